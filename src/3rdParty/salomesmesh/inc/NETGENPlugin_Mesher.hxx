@@ -131,6 +131,11 @@ class NETGENPLUGIN_EXPORT NETGENPlugin_Mesher
                      const int *       algoProgressTic,
                      const double *    algoProgress) const;
 
+  // progress [0,100] of the running netgen computation and its termination,
+  // for callers running Compute() in a separate thread
+  static double GetNetgenPercent();
+  static void   SetNetgenTerminate(bool terminate);
+
   static void PrepareOCCgeometry(netgen::OCCGeometry&          occgeom,
                                  const TopoDS_Shape&           shape,
                                  SMESH_Mesh&                   mesh,
@@ -223,6 +228,9 @@ class NETGENPLUGIN_EXPORT NETGENPlugin_Mesher
   NETGENPlugin_Mesher ** _ptrToMe; 
 };
 
+// NETGENPlugin_Mesher::GetNetgenPercent() and SetNetgenTerminate() are available
+#define NETGENPLUGIN_MESHER_PROGRESS
+
 //=============================================================================
 /*!
  * \brief Container of info needed to solve problems with internal shapes.
@@ -3441,6 +3441,28 @@ bool NETGENPlugin_Mesher::Evaluate(MapShapeNbElems& aResMap)
   return true;
 }
 
+//================================================================================
+/*!
+ * \brief Return progress of the running netgen computation in percent
+ */
+//================================================================================
+
+double NETGENPlugin_Mesher::GetNetgenPercent()
+{
+  return netgen::multithread.percent;
+}
+
+//================================================================================
+/*!
+ * \brief Request termination of the running netgen computation or reset the request
+ */
+//================================================================================
+
+void NETGENPlugin_Mesher::SetNetgenTerminate(bool terminate)
+{
+  netgen::multithread.terminate = terminate ? 1 : 0;
+}
+
 double NETGENPlugin_Mesher::GetProgress(const SMESH_Algo* holder,
                                         const int *       algoProgressTic,
                                         const double *    algoProgress) const
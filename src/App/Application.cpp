@@ -84,6 +84,11 @@
 #include <Base/QuantityPy.h>
 #include <Base/UnitPy.h>
 #include <Base/TypePy.h>
+#include <Base/Stream.h>
+#include <Base/ThreadPool.h>
+#include <Base/Profiler.h>
+#include <future>
+#include <thread>
 
 #include "GeoFeature.h"
 #include "FeatureTest.h"
@@ -145,6 +150,7 @@ namespace sp = std::placeholders;
 // scriptings (scripts are built-in but can be overridden by command line option)
 #include <App/InitScript.h>
 #include <App/TestScript.h>
+#include <App/ServerScript.h>
 #include <App/CMakeScript.h>
 
 #ifdef _MSC_VER // New handler for Microsoft Visual C++ compiler
@@ -623,6 +629,61 @@ Document* Application::openDocument(const char * FileName, bool createView) {
     return 0;
 }
 
+namespace {
+
+// Files read ahead by Application::openDocuments() while the previous
+// document is restored. The worker threads only read the file content, the
+// documents themselves must be restored by the main thread.
+class DocumentPrefetcher
+{
+public:
+    DocumentPrefetcher()
+    {
+        ParameterGrp::handle hGrp = GetApplication().GetParameterGroupByPath(
+                "User parameter:BaseApp/Preferences/Document");
+        maxPending = hGrp->GetBool("PrefetchDocuments", true) ?
+            std::max(2u, std::thread::hardware_concurrency()) : 0;
+    }
+
+    void prefetch(const std::string &path)
+    {
+        if (pending.size() >= maxPending || pending.count(path))
+            return;
+        Base::FileInfo fi(path);
+        if (!fi.isReadable() || fi.size() > MaxFileSize)
+            return;
+        pending.emplace(path, std::async(std::launch::async, [fi]() {
+            auto data = std::make_shared<std::string>();
+            Base::ifstream file(fi, std::ios::in | std::ios::binary);
+            if (file)
+                data->assign(std::istreambuf_iterator<char>(file),
+                             std::istreambuf_iterator<char>());
+            if (!file.eof() && file.fail())
+                data.reset();
+            return data;
+        }));
+    }
+
+    /// Returns the content of the file, or nullptr if not read ahead
+    std::shared_ptr<std::string> take(const std::string &path)
+    {
+        auto it = pending.find(path);
+        if (it == pending.end())
+            return std::shared_ptr<std::string>();
+        auto data = it->second.get();
+        pending.erase(it);
+        return data;
+    }
+
+private:
+    // larger files are read while restoring as usual
+    static const unsigned int MaxFileSize = 256 * 1024 * 1024;
+    std::size_t maxPending;
+    std::map<std::string, std::future<std::shared_ptr<std::string> > > pending;
+};
+
+} // anonymous namespace
+
 std::vector<Document*> Application::openDocuments(const std::vector<std::string> &filenames,
                                                   const std::vector<std::string> *paths,
                                                   const std::vector<std::string> *labels,
@@ -653,6 +714,19 @@ std::vector<Document*> Application::openDocuments(const std::vector<std::string>
 
     FC_TIME_INIT(t);
 
+    // The queue holds the main documents first, followed by the external
+    // documents found while restoring. Read ahead the next ones in the queue.
+    DocumentPrefetcher prefetcher;
+    auto prefetchPending = [&](std::size_t next) {
+        for (auto name : _pendingDocs) {
+            if (next < filenames.size() && paths && paths->size() > next)
+                prefetcher.prefetch((*paths)[next]);
+            else
+                prefetcher.prefetch(name);
+            ++next;
+        }
+    };
+
     for (std::size_t count=0;; ++count) {
         const char *name = _pendingDocs.front();
         _pendingDocs.pop_front();
@@ -680,7 +754,14 @@ std::vector<Document*> Application::openDocuments(const std::vector<std::string>
                     label = (*labels)[count].c_str();
             }
 
-            auto doc = openDocumentPrivate(path, name, label, isMainDoc, createView, objNames);
+            auto data = prefetcher.take(path);
+            prefetchPending(count+1);
+            std::unique_ptr<std::istringstream> stream;
+            if (data)
+                stream.reset(new std::istringstream(std::move(*data)));
+            data.reset();
+
+            auto doc = openDocumentPrivate(path, name, label, isMainDoc, createView, objNames, stream.get());
             FC_DURATION_PLUS(timing.d1,t1);
             if (doc)
                 newDocs.emplace(doc,timing);
@@ -786,7 +867,8 @@ std::vector<Document*> Application::openDocuments(const std::vector<std::string>
 Document* Application::openDocumentPrivate(const char * FileName,
         const char *propFileName, const char *label,
         bool isMainDoc, bool createView,
-        const std::set<std::string> &objNames)
+        const std::set<std::string> &objNames,
+        std::istream *stream)
 {
     FileInfo File(FileName);
 
@@ -866,7 +948,7 @@ Document* Application::openDocumentPrivate(const char * FileName,
 
     try {
         // read the document
-        newDoc->restore(File.filePath().c_str(),true,objNames);
+        newDoc->restore(File.filePath().c_str(),true,objNames,stream);
         return newDoc;
     }
     // if the project file itself is corrupt then
@@ -1536,6 +1618,9 @@ void Application::destruct(void)
     assert(_pcSingleton);
     delete _pcSingleton;
 
+    Base::ThreadPool::destruct();
+    Base::Profiler::destruct();
+
     // We must detach from console and delete the observer to save our file
     destructObserver();
 
@@ -1714,9 +1799,16 @@ void Application::init(int argc, char ** argv)
 #if defined(FC_SE_TRANSLATOR)
         _set_se_translator(my_se_translator_filter);
 #endif
+        // FREECAD_PROFILE_STARTUP=<file> writes a trace of the startup to file
+        const char* profile = getenv("FREECAD_PROFILE_STARTUP");
+        if (profile && *profile)
+            Base::Profiler::instance().start();
+
         initTypes();
 
         initConfig(argc,argv);
+        if (profile && *profile)
+            mConfig["ProfileStartup"] = profile;
         initApplication();
     }
     catch (...) {
@@ -1728,6 +1820,8 @@ void Application::init(int argc, char ** argv)
 
 void Application::initTypes(void)
 {
+    FC_PROFILE_ZONE("Application::initTypes");
+
     // Base types
     Base::Type                      ::init();
     Base::BaseClass                 ::init();
@@ -1921,6 +2015,8 @@ void Application::initTypes(void)
 
 void Application::initConfig(int argc, char ** argv)
 {
+    FC_PROFILE_ZONE("Application::initConfig");
+
     // find the home path....
     mConfig["AppHomePath"] = FindHomePath(argv[0]);
 
@@ -2094,11 +2190,14 @@ void Application::SaveEnv(const char* s)
 
 void Application::initApplication(void)
 {
+    FC_PROFILE_ZONE("Application::initApplication");
+
     // interpreter and Init script ==========================================================
     // register scripts
     new ScriptProducer( "CMakeVariables", CMakeVariables );
     new ScriptProducer( "FreeCADInit",    FreeCADInit    );
     new ScriptProducer( "FreeCADTest",    FreeCADTest    );
+    new ScriptProducer( "FreeCADServer",  FreeCADServer  );
 
     // creating the application
     if (!(mConfig["Verbose"] == "Strict")) Console().Log("Create Application\n");
@@ -2114,6 +2213,10 @@ void Application::initApplication(void)
     int denom = hGrp->GetInt("FracInch", Base::QuantityFormat::getDefaultDenominator());
     Base::QuantityFormat::setDefaultDenominator(denom);
 
+    // set up the shared thread pool, 0 means to use all cores
+    hGrp = App::GetApplication().GetParameterGroupByPath
+       ("User parameter:BaseApp/Preferences/General");
+    Base::ThreadPool::instance().setThreadCount(hGrp->GetInt("ThreadCount", 0));
 
 #if defined (_DEBUG)
     Console().Log("Application is built with debug information\n");
@@ -2264,6 +2367,27 @@ void Application::processCmdLineFiles(void)
             Console().Error("Unknown exception while saving to file: %s \n", output.c_str());
         }
     }
+
+    saveStartupProfile();
+}
+
+void Application::saveStartupProfile()
+{
+    std::map<std::string,std::string>::iterator it = mConfig.find("ProfileStartup");
+    if (it == mConfig.end())
+        return;
+
+    std::string file = it->second;
+    mConfig.erase(it);
+
+    Base::Profiler::instance().stop();
+    try {
+        Base::Profiler::instance().saveTrace(file);
+        Console().Log("Startup profile written to %s\n", file.c_str());
+    }
+    catch (const Base::Exception& e) {
+        Console().Error("Failed to write startup profile %s: %s\n", file.c_str(), e.what());
+    }
 }
 
 void Application::runApplication()
@@ -2469,6 +2593,8 @@ void Application::ParseOptions(int ac, char ** av)
     ("module-path,M", value< vector<string> >()->composing(),"Additional module paths")
     ("python-path,P", value< vector<string> >()->composing(),"Additional python paths")
     ("single-instance", "Allow to run a single instance of the application")
+    ("run-server", value<string>(), "Run batch jobs sent to a local socket (port, host:port or socket path)")
+    ("server-memory", value<int>(), "Replace the server worker once it uses more memory (in MB) than this")
     ;
 
 
@@ -2688,6 +2814,18 @@ void Application::ParseOptions(int ac, char ** av)
         //sScriptName = FreeCADTest;
     }
 
+    if (vm.count("run-server")) {
+        mConfig["ServerAddress"] = vm["run-server"].as<string>();
+        mConfig["RunMode"] = "Internal";
+        mConfig["ScriptFileName"] = "FreeCADServer";
+    }
+
+    if (vm.count("server-memory")) {
+        std::ostringstream buffer;
+        buffer << vm["server-memory"].as<int>();
+        mConfig["ServerMemory"] = buffer.str();
+    }
+
     if (vm.count("single-instance")) {
         mConfig["SingleInstance"] = "1";
     }
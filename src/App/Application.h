@@ -355,6 +355,8 @@ public:
     static void destruct(void);
     static void destructObserver(void);
     static void processCmdLineFiles(void);
+    /// Write the trace requested with FREECAD_PROFILE_STARTUP, once startup is done
+    static void saveStartupProfile(void);
     static std::list<std::string> getCmdLineFiles();
     static std::list<std::string> processFiles(const std::list<std::string>&);
     static void runApplication(void);
@@ -441,7 +443,8 @@ protected:
 
     /// open single document only
     App::Document* openDocumentPrivate(const char * FileName, const char *propFileName,
-            const char *label, bool isMainDoc, bool createView, const std::set<std::string> &objNames);
+            const char *label, bool isMainDoc, bool createView, const std::set<std::string> &objNames,
+            std::istream *stream=nullptr);
 
     /// Helper class for App::Document to signal on close/abort transaction
     class AppExport TransactionSignaller {
@@ -515,6 +518,10 @@ private:
     static PyObject *sGetActiveTransaction  (PyObject *self,PyObject *args);
     static PyObject *sCloseActiveTransaction(PyObject *self,PyObject *args);
     static PyObject *sCheckAbort(PyObject *self,PyObject *args);
+    static PyObject *sStartProfiling(PyObject *self,PyObject *args);
+    static PyObject *sStopProfiling (PyObject *self,PyObject *args);
+    static PyObject *sSaveProfile   (PyObject *self,PyObject *args);
+    static PyObject *sGetMemoryReport(PyObject *self,PyObject *args);
     static PyMethodDef    Methods[];
 
     friend class ApplicationObserver;
@@ -35,11 +35,13 @@
 #include "DocumentPy.h"
 #include "DocumentObserverPython.h"
 #include "DocumentObjectPy.h"
+#include "MemoryReport.h"
 
 // FreeCAD Base header
 #include <Base/Interpreter.h>
 #include <Base/Exception.h>
 #include <Base/Parameter.h>
+#include <Base/Profiler.h>
 #include <Base/Console.h>
 #include <Base/Factory.h>
 #include <Base/FileInfo.h>
@@ -185,6 +187,21 @@ PyMethodDef Application::Methods[] = {
      "There is an active sequencer during document restore and recomputation. User may\n"
      "abort the operation by pressing the ESC key. Once detected, this function will\n"
      "trigger a BaseExceptionFreeCADAbort exception."},
+    {"startProfiling", (PyCFunction) Application::sStartProfiling, METH_VARARGS,
+     "startProfiling() -- discard the zones of a previous run and start recording\n\n"
+     "Recompute, restore, save, tessellation, rendering and commands are timed while the\n"
+     "profiler is running. Use saveProfile() to get the recorded zones."},
+    {"stopProfiling", (PyCFunction) Application::sStopProfiling, METH_VARARGS,
+     "stopProfiling() -> Int -- stop recording and return the number of recorded zones"},
+    {"saveProfile", (PyCFunction) Application::sSaveProfile, METH_VARARGS,
+     "saveProfile(filename) -- write the recorded zones as Chrome trace JSON\n\n"
+     "The file can be opened with chrome://tracing or https://ui.perfetto.dev"},
+    {"getMemoryReport", (PyCFunction) Application::sGetMemoryReport, METH_VARARGS,
+     "getMemoryReport([group]) -> list -- estimated memory usage of the open documents\n\n"
+     "Without argument a list of dicts with the keys Document, Object, Label, Name, Category\n"
+     "and Size (in bytes) is returned, one per property, undo stack and scene graph.\n"
+     "With group set to 'Document', 'Object', 'Property' or 'Category' a list of\n"
+     "(name, size) tuples is returned, the biggest first."},
     {NULL, NULL, 0, NULL}		/* Sentinel */
 };
 
@@ -954,3 +971,86 @@ PyObject *Application::sCheckAbort(PyObject * /*self*/, PyObject *args)
         Py_Return;
     }PY_CATCH
 }
+
+PyObject *Application::sGetMemoryReport(PyObject * /*self*/, PyObject *args)
+{
+    char *group = nullptr;
+    if (!PyArg_ParseTuple(args, "|s", &group))
+        return 0;
+
+    MemoryReport::GroupBy groupBy = MemoryReport::ByObject;
+    if (group) {
+        if (strcmp(group, "Document") == 0)
+            groupBy = MemoryReport::ByDocument;
+        else if (strcmp(group, "Object") == 0)
+            groupBy = MemoryReport::ByObject;
+        else if (strcmp(group, "Property") == 0)
+            groupBy = MemoryReport::ByProperty;
+        else if (strcmp(group, "Category") == 0)
+            groupBy = MemoryReport::ByCategory;
+        else {
+            PyErr_Format(PyExc_ValueError, "Unknown group '%s'", group);
+            return 0;
+        }
+    }
+
+    PY_TRY {
+        MemoryReport report;
+        report.collect();
+
+        Py::List list;
+        if (group) {
+            for (const auto& it : report.totals(groupBy)) {
+                Py::Tuple tuple(2);
+                tuple.setItem(0, Py::String(it.first));
+                tuple.setItem(1, Py::Long(static_cast<unsigned long>(it.second)));
+                list.append(tuple);
+            }
+        }
+        else {
+            for (const auto& it : report.entries()) {
+                Py::Dict dict;
+                dict.setItem("Document", Py::String(it.document));
+                dict.setItem("Object", Py::String(it.object));
+                dict.setItem("Label", Py::String(it.label));
+                dict.setItem("Name", Py::String(it.name));
+                dict.setItem("Category", Py::String(MemoryReport::categoryName(it.category)));
+                dict.setItem("Size", Py::Long(static_cast<unsigned long>(it.size)));
+                list.append(dict);
+            }
+        }
+        return Py::new_reference_to(list);
+    }PY_CATCH
+}
+
+PyObject *Application::sStartProfiling(PyObject * /*self*/, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    Base::Profiler::instance().start();
+    Py_Return;
+}
+
+PyObject *Application::sStopProfiling(PyObject * /*self*/, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    Base::Profiler::instance().stop();
+    return Py_BuildValue("n", static_cast<Py_ssize_t>(Base::Profiler::instance().size()));
+}
+
+PyObject *Application::sSaveProfile(PyObject * /*self*/, PyObject *args)
+{
+    char *fileName;
+    if (!PyArg_ParseTuple(args, "et", "utf-8", &fileName))
+        return 0;
+
+    std::string name = fileName;
+    PyMem_Free(fileName);
+    PY_TRY {
+        Base::Profiler::instance().saveTrace(name);
+        Py_Return;
+    }PY_CATCH
+}
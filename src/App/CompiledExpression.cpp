@@ -0,0 +1,665 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <climits>
+# include <cmath>
+#endif
+
+#include <App/Application.h>
+#include <App/DocumentObject.h>
+#include <Base/Exception.h>
+
+#include "CompiledExpression.h"
+#include "ExpressionParser.h"
+#include "PropertyStandard.h"
+#include "PropertyUnits.h"
+
+using namespace App;
+using namespace Base;
+
+namespace {
+
+enum VariableType {
+    VarQuantity,
+    VarFloat,
+    VarInteger,
+    VarBool,
+};
+
+// Bumped on any change that may alter how an ObjectIdentifier resolves
+unsigned long _Epoch = 1;
+
+void bumpEpoch() {
+    ++_Epoch;
+}
+
+void connectEpochSignals() {
+    static bool connected;
+    if(connected)
+        return;
+    connected = true;
+
+    auto &app = GetApplication();
+    app.signalNewObject.connect([](const DocumentObject &) {bumpEpoch();});
+    app.signalDeletedObject.connect([](const DocumentObject &) {bumpEpoch();});
+    app.signalRelabelObject.connect([](const DocumentObject &) {bumpEpoch();});
+    app.signalAppendDynamicProperty.connect([](const Property &) {bumpEpoch();});
+    app.signalRemoveDynamicProperty.connect([](const Property &) {bumpEpoch();});
+    app.signalDeleteDocument.connect([](const Document &) {bumpEpoch();});
+    app.signalRelabelDocument.connect([](const Document &) {bumpEpoch();});
+    app.signalRenameDocument.connect([](const Document &) {bumpEpoch();});
+    app.signalStartRestoreDocument.connect([](const Document &) {bumpEpoch();});
+    app.signalFinishRestoreDocument.connect([](const Document &) {bumpEpoch();});
+    app.signalUndoDocument.connect([](const Document &) {bumpEpoch();});
+    app.signalRedoDocument.connect([](const Document &) {bumpEpoch();});
+    app.signalChangePropertyEditor.connect([](const Document &, const Property &) {bumpEpoch();});
+}
+
+typedef CompiledExpression::Value Value;
+
+// Python ints are converted to float exactly only up to 2^53
+const long MaxExactLong = 1L << 53;
+
+inline bool isExact(long v) {
+    return v <= MaxExactLong && v >= -MaxExactLong;
+}
+
+inline Value makeLong(long v) {
+    Value res;
+    res.type = Value::TypeLong;
+    res.l = v;
+    return res;
+}
+
+inline Value makeDouble(double v) {
+    Value res;
+    res.type = Value::TypeDouble;
+    res.d = v;
+    return res;
+}
+
+inline Value makeQuantity(const Quantity &v) {
+    Value res;
+    res.type = Value::TypeQuantity;
+    res.q = v;
+    return res;
+}
+
+inline double toDouble(const Value &v) {
+    switch(v.type) {
+    case Value::TypeLong:
+        return static_cast<double>(v.l);
+    case Value::TypeDouble:
+        return v.d;
+    default:
+        return v.q.getValue();
+    }
+}
+
+inline Quantity toQuantity(const Value &v) {
+    if(v.type == Value::TypeQuantity)
+        return v.q;
+    return Quantity(toDouble(v));
+}
+
+inline bool isTrue(const Value &v) {
+    return toDouble(v) != 0.0;
+}
+
+// Python float remainder, result takes the sign of the divisor
+bool floatRemainder(double a, double b, double &res) {
+    if(b == 0.0)
+        return false;
+    res = std::fmod(a, b);
+    if(res != 0.0) {
+        if((b < 0) != (res < 0))
+            res += b;
+    }
+    else
+        res = std::copysign(0.0, b);
+    return true;
+}
+
+bool floatPower(double a, double b, double &res) {
+    if(!std::isfinite(a) || !std::isfinite(b))
+        return false;
+    if(a == 0.0 && b < 0.0)
+        return false;
+    if(a < 0.0 && std::floor(b) != b)
+        return false;
+    res = std::pow(a, b);
+    return std::isfinite(res);
+}
+
+bool longMultiply(long a, long b, long &res) {
+    if(a > 0) {
+        if(b > 0 ? a > LONG_MAX / b : b < LONG_MIN / a)
+            return false;
+    }
+    else if(b > 0 ? a < LONG_MIN / b : (a != 0 && b < LONG_MAX / a))
+        return false;
+    res = a * b;
+    return true;
+}
+
+bool longPower(long a, long b, long &res) {
+    res = 1;
+    while(b) {
+        if(b & 1) {
+            if(!longMultiply(res, a, res))
+                return false;
+        }
+        b >>= 1;
+        if(b && !longMultiply(a, a, a))
+            return false;
+    }
+    return true;
+}
+
+bool compare(int op, double a, double b) {
+    switch(op) {
+    case OperatorExpression::EQ:
+        return a == b;
+    case OperatorExpression::NEQ:
+        return a != b;
+    case OperatorExpression::LT:
+        return a < b;
+    case OperatorExpression::GT:
+        return a > b;
+    case OperatorExpression::LTE:
+        return a <= b;
+    default:
+        return a >= b;
+    }
+}
+
+// Mirrors QuantityPy::richCompare()
+bool compare(int op, const Quantity &a, const Quantity &b) {
+    switch(op) {
+    case OperatorExpression::EQ:
+        return a == b;
+    case OperatorExpression::NEQ:
+        return !(a == b);
+    case OperatorExpression::LT:
+        return a < b;
+    case OperatorExpression::GT:
+        return !(a < b) && !(a == b);
+    case OperatorExpression::LTE:
+        return a < b || a == b;
+    default:
+        return !(a < b);
+    }
+}
+
+bool unaryOperator(int op, const Value &v, Value &res) {
+    switch(v.type) {
+    case Value::TypeLong:
+        if(op == OperatorExpression::NEG) {
+            if(v.l == LONG_MIN)
+                return false;
+            res = makeLong(-v.l);
+        }
+        else
+            res = v;
+        return true;
+    case Value::TypeDouble:
+        res = makeDouble(op == OperatorExpression::NEG ? -v.d : v.d);
+        return true;
+    default:
+        res = makeQuantity(op == OperatorExpression::NEG ? v.q * -1.0 : v.q);
+        return true;
+    }
+}
+
+bool longOperator(int op, long a, long b, Value &res) {
+    long l;
+    switch(op) {
+    case OperatorExpression::ADD:
+        if((b > 0 && a > LONG_MAX - b) || (b < 0 && a < LONG_MIN - b))
+            return false;
+        res = makeLong(a + b);
+        return true;
+    case OperatorExpression::SUB:
+        if((b > 0 && a < LONG_MIN + b) || (b < 0 && a > LONG_MAX + b))
+            return false;
+        res = makeLong(a - b);
+        return true;
+    case OperatorExpression::MUL:
+    case OperatorExpression::UNIT:
+        if(!longMultiply(a, b, l))
+            return false;
+        res = makeLong(l);
+        return true;
+    case OperatorExpression::DIV:
+        if(b == 0 || !isExact(a) || !isExact(b))
+            return false;
+        res = makeDouble(static_cast<double>(a) / static_cast<double>(b));
+        return true;
+    case OperatorExpression::MOD:
+        if(b == 0)
+            return false;
+        if(b == -1)
+            l = 0;
+        else {
+            l = a % b;
+            if(l != 0 && ((l < 0) != (b < 0)))
+                l += b;
+        }
+        res = makeLong(l);
+        return true;
+    case OperatorExpression::POW:
+        if(b < 0) {
+            double d;
+            if(a == 0 || !isExact(a) || !isExact(b)
+                    || !floatPower(static_cast<double>(a), static_cast<double>(b), d))
+                return false;
+            res = makeDouble(d);
+            return true;
+        }
+        if(!longPower(a, b, l))
+            return false;
+        res = makeLong(l);
+        return true;
+    default:
+        if(!isExact(a) || !isExact(b))
+            return false;
+        res = makeLong(compare(op, static_cast<double>(a), static_cast<double>(b)) ? 1 : 0);
+        return true;
+    }
+}
+
+bool doubleOperator(int op, double a, double b, Value &res) {
+    double d;
+    switch(op) {
+    case OperatorExpression::ADD:
+        d = a + b;
+        break;
+    case OperatorExpression::SUB:
+        d = a - b;
+        break;
+    case OperatorExpression::MUL:
+    case OperatorExpression::UNIT:
+        d = a * b;
+        break;
+    case OperatorExpression::DIV:
+        if(b == 0.0)
+            return false;
+        d = a / b;
+        break;
+    case OperatorExpression::MOD:
+        if(!floatRemainder(a, b, d))
+            return false;
+        break;
+    case OperatorExpression::POW:
+        if(!floatPower(a, b, d))
+            return false;
+        break;
+    default:
+        res = makeLong(compare(op, a, b) ? 1 : 0);
+        return true;
+    }
+    res = makeDouble(d);
+    return true;
+}
+
+// Mirrors the QuantityPy number protocol
+bool quantityOperator(int op, const Value &l, const Value &r, Value &res) {
+    switch(op) {
+    case OperatorExpression::ADD:
+        res = makeQuantity(toQuantity(l) + toQuantity(r));
+        return true;
+    case OperatorExpression::SUB:
+        res = makeQuantity(toQuantity(l) - toQuantity(r));
+        return true;
+    case OperatorExpression::MUL:
+    case OperatorExpression::UNIT:
+        res = makeQuantity(toQuantity(l) * toQuantity(r));
+        return true;
+    case OperatorExpression::DIV:
+        res = makeQuantity(toQuantity(l) / toQuantity(r));
+        return true;
+    case OperatorExpression::MOD: {
+        double d;
+        if(l.type != Value::TypeQuantity || !floatRemainder(l.q.getValue(), toDouble(r), d))
+            return false;
+        res = makeQuantity(Quantity(d, l.q.getUnit()));
+        return true;
+    }
+    case OperatorExpression::POW:
+        if(l.type != Value::TypeQuantity)
+            return false;
+        if(r.type == Value::TypeQuantity)
+            res = makeQuantity(l.q.pow(r.q));
+        else {
+            if(r.type == Value::TypeLong && !isExact(r.l))
+                return false;
+            res = makeQuantity(l.q.pow(toDouble(r)));
+        }
+        return true;
+    default:
+        if(l.type == Value::TypeQuantity && r.type == Value::TypeQuantity)
+            res = makeLong(compare(op, l.q, r.q) ? 1 : 0);
+        else {
+            if((l.type == Value::TypeLong && !isExact(l.l))
+                    || (r.type == Value::TypeLong && !isExact(r.l)))
+                return false;
+            res = makeLong(compare(op, toDouble(l), toDouble(r)) ? 1 : 0);
+        }
+        return true;
+    }
+}
+
+bool binaryOperator(int op, const Value &l, const Value &r, Value &res) {
+    if(l.type == Value::TypeQuantity || r.type == Value::TypeQuantity)
+        return quantityOperator(op, l, r, res);
+    if(l.type == Value::TypeLong && r.type == Value::TypeLong)
+        return longOperator(op, l.l, r.l, res);
+    if((l.type == Value::TypeLong && !isExact(l.l))
+            || (r.type == Value::TypeLong && !isExact(r.l)))
+        return false;
+    return doubleOperator(op, toDouble(l), toDouble(r), res);
+}
+
+inline bool isSameValue(const Value &a, const Value &b) {
+    if(a.type != b.type)
+        return false;
+    switch(a.type) {
+    case Value::TypeLong:
+        return a.l == b.l;
+    case Value::TypeDouble:
+        return a.d == b.d;
+    default:
+        return a.q == b.q;
+    }
+}
+
+bool anyToValue(const App::any &value, Value &res) {
+    if(value.type() == typeid(Quantity))
+        res = makeQuantity(App::any_cast<const Quantity&>(value));
+    else if(value.type() == typeid(double))
+        res = makeDouble(App::any_cast<double>(value));
+    else if(value.type() == typeid(long))
+        res = makeLong(App::any_cast<long>(value));
+    else
+        return false;
+    return true;
+}
+
+} // anonymous namespace
+
+CompiledExpression::CompiledExpression()
+    : epoch(_Epoch)
+{
+}
+
+std::shared_ptr<CompiledExpression> CompiledExpression::compile(const Expression *expr)
+{
+    connectEpochSignals();
+
+    std::shared_ptr<CompiledExpression> res(new CompiledExpression);
+    if(expr && expr->getOwner() && res->compileNode(expr) < 0)
+        res->nodes.clear();
+    return res;
+}
+
+bool CompiledExpression::isValid() const
+{
+    return epoch == _Epoch;
+}
+
+unsigned long CompiledExpression::getEpoch()
+{
+    connectEpochSignals();
+    return _Epoch;
+}
+
+void CompiledExpression::recordInputs()
+{
+    inputs.clear();
+    hasInputs = false;
+    if(nodes.empty() || !isValid())
+        return;
+    for(auto &node : nodes) {
+        if(node.type != Node::Variable)
+            continue;
+        inputs.emplace_back();
+        readVariable(node, inputs.back());
+    }
+    hasInputs = true;
+}
+
+bool CompiledExpression::isInputChanged() const
+{
+    if(!hasInputs || !isValid())
+        return true;
+    auto it = inputs.begin();
+    for(auto &node : nodes) {
+        if(node.type != Node::Variable)
+            continue;
+        Value value;
+        readVariable(node, value);
+        if(!isSameValue(value, *it++))
+            return true;
+    }
+    return false;
+}
+
+int CompiledExpression::compileNode(const Expression *expr)
+{
+    if(!expr || expr->hasComponent())
+        return -1;
+
+    Node node;
+    node.expr = expr;
+
+    if(auto opExpr = freecad_dynamic_cast<OperatorExpression>(expr)) {
+        node.type = Node::Operator;
+        node.op = opExpr->getOperator();
+        switch(node.op) {
+        case OperatorExpression::NONE:
+            return -1;
+        case OperatorExpression::NEG:
+        case OperatorExpression::POS:
+            node.argc = 1;
+            break;
+        default:
+            node.argc = 2;
+            node.args[1] = compileNode(opExpr->getRight());
+            if(node.args[1] < 0)
+                return -1;
+        }
+        node.args[0] = compileNode(opExpr->getLeft());
+        if(node.args[0] < 0)
+            return -1;
+    }
+    else if(auto condExpr = freecad_dynamic_cast<ConditionalExpression>(expr)) {
+        node.type = Node::Conditional;
+        node.argc = 3;
+        node.args[0] = compileNode(condExpr->getCondition());
+        node.args[1] = compileNode(condExpr->getTrueExpr());
+        node.args[2] = compileNode(condExpr->getFalseExpr());
+        if(node.args[0] < 0 || node.args[1] < 0 || node.args[2] < 0)
+            return -1;
+    }
+    else if(auto funcExpr = freecad_dynamic_cast<FunctionExpression>(expr)) {
+        const auto &args = funcExpr->getArgs();
+        if(!FunctionExpression::isMathFunction(funcExpr->getFunction())
+                || args.empty() || args.size() > 3)
+            return -1;
+        node.type = Node::Function;
+        node.op = funcExpr->getFunction();
+        node.argc = args.size();
+        for(std::size_t i=0; i<args.size(); ++i) {
+            node.args[i] = compileNode(args[i]);
+            if(node.args[i] < 0)
+                return -1;
+        }
+    }
+    else if(auto varExpr = freecad_dynamic_cast<VariableExpression>(expr)) {
+        const ObjectIdentifier &path = varExpr->getPath();
+        int ptype;
+        Property *prop = path.getProperty(&ptype);
+        // Only bind a plain property of a document object, without sub-object
+        // path, pseudo property or further attribute access. The property
+        // name check excludes indirect look up such as spreadsheet aliases.
+        if(!prop || ptype || path.numSubComponents() != 1
+                || path.getSubObjectName().size()
+                || !prop->getName()
+                || path.getPropertyName() != prop->getName()
+                || !freecad_dynamic_cast<DocumentObject>(prop->getContainer()))
+            return -1;
+
+        Base::Type type = prop->getTypeId();
+        if(type.isDerivedFrom(PropertyQuantity::getClassTypeId()))
+            node.op = VarQuantity;
+        else if(type == PropertyFloat::getClassTypeId()
+                || type == PropertyFloatConstraint::getClassTypeId()
+                || type == PropertyPrecision::getClassTypeId())
+            node.op = VarFloat;
+        else if(type == PropertyInteger::getClassTypeId()
+                || type == PropertyIntegerConstraint::getClassTypeId()
+                || type == PropertyPercent::getClassTypeId())
+            node.op = VarInteger;
+        else if(type == PropertyBool::getClassTypeId())
+            node.op = VarBool;
+        else
+            return -1;
+        node.type = Node::Variable;
+        node.prop = prop;
+    }
+    else if(expr->getTypeId() == UnitExpression::getClassTypeId()
+            || expr->getTypeId() == NumberExpression::getClassTypeId()
+            || expr->getTypeId() == ConstantExpression::getClassTypeId())
+    {
+        // Evaluate constants once through Python to get the exact same value type
+        node.type = Node::Constant;
+        try {
+            if(!anyToValue(expr->getValueAsAny(), node.value))
+                return -1;
+        }
+        catch(Base::Exception &) {
+            return -1;
+        }
+    }
+    else
+        return -1;
+
+    nodes.push_back(node);
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+bool CompiledExpression::evaluate(App::any &value) const
+{
+    if(nodes.empty() || !isValid())
+        return false;
+
+    Value res;
+    try {
+        if(!evaluateNode(static_cast<int>(nodes.size()) - 1, res))
+            return false;
+    }
+    catch(Base::Exception &) {
+        return false;
+    }
+    catch(std::exception &) {
+        return false;
+    }
+
+    switch(res.type) {
+    case Value::TypeLong:
+        value = App::any(res.l);
+        break;
+    case Value::TypeDouble:
+        value = App::any(res.d);
+        break;
+    default:
+        value = App::any(res.q);
+        break;
+    }
+    return true;
+}
+
+void CompiledExpression::readVariable(const Node &node, Value &res)
+{
+    switch(node.op) {
+    case VarQuantity:
+        res = makeQuantity(static_cast<const PropertyQuantity*>(node.prop)->getQuantityValue());
+        break;
+    case VarFloat:
+        res = makeDouble(static_cast<const PropertyFloat*>(node.prop)->getValue());
+        break;
+    case VarInteger:
+        res = makeLong(static_cast<const PropertyInteger*>(node.prop)->getValue());
+        break;
+    default:
+        res = makeLong(static_cast<const PropertyBool*>(node.prop)->getValue() ? 1 : 0);
+        break;
+    }
+}
+
+bool CompiledExpression::evaluateNode(int index, Value &res) const
+{
+    const Node &node = nodes[index];
+    switch(node.type) {
+    case Node::Constant:
+        res = node.value;
+        return true;
+    case Node::Variable:
+        readVariable(node, res);
+        return true;
+    case Node::Conditional: {
+        Value cond;
+        if(!evaluateNode(node.args[0], cond))
+            return false;
+        return evaluateNode(isTrue(cond) ? node.args[1] : node.args[2], res);
+    }
+    case Node::Operator: {
+        Value l, r;
+        if(!evaluateNode(node.args[0], l))
+            return false;
+        if(node.argc == 1)
+            return unaryOperator(node.op, l, res);
+        if(!evaluateNode(node.args[1], r))
+            return false;
+        return binaryOperator(node.op, l, r, res);
+    }
+    case Node::Function: {
+        Quantity v[3];
+        for(std::size_t i=0; i<node.argc; ++i) {
+            Value arg;
+            if(!evaluateNode(node.args[i], arg))
+                return false;
+            if(arg.type == Value::TypeLong && !isExact(arg.l))
+                return false;
+            v[i] = toQuantity(arg);
+        }
+        res = makeQuantity(FunctionExpression::evaluateMath(
+                    node.expr, node.op, node.argc, v[0], v[1], v[2]));
+        return true;
+    }
+    }
+    return false;
+}
@@ -0,0 +1,140 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef APP_COMPILEDEXPRESSION_H
+#define APP_COMPILEDEXPRESSION_H
+
+#include <memory>
+#include <vector>
+#include <Base/Quantity.h>
+#include <App/Expression.h>
+
+namespace App {
+
+class Property;
+
+/** Pre-resolved form of a purely numerical expression
+ *
+ * Evaluating an Expression goes through Python for every node, including
+ * property look up through ObjectIdentifier. For the common case of an
+ * expression built only from numbers, units, arithmetic, comparison,
+ * conditionals, math functions and plain numerical property references, the
+ * tree can be flattened into nodes with directly bound properties and
+ * evaluated without the interpreter.
+ *
+ * The compiled form is conservative. compile() leaves the object empty for
+ * any unsupported construct, and evaluate() returns false whenever the result
+ * might differ from the Python evaluation, e.g. on any error, integer
+ * overflow or division by zero. The caller is expected to fall back to
+ * Expression::getValueAsAny() in that case, which reproduces the exact result
+ * or error message.
+ *
+ * Bound properties are only valid as long as the document structure does not
+ * change. Any object creation, deletion, relabel or dynamic property change
+ * invalidates all compiled expressions, see isValid().
+ *
+ * The bound property values can also be recorded after an evaluation, so
+ * that the caller can skip evaluating again while none of them changed, see
+ * isInputChanged().
+ */
+class AppExport CompiledExpression
+{
+public:
+    /// Compile the given expression, the returned object is never null
+    static std::shared_ptr<CompiledExpression> compile(const Expression *expr);
+
+    /// Check if the compiled form is still valid for the current document structure
+    bool isValid() const;
+
+    /// Return the current document structure epoch, changes whenever isValid() may change
+    static unsigned long getEpoch();
+
+    /// Check if the expression was compiled
+    bool isEmpty() const { return nodes.empty(); }
+
+    /** Evaluate the compiled expression
+     *
+     * @param value: output value of the same type as Expression::getValueAsAny()
+     *
+     * @return Return false if the compiled form can not produce the result,
+     * in which case the expression must be evaluated as usual.
+     */
+    bool evaluate(App::any &value) const;
+
+    /// Remember the current values of all bound properties
+    void recordInputs();
+
+    /** Check if any bound property changed since the last recordInputs()
+     *
+     * Always returns true if the expression was not compiled, or if no input
+     * has been recorded since compilation.
+     */
+    bool isInputChanged() const;
+
+    struct Value {
+        enum Type {
+            TypeLong,
+            TypeDouble,
+            TypeQuantity,
+        };
+        Type type = TypeLong;
+        long l = 0;
+        double d = 0.0;
+        Base::Quantity q;
+    };
+
+private:
+    struct Node {
+        enum Type {
+            Constant,
+            Variable,
+            Operator,
+            Conditional,
+            Function,
+        };
+        Type type = Constant;
+        /// operator, function or bound property type depending on node type
+        int op = 0;
+        int args[3] = {-1, -1, -1};
+        std::size_t argc = 0;
+        Value value;
+        const Property *prop = nullptr;
+        const Expression *expr = nullptr;
+    };
+
+    CompiledExpression();
+
+    int compileNode(const Expression *expr);
+    bool evaluateNode(int index, Value &value) const;
+    static void readVariable(const Node &node, Value &value);
+
+private:
+    std::vector<Node> nodes;
+    std::vector<Value> inputs;
+    bool hasInputs = false;
+    unsigned long epoch;
+};
+
+}
+
+#endif // APP_COMPILEDEXPRESSION_H
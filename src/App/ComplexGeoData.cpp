@@ -115,6 +115,11 @@ void ComplexGeoData::getFacesFromSubelement(const Segment*,
     (void)faces;
 }
 
+Base::BoundBox3d ComplexGeoData::getSubElementBoundBox(const Segment*) const
+{
+    return Base::BoundBox3d();
+}
+
 Base::Vector3d ComplexGeoData::getPointFromLineIntersection(const Base::Vector3f& base,
                                                             const Base::Vector3f& dir) const
 {
@@ -95,6 +95,11 @@ public:
         std::vector<Base::Vector3d> &Points,
         std::vector<Base::Vector3d> &PointNormals,
         std::vector<Facet> &faces) const;
+    /** Get a cheap bounding box of the segment, used to cull sub-elements
+     * e.g. in box selection. The default implementation returns an invalid
+     * box, which means the box is unknown.
+     */
+    virtual Base::BoundBox3d getSubElementBoundBox(const Segment*) const;
     //@}
 
     /** @name Placement control */
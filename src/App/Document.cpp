@@ -87,9 +87,14 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include <unordered_set>
 #include <unordered_map>
 #include <random>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
 #include <QCoreApplication>
 #include <QCryptographicHash>
+#include <QRunnable>
+#include <QThreadPool>
 
 #include "AutoTransaction.h"
 #include "Document.h"
@@ -102,7 +107,13 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/Profiler.h>
 #include <Base/TimeInfo.h>
+#include <ctime>
+#if defined(FC_OS_LINUX) || defined(FC_OS_BSD) || defined(FC_OS_MACOSX)
+# include <sys/resource.h>
+# include <time.h>
+#endif
 #include <Base/Interpreter.h>
 #include <Base/Reader.h>
 #include <Base/Writer.h>
@@ -127,6 +138,7 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include "OriginGroupExtension.h"
 #include "Link.h"
 #include "GeoFeature.h"
+#include "PropertyPythonObject.h"
 
 FC_LOG_LEVEL_INIT("App", true, true, true)
 
@@ -162,6 +174,16 @@ namespace App {
 
 static bool _IsRestoring;
 static bool _IsRelabeling;
+// The object currently recomputed by a worker thread of the parallel
+// recompute, see Document::_recomputeParallel()
+static thread_local DocumentObject *_RecomputeWorkerObject;
+
+struct DeferredChange {
+    const TransactionalObject *who;
+    const Property *what;
+    bool before;
+};
+
 // Pimpl class
 struct DocumentP
 {
@@ -191,6 +213,34 @@ struct DocumentP
 #endif //USE_OLD_DAG
     std::multimap<const App::DocumentObject*,
         std::unique_ptr<App::DocumentObjectExecReturn> > _RecomputeLog;
+    // Guards the recompute log, the undo transaction and the deferred
+    // change signals while a parallel recompute is running
+    std::mutex recomputeMutex;
+    std::map<const App::DocumentObject*, std::vector<DeferredChange> > deferredChanges;
+    // Statistics of Document::setRecomputeProfiling(), guarded by
+    // recomputeMutex
+    bool recomputeProfiling;
+    std::map<std::string, Document::RecomputeStat> recomputeProfile;
+    // Objects whose output fingerprint did not change in the running
+    // recompute (parameter 'RecomputeEarlyCutOff'), guarded by recomputeMutex
+    bool earlyCutOff;
+    std::unordered_set<const App::DocumentObject*> unchangedOutputs;
+    // Pending change signals of Document::beginChangeBatch()
+    int changeBatchLevel;
+    std::vector<std::pair<const DocumentObject*, const Property*> > batchedChanges;
+    std::set<std::pair<const DocumentObject*, const Property*> > batchedChangeSet;
+    // Files of object properties in the last saved or restored archive. The
+    // entries of unchanged properties are copied from there on the next save.
+    struct SavedFile {
+        std::string name;
+        const PropertyContainer *container;
+        long id;
+    };
+    std::unordered_map<const Base::Persistence*, SavedFile> savedFiles;
+    std::string savedArchive;
+    unsigned int savedArchiveSize;
+    Base::TimeInfo savedArchiveTime;
+    int savedFileVersion;
 
     DocumentP() {
         static std::random_device _RD;
@@ -207,6 +257,11 @@ struct DocumentP
         undoing = false;
         committing = false;
         opentransaction = false;
+        changeBatchLevel = 0;
+        recomputeProfiling = false;
+        earlyCutOff = false;
+        savedArchiveSize = 0;
+        savedFileVersion = 0;
         StatusBits.set((size_t)Document::Closable, true);
         StatusBits.set((size_t)Document::KeepTrailingDigits, true);
         StatusBits.set((size_t)Document::Restoring, false);
@@ -215,10 +270,64 @@ struct DocumentP
         UndoMaxStackSize = 20;
     }
 
+    // Enforce the recompute of the objects depending on \a obj. With an
+    // unchanged output fingerprint only the dependents that may read other
+    // values of obj through Python or expressions are enforced.
+    void enforceDependents(App::DocumentObject *obj);
+
     void addRecomputeLog(const char *why, App::DocumentObject *obj) {
         addRecomputeLog(new DocumentObjectExecReturn(why,obj));
     }
 
+    void setSavedFiles(const Document *doc, const std::string &archive, int fileVersion,
+                       const std::map<const Base::Persistence*, std::string> &files)
+    {
+        savedFiles.clear();
+        Base::FileInfo fi(archive);
+        savedArchive = archive;
+        savedArchiveSize = fi.size();
+        savedArchiveTime = fi.lastModified();
+        savedFileVersion = fileVersion;
+        for (auto &v : files) {
+            if (!v.first->isDerivedFrom(Property::getClassTypeId()))
+                continue;
+            auto container = static_cast<const Property*>(v.first)->getContainer();
+            if (!container || !container->isDerivedFrom(DocumentObject::getClassTypeId()))
+                continue;
+            auto obj = static_cast<const DocumentObject*>(container);
+            if (obj->getDocument() != doc)
+                continue;
+            savedFiles[v.first] = SavedFile{v.second, container, obj->getID()};
+        }
+    }
+
+    // Returns the entries in the saved archive of the files that didn't
+    // change, \a files must only contain live objects
+    std::map<const Base::Persistence*, std::string> getSavedFiles(const Document *doc, int fileVersion,
+            const std::map<const Base::Persistence*, std::string> &files) const
+    {
+        std::map<const Base::Persistence*, std::string> res;
+        if (savedFiles.empty() || fileVersion != savedFileVersion)
+            return res;
+        // the archive may have been replaced in the meantime
+        Base::FileInfo fi(savedArchive);
+        if (!fi.exists() || fi.size() != savedArchiveSize || !(fi.lastModified() == savedArchiveTime))
+            return res;
+        for (auto &v : files) {
+            auto it = savedFiles.find(v.first);
+            if (it == savedFiles.end() || !v.first->isDerivedFrom(Property::getClassTypeId()))
+                continue;
+            // the address may have been reused by a property of another object
+            auto container = static_cast<const Property*>(v.first)->getContainer();
+            if (container != it->second.container
+                    || static_cast<const DocumentObject*>(container)->getDocument() != doc
+                    || static_cast<const DocumentObject*>(container)->getID() != it->second.id)
+                continue;
+            res[v.first] = it->second.name;
+        }
+        return res;
+    }
+
     void addRecomputeLog(const std::string &why, App::DocumentObject *obj) {
         addRecomputeLog(new DocumentObjectExecReturn(why,obj));
     }
@@ -228,6 +337,7 @@ struct DocumentP
             delete returnCode;
             return;
         }
+        std::lock_guard<std::mutex> lock(recomputeMutex);
         _RecomputeLog.emplace(returnCode->Which, std::unique_ptr<DocumentObjectExecReturn>(returnCode));
         returnCode->Which->setStatus(ObjectStatus::Error,true);
     }
@@ -280,8 +390,16 @@ void Document::writeDependencyGraphViz(std::ostream &out)
     out << "\tordering=out;" << endl;
     out << "\tnode [shape = box];" << endl;
 
+    auto profile = getRecomputeProfile();
     for (auto It = d->objectMap.begin(); It != d->objectMap.end();++It) {
-        out << "\t" << It->first << ";" <<endl;
+        // annotate the node with the recompute profile, if any
+        auto stat = profile.find(It->first);
+        if (stat != profile.end()) {
+            out << "\t" << It->first << " [label=\"" << It->first << "\\n"
+                << stat->second.wallTime << " s (" << stat->second.calls << ")\"];" << endl;
+        }
+        else
+            out << "\t" << It->first << ";" <<endl;
         std::vector<DocumentObject*> OutList = It->second->getOutList();
         for (std::vector<DocumentObject*>::const_iterator It2=OutList.begin();It2!=OutList.end();++It2)
             if (*It2)
@@ -1240,6 +1358,20 @@ void Document::_commitTransaction(bool notify)
             delete mUndoTransactions.front();
             mUndoTransactions.pop_front();
         }
+        // check the stack for the memory limit, but always keep the
+        // transaction just committed
+        if(d->UndoMemSize) {
+            unsigned int size = 0;
+            for (auto trans : mUndoTransactions)
+                size += trans->getMemSize();
+            while(size > d->UndoMemSize && mUndoTransactions.size() > 1) {
+                Transaction *trans = mUndoTransactions.front();
+                size -= std::min(size, trans->getMemSize());
+                mUndoMap.erase(trans->getID());
+                delete trans;
+                mUndoTransactions.pop_front();
+            }
+        }
         signalCommitTransaction(*this);
 
         // closeActiveTransaction() may call again _commitTransaction()
@@ -1436,7 +1568,14 @@ int Document::getUndoMode(void) const
 
 unsigned int Document::getUndoMemSize (void) const
 {
-    return d->UndoMemSize;
+    unsigned int size = 0;
+    for (auto trans : mUndoTransactions)
+        size += trans->getMemSize();
+    for (auto trans : mRedoTransactions)
+        size += trans->getMemSize();
+    if (d->activeUndoTransaction)
+        size += d->activeUndoTransaction->getMemSize();
+    return size;
 }
 
 void Document::setUndoLimit(unsigned int UndoMemSize)
@@ -1444,6 +1583,11 @@ void Document::setUndoLimit(unsigned int UndoMemSize)
     d->UndoMemSize = UndoMemSize;
 }
 
+unsigned int Document::getUndoLimit(void) const
+{
+    return d->UndoMemSize;
+}
+
 void Document::setMaxUndoStackSize(unsigned int UndoMaxStackSize)
 {
      d->UndoMaxStackSize = UndoMaxStackSize;
@@ -1507,6 +1651,19 @@ void Document::onChanged(const Property* prop)
 
 void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Property *What)
 {
+    if(_RecomputeWorkerObject) {
+        // Called from a worker thread of a parallel recompute. Record the
+        // change and let the main thread emit the signal once the object
+        // is done.
+        std::lock_guard<std::mutex> lock(d->recomputeMutex);
+        d->deferredChanges[_RecomputeWorkerObject].push_back({Who,What,true});
+        if(!d->rollback && !_IsRelabeling) {
+            _checkTransaction(0,What,__LINE__);
+            if (d->activeUndoTransaction)
+                d->activeUndoTransaction->addObjectChange(Who,What);
+        }
+        return;
+    }
     if(Who->isDerivedFrom(App::DocumentObject::getClassTypeId()))
         signalBeforeChangeObject(*static_cast<const App::DocumentObject*>(Who), *What);
     if(!d->rollback && !_IsRelabeling) {
@@ -1518,9 +1675,83 @@ void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Prop
 
 void Document::onChangedProperty(const DocumentObject *Who, const Property *What)
 {
+    if(_RecomputeWorkerObject) {
+        std::lock_guard<std::mutex> lock(d->recomputeMutex);
+        d->savedFiles.erase(What);
+        d->deferredChanges[_RecomputeWorkerObject].push_back({Who,What,false});
+        return;
+    }
+    // the file of the property must be written again on the next save
+    d->savedFiles.erase(What);
+    if(d->changeBatchLevel) {
+        if(d->batchedChangeSet.insert(std::make_pair(Who,What)).second)
+            d->batchedChanges.emplace_back(Who,What);
+        return;
+    }
     signalChangedObject(*Who, *What);
 }
 
+void Document::beginChangeBatch()
+{
+    ++d->changeBatchLevel;
+}
+
+void Document::endChangeBatch()
+{
+    if(d->changeBatchLevel <= 0) {
+        FC_WARN("Unbalanced change batch in document " << getName());
+        return;
+    }
+    if(--d->changeBatchLevel)
+        return;
+
+    // Signals may cause further changes, which are now emitted directly
+    std::vector<std::pair<const DocumentObject*, const Property*> > changes;
+    changes.swap(d->batchedChanges);
+    d->batchedChangeSet.clear();
+    for(auto &change : changes) {
+        // The property may have been removed in the mean time
+        if(change.first->getPropertyName(change.second))
+            signalChangedObject(*change.first, *change.second);
+    }
+}
+
+bool Document::isBatchingChanges() const
+{
+    return d->changeBatchLevel > 0;
+}
+
+static void _dropBatchedChanges(DocumentP *d, const std::set<DocumentObject*> &objs)
+{
+    if(d->batchedChanges.empty())
+        return;
+    auto &changes = d->batchedChanges;
+    changes.erase(std::remove_if(changes.begin(), changes.end(),
+        [&objs](const std::pair<const DocumentObject*, const Property*> &change) {
+            return objs.count(const_cast<DocumentObject*>(change.first)) > 0;
+        }), changes.end());
+    for(auto it=d->batchedChangeSet.begin(); it!=d->batchedChangeSet.end();) {
+        if(objs.count(const_cast<DocumentObject*>(it->first)))
+            it = d->batchedChangeSet.erase(it);
+        else
+            ++it;
+    }
+}
+
+static void _dropBatchedChanges(DocumentP *d, const DocumentObject *obj)
+{
+    if(d->batchedChanges.empty())
+        return;
+    auto &changes = d->batchedChanges;
+    changes.erase(std::remove_if(changes.begin(), changes.end(),
+        [obj](const std::pair<const DocumentObject*, const Property*> &change) {
+            return change.first == obj;
+        }), changes.end());
+    for(auto it=d->batchedChangeSet.lower_bound(std::make_pair(obj,(const Property*)0));
+            it!=d->batchedChangeSet.end() && it->first==obj;)
+        it = d->batchedChangeSet.erase(it);
+}
+
 void Document::setTransactionMode(int iMode)
 {
     d->iTransactionMode = iMode;
@@ -1710,6 +1941,7 @@ void Document::Save (Base::Writer &writer) const
 
 void Document::Restore(Base::XMLReader &reader)
 {
+    FC_PROFILE_ZONE_DETAIL("Document::Restore", getName());
     int i,Cnt;
     d->touchedObjs.clear();
     setStatus(Document::PartialDoc,false);
@@ -2591,6 +2823,7 @@ private:
 
 bool Document::saveToFile(const char* filename) const
 {
+    FC_PROFILE_ZONE_DETAIL("Document::saveToFile", filename);
     signalStartSave(*this, filename);
 
     auto hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
@@ -2610,6 +2843,8 @@ bool Document::saveToFile(const char* filename) const
         fn += uuid;
     }
     Base::FileInfo tmp(fn);
+    std::map<const Base::Persistence*, std::string> files;
+    int fileVersion = 0;
 
     // open extra scope to close ZipWriter properly
     {
@@ -2621,9 +2856,16 @@ bool Document::saveToFile(const char* filename) const
 
         writer.setComment("FreeCAD Document");
         writer.setLevel(compression);
+        writer.setParallelDeflate(hGrp->GetBool("ParallelSave", true));
         writer.putNextEntry("Document.xml");
 
-        if (hGrp->GetBool("SaveBinaryBrep", false))
+        // a per document choice stored in Meta overrides the user preference
+        const std::string& shapeFormat = Meta["ShapeFormat"];
+        if (shapeFormat == "compact")
+            writer.setMode("CompactBrep");
+        else if (shapeFormat == "binary")
+            writer.setMode("BinaryBrep");
+        else if (shapeFormat.empty() && hGrp->GetBool("SaveBinaryBrep", false))
             writer.setMode("BinaryBrep");
 
         writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << endl
@@ -2635,12 +2877,23 @@ bool Document::saveToFile(const char* filename) const
         // Special handling for Gui document.
         signalSaveDocument(writer);
 
+        // copy the files of unchanged properties from the last saved archive,
+        // unless it's overwritten in place
+        files = writer.getFileMap();
+        if (hGrp->GetBool("IncrementalSave", true)
+                && Base::FileInfo(d->savedArchive).filePath() != tmp.filePath())
+            writer.setPreviousArchive(d->savedArchive, d->getSavedFiles(this, writer.getFileVersion(), files));
+
         // write additional files
         writer.writeFiles();
 
         if (writer.hasErrors()) {
             throw Base::FileException("Failed to write all data to file", tmp);
         }
+        if (writer.getCopiedFiles())
+            FC_LOG("Copied " << writer.getCopiedFiles() << " of " << files.size()
+                    << " files from " << d->savedArchive);
+        fileVersion = writer.getFileVersion();
 
         GetApplication().signalSaveDocument(*this);
     }
@@ -2672,6 +2925,8 @@ bool Document::saveToFile(const char* filename) const
         policy.apply(fn, filename);
     }
 
+    d->setSavedFiles(this, filename, fileVersion, files);
+
     signalFinishSave(*this, filename);
 
     return true;
@@ -2683,8 +2938,9 @@ bool Document::isAnyRestoring() {
 
 // Open the document
 void Document::restore (const char *filename,
-        bool delaySignal, const std::set<std::string> &objNames)
+        bool delaySignal, const std::set<std::string> &objNames, std::istream *stream)
 {
+    FC_PROFILE_ZONE_DETAIL("Document::restore", filename);
     clearUndos();
     d->activeObject = 0;
 
@@ -2721,7 +2977,12 @@ void Document::restore (const char *filename,
     if(!filename)
         filename = FileName.getValue();
     Base::FileInfo fi(filename);
-    Base::ifstream file(fi, std::ios::in | std::ios::binary);
+    std::unique_ptr<Base::ifstream> ifile;
+    if (!stream) {
+        ifile.reset(new Base::ifstream(fi, std::ios::in | std::ios::binary));
+        stream = ifile.get();
+    }
+    std::istream &file = *stream;
     std::streambuf* buf = file.rdbuf();
     std::streamoff size = buf->pubseekoff(0, std::ios::end, std::ios::in);
     buf->pubseekoff(0, std::ios::beg, std::ios::in);
@@ -2756,8 +3017,26 @@ void Document::restore (const char *filename,
     // Note: This file doesn't need to be available if the document has been created
     // without GUI. But if available then follow after all data files of the App document.
     signalRestoreDocument(reader);
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Document");
+    reader.setParallelFiles(hGrp->GetBool("ParallelRestore",true));
+    // Objects may only keep referring to the archive if it is the document
+    // file itself, and not e.g. a recovery file
+    reader.setLazyFiles(hGrp->GetBool("LazyRestore",false)
+            && fi.filePath() == Base::FileInfo(FileName.getValue()).filePath());
     reader.readFiles(zipstream);
 
+    // the files of the archive can be copied on the next save
+    if (ifile && !testStatus(Document::PartialDoc)) {
+        std::map<const Base::Persistence*, std::string> files;
+        for (auto &entry : reader.FileList)
+            files[entry.Object] = entry.FileName;
+        d->setSavedFiles(this, fi.filePath(), reader.FileVersion, files);
+    }
+    else {
+        d->savedFiles.clear();
+    }
+
     if (reader.testStatus(Base::XMLReader::ReaderStatus::PartialRestore)) {
         setStatus(Document::PartialRestore, true);
         Base::Console().Error("There were errors while loading the file. Some data might have been modified or not recovered at all. Look above for more specific information about the objects involved.\n");
@@ -2791,15 +3070,20 @@ bool Document::afterRestore(const std::vector<DocumentObject *> &objArray, bool
     // API is not called in object dedpenency order, because the order
     // information is not ready yet.
     std::map<DocumentObject*, std::vector<App::Property*> > propMap;
-    for(auto obj : objArray) {
-        auto &props = propMap[obj];
-        obj->getPropertyList(props);
-        for(auto prop : props) {
-            try {
-                prop->afterRestore();
-            } catch (const Base::Exception& e) {
-                FC_ERR("Failed to restore " << obj->getFullName()
-                        << '.' << prop->getName() << ": " << e.what());
+    {
+        // no objects are added or renamed here, so repeated expressions
+        // can be copied instead of parsed again
+        ExpressionParser::ExpressionCache exprCache;
+        for(auto obj : objArray) {
+            auto &props = propMap[obj];
+            obj->getPropertyList(props);
+            for(auto prop : props) {
+                try {
+                    prop->afterRestore();
+                } catch (const Base::Exception& e) {
+                    FC_ERR("Failed to restore " << obj->getFullName()
+                            << '.' << prop->getName() << ": " << e.what());
+                }
             }
         }
     }
@@ -3440,6 +3724,7 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     d->clearRecomputeLog();
 
     FC_TIME_INIT(t);
+    FC_PROFILE_ZONE_DETAIL("Document::recompute", getName());
 
     Base::ObjectStatusLocker<Document::Status, Document> exe(Document::Recomputing, this);
     signalBeforeRecompute(*this);
@@ -3471,6 +3756,9 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     ParameterGrp::handle hGrp = GetApplication().GetParameterGroupByPath(
             "User parameter:BaseApp/Preferences/Document");
     bool canAbort = hGrp->GetBool("CanAbortRecompute",true);
+    bool parallel = hGrp->GetBool("ParallelRecompute",false);
+    d->earlyCutOff = hGrp->GetBool("RecomputeEarlyCutOff",false);
+    d->unchangedOutputs.clear();
 
     std::set<App::DocumentObject *> filter;
     size_t idx = 0;
@@ -3484,6 +3772,8 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
             if(canAbort)
                 seq.reset(new Base::SequencerLauncher("Recompute...", topoSortedObjects.size()));
             FC_LOG("Recompute pass " << passes);
+            if(parallel && !_recomputeParallel(topoSortedObjects,idx,filter,objectCount,hasError,seq.get()))
+                passes = 2;
             for (; idx < topoSortedObjects.size(); ++idx) {
                 auto obj = topoSortedObjects[idx];
                 if(!obj->getNameInDocument() || filter.find(obj)!=filter.end())
@@ -3512,8 +3802,7 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
                     signalRecomputedObject(*obj);
                     obj->purgeTouched();
                     // set all dependent object touched to force recompute
-                    for (auto inObjIt : obj->getInList())
-                        inObjIt->enforceRecompute();
+                    d->enforceDependents(obj);
                 }
                 if (seq)
                     seq->next(true);
@@ -3542,6 +3831,9 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
 
     FC_TIME_LOG(t2, "Recompute");
 
+    d->earlyCutOff = false;
+    d->unchangedOutputs.clear();
+
     for(auto obj : topoSortedObjects) {
         if(!obj->getNameInDocument())
             continue;
@@ -3736,17 +4028,123 @@ const char * Document::getErrorDescription(const App::DocumentObject*Obj) const
 }
 
 // call the recompute of the Feature and handle the exceptions and errors.
+namespace {
+
+// CPU time in seconds of the calling thread. Falls back to the process CPU
+// time where not available.
+double _threadCpuTime()
+{
+#if defined(FC_OS_LINUX) || defined(FC_OS_BSD) || defined(FC_OS_MACOSX)
+    struct timespec ts;
+    if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+    return double(std::clock()) / CLOCKS_PER_SEC;
+}
+
+// Peak resident memory of the process in KB, or zero if not available
+long _peakMemory()
+{
+#if defined(FC_OS_LINUX) || defined(FC_OS_BSD) || defined(FC_OS_MACOSX)
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0) {
+# if defined(FC_OS_MACOSX)
+        return usage.ru_maxrss / 1024;
+# else
+        return usage.ru_maxrss;
+# endif
+    }
+#endif
+    return 0;
+}
+
+// Measures one call of Document::_recomputeFeature() if profiling is enabled
+class RecomputeProfiler
+{
+public:
+    RecomputeProfiler(DocumentP *d, DocumentObject *obj)
+        : d(d->recomputeProfiling ? d : nullptr), obj(obj)
+    {
+        if(this->d) {
+            cpuTime = _threadCpuTime();
+            peakMemory = _peakMemory();
+        }
+    }
+
+    ~RecomputeProfiler()
+    {
+        if(!d || !obj->getNameInDocument())
+            return;
+        Base::TimeInfo end;
+        double cpu = _threadCpuTime() - cpuTime;
+        long memory = _peakMemory() - peakMemory;
+        std::lock_guard<std::mutex> lock(d->recomputeMutex);
+        auto &stat = d->recomputeProfile[obj->getNameInDocument()];
+        ++stat.calls;
+        stat.wallTime += Base::TimeInfo::diffTimeF(start, end);
+        stat.cpuTime += cpu;
+        stat.expressionTime += expressionTime;
+        stat.peakMemoryDelta = std::max(stat.peakMemoryDelta, memory);
+    }
+
+    DocumentObjectExecReturn *executeExpressions(PropertyExpressionEngine::ExecuteOption option)
+    {
+        if(!d)
+            return obj->ExpressionEngine.execute(option);
+        Base::TimeInfo begin;
+        auto ret = obj->ExpressionEngine.execute(option);
+        expressionTime += Base::TimeInfo::diffTimeF(begin, Base::TimeInfo());
+        return ret;
+    }
+
+private:
+    DocumentP *d;
+    DocumentObject *obj;
+    Base::TimeInfo start;
+    double cpuTime = 0.0;
+    double expressionTime = 0.0;
+    long peakMemory = 0;
+};
+
+} // anonymous namespace
+
+void Document::setRecomputeProfiling(bool enable)
+{
+    d->recomputeProfiling = enable;
+}
+
+bool Document::isRecomputeProfiling() const
+{
+    return d->recomputeProfiling;
+}
+
+std::map<std::string, Document::RecomputeStat> Document::getRecomputeProfile() const
+{
+    std::lock_guard<std::mutex> lock(d->recomputeMutex);
+    return d->recomputeProfile;
+}
+
+void Document::clearRecomputeProfile()
+{
+    std::lock_guard<std::mutex> lock(d->recomputeMutex);
+    d->recomputeProfile.clear();
+}
+
 int Document::_recomputeFeature(DocumentObject* Feat)
 {
     FC_LOG("Recomputing " << Feat->getFullName());
+    FC_PROFILE_ZONE_DETAIL("Document::_recomputeFeature", Feat->getNameInDocument());
 
+    RecomputeProfiler profiler(d, Feat);
+    std::size_t fingerprint = 0;
+    bool hasFingerprint = d->earlyCutOff && Feat->getOutputFingerprint(fingerprint);
     DocumentObjectExecReturn  *returnCode = 0;
     try {
-        returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+        returnCode = profiler.executeExpressions(PropertyExpressionEngine::ExecuteNonOutput);
         if (returnCode == DocumentObject::StdReturn) {
             returnCode = Feat->recompute();
             if(returnCode == DocumentObject::StdReturn)
-                returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteOutput);
+                returnCode = profiler.executeExpressions(PropertyExpressionEngine::ExecuteOutput);
         }
     }
     catch(Base::AbortException &e){
@@ -3781,6 +4179,14 @@ int Document::_recomputeFeature(DocumentObject* Feat)
 
     if (returnCode == DocumentObject::StdReturn) {
         Feat->resetError();
+        std::size_t newFingerprint = 0;
+        if (hasFingerprint && Feat->getOutputFingerprint(newFingerprint)
+                && newFingerprint == fingerprint)
+        {
+            FC_LOG("Output of " << Feat->getFullName() << " unchanged");
+            std::lock_guard<std::mutex> lock(d->recomputeMutex);
+            d->unchangedOutputs.insert(Feat);
+        }
     }
     else {
         returnCode->Which = Feat;
@@ -3791,6 +4197,280 @@ int Document::_recomputeFeature(DocumentObject* Feat)
     return 0;
 }
 
+namespace {
+
+class RecomputeTask : public QRunnable
+{
+public:
+    explicit RecomputeTask(const std::function<void()> &func)
+        : func(func)
+    {
+    }
+    void run() override
+    {
+        func();
+    }
+
+private:
+    std::function<void()> func;
+};
+
+// Objects that may execute Python code during recompute are kept out of the
+// worker threads. They are recomputed one at a time in the calling thread.
+bool needsPythonLane(DocumentObject *obj)
+{
+    auto proxy = obj->getPropertyByName("Proxy");
+    if(proxy && proxy->isDerivedFrom(PropertyPythonObject::getClassTypeId()))
+        return true;
+    return obj->ExpressionEngine.numExpressions() > 0;
+}
+
+} // anonymous namespace
+
+void DocumentP::enforceDependents(DocumentObject *obj)
+{
+    bool unchanged;
+    {
+        std::lock_guard<std::mutex> lock(recomputeMutex);
+        unchanged = unchangedOutputs.erase(obj) > 0;
+    }
+    for (auto inObj : obj->getInList()) {
+        if (unchanged && !needsPythonLane(inObj)) {
+            FC_LOG("Skip recompute of " << inObj->getFullName());
+            continue;
+        }
+        inObj->enforceRecompute();
+    }
+}
+
+/*!
+  Recompute the objects starting at \a idx of the dependency sorted list
+  \a objs. An object is scheduled as soon as all of its dependencies inside
+  the list are done, so independent branches of the dependency graph run on
+  a pool of worker threads at the same time. Objects that need the Python
+  interpreter are recomputed by the calling thread.
+
+  The property change signals of objects recomputed by a worker thread are
+  deferred and emitted by the calling thread after the object is done, so
+  that observers (e.g. view providers) are never called concurrently.
+
+  \return false if the recompute was aborted by the user.
+ */
+bool Document::_recomputeParallel(const std::vector<DocumentObject*> &objs, size_t &idx,
+        std::set<DocumentObject*> &filter, int &objectCount, bool *hasError,
+        Base::SequencerLauncher *seq)
+{
+    enum State {
+        Waiting,
+        Queued,
+        Done,
+    };
+
+    std::unordered_map<DocumentObject*, size_t> indices;
+    for(size_t i=idx; i<objs.size(); ++i)
+        indices.emplace(objs[i], i);
+
+    std::vector<int> pending(objs.size(), 0);
+    std::vector<State> states(objs.size(), Done);
+    std::vector<std::vector<size_t> > dependents(objs.size());
+    std::set<size_t> ready;
+    for(size_t i=idx; i<objs.size(); ++i) {
+        states[i] = Waiting;
+        auto outList = objs[i]->getOutList();
+        std::sort(outList.begin(), outList.end());
+        outList.erase(std::unique(outList.begin(), outList.end()), outList.end());
+        for(auto dep : outList) {
+            auto it = indices.find(dep);
+            if(it == indices.end() || it->second == i)
+                continue;
+            ++pending[i];
+            dependents[it->second].push_back(i);
+        }
+        if(!pending[i]) {
+            states[i] = Queued;
+            ready.insert(i);
+        }
+    }
+
+    ParameterGrp::handle hGrp = GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Document");
+    int threads = hGrp->GetInt("RecomputeThreads",0);
+
+    QThreadPool pool;
+    if(threads > 0)
+        pool.setMaxThreadCount(threads);
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<std::pair<size_t,int> > finished;
+    std::deque<size_t> pythonLane;
+    int running = 0;
+    size_t remaining = objs.size() - idx;
+    bool aborted = false;
+    idx = objs.size();
+
+    auto waitForWorkers = [&]() {
+        std::unique_ptr<Base::PyGILStateRelease> release;
+        if(PyGILState_Check())
+            release.reset(new Base::PyGILStateRelease);
+        pool.waitForDone();
+    };
+
+    auto flushChanges = [&](DocumentObject *obj) {
+        std::vector<DeferredChange> changes;
+        {
+            std::lock_guard<std::mutex> lock(d->recomputeMutex);
+            auto it = d->deferredChanges.find(obj);
+            if(it == d->deferredChanges.end())
+                return;
+            changes.swap(it->second);
+            d->deferredChanges.erase(it);
+        }
+        for(auto &change : changes) {
+            if(!change.who->isDerivedFrom(App::DocumentObject::getClassTypeId()))
+                continue;
+            auto who = static_cast<const App::DocumentObject*>(change.who);
+            if(change.before)
+                signalBeforeChangeObject(*who, *change.what);
+            else
+                onChangedProperty(who, change.what);
+        }
+    };
+
+    // must be called by the calling thread once an object is done
+    auto finish = [&](size_t i, bool recomputed, int res) {
+        auto obj = objs[i];
+        states[i] = Done;
+        --remaining;
+        flushChanges(obj);
+        if(res) {
+            if(hasError)
+                *hasError = true;
+            if(res < 0) {
+                aborted = true;
+            } else {
+                // filter all object in its inListRecursive from the queue
+                obj->getInListEx(filter,true);
+                filter.insert(obj);
+            }
+        } else if(obj->getNameInDocument()) {
+            if(obj->isTouched() || recomputed) {
+                signalRecomputedObject(*obj);
+                obj->purgeTouched();
+                // set all dependent object touched to force recompute
+                d->enforceDependents(obj);
+            }
+        }
+        for(auto dep : dependents[i]) {
+            if(--pending[dep] <= 0 && states[dep] == Waiting) {
+                states[dep] = Queued;
+                ready.insert(dep);
+            }
+        }
+        if(seq && !res)
+            seq->next(true);
+    };
+
+    try {
+        while(remaining) {
+            while(!ready.empty() && !aborted) {
+                size_t i = *ready.begin();
+                ready.erase(ready.begin());
+                auto obj = objs[i];
+                if(!obj->getNameInDocument() || filter.find(obj)!=filter.end()) {
+                    states[i] = Done;
+                    --remaining;
+                    for(auto dep : dependents[i]) {
+                        if(--pending[dep] <= 0 && states[dep] == Waiting) {
+                            states[dep] = Queued;
+                            ready.insert(dep);
+                        }
+                    }
+                    continue;
+                }
+                // ask the object if it should be recomputed
+                if(!obj->mustRecompute()) {
+                    finish(i,false,0);
+                    continue;
+                }
+                ++objectCount;
+                if(needsPythonLane(obj)) {
+                    pythonLane.push_back(i);
+                    continue;
+                }
+                ++running;
+                pool.start(new RecomputeTask([&,i,obj]() {
+                    int res = 1;
+                    _RecomputeWorkerObject = obj;
+                    try {
+                        res = _recomputeFeature(obj);
+                    }
+                    catch (...) {
+                        FC_ERR("Unknown exception in " << obj->getFullName() << " thrown");
+                        d->addRecomputeLog("Unknown exception!",obj);
+                    }
+                    _RecomputeWorkerObject = nullptr;
+                    std::lock_guard<std::mutex> lock(mutex);
+                    finished.emplace_back(i,res);
+                    cond.notify_one();
+                }));
+            }
+
+            if(!aborted && !pythonLane.empty()) {
+                size_t i = pythonLane.front();
+                pythonLane.pop_front();
+                int res;
+                {
+                    Base::PyGILStateLocker lock;
+                    res = _recomputeFeature(objs[i]);
+                }
+                finish(i,true,res);
+                continue;
+            }
+
+            if(!running) {
+                if(aborted || !ready.empty())
+                    break;
+                // Only objects with cyclic dependencies are left. Resolve
+                // them one by one in the order of the sorted list.
+                for(size_t i=0; i<objs.size(); ++i) {
+                    if(states[i] == Waiting) {
+                        states[i] = Queued;
+                        ready.insert(i);
+                        break;
+                    }
+                }
+                if(ready.empty())
+                    break;
+                continue;
+            }
+
+            std::deque<std::pair<size_t,int> > results;
+            {
+                std::unique_ptr<Base::PyGILStateRelease> release;
+                if(PyGILState_Check())
+                    release.reset(new Base::PyGILStateRelease);
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&finished]() {return !finished.empty();});
+                results.swap(finished);
+            }
+            for(auto &result : results) {
+                --running;
+                finish(result.first,true,result.second);
+            }
+        }
+    }
+    catch (...) {
+        waitForWorkers();
+        for(size_t i=0; i<objs.size(); ++i)
+            flushChanges(objs[i]);
+        throw;
+    }
+
+    waitForWorkers();
+    return !aborted;
+}
+
 bool Document::recomputeFeature(DocumentObject* Feat, bool recursive)
 {
     // delete recompute log
@@ -3853,6 +4533,7 @@ DocumentObject * Document::addObject(const char* sType, const char* pObjectName,
     d->objectIdMap[pcObject->_Id] = pcObject;
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    DocumentObject::_clearRecursiveListCache();
     // insert in the vector
     d->objectArray.push_back(pcObject);
     // insert in the adjacence list and reference through the ConectionMap
@@ -3894,18 +4575,36 @@ DocumentObject * Document::addObject(const char* sType, const char* pObjectName,
 
 std::vector<DocumentObject *> Document::addObjects(const char* sType, const std::vector<std::string>& objectNames, bool isNew)
 {
-    Base::Type::importModule(sType);
-    Base::Type type = Base::Type::fromName(sType);
-    if (!type.isDerivedFrom(App::DocumentObject::getClassTypeId())) {
-        std::stringstream str;
-        str << "'" << sType << "' is not a document object type";
-        throw Base::TypeError(str.str());
+    return addObjects(std::vector<std::string>(objectNames.size(), sType), objectNames, isNew);
+}
+
+std::vector<DocumentObject *> Document::addObjects(const std::vector<std::string>& types,
+        const std::vector<std::string>& objectNames, bool isNew)
+{
+    if (types.size() != objectNames.size())
+        throw Base::ValueError("Number of object types and names differ");
+
+    std::map<std::string, Base::Type> typeMap;
+    for (const auto &sType : types) {
+        if (typeMap.count(sType))
+            continue;
+        Base::Type::importModule(sType.c_str());
+        Base::Type type = Base::Type::fromName(sType.c_str());
+        if (!type.isDerivedFrom(App::DocumentObject::getClassTypeId())) {
+            std::stringstream str;
+            str << "'" << sType << "' is not a document object type";
+            throw Base::TypeError(str.str());
+        }
+        typeMap[sType] = type;
     }
 
     std::vector<DocumentObject *> objects;
-    objects.resize(objectNames.size());
-    std::generate(objects.begin(), objects.end(),
-                  [&]{ return static_cast<App::DocumentObject*>(type.createInstance()); });
+    objects.reserve(types.size());
+    for (const auto &sType : types)
+        objects.push_back(static_cast<App::DocumentObject*>(typeMap[sType].createInstance()));
+
+    // signal the property changes of setupObject() once all objects exist
+    DocumentChangeBatch batch(this);
 
     // get all existing object names
     std::vector<std::string> reservedNames;
@@ -3931,7 +4630,7 @@ std::vector<DocumentObject *> Document::addObjects(const char* sType, const std:
         // get unique name
         std::string ObjectName = objectNames[index];
         if (ObjectName.empty())
-            ObjectName = sType;
+            ObjectName = types[index];
         ObjectName = Base::Tools::getIdentifier(ObjectName);
         if (d->objectMap.find(ObjectName) != d->objectMap.end()) {
             // remove also trailing digits from clean name which is to avoid to create lengthy names
@@ -3955,6 +4654,7 @@ std::vector<DocumentObject *> Document::addObjects(const char* sType, const std:
         d->objectIdMap[pcObject->_Id] = pcObject;
         // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
         pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+        DocumentObject::_clearRecursiveListCache();
         // insert in the vector
         d->objectArray.push_back(pcObject);
 
@@ -4019,6 +4719,7 @@ void Document::addObject(DocumentObject* pcObject, const char* pObjectName)
     d->objectIdMap[pcObject->_Id] = pcObject;
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    DocumentObject::_clearRecursiveListCache();
     // insert in the vector
     d->objectArray.push_back(pcObject);
 
@@ -4050,6 +4751,7 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
     d->objectArray.push_back(pcObject);
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    DocumentObject::_clearRecursiveListCache();
 
     // do no transactions if we do a rollback!
     if (!d->rollback) {
@@ -4079,8 +4781,8 @@ void Document::removeObject(const char* sName)
 {
     auto pos = d->objectMap.find(sName);
 
-    // name not found?
-    if (pos == d->objectMap.end())
+    // name not found or already being removed, e.g. by removeObjects()?
+    if (pos == d->objectMap.end() || pos->second->testStatus(ObjectStatus::Remove))
         return;
 
     if (pos->second->testStatus(ObjectStatus::PendingRecompute)) {
@@ -4125,6 +4827,7 @@ void Document::removeObject(const char* sName)
     }
 
     signalDeletedObject(*(pos->second));
+    _dropBatchedChanges(d, pos->second);
 
     // do no transactions if we do a rollback!
     if (!d->rollback && d->activeUndoTransaction) {
@@ -4188,6 +4891,119 @@ void Document::removeObject(const char* sName)
     d->objectMap.erase(pos);
 }
 
+void Document::removeObjects(const std::vector<DocumentObject*>& objs)
+{
+    // Refer to the objects by ID, unsetupObject() may remove some of them
+    std::vector<long> ids;
+    std::set<long> idSet;
+    for (auto obj : objs) {
+        if (!obj || obj->getDocument() != this || !obj->getNameInDocument())
+            continue;
+        if (obj->testStatus(ObjectStatus::PendingRecompute)) {
+            FC_LOG("pending remove of " << obj->getNameInDocument()
+                    << " after recomputing document " << getName());
+            obj->setStatus(ObjectStatus::PendingRemove,true);
+            continue;
+        }
+        if (idSet.insert(obj->_Id).second)
+            ids.push_back(obj->_Id);
+    }
+    if (ids.empty())
+        return;
+
+    TransactionLocker tlock;
+    std::vector<std::unique_ptr<DocumentObject> > tobedestroyed;
+    DocumentChangeBatch batch(this);
+
+    for (auto id : ids) {
+        if (d->activeUndoTransaction)
+            break;
+        _checkTransaction(d->objectIdMap[id],0,__LINE__);
+    }
+
+    std::vector<DocumentObject*> removed;
+    removed.reserve(ids.size());
+    for (auto id : ids) {
+        auto it = d->objectIdMap.find(id);
+        if (it == d->objectIdMap.end())
+            continue;
+        auto obj = it->second;
+        removed.push_back(obj);
+
+        if (d->activeObject == obj)
+            d->activeObject = 0;
+
+        // Mark the object as about to be deleted
+        obj->setStatus(ObjectStatus::Remove, true);
+        if (!d->undoing && !d->rollback) {
+            obj->unsetupObject();
+        }
+
+        signalDeletedObject(*obj);
+
+        // do no transactions if we do a rollback!
+        if (!d->rollback && d->activeUndoTransaction)
+            signalTransactionRemove(*obj, d->activeUndoTransaction);
+        else
+            signalTransactionRemove(*obj, 0);
+
+#ifdef USE_OLD_DAG
+        for (auto &v : d->vertexMap) {
+            if (v.second == obj) {
+                v.second = 0;
+                break;
+            }
+        }
+#endif //USE_OLD_DAG
+    }
+
+    // the objects removed in the mean time by unsetupObject() are gone
+    removed.erase(std::remove_if(removed.begin(), removed.end(),
+        [this](DocumentObject *obj) {
+            auto it = d->objectIdMap.find(obj->_Id);
+            return it == d->objectIdMap.end() || it->second != obj;
+        }), removed.end());
+
+    // Before deleting we must nullify all dependent objects
+    std::set<DocumentObject*> removedSet(removed.begin(), removed.end());
+    PropertyLinkBase::breakLinks(removedSet, d->objectArray, true);
+    _dropBatchedChanges(d, removedSet);
+
+    //and remove the tip if needed
+    if (Tip.getValue() && removedSet.count(Tip.getValue())) {
+        Tip.setValue(nullptr);
+        TipName.setValue("");
+    }
+
+    for (auto obj : removed) {
+        // remove the ID before possibly deleting the object
+        d->objectIdMap.erase(obj->_Id);
+        // Unset the bit to be on the safe side
+        obj->setStatus(ObjectStatus::Remove, false);
+        auto pos = d->objectMap.find(*obj->pcNameInDocument);
+
+        // do no transactions if we do a rollback!
+        if (!d->rollback) {
+            // Undo stuff
+            if (d->activeUndoTransaction) {
+                // in this case transaction delete or save the object
+                d->activeUndoTransaction->addObjectNew(obj);
+            }
+            else {
+                // if not saved in undo -> delete object later
+                tobedestroyed.emplace_back(obj);
+                obj->setStatus(ObjectStatus::Destroy, true);
+            }
+        }
+        d->objectMap.erase(pos);
+    }
+
+    d->objectArray.erase(std::remove_if(d->objectArray.begin(), d->objectArray.end(),
+        [&removedSet](DocumentObject *obj) {
+            return removedSet.count(obj) > 0;
+        }), d->objectArray.end());
+}
+
 /// Remove an object out of the document (internal)
 void Document::_removeObject(DocumentObject* pcObject)
 {
@@ -4226,6 +5042,7 @@ void Document::_removeObject(DocumentObject* pcObject)
         pcObject->unsetupObject();
     }
     signalDeletedObject(*pcObject);
+    _dropBatchedChanges(d, pcObject);
     // TODO Check me if it's needed (2015-09-01, Fat-Zer)
 
     //remove the tip if needed
@@ -4271,6 +5088,123 @@ void Document::breakDependency(DocumentObject* pcObject, bool clear)
     PropertyLinkBase::breakLinks(pcObject,d->objectArray,clear);
 }
 
+// Python objects and expressions are bound to their owner. Only the import
+// of exported objects rebinds them to the copies.
+static bool _canCopyInMemory(const Document *doc, const std::vector<DocumentObject*> &objs)
+{
+    std::vector<Property*> props;
+    for (auto obj : objs) {
+        if (!obj || obj->getDocument() != doc || obj->testStatus(App::PartialObject))
+            return false;
+        props.clear();
+        obj->getPropertyList(props);
+        for (auto prop : props) {
+            if (prop->isDerivedFrom(PropertyPythonObject::getClassTypeId()))
+                return false;
+            if (prop == &obj->ExpressionEngine) {
+                if (obj->ExpressionEngine.numExpressions())
+                    return false;
+            }
+            else if (prop->isDerivedFrom(PropertyExpressionContainer::getClassTypeId()))
+                return false;
+        }
+    }
+    return true;
+}
+
+/*!
+  Copy the objects \a objs of this document through their properties, which
+  does the same as importObjects() of the exported objects without writing
+  and parsing them. Links between the copied objects are redirected to the
+  copies.
+ */
+std::vector<DocumentObject*> Document::copyObjectsInMemory(const std::vector<DocumentObject*> &objs)
+{
+    Base::FlagToggler<> flag(_IsRestoring,false);
+    Base::ObjectStatusLocker<Status, Document> restoreBit(Status::Restoring, this);
+    Base::ObjectStatusLocker<Status, Document> restoreBit2(Status::Importing, this);
+
+    // like the name mapping of the import, see readObjects()
+    bool keepDigits = testStatus(Document::KeepTrailingDigits);
+    setStatus(Document::KeepTrailingDigits, false);
+
+    std::vector<DocumentObject*> sources;
+    std::vector<DocumentObject*> copies;
+    std::unordered_map<DocumentObject*, DocumentObject*> copyMap;
+    sources.reserve(objs.size());
+    copies.reserve(objs.size());
+    for (auto src : objs) {
+        std::string viewType = src->getViewProviderNameStored();
+        if (viewType == src->getViewProviderName())
+            viewType.clear();
+        try {
+            auto obj = addObject(src->getTypeId().getName(), src->getNameInDocument(),
+                                 /*isNew=*/ false, viewType.c_str());
+            if (!obj)
+                continue;
+            sources.push_back(src);
+            copies.push_back(obj);
+            copyMap[src] = obj;
+            if (src->testStatus(ObjectStatus::Touch))
+                d->touchedObjs.insert(obj);
+            if (src->isError()) {
+                obj->setStatus(ObjectStatus::Error, true);
+                auto desc = getErrorDescription(src);
+                if (desc)
+                    d->addRecomputeLog(desc,obj);
+            }
+        }
+        catch (const Base::Exception& e) {
+            Base::Console().Error("Cannot create object '%s': (%s)\n", src->getNameInDocument(), e.what());
+        }
+    }
+    setStatus(Document::KeepTrailingDigits, keepDigits);
+
+    for (size_t i=0; i<copies.size(); ++i) {
+        copies[i]->setStatus(ObjectStatus::Restore, true);
+        copies[i]->copyProperties(*sources[i]);
+    }
+
+    std::vector<Property*> props;
+    std::vector<DocumentObject*> links;
+    for (auto obj : copies) {
+        props.clear();
+        obj->getPropertyList(props);
+        for (auto prop : props) {
+            auto linkProp = Base::freecad_dynamic_cast<PropertyLinkBase>(prop);
+            if (!linkProp)
+                continue;
+            links.clear();
+            linkProp->getLinks(links,true);
+            for (auto link : links) {
+                auto it = copyMap.find(link);
+                if (it == copyMap.end())
+                    continue;
+                std::unique_ptr<Property> copy(linkProp->CopyOnLinkReplace(obj,link,it->second));
+                if (copy)
+                    linkProp->Paste(*copy);
+            }
+        }
+    }
+
+    for (auto obj : copies) {
+        obj->setStatus(ObjectStatus::Restore, false);
+        obj->setStatus(App::ObjImporting,true);
+    }
+
+    signalCopyViewObjects(sources, copies);
+    afterRestore(copies,true);
+
+    signalFinishImportObjects(copies);
+
+    for (auto obj : copies) {
+        if (obj->getNameInDocument())
+            obj->setStatus(App::ObjImporting,false);
+    }
+
+    return copies;
+}
+
 std::vector<DocumentObject*> Document::copyObject(
     const std::vector<DocumentObject*> &objs, bool recursive, bool returnAll)
 {
@@ -4285,42 +5219,49 @@ std::vector<DocumentObject*> Document::copyObject(
                 "Document must be saved at least once before link to external objects");
     }
 
-    MergeDocuments md(this);
-    // if not copying recursively then suppress possible warnings
-    md.setVerbose(recursive);
+    std::vector<App::DocumentObject*> imported;
+    ParameterGrp::handle hGrp = GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Document");
+    if (hGrp->GetBool("CopyObjectsInMemory",true) && _canCopyInMemory(this, deps)) {
+        imported = copyObjectsInMemory(deps);
+    }
+    else {
+        MergeDocuments md(this);
+        // if not copying recursively then suppress possible warnings
+        md.setVerbose(recursive);
 
-    unsigned int memsize=1000; // ~ for the meta-information
-    for (std::vector<App::DocumentObject*>::iterator it = deps.begin(); it != deps.end(); ++it)
-        memsize += (*it)->getMemSize();
+        unsigned int memsize=1000; // ~ for the meta-information
+        for (std::vector<App::DocumentObject*>::iterator it = deps.begin(); it != deps.end(); ++it)
+            memsize += (*it)->getMemSize();
 
-    // if less than ~10 MB
-    bool use_buffer=(memsize < 0xA00000);
-    QByteArray res;
-    try {
-        res.reserve(memsize);
-    }
-    catch (const Base::MemoryException&) {
-        use_buffer = false;
-    }
+        // if less than ~10 MB
+        bool use_buffer=(memsize < 0xA00000);
+        QByteArray res;
+        try {
+            res.reserve(memsize);
+        }
+        catch (const Base::MemoryException&) {
+            use_buffer = false;
+        }
 
-    std::vector<App::DocumentObject*> imported;
-    if (use_buffer) {
-        Base::ByteArrayOStreambuf obuf(res);
-        std::ostream ostr(&obuf);
-        exportObjects(deps, ostr);
-
-        Base::ByteArrayIStreambuf ibuf(res);
-        std::istream istr(0);
-        istr.rdbuf(&ibuf);
-        imported = md.importObjects(istr);
-    } else {
-        static Base::FileInfo fi(App::Application::getTempFileName());
-        Base::ofstream ostr(fi, std::ios::out | std::ios::binary);
-        exportObjects(deps, ostr);
-        ostr.close();
+        if (use_buffer) {
+            Base::ByteArrayOStreambuf obuf(res);
+            std::ostream ostr(&obuf);
+            exportObjects(deps, ostr);
 
-        Base::ifstream istr(fi, std::ios::in | std::ios::binary);
-        imported = md.importObjects(istr);
+            Base::ByteArrayIStreambuf ibuf(res);
+            std::istream istr(0);
+            istr.rdbuf(&ibuf);
+            imported = md.importObjects(istr);
+        } else {
+            static Base::FileInfo fi(App::Application::getTempFileName());
+            Base::ofstream ostr(fi, std::ios::out | std::ios::binary);
+            exportObjects(deps, ostr);
+            ostr.close();
+
+            Base::ifstream istr(fi, std::ios::in | std::ios::binary);
+            imported = md.importObjects(istr);
+        }
     }
 
     if (returnAll || imported.size()!=deps.size())
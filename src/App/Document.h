@@ -33,6 +33,7 @@
 #include "PropertyLinks.h"
 
 #include <map>
+#include <set>
 #include <vector>
 #include <stack>
 #include <functional>
@@ -41,6 +42,7 @@
 
 namespace Base {
     class Writer;
+    class SequencerLauncher;
 }
 
 namespace App
@@ -163,6 +165,10 @@ public:
     boost::signals2::signal<void (const std::vector<App::DocumentObject*>&, Base::Reader&,
                                   const std::map<std::string, std::string>&)> signalImportViewObjects;
     boost::signals2::signal<void (const std::vector<App::DocumentObject*>&)> signalFinishImportObjects;
+    /// signal the in-memory copy of objects by copyObject(), with the
+    /// originals and their copies in the same order
+    boost::signals2::signal<void (const std::vector<App::DocumentObject*>&,
+                                  const std::vector<App::DocumentObject*>&)> signalCopyViewObjects;
     //signal starting a save action to a file
     boost::signals2::signal<void (const App::Document&, const std::string&)> signalStartSave;
     //signal finishing a save action to a file
@@ -193,9 +199,17 @@ public:
     bool save (void);
     bool saveAs(const char* file);
     bool saveCopy(const char* file) const;
-    /// Restore the document from the file in Property Path
+    /** Restore the document from the file in Property Path
+     *
+     * @param filename: the file to restore from, defaults to FileName
+     * @param delaySignal: do not call afterRestore()
+     * @param objNames: the objects to restore for partial loading
+     * @param stream: optional content of \a filename, e.g. read ahead by
+     * Application::openDocuments()
+     */
     void restore (const char *filename=0,
-            bool delaySignal=false, const std::set<std::string> &objNames={});
+            bool delaySignal=false, const std::set<std::string> &objNames={},
+            std::istream *stream=nullptr);
     void afterRestore(bool checkPartial=false);
     bool afterRestore(const std::vector<App::DocumentObject *> &, bool checkPartial=false);
     enum ExportStatus {
@@ -262,8 +276,22 @@ public:
      * @param isNew       If false don't call the \c DocumentObject::setupObject() callback (default is true)
      */
     std::vector<DocumentObject *>addObjects(const char* sType, const std::vector<std::string>& objectNames, bool isNew=true);
+    /** Add an array of features of different types.
+     * @param types       The type of each created object
+     * @param objectNames The object names, an empty name is derived from the type
+     * @param isNew       If false don't call the \c DocumentObject::setupObject() callback (default is true)
+     */
+    std::vector<DocumentObject *>addObjects(const std::vector<std::string>& types,
+            const std::vector<std::string>& objectNames, bool isNew=true);
     /// Remove a feature out of the document
     void removeObject(const char* sName);
+    /** Remove an array of features out of the document
+     * Unlike calling removeObject() for each of them, the links to the
+     * removed objects are broken in a single pass over the document, and
+     * the change signals of the objects referring to them are sent once
+     * per property when the removal is done.
+     */
+    void removeObjects(const std::vector<DocumentObject*>& objs);
     /** Add an existing feature with sName (ASCII) to this document and set it active.
      * Unicode names are set through the Label property.
      * This is an overloaded function of the function above and can be used to create
@@ -283,6 +311,11 @@ public:
      * auto included by recursive searching. If false, then only return the
      * copied object corresponding to the input objects.
      *
+     * Objects of this document are copied in memory through their
+     * properties unless they hold Python objects or expressions, or the
+     * parameter 'CopyObjectsInMemory' is off. Otherwise the objects are
+     * exported and imported again.
+     *
      * @return Returns the list of objects copied.
      */
     std::vector<DocumentObject*> copyObject(
@@ -356,6 +389,31 @@ public:
     void setStatus(Status pos, bool on);
     //@}
 
+    /** @name Recompute profiling */
+    //@{
+    /// Recompute statistics of one object
+    struct RecomputeStat {
+        /// number of recomputes of the object
+        int calls = 0;
+        /// accumulated wall time in seconds, including the expressions
+        double wallTime = 0.0;
+        /// accumulated CPU time in seconds of the recomputing thread
+        double cpuTime = 0.0;
+        /// accumulated wall time in seconds spent in the expression engine
+        double expressionTime = 0.0;
+        /// largest growth in KB of the process peak memory during one recompute
+        long peakMemoryDelta = 0;
+    };
+    /// Enable or disable collecting recompute statistics
+    void setRecomputeProfiling(bool enable);
+    /// Check if recompute statistics are collected
+    bool isRecomputeProfiling() const;
+    /// Returns the collected statistics by object name
+    std::map<std::string, RecomputeStat> getRecomputeProfile() const;
+    /// Remove all collected statistics
+    void clearRecomputeProfile();
+    //@}
+
 
     /** @name methods for the UNDO REDO and Transaction handling
      *
@@ -402,8 +460,10 @@ public:
     /// Check if a transaction is open and its list is empty.
     /// If no transaction is open true is returned.
     bool isTransactionEmpty() const;
-    /// Set the Undo limit in Byte!
+    /// Set the Undo limit in Byte! Zero means no limit.
     void setUndoLimit(unsigned int UndoMemSize=0);
+    /// Returns the Undo limit in Byte
+    unsigned int getUndoLimit(void) const;
     /// Returns the actual memory consumption of the Undo redo stuff.
     unsigned int getUndoMemSize (void) const;
     /// Set the Undo limit as stack size
@@ -430,6 +490,23 @@ public:
     void addOrRemovePropertyOfObject(TransactionalObject*, Property *prop, bool add);
     //@}
 
+    /** @name Batched change notification
+     *
+     * Between beginChangeBatch() and the matching endChangeBatch(),
+     * signalChangedObject is not emitted on each property change. The
+     * changes are instead coalesced per object and property, and signaled
+     * once, in the order of their first change, when the outermost batch
+     * ends. Calls can be nested. Changes of objects removed from the
+     * document in the meantime are dropped. Use DocumentChangeBatch to
+     * make sure the batch is ended on exceptions.
+     */
+    //@{
+    void beginChangeBatch();
+    void endChangeBatch();
+    /// Returns true if inside a change notification batch
+    bool isBatchingChanges() const;
+    //@}
+
     /** @name dependency stuff */
     //@{
     /// write GraphViz file
@@ -525,6 +602,7 @@ protected:
     void _checkTransaction(DocumentObject* pcDelObj, const Property *What, int line);
     void breakDependency(DocumentObject* pcObject, bool clear);
     std::vector<App::DocumentObject*> readObjects(Base::XMLReader& reader);
+    std::vector<App::DocumentObject*> copyObjectsInMemory(const std::vector<App::DocumentObject*> &objs);
     void writeObjects(const std::vector<App::DocumentObject*>&, Base::Writer &writer) const;
     bool saveToFile(const char* filename) const;
 
@@ -537,6 +615,11 @@ protected:
     /// helper which Recompute only this feature
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
     int _recomputeFeature(DocumentObject* Feat);
+    /// helper which recomputes independent features in parallel
+    /// @return false if aborted by user.
+    bool _recomputeParallel(const std::vector<DocumentObject*> &objs, size_t &idx,
+            std::set<DocumentObject*> &filter, int &objectCount, bool *hasError,
+            Base::SequencerLauncher *seq);
     void _clearRedos();
 
     /// refresh the internal dependency graph
@@ -576,6 +659,22 @@ private:
     std::string myName;
 };
 
+/// Helper class to batch the change notification of a document within a scope
+class AppExport DocumentChangeBatch
+{
+public:
+    DocumentChangeBatch(Document *doc) : doc(doc) {
+        if (doc)
+            doc->beginChangeBatch();
+    }
+    ~DocumentChangeBatch() {
+        if (doc)
+            doc->endChangeBatch();
+    }
+private:
+    Document *doc;
+};
+
 template<typename T>
 inline std::vector<T*> Document::getObjectsOfType() const
 {
@@ -43,6 +43,9 @@
 #include "GeoFeatureGroupExtension.h"
 #include <App/DocumentObjectPy.h>
 #include <boost/bind/bind.hpp>
+#include <boost/functional/hash.hpp>
+#include <atomic>
+#include <mutex>
 
 FC_LOG_LEVEL_INIT("App",true,true)
 
@@ -80,8 +83,151 @@ DocumentObject::DocumentObject(void)
     Visibility.setStatus(Property::NoModify,true);
 }
 
+namespace {
+// Cache of the recursive in and out lists, shared by all objects because the
+// lists span over documents. The whole cache is invalidated by bumping the
+// graph epoch on any change of the links, so that repeated queries, e.g.
+// testIfLinkDAGCompatible() during tree drag and drop, only walk the graph
+// once between changes.
+struct RecursiveListCache {
+    struct InList {
+        std::set<App::DocumentObject*> inSet;
+        std::vector<App::DocumentObject*> inList;
+    };
+    std::unordered_map<const App::DocumentObject*, InList> inLists;
+    std::unordered_map<const App::DocumentObject*, std::set<App::DocumentObject*> > outLists;
+    unsigned long epoch = 0;
+    std::size_t size = 0;
+
+    // Upper limit of the total number of cached entries, since caching the
+    // recursive lists of all objects is quadratic in the worst case.
+    static const std::size_t MaxSize = 500000;
+
+    void check(unsigned long newEpoch) {
+        if(epoch != newEpoch) {
+            clear();
+            epoch = newEpoch;
+        }
+    }
+    void clear() {
+        inLists.clear();
+        outLists.clear();
+        size = 0;
+    }
+    void reserve(std::size_t count) {
+        if(size + count > MaxSize)
+            clear();
+        size += count;
+    }
+};
+}
+
+static std::atomic<unsigned long> _GraphEpoch(1);
+static RecursiveListCache _RecursiveListCache;
+// The lists may be queried by the workers of a parallel recompute
+static std::mutex _RecursiveListCacheMutex;
+
+namespace {
+// Cache of the results of getSubObject() and getLinkedObject(), so that
+// selection, the tree view and shape lookups don't walk the group and link
+// chains again on every call. The accumulated transformation is stored
+// relative to the input matrix, because all implementations only multiply it
+// from the right. Like the recursive list cache, it is shared by all documents
+// since links span over documents. It is invalidated as a whole on any
+// property change and on any change of the object graph.
+struct SubObjectCache {
+    enum Flags {
+        Transform = 1,
+        LinkedObject = 2,
+        Recursive = 4,
+    };
+    struct Key {
+        const App::DocumentObject *obj;
+        std::string subname;
+        int flags;
+
+        bool operator==(const Key &other) const {
+            return obj == other.obj && flags == other.flags && subname == other.subname;
+        }
+    };
+    struct KeyHasher {
+        std::size_t operator()(const Key &key) const {
+            std::size_t seed = std::hash<std::string>()(key.subname);
+            boost::hash_combine(seed, key.obj);
+            boost::hash_combine(seed, key.flags);
+            return seed;
+        }
+    };
+    struct Entry {
+        App::DocumentObject *obj = nullptr;
+        Base::Matrix4D mat;
+        bool hasMatrix = false;
+    };
+    std::unordered_map<Key, Entry, KeyHasher> entries;
+    unsigned long epoch = 0;
+
+    static const std::size_t MaxSize = 100000;
+
+    void check(unsigned long newEpoch) {
+        if(epoch != newEpoch) {
+            entries.clear();
+            epoch = newEpoch;
+        }
+    }
+};
+}
+
+static std::atomic<unsigned long> _SubObjectEpoch(1);
+static SubObjectCache _SubObjectCache;
+static std::mutex _SubObjectCacheMutex;
+
+static bool getCachedSubObject(const SubObjectCache::Key &key,
+        DocumentObject *&ret, Base::Matrix4D *mat)
+{
+    std::lock_guard<std::mutex> lock(_SubObjectCacheMutex);
+    auto &cache = _SubObjectCache;
+    cache.check(_SubObjectEpoch);
+    auto it = cache.entries.find(key);
+    if(it == cache.entries.end() || (mat && !it->second.hasMatrix))
+        return false;
+    ret = it->second.obj;
+    if(mat)
+        *mat *= it->second.mat;
+    return true;
+}
+
+static void setCachedSubObject(SubObjectCache::Key &&key, unsigned long epoch,
+        DocumentObject *ret, const Base::Matrix4D *mat)
+{
+    std::lock_guard<std::mutex> lock(_SubObjectCacheMutex);
+    if(epoch != _SubObjectEpoch)
+        return;
+    auto &cache = _SubObjectCache;
+    cache.check(epoch);
+    if(cache.entries.size() >= SubObjectCache::MaxSize)
+        cache.entries.clear();
+    auto &entry = cache.entries[std::move(key)];
+    entry.obj = ret;
+    if(mat) {
+        entry.mat = *mat;
+        entry.hasMatrix = true;
+    }
+}
+
+void DocumentObject::_clearRecursiveListCache()
+{
+    ++_GraphEpoch;
+    ++_SubObjectEpoch;
+}
+
+void DocumentObject::_clearSubObjectCache()
+{
+    ++_SubObjectEpoch;
+}
+
 DocumentObject::~DocumentObject(void)
 {
+    _clearRecursiveListCache();
     if (!PythonObject.is(Py::_None())){
         Base::PyGILStateLocker lock;
         // Remark: The API of Py::Object has been changed to set whether the wrapper owns the passed
@@ -200,6 +346,12 @@ bool DocumentObject::mustRecompute(void) const
     return mustExecute() > 0;
 }
 
+bool DocumentObject::getOutputFingerprint(std::size_t &fingerprint) const
+{
+    (void)fingerprint;
+    return false;
+}
+
 short DocumentObject::mustExecute(void) const
 {
     if (ExpressionEngine.isTouched())
@@ -276,6 +428,7 @@ const char* DocumentObject::detachFromDocument()
 {
     const std::string* name = pcNameInDocument;
     pcNameInDocument = 0;
+    _clearRecursiveListCache();
     return name ? name->c_str() : 0;
 }
 
@@ -455,23 +608,75 @@ void DocumentObject::getInListEx(std::set<App::DocumentObject*> &inSet,
         return;
     }
 
+    auto &cache = _RecursiveListCache;
+    unsigned long epoch = _GraphEpoch;
+    {
+        std::lock_guard<std::mutex> lock(_RecursiveListCacheMutex);
+        cache.check(epoch);
+        auto it = cache.inLists.find(this);
+        if(it != cache.inLists.end()) {
+            const auto &entry = it->second;
+            if(inSet.empty()) {
+                inSet = entry.inSet;
+                if(inList)
+                    inList->insert(inList->end(), entry.inList.begin(), entry.inList.end());
+            } else {
+                for(auto o : entry.inList) {
+                    if(inSet.insert(o).second && inList)
+                        inList->push_back(o);
+                }
+            }
+            return;
+        }
+    }
+
+    RecursiveListCache::InList entry;
     std::stack<DocumentObject*> pendings;
     pendings.push(const_cast<DocumentObject*>(this));
     while(pendings.size()) {
         auto obj = pendings.top();
         pendings.pop();
         for(auto o : obj->getInList()) {
-            if(o && o->getNameInDocument() && inSet.insert(o).second) {
+            if(o && o->getNameInDocument() && entry.inSet.insert(o).second) {
                 pendings.push(o);
-                if(inList)
+                entry.inList.push_back(o);
+                if(inSet.insert(o).second && inList)
                     inList->push_back(o);
             }
         }
     }
 
+    std::lock_guard<std::mutex> lock(_RecursiveListCacheMutex);
+    if(epoch == _GraphEpoch) {
+        cache.check(epoch);
+        cache.reserve(entry.inList.size());
+        cache.inLists.emplace(this, std::move(entry));
+    }
+
 #endif
 }
 
+// Calls func with the cached recursive in list of obj, which is computed first
+// if not cached
+template<class Func>
+static auto _withInListRecursive(const DocumentObject *obj, Func func)
+    -> decltype(func(std::set<App::DocumentObject*>()))
+{
+#ifndef USE_OLD_DAG
+    {
+        auto &cache = _RecursiveListCache;
+        std::lock_guard<std::mutex> lock(_RecursiveListCacheMutex);
+        cache.check(_GraphEpoch);
+        auto it = cache.inLists.find(obj);
+        if(it != cache.inLists.end())
+            return func(it->second.inSet);
+    }
+#endif
+    std::set<App::DocumentObject*> inSet;
+    obj->getInListEx(inSet,true);
+    return func(inSet);
+}
+
 std::set<App::DocumentObject*> DocumentObject::getInListEx(bool recursive) const {
     std::set<App::DocumentObject*> ret;
     getInListEx(ret,recursive);
@@ -495,18 +700,44 @@ void _getOutListRecursive(std::set<DocumentObject*>& objSet,
     }
 }
 
-std::vector<App::DocumentObject*> DocumentObject::getOutListRecursive(void) const
+// Calls func with the cached recursive out list of obj, which is computed
+// first if not cached
+template<class Func>
+static auto _withOutListRecursive(const DocumentObject *obj, Func func)
+    -> decltype(func(std::set<App::DocumentObject*>()))
 {
+    auto &cache = _RecursiveListCache;
+    unsigned long epoch = _GraphEpoch;
+    {
+        std::lock_guard<std::mutex> lock(_RecursiveListCacheMutex);
+        cache.check(epoch);
+        auto it = cache.outLists.find(obj);
+        if(it != cache.outLists.end())
+            return func(it->second);
+    }
+
     // number of objects in document is a good estimate in result size
     int maxDepth = GetApplication().checkLinkDepth(0);
     std::set<App::DocumentObject*> result;
 
     // using a recursive helper to collect all OutLists
-    _getOutListRecursive(result, this, this, maxDepth);
+    _getOutListRecursive(result, obj, obj, maxDepth);
+
+    auto ret = func(result);
+    std::lock_guard<std::mutex> lock(_RecursiveListCacheMutex);
+    if(epoch == _GraphEpoch) {
+        cache.check(epoch);
+        cache.reserve(result.size());
+        cache.outLists.emplace(obj, std::move(result));
+    }
+    return ret;
+}
 
-    std::vector<App::DocumentObject*> array;
-    array.insert(array.begin(), result.begin(), result.end());
-    return array;
+std::vector<App::DocumentObject*> DocumentObject::getOutListRecursive(void) const
+{
+    return _withOutListRecursive(this, [](const std::set<App::DocumentObject*> &result) {
+        return std::vector<App::DocumentObject*>(result.begin(), result.end());
+    });
 }
 
 // helper for isInInListRecursive()
@@ -540,7 +771,10 @@ bool DocumentObject::isInInListRecursive(DocumentObject *linkTo) const
     int maxDepth = getDocument()->countObjects() + 2;
     return _isInInListRecursive(this, linkTo, maxDepth);
 #else
-    return this==linkTo || getInListEx(true).count(linkTo);
+    return this==linkTo || _withInListRecursive(this,
+            [linkTo](const std::set<App::DocumentObject*> &inSet) {
+                return inSet.count(linkTo) > 0;
+            });
 #endif
 }
 
@@ -584,8 +818,14 @@ bool _isInOutListRecursive(const DocumentObject* act,
 
 bool DocumentObject::isInOutListRecursive(DocumentObject *linkTo) const
 {
+#if 0
     int maxDepth = getDocument()->countObjects() + 2;
     return _isInOutListRecursive(this, linkTo, maxDepth);
+#else
+    return _withOutListRecursive(this, [linkTo](const std::set<App::DocumentObject*> &result) {
+        return result.count(linkTo) > 0;
+    });
+#endif
 }
 
 std::vector<std::list<App::DocumentObject*> >
@@ -619,12 +859,12 @@ bool DocumentObject::testIfLinkDAGCompatible(const std::vector<DocumentObject *>
     else
         return true;
 #else
-    auto inLists = getInListEx(true);
-    inLists.emplace(const_cast<DocumentObject*>(this));
-    for(auto obj : linksTo)
-        if(inLists.count(obj))
-            return false;
-    return true;
+    return _withInListRecursive(this, [this,&linksTo](const std::set<App::DocumentObject*> &inLists) {
+        for(auto obj : linksTo)
+            if(obj == this || inLists.count(obj))
+                return false;
+        return true;
+    });
 #endif
 }
 
@@ -714,6 +954,8 @@ void DocumentObject::onBeforeChange(const Property* prop)
 /// get called by the container when a Property was changed
 void DocumentObject::onChanged(const Property* prop)
 {
+    _clearSubObjectCache();
+
     if(GetApplication().isClosingAll())
         return;
 
@@ -760,12 +1002,17 @@ void DocumentObject::onChanged(const Property* prop)
         _pDoc->onChangedProperty(this,prop);
 
     signalChanged(*this,*prop);
+
+    // Again, in case anything resolved sub objects before the extensions
+    // caught up with the change
+    _clearSubObjectCache();
 }
 
 void DocumentObject::clearOutListCache() const {
     _outList.clear();
     _outListMap.clear();
     _outListCached = false;
+    _clearRecursiveListCache();
 }
 
 PyObject *DocumentObject::getPyObject(void)
@@ -779,6 +1026,28 @@ PyObject *DocumentObject::getPyObject(void)
 
 DocumentObject *DocumentObject::getSubObject(const char *subname,
         PyObject **pyObj, Base::Matrix4D *mat, bool transform, int depth) const
+{
+    // Only the outermost call of an object path is cached. The python object
+    // holds the current (transformed) shape and is never cached.
+    if(pyObj || depth || !subname || !strchr(subname,'.'))
+        return _getSubObject(subname,pyObj,mat,transform,depth);
+
+    SubObjectCache::Key key{this, subname, transform?SubObjectCache::Transform:0};
+    DocumentObject *ret = 0;
+    if(getCachedSubObject(key,ret,mat))
+        return ret;
+
+    unsigned long epoch = _SubObjectEpoch;
+    Base::Matrix4D relMat;
+    ret = _getSubObject(subname,0,mat?&relMat:0,transform,depth);
+    if(mat)
+        *mat *= relMat;
+    setCachedSubObject(std::move(key),epoch,ret,mat?&relMat:0);
+    return ret;
+}
+
+DocumentObject *DocumentObject::_getSubObject(const char *subname,
+        PyObject **pyObj, Base::Matrix4D *mat, bool transform, int depth) const
 {
     DocumentObject *ret = 0;
     auto exts = getExtensionsDerivedFromType<App::DocumentObjectExtension>();
@@ -887,9 +1156,29 @@ DocumentObject *DocumentObject::getLinkedObject(
 {
     DocumentObject *ret = 0;
     auto exts = getExtensionsDerivedFromType<App::DocumentObjectExtension>();
-    for(auto ext : exts) {
-        if(ext->extensionGetLinkedObject(ret,recursive,mat,transform,depth))
+    if(exts.size() && !depth) {
+        // Only objects with extensions can be links, see getSubObject() for
+        // the caching
+        SubObjectCache::Key key{this, std::string(), SubObjectCache::LinkedObject
+            | (transform?SubObjectCache::Transform:0) | (recursive?SubObjectCache::Recursive:0)};
+        if(getCachedSubObject(key,ret,mat))
             return ret;
+
+        unsigned long epoch = _SubObjectEpoch;
+        Base::Matrix4D relMat;
+        for(auto ext : exts) {
+            if(ext->extensionGetLinkedObject(ret,recursive,mat?&relMat:0,transform,depth)) {
+                if(mat)
+                    *mat *= relMat;
+                setCachedSubObject(std::move(key),epoch,ret,mat?&relMat:0);
+                return ret;
+            }
+        }
+    } else {
+        for(auto ext : exts) {
+            if(ext->extensionGetLinkedObject(ret,recursive,mat,transform,depth))
+                return ret;
+        }
     }
     if(transform && mat) {
         auto pla = dynamic_cast<PropertyPlacement*>(getPropertyByName("Placement"));
@@ -990,8 +1279,10 @@ void App::DocumentObject::_removeBackLink(DocumentObject* rmvObj)
     //do not use erase-remove idom, as this erases ALL entries that match. we only want to remove a
     //single one.
     auto it = std::find(_inList.begin(), _inList.end(), rmvObj);
-    if(it != _inList.end())
+    if(it != _inList.end()) {
         _inList.erase(it);
+        _clearRecursiveListCache();
+    }
 #else
     (void)rmvObj;
 #endif
@@ -1005,6 +1296,7 @@ void App::DocumentObject::_addBackLink(DocumentObject* newObj)
     //this removal would clear the object from the inlist, even though there may be other link properties 
     //from this object that link to us.
     _inList.push_back(newObj);
+    _clearRecursiveListCache();
 #else
     (void)newObj;
 #endif //USE_OLD_DAG    
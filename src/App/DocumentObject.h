@@ -269,6 +269,17 @@ public:
     void _removeBackLink(DocumentObject*);
     /// internal, used by PropertyLink to maintain DAG back links
     void _addBackLink(DocumentObject*);
+    /** internal, invalidates the cached recursive in and out lists of all objects
+     *
+     * Called on any change of the object graph, i.e. on back link changes,
+     * out list cache clearing and on adding or removing objects.
+     */
+    static void _clearRecursiveListCache();
+    /** internal, invalidates the cached results of getSubObject() and getLinkedObject()
+     *
+     * Called on any property change, and with _clearRecursiveListCache().
+     */
+    static void _clearSubObjectCache();
     //@}
 
     /**
@@ -300,6 +311,21 @@ public:
      */
     virtual short mustExecute(void) const;
 
+    /** Fingerprint of the output of this object
+     *
+     * @param fingerprint: receives a hash of the values that dependent
+     * objects read from this object after execute()
+     *
+     * @return false if the object can not provide a fingerprint, which is
+     * the default.
+     *
+     * With the document parameter 'RecomputeEarlyCutOff' enabled, the
+     * document compares the fingerprint taken before and after the
+     * recompute of the object, and does not enforce the recompute of its
+     * dependents if it is unchanged.
+     */
+    virtual bool getOutputFingerprint(std::size_t &fingerprint) const;
+
     /** Recompute only this feature
      *
      * @param recursive: set to true to recompute any dependent objects as well
@@ -630,6 +656,10 @@ private:
     // unique identifier (among a document) of this object.
     long _Id;
 
+    // getSubObject() without the sub object cache
+    DocumentObject *_getSubObject(const char *subname, PyObject **pyObj,
+            Base::Matrix4D *mat, bool transform, int depth) const;
+
 private:
     // Back pointer to all the fathers in a DAG of the document
     // this is used by the document (via friend) to have a effective DAG handling
@@ -286,6 +286,47 @@ PyObject*  DocumentPy::removeObject(PyObject *args)
     }
 }
 
+PyObject*  DocumentPy::removeObjects(PyObject *args)
+{
+    PyObject *obj;
+    if (!PyArg_ParseTuple(args, "O",&obj))
+        return NULL;    // NULL triggers exception
+
+    if (!PySequence_Check(obj)) {
+        PyErr_SetString(PyExc_TypeError, "Expect a sequence of document objects or object names");
+        return 0;
+    }
+
+    std::vector<App::DocumentObject*> objs;
+    Py::Sequence seq(obj);
+    for (Py_ssize_t i=0;i<seq.size();++i) {
+        Py::Object item(seq[i]);
+        if (PyObject_TypeCheck(item.ptr(),&DocumentObjectPy::Type)) {
+            objs.push_back(static_cast<DocumentObjectPy*>(item.ptr())->getDocumentObjectPtr());
+        }
+        else if (item.isString()) {
+            std::string name = Py::String(item).as_std_string("utf-8");
+            DocumentObject *pcFtr = getDocumentPtr()->getObject(name.c_str());
+            if (!pcFtr) {
+                std::stringstream str;
+                str << "No document object found with name '" << name << "'";
+                PyErr_SetString(Base::BaseExceptionFreeCADError, str.str().c_str());
+                return 0;
+            }
+            objs.push_back(pcFtr);
+        }
+        else {
+            PyErr_SetString(PyExc_TypeError, "Expect element in sequence to be a document object or name");
+            return 0;
+        }
+    }
+
+    PY_TRY {
+        getDocumentPtr()->removeObjects(objs);
+        Py_Return;
+    } PY_CATCH
+}
+
 PyObject*  DocumentPy::copyObject(PyObject *args)
 {
     PyObject *obj, *rec=Py_False, *retAll=Py_False;
@@ -424,6 +465,25 @@ PyObject*  DocumentPy::commitTransaction(PyObject * args)
     Py_Return;
 }
 
+PyObject*  DocumentPy::beginChangeBatch(PyObject * args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+    getDocumentPtr()->beginChangeBatch();
+    Py_Return;
+}
+
+PyObject*  DocumentPy::endChangeBatch(PyObject * args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+    PY_TRY {
+        getDocumentPtr()->endChangeBatch();
+        Py_Return;
+    }
+    PY_CATCH;
+}
+
 Py::Boolean DocumentPy::getHasPendingTransaction() const {
     return Py::Boolean(getDocumentPtr()->hasPendingTransaction());
 }
@@ -693,6 +753,45 @@ void DocumentPy::setRecomputesFrozen(Py::Boolean arg)
     getDocumentPtr()->setStatus(Document::Status::SkipRecompute, arg.isTrue());
 }
 
+Py::Boolean DocumentPy::getRecomputeProfiling(void) const
+{
+    return Py::Boolean(getDocumentPtr()->isRecomputeProfiling());
+}
+
+void DocumentPy::setRecomputeProfiling(Py::Boolean arg)
+{
+    getDocumentPtr()->setRecomputeProfiling(arg.isTrue());
+}
+
+PyObject* DocumentPy::getRecomputeProfile(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    PY_TRY {
+        Py::Dict dict;
+        for (auto &v : getDocumentPtr()->getRecomputeProfile()) {
+            Py::Dict stat;
+            stat.setItem("Calls", Py::Int(v.second.calls));
+            stat.setItem("WallTime", Py::Float(v.second.wallTime));
+            stat.setItem("CpuTime", Py::Float(v.second.cpuTime));
+            stat.setItem("ExpressionTime", Py::Float(v.second.expressionTime));
+            stat.setItem("PeakMemoryDelta", Py::Long(v.second.peakMemoryDelta));
+            dict.setItem(v.first, stat);
+        }
+        return Py::new_reference_to(dict);
+    }
+    PY_CATCH;
+}
+
+PyObject* DocumentPy::clearRecomputeProfile(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+    getDocumentPtr()->clearRecomputeProfile();
+    Py_Return;
+}
+
 PyObject* DocumentPy::getTempFileName(PyObject *args)
 {
     PyObject *value;
@@ -53,6 +53,7 @@
 #include <stdio.h>
 #include <stack>
 #include <deque>
+#include <unordered_map>
 #include <algorithm>
 #include "ExpressionParser.h"
 #include <Base/Unit.h>
@@ -2046,6 +2047,13 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         v3 = pyToQuantity(e3,expr,"Invalid third argument.");
     }
 
+    return Py::asObject(new QuantityPy(new Quantity(
+                    evaluateMath(expr, f, args.size(), v1, v2, v3))));
+}
+
+Quantity FunctionExpression::evaluateMath(const Expression *expr, int f, std::size_t argc,
+        const Quantity &v1, const Quantity &v2, const Quantity &v3)
+{
     double output;
     Unit unit;
     double scaler = 1;
@@ -2115,7 +2123,7 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         break;
     }
     case ATAN2:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (v1.getUnit() != v2.getUnit())
@@ -2124,12 +2132,12 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         scaler = 180.0 / M_PI;
         break;
     case MOD:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         unit = v1.getUnit() / v2.getUnit();
         break;
     case POW: {
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (!v2.getUnit().isEmpty())
@@ -2147,14 +2155,12 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     }
     case HYPOT:
     case CATH:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         if (v1.getUnit() != v2.getUnit())
             _EXPR_THROW("Units must be equal.",expr);
 
-        if (args.size() > 2) {
-            if (e3.isNone())
-                _EXPR_THROW("Invalid second argument.",expr);
+        if (argc > 2) {
             if (v2.getUnit() != v3.getUnit())
                 _EXPR_THROW("Units must be equal.",expr);
         }
@@ -2221,11 +2227,11 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         break;
     }
     case HYPOT: {
-        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (argc > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case CATH: {
-        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (argc > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case ROUND:
@@ -2244,7 +2250,7 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         _EXPR_THROW("Unknown function: " << f,expr);
     }
 
-    return Py::asObject(new QuantityPy(new Quantity(scaler * output, unit)));
+    return Quantity(scaler * output, unit);
 }
 
 Py::Object FunctionExpression::_getPyValue() const {
@@ -3056,6 +3062,20 @@ Base::XMLReader *ExpressionParser::ExpressionImporter::reader() {
     return _Reader;
 }
 
+static int _CacheDepth = 0;
+typedef std::unordered_map<std::string, std::unique_ptr<Expression> > ExpressionTemplates;
+static std::unordered_map<const App::DocumentObject*, ExpressionTemplates> _Cache;
+
+ExpressionParser::ExpressionCache::ExpressionCache() {
+    ++_CacheDepth;
+}
+
+ExpressionParser::ExpressionCache::~ExpressionCache() {
+    assert(_CacheDepth > 0);
+    if (--_CacheDepth == 0)
+        _Cache.clear();
+}
+
 namespace App {
 
 namespace ExpressionParser {
@@ -3231,6 +3251,14 @@ std::vector<std::tuple<int, int, std::string> > tokenize(const std::string &str)
 
 Expression * App::ExpressionParser::parse(const App::DocumentObject *owner, const char* buffer)
 {
+    ExpressionTemplates *templates = 0;
+    if (_CacheDepth > 0) {
+        templates = &_Cache[owner];
+        auto it = templates->find(buffer);
+        if (it != templates->end())
+            return it->second->copy();
+    }
+
     // parse from buffer
     ExpressionParser::YY_BUFFER_STATE my_string_buffer = ExpressionParser::ExpressionParser_scan_string (buffer);
 
@@ -3248,8 +3276,12 @@ Expression * App::ExpressionParser::parse(const App::DocumentObject *owner, cons
     if (ScanResult == 0)
         throw ParserError("Unknown error in expression");
 
-    if (valueExpression)
+    if (valueExpression) {
+        // the caller owns the result and may modify it, so keep a copy
+        if (templates)
+            templates->emplace(buffer, std::unique_ptr<Expression>(ScanResult->copy()));
         return ScanResult;
+    }
     else {
         delete ScanResult;
         throw Expression::Exception("Expression can not evaluate to a value.");
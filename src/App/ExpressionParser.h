@@ -219,6 +219,12 @@ public:
 
     virtual int priority() const override;
 
+    Expression * getCondition() const { return condition; }
+
+    Expression * getTrueExpr() const { return trueExpr; }
+
+    Expression * getFalseExpr() const { return falseExpr; }
+
 protected:
     virtual Expression * _copy() const override;
     virtual void _visit(ExpressionVisitor & v) override;
@@ -298,6 +304,22 @@ public:
 
     static Py::Object evaluate(const Expression *owner, int type, const std::vector<Expression*> &args);
 
+    /** Evaluate one of the math functions (ACOS to CATH) on already converted arguments
+     *
+     * @param owner: the expression used for error reporting
+     * @param type: the function
+     * @param argc: number of arguments actually given (1 to 3)
+     * @param v1, v2, v3: the arguments, unused ones are ignored
+     */
+    static Base::Quantity evaluateMath(const Expression *owner, int type, std::size_t argc,
+            const Base::Quantity &v1, const Base::Quantity &v2, const Base::Quantity &v3);
+
+    static bool isMathFunction(int type) { return type >= ACOS && type <= CATH; }
+
+    Function getFunction() const { return f; }
+
+    const std::vector<Expression*> &getArgs() const { return args; }
+
 protected:
     static Py::Object evalAggregate(const Expression *owner, int type, const std::vector<Expression*> &args);
     virtual Py::Object _getPyValue() const override;
@@ -461,6 +483,20 @@ public:
     static Base::XMLReader *reader();
 };
 
+/** Convenient class to cache the parsed expressions while an instance exists
+ *
+ * Documents often contain the same expression many times, e.g. in the cells of a
+ * spreadsheet. parse() then keeps a template of the result for each owner and
+ * expression text and returns a copy of it the next time. Instances can be nested,
+ * the cache is cleared when the outermost one is destroyed. Because identifiers are
+ * resolved when parsing, it must only be used while no objects are added or renamed.
+ */
+class AppExport ExpressionCache {
+public:
+    ExpressionCache();
+    ~ExpressionCache();
+};
+
 AppExport bool isModuleImported(PyObject *);
 
 /**
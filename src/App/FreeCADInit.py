@@ -80,6 +80,107 @@ def setupSearchPaths(PathExtension):
 	except KeyError:
 		os.environ["PATH"] = PathEnvironment
 
+def readModuleManifest(Dir):
+	"""Returns the parsed Manifest.ini of a module directory or None.
+		A module with a manifest is registered from its [Import], [Export]
+		and [Workbench] sections at startup, and its Init.py and InitGui.py
+		only run when the module is first used."""
+	ManifestFile = os.path.join(Dir,"Manifest.ini")
+	if not os.path.exists(ManifestFile):
+		return None
+	if sys.version_info.major < 3:
+		import ConfigParser as configparser
+	else:
+		import configparser
+	parser = configparser.RawConfigParser()
+	parser.optionxform = str # keep the case of module names
+	try:
+		parser.read(ManifestFile)
+	except Exception as inst:
+		Wrn('Invalid manifest ' + ManifestFile + ': ' + str(inst) + '\n')
+		return None
+	manifest = {}
+	for section in parser.sections():
+		manifest[section] = dict(parser.items(section))
+	return manifest
+
+def runModuleInitScript(Dir, InstallFile):
+	"""Runs the Init.py of a module directory and logs the time it took."""
+	start = time.time()
+	try:
+		# XXX: This looks scary securitywise...
+		if sys.version_info.major < 3:
+			with open(InstallFile) as f:
+				exec(f.read(), dict(globals(), Dir=Dir, InstallFile=InstallFile))
+		else:
+			with open(file=InstallFile, encoding="utf-8") as f:
+				exec(f.read(), dict(globals(), Dir=Dir, InstallFile=InstallFile))
+	except Exception as inst:
+		Log('Init:      Initializing ' + Dir + '... failed\n')
+		Log('-'*100+'\n')
+		Log(traceback.format_exc())
+		Log('-'*100+'\n')
+		Err('During initialization the error "' + str(inst) + '" occurred in ' + InstallFile + '\n')
+		Err('Please look into the log file for further information\n')
+	else:
+		elapsed = time.time() - start
+		FreeCAD.__ModuleInitTimes__[Dir] = elapsed
+		Log('Init:      Initializing ' + Dir + '... done (%.3f s)\n' % elapsed)
+
+class DeferredModuleFinder(object):
+	"""Import hook that runs the Init.py of a deferred module right before
+		the first import of one of its Python modules."""
+	def __init__(self):
+		self.modules = {}
+
+	def find_spec(self, fullname, path=None, target=None):
+		Dir = self.modules.get(fullname.partition('.')[0])
+		if Dir:
+			loadDeferredModule(Dir)
+		return None # let the regular finders do the actual import
+
+	def find_module(self, fullname, path=None):
+		return self.find_spec(fullname, path)
+
+DeferredModules = DeferredModuleFinder()
+
+def loadDeferredModule(Dir):
+	"""Runs the Init.py of a deferred module unless this already happened.
+		Returns False if Dir is not a pending deferred module."""
+	entry = FreeCAD.__DeferredModules__.pop(Dir, None)
+	if entry is None:
+		return False
+	for name in entry["Modules"]:
+		DeferredModules.modules.pop(name, None)
+	if os.path.exists(entry["InitFile"]):
+		Log('Init:      Loading deferred module ' + Dir + '\n')
+		runModuleInitScript(Dir, entry["InitFile"])
+	return True
+
+def registerDeferredModule(Dir, InstallFile, Manifest):
+	"""Registers the file types of a module from its manifest and defers
+		running its Init.py until one of its Python modules is imported."""
+	section = Manifest.get("Module", {})
+	names = [i.strip() for i in section.get("Modules", "").split(",") if i.strip()]
+	if not names:
+		names.append(os.path.basename(Dir))
+		for i in os.listdir(Dir):
+			base, ext = os.path.splitext(i)
+			if ext == ".py" and base not in ("Init", "InitGui"):
+				names.append(base)
+			elif os.path.exists(os.path.join(Dir, i, "__init__.py")):
+				names.append(i)
+	for module, filters in Manifest.get("Import", {}).items():
+		for i in filters.splitlines():
+			if i.strip(): FreeCAD.addImportType(i.strip(), module)
+	for module, filters in Manifest.get("Export", {}).items():
+		for i in filters.splitlines():
+			if i.strip(): FreeCAD.addExportType(i.strip(), module)
+	FreeCAD.__DeferredModules__[Dir] = {"InitFile": InstallFile, "Modules": names}
+	for name in names:
+		DeferredModules.modules[name] = Dir
+	return True
+
 FreeCAD._importFromFreeCAD = removeFromPath
 
 
@@ -165,29 +266,25 @@ def InitApplications():
 	# proper python modules this can eventuelly be removed.
 	sys.path = [ModDir] + libpaths + [ExtDir] + sys.path
 
+	# modules with a Manifest.ini are initialized on first use
+	FreeCAD.__ModuleManifests__ = {}
+	FreeCAD.__DeferredModules__ = {}
+	FreeCAD.__ModuleInitTimes__ = {}
+	FreeCAD.loadDeferredModule = loadDeferredModule
+	sys.meta_path.insert(0, DeferredModules)
+
 	for Dir in ModDict.values():
 		if ((Dir != '') & (Dir != 'CVS') & (Dir != '__init__.py')):
 			sys.path.insert(0,Dir)
 			PathExtension.append(Dir)
 			InstallFile = os.path.join(Dir,"Init.py")
-			if (os.path.exists(InstallFile)):
-				try:
-					# XXX: This looks scary securitywise...
-					if sys.version_info.major < 3:
-						with open(InstallFile) as f:
-							exec(f.read())
-					else:
-						with open(file=InstallFile, encoding="utf-8") as f:
-							exec(f.read())
-				except Exception as inst:
-					Log('Init:      Initializing ' + Dir + '... failed\n')
-					Log('-'*100+'\n')
-					Log(traceback.format_exc())
-					Log('-'*100+'\n')
-					Err('During initialization the error "' + str(inst) + '" occurred in ' + InstallFile + '\n')
-					Err('Please look into the log file for further information\n')
-				else:
-					Log('Init:      Initializing ' + Dir + '... done\n')
+			Manifest = readModuleManifest(Dir)
+			if Manifest is not None:
+				FreeCAD.__ModuleManifests__[Dir] = Manifest
+				registerDeferredModule(Dir, InstallFile, Manifest)
+				Log('Init:      Initializing ' + Dir + '... deferred\n')
+			elif (os.path.exists(InstallFile)):
+				runModuleInitScript(Dir, InstallFile)
 			else:
 				Log('Init:      Initializing ' + Dir + '(Init.py not found)... ignore\n')
 
@@ -254,7 +351,7 @@ App.__unit_test__ = []
 Log ('Init: starting App::FreeCADInit.py\n')
 
 try:
-    import sys,os,traceback,inspect
+    import sys,os,time,traceback,inspect
     from datetime import datetime
 except ImportError:
     FreeCAD.Console.PrintError("\n\nSeems the python standard libs are not installed, bailing out!\n\n")
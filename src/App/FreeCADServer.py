@@ -0,0 +1,240 @@
+#***************************************************************************
+#*   Copyright (c) 2021 FreeCAD contributors                               *
+#*                                                                         *
+#*   This file is part of the FreeCAD CAx development system.              *
+#*                                                                         *
+#*   This program is free software; you can redistribute it and/or modify  *
+#*   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#*   as published by the Free Software Foundation; either version 2 of     *
+#*   the License, or (at your option) any later version.                   *
+#*   for detail see the LICENCE text file.                                 *
+#*                                                                         *
+#*   FreeCAD is distributed in the hope that it will be useful,            *
+#*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#*   GNU Lesser General Public License for more details.                   *
+#*                                                                         *
+#*   You should have received a copy of the GNU Library General Public     *
+#*   License along with FreeCAD; if not, write to the Free Software        *
+#*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#*   USA                                                                   *
+#*                                                                         *
+#***************************************************************************/
+
+# FreeCAD batch job server
+#
+# Keeps an initialized application with the CAD modules loaded and runs jobs
+# sent over a local socket, so that every job doesn't pay for the start-up.
+#
+# Started with 'FreeCADCmd --run-server ADDRESS'. ADDRESS is a port number on
+# 127.0.0.1, 'host:port' or, on platforms supporting it, the path of a Unix
+# domain socket. A job is a JSON object on a single line, the reply is a JSON
+# object on a single line:
+#
+#   {"open": ["part.FCStd"],         files to open, the first is 'doc'
+#    "script": "doc.Pad.Length = 5", Python code run with 'App', 'doc' and
+#                                    'documents' defined, it may set 'result'
+#    "recompute": true,              recompute the documents (default)
+#    "export": ["part.step"],        export the objects of 'doc'
+#    "save": "out.FCStd"}            save 'doc' under a new name
+#
+#   {"ok": true, "result": ..., "output": "...", "error": ""}
+#
+#   {"shutdown": true} stops the server.
+#
+# All documents opened or created by a job are closed when it is done. Jobs
+# are run by a worker process forked from the initialized server. With
+# --server-memory the worker is replaced once it uses more memory (in MB)
+# than that, the connection is closed after the reply then and the client
+# has to reconnect.
+
+import contextlib
+import io
+import json
+import os
+import socket
+import sys
+import traceback
+
+import FreeCAD
+
+PreloadModules = ["Part", "Sketcher", "PartDesign", "Import", "Mesh"]
+ShutdownCode = 3
+
+
+def preload():
+    for name in PreloadModules:
+        try:
+            __import__(name)
+        except Exception as e:
+            Log("Server: cannot preload module {}: {}\n".format(name, e))
+
+
+def listen(address):
+    if os.sep in address or address.startswith("."):
+        if not hasattr(socket, "AF_UNIX"):
+            raise RuntimeError("Unix domain sockets are not supported on this platform")
+        if os.path.exists(address):
+            os.remove(address)
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        sock.bind(address)
+    else:
+        host, _, port = address.rpartition(":")
+        sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        sock.bind((host or "127.0.0.1", int(port)))
+    sock.listen(16)
+    return sock
+
+
+def memoryUsage():
+    """Peak resident memory of this process in MB, or 0 if unknown."""
+    try:
+        import resource
+    except ImportError:
+        return 0
+    usage = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Linux reports kilobytes, macOS bytes
+    if sys.platform == "darwin":
+        return usage / (1024 * 1024)
+    return usage / 1024
+
+
+def exportDocument(doc, path):
+    ext = os.path.splitext(path)[1][1:].lower()
+    modules = FreeCAD.getExportType(ext)
+    if not modules:
+        raise RuntimeError("File format not supported: {}".format(path))
+    module = __import__(modules[0])
+    module.export(doc.Objects, path)
+
+
+def runJob(job):
+    reply = {"ok": True, "result": None, "output": "", "error": ""}
+    before = set(FreeCAD.listDocuments().keys())
+    output = io.StringIO()
+    try:
+        with contextlib.redirect_stdout(output):
+            files = job.get("open", [])
+            if isinstance(files, str):
+                files = [files]
+            documents = [FreeCAD.openDocument(f, hidden=True) for f in files]
+            doc = documents[0] if documents else None
+
+            script = job.get("script")
+            if script:
+                env = {"App": FreeCAD, "FreeCAD": FreeCAD, "doc": doc,
+                       "documents": documents, "result": None}
+                exec(script, env)
+                reply["result"] = env["result"]
+                doc = env["doc"]
+
+            if job.get("recompute", True):
+                for name in FreeCAD.listDocuments().keys():
+                    if name not in before:
+                        FreeCAD.getDocument(name).recompute()
+
+            exports = job.get("export", [])
+            if isinstance(exports, str):
+                exports = [exports]
+            for path in exports:
+                exportDocument(doc, path)
+
+            if job.get("save"):
+                doc.saveAs(job["save"])
+        json.dumps(reply["result"])
+    except Exception as e:
+        reply["ok"] = False
+        reply["result"] = None
+        reply["error"] = "{}\n{}".format(e, traceback.format_exc())
+    finally:
+        # documents must not leak into the next job
+        for name in list(FreeCAD.listDocuments().keys()):
+            if name not in before:
+                FreeCAD.closeDocument(name)
+    reply["output"] = output.getvalue()
+    return reply
+
+
+def serve(sock, maxMemory):
+    """Runs jobs until the server is shut down or, if maxMemory is set, this
+    process uses more memory than that. Returns True on shutdown."""
+    while True:
+        conn, _ = sock.accept()
+        try:
+            if serveConnection(conn, maxMemory):
+                return True
+        except OSError as e:
+            # the client went away, wait for the next one
+            Log("Server: connection lost: {}\n".format(e))
+        finally:
+            conn.close()
+        if maxMemory > 0 and memoryUsage() > maxMemory:
+            Log("Server: recycling worker at {:.0f} MB\n".format(memoryUsage()))
+            return False
+
+
+def serveConnection(conn, maxMemory):
+    """Runs the jobs of one client. Returns True on shutdown."""
+    with conn.makefile("rwb") as stream:
+        for line in stream:
+            if not line.strip():
+                continue
+            try:
+                job = json.loads(line.decode("utf-8"))
+            except ValueError as e:
+                job = str(e)
+            if not isinstance(job, dict):
+                error = job if isinstance(job, str) else "A job must be a JSON object"
+                job = None
+                reply = {"ok": False, "result": None, "output": "", "error": error}
+            elif job.get("shutdown"):
+                stream.write(b'{"ok": true}\n')
+                stream.flush()
+                return True
+            if job is not None:
+                reply = runJob(job)
+            stream.write(json.dumps(reply).encode("utf-8") + b"\n")
+            stream.flush()
+            if maxMemory > 0 and memoryUsage() > maxMemory:
+                return False
+    return False
+
+
+def run():
+    address = FreeCAD.ConfigGet("ServerAddress")
+    maxMemory = float(FreeCAD.ConfigGet("ServerMemory") or 0)
+    preload()
+    sock = listen(address)
+    FreeCAD.Console.PrintMessage("FreeCAD server listening at {}\n".format(address))
+
+    if not hasattr(os, "fork"):
+        # without fork the worker cannot be replaced, run the jobs in-process
+        serve(sock, 0)
+        return
+
+    while True:
+        pid = os.fork()
+        if pid == 0:
+            # the worker must never return into the interpreter of the server
+            code = 1
+            try:
+                code = ShutdownCode if serve(sock, maxMemory) else 0
+            except BaseException:
+                traceback.print_exc()
+            sys.stdout.flush()
+            os._exit(code)
+        _, status = os.waitpid(pid, 0)
+        if os.WIFEXITED(status) and os.WEXITSTATUS(status) == ShutdownCode:
+            break
+        if not os.WIFEXITED(status):
+            Log("Server: worker terminated abnormally, restarting\n")
+
+
+Log("FreeCAD server starting...\n")
+
+run()
+
+Log("FreeCAD server done\n")
+
+sys.exit(0)
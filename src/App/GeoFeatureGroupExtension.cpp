@@ -44,6 +44,8 @@ using namespace App;
 
 EXTENSION_PROPERTY_SOURCE(App::GeoFeatureGroupExtension, App::GroupExtension)
 
+unsigned long GeoFeatureGroupExtension::hierarchyCounter = 0;
+
 
 //===========================================================================
 // Feature
@@ -121,15 +123,37 @@ Base::Placement GeoFeatureGroupExtension::globalGroupPlacement() {
 
 Base::Placement GeoFeatureGroupExtension::recursiveGroupPlacement(GeoFeatureGroupExtension* group) {
 
-    
+    if(group->cachedPlacementValid && group->cachedHierarchy == hierarchyCounter)
+        return group->cachedPlacement;
+
+    Base::Placement plm = group->placement().getValue();
     auto inList = group->getExtendedObject()->getInList();
     for(auto* link : inList) {
         auto parent = link->getExtensionByType<GeoFeatureGroupExtension>(true);
-        if(parent && parent->hasObject(group->getExtendedObject()))
-            return recursiveGroupPlacement(parent) * group->placement().getValue();
+        if(parent && parent->hasObject(group->getExtendedObject())) {
+            plm = recursiveGroupPlacement(parent) * plm;
+            break;
+        }
+    }
+
+    group->cachedPlacement = plm;
+    group->cachedHierarchy = hierarchyCounter;
+    group->cachedPlacementValid = true;
+    return plm;
+}
+
+void GeoFeatureGroupExtension::invalidateGroupPlacement() {
+
+    if(!cachedPlacementValid)
+        return;
+    cachedPlacementValid = false;
+
+    // the placement of all sub groups depends on this one
+    for(auto obj : Group.getValues()) {
+        auto group = obj ? obj->getExtensionByType<GeoFeatureGroupExtension>(true) : nullptr;
+        if(group)
+            group->invalidateGroupPlacement();
     }
-    
-    return group->placement().getValue();
 }
 
 std::vector<DocumentObject*> GeoFeatureGroupExtension::addObjects(std::vector<App::DocumentObject*> objects)  {
@@ -191,6 +215,11 @@ std::vector<DocumentObject*> GeoFeatureGroupExtension::removeObjects(std::vector
 
 void GeoFeatureGroupExtension::extensionOnChanged(const Property* p) {
 
+    if(p == &Group)
+        ++hierarchyCounter;
+    else if(getExtendedContainer() && p == &placement())
+        invalidateGroupPlacement();
+
     //objects are only allowed in a single GeoFeatureGroup
     if(p == &Group && !Group.testStatus(Property::User3)) {
     
@@ -228,6 +257,12 @@ void GeoFeatureGroupExtension::extensionOnChanged(const Property* p) {
     App::GroupExtension::extensionOnChanged(p);
 }
 
+void GeoFeatureGroupExtension::onExtendedUnsetupObject() {
+
+    // sub groups may stay in the document without this one as parent
+    ++hierarchyCounter;
+    App::GroupExtension::onExtendedUnsetupObject();
+}
 
 std::vector< DocumentObject* > GeoFeatureGroupExtension::getScopedObjectsFromLinks(const DocumentObject* obj, LinkScope scope) {
 
@@ -71,6 +71,7 @@ public:
     virtual ~GeoFeatureGroupExtension();
     
     virtual void extensionOnChanged(const Property* p) override;
+    virtual void onExtendedUnsetupObject() override;
 
     /** Returns the geo feature group which contains this object.
      * In case this object is not part of any geoFeatureGroup 0 is returned.
@@ -87,6 +88,8 @@ public:
      * GeoFeatureGroup the returned placement is the one of this group. For multiple stacked 
      * GeoFeatureGroups the returned Placement is the combination of all parent placements including 
      * the one of this group.
+     * The result is cached. The cache is invalidated for the group and all groups below it when
+     * the placement of the group changes, and for all groups when the content of any group changes.
      * @return Base::Placement The transformation from global reference system to the groups local system
      */
     Base::Placement globalGroupPlacement();
@@ -121,6 +124,8 @@ public:
     
 private:
     Base::Placement recursiveGroupPlacement(GeoFeatureGroupExtension* group);
+    /// Marks the cached global placement of this group and of all sub groups as invalid
+    void invalidateGroupPlacement();
     static std::vector<App::DocumentObject*> getScopedObjectsFromLinks(const App::DocumentObject*, LinkScope scope = LinkScope::Local);
     static std::vector<App::DocumentObject*> getScopedObjectsFromLink(App::Property*, LinkScope scope = LinkScope::Local);
 
@@ -135,7 +140,13 @@ private:
     
     static void recursiveCSRelevantLinks(const App::DocumentObject* obj,
                                          std::vector<App::DocumentObject*>& vec);
- 
+
+    // cache of globalGroupPlacement(), valid if the hierarchy hasn't changed in the meantime
+    Base::Placement cachedPlacement;
+    unsigned long cachedHierarchy = 0;
+    bool cachedPlacementValid = false;
+    /// Changed whenever the content of any GeoFeatureGroup changes
+    static unsigned long hierarchyCounter;
 };
 
 typedef ExtensionPythonT<GroupExtensionPythonT<GeoFeatureGroupExtension>> GeoFeatureGroupExtensionPython;
@@ -753,8 +753,25 @@ bool LinkBaseExtension::extensionGetLinkedObject(DocumentObject *&ret,
 
 void LinkBaseExtension::extensionOnChanged(const Property *prop) {
     auto parent = getContainer();
-    if(parent && !parent->isRestoring() && prop && !prop->testStatus(Property::User3))
+    if(parent && !parent->isRestoring() && prop && !prop->testStatus(Property::User3)) {
+        // Large arrays keep their elements in the list properties of the
+        // link instead of one LinkElement object per element
+        auto propShow = _getShowElementProperty();
+        if(prop == _getElementCountProperty() && propShow && propShow->getValue()
+                && parent->getDocument()
+                && !parent->getDocument()->isPerformingTransaction())
+        {
+            auto hGrp = GetApplication().GetParameterGroupByPath(
+                    "User parameter:BaseApp/Preferences/Link");
+            long limit = hGrp->GetInt("ElementObjectLimit",0);
+            if(limit>0 && getElementCountValue()>limit) {
+                FC_LOG("store elements in lists for " << parent->getFullName()
+                        << " with " << getElementCountValue() << " elements");
+                propShow->setValue(false);
+            }
+        }
         update(parent,prop);
+    }
     inherited::extensionOnChanged(prop);
 }
 
@@ -922,10 +939,7 @@ void LinkBaseExtension::update(App::DocumentObject *parent, const Property *prop
             if(getScaleListProperty())
                 getScaleListProperty()->setValue(scales);
 
-            for(auto obj : objs) {
-                if(obj && obj->getNameInDocument())
-                    obj->getDocument()->removeObject(obj->getNameInDocument());
-            }
+            parent->getDocument()->removeObjects(objs);
         }
     }else if(prop == _getElementCountProperty()) {
         size_t elementCount = getElementCountValue()<0?0:(size_t)getElementCountValue();
@@ -1020,10 +1034,7 @@ void LinkBaseExtension::update(App::DocumentObject *parent, const Property *prop
                     objs.pop_back();
                 }
                 getElementListProperty()->setValue(objs);
-                for(auto obj : tmpObjs) {
-                    if(obj && obj->getNameInDocument())
-                        obj->getDocument()->removeObject(obj->getNameInDocument());
-                }
+                parent->getDocument()->removeObjects(tmpObjs);
             }
         }
     }else if(prop == getVisibilityListProperty()) {
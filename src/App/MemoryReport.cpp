@@ -0,0 +1,133 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <map>
+#endif
+
+#include "MemoryReport.h"
+#include "Application.h"
+#include "Document.h"
+#include "DocumentObject.h"
+#include "Property.h"
+
+using namespace App;
+
+std::vector<MemoryReport::Collector> MemoryReport::collectors;
+
+void MemoryReport::addCollector(const Collector& func)
+{
+    collectors.push_back(func);
+}
+
+void MemoryReport::collect()
+{
+    for (auto doc : GetApplication().getDocuments())
+        addDocument(doc);
+    for (auto& func : collectors)
+        func(*this);
+}
+
+void MemoryReport::addDocument(const Document* doc)
+{
+    std::string docName = doc->getName();
+    addProperties(docName, std::string(), std::string(), doc, Properties);
+    for (auto obj : doc->getObjects()) {
+        if (!obj->getNameInDocument())
+            continue;
+        addProperties(docName, obj->getNameInDocument(), obj->Label.getStrValue(), obj, Properties);
+    }
+
+    std::size_t undo = doc->getUndoMemSize();
+    if (undo > 0)
+        add(Entry{docName, std::string(), std::string(), "Undo/Redo", UndoStack, undo});
+}
+
+void MemoryReport::addProperties(const std::string& document, const std::string& object, const std::string& label,
+                                 const PropertyContainer* container, Category category)
+{
+    std::map<std::string, App::Property*> props;
+    container->getPropertyMap(props);
+    for (const auto& it : props)
+        add(Entry{document, object, label, it.first, category, it.second->getMemSize()});
+}
+
+void MemoryReport::add(Entry&& entry)
+{
+    items.push_back(std::move(entry));
+}
+
+std::size_t MemoryReport::total() const
+{
+    std::size_t size = 0;
+    for (const auto& it : items)
+        size += it.size;
+    return size;
+}
+
+std::vector<std::pair<std::string, std::size_t>> MemoryReport::totals(GroupBy group) const
+{
+    std::map<std::string, std::size_t> sums;
+    for (const auto& it : items) {
+        switch (group) {
+        case ByDocument:
+            sums[it.document] += it.size;
+            break;
+        case ByObject:
+            sums[it.object.empty() ? it.document : it.document + "#" + it.object] += it.size;
+            break;
+        case ByProperty:
+            sums[it.name] += it.size;
+            break;
+        case ByCategory:
+            sums[categoryName(it.category)] += it.size;
+            break;
+        }
+    }
+
+    std::vector<std::pair<std::string, std::size_t>> result(sums.begin(), sums.end());
+    std::stable_sort(result.begin(), result.end(), [](const std::pair<std::string, std::size_t>& a,
+                                                      const std::pair<std::string, std::size_t>& b) {
+        return a.second > b.second;
+    });
+    return result;
+}
+
+const char* MemoryReport::categoryName(Category category)
+{
+    switch (category) {
+    case Properties:
+        return "Properties";
+    case UndoStack:
+        return "UndoStack";
+    case ViewProperties:
+        return "ViewProperties";
+    case SceneGraph:
+        return "SceneGraph";
+    }
+    return "";
+}
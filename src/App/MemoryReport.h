@@ -0,0 +1,111 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef APP_MEMORYREPORT_H
+#define APP_MEMORYREPORT_H
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace App
+{
+class Document;
+class PropertyContainer;
+
+/**
+ * \brief The MemoryReport class collects the estimated memory usage of the open documents.
+ *
+ * Every entry is the size of one property of an object, of the undo/redo stack of a
+ * document or of data that other modules hold for an object, e.g. the Coin nodes of its
+ * view provider. The sizes are the estimates of Property::getMemSize(), so they show
+ * which objects are responsible for the memory usage, not the exact heap usage.
+ *
+ * Modules that hold data outside of the properties register a collector with
+ * addCollector() that is run by collect().
+ */
+class AppExport MemoryReport
+{
+public:
+    /// The kinds of memory the entries account for
+    enum Category {
+        Properties,     ///< the properties of an object
+        UndoStack,      ///< the undo and redo transactions of a document
+        ViewProperties, ///< the properties of a view provider
+        SceneGraph,     ///< the Coin nodes of a view provider
+    };
+
+    struct Entry
+    {
+        std::string document;   ///< name of the document
+        std::string object;     ///< name of the object, empty for document wide entries
+        std::string label;      ///< label of the object
+        std::string name;       ///< name of the property
+        Category category;
+        std::size_t size;       ///< in bytes
+    };
+
+    /// The fields of the entries the totals can be grouped by
+    enum GroupBy {
+        ByDocument,
+        ByObject,
+        ByProperty,
+        ByCategory,
+    };
+
+    using Collector = std::function<void(MemoryReport&)>;
+
+    /// Adds the entries of all open documents, including the ones of the registered collectors
+    void collect();
+    /// Adds the properties of the objects and the undo/redo stack of \a doc
+    void addDocument(const Document* doc);
+    /// Adds one entry per property of \a container
+    void addProperties(const std::string& document, const std::string& object, const std::string& label,
+                       const PropertyContainer* container, Category category);
+    void add(Entry&& entry);
+
+    const std::vector<Entry>& entries() const {
+        return items;
+    }
+    /// Returns the sum of all entries
+    std::size_t total() const;
+    /** Returns the totals grouped by \a group, the biggest first. Objects are identified
+     * by "Document#Object".
+     */
+    std::vector<std::pair<std::string, std::size_t>> totals(GroupBy group) const;
+
+    static const char* categoryName(Category);
+
+    /// Registers a collector that adds the entries of a module in collect()
+    static void addCollector(const Collector&);
+
+private:
+    std::vector<Entry> items;
+    static std::vector<Collector> collectors;
+};
+
+} // namespace App
+
+#endif // APP_MEMORYREPORT_H
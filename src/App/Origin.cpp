@@ -31,6 +31,7 @@
 #include <Base/Exception.h>
 #include <Base/Placement.h>
 
+#include <App/Application.h>
 #include <App/Document.h>
 #include "OriginFeature.h"
 
@@ -48,9 +49,31 @@ PROPERTY_SOURCE(App::Origin, App::DocumentObject)
 const char* Origin::AxisRoles[3] = {"X_Axis", "Y_Axis", "Z_Axis"};
 const char* Origin::PlaneRoles[3] = {"XY_Plane", "XZ_Plane", "YZ_Plane"};
 
+namespace {
+struct OriginSetupData {
+    Base::Type type;
+    const char *role;
+    Base::Rotation rot;
+};
+
+const std::vector<OriginSetupData> &originSetupData() {
+    const static std::vector<OriginSetupData> setupData = {
+        {App::Line::getClassTypeId(), "X_Axis", Base::Rotation () },
+        {App::Line::getClassTypeId(), "Y_Axis", Base::Rotation ( Base::Vector3d (1,1,1), M_PI*2/3 ) },
+        {App::Line::getClassTypeId(), "Z_Axis", Base::Rotation ( Base::Vector3d (1,1,1), M_PI*4/3 ) },
+        {App::Plane::getClassTypeId (), "XY_Plane", Base::Rotation () },
+        {App::Plane::getClassTypeId (), "XZ_Plane", Base::Rotation ( 1.0, 0.0, 0.0, 1.0 ), },
+        {App::Plane::getClassTypeId (), "YZ_Plane", Base::Rotation ( Base::Vector3d (1,1,1), M_PI*2/3 ) },
+    };
+    return setupData;
+}
+}
+
 Origin::Origin(void) : extension(this) {
     ADD_PROPERTY_TYPE ( OriginFeatures, (0), 0, App::Prop_Hidden,
             "Axis and baseplanes controlled by the origin" );
+    ADD_PROPERTY_TYPE ( Compact, (false), 0, App::Prop_Hidden,
+            "Create the axis and baseplanes only when they are used" );
 
     setStatus(App::NoAutoExpand,true);
     extension.initExtension(this);
@@ -60,7 +83,7 @@ Origin::Origin(void) : extension(this) {
 Origin::~Origin(void)
 { }
 
-App::OriginFeature *Origin::getOriginFeature( const char *role) const {
+App::OriginFeature *Origin::findOriginFeature( const char *role) const {
     const auto & features = OriginFeatures.getValues ();
     auto featIt = std::find_if (features.begin(), features.end(),
             [role] (App::DocumentObject *obj) {
@@ -69,8 +92,28 @@ App::OriginFeature *Origin::getOriginFeature( const char *role) const {
             } );
     if (featIt != features.end()) {
         return static_cast<App::OriginFeature *>(*featIt);
-    } else {
+    }
+    return nullptr;
+}
+
+App::OriginFeature *Origin::getOriginFeature( const char *role) const {
+    App::OriginFeature *feat = findOriginFeature (role);
+    if (feat) {
+        return feat;
+    }
+
+    // A compact origin creates its features on demand. This is not done while the
+    // document is restored or undone, then the features must come from the file or the
+    // transaction.
+    App::Document *doc = getDocument ();
+    if (Compact.getValue () && doc && !doc->testStatus(App::Document::Restoring)
+            && !doc->isPerformingTransaction () && !isRemoving ()) {
+        feat = const_cast<Origin*>(this)->createOriginFeature (role);
+    }
 
+    if (feat) {
+        return feat;
+    } else {
         std::stringstream err;
         err << "Origin \"" << getFullName () << "\" doesn't contain feature with role \""
             << role << '"';
@@ -118,11 +161,17 @@ short Origin::mustExecute(void) const {
 App::DocumentObjectExecReturn *Origin::execute(void) {
     try { // try to find all base axis and planes in the origin
         for (const char* role: AxisRoles) {
+            if (Compact.getValue () && !findOriginFeature (role)) {
+                continue;
+            }
             App::Line *axis = getAxis (role);
             assert(axis);
             (void)axis;
         }
         for (const char* role: PlaneRoles) {
+            if (Compact.getValue () && !findOriginFeature (role)) {
+                continue;
+            }
             App::Plane *plane = getPlane (role);
             assert(plane);
             (void)plane;
@@ -136,23 +185,18 @@ App::DocumentObjectExecReturn *Origin::execute(void) {
 }
 
 void Origin::setupObject () {
-    const static struct {
-        const Base::Type type;
-        const char *role;
-        Base::Rotation rot;
-    } setupData [] = {
-        {App::Line::getClassTypeId(), "X_Axis", Base::Rotation () },
-        {App::Line::getClassTypeId(), "Y_Axis", Base::Rotation ( Base::Vector3d (1,1,1), M_PI*2/3 ) },
-        {App::Line::getClassTypeId(), "Z_Axis", Base::Rotation ( Base::Vector3d (1,1,1), M_PI*4/3 ) },
-        {App::Plane::getClassTypeId (), "XY_Plane", Base::Rotation () },
-        {App::Plane::getClassTypeId (), "XZ_Plane", Base::Rotation ( 1.0, 0.0, 0.0, 1.0 ), },
-        {App::Plane::getClassTypeId (), "YZ_Plane", Base::Rotation ( Base::Vector3d (1,1,1), M_PI*2/3 ) },
-    };
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Document");
+    if (hGrp->GetBool("CompactOrigin", false)) {
+        // the features are created by getOriginFeature() when they are needed
+        Compact.setValue (true);
+        return;
+    }
 
     App::Document *doc = getDocument ();
 
     std::vector<App::DocumentObject *> links;
-    for (auto data: setupData) {
+    for (const auto &data: originSetupData()) {
         std::string objName = doc->getUniqueObjectName ( data.role );
         App::DocumentObject *featureObj = doc->addObject ( data.type.getName(), objName.c_str () );
 
@@ -168,6 +212,32 @@ void Origin::setupObject () {
     OriginFeatures.setValues (links);
 }
 
+App::OriginFeature *Origin::createOriginFeature (const char *role) {
+    const auto &setupData = originSetupData();
+    auto it = std::find_if (setupData.begin(), setupData.end(),
+            [role] (const OriginSetupData &data) { return strcmp (data.role, role) == 0; } );
+    if (it == setupData.end()) {
+        return nullptr;
+    }
+
+    App::Document *doc = getDocument ();
+    std::string objName = doc->getUniqueObjectName ( it->role );
+    App::DocumentObject *featureObj = doc->addObject ( it->type.getName(), objName.c_str () );
+    if ( !featureObj || !featureObj->isDerivedFrom ( App::OriginFeature::getClassTypeId () ) ) {
+        return nullptr;
+    }
+
+    App::OriginFeature *feature = static_cast <App::OriginFeature *> ( featureObj );
+    feature->Placement.setValue ( Base::Placement ( Base::Vector3d (), it->rot ) );
+    feature->Role.setValue ( it->role );
+
+    std::vector<App::DocumentObject *> links = OriginFeatures.getValues ();
+    links.push_back (feature);
+    OriginFeatures.setValues (links);
+
+    return feature;
+}
+
 void Origin::unsetupObject () {
     const auto &objsLnk = OriginFeatures.getValues ();
     // Copy to set to assert we won't call methode more then one time for each object
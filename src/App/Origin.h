@@ -96,9 +96,14 @@ public:
         return { getX(), getY(), getZ(), getXY(), getXZ(), getYZ() };
     }
 
-    /// Returns an axis by it's name
+    /** Returns an axis or plane by it's role name
+     * In compact mode a missing feature is created on the first request.
+     */
     App::OriginFeature *getOriginFeature( const char* role ) const;
 
+    /// Returns an axis or plane by it's role name or null if it doesn't exist (yet)
+    App::OriginFeature *findOriginFeature( const char* role ) const;
+
     /// Returns an axis by it's name
     App::Line *getAxis( const char* role ) const;
 
@@ -123,6 +128,11 @@ public:
 
     // Axis links
     PropertyLinkList OriginFeatures;
+    /** If true the axes and planes are only created when they are requested, e.g. when
+     * they are referenced, resolved by getSubObject() or shown. Set up from the parameter
+     * BaseApp/Preferences/Document/CompactOrigin when the origin is created.
+     */
+    PropertyBool Compact;
 
 protected:
     /// Checks integrity of the Origin
@@ -135,6 +145,8 @@ protected:
 private:
     struct SetupData;
     void setupOriginFeature (App::PropertyLink &featProp, const SetupData &data);
+    /// Creates the feature of the given role and adds it to OriginFeatures
+    App::OriginFeature *createOriginFeature (const char *role);
 
     class OriginExtension : public GeoFeatureGroupExtension {
         Origin* obj;
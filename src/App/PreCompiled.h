@@ -84,6 +84,7 @@
 #include <iterator>
 #include <functional>
 #include <tuple>
+#include <algorithm>
 
 // Boost
 #include <boost_signals2.hpp>
@@ -225,6 +225,13 @@ public:
 
     /// Returns a new copy of the property (mainly for Undo/Redo and transactions)
     virtual Property *Copy(void) const = 0;
+    /** Returns a new copy of the property to be kept by Undo/Redo
+     *
+     * The default implementation calls Copy(). Properties holding large data
+     * that is never modified in place may share it with the returned copy.
+     * Also used by PropertyContainer::copyProperties().
+     */
+    virtual Property *CopyForUndo(void) const { return Copy(); }
     /// Paste the value from the property (mainly for Undo/Redo and transactions)
     virtual void Paste(const Property &from) = 0;
 
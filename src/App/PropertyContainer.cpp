@@ -27,6 +27,7 @@
 # include <cassert>
 # include <algorithm>
 # include <functional>
+# include <memory>
 #endif
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
@@ -241,72 +242,125 @@ void PropertyContainer::Save (Base::Writer &writer) const
     }
 
     writer.incInd(); // indentation for 'Properties Count'
-    writer.Stream() << writer.ind() << "<Properties Count=\"" << Map.size()
-                    << "\" TransientCount=\"" << transients.size() << "\">" << endl;
+    writer.beginElement("Properties")
+          .addAttribute("Count", Map.size())
+          .addAttribute("TransientCount", transients.size())
+          .endElement(false);
 
     // First store transient properties to persist their status value. We use
     // a new element named "_Property" so that the save file can be opened by
     // older versions of FC.
     writer.incInd();
     for(auto prop : transients) {
-        writer.Stream() << writer.ind() << "<_Property name=\"" << prop->getName() 
-            << "\" type=\"" << prop->getTypeId().getName() 
-            << "\" status=\"" << prop->getStatus() << "\"/>" << std::endl;
+        writer.beginElement("_Property")
+              .addAttribute("name", prop->getName())
+              .addAttribute("type", prop->getTypeId().getName())
+              .addAttribute("status", prop->getStatus())
+              .endElement();
     }
     writer.decInd();
 
     // Now store normal properties
     for (auto it = Map.begin(); it != Map.end(); ++it)
-    {
-        writer.incInd(); // indentation for 'Property name'
-        writer.Stream() << writer.ind() << "<Property name=\"" << it->first << "\" type=\"" 
-                        << it->second->getTypeId().getName();
+        saveProperty(writer, it->first.c_str(), it->second);
+    writer.Stream() << writer.ind() << "</Properties>" << endl;
+    writer.decInd(); // indentation for 'Properties Count'
+}
 
-        dynamicProps.save(it->second,writer);
+void PropertyContainer::saveProperties(Base::Writer &writer, const std::vector<Property*> &props) const
+{
+    std::vector<Property*> persistents;
+    for(auto prop : props) {
+        if(prop->getContainer() != this
+                || prop->testStatus(Property::PropNoPersist)
+                || prop->testStatus(Property::Transient)
+                || getPropertyType(prop) & Prop_Transient)
+            continue;
+        persistents.push_back(prop);
+    }
 
-        auto status = it->second->getStatus();
-        if(status)
-            writer.Stream() << "\" status=\"" << status;
-        writer.Stream() << "\">";
+    writer.incInd(); // indentation for 'Properties Count'
+    writer.beginElement("Properties")
+          .addAttribute("Count", persistents.size())
+          .addAttribute("TransientCount", 0)
+          .endElement(false);
+    for(auto prop : persistents)
+        saveProperty(writer, prop->getName(), prop);
+    writer.Stream() << writer.ind() << "</Properties>" << endl;
+    writer.decInd(); // indentation for 'Properties Count'
+}
 
-        if(it->second->testStatus(Property::Transient) 
-                || it->second->getType() & Prop_Transient) 
-        {
-            writer.decInd();
-            writer.Stream() << "</Property>" << std::endl;
+void PropertyContainer::copyProperties(const PropertyContainer &from)
+{
+    std::vector<Property*> props;
+    from.getPropertyList(props);
+    for(auto prop : props) {
+        if(prop->testStatus(Property::PropNoPersist))
             continue;
+        auto dst = getPropertyByName(prop->getName());
+        if(!dst && prop->testStatus(Property::PropDynamic)) {
+            auto data = from.getDynamicPropertyData(prop);
+            dst = addDynamicProperty(prop->getTypeId().getName(), prop->getName(),
+                    data.group.c_str(), data.doc.c_str(), data.attr, data.readonly, data.hidden);
         }
+        if(!dst || dst->getTypeId() != prop->getTypeId())
+            continue;
+        dst->setStatusValue(prop->getStatus());
+        if(prop->testStatus(Property::Transient) || prop->getType() & Prop_Transient)
+            continue;
+        std::unique_ptr<Property> copy(prop->CopyForUndo());
+        dst->Paste(*copy);
+    }
+}
 
-        writer.Stream() << std::endl;
-       
-        writer.incInd(); // indentation for the actual property
+void PropertyContainer::saveProperty(Base::Writer &writer, const char *name, Property *prop) const
+{
+    writer.incInd(); // indentation for 'Property name'
+    writer.Stream() << writer.ind() << "<Property name=\"" << name << "\" type=\"" 
+                    << prop->getTypeId().getName();
 
-        try {
-            // We must make sure to handle all exceptions accordingly so that
-            // the project file doesn't get invalidated. In the error case this
-            // means to proceed instead of aborting the write operation.
-            it->second->Save(writer);
-        }
-        catch (const Base::Exception &e) {
-            Base::Console().Error("%s\n", e.what());
-        }
-        catch (const std::exception &e) {
-            Base::Console().Error("%s\n", e.what());
-        }
-        catch (const char* e) {
-            Base::Console().Error("%s\n", e);
-        }
+    dynamicProps.save(prop,writer);
+
+    auto status = prop->getStatus();
+    if(status)
+        writer.Stream() << "\" status=\"" << status;
+    writer.Stream() << "\">";
+
+    if(prop->testStatus(Property::Transient) 
+            || prop->getType() & Prop_Transient) 
+    {
+        writer.decInd();
+        writer.Stream() << "</Property>\n";
+        return;
+    }
+
+    writer.Stream() << '\n';
+   
+    writer.incInd(); // indentation for the actual property
+
+    try {
+        // We must make sure to handle all exceptions accordingly so that
+        // the project file doesn't get invalidated. In the error case this
+        // means to proceed instead of aborting the write operation.
+        prop->Save(writer);
+    }
+    catch (const Base::Exception &e) {
+        Base::Console().Error("%s\n", e.what());
+    }
+    catch (const std::exception &e) {
+        Base::Console().Error("%s\n", e.what());
+    }
+    catch (const char* e) {
+        Base::Console().Error("%s\n", e);
+    }
 #ifndef FC_DEBUG
-        catch (...) {
-            Base::Console().Error("PropertyContainer::Save: Unknown C++ exception thrown. Try to continue...\n");
-        }
-#endif
-        writer.decInd(); // indentation for the actual property
-        writer.Stream() << writer.ind() << "</Property>" << endl;    
-        writer.decInd(); // indentation for 'Property name'
+    catch (...) {
+        Base::Console().Error("PropertyContainer::Save: Unknown C++ exception thrown. Try to continue...\n");
     }
-    writer.Stream() << writer.ind() << "</Properties>" << endl;
-    writer.decInd(); // indentation for 'Properties Count'
+#endif
+    writer.decInd(); // indentation for the actual property
+    writer.Stream() << writer.ind() << "</Property>\n";
+    writer.decInd(); // indentation for 'Property name'
 }
 
 void PropertyContainer::Restore(Base::XMLReader &reader)
@@ -333,6 +387,9 @@ void PropertyContainer::Restore(Base::XMLReader &reader)
         std::string PropName = reader.getAttribute("name");
         std::string TypeName = reader.getAttribute("type");
         auto prop = dynamicProps.restore(*this,PropName.c_str(),TypeName.c_str(),reader);
+        // a dynamic property hides a static one with the same name
+        if(!prop && (!dynamicProps.size() || !dynamicProps.getDynamicPropertyByName(PropName.c_str())))
+            prop = getPropertyData().getRestoreProperty(this,i,PropName.c_str());
         if(!prop)
             prop = getPropertyByName(PropName.c_str());
 
@@ -461,6 +518,7 @@ void PropertyData::split(PropertyData *other) {
         auto &index = propertyData.get<2>();
         for(const auto &spec : other->propertyData.get<0>())
             index.erase(spec.Offset);
+        restorePlan.clear();
     }
 }
 
@@ -570,6 +628,25 @@ Property *PropertyData::getPropertyByName(OffsetBase offsetBase,const char* name
     return 0;
 }
 
+Property *PropertyData::getRestoreProperty(OffsetBase offsetBase,std::size_t index,const char* name) const
+{
+    if(index < restorePlan.size()) {
+        const auto &step = restorePlan[index];
+        if(step.Name && strcmp(step.Name,name) == 0)
+            return (Property *) (step.Offset + offsetBase.getOffset());
+    }
+
+    const PropertyData::PropertySpec* Spec = findProperty(offsetBase,name);
+    if(!Spec)
+        return 0;
+
+    if(index >= restorePlan.size())
+        restorePlan.resize(index+1);
+    restorePlan[index].Name = Spec->Name;
+    restorePlan[index].Offset = Spec->Offset;
+    return (Property *) (Spec->Offset + offsetBase.getOffset());
+}
+
 void PropertyData::getPropertyMap(OffsetBase offsetBase,std::map<std::string,Property*> &Map) const
 {
     merge();
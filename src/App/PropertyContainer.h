@@ -114,6 +114,14 @@ struct AppExport PropertyData
 
   const PropertyData*     parentPropertyData;
 
+  // The static properties in the order of the last restored container, see getRestoreProperty()
+  struct RestoreStep
+  {
+    const char * Name = 0;
+    short Offset = 0;
+  };
+  mutable std::vector<RestoreStep> restorePlan;
+
   void addProperty(OffsetBase offsetBase,const char* PropName, Property *Prop, const char* PropertyGroup= 0, PropertyType = Prop_None, const char* PropertyDocu= 0 );
 
   const PropertySpec *findProperty(OffsetBase offsetBase,const char* PropName) const;
@@ -128,6 +136,12 @@ struct AppExport PropertyData
   const char* getDocumentation(OffsetBase offsetBase,const Property* prop) const;
 
   Property *getPropertyByName(OffsetBase offsetBase,const char* name) const;
+  /** Returns the static property with the given name that is saved at position \a index of
+   * a property list. Containers of the same type usually save their properties in the same
+   * order, so the property is remembered per position to resolve the name of the next
+   * container with a single string comparison.
+   */
+  Property *getRestoreProperty(OffsetBase offsetBase,std::size_t index,const char* name) const;
   void getPropertyMap(OffsetBase offsetBase,std::map<std::string,Property*> &Map) const;
   void getPropertyList(OffsetBase offsetBase,std::vector<Property*> &List) const;
 
@@ -215,6 +229,22 @@ public:
   virtual void Save (Base::Writer &writer) const;
   virtual void Restore(Base::XMLReader &reader);
 
+  /** Save only the given properties in the format read by Restore()
+   *
+   * Used to write incremental changes, e.g. by the recovery journal of the
+   * AutoSaver. Transient properties are skipped.
+   */
+  void saveProperties(Base::Writer &writer, const std::vector<Property*> &props) const;
+
+  /** Copy the persistent properties of another container in memory
+   *
+   * Does the same as saving \a from and restoring it into this container:
+   * missing dynamic properties are added, transient properties only get
+   * their status. The values are transferred by Property::CopyForUndo() and
+   * Paste(), so large immutable data is shared instead of serialized.
+   */
+  void copyProperties(const PropertyContainer &from);
+
   const char *getPropertyPrefix() const {
       return _propertyPrefix.c_str();
   }
@@ -241,6 +271,8 @@ protected:
   virtual void handleChangedPropertyType(Base::XMLReader &reader, const char * TypeName, Property * prop);
 
 private:
+  void saveProperty(Base::Writer &writer, const char *name, Property *prop) const;
+
   // forbidden
   PropertyContainer(const PropertyContainer&);
   PropertyContainer& operator = (const PropertyContainer&);
@@ -24,14 +24,18 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <sstream>
 #endif
 
 #include "PropertyContainer.h"
 #include "Property.h"
 #include "PropertyLinks.h"
+#include "PropertyStandard.h"
+#include "PropertyGeo.h"
 #include "Application.h"
 #include "DocumentObject.h"
+#include <Base/PyBuffer.h>
 
 #include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/stream.hpp>
@@ -500,6 +504,98 @@ PyObject* PropertyContainerPy::restorePropertyContent(PyObject *args)
     Py_Return;
 }
 
+PyObject* PropertyContainerPy::getPropertyArray(PyObject *args)
+{
+    char* property;
+    if (!PyArg_ParseTuple(args, "s", &property))
+        return NULL;
+
+    Property* prop = getPropertyContainerPtr()->getPropertyByName(property);
+    if (!prop) {
+        PyErr_Format(PyExc_AttributeError, "Property container has no property '%s'", property);
+        return NULL;
+    }
+
+    if (prop->isDerivedFrom(PropertyFloatList::getClassTypeId())) {
+        const std::vector<double>& values = static_cast<PropertyFloatList*>(prop)->getValues();
+        return Base::createArrayView(static_cast<Py_ssize_t>(values.size()), 1, "d", sizeof(double),
+                                     [&values](char* data) {
+            std::copy(values.begin(), values.end(), reinterpret_cast<double*>(data));
+        });
+    }
+    else if (prop->isDerivedFrom(PropertyIntegerList::getClassTypeId())) {
+        const std::vector<long>& values = static_cast<PropertyIntegerList*>(prop)->getValues();
+        return Base::createArrayView(static_cast<Py_ssize_t>(values.size()), 1, "l", sizeof(long),
+                                     [&values](char* data) {
+            std::copy(values.begin(), values.end(), reinterpret_cast<long*>(data));
+        });
+    }
+    else if (prop->isDerivedFrom(PropertyVectorList::getClassTypeId())) {
+        const std::vector<Base::Vector3d>& values = static_cast<PropertyVectorList*>(prop)->getValues();
+        return Base::createArrayView(static_cast<Py_ssize_t>(values.size()), 3, "d", sizeof(double),
+                                     [&values](char* data) {
+            double* coords = reinterpret_cast<double*>(data);
+            for (const auto& it : values) {
+                *coords++ = it.x;
+                *coords++ = it.y;
+                *coords++ = it.z;
+            }
+        });
+    }
+
+    PyErr_Format(PyExc_TypeError, "Property '%s' is not a float, integer or vector list", property);
+    return NULL;
+}
+
+PyObject* PropertyContainerPy::setPropertyArray(PyObject *args)
+{
+    char* property;
+    PyObject* array;
+    if (!PyArg_ParseTuple(args, "sO", &property, &array))
+        return NULL;
+
+    Property* prop = getPropertyContainerPtr()->getPropertyByName(property);
+    if (!prop) {
+        PyErr_Format(PyExc_AttributeError, "Property container has no property '%s'", property);
+        return NULL;
+    }
+    if (prop->testStatus(Property::Immutable)) {
+        PyErr_Format(PyExc_AttributeError, "Object attribute '%s' is read-only", property);
+        return NULL;
+    }
+
+    PY_TRY {
+        if (prop->isDerivedFrom(PropertyFloatList::getClassTypeId())) {
+            std::vector<double> values;
+            if (!Base::readArrayBuffer(array, 1, values))
+                return NULL;
+            static_cast<PropertyFloatList*>(prop)->setValues(values);
+        }
+        else if (prop->isDerivedFrom(PropertyIntegerList::getClassTypeId())) {
+            std::vector<long long> values;
+            if (!Base::readArrayBuffer(array, 1, values))
+                return NULL;
+            static_cast<PropertyIntegerList*>(prop)->setValues(std::vector<long>(values.begin(), values.end()));
+        }
+        else if (prop->isDerivedFrom(PropertyVectorList::getClassTypeId())) {
+            std::vector<double> coords;
+            if (!Base::readArrayBuffer(array, 3, coords))
+                return NULL;
+            std::vector<Base::Vector3d> values;
+            values.reserve(coords.size() / 3);
+            for (std::size_t i = 0; i < coords.size(); i += 3)
+                values.emplace_back(coords[i], coords[i+1], coords[i+2]);
+            static_cast<PropertyVectorList*>(prop)->setValues(values);
+        }
+        else {
+            PyErr_Format(PyExc_TypeError, "Property '%s' is not a float, integer or vector list", property);
+            return NULL;
+        }
+    } PY_CATCH;
+
+    Py_Return;
+}
+
 PyObject *PropertyContainerPy::getCustomAttributes(const char* attr) const
 {
     // search in PropertyList
@@ -28,6 +28,7 @@
 #include <Base/Writer.h>
 #include <Base/Reader.h>
 #include <Base/Tools.h>
+#include "CompiledExpression.h"
 #include "Expression.h"
 #include "ExpressionVisitors.h"
 #include "PropertyExpressionEngine.h"
@@ -119,6 +120,11 @@ Property *PropertyExpressionEngine::Copy() const
 
 void PropertyExpressionEngine::hasSetValue()
 {
+    // Expressions may have been modified in place, e.g. by renaming
+    for(auto &e : expressions)
+        e.second.compiled.reset();
+    evaluationOrders.clear();
+
     App::DocumentObject *owner = dynamic_cast<App::DocumentObject*>(getContainer());
     if(!owner || !owner->getNameInDocument() || owner->isRestoring() || testFlag(LinkDetached)) {
         PropertyExpressionContainer::hasSetValue();
@@ -477,6 +483,28 @@ std::vector<App::ObjectIdentifier> PropertyExpressionEngine::computeEvaluationOr
     return evaluationOrder;
 }
 
+/**
+ * @brief Return the evaluation order for the given option, reusing the one
+ * computed by a previous call as long as neither the expressions nor the
+ * document structure changed.
+ */
+
+std::shared_ptr<const std::vector<App::ObjectIdentifier> >
+PropertyExpressionEngine::getEvaluationOrder(ExecuteOption option)
+{
+    // Property look up, and thus the graph, depends on the document structure
+    if(evaluationOrderEpoch != CompiledExpression::getEpoch()) {
+        evaluationOrders.clear();
+        evaluationOrderEpoch = CompiledExpression::getEpoch();
+    }
+
+    auto &order = evaluationOrders[option];
+    if(!order)
+        order = std::make_shared<const std::vector<App::ObjectIdentifier> >(
+                computeEvaluationOrder(option));
+    return order;
+}
+
 /**
  * @brief Compute and update values of all registered expressions.
  * @return StdReturn on success.
@@ -525,8 +553,12 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
 
     resetter r(running);
 
-    // Compute evaluation order
-    std::vector<App::ObjectIdentifier> evaluationOrder = computeEvaluationOrder(option);
+    // Compute evaluation order. Hold a reference, as setting a property
+    // value below may modify the expressions and clear the cache.
+    auto evaluationOrderPtr = option == ExecuteOnRestore ?
+        std::make_shared<const std::vector<App::ObjectIdentifier> >(computeEvaluationOrder(option))
+        : getEvaluationOrder(option);
+    const auto &evaluationOrder = *evaluationOrderPtr;
     std::vector<ObjectIdentifier>::const_iterator it = evaluationOrder.begin();
 
 #ifdef FC_PROPERTYEXPRESSIONENGINE_LOG
@@ -551,8 +583,23 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
         /* Set value of property */
         App::any value;
         try {
-            // Evaluate expression
-            value = expressions[*it].expression->getValueAsAny();
+            // Evaluate expression, use the compiled form if possible
+            auto &info = expressions[*it];
+            if(!info.compiled || !info.compiled->isValid())
+                info.compiled = CompiledExpression::compile(info.expression.get());
+            auto compiled = info.compiled;
+
+            // Skip the expression if neither its inputs nor the bound
+            // property changed since it was last evaluated. Changes of a
+            // property bound earlier in the evaluation order show up as
+            // changed input, so this propagates downstream.
+            if(option != ExecuteOnRestore
+                    && !prop->isTouched()
+                    && !compiled->isInputChanged())
+                continue;
+
+            if(!compiled->evaluate(value))
+                value = info.expression->getValueAsAny();
             if(option == ExecuteOnRestore && prop->testStatus(Property::EvalOnRestore)) {
                 if(isAnyEqual(value, prop->getPathValue(*it)))
                     continue;
@@ -560,6 +607,7 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
                     *touched = true;
             }
             prop->setPathValue(*it, value);
+            compiled->recordInputs();
         }catch(Base::Exception &e) {
             std::ostringstream ss;
             ss << e.what() << std::endl << "in property binding '" << prop->getName() << "'";
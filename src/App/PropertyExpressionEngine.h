@@ -30,6 +30,7 @@
 #include <boost/graph/topological_sort.hpp>
 #include <App/PropertyLinks.h>
 #include <App/Expression.h>
+#include <map>
 #include <set>
 
 namespace Base {
@@ -43,6 +44,7 @@ class DocumentObject;
 class DocumentObjectExecReturn;
 class ObjectIdentifier;
 class Expression;
+class CompiledExpression;
 
 class AppExport PropertyExpressionContainer : public App::PropertyXLinkContainer
 {
@@ -85,6 +87,7 @@ public:
 
     struct ExpressionInfo {
         std::shared_ptr<App::Expression> expression; /**< The actual expression tree */
+        std::shared_ptr<App::CompiledExpression> compiled; /**< Lazily compiled form, not copied */
 
         ExpressionInfo(std::shared_ptr<App::Expression> expression = std::shared_ptr<App::Expression>()) {
             this->expression = expression;
@@ -178,6 +181,8 @@ private:
 
     std::vector<App::ObjectIdentifier> computeEvaluationOrder(ExecuteOption option);
 
+    std::shared_ptr<const std::vector<App::ObjectIdentifier> > getEvaluationOrder(ExecuteOption option);
+
     void buildGraphStructures(const App::ObjectIdentifier &path,
                               const std::shared_ptr<Expression> expression, boost::unordered_map<App::ObjectIdentifier, int> &nodes,
                               boost::unordered_map<int, App::ObjectIdentifier> &revNodes, std::vector<Edge> &edges) const;
@@ -191,6 +196,10 @@ private:
 
     ExpressionMap expressions; /**< Stored expressions */
 
+    /// Cached evaluation order per execute option, cleared on any expression change
+    std::map<int, std::shared_ptr<const std::vector<App::ObjectIdentifier> > > evaluationOrders;
+    unsigned long evaluationOrderEpoch = 0;
+
     ValidatorFunc validator; /**< Valdiator functor */
 
     struct RestoredExpression {
@@ -149,7 +149,11 @@ void PropertyVector::setPyObject(PyObject *value)
 
 void PropertyVector::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<PropertyVector valueX=\"" <<  _cVec.x << "\" valueY=\"" <<  _cVec.y << "\" valueZ=\"" <<  _cVec.z <<"\"/>" << endl;
+    writer.beginElement("PropertyVector")
+          .addAttribute("valueX", _cVec.x)
+          .addAttribute("valueY", _cVec.y)
+          .addAttribute("valueZ", _cVec.z)
+          .endElement();
 }
 
 void PropertyVector::Restore(Base::XMLReader &reader)
@@ -477,12 +481,16 @@ void PropertyMatrix::setPyObject(PyObject *value)
 
 void PropertyMatrix::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<PropertyMatrix";
-    writer.Stream() << " a11=\"" <<  _cMat[0][0] << "\" a12=\"" <<  _cMat[0][1] << "\" a13=\"" <<  _cMat[0][2] << "\" a14=\"" <<  _cMat[0][3] << "\"";
-    writer.Stream() << " a21=\"" <<  _cMat[1][0] << "\" a22=\"" <<  _cMat[1][1] << "\" a23=\"" <<  _cMat[1][2] << "\" a24=\"" <<  _cMat[1][3] << "\"";
-    writer.Stream() << " a31=\"" <<  _cMat[2][0] << "\" a32=\"" <<  _cMat[2][1] << "\" a33=\"" <<  _cMat[2][2] << "\" a34=\"" <<  _cMat[2][3] << "\"";
-    writer.Stream() << " a41=\"" <<  _cMat[3][0] << "\" a42=\"" <<  _cMat[3][1] << "\" a43=\"" <<  _cMat[3][2] << "\" a44=\"" <<  _cMat[3][3] << "\"";
-    writer.Stream() <<"/>" << endl;
+    writer.beginElement("PropertyMatrix");
+    char name[] = "a11";
+    for (int i = 0; i < 4; i++) {
+        name[1] = static_cast<char>('1' + i);
+        for (int j = 0; j < 4; j++) {
+            name[2] = static_cast<char>('1' + j);
+            writer.addAttribute(name, _cMat[i][j]);
+        }
+    }
+    writer.endElement();
 }
 
 void PropertyMatrix::Restore(Base::XMLReader &reader)
@@ -696,23 +704,23 @@ void PropertyPlacement::setPyObject(PyObject *value)
 
 void PropertyPlacement::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<PropertyPlacement";
-    writer.Stream() << " Px=\"" <<  _cPos.getPosition().x 
-                    << "\" Py=\"" <<  _cPos.getPosition().y
-                    << "\" Pz=\"" <<  _cPos.getPosition().z << "\"";
+    writer.beginElement("PropertyPlacement")
+          .addAttribute("Px", _cPos.getPosition().x)
+          .addAttribute("Py", _cPos.getPosition().y)
+          .addAttribute("Pz", _cPos.getPosition().z);
 
-    writer.Stream() << " Q0=\"" <<  _cPos.getRotation()[0]
-                    << "\" Q1=\"" <<  _cPos.getRotation()[1]
-                    << "\" Q2=\"" <<  _cPos.getRotation()[2]
-                    << "\" Q3=\"" <<  _cPos.getRotation()[3] << "\"";
+    writer.addAttribute("Q0", _cPos.getRotation()[0])
+          .addAttribute("Q1", _cPos.getRotation()[1])
+          .addAttribute("Q2", _cPos.getRotation()[2])
+          .addAttribute("Q3", _cPos.getRotation()[3]);
     Vector3d axis;
     double rfAngle;
     _cPos.getRotation().getValue(axis, rfAngle);
-    writer.Stream() << " A=\"" <<  rfAngle
-                    << "\" Ox=\"" <<  axis.x
-                    << "\" Oy=\"" <<  axis.y
-                    << "\" Oz=\"" <<  axis.z << "\"";
-    writer.Stream() <<"/>" << endl;
+    writer.addAttribute("A", rfAngle)
+          .addAttribute("Ox", axis.x)
+          .addAttribute("Oy", axis.y)
+          .addAttribute("Oz", axis.z)
+          .endElement();
 }
 
 void PropertyPlacement::Restore(Base::XMLReader &reader)
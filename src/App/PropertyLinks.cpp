@@ -267,7 +267,10 @@ bool PropertyLinkBase::_updateElementReference(DocumentObject *feature,
     (void)obj;
     (void)reverse;
     (void)notify;
-    shadow.second = sub;
+    (void)sub;
+    // Without element mapping the old style reference is the subname itself,
+    // which is represented by an empty string. Release the memory of any copy.
+    std::string().swap(shadow.second);
     return false;
 }
 
@@ -1379,7 +1382,7 @@ void PropertyLinkSub::Restore(Base::XMLReader &reader)
             values[i] = shadows[i].first =
                 importSubName(reader,reader.getAttribute(ATTR_SHADOWED),restoreLabel);
         } else {
-            values[i] = shadows[i].second;
+            values[i].swap(shadows[i].second);
             if(reader.hasAttribute(ATTR_SHADOW) && !IGNORE_SHADOW)
                 shadows[i].first = importSubName(reader,reader.getAttribute(ATTR_SHADOW),restoreLabel);
         }
@@ -2161,7 +2164,8 @@ void PropertyLinkSubList::Restore(Base::XMLReader &reader)
                 shadow.first = importSubName(reader,reader.getAttribute(ATTR_SHADOWED),restoreLabel);
                 SubNames.push_back(shadow.first);
             }else{
-                SubNames.push_back(shadow.second);
+                SubNames.emplace_back();
+                SubNames.back().swap(shadow.second);
                 if(reader.hasAttribute(ATTR_SHADOW) && !IGNORE_SHADOW)
                     shadow.first = importSubName(reader,reader.getAttribute(ATTR_SHADOW),restoreLabel);
             }
@@ -2809,6 +2813,40 @@ public:
                 link->breakLink(obj,clear);
         }
     }
+
+    static void breakLinks(const std::set<App::DocumentObject*> &objs, bool clear) {
+        if(objs.empty())
+            return;
+        auto doc = (*objs.begin())->getDocument();
+        for(auto itD=_DocInfoMap.begin(),itDNext=itD;itD!=_DocInfoMap.end();itD=itDNext) {
+            ++itDNext;
+            auto docInfo = itD->second;
+            if(docInfo->pcDoc != doc)
+                continue;
+            auto &links = docInfo->links;
+            std::set<std::pair<PropertyLinkBase*,App::DocumentObject*> > parentLinks;
+            for(auto it=links.begin(),itNext=it;it!=links.end();it=itNext) {
+                ++itNext;
+                auto link = *it;
+                App::DocumentObject *obj = 0;
+                if(objs.count(link->_pcLink))
+                    obj = link->_pcLink;
+                else if(clear) {
+                    auto owner = dynamic_cast<App::DocumentObject*>(link->getContainer());
+                    if(owner && objs.count(owner))
+                        obj = owner;
+                }
+                if(!obj)
+                    continue;
+                if(link->parentProp)
+                    parentLinks.emplace(link->parentProp,obj);
+                else
+                    link->breakLink(obj,clear);
+            }
+            for(auto &v : parentLinks)
+                v.first->breakLink(v.second,clear);
+        }
+    }
 };
 
 void PropertyLinkBase::breakLinks(App::DocumentObject *link,
@@ -2827,6 +2865,34 @@ void PropertyLinkBase::breakLinks(App::DocumentObject *link,
     DocInfo::breakLinks(link,clear);
 }
 
+void PropertyLinkBase::breakLinks(const std::set<App::DocumentObject*> &links,
+        const std::vector<App::DocumentObject*> &objs, bool clear)
+{
+    std::vector<Property*> props;
+    std::vector<App::DocumentObject*> linked;
+    for(auto obj : objs) {
+        bool owner = clear && links.count(obj);
+        props.clear();
+        obj->getPropertyList(props);
+        for(auto prop : props) {
+            auto linkProp = dynamic_cast<PropertyLinkBase*>(prop);
+            if(!linkProp)
+                continue;
+            if(owner) {
+                linkProp->breakLink(obj,true);
+                continue;
+            }
+            linked.clear();
+            linkProp->getLinks(linked,true);
+            for(auto o : linked) {
+                if(links.count(o))
+                    linkProp->breakLink(o,clear);
+            }
+        }
+    }
+    DocInfo::breakLinks(links,clear);
+}
+
 //**************************************************************************
 // PropertyXLink
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -3295,7 +3361,7 @@ void PropertyXLink::Restore(Base::XMLReader &reader)
         if(reader.hasAttribute(ATTR_SHADOWED) && !IGNORE_SHADOW)
             subname = shadow.first = importSubName(reader,reader.getAttribute(ATTR_SHADOWED),restoreLabel);
         else {
-            subname = shadow.second;
+            subname.swap(shadow.second);
             if(reader.hasAttribute(ATTR_SHADOW) && !IGNORE_SHADOW)
                 shadow.first = importSubName(reader,reader.getAttribute(ATTR_SHADOW),restoreLabel);
         }
@@ -3310,7 +3376,7 @@ void PropertyXLink::Restore(Base::XMLReader &reader)
                 subs[i] = shadows[i].first =
                     importSubName(reader,reader.getAttribute(ATTR_SHADOWED),restoreLabel);
             else {
-                subs[i] = shadows[i].second;
+                subs[i].swap(shadows[i].second);
                 if(reader.hasAttribute(ATTR_SHADOW) && !IGNORE_SHADOW)
                     shadows[i].first = importSubName(reader,reader.getAttribute(ATTR_SHADOW),restoreLabel);
             }
@@ -29,6 +29,7 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include <list>
 #include <string>
 #include <memory>
@@ -104,6 +105,10 @@ class AppExport PropertyLinkBase : public Property, public ScopedLink
 {
     TYPESYSTEM_HEADER_WITH_OVERRIDE();
 public:
+    /** Pair of new and old style element references of a subname. An empty
+     * reference means that it is the same as the subname itself, so the
+     * common case doesn't keep a second copy of every subname.
+     */
     typedef std::pair<std::string,std::string> ShadowSub;
 
     PropertyLinkBase();
@@ -391,6 +396,19 @@ public:
      */
     static void breakLinks(App::DocumentObject *link, const std::vector<App::DocumentObject*> &objs, bool clear);
 
+    /** Reset the link properties linking to any of the given objects
+     *
+     * @param links: reset link property if it is linked to any of these objects
+     * @param objs: the objects to check for the link properties
+     * @param clear: if true, then also reset property if its owner is in \a links
+     *
+     * Same as calling the above function for each of \a links, but checks
+     * each link property only once. App::Document::removeObjects() calls
+     * this function.
+     */
+    static void breakLinks(const std::set<App::DocumentObject*> &links,
+            const std::vector<App::DocumentObject*> &objs, bool clear);
+
     /** Helper function for link import operation
      *
      * @param obj: the linked object
@@ -34,11 +34,427 @@
 #include <Base/Reader.h>
 #include <Base/Console.h>
 #include <Base/Interpreter.h>
+#include <cstring>
 #include <iostream>
+#include <map>
+#include <vector>
 #include <boost/regex.hpp>
 
 using namespace App;
 
+namespace {
+
+// Returns a (cached) function of the json module. The references are kept
+// for the lifetime of the interpreter on purpose, so that nothing has to be
+// released after Py_Finalize(). The GIL must be held by the caller.
+Py::Callable jsonFunction(const char *name)
+{
+    static std::map<std::string, PyObject*> functions;
+    PyObject *&func = functions[name];
+    if (!func) {
+        Py::Module json(PyImport_ImportModule("json"),true);
+        if (json.isNull())
+            throw Py::Exception();
+        func = Py::new_reference_to(json.getAttr(std::string(name)));
+    }
+    return Py::Callable(func);
+}
+
+void appendJsonString(PyObject *str, std::string &out)
+{
+    static const char hex[] = "0123456789abcdef";
+    auto appendEscape = [&out](Py_UCS4 c) {
+        out += "\\u";
+        out += hex[(c >> 12) & 0xf];
+        out += hex[(c >> 8) & 0xf];
+        out += hex[(c >> 4) & 0xf];
+        out += hex[c & 0xf];
+    };
+
+    out += '"';
+    Py_ssize_t len = PyUnicode_GetLength(str);
+    for (Py_ssize_t i = 0; i < len; ++i) {
+        Py_UCS4 c = PyUnicode_ReadChar(str, i);
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        default:
+            if (c >= ' ' && c <= '~') {
+                out += static_cast<char>(c);
+            }
+            else if (c > 0xffff) {
+                c -= 0x10000;
+                appendEscape(0xd800 | ((c >> 10) & 0x3ff));
+                appendEscape(0xdc00 | (c & 0x3ff));
+            }
+            else {
+                appendEscape(c);
+            }
+        }
+    }
+    out += '"';
+}
+
+// Encodes the state of a Python proxy without calling into the json module.
+// Only plain None/bool/int/float/str values and lists, tuples and str-keyed
+// dicts of those are handled, and the text is identical to what json.dumps()
+// produces with its default settings. Returns false for anything else, in
+// which case the caller falls back to json.dumps().
+bool dumpSimpleJson(PyObject *obj, std::string &out, int depth)
+{
+    if (depth > 32)
+        return false;
+
+    if (obj == Py_None) {
+        out += "null";
+    }
+    else if (obj == Py_True) {
+        out += "true";
+    }
+    else if (obj == Py_False) {
+        out += "false";
+    }
+    else if (PyUnicode_CheckExact(obj)) {
+        appendJsonString(obj, out);
+    }
+    else if (PyLong_CheckExact(obj) || PyFloat_CheckExact(obj)) {
+        if (PyFloat_CheckExact(obj)) {
+            double d = PyFloat_AS_DOUBLE(obj);
+            if (Py_IS_NAN(d)) {
+                out += "NaN";
+                return true;
+            }
+            if (Py_IS_INFINITY(d)) {
+                out += d > 0 ? "Infinity" : "-Infinity";
+                return true;
+            }
+        }
+        PyObject *repr = PyObject_Repr(obj);
+        if (!repr) {
+            PyErr_Clear();
+            return false;
+        }
+        const char *text = PyUnicode_AsUTF8(repr);
+        if (text)
+            out += text;
+        else
+            PyErr_Clear();
+        Py_DECREF(repr);
+        return text != nullptr;
+    }
+    else if (PyList_CheckExact(obj) || PyTuple_CheckExact(obj)) {
+        Py_ssize_t size = PySequence_Fast_GET_SIZE(obj);
+        PyObject **items = PySequence_Fast_ITEMS(obj);
+        out += '[';
+        for (Py_ssize_t i = 0; i < size; ++i) {
+            if (i)
+                out += ", ";
+            if (!dumpSimpleJson(items[i], out, depth+1))
+                return false;
+        }
+        out += ']';
+    }
+    else if (PyDict_CheckExact(obj)) {
+        PyObject *key, *value;
+        Py_ssize_t pos = 0;
+        bool first = true;
+        out += '{';
+        while (PyDict_Next(obj, &pos, &key, &value)) {
+            if (!PyUnicode_CheckExact(key))
+                return false;
+            if (!first)
+                out += ", ";
+            first = false;
+            appendJsonString(key, out);
+            out += ": ";
+            if (!dumpSimpleJson(value, out, depth+1))
+                return false;
+        }
+        out += '}';
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+// Counterpart of dumpSimpleJson(). Parses plain ASCII JSON text as written by
+// json.dumps() and returns a new reference, or nullptr (with no Python error
+// set) if the text is not understood, in which case json.loads() is used.
+class SimpleJsonReader
+{
+public:
+    explicit SimpleJsonReader(const std::string &str)
+        : cur(str.c_str()), end(str.c_str() + str.size())
+    {
+    }
+
+    PyObject *parse()
+    {
+        PyObject *res = parseValue(0);
+        skipSpace();
+        if (res && cur != end) {
+            Py_DECREF(res);
+            res = nullptr;
+        }
+        if (!res)
+            PyErr_Clear();
+        return res;
+    }
+
+private:
+    void skipSpace()
+    {
+        while (cur != end && (*cur == ' ' || *cur == '\t' || *cur == '\n' || *cur == '\r'))
+            ++cur;
+    }
+
+    bool digit() const
+    {
+        return cur != end && *cur >= '0' && *cur <= '9';
+    }
+
+    bool match(const char *token)
+    {
+        std::size_t len = strlen(token);
+        if (static_cast<std::size_t>(end - cur) < len || strncmp(cur, token, len) != 0)
+            return false;
+        cur += len;
+        return true;
+    }
+
+    PyObject *parseValue(int depth)
+    {
+        skipSpace();
+        if (cur == end || depth > 32)
+            return nullptr;
+
+        switch (*cur) {
+        case '"':
+            return parseString();
+        case '[':
+            return parseList(depth);
+        case '{':
+            return parseDict(depth);
+        case 'n':
+            if (match("null"))
+                Py_RETURN_NONE;
+            return nullptr;
+        case 't':
+            if (match("true"))
+                Py_RETURN_TRUE;
+            return nullptr;
+        case 'f':
+            if (match("false"))
+                Py_RETURN_FALSE;
+            return nullptr;
+        case 'N':
+            if (match("NaN"))
+                return PyFloat_FromDouble(Py_NAN);
+            return nullptr;
+        case 'I':
+            if (match("Infinity"))
+                return PyFloat_FromDouble(Py_HUGE_VAL);
+            return nullptr;
+        default:
+            return parseNumber();
+        }
+    }
+
+    PyObject *parseNumber()
+    {
+        if (match("-Infinity"))
+            return PyFloat_FromDouble(-Py_HUGE_VAL);
+
+        const char *start = cur;
+        bool isFloat = false;
+        if (cur != end && *cur == '-')
+            ++cur;
+        if (!digit())
+            return nullptr;
+        if (*cur == '0')
+            ++cur;
+        else
+            while (digit())
+                ++cur;
+        if (cur != end && *cur == '.') {
+            isFloat = true;
+            ++cur;
+            if (!digit())
+                return nullptr;
+            while (digit())
+                ++cur;
+        }
+        if (cur != end && (*cur == 'e' || *cur == 'E')) {
+            isFloat = true;
+            ++cur;
+            if (cur != end && (*cur == '+' || *cur == '-'))
+                ++cur;
+            if (!digit())
+                return nullptr;
+            while (digit())
+                ++cur;
+        }
+
+        std::string token(start, cur);
+        if (!isFloat)
+            return PyLong_FromString(token.c_str(), nullptr, 10);
+        double d = PyOS_string_to_double(token.c_str(), nullptr, nullptr);
+        if (d == -1.0 && PyErr_Occurred())
+            return nullptr;
+        return PyFloat_FromDouble(d);
+    }
+
+    bool parseHex(Py_UCS4 &c)
+    {
+        if (end - cur < 4)
+            return false;
+        c = 0;
+        for (int i = 0; i < 4; ++i, ++cur) {
+            char h = *cur;
+            c <<= 4;
+            if (h >= '0' && h <= '9')
+                c |= h - '0';
+            else if (h >= 'a' && h <= 'f')
+                c |= h - 'a' + 10;
+            else if (h >= 'A' && h <= 'F')
+                c |= h - 'A' + 10;
+            else
+                return false;
+        }
+        return true;
+    }
+
+    PyObject *parseString()
+    {
+        ++cur; // opening quote
+        std::vector<Py_UCS4> chars;
+        while (cur != end && *cur != '"') {
+            unsigned char c = static_cast<unsigned char>(*cur++);
+            // leave control and non-ASCII characters to the json module
+            if (c < 0x20 || c > 0x7f)
+                return nullptr;
+            if (c != '\\') {
+                chars.push_back(c);
+                continue;
+            }
+            if (cur == end)
+                return nullptr;
+            switch (*cur++) {
+            case '"':  chars.push_back('"'); break;
+            case '\\': chars.push_back('\\'); break;
+            case '/':  chars.push_back('/'); break;
+            case 'n':  chars.push_back('\n'); break;
+            case 'r':  chars.push_back('\r'); break;
+            case 't':  chars.push_back('\t'); break;
+            case 'b':  chars.push_back('\b'); break;
+            case 'f':  chars.push_back('\f'); break;
+            case 'u': {
+                Py_UCS4 u;
+                if (!parseHex(u))
+                    return nullptr;
+                // combine a surrogate pair the same way json.loads() does
+                if (u >= 0xd800 && u <= 0xdbff && end - cur >= 6
+                        && cur[0] == '\\' && cur[1] == 'u') {
+                    const char *save = cur;
+                    Py_UCS4 low;
+                    cur += 2;
+                    if (parseHex(low) && low >= 0xdc00 && low <= 0xdfff)
+                        u = 0x10000 + (((u - 0xd800) << 10) | (low - 0xdc00));
+                    else
+                        cur = save;
+                }
+                chars.push_back(u);
+                break;
+            }
+            default:
+                return nullptr;
+            }
+        }
+        if (cur == end)
+            return nullptr;
+        ++cur; // closing quote
+        if (chars.empty())
+            return PyUnicode_FromStringAndSize("", 0);
+        return PyUnicode_FromKindAndData(PyUnicode_4BYTE_KIND, chars.data(),
+                                         static_cast<Py_ssize_t>(chars.size()));
+    }
+
+    PyObject *parseList(int depth)
+    {
+        ++cur; // '['
+        Py::List list;
+        skipSpace();
+        if (cur != end && *cur == ']') {
+            ++cur;
+            return Py::new_reference_to(list);
+        }
+        for (;;) {
+            PyObject *item = parseValue(depth+1);
+            if (!item)
+                return nullptr;
+            PyList_Append(list.ptr(), item);
+            Py_DECREF(item);
+            skipSpace();
+            if (cur == end)
+                return nullptr;
+            if (*cur == ']') {
+                ++cur;
+                return Py::new_reference_to(list);
+            }
+            if (*cur++ != ',')
+                return nullptr;
+        }
+    }
+
+    PyObject *parseDict(int depth)
+    {
+        ++cur; // '{'
+        Py::Dict dict;
+        skipSpace();
+        if (cur != end && *cur == '}') {
+            ++cur;
+            return Py::new_reference_to(dict);
+        }
+        for (;;) {
+            skipSpace();
+            if (cur == end || *cur != '"')
+                return nullptr;
+            Py::Object key = Py::asObject(parseString());
+            if (key.isNull())
+                return nullptr;
+            skipSpace();
+            if (cur == end || *cur++ != ':')
+                return nullptr;
+            PyObject *value = parseValue(depth+1);
+            if (!value)
+                return nullptr;
+            PyDict_SetItem(dict.ptr(), key.ptr(), value);
+            Py_DECREF(value);
+            skipSpace();
+            if (cur == end)
+                return nullptr;
+            if (*cur == '}') {
+                ++cur;
+                return Py::new_reference_to(dict);
+            }
+            if (*cur++ != ',')
+                return nullptr;
+        }
+    }
+
+private:
+    const char *cur;
+    const char *end;
+};
+
+} // namespace
+
 
 TYPESYSTEM_SOURCE(App::PropertyPythonObject , App::Property)
 
@@ -85,10 +501,6 @@ std::string PropertyPythonObject::toString() const
     std::string repr;
     Base::PyGILStateLocker lock;
     try {
-        Py::Module pickle(PyImport_ImportModule("json"),true);
-        if (pickle.isNull())
-            throw Py::Exception();
-        Py::Callable method(pickle.getAttr(std::string("dumps")));
         Py::Object dump;
         if (this->object.hasAttr("__getstate__")) {
             Py::Tuple args;
@@ -102,11 +514,16 @@ std::string PropertyPythonObject::toString() const
             dump = this->object;
         }
 
-        Py::Tuple args(1);
-        args.setItem(0, dump);
-        Py::Object res = method.apply(args);
-        Py::String str(res);
-        repr = str.as_std_string("ascii");
+        // Most proxies only keep a few plain values in their state. Encode
+        // those natively and leave the rest to the json module.
+        if (!dumpSimpleJson(dump.ptr(), repr, 0)) {
+            repr.clear();
+            Py::Tuple args(1);
+            args.setItem(0, dump);
+            Py::Object res = jsonFunction("dumps").apply(args);
+            Py::String str(res);
+            repr = str.as_std_string("ascii");
+        }
     }
     catch (Py::Exception&) {
         Py::String typestr(this->object.type().str());
@@ -124,13 +541,12 @@ void PropertyPythonObject::fromString(const std::string& repr)
     try {
         if (repr.empty())
             return;
-        Py::Module pickle(PyImport_ImportModule("json"),true);
-        if (pickle.isNull())
-            throw Py::Exception();
-        Py::Callable method(pickle.getAttr(std::string("loads")));
-        Py::Tuple args(1);
-        args.setItem(0, Py::String(repr));
-        Py::Object res = method.apply(args);
+        Py::Object res = Py::asObject(SimpleJsonReader(repr).parse());
+        if (res.isNull()) {
+            Py::Tuple args(1);
+            args.setItem(0, Py::String(repr));
+            res = jsonFunction("loads").apply(args);
+        }
 
         if (this->object.hasAttr("__setstate__")) {
             Py::Tuple args(1);
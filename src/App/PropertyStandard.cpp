@@ -115,7 +115,7 @@ void PropertyInteger::setPyObject(PyObject *value)
 
 void PropertyInteger::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Integer value=\"" <<  _lValue <<"\"/>" << std::endl;
+    writer.beginElement("Integer").addAttribute("value", _lValue).endElement();
 }
 
 void PropertyInteger::Restore(Base::XMLReader &reader)
@@ -942,7 +942,7 @@ void PropertyFloat::setPyObject(PyObject *value)
 
 void PropertyFloat::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Float value=\"" <<  _dValue <<"\"/>" << std::endl;
+    writer.beginElement("Float").addAttribute("value", _dValue).endElement();
 }
 
 void PropertyFloat::Restore(Base::XMLReader &reader)
@@ -1187,10 +1187,10 @@ double PropertyFloatList::getPyValue(PyObject *item) const {
 void PropertyFloatList::Save (Base::Writer &writer) const
 {
     if (writer.isForceXML()) {
-        writer.Stream() << writer.ind() << "<FloatList count=\"" <<  getSize() <<"\">" << endl;
+        writer.beginElement("FloatList").addAttribute("count", getSize()).endElement(false);
         writer.incInd();
         for(int i = 0;i<getSize(); i++)
-            writer.Stream() << writer.ind() << "<F v=\"" <<  _lValueList[i] <<"\"/>" << endl; ;
+            writer.beginElement("F").addAttribute("v", _lValueList[i]).endElement();
         writer.decInd();
         writer.Stream() << writer.ind() <<"</FloatList>" << endl ;
     }
@@ -1435,24 +1435,23 @@ void PropertyString::setPyObject(PyObject *value)
 
 void PropertyString::Save (Base::Writer &writer) const
 {
-    std::string val;
     auto obj = dynamic_cast<DocumentObject*>(getContainer());
-    writer.Stream() << writer.ind() << "<String ";
+    writer.beginElement("String");
     bool exported = false;
     if(obj && obj->getNameInDocument() &&
        obj->isExporting() && &obj->Label==this)
     {
         if(obj->allowDuplicateLabel())
-            writer.Stream() <<"restore=\"1\" ";
+            writer.addAttribute("restore", "1");
         else if(_cValue==obj->getNameInDocument()) {
-            writer.Stream() <<"restore=\"0\" ";
-            val = encodeAttribute(obj->getExportName());
+            writer.addAttribute("restore", "0");
+            writer.addAttribute("value", obj->getExportName());
             exported = true;
         }
     }
     if(!exported)
-        val = encodeAttribute(_cValue);
-    writer.Stream() <<"value=\"" << val <<"\"/>" << std::endl;
+        writer.addAttribute("value", _cValue);
+    writer.endElement();
 }
 
 void PropertyString::Restore(Base::XMLReader &reader)
@@ -1989,12 +1988,7 @@ void PropertyBool::setPyObject(PyObject *value)
 
 void PropertyBool::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Bool value=\"" ;
-    if (_lValue)
-        writer.Stream() << "true" <<"\"/>" ;
-    else
-        writer.Stream() << "false" <<"\"/>" ;
-    writer.Stream() << std::endl;
+    writer.beginElement("Bool").addAttribute("value", _lValue).endElement();
 }
 
 void PropertyBool::Restore(Base::XMLReader &reader)
@@ -112,7 +112,10 @@ int Transaction::getLastID() {
 
 unsigned int Transaction::getMemSize (void) const
 {
-    return 0;
+    unsigned int size = 0;
+    for (auto &v : _Objects)
+        size += v.second->getMemSize();
+    return size;
 }
 
 void Transaction::Save (Base::Writer &/*writer*/) const
@@ -367,7 +370,7 @@ void TransactionObject::setProperty(const Property* pcProp)
     if(!data.property && data.name.empty()) {
         static_cast<DynamicProperty::PropData&>(data) = 
             pcProp->getContainer()->getDynamicPropertyData(pcProp);
-        data.property = pcProp->Copy();
+        data.property = pcProp->CopyForUndo();
         data.propertyType = pcProp->getTypeId();
         data.property->setStatusValue(pcProp->getStatus());
     }
@@ -398,7 +401,7 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
     if(add) 
         data.property = 0;
     else {
-        data.property = pcProp->Copy();
+        data.property = pcProp->CopyForUndo();
         data.propertyType = pcProp->getTypeId();
         data.property->setStatusValue(pcProp->getStatus());
     }
@@ -406,7 +409,13 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
 
 unsigned int TransactionObject::getMemSize (void) const
 {
-    return 0;
+    unsigned int size = 0;
+    for (auto &v : _PropChangeMap) {
+        size += sizeof(v);
+        if (v.second.property)
+            size += v.second.property->getMemSize();
+    }
+    return size;
 }
 
 void TransactionObject::Save (Base::Writer &/*writer*/) const
@@ -887,10 +887,32 @@ inline BoundBox2d BoundBox3<_Precision>::ProjectBox(const ViewProjMethod *pclP)
 template <class _Precision>
 inline BoundBox3<_Precision> BoundBox3<_Precision>::Transformed(const Matrix4D& mat) const
 {
-    BoundBox3<_Precision> bbox;
-    for (int i=0; i<8; i++)
-        bbox.Add(mat * CalcPoint(i));
-    return bbox;
+    if (!IsValid())
+        return BoundBox3<_Precision>();
+
+    // The box of the eight transformed corners is centered at the transformed
+    // center, its half lengths are the absolute matrix coefficients applied to
+    // the half lengths of this box (J. Arvo, Graphics Gems 1990).
+    double center[3] = {(static_cast<double>(MinX) + MaxX) / 2,
+                        (static_cast<double>(MinY) + MaxY) / 2,
+                        (static_cast<double>(MinZ) + MaxZ) / 2};
+    double half[3] = {(static_cast<double>(MaxX) - MinX) / 2,
+                      (static_cast<double>(MaxY) - MinY) / 2,
+                      (static_cast<double>(MaxZ) - MinZ) / 2};
+    double bmin[3], bmax[3];
+    for (int i=0; i<3; i++) {
+        double c = mat[i][0] * center[0] + mat[i][1] * center[1] + mat[i][2] * center[2] + mat[i][3];
+        double e = std::fabs(mat[i][0]) * half[0] + std::fabs(mat[i][1]) * half[1] + std::fabs(mat[i][2]) * half[2];
+        bmin[i] = c - e;
+        bmax[i] = c + e;
+    }
+
+    return BoundBox3<_Precision>(static_cast<_Precision>(bmin[0]),
+                                 static_cast<_Precision>(bmin[1]),
+                                 static_cast<_Precision>(bmin[2]),
+                                 static_cast<_Precision>(bmax[0]),
+                                 static_cast<_Precision>(bmax[1]),
+                                 static_cast<_Precision>(bmax[2]));
 }
 
 template <class _Precision>
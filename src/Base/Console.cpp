@@ -35,6 +35,8 @@
 # include "fcntl.h"
 #endif
 
+#include <atomic>
+
 #include "Console.h"
 #include "Exception.h"
 #include "PyObjectBase.h"
@@ -64,6 +66,77 @@ public:
     }
 };
 
+/**
+ * A bounded multi-producer queue for messages issued in queued connection mode.
+ * Producers claim a slot with a single atomic operation, so worker threads never
+ * block each other or the GUI thread. The slots keep their string capacity, so
+ * once warmed up pushing a message of similar size doesn't allocate memory.
+ */
+class ConsoleQueue
+{
+public:
+    static const std::size_t Capacity = 1024; // must be a power of two
+
+    ConsoleQueue() : head(0), tail(0)
+    {
+        for (std::size_t i = 0; i < Capacity; ++i)
+            slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    bool push(ConsoleSingleton::FreeCAD_ConsoleMsgType type, const char* msg)
+    {
+        Slot* slot;
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &slots[pos & (Capacity - 1)];
+            std::size_t seq = slot->seq.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false; // full
+            }
+            else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->type = type;
+        slot->msg = msg;
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // must only be called from one thread
+    bool pop(ConsoleSingleton::FreeCAD_ConsoleMsgType& type, std::string& msg)
+    {
+        std::size_t pos = head.load(std::memory_order_relaxed);
+        Slot* slot = &slots[pos & (Capacity - 1)];
+        std::size_t seq = slot->seq.load(std::memory_order_acquire);
+        if (seq != pos + 1)
+            return false; // empty or the producer hasn't finished yet
+
+        head.store(pos + 1, std::memory_order_relaxed);
+        type = slot->type;
+        msg = slot->msg;
+        slot->seq.store(pos + Capacity, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> seq;
+        ConsoleSingleton::FreeCAD_ConsoleMsgType type;
+        std::string msg;
+    };
+
+    Slot slots[Capacity];
+    std::atomic<std::size_t> head;
+    std::atomic<std::size_t> tail;
+};
+
 class ConsoleOutput : public QObject
 {
 public:
@@ -77,34 +150,64 @@ public:
         instance = 0;
     }
 
+    /// Can be called from any thread
+    void post(ConsoleSingleton::FreeCAD_ConsoleMsgType type, const char* msg) {
+        if (queue.push(type, msg)) {
+            // only the first message after the last drain wakes up the GUI thread
+            if (!pending.exchange(true))
+                QCoreApplication::postEvent(this, new QEvent(DrainEvent));
+        }
+        else {
+            // the queue overflows, fall back to a dedicated event instead of losing the message
+            QCoreApplication::postEvent(this, new ConsoleEvent(type, msg));
+        }
+    }
+
     void customEvent(QEvent* ev) {
         if (ev->type() == QEvent::User) {
             ConsoleEvent* ce = static_cast<ConsoleEvent*>(ev);
-            switch (ce->msgtype) {
-            case ConsoleSingleton::MsgType_Txt:
-                Console().NotifyMessage(ce->msg.c_str());
-                break;
-            case ConsoleSingleton::MsgType_Log:
-                Console().NotifyLog(ce->msg.c_str());
-                break;
-            case ConsoleSingleton::MsgType_Wrn:
-                Console().NotifyWarning(ce->msg.c_str());
-                break;
-            case ConsoleSingleton::MsgType_Err:
-                Console().NotifyError(ce->msg.c_str());
-                break;
-            }
+            notify(ce->msgtype, ce->msg.c_str());
+        }
+        else if (ev->type() == DrainEvent) {
+            // reset the flag before draining so that a concurrent push posts a new event
+            pending.store(false);
+            ConsoleSingleton::FreeCAD_ConsoleMsgType type;
+            while (queue.pop(type, buffer))
+                notify(type, buffer.c_str());
         }
     }
 
 private:
-    ConsoleOutput()
+    static void notify(ConsoleSingleton::FreeCAD_ConsoleMsgType type, const char* msg) {
+        switch (type) {
+        case ConsoleSingleton::MsgType_Txt:
+            Console().NotifyMessage(msg);
+            break;
+        case ConsoleSingleton::MsgType_Log:
+            Console().NotifyLog(msg);
+            break;
+        case ConsoleSingleton::MsgType_Wrn:
+            Console().NotifyWarning(msg);
+            break;
+        case ConsoleSingleton::MsgType_Err:
+            Console().NotifyError(msg);
+            break;
+        }
+    }
+
+    static const QEvent::Type DrainEvent = static_cast<QEvent::Type>(QEvent::User + 1);
+
+    ConsoleOutput() : pending(false)
     {
     }
     ~ConsoleOutput()
     {
     }
 
+    ConsoleQueue queue;
+    std::atomic<bool> pending;
+    std::string buffer;
+
     static ConsoleOutput* instance;
 };
 
@@ -125,6 +228,9 @@ ConsoleSingleton::ConsoleSingleton(void)
 #else
   ,_defaultLogLevel(FC_LOGLEVEL_MSG)
 #endif
+  , _lastType(MsgType_Txt)
+  , _repeatCount(0)
+  , _repeatLimit(10)
 {
 }
 
@@ -206,28 +312,47 @@ ConsoleMsgFlags ConsoleSingleton::SetEnabledMsgType(const char* sObs, ConsoleMsg
     }
 }
 
+static inline bool acceptsMsgType(const ILogger* pObs, ConsoleSingleton::FreeCAD_ConsoleMsgType type)
+{
+    switch (type) {
+    case ConsoleSingleton::MsgType_Txt:
+        return pObs->bMsg;
+    case ConsoleSingleton::MsgType_Log:
+        return pObs->bLog;
+    case ConsoleSingleton::MsgType_Wrn:
+        return pObs->bWrn;
+    case ConsoleSingleton::MsgType_Err:
+        return pObs->bErr;
+    default:
+        return false;
+    }
+}
+
 bool ConsoleSingleton::IsMsgTypeEnabled(const char* sObs, FreeCAD_ConsoleMsgType type) const
 {
     ILogger* pObs = Get(sObs);
     if (pObs) {
-        switch (type) {
-        case MsgType_Txt:
-            return pObs->bMsg;
-        case MsgType_Log:
-            return pObs->bLog;
-        case MsgType_Wrn:
-            return pObs->bWrn;
-        case MsgType_Err:
-            return pObs->bErr;
-        default:
-            return false;
-        }
+        return acceptsMsgType(pObs, type);
     }
     else {
         return false;
     }
 }
 
+/**
+ * Returns true if at least one attached observer accepts messages of type \a type.
+ * This is much cheaper than formatting a message nobody is going to see, so use it
+ * to guard the computation of expensive output.
+ */
+bool ConsoleSingleton::IsEnabled(FreeCAD_ConsoleMsgType type) const
+{
+    for (std::set<ILogger * >::const_iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter) {
+        if (acceptsMsgType(*Iter, type))
+            return true;
+    }
+    return false;
+}
+
 void ConsoleSingleton::SetConnectionMode(ConnectionMode mode)
 {
     connectionMode = mode;
@@ -238,6 +363,14 @@ void ConsoleSingleton::SetConnectionMode(ConnectionMode mode)
     }
 }
 
+void ConsoleSingleton::SetRepeatLimit(unsigned int limit)
+{
+    std::lock_guard<std::mutex> lock(_repeatMutex);
+    _repeatLimit = limit;
+    _repeatCount = 0;
+    _lastMsg.clear();
+}
+
 /** Prints a Message
  *  This method issues a Message.
  *  Messages are used to show some non vital information. That means when
@@ -255,6 +388,8 @@ void ConsoleSingleton::SetConnectionMode(ConnectionMode mode)
 void ConsoleSingleton::Message( const char *pMsg, ... )
 {
 #define FC_CONSOLE_FMT(_type,_type2) \
+    if (!IsEnabled(MsgType_##_type2))\
+        return;\
     char format[BufferSize];\
     format[sizeof(format)-4] = '.';\
     format[sizeof(format)-3] = '.';\
@@ -269,7 +404,7 @@ void ConsoleSingleton::Message( const char *pMsg, ... )
     if (connectionMode == Direct)\
         Notify##_type(format);\
     else\
-        QCoreApplication::postEvent(ConsoleOutput::getInstance(), new ConsoleEvent(MsgType_##_type2, format));
+        ConsoleOutput::getInstance()->post(MsgType_##_type2, format);
 
     FC_CONSOLE_FMT(Message,Txt);
 }
@@ -370,34 +505,86 @@ void ConsoleSingleton::DetachObserver(ILogger *pcObserver)
 
 void ConsoleSingleton::NotifyMessage(const char *sMsg)
 {
-    for (std::set<ILogger * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter) {
-        if ((*Iter)->bMsg)
-            (*Iter)->SendLog(sMsg, LogStyle::Message);   // send string to the listener
-    }
+    if (!isRepeated(MsgType_Txt, sMsg))
+        notifyObservers(MsgType_Txt, sMsg);
 }
 
 void ConsoleSingleton::NotifyWarning(const char *sMsg)
 {
-    for (std::set<ILogger * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter) {
-        if ((*Iter)->bWrn)
-            (*Iter)->SendLog(sMsg, LogStyle::Warning);   // send string to the listener
-    }
+    if (!isRepeated(MsgType_Wrn, sMsg))
+        notifyObservers(MsgType_Wrn, sMsg);
 }
 
 void ConsoleSingleton::NotifyError(const char *sMsg)
 {
-    for (std::set<ILogger * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter) {
-        if ((*Iter)->bErr)
-            (*Iter)->SendLog(sMsg, LogStyle::Error);   // send string to the listener
-    }
+    if (!isRepeated(MsgType_Err, sMsg))
+        notifyObservers(MsgType_Err, sMsg);
 }
 
 void ConsoleSingleton::NotifyLog(const char *sMsg)
 {
+    if (!isRepeated(MsgType_Log, sMsg))
+        notifyObservers(MsgType_Log, sMsg);
+}
+
+void ConsoleSingleton::notifyObservers(FreeCAD_ConsoleMsgType type, const char *sMsg)
+{
+    LogStyle style;
+    switch (type) {
+    case MsgType_Txt:
+        style = LogStyle::Message;
+        break;
+    case MsgType_Wrn:
+        style = LogStyle::Warning;
+        break;
+    case MsgType_Err:
+        style = LogStyle::Error;
+        break;
+    default:
+        style = LogStyle::Log;
+        break;
+    }
+
     for (std::set<ILogger * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter) {
-        if ((*Iter)->bLog)
-            (*Iter)->SendLog(sMsg, LogStyle::Log);   // send string to the listener
+        if (acceptsMsgType(*Iter, type))
+            (*Iter)->SendLog(sMsg, style);   // send string to the listener
+    }
+}
+
+/**
+ * Returns true if \a sMsg is the same as the previous message and it has already
+ * been repeated more often than the repeat limit allows. When a different message
+ * comes in the number of suppressed copies is reported to the observers.
+ */
+bool ConsoleSingleton::isRepeated(FreeCAD_ConsoleMsgType type, const char *sMsg)
+{
+    FreeCAD_ConsoleMsgType suppressedType = MsgType_Txt;
+    unsigned int suppressed = 0;
+    {
+        std::lock_guard<std::mutex> lock(_repeatMutex);
+        if (_repeatLimit == 0)
+            return false;
+        if (type == _lastType && _repeatCount > 0 && _lastMsg == sMsg) {
+            ++_repeatCount;
+            return _repeatCount > _repeatLimit;
+        }
+
+        if (_repeatCount > _repeatLimit) {
+            suppressed = _repeatCount - _repeatLimit;
+            suppressedType = _lastType;
+        }
+        _lastType = type;
+        _lastMsg = sMsg;
+        _repeatCount = 1;
     }
+
+    if (suppressed > 0) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "Last message repeated %u more times\n", suppressed);
+        notifyObservers(suppressedType, buf);
+    }
+
+    return false;
 }
 
 ILogger *ConsoleSingleton::Get(const char *Name) const
@@ -30,6 +30,7 @@
 #include <assert.h>
 #include <set>
 #include <map>
+#include <mutex>
 #include <string>
 #include <cstring>
 #include <sstream>
@@ -561,7 +562,16 @@ namespace Base {
             ConsoleMsgFlags SetEnabledMsgType(const char* sObs, ConsoleMsgFlags type, bool b);
             /// Enables or disables message types of a certain console observer
             bool IsMsgTypeEnabled(const char* sObs, FreeCAD_ConsoleMsgType type) const;
+            /// Checks whether at least one observer accepts messages of the given type
+            bool IsEnabled(FreeCAD_ConsoleMsgType type) const;
             void SetConnectionMode(ConnectionMode mode);
+            /** Sets how often the same message may be repeated in a row before
+             *  further copies are suppressed. A value of 0 disables the suppression.
+             */
+            void SetRepeatLimit(unsigned int limit);
+            unsigned int GetRepeatLimit() const {
+                return _repeatLimit;
+            }
 
             int *GetLogLevel(const char *tag, bool create=true);
 
@@ -598,6 +608,9 @@ namespace Base {
             bool _bCanRefresh;
             ConnectionMode connectionMode;
 
+            bool isRepeated(FreeCAD_ConsoleMsgType type, const char *sMsg);
+            void notifyObservers(FreeCAD_ConsoleMsgType type, const char *sMsg);
+
             // Singleton!
             ConsoleSingleton(void);
             virtual ~ConsoleSingleton();
@@ -613,6 +626,13 @@ namespace Base {
             std::map<std::string, int> _logLevels;
             int _defaultLogLevel;
 
+            // repeated message suppression
+            std::mutex _repeatMutex;
+            std::string _lastMsg;
+            FreeCAD_ConsoleMsgType _lastType;
+            unsigned int _repeatCount;
+            unsigned int _repeatLimit;
+
             friend class ConsoleOutput;
     };
 
@@ -70,6 +70,15 @@ StdInputStream::~StdInputStream()
 // ---------------------------------------------------------------------------
 //  StdInputStream: Implementation of the input stream interface
 // ---------------------------------------------------------------------------
+static bool isPlainAscii(const XMLByte* const buf, XMLSize_t len)
+{
+    for (XMLSize_t i=0; i<len; i++) {
+        if (buf[i] == 0 || buf[i] > 0x7f)
+            return false;
+    }
+    return true;
+}
+
 #if (XERCES_VERSION_MAJOR == 2)
 unsigned int StdInputStream::curPos() const
 {
@@ -86,6 +95,10 @@ unsigned int StdInputStream::readBytes( XMLByte* const  toFill, const unsigned i
   stream.read((char *)toFill,maxToRead);
   XMLSize_t len = stream.gcount();
 
+  // Most of a document is plain ASCII, which needs no check
+  if (state.remainingChars == 0 && isPlainAscii(toFill, len))
+      return len;
+
   QTextCodec *codec = QTextCodec::codecForName("UTF-8");
   const QString text = codec->toUnicode((char *)toFill, len, &state);
   if (state.invalidChars > 0) {
@@ -120,6 +133,10 @@ XMLSize_t StdInputStream::readBytes( XMLByte* const  toFill, const XMLSize_t max
   stream.read((char *)toFill,maxToRead);
   XMLSize_t len = stream.gcount();
 
+  // Most of a document is plain ASCII, which needs no check
+  if (state.remainingChars == 0 && isPlainAscii(toFill, len))
+      return len;
+
   QTextCodec *codec = QTextCodec::codecForName("UTF-8");
   const QString text = codec->toUnicode((char *)toFill, len, &state);
   if (state.invalidChars > 0) {
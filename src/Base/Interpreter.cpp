@@ -36,6 +36,7 @@
 #include "PyTools.h"
 #include "Exception.h"
 #include "PyObjectBase.h"
+#include "Profiler.h"
 #include <CXX/Extensions.hxx>
 
 #include "ExceptionFactory.h"
@@ -238,6 +239,7 @@ InterpreterSingleton::~InterpreterSingleton()
 
 std::string InterpreterSingleton::runString(const char *sCmd)
 {
+    FC_PROFILE_ZONE_DETAIL("Interpreter::runString", sCmd);
     PyObject *module, *dict, *presult;          /* "exec code in d, d" */
 
     PyGILStateLocker locker;
@@ -381,6 +383,7 @@ done:
 
 void InterpreterSingleton::runInteractiveString(const char *sCmd)
 {
+    FC_PROFILE_ZONE_DETAIL("Interpreter::runInteractiveString", sCmd);
     PyObject *module, *dict, *presult;          /* "exec code in d, d" */
 
     PyGILStateLocker locker;
@@ -417,6 +420,7 @@ void InterpreterSingleton::runInteractiveString(const char *sCmd)
 
 void InterpreterSingleton::runFile(const char*pxFileName, bool local)
 {
+    FC_PROFILE_ZONE_DETAIL("Interpreter::runFile", pxFileName);
 #ifdef FC_OS_WIN32
     FileInfo fi(pxFileName);
     FILE *fp = _wfopen(fi.toStdWString().c_str(),L"r");
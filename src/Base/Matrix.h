@@ -28,6 +28,7 @@
 #include <cmath>
 #include <cstdio>
 #include <string>
+#include <type_traits>
 
 #include "Vector3D.h"
 #include <float.h>
@@ -85,6 +86,15 @@ public:
   inline Vector3d  operator *  (const Vector3d& rclVct) const;
   inline void multVec(const Vector3d & src, Vector3d & dst) const;
   inline void multVec(const Vector3f & src, Vector3f & dst) const;
+  /** Transform the points in the range [first, last) in place.
+   * T is Vector3f, Vector3d or a type derived from them. The loop is kept
+   * free of aliasing and function calls so that the compiler can vectorize it.
+   */
+  template <typename T>
+  inline void multVecs(T* first, T* last) const;
+  /// Same as multVecs() but ignores the translation part, e.g. for normals
+  template <typename T>
+  inline void multDirs(T* first, T* last) const;
   /// Comparison
   inline bool      operator != (const Matrix4D& rclMtrx) const;
   /// Comparison
@@ -331,6 +341,42 @@ inline void Matrix4D::multVec(const Vector3f & src, Vector3f & dst) const
           static_cast<float>(z));
 }
 
+template <typename T>
+inline void Matrix4D::multVecs(T* first, T* last) const
+{
+  typedef typename std::remove_reference<decltype(first->x)>::type value_type;
+  const double m00 = dMtrx4D[0][0], m01 = dMtrx4D[0][1], m02 = dMtrx4D[0][2], m03 = dMtrx4D[0][3];
+  const double m10 = dMtrx4D[1][0], m11 = dMtrx4D[1][1], m12 = dMtrx4D[1][2], m13 = dMtrx4D[1][3];
+  const double m20 = dMtrx4D[2][0], m21 = dMtrx4D[2][1], m22 = dMtrx4D[2][2], m23 = dMtrx4D[2][3];
+
+  for (T* it = first; it < last; ++it) {
+    double sx = static_cast<double>(it->x);
+    double sy = static_cast<double>(it->y);
+    double sz = static_cast<double>(it->z);
+    it->x = static_cast<value_type>(m00*sx + m01*sy + m02*sz + m03);
+    it->y = static_cast<value_type>(m10*sx + m11*sy + m12*sz + m13);
+    it->z = static_cast<value_type>(m20*sx + m21*sy + m22*sz + m23);
+  }
+}
+
+template <typename T>
+inline void Matrix4D::multDirs(T* first, T* last) const
+{
+  typedef typename std::remove_reference<decltype(first->x)>::type value_type;
+  const double m00 = dMtrx4D[0][0], m01 = dMtrx4D[0][1], m02 = dMtrx4D[0][2];
+  const double m10 = dMtrx4D[1][0], m11 = dMtrx4D[1][1], m12 = dMtrx4D[1][2];
+  const double m20 = dMtrx4D[2][0], m21 = dMtrx4D[2][1], m22 = dMtrx4D[2][2];
+
+  for (T* it = first; it < last; ++it) {
+    double sx = static_cast<double>(it->x);
+    double sy = static_cast<double>(it->y);
+    double sz = static_cast<double>(it->z);
+    it->x = static_cast<value_type>(m00*sx + m01*sy + m02*sz);
+    it->y = static_cast<value_type>(m10*sx + m11*sy + m12*sz);
+    it->z = static_cast<value_type>(m20*sx + m21*sy + m22*sz);
+  }
+}
+
 inline bool Matrix4D::operator== (const Matrix4D& rclMtrx) const
 {
   unsigned short iz, is;
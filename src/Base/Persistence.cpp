@@ -25,6 +25,7 @@
 #include "Writer.h"
 #include "Reader.h"
 #include "PyObjectBase.h"
+#include "Exception.h"
 
 #ifndef _PreComp_
 #endif
@@ -72,33 +73,55 @@ void Persistence::RestoreDocFile(Reader &/*reader*/)
 {
 }
 
+bool Persistence::canRestoreDocFileAsync() const
+{
+    return false;
+}
+
+std::function<void()> Persistence::RestoreDocFileAsync(Reader &/*reader*/)
+{
+    // you have to implement this method if canRestoreDocFileAsync() returns true
+    throw Base::NotImplementedError("Persistence::RestoreDocFileAsync");
+}
+
+bool Persistence::RestoreDocFileLazy(const std::string &/*archive*/,
+        const std::string &/*entry*/, int /*fileVersion*/)
+{
+    return false;
+}
+
 std::string Persistence::encodeAttribute(const std::string& str)
 {
     std::string tmp;
-    for (std::string::const_iterator it = str.begin(); it != str.end(); ++it) {
-        if (*it == '<')
-            tmp += "&lt;";
-        else if (*it == '\"')
-            tmp += "&quot;";
-        else if (*it == '\'')
-            tmp += "&apos;";
-        else if (*it == '&')
-            tmp += "&amp;";
-        else if (*it == '>')
-            tmp += "&gt;";
-        else if (*it == '\r')
-            tmp += "&#13;";
-        else if (*it == '\n')
-            tmp += "&#10;";
-        else if (*it == '\t')
-            tmp += "&#9;";
-        else
-            tmp += *it;
-    }
-
+    tmp.reserve(str.size());
+    encodeAttribute(str.c_str(), tmp);
     return tmp;
 }
 
+void Persistence::encodeAttribute(const char* str, std::string& out)
+{
+    // copy the runs of characters that need no escaping at once
+    const char* run = str;
+    for (const char* it = str; *it; ++it) {
+        const char* entity;
+        switch (*it) {
+        case '<':  entity = "&lt;";   break;
+        case '\"': entity = "&quot;"; break;
+        case '\'': entity = "&apos;"; break;
+        case '&':  entity = "&amp;";  break;
+        case '>':  entity = "&gt;";   break;
+        case '\r': entity = "&#13;";  break;
+        case '\n': entity = "&#10;";  break;
+        case '\t': entity = "&#9;";   break;
+        default:   continue;
+        }
+        out.append(run, it - run);
+        out.append(entity);
+        run = it + 1;
+    }
+    out.append(run);
+}
+
 void Persistence::dumpToStream(std::ostream& stream, int compression)
 {
     //we need to close the zipstream to get a good result, the only way to do this is to delete the ZipWriter.
@@ -28,6 +28,7 @@
 
 
 #include <assert.h>
+#include <functional>
 
 #include "BaseClass.h"
 
@@ -146,8 +147,44 @@ public:
      * @see Base::Reader,Base::XMLReader
      */
     virtual void RestoreDocFile(Reader &/*reader*/);
+    /** Returns true if the file requested in Restore() can be decoded with
+     * RestoreDocFileAsync() instead of RestoreDocFile().
+     * @see Base::XMLReader::readFiles()
+     */
+    virtual bool canRestoreDocFileAsync() const;
+    /** This method is used to decode a file in a worker thread
+     * It must only read from \a reader and must not change this object or any
+     * shared data. It returns a function that applies the decoded data to this
+     * object and that is called from the thread that restores the document.
+     * \code
+     * std::function<void()> PropertyMeshKernel::RestoreDocFileAsync(Base::Reader &reader)
+     * {
+     *     auto mesh = std::make_shared<MeshObject>();
+     *     mesh->load(reader);
+     *     return [this, mesh]() {
+     *         aboutToSetValue();
+     *         _meshObject->swap(mesh->getKernel());
+     *         hasSetValue();
+     *     };
+     * }
+     * \endcode
+     */
+    virtual std::function<void()> RestoreDocFileAsync(Reader &/*reader*/);
+    /** Defers the decoding of the file requested in Restore()
+     *
+     * Called instead of RestoreDocFile() if lazy files are enabled, see
+     * Base::XMLReader::setLazyFiles(). An implementation may keep \a archive
+     * and \a entry, and read the data from the archive on first access, e.g.
+     * with zipios::ZipFile. It returns false if the data must be restored now,
+     * in which case RestoreDocFile() is called as usual. The default
+     * implementation returns false.
+     */
+    virtual bool RestoreDocFileLazy(const std::string &archive,
+            const std::string &entry, int fileVersion);
     /// Encodes an attribute upon saving.
     static std::string encodeAttribute(const std::string&);
+    /// Encodes an attribute and appends it to \a out without a temporary string.
+    static void encodeAttribute(const char* str, std::string& out);
 
     //dump the binary persistence data into into the stream
     void dumpToStream(std::ostream& stream, int compression);
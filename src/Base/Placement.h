@@ -76,6 +76,15 @@ public:
     Placement pow(double t, bool shorten = true) const;
 
     void multVec(const Vector3d & src, Vector3d & dst) const;
+    /** Apply the placement to the points in the range [first, last) in place.
+     * T is Vector3f, Vector3d or a type derived from them. The rotation is
+     * converted only once for the whole range.
+     */
+    template <typename T>
+    void multVecs(T* first, T* last) const
+    {
+        toMatrix().multVecs(first, last);
+    }
     //@}
 
     static Placement slerp(const Placement & p0, const Placement & p1, double t);
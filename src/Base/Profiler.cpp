@@ -0,0 +1,184 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <iomanip>
+# include <ostream>
+#endif
+
+#include "Profiler.h"
+#include "Exception.h"
+#include "FileInfo.h"
+#include "Stream.h"
+
+using namespace Base;
+
+namespace {
+// The buffer of the current thread and the profiler instance it belongs to
+std::atomic<int> instanceCount(0);
+thread_local int bufferOwner = -1;
+thread_local void* currentBuffer = nullptr;
+
+std::int64_t toNanoseconds(Profiler::Clock::time_point t)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+void writeJsonString(std::ostream& str, const char* s)
+{
+    str << '"';
+    for (; *s; ++s) {
+        unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\')
+            str << '\\' << *s;
+        else if (c < 0x20)
+            str << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c)
+                << std::dec << std::setfill(' ');
+        else
+            str << *s;
+    }
+    str << '"';
+}
+}
+
+std::atomic<bool> Profiler::active(false);
+Profiler* Profiler::_instance = nullptr;
+
+Profiler& Profiler::instance()
+{
+    if (!_instance)
+        _instance = new Profiler();
+    return *_instance;
+}
+
+void Profiler::destruct()
+{
+    active = false;
+    delete _instance;
+    _instance = nullptr;
+}
+
+Profiler::Profiler()
+  : generation(instanceCount++)
+  , origin(toNanoseconds(Clock::now()))
+{
+}
+
+Profiler::~Profiler()
+{
+}
+
+void Profiler::start()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& it : buffers) {
+        std::lock_guard<std::mutex> bufferLock(it->mutex);
+        it->zones.clear();
+    }
+    origin = toNanoseconds(Clock::now());
+    active = true;
+}
+
+void Profiler::stop()
+{
+    active = false;
+}
+
+std::size_t Profiler::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t count = 0;
+    for (const auto& it : buffers) {
+        std::lock_guard<std::mutex> bufferLock(it->mutex);
+        count += it->zones.size();
+    }
+    return count;
+}
+
+Profiler::ThreadBuffer* Profiler::threadBuffer()
+{
+    if (bufferOwner != generation) {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.emplace_back(new ThreadBuffer());
+        buffers.back()->id = static_cast<int>(buffers.size());
+        bufferOwner = generation;
+        currentBuffer = buffers.back().get();
+    }
+    return static_cast<ThreadBuffer*>(currentBuffer);
+}
+
+void Profiler::record(const char* name, std::string&& detail, Clock::time_point begin, Clock::time_point end)
+{
+    // zones that were entered before start() are clipped
+    std::int64_t start = std::max(toNanoseconds(begin) - origin.load(std::memory_order_relaxed), std::int64_t(0));
+    std::int64_t duration = std::max(toNanoseconds(end) - origin.load(std::memory_order_relaxed) - start, std::int64_t(0));
+
+    ThreadBuffer* buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->zones.push_back(Zone{name, std::move(detail), start, duration});
+}
+
+void Profiler::writeTrace(std::ostream& str) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    str << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    const char* sep = "\n";
+    str << std::fixed << std::setprecision(3);
+    for (const auto& it : buffers) {
+        std::lock_guard<std::mutex> bufferLock(it->mutex);
+        if (it->zones.empty())
+            continue;
+        str << sep << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << it->id
+            << ",\"args\":{\"name\":\"Thread " << it->id << "\"}}";
+        sep = ",\n";
+        for (const Zone& zone : it->zones) {
+            // the timestamps are in microseconds
+            str << sep << "{\"name\":";
+            writeJsonString(str, zone.name);
+            str << ",\"cat\":\"FreeCAD\",\"ph\":\"X\",\"pid\":1,\"tid\":" << it->id
+                << ",\"ts\":" << zone.begin / 1000.0 << ",\"dur\":" << zone.duration / 1000.0;
+            if (!zone.detail.empty()) {
+                str << ",\"args\":{\"detail\":";
+                writeJsonString(str, zone.detail.c_str());
+                str << "}";
+            }
+            str << "}";
+        }
+    }
+    str << "\n]}\n";
+}
+
+void Profiler::saveTrace(const std::string& fileName) const
+{
+    Base::FileInfo fi(fileName);
+    Base::ofstream str(fi, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!str)
+        throw Base::FileException("Cannot open file for writing", fi);
+    writeTrace(str);
+    if (!str)
+        throw Base::FileException("Failed to write trace", fi);
+}
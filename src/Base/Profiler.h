@@ -0,0 +1,171 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef BASE_PROFILER_H
+#define BASE_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Base
+{
+
+/**
+ * \brief The Profiler class collects the timings of the profiling zones.
+ *
+ * A zone is a scope marked with FC_PROFILE_ZONE(). While the profiler is inactive a
+ * zone costs a single relaxed atomic load. Once started every zone that is left records
+ * its name, thread, begin and duration in a buffer of its thread, so no lock is shared
+ * between the threads of the ThreadPool.
+ *
+ * The recorded zones are written in the Chrome trace event format that is understood by
+ * chrome://tracing and https://ui.perfetto.dev. From Python:
+ * \code
+ * FreeCAD.startProfiling()
+ * doc.recompute()
+ * FreeCAD.stopProfiling()
+ * FreeCAD.saveProfile("/tmp/recompute.json")
+ * \endcode
+ *
+ * Building with FC_PROFILE_DISABLED removes all zones from the code.
+ */
+class BaseExport Profiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static Profiler& instance();
+    static void destruct();
+
+    /// Returns true while zones are recorded
+    static bool isActive() {
+        return active.load(std::memory_order_relaxed);
+    }
+    /// Discards the zones of a previous run and starts recording
+    void start();
+    /// Stops recording, the recorded zones are kept until the next start()
+    void stop();
+    /// Returns the number of recorded zones
+    std::size_t size() const;
+
+    /// Writes the recorded zones as Chrome trace JSON
+    void writeTrace(std::ostream&) const;
+    /// Writes the recorded zones as Chrome trace JSON to \a fileName
+    void saveTrace(const std::string& fileName) const;
+
+    /// Records a zone of the calling thread, \a name must be a string literal
+    void record(const char* name, std::string&& detail, Clock::time_point begin, Clock::time_point end);
+
+private:
+    struct Zone
+    {
+        const char* name;
+        std::string detail;
+        std::int64_t begin; // in ns since start()
+        std::int64_t duration;
+    };
+    struct ThreadBuffer
+    {
+        int id;
+        mutable std::mutex mutex; // only contended while the trace is written
+        std::vector<Zone> zones;
+    };
+    ThreadBuffer* threadBuffer();
+
+    Profiler();
+    ~Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static std::atomic<bool> active;
+    static Profiler* _instance;
+    const int generation;
+    std::atomic<std::int64_t> origin;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+/**
+ * \brief The ProfileZone class times its own lifetime, see FC_PROFILE_ZONE().
+ */
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name)
+      : name(name)
+      , recording(Profiler::isActive())
+    {
+        if (recording)
+            begin = Profiler::Clock::now();
+    }
+    /// \a detail is shown as argument of the zone, e.g. the name of the recomputed object
+    ProfileZone(const char* name, const char* detail)
+      : name(name)
+      , recording(Profiler::isActive())
+    {
+        if (recording) {
+            if (detail)
+                this->detail = detail;
+            begin = Profiler::Clock::now();
+        }
+    }
+    ~ProfileZone()
+    {
+        if (recording)
+            Profiler::instance().record(name, std::move(detail), begin, Profiler::Clock::now());
+    }
+
+private:
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+    const char* name;
+    bool recording;
+    std::string detail;
+    Profiler::Clock::time_point begin;
+};
+
+} // namespace Base
+
+#ifndef FC_PROFILE_DISABLED
+#   define _FC_PROFILE_CONCAT2(_a,_b) _a##_b
+#   define _FC_PROFILE_CONCAT(_a,_b) _FC_PROFILE_CONCAT2(_a,_b)
+/// Times the enclosing scope, \a _name must be a string literal
+#   define FC_PROFILE_ZONE(_name) \
+        Base::ProfileZone _FC_PROFILE_CONCAT(_fc_profile_zone_,__LINE__)(_name)
+/// Times the enclosing scope, \a _detail is a const char* that is only copied when recording
+#   define FC_PROFILE_ZONE_DETAIL(_name,_detail) \
+        Base::ProfileZone _FC_PROFILE_CONCAT(_fc_profile_zone_,__LINE__)(_name,_detail)
+#else
+#   define FC_PROFILE_ZONE(_name) do{}while(0)
+#   define FC_PROFILE_ZONE_DETAIL(_name,_detail) do{}while(0)
+#endif
+
+#endif // BASE_PROFILER_H
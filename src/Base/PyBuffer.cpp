@@ -0,0 +1,149 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "PyBuffer.h"
+
+using namespace Base;
+
+namespace {
+
+template <typename S, typename T>
+void convertItems(const char* data, Py_ssize_t count, std::vector<T>& values)
+{
+    values.resize(count);
+    for (Py_ssize_t i = 0; i < count; i++) {
+        S item;
+        std::memcpy(&item, data + i * sizeof(S), sizeof(S));
+        values[i] = static_cast<T>(item);
+    }
+}
+
+template <typename T>
+bool readBuffer(PyObject* obj, Py_ssize_t columns, std::vector<T>& values, bool allowFloat)
+{
+    if (!PyObject_CheckBuffer(obj)) {
+        PyErr_SetString(PyExc_TypeError, "Object doesn't support the buffer protocol");
+        return false;
+    }
+
+    Py_buffer buf;
+    if (PyObject_GetBuffer(obj, &buf, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+        return false;
+
+    // native or little-endian standard sizes, the item size decides the type
+    const char* format = buf.format ? buf.format : "B";
+    if (*format == '@' || *format == '=' || *format == '<')
+        format++;
+
+    bool ok = true;
+    Py_ssize_t count = buf.itemsize > 0 ? buf.len / buf.itemsize : 0;
+    const char* data = static_cast<const char*>(buf.buf);
+    char code = format[1] == '\0' ? format[0] : '\0';
+    bool isFloat = (code == 'f' || code == 'd' || code == 'e');
+    bool isSigned = (code == 'b' || code == 'h' || code == 'i' || code == 'l' || code == 'q' || code == 'n');
+    bool isUnsigned = (code == 'B' || code == 'H' || code == 'I' || code == 'L' || code == 'Q' || code == 'N');
+
+    if (columns > 1 && count % columns != 0) {
+        PyErr_Format(PyExc_ValueError, "Number of items is not a multiple of %zd", columns);
+        ok = false;
+    }
+    else if (isFloat && allowFloat && buf.itemsize == 4) {
+        convertItems<float>(data, count, values);
+    }
+    else if (isFloat && allowFloat && buf.itemsize == 8) {
+        convertItems<double>(data, count, values);
+    }
+    else if (isSigned || isUnsigned) {
+        switch (buf.itemsize) {
+        case 1:
+            isSigned ? convertItems<std::int8_t>(data, count, values)
+                     : convertItems<std::uint8_t>(data, count, values);
+            break;
+        case 2:
+            isSigned ? convertItems<std::int16_t>(data, count, values)
+                     : convertItems<std::uint16_t>(data, count, values);
+            break;
+        case 4:
+            isSigned ? convertItems<std::int32_t>(data, count, values)
+                     : convertItems<std::uint32_t>(data, count, values);
+            break;
+        case 8:
+            isSigned ? convertItems<std::int64_t>(data, count, values)
+                     : convertItems<std::uint64_t>(data, count, values);
+            break;
+        default:
+            ok = false;
+            break;
+        }
+    }
+    else {
+        ok = false;
+    }
+
+    if (!ok && !PyErr_Occurred()) {
+        PyErr_Format(PyExc_TypeError, "Unsupported buffer format '%s', expected %s",
+                     buf.format ? buf.format : "B", allowFloat ? "numbers" : "integers");
+    }
+
+    PyBuffer_Release(&buf);
+    return ok;
+}
+
+}
+
+PyObject* Base::createArrayView(Py_ssize_t rows, Py_ssize_t columns, const char* format,
+                                Py_ssize_t itemSize, const std::function<void(char*)>& fill)
+{
+    PyObject* bytes = PyBytes_FromStringAndSize(nullptr, rows * columns * itemSize);
+    if (!bytes)
+        return nullptr;
+    fill(PyBytes_AS_STRING(bytes));
+
+    PyObject* view = PyMemoryView_FromObject(bytes);
+    Py_DECREF(bytes);
+    if (!view)
+        return nullptr;
+
+    // a memoryview cannot be cast to a shape with a zero dimension
+    PyObject* array;
+    if (columns > 1 && rows > 0)
+        array = PyObject_CallMethod(view, "cast", "s(nn)", format, rows, columns);
+    else
+        array = PyObject_CallMethod(view, "cast", "s", format);
+    Py_DECREF(view);
+    return array;
+}
+
+bool Base::readArrayBuffer(PyObject* obj, Py_ssize_t columns, std::vector<double>& values)
+{
+    return readBuffer(obj, columns, values, true);
+}
+
+bool Base::readArrayBuffer(PyObject* obj, Py_ssize_t columns, std::vector<long long>& values)
+{
+    return readBuffer(obj, columns, values, false);
+}
@@ -0,0 +1,57 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef BASE_PYBUFFER_H
+#define BASE_PYBUFFER_H
+
+#include <functional>
+#include <vector>
+#include "PyObjectBase.h"
+
+namespace Base
+{
+
+/**
+ * Creates a read-only memoryview of \a rows x \a columns items of the struct
+ * format \a format ('f', 'd', 'I', ...) with \a itemSize bytes each. The view
+ * is one-dimensional if \a columns is 1. It owns a copy of the data which \a fill
+ * writes in row-major order to the passed memory, so that the data can be passed
+ * to e.g. numpy.asarray() without creating a Python object for each item.
+ * Returns null with a Python exception set on failure.
+ */
+BaseExport PyObject* createArrayView(Py_ssize_t rows, Py_ssize_t columns, const char* format,
+                                     Py_ssize_t itemSize, const std::function<void(char*)>& fill);
+
+/**
+ * Reads the numbers of a C-contiguous object supporting the buffer protocol
+ * (bytes, array.array, numpy arrays, memoryviews) into \a values. The number
+ * of items must be a multiple of \a columns.
+ * Returns false with a Python exception set on failure.
+ */
+BaseExport bool readArrayBuffer(PyObject* obj, Py_ssize_t columns, std::vector<double>& values);
+/// The same for buffers of integers only
+BaseExport bool readArrayBuffer(PyObject* obj, Py_ssize_t columns, std::vector<long long>& values);
+
+} // namespace Base
+
+#endif // BASE_PYBUFFER_H
@@ -31,6 +31,11 @@
 #endif
 
 #include <locale>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <QRunnable>
+#include <QThreadPool>
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include "Reader.h"
@@ -40,6 +45,7 @@
 #include "InputSource.h"
 #include "Console.h"
 #include "Sequencer.h"
+#include "Stream.h"
 
 #ifdef _MSC_VER
 #include <zipios++/zipios-config.h>
@@ -63,8 +69,8 @@ using namespace std;
 
 Base::XMLReader::XMLReader(const char* FileName, std::istream& str)
   : DocumentSchema(0), ProgramVersion(""), FileVersion(0), Level(0),
-    CharacterCount(0), ReadType(None), _File(FileName), _valid(false),
-    _verbose(true)
+    CharacterCount(0), AttrCount(0), ReadType(None), _File(FileName), _valid(false),
+    _verbose(true), _parallelFiles(false), _lazyFiles(false)
 {
 #ifdef _MSC_VER
     str.imbue(std::locale::empty());
@@ -122,15 +128,25 @@ const char* Base::XMLReader::localName(void) const
 
 unsigned int Base::XMLReader::getAttributeCount(void) const
 {
-    return (unsigned int)AttrMap.size();
+    return (unsigned int)AttrCount;
+}
+
+const Base::XMLReader::Attribute *Base::XMLReader::findAttribute(const char* AttrName) const
+{
+    // elements have only a few attributes, a linear search is the fastest
+    for (std::size_t i = 0; i < AttrCount; i++) {
+        if (Attributes[i].Name == AttrName)
+            return &Attributes[i];
+    }
+    return nullptr;
 }
 
 long Base::XMLReader::getAttributeAsInteger(const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    const Attribute *attr = findAttribute(AttrName);
 
-    if (pos != AttrMap.end()) {
-        return atol(pos->second.c_str());
+    if (attr) {
+        return atol(attr->Value.c_str());
     }
     else {
         // wrong name, use hasAttribute if not sure!
@@ -142,10 +158,10 @@ long Base::XMLReader::getAttributeAsInteger(const char* AttrName) const
 
 unsigned long Base::XMLReader::getAttributeAsUnsigned(const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    const Attribute *attr = findAttribute(AttrName);
 
-    if (pos != AttrMap.end()) {
-        return strtoul(pos->second.c_str(),0,10);
+    if (attr) {
+        return strtoul(attr->Value.c_str(),0,10);
     }
     else {
         // wrong name, use hasAttribute if not sure!
@@ -157,10 +173,10 @@ unsigned long Base::XMLReader::getAttributeAsUnsigned(const char* AttrName) cons
 
 double Base::XMLReader::getAttributeAsFloat  (const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    const Attribute *attr = findAttribute(AttrName);
 
-    if (pos != AttrMap.end()) {
-        return atof(pos->second.c_str());
+    if (attr) {
+        return atof(attr->Value.c_str());
     }
     else {
         // wrong name, use hasAttribute if not sure!
@@ -172,10 +188,10 @@ double Base::XMLReader::getAttributeAsFloat  (const char* AttrName) const
 
 const char*  Base::XMLReader::getAttribute (const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    const Attribute *attr = findAttribute(AttrName);
 
-    if (pos != AttrMap.end()) {
-        return pos->second.c_str();
+    if (attr) {
+        return attr->Value.c_str();
     }
     else {
         // wrong name, use hasAttribute if not sure!
@@ -187,7 +203,7 @@ const char*  Base::XMLReader::getAttribute (const char* AttrName) const
 
 bool Base::XMLReader::hasAttribute (const char* AttrName) const
 {
-    return AttrMap.find(AttrName) != AttrMap.end();
+    return findAttribute(AttrName) != nullptr;
 }
 
 bool Base::XMLReader::read(void)
@@ -307,6 +323,50 @@ void Base::XMLReader::readBinFile(const char* filename)
     to.close();
 }
 
+namespace {
+
+// A file that is decoded with Persistence::RestoreDocFileAsync() by a worker
+// thread while the next files are read from the archive
+struct StagedFile
+{
+    StagedFile(Base::Persistence *object, const std::string &name, int version, std::string &&data)
+        : name(name), size(data.size()), task([object, name, version, data = std::move(data)]() {
+            Base::Streambuf buf(data);
+            std::istream str(&buf);
+            Base::Reader reader(str, name, version);
+            return object->RestoreDocFileAsync(reader);
+        })
+    {
+        result = task.get_future();
+    }
+
+    std::string name;
+    std::size_t size;
+    std::packaged_task<std::function<void()>()> task;
+    std::future<std::function<void()> > result;
+};
+
+class StagedFileTask : public QRunnable
+{
+public:
+    explicit StagedFileTask(const std::shared_ptr<StagedFile> &file)
+        : file(file)
+    {
+    }
+    void run() override
+    {
+        file->task();
+    }
+
+private:
+    std::shared_ptr<StagedFile> file;
+};
+
+// Upper limit of the inflated data held in memory while decoding
+const std::size_t MaxStagedBytes = 256 * 1024 * 1024;
+
+}
+
 void Base::XMLReader::readFiles(zipios::ZipInputStream &zipstream) const
 {
     // It's possible that not all objects inside the document could be created, e.g. if a module
@@ -326,6 +386,35 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream &zipstream) const
         // project file was created without GUI
         return;
     }
+    std::deque<std::shared_ptr<StagedFile> > staged;
+    std::size_t stagedBytes = 0;
+
+    // apply the decoded files in archive order
+    auto applyStaged = [&staged, &stagedBytes](std::size_t maxBytes) {
+        while (!staged.empty() && stagedBytes > maxBytes) {
+            std::shared_ptr<StagedFile> file = staged.front();
+            staged.pop_front();
+            stagedBytes -= file->size;
+            try {
+                std::function<void()> apply = file->result.get();
+                if (apply)
+                    apply();
+            }
+            catch(...) {
+                Base::Console().Error("Reading failed from embedded file: %s\n", file->name.c_str());
+            }
+        }
+    };
+
+    // the worker threads must be done before leaving in any case
+    struct StagedGuard {
+        std::deque<std::shared_ptr<StagedFile> > &files;
+        ~StagedGuard() {
+            for (auto &file : files)
+                file->result.wait();
+        }
+    } guard{staged};
+
     std::vector<FileEntry>::const_iterator it = FileList.begin();
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
     while (entry->isValid() && it != FileList.end()) {
@@ -336,7 +425,31 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream &zipstream) const
             ++jt;
         // If this condition is true both file names match and we can read-in the data, otherwise
         // no file name for the current entry in the zip was registered.
-        if (jt != FileList.end()) {
+        if (jt != FileList.end() && isLazyFiles()
+                && jt->Object->RestoreDocFileLazy(_File.filePath(), jt->FileName, FileVersion)) {
+            // the data is read from the archive on demand
+            it = jt + 1;
+        }
+        else if (jt != FileList.end() && isParallelFiles() && jt->Object->canRestoreDocFileAsync()) {
+            try {
+                std::string data((std::istreambuf_iterator<char>(zipstream)),
+                                 std::istreambuf_iterator<char>());
+                auto file = std::make_shared<StagedFile>(jt->Object, jt->FileName,
+                                                         FileVersion, std::move(data));
+                staged.push_back(file);
+                stagedBytes += file->size;
+                QThreadPool::globalInstance()->start(new StagedFileTask(file));
+                applyStaged(MaxStagedBytes);
+            }
+            catch(...) {
+                Base::Console().Error("Reading failed from embedded file: %s\n", entry->toString().c_str());
+            }
+            // Go to the next registered file name
+            it = jt + 1;
+        }
+        else if (jt != FileList.end()) {
+            // keep the order of files that must be read in this thread
+            applyStaged(0);
             try {
                 Base::Reader reader(zipstream, jt->FileName, FileVersion);
                 jt->Object->RestoreDocFile(reader);
@@ -366,6 +479,8 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream &zipstream) const
             break;
         }
     }
+
+    applyStaged(0);
 }
 
 const char *Base::XMLReader::addFile(const char* Name, Base::Persistence *Object)
@@ -424,15 +539,74 @@ void Base::XMLReader::endDocument()
     ReadType = EndDocument;
 }
 
+namespace {
+
+// Converts to the local code page like StrX, but without allocation for the
+// names and text that are plain ASCII, which is the common case
+void transcodeLocal(const XMLCh* const str, std::string &out)
+{
+    out.clear();
+    for (const XMLCh *c = str; *c; ++c) {
+        if (*c > 0x7f) {
+            out = StrX(str).c_str();
+            return;
+        }
+        out += static_cast<char>(*c);
+    }
+}
+
+// Converts UTF-16 to UTF-8 like StrXUTF8, reusing the memory of out
+void transcodeUTF8(const XMLCh* const str, std::string &out)
+{
+    out.clear();
+    for (const XMLCh *c = str; *c; ++c) {
+        unsigned long code = *c;
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+            continue;
+        }
+        if (code >= 0xD800 && code <= 0xDBFF && c[1] >= 0xDC00 && c[1] <= 0xDFFF) {
+            code = 0x10000 + ((code - 0xD800) << 10) + (c[1] - 0xDC00);
+            ++c;
+        }
+        else if (code >= 0xD800 && code <= 0xDFFF) {
+            // unpaired surrogate, replaced like the Xerces transcoder does
+            out += '?';
+            continue;
+        }
+        if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+        }
+        else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        }
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+}
+
 void Base::XMLReader::startElement(const XMLCh* const /*uri*/, const XMLCh* const localname, const XMLCh* const /*qname*/, const XERCES_CPP_NAMESPACE_QUALIFIER Attributes& attrs)
 {
     Level++; // new scope
-    LocalName = StrX(localname).c_str();
+    transcodeLocal(localname, LocalName);
 
-    // saving attributes of the current scope, delete all previously stored ones
-    AttrMap.clear();
+    // saving attributes of the current scope, overwrite all previously stored ones
+    AttrCount = 0;
     for (unsigned int i = 0; i < attrs.getLength(); i++) {
-        AttrMap[StrX(attrs.getQName(i)).c_str()] = StrXUTF8(attrs.getValue(i)).c_str();
+        if (AttrCount == Attributes.size())
+            Attributes.emplace_back();
+        Attribute &attr = Attributes[AttrCount];
+        transcodeLocal(attrs.getQName(i), attr.Name);
+        transcodeUTF8(attrs.getValue(i), attr.Value);
+        // the parser already rejects duplicate attribute names
+        ++AttrCount;
     }
 
     ReadType = StartElement;
@@ -441,7 +615,7 @@ void Base::XMLReader::startElement(const XMLCh* const /*uri*/, const XMLCh* cons
 void Base::XMLReader::endElement  (const XMLCh* const /*uri*/, const XMLCh *const localname, const XMLCh *const /*qname*/)
 {
     Level--; // end of scope
-    LocalName = StrX(localname).c_str();
+    transcodeLocal(localname, LocalName);
 
     if (ReadType == StartElement)
         ReadType = StartEndElement;
@@ -465,7 +639,7 @@ void Base::XMLReader::characters(const   XMLCh* const chars, const unsigned int
 void Base::XMLReader::characters(const   XMLCh* const chars, const XMLSize_t length)
 #endif
 {
-    Characters = StrX(chars).c_str();
+    transcodeLocal(chars, Characters);
     ReadType = Chars;
     CharacterCount += length;
 }
@@ -130,6 +130,12 @@ public:
     bool isValid() const { return _valid; }
     bool isVerbose() const { return _verbose; }
     void setVerbose(bool on) { _verbose = on; }
+    /// decode the additional files in worker threads where possible, see readFiles()
+    bool isParallelFiles() const { return _parallelFiles; }
+    void setParallelFiles(bool on) { _parallelFiles = on; }
+    /// let objects defer the decoding of additional files, see Persistence::RestoreDocFileLazy()
+    bool isLazyFiles() const { return _lazyFiles; }
+    void setLazyFiles(bool on) { _lazyFiles = on; }
 
     /** @name Parser handling */
     //@{
@@ -180,7 +186,13 @@ public:
     //@{
     /// add a read request of a persistent object
     const char *addFile(const char* Name, Base::Persistence *Object);
-    /// process the requested file writes
+    /** process the requested file reads
+     *
+     * If parallel files are enabled the data of objects that support
+     * Persistence::RestoreDocFileAsync() is inflated into memory and decoded
+     * by worker threads. The decoded data is applied by the calling thread in
+     * the order of the archive.
+     */
     void readFiles(zipios::ZipInputStream &zipstream) const;
     /// get all registered file names
     const std::vector<std::string>& getFilenames() const;
@@ -265,8 +277,15 @@ protected:
     std::string Characters;
     unsigned int CharacterCount;
 
-    std::map<std::string,std::string> AttrMap;
-    typedef std::map<std::string,std::string> AttrMapType;
+    /// Attributes of the current element. The entries beyond AttrCount are
+    /// kept to reuse their memory for the next elements.
+    struct Attribute {
+        std::string Name;
+        std::string Value;
+    };
+    std::vector<Attribute> Attributes;
+    std::size_t AttrCount;
+    const Attribute *findAttribute(const char* AttrName) const;
 
     enum {
         None = 0,
@@ -286,6 +305,8 @@ protected:
     XERCES_CPP_NAMESPACE_QUALIFIER XMLPScanToken token;
     bool _valid;
     bool _verbose;
+    bool _parallelFiles;
+    bool _lazyFiles;
 
     std::vector<std::string> FileNames;
 
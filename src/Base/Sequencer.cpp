@@ -26,6 +26,7 @@
 #ifndef _PreComp_
 # include <cstdio>
 # include <algorithm>
+# include <chrono>
 # include <QMutex>
 # include <QMutexLocker>
 #endif
@@ -311,6 +312,148 @@ bool SequencerLauncher::wasCanceled() const
 
 // ---------------------------------------------------------
 
+namespace {
+long long progressClock()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>
+            (std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+ProgressCounter::ProgressCounter(const char* pszStr, size_t steps)
+  : launcher(pszStr, steps)
+  , totalSteps(steps)
+  , interval(100)
+  , counter(0)
+  , nextUpdate(progressClock())
+  , canceled(false)
+{
+}
+
+ProgressCounter::~ProgressCounter()
+{
+}
+
+size_t ProgressCounter::numberOfSteps() const
+{
+    return totalSteps;
+}
+
+size_t ProgressCounter::progress() const
+{
+    return std::min(counter.load(std::memory_order_relaxed), totalSteps);
+}
+
+void ProgressCounter::setUpdateInterval(int ms)
+{
+    interval = std::max(ms, 0);
+}
+
+void ProgressCounter::add(size_t steps)
+{
+    size_t value = counter.fetch_add(steps, std::memory_order_relaxed) + steps;
+
+    // the last step is always shown, otherwise only update after the interval has elapsed
+    long long now = progressClock();
+    long long next = nextUpdate.load(std::memory_order_relaxed);
+    if (now < next && value < totalSteps)
+        return;
+
+    // only one thread at a time updates the sequencer
+    if (!nextUpdate.compare_exchange_strong(next, now + interval))
+        return;
+    update(std::min(value, totalSteps));
+}
+
+void ProgressCounter::update(size_t value)
+{
+    QMutexLocker locker(&SequencerP::mutex);
+    // a nested counter doesn't influence the running sequencer
+    if (SequencerP::_topLauncher == &launcher) {
+        launcher.setProgress(value);
+        if (launcher.wasCanceled())
+            canceled = true;
+    }
+}
+
+void ProgressCounter::cancel()
+{
+    canceled = true;
+}
+
+bool ProgressCounter::isCanceled() const
+{
+    return canceled.load(std::memory_order_relaxed);
+}
+
+void ProgressCounter::checkCanceled() const
+{
+    if (isCanceled())
+        throw AbortException();
+}
+
+// ---------------------------------------------------------
+
+ProgressRange::ProgressRange(ProgressCounter& counter, size_t parentSteps, size_t steps)
+  : root(counter)
+  , parent(nullptr)
+  , parentSteps(parentSteps)
+  , totalSteps(steps)
+  , counter(0)
+  , reported(0)
+{
+}
+
+ProgressRange::ProgressRange(ProgressRange& range, size_t parentSteps, size_t steps)
+  : root(range.root)
+  , parent(&range)
+  , parentSteps(parentSteps)
+  , totalSteps(steps)
+  , counter(0)
+  , reported(0)
+{
+}
+
+size_t ProgressRange::numberOfSteps() const
+{
+    return totalSteps;
+}
+
+void ProgressRange::add(size_t steps)
+{
+    size_t value = std::min(counter.fetch_add(steps, std::memory_order_relaxed) + steps, totalSteps);
+    if (totalSteps > 0)
+        forward(static_cast<size_t>(static_cast<double>(value) / totalSteps * parentSteps));
+}
+
+void ProgressRange::finish()
+{
+    counter = totalSteps;
+    forward(parentSteps);
+}
+
+void ProgressRange::forward(size_t parentValue)
+{
+    // pass on only the steps that haven't been reported by another thread yet
+    size_t old = reported.load(std::memory_order_relaxed);
+    while (parentValue > old) {
+        if (reported.compare_exchange_weak(old, parentValue)) {
+            if (parent)
+                parent->add(parentValue - old);
+            else
+                root.add(parentValue - old);
+            break;
+        }
+    }
+}
+
+bool ProgressRange::isCanceled() const
+{
+    return root.isCanceled();
+}
+
+// ---------------------------------------------------------
+
 void ProgressIndicatorPy::init_type()
 {
     behaviors().name("ProgressIndicator");
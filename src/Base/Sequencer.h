@@ -24,6 +24,7 @@
 #ifndef BASE_SEQUENCER_H
 #define BASE_SEQUENCER_H
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <CXX/Extensions.hxx>
@@ -35,6 +36,7 @@ namespace Base
 
 class AbortException;
 class SequencerLauncher;
+class ProgressCounter;
 
 /**
  * \brief This class gives the user an indication of the progress of an operation and
@@ -376,6 +378,108 @@ public:
     bool wasCanceled() const;
 };
 
+/**
+ * \brief The ProgressCounter class reports the progress of an operation that is
+ * processed by several threads at once.
+ *
+ * Like SequencerLauncher it must be created on the stack in the thread that starts
+ * the operation. The worker threads then call add() for every processed item which
+ * only costs an atomic increment. The running sequencer is updated by whichever
+ * thread first notices that the update interval (100 ms by default) has elapsed,
+ * so it is neither flooded with updates nor accessed by two threads at a time.
+ *
+ * Cancellation is cooperative: the workers poll isCanceled() and return early, and
+ * once all of them are finished the starting thread calls checkCanceled() which
+ * throws an AbortException if the user canceled the operation.
+ *
+ *  \code
+ *  Base::ProgressCounter progress("Processing items", items.size());
+ *  QtConcurrent::blockingMap(items, [&](Item& item) {
+ *      if (progress.isCanceled())
+ *          return;
+ *      // do something
+ *      progress.add();
+ *  });
+ *  progress.checkCanceled();
+ *  \endcode
+ *
+ * @see ProgressRange
+ */
+class BaseExport ProgressCounter
+{
+public:
+    ProgressCounter(const char* pszStr, size_t steps);
+    ~ProgressCounter();
+
+    size_t numberOfSteps() const;
+    /** Returns the number of steps performed so far. This method is thread-safe. */
+    size_t progress() const;
+    /** Adds \a steps to the progress. This method is thread-safe. */
+    void add(size_t steps = 1);
+    /** Sets the minimum time in milliseconds between two updates of the sequencer. */
+    void setUpdateInterval(int ms);
+    /** Requests the cancellation of the operation. This method is thread-safe. */
+    void cancel();
+    /** Returns true if the operation should be canceled. This method is thread-safe. */
+    bool isCanceled() const;
+    /** Throws an AbortException if the operation was canceled. */
+    void checkCanceled() const;
+
+private:
+    void update(size_t value);
+
+private:
+    SequencerLauncher launcher;
+    size_t totalSteps;
+    long long interval;
+    std::atomic<size_t> counter;
+    std::atomic<long long> nextUpdate;
+    std::atomic<bool> canceled;
+};
+
+/**
+ * \brief The ProgressRange class allows parallel sub-tasks to count their own steps.
+ *
+ * A range of \a steps steps covers \a parentSteps steps of a ProgressCounter or of
+ * another range, so a task only needs to know how many items it processes itself.
+ * Ranges can be nested arbitrarily and all methods are thread-safe.
+ *
+ *  \code
+ *  Base::ProgressCounter progress("Processing meshes", meshes.size());
+ *  QtConcurrent::blockingMap(meshes, [&](Mesh& mesh) {
+ *      Base::ProgressRange range(progress, 1, mesh.countFacets());
+ *      for (auto& facet : mesh) {
+ *          // do something
+ *          range.add();
+ *      }
+ *  });
+ *  \endcode
+ */
+class BaseExport ProgressRange
+{
+public:
+    ProgressRange(ProgressCounter& counter, size_t parentSteps, size_t steps);
+    ProgressRange(ProgressRange& parent, size_t parentSteps, size_t steps);
+
+    size_t numberOfSteps() const;
+    /** Adds \a steps to the progress of this range. */
+    void add(size_t steps = 1);
+    /** Sets the range to be completely done. */
+    void finish();
+    bool isCanceled() const;
+
+private:
+    void forward(size_t parentValue);
+
+private:
+    ProgressCounter& root;
+    ProgressRange* parent;
+    size_t parentSteps;
+    size_t totalSteps;
+    std::atomic<size_t> counter;
+    std::atomic<size_t> reported;
+};
+
 /** Access to the only SequencerBase instance */
 inline SequencerBase& Sequencer ()
 {
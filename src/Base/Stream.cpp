@@ -32,6 +32,7 @@
 # include <string>
 # include <cstdio>
 # include <cstring>
+# include <algorithm>
 #ifdef __GNUC__
 # include <cstdint>
 #endif
@@ -144,6 +145,29 @@ OutputStream& OutputStream::operator << (double d)
     return *this;
 }
 
+OutputStream& OutputStream::write(const float* data, std::size_t count)
+{
+    if (!_swap) {
+        _out.write((const char*)data, count * sizeof(float));
+        return *this;
+    }
+
+    // swap a block at a time to avoid copying the whole array
+    const std::size_t blockSize = 4096;
+    float buffer[blockSize];
+    while (count > 0) {
+        std::size_t num = std::min(count, blockSize);
+        for (std::size_t i=0; i<num; i++) {
+            buffer[i] = data[i];
+            SwapEndian<float>(buffer[i]);
+        }
+        _out.write((const char*)buffer, num * sizeof(float));
+        data += num;
+        count -= num;
+    }
+    return *this;
+}
+
 InputStream::InputStream(std::istream &rin) : _in(rin)
 {
 }
@@ -226,6 +250,16 @@ InputStream& InputStream::operator >> (double& d)
     return *this;
 }
 
+InputStream& InputStream::read(float* data, std::size_t count)
+{
+    _in.read((char*)data, count * sizeof(float));
+    if (_swap) {
+        for (std::size_t i=0; i<count; i++)
+            SwapEndian<float>(data[i]);
+    }
+    return *this;
+}
+
 // ----------------------------------------------------------------------
 
 ByteArrayOStreambuf::ByteArrayOStreambuf(QByteArray& ba) : _buffer(new QBuffer(&ba))
@@ -80,6 +80,8 @@ public:
     OutputStream& operator << (uint64_t ul);
     OutputStream& operator << (float f);
     OutputStream& operator << (double d);
+    /// Write an array of floats in one go
+    OutputStream& write(const float* data, std::size_t count);
 
 private:
     OutputStream (const OutputStream&);
@@ -110,6 +112,8 @@ public:
     InputStream& operator >> (uint64_t& ul);
     InputStream& operator >> (float& f);
     InputStream& operator >> (double& d);
+    /// Read an array of floats in one go
+    InputStream& read(float* data, std::size_t count);
 
     operator bool() const
     {
@@ -0,0 +1,362 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+#endif
+
+#include <chrono>
+
+#include "ThreadPool.h"
+#include "Exception.h"
+
+using namespace Base;
+
+namespace {
+// The pool and the index of the worker the current thread belongs to
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local std::size_t currentWorker = 0;
+const std::size_t noWorker = static_cast<std::size_t>(-1);
+}
+
+ThreadPool* ThreadPool::_instance = nullptr;
+
+ThreadPool& ThreadPool::instance()
+{
+    if (!_instance)
+        _instance = new ThreadPool();
+    return *_instance;
+}
+
+void ThreadPool::destruct()
+{
+    delete _instance;
+    _instance = nullptr;
+}
+
+ThreadPool::ThreadPool()
+  : pending(0)
+  , sleeping(0)
+  , stopping(false)
+  , numThreads(1)
+{
+    start(0);
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+void ThreadPool::setThreadCount(int count)
+{
+    if (count <= 0)
+        count = static_cast<int>(std::thread::hardware_concurrency());
+    if (std::max(count, 1) == numThreads)
+        return;
+
+    stop();
+    start(count);
+}
+
+int ThreadPool::threadCount() const
+{
+    return numThreads;
+}
+
+void ThreadPool::start(int count)
+{
+    if (count <= 0)
+        count = static_cast<int>(std::thread::hardware_concurrency());
+    numThreads = std::max(count, 1);
+    stopping = false;
+
+    // the thread that waits for the tasks takes part in the work
+    for (int i = 1; i < numThreads; ++i)
+        workers.emplace_back(new Worker);
+    for (std::size_t i = 0; i < workers.size(); ++i)
+        workers[i]->thread = std::thread(&ThreadPool::run, this, i);
+}
+
+void ThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+
+    // the workers process all pending tasks before they exit
+    for (auto& it : workers) {
+        if (it->thread.joinable())
+            it->thread.join();
+    }
+    workers.clear();
+}
+
+void ThreadPool::submit(Task task)
+{
+    if (workers.empty()) {
+        task();
+        return;
+    }
+
+    if (currentPool == this) {
+        // nested tasks go to the queue of the worker where other workers can steal them
+        Worker& worker = *workers[currentWorker];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    else {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+
+    pending.fetch_add(1);
+    if (sleeping.load() > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        wakeup.notify_one();
+    }
+}
+
+bool ThreadPool::runPendingTask()
+{
+    Task task;
+    if (!takeTask(currentPool == this ? currentWorker : noWorker, task))
+        return false;
+    task();
+    return true;
+}
+
+bool ThreadPool::isWorkerThread() const
+{
+    return currentPool == this;
+}
+
+bool ThreadPool::takeTask(std::size_t index, Task& task)
+{
+    if (pending.load() == 0)
+        return false;
+
+    // own tasks are processed last-in first-out to keep the data in the cache
+    if (index < workers.size()) {
+        Worker& worker = *workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (!worker.tasks.empty()) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            pending.fetch_sub(1);
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!tasks.empty()) {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            pending.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // steal the oldest task of another worker
+    std::size_t count = workers.size();
+    std::size_t first = index < count ? index + 1 : 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        Worker& victim = *workers[(first + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pending.fetch_sub(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::run(std::size_t index)
+{
+    currentPool = this;
+    currentWorker = index;
+
+    Task task;
+    for (;;) {
+        if (takeTask(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        sleeping.fetch_add(1);
+        wakeup.wait(lock, [this]() {
+            return stopping || pending.load() > 0;
+        });
+        sleeping.fetch_sub(1);
+        if (stopping && pending.load() == 0)
+            break;
+    }
+
+    currentPool = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+TaskGroup::TaskGroup(ThreadPool& pool)
+  : pool(pool)
+  , count(0)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    waitForTasks();
+}
+
+void TaskGroup::run(std::function<void()> task)
+{
+    if (pool.threadCount() <= 1) {
+        execute(task);
+        return;
+    }
+
+    count.fetch_add(1);
+    pool.submit([this, task]() {
+        execute(task);
+        // decrement under the lock so that wait() cannot return and destroy the
+        // group before this task has released the mutex
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count.fetch_sub(1) == 1)
+            finished.notify_all();
+    });
+}
+
+void TaskGroup::wait()
+{
+    waitForTasks();
+
+    std::exception_ptr exc;
+    std::swap(exc, error);
+    if (exc)
+        std::rethrow_exception(exc);
+}
+
+void TaskGroup::execute(const std::function<void()>& task)
+{
+    try {
+        task();
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+            error = std::current_exception();
+    }
+}
+
+void TaskGroup::waitForTasks()
+{
+    for (;;) {
+        // help processing tasks instead of blocking the thread
+        if (count.load() > 0 && pool.runPendingTask())
+            continue;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (count.load() == 0)
+            return;
+        // wake up regularly to check for new tasks to help with
+        finished.wait_for(lock, std::chrono::milliseconds(1), [this]() {
+            return count.load() == 0;
+        });
+        if (count.load() == 0)
+            return;
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+TaskGraph::TaskGraph()
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+}
+
+TaskGraph::Node TaskGraph::add(std::function<void()> task, const std::vector<Node>& dependencies)
+{
+    Node node = nodes.size();
+    for (auto it : dependencies) {
+        if (it >= node)
+            throw Base::IndexError("Task depends on an unknown task");
+    }
+
+    std::unique_ptr<NodeData> data(new NodeData);
+    data->task = std::move(task);
+    data->numDependencies = dependencies.size();
+    data->remaining = 0;
+    nodes.push_back(std::move(data));
+
+    for (auto it : dependencies)
+        nodes[it]->successors.push_back(node);
+    return node;
+}
+
+std::size_t TaskGraph::size() const
+{
+    return nodes.size();
+}
+
+void TaskGraph::run(ThreadPool& pool)
+{
+    for (auto& it : nodes)
+        it->remaining = it->numDependencies;
+
+    TaskGroup group(pool);
+    for (Node i = 0; i < nodes.size(); ++i) {
+        if (nodes[i]->numDependencies == 0) {
+            group.run([this, &group, i]() {
+                execute(group, i);
+            });
+        }
+    }
+    group.wait();
+}
+
+void TaskGraph::execute(TaskGroup& group, Node node)
+{
+    // if the task throws an exception its successors are never started
+    nodes[node]->task();
+
+    for (auto it : nodes[node]->successors) {
+        if (nodes[it]->remaining.fetch_sub(1) == 1) {
+            group.run([this, &group, it]() {
+                execute(group, it);
+            });
+        }
+    }
+}
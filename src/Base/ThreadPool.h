@@ -0,0 +1,275 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef BASE_THREADPOOL_H
+#define BASE_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Base
+{
+
+/**
+ * \brief The ThreadPool class is the project-wide pool of worker threads.
+ *
+ * Every worker has its own task queue. Tasks submitted from a worker thread go to
+ * the queue of that worker and idle workers steal from the queues of the others,
+ * so nested parallelism doesn't create any further threads. A thread waiting for
+ * its tasks (see TaskGroup::wait()) executes pending tasks in the meantime instead
+ * of blocking a core.
+ *
+ * The pool doesn't depend on Qt and can therefore be used by all modules. The
+ * number of threads is set once by the application from the user parameters, see
+ * setThreadCount(). Use the higher level functions parallel_for(), parallel_reduce(),
+ * TaskGroup and TaskGraph rather than submitting tasks directly.
+ */
+class BaseExport ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    static ThreadPool& instance();
+    static void destruct();
+
+    /** Sets the number of threads that process tasks concurrently, including the thread
+     * that waits for the result. 0 uses the number of cores. Must not be called while
+     * tasks are running.
+     */
+    void setThreadCount(int count);
+    /** Returns the number of threads that process tasks concurrently. */
+    int threadCount() const;
+    /** Adds a task to the pool. Tasks must not throw exceptions, see TaskGroup. */
+    void submit(Task task);
+    /** Executes one pending task in the calling thread. Returns false if there was none. */
+    bool runPendingTask();
+    /** Returns true if the calling thread is a worker thread of this pool. */
+    bool isWorkerThread() const;
+
+private:
+    ThreadPool();
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    void start(int count);
+    void stop();
+    void run(std::size_t index);
+    bool takeTask(std::size_t index, Task& task);
+
+private:
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex mutex; /**< protects the queue of tasks submitted from outside */
+    std::deque<Task> tasks;
+    std::condition_variable wakeup;
+    std::atomic<std::size_t> pending; /**< number of queued tasks */
+    std::atomic<int> sleeping; /**< number of idle workers */
+    std::atomic<bool> stopping;
+    int numThreads;
+
+    static ThreadPool* _instance;
+};
+
+/**
+ * \brief A TaskGroup runs a set of tasks on the thread pool and waits for them.
+ *
+ * If a task throws an exception the remaining tasks are still executed and the
+ * first exception is re-thrown by wait().
+ *
+ *  \code
+ *  Base::TaskGroup group;
+ *  group.run([&]() { computeA(); });
+ *  group.run([&]() { computeB(); });
+ *  group.wait();
+ *  \endcode
+ */
+class BaseExport TaskGroup
+{
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::instance());
+    /** Waits for the pending tasks but doesn't re-throw exceptions. */
+    ~TaskGroup();
+
+    /** Adds a task. If the pool processes only one thread the task is executed immediately. */
+    void run(std::function<void()> task);
+    /** Waits until all tasks are finished and re-throws the first exception of a task. */
+    void wait();
+
+private:
+    void execute(const std::function<void()>& task);
+    void waitForTasks();
+
+private:
+    ThreadPool& pool;
+    std::atomic<std::size_t> count;
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+};
+
+/**
+ * \brief A TaskGraph executes tasks that depend on each other.
+ *
+ * A task is started as soon as all tasks it depends on are finished. Independent
+ * tasks run concurrently. If a task throws an exception the tasks depending on it
+ * are skipped and the exception is re-thrown by run().
+ *
+ *  \code
+ *  Base::TaskGraph graph;
+ *  auto a = graph.add([&]() { loadA(); });
+ *  auto b = graph.add([&]() { loadB(); });
+ *  graph.add([&]() { merge(); }, {a, b});
+ *  graph.run();
+ *  \endcode
+ */
+class BaseExport TaskGraph
+{
+public:
+    using Node = std::size_t;
+
+    TaskGraph();
+    ~TaskGraph();
+
+    /** Adds a task that is started after all tasks of \a dependencies are finished. */
+    Node add(std::function<void()> task, const std::vector<Node>& dependencies = std::vector<Node>());
+    std::size_t size() const;
+    /** Executes all tasks and waits for them. */
+    void run(ThreadPool& pool = ThreadPool::instance());
+
+private:
+    struct NodeData
+    {
+        std::function<void()> task;
+        std::vector<Node> successors;
+        std::size_t numDependencies;
+        std::atomic<std::size_t> remaining;
+    };
+
+    void execute(TaskGroup& group, Node node);
+
+private:
+    std::vector<std::unique_ptr<NodeData>> nodes;
+};
+
+/**
+ * Calls \a func for each index of [\a begin, \a end) on the thread pool. The range is
+ * split into chunks of \a grain indices, if \a grain is 0 a suitable size is chosen.
+ * Exceptions thrown by \a func are re-thrown after all chunks are finished.
+ */
+template <typename Index, typename Func>
+void parallel_for(Index begin, Index end, Func func, Index grain = 0)
+{
+    if (!(begin < end))
+        return;
+
+    ThreadPool& pool = ThreadPool::instance();
+    Index count = end - begin;
+    if (grain < 1)
+        grain = std::max<Index>(1, count / (4 * pool.threadCount()));
+    if (count <= grain || pool.threadCount() <= 1) {
+        for (Index i = begin; i < end; ++i)
+            func(i);
+        return;
+    }
+
+    TaskGroup group(pool);
+    for (Index first = begin; first < end; ) {
+        Index last = (end - first > grain) ? first + grain : end;
+        group.run([&func, first, last]() {
+            for (Index i = first; i < last; ++i)
+                func(i);
+        });
+        first = last;
+    }
+    group.wait();
+}
+
+/**
+ * Splits [\a begin, \a end) into chunks, calls \a func(first, last, identity) for each
+ * chunk on the thread pool and combines the partial results with \a reduce. The partial
+ * results are combined in the order of the chunks so that the result doesn't depend on
+ * the scheduling.
+ *
+ *  \code
+ *  double sum = Base::parallel_reduce(std::size_t(0), values.size(), 0.0,
+ *      [&](std::size_t first, std::size_t last, double init) {
+ *          for (std::size_t i = first; i < last; ++i)
+ *              init += values[i];
+ *          return init;
+ *      },
+ *      [](double a, double b) { return a + b; });
+ *  \endcode
+ */
+template <typename Index, typename T, typename Func, typename Reduce>
+T parallel_reduce(Index begin, Index end, T identity, Func func, Reduce reduce, Index grain = 0)
+{
+    if (!(begin < end))
+        return identity;
+
+    ThreadPool& pool = ThreadPool::instance();
+    Index count = end - begin;
+    if (grain < 1)
+        grain = std::max<Index>(1, count / (4 * pool.threadCount()));
+    if (count <= grain || pool.threadCount() <= 1)
+        return func(begin, end, identity);
+
+    std::vector<Index> bounds;
+    for (Index first = begin; first < end; ) {
+        bounds.push_back(first);
+        first = (end - first > grain) ? first + grain : end;
+    }
+    bounds.push_back(end);
+
+    std::vector<T> partial(bounds.size() - 1, identity);
+    TaskGroup group(pool);
+    for (std::size_t i = 0; i + 1 < bounds.size(); ++i) {
+        group.run([&, i]() {
+            partial[i] = func(bounds[i], bounds[i + 1], identity);
+        });
+    }
+    group.wait();
+
+    T result = identity;
+    for (const auto& it : partial)
+        result = reduce(result, it);
+    return result;
+}
+
+} // namespace Base
+
+#endif // BASE_THREADPOOL_H
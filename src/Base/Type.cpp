@@ -24,6 +24,7 @@
 
 #ifndef _PreComp_
 # include <assert.h>
+# include <cstring>
 #endif
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
@@ -51,13 +52,29 @@ struct Base::TypeData
   Type::instantiationMethod instMethod;
 };
 
-map<string,unsigned int> Type::typemap;
+unordered_map<const char*,unsigned int,Type::TypeNameHasher,Type::TypeNameHasher> Type::typemap;
 vector<TypeData*>        Type::typedata;
 set<string>              Type::loadModuleSet;
 
 //**************************************************************************
 // Construction/Destruction
 
+std::size_t Type::TypeNameHasher::operator()(const char *s) const
+{
+  // FNV-1a
+  std::size_t hash = 2166136261u;
+  for (; *s; ++s) {
+    hash ^= static_cast<unsigned char>(*s);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+bool Type::TypeNameHasher::operator()(const char *a, const char *b) const
+{
+  return std::strcmp(a,b) == 0;
+}
+
 /**
  * A constructor.
  * A more elaborate description of the constructor.
@@ -104,6 +121,11 @@ void *Type::createInstanceByName(const char* TypeName, bool bLoadModule)
 
 void Type::importModule(const char* TypeName)
 {
+  // a registered type means that its module is already loaded, this avoids
+  // extracting the module name for every object when a document is restored
+  if (typemap.find(TypeName) != typemap.end())
+    return;
+
   // cut out the module name
   string Mod = getModuleName(TypeName);
   // ignore base modules
@@ -147,7 +169,7 @@ const Type Type::createType(const Type parent, const char *name, instantiationMe
   Type::typedata.push_back(typeData);
 
   // add to dictionary for fast lookup
-  Type::typemap[name] = newType.getKey();
+  Type::typemap[typeData->name.c_str()] = newType.getKey();
 
   return newType;
 }
@@ -159,7 +181,7 @@ void Type::init(void)
 
 
   Type::typedata.push_back(new TypeData("BadType"));
-  Type::typemap["BadType"] = 0;
+  Type::typemap[Type::typedata[0]->name.c_str()] = 0;
 
 
 }
@@ -175,9 +197,10 @@ void Type::destruct(void)
 
 Type Type::fromName(const char *name)
 {
-  std::map<std::string,unsigned int>::const_iterator pos;
+  if (!name)
+    return Type::badType();
 
-  pos = typemap.find(name);
+  auto pos = typemap.find(name);
   if (pos != typemap.end())
     return typedata[pos->second]->type;
   else
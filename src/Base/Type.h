@@ -29,6 +29,7 @@
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace Base
@@ -128,8 +129,14 @@ private:
 
   unsigned int index;
 
+  /// hashes and compares the type names without creating a std::string for each lookup
+  struct TypeNameHasher {
+    std::size_t operator()(const char *s) const;
+    bool operator()(const char *a, const char *b) const;
+  };
 
-  static std::map<std::string,unsigned int> typemap;
+  // the keys point to the names in typedata
+  static std::unordered_map<const char*,unsigned int,TypeNameHasher,TypeNameHasher> typemap;
   static std::vector<TypeData*>     typedata;
 
   static std::set<std::string>  loadModuleSet;
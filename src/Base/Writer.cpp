@@ -38,6 +38,14 @@
 #include <algorithm>
 #include <locale>
 #include <limits>
+#include <deque>
+#include <future>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <zlib.h>
+#include <QRunnable>
+#include <QThreadPool>
 
 using namespace Base;
 using namespace std;
@@ -53,6 +61,7 @@ Writer::Writer(void)
   : indent(0),forceXML(false),fileVersion(1)
 {
     indBuf[0] = '\0';
+    elementBuf.reserve(1024);
 }
 
 Writer::~Writer()
@@ -89,6 +98,108 @@ void Writer::insertBinFile(const char* FileName)
     Stream() << "]]>" << endl;
 }
 
+Writer& Writer::beginElement(const char* name)
+{
+    assert(elementBuf.empty());
+    elementBuf.append(indBuf, indent);
+    elementBuf += '<';
+    elementBuf.append(name);
+    return *this;
+}
+
+Writer& Writer::addAttribute(const char* name, const char* value)
+{
+    elementBuf += ' ';
+    elementBuf.append(name);
+    elementBuf.append("=\"");
+    Persistence::encodeAttribute(value, elementBuf);
+    elementBuf += '"';
+    return *this;
+}
+
+Writer& Writer::addAttribute(const char* name, const std::string& value)
+{
+    return addAttribute(name, value.c_str());
+}
+
+Writer& Writer::addAttribute(const char* name, double value)
+{
+    // use the fewest digits that read back to the same value, at most 17 are needed
+    char buf[32];
+    int len = 0;
+    for (int precision = 15; precision <= 17; precision++) {
+        len = snprintf(buf, sizeof(buf), "%.*g", precision, value);
+        if (precision == 17 || strtod(buf, nullptr) == value)
+            break;
+    }
+
+    elementBuf += ' ';
+    elementBuf.append(name);
+    elementBuf.append("=\"");
+    elementBuf.append(buf, len);
+    elementBuf += '"';
+    return *this;
+}
+
+Writer& Writer::addAttribute(const char* name, bool value)
+{
+    return addAttribute(name, value ? "true" : "false");
+}
+
+Writer& Writer::addAttribute(const char* name, int value)
+{
+    return addAttribute(name, static_cast<long long>(value));
+}
+
+Writer& Writer::addAttribute(const char* name, long value)
+{
+    return addAttribute(name, static_cast<long long>(value));
+}
+
+Writer& Writer::addAttribute(const char* name, long long value)
+{
+    char buf[24];
+    int len = snprintf(buf, sizeof(buf), "%lld", value);
+
+    elementBuf += ' ';
+    elementBuf.append(name);
+    elementBuf.append("=\"");
+    elementBuf.append(buf, len);
+    elementBuf += '"';
+    return *this;
+}
+
+Writer& Writer::addAttribute(const char* name, unsigned int value)
+{
+    return addAttribute(name, static_cast<unsigned long long>(value));
+}
+
+Writer& Writer::addAttribute(const char* name, unsigned long value)
+{
+    return addAttribute(name, static_cast<unsigned long long>(value));
+}
+
+Writer& Writer::addAttribute(const char* name, unsigned long long value)
+{
+    char buf[24];
+    int len = snprintf(buf, sizeof(buf), "%llu", value);
+
+    elementBuf += ' ';
+    elementBuf.append(name);
+    elementBuf.append("=\"");
+    elementBuf.append(buf, len);
+    elementBuf += '"';
+    return *this;
+}
+
+void Writer::endElement(bool empty)
+{
+    elementBuf.append(empty ? "/>\n" : ">\n");
+    Stream().write(elementBuf.data(), elementBuf.size());
+    // keep the capacity for the next element
+    elementBuf.clear();
+}
+
 void Writer::setForceXML(bool on)
 {
     forceXML = on;
@@ -215,6 +326,14 @@ const std::vector<std::string>& Writer::getFilenames() const
     return FileNames;
 }
 
+std::map<const Base::Persistence*, std::string> Writer::getFileMap() const
+{
+    std::map<const Base::Persistence*, std::string> files;
+    for (const auto& entry : FileList)
+        files[entry.Object] = entry.FileName;
+    return files;
+}
+
 void Writer::incInd(void)
 {
     if (indent < 1020) {
@@ -241,42 +360,235 @@ void Writer::decInd(void)
 // ----------------------------------------------------------------------------
 
 ZipWriter::ZipWriter(const char* FileName)
-  : ZipStream(FileName)
+  : ZipStream(FileName), Level(6), ParallelDeflate(false), CopiedFiles(0)
 {
-#ifdef _MSC_VER
-    ZipStream.imbue(std::locale::empty());
-#else
-    ZipStream.imbue(std::locale::classic());
-#endif
-    ZipStream.precision(std::numeric_limits<double>::digits10 + 1);
-    ZipStream.setf(ios::fixed,ios::floatfield);
+    setupStream(ZipStream);
 }
 
 ZipWriter::ZipWriter(std::ostream& os)
-  : ZipStream(os)
+  : ZipStream(os), Level(6), ParallelDeflate(false), CopiedFiles(0)
+{
+    setupStream(ZipStream);
+}
+
+void ZipWriter::setupStream(std::ostream& str) const
 {
 #ifdef _MSC_VER
-    ZipStream.imbue(std::locale::empty());
+    str.imbue(std::locale::empty());
 #else
-    ZipStream.imbue(std::locale::classic());
+    str.imbue(std::locale::classic());
 #endif
-    ZipStream.precision(std::numeric_limits<double>::digits10 + 1);
-    ZipStream.setf(ios::fixed,ios::floatfield);
+    str.precision(std::numeric_limits<double>::digits10 + 1);
+    str.setf(ios::fixed,ios::floatfield);
+}
+
+namespace {
+
+// A file that is compressed by a worker thread while the next files are serialized
+struct DeflatedFile
+{
+    struct Result {
+        std::string data;
+        uint32 crc = 0;
+        uint32 size = 0;
+    };
+
+    DeflatedFile(const std::string &name, std::string &&data, int level)
+        : name(name), size(data.size()), task([data = std::move(data), level]() {
+            Result result;
+            result.size = static_cast<uint32>(data.size());
+            result.crc = crc32(crc32(0L, Z_NULL, 0),
+                               reinterpret_cast<const Bytef*>(data.data()),
+                               static_cast<uInt>(data.size()));
+
+            // raw deflate stream as written by zipios::DeflateOutputStreambuf
+            z_stream zs;
+            std::memset(&zs, 0, sizeof(zs));
+            if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                throw Base::RuntimeError("Failed to initialize zlib");
+            result.data.resize(deflateBound(&zs, static_cast<uLong>(data.size())));
+            zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+            zs.avail_in = static_cast<uInt>(data.size());
+            zs.next_out = reinterpret_cast<Bytef*>(&result.data[0]);
+            zs.avail_out = static_cast<uInt>(result.data.size());
+            int ret = deflate(&zs, Z_FINISH);
+            result.data.resize(zs.total_out);
+            deflateEnd(&zs);
+            if (ret != Z_STREAM_END)
+                throw Base::RuntimeError("Failed to compress data");
+            return result;
+        })
+    {
+        result = task.get_future();
+    }
+
+    // A file whose compressed data is copied from another archive
+    DeflatedFile(const std::string &name, Result &&res)
+        : name(name), size(res.data.size())
+    {
+        std::promise<Result> promise;
+        promise.set_value(std::move(res));
+        result = promise.get_future();
+    }
+
+    std::string name;
+    std::size_t size;
+    std::packaged_task<Result()> task;
+    std::future<Result> result;
+};
+
+class DeflatedFileTask : public QRunnable
+{
+public:
+    explicit DeflatedFileTask(const std::shared_ptr<DeflatedFile> &file)
+        : file(file)
+    {
+    }
+    void run() override
+    {
+        file->task();
+    }
+
+private:
+    std::shared_ptr<DeflatedFile> file;
+};
+
+// Upper limit of the serialized data held in memory while compressing
+const std::size_t MaxDeflatedBytes = 256 * 1024 * 1024;
+
+}
+
+void ZipWriter::writeFilesParallel()
+{
+    std::deque<std::shared_ptr<DeflatedFile> > pending;
+    std::size_t pendingBytes = 0;
+
+    // write the compressed files in the order they were added
+    auto writePending = [this, &pending, &pendingBytes](std::size_t maxBytes) {
+        while (!pending.empty() && pendingBytes > maxBytes) {
+            std::shared_ptr<DeflatedFile> file = pending.front();
+            pending.pop_front();
+            pendingBytes -= file->size;
+            DeflatedFile::Result res = file->result.get();
+            ZipStream.putRawEntry(zipios::ZipCDirEntry(file->name), res.data.c_str(),
+                                  static_cast<uint32>(res.data.size()), res.crc, res.size);
+        }
+    };
+
+    // the worker threads must be done before leaving in any case
+    struct PendingGuard {
+        std::deque<std::shared_ptr<DeflatedFile> > &files;
+        std::unique_ptr<std::ostringstream> &stream;
+        ~PendingGuard() {
+            stream.reset();
+            for (auto &file : files)
+                file->result.wait();
+        }
+    } guard{pending, EntryStream};
+
+    size_t index = 0;
+    while (index < FileList.size()) {
+        FileEntry entry = FileList.begin()[index];
+        DeflatedFile::Result copied;
+        if (readPreviousFile(entry, copied.data, copied.crc, copied.size)) {
+            auto file = std::make_shared<DeflatedFile>(entry.FileName, std::move(copied));
+            pending.push_back(file);
+            pendingBytes += file->size;
+            writePending(MaxDeflatedBytes);
+            index++;
+            continue;
+        }
+
+        EntryStream.reset(new std::ostringstream(std::ios::out | std::ios::binary));
+        setupStream(*EntryStream);
+        entry.Object->SaveDocFile(*this);
+
+        auto file = std::make_shared<DeflatedFile>(entry.FileName, EntryStream->str(), Level);
+        EntryStream.reset();
+        pending.push_back(file);
+        pendingBytes += file->size;
+        QThreadPool::globalInstance()->start(new DeflatedFileTask(file));
+        writePending(MaxDeflatedBytes);
+        index++;
+    }
+
+    writePending(0);
 }
 
 void ZipWriter::writeFiles(void)
 {
+    if (ParallelDeflate) {
+        writeFilesParallel();
+        return;
+    }
+
     // use a while loop because it is possible that while
     // processing the files new ones can be added
     size_t index = 0;
     while (index < FileList.size()) {
         FileEntry entry = FileList.begin()[index];
-        ZipStream.putNextEntry(entry.FileName);
-        entry.Object->SaveDocFile(*this);
+        std::string data;
+        uint32 crc, size;
+        if (readPreviousFile(entry, data, crc, size)) {
+            ZipStream.putRawEntry(zipios::ZipCDirEntry(entry.FileName), data.c_str(),
+                                  static_cast<uint32>(data.size()), crc, size);
+        }
+        else {
+            ZipStream.putNextEntry(entry.FileName);
+            entry.Object->SaveDocFile(*this);
+        }
         index++;
     }
 }
 
+void ZipWriter::setPreviousArchive(const std::string& archive,
+                                   const std::map<const Base::Persistence*, std::string>& entries)
+{
+    PreviousArchive.reset();
+    PreviousEntries.clear();
+    if (entries.empty() || !FileInfo(archive).isReadable())
+        return;
+    try {
+        PreviousArchive.reset(new zipios::ZipFile(archive));
+        if (!PreviousArchive->isValid()) {
+            PreviousArchive.reset();
+            return;
+        }
+        PreviousEntries = entries;
+    }
+    catch (const std::exception&) {
+        PreviousArchive.reset();
+    }
+}
+
+bool ZipWriter::readPreviousFile(const FileEntry& entry, std::string& data, uint32& crc, uint32& size)
+{
+    if (!PreviousArchive)
+        return false;
+    auto it = PreviousEntries.find(entry.Object);
+    if (it == PreviousEntries.end())
+        return false;
+    // the extension tells the format of the file, e.g. binary or text brep
+    if (FileInfo(it->second).extension() != FileInfo(entry.FileName).extension())
+        return false;
+
+    try {
+        zipios::ConstEntryPointer zentry = PreviousArchive->getEntry(it->second);
+        if (!zentry || zentry->getMethod() != zipios::DEFLATED)
+            return false;
+        if (!PreviousArchive->getRawData(zentry, data))
+            return false;
+        crc = zentry->getCrc();
+        size = zentry->getSize();
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+
+    ++CopiedFiles;
+    return true;
+}
+
 ZipWriter::~ZipWriter()
 {
     ZipStream.close();
@@ -24,6 +24,8 @@
 #define BASE_WRITER_H
 
 
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <sstream>
@@ -81,6 +83,8 @@ public:
     virtual void writeFiles(void)=0;
     /// get all registered file names
     const std::vector<std::string>& getFilenames() const;
+    /// get the registered file name of each object
+    std::map<const Base::Persistence*, std::string> getFileMap() const;
     /// Set mode
     void setMode(const std::string& mode);
     /// Set modes
@@ -113,6 +117,33 @@ public:
     void decInd(void);
     //@}
 
+    /** @name buffered XML output
+     * An element is built in a buffer that is reused for all elements and is written
+     * to Stream() at once by endElement(). The attribute values are escaped while they
+     * are appended and numbers are written with the shortest text that reads back to
+     * the same value, so no stream formatting is involved.
+     * \code
+     * writer.beginElement("PropertyVector").addAttribute("valueX", x).endElement();
+     * \endcode
+     */
+    //@{
+    /// start an element at the current indentation
+    Writer& beginElement(const char* name);
+    /// add an attribute to the element, the value is escaped
+    Writer& addAttribute(const char* name, const char* value);
+    Writer& addAttribute(const char* name, const std::string& value);
+    Writer& addAttribute(const char* name, double value);
+    Writer& addAttribute(const char* name, bool value);
+    Writer& addAttribute(const char* name, int value);
+    Writer& addAttribute(const char* name, long value);
+    Writer& addAttribute(const char* name, long long value);
+    Writer& addAttribute(const char* name, unsigned int value);
+    Writer& addAttribute(const char* name, unsigned long value);
+    Writer& addAttribute(const char* name, unsigned long long value);
+    /// close the element, with "/>" if \a empty is true, otherwise with ">", and write it
+    void endElement(bool empty=true);
+    //@}
+
     virtual std::ostream &Stream(void)=0;
 
     /// name for underlying file saves
@@ -131,6 +162,7 @@ protected:
 
     short indent;
     char indBuf[1024];
+    std::string elementBuf;
 
     bool forceXML;
     int fileVersion;
@@ -152,14 +184,45 @@ public:
 
     virtual void writeFiles(void);
 
-    virtual std::ostream &Stream(void){return ZipStream;}
+    virtual std::ostream &Stream(void){return EntryStream ? static_cast<std::ostream&>(*EntryStream) : ZipStream;}
 
     void setComment(const char* str){ZipStream.setComment(str);}
-    void setLevel(int level){ZipStream.setLevel( level );}
+    void setLevel(int level){ZipStream.setLevel( level ); Level = level;}
     void putNextEntry(const char* str){ZipStream.putNextEntry(str);}
 
+    /** Compress the additional files in worker threads
+     * The files are still serialized one after another but into memory,
+     * and the compressed data is written in the order the files were added.
+     */
+    void setParallelDeflate(bool on){ParallelDeflate = on;}
+    bool isParallelDeflate() const {return ParallelDeflate;}
+
+    /** Copy unchanged files from a previously written archive
+     * \a entries maps the objects whose files didn't change since \a archive
+     * was written to their entry names in there. writeFiles() copies the
+     * compressed data of these entries instead of saving the objects again.
+     * Entries that are missing, stored uncompressed or whose file extension
+     * differs from the new file name are written as usual.
+     */
+    void setPreviousArchive(const std::string& archive,
+                            const std::map<const Base::Persistence*, std::string>& entries);
+    /// the number of files copied from the previous archive by writeFiles()
+    std::size_t getCopiedFiles() const {return CopiedFiles;}
+
+private:
+    void setupStream(std::ostream&) const;
+    void writeFilesParallel();
+    bool readPreviousFile(const FileEntry&, std::string& data,
+                          zipios::uint32& crc, zipios::uint32& size);
+
 private:
     zipios::ZipOutputStream ZipStream;
+    std::unique_ptr<std::ostringstream> EntryStream;
+    int Level;
+    bool ParallelDeflate;
+    std::unique_ptr<zipios::ZipFile> PreviousArchive;
+    std::map<const Base::Persistence*, std::string> PreviousEntries;
+    std::size_t CopiedFiles;
 };
 
 /** The StringWriter class
@@ -0,0 +1,312 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+/* Timing suite for the core kernels of FreeCAD.
+ *
+ * FreeCAD_benchmarks [options]
+ *
+ *   --repeat N       number of timed runs per benchmark (default 5)
+ *   --size N         scale of the generated data (default 1)
+ *   --filter TEXT    only run the benchmarks whose name contains TEXT
+ *   --list           print the names of the benchmarks and exit
+ *   --output FILE    write the results as JSON to FILE instead of stdout
+ *
+ * All input data is generated, so the results of two versions of FreeCAD built
+ * on the same machine can be compared directly.
+ */
+
+#include "PreCompiled.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <clocale>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Interpreter.h>
+#include <App/Application.h>
+
+#include "Benchmark.h"
+
+using namespace Benchmark;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::string jsonString(const std::string &s)
+{
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        if (c == '\n')
+            out += "\\n";
+        else
+            out += c;
+    }
+    out += '"';
+    return out;
+}
+
+void writeJson(std::ostream &str, const std::vector<Result> &results, int repeat, int size)
+{
+    str << "{\n  \"benchmark\": \"FreeCAD\",\n"
+        << "  \"version\": " << jsonString(App::Application::Config()["BuildVersionMajor"] + "." +
+                                           App::Application::Config()["BuildVersionMinor"] + "." +
+                                           App::Application::Config()["BuildRevision"]) << ",\n"
+        << "  \"repeat\": " << repeat << ",\n"
+        << "  \"size\": " << size << ",\n"
+        << "  \"results\": [";
+    const char *sep = "\n";
+    for (const Result &r : results) {
+        std::vector<double> t(r.times);
+        std::sort(t.begin(), t.end());
+        double mean = 0;
+        for (double v : t)
+            mean += v;
+        mean /= t.empty() ? 1 : t.size();
+        double median = t.empty() ? 0 : t[t.size() / 2];
+        double minimum = t.empty() ? 0 : t.front();
+
+        str << sep << "    {\"name\": " << jsonString(r.name)
+            << ", \"runs\": " << t.size()
+            << ", \"min_ms\": " << minimum
+            << ", \"median_ms\": " << median
+            << ", \"mean_ms\": " << mean;
+        for (const auto &it : r.counters)
+            str << ", " << jsonString(it.first) << ": " << it.second;
+        if (!r.error.empty())
+            str << ", \"error\": " << jsonString(r.error);
+        str << "}";
+        sep = ",\n";
+    }
+    str << "\n  ]\n}\n";
+}
+
+void usage()
+{
+    std::cerr << "Usage: FreeCAD_benchmarks [--repeat N] [--size N] [--filter TEXT] [--list] [--output FILE]\n";
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+Context::Context(int repeat, int size, const std::string& tempDir)
+  : repeat(repeat)
+  , scale(size)
+  , tempDir(tempDir)
+{
+}
+
+std::string Context::tempFile(const std::string& name) const
+{
+    return tempDir + name;
+}
+
+void Context::measure(const std::function<void()>& body)
+{
+    measure(std::function<void()>(), body);
+}
+
+void Context::measure(const std::function<void()>& setup, const std::function<void()>& body)
+{
+    for (int i = 0; i < repeat; i++) {
+        if (setup)
+            setup();
+        Clock::time_point start = Clock::now();
+        body();
+        current.times.push_back(elapsedMs(start));
+    }
+}
+
+void Context::setCounter(const std::string& name, double value)
+{
+    current.counters[name] = value;
+}
+
+void Suite::add(const std::string& name, Function func)
+{
+    benchmarks.push_back(Entry{name, func});
+}
+
+// ----------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    // Make sure that we use '.' as decimal point
+    setlocale(LC_ALL, "");
+    setlocale(LC_NUMERIC, "C");
+
+    int repeat = 5;
+    int size = 1;
+    bool list = false;
+    std::string filter;
+    std::string output;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc)
+                    throw std::runtime_error("missing value for " + arg);
+                return argv[++i];
+            };
+            if (arg == "--repeat")
+                repeat = std::max(1, std::stoi(next()));
+            else if (arg == "--size")
+                size = std::max(1, std::stoi(next()));
+            else if (arg == "--filter")
+                filter = next();
+            else if (arg == "--list")
+                list = true;
+            else if (arg == "--output")
+                output = next();
+            else if (arg == "--help" || arg == "-h") {
+                usage();
+                return 0;
+            }
+            else {
+                usage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << "FreeCAD_benchmarks: " << e.what() << "\n";
+        return 1;
+    }
+
+    Suite suite;
+    registerAppBenchmarks(suite);
+#ifdef FC_BENCHMARK_MESH
+    registerMeshBenchmarks(suite);
+#endif
+#ifdef FC_BENCHMARK_POINTS
+    registerPointsBenchmarks(suite);
+#endif
+#ifdef FC_BENCHMARK_PART
+    registerPartBenchmarks(suite);
+#endif
+#ifdef FC_BENCHMARK_SKETCHER
+    registerSketcherBenchmarks(suite);
+#endif
+
+    if (list) {
+        for (const auto &it : suite.entries())
+            std::cout << it.name << "\n";
+        return 0;
+    }
+
+    // The application is initialized without the command line of the suite
+    App::Application::Config()["ExeName"] = "FreeCAD";
+    App::Application::Config()["ExeVendor"] = "FreeCAD";
+    App::Application::Config()["AppDataSkipVendor"] = "true";
+    App::Application::Config()["RunMode"] = "Exit";
+    App::Application::Config()["Verbose"] = "Strict";
+    App::Application::Config()["LoggingConsole"] = "0";
+
+    try {
+        int fcArgc = 1;
+        App::Application::init(fcArgc, argv);
+        // load the modules so that their types get registered
+#ifdef FC_BENCHMARK_MESH
+        Base::Interpreter().runString("import Mesh");
+#endif
+#ifdef FC_BENCHMARK_POINTS
+        Base::Interpreter().runString("import Points");
+#endif
+#ifdef FC_BENCHMARK_PART
+        Base::Interpreter().runString("import Part");
+#endif
+#ifdef FC_BENCHMARK_SKETCHER
+        Base::Interpreter().runString("import Sketcher");
+#endif
+    }
+    catch (const Base::Exception &e) {
+        std::cerr << "Initialization of FreeCAD failed: " << e.what() << "\n";
+        return 100;
+    }
+
+    std::stringstream name;
+    name << App::Application::getTempPath() << "FreeCAD_benchmarks_" << std::rand() << "/";
+    Base::FileInfo tempDir(name.str());
+    tempDir.createDirectory();
+
+    std::vector<Result> results;
+    for (const auto &it : suite.entries()) {
+        if (!filter.empty() && it.name.find(filter) == std::string::npos)
+            continue;
+
+        std::cerr << "Benchmarking " << it.name << "\n";
+        Context context(repeat, size, name.str());
+        context.result().name = it.name;
+        try {
+            it.func(context);
+        }
+        catch (const Base::Exception &e) {
+            context.result().error = e.what();
+        }
+        catch (const std::exception &e) {
+            context.result().error = e.what();
+        }
+        catch (...) {
+            context.result().error = "Unknown exception";
+        }
+        if (!context.result().error.empty())
+            std::cerr << "  failed: " << context.result().error << "\n";
+        results.push_back(context.result());
+    }
+
+    tempDir.deleteDirectoryRecursive();
+
+    int ret = 0;
+    if (output.empty()) {
+        writeJson(std::cout, results, repeat, size);
+    }
+    else {
+        std::ofstream str(output);
+        if (str) {
+            writeJson(str, results, repeat, size);
+        }
+        else {
+            std::cerr << "FreeCAD_benchmarks: Cannot write " << output << "\n";
+            ret = 1;
+        }
+    }
+
+    App::GetApplication().closeAllDocuments();
+    App::Application::destruct();
+    return ret;
+}
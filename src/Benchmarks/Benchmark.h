@@ -0,0 +1,103 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef BENCHMARKS_BENCHMARK_H
+#define BENCHMARKS_BENCHMARK_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+
+/// The measurements of one benchmark
+struct Result
+{
+    std::string name;
+    std::vector<double> times; // in milliseconds
+    std::map<std::string, double> counters;
+    std::string error;
+};
+
+/**
+ * The Context is passed to every benchmark. A benchmark prepares its data and then
+ * calls measure() with the code to be timed, which is run 'repeat' times.
+ */
+class Context
+{
+public:
+    Context(int repeat, int size, const std::string& tempDir);
+
+    /// The scale of the generated data, 1 by default
+    int size() const { return scale; }
+    /// Returns the path of a file in the temporary directory of the suite
+    std::string tempFile(const std::string& name) const;
+
+    /// Times \a body
+    void measure(const std::function<void()>& body);
+    /// Times \a body, \a setup is called untimed before each run
+    void measure(const std::function<void()>& setup, const std::function<void()>& body);
+    /// Stores a characteristic number of the benchmark, e.g. the number of facets
+    void setCounter(const std::string& name, double value);
+
+    Result& result() { return current; }
+
+private:
+    int repeat;
+    int scale;
+    std::string tempDir;
+    Result current;
+};
+
+typedef std::function<void(Context&)> Function;
+
+class Suite
+{
+public:
+    /// Adds a benchmark, names are of the form "Module/Kernel/Case"
+    void add(const std::string& name, Function func);
+
+    struct Entry
+    {
+        std::string name;
+        Function func;
+    };
+    const std::vector<Entry>& entries() const { return benchmarks; }
+
+private:
+    std::vector<Entry> benchmarks;
+};
+
+// The benchmarks of each module
+void registerAppBenchmarks(Suite&);
+void registerMeshBenchmarks(Suite&);
+void registerPointsBenchmarks(Suite&);
+void registerPartBenchmarks(Suite&);
+void registerSketcherBenchmarks(Suite&);
+
+} // namespace Benchmark
+
+#endif // BENCHMARKS_BENCHMARK_H
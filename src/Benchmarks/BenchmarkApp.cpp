@@ -0,0 +1,146 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <memory>
+#include <sstream>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/Expression.h>
+#include <App/FeatureTest.h>
+#include <App/ObjectIdentifier.h>
+
+#include "Benchmark.h"
+
+using namespace Benchmark;
+
+namespace {
+
+/// Creates a document with a chain of objects where each Float depends on its predecessor
+App::Document* createChain(const char* name, int count)
+{
+    App::Document* doc = App::GetApplication().newDocument(name, name, false);
+    App::FeatureTest* prev = nullptr;
+    for (int i = 0; i < count; i++) {
+        auto obj = static_cast<App::FeatureTest*>(doc->addObject("App::FeatureTest"));
+        if (prev) {
+            std::stringstream str;
+            str << prev->getNameInDocument() << ".Float * 1.0001 + " << i;
+            obj->setExpression(App::ObjectIdentifier(obj->Float),
+                               std::shared_ptr<App::Expression>(App::Expression::parse(obj, str.str())));
+        }
+        prev = obj;
+    }
+    doc->recompute();
+    return doc;
+}
+
+void recomputeChain(Context& ctx)
+{
+    int count = 1000 * ctx.size();
+    App::Document* doc = createChain("BenchmarkRecompute", count);
+    App::DocumentObject* first = doc->getObjects().front();
+    ctx.setCounter("objects", count);
+    ctx.measure([first]() {
+        first->touch();
+    }, [doc]() {
+        doc->recompute();
+    });
+    App::GetApplication().closeDocument(doc->getName());
+}
+
+void saveDocument(Context& ctx)
+{
+    int count = 1000 * ctx.size();
+    App::Document* doc = createChain("BenchmarkSave", count);
+    std::string file = ctx.tempFile("BenchmarkSave.FCStd");
+    ctx.setCounter("objects", count);
+    ctx.measure([doc, &file]() {
+        doc->saveAs(file.c_str());
+    });
+    App::GetApplication().closeDocument(doc->getName());
+}
+
+void restoreDocument(Context& ctx)
+{
+    int count = 1000 * ctx.size();
+    App::Document* doc = createChain("BenchmarkRestore", count);
+    std::string file = ctx.tempFile("BenchmarkRestore.FCStd");
+    doc->saveAs(file.c_str());
+    App::GetApplication().closeDocument(doc->getName());
+    ctx.setCounter("objects", count);
+
+    std::string name;
+    ctx.measure([&name]() {
+        if (!name.empty())
+            App::GetApplication().closeDocument(name.c_str());
+        name.clear();
+    }, [&name, &file]() {
+        App::Document* doc = App::GetApplication().openDocument(file.c_str(), false);
+        name = doc->getName();
+    });
+    if (!name.empty())
+        App::GetApplication().closeDocument(name.c_str());
+}
+
+const char* expressionText = "sin(30 deg) * 2 mm + sqrt(16) * (3 mm + 4 mm) / 2 - abs(-5 mm) + pow(2; 3) * 1 mm";
+
+void parseExpression(Context& ctx)
+{
+    int count = 1000 * ctx.size();
+    App::Document* doc = App::GetApplication().newDocument("BenchmarkParse", "BenchmarkParse", false);
+    App::DocumentObject* obj = doc->addObject("App::FeatureTest");
+    ctx.setCounter("expressions", count);
+    ctx.measure([obj, count]() {
+        for (int i = 0; i < count; i++)
+            std::unique_ptr<App::Expression> expr(App::Expression::parse(obj, expressionText));
+    });
+    App::GetApplication().closeDocument(doc->getName());
+}
+
+void evaluateExpression(Context& ctx)
+{
+    int count = 10000 * ctx.size();
+    App::Document* doc = App::GetApplication().newDocument("BenchmarkEvaluate", "BenchmarkEvaluate", false);
+    App::DocumentObject* obj = doc->addObject("App::FeatureTest");
+    std::unique_ptr<App::Expression> expr(App::Expression::parse(obj, expressionText));
+    ctx.setCounter("evaluations", count);
+    ctx.measure([&expr, count]() {
+        for (int i = 0; i < count; i++)
+            std::unique_ptr<App::Expression> value(expr->eval());
+    });
+    App::GetApplication().closeDocument(doc->getName());
+}
+
+}
+
+void Benchmark::registerAppBenchmarks(Suite& suite)
+{
+    suite.add("App/Document/Recompute", recomputeChain);
+    suite.add("App/Document/Save", saveDocument);
+    suite.add("App/Document/Restore", restoreDocument);
+    suite.add("App/Expression/Parse", parseExpression);
+    suite.add("App/Expression/Evaluate", evaluateExpression);
+}
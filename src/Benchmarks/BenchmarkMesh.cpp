@@ -0,0 +1,162 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <cmath>
+#include <sstream>
+
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+#include "Benchmark.h"
+
+using namespace Benchmark;
+using MeshCore::MeshKernel;
+
+namespace {
+
+/// Creates a torus with 2*n*n facets
+void createTorus(MeshKernel& kernel, int n)
+{
+    const double pi = 3.14159265358979323846;
+    const float R = 10.0f, r = 3.0f;
+    auto point = [=](int i, int j) {
+        double u = 2.0 * pi * (i % n) / n;
+        double v = 2.0 * pi * (j % n) / n;
+        return Base::Vector3f(static_cast<float>((R + r * cos(v)) * cos(u)),
+                              static_cast<float>((R + r * cos(v)) * sin(u)),
+                              static_cast<float>(r * sin(v)));
+    };
+
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    facets.reserve(2 * n * n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            Base::Vector3f p1 = point(i, j), p2 = point(i + 1, j);
+            Base::Vector3f p3 = point(i + 1, j + 1), p4 = point(i, j + 1);
+            facets.emplace_back(p1, p2, p3);
+            facets.emplace_back(p1, p3, p4);
+        }
+    }
+    kernel = facets;
+}
+
+int torusResolution(const Context& ctx)
+{
+    // 500,000 facets at size 1
+    return static_cast<int>(500 * std::sqrt(static_cast<double>(ctx.size())));
+}
+
+void buildMesh(Context& ctx)
+{
+    int n = torusResolution(ctx);
+    MeshKernel kernel;
+    ctx.measure([&kernel]() {
+        kernel.Clear();
+    }, [&kernel, n]() {
+        createTorus(kernel, n);
+    });
+    ctx.setCounter("facets", kernel.CountFacets());
+}
+
+void buildGrid(Context& ctx)
+{
+    MeshKernel kernel;
+    createTorus(kernel, torusResolution(ctx));
+    ctx.setCounter("facets", kernel.CountFacets());
+    ctx.measure([&kernel]() {
+        MeshCore::MeshFacetGrid grid(kernel);
+    });
+}
+
+void rebuildNeighbours(Context& ctx)
+{
+    MeshKernel kernel;
+    createTorus(kernel, torusResolution(ctx));
+    ctx.setCounter("facets", kernel.CountFacets());
+    ctx.measure([&kernel]() {
+        kernel.RebuildNeighbours();
+    });
+}
+
+void saveBinarySTL(Context& ctx)
+{
+    MeshKernel kernel;
+    createTorus(kernel, torusResolution(ctx));
+    ctx.setCounter("facets", kernel.CountFacets());
+    ctx.measure([&kernel]() {
+        std::stringstream str;
+        MeshCore::MeshOutput(kernel).SaveBinarySTL(str);
+    });
+}
+
+void loadBinarySTL(Context& ctx)
+{
+    std::string data;
+    {
+        MeshKernel kernel;
+        createTorus(kernel, torusResolution(ctx));
+        ctx.setCounter("facets", kernel.CountFacets());
+        std::stringstream str;
+        MeshCore::MeshOutput(kernel).SaveBinarySTL(str);
+        data = str.str();
+    }
+
+    MeshKernel kernel;
+    ctx.measure([&kernel]() {
+        kernel.Clear();
+    }, [&kernel, &data]() {
+        MeshCore::MeshInput(kernel).LoadBinarySTL(data.c_str(), data.size());
+    });
+}
+
+void decimate(Context& ctx)
+{
+    MeshKernel original;
+    createTorus(original, torusResolution(ctx) / 2);
+    ctx.setCounter("facets", original.CountFacets());
+
+    MeshKernel kernel;
+    ctx.measure([&kernel, &original]() {
+        kernel = original;
+    }, [&kernel]() {
+        MeshCore::MeshSimplify(kernel).simplify(0.1f, 0.5f);
+    });
+    ctx.setCounter("facets_after", kernel.CountFacets());
+}
+
+}
+
+void Benchmark::registerMeshBenchmarks(Suite& suite)
+{
+    suite.add("Mesh/Kernel/Build", buildMesh);
+    suite.add("Mesh/Kernel/RebuildNeighbours", rebuildNeighbours);
+    suite.add("Mesh/FacetGrid/Build", buildGrid);
+    suite.add("Mesh/STL/SaveBinary", saveBinarySTL);
+    suite.add("Mesh/STL/LoadBinary", loadBinarySTL);
+    suite.add("Mesh/Decimation/Simplify", decimate);
+}
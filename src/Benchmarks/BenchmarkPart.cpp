@@ -0,0 +1,148 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <cmath>
+#include <sstream>
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <BRepTools.hxx>
+#include <gp.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Pnt.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+
+#include <Mod/Part/App/TopoShape.h>
+
+#include "Benchmark.h"
+
+using namespace Benchmark;
+using Part::TopoShape;
+
+namespace {
+
+/// Returns the number of cylinders per axis of the drilled plate
+int holeCount(const Context& ctx)
+{
+    return static_cast<int>(8 * std::sqrt(static_cast<double>(ctx.size())));
+}
+
+TopoDS_Shape makePlate(int n)
+{
+    return BRepPrimAPI_MakeBox(gp_Pnt(0, 0, 0), 10.0 * n, 10.0 * n, 5.0).Shape();
+}
+
+std::vector<TopoDS_Shape> makeCylinders(int n)
+{
+    std::vector<TopoDS_Shape> tools;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            gp_Ax2 axis(gp_Pnt(10.0 * i + 5.0, 10.0 * j + 5.0, -1.0), gp::DZ());
+            tools.push_back(BRepPrimAPI_MakeCylinder(axis, 3.0, 7.0).Shape());
+        }
+    }
+    return tools;
+}
+
+void booleanCut(Context& ctx)
+{
+    int n = holeCount(ctx);
+    TopoShape plate(makePlate(n));
+    std::vector<TopoDS_Shape> tools = makeCylinders(n);
+    ctx.setCounter("tools", tools.size());
+    ctx.measure([&plate, &tools]() {
+        plate.cut(tools);
+    });
+}
+
+void booleanFuse(Context& ctx)
+{
+    int n = holeCount(ctx);
+    TopoShape plate(makePlate(n));
+    std::vector<TopoDS_Shape> tools = makeCylinders(n);
+    ctx.setCounter("tools", tools.size());
+    ctx.measure([&plate, &tools]() {
+        plate.fuse(tools);
+    });
+}
+
+void booleanCommon(Context& ctx)
+{
+    int n = holeCount(ctx);
+    TopoShape plate(makePlate(n));
+    TopoShape sphere(BRepPrimAPI_MakeSphere(gp_Pnt(5.0 * n, 5.0 * n, 2.5), 5.0 * n).Shape());
+    std::vector<TopoDS_Shape> tools;
+    tools.push_back(sphere.getShape());
+    ctx.measure([&plate, &tools]() {
+        plate.common(tools);
+    });
+}
+
+void subShapeByName(Context& ctx)
+{
+    int n = holeCount(ctx);
+    TopoShape shape(TopoShape(makePlate(n)).cut(makeCylinders(n)));
+    int faces = shape.countSubShapes(TopAbs_FACE);
+    std::vector<std::string> names;
+    for (int i = 1; i <= faces; i++) {
+        std::stringstream str;
+        str << "Face" << i;
+        names.push_back(str.str());
+    }
+    ctx.setCounter("faces", faces);
+    ctx.measure([&shape, &names]() {
+        for (const auto &name : names)
+            shape.getSubShape(name.c_str());
+    });
+}
+
+void tessellate(Context& ctx)
+{
+    int n = holeCount(ctx);
+    TopoShape shape(TopoShape(makePlate(n)).cut(makeCylinders(n)));
+    std::vector<Base::Vector3d> points;
+    std::vector<Data::ComplexGeoData::Facet> facets;
+    ctx.measure([&shape, &points, &facets]() {
+        // remove the triangulation of the previous run
+        BRepTools::Clean(shape.getShape());
+        points.clear();
+        facets.clear();
+    }, [&shape, &points, &facets]() {
+        shape.getFaces(points, facets, 0.01f);
+    });
+    ctx.setCounter("facets", facets.size());
+}
+
+}
+
+void Benchmark::registerPartBenchmarks(Suite& suite)
+{
+    suite.add("Part/Boolean/Cut", booleanCut);
+    suite.add("Part/Boolean/Fuse", booleanFuse);
+    suite.add("Part/Boolean/Common", booleanCommon);
+    suite.add("Part/TopoShape/GetSubShape", subShapeByName);
+    suite.add("Part/TopoShape/Tessellate", tessellate);
+}
@@ -0,0 +1,120 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <cmath>
+#include <memory>
+
+#include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsAlgos.h>
+
+#include "Benchmark.h"
+
+using namespace Benchmark;
+
+namespace {
+
+/// Creates a wavy point cloud with 1,000,000 points at size 1
+void createCloud(Points::PointKernel& kernel, const Context& ctx)
+{
+    int n = static_cast<int>(1000 * std::sqrt(static_cast<double>(ctx.size())));
+    kernel.reserve(n * n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double x = 0.1 * i, y = 0.1 * j;
+            kernel.push_back(Base::Vector3d(x, y, std::sin(x) * std::cos(y)));
+        }
+    }
+}
+
+template <typename WriterT>
+void writeCloud(Context& ctx, const char* name)
+{
+    Points::PointKernel kernel;
+    createCloud(kernel, ctx);
+    ctx.setCounter("points", kernel.size());
+    std::string file = ctx.tempFile(name);
+    ctx.measure([&kernel, &file]() {
+        WriterT writer(kernel);
+        writer.write(file);
+    });
+}
+
+template <typename WriterT, typename ReaderT>
+void readCloud(Context& ctx, const char* name)
+{
+    std::string file = ctx.tempFile(name);
+    {
+        Points::PointKernel kernel;
+        createCloud(kernel, ctx);
+        ctx.setCounter("points", kernel.size());
+        WriterT writer(kernel);
+        writer.write(file);
+    }
+    ctx.measure([&file]() {
+        ReaderT reader;
+        reader.read(file);
+    });
+}
+
+void loadAsc(Context& ctx)
+{
+    std::string file = ctx.tempFile("BenchmarkLoad.asc");
+    {
+        Points::PointKernel kernel;
+        createCloud(kernel, ctx);
+        ctx.setCounter("points", kernel.size());
+        Points::AscWriter writer(kernel);
+        writer.write(file);
+    }
+    ctx.measure([&file]() {
+        Points::PointKernel kernel;
+        Points::PointsAlgos::Load(kernel, file.c_str());
+    });
+}
+
+}
+
+void Benchmark::registerPointsBenchmarks(Suite& suite)
+{
+    suite.add("Points/ASC/Write", [](Context& ctx) {
+        writeCloud<Points::AscWriter>(ctx, "BenchmarkWrite.asc");
+    });
+    suite.add("Points/ASC/Read", [](Context& ctx) {
+        readCloud<Points::AscWriter, Points::AscReader>(ctx, "BenchmarkRead.asc");
+    });
+    suite.add("Points/ASC/Load", loadAsc);
+    suite.add("Points/PLY/Write", [](Context& ctx) {
+        writeCloud<Points::PlyWriter>(ctx, "BenchmarkWrite.ply");
+    });
+    suite.add("Points/PLY/Read", [](Context& ctx) {
+        readCloud<Points::PlyWriter, Points::PlyReader>(ctx, "BenchmarkRead.ply");
+    });
+    suite.add("Points/PCD/Write", [](Context& ctx) {
+        writeCloud<Points::PcdWriter>(ctx, "BenchmarkWrite.pcd");
+    });
+    suite.add("Points/PCD/Read", [](Context& ctx) {
+        readCloud<Points::PcdWriter, Points::PcdReader>(ctx, "BenchmarkRead.pcd");
+    });
+}
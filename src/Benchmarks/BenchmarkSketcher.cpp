@@ -0,0 +1,135 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include <Mod/Part/App/Geometry.h>
+#include <Mod/Sketcher/App/Constraint.h>
+#include <Mod/Sketcher/App/Sketch.h>
+
+#include "Benchmark.h"
+
+using namespace Benchmark;
+
+namespace {
+
+/**
+ * A fully constrained staircase of line segments: consecutive segments are coincident,
+ * alternately horizontal and vertical and each one has a fixed length. The geometry
+ * is slightly off so that the solver has to move every point.
+ */
+class Staircase
+{
+public:
+    explicit Staircase(int count)
+    {
+        for (int i = 0; i < count; i++) {
+            double x = (i + 1) / 2 * 10.0;
+            double y = i / 2 * 10.0;
+            double dx = (i % 2 == 0) ? 10.0 : 0.0;
+            double dy = (i % 2 == 0) ? 0.0 : 10.0;
+            double noise = 0.1 * ((i % 7) - 3);
+            auto line = new Part::GeomLineSegment();
+            line->setPoints(Base::Vector3d(x + noise, y - noise, 0),
+                            Base::Vector3d(x + dx - noise, y + dy + noise, 0));
+            geometry.push_back(line);
+
+            addConstraint(i % 2 == 0 ? Sketcher::Horizontal : Sketcher::Vertical, i);
+            addConstraint(Sketcher::Distance, i)->setValue(10.0);
+            if (i > 0) {
+                Sketcher::Constraint* c = addConstraint(Sketcher::Coincident, i - 1, Sketcher::end);
+                c->Second = i;
+                c->SecondPos = Sketcher::start;
+            }
+        }
+        addConstraint(Sketcher::DistanceX, 0, Sketcher::start)->setValue(0.0);
+        addConstraint(Sketcher::DistanceY, 0, Sketcher::start)->setValue(0.0);
+    }
+    ~Staircase()
+    {
+        for (auto it : geometry)
+            delete it;
+        for (auto it : constraints)
+            delete it;
+    }
+
+    std::vector<Part::Geometry*> geometry;
+    std::vector<Sketcher::Constraint*> constraints;
+
+private:
+    Sketcher::Constraint* addConstraint(Sketcher::ConstraintType type, int first,
+                                        Sketcher::PointPos pos = Sketcher::none)
+    {
+        auto c = new Sketcher::Constraint();
+        c->Type = type;
+        c->First = first;
+        c->FirstPos = pos;
+        constraints.push_back(c);
+        return c;
+    }
+};
+
+int segmentCount(const Context& ctx)
+{
+    return 200 * ctx.size();
+}
+
+void setUpSketch(Context& ctx)
+{
+    Staircase stairs(segmentCount(ctx));
+    ctx.setCounter("geometries", stairs.geometry.size());
+    ctx.setCounter("constraints", stairs.constraints.size());
+    ctx.measure([&stairs]() {
+        Sketcher::Sketch sketch;
+        sketch.setUpSketch(stairs.geometry, stairs.constraints);
+    });
+}
+
+void solveSketch(Context& ctx)
+{
+    Staircase stairs(segmentCount(ctx));
+    ctx.setCounter("geometries", stairs.geometry.size());
+    ctx.setCounter("constraints", stairs.constraints.size());
+
+    std::unique_ptr<Sketcher::Sketch> sketch;
+    int dofs = 0;
+    ctx.measure([&]() {
+        sketch.reset(new Sketcher::Sketch());
+        dofs = sketch->setUpSketch(stairs.geometry, stairs.constraints);
+    }, [&sketch]() {
+        if (sketch->solve() != 0)
+            throw std::runtime_error("Solving the sketch failed");
+    });
+    ctx.setCounter("dofs", dofs);
+}
+
+}
+
+void Benchmark::registerSketcherBenchmarks(Suite& suite)
+{
+    suite.add("Sketcher/Sketch/SetUp", setUpSketch);
+    suite.add("Sketcher/Sketch/Solve", solveSketch);
+}
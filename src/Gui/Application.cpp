@@ -56,10 +56,12 @@
 #include <Base/Exception.h>
 #include <Base/Factory.h>
 #include <Base/FileInfo.h>
+#include <Base/Profiler.h>
 #include <Base/Tools.h>
 #include <Base/UnitsApi.h>
 #include <App/Document.h>
 #include <App/DocumentObjectPy.h>
+#include <App/MemoryReport.h>
 
 #include "Application.h"
 #include "AutoSaver.h"
@@ -315,6 +317,16 @@ Application::Application(bool GUIenabled)
         App::GetApplication().signalActiveDocument.connect(std::bind(&Gui::Application::slotActiveDocument, this, sp::_1));
         App::GetApplication().signalRelabelDocument.connect(std::bind(&Gui::Application::slotRelabelDocument, this, sp::_1));
         App::GetApplication().signalShowHidden.connect(std::bind(&Gui::Application::slotShowHidden, this, sp::_1));
+        // the view providers add their share to FreeCAD.getMemoryReport()
+        App::MemoryReport::addCollector([](App::MemoryReport& report) {
+            if (!Application::Instance)
+                return;
+            for (auto doc : App::GetApplication().getDocuments()) {
+                Gui::Document* gdoc = Application::Instance->getDocument(doc);
+                if (gdoc)
+                    gdoc->addToMemoryReport(report);
+            }
+        });
 
 
         // install the last active language
@@ -1255,6 +1267,8 @@ void Application::tryClose(QCloseEvent * e)
  */
 bool Application::activateWorkbench(const char* name)
 {
+    FC_PROFILE_ZONE_DETAIL("Application::activateWorkbench", name);
+
     bool ok = false;
     WaitCursor wc;
     Workbench* oldWb = WorkbenchManager::instance()->active();
@@ -1792,6 +1806,7 @@ void Application::initOpenInventor(void)
 
 void Application::runInitGuiScript(void)
 {
+    FC_PROFILE_ZONE("Application::runInitGuiScript");
     Base::Interpreter().runString(Base::ScriptFactory().ProduceScript("FreeCADGuiInit"));
 }
 
@@ -27,6 +27,7 @@
 # include <QApplication>
 # include <QFile>
 # include <QDir>
+# include <QFileInfo>
 # include <QRunnable>
 # include <QTextStream>
 # include <QThreadPool>
@@ -37,12 +38,14 @@
 #include "AutoSaver.h"
 #include <Base/Console.h>
 #include <Base/FileInfo.h>
+#include <Base/Reader.h>
 #include <Base/Stream.h>
 #include <Base/Tools.h>
 #include <Base/Writer.h>
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObject.h>
+#include <zipios++/zipinputstream.h>
 
 #include "Document.h"
 #include "WaitCursor.h"
@@ -57,9 +60,95 @@ namespace bp = boost::placeholders;
 
 AutoSaver* AutoSaver::self = 0;
 
+// The key of a property in AutoSaveProperty::touched
+static std::string propertyAddress(const void* prop)
+{
+    std::stringstream str;
+    str << prop << std::ends;
+    return str.str();
+}
+
+static bool isDocumentObjectProperty(const Base::Persistence* object)
+{
+    if (!object->isDerivedFrom(App::Property::getClassTypeId()))
+        return false;
+    const App::PropertyContainer* parent = static_cast<const App::Property*>(object)->getContainer();
+    return parent && parent->isDerivedFrom(App::DocumentObject::getClassTypeId());
+}
+
+namespace Gui {
+
+/*!
+ Writes a record of the recovery journal. The XML part is created in the
+ main thread, the data files are written from copies of the properties.
+ */
+class JournalRunnable : public QRunnable
+{
+public:
+    JournalRunnable(const std::set<std::string>& modes, const QString& dir,
+                    const QString& file, const std::string& xml)
+        : modes(modes), dirName(dir), fileName(file), xml(xml)
+    {
+    }
+    virtual ~JournalRunnable()
+    {
+        for (auto& it : files)
+            delete it.second;
+    }
+    void addFile(const std::string& name, App::Property* prop)
+    {
+        files.emplace_back(name, prop);
+    }
+    virtual void run()
+    {
+        QDir dir(dirName);
+        QString tmpName = QString::fromLatin1("%1.tmp").arg(fileName);
+        try {
+            {
+                Base::FileInfo fi(dir.absoluteFilePath(tmpName).toUtf8().constData());
+                Base::ofstream file(fi, std::ios::out | std::ios::binary);
+                if (!file.is_open()) {
+                    FC_ERR("Failed to write recovery journal record " << fi.filePath());
+                    return;
+                }
+                Base::ZipWriter writer(file);
+                writer.setModes(modes);
+                writer.setComment("AutoRecovery journal");
+                writer.setLevel(1);
+                writer.putNextEntry("Changes.xml");
+                writer.Stream() << xml;
+                for (auto& it : files) {
+                    writer.putNextEntry(it.first.c_str());
+                    it.second->SaveDocFile(writer);
+                }
+            }
+            // the record only becomes visible to a recovery once it's complete
+            dir.rename(tmpName, fileName);
+        }
+        catch (const Base::Exception& e) {
+            FC_ERR("Failed to write recovery journal record: " << e.what());
+        }
+        catch (const std::exception& e) {
+            FC_ERR("Failed to write recovery journal record: " << e.what());
+        }
+    }
+
+private:
+    std::set<std::string> modes;
+    QString dirName;
+    QString fileName;
+    std::string xml;
+    std::vector<std::pair<std::string, App::Property*> > files;
+};
+
+}
+
 AutoSaver::AutoSaver(QObject* parent)
   : QObject(parent), timeout(900000), compressed(true)
 {
+    // a single thread keeps the journal records in order
+    journalPool = new QThreadPool(this);
+    journalPool->setMaxThreadCount(1);
     App::GetApplication().signalNewDocument.connect(boost::bind(&AutoSaver::slotCreateDocument, this, bp::_1));
     App::GetApplication().signalDeleteDocument.connect(boost::bind(&AutoSaver::slotDeleteDocument, this, bp::_1));
 }
@@ -126,6 +215,8 @@ void AutoSaver::slotDeleteDocument(const App::Document& Doc)
     if (it != saverMap.end()) {
         if (it->second->timerId > 0)
             killTimer(it->second->timerId);
+        // the transient directory is about to be removed
+        journalPool->waitForDone();
         delete it->second;
         saverMap.erase(it);
     }
@@ -189,30 +280,82 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
 
                 // write additional files
                 writer.writeFiles();
+
+                saver.touched.clear();
+                saver.changes.clear();
             }
             // only create the file if something has changed
             else if (!saver.touched.empty()) {
                 std::string fn = doc->TransientDir.getValue();
                 fn += "/fc_recovery_file.fcstd";
-                Base::FileInfo tmp(fn);
-                Base::ofstream file(tmp, std::ios::out | std::ios::binary);
-                if (file.is_open())
-                {
-                    Base::ZipWriter writer(file);
-                    if (hGrp->GetBool("SaveBinaryBrep", true))
-                        writer.setMode("BinaryBrep");
-
-                    writer.setComment("AutoRecovery file");
-                    writer.setLevel(1); // apparently the fastest compression
-                    writer.putNextEntry("Document.xml");
-
-                    doc->Save(writer);
 
-                    // Special handling for Gui document.
-                    doc->signalSaveDocument(writer);
-
-                    // write additional files
-                    writer.writeFiles();
+                // Append the changed properties to the journal of the last
+                // recovery file unless there are too many records already, or
+                // the changes can't be expressed as property values.
+                int maxRecords = hGrp->GetInt("AutoSaveJournalRecords", 20);
+                if (hGrp->GetBool("AutoSaveJournal", true) && saver.hasBaseFile
+                        && !saver.structureChanged && saver.journalRecords < maxRecords
+                        && writeJournal(doc, saver))
+                {
+                    saver.changes.clear();
+                }
+                else {
+                    // write a new file so that the files of unchanged properties
+                    // can be copied from the last one
+                    Base::FileInfo tmp(fn + ".tmp");
+                    bool saved = false;
+                    {
+                        Base::ofstream file(tmp, std::ios::out | std::ios::binary);
+                        if (file.is_open())
+                        {
+                            Base::ZipWriter writer(file);
+                            if (hGrp->GetBool("SaveBinaryBrep", true))
+                                writer.setMode("BinaryBrep");
+
+                            writer.setComment("AutoRecovery file");
+                            writer.setLevel(1); // apparently the fastest compression
+                            writer.putNextEntry("Document.xml");
+
+                            doc->Save(writer);
+
+                            // Special handling for Gui document.
+                            doc->signalSaveDocument(writer);
+
+                            std::map<const Base::Persistence*, std::string> files = writer.getFileMap();
+                            std::map<const Base::Persistence*, std::string> unchanged;
+                            for (const auto& it : files) {
+                                auto jt = saver.archiveMap.find(it.first);
+                                if (jt != saver.archiveMap.end() && !saver.touched.count(propertyAddress(it.first)))
+                                    unchanged.insert(*jt);
+                            }
+                            writer.setPreviousArchive(fn, unchanged);
+
+                            // write additional files
+                            writer.writeFiles();
+
+                            // view provider properties are not tracked
+                            saver.archiveMap.clear();
+                            for (const auto& it : files) {
+                                if (isDocumentObjectProperty(it.first))
+                                    saver.archiveMap.insert(it);
+                            }
+                            saved = true;
+                        }
+                    }
+                    if (saved) {
+                        // The journal is part of the new file now. Remove it
+                        // first so that it's never applied to the new file.
+                        clearJournal(doc->TransientDir.getValue(), saver);
+
+                        Base::FileInfo fi(fn);
+                        if (fi.exists())
+                            fi.deleteFile();
+                        tmp.renameFile(fn.c_str());
+                        saver.hasBaseFile = true;
+                        saver.structureChanged = false;
+                        saver.touched.clear();
+                        saver.changes.clear();
+                    }
                 }
             }
         }
@@ -221,6 +364,141 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
         Base::Console().Log("Save AutoRecovery file: %s\n", str.c_str());
         hGrp->SetBool("SaveThumbnail",save);
     }
+    else {
+        saver.touched.clear();
+        saver.changes.clear();
+    }
+}
+
+bool AutoSaver::writeJournal(App::Document* doc, AutoSaveProperty& saver)
+{
+    if (saver.changes.empty())
+        return true;
+
+    std::vector<std::pair<App::DocumentObject*, std::vector<App::Property*> > > objects;
+    for (const auto& it : saver.changes) {
+        App::DocumentObject* obj = doc->getObject(it.first.c_str());
+        if (!obj)
+            return false;
+        std::vector<App::Property*> props;
+        for (const auto& name : it.second) {
+            App::Property* prop = obj->getPropertyByName(name.c_str());
+            if (!prop)
+                return false;
+            props.push_back(prop);
+        }
+        objects.emplace_back(obj, props);
+    }
+
+    // The data files are written in a worker thread, so force binary format
+    // because ASCII is not reentrant. See PropertyPartShape::SaveDocFile
+    Base::StringWriter writer;
+    writer.setMode("BinaryBrep");
+    writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << std::endl
+                    << "<Journal SchemaVersion=\"1\">" << std::endl;
+    writer.incInd();
+    writer.Stream() << writer.ind() << "<ObjectData Count=\"" << objects.size() << "\">" << std::endl;
+    for (const auto& it : objects) {
+        writer.incInd();
+        writer.ObjectName = it.first->getNameInDocument();
+        writer.Stream() << writer.ind() << "<Object name=\"" << it.first->getNameInDocument() << "\">" << std::endl;
+        it.first->saveProperties(writer, it.second);
+        writer.Stream() << writer.ind() << "</Object>" << std::endl;
+        writer.decInd();
+    }
+    writer.Stream() << writer.ind() << "</ObjectData>" << std::endl;
+    writer.decInd();
+    writer.Stream() << "</Journal>" << std::endl;
+
+    std::string dirName = doc->TransientDir.getValue();
+    dirName += "/fc_recovery_journal";
+    Base::FileInfo di(dirName);
+    if (!di.exists() && !di.createDirectory())
+        return false;
+
+    QString fileName = QString::fromLatin1("%1.fcjr").arg(saver.journalRecords + 1, 6, 10, QLatin1Char('0'));
+    std::unique_ptr<JournalRunnable> runnable(new JournalRunnable(writer.getModes(),
+            QString::fromUtf8(dirName.c_str()), fileName, writer.getString()));
+
+    // the files must be read in the order they were added
+    std::map<std::string, const Base::Persistence*> objectOfFile;
+    for (const auto& it : writer.getFileMap())
+        objectOfFile[it.second] = it.first;
+    for (const auto& name : writer.getFilenames()) {
+        const Base::Persistence* object = objectOfFile[name];
+        if (!object || !object->isDerivedFrom(App::Property::getClassTypeId()))
+            return false;
+        runnable->addFile(name, static_cast<const App::Property*>(object)->Copy());
+    }
+
+    journalPool->start(runnable.release());
+    ++saver.journalRecords;
+    return true;
+}
+
+void AutoSaver::clearJournal(const std::string& transientDir, AutoSaveProperty& saver)
+{
+    journalPool->waitForDone();
+    QDir dir(QString::fromUtf8(transientDir.c_str()));
+    if (dir.cd(QLatin1String("fc_recovery_journal")))
+        dir.removeRecursively();
+    saver.journalRecords = 0;
+}
+
+void AutoSaver::replayJournal(App::Document* doc, const QString& dirName)
+{
+    QDir dir(dirName);
+    QStringList records = dir.entryList(QStringList() << QLatin1String("*.fcjr"), QDir::Files, QDir::Name);
+
+    // a missing record means that the program crashed before it was written,
+    // so the following ones can't be applied either
+    int sequence = 0;
+    for (const auto& record : records) {
+        bool ok;
+        if (QFileInfo(record).completeBaseName().toInt(&ok) != ++sequence || !ok)
+            break;
+
+        std::string fn = dir.absoluteFilePath(record).toUtf8().constData();
+        try {
+            Base::FileInfo fi(fn);
+            Base::ifstream file(fi, std::ios::in | std::ios::binary);
+            zipios::ZipInputStream zipstream(file);
+            Base::XMLReader reader(fn.c_str(), zipstream);
+            if (!reader.isValid())
+                throw Base::FileException("Invalid recovery journal record", fi);
+
+            reader.readElement("Journal");
+            reader.readElement("ObjectData");
+            int count = reader.getAttributeAsInteger("Count");
+            for (int i=0; i<count; i++) {
+                reader.readElement("Object");
+                int level = reader.level();
+                App::DocumentObject* obj = doc->getObject(reader.getAttribute("name"));
+                if (obj) {
+                    obj->setStatus(App::ObjectStatus::Restore, true);
+                    try {
+                        obj->Restore(reader);
+                    }
+                    catch (...) {
+                        obj->setStatus(App::ObjectStatus::Restore, false);
+                        throw;
+                    }
+                    obj->setStatus(App::ObjectStatus::Restore, false);
+                }
+                reader.readEndElement("Object", level-1);
+            }
+            reader.readEndElement("ObjectData");
+            reader.readFiles(zipstream);
+        }
+        catch (const Base::Exception& e) {
+            FC_ERR("Failed to apply recovery journal record " << fn << ": " << e.what());
+            break;
+        }
+        catch (const std::exception& e) {
+            FC_ERR("Failed to apply recovery journal record " << fn << ": " << e.what());
+            break;
+        }
+    }
 }
 
 void AutoSaver::timerEvent(QTimerEvent * event)
@@ -230,7 +508,6 @@ void AutoSaver::timerEvent(QTimerEvent * event)
         if (it->second->timerId == id) {
             try {
                 saveDocument(it->first, *it->second);
-                it->second->touched.clear();
                 break;
             }
             catch (...) {
@@ -242,18 +519,28 @@ void AutoSaver::timerEvent(QTimerEvent * event)
 
 // ----------------------------------------------------------------------------
 
-AutoSaveProperty::AutoSaveProperty(const App::Document* doc) : timerId(-1)
+AutoSaveProperty::AutoSaveProperty(const App::Document* doc)
+  : timerId(-1), structureChanged(false), hasBaseFile(false), journalRecords(0), document(doc)
 {
     documentNew = const_cast<App::Document*>(doc)->signalNewObject.connect
         (boost::bind(&AutoSaveProperty::slotNewObject, this, bp::_1));
+    documentDel = const_cast<App::Document*>(doc)->signalDeletedObject.connect
+        (boost::bind(&AutoSaveProperty::slotDeletedObject, this, bp::_1));
     documentMod = const_cast<App::Document*>(doc)->signalChangedObject.connect
-        (boost::bind(&AutoSaveProperty::slotChangePropertyData, this, bp::_2));
+        (boost::bind(&AutoSaveProperty::slotChangePropertyData, this, bp::_1, bp::_2));
+    propertyAdd = App::GetApplication().signalAppendDynamicProperty.connect
+        (boost::bind(&AutoSaveProperty::slotDynamicProperty, this, bp::_1));
+    propertyDel = App::GetApplication().signalRemoveDynamicProperty.connect
+        (boost::bind(&AutoSaveProperty::slotDynamicProperty, this, bp::_1));
 }
 
 AutoSaveProperty::~AutoSaveProperty()
 {
     documentNew.disconnect();
+    documentDel.disconnect();
     documentMod.disconnect();
+    propertyAdd.disconnect();
+    propertyDel.disconnect();
 }
 
 void AutoSaveProperty::slotNewObject(const App::DocumentObject& obj)
@@ -264,16 +551,31 @@ void AutoSaveProperty::slotNewObject(const App::DocumentObject& obj)
     // if an object was deleted and then restored by an undo then add all properties
     // because this might be the data files which we may want to re-write
     for (std::vector<App::Property*>::iterator it = props.begin(); it != props.end(); ++it) {
-        slotChangePropertyData(*(*it));
+        this->touched.insert(propertyAddress(*it));
     }
+
+    // the journal only records property values
+    this->structureChanged = true;
 }
 
-void AutoSaveProperty::slotChangePropertyData(const App::Property& prop)
+void AutoSaveProperty::slotDeletedObject(const App::DocumentObject&)
 {
-    std::stringstream str;
-    str << static_cast<const void *>(&prop) << std::ends;
-    std::string address = str.str();
-    this->touched.insert(address);
+    this->structureChanged = true;
+}
+
+void AutoSaveProperty::slotChangePropertyData(const App::DocumentObject& obj, const App::Property& prop)
+{
+    this->touched.insert(propertyAddress(&prop));
+    if (obj.getNameInDocument() && prop.getName())
+        this->changes[obj.getNameInDocument()].insert(prop.getName());
+}
+
+void AutoSaveProperty::slotDynamicProperty(const App::Property& prop)
+{
+    const App::PropertyContainer* parent = prop.getContainer();
+    if (parent && parent->isDerivedFrom(App::DocumentObject::getClassTypeId())
+            && static_cast<const App::DocumentObject*>(parent)->getDocument() == document)
+        this->structureChanged = true;
 }
 
 // ----------------------------------------------------------------------------
@@ -302,9 +604,7 @@ bool RecoveryWriter::shouldWrite(const std::string& name, const Base::Persistenc
     }
 
     // These are the addresses of touched properties of a document object.
-    std::stringstream str;
-    str << static_cast<const void *>(object) << std::ends;
-    std::string address = str.str();
+    std::string address = propertyAddress(object);
 
     // Check if the property will be exported to the same file. If the file has changed or if the property hasn't been
     // yet exported then (re-)write the file.
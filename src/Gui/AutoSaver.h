@@ -31,6 +31,8 @@
 #include <string>
 #include <boost_signals2.hpp>
 
+class QThreadPool;
+
 namespace App {
 class Document;
 class DocumentObject;
@@ -49,13 +51,30 @@ public:
     std::set<std::string> touched;
     std::string dirName;
     std::map<std::string, std::string> fileMap;
+    /// the files of object properties in the compressed recovery file
+    std::map<const Base::Persistence*, std::string> archiveMap;
+    /// the names of the properties changed since the last recovery file or
+    /// journal record, by object name
+    std::map<std::string, std::set<std::string> > changes;
+    /// set if objects or dynamic properties were added or removed
+    bool structureChanged;
+    /// set once this session wrote a full recovery file that the journal applies to
+    bool hasBaseFile;
+    /// the number of journal records written since the last full recovery file
+    int journalRecords;
 
 private:
     void slotNewObject(const App::DocumentObject&);
-    void slotChangePropertyData(const App::Property&);
+    void slotDeletedObject(const App::DocumentObject&);
+    void slotChangePropertyData(const App::DocumentObject&, const App::Property&);
+    void slotDynamicProperty(const App::Property&);
     typedef boost::signals2::connection Connection;
+    const App::Document* document;
     Connection documentNew;
+    Connection documentDel;
     Connection documentMod;
+    Connection propertyAdd;
+    Connection propertyDel;
 };
 
 /*!
@@ -81,12 +100,19 @@ public:
      Enables or disables to create compreesed recovery files.
      */
     void setCompressed(bool on);
+    /*!
+     Applies the records of a recovery journal in \a dirName to the document
+     restored from the recovery file they were written on top of.
+     */
+    static void replayJournal(App::Document* doc, const QString& dirName);
 
 protected:
     void slotCreateDocument(const App::Document& Doc);
     void slotDeleteDocument(const App::Document& Doc);
     void timerEvent(QTimerEvent * event);
     void saveDocument(const std::string&, AutoSaveProperty&);
+    bool writeJournal(App::Document*, AutoSaveProperty&);
+    void clearJournal(const std::string&, AutoSaveProperty&);
 
 public Q_SLOTS:
     void renameFile(QString dirName, QString file, QString tmpFile);
@@ -94,6 +120,7 @@ public Q_SLOTS:
 private:
     int timeout; /*!< Timeout in milliseconds */
     bool compressed;
+    QThreadPool* journalPool;
     std::map<std::string, AutoSaveProperty*> saverMap;
 };
 
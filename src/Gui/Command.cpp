@@ -59,6 +59,7 @@
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Interpreter.h>
+#include <Base/Profiler.h>
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 
@@ -367,6 +368,7 @@ void Command::setupCheckable(int iMsg) {
 
 void Command::invoke(int i, TriggerSource trigger)
 {
+    FC_PROFILE_ZONE_DETAIL("Command::invoke", sName);
     CommandTrigger cmdTrigger(_trigger,trigger);
     if (displayText.empty()) {
         displayText = getMenuText();
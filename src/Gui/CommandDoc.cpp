@@ -65,6 +65,7 @@
 #include "Selection.h"
 #include "DlgProjectInformationImp.h"
 #include "DlgProjectUtility.h"
+#include "DlgMemoryReport.h"
 #include "Transform.h"
 #include "Placement.h"
 #include "ManualAlignment.h"
@@ -862,6 +863,30 @@ bool StdCmdProjectUtil::isActive(void)
     return true;
 }
 
+//===========================================================================
+// Std_MemoryReport
+//===========================================================================
+
+DEF_STD_CMD(StdCmdMemoryReport)
+
+StdCmdMemoryReport::StdCmdMemoryReport()
+  :Command("Std_MemoryReport")
+{
+    sGroup        = QT_TR_NOOP("Tools");
+    sWhatsThis    = "Std_MemoryReport";
+    sMenuText     = QT_TR_NOOP("Memory usage...");
+    sToolTipText  = QT_TR_NOOP("Show the estimated memory usage of the objects of the open documents");
+    sStatusTip    = QT_TR_NOOP("Show the estimated memory usage of the objects of the open documents");
+    eType         = 0;
+}
+
+void StdCmdMemoryReport::activated(int iMsg)
+{
+    Q_UNUSED(iMsg);
+    Gui::Dialog::DlgMemoryReport dlg(getMainWindow());
+    dlg.exec();
+}
+
 //===========================================================================
 // Std_Print
 //===========================================================================
@@ -1960,6 +1985,7 @@ void CreateDocCommands(void)
     rcCmdMgr.addCommand(new StdCmdRevert());
     rcCmdMgr.addCommand(new StdCmdProjectInfo());
     rcCmdMgr.addCommand(new StdCmdProjectUtil());
+    rcCmdMgr.addCommand(new StdCmdMemoryReport());
     rcCmdMgr.addCommand(new StdCmdUndo());
     rcCmdMgr.addCommand(new StdCmdRedo());
     rcCmdMgr.addCommand(new StdCmdPrint());
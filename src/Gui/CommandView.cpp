@@ -2652,6 +2652,21 @@ static std::vector<std::string> getBoxSelection(
                 std::unique_ptr<Data::Segment> segment(data->getSubElementByName(element.c_str()));
                 if(!segment)
                     continue;
+                // cull the element by its bounding box before extracting
+                // its lines, which is much more expensive
+                auto ebox3 = data->getSubElementBoundBox(segment.get());
+                if(ebox3.IsValid()) {
+                    auto ebox = ebox3.ProjectBox(&proj);
+                    if(!ebox.Intersect(polygon))
+                        continue;
+                    // the polygon is a box, see above
+                    if(polygon.Contains(Base::Vector2d(ebox.MinX,ebox.MinY)) &&
+                       polygon.Contains(Base::Vector2d(ebox.MaxX,ebox.MaxY)))
+                    {
+                        ret.push_back(element);
+                        continue;
+                    }
+                }
                 std::vector<Base::Vector3d> points;
                 std::vector<Data::ComplexGeoData::Line> lines;
                 data->getLinesFromSubelement(segment.get(),points,lines);
@@ -2759,6 +2774,7 @@ static void selectionCallback(void * ud, SoEventCallback * cb)
             Gui::Selection().clearSelection(doc->getName());
         }
 
+        std::vector<App::SubObjectT> sels;
         for(auto obj : doc->getObjects()) {
             if(App::GeoFeatureGroupExtension::getGroupOfObject(obj))
                 continue;
@@ -2769,8 +2785,9 @@ static void selectionCallback(void * ud, SoEventCallback * cb)
 
             Base::Matrix4D mat;
             for(auto &sub : getBoxSelection(vp,selectionMode,selectElement,proj,polygon,mat))
-                Gui::Selection().addSelection(doc->getName(), obj->getNameInDocument(), sub.c_str());
+                sels.emplace_back(obj, sub.c_str());
         }
+        Gui::Selection().addSelections(sels);
     }
 }
 
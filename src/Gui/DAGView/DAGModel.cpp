@@ -261,6 +261,7 @@ void Model::slotNewObject(const ViewProviderDocumentObject &VPDObjectIn)
       const_cast<Gui::ViewProviderDocumentObject&>(VPDObjectIn).signalChangeIcon.connect(
           boost::bind(&Model::slotChangeIcon, this, boost::cref(VPDObjectIn), icon));
   
+  dirtyVertices.insert(virginVertex);
   graphDirty = true;
   lastAddedVertex = Graph::null_vertex();
 }
@@ -290,6 +291,7 @@ void Model::slotDeleteObject(const ViewProviderDocumentObject &VPDObjectIn)
     lastAddedVertex = Graph::null_vertex();
 
   (*theGraph)[vertex].connChangeIcon.disconnect();
+  dirtyVertices.erase(vertex);
   
   //remove the actual vertex.
   boost::clear_vertex(vertex, *theGraph);
@@ -319,8 +321,10 @@ void Model::slotChangeObject(const ViewProviderDocumentObject &VPDObjectIn, cons
   }
   else if (propertyIn.isDerivedFrom(App::PropertyLinkBase::getClassTypeId()))
   {
+    //clear_vertex also drops the in edges, so updateEdges restores them from the in list.
     const GraphLinkRecord &record = findRecord(&VPDObjectIn, *graphLink);
     boost::clear_vertex(record.vertex, *theGraph);
+    dirtyVertices.insert(record.vertex);
     graphDirty = true;
   }
 }
@@ -467,27 +471,11 @@ void Model::updateSlot()
   
   Base::TimeInfo startTime;
   
-  //here we will cycle through the graph updating edges.
+  //here we will update the edges of the vertices that were added or had their links changed.
   //we have to do this first and in isolation because everything is dependent on an up to date graph.
-  BGL_FORALL_VERTICES(currentVertex, *theGraph, Graph)
-  {
-    const App::DocumentObject *currentDObject = findRecord(currentVertex, *graphLink).DObject;
-    std::vector<App::DocumentObject *> otherDObjects = currentDObject->getOutList();
-    for (auto &currentOtherDObject : otherDObjects)
-    {
-      if (!hasRecord(currentOtherDObject, *graphLink))
-          continue;
-      Vertex otherVertex = findRecord(currentOtherDObject, *graphLink).vertex;
-      bool result;
-      Edge edge;
-      boost::tie(edge, result) = boost::add_edge(currentVertex, otherVertex, *theGraph);
-      if (result)
-      {
-        (*theGraph)[edge].connector = std::make_shared<QGraphicsPathItem>();
-        (*theGraph)[edge].connector->setZValue(0.0);
-      }
-    }
-  }
+  for (const auto &currentVertex : dirtyVertices)
+    updateEdges(currentVertex);
+  dirtyVertices.clear();
   
   //apply filters.
   BGL_FORALL_VERTICES(currentVertex, *theGraph, Graph)
@@ -558,6 +546,37 @@ void Model::updateSlot()
     tempIndex++;
   }
   
+  //the columns used between a vertex and its farthest parent in the sort order are
+  //looked up in a segment tree, so finding a column doesn't scan all the rows in between.
+  //hidden vertices keep their last column like before.
+  std::size_t leafCount = 1;
+  while (leafCount < sorted.size())
+    leafCount <<= 1;
+  std::vector<ColumnMask> columnTree(2 * leafCount);
+  for (std::size_t index = 0; index < sorted.size(); ++index)
+    columnTree[leafCount + index] = (*theGraph)[sorted[index]].column;
+  for (std::size_t index = leafCount - 1; index > 0; --index)
+    columnTree[index] = columnTree[2 * index] | columnTree[2 * index + 1];
+  auto setColumnMask = [&](std::size_t index, const ColumnMask &maskIn)
+  {
+    index += leafCount;
+    columnTree[index] = maskIn;
+    for (index /= 2; index > 0; index /= 2)
+      columnTree[index] = columnTree[2 * index] | columnTree[2 * index + 1];
+  };
+  auto usedColumns = [&](std::size_t begin, std::size_t end) //end is not included.
+  {
+    ColumnMask out;
+    for (begin += leafCount, end += leafCount; begin < end; begin /= 2, end /= 2)
+    {
+      if (begin & 1)
+        out |= columnTree[begin++];
+      if (end & 1)
+        out |= columnTree[--end];
+    }
+    return out;
+  };
+  
   //draw graph(nodes and connectors).
   int currentRow = 0;
   int currentColumn = -1; //we know first column is going to be root so will be kicked up to 0.
@@ -574,31 +593,16 @@ void Model::updateSlot()
     {
       //loop parents and find an acceptable column.
       int farthestParentIndex = sorted.size();
-      ColumnMask columnMask;
       Path parentVertices;
       OutEdgeIterator it, itEnd;
       boost::tie(it, itEnd) = boost::out_edges(currentVertex, *theGraph);
       for (;it != itEnd; ++it)
       {
-//         std::cout << std::endl << "name: " << findRecord(currentVertex, *graphLink).DObject->Label.getValue() << std::endl;
-        
         Vertex target = boost::target(*it, *theGraph);
         parentVertices.push_back(target);
-        int currentParentIndex = (*theGraph)[target].topoSortIndex;
-        if (currentParentIndex < farthestParentIndex)
-        {
-          Path::const_iterator start = sorted.begin() + currentParentIndex + 1; // 1 after
-          Path::const_iterator end = sorted.begin() + (*theGraph)[currentVertex].topoSortIndex; // 1 before
-          Path::const_iterator it;
-          for (it = start; it != end; ++it)
-          {
-//             std::cout << "    parent: " << findRecord(*it, *graphLink).DObject->Label.getValue() << std::endl;
-            
-            columnMask |= (*theGraph)[*it].column;
-          }
-          farthestParentIndex = currentParentIndex;
-        }
+        farthestParentIndex = std::min(farthestParentIndex, (*theGraph)[target].topoSortIndex);
       }
+      ColumnMask columnMask = usedColumns(farthestParentIndex + 1, (*theGraph)[currentVertex].topoSortIndex);
       
       //have to create a smaller subset to get through std::cout.
 //       std::bitset<8> testSet;
@@ -668,8 +672,11 @@ void Model::updateSlot()
     auto *pixmap = (*theGraph)[currentVertex].icon.get();
     pixmap->setTransform(QTransform::fromTranslate(0.0, rowHeight * currentRow + cheat)); //calculate x location later.
     
+    //relayout of the text is the expensive part, so only touch it when the label changed.
     auto *text = (*theGraph)[currentVertex].text.get();
-    text->setPlainText(QString::fromUtf8(findRecord(currentVertex, *graphLink).DObject->Label.getValue()));
+    QString label = QString::fromUtf8(findRecord(currentVertex, *graphLink).DObject->Label.getValue());
+    if (text->toPlainText() != label)
+      text->setPlainText(label);
     text->setDefaultTextColor(currentBrush.color());
     maxTextLength = std::max(maxTextLength, static_cast<float>(text->boundingRect().width()));
     text->setTransform(QTransform::fromTranslate
@@ -679,6 +686,7 @@ void Model::updateSlot()
     //store column and row int the graph. use for connectors later.
     (*theGraph)[currentVertex].row = currentRow;
     (*theGraph)[currentVertex].column.reset().set((currentColumn));
+    setColumnMask((*theGraph)[currentVertex].topoSortIndex, (*theGraph)[currentVertex].column);
     
     //our list is topo sorted so all dependents should be located, so we can build the connectors.
     //will have some more logic for connector path, simple for now.
@@ -691,15 +699,15 @@ void Model::updateSlot()
       Vertex target = boost::target(*it, *theGraph);
       if (!(*theGraph)[target].dagVisible)
         continue; //we don't make it here if source isn't visible. So don't have to worry about that.
-      float dependentX = pointSpacing * static_cast<int>(columnFromMask((*theGraph)[target].column)) + pointSize / 2.0; //on center.
-      columnFromMask((*theGraph)[target].column);
+      int dependentColumn = static_cast<int>(columnFromMask((*theGraph)[target].column));
+      float dependentX = pointSpacing * dependentColumn + pointSize / 2.0; //on center.
       float dependentY = rowHeight * (*theGraph)[target].row + rowHeight / 2.0;
       
       QGraphicsPathItem *pathItem = (*theGraph)[*it].connector.get();
       pathItem->setBrush(Qt::NoBrush);
       QPainterPath path;
       path.moveTo(currentX, currentY);
-      if (currentColumn == static_cast<int>(columnFromMask((*theGraph)[target].column)))
+      if (currentColumn == dependentColumn)
         path.lineTo(currentX, dependentY); //straight connector in y.
       else
       {
@@ -883,10 +891,42 @@ void Model::updateStates()
   }
 }
 
+void Model::updateEdges(const Vertex &vertexIn)
+{
+  auto addEdge = [this](const Vertex &source, const Vertex &target)
+  {
+    bool result;
+    Edge edge;
+    boost::tie(edge, result) = boost::add_edge(source, target, *theGraph);
+    if (result)
+    {
+      (*theGraph)[edge].connector = std::make_shared<QGraphicsPathItem>();
+      (*theGraph)[edge].connector->setZValue(0.0);
+    }
+  };
+  
+  const App::DocumentObject *currentDObject = findRecord(vertexIn, *graphLink).DObject;
+  for (auto *otherDObject : currentDObject->getOutList())
+  {
+    if (hasRecord(otherDObject, *graphLink))
+      addEdge(vertexIn, findRecord(otherDObject, *graphLink).vertex);
+  }
+  for (auto *otherDObject : currentDObject->getInList())
+  {
+    if (hasRecord(otherDObject, *graphLink))
+      addEdge(findRecord(otherDObject, *graphLink).vertex, vertexIn);
+  }
+}
+
 std::size_t Model::columnFromMask(const ColumnMask &maskIn)
 {
-  std::string maskString = maskIn.to_string();
-  return maskString.size() - maskString.find('1') - 1;
+  //highest set bit, without building the string of the whole mask.
+  for (std::size_t index = maskIn.size(); index-- > 0;)
+  {
+    if (maskIn.test(index))
+      return index;
+  }
+  return maskIn.size();
 }
 
 RectItem* Model::getRectFromPosition(const QPointF& position)
@@ -24,6 +24,7 @@
 #define DAGMODEL_H
 
 #include <memory>
+#include <set>
 #include <vector>
 
 #include <boost_signals2.hpp>
@@ -105,6 +106,8 @@ namespace Gui
       std::shared_ptr<GraphLinkContainer> graphLink;
       std::shared_ptr<Graph> theGraph;
       bool graphDirty;
+      std::set<Vertex> dirtyVertices; //!< vertices whose edges have to be rebuilt in updateSlot.
+      void updateEdges(const Vertex &vertexIn);
       
       void indexVerticesEdges();
       void removeAllItems();
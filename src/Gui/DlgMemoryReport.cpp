@@ -0,0 +1,181 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <map>
+# include <QHeaderView>
+# include <QTreeWidgetItem>
+#endif
+
+#include <App/MemoryReport.h>
+
+#include "DlgMemoryReport.h"
+#include "WaitCursor.h"
+#include "ui_DlgMemoryReport.h"
+
+using namespace Gui::Dialog;
+
+namespace {
+
+const int SizeColumn = 2;
+
+QString formatSize(std::size_t size)
+{
+    if (size < 1024)
+        return QObject::tr("%1 B").arg(size);
+    if (size < 1024 * 1024)
+        return QObject::tr("%1 KB").arg(size / 1024.0, 0, 'f', 1);
+    if (size < 1024 * 1024 * 1024)
+        return QObject::tr("%1 MB").arg(size / (1024.0 * 1024.0), 0, 'f', 1);
+    return QObject::tr("%1 GB").arg(size / (1024.0 * 1024.0 * 1024.0), 0, 'f', 2);
+}
+
+/// Sorts by the number of bytes instead of the text of the size column
+class SizeItem : public QTreeWidgetItem
+{
+public:
+    explicit SizeItem(const QString& name)
+    {
+        setText(0, name);
+        setTextAlignment(SizeColumn, Qt::AlignRight | Qt::AlignVCenter);
+    }
+    void addSize(std::size_t value)
+    {
+        size += value;
+        setText(SizeColumn, formatSize(size));
+    }
+    bool operator<(const QTreeWidgetItem& other) const override
+    {
+        int column = treeWidget() ? treeWidget()->sortColumn() : 0;
+        if (column == SizeColumn)
+            return size < static_cast<const SizeItem&>(other).size;
+        return QTreeWidgetItem::operator<(other);
+    }
+
+private:
+    std::size_t size = 0;
+};
+
+QString objectText(const App::MemoryReport::Entry& entry)
+{
+    if (entry.object.empty())
+        return QString::fromUtf8(entry.document.c_str());
+    if (entry.label.empty() || entry.label == entry.object)
+        return QString::fromUtf8(entry.object.c_str());
+    return QString::fromLatin1("%1 (%2)").arg(QString::fromUtf8(entry.label.c_str()),
+                                              QString::fromUtf8(entry.object.c_str()));
+}
+
+}
+
+/* TRANSLATOR Gui::Dialog::DlgMemoryReport */
+
+DlgMemoryReport::DlgMemoryReport(QWidget* parent, Qt::WindowFlags fl)
+  : QDialog(parent, fl), ui(new Ui_DlgMemoryReport)
+{
+    ui->setupUi(this);
+    ui->treeWidget->header()->setStretchLastSection(false);
+    ui->treeWidget->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    populate();
+}
+
+DlgMemoryReport::~DlgMemoryReport()
+{
+}
+
+void DlgMemoryReport::on_refreshButton_clicked()
+{
+    populate();
+}
+
+void DlgMemoryReport::on_groupBox_activated(int)
+{
+    populate();
+}
+
+void DlgMemoryReport::populate()
+{
+    WaitCursor wc;
+    App::MemoryReport report;
+    report.collect();
+
+    QTreeWidget* tree = ui->treeWidget;
+    tree->clear();
+    tree->setSortingEnabled(false);
+
+    // Two levels of groups, the entries are the leaves
+    std::map<QString, SizeItem*> groups;
+    std::map<std::pair<QString, QString>, SizeItem*> subgroups;
+    int grouping = ui->groupBox->currentIndex();
+    for (const auto& entry : report.entries()) {
+        QString document = QString::fromUtf8(entry.document.c_str());
+        QString name = QString::fromUtf8(entry.name.c_str());
+        QString category = QString::fromLatin1(App::MemoryReport::categoryName(entry.category));
+        QString group, subgroup, leaf;
+        switch (grouping) {
+        case 1: // Property
+            group = name;
+            subgroup = document;
+            leaf = objectText(entry);
+            break;
+        case 2: // Category
+            group = category;
+            subgroup = document;
+            leaf = objectText(entry) + QLatin1String(".") + name;
+            break;
+        default: // Document
+            group = document;
+            subgroup = objectText(entry);
+            leaf = name;
+            break;
+        }
+
+        SizeItem*& groupItem = groups[group];
+        if (!groupItem) {
+            groupItem = new SizeItem(group);
+            tree->addTopLevelItem(groupItem);
+        }
+        SizeItem*& subgroupItem = subgroups[std::make_pair(group, subgroup)];
+        if (!subgroupItem) {
+            subgroupItem = new SizeItem(subgroup);
+            groupItem->addChild(subgroupItem);
+        }
+        SizeItem* item = new SizeItem(leaf);
+        item->setText(1, category);
+        item->addSize(entry.size);
+        subgroupItem->addChild(item);
+        subgroupItem->addSize(entry.size);
+        groupItem->addSize(entry.size);
+    }
+
+    tree->setSortingEnabled(true);
+    tree->sortByColumn(SizeColumn, Qt::DescendingOrder);
+    tree->resizeColumnToContents(1);
+    tree->resizeColumnToContents(SizeColumn);
+    ui->totalLabel->setText(tr("Total: %1 (estimated)").arg(formatSize(report.total())));
+}
+
+#include "moc_DlgMemoryReport.cpp"
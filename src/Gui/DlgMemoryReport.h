@@ -0,0 +1,59 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef GUI_DIALOG_DLGMEMORYREPORT_H
+#define GUI_DIALOG_DLGMEMORYREPORT_H
+
+#include <QDialog>
+#include <memory>
+
+namespace Gui { namespace Dialog {
+
+class Ui_DlgMemoryReport;
+
+/** Shows the estimated memory usage of the open documents, see App::MemoryReport.
+ */
+class DlgMemoryReport : public QDialog
+{
+    Q_OBJECT
+
+public:
+    DlgMemoryReport(QWidget* parent = nullptr, Qt::WindowFlags fl = Qt::WindowFlags());
+    ~DlgMemoryReport();
+
+private Q_SLOTS:
+    void on_refreshButton_clicked();
+    void on_groupBox_activated(int);
+
+private:
+    void populate();
+
+private:
+    std::unique_ptr<Ui_DlgMemoryReport> ui;
+};
+
+} // namespace Dialog
+} // namespace Gui
+
+#endif // GUI_DIALOG_DLGMEMORYREPORT_H
@@ -37,6 +37,15 @@
 # include <boost_bind_bind.hpp>
 # include <Inventor/actions/SoSearchAction.h>
 # include <Inventor/nodes/SoSeparator.h>
+# include <Inventor/fields/SoMFColor.h>
+# include <Inventor/fields/SoMFFloat.h>
+# include <Inventor/fields/SoMFInt32.h>
+# include <Inventor/fields/SoMFUInt32.h>
+# include <Inventor/fields/SoMFVec2f.h>
+# include <Inventor/fields/SoMFVec3f.h>
+# include <Inventor/fields/SoMFVec4f.h>
+# include <Inventor/lists/SoFieldList.h>
+# include <Inventor/misc/SoChildList.h>
 #endif
 
 #include <cctype>
@@ -54,6 +63,7 @@
 #include <App/Transactions.h>
 #include <App/AutoTransaction.h>
 #include <App/GeoFeatureGroupExtension.h>
+#include <App/MemoryReport.h>
 
 #include "Application.h"
 #include "MainWindow.h"
@@ -127,6 +137,7 @@ struct DocumentP
     Connection connectExportObjects;
     Connection connectImportObjects;
     Connection connectFinishImportObjects;
+    Connection connectCopyViewObjects;
     Connection connectUndoDocument;
     Connection connectRedoDocument;
     Connection connectRecomputed;
@@ -199,6 +210,8 @@ Document::Document(App::Document* pcDocument,Application * app)
         (boost::bind(&Gui::Document::importObjects, this, bp::_1, bp::_2, bp::_3));
     d->connectFinishImportObjects = pcDocument->signalFinishImportObjects.connect
         (boost::bind(&Gui::Document::slotFinishImportObjects, this, bp::_1));
+    d->connectCopyViewObjects = pcDocument->signalCopyViewObjects.connect
+        (boost::bind(&Gui::Document::copyViewObjects, this, bp::_1, bp::_2));
 
     d->connectUndoDocument = pcDocument->signalUndo.connect
         (boost::bind(&Gui::Document::slotUndoDocument, this, bp::_1));
@@ -248,6 +261,7 @@ Document::~Document()
     d->connectExportObjects.disconnect();
     d->connectImportObjects.disconnect();
     d->connectFinishImportObjects.disconnect();
+    d->connectCopyViewObjects.disconnect();
     d->connectUndoDocument.disconnect();
     d->connectRedoDocument.disconnect();
     d->connectRecomputed.disconnect();
@@ -1302,6 +1316,69 @@ unsigned int Document::getMemSize (void) const
     return size;
 }
 
+namespace {
+/// Estimates the memory of \a node and its children, nodes in \a visited are not counted again
+std::size_t sceneGraphMemSize(SoNode* node, std::set<const SoNode*>& visited)
+{
+    if (!node || !visited.insert(node).second)
+        return 0;
+
+    std::size_t size = sizeof(SoNode);
+    SoFieldList fields;
+    int count = node->getFields(fields);
+    for (int i = 0; i < count; i++) {
+        SoField* field = fields[i];
+        size += sizeof(SoField);
+        if (!field->isOfType(SoMField::getClassTypeId()))
+            continue;
+
+        // the big fields are the coordinates, normals, colors and indices of the shapes
+        std::size_t num = static_cast<SoMField*>(field)->getNum();
+        if (field->isOfType(SoMFVec3f::getClassTypeId()))
+            size += num * sizeof(SbVec3f);
+        else if (field->isOfType(SoMFVec2f::getClassTypeId()))
+            size += num * sizeof(SbVec2f);
+        else if (field->isOfType(SoMFVec4f::getClassTypeId()))
+            size += num * sizeof(SbVec4f);
+        else if (field->isOfType(SoMFColor::getClassTypeId()))
+            size += num * sizeof(SbColor);
+        else if (field->isOfType(SoMFInt32::getClassTypeId()))
+            size += num * sizeof(int32_t);
+        else if (field->isOfType(SoMFUInt32::getClassTypeId()))
+            size += num * sizeof(uint32_t);
+        else if (field->isOfType(SoMFFloat::getClassTypeId()))
+            size += num * sizeof(float);
+        else
+            size += num * sizeof(void*);
+    }
+
+    SoChildList* children = node->getChildren();
+    if (children) {
+        for (int i = 0; i < children->getLength(); i++)
+            size += sceneGraphMemSize((*children)[i], visited);
+    }
+    return size;
+}
+}
+
+void Document::addToMemoryReport(App::MemoryReport& report) const
+{
+    std::string docName = getDocument()->getName();
+    std::set<const SoNode*> visited;
+    for (const auto& it : d->_ViewProviderMap) {
+        const App::DocumentObject* obj = it.first;
+        if (!obj->getNameInDocument())
+            continue;
+        std::string name = obj->getNameInDocument();
+        std::string label = obj->Label.getStrValue();
+        ViewProviderDocumentObject* vp = it.second;
+        report.addProperties(docName, name, label, vp, App::MemoryReport::ViewProperties);
+        std::size_t size = sceneGraphMemSize(vp->getRoot(), visited);
+        report.add(App::MemoryReport::Entry{docName, name, label, "Coin nodes",
+                                            App::MemoryReport::SceneGraph, size});
+    }
+}
+
 /**
  * Adds a separate XML file to the projects file that contains information about the view providers.
  */
@@ -1643,6 +1720,24 @@ void Document::importObjects(const std::vector<App::DocumentObject*>& obj, Base:
         reader.initLocalReader(localreader);
 }
 
+void Document::copyViewObjects(const std::vector<App::DocumentObject*>& sources,
+                               const std::vector<App::DocumentObject*>& copies)
+{
+    for (std::size_t i=0; i<sources.size() && i<copies.size(); ++i) {
+        Gui::ViewProvider* src = getViewProvider(sources[i]);
+        Gui::ViewProvider* dst = getViewProvider(copies[i]);
+        if (!src || !dst)
+            continue;
+        // finishRestoring() is triggered by signalFinishRestoreObject as
+        // for imported objects
+        dst->setStatus(Gui::isRestoring,true);
+        auto vpd = Base::freecad_dynamic_cast<ViewProviderDocumentObject>(dst);
+        if (vpd)
+            vpd->startRestoring();
+        dst->copyProperties(*src);
+    }
+}
+
 void Document::slotFinishImportObjects(const std::vector<App::DocumentObject*> &objs) {
     (void)objs;
     // finishRestoring() is now triggered by signalFinishRestoreObject
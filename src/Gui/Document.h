@@ -44,6 +44,7 @@ class Matrix4D;
 
 namespace App {
 class DocumentObjectGroup;
+class MemoryReport;
 }
 
 namespace Gui {
@@ -140,6 +141,8 @@ public:
     /** @name I/O of the document */
     //@{
     unsigned int getMemSize (void) const;
+    /// Adds the properties and the Coin nodes of the view providers to \a report
+    void addToMemoryReport(App::MemoryReport& report) const;
     /// Save the document
     bool save(void);
     /// Save the document under a new file name
@@ -159,6 +162,9 @@ public:
     void exportObjects(const std::vector<App::DocumentObject*>&, Base::Writer&);
     void importObjects(const std::vector<App::DocumentObject*>&, Base::Reader&,
                        const std::map<std::string, std::string>& nameMapping);
+    /// Copy the view provider properties of objects copied in memory
+    void copyViewObjects(const std::vector<App::DocumentObject*>& sources,
+                         const std::vector<App::DocumentObject*>& copies);
     /// Add all root objects of the given array to a group
     void addRootObjectsToGroup(const std::vector<App::DocumentObject*>&, App::DocumentObjectGroup*);
     //@}
@@ -49,6 +49,7 @@
 
 #include <Base/Console.h>
 #include "DocumentRecovery.h"
+#include "AutoSaver.h"
 #include "ui_DocumentRecovery.h"
 #include "WaitCursor.h"
 
@@ -298,6 +299,11 @@ void DocumentRecovery::accept()
                 d->writeRecoveryInfo(info);
             }
             else {
+                // apply the changes recorded after the recovery file was written
+                QFileInfo xfi(info.xmlFile);
+                AutoSaver::replayJournal(docs[i], QDir(xfi.absolutePath())
+                        .filePath(QLatin1String("fc_recovery_journal")));
+
                 auto gdoc = Application::Instance->getDocument(docs[i]);
                 if (gdoc)
                     gdoc->setModified(true);
@@ -310,7 +316,6 @@ void DocumentRecovery::accept()
 
                 QDir transDir(QString::fromUtf8(docs[i]->TransientDir.getValue()));
 
-                QFileInfo xfi(info.xmlFile);
                 QFileInfo fi(info.projectFile);
                 bool res = false;
 
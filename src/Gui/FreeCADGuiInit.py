@@ -104,6 +104,80 @@ class NoneWorkbench ( Workbench ):
         """Return the name of the associated C++ class."""
         return "Gui::NoneWorkbench"
 
+def runModuleInitGuiScript(Dir, InstallFile):
+    """Runs the InitGui.py of a module directory and logs the time it took."""
+    import sys,time,traceback
+    start = time.time()
+    try:
+        # XXX: This looks scary securitywise...
+        if sys.version_info.major < 3:
+            with open(InstallFile) as f:
+                exec(f.read(), dict(globals(), Dir=Dir, InstallFile=InstallFile))
+        else:
+            with open(file=InstallFile, encoding="utf-8") as f:
+                exec(f.read(), dict(globals(), Dir=Dir, InstallFile=InstallFile))
+    except Exception as inst:
+        Log('Init:      Initializing ' + Dir + '... failed\n')
+        Log('-'*100+'\n')
+        Log(traceback.format_exc())
+        Log('-'*100+'\n')
+        Err('During initialization the error "' + str(inst) + '" occurred in ' + InstallFile + '\n')
+        Err('Please look into the log file for further information\n')
+        return False
+    else:
+        elapsed = time.time() - start
+        FreeCAD.__ModuleInitTimes__[InstallFile] = elapsed
+        Log('Init:      Initializing ' + Dir + '... done (%.3f s)\n' % elapsed)
+        return True
+
+def DeferredWorkbench(Dir, InstallFile, Manifest):
+    """Creates a placeholder for the workbench described in the [Workbench]
+    section of a module manifest. Only its first activation loads the module:
+    InitGui.py is run, the workbench it adds takes the place of the
+    placeholder and gets initialized."""
+    import os
+    section = Manifest["Workbench"]
+    icon = section.get("Icon", "")
+    if icon and not os.path.isabs(icon) and os.path.exists(os.path.join(Dir, icon)):
+        icon = os.path.join(Dir, icon)
+    className = section.get("ClassName", "Gui::PythonWorkbench")
+
+    def Initialize(self):
+        FreeCAD.loadDeferredModule(Dir)
+        added = []
+        addWorkbench = FreeCADGui.addWorkbench
+        FreeCADGui.addWorkbench = added.append
+        try:
+            runModuleInitGuiScript(Dir, InstallFile)
+        finally:
+            FreeCADGui.addWorkbench = addWorkbench
+        real = None
+        for wb in added:
+            if isinstance(wb, type) or type(wb).__name__ == "classobj":
+                wb = wb()
+            if type(wb).__name__ == type(self).__name__ and real is None:
+                real = wb
+            else:
+                addWorkbench(wb)
+        if real is None:
+            Err('Module ' + Dir + ' did not add the workbench ' + type(self).__name__ + '\n')
+            return
+        handle = self.__Workbench__
+        self.__class__ = real.__class__
+        self.__dict__.update(real.__dict__)
+        self.__Workbench__ = handle
+        self.Initialize()
+
+    def GetClassName(self):
+        return className
+
+    return type(section.get("Name", os.path.basename(Dir) + "Workbench"), (Workbench,), {
+        "MenuText": section.get("MenuText", ""),
+        "ToolTip": section.get("ToolTip", ""),
+        "Icon": icon,
+        "Initialize": Initialize,
+        "GetClassName": GetClassName})()
+
 def InitApplications():
     import sys,os,traceback
     try:
@@ -120,24 +194,12 @@ def InitApplications():
     for Dir in ModDirs:
         if ((Dir != '') & (Dir != 'CVS') & (Dir != '__init__.py')):
             InstallFile = os.path.join(Dir,"InitGui.py")
-            if (os.path.exists(InstallFile)):
-                try:
-                    # XXX: This looks scary securitywise...
-                    if sys.version_info.major < 3:
-                        with open(InstallFile) as f:
-                            exec(f.read())
-                    else:
-                        with open(file=InstallFile, encoding="utf-8") as f:
-                            exec(f.read())
-                except Exception as inst:
-                    Log('Init:      Initializing ' + Dir + '... failed\n')
-                    Log('-'*100+'\n')
-                    Log(traceback.format_exc())
-                    Log('-'*100+'\n')
-                    Err('During initialization the error "' + str(inst) + '" occurred in ' + InstallFile + '\n')
-                    Err('Please look into the log file for further information\n')
-                else:
-                    Log('Init:      Initializing ' + Dir + '... done\n')
+            Manifest = FreeCAD.__ModuleManifests__.get(Dir)
+            if (os.path.exists(InstallFile)) and Manifest and "Workbench" in Manifest:
+                Gui.addWorkbench(DeferredWorkbench(Dir, InstallFile, Manifest))
+                Log('Init:      Initializing ' + Dir + '... deferred\n')
+            elif (os.path.exists(InstallFile)):
+                runModuleInitGuiScript(Dir, InstallFile)
             else:
                 Log('Init:      Initializing ' + Dir + '(InitGui.py not found)... ignore\n')
 
@@ -255,6 +255,13 @@ void OpenGLMultiBuffer::allocate(const void *data, int count)
     }
 }
 
+void OpenGLMultiBuffer::write(int offset, const void *data, int count)
+{
+    if (currentBuf && *currentBuf) {
+        cc_glglue_glBufferSubData(glue, target, offset, count, data);
+    }
+}
+
 bool OpenGLMultiBuffer::bind()
 {
     if (currentBuf && *currentBuf) {
@@ -72,6 +72,8 @@ public:
 
     void destroy();
     void allocate(const void *data, int count);
+    /// Replaces \a count bytes of the bound buffer starting at \a offset
+    void write(int offset, const void *data, int count);
     bool bind();
     void release();
     GLuint getBufferId() const;
@@ -59,6 +59,7 @@
 #include <Base/FileInfo.h>
 #include <Base/Interpreter.h>
 #include <Base/Persistence.h>
+#include <Base/Profiler.h>
 #include <Base/Stream.h>
 #include <Base/Reader.h>
 #include <Base/Writer.h>
@@ -1234,6 +1235,7 @@ void MainWindow::delayedStartup()
 
     // processing all command line files
     try {
+        FC_PROFILE_ZONE("MainWindow::processCmdLineFiles");
         std::list<std::string> files = App::Application::getCmdLineFiles();
         files = App::Application::processFiles(files);
         for (std::list<std::string>::iterator it = files.begin(); it != files.end(); ++it) {
@@ -1263,6 +1265,8 @@ void MainWindow::delayedStartup()
     if (hGrp->GetBool("RecoveryEnabled", true)) {
         Application::Instance->checkForPreviousCrashes();
     }
+
+    App::Application::saveStartupProfile();
 }
 
 void MainWindow::appendRecentFile(const QString& filename)
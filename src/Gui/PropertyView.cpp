@@ -322,16 +322,6 @@ struct PropertyView::PropInfo
     std::vector<App::Property*> propList;
 };
 
-struct PropertyView::PropFind {
-    const PropInfo& item;
-    PropFind(const PropInfo& item) : item(item) {}
-    bool operator () (const PropInfo& elem) const
-    {
-        return (elem.propId == item.propId) &&
-               (elem.propName == item.propName);
-    }
-};
-
 void PropertyView::onSelectionChanged(const SelectionChanges& msg)
 {
     if (msg.Type != SelectionChanges::AddSelection &&
@@ -377,6 +367,8 @@ void PropertyView::onTimer() {
     // group the properties by <name,id>
     std::vector<PropInfo> propDataMap;
     std::vector<PropInfo> propViewMap;
+    std::map<std::pair<std::string,int>, std::size_t> propDataIndex;
+    std::map<std::pair<std::string,int>, std::size_t> propViewIndex;
     bool checkLink = true;
     ViewProviderDocumentObject *vpLast = 0;
     auto sels = Gui::Selection().getSelectionEx("*");
@@ -410,23 +402,28 @@ void PropertyView::onTimer() {
         // get the properties as map here because it doesn't matter to have them sorted alphabetically
         vp->getPropertyMap(viewList);
 
+        // Only the properties common to all objects are shown, so anything
+        // missing in the first object can be skipped for the others.
+        bool firstObject = objSet.size() == 1;
+
         // store the properties with <name,id> as key in a map
         {
             for (auto prop : dataList) {
                 if (isPropertyHidden(prop))
                     continue;
 
-                PropInfo nameType;
-                nameType.propName = prop->getName();
-                nameType.propId = prop->getTypeId().getKey();
-
-                std::vector<PropInfo>::iterator pi = std::find_if(propDataMap.begin(), propDataMap.end(), PropFind(nameType));
-                if (pi != propDataMap.end()) {
-                    pi->propList.push_back(prop);
+                auto key = std::make_pair(std::string(prop->getName()), (int)prop->getTypeId().getKey());
+                auto pi = propDataIndex.find(key);
+                if (pi != propDataIndex.end()) {
+                    propDataMap[pi->second].propList.push_back(prop);
                 }
-                else {
+                else if (firstObject) {
+                    PropInfo nameType;
+                    nameType.propName = key.first;
+                    nameType.propId = key.second;
                     nameType.propList.push_back(prop);
-                    propDataMap.push_back(nameType);
+                    propDataIndex.emplace(std::move(key), propDataMap.size());
+                    propDataMap.push_back(std::move(nameType));
                 }
             }
         }
@@ -437,17 +434,18 @@ void PropertyView::onTimer() {
                 if (isPropertyHidden(pt->second))
                     continue;
 
-                PropInfo nameType;
-                nameType.propName = pt->first;
-                nameType.propId = pt->second->getTypeId().getKey();
-
-                std::vector<PropInfo>::iterator pi = std::find_if(propViewMap.begin(), propViewMap.end(), PropFind(nameType));
-                if (pi != propViewMap.end()) {
-                    pi->propList.push_back(pt->second);
+                auto key = std::make_pair(pt->first, (int)pt->second->getTypeId().getKey());
+                auto pi = propViewIndex.find(key);
+                if (pi != propViewIndex.end()) {
+                    propViewMap[pi->second].propList.push_back(pt->second);
                 }
-                else {
+                else if (firstObject) {
+                    PropInfo nameType;
+                    nameType.propName = key.first;
+                    nameType.propId = key.second;
                     nameType.propList.push_back(pt->second);
-                    propViewMap.push_back(nameType);
+                    propViewIndex.emplace(std::move(key), propViewMap.size());
+                    propViewMap.push_back(std::move(nameType));
                 }
             }
         }
@@ -510,7 +508,7 @@ void PropertyView::onTimer() {
     dataPropsMap.clear();
 
     for (it = propDataMap.begin(); it != propDataMap.end(); ++it) {
-        if (it->propList.size() == sels.size()) {
+        if (it->propList.size() == objSet.size()) {
             if(it->propList[0]->testStatus(App::Property::PropDynamic))
                 dataPropsMap.emplace(it->propName, std::move(it->propList));
             else
@@ -524,7 +522,7 @@ void PropertyView::onTimer() {
     propertyEditorData->buildUp(std::move(dataProps),true);
 
     for (it = propViewMap.begin(); it != propViewMap.end(); ++it) {
-        if (it->propList.size() == sels.size())
+        if (it->propList.size() == objSet.size())
             viewProps.emplace_back(it->propName, std::move(it->propList));
     }
 
@@ -96,7 +96,6 @@ private:
 
 private:
     struct PropInfo;
-    struct PropFind;
     typedef boost::signals2::connection Connection;
     Connection connectPropData;
     Connection connectPropView;
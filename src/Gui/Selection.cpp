@@ -1243,16 +1243,29 @@ std::vector<SelectionObject> SelectionSingleton::selStackGet(
 }
 
 bool SelectionSingleton::addSelections(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames)
+{
+    // this function has never logged its selection
+    SelectionLogDisabler disabler(true);
+    std::vector<App::SubObjectT> objs;
+    objs.reserve(pSubNames.size());
+    for(auto &sub : pSubNames)
+        objs.emplace_back(pDocName, pObjectName, sub.c_str());
+    addSelections(objs, false);
+    return true;
+}
+
+bool SelectionSingleton::addSelections(const std::vector<App::SubObjectT> &objs, bool clearPreselect)
 {
     if(_PickedList.size()) {
         _PickedList.clear();
         notify(SelectionChanges(SelectionChanges::PickedListChanged));
     }
 
-    bool update = false;
-    for(std::vector<std::string>::const_iterator it = pSubNames.begin(); it != pSubNames.end(); ++it) {
+    std::vector<std::string> docs;
+    for(auto &objT : objs) {
         _SelObj temp;
-        int ret = checkSelection(pDocName,pObjectName,it->c_str(),0,temp);
+        int ret = checkSelection(objT.getDocumentName().c_str(), objT.getObjectName().c_str(),
+                objT.getSubName().c_str(), 0, temp);
         if(ret!=0)
             continue;
 
@@ -1260,20 +1273,39 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
         temp.y        = 0;
         temp.z        = 0;
 
-        _SelList.push_back(temp);
-        _SelStackForward.clear();
+        // Unlike addSelection(), silently skip what is rejected by the gate
+        // so that a large selection does not beep for each entry.
+        if (ActiveGate) {
+            const char *subelement = 0;
+            auto pObject = getObjectOfType(temp,App::DocumentObject::getClassTypeId(),gateResolve,&subelement);
+            if (!ActiveGate->allow(pObject?pObject->getDocument():temp.pDoc,pObject,subelement)) {
+                ActiveGate->notAllowedReason.clear();
+                continue;
+            }
+        }
 
-        SelectionChanges Chng(SelectionChanges::AddSelection,
-                temp.DocName,temp.FeatName,temp.SubName,temp.TypeName);
+        if(!logDisabled)
+            temp.log(false,clearPreselect);
 
-        FC_LOG("Add Selection "<<Chng.pDocName<<'#'<<Chng.pObjectName<<'.'<<Chng.pSubName);
+        FC_LOG("Add Selection "<<temp.DocName<<'#'<<temp.FeatName<<'.'<<temp.SubName);
 
-        notify(std::move(Chng));
-        update = true;
+        if(std::find(docs.begin(), docs.end(), temp.DocName) == docs.end())
+            docs.push_back(temp.DocName);
+        _SelList.push_back(std::move(temp));
     }
 
-    if(update)
-        getMainWindow()->updateActions();
+    if(docs.empty())
+        return false;
+
+    _SelStackForward.clear();
+
+    if(clearPreselect)
+        rmvPreselect();
+
+    for(auto &doc : docs)
+        notify(SelectionChanges(SelectionChanges::SetSelection, doc));
+
+    getMainWindow()->updateActions();
     return true;
 }
 
@@ -1962,12 +1994,13 @@ PyObject *SelectionSingleton::sAddSelection(PyObject * /*self*/, PyObject *args)
         try {
             if (PyTuple_Check(sequence) || PyList_Check(sequence)) {
                 Py::Sequence list(sequence);
+                std::vector<App::SubObjectT> objs;
+                objs.reserve(list.size());
                 for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
                     std::string subname = static_cast<std::string>(Py::String(*it));
-                    Selection().addSelection(docObj->getDocument()->getName(),
-                                             docObj->getNameInDocument(),
-                                             subname.c_str(),0,0,0,0,PyObject_IsTrue(clearPreselect));
+                    objs.emplace_back(docObj, subname.c_str());
                 }
+                Selection().addSelections(objs, PyObject_IsTrue(clearPreselect));
 
                 Py_Return;
             }
@@ -377,6 +377,16 @@ public:
     bool addSelection(const SelectionObject&, bool clearPreSelect=true);
     /// Add to selection with several sub-elements
     bool addSelections(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames);
+    /** Add several objects or sub-elements to the selection at once
+     *
+     * Instead of one AddSelection message per entry, observers receive a single
+     * SetSelection message for each affected document, and are expected to
+     * query the new selection from there. Entries already selected or rejected by
+     * the active selection gate are skipped.
+     *
+     * @return true if anything has been added to the selection
+     */
+    bool addSelections(const std::vector<App::SubObjectT> &objs, bool clearPreSelect=true);
     /// Update a selection
     bool updateSelection(bool show, const char* pDocName, const char* pObjectName=0, const char* pSubName=0);
     /// Remove from selection (for internal use)
@@ -69,6 +69,7 @@
 #include "Inventor/SmSwitchboard.h"
 #include "SoFCCSysDragger.h"
 #include "SoMouseWheelEvent.h"
+#include "ViewProviderLink.h"
 
 #include "propertyeditor/PropertyItem.h"
 #include "NavigationStyle.h"
@@ -138,6 +139,7 @@ void Gui::SoFCDB::init()
     SmSwitchboard                   ::initClass();
     SoFCSeparator                   ::initClass();
     SoFCSelectionRoot               ::initClass();
+    SoFCLinkElementSwitch           ::initClass();
     SoFCPathAnnotation              ::initClass();
     SoMouseWheelEvent               ::initClass();
 
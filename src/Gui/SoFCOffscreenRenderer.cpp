@@ -43,6 +43,7 @@
 //gcc
 # include <iomanip>
 # include <ios>
+# include <memory>
 # include <sstream>
 
 #include <Base/FileInfo.h>
@@ -414,6 +415,10 @@ void SoQtOffscreenRenderer::init(const SbViewportRegion & vpr,
 
 #if !defined(HAVE_QT5_OPENGL)
     this->pixelbuffer = NULL;                // constructed later
+#else
+    this->glcontext = NULL;                  // constructed later
+    this->offscreen = NULL;
+    this->contextSamples = -1;
 #endif
     this->framebuffer = NULL;
     this->numSamples = -1;
@@ -454,8 +459,16 @@ SoQtOffscreenRenderer::~SoQtOffscreenRenderer()
 {
 #if !defined(HAVE_QT5_OPENGL)
     delete pixelbuffer;
-#endif
     delete framebuffer;
+#else
+    // the framebuffer must be destroyed with its context being current
+    if (glcontext && offscreen && glcontext->makeCurrent(offscreen)) {
+        delete framebuffer;
+        glcontext->doneCurrent();
+    }
+    delete glcontext;
+    delete offscreen;
+#endif
 
     if (this->didallocation) {
         delete this->renderaction;
@@ -625,25 +638,58 @@ SoQtOffscreenRenderer::makeFrameBuffer(int width, int height, int samples)
     fmt.setInternalTextureFormat(this->texFormat);
 
     framebuffer = new QtGLFramebufferObject(width, height, fmt);
+#if !defined(HAVE_QT5_OPENGL)
     cache_context = SoGLCacheContextElement::getUniqueCacheContext(); // unique per pixel buffer object, just to be sure
+#endif
 }
 
+#if defined(HAVE_QT5_OPENGL)
+bool
+SoQtOffscreenRenderer::makeContext(int samples)
+{
+    if (glcontext && contextSamples == samples)
+        return glcontext->makeCurrent(offscreen);
+
+    // The framebuffer belongs to the old context
+    if (glcontext && glcontext->makeCurrent(offscreen)) {
+        delete framebuffer;
+        glcontext->doneCurrent();
+    }
+    framebuffer = NULL;
+    delete glcontext;
+    delete offscreen;
+    glcontext = NULL;
+    offscreen = NULL;
+
+    QSurfaceFormat format;
+    format.setSamples(samples);
+    std::unique_ptr<QOpenGLContext> context(new QOpenGLContext);
+    context->setFormat(format);
+    if (!context->create())
+        return false;
+    std::unique_ptr<QOffscreenSurface> surface(new QOffscreenSurface);
+    surface->setFormat(format);
+    surface->create();
+    if (!context->makeCurrent(surface.get()))
+        return false;
+
+    glcontext = context.release();
+    offscreen = surface.release();
+    contextSamples = samples;
+    // Coin's display lists and textures are per OpenGL context
+    cache_context = SoGLCacheContextElement::getUniqueCacheContext();
+    return true;
+}
+#endif
+
 SbBool
 SoQtOffscreenRenderer::renderFromBase(SoBase * base)
 {
     const SbVec2s fullsize = this->viewport.getViewportSizePixels();
 
 #if defined(HAVE_QT5_OPENGL)
-    QSurfaceFormat format;
-    format.setSamples(PRIVATE(this)->numSamples);
-    QOpenGLContext context;
-    context.setFormat(format);
-    if (!context.create())
+    if (!makeContext(PRIVATE(this)->numSamples))
         return false;
-    QOffscreenSurface offscreen;
-    offscreen.setFormat(format);
-    offscreen.create();
-    context.makeCurrent(&offscreen);
 #endif
 
 #if !defined(HAVE_QT5_OPENGL)
@@ -712,7 +758,7 @@ SoQtOffscreenRenderer::renderFromBase(SoBase * base)
 
 #if defined(HAVE_QT5_OPENGL)
     glImage = framebuffer->toImage();
-    context.doneCurrent();
+    glcontext->doneCurrent();
 #endif
 
     return true;
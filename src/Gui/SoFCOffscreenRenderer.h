@@ -31,6 +31,11 @@
 #include <QStringList>
 #include <QtOpenGL.h>
 
+#if defined(HAVE_QT5_OPENGL)
+class QOpenGLContext;
+class QOffscreenSurface;
+#endif
+
 namespace Gui {
 
 /**
@@ -98,6 +103,13 @@ public:
   std::string createMIBA(const SbMatrix& mat) const;
 };
 
+/**
+ * The SoQtOffscreenRenderer class renders scenes into a Qt framebuffer object.
+ * The OpenGL context and the framebuffer are kept between two calls of render()
+ * so that a single instance can be used to render a series of images without
+ * setting up OpenGL again. The framebuffer is only re-created when the size or
+ * the number of samples changes.
+ */
 class GuiExport SoQtOffscreenRenderer
 {
 public:
@@ -137,9 +149,16 @@ private:
     void makePixelBuffer(int width, int height, int samples);
 #endif
     void makeFrameBuffer(int width, int height, int samples);
+#if defined(HAVE_QT5_OPENGL)
+    bool makeContext(int samples);
+#endif
 
 #if !defined(HAVE_QT5_OPENGL)
     QGLPixelBuffer*         pixelbuffer; // the offscreen rendering supported by Qt
+#else
+    QOpenGLContext*         glcontext;   // kept for the lifetime of the renderer
+    QOffscreenSurface*      offscreen;
+    int                     contextSamples;
 #endif
     QtGLFramebufferObject*  framebuffer;
     uint32_t                cache_context; // our unique context id
@@ -39,6 +39,7 @@
 #include <Inventor/actions/SoHandleEventAction.h>
 #include <Inventor/events/SoKeyboardEvent.h>
 #include <Inventor/elements/SoComplexityElement.h>
+#include <Inventor/elements/SoCullElement.h>
 #include <Inventor/elements/SoComplexityTypeElement.h>
 #include <Inventor/elements/SoCoordinateElement.h>
 #include <Inventor/elements/SoElements.h>
@@ -64,6 +65,7 @@
 #include <Inventor/nodes/SoNormalBinding.h>
 #include <Inventor/events/SoLocation2Event.h>
 #include <Inventor/SoPickedPoint.h>
+#include <Inventor/SbTime.h>
 #include <Inventor/threads/SbStorage.h>
 
 #ifdef FC_OS_MACOSX
@@ -435,18 +437,53 @@ void SoFCUnifiedSelection::doAction(SoAction *action)
             std::vector<ViewProvider*> vps;
             if (this->pcDocument)
                 vps = this->pcDocument->getViewProvidersOfType(ViewProviderDocumentObject::getClassTypeId());
+
+            // Collect the selected sub-elements of each object in one go, so
+            // that a bulk selection change is applied in a single pass.
+            std::map<App::DocumentObject*, std::vector<const char*> > selMap;
+            std::vector<SelectionSingleton::SelObj> sels;
+            if (this->pcDocument)
+                sels = Selection().getSelection(this->pcDocument->getDocument()->getName(), 0);
+            for (auto &sel : sels)
+                selMap[sel.pObject].push_back(sel.SubName);
+
             for (std::vector<ViewProvider*>::iterator it = vps.begin(); it != vps.end(); ++it) {
                 ViewProviderDocumentObject* vpd = static_cast<ViewProviderDocumentObject*>(*it);
                 if (useNewSelection.getValue() || vpd->useNewSelectionModel()) {
-                    SoSelectionElementAction::Type type;
-                    if(Selection().isSelected(vpd->getObject()) && vpd->isSelectable())
-                        type = SoSelectionElementAction::All;
-                    else
-                        type = SoSelectionElementAction::None;
+                    auto iter = selMap.find(vpd->getObject());
+                    bool whole = false;
+                    if (iter != selMap.end() && vpd->isSelectable()) {
+                        for (auto sub : iter->second) {
+                            if (!sub || !sub[0]) {
+                                whole = true;
+                                break;
+                            }
+                        }
+                    }
 
-                    SoSelectionElementAction selectionAction(type);
+                    SoSelectionElementAction selectionAction(whole ?
+                            SoSelectionElementAction::All : SoSelectionElementAction::None);
                     selectionAction.setColor(this->colorSelection.getValue());
                     selectionAction.apply(vpd->getRoot());
+                    if (whole || iter == selMap.end() || !vpd->isSelectable())
+                        continue;
+
+                    for (auto sub : iter->second) {
+                        SoDetail *detail = nullptr;
+                        detailPath->truncate(0);
+                        if (vpd->getDetailPath(sub,detailPath,true,detail)) {
+                            SoSelectionElementAction subAction(detail ?
+                                    SoSelectionElementAction::Append : SoSelectionElementAction::All);
+                            subAction.setColor(this->colorSelection.getValue());
+                            subAction.setElement(detail);
+                            if (detailPath->getLength())
+                                subAction.apply(detailPath);
+                            else
+                                subAction.apply(vpd->getRoot());
+                        }
+                        detailPath->truncate(0);
+                        delete detail;
+                    }
                 }
             }
         }
@@ -1096,6 +1133,9 @@ std::unordered_map<SoAction*,SoFCSelectionRoot::Stack> SoFCSelectionRoot::Action
 SoFCSelectionRoot::ColorStack SoFCSelectionRoot::SelColorStack;
 SoFCSelectionRoot::ColorStack SoFCSelectionRoot::HlColorStack;
 SoFCSelectionRoot* SoFCSelectionRoot::ShapeColorNode;
+View3DInventorViewer::RenderStatistics *SoFCSelectionRoot::RenderStats;
+float SoFCSelectionRoot::MinRenderSize;
+bool SoFCSelectionRoot::HideLines;
 
 SO_NODE_SOURCE(SoFCSelectionRoot)
 
@@ -1228,7 +1268,7 @@ std::pair<bool,SoFCSelectionContextBasePtr*> SoFCSelectionRoot::findActionContex
     return res;
 }
 
-bool SoFCSelectionRoot::renderBBox(SoGLRenderAction *action, SoNode *node, SbColor color)
+static SoFCBBoxRenderInfo *getBBoxRenderInfo()
 {
     auto data = (SoFCBBoxRenderInfo*) so_bbox_storage->get();
     if (data->bboxaction == NULL) {
@@ -1239,6 +1279,12 @@ bool SoFCSelectionRoot::renderBBox(SoGLRenderAction *action, SoNode *node, SbCol
         data->cube->ref();
         data->packer = new SoColorPacker;
     }
+    return data;
+}
+
+bool SoFCSelectionRoot::renderBBox(SoGLRenderAction *action, SoNode *node, SbColor color)
+{
+    auto data = getBBoxRenderInfo();
 
     SbBox3f bbox;
     data->bboxaction->setViewportRegion(action->getViewportRegion());
@@ -1277,9 +1323,74 @@ bool SoFCSelectionRoot::renderBBox(SoGLRenderAction *action, SoNode *node, SbCol
     return true;
 }
 
+void SoFCSelectionRoot::updateCullBox(SoGLRenderAction *action)
+{
+    // The node id changes whenever anything below this node is modified, so
+    // the bounding box is only recomputed for the changed objects.
+    if(cullBoxId != getNodeId()) {
+        auto data = getBBoxRenderInfo();
+        data->bboxaction->setViewportRegion(action->getViewportRegion());
+        data->bboxaction->apply(this);
+        cullBox = data->bboxaction->getBoundingBox();
+        cullBoxId = getNodeId();
+    }
+}
+
+bool SoFCSelectionRoot::cullTest(SoGLRenderAction *action)
+{
+    auto state = action->getState();
+    if(SoCullElement::completelyInside(state))
+        return false;
+
+    updateCullBox(action);
+
+    // Be conservative and never cull anything without a proper bounding box,
+    // e.g. a group relying on the parent for its switch state.
+    if(cullBox.isEmpty())
+        return false;
+    return SoCullElement::cullBox(state, cullBox) ? true : false;
+}
+
+bool SoFCSelectionRoot::sizeTest(SoGLRenderAction *action)
+{
+    updateCullBox(action);
+    if(cullBox.isEmpty())
+        return false;
+
+    auto state = action->getState();
+    SbBox3f box = cullBox;
+    box.transform(SoModelMatrixElement::get(state));
+    const SbViewVolume &vv = SoViewVolumeElement::get(state);
+    // the projection of a box around the eye point is meaningless
+    if(vv.getProjectionType() == SbViewVolume::PERSPECTIVE
+            && box.intersect(vv.getProjectionPoint()))
+        return false;
+
+    SbVec2f size = vv.projectBox(box);
+    SbVec2s pixels = SoViewportRegionElement::get(state).getViewportSizePixels();
+    return size[0]*pixels[0] < MinRenderSize && size[1]*pixels[1] < MinRenderSize;
+}
+
 static std::time_t _CyclicLastReported;
 
 void SoFCSelectionRoot::renderPrivate(SoGLRenderAction * action, bool inPath) {
+    // Skip the whole object if it lies outside of the view frustum. Only done
+    // below path, as the in path traversal may target some of our children.
+    if(!inPath && ViewParams::instance()->getRenderCulling() && cullTest(action)) {
+        if(RenderStats)
+            ++RenderStats->culled;
+        return;
+    }
+
+    // Skip objects too small to be seen while the camera is moving. The frame
+    // must not end up in a render cache of a parent.
+    if(!inPath && MinRenderSize > 0.0f && sizeTest(action)) {
+        SoCacheElement::invalidate(action->getState());
+        if(RenderStats)
+            ++RenderStats->culled;
+        return;
+    }
+
     if(ViewParams::instance()->getCoinCycleCheck()
             && !SelStack.nodeSet.insert(this).second)
     {
@@ -1290,6 +1401,12 @@ void SoFCSelectionRoot::renderPrivate(SoGLRenderAction * action, bool inPath) {
         }
         return;
     }
+    // Only time the top level roots, i.e. the view provider of each object
+    bool timing = RenderStats && SelStack.empty();
+    double start = timing ? SbTime::getTimeOfDay().getValue() : 0.0;
+    if(RenderStats)
+        ++RenderStats->rendered;
+
     SelStack.push_back(this);
     if(_renderPrivate(action,inPath)) {
         if(inPath)
@@ -1299,6 +1416,12 @@ void SoFCSelectionRoot::renderPrivate(SoGLRenderAction * action, bool inPath) {
     }
     SelStack.pop_back();
     SelStack.nodeSet.erase(this);
+
+    if(timing) {
+        auto &stat = RenderStats->objects[this];
+        stat.time += SbTime::getTimeOfDay().getValue() - start;
+        ++stat.count;
+    }
 }
 
 bool SoFCSelectionRoot::_renderPrivate(SoGLRenderAction * action, bool inPath) {
@@ -324,11 +324,33 @@ public:
 
     static bool renderBBox(SoGLRenderAction *action, SoNode *node, SbColor color);
 
+    /// Set the collector of render statistics for the current render pass
+    static void setRenderStatistics(View3DInventorViewer::RenderStatistics *stats) {
+        RenderStats = stats;
+    }
+
+    /** Set the reduced quality of the current render pass while the camera is moving.
+     * Objects with a projected size below \a minSize pixels are skipped, 0 disables it.
+     * With \a hideLines the line and point sets of the objects are asked to skip
+     * rendering, see isHidingLines().
+     */
+    static void setInteractiveReduction(float minSize, bool hideLines) {
+        MinRenderSize = minSize;
+        HideLines = hideLines;
+    }
+    /// Returns true if lines and points shall be skipped in the current render pass
+    static bool isHidingLines() {
+        return HideLines;
+    }
+
 protected:
     virtual ~SoFCSelectionRoot();
 
     void renderPrivate(SoGLRenderAction *, bool inPath);
     bool _renderPrivate(SoGLRenderAction *, bool inPath);
+    bool cullTest(SoGLRenderAction *);
+    bool sizeTest(SoGLRenderAction *);
+    void updateCullBox(SoGLRenderAction *);
 
     class Stack : public std::vector<SoFCSelectionRoot*> {
     public:
@@ -367,11 +389,19 @@ protected:
     static ColorStack SelColorStack;
     static ColorStack HlColorStack;
     static SoFCSelectionRoot *ShapeColorNode;
+    static View3DInventorViewer::RenderStatistics *RenderStats;
+    static float MinRenderSize;
+    static bool HideLines;
     bool overrideColor = false;
     SbColor colorOverride;
     float transOverride = 0.0f;
     SoColorPacker shapeColorPacker;
 
+    // Local bounding box used for frustum culling, valid as long as the node
+    // id matches cullBoxId.
+    SbBox3f cullBox;
+    SbUniqueId cullBoxId = 0;
+
     bool doActionPrivate(Stack &stack, SoAction *);
 };
 
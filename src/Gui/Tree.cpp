@@ -2574,6 +2574,21 @@ void TreeWidget::onItemExpanded(QTreeWidgetItem * item)
         objItem->setExpandedStatus(true);
         objItem->getOwnerDocument()->populateItem(objItem,false,false);
     }
+    if (item && TreeParams::Instance()->LazyStatusUpdate())
+        testExposedStatus(item);
+}
+
+void TreeWidget::testExposedStatus(QTreeWidgetItem *item)
+{
+    // Refresh the status of the items whose update was deferred while hidden
+    // inside a collapsed parent. See DocumentObjectItem::testStatus().
+    for(int i=0,count=item->childCount();i<count;++i) {
+        auto child = item->child(i);
+        if(child->type() == TreeWidget::ObjectType)
+            static_cast<DocumentObjectItem*>(child)->testStatus(false);
+        if(child->isExpanded())
+            testExposedStatus(child);
+    }
 }
 
 void TreeWidget::scrollItemToTop()
@@ -4523,6 +4538,14 @@ void DocumentObjectItem::testStatus(bool resetStatus)
 
 void DocumentObjectItem::testStatus(bool resetStatus, QIcon &icon1, QIcon &icon2)
 {
+    if (TreeParams::Instance()->LazyStatusUpdate() && !isExposed()) {
+        // Defer the status check until the item is exposed by expanding its
+        // parent. This saves the walk over all objects of a large document
+        // on every status update. Reset previousStatus to force a refresh.
+        previousStatus = -1;
+        return;
+    }
+
     App::DocumentObject* pObject = object()->getObject();
 
     int visible = -1;
@@ -4769,6 +4792,14 @@ bool DocumentObjectItem::isChildOfItem(DocumentObjectItem* item)
     return false;
 }
 
+bool DocumentObjectItem::isExposed() const
+{
+    for(auto pitem=parent();pitem;pitem=pitem->parent())
+        if(!pitem->isExpanded())
+            return false;
+    return true;
+}
+
 bool DocumentObjectItem::requiredAtRoot(bool excludeSelf) const{
     if(myData->rootItem || object()->getDocument()!=getOwnerDocument()->document())
         return false;
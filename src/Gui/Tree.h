@@ -208,6 +208,8 @@ private:
     void updateChildren(App::DocumentObject *obj,
             const std::set<DocumentObjectDataPtr> &data, bool output, bool force);
 
+    static void testExposedStatus(QTreeWidgetItem *item);
+
 private:
     QAction* createGroupAction;
     QAction* relabelObjectAction;
@@ -394,6 +396,8 @@ public:
     void setExpandedStatus(bool);
     void setData(int column, int role, const QVariant & value);
     bool isChildOfItem(DocumentObjectItem*);
+    // Check if all parent items are expanded, i.e. this item can be seen
+    bool isExposed() const;
 
     void restoreBackground();
 
@@ -540,6 +544,7 @@ public:
     FC_TREEPARAM_DEF(KeepRootOrder,bool,Bool,true) \
     FC_TREEPARAM_DEF(TreeActiveAutoExpand,bool,Bool,true) \
     FC_TREEPARAM_DEF(Indentation,int,Int,0) \
+    FC_TREEPARAM_DEF(LazyStatusUpdate,bool,Bool,true) \
 
 #undef FC_TREEPARAM_DEF
 #define FC_TREEPARAM_DEF(_name,_type,_Type,_default) \
@@ -89,6 +89,7 @@
 #endif
 
 #include <Inventor/SoEventManager.h>
+#include <Inventor/SbTime.h>
 
 #if !defined(FC_OS_MACOSX)
 # include <GL/gl.h>
@@ -102,6 +103,7 @@
 #include <Base/Console.h>
 #include <Base/Stream.h>
 #include <Base/FileInfo.h>
+#include <Base/Profiler.h>
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 #include <Base/UnitsApi.h>
@@ -720,6 +722,16 @@ void View3DInventorViewer::checkGroupOnTop(const SelectionChanges &Reason) {
         clearGroupOnTop();
         if(Reason.Type == SelectionChanges::ClrSelection)
             return;
+        // A bulk selection change, re-add whatever of the new selection
+        // belongs on top.
+        if(getDocument() && Reason.pDocName
+                && strcmp(Reason.pDocName, getDocument()->getDocument()->getName())==0) {
+            for(auto &sel : Selection().getSelection(Reason.pDocName, 0)) {
+                checkGroupOnTop(SelectionChanges(SelectionChanges::AddSelection,
+                            sel.DocName, sel.FeatName, sel.SubName));
+            }
+        }
+        return;
     }
     if(Reason.Type == SelectionChanges::RmvPreselect ||
        Reason.Type == SelectionChanges::RmvPreselectSignal)
@@ -998,6 +1010,8 @@ void View3DInventorViewer::removeViewProvider(ViewProvider* pcProvider)
         if(index>=0)
             pcViewProviderRoot->removeChild(index);
         _ViewProviderMap.erase(root);
+        if (renderStats)
+            renderStats->objects.erase(root);
     }
 
     SoSeparator* fore = pcProvider->getFrontRoot();
@@ -1350,6 +1364,56 @@ void View3DInventorViewer::setEnabledFPSCounter(bool on)
     fpsEnabled = on;
 }
 
+void View3DInventorViewer::setRenderStatistics(bool on)
+{
+    if (on == isRenderStatistics())
+        return;
+    if (on)
+        renderStats.reset(new RenderStatistics);
+    else
+        renderStats.reset();
+    getSoRenderManager()->scheduleRedraw();
+}
+
+bool View3DInventorViewer::isRenderStatistics() const
+{
+    return renderStats != nullptr;
+}
+
+void View3DInventorViewer::resetRenderStatistics()
+{
+    if (renderStats)
+        *renderStats = RenderStatistics();
+}
+
+const View3DInventorViewer::RenderStatistics *View3DInventorViewer::getRenderStatistics() const
+{
+    return renderStats.get();
+}
+
+std::vector<std::pair<ViewProvider*, View3DInventorViewer::RenderStatistics::ObjectStat> >
+View3DInventorViewer::getRenderCost(int count) const
+{
+    std::vector<std::pair<ViewProvider*, RenderStatistics::ObjectStat> > res;
+    if (!renderStats)
+        return res;
+
+    // Objects removed in the meantime are simply not found in the map
+    for (auto &v : renderStats->objects) {
+        auto it = _ViewProviderMap.find(v.first);
+        if (it != _ViewProviderMap.end())
+            res.emplace_back(it->second, v.second);
+    }
+    std::sort(res.begin(), res.end(),
+        [](const std::pair<ViewProvider*, RenderStatistics::ObjectStat> &a,
+           const std::pair<ViewProvider*, RenderStatistics::ObjectStat> &b) {
+            return a.second.time > b.second.time;
+        });
+    if (count >= 0 && (int)res.size() > count)
+        res.resize(count);
+    return res;
+}
+
 void View3DInventorViewer::setEnabledVBO(bool on)
 {
     vboEnabled = on;
@@ -1643,12 +1707,18 @@ void View3DInventorViewer::savePicture(int w, int h, int s, const QColor& bg, QI
     try {
         // render the scene
         if (!useCoinOffscreenRenderer) {
-            SoQtOffscreenRenderer renderer(vp);
+            View3DInventorViewer* self = const_cast<View3DInventorViewer*>(this);
+            if (!self->offscreenRenderer)
+                self->offscreenRenderer.reset(new SoQtOffscreenRenderer(vp));
+            SoQtOffscreenRenderer& renderer = *self->offscreenRenderer;
+            renderer.setViewportRegion(vp);
             renderer.setNumPasses(s);
             renderer.setInternalTextureFormat(getInternalTextureFormat());
             renderer.setPbufferEnable(usePixelBuffer);
             if (bgColor.isValid())
                 renderer.setBackgroundColor(SbColor4f(bgColor.redF(), bgColor.greenF(), bgColor.blueF(), bgColor.alphaF()));
+            else
+                renderer.setBackgroundColor(SbColor4f(0.0f, 0.0f, 0.0f, 1.0f));
             if (!renderer.render(root))
                 throw Base::RuntimeError("Offscreen rendering failed");
 
@@ -1900,6 +1970,10 @@ void View3DInventorViewer::interactionStartCB(void*, SoQTQuarterAdaptor* viewer)
 {
     SoGLRenderAction* glra = viewer->getSoRenderManager()->getGLRenderAction();
     SoFCInteractiveElement::set(glra->getState(), viewer->getSceneGraph(), true);
+
+    View3DInventorViewer* view = static_cast<View3DInventorViewer*>(viewer);
+    view->interacting = true;
+    view->interactiveLevel = 0;
 }
 
 /**
@@ -1909,6 +1983,11 @@ void View3DInventorViewer::interactionFinishCB(void*, SoQTQuarterAdaptor* viewer
 {
     SoGLRenderAction* glra = viewer->getSoRenderManager()->getGLRenderAction();
     SoFCInteractiveElement::set(glra->getState(), viewer->getSceneGraph(), false);
+
+    // the next frame is rendered in full quality again
+    View3DInventorViewer* view = static_cast<View3DInventorViewer*>(viewer);
+    view->interacting = false;
+    view->interactiveLevel = 0;
     viewer->redraw();
 }
 
@@ -2237,8 +2316,46 @@ void View3DInventorViewer::renderToFramebuffer(QtGLFramebufferObject* fbo)
     fbo->release();
 }
 
+void View3DInventorViewer::beginUpdateBatch()
+{
+    if (updateBatch++ == 0) {
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/View");
+        batchRedrawInterval = hGrp->GetInt("UpdateBatchRedrawInterval", 500) / 1000.0;
+        batchLastRender = SbTime::getTimeOfDay().getValue();
+        batchRedrawPending = false;
+    }
+}
+
+void View3DInventorViewer::endUpdateBatch()
+{
+    if (updateBatch == 0 || --updateBatch > 0)
+        return;
+
+    if (batchRedrawPending) {
+        batchRedrawPending = false;
+        redraw();
+    }
+}
+
+bool View3DInventorViewer::isUpdateBatch() const
+{
+    return updateBatch > 0;
+}
+
 void View3DInventorViewer::actualRedraw()
 {
+    FC_PROFILE_ZONE("View3DInventorViewer::actualRedraw");
+    if (updateBatch > 0) {
+        // keep the last frame and render once when the batch ends
+        double now = SbTime::getTimeOfDay().getValue();
+        if (batchRedrawInterval <= 0.0 || now - batchLastRender < batchRedrawInterval) {
+            batchRedrawPending = true;
+            return;
+        }
+        batchLastRender = now;
+    }
+
     switch (renderType) {
     case Native:
         renderScene();
@@ -2339,6 +2456,7 @@ void View3DInventorViewer::renderGLImage()
 // upon spin.
 void View3DInventorViewer::renderScene(void)
 {
+    FC_PROFILE_ZONE("View3DInventorViewer::renderScene");
     // Must set up the OpenGL viewport manually, as upon resize
     // operations, Coin won't set it up until the SoGLRenderAction is
     // applied again. And since we need to do glClear() before applying
@@ -2374,6 +2492,33 @@ void View3DInventorViewer::renderScene(void)
         SoOverrideElement::setLightModelOverride(state, selectionRoot, true);
     }
 
+    // Let the object roots report their render cost
+    struct StatisticsGuard {
+        StatisticsGuard(RenderStatistics *stats) {
+            SoFCSelectionRoot::setRenderStatistics(stats);
+        }
+        ~StatisticsGuard() {
+            SoFCSelectionRoot::setRenderStatistics(nullptr);
+        }
+    } statsGuard(renderStats.get());
+
+    // While the camera moves the quality is reduced step by step as long as a
+    // frame takes longer than the target time: first small objects are skipped,
+    // then lines and points.
+    bool reduce = interacting && ViewParams::instance()->getInteractiveRendering();
+    struct ReductionGuard {
+        ReductionGuard(int level) {
+            auto params = ViewParams::instance();
+            SoFCSelectionRoot::setInteractiveReduction(
+                    level >= 1 ? static_cast<float>(params->getInteractiveMinPixelSize()) : 0.0f,
+                    level >= 2 && params->getInteractiveHideLines());
+        }
+        ~ReductionGuard() {
+            SoFCSelectionRoot::setInteractiveReduction(0.0f, false);
+        }
+    } reductionGuard(reduce ? interactiveLevel : 0);
+    double renderStart = (renderStats || reduce) ? SbTime::getTimeOfDay().getValue() : 0.0;
+
     try {
         // Render normal scenegraph.
         inherited::actualRedraw();
@@ -2388,6 +2533,22 @@ void View3DInventorViewer::renderScene(void)
                              QObject::tr("Not enough memory available to display the data."));
     }
 
+    if (renderStats) {
+        // GL calls are asynchronous. Wait for the pipeline so that the time
+        // spent by the GL is not attributed to the next frame.
+        double traversed = SbTime::getTimeOfDay().getValue();
+        glFinish();
+        renderStats->traversalTime += traversed - renderStart;
+        renderStats->finishTime += SbTime::getTimeOfDay().getValue() - traversed;
+        ++renderStats->frames;
+    }
+
+    if (reduce && interactiveLevel < 2) {
+        double frameTime = SbTime::getTimeOfDay().getValue() - renderStart;
+        if (frameTime * 1000.0 > ViewParams::instance()->getInteractiveFrameTime())
+            ++interactiveLevel;
+    }
+
     if (!this->shading) {
         state->pop();
     }
@@ -2434,6 +2595,36 @@ void View3DInventorViewer::renderScene(void)
         draw2DString(stream.str().c_str(), SbVec2s(10,10), SbVec2f(0.1f,0.1f));
     }
 
+    if (renderStats && renderStats->frames) {
+        double frames = renderStats->frames;
+        std::vector<std::string> lines;
+        std::stringstream stream;
+        stream.precision(2);
+        stream.setf(std::ios::fixed | std::ios::showpoint);
+        stream << "traversal " << renderStats->traversalTime * 1000.0 / frames
+               << " ms, GL " << renderStats->finishTime * 1000.0 / frames << " ms";
+        lines.push_back(stream.str());
+        stream.str("");
+        stream << "objects " << renderStats->rendered / frames
+               << ", culled " << renderStats->culled / frames;
+        lines.push_back(stream.str());
+        for (auto &v : getRenderCost(5)) {
+            stream.str("");
+            auto vpd = Base::freecad_dynamic_cast<ViewProviderDocumentObject>(v.first);
+            if (vpd && vpd->getObject())
+                stream << vpd->getObject()->Label.getValue();
+            else
+                stream << v.first->getTypeId().getName();
+            stream << " " << v.second.time * 1000.0 / v.second.count << " ms";
+            lines.push_back(stream.str());
+        }
+
+        // Draw bottom up above the fps counter
+        int y = 30;
+        for (auto it = lines.rbegin(); it != lines.rend(); ++it, y += 15)
+            draw2DString(it->c_str(), size, SbVec2f(10.0f, (float)y));
+    }
+
     if (naviCubeEnabled)
         naviCube->drawNaviCube();
 
@@ -26,6 +26,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -71,6 +72,7 @@ class Document;
 class GLGraphicsItem;
 class SoShapeScale;
 class ViewerEventFilter;
+class SoQtOffscreenRenderer;
 
 /** GUI view into a 3D scene provided by View3DInventor
  *
@@ -368,6 +370,37 @@ public:
     bool hasAxisCross(void);
 
     void setEnabledFPSCounter(bool b);
+
+    /// Render statistics accumulated since enabling or the last reset
+    struct RenderStatistics {
+        unsigned long frames = 0;
+        /// Time in seconds spent traversing the scene graph
+        double traversalTime = 0.0;
+        /// Time in seconds waiting for the GL pipeline to finish the frame
+        double finishTime = 0.0;
+        /// Number of rendered object roots, including nested ones (e.g. links)
+        unsigned long rendered = 0;
+        /// Number of object roots skipped by frustum culling
+        unsigned long culled = 0;
+        struct ObjectStat {
+            double time = 0.0;
+            unsigned long count = 0;
+        };
+        /// Traversal time of the top level object roots
+        std::map<SoSeparator*, ObjectStat> objects;
+    };
+    /** Enables collecting render statistics and shows them as an overlay.
+     * Enabling it forces a glFinish() after each frame to separate the
+     * traversal from the GL time, so it slightly slows down the rendering.
+     */
+    void setRenderStatistics(bool on);
+    bool isRenderStatistics() const;
+    void resetRenderStatistics();
+    /// Returns null if not enabled
+    const RenderStatistics *getRenderStatistics() const;
+    /// Returns the \a count view providers with the highest render cost
+    std::vector<std::pair<ViewProvider*, RenderStatistics::ObjectStat> >
+        getRenderCost(int count) const;
     void setEnabledNaviCube(bool b);
     bool isEnabledNaviCube(void) const;
     void setNaviCubeCorner(int);
@@ -376,6 +409,18 @@ public:
     bool isEnabledVBO() const;
     void setRenderCache(int);
 
+    /** @name Update batches
+     * While a batch is active scheduled redraws don't render the scene, at most one frame
+     * is rendered per interval (parameter View/UpdateBatchRedrawInterval in ms, 0 renders
+     * nothing until the end). When the outermost batch ends the scene is redrawn once if a
+     * redraw was requested in the meantime. Batches can be nested.
+     */
+    //@{
+    void beginUpdateBatch();
+    void endUpdateBatch();
+    bool isUpdateBatch() const;
+    //@}
+
     NavigationStyle* navigationStyle() const;
 
     void setDocument(Gui::Document *pcDocument);
@@ -464,6 +509,16 @@ private:
 
     //stuff needed to draw the fps counter
     bool fpsEnabled;
+    std::unique_ptr<RenderStatistics> renderStats;
+    // quality reduction while the camera is moving, raised when frames are too slow
+    bool interacting = false;
+    int interactiveLevel = 0;
+    int updateBatch = 0;
+    bool batchRedrawPending = false;
+    double batchRedrawInterval = 0.0;
+    double batchLastRender = 0.0;
+    /// reused by savePicture() to keep the offscreen context and buffers
+    std::unique_ptr<SoQtOffscreenRenderer> offscreenRenderer;
     bool vboEnabled;
     SbBool naviCubeEnabled;
 
@@ -115,6 +115,14 @@ void View3DInventorPy::init_type()
     add_varargs_method("stopAnimating",&View3DInventorPy::stopAnimating,"stopAnimating()");
     add_varargs_method("setAnimationEnabled",&View3DInventorPy::setAnimationEnabled,"setAnimationEnabled()");
     add_varargs_method("isAnimationEnabled",&View3DInventorPy::isAnimationEnabled,"isAnimationEnabled()");
+    add_varargs_method("setRenderStatistics",&View3DInventorPy::setRenderStatistics,
+        "setRenderStatistics(bool) -- Enables collecting render statistics and shows them as overlay");
+    add_varargs_method("getRenderStatistics",&View3DInventorPy::getRenderStatistics,
+        "getRenderStatistics(count=10) -> dict or None\n"
+        "Returns the render statistics accumulated since enabling or the last reset,\n"
+        "including the 'count' objects with the highest render cost");
+    add_varargs_method("resetRenderStatistics",&View3DInventorPy::resetRenderStatistics,
+        "resetRenderStatistics() -- Resets the accumulated render statistics");
     add_varargs_method("dump",&View3DInventorPy::dump,"dump(filename, [onlyVisible=False])");
     add_varargs_method("dumpNode",&View3DInventorPy::dumpNode,"dumpNode(node)");
     add_varargs_method("setStereoType",&View3DInventorPy::setStereoType,"setStereoType()");
@@ -953,6 +961,65 @@ Py::Object View3DInventorPy::isAnimationEnabled(const Py::Tuple& args)
     return Py::Boolean(ok ? true : false);
 }
 
+Py::Object View3DInventorPy::setRenderStatistics(const Py::Tuple& args)
+{
+    PyObject *on;
+    if (!PyArg_ParseTuple(args.ptr(), "O!", &PyBool_Type, &on))
+        throw Py::Exception();
+    _view->getViewer()->setRenderStatistics(PyObject_IsTrue(on) ? true : false);
+    return Py::None();
+}
+
+Py::Object View3DInventorPy::getRenderStatistics(const Py::Tuple& args)
+{
+    int count = 10;
+    if (!PyArg_ParseTuple(args.ptr(), "|i", &count))
+        throw Py::Exception();
+
+    View3DInventorViewer *viewer = _view->getViewer();
+    auto stats = viewer->getRenderStatistics();
+    if (!stats)
+        return Py::None();
+
+    Py::Dict dict;
+    double frames = stats->frames ? stats->frames : 1;
+    dict.setItem("Frames", Py::Long((long)stats->frames));
+    dict.setItem("TraversalTime", Py::Float(stats->traversalTime / frames));
+    dict.setItem("GLTime", Py::Float(stats->finishTime / frames));
+    dict.setItem("Rendered", Py::Float(stats->rendered / frames));
+    dict.setItem("Culled", Py::Float(stats->culled / frames));
+
+    // Primitive count of the whole scene, regardless of culling
+    SoGetPrimitiveCountAction action(viewer->getSoRenderManager()->getViewportRegion());
+    action.apply(viewer->getSoRenderManager()->getSceneGraph());
+    dict.setItem("Triangles", Py::Long((long)action.getTriangleCount()));
+    dict.setItem("Lines", Py::Long((long)action.getLineCount()));
+    dict.setItem("Points", Py::Long((long)action.getPointCount()));
+
+    Py::List list;
+    for (auto &v : viewer->getRenderCost(count)) {
+        Py::Tuple tuple(3);
+        auto vpd = Base::freecad_dynamic_cast<ViewProviderDocumentObject>(v.first);
+        if (vpd && vpd->getObject())
+            tuple.setItem(0, Py::asObject(vpd->getObject()->getPyObject()));
+        else
+            tuple.setItem(0, Py::String(v.first->getTypeId().getName()));
+        tuple.setItem(1, Py::Float(v.second.time));
+        tuple.setItem(2, Py::Long((long)v.second.count));
+        list.append(tuple);
+    }
+    dict.setItem("Objects", list);
+    return dict;
+}
+
+Py::Object View3DInventorPy::resetRenderStatistics(const Py::Tuple& args)
+{
+    if (!PyArg_ParseTuple(args.ptr(), ""))
+        throw Py::Exception();
+    _view->getViewer()->resetRenderStatistics();
+    return Py::None();
+}
+
 Py::Object View3DInventorPy::saveImage(const Py::Tuple& args)
 {
     char *cFileName,*cColor="Current",*cComment="$MIBA";
@@ -87,6 +87,9 @@ public:
     Py::Object stopAnimating(const Py::Tuple&);
     Py::Object setAnimationEnabled(const Py::Tuple&);
     Py::Object isAnimationEnabled(const Py::Tuple&);
+    Py::Object setRenderStatistics(const Py::Tuple&);
+    Py::Object getRenderStatistics(const Py::Tuple&);
+    Py::Object resetRenderStatistics(const Py::Tuple&);
     Py::Object dump(const Py::Tuple&);
     Py::Object dumpNode(const Py::Tuple&);
     Py::Object setStereoType(const Py::Tuple&);
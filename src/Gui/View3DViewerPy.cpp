@@ -97,6 +97,13 @@ void View3DInventorViewerPy::init_type()
     add_varargs_method("setNaviCubeCorner", &View3DInventorViewerPy::setNaviCubeCorner,
         "setNaviCubeCorner(int): sets the corner where to show the navi cube:\n"
         "0=top left, 1=top right, 2=bottom left, 3=bottom right");
+    add_varargs_method("beginUpdateBatch", &View3DInventorViewerPy::beginUpdateBatch,
+        "beginUpdateBatch(): suspends rendering of scheduled redraws until endUpdateBatch() is called.\n"
+        "Calls can be nested, the scene is redrawn once when the outermost batch ends.");
+    add_varargs_method("endUpdateBatch", &View3DInventorViewerPy::endUpdateBatch,
+        "endUpdateBatch(): ends a batch started with beginUpdateBatch().");
+    add_varargs_method("isUpdateBatch", &View3DInventorViewerPy::isUpdateBatch,
+        "isUpdateBatch() -> bool: check whether an update batch is active.");
 }
 
 View3DInventorViewerPy::View3DInventorViewerPy(View3DInventorViewer *vi)
@@ -494,3 +501,27 @@ Py::Object View3DInventorViewerPy::setNaviCubeCorner(const Py::Tuple& args)
     _viewer->setNaviCubeCorner(pos);
     return Py::None();
 }
+
+Py::Object View3DInventorViewerPy::beginUpdateBatch(const Py::Tuple& args)
+{
+    if (!PyArg_ParseTuple(args.ptr(), ""))
+        throw Py::Exception();
+    _viewer->beginUpdateBatch();
+    return Py::None();
+}
+
+Py::Object View3DInventorViewerPy::endUpdateBatch(const Py::Tuple& args)
+{
+    if (!PyArg_ParseTuple(args.ptr(), ""))
+        throw Py::Exception();
+    _viewer->endUpdateBatch();
+    return Py::None();
+}
+
+Py::Object View3DInventorViewerPy::isUpdateBatch(const Py::Tuple& args)
+{
+    if (!PyArg_ParseTuple(args.ptr(), ""))
+        throw Py::Exception();
+    bool ok = _viewer->isUpdateBatch();
+    return Py::Boolean(ok);
+}
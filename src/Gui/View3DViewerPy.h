@@ -77,6 +77,11 @@ public:
     Py::Object isEnabledNaviCube(const Py::Tuple& args);
     Py::Object setNaviCubeCorner(const Py::Tuple& args);
 
+    // Update batches
+    Py::Object beginUpdateBatch(const Py::Tuple& args);
+    Py::Object endUpdateBatch(const Py::Tuple& args);
+    Py::Object isUpdateBatch(const Py::Tuple& args);
+
 
 private:
     typedef PyObject* (*method_varargs_handler)(PyObject *_self, PyObject *_args);
@@ -50,6 +50,7 @@ public:
     FC_VIEW_PARAM(RenderCache,int,Int,0) \
     FC_VIEW_PARAM(RandomColor,bool,Bool,false) \
     FC_VIEW_PARAM(BoundingBoxColor,unsigned long,Unsigned,4294967295UL) \
+    FC_VIEW_PARAM(BoundingBoxFontSize,double,Float,10.0) \
     FC_VIEW_PARAM(AnnotationTextColor,unsigned long,Unsigned,4294967295UL) \
     FC_VIEW_PARAM(MarkerSize,int,Int,9) \
     FC_VIEW_PARAM(DefaultLinkColor,unsigned long,Unsigned,0x66FFFF00) \
@@ -60,6 +61,12 @@ public:
     FC_VIEW_PARAM(CoinCycleCheck,bool,Bool,true) \
     FC_VIEW_PARAM(EnablePropertyViewForInactiveDocument,bool,Bool,true) \
     FC_VIEW_PARAM(ShowSelectionBoundingBox,bool,Bool,false) \
+    FC_VIEW_PARAM(LinkArrayInstancing,bool,Bool,false) \
+    FC_VIEW_PARAM(RenderCulling,bool,Bool,false) \
+    FC_VIEW_PARAM(InteractiveRendering,bool,Bool,false) \
+    FC_VIEW_PARAM(InteractiveFrameTime,int,Int,40) \
+    FC_VIEW_PARAM(InteractiveMinPixelSize,double,Float,4.0) \
+    FC_VIEW_PARAM(InteractiveHideLines,bool,Bool,true) \
 
 #undef FC_VIEW_PARAM
 #define FC_VIEW_PARAM(_name,_ctype,_type,_def) \
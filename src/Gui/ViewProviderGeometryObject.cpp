@@ -65,6 +65,7 @@
 #endif
 #include "SoFCUnifiedSelection.h"
 #include "SoFCCSysDragger.h"
+#include "ViewParams.h"
 #include "Control.h"
 #include "TaskCSysDragger.h"
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -79,8 +80,7 @@ ViewProviderGeometryObject::ViewProviderGeometryObject()
     : pcBoundSwitch(0)
     , pcBoundColor(0)
 {
-    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/View");
-    bool randomColor = hGrp->GetBool("RandomColor", false);
+    bool randomColor = ViewParams::instance()->getRandomColor();
     float r,g,b;
 
     if (randomColor){
@@ -90,7 +90,7 @@ ViewProviderGeometryObject::ViewProviderGeometryObject()
         b = (float)rand()/fMax;
     }
     else {
-        unsigned long shcol = hGrp->GetUnsigned("DefaultShapeColor",3435973887UL); // light gray (204,204,204)
+        unsigned long shcol = ViewParams::instance()->getDefaultShapeColor(); // light gray (204,204,204)
         r = ((shcol >> 24) & 0xff) / 255.0;
         g = ((shcol >> 16) & 0xff) / 255.0;
         b = ((shcol >> 8) & 0xff) / 255.0;
@@ -108,7 +108,7 @@ ViewProviderGeometryObject::ViewProviderGeometryObject()
     ADD_PROPERTY_TYPE(BoundingBox, (false), dogroup, App::Prop_None, "Display object bounding box");
     ADD_PROPERTY_TYPE(Selectable, (true), sgroup, App::Prop_None, "Set if the object is selectable in the 3d view");
 
-    bool enableSel = hGrp->GetBool("EnableSelection", true);
+    bool enableSel = ViewParams::instance()->getEnableSelection();
     Selectable.setValue(enableSel);
 
     pcShapeMaterial = new SoMaterial;
@@ -246,16 +246,13 @@ SoPickedPoint* ViewProviderGeometryObject::getPickedPoint(const SbVec2s& pos, co
 
 unsigned long ViewProviderGeometryObject::getBoundColor() const
 {
-    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/View");
-    unsigned long bbcol = hGrp->GetUnsigned("BoundingBoxColor",4294967295UL); // white (255,255,255)
-    return bbcol;
+    return ViewParams::instance()->getBoundingBoxColor(); // white (255,255,255)
 }
 
 namespace {
 float getBoundBoxFontSize()
 {
-    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/View");
-    return hGrp->GetFloat("BoundingBoxFontSize", 10.0);
+    return ViewParams::instance()->getBoundingBoxFontSize();
 }
 }
 
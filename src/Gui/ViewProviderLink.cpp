@@ -40,6 +40,9 @@
 # include <Inventor/nodes/SoSurroundScale.h>
 # include <Inventor/nodes/SoCube.h>
 # include <Inventor/sensors/SoNodeSensor.h>
+# include <Inventor/nodes/SoCallback.h>
+# include <Inventor/actions/SoGLRenderAction.h>
+# include <Inventor/elements/SoModelMatrixElement.h>
 #endif
 #include <cctype>
 #include <atomic>
@@ -824,7 +827,9 @@ public:
     Element(LinkView &handle):handle(handle) {
         pcTransform = new SoTransform;
         pcRoot = new SoFCSelectionRoot(true);
-        pcSwitch = new SoSwitch;
+        auto pcElementSwitch = new SoFCLinkElementSwitch;
+        pcElementSwitch->instances = handle.instances;
+        pcSwitch = pcElementSwitch;
         pcSwitch->addChild(pcRoot);
         pcSwitch->whichChild = 0;
     }
@@ -862,6 +867,103 @@ public:
     }
 };
 
+//////////////////////////////////////////////////////////////////////////////////
+
+/* Direct rendering of link arrays
+ *
+ * A link array with ElementCount > 1 normally renders each element through
+ * its own switch, selection root and transform, which means the whole
+ * selection context machinery runs once per element. When nothing but plain
+ * geometry is involved, LinkView instead renders the shared linked root once
+ * per element transform from a callback node placed in front of the element
+ * switches, and the switches then skip their own rendering.
+ */
+class Gui::LinkInstances {
+public:
+    LinkView &handle;
+    CoinPtr<SoCallback> pcCallback;
+    SoFCSelectionCounter selCounter;
+    bool hasSecondary = false;
+    SoAction *renderAction = nullptr;
+    int pending = 0;
+
+    LinkInstances(LinkView &handle):handle(handle) {
+        pcCallback = new SoCallback;
+        pcCallback->setCallback(render,this);
+    }
+
+    // The element switches may outlive the LinkView
+    void detach() {
+        pcCallback->setCallback(nullptr,nullptr);
+        renderAction = nullptr;
+        pending = 0;
+    }
+
+    static void render(void *data, SoAction *action) {
+        auto self = static_cast<LinkInstances*>(data);
+        if(!action->isOfType(SoGLRenderAction::getClassTypeId()))
+            return;
+        self->renderAction = nullptr;
+        self->pending = 0;
+        if(self->handle.renderInstances(static_cast<SoGLRenderAction*>(action))) {
+            self->renderAction = action;
+            self->pending = (int)self->handle.nodeArray.size();
+        }
+    }
+
+    bool skip(SoAction *action) {
+        if(action!=renderAction
+                || pending<=0
+                || action->getCurPathCode()==SoAction::IN_PATH)
+            return false;
+        --pending;
+        return true;
+    }
+};
+
+SO_NODE_SOURCE(SoFCLinkElementSwitch)
+
+SoFCLinkElementSwitch::SoFCLinkElementSwitch()
+{
+    SO_NODE_CONSTRUCTOR(SoFCLinkElementSwitch);
+}
+
+SoFCLinkElementSwitch::~SoFCLinkElementSwitch()
+{
+}
+
+void SoFCLinkElementSwitch::initClass(void)
+{
+    SO_NODE_INIT_CLASS(SoFCLinkElementSwitch,SoSwitch,"Switch");
+}
+
+void SoFCLinkElementSwitch::GLRender(SoGLRenderAction * action)
+{
+    if(instances && instances->skip(action))
+        return;
+    inherited::GLRender(action);
+}
+
+void SoFCLinkElementSwitch::doAction(SoAction *action)
+{
+    if(instances) {
+        if(action->getTypeId() == SoHighlightElementAction::getClassTypeId())
+            instances->selCounter.checkAction(static_cast<SoHighlightElementAction*>(action));
+        else if(action->getTypeId() == SoSelectionElementAction::getClassTypeId()) {
+            auto selaction = static_cast<SoSelectionElementAction*>(action);
+            instances->selCounter.checkAction(selaction);
+            if(selaction->isSecondary()) {
+                // Secondary selection is used for element colors and element
+                // visibility, which the direct rendering does not handle.
+                instances->hasSecondary = selaction->getType()!=SoSelectionElementAction::None
+                    && (selaction->getType()!=SoSelectionElementAction::Color
+                            || !selaction->getColors().empty());
+            }
+        }
+    }
+    inherited::doAction(action);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////
 
 TYPESYSTEM_SOURCE(Gui::LinkView,Base::BaseClass)
@@ -871,9 +973,11 @@ LinkView::LinkView()
     ,childType((SnapshotType)-1),autoSubLink(true)
 {
     pcLinkRoot = new SoFCSelectionRoot;
+    instances = std::make_shared<LinkInstances>(*this);
 }
 
 LinkView::~LinkView() {
+    instances->detach();
     unlink(linkInfo);
     unlink(linkOwner);
 }
@@ -1120,6 +1224,8 @@ void LinkView::setSize(int _size) {
             nodeMap.erase(nodeArray[i]->pcSwitch);
         nodeArray.resize(size);
     }
+    if(childType<0)
+        pcLinkRoot->addChild(instances->pcCallback);
     for(auto &info : nodeArray)
         pcLinkRoot->addChild(info->pcSwitch);
 
@@ -1207,6 +1313,50 @@ void LinkView::setChildren(const std::vector<App::DocumentObject*> &children,
     }
 }
 
+bool LinkView::renderInstances(SoGLRenderAction *action) {
+    if(!ViewParams::instance()->getLinkArrayInstancing()
+            || childType>=0
+            || !pcLinkedRoot
+            || !subInfo.empty()
+            || nodeArray.size()<2
+            || action->getCurPathCode()==SoAction::IN_PATH
+            || action->isRenderingDelayedPaths()
+            || pcLinkRoot->hasColorOverride())
+        return false;
+
+    SoState *state = action->getState();
+    if(instances->hasSecondary || !instances->selCounter.checkRenderCache(state))
+        return false;
+
+    if(!isLinked())
+        return false;
+    auto vp = Base::freecad_dynamic_cast<ViewProviderGeometryObject>(linkInfo->pcLinked);
+    if(!vp || vp->Transparency.getValue())
+        return false;
+
+    for(auto &info : nodeArray) {
+        if(info->pcRoot->hasColorOverride())
+            return false;
+    }
+
+    SbMatrix mat;
+    for(auto &info : nodeArray) {
+        if(info->pcSwitch->whichChild.getValue()<0)
+            continue;
+        auto &trans = *info->pcTransform;
+        mat.setTransform(trans.translation.getValue(),
+                         trans.rotation.getValue(),
+                         trans.scaleFactor.getValue(),
+                         trans.scaleOrientation.getValue(),
+                         trans.center.getValue());
+        state->push();
+        SoModelMatrixElement::mult(state,pcLinkRoot,mat);
+        action->traverse(pcLinkedRoot);
+        state->pop();
+    }
+    return true;
+}
+
 std::vector<ViewProviderDocumentObject*> LinkView::getChildren() const {
     std::vector<ViewProviderDocumentObject*> ret;
     for(auto &info : nodeArray) {
@@ -2773,6 +2923,7 @@ std::map<std::string, App::Color> ViewProviderLink::getElementColors(const char
     if(!ext || ! ext->getColoredElementsProperty())
         return colors;
     const auto &subs = ext->getColoredElementsProperty()->getShadowSubs();
+    const auto &subValues = ext->getColoredElementsProperty()->getSubValues();
     int size = OverrideColorList.getSize();
 
     std::string wildcard(subname);
@@ -2800,16 +2951,18 @@ std::map<std::string, App::Color> ViewProviderLink::getElementColors(const char
         for(auto &sub : subs) {
             if(++i >= size)
                 break;
-            auto pos = sub.second.rfind('.');
+            // an empty old style name is the same as the sub value
+            const std::string &name = sub.second.empty() ? subValues[i] : sub.second;
+            auto pos = name.rfind('.');
             if(pos == std::string::npos)
                 pos = 0;
             else
                 ++pos;
-            const char *element = sub.second.c_str()+pos;
+            const char *element = name.c_str()+pos;
             if(boost::starts_with(element,wildcard))
-                colors[sub.second] = OverrideColorList[i];
+                colors[name] = OverrideColorList[i];
             else if(!element[0] && wildcard=="Face")
-                colors[sub.second.substr(0,element-sub.second.c_str())+wildcard] = OverrideColorList[i];
+                colors[name.substr(0,element-name.c_str())+wildcard] = OverrideColorList[i];
         }
 
         // In case of multi-level linking, we recursively call into each level,
@@ -25,6 +25,7 @@
 #define GUI_VIEWPROVIDER_LINK_H
 
 #include <boost/preprocessor/seq/for_each.hpp>
+#include <Inventor/nodes/SoSwitch.h>
 #include <App/PropertyGeo.h>
 #include <App/Link.h>
 #include "SoFCUnifiedSelection.h"
@@ -40,6 +41,29 @@ namespace Gui {
 
 class LinkInfo;
 typedef boost::intrusive_ptr<LinkInfo> LinkInfoPtr;
+class LinkInstances;
+
+/** Switch node of the elements of a link array
+ *
+ * If the link array has been rendered in one go by LinkView the node skips
+ * its own rendering. Any other action is handled like SoSwitch.
+ */
+class GuiExport SoFCLinkElementSwitch : public SoSwitch {
+    typedef SoSwitch inherited;
+    SO_NODE_HEADER(Gui::SoFCLinkElementSwitch);
+
+public:
+    static void initClass(void);
+    SoFCLinkElementSwitch();
+
+    virtual void GLRender(SoGLRenderAction * action);
+    virtual void doAction(SoAction *action);
+
+    std::shared_ptr<LinkInstances> instances;
+
+protected:
+    virtual ~SoFCLinkElementSwitch();
+};
 
 class GuiExport ViewProviderLinkObserver: public ViewProviderExtension {
     EXTENSION_TYPESYSTEM_HEADER_WITH_OVERRIDE();
@@ -155,6 +179,8 @@ protected:
     void replaceLinkedRoot(SoSeparator *);
     void resetRoot();
     bool getGroupHierarchy(int index, SoFullPath *path) const;
+    bool renderInstances(SoGLRenderAction *action);
+    friend class LinkInstances;
 
 protected:
     LinkInfoPtr linkOwner;
@@ -175,6 +201,7 @@ protected:
     class Element;
     std::vector<std::unique_ptr<Element> > nodeArray;
     std::unordered_map<SoNode*,int> nodeMap;
+    std::shared_ptr<LinkInstances> instances;
 
     Py::Object PythonObject;
 };
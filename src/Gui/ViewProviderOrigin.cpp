@@ -166,7 +166,6 @@ bool ViewProviderOrigin::isTemporaryVisibility() {
 void ViewProviderOrigin::onChanged(const App::Property* prop) {
     if (prop == &Size) {
         try {
-            Gui::Application *app = Gui::Application::Instance;
             Base::Vector3d sz = Size.getValue ();
             App::Origin* origin = static_cast<App::Origin*> ( getObject() );
 
@@ -183,13 +182,13 @@ void ViewProviderOrigin::onChanged(const App::Property* prop) {
             Gui::ViewProviderPlane* vpPlaneXY, *vpPlaneXZ, *vpPlaneYZ;
             Gui::ViewProviderLine* vpLineX, *vpLineY, *vpLineZ;
             // Planes
-            vpPlaneXY = static_cast<Gui::ViewProviderPlane *> ( app->getViewProvider ( origin->getXY () ) );
-            vpPlaneXZ = static_cast<Gui::ViewProviderPlane *> ( app->getViewProvider ( origin->getXZ () ) );
-            vpPlaneYZ = static_cast<Gui::ViewProviderPlane *> ( app->getViewProvider ( origin->getYZ () ) );
+            vpPlaneXY = static_cast<Gui::ViewProviderPlane *> ( getFeatureViewProvider ( origin, "XY_Plane" ) );
+            vpPlaneXZ = static_cast<Gui::ViewProviderPlane *> ( getFeatureViewProvider ( origin, "XZ_Plane" ) );
+            vpPlaneYZ = static_cast<Gui::ViewProviderPlane *> ( getFeatureViewProvider ( origin, "YZ_Plane" ) );
             // Axes
-            vpLineX = static_cast<Gui::ViewProviderLine *> ( app->getViewProvider ( origin->getX () ) );
-            vpLineY = static_cast<Gui::ViewProviderLine *> ( app->getViewProvider ( origin->getY () ) );
-            vpLineZ = static_cast<Gui::ViewProviderLine *> ( app->getViewProvider ( origin->getZ () ) );
+            vpLineX = static_cast<Gui::ViewProviderLine *> ( getFeatureViewProvider ( origin, "X_Axis" ) );
+            vpLineY = static_cast<Gui::ViewProviderLine *> ( getFeatureViewProvider ( origin, "Y_Axis" ) );
+            vpLineZ = static_cast<Gui::ViewProviderLine *> ( getFeatureViewProvider ( origin, "Z_Axis" ) );
 
             // set their sizes
             if (vpPlaneXY) { vpPlaneXY->Size.setValue ( szXY ); }
@@ -211,6 +210,25 @@ void ViewProviderOrigin::onChanged(const App::Property* prop) {
     ViewProviderDocumentObject::onChanged ( prop );
 }
 
+void ViewProviderOrigin::updateData(const App::Property* prop) {
+    // features of a compact origin are added later, give them the size of the origin
+    App::Origin* origin = static_cast<App::Origin*> ( getObject() );
+    if (prop == &origin->OriginFeatures && origin->Compact.getValue()) {
+        onChanged(&Size);
+    }
+
+    ViewProviderDocumentObject::updateData ( prop );
+}
+
+Gui::ViewProvider* ViewProviderOrigin::getFeatureViewProvider(App::Origin* origin, const char* role) {
+    // don't use getOriginFeature() here, it would create the missing features of a compact origin
+    App::OriginFeature* feat = origin->findOriginFeature(role);
+    if (!feat) {
+        return nullptr;
+    }
+    return Gui::Application::Instance->getViewProvider(feat);
+}
+
 bool ViewProviderOrigin::onDelete(const std::vector<std::string> &) {
     App::Origin* origin = static_cast<App::Origin*>( getObject() );
 
@@ -29,6 +29,10 @@
 
 #include "ViewProviderDocumentObject.h"
 
+namespace App {
+class Origin;
+}
+
 namespace Gui {
 
 class Document;
@@ -56,6 +60,7 @@ public:
     virtual void attach(App::DocumentObject* pcObject);
     virtual std::vector<std::string> getDisplayModes(void) const;
     virtual void setDisplayMode(const char* ModeName);
+    virtual void updateData(const App::Property* prop);
     ///@}
 
     /** @name Temporary visibility mode
@@ -80,6 +85,10 @@ protected:
     virtual void onChanged(const App::Property* prop);
     virtual bool onDelete(const std::vector<std::string> &);
 
+private:
+    /// Returns the view provider of an existing axis or plane
+    static Gui::ViewProvider* getFeatureViewProvider(App::Origin* origin, const char* role);
+
 private:
     SoGroup *pcGroupChildren;
 
@@ -652,6 +652,7 @@ MenuItem* StdWorkbench::setupMenuBar() const
           << "Std_SceneInspector"
           << "Std_DependencyGraph"
           << "Std_ProjectUtil"
+          << "Std_MemoryReport"
           << "Separator"
           << "Std_MeasureDistance"
           << "Separator"
@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 # include <cfloat>
+# include <QTimer>
 #endif
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -42,6 +43,9 @@ PropertyModel::PropertyModel(QObject* parent)
     : QAbstractItemModel(parent)
 {
     rootItem = static_cast<PropertyItem*>(PropertyItem::create());
+    updateTimer = new QTimer(this);
+    updateTimer->setSingleShot(true);
+    connect(updateTimer, SIGNAL(timeout()), this, SLOT(onUpdateTimer()));
 }
 
 PropertyModel::~PropertyModel()
@@ -233,6 +237,9 @@ void PropertyModel::buildUp(const PropertyModel::PropertyList& props)
 
     // fill up the listview with the properties
     rootItem->reset();
+    itemMap.clear();
+    pendingUpdates.clear();
+    updateTimer->stop();
 
     // sort the properties into their groups
     std::map<std::string, std::vector<PropItemInfo> > propGroup;
@@ -276,6 +283,8 @@ void PropertyModel::buildUp(const PropertyModel::PropertyList& props)
                     setPropertyItemName(child,prop->getName(),groupName);
 
                     child->setPropertyData(info.props);
+                    for (auto p : info.props)
+                        itemMap[p] = child;
                 }
             }
         }
@@ -285,21 +294,48 @@ void PropertyModel::buildUp(const PropertyModel::PropertyList& props)
 }
 
 void PropertyModel::updateProperty(const App::Property& prop)
+{
+    auto it = itemMap.find(&prop);
+    if (it == itemMap.end())
+        return;
+
+    PropertyItem* child = it->second;
+    if (child->getPropertyData().size() <= 1) {
+        updateItem(child, prop);
+        return;
+    }
+
+    // When editing many objects at once every one of them reports its change.
+    // Refresh a shared row only once after all of them are done.
+    pendingUpdates[child] = &prop;
+    if (!updateTimer->isActive())
+        updateTimer->start(0);
+}
+
+void PropertyModel::onUpdateTimer()
+{
+    auto pending = std::move(pendingUpdates);
+    pendingUpdates.clear();
+    for (auto &v : pending) {
+        // the item may have lost the property in the meantime
+        if (v.first->hasProperty(v.second))
+            updateItem(v.first, *v.second);
+    }
+}
+
+void PropertyModel::updateItem(PropertyItem* child, const App::Property& prop)
 {
     int column = 1;
-    int numChild = rootItem->childCount();
-    for (int row=0; row<numChild; row++) {
-        PropertyItem* child = rootItem->child(row);
-        if (child->hasProperty(&prop)) {
-            child->updateData();
-            QModelIndex data = this->index(row, column, QModelIndex());
-            if (data.isValid()) {
-                child->assignProperty(&prop);
-                dataChanged(data, data);
-                updateChildren(child, column, data);
-            }
-            break;
-        }
+    int row = child->row();
+    if (row < 0 || rootItem->child(row) != child)
+        return;
+
+    child->updateData();
+    QModelIndex data = this->index(row, column, QModelIndex());
+    if (data.isValid()) {
+        child->assignProperty(&prop);
+        dataChanged(data, data);
+        updateChildren(child, column, data);
     }
 }
 
@@ -385,6 +421,7 @@ void PropertyModel::appendProperty(const App::Property& prop)
 
         setPropertyItemName(item,prop.getName(),groupName);
         item->setPropertyData(data);
+        itemMap[&prop] = item;
 
         endInsertRows();
     }
@@ -392,15 +429,18 @@ void PropertyModel::appendProperty(const App::Property& prop)
 
 void PropertyModel::removeProperty(const App::Property& prop)
 {
-    int numChild = rootItem->childCount();
-    for (int row=0; row<numChild; row++) {
-        PropertyItem* child = rootItem->child(row);
-        if (child->hasProperty(&prop)) {
-            if (child->removeProperty(&prop)) {
-                removeRow(row, QModelIndex());
-            }
-            break;
-        }
+    auto it = itemMap.find(&prop);
+    if (it == itemMap.end())
+        return;
+
+    PropertyItem* child = it->second;
+    itemMap.erase(it);
+    int row = child->row();
+    if (row < 0 || rootItem->child(row) != child)
+        return;
+    if (child->removeProperty(&prop)) {
+        pendingUpdates.erase(child);
+        removeRow(row, QModelIndex());
     }
 }
 
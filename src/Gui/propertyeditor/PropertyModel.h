@@ -28,6 +28,9 @@
 #include <QStringList>
 #include <vector>
 #include <map>
+#include <unordered_map>
+
+class QTimer;
 
 namespace App {
 class Property;
@@ -67,11 +70,20 @@ public:
     QStringList propertyPathFromIndex(const QModelIndex&) const;
     QModelIndex propertyIndexFromPath(const QStringList&) const;
 
+private Q_SLOTS:
+    void onUpdateTimer();
+
 private:
     void updateChildren(PropertyItem* item, int column, const QModelIndex& parent);
+    void updateItem(PropertyItem* item, const App::Property& prop);
 
 private:
     PropertyItem *rootItem;
+    /// top level item of each property, to avoid searching all the rows on change
+    std::unordered_map<const App::Property*, PropertyItem*> itemMap;
+    /// items shared by several objects whose update is coalesced
+    std::map<PropertyItem*, const App::Property*> pendingUpdates;
+    QTimer *updateTimer;
 };
 
 } //namespace PropertyEditor
@@ -320,6 +320,26 @@ bool best_fit::Perform_PointCloud()
 	return true;
 }
 
+bool best_fit::Perform_ICP(float trimRatio)
+{
+    Tesselate_Shape(m_Cad, m_CadMesh, 1);
+    MeshFit_Coarse(); // Transformation Mesh -> CAD
+
+    // the tessellation is only prepared once, the nearest points are searched in parallel
+    MeshCore::MeshRegistration icp(m_CadMesh);
+    icp.SetTrimRatio(trimRatio);
+
+    const MeshCore::MeshPointArray& pnts = m_MeshWork.GetPoints();
+    std::vector<Base::Vector3f> points(pnts.begin(), pnts.end());
+    Base::Matrix4D M = icp.Align(points);
+
+    m_MeshWork.Transform(M);
+    m_Mesh = m_MeshWork;
+    m_ICPIterations = icp.GetIterations();
+
+    return icp.Converged();
+}
+
 /*
 bool best_fit::Intersect(const Base::Vector3f &normal,const MeshCore::MeshKernel &mesh, Base::Vector3f &P, Base::Vector3f &I)
 {
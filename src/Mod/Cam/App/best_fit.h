@@ -29,6 +29,7 @@
 #include <Mod/Mesh/App/Core/Approximation.h>
 #include <Mod/Mesh/App/Core/Evaluation.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Registration.h>
 #include <Base/Exception.h>
 #include <gp_Vec.hxx>
 #include <TopoDS_Shape.hxx>
@@ -87,6 +88,18 @@ public:
     /*! \brief Main function of the best-fit-algorithm only on point clouds */
     bool Perform_PointCloud();
 
+    /*! \brief Fast best-fit using a trimmed ICP on the tessellation of m_Cad
+
+        The tessellation is put into a bounding volume hierarchy once and the
+        nearest points are searched in parallel, starting with a subset of the
+        mesh points. Unlike Perform() no weights are used. Returns true if the
+        alignment has converged, m_ICPIterations holds the RMS error of each
+        iteration.
+
+        \param trimRatio ratio of the closest point pairs used in each iteration
+    */
+    bool Perform_ICP(float trimRatio = 0.9f);
+
     bool output_best_fit_mesh();
 
     //double CompError(std::vector<Base::Vector3f> &pnts, std::vector<Base::Vector3f> &normals);
@@ -182,6 +195,9 @@ public:
     /*! \brief Vector of the preselected-faces for the weighting */
     std::vector<TopoDS_Face> m_LowFaces;   // Vektor der in der GUI selektierten Faces mit geringer Gewichtung
 
+    /*! \brief The iterations of the last call of Perform_ICP() */
+    std::vector<MeshCore::MeshRegistration::Iteration> m_ICPIterations;
+
 private:
     /*! \brief Computes the rotation-matrix with reference to the given
                parameters
@@ -67,6 +67,7 @@
 #ifdef FC_USE_VTK
 #include "FemPostPipeline.h"
 #include "FemVTKTools.h"
+#include "FemFrdReader.h"
 #endif
 
 #include <Base/Vector3D.h>
@@ -97,6 +98,15 @@ public:
         add_varargs_method("writeResult",&Module::writeResult,
             "write a CFD or FEM result (auto detect) to a file (file format detected from file suffix)"
         );
+        add_varargs_method("getFrdSteps",&Module::getFrdSteps,
+            "getFrdSteps(string) -- Return the (step number, time) of the result steps in a CalculiX .frd file."
+        );
+        add_varargs_method("readFrdResult",&Module::readFrdResult,
+            "readFrdResult(string,result,[int],[mesh]) -- Read a step of a CalculiX .frd file into a result object.\n"
+            "The step is an index into the list of getFrdSteps(), by default the last step is read.\n"
+            "The mesh of the file is added as new mesh object unless a mesh object from an earlier call\n"
+            "is passed. Returns the mesh object the result is linked to."
+        );
 #endif
         add_varargs_method("show",&Module::show,
             "show(shape,[string]) -- Add the mesh to the active document or create one if no document exists."
@@ -291,6 +301,69 @@ private:
 
         return Py::None();
     }
+
+    Py::Object getFrdSteps(const Py::Tuple& args)
+    {
+        char* fileName = NULL;
+        if (!PyArg_ParseTuple(args.ptr(), "et","utf-8", &fileName))
+            throw Py::Exception();
+        std::string EncodedName = std::string(fileName);
+        PyMem_Free(fileName);
+
+        FrdReader reader(EncodedName);
+        Py::List list;
+        for (std::size_t i = 0; i < reader.countSteps(); i++) {
+            Py::Tuple step(2);
+            step.setItem(0, Py::Long(reader.stepNumber(i)));
+            step.setItem(1, Py::Float(reader.stepTime(i)));
+            list.append(step);
+        }
+        return list;
+    }
+
+    Py::Object readFrdResult(const Py::Tuple& args)
+    {
+        char* fileName = NULL;
+        PyObject* pcResult;
+        int step = -1;
+        PyObject* pcMesh = Py_None;
+
+        if (!PyArg_ParseTuple(args.ptr(), "etO!|iO","utf-8", &fileName, &(App::DocumentObjectPy::Type), &pcResult,
+                              &step, &pcMesh))
+            throw Py::Exception();
+        std::string EncodedName = std::string(fileName);
+        PyMem_Free(fileName);
+
+        App::DocumentObject* result = static_cast<App::DocumentObjectPy*>(pcResult)->getDocumentObjectPtr();
+        if (!result->getTypeId().isDerivedFrom(FemResultObject::getClassTypeId()))
+            throw Py::TypeError("object is not a result object");
+
+        App::DocumentObject* mesh = nullptr;
+        if (pcMesh != Py_None) {
+            if (!PyObject_TypeCheck(pcMesh, &(App::DocumentObjectPy::Type)))
+                throw Py::TypeError("mesh must be a document object");
+            mesh = static_cast<App::DocumentObjectPy*>(pcMesh)->getDocumentObjectPtr();
+            if (!mesh->getTypeId().isDerivedFrom(FemMeshObject::getClassTypeId()))
+                throw Py::TypeError("object is not a mesh object");
+        }
+
+        FrdReader reader(EncodedName);
+        if (reader.countSteps() == 0)
+            throw Py::RuntimeError("File contains no results");
+        std::size_t index = (step < 0) ? reader.countSteps() - 1 : std::size_t(step);
+
+        if (!mesh) {
+            std::unique_ptr<FemMesh> fmesh(new FemMesh);
+            reader.readMesh(*fmesh);
+            mesh = result->getDocument()->addObject("Fem::FemMeshObject", "ResultMesh");
+            static_cast<FemMeshObject*>(mesh)->FemMesh.setValuePtr(fmesh.release());
+        }
+
+        static_cast<FemResultObject*>(result)->Mesh.setValue(mesh);
+        reader.readResult(index, result);
+
+        return Py::asObject(mesh->getPyObject());
+    }
 #endif
 
     Py::Object show(const Py::Tuple& args)
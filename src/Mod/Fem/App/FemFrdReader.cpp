@@ -0,0 +1,776 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
+# include <cmath>
+# include <cstdlib>
+# include <cstring>
+# include <map>
+# include <set>
+
+# include <SMESH_Mesh.hxx>
+# include <SMESHDS_Mesh.hxx>
+
+# include <vtkCellArray.h>
+# include <vtkCellType.h>
+# include <vtkDoubleArray.h>
+# include <vtkIdTypeArray.h>
+# include <vtkPointData.h>
+# include <vtkPoints.h>
+#endif
+
+#include <QFile>
+
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/ThreadPool.h>
+#include <App/DocumentObject.h>
+#include <App/PropertyGeo.h>
+#include <App/PropertyStandard.h>
+
+#include "FemFrdReader.h"
+#include "FemMesh.h"
+
+using namespace Fem;
+
+namespace {
+
+const char* nextLine(const char* pos, const char* end)
+{
+    const char* nl = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+    return nl ? nl + 1 : end;
+}
+
+const char* lineEnd(const char* pos, const char* end)
+{
+    const char* nl = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+    if (!nl)
+        return end;
+    if (nl > pos && nl[-1] == '\r')
+        return nl - 1;
+    return nl;
+}
+
+bool startsWith(const char* pos, const char* eol, const char* key)
+{
+    std::size_t len = std::strlen(key);
+    return static_cast<std::size_t>(eol - pos) >= len && std::memcmp(pos, key, len) == 0;
+}
+
+// The data lines start with ' -1' (first line of a node or element), ' -2' (continuation),
+// ' -3' (end of block), ' -4' and ' -5' (names of the result and its components)
+int recordKey(const char* pos, const char* end)
+{
+    if (end - pos >= 3 && pos[0] == ' ' && pos[1] == '-' && pos[2] >= '1' && pos[2] <= '5')
+        return -(pos[2] - '0');
+    return 0;
+}
+
+// Fixed width fields, the values may follow each other without a blank
+int readInt(const char* pos, const char* eol, int width)
+{
+    if (pos >= eol)
+        return 0;
+    char buf[32];
+    std::size_t len = std::min<std::size_t>(std::min<std::size_t>(width, eol - pos), sizeof(buf) - 1);
+    std::memcpy(buf, pos, len);
+    buf[len] = '\0';
+    return static_cast<int>(std::strtol(buf, nullptr, 10));
+}
+
+double readDouble(const char* pos, const char* eol, int width)
+{
+    if (pos >= eol)
+        return 0.0;
+    char buf[32];
+    std::size_t len = std::min<std::size_t>(std::min<std::size_t>(width, eol - pos), sizeof(buf) - 1);
+    std::memcpy(buf, pos, len);
+    buf[len] = '\0';
+    return std::strtod(buf, nullptr);
+}
+
+std::vector<std::string> tokens(const char* pos, const char* eol)
+{
+    std::vector<std::string> result;
+    while (pos < eol) {
+        while (pos < eol && *pos == ' ')
+            pos++;
+        const char* start = pos;
+        while (pos < eol && *pos != ' ')
+            pos++;
+        if (pos > start)
+            result.emplace_back(start, pos);
+    }
+    return result;
+}
+
+// Splits the lines of a block into chunks of about chunkSize bytes, each starting with a ' -1' line
+std::vector<const char*> splitRecords(const char* begin, const char* end)
+{
+    const std::size_t chunkSize = 1 << 20;
+    std::vector<const char*> bounds;
+    bounds.push_back(begin);
+    const char* pos = begin;
+    while (static_cast<std::size_t>(end - pos) > chunkSize) {
+        pos = nextLine(pos + chunkSize, end);
+        while (pos < end && recordKey(pos, end) != -1)
+            pos = nextLine(pos, end);
+        if (pos >= end)
+            break;
+        bounds.push_back(pos);
+    }
+    bounds.push_back(end);
+    return bounds;
+}
+
+// The CalculiX element types with the node order of VTK. The quadratic hexahedron
+// and wedge are written with the mid-nodes of the vertical edges last, the quadratic
+// beam with the mid-node second.
+const int he20Order[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 16, 17, 18, 19, 12, 13, 14, 15};
+const int pe15Order[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 13, 14, 9, 10, 11};
+const int be3Order[] = {0, 2, 1};
+
+struct ElementType
+{
+    int vtkType;
+    int numNodes;
+    const int* order;
+};
+
+const ElementType* elementType(int frdType)
+{
+    static const ElementType types[] = {
+        {VTK_QUADRATIC_HEXAHEDRON, 20, he20Order},  // 1: he20
+        {VTK_QUADRATIC_WEDGE, 15, pe15Order},       // 2: pe15
+        {VTK_QUADRATIC_TETRA, 10, nullptr},         // 3: te10
+        {VTK_HEXAHEDRON, 8, nullptr},               // 4: he8
+        {VTK_WEDGE, 6, nullptr},                    // 5: pe6
+        {VTK_TETRA, 4, nullptr},                    // 6: te4
+        {VTK_TRIANGLE, 3, nullptr},                 // 7: tr3
+        {VTK_QUADRATIC_TRIANGLE, 6, nullptr},       // 8: tr6
+        {VTK_QUAD, 4, nullptr},                     // 9: qu4
+        {VTK_QUADRATIC_QUAD, 8, nullptr},           // 10: qu8
+        {VTK_LINE, 2, nullptr},                     // 11: be2
+        {VTK_QUADRATIC_EDGE, 3, be3Order}           // 12: be3
+    };
+    if (frdType < 1 || frdType > 12)
+        return nullptr;
+    return &types[frdType - 1];
+}
+
+// How the values of a result block map to the result properties, the names are the
+// same as in FemVTKTools, see src/Mod/Fem/femobjects/_FemResultMechanical
+enum FieldKind {
+    Component,
+    Vector,
+    Length,
+    VonMises
+};
+
+struct ResultField
+{
+    const char* block;
+    FieldKind kind;
+    int component;
+    const char* property;
+    const char* vtkName;
+};
+
+const ResultField resultFields[] = {
+    {"DISP",     Vector,    0, "DisplacementVectors", "Displacement"},
+    {"DISP",     Length,    0, "DisplacementLengths", "Displacement Magnitude"},
+    {"STRESS",   Component, 0, "NodeStressXX", "Stress xx component"},
+    {"STRESS",   Component, 1, "NodeStressYY", "Stress yy component"},
+    {"STRESS",   Component, 2, "NodeStressZZ", "Stress zz component"},
+    {"STRESS",   Component, 3, "NodeStressXY", "Stress xy component"},
+    {"STRESS",   Component, 4, "NodeStressYZ", "Stress yz component"},
+    {"STRESS",   Component, 5, "NodeStressXZ", "Stress xz component"},
+    {"STRESS",   VonMises,  0, "vonMises", "von Mises Stress"},
+    {"TOSTRAIN", Component, 0, "NodeStrainXX", "Strain xx component"},
+    {"TOSTRAIN", Component, 1, "NodeStrainYY", "Strain yy component"},
+    {"TOSTRAIN", Component, 2, "NodeStrainZZ", "Strain zz component"},
+    {"TOSTRAIN", Component, 3, "NodeStrainXY", "Strain xy component"},
+    {"TOSTRAIN", Component, 4, "NodeStrainYZ", "Strain yz component"},
+    {"TOSTRAIN", Component, 5, "NodeStrainXZ", "Strain xz component"},
+    {"PE",       Component, 0, "Peeq", "Equivalent Plastic Strain"},
+    {"NDTEMP",   Component, 0, "Temperature", "Temperature"},
+    {"MAFLOW",   Component, 0, "MassFlowRate", "Mass Flow Rate"},
+    {"STPRES",   Component, 0, "NetworkPressure", "Network Pressure"}
+};
+
+int fieldDimension(const ResultField& field)
+{
+    return field.kind == Vector ? 3 : 1;
+}
+
+// Returns false if the block doesn't have enough values for the field
+bool fieldValue(const ResultField& field, const double* v, int numValues, double* out)
+{
+    switch (field.kind) {
+    case Component:
+        if (field.component >= numValues)
+            return false;
+        out[0] = v[field.component];
+        return true;
+    case Vector:
+        if (numValues < 3)
+            return false;
+        out[0] = v[0];
+        out[1] = v[1];
+        out[2] = v[2];
+        return true;
+    case Length:
+        if (numValues < 3)
+            return false;
+        out[0] = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        return true;
+    case VonMises:
+        if (numValues < 6)
+            return false;
+        // xx, yy, zz, xy, yz, zx
+        out[0] = std::sqrt(0.5 * ((v[0] - v[1]) * (v[0] - v[1]) +
+                                  (v[1] - v[2]) * (v[1] - v[2]) +
+                                  (v[2] - v[0]) * (v[2] - v[0]) +
+                                  6.0 * (v[3] * v[3] + v[4] * v[4] + v[5] * v[5])));
+        return true;
+    }
+    return false;
+}
+
+}
+
+FrdReader::FrdReader(const std::string& fileName)
+  : file(new QFile(QString::fromUtf8(fileName.c_str())))
+{
+    if (!file->open(QIODevice::ReadOnly))
+        throw Base::FileException("Cannot open file", fileName.c_str());
+
+    qint64 size = file->size();
+    if (size > 0) {
+        uchar* map = file->map(0, size);
+        if (!map)
+            throw Base::FileException("Cannot map file into memory", fileName.c_str());
+        data = reinterpret_cast<const char*>(map);
+        dataEnd = data + size;
+    }
+
+    index();
+    if (steps.empty() && !nodeBlock.begin)
+        throw Base::FileException("No nodes or results found in file", fileName.c_str());
+}
+
+FrdReader::~FrdReader()
+{
+}
+
+std::size_t FrdReader::countSteps() const
+{
+    return steps.size();
+}
+
+int FrdReader::stepNumber(std::size_t step) const
+{
+    return getStep(step).number;
+}
+
+double FrdReader::stepTime(std::size_t step) const
+{
+    return getStep(step).time;
+}
+
+const FrdReader::Step& FrdReader::getStep(std::size_t step) const
+{
+    if (step >= steps.size())
+        throw Base::IndexError("Step index out of range");
+    return steps[step];
+}
+
+void FrdReader::index()
+{
+    const char* pos = data;
+    while (pos < dataEnd) {
+        const char* eol = lineEnd(pos, dataEnd);
+        const char* next = nextLine(pos, dataEnd);
+        const char* key = pos;
+        while (key < eol && *key == ' ')
+            key++;
+
+        if (startsWith(key, eol, "2C") || startsWith(key, eol, "3C")) {
+            Block& block = (key[0] == '2') ? nodeBlock : elementBlock;
+            // number of entities and format: 0 short, 1 long, 2 binary
+            std::vector<std::string> values = tokens(key + 2, eol);
+            int format = values.size() > 1 ? std::atoi(values[1].c_str()) : 0;
+            if (format > 1)
+                throw Base::FileException("Binary frd files are not supported");
+            block.longFormat = (format == 1);
+            next = skipBlock(next, block);
+        }
+        else if (startsWith(key, eol, "100C")) {
+            // setname (6), value (12), numnod (12), text (20), ictype (2), numstp (5),
+            // analys (10), format (2)
+            const char* fields = key + 4;
+            double time = readDouble(fields + 6, eol, 12);
+            int number = readInt(fields + 52, eol, 5);
+            int format = readInt(fields + 67, eol, 2);
+            if (format > 1)
+                throw Base::FileException("Binary frd files are not supported");
+
+            ResultBlock block;
+            block.longFormat = (format == 1);
+            while (next < dataEnd) {
+                const char* lineEol = lineEnd(next, dataEnd);
+                int record = recordKey(next, dataEnd);
+                if (record == -4) {
+                    std::vector<std::string> values = tokens(next + 3, lineEol);
+                    if (!values.empty())
+                        block.name = values[0];
+                }
+                else if (record == -5) {
+                    // name, menu, ictype, icind1, icind2, iexist: components with
+                    // iexist 1 are derived by the post-processor and have no values
+                    std::vector<std::string> values = tokens(next + 3, lineEol);
+                    if (values.size() < 6 || std::atoi(values[5].c_str()) != 1)
+                        block.numValues++;
+                }
+                else {
+                    break;
+                }
+                next = nextLine(next, dataEnd);
+            }
+            next = skipBlock(next, block);
+
+            if (steps.empty() || steps.back().number != number) {
+                steps.emplace_back();
+                steps.back().number = number;
+                steps.back().time = time;
+            }
+            steps.back().blocks.push_back(block);
+        }
+        else if (startsWith(key, eol, "9999")) {
+            break;
+        }
+        pos = next;
+    }
+}
+
+const char* FrdReader::skipBlock(const char* pos, Block& block) const
+{
+    block.begin = pos;
+    while (pos < dataEnd && recordKey(pos, dataEnd) != -3)
+        pos = nextLine(pos, dataEnd);
+    block.end = pos;
+    return nextLine(pos, dataEnd);
+}
+
+void FrdReader::parseMesh() const
+{
+    if (meshParsed)
+        return;
+    parseNodes();
+    parseElements();
+    meshParsed = true;
+}
+
+void FrdReader::parseNodes() const
+{
+    nodeIds.clear();
+    coords.clear();
+    if (!nodeBlock.begin)
+        return;
+
+    const int width = nodeBlock.longFormat ? 10 : 5;
+    std::vector<const char*> bounds = splitRecords(nodeBlock.begin, nodeBlock.end);
+    std::size_t numChunks = bounds.size() - 1;
+    std::vector<std::vector<int>> chunkIds(numChunks);
+    std::vector<std::vector<double>> chunkCoords(numChunks);
+
+    Base::parallel_for(std::size_t(0), numChunks, [&](std::size_t chunk) {
+        const char* end = bounds[chunk + 1];
+        for (const char* pos = bounds[chunk]; pos < end; pos = nextLine(pos, end)) {
+            if (recordKey(pos, end) != -1)
+                continue;
+            const char* eol = lineEnd(pos, end);
+            const char* field = pos + 3;
+            chunkIds[chunk].push_back(readInt(field, eol, width));
+            field += width;
+            for (int i = 0; i < 3; i++)
+                chunkCoords[chunk].push_back(readDouble(field + 12 * i, eol, 12));
+        }
+    }, std::size_t(1));
+
+    for (std::size_t chunk = 0; chunk < numChunks; chunk++) {
+        nodeIds.insert(nodeIds.end(), chunkIds[chunk].begin(), chunkIds[chunk].end());
+        coords.insert(coords.end(), chunkCoords[chunk].begin(), chunkCoords[chunk].end());
+    }
+}
+
+void FrdReader::parseElements() const
+{
+    elements = Elements();
+    if (!elementBlock.begin) {
+        elements.offsets.push_back(0);
+        return;
+    }
+
+    const int width = elementBlock.longFormat ? 10 : 5;
+    std::vector<const char*> bounds = splitRecords(elementBlock.begin, elementBlock.end);
+    std::size_t numChunks = bounds.size() - 1;
+    std::vector<Elements> chunks(numChunks);
+
+    Base::parallel_for(std::size_t(0), numChunks, [&](std::size_t chunk) {
+        Elements& elems = chunks[chunk];
+        const char* end = bounds[chunk + 1];
+        for (const char* pos = bounds[chunk]; pos < end; pos = nextLine(pos, end)) {
+            int record = recordKey(pos, end);
+            const char* eol = lineEnd(pos, end);
+            if (record == -1) {
+                // id, type, group, material
+                elems.ids.push_back(readInt(pos + 3, eol, width));
+                elems.types.push_back(readInt(pos + 3 + width, eol, 5));
+                elems.offsets.push_back(static_cast<int>(elems.nodes.size()));
+            }
+            else if (record == -2 && !elems.ids.empty()) {
+                for (const char* field = pos + 3; field + width <= eol; field += width)
+                    elems.nodes.push_back(readInt(field, eol, width));
+            }
+        }
+        elems.offsets.push_back(static_cast<int>(elems.nodes.size()));
+
+        // convert to the node order of VTK
+        std::vector<int> frdNodes;
+        for (std::size_t i = 0; i < elems.ids.size(); i++) {
+            const ElementType* type = elementType(elems.types[i]);
+            int count = elems.offsets[i + 1] - elems.offsets[i];
+            if (!type || !type->order || count != type->numNodes)
+                continue;
+            int* nodes = elems.nodes.data() + elems.offsets[i];
+            frdNodes.assign(nodes, nodes + count);
+            for (int j = 0; j < count; j++)
+                nodes[j] = frdNodes[type->order[j]];
+        }
+    }, std::size_t(1));
+
+    for (std::size_t chunk = 0; chunk < numChunks; chunk++) {
+        Elements& elems = chunks[chunk];
+        int offset = static_cast<int>(elements.nodes.size());
+        elements.ids.insert(elements.ids.end(), elems.ids.begin(), elems.ids.end());
+        elements.types.insert(elements.types.end(), elems.types.begin(), elems.types.end());
+        for (std::size_t i = 0; i + 1 < elems.offsets.size(); i++)
+            elements.offsets.push_back(elems.offsets[i] + offset);
+        elements.nodes.insert(elements.nodes.end(), elems.nodes.begin(), elems.nodes.end());
+    }
+    elements.offsets.push_back(static_cast<int>(elements.nodes.size()));
+}
+
+FrdReader::Values FrdReader::parseValues(const ResultBlock& block) const
+{
+    const int width = block.longFormat ? 10 : 5;
+    const int numValues = block.numValues;
+    std::vector<const char*> bounds = splitRecords(block.begin, block.end);
+    std::size_t numChunks = bounds.size() - 1;
+    std::vector<Values> chunks(numChunks);
+
+    Base::parallel_for(std::size_t(0), numChunks, [&](std::size_t chunk) {
+        Values& vals = chunks[chunk];
+        const char* end = bounds[chunk + 1];
+        int count = numValues;  // values read for the current node
+        for (const char* pos = bounds[chunk]; pos < end; pos = nextLine(pos, end)) {
+            int record = recordKey(pos, end);
+            const char* eol = lineEnd(pos, end);
+            if (record == -1) {
+                // the values of a node start with its id, fill up the previous node
+                for (; count < numValues; count++)
+                    vals.values.push_back(0.0);
+                vals.nodes.push_back(readInt(pos + 3, eol, width));
+                count = 0;
+            }
+            else if (record != -2) {
+                continue;
+            }
+            // continuation lines have a blank id field
+            for (const char* field = pos + 3 + width; field < eol && count < numValues; field += 12, count++)
+                vals.values.push_back(readDouble(field, eol, 12));
+        }
+        for (; count < numValues; count++)
+            vals.values.push_back(0.0);
+    }, std::size_t(1));
+
+    Values result;
+    for (std::size_t chunk = 0; chunk < numChunks; chunk++) {
+        result.nodes.insert(result.nodes.end(), chunks[chunk].nodes.begin(), chunks[chunk].nodes.end());
+        result.values.insert(result.values.end(), chunks[chunk].values.begin(), chunks[chunk].values.end());
+    }
+    return result;
+}
+
+void FrdReader::readMesh(FemMesh& mesh) const
+{
+    parseMesh();
+
+    SMESH_Mesh* smesh = const_cast<SMESH_Mesh*>(mesh.getSMesh());
+    SMESHDS_Mesh* meshds = smesh->GetMeshDS();
+    meshds->ClearMesh();
+
+    for (std::size_t i = 0; i < nodeIds.size(); i++) {
+        const double* p = coords.data() + 3 * i;
+        meshds->AddNodeWithID(p[0], p[1], p[2], nodeIds[i]);
+    }
+
+    int unsupported = 0;
+    for (std::size_t i = 0; i < elements.ids.size(); i++) {
+        const ElementType* type = elementType(elements.types[i]);
+        const int* n = elements.nodes.data() + elements.offsets[i];
+        int count = elements.offsets[i + 1] - elements.offsets[i];
+        int id = elements.ids[i];
+        if (!type || count != type->numNodes) {
+            unsupported++;
+            continue;
+        }
+        switch (type->vtkType) {
+        case VTK_LINE:
+            meshds->AddEdgeWithID(n[0], n[1], id);
+            break;
+        case VTK_QUADRATIC_EDGE:
+            meshds->AddEdgeWithID(n[0], n[1], n[2], id);
+            break;
+        case VTK_TRIANGLE:
+            meshds->AddFaceWithID(n[0], n[1], n[2], id);
+            break;
+        case VTK_QUADRATIC_TRIANGLE:
+            meshds->AddFaceWithID(n[0], n[1], n[2], n[3], n[4], n[5], id);
+            break;
+        case VTK_QUAD:
+            meshds->AddFaceWithID(n[0], n[1], n[2], n[3], id);
+            break;
+        case VTK_QUADRATIC_QUAD:
+            meshds->AddFaceWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], id);
+            break;
+        case VTK_TETRA:
+            meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], id);
+            break;
+        case VTK_QUADRATIC_TETRA:
+            meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], id);
+            break;
+        case VTK_HEXAHEDRON:
+            meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], id);
+            break;
+        case VTK_QUADRATIC_HEXAHEDRON:
+            meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9],
+                                    n[10], n[11], n[12], n[13], n[14], n[15], n[16], n[17], n[18], n[19],
+                                    id);
+            break;
+        case VTK_WEDGE:
+            meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], id);
+            break;
+        case VTK_QUADRATIC_WEDGE:
+            meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9],
+                                    n[10], n[11], n[12], n[13], n[14],
+                                    id);
+            break;
+        default:
+            unsupported++;
+            break;
+        }
+    }
+
+    if (unsupported > 0)
+        Base::Console().Warning("%d elements of an unsupported type were skipped\n", unsupported);
+}
+
+void FrdReader::readResult(std::size_t step, App::DocumentObject* result) const
+{
+    const Step& s = getStep(step);
+    std::map<std::string, Values> values;
+    std::map<std::string, int> numValues;
+    for (const ResultBlock& block : s.blocks) {
+        bool used = std::any_of(std::begin(resultFields), std::end(resultFields), [&](const ResultField& field) {
+            return block.name == field.block;
+        });
+        if (used && values.find(block.name) == values.end()) {
+            values[block.name] = parseValues(block);
+            numValues[block.name] = block.numValues;
+        }
+    }
+
+    App::PropertyFloat* time = dynamic_cast<App::PropertyFloat*>(result->getPropertyByName("Time"));
+    if (time)
+        time->setValue(s.time);
+
+    // the nodes of the first block are the node numbers of the result
+    const Values* first = nullptr;
+    for (const ResultField& field : resultFields) {
+        auto it = values.find(field.block);
+        if (it != values.end()) {
+            first = &it->second;
+            break;
+        }
+    }
+    if (!first) {
+        Base::Console().Warning("No supported results found in step %d\n", s.number);
+        return;
+    }
+
+    const std::vector<int>& nodes = first->nodes;
+    int maxId = nodes.empty() ? 0 : *std::max_element(nodes.begin(), nodes.end());
+    std::vector<int> nodeIndex(maxId + 1, -1);
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i] >= 0)
+            nodeIndex[nodes[i]] = static_cast<int>(i);
+    }
+
+    App::PropertyIntegerList* nodeNumbers = dynamic_cast<App::PropertyIntegerList*>(result->getPropertyByName("NodeNumbers"));
+    if (nodeNumbers)
+        nodeNumbers->setValues(std::vector<long>(nodes.begin(), nodes.end()));
+
+    for (const ResultField& field : resultFields) {
+        auto it = values.find(field.block);
+        if (it == values.end())
+            continue;
+        App::Property* prop = result->getPropertyByName(field.property);
+        if (!prop)
+            continue;
+
+        const Values& vals = it->second;
+        int count = numValues[field.block];
+        int dim = fieldDimension(field);
+        std::vector<double> data(nodes.size() * dim, 0.0);
+        bool ok = true;
+        for (std::size_t i = 0; i < vals.nodes.size() && ok; i++) {
+            int id = vals.nodes[i];
+            if (id < 0 || id > maxId || nodeIndex[id] < 0)
+                continue;
+            ok = fieldValue(field, vals.values.data() + i * count, count, data.data() + nodeIndex[id] * dim);
+        }
+        if (!ok)
+            continue;
+
+        if (dim == 3) {
+            App::PropertyVectorList* list = dynamic_cast<App::PropertyVectorList*>(prop);
+            if (list) {
+                std::vector<Base::Vector3d> vecs(nodes.size());
+                for (std::size_t i = 0; i < nodes.size(); i++)
+                    vecs[i].Set(data[3 * i], data[3 * i + 1], data[3 * i + 2]);
+                list->setValues(vecs);
+            }
+        }
+        else {
+            App::PropertyFloatList* list = dynamic_cast<App::PropertyFloatList*>(prop);
+            if (list)
+                list->setValues(data);
+        }
+    }
+}
+
+void FrdReader::readGrid(std::size_t step, vtkSmartPointer<vtkUnstructuredGrid> grid) const
+{
+    parseMesh();
+    const Step& s = getStep(step);
+
+    int maxId = nodeIds.empty() ? 0 : *std::max_element(nodeIds.begin(), nodeIds.end());
+
+    // nodes, the gaps of the numbering are filled with unused points
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetDataTypeToFloat();
+    points->SetNumberOfPoints(maxId);
+    float* pnts = static_cast<float*>(points->GetVoidPointer(0));
+    std::fill(pnts, pnts + 3 * static_cast<std::size_t>(maxId), 0.0f);
+    Base::parallel_for(std::size_t(0), nodeIds.size(), [&](std::size_t i) {
+        float* pnt = pnts + 3 * static_cast<std::size_t>(nodeIds[i] - 1);
+        pnt[0] = float(coords[3 * i]);
+        pnt[1] = float(coords[3 * i + 1]);
+        pnt[2] = float(coords[3 * i + 2]);
+    });
+    points->Modified();
+    grid->SetPoints(points);
+
+    // elements, in the legacy layout (n, id0, id1, ...)
+    std::vector<std::size_t> cellOffsets;
+    std::vector<int> cellTypes;
+    std::vector<std::size_t> cellElements;
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < elements.ids.size(); i++) {
+        const ElementType* type = elementType(elements.types[i]);
+        if (!type || elements.offsets[i + 1] - elements.offsets[i] != type->numNodes)
+            continue;
+        cellOffsets.push_back(size);
+        cellTypes.push_back(type->vtkType);
+        cellElements.push_back(i);
+        size += type->numNodes + 1;
+    }
+
+    vtkSmartPointer<vtkIdTypeArray> ids = vtkSmartPointer<vtkIdTypeArray>::New();
+    ids->SetNumberOfValues(static_cast<vtkIdType>(size));
+    vtkIdType* cellData = ids->GetPointer(0);
+    Base::parallel_for(std::size_t(0), cellElements.size(), [&](std::size_t c) {
+        std::size_t elem = cellElements[c];
+        int count = elements.offsets[elem + 1] - elements.offsets[elem];
+        const int* nodes = elements.nodes.data() + elements.offsets[elem];
+        vtkIdType* cell = cellData + cellOffsets[c];
+        cell[0] = count;
+        for (int j = 0; j < count; j++)
+            cell[j + 1] = nodes[j] - 1;
+    });
+    vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetCells(static_cast<vtkIdType>(cellTypes.size()), ids);
+    grid->SetCells(cellTypes.data(), cells);
+
+    // results, a name used twice in a step is taken from the first block
+    std::set<std::string> done;
+    for (const ResultBlock& block : s.blocks) {
+        bool used = std::any_of(std::begin(resultFields), std::end(resultFields), [&](const ResultField& field) {
+            return block.name == field.block;
+        });
+        if (!used || !done.insert(block.name).second)
+            continue;
+
+        Values vals = parseValues(block);
+        for (const ResultField& field : resultFields) {
+            if (block.name != field.block)
+                continue;
+
+            int dim = fieldDimension(field);
+            vtkSmartPointer<vtkDoubleArray> array = vtkSmartPointer<vtkDoubleArray>::New();
+            array->SetNumberOfComponents(dim);
+            array->SetNumberOfTuples(maxId);
+            array->SetName(field.vtkName);
+            double* tuples = array->GetPointer(0);
+            std::fill(tuples, tuples + dim * static_cast<std::size_t>(maxId), 0.0);
+
+            std::atomic<bool> ok(true);
+            Base::parallel_for(std::size_t(0), vals.nodes.size(), [&](std::size_t i) {
+                int id = vals.nodes[i];
+                if (id < 1 || id > maxId)
+                    return;
+                if (!fieldValue(field, vals.values.data() + i * block.numValues, block.numValues,
+                                tuples + dim * static_cast<std::size_t>(id - 1)))
+                    ok = false;
+            });
+            if (ok)
+                grid->GetPointData()->AddArray(array);
+        }
+    }
+}
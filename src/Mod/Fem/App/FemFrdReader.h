@@ -0,0 +1,139 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef FEM_FRD_READER_H
+#define FEM_FRD_READER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+class QFile;
+
+namespace App {
+class DocumentObject;
+}
+
+namespace Fem
+{
+
+class FemMesh;
+
+/**
+ * \brief Reader for the ASCII result files (.frd) of CalculiX.
+ *
+ * The file is memory-mapped and only indexed when it is opened: the positions of the
+ * node and element blocks and of the result blocks of every step are recorded, the
+ * values are parsed when they are requested. A single step of a transient analysis can
+ * therefore be loaded without reading the rest of the file. The lines of a block are
+ * parsed in parallel.
+ *
+ * The results are written into the properties of a mechanical result object with the
+ * same names as used by FemVTKTools, or into the point data of a VTK grid. Binary .frd
+ * files are not supported.
+ */
+class AppFemExport FrdReader
+{
+public:
+    /// Opens and indexes the file, throws Base::FileException if it can't be read
+    explicit FrdReader(const std::string& fileName);
+    ~FrdReader();
+
+    /// Number of result steps in the file
+    std::size_t countSteps() const;
+    /// The step number as written by CalculiX
+    int stepNumber(std::size_t step) const;
+    /// The time of a step, or the frequency for a frequency analysis
+    double stepTime(std::size_t step) const;
+
+    /// Fills mesh with the nodes and elements of the file, using their CalculiX ids
+    void readMesh(FemMesh& mesh) const;
+    /// Fills the result properties of result with the values of step
+    void readResult(std::size_t step, App::DocumentObject* result) const;
+    /** Fills grid with the nodes, elements and values of step. Like FemVTKTools::exportVTKMesh
+     * the point of a node is at index node id - 1.
+     */
+    void readGrid(std::size_t step, vtkSmartPointer<vtkUnstructuredGrid> grid) const;
+
+private:
+    struct Block
+    {
+        const char* begin = nullptr; /**< first data line */
+        const char* end = nullptr;   /**< the line that terminates the block */
+        bool longFormat = false;
+    };
+    struct ResultBlock : Block
+    {
+        std::string name;
+        int numValues = 0; /**< values per node, without the derived components */
+    };
+    struct Step
+    {
+        int number = 0;
+        double time = 0.0;
+        std::vector<ResultBlock> blocks;
+    };
+    /// The values of a result block, numValues per node
+    struct Values
+    {
+        std::vector<int> nodes;
+        std::vector<double> values;
+    };
+    struct Elements
+    {
+        std::vector<int> ids;
+        std::vector<int> types;    /**< CalculiX element types */
+        std::vector<int> offsets;  /**< start of the nodes of each element, plus the end */
+        std::vector<int> nodes;    /**< in VTK order */
+    };
+
+    void index();
+    const char* skipBlock(const char* pos, Block& block) const;
+    void parseMesh() const;
+    void parseNodes() const;
+    void parseElements() const;
+    Values parseValues(const ResultBlock& block) const;
+    const Step& getStep(std::size_t step) const;
+
+private:
+    std::unique_ptr<QFile> file;
+    const char* data = nullptr;
+    const char* dataEnd = nullptr;
+    Block nodeBlock;
+    Block elementBlock;
+    std::vector<Step> steps;
+
+    // the mesh is parsed once on first use
+    mutable bool meshParsed = false;
+    mutable std::vector<int> nodeIds;
+    mutable std::vector<double> coords;
+    mutable Elements elements;
+};
+
+} //namespace Fem
+
+
+#endif // FEM_FRD_READER_H
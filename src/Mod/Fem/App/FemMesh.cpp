@@ -38,6 +38,9 @@
 # include <TopoDS_Solid.hxx>
 # include <TopoDS_Shape.hxx>
 # include <ShapeAnalysis_ShapeTolerance.hxx>
+# include <Standard_Failure.hxx>
+# include <algorithm>
+# include <sstream>
 
 # include <boost/assign/list_of.hpp>
 # include <boost/tokenizer.hpp> //to simplify parsing input files we use the boost lib
@@ -80,6 +83,8 @@
 #include <Mod/Mesh/App/Core/Iterator.h>
 
 #include "FemMesh.h"
+
+#include <QtConcurrentMap>
 #ifdef FC_USE_VTK
 #include "FemVTKTools.h"
 #endif
@@ -856,10 +861,76 @@ std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face &face) const
     return result;
 }
 
-std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid &solid) const
+namespace {
+
+struct NodePoint {
+    int id;
+    gp_Pnt pnt;
+};
+
+// Collect the nodes, in absolute space, which are inside the box
+std::vector<NodePoint> getNodesInBox(const SMESHDS_Mesh* data, const Base::Matrix4D& mat, const Bnd_Box& box)
+{
+    std::vector<NodePoint> nodes;
+    SMDS_NodeIteratorPtr aNodeIter = data->nodesIterator();
+    while (aNodeIter->more()) {
+        const SMDS_MeshNode* aNode = aNodeIter->next();
+        Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
+        // Apply the matrix to hold the BoundBox in absolute space.
+        vec = mat * vec;
+
+        gp_Pnt pnt(vec.x,vec.y,vec.z);
+        if (!box.IsOut(pnt))
+            nodes.push_back({aNode->GetID(), pnt});
+    }
+    return nodes;
+}
+
+// Return the IDs of the nodes closer to the shape than limit. The distances
+// are measured in parallel, each task loads the shape only once.
+std::set<int> getNodesNearShape(const TopoDS_Shape& shape, const std::vector<NodePoint>& nodes, double limit)
 {
+    const std::size_t chunkSize = 256;
+    std::vector<std::size_t> chunks;
+    for (std::size_t i = 0; i < nodes.size(); i += chunkSize)
+        chunks.push_back(i);
+
+    std::vector<char> inside(nodes.size(), 0);
+    QtConcurrent::blockingMap(chunks, [&](std::size_t start) {
+        std::size_t end = std::min(start + chunkSize, nodes.size());
+        try {
+            BRepExtrema_DistShapeShape measure;
+            measure.LoadS1(shape);
+            for (std::size_t i = start; i < end; i++) {
+                // create a vertex
+                BRepBuilderAPI_MakeVertex aBuilder(nodes[i].pnt);
+                // measure distance
+                measure.LoadS2(aBuilder.Vertex());
+                measure.Perform();
+                if (!measure.IsDone() || measure.NbSolution() < 1)
+                    continue;
+
+                if (measure.Value() < limit)
+                    inside[i] = 1;
+            }
+        }
+        catch (Standard_Failure&) {
+            // leave the remaining nodes of this chunk out, as for failed measurements
+        }
+    });
+
     std::set<int> result;
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (inside[i])
+            result.insert(result.end(), nodes[i].id);
+    }
+    return result;
+}
+
+} // namespace
 
+std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid &solid) const
+{
     Bnd_Box box;
     BRepBndLib::Add(solid, box);
 
@@ -872,34 +943,12 @@ std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid &solid) const
     // get the current transform of the FemMesh
     const Base::Matrix4D Mtrx(getTransform());
 
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x,vec.y,vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x,vec.y,vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(solid,s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1)
-                continue;
-
-            if (measure.Value() < limit)
-                result.insert(aNode->GetID());
-        }
-    }
-    return result;
+    std::vector<NodePoint> nodes = getNodesInBox(myMesh->GetMeshDS(), Mtrx, box);
+    return getNodesNearShape(solid, nodes, limit);
 }
 
 std::set<int> FemMesh::getNodesByFace(const TopoDS_Face &face) const
 {
-    std::set<int> result;
-
     Bnd_Box box;
     BRepBndLib::Add(face, box, Standard_False);  // https://forum.freecadweb.org/viewtopic.php?f=18&t=21571&start=70#p221591
     // limit where the mesh node belongs to the face:
@@ -909,26 +958,50 @@ std::set<int> FemMesh::getNodesByFace(const TopoDS_Face &face) const
     // get the current transform of the FemMesh
     const Base::Matrix4D Mtrx(getTransform());
 
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
+    std::vector<NodePoint> nodes = getNodesInBox(myMesh->GetMeshDS(), Mtrx, box);
+    return getNodesNearShape(face, nodes, limit);
+}
 
-        if (!box.IsOut(gp_Pnt(vec.x,vec.y,vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x,vec.y,vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(face,s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1)
-                continue;
+std::vector<std::set<int> > FemMesh::getNodesByFaces(const std::vector<TopoDS_Face> &faces) const
+{
+    std::vector<std::set<int> > result;
+    result.reserve(faces.size());
+    if (faces.empty())
+        return result;
+
+    // get all nodes in absolute space once, sorted by their x coordinate
+    Bnd_Box all;
+    all.SetWhole();
+    std::vector<NodePoint> nodes = getNodesInBox(myMesh->GetMeshDS(), Base::Matrix4D(getTransform()), all);
+    std::sort(nodes.begin(), nodes.end(), [](const NodePoint& a, const NodePoint& b) {
+        return a.pnt.X() < b.pnt.X();
+    });
+
+    for (const auto& face : faces) {
+        Bnd_Box box;
+        BRepBndLib::Add(face, box, Standard_False);
+        double limit = BRep_Tool::Tolerance(face);
+        box.Enlarge(limit);
+        if (box.IsVoid()) {
+            result.emplace_back();
+            continue;
+        }
 
-            if (measure.Value() < limit)
-                result.insert(aNode->GetID());
+        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+        box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        auto first = std::lower_bound(nodes.begin(), nodes.end(), xMin, [](const NodePoint& n, double x) {
+            return n.pnt.X() < x;
+        });
+        auto last = std::upper_bound(first, nodes.end(), xMax, [](double x, const NodePoint& n) {
+            return x < n.pnt.X();
+        });
+
+        std::vector<NodePoint> candidates;
+        for (auto it = first; it != last; ++it) {
+            if (!box.IsOut(it->pnt))
+                candidates.push_back(*it);
         }
+        result.push_back(getNodesNearShape(face, candidates, limit));
     }
 
     return result;
@@ -936,8 +1009,6 @@ std::set<int> FemMesh::getNodesByFace(const TopoDS_Face &face) const
 
 std::set<int> FemMesh::getNodesByEdge(const TopoDS_Edge &edge) const
 {
-    std::set<int> result;
-
     Bnd_Box box;
     BRepBndLib::Add(edge, box);
     // limit where the mesh node belongs to the edge:
@@ -947,29 +1018,8 @@ std::set<int> FemMesh::getNodesByEdge(const TopoDS_Edge &edge) const
     // get the current transform of the FemMesh
     const Base::Matrix4D Mtrx(getTransform());
 
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x,vec.y,vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x,vec.y,vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(edge,s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1)
-                continue;
-
-            if (measure.Value() < limit)
-                result.insert(aNode->GetID());
-        }
-    }
-
-    return result;
+    std::vector<NodePoint> nodes = getNodesInBox(myMesh->GetMeshDS(), Mtrx, box);
+    return getNodesNearShape(edge, nodes, limit);
 }
 
 std::set<int> FemMesh::getNodesByVertex(const TopoDS_Vertex &vertex) const
@@ -1847,6 +1897,40 @@ void FemMesh::read(const char *FileName)
     }
 }
 
+namespace {
+
+// Write count lines to out. The lines are formatted in parallel by
+// format(stream, index) into blocks that are then written in order.
+template<class Func> void writeLines(std::ostream& out, std::size_t count, Func format)
+{
+    const std::size_t linesPerBlock = 4096;
+    const std::size_t blocksPerPass = 256;
+
+    std::vector<std::size_t> blocks;
+    std::vector<std::string> buffers;
+    for (std::size_t first = 0; first < count; first += linesPerBlock * blocksPerPass) {
+        blocks.clear();
+        for (std::size_t i = first; i < count && i < first + linesPerBlock * blocksPerPass; i += linesPerBlock)
+            blocks.push_back(i);
+        buffers.assign(blocks.size(), std::string());
+
+        QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+            std::ostringstream str;
+            str.imbue(std::locale::classic());
+            str.precision(out.precision());
+            std::size_t last = std::min(start + linesPerBlock, count);
+            for (std::size_t i = start; i < last; i++)
+                format(str, i);
+            buffers[(start - first) / linesPerBlock] = str.str();
+        });
+
+        for (const std::string& buf : buffers)
+            out.write(buf.c_str(), buf.size());
+    }
+}
+
+}
+
 void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool groupParam) const
 {
     /*
@@ -1970,74 +2054,43 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
     }
 
     // get all data --> Extract Nodes and Elements of the current SMESH datastructure
-    typedef std::map<int, Base::Vector3d> VertexMap;
-    typedef std::map<int, std::vector<int> > NodesMap;
-    typedef std::map<std::string, NodesMap> ElementsMap;
+    // the elements are kept by type name and get sorted by their id before writing
+    typedef std::map<std::string, std::vector<const SMDS_MeshElement*> > ElementsMap;
+    SMESHDS_Mesh* meshDS = myMesh->GetMeshDS();
+
+    auto addElement = [](ElementsMap& elements, const std::map<int, std::string>& typeMap, const SMDS_MeshElement* aElem) {
+        std::map<int, std::string>::const_iterator it = typeMap.find(aElem->NbNodes());
+        if (it != typeMap.end())
+            elements[it->second].push_back(aElem);
+    };
 
     // get nodes
-    VertexMap vertexMap;  // empty nodes map
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    Base::Vector3d current_node;
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        current_node.Set(aNode->X(),aNode->Y(),aNode->Z());
-        current_node = _Mtrx * current_node;
-        vertexMap[aNode->GetID()] = current_node;
-    }
+    std::vector<const SMDS_MeshNode*> nodes;
+    nodes.reserve(meshDS->NbNodes());
+    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
+    while (aNodeIter->more())
+        nodes.push_back(aNodeIter->next());
 
     // get volumes
     ElementsMap elementsMapVol;  // empty volumes map
-    SMDS_VolumeIteratorPtr aVolIter = myMesh->GetMeshDS()->volumesIterator();
-    while (aVolIter->more()) {
-        const SMDS_MeshVolume* aVol = aVolIter->next();
-        std::pair<int, std::vector<int> > apair;
-        apair.first = aVol->GetID();
-        int numNodes = aVol->NbNodes();
-        std::map<int, std::string>::iterator it = volTypeMap.find(numNodes);
-        if (it != volTypeMap.end()) {
-            const std::vector<int>& order = elemOrderMap[it->second];
-            for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
-                apair.second.push_back(aVol->GetNode(*jt)->GetID());
-            elementsMapVol[it->second].insert(apair);
-        }
-    }
+    SMDS_VolumeIteratorPtr aVolIter = meshDS->volumesIterator();
+    while (aVolIter->more())
+        addElement(elementsMapVol, volTypeMap, aVolIter->next());
 
     //get faces
     ElementsMap elementsMapFac;  // empty faces map used for elemParam = 1  and elementsMapVol is not empty
     if ((elemParam == 0) || (elemParam == 1 && elementsMapVol.empty())) {
         // for elemParam = 1 we only fill the elementsMapFac if the elmentsMapVol is empty
         // we're going to fill the elementsMapFac with all faces
-        SMDS_FaceIteratorPtr aFaceIter = myMesh->GetMeshDS()->facesIterator();
-        while (aFaceIter->more()) {
-            const SMDS_MeshFace* aFace = aFaceIter->next();
-            std::pair<int, std::vector<int> > apair;
-            apair.first = aFace->GetID();
-            int numNodes = aFace->NbNodes();
-            std::map<int, std::string>::iterator it = faceTypeMap.find(numNodes);
-            if (it != faceTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
-                    apair.second.push_back(aFace->GetNode(*jt)->GetID());
-                elementsMapFac[it->second].insert(apair);
-            }
-        }
+        SMDS_FaceIteratorPtr aFaceIter = meshDS->facesIterator();
+        while (aFaceIter->more())
+            addElement(elementsMapFac, faceTypeMap, aFaceIter->next());
     }
     if (elemParam == 2) {
         // we're going to fill the elementsMapFac with the facesOnly
         std::set<int> facesOnly = getFacesOnly();
-        for (std::set<int>::iterator itfa = facesOnly.begin(); itfa != facesOnly.end(); ++itfa) {
-            std::pair<int, std::vector<int> > apair;
-            apair.first = *itfa;
-            const SMDS_MeshElement* aFace = myMesh->GetMeshDS()->FindElement(*itfa);
-            int numNodes = aFace->NbNodes();
-            std::map<int, std::string>::iterator it = faceTypeMap.find(numNodes);
-            if (it != faceTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
-                    apair.second.push_back(aFace->GetNode(*jt)->GetID());
-                elementsMapFac[it->second].insert(apair);
-            }
-        }
+        for (std::set<int>::iterator itfa = facesOnly.begin(); itfa != facesOnly.end(); ++itfa)
+            addElement(elementsMapFac, faceTypeMap, meshDS->FindElement(*itfa));
     }
 
     // get edges
@@ -2045,37 +2098,15 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
     if ((elemParam == 0) || (elemParam == 1 && elementsMapVol.empty() && elementsMapFac.empty())) {
         // for elemParam = 1 we only fill the elementsMapEdg if the elmentsMapVol and elmentsMapFac are empty
         // we're going to fill the elementsMapEdg with all edges
-        SMDS_EdgeIteratorPtr aEdgeIter = myMesh->GetMeshDS()->edgesIterator();
-        while (aEdgeIter->more()) {
-            const SMDS_MeshEdge* aEdge = aEdgeIter->next();
-            std::pair<int, std::vector<int> > apair;
-            apair.first = aEdge->GetID();
-            int numNodes = aEdge->NbNodes();
-            std::map<int, std::string>::iterator it = edgeTypeMap.find(numNodes);
-            if (it != edgeTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
-                    apair.second.push_back(aEdge->GetNode(*jt)->GetID());
-                elementsMapEdg[it->second].insert(apair);
-            }
-        }
+        SMDS_EdgeIteratorPtr aEdgeIter = meshDS->edgesIterator();
+        while (aEdgeIter->more())
+            addElement(elementsMapEdg, edgeTypeMap, aEdgeIter->next());
     }
     if (elemParam == 2) {
         // we're going to fill the elementsMapEdg with the edgesOnly
         std::set<int> edgesOnly = getEdgesOnly();
-        for (std::set<int>::iterator ited = edgesOnly.begin(); ited != edgesOnly.end(); ++ited) {
-            std::pair<int, std::vector<int> > apair;
-            apair.first = *ited;
-            const SMDS_MeshElement* aEdge = myMesh->GetMeshDS()->FindElement(*ited);
-            int numNodes = aEdge->NbNodes();
-            std::map<int, std::string>::iterator it = edgeTypeMap.find(numNodes);
-            if (it != edgeTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
-                    apair.second.push_back(aEdge->GetNode(*jt)->GetID());
-                elementsMapEdg[it->second].insert(apair);
-            }
-        }
+        for (std::set<int>::iterator ited = edgesOnly.begin(); ited != edgesOnly.end(); ++ited)
+            addElement(elementsMapEdg, edgeTypeMap, meshDS->FindElement(*ited));
     }
 
     // write all data to file
@@ -2101,58 +2132,62 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
     anABAQUS_Output << "*Node, NSET=Nall" << std::endl;
     // This way we get sorted output.
     // See http://forum.freecadweb.org/viewtopic.php?f=18&t=12646&start=40#p103004
-    for (VertexMap::iterator it = vertexMap.begin(); it != vertexMap.end(); ++it) {
-        anABAQUS_Output << it->first << ", "
-            << it->second.x << ", "
-            << it->second.y << ", "
-            << it->second.z << std::endl;
-    }
+    std::sort(nodes.begin(), nodes.end(), [](const SMDS_MeshNode* n1, const SMDS_MeshNode* n2) {
+        return n1->GetID() < n2->GetID();
+    });
+    Base::Matrix4D mat = _Mtrx;
+    writeLines(anABAQUS_Output, nodes.size(), [&](std::ostream& str, std::size_t index) {
+        const SMDS_MeshNode* aNode = nodes[index];
+        Base::Vector3d current_node = mat * Base::Vector3d(aNode->X(),aNode->Y(),aNode->Z());
+        str << aNode->GetID() << ", "
+            << current_node.x << ", "
+            << current_node.y << ", "
+            << current_node.z << '\n';
+    });
     anABAQUS_Output << std::endl << std::endl;;
 
+    auto writeElements = [&](ElementsMap& elements, const char* comment, const char* elset) {
+        for (ElementsMap::iterator it = elements.begin(); it != elements.end(); ++it) {
+            anABAQUS_Output << "** " << comment << " elements" << std::endl;
+            anABAQUS_Output << "*Element, TYPE=" << it->first << ", ELSET=" << elset << std::endl;
 
-    // write volumes to file
-    std::string elsetname = "";
-    if (!elementsMapVol.empty()) {
-        for (ElementsMap::iterator it = elementsMapVol.begin(); it != elementsMapVol.end(); ++it) {
-            anABAQUS_Output << "** Volume elements" << std::endl;
-            anABAQUS_Output << "*Element, TYPE=" << it->first << ", ELSET=Evolumes" << std::endl;
-            for (NodesMap::iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
-                anABAQUS_Output << jt->first;
+            std::vector<const SMDS_MeshElement*>& elems = it->second;
+            std::sort(elems.begin(), elems.end(), [](const SMDS_MeshElement* e1, const SMDS_MeshElement* e2) {
+                return e1->GetID() < e2->GetID();
+            });
+
+            const std::vector<int>& order = elemOrderMap[it->first];
+            writeLines(anABAQUS_Output, elems.size(), [&](std::ostream& str, std::size_t index) {
+                const SMDS_MeshElement* aElem = elems[index];
+                str << aElem->GetID();
                 // Calculix allows max 16 entries in one line, a hexa20 has more !
-                int ct = 0;  // counter
-                bool first_line = true;
-                for (std::vector<int>::iterator kt = jt->second.begin(); kt != jt->second.end(); ++kt, ++ct) {
+                for (std::size_t ct = 0; ct < order.size(); ++ct) {
+                    int id = aElem->GetNode(order[ct])->GetID();
                     if (ct < 15) {
-                        anABAQUS_Output  << ", " << *kt;
+                        str << ", " << id;
                     }
                     else {
-                        if (first_line == true) {
-                            anABAQUS_Output << "," << std::endl;
-                            first_line = false;
-                        }
-                        anABAQUS_Output << *kt << ", ";
+                        if (ct == 15)
+                            str << ",\n";
+                        str << id << ", ";
                     }
                 }
-                anABAQUS_Output << std::endl;
-            }
+                str << '\n';
+            });
         }
+    };
+
+    // write volumes to file
+    std::string elsetname = "";
+    if (!elementsMapVol.empty()) {
+        writeElements(elementsMapVol, "Volume", "Evolumes");
         elsetname += "Evolumes";
         anABAQUS_Output << std::endl;
     }
 
     // write faces to file
     if (!elementsMapFac.empty()) {
-        for (ElementsMap::iterator it = elementsMapFac.begin(); it != elementsMapFac.end(); ++it) {
-            anABAQUS_Output << "** Face elements" << std::endl;
-            anABAQUS_Output << "*Element, TYPE=" << it->first << ", ELSET=Efaces" << std::endl;
-            for (NodesMap::iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
-                anABAQUS_Output << jt->first;
-                for (std::vector<int>::iterator kt = jt->second.begin(); kt != jt->second.end(); ++kt) {
-                    anABAQUS_Output << ", " << *kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
-        }
+        writeElements(elementsMapFac, "Face", "Efaces");
         if (elsetname == "")
             elsetname += "Efaces";
         else
@@ -2162,17 +2197,7 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
 
     // write edges to file
     if (!elementsMapEdg.empty()) {
-        for (ElementsMap::iterator it = elementsMapEdg.begin(); it != elementsMapEdg.end(); ++it) {
-            anABAQUS_Output << "** Edge elements" << std::endl;
-            anABAQUS_Output << "*Element, TYPE=" << it->first << ", ELSET=Eedges" << std::endl;
-            for (NodesMap::iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
-                anABAQUS_Output << jt->first;
-                for (std::vector<int>::iterator kt = jt->second.begin(); kt != jt->second.end(); ++kt) {
-                    anABAQUS_Output << ", " << *kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
-        }
+        writeElements(elementsMapEdg, "Edge", "Eedges");
         if (elsetname == "")
             elsetname += "Eedges";
         else
@@ -2221,15 +2246,18 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
             }
 
             // get and write group elements
-            std::set<int> ids;
+            std::vector<int> ids;
+            ids.reserve(myMesh->GetGroup(*it)->GetGroupDS()->Extent());
             SMDS_ElemIteratorPtr aElemIter = myMesh->GetGroup(*it)->GetGroupDS()->GetElements();
             while (aElemIter->more()) {
                 const SMDS_MeshElement* aElement = aElemIter->next();
-                ids.insert(aElement->GetID());
-            }
-            for (std::set<int>::iterator it = ids.begin(); it != ids.end(); ++it) {
-                anABAQUS_Output << *it << std::endl;
+                ids.push_back(aElement->GetID());
             }
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+            writeLines(anABAQUS_Output, ids.size(), [&](std::ostream& str, std::size_t index) {
+                str << ids[index] << '\n';
+            });
 
             // write newline after each group
             anABAQUS_Output << std::endl;
@@ -2324,12 +2352,245 @@ unsigned int FemMesh::getMemSize (void) const
     return 0;
 }
 
+namespace {
+
+// Identifies the binary format written by FemMesh::writeBinary()
+const uint32_t binaryMagic = 0xA0B1C2D3;
+const uint32_t binaryVersion = 0x010000;
+
+bool useBinaryDocFile()
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Fem/General");
+    return hGrp->GetBool("BinaryDocFile", false);
+}
+
+// Only the element kinds that can be re-created with the SMESHDS_Mesh::Add*WithID()
+// functions are supported. For anything else the UNV format is used.
+bool isBinaryElement(const SMDS_MeshElement* elem)
+{
+    if (elem->IsPoly())
+        return false;
+
+    switch (elem->GetType()) {
+    case SMDSAbs_Edge:
+        switch (elem->NbNodes()) {
+        case 2: case 3:
+            return true;
+        default:
+            return false;
+        }
+    case SMDSAbs_Face:
+        switch (elem->NbNodes()) {
+        case 3: case 4: case 6: case 8:
+            return true;
+        default:
+            return false;
+        }
+    case SMDSAbs_Volume:
+        switch (elem->NbNodes()) {
+        case 4: case 5: case 6: case 8: case 10: case 13: case 15: case 20:
+            return true;
+        default:
+            return false;
+        }
+    default:
+        return false;
+    }
+}
+
+const SMDS_MeshElement* addElement(SMESHDS_Mesh* meshds, uint32_t type,
+                                   const std::vector<const SMDS_MeshNode*>& n, int id)
+{
+    switch (type) {
+    case SMDSAbs_Edge:
+        switch (n.size()) {
+        case 2:
+            return meshds->AddEdgeWithID(n[0], n[1], id);
+        case 3:
+            return meshds->AddEdgeWithID(n[0], n[1], n[2], id);
+        }
+        break;
+    case SMDSAbs_Face:
+        switch (n.size()) {
+        case 3:
+            return meshds->AddFaceWithID(n[0], n[1], n[2], id);
+        case 4:
+            return meshds->AddFaceWithID(n[0], n[1], n[2], n[3], id);
+        case 6:
+            return meshds->AddFaceWithID(n[0], n[1], n[2], n[3], n[4], n[5], id);
+        case 8:
+            return meshds->AddFaceWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], id);
+        }
+        break;
+    case SMDSAbs_Volume:
+        switch (n.size()) {
+        case 4:
+            return meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], id);
+        case 5:
+            return meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], id);
+        case 6:
+            return meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], id);
+        case 8:
+            return meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], id);
+        case 10:
+            return meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], id);
+        case 13:
+            return meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9],
+                                           n[10], n[11], n[12], id);
+        case 15:
+            return meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9],
+                                           n[10], n[11], n[12], n[13], n[14], id);
+        case 20:
+            return meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9],
+                                           n[10], n[11], n[12], n[13], n[14], n[15], n[16], n[17], n[18], n[19], id);
+        }
+        break;
+    }
+
+    return nullptr;
+}
+
+}
+
+bool FemMesh::canWriteBinary() const
+{
+    SMDS_ElemIteratorPtr aElemIter = myMesh->GetMeshDS()->elementsIterator();
+    while (aElemIter->more()) {
+        if (!isBinaryElement(aElemIter->next()))
+            return false;
+    }
+    return true;
+}
+
+void FemMesh::writeBinary(std::ostream& out) const
+{
+    Base::OutputStream str(out);
+    str << binaryMagic << binaryVersion;
+
+    SMESHDS_Mesh* meshds = myMesh->GetMeshDS();
+
+    // nodes
+    str << static_cast<uint32_t>(meshds->NbNodes());
+    SMDS_NodeIteratorPtr aNodeIter = meshds->nodesIterator();
+    while (aNodeIter->more()) {
+        const SMDS_MeshNode* aNode = aNodeIter->next();
+        str << static_cast<int32_t>(aNode->GetID()) << aNode->X() << aNode->Y() << aNode->Z();
+    }
+
+    // elements
+    std::vector<const SMDS_MeshElement*> elements;
+    elements.reserve(meshds->NbEdges() + meshds->NbFaces() + meshds->NbVolumes());
+    SMDS_ElemIteratorPtr aElemIter = meshds->elementsIterator();
+    while (aElemIter->more())
+        elements.push_back(aElemIter->next());
+
+    str << static_cast<uint32_t>(elements.size());
+    for (const SMDS_MeshElement* aElem : elements) {
+        int numNodes = aElem->NbNodes();
+        str << static_cast<uint32_t>(aElem->GetType()) << static_cast<uint32_t>(numNodes)
+            << static_cast<int32_t>(aElem->GetID());
+        for (int i = 0; i < numNodes; i++)
+            str << static_cast<int32_t>(aElem->GetNode(i)->GetID());
+    }
+
+    // groups
+    std::list<int> grpIds = myMesh->GetGroupIds();
+    str << static_cast<uint32_t>(grpIds.size());
+    for (auto it : grpIds) {
+        SMESHDS_GroupBase* groupDS = myMesh->GetGroup(it)->GetGroupDS();
+        std::string name = myMesh->GetGroup(it)->GetName();
+        str << static_cast<uint32_t>(groupDS->GetType()) << static_cast<uint32_t>(name.size());
+        out.write(name.c_str(), name.size());
+
+        std::vector<int32_t> ids;
+        SMDS_ElemIteratorPtr aIter = groupDS->GetElements();
+        while (aIter->more())
+            ids.push_back(aIter->next()->GetID());
+        str << static_cast<uint32_t>(ids.size());
+        for (int32_t id : ids)
+            str << id;
+    }
+}
+
+void FemMesh::readBinary(std::istream& in)
+{
+    Base::InputStream str(in);
+    uint32_t numNodes = 0;
+    str >> numNodes;
+
+    SMESHDS_Mesh* meshds = myMesh->GetMeshDS();
+    for (uint32_t i = 0; i < numNodes; i++) {
+        int32_t id;
+        double x, y, z;
+        str >> id >> x >> y >> z;
+        meshds->AddNodeWithID(x, y, z, id);
+    }
+
+    uint32_t numElements = 0;
+    str >> numElements;
+    std::vector<const SMDS_MeshNode*> nodes;
+    for (uint32_t i = 0; i < numElements; i++) {
+        uint32_t type, count;
+        int32_t id;
+        str >> type >> count >> id;
+        if (!in || count > 20)
+            throw Base::BadFormatError("Invalid data structure");
+
+        nodes.resize(count);
+        for (uint32_t j = 0; j < count; j++) {
+            int32_t nodeId;
+            str >> nodeId;
+            nodes[j] = meshds->FindNode(nodeId);
+            if (!nodes[j])
+                throw Base::BadFormatError("Invalid node index");
+        }
+
+        if (!addElement(meshds, type, nodes, id))
+            throw Base::BadFormatError("Unsupported element type");
+    }
+
+    uint32_t numGroups = 0;
+    str >> numGroups;
+    for (uint32_t i = 0; i < numGroups; i++) {
+        uint32_t type, length;
+        str >> type >> length;
+        if (!in)
+            throw Base::BadFormatError("Reading from stream failed");
+        std::string name(length, '\0');
+        if (length > 0)
+            in.read(&name[0], length);
+
+        uint32_t count = 0;
+        str >> count;
+
+        int aId = -1;
+        SMDSAbs_ElementType groupType = static_cast<SMDSAbs_ElementType>(type);
+        SMESH_Group* group = myMesh->AddGroup(groupType, name.c_str(), aId);
+        SMESHDS_Group* groupDS = group ? dynamic_cast<SMESHDS_Group*>(group->GetGroupDS()) : nullptr;
+        for (uint32_t j = 0; j < count; j++) {
+            int32_t id;
+            str >> id;
+            if (!groupDS)
+                continue;
+            const SMDS_MeshElement* aElem = groupType == SMDSAbs_Node
+                    ? meshds->FindNode(id) : meshds->FindElement(id);
+            if (aElem)
+                groupDS->SMDSGroup().Add(aElem);
+        }
+    }
+
+    if (!in)
+        throw Base::BadFormatError("Reading from stream failed");
+    meshds->Modified();
+}
+
 void FemMesh::Save (Base::Writer &writer) const
 {
     if (!writer.isForceXML()) {
         //See SaveDocFile(), RestoreDocFile()
+        bool binary = useBinaryDocFile() && canWriteBinary();
         writer.Stream() << writer.ind() << "<FemMesh file=\"" ;
-        writer.Stream() << writer.addFile("FemMesh.unv", this) << "\"";
+        writer.Stream() << writer.addFile(binary ? "FemMesh.bin" : "FemMesh.unv", this) << "\"";
         writer.Stream() << " a11=\"" <<  _Mtrx[0][0] << "\" a12=\"" <<  _Mtrx[0][1] << "\" a13=\"" <<  _Mtrx[0][2] << "\" a14=\"" <<  _Mtrx[0][3] << "\"";
         writer.Stream() << " a21=\"" <<  _Mtrx[1][0] << "\" a22=\"" <<  _Mtrx[1][1] << "\" a23=\"" <<  _Mtrx[1][2] << "\" a24=\"" <<  _Mtrx[1][3] << "\"";
         writer.Stream() << " a31=\"" <<  _Mtrx[2][0] << "\" a32=\"" <<  _Mtrx[2][1] << "\" a33=\"" <<  _Mtrx[2][2] << "\" a34=\"" <<  _Mtrx[2][3] << "\"";
@@ -2380,6 +2641,13 @@ void FemMesh::Restore(Base::XMLReader &reader)
 
 void FemMesh::SaveDocFile (Base::Writer &writer) const
 {
+    // the binary format avoids the round trip through a temporary UNV file
+    // but can't be read by older versions
+    if (useBinaryDocFile() && canWriteBinary()) {
+        writeBinary(writer.Stream());
+        return;
+    }
+
     // create a temporary file and copy the content to the zip stream
     Base::FileInfo fi(App::Application::getTempFileName().c_str());
 
@@ -2398,11 +2666,33 @@ void FemMesh::SaveDocFile (Base::Writer &writer) const
 
 void FemMesh::RestoreDocFile(Base::Reader &reader)
 {
+    // check for the binary format written by writeBinary(), it starts with
+    // the little-endian magic number
+    char head[4];
+    reader.read(head, sizeof(head));
+    std::streamsize num = reader.gcount();
+    if (num == 4 && static_cast<unsigned char>(head[0]) == (binaryMagic & 0xff) &&
+                    static_cast<unsigned char>(head[1]) == ((binaryMagic >> 8) & 0xff) &&
+                    static_cast<unsigned char>(head[2]) == ((binaryMagic >> 16) & 0xff) &&
+                    static_cast<unsigned char>(head[3]) == ((binaryMagic >> 24) & 0xff)) {
+        Base::InputStream str(reader);
+        uint32_t version = 0;
+        str >> version;
+        if (version != binaryVersion)
+            throw Base::BadFormatError("Unsupported version of binary FEM mesh");
+        readBinary(reader);
+        return;
+    }
+
     // create a temporary file and copy the content from the zip stream
     Base::FileInfo fi(App::Application::getTempFileName().c_str());
 
     // read in the ASCII file and write back to the file stream
     Base::ofstream file(fi, std::ios::out | std::ios::binary);
+    // the bytes consumed by the format check belong to the UNV file
+    if (num > 0)
+        file.write(head, num);
+    reader.clear();
     if (reader)
         reader >> file.rdbuf();
     file.close();
@@ -94,6 +94,11 @@ public:
     std::set<int> getNodesBySolid(const TopoDS_Solid &solid) const;
     /// retrieving by face
     std::set<int> getNodesByFace(const TopoDS_Face &face) const;
+    /** retrieving by several faces at once
+     * The mesh nodes are only collected and sorted once for all faces, so this
+     * is faster than calling getNodesByFace() for each face.
+     */
+    std::vector<std::set<int> > getNodesByFaces(const std::vector<TopoDS_Face> &faces) const;
     /// retrieving by edge
     std::set<int> getNodesByEdge(const TopoDS_Edge &edge) const;
     /// retrieving by vertex
@@ -172,6 +177,9 @@ private:
     void readNastran95(const std::string &Filename);
     void readZ88(const std::string &Filename);
     void readAbaqus(const std::string &Filename);
+    bool canWriteBinary() const;
+    void writeBinary(std::ostream&) const;
+    void readBinary(std::istream&);
 
 private:
     /// positioning matrix
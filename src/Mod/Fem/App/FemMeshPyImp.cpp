@@ -861,6 +861,49 @@ PyObject* FemMeshPy::getNodesByFace(PyObject *args)
     }
 }
 
+PyObject* FemMeshPy::getNodesByFaces(PyObject *args)
+{
+    PyObject *seq;
+    if (!PyArg_ParseTuple(args, "O", &seq))
+         return 0;
+
+    try {
+        std::vector<TopoDS_Face> faces;
+        Py::Sequence list(seq);
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+            PyObject* item = (*it).ptr();
+            if (!PyObject_TypeCheck(item, &(Part::TopoShapeFacePy::Type))) {
+                PyErr_SetString(PyExc_TypeError, "sequence of faces expected");
+                return 0;
+            }
+            const TopoDS_Shape& sh = static_cast<Part::TopoShapeFacePy*>(item)->getTopoShapePtr()->getShape();
+            if (sh.IsNull()) {
+                PyErr_SetString(Base::BaseExceptionFreeCADError, "Face is empty");
+                return 0;
+            }
+            faces.push_back(TopoDS::Face(sh));
+        }
+
+        Py::List ret;
+        std::vector<std::set<int> > resultSets = getFemMeshPtr()->getNodesByFaces(faces);
+        for (const auto& resultSet : resultSets) {
+            Py::List nodes;
+            for (std::set<int>::const_iterator it = resultSet.begin();it!=resultSet.end();++it)
+                nodes.append(Py::Long(*it));
+            ret.append(nodes);
+        }
+
+        return Py::new_reference_to(ret);
+    }
+    catch (Standard_Failure& e) {
+        PyErr_SetString(Base::BaseExceptionFreeCADError, e.GetMessageString());
+        return 0;
+    }
+    catch (Py::Exception&) {
+        return 0;
+    }
+}
+
 PyObject* FemMeshPy::getNodesByEdge(PyObject *args)
 {
     PyObject *pW;
@@ -33,6 +33,7 @@
 
 # include <BRepBuilderAPI_Copy.hxx>
 # include <BRepTools.hxx>
+# include <Standard_Failure.hxx>
 
 # ifdef FCWithNetgen
 #  include <NETGENPlugin_SimpleHypothesis_3D.hxx>
@@ -48,6 +49,10 @@
 #include <Base/Placement.h>
 #include <Mod/Part/App/PartFeature.h>
 #include <Base/Console.h>
+#include <Base/Sequencer.h>
+
+#include <QThread>
+#include <QtConcurrentRun>
 
 using namespace Fem;
 using namespace App;
@@ -101,7 +106,53 @@ App::DocumentObjectExecReturn *FemMeshShapeNetgenObject::execute(void)
     myNetGenMesher.SetParameters( tet);
     newMesh.getSMesh()->ShapeToMesh(shape);
 
-    myNetGenMesher.Compute();
+    // netgen runs in a worker thread while this thread shows its progress and
+    // lets the user cancel it
+    std::string error;
+    QFuture<void> future = QtConcurrent::run([&myNetGenMesher, &error]() {
+        try {
+            myNetGenMesher.Compute();
+        }
+        catch (const Standard_Failure& e) {
+            error = e.GetMessageString();
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+        }
+        catch (...) {
+            error = "Unknown exception in Netgen";
+        }
+    });
+
+    bool canceled = false;
+    {
+#ifdef NETGENPLUGIN_MESHER_PROGRESS
+        NETGENPlugin_Mesher::SetNetgenTerminate(false);
+        Base::SequencerLauncher seq("Meshing with Netgen...", 100);
+#else
+        Base::SequencerLauncher seq("Meshing with Netgen...", 0);
+#endif
+        while (!future.isFinished()) {
+#ifdef NETGENPLUGIN_MESHER_PROGRESS
+            seq.setProgress(static_cast<size_t>(std::max(0.0, NETGENPlugin_Mesher::GetNetgenPercent())));
+            if (!canceled && seq.wasCanceled()) {
+                NETGENPlugin_Mesher::SetNetgenTerminate(true);
+                canceled = true;
+            }
+#else
+            seq.next();
+#endif
+            QThread::msleep(50);
+        }
+    }
+
+#ifdef NETGENPLUGIN_MESHER_PROGRESS
+    NETGENPlugin_Mesher::SetNetgenTerminate(false);
+#endif
+    if (canceled)
+        return new App::DocumentObjectExecReturn("Netgen meshing was canceled", this);
+    if (!error.empty())
+        return new App::DocumentObjectExecReturn(error, this);
 
     // throw Base::RuntimeError("Compute Done\n");
 
@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 # include <Python.h>
+# include <vtkCallbackCommand.h>
 # include <vtkFieldData.h>
 # include <vtkPointData.h>
 #endif
@@ -32,6 +33,7 @@
 #include "FemPostFilter.h"
 #include "FemPostPipeline.h"
 #include <Base/Console.h>
+#include <Base/Sequencer.h>
 #include <App/Document.h>
 #include <App/DocumentObjectPy.h>
 
@@ -41,6 +43,20 @@ using namespace App;
 
 PROPERTY_SOURCE(Fem::FemPostFilter, Fem::FemPostObject)
 
+namespace {
+
+// Forward the progress of a VTK algorithm to the sequencer and abort it if the user cancels
+void onFilterProgress(vtkObject* caller, unsigned long, void* clientData, void* callData)
+{
+    Base::SequencerLauncher* seq = static_cast<Base::SequencerLauncher*>(clientData);
+    double progress = *static_cast<double*>(callData);
+    seq->setProgress(static_cast<size_t>(progress * 100.0));
+    if (seq->wasCanceled())
+        static_cast<vtkAlgorithm*>(caller)->SetAbortExecute(1);
+}
+
+}
+
 
 FemPostFilter::FemPostFilter()
 {
@@ -71,25 +87,63 @@ DocumentObjectExecReturn* FemPostFilter::execute(void) {
 
     if(!m_pipelines.empty() && !m_activePipeline.empty()) {
         FemPostFilter::FilterPipeline& pipe = m_pipelines[m_activePipeline];
+        // the input is only set again if it has changed, so VTK can skip the
+        // algorithms whose input and parameters are unchanged
+        vtkDataObject* input = getInputData();
+        vtkAlgorithm* target = nullptr;
         if (m_activePipeline.length() >= 11) {
             std::string LineClip = m_activePipeline.substr(0,13);
             std::string PointClip = m_activePipeline.substr(0,11);
             if ((LineClip == "DataAlongLine") || (PointClip == "DataAtPoint")) {
-                pipe.filterSource->SetSourceData(getInputData());
-                pipe.filterTarget->Update();
-
-                Data.setValue(pipe.filterTarget->GetOutputDataObject(0));
+                if (pipe.filterSource->GetSource() != input)
+                    pipe.filterSource->SetSourceData(input);
+                target = pipe.filterTarget;
             }
         } else {
-            pipe.source->SetInputDataObject(getInputData());
-            pipe.target->Update();
-            Data.setValue(pipe.target->GetOutputDataObject(0));
+            if (pipe.source->GetNumberOfInputConnections(0) == 0 || pipe.source->GetInputDataObject(0, 0) != input)
+                pipe.source->SetInputDataObject(input);
+            target = pipe.target;
         }
 
+        if (target) {
+            if (!runFilter(target))
+                return new App::DocumentObjectExecReturn("Post-processing filter was canceled");
+
+            // only pass on output that was re-generated, otherwise the filters
+            // downstream would run again although nothing has changed
+            vtkDataObject* output = target->GetOutputDataObject(0);
+            if (output != m_lastOutput || output->GetMTime() != m_lastOutputTime) {
+                Data.setValue(output);
+                m_lastOutput = output;
+                m_lastOutputTime = output->GetMTime();
+            }
+        }
     }
     return StdReturn;
 }
 
+bool FemPostFilter::runFilter(vtkAlgorithm* target) {
+
+    Base::SequencerLauncher seq("Running post-processing filter...", 100);
+    vtkSmartPointer<vtkCallbackCommand> progress = vtkSmartPointer<vtkCallbackCommand>::New();
+    progress->SetCallback(onFilterProgress);
+    progress->SetClientData(&seq);
+    unsigned long tag = target->AddObserver(vtkCommand::ProgressEvent, progress);
+
+    target->Update();
+    target->RemoveObserver(tag);
+
+    if (target->GetAbortExecute()) {
+        // make sure the filter runs again on the next recompute
+        target->SetAbortExecute(0);
+        target->Modified();
+        m_lastOutput = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
 vtkDataObject* FemPostFilter::getInputData() {
 
     if(Input.getValue()) {
@@ -58,6 +58,8 @@ public:
 
 protected:
     vtkDataObject* getInputData();
+    /// Update the algorithm and show its progress, returns false if the user canceled it
+    bool runFilter(vtkAlgorithm* target);
 
     //pipeline handling for derived filter
     struct FilterPipeline {
@@ -73,6 +75,9 @@ private:
     //handling of multiple pipelines which can be the filter
     std::map<std::string, FilterPipeline> m_pipelines;
     std::string m_activePipeline;
+    //the last output passed to Data
+    vtkDataObject* m_lastOutput = nullptr;
+    vtkMTimeType m_lastOutputTime = 0;
 };
 
 class AppFemExport FemPostClipFilter : public FemPostFilter {
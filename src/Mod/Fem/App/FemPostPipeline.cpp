@@ -26,6 +26,7 @@
 #ifndef _PreComp_
 # include <Python.h>
 # include <SMESH_Mesh.hxx>
+# include <SMESHDS_Mesh.hxx>
 # include <vtkDataSetReader.h>
 # include <vtkGeometryFilter.h>
 # include <vtkStructuredGrid.h>
@@ -44,6 +45,7 @@
 #include "FemMesh.h"
 #include "FemMeshObject.h"
 #include "FemVTKTools.h"
+#include "FemFrdReader.h"
 
 #include <Base/Console.h>
 #include <App/Document.h>
@@ -124,7 +126,8 @@ bool FemPostPipeline::canRead(Base::FileInfo File) {
         File.hasExtension("vts") ||
         File.hasExtension("vtr") ||
         File.hasExtension("vti") ||
-        File.hasExtension("vtu"))
+        File.hasExtension("vtu") ||
+        File.hasExtension("frd"))
         return true;
 
     return false;
@@ -148,11 +151,25 @@ void FemPostPipeline::read(Base::FileInfo File) {
         readXMLFile<vtkXMLImageDataReader>(File.filePath());
     else if (File.hasExtension("vtk"))
         readXMLFile<vtkDataSetReader>(File.filePath());
+    else if (File.hasExtension("frd"))
+        readFrdFile(File.filePath());
     else
         throw Base::FileException("Unknown extension");
 }
 
 
+//! CalculiX results are read without a result object, the last step is shown
+void FemPostPipeline::readFrdFile(const std::string& file) {
+
+    FrdReader reader(file);
+    if (reader.countSteps() == 0)
+        throw Base::FileException("File contains no results", file.c_str());
+
+    vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    reader.readGrid(reader.countSteps() - 1, grid);
+    Data.setValue(grid);
+}
+
 // PyObject *FemPostPipeline::getPyObject()
 // {
 //     if (PythonObject.is(Py::_None())){
@@ -257,11 +274,25 @@ void FemPostPipeline::load(FemResultObject* res) {
         return;
     }
 
-    //first copy the mesh over
+    //first copy the mesh over, the points and cells are shared with the
+    //cached grid if the mesh didn't change since the last load
     // ***************************
     const FemMesh& mesh = static_cast<FemMeshObject*>(res->Mesh.getValue())->FemMesh.getValue();
+    const SMESHDS_Mesh* meshDS = const_cast<SMESH_Mesh*>(mesh.getSMesh())->GetMeshDS();
+    if (static_cast<FemMesh*>(cachedMesh) != &mesh
+            || cachedMeshTime != static_cast<unsigned long>(meshDS->GetMTime())
+            || cachedNodes != meshDS->NbNodes()
+            || cachedElements != meshDS->GetMeshInfo().NbElements()) {
+        cachedGrid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+        FemVTKTools::exportVTKMesh(&mesh, cachedGrid);
+        cachedMesh = const_cast<FemMesh*>(&mesh);
+        cachedMeshTime = static_cast<unsigned long>(meshDS->GetMTime());
+        cachedNodes = meshDS->NbNodes();
+        cachedElements = meshDS->GetMeshInfo().NbElements();
+    }
+
     vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    FemVTKTools::exportVTKMesh(&mesh, grid);
+    grid->ShallowCopy(cachedGrid);
 
     //Now copy the point data over
     // ***************************
@@ -28,9 +28,11 @@
 #include "FemPostFilter.h"
 #include "FemPostFunction.h"
 #include "FemResultObject.h"
+#include "FemMesh.h"
 
 #include <vtkSmartPointer.h>
 #include <vtkDataSet.h>
+#include <vtkUnstructuredGrid.h>
 
 namespace Fem
 {
@@ -73,6 +75,16 @@ protected:
 private:
     static const char* ModeEnums[];
 
+    /// The VTK grid of the last loaded result mesh. Results of several time steps
+    /// share the same mesh, so its points and cells are converted only once.
+    Base::Reference<FemMesh> cachedMesh;
+    unsigned long cachedMeshTime = 0;
+    int cachedNodes = 0;
+    int cachedElements = 0;
+    vtkSmartPointer<vtkUnstructuredGrid> cachedGrid;
+
+    void readFrdFile(const std::string& file);
+
     template<class TReader> void readXMLFile(std::string file) {
 
         vtkSmartPointer<TReader> reader = vtkSmartPointer<TReader>::New();
@@ -28,6 +28,7 @@
 # include <Python.h>
 # include <cstdlib>
 # include <memory>
+# include <algorithm>
 # include <cmath>
 # include <map>
 
@@ -61,6 +62,8 @@
 # include <vtkDataArray.h>
 # include <vtkDoubleArray.h>
 # include <vtkIdList.h>
+# include <vtkIdTypeArray.h>
+# include <vtkPoints.h>
 # include <vtkCellTypes.h>
 # include <vtkTriangle.h>
 # include <vtkQuad.h>
@@ -90,6 +93,8 @@
 #include "FemMeshProperty.h"
 #include "FemAnalysis.h"
 
+#include <QtConcurrentMap>
+
 namespace Fem
 {
 
@@ -225,83 +230,84 @@ FemMesh* FemVTKTools::readVTKMesh(const char* filename, FemMesh* mesh)
     return mesh;
 }
 
-void exportFemMeshFaces(vtkSmartPointer<vtkUnstructuredGrid> grid, const SMDS_FaceIteratorPtr& aFaceIter)
+// Run func(first, last) in parallel on blocks of [0, count)
+template<class Func> void parallelBlocks(std::size_t count, Func func)
 {
-    Base::Console().Log("  Start: VTK mesh builder faces.\n");
-
-    vtkSmartPointer<vtkCellArray> triangleArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadTriangleArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadQuadArray = vtkSmartPointer<vtkCellArray>::New();
-
-    for (;aFaceIter->more();)
-    {
-        const SMDS_MeshFace* aFace = aFaceIter->next();
-
-        //triangle
-        if(aFace->NbNodes() == 3)
-        {
-            vtkSmartPointer<vtkTriangle> tria = vtkSmartPointer<vtkTriangle>::New();
-            tria->GetPointIds()->SetId(0, aFace->GetNode(0)->GetID()-1);
-            tria->GetPointIds()->SetId(1, aFace->GetNode(1)->GetID()-1);
-            tria->GetPointIds()->SetId(2, aFace->GetNode(2)->GetID()-1);
+    const std::size_t blockSize = 4096;
+    std::vector<std::size_t> blocks;
+    for (std::size_t i = 0; i < count; i += blockSize)
+        blocks.push_back(i);
+
+    QtConcurrent::blockingMap(blocks, [&](std::size_t first) {
+        func(first, std::min(first + blockSize, count));
+    });
+}
 
-            triangleArray->InsertNextCell(tria);
+// Elements of the same node count are exported as one VTK cell type
+struct CellBlock
+{
+    int nbNodes;
+    int vtkType;
+    std::vector<const SMDS_MeshElement*> elements;
+};
+
+// Fill the connectivity of all elements of a block in the legacy layout
+// (n, id0, id1, ...) directly in the buffer of the cell array
+vtkSmartPointer<vtkCellArray> exportCellBlock(const CellBlock& block)
+{
+    const std::size_t stride = block.nbNodes + 1;
+    vtkSmartPointer<vtkIdTypeArray> ids = vtkSmartPointer<vtkIdTypeArray>::New();
+    ids->SetNumberOfValues(static_cast<vtkIdType>(block.elements.size() * stride));
+    vtkIdType* data = ids->GetPointer(0);
+
+    parallelBlocks(block.elements.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            const SMDS_MeshElement* elem = block.elements[i];
+            vtkIdType* cell = data + i * stride;
+            cell[0] = block.nbNodes;
+            for (int j = 0; j < block.nbNodes; j++)
+                cell[j+1] = elem->GetNode(j)->GetID()-1;
         }
-        //quad
-        else if(aFace->NbNodes() == 4)
-        {
-            vtkSmartPointer<vtkQuad> quad = vtkSmartPointer<vtkQuad>::New();
-            quad->GetPointIds()->SetId(0, aFace->GetNode(0)->GetID()-1);
-            quad->GetPointIds()->SetId(1, aFace->GetNode(1)->GetID()-1);
-            quad->GetPointIds()->SetId(2, aFace->GetNode(2)->GetID()-1);
-            quad->GetPointIds()->SetId(3, aFace->GetNode(3)->GetID()-1);
+    });
 
-            quadArray->InsertNextCell(quad);
-        }
-        //quadratic triangle
-        else if (aFace->NbNodes() == 6)
-        {
-            vtkSmartPointer<vtkQuadraticTriangle> tria = vtkSmartPointer<vtkQuadraticTriangle>::New();
-            tria->GetPointIds()->SetId(0, aFace->GetNode(0)->GetID()-1);
-            tria->GetPointIds()->SetId(1, aFace->GetNode(1)->GetID()-1);
-            tria->GetPointIds()->SetId(2, aFace->GetNode(2)->GetID()-1);
-            tria->GetPointIds()->SetId(3, aFace->GetNode(3)->GetID()-1);
-            tria->GetPointIds()->SetId(4, aFace->GetNode(4)->GetID()-1);
-            tria->GetPointIds()->SetId(5, aFace->GetNode(5)->GetID()-1);
-            quadTriangleArray->InsertNextCell(tria);
-        }
-        //quadratic quad
-        else if(aFace->NbNodes() == 8)
-        {
-            vtkSmartPointer<vtkQuadraticQuad> quad = vtkSmartPointer<vtkQuadraticQuad>::New();
-            quad->GetPointIds()->SetId(0, aFace->GetNode(0)->GetID()-1);
-            quad->GetPointIds()->SetId(1, aFace->GetNode(1)->GetID()-1);
-            quad->GetPointIds()->SetId(2, aFace->GetNode(2)->GetID()-1);
-            quad->GetPointIds()->SetId(3, aFace->GetNode(3)->GetID()-1);
-            quad->GetPointIds()->SetId(4, aFace->GetNode(4)->GetID()-1);
-            quad->GetPointIds()->SetId(5, aFace->GetNode(5)->GetID()-1);
-            quad->GetPointIds()->SetId(6, aFace->GetNode(6)->GetID()-1);
-            quad->GetPointIds()->SetId(7, aFace->GetNode(7)->GetID()-1);
-
-            quadQuadArray->InsertNextCell(quad);
-        }
-        else
-        {
-            throw std::runtime_error("Face not yet supported by FreeCAD's VTK mesh builder\n");
-        }
+    vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetCells(static_cast<vtkIdType>(block.elements.size()), ids);
+    return cells;
+}
+
+// The blocks are passed to the grid in the given order. Every call of SetCells()
+// replaces the cells of the grid, so only the last non-empty block is kept as before.
+template<class TIterator> void exportFemMeshElements(vtkSmartPointer<vtkUnstructuredGrid> grid, const TIterator& aIter,
+                                                     std::vector<CellBlock>& blocks, const char* error)
+{
+    while (aIter->more()) {
+        const SMDS_MeshElement* aElem = aIter->next();
+        int nbNodes = aElem->NbNodes();
+        std::vector<CellBlock>::iterator it = std::find_if(blocks.begin(), blocks.end(), [nbNodes](const CellBlock& block) {
+            return block.nbNodes == nbNodes;
+        });
+        if (it == blocks.end())
+            throw std::runtime_error(error);
+        it->elements.push_back(aElem);
     }
-    if(triangleArray->GetNumberOfCells()>0)
-       grid->SetCells(VTK_TRIANGLE, triangleArray);
 
-    if(quadArray->GetNumberOfCells()>0)
-       grid->SetCells(VTK_QUAD, quadArray);
+    for (const CellBlock& block : blocks) {
+        if (!block.elements.empty())
+            grid->SetCells(block.vtkType, exportCellBlock(block));
+    }
+}
 
-    if(quadTriangleArray->GetNumberOfCells()>0)
-       grid->SetCells(VTK_QUADRATIC_TRIANGLE, quadTriangleArray);
+void exportFemMeshFaces(vtkSmartPointer<vtkUnstructuredGrid> grid, const SMDS_FaceIteratorPtr& aFaceIter)
+{
+    Base::Console().Log("  Start: VTK mesh builder faces.\n");
 
-    if(quadQuadArray->GetNumberOfCells()>0)
-       grid->SetCells(VTK_QUADRATIC_QUAD, quadQuadArray);
+    std::vector<CellBlock> blocks = {
+        {3, VTK_TRIANGLE, {}},
+        {4, VTK_QUAD, {}},
+        {6, VTK_QUADRATIC_TRIANGLE, {}},
+        {8, VTK_QUADRATIC_QUAD, {}}
+    };
+    exportFemMeshElements(grid, aFaceIter, blocks, "Face not yet supported by FreeCAD's VTK mesh builder\n");
 
     Base::Console().Log("  End: VTK mesh builder faces.\n");
 }
@@ -310,124 +316,17 @@ void exportFemMeshCells(vtkSmartPointer<vtkUnstructuredGrid> grid, const SMDS_Vo
 {
     Base::Console().Log("  Start: VTK mesh builder volumes.\n");
 
-    vtkSmartPointer<vtkCellArray> tetraArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> pyramidArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> wedgeArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> hexaArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadTetraArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadPyramidArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadWedgeArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadHexaArray = vtkSmartPointer<vtkCellArray>::New();
-
-    for (;aVolIter->more();)
-    {
-        const SMDS_MeshVolume* aVol = aVolIter->next();
-
-        if (aVol->NbNodes() == 4) { // tetra4
-            Base::Console().Log("    Volume tetra4\n");
-            vtkSmartPointer<vtkTetra> cell = vtkSmartPointer<vtkTetra>::New();
-            cell->GetPointIds()->SetId(0, aVol->GetNode(0)->GetID()-1);
-            cell->GetPointIds()->SetId(1, aVol->GetNode(1)->GetID()-1);
-            cell->GetPointIds()->SetId(2, aVol->GetNode(2)->GetID()-1);
-            cell->GetPointIds()->SetId(3, aVol->GetNode(3)->GetID()-1);
-            tetraArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 5) { // pyra5
-            Base::Console().Log("    Volume pyra5\n");
-            vtkSmartPointer<vtkPyramid> cell = vtkSmartPointer<vtkPyramid>::New();
-            cell->GetPointIds()->SetId(0, aVol->GetNode(0)->GetID()-1);
-            cell->GetPointIds()->SetId(1, aVol->GetNode(1)->GetID()-1);
-            cell->GetPointIds()->SetId(2, aVol->GetNode(2)->GetID()-1);
-            cell->GetPointIds()->SetId(3, aVol->GetNode(3)->GetID()-1);
-            cell->GetPointIds()->SetId(4, aVol->GetNode(4)->GetID()-1);
-            pyramidArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 6) { // penta6
-            Base::Console().Log("    Volume penta6\n");
-            vtkSmartPointer<vtkWedge> cell = vtkSmartPointer<vtkWedge>::New();
-            cell->GetPointIds()->SetId(0, aVol->GetNode(0)->GetID()-1);
-            cell->GetPointIds()->SetId(1, aVol->GetNode(1)->GetID()-1);
-            cell->GetPointIds()->SetId(2, aVol->GetNode(2)->GetID()-1);
-            cell->GetPointIds()->SetId(3, aVol->GetNode(3)->GetID()-1);
-            cell->GetPointIds()->SetId(4, aVol->GetNode(4)->GetID()-1);
-            cell->GetPointIds()->SetId(5, aVol->GetNode(5)->GetID()-1);
-            wedgeArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 8) { // hexa8
-            Base::Console().Log("    Volume hexa8\n");
-            vtkSmartPointer<vtkHexahedron> cell = vtkSmartPointer<vtkHexahedron>::New();
-            cell->GetPointIds()->SetId(0, aVol->GetNode(0)->GetID()-1);
-            cell->GetPointIds()->SetId(1, aVol->GetNode(1)->GetID()-1);
-            cell->GetPointIds()->SetId(2, aVol->GetNode(2)->GetID()-1);
-            cell->GetPointIds()->SetId(3, aVol->GetNode(3)->GetID()-1);
-            cell->GetPointIds()->SetId(4, aVol->GetNode(4)->GetID()-1);
-            cell->GetPointIds()->SetId(5, aVol->GetNode(5)->GetID()-1);
-            cell->GetPointIds()->SetId(6, aVol->GetNode(6)->GetID()-1);
-            cell->GetPointIds()->SetId(7, aVol->GetNode(7)->GetID()-1);
-            hexaArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 10) { // tetra10
-            Base::Console().Log("    Volume tetra10\n");
-            vtkSmartPointer<vtkQuadraticTetra> tetra = vtkSmartPointer<vtkQuadraticTetra>::New();
-            for(int i=0; i<10; i++){
-                tetra->GetPointIds()->SetId(i, aVol->GetNode(i)->GetID()-1);
-            }
-            quadTetraArray->InsertNextCell(tetra);
-        }
-
-        else if (aVol->NbNodes() == 13) { // pyra13
-            Base::Console().Log("    Volume pyra13\n");
-            vtkSmartPointer<vtkQuadraticPyramid> cell = vtkSmartPointer<vtkQuadraticPyramid>::New();
-            for(int i=0; i<13; i++){
-                cell->GetPointIds()->SetId(i, aVol->GetNode(i)->GetID()-1);
-                // Base::Console().Log("node ids: %i\n", aVol->GetNode(i)->GetID()-1);
-            }
-            quadPyramidArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 15) { // penta15
-            Base::Console().Log("    Volume penta15\n");
-            vtkSmartPointer<vtkQuadraticWedge> cell = vtkSmartPointer<vtkQuadraticWedge>::New();
-            for(int i=0; i<15; i++){
-                cell->GetPointIds()->SetId(i, aVol->GetNode(i)->GetID()-1);
-            }
-            quadWedgeArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 20) { // hexa20
-            Base::Console().Log("    Volume hexa20\n");
-            vtkSmartPointer<vtkQuadraticHexahedron> cell = vtkSmartPointer<vtkQuadraticHexahedron>::New();
-            for(int i=0; i<20; i++){
-                cell->GetPointIds()->SetId(i, aVol->GetNode(i)->GetID()-1);
-            }
-            quadHexaArray->InsertNextCell(cell);
-        }
-        else {
-            throw std::runtime_error("Volume not yet supported by FreeCAD's VTK mesh builder\n");
-        }
-    }
-
-    if(tetraArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_TETRA, tetraArray);
-
-    if(pyramidArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_PYRAMID, pyramidArray);
-
-    if(wedgeArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_WEDGE, wedgeArray);
-
-    if(hexaArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_HEXAHEDRON, hexaArray);
-
-    if(quadTetraArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_QUADRATIC_TETRA, quadTetraArray);
-
-    if(quadPyramidArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_QUADRATIC_PYRAMID, quadPyramidArray);
-
-    if(quadWedgeArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_QUADRATIC_WEDGE, quadWedgeArray);
-
-    if(quadHexaArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_QUADRATIC_HEXAHEDRON, quadHexaArray);
+    std::vector<CellBlock> blocks = {
+        {4, VTK_TETRA, {}},
+        {5, VTK_PYRAMID, {}},
+        {6, VTK_WEDGE, {}},
+        {8, VTK_HEXAHEDRON, {}},
+        {10, VTK_QUADRATIC_TETRA, {}},
+        {13, VTK_QUADRATIC_PYRAMID, {}},
+        {15, VTK_QUADRATIC_WEDGE, {}},
+        {20, VTK_QUADRATIC_HEXAHEDRON, {}}
+    };
+    exportFemMeshElements(grid, aVolIter, blocks, "Volume not yet supported by FreeCAD's VTK mesh builder\n");
 
     Base::Console().Log("  End: VTK mesh builder volumes.\n");
 }
@@ -442,17 +341,34 @@ void FemVTKTools::exportVTKMesh(const FemMesh* mesh, vtkSmartPointer<vtkUnstruct
     // nodes
     Base::Console().Log("  Start: VTK mesh builder nodes.\n");
 
-    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    std::vector<const SMDS_MeshNode*> nodes;
+    nodes.reserve(meshDS->NbNodes());
+    int maxId = 0;
     SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-
     while (aNodeIter->more()) {
-        const SMDS_MeshNode* node = aNodeIter->next();  // why float, not double?
-        double coords[3] = {double(node->X()*scale), double(node->Y()*scale), double(node->Z()*scale)};
-        points->InsertPoint(node->GetID()-1, coords);
-        // memory is allocated by VTK points size for max node id, not for point count
-        // if the SMESH mesh has gaps in node numbering, points without any element assignment will be inserted in these point gaps too
-        // this needs to be taken into account on node mapping when FreeCAD FEM results are exported to vtk
+        const SMDS_MeshNode* node = aNodeIter->next();
+        nodes.push_back(node);
+        maxId = std::max(maxId, node->GetID());
     }
+
+    // memory is allocated by VTK points size for max node id, not for point count
+    // if the SMESH mesh has gaps in node numbering, points without any element assignment will be inserted in these point gaps too
+    // this needs to be taken into account on node mapping when FreeCAD FEM results are exported to vtk
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetDataTypeToFloat();
+    points->SetNumberOfPoints(maxId);
+    float* coords = static_cast<float*>(points->GetVoidPointer(0));
+    std::fill(coords, coords + 3 * static_cast<std::size_t>(maxId), 0.0f);
+    parallelBlocks(nodes.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            const SMDS_MeshNode* node = nodes[i];
+            float* pnt = coords + 3 * static_cast<std::size_t>(node->GetID()-1);
+            pnt[0] = float(node->X()*scale);
+            pnt[1] = float(node->Y()*scale);
+            pnt[2] = float(node->Z()*scale);
+        }
+    });
+    points->Modified();
     grid->SetPoints(points);
     // nodes debugging
     const SMDS_MeshInfo& info = meshDS->GetMeshInfo();
@@ -847,18 +763,18 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
 
             //we need to set values for the unused points.
             //TODO: ensure that the result bar does not include the used 0 if it is not part of the result (e.g. does the result bar show 0 as smallest value?)
+            double* tuples = data->GetPointer(0);
             if (nPoints != field->getSize()) {
-                double tuple[] = {0,0,0};
-                for (vtkIdType i=0; i<nPoints; ++i) {
-                    data->SetTuple(i, tuple);
-                }
+                std::fill(tuples, tuples + dim * nPoints, 0.0);
             }
 
             SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
             for (std::vector<Base::Vector3d>::const_iterator jt=vel.begin(); jt!=vel.end(); ++jt) {
                 const SMDS_MeshNode* node = aNodeIter->next();
-                double tuple[] = {jt->x, jt->y, jt->z};
-                data->SetTuple(node->GetID()-1, tuple);
+                double* tuple = tuples + dim * (node->GetID()-1);
+                tuple[0] = jt->x;
+                tuple[1] = jt->y;
+                tuple[2] = jt->z;
             }
             grid->GetPointData()->AddArray(data);
             Base::Console().Log("    The PropertyVectorList %s was exported to VTK vector list: %s\n", it->first.c_str(), it->second.c_str());
@@ -886,16 +802,15 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
 
             //we need to set values for the unused points.
             //TODO: ensure that the result bar does not include the used 0 if it is not part of the result (e.g. does the result bar show 0 as smallest value?)
+            double* values = data->GetPointer(0);
             if (nPoints != field->getSize()) {
-                for (vtkIdType i=0; i<nPoints; ++i) {
-                    data->SetValue(i, 0);
-                }
-             }
+                std::fill(values, values + nPoints, 0.0);
+            }
 
             SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
             for (size_t i=0; i<vec.size(); ++i) {
                 const SMDS_MeshNode* node = aNodeIter->next();
-                data->SetValue(node->GetID()-1, vec[i]);
+                values[node->GetID()-1] = vec[i];
             }
 
             grid->GetPointData()->AddArray(data);
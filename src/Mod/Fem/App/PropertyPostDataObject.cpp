@@ -71,8 +71,10 @@ void PropertyPostDataObject::setValue(const vtkSmartPointer<vtkDataObject>& ds)
     aboutToSetValue();
 
     if(ds) {
+        // the arrays are shared with the filter output, VTK algorithms allocate
+        // new arrays when they run again instead of modifying the old ones
         createDataObjectByExternalType(ds);
-        m_dataObject->DeepCopy(ds);
+        m_dataObject->ShallowCopy(ds);
     }
     else
         m_dataObject = NULL;
@@ -67,6 +67,8 @@
 #include <queue>
 #include <bitset>
 #include <sstream>
+#include <functional>
+#include <unordered_map>
 
 // boost
 #include <boost/bind/bind.hpp>
@@ -151,6 +153,11 @@
 #include <Inventor/actions/SoSearchAction.h>
 #include <Inventor/nodes/SoLightModel.h>
 #include <Inventor/nodes/SoTransform.h>
+#include <Inventor/nodes/SoSwitch.h>
+#include <Inventor/nodes/SoTexture2.h>
+#include <Inventor/nodes/SoTexture2Transform.h>
+#include <Inventor/nodes/SoTextureCoordinate2.h>
+#include <Inventor/nodes/SoTextureCoordinateBinding.h>
 #include <Inventor/nodes/SoIndexedFaceSet.h>
 #include <Inventor/nodes/SoPointSet.h>
 #include <Inventor/nodes/SoPolygonOffset.h>
@@ -45,6 +45,7 @@
 # include <Inventor/nodes/SoCube.h>
 # include <Inventor/nodes/SoShapeHints.h>
 # include <Inventor/nodes/SoComplexity.h>
+# include <Inventor/nodes/SoMultipleCopy.h>
 #endif
 
 #include "ViewProviderFemConstraint.h"
@@ -458,6 +459,19 @@ void ViewProviderFemConstraint::updateRotation(const SoNode* node, const int idx
     updatePlacement(sep, idx+CYLINDER_CHILDREN, SbVec3f(0, -(height)*2-width/8 - (gap ? 1.0 : 0.0) * width/8, 0), SbRotation());
 }
 
+SoMultipleCopy* ViewProviderFemConstraint::getSymbolCopies(const int idx)
+{
+    while (pShapeSep->getNumChildren() <= idx)
+        pShapeSep->addChild(new SoMultipleCopy());
+    return static_cast<SoMultipleCopy*>(pShapeSep->getChild(idx));
+}
+
+void ViewProviderFemConstraint::setSymbol(SoMultipleCopy* cp, SoSeparator* symbol)
+{
+    cp->removeAllChildren();
+    cp->addChild(symbol);
+}
+
 QObject* ViewProviderFemConstraint::findChildByName(const QObject* parent, const QString& name)
 {
     for (QObjectList::const_iterator o = parent->children().begin(); o != parent->children().end(); o++) {
@@ -36,6 +36,7 @@ class SoBaseColor;
 class SoTranslation;
 class SbRotation;
 class SoMaterial;
+class SoMultipleCopy;
 
 namespace FemGui
 {
@@ -99,6 +100,15 @@ protected:
     static SoSeparator* createRotation(const double height, const double width, const bool gap = false);
     static void updateRotation(const SoNode* node, const int idx, const double height, const double width, const bool gap = false);
 
+    /** Symbols that are drawn at every point of the constraint share a single geometry:
+     * child idx of pShapeSep is a SoMultipleCopy holding the geometry, its matrix field
+     * holds the placements of the copies and is updated in place. Missing copy nodes up to
+     * idx are created.
+     */
+    SoMultipleCopy* getSymbolCopies(const int idx = 0);
+    /// Replaces the shared geometry of the copies, e.g. after the scale changed
+    static void setSymbol(SoMultipleCopy* cp, SoSeparator* symbol);
+
 private:
     SoFontStyle      * pFont;
     SoText2          * pLabel;
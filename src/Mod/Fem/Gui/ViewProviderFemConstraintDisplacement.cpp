@@ -94,7 +94,6 @@ bool ViewProviderFemConstraintDisplacement::setEdit(int ModNum)
 
 #define HEIGHT (4)
 #define WIDTH (0.3)
-//#define USE_MULTIPLE_COPY  //OvG: MULTICOPY fails to update scaled display on initial drawing - so disable
 
 void ViewProviderFemConstraintDisplacement::updateData(const App::Property* prop)
 {
@@ -102,207 +101,61 @@ void ViewProviderFemConstraintDisplacement::updateData(const App::Property* prop
     Fem::ConstraintDisplacement* pcConstraint = static_cast<Fem::ConstraintDisplacement*>(this->getObject());
     float scaledwidth = WIDTH * pcConstraint->Scale.getValue(); //OvG: Calculate scaled values once only
     float scaledheight = HEIGHT * pcConstraint->Scale.getValue();
-    bool xFree = pcConstraint->xFree.getValue();
-    bool yFree = pcConstraint->yFree.getValue();
-    bool zFree = pcConstraint->zFree.getValue();
-    bool rotxFree = pcConstraint->rotxFree.getValue();
-    bool rotyFree = pcConstraint->rotyFree.getValue();
-    bool rotzFree = pcConstraint->rotzFree.getValue();
 
-#ifdef USE_MULTIPLE_COPY
-    //OvG: always need access to cp for scaling
-    SoMultipleCopy* cpx = new SoMultipleCopy();
-    SoMultipleCopy* cpy = new SoMultipleCopy();
-    SoMultipleCopy* cpz = new SoMultipleCopy();
-    SoMultipleCopy* cprotx = new SoMultipleCopy();
-    SoMultipleCopy* cproty = new SoMultipleCopy();
-    SoMultipleCopy* cprotz = new SoMultipleCopy();
-    if (pShapeSep->getNumChildren() == 0) {
-        // Set up the nodes
-        cpx->matrix.setNum(0);
-        cpx->addChild((SoNode*)createDisplacement(scaledheight, scaledwidth)); //OvG: Scaling
-
-        cpy->matrix.setNum(0);
-        cpy->addChild((SoNode*)createDisplacement(scaledheight, scaledwidth)); //OvG: Scaling
-
-        cpz->matrix.setNum(0);
-        cpz->addChild((SoNode*)createDisplacement(scaledheight, scaledwidth)); //OvG: Scaling
-
-        cprotx->matrix.setNum(0);
-        cprotx->addChild((SoNode*)createRotation(scaledheight, scaledwidth)); //OvG: Scaling
-
-        cproty->matrix.setNum(0);
-        cproty->addChild((SoNode*)createRotation(scaledheight, scaledwidth)); //OvG: Scaling
-
-        cprotz->matrix.setNum(0);
-        cprotz->addChild((SoNode*)createRotation(scaledheight, scaledwidth)); //OvG: Scaling
-
-        pShapeSep->addChild(cpx);
-        pShapeSep->addChild(cpy);
-        pShapeSep->addChild(cpz);
-        pShapeSep->addChild(cprotx);
-        pShapeSep->addChild(cproty);
-        pShapeSep->addChild(cprotz;
+    // One symbol for each fixed translation and rotation, each shared by all points
+    // 0..2: translation in x, y, z, 3..5: rotation about x, y, z
+    if (strcmp(prop->getName(),"Scale") == 0) {
+        // The placements don't depend on the scale
+        for (int i = 0; i < 3; i++) {
+            setSymbol(getSymbolCopies(i), createDisplacement(scaledheight, scaledwidth)); //OvG: Scaling
+            setSymbol(getSymbolCopies(i+3), createRotation(scaledheight, scaledwidth)); //OvG: Scaling
+        }
     }
-#endif
-
-    if (strcmp(prop->getName(),"Points") == 0) {
+    else if (strcmp(prop->getName(),"Points") == 0) {
         const std::vector<Base::Vector3d>& points = pcConstraint->Points.getValues();
         const std::vector<Base::Vector3d>& normals = pcConstraint->Normals.getValues();
         if (points.size() != normals.size())
             return;
-        std::vector<Base::Vector3d>::const_iterator n = normals.begin();
-
-#ifdef USE_MULTIPLE_COPY
-        cpx = static_cast<SoMultipleCopy*>(pShapeSep->getChild(0));
-        cpx->matrix.setNum(points.size());
-        SbMatrix* matricesx = cpx->matrix.startEditing();
-
-        cpy = static_cast<SoMultipleCopy*>(pShapeSep->getChild(1));
-        cpy->matrix.setNum(points.size());
-        SbMatrix* matricesy = cpy->matrix.startEditing();
-
-        cpz = static_cast<SoMultipleCopy*>(pShapeSep->getChild(2));
-        cpz->matrix.setNum(points.size());
-        SbMatrix* matricesz = cpz->matrix.startEditing();
-
-        cprotx = static_cast<SoMultipleCopy*>(pShapeSep->getChild(3));
-        cprotx->matrix.setNum(points.size());
-        SbMatrix* matricesrotx = cprotx->matrix.startEditing();
-
-        cproty = static_cast<SoMultipleCopy*>(pShapeSep->getChild(4));
-        cproty->matrix.setNum(points.size());
-        SbMatrix* matricesroty = cproty->matrix.startEditing();
-
-        cprotz = static_cast<SoMultipleCopy*>(pShapeSep->getChild(5));
-        cprotz->matrix.setNum(points.size());
-        SbMatrix* matricesrotz = cprotz->matrix.startEditing();
 
-        int idx = 0;
-        int idy = 0;
-        int idz = 0;
-        int idrotx = 0;
-        int idroty = 0;
-        int idrotz = 0;
-#else
-        // Note: Points and Normals are always updated together
-        Gui::coinRemoveAllChildren(pShapeSep);
-#endif
-
-        for (std::vector<Base::Vector3d>::const_iterator p = points.begin(); p != points.end(); p++) {
-            SbVec3f base(p->x, p->y, p->z);
-            SbVec3f dirx(1,0,0); //OvG: Make relevant to global axes
-            SbVec3f diry(0,1,0); //OvG: Make relevant to global axes
-            SbVec3f dirz(0,0,1); //OvG: Make relevant to global axes
-            SbRotation rotx(SbVec3f(0,-1,0), dirx); //OvG Tri-cones
-            SbRotation roty(SbVec3f(0,-1,0), diry);
-            SbRotation rotz(SbVec3f(0,-1,0), dirz);
-#ifdef USE_MULTIPLE_COPY
-            SbMatrix mx;
-            SbMatrix my;
-            SbMatrix mz;
-            //OvG: Translation indication
-            if(!xFree)
-            {
-                SbMatrix mx;
-                mx.setTransform(base, rotx, SbVec3f(1,1,1));
-                matricesx[idx] = mx;
-                idx++;
-            }
-            if(!yFree)
-            {
-                SbMatrix my;
-                my.setTransform(base, roty, SbVec3f(1,1,1));
-                matricesy[idy] = my;
-                idy++;
-            }
-            if(!zFree)
-            {
-                SbMatrix mz;
-                mz.setTransform(base, rotz, SbVec3f(1,1,1));
-                matricesz[idz] = mz;
-                idz++;
+        const bool fixed[6] = {
+            !pcConstraint->xFree.getValue(),
+            !pcConstraint->yFree.getValue(),
+            !pcConstraint->zFree.getValue(),
+            !pcConstraint->rotxFree.getValue(),
+            !pcConstraint->rotyFree.getValue(),
+            !pcConstraint->rotzFree.getValue()
+        };
+        //OvG: Make relevant to global axes, tri-cones
+        const SbRotation rot[3] = {
+            SbRotation(SbVec3f(0,-1,0), SbVec3f(1,0,0)),
+            SbRotation(SbVec3f(0,-1,0), SbVec3f(0,1,0)),
+            SbRotation(SbVec3f(0,-1,0), SbVec3f(0,0,1))
+        };
+
+        for (int i = 0; i < 6; i++) {
+            SoMultipleCopy* cp = getSymbolCopies(i);
+            if (cp->getNumChildren() == 0) {
+                if (i < 3)
+                    setSymbol(cp, createDisplacement(scaledheight, scaledwidth)); //OvG: Scaling
+                else
+                    setSymbol(cp, createRotation(scaledheight, scaledwidth)); //OvG: Scaling
             }
 
-            //OvG: Rotation indication
-            if(!rotxFree)
-            {
-                SbMatrix mrotx;
-                mrotx.setTransform(base, rotx, SbVec3f(1,1,1));
-                matricesrotx[idrotx] = mrotx;
-                idrotx++;
-            }
-            if(!rotyFree)
-            {
-                SbMatrix mroty;
-                mroty.setTransform(base, roty, SbVec3f(1,1,1));
-                matricesroty[idroty] = mroty;
-                idroty++;
-            }
-            if(!rotzFree)
-            {
-                SbMatrix mrotz;
-                mrotz.setTransform(base, rotz, SbVec3f(1,1,1));
-                matricesrotz[idrotz] = mrotz;
-                idrotz++;
-            }
-#else
-            //OvG: Translation indication
-            if(!xFree)
-            {
-                SoSeparator* sepx = new SoSeparator();
-                createPlacement(sepx, base, rotx);
-                createDisplacement(sepx, scaledheight, scaledwidth); //OvG: Scaling
-                pShapeSep->addChild(sepx);
-            }
-            if(!yFree)
-            {
-                SoSeparator* sepy = new SoSeparator();
-                createPlacement(sepy, base, roty);
-                createDisplacement(sepy, scaledheight, scaledwidth); //OvG: Scaling
-                pShapeSep->addChild(sepy);
-            }
-            if(!zFree)
-            {
-                SoSeparator* sepz = new SoSeparator();
-                createPlacement(sepz, base, rotz);
-                createDisplacement(sepz, scaledheight, scaledwidth); //OvG: Scaling
-                pShapeSep->addChild(sepz);
+            if (!fixed[i]) {
+                cp->matrix.setNum(0);
+                continue;
             }
 
-            //OvG: Rotation indication
-            if(!rotxFree)
-            {
-                SoSeparator* sepx = new SoSeparator();
-                createPlacement(sepx, base, rotx);
-                createRotation(sepx, scaledheight, scaledwidth); //OvG: Scaling
-                pShapeSep->addChild(sepx);
-            }
-            if(!rotyFree)
-            {
-                SoSeparator* sepy = new SoSeparator();
-                createPlacement(sepy, base, roty);
-                createRotation(sepy, scaledheight, scaledwidth); //OvG: Scaling
-                pShapeSep->addChild(sepy);
-            }
-            if(!rotzFree)
-            {
-                SoSeparator* sepz = new SoSeparator();
-                createPlacement(sepz, base, rotz);
-                createRotation(sepz, scaledheight, scaledwidth); //OvG: Scaling
-                pShapeSep->addChild(sepz);
+            cp->matrix.setNum(points.size());
+            SbMatrix* matrices = cp->matrix.startEditing();
+            int idx = 0;
+            for (std::vector<Base::Vector3d>::const_iterator p = points.begin(); p != points.end(); p++) {
+                SbVec3f base(p->x, p->y, p->z);
+                matrices[idx].setTransform(base, rot[i % 3], SbVec3f(1,1,1));
+                idx++;
             }
-#endif
-            n++;
+            cp->matrix.finishEditing();
         }
-#ifdef USE_MULTIPLE_COPY
-        cpx->matrix.finishEditing();
-        cpy->matrix.finishEditing();
-        cpz->matrix.finishEditing();
-        cprotx->matrix.finishEditing();
-        cproty->matrix.finishEditing();
-        cprotz->matrix.finishEditing();
-#endif
     }
 
     // Gets called whenever a property of the attached object changes
@@ -110,7 +110,6 @@ bool ViewProviderFemConstraintFixed::setEdit(int ModNum)
 
 #define WIDTH (2)
 #define HEIGHT (1)
-//#define USE_MULTIPLE_COPY  //OvG: MULTICOPY fails to update scaled display on initial drawing - so disable
 
 void ViewProviderFemConstraintFixed::updateData(const App::Property* prop)
 {
@@ -119,54 +118,36 @@ void ViewProviderFemConstraintFixed::updateData(const App::Property* prop)
     float scaledwidth = WIDTH * pcConstraint->Scale.getValue(); //OvG: Calculate scaled values once only
     float scaledheight = HEIGHT * pcConstraint->Scale.getValue();
 
-#ifdef USE_MULTIPLE_COPY
-    //OvG: always need access to cp for scaling
-    SoMultipleCopy* cp = new SoMultipleCopy();
-    if (pShapeSep->getNumChildren() == 0) {
-        // Set up the nodes
-        cp->matrix.setNum(0);
-        cp->addChild((SoNode*)createFixed(scaledheight, scaledwidth)); //OvG: Scaling
-        pShapeSep->addChild(cp);
+    if (strcmp(prop->getName(),"Scale") == 0) {
+        // The placements don't depend on the scale
+        setSymbol(getSymbolCopies(), createFixed(scaledheight, scaledwidth)); //OvG: Scaling
     }
-#endif
-
-    if (strcmp(prop->getName(),"Points") == 0) {
+    else if (strcmp(prop->getName(),"Points") == 0) {
         const std::vector<Base::Vector3d>& points = pcConstraint->Points.getValues();
         const std::vector<Base::Vector3d>& normals = pcConstraint->Normals.getValues();
         if (points.size() != normals.size())
             return;
         std::vector<Base::Vector3d>::const_iterator n = normals.begin();
 
-#ifdef USE_MULTIPLE_COPY
-        cp = static_cast<SoMultipleCopy*>(pShapeSep->getChild(0));
+        // All symbols share one geometry
+        SoMultipleCopy* cp = getSymbolCopies();
+        if (cp->getNumChildren() == 0)
+            setSymbol(cp, createFixed(scaledheight, scaledwidth)); //OvG: Scaling
+
+        // Note: Points and Normals are always updated together
         cp->matrix.setNum(points.size());
         SbMatrix* matrices = cp->matrix.startEditing();
         int idx = 0;
-#else
-        // Note: Points and Normals are always updated together
-        Gui::coinRemoveAllChildren(pShapeSep);
-#endif
 
         for (std::vector<Base::Vector3d>::const_iterator p = points.begin(); p != points.end(); p++) {
             SbVec3f base(p->x, p->y, p->z);
             SbVec3f dir(n->x, n->y, n->z);
             SbRotation rot(SbVec3f(0,-1,0), dir);
-#ifdef USE_MULTIPLE_COPY
-            SbMatrix m;
-            m.setTransform(base, rot, SbVec3f(1,1,1));
-            matrices[idx] = m;
+            matrices[idx].setTransform(base, rot, SbVec3f(1,1,1));
             idx++;
-#else
-            SoSeparator* sep = new SoSeparator();
-            createPlacement(sep, base, rot);
-            createFixed(sep, scaledheight, scaledwidth); //OvG: Scaling
-            pShapeSep->addChild(sep);
-#endif
             n++;
         }
-#ifdef USE_MULTIPLE_COPY
         cp->matrix.finishEditing();
-#endif
     }
 
     ViewProviderFemConstraint::updateData(prop);
@@ -110,7 +110,6 @@ bool ViewProviderFemConstraintForce::setEdit(int ModNum)
 
 #define ARROWLENGTH (4)
 #define ARROWHEADRADIUS (ARROWLENGTH/3.0f)
-//#define USE_MULTIPLE_COPY  //OvG: MULTICOPY fails to update scaled arrows on initial drawing - so disable
 
 void ViewProviderFemConstraintForce::updateData(const App::Property* prop)
 {
@@ -119,29 +118,16 @@ void ViewProviderFemConstraintForce::updateData(const App::Property* prop)
     float scaledheadradius = ARROWHEADRADIUS * pcConstraint->Scale.getValue(); //OvG: Calculate scaled values once only
     float scaledlength = ARROWLENGTH * pcConstraint->Scale.getValue();
 
-#ifdef USE_MULTIPLE_COPY
-    //OvG: need access to cp for scaling
-    SoMultipleCopy* cp = new SoMultipleCopy();
-    if (pShapeSep->getNumChildren() == 0) {
-        // Set up the nodes
-        cp->matrix.setNum(0);
-        cp->addChild((SoNode*)createArrow(scaledlength , scaledheadradius)); //OvG: Scaling
-        pShapeSep->addChild(cp);
-    }
-#endif
-
-    if (strcmp(prop->getName(),"Points") == 0) {
+    // Note: "Reversed" also triggers "DirectionVector"
+    if (strcmp(prop->getName(),"Points") == 0 || strcmp(prop->getName(),"DirectionVector") == 0 ||
+        strcmp(prop->getName(),"Scale") == 0) {
         const std::vector<Base::Vector3d>& points = pcConstraint->Points.getValues();
 
-#ifdef USE_MULTIPLE_COPY
-        cp = static_cast<SoMultipleCopy*>(pShapeSep->getChild(0));
-        cp->matrix.setNum(points.size());
-        SbMatrix* matrices = cp->matrix.startEditing();
-        int idx = 0;
-#else
-        // Redraw all arrows
-        Gui::coinRemoveAllChildren(pShapeSep);
-#endif
+        // All arrows share one geometry, only a new scale needs a new one
+        SoMultipleCopy* cp = getSymbolCopies();
+        if (cp->getNumChildren() == 0 || prop == &pcConstraint->Scale)
+            setSymbol(cp, createArrow(scaledlength, scaledheadradius)); //OvG: Scaling
+
         // This should always point outside of the solid
         Base::Vector3d normal = pcConstraint->NormalDirection.getValue();
 
@@ -153,63 +139,18 @@ void ViewProviderFemConstraintForce::updateData(const App::Property* prop)
         SbVec3f dir(forceDirection.x, forceDirection.y, forceDirection.z);
         SbRotation rot(SbVec3f(0,1,0), dir);
 
-        for (std::vector<Base::Vector3d>::const_iterator p = points.begin(); p != points.end(); p++) {
-            SbVec3f base(p->x, p->y, p->z);
-            if (forceDirection.GetAngle(normal) < M_PI_2) // Move arrow so it doesn't disappear inside the solid
-                base = base + dir * scaledlength; //OvG: Scaling
-#ifdef USE_MULTIPLE_COPY
-            SbMatrix m;
-            m.setTransform(base, rot, SbVec3f(1,1,1));
-            matrices[idx] = m;
-            idx++;
-#else
-            SoSeparator* sep = new SoSeparator();
-            createPlacement(sep, base, rot);
-            createArrow(sep, scaledlength, scaledheadradius); //OvG: Scaling
-            pShapeSep->addChild(sep);
-#endif
-        }
-#ifdef USE_MULTIPLE_COPY
-        cp->matrix.finishEditing();
-#endif
-    }
-    else if (strcmp(prop->getName(),"DirectionVector") == 0) { // Note: "Reversed" also triggers "DirectionVector"
-        // Re-orient all arrows
-        Base::Vector3d normal = pcConstraint->NormalDirection.getValue();
-        Base::Vector3d forceDirection = pcConstraint->DirectionVector.getValue();
-        if (forceDirection.Length() < Precision::Confusion())
-            forceDirection = normal;
-
-        SbVec3f dir(forceDirection.x, forceDirection.y, forceDirection.z);
-        SbRotation rot(SbVec3f(0,1,0), dir);
-
-        const std::vector<Base::Vector3d>& points = pcConstraint->Points.getValues();
-
-#ifdef USE_MULTIPLE_COPY
-        SoMultipleCopy* cp = static_cast<SoMultipleCopy*>(pShapeSep->getChild(0));
         cp->matrix.setNum(points.size());
         SbMatrix* matrices = cp->matrix.startEditing();
-#endif
         int idx = 0;
 
         for (std::vector<Base::Vector3d>::const_iterator p = points.begin(); p != points.end(); p++) {
             SbVec3f base(p->x, p->y, p->z);
-            if (forceDirection.GetAngle(normal) < M_PI_2)
+            if (forceDirection.GetAngle(normal) < M_PI_2) // Move arrow so it doesn't disappear inside the solid
                 base = base + dir * scaledlength; //OvG: Scaling
-#ifdef USE_MULTIPLE_COPY
-            SbMatrix m;
-            m.setTransform(base, rot, SbVec3f(1,1,1));
-            matrices[idx] = m;
-#else
-            SoSeparator* sep = static_cast<SoSeparator*>(pShapeSep->getChild(idx));
-            updatePlacement(sep, 0, base, rot);
-            updateArrow(sep, 2, scaledlength, scaledheadradius); //OvG: Scaling
-#endif
+            matrices[idx].setTransform(base, rot, SbVec3f(1,1,1));
             idx++;
         }
-#ifdef USE_MULTIPLE_COPY
         cp->matrix.finishEditing();
-#endif
     }
 
     ViewProviderFemConstraint::updateData(prop);
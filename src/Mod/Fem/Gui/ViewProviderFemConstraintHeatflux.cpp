@@ -100,7 +100,61 @@ bool ViewProviderFemConstraintHeatflux::setEdit(int ModNum)
 
 #define HEIGHT (1.5)
 #define RADIUS (0.3)
-//#define USE_MULTIPLE_COPY  //OvG: MULTICOPY fails to update scaled display on initial drawing - so disable
+
+/// Temperature indication: a temp gauge with sphere and cylinders, along the y axis
+static SoSeparator* createThermometer(const float scaledradius, const float scaledheight)
+{
+    SoSeparator* sep = new SoSeparator();
+
+    //first move away from the face
+    SoTranslation* trans = new SoTranslation();
+    trans->translation.setValue(SbVec3f(0,scaledradius*0.7f,0));
+    sep->addChild(trans);
+
+    //define color of shape
+    SoMaterial* myMaterial = new SoMaterial;
+    myMaterial->diffuseColor.set1Value(0,SbColor(0.65f,0.1f,0.25f));//RGB
+    //myMaterial->diffuseColor.set1Value(1,SbColor(.1,.1,.1));//possible to adjust sides separately
+    sep->addChild(myMaterial);
+
+    //draw a sphere
+    SoSphere* sph = new SoSphere();
+    sph->radius.setValue(scaledradius*0.75);
+    sep->addChild(sph);
+    //translate position
+    SoTranslation* trans2 = new SoTranslation();
+    trans2->translation.setValue(SbVec3f(0,scaledheight*0.375,0));
+    sep->addChild(trans2);
+    //draw a cylinder
+    SoCylinder* cyl = new SoCylinder();
+    cyl->height.setValue(scaledheight*0.5);
+    cyl->radius.setValue(scaledradius*0.375);
+    sep->addChild(cyl);
+    //translate position
+    SoTranslation* trans3 = new SoTranslation();
+    trans3->translation.setValue(SbVec3f(0,scaledheight*0.375,0));
+    sep->addChild(trans3);
+    //define color of shape
+    SoMaterial *myMaterial2 = new SoMaterial;
+    myMaterial2->diffuseColor.set1Value(0,SbColor(1,1,1));//RGB
+    sep->addChild(myMaterial2);
+    //draw a cylinder
+    SoCylinder* cyl2 = new SoCylinder();
+    cyl2->height.setValue(scaledheight*0.25);
+    cyl2->radius.setValue(scaledradius*0.375);
+    sep->addChild(cyl2);
+    //translate position
+    SoTranslation* trans4 = new SoTranslation();
+    trans4->translation.setValue(SbVec3f(0,-scaledheight*0.375,0));
+    sep->addChild(trans4);
+    //draw a cylinder
+    SoCylinder* cyl3 = new SoCylinder();
+    cyl3->height.setValue(scaledheight*0.05);
+    cyl3->radius.setValue(scaledradius*1);
+    sep->addChild(cyl3);
+
+    return sep;
+}
 
 void ViewProviderFemConstraintHeatflux::updateData(const App::Property* prop)
 {
@@ -112,83 +166,36 @@ void ViewProviderFemConstraintHeatflux::updateData(const App::Property* prop)
     // //float facetemp = pcConstraint->FaceTemp.getValue();
     //float filmcoef = pcConstraint->FilmCoef.getValue();
 
-    if (strcmp(prop->getName(),"Points") == 0) {
+    if (strcmp(prop->getName(),"Scale") == 0) {
+        // The placements don't depend on the scale
+        setSymbol(getSymbolCopies(), createThermometer(scaledradius, scaledheight));
+    }
+    else if (strcmp(prop->getName(),"Points") == 0) {
         const std::vector<Base::Vector3d>& points = pcConstraint->Points.getValues();
         const std::vector<Base::Vector3d>& normals = pcConstraint->Normals.getValues();
         if (points.size() != normals.size())
             return;
         std::vector<Base::Vector3d>::const_iterator n = normals.begin();
 
+        // All gauges share one geometry
+        SoMultipleCopy* cp = getSymbolCopies();
+        if (cp->getNumChildren() == 0)
+            setSymbol(cp, createThermometer(scaledradius, scaledheight));
+
         // Note: Points and Normals are always updated together
-        Gui::coinRemoveAllChildren(pShapeSep);
+        cp->matrix.setNum(points.size());
+        SbMatrix* matrices = cp->matrix.startEditing();
+        int idx = 0;
 
         for (std::vector<Base::Vector3d>::const_iterator p = points.begin(); p != points.end(); p++) {
             //Define base and normal directions
             SbVec3f base(p->x, p->y, p->z);
             SbVec3f dir(n->x, n->y, n->z);//normal
-
-            ///Temperature indication
-            //define separator
-            SoSeparator* sep = new SoSeparator();
-
-            ///draw a temp gauge,with sphere and a cylinder
-            //first move to correct position
-            SoTranslation* trans = new SoTranslation();
-            SbVec3f newPos=base+scaledradius*dir*0.7f;
-            trans->translation.setValue(newPos);
-            sep->addChild(trans);
-
-            //adjust orientation
-            SoRotation* rot = new SoRotation();
-            rot->rotation.setValue(SbRotation(SbVec3f(0,1,0),dir));
-            sep->addChild(rot);
-
-            //define color of shape
-            SoMaterial* myMaterial = new SoMaterial;
-            myMaterial->diffuseColor.set1Value(0,SbColor(0.65f,0.1f,0.25f));//RGB
-            //myMaterial->diffuseColor.set1Value(1,SbColor(.1,.1,.1));//possible to adjust sides separately
-            sep->addChild(myMaterial);
-
-            //draw a sphere
-            SoSphere* sph = new SoSphere();
-            sph->radius.setValue(scaledradius*0.75);
-            sep->addChild(sph);
-            //translate position
-            SoTranslation* trans2 = new SoTranslation();
-            trans2->translation.setValue(SbVec3f(0,scaledheight*0.375,0));
-            sep->addChild(trans2);
-            //draw a cylinder
-            SoCylinder* cyl = new SoCylinder();
-            cyl->height.setValue(scaledheight*0.5);
-            cyl->radius.setValue(scaledradius*0.375);
-            sep->addChild(cyl);
-            //translate position
-            SoTranslation* trans3 = new SoTranslation();
-            trans3->translation.setValue(SbVec3f(0,scaledheight*0.375,0));
-            sep->addChild(trans3);
-            //define color of shape
-            SoMaterial *myMaterial2 = new SoMaterial;
-            myMaterial2->diffuseColor.set1Value(0,SbColor(1,1,1));//RGB
-            sep->addChild(myMaterial2);
-            //draw a cylinder
-            SoCylinder* cyl2 = new SoCylinder();
-            cyl2->height.setValue(scaledheight*0.25);
-            cyl2->radius.setValue(scaledradius*0.375);
-            sep->addChild(cyl2);
-                        //translate position
-            SoTranslation* trans4 = new SoTranslation();
-            trans4->translation.setValue(SbVec3f(0,-scaledheight*0.375,0));
-            sep->addChild(trans4);
-                        //draw a cylinder
-            SoCylinder* cyl3 = new SoCylinder();
-            cyl3->height.setValue(scaledheight*0.05);
-            cyl3->radius.setValue(scaledradius*1);
-            sep->addChild(cyl3);
-
-            pShapeSep->addChild(sep);
-
+            matrices[idx].setTransform(base, SbRotation(SbVec3f(0,1,0),dir), SbVec3f(1,1,1));
+            idx++;
             n++;
         }
+        cp->matrix.finishEditing();
     }
     // Gets called whenever a property of the attached object changes
     ViewProviderFemConstraint::updateData(prop);
@@ -92,7 +92,6 @@ bool ViewProviderFemConstraintPressure::setEdit(int ModNum)
 
 #define ARROWLENGTH (4)
 #define ARROWHEADRADIUS (ARROWLENGTH/3.0f)
-//#define USE_MULTIPLE_COPY //OvG: MULTICOPY fails to update scaled arrows on initial drawing - so disable
 
 void ViewProviderFemConstraintPressure::updateData(const App::Property* prop)
 {
@@ -101,18 +100,8 @@ void ViewProviderFemConstraintPressure::updateData(const App::Property* prop)
     float scaledheadradius = ARROWHEADRADIUS * pcConstraint->Scale.getValue(); //OvG: Calculate scaled values once only
     float scaledlength = ARROWLENGTH * pcConstraint->Scale.getValue();
 
-#ifdef USE_MULTIPLE_COPY
-    //OvG: always need access to cp for scaling
-    SoMultipleCopy* cp = new SoMultipleCopy();
-    if (pShapeSep->getNumChildren() == 0) {
-        // Set up the nodes
-        cp->matrix.setNum(0);
-        cp->addChild((SoNode*)createArrow(scaledlength , scaledheadradius)); //OvG: Scaling
-        pShapeSep->addChild(cp);
-    }
-#endif
-
-    if (strcmp(prop->getName(),"Points") == 0) {
+    // Note: "Reversed" also triggers "Points"
+    if (strcmp(prop->getName(),"Points") == 0 || strcmp(prop->getName(),"Scale") == 0) {
         const std::vector<Base::Vector3d>& points = pcConstraint->Points.getValues();
         const std::vector<Base::Vector3d>& normals = pcConstraint->Normals.getValues();
         if (points.size() != normals.size()) {
@@ -120,15 +109,14 @@ void ViewProviderFemConstraintPressure::updateData(const App::Property* prop)
         }
         std::vector<Base::Vector3d>::const_iterator n = normals.begin();
 
-#ifdef USE_MULTIPLE_COPY
-        cp = static_cast<SoMultipleCopy*>(pShapeSep->getChild(0)); //OvG: Use top cp
+        // All arrows share one geometry, only a new scale needs a new one
+        SoMultipleCopy* cp = getSymbolCopies();
+        if (cp->getNumChildren() == 0 || prop == &pcConstraint->Scale)
+            setSymbol(cp, createArrow(scaledlength, scaledheadradius)); //OvG: Scaling
+
         cp->matrix.setNum(points.size());
         SbMatrix* matrices = cp->matrix.startEditing();
         int idx = 0;
-#else
-        // Redraw all arrows
-        Gui::coinRemoveAllChildren(pShapeSep);
-#endif
 
         for (std::vector<Base::Vector3d>::const_iterator p = points.begin(); p != points.end(); p++) {
             SbVec3f base(p->x, p->y, p->z);
@@ -141,22 +129,11 @@ void ViewProviderFemConstraintPressure::updateData(const App::Property* prop)
                 rev = -1;
             }
             SbRotation rot(SbVec3f(0, rev, 0), dir);
-#ifdef USE_MULTIPLE_COPY
-            SbMatrix m;
-            m.setTransform(base, rot, SbVec3f(1,1,1));
-            matrices[idx] = m;
+            matrices[idx].setTransform(base, rot, SbVec3f(1,1,1));
             idx++;
-#else
-            SoSeparator* sep = new SoSeparator();
-            createPlacement(sep, base, rot);
-            createArrow(sep, scaledlength , scaledheadradius); //OvG: Scaling
-            pShapeSep->addChild(sep);
-#endif
             n++;
         }
-#ifdef USE_MULTIPLE_COPY
         cp->matrix.finishEditing();
-#endif
     }
 
     ViewProviderFemConstraint::updateData(prop);
@@ -35,6 +35,11 @@
 # include <Inventor/nodes/SoMaterial.h>
 # include <Inventor/nodes/SoSeparator.h>
 # include <Inventor/nodes/SoTransform.h>
+# include <Inventor/nodes/SoSwitch.h>
+# include <Inventor/nodes/SoTexture2.h>
+# include <Inventor/nodes/SoTexture2Transform.h>
+# include <Inventor/nodes/SoTextureCoordinate2.h>
+# include <Inventor/nodes/SoTextureCoordinateBinding.h>
 # include <Inventor/nodes/SoRotation.h>
 # include <Inventor/nodes/SoCoordinate3.h>
 # include <Inventor/nodes/SoDrawStyle.h>
@@ -51,7 +56,9 @@
 
 # include <QFile>
 
+# include <functional>
 # include <sstream>
+# include <unordered_map>
 
 # include <SMESH_Mesh.hxx>
 # include <SMESHDS_Mesh.hxx>
@@ -68,7 +75,8 @@
 #include <Base/Stream.h>
 #include <Base/Console.h>
 #include <Base/TimeInfo.h>
-#include <Base/BoundBox.h>
+#include <Base/ThreadPool.h>
+#include <boost/functional/hash.hpp>
 
 
 
@@ -83,20 +91,19 @@ struct FemFace
     unsigned short Size;
     unsigned short FaceNo;
     bool hide;
-    Base::Vector3d getFirstNodePoint(void) {
-        return Base::Vector3d(Nodes[0]->X(),Nodes[0]->Y(),Nodes[0]->Z());
-    }
 
-    Base::Vector3d set(short size,const SMDS_MeshElement* element,unsigned short id, short faceNo,
+    void set(short size,const SMDS_MeshElement* element,unsigned short id, short faceNo,
         const SMDS_MeshNode* n1,const SMDS_MeshNode* n2,const SMDS_MeshNode* n3,const SMDS_MeshNode* n4=0,
         const SMDS_MeshNode* n5=0,const SMDS_MeshNode* n6=0,const SMDS_MeshNode* n7=0,const SMDS_MeshNode* n8=0);
 
-    bool isSameFace (FemFace &face);
+    /// hash of the sorted nodes, equal for the faces of two elements sharing this face
+    std::size_t hashKey() const;
+    bool isSameFace (const FemFace &face) const;
 };
 
-Base::Vector3d FemFace::set(short size,const SMDS_MeshElement* element,unsigned short id,short faceNo,
-                            const SMDS_MeshNode* n1,const SMDS_MeshNode* n2,const SMDS_MeshNode* n3,const SMDS_MeshNode* n4,
-                            const SMDS_MeshNode* n5,const SMDS_MeshNode* n6,const SMDS_MeshNode* n7,const SMDS_MeshNode* n8)
+void FemFace::set(short size,const SMDS_MeshElement* element,unsigned short id,short faceNo,
+                  const SMDS_MeshNode* n1,const SMDS_MeshNode* n2,const SMDS_MeshNode* n3,const SMDS_MeshNode* n4,
+                  const SMDS_MeshNode* n5,const SMDS_MeshNode* n6,const SMDS_MeshNode* n7,const SMDS_MeshNode* n8)
 {
     Nodes[0] = n1;
     Nodes[1] = n2;
@@ -113,34 +120,19 @@ Base::Vector3d FemFace::set(short size,const SMDS_MeshElement* element,unsigned
     FaceNo          = faceNo;
     hide            = false;
 
-    // sorting the nodes for later easier comparison (bubble sort)
-    int i, j, flag = 1;    // set flag to 1 to start first pass
-    const SMDS_MeshNode* temp;   // holding variable
-
-    for(i = 1; (i <= size) && flag; i++)
-    {
-        flag = 0;
-        for (j=0; j < (size -1); j++)
-        {
-            if (Nodes[j+1] > Nodes[j])      // ascending order simply changes to <
-            {
-                temp = Nodes[j];             // swap elements
-                Nodes[j] = Nodes[j+1];
-                Nodes[j+1] = temp;
-                flag = 1;               // indicates that a swap occurred.
-            }
-        }
-    }
-
-    return Base::Vector3d(Nodes[0]->X(),Nodes[0]->Y(),Nodes[0]->Z());
+    // sorting the nodes for later easier comparison
+    std::sort(Nodes, Nodes + size, std::greater<const SMDS_MeshNode*>());
 }
 
-class FemFaceGridItem : public std::vector<FemFace*>{
-public:
-    //FemFaceGridItem(void){reserve(200);}
-};
+std::size_t FemFace::hashKey() const
+{
+    std::size_t key = Size;
+    for (int i = 0; i < Size; i++)
+        boost::hash_combine(key, Nodes[i]);
+    return key;
+}
 
-bool FemFace::isSameFace (FemFace &face)
+bool FemFace::isSameFace (const FemFace &face) const
 {
     // the same element can not have the same face
     if(face.ElementNumber == ElementNumber)
@@ -148,20 +140,224 @@ bool FemFace::isSameFace (FemFace &face)
     if(face.Size != Size)
         return false;
     // if the same face size just compare if the sorted nodes are the same
-    if( Nodes[0] == face.Nodes[0] &&
-        Nodes[1] == face.Nodes[1] &&
-        Nodes[2] == face.Nodes[2] &&
-        Nodes[3] == face.Nodes[3] &&
-        Nodes[4] == face.Nodes[4] &&
-        Nodes[5] == face.Nodes[5] &&
-        Nodes[6] == face.Nodes[6] &&
-        Nodes[7] == face.Nodes[7] ){
-            hide = true;
-            face.hide = true;
-            return true;
+    return std::equal(Nodes, Nodes + Size, face.Nodes);
+}
+
+/// Fills in the faces of a volume element, returns the number of faces
+static int setVolumeFaces(FemFace* faces, const SMDS_MeshVolume* aVol)
+{
+    int i=0;
+    int num = aVol->NbNodes();
+
+    switch (num){
+    //tetra4 volume
+    case 4:
+        // face 1 = N1, N2, N3
+        // face 2 = N1, N4, N2
+        // face 3 = N2, N4, N3
+        // face 4 = N3, N4, N1
+        faces[i++].set(3, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2));
+        faces[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(3), aVol->GetNode(1));
+        faces[i++].set(3, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(3), aVol->GetNode(2));
+        faces[i++].set(3, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(3), aVol->GetNode(0));
+        break;
+    //pyra5 volume
+    case 5:
+        // face 1 = N1, N2, N3, N4
+        // face 2 = N1, N5, N2
+        // face 3 = N2, N5, N3
+        // face 4 = N3, N5, N4
+        // face 5 = N4, N5, N1
+        faces[i++].set(4, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2), aVol->GetNode(3));
+        faces[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(1));
+        faces[i++].set(3, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(4), aVol->GetNode(2));
+        faces[i++].set(3, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(4), aVol->GetNode(3));
+        faces[i++].set(3, aVol, aVol->GetID(), 5, aVol->GetNode(3), aVol->GetNode(4), aVol->GetNode(0));
+        break;
+    //penta6 volume
+    case 6:
+        // face 1 = N1, N2, N3
+        // face 2 = N4, N6, N5
+        // face 3 = N1, N4, N5, N2
+        // face 4 = N2, N5, N6, N3
+        // face 5 = N3, N6, N4, N1
+        faces[i++].set(3, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2));
+        faces[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(3), aVol->GetNode(5), aVol->GetNode(4));
+        faces[i++].set(4, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(3), aVol->GetNode(4), aVol->GetNode(1));
+        faces[i++].set(4, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(4), aVol->GetNode(5), aVol->GetNode(2));
+        faces[i++].set(4, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(5), aVol->GetNode(3), aVol->GetNode(0));
+        break;
+    //hexa8 volume
+    case 8:
+        // face 1 = N1, N2, N3, N4
+        // face 2 = N5, N8, N7, N6
+        // face 3 = N1, N5, N6, N2
+        // face 4 = N2, N6, N7, N3
+        // face 5 = N3, N7, N8, N4
+        // face 6 = N4, N8, N5, N1
+        faces[i++].set(4, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2), aVol->GetNode(3));
+        faces[i++].set(4, aVol, aVol->GetID(), 2, aVol->GetNode(4), aVol->GetNode(7), aVol->GetNode(6), aVol->GetNode(5));
+        faces[i++].set(4, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(5), aVol->GetNode(1));
+        faces[i++].set(4, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(5), aVol->GetNode(6), aVol->GetNode(2));
+        faces[i++].set(4, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(6), aVol->GetNode(7), aVol->GetNode(3));
+        faces[i++].set(4, aVol, aVol->GetID(), 6, aVol->GetNode(3), aVol->GetNode(7), aVol->GetNode(4), aVol->GetNode(0));
+        break;
+    //tetra10 volume
+    case 10:
+        // face 1 = N1, N5,  N2, N6,  N3, N7
+        // face 2 = N1, N8,  N4, N9,  N2, N5
+        // face 3 = N2, N9,  N4, N10, N3, N6
+        // face 4 = N3, N10, N4, N8,  N1, N7
+        faces[i++].set(6, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(1), aVol->GetNode(5), aVol->GetNode(2), aVol->GetNode(6));
+        faces[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(7), aVol->GetNode(3), aVol->GetNode(8), aVol->GetNode(1), aVol->GetNode(4));
+        faces[i++].set(6, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(8), aVol->GetNode(3), aVol->GetNode(9), aVol->GetNode(2), aVol->GetNode(5));
+        faces[i++].set(6, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(9), aVol->GetNode(3), aVol->GetNode(7), aVol->GetNode(0), aVol->GetNode(6));
+        break;
+    //pyra13 volume
+    case 13:
+        // face 1 = N1, N6, N2, N7,  N3,  N8, N4, N9
+        // face 2 = N1, N10, N5, N11, N2, N6
+        // face 3 = N2, N11, N5, N12, N3, N7
+        // face 4 = N3, N12, N5, N13, N4, N8
+        // face 5 = N4, N13, N5, N10, N1, N9
+        faces[i++].set(8, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(5),  aVol->GetNode(1), aVol->GetNode(6),  aVol->GetNode(2), aVol->GetNode(7), aVol->GetNode(3), aVol->GetNode(8));
+        faces[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(9),  aVol->GetNode(4), aVol->GetNode(10), aVol->GetNode(1), aVol->GetNode(5));
+        faces[i++].set(6, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(10), aVol->GetNode(4), aVol->GetNode(11), aVol->GetNode(2), aVol->GetNode(6));
+        faces[i++].set(6, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(11), aVol->GetNode(4), aVol->GetNode(12), aVol->GetNode(3), aVol->GetNode(7));
+        faces[i++].set(6, aVol, aVol->GetID(), 5, aVol->GetNode(3), aVol->GetNode(12), aVol->GetNode(4), aVol->GetNode(9),  aVol->GetNode(0), aVol->GetNode(8));
+        break;
+    //penta15 volume
+    case 15:
+        // face 1 = N1, N7,  N2, N8,  N3, N9
+        // face 2 = N4, N12, N6, N11, N5, N10
+        // face 3 = N1, N13, N4, N10, N5, N14, N2, N7
+        // face 4 = N2, N14, N5, N11, N6, N15, N3, N8
+        // face 5 = N3, N15, N6, N12, N4, N13, N1, N9
+        faces[i++].set(6, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(6),  aVol->GetNode(1), aVol->GetNode(7),  aVol->GetNode(2), aVol->GetNode(8));
+        faces[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(3), aVol->GetNode(11), aVol->GetNode(5), aVol->GetNode(10), aVol->GetNode(4), aVol->GetNode(9));
+        faces[i++].set(8, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(12), aVol->GetNode(3), aVol->GetNode(9),  aVol->GetNode(4), aVol->GetNode(13), aVol->GetNode(1), aVol->GetNode(6));
+        faces[i++].set(8, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(13), aVol->GetNode(4), aVol->GetNode(10), aVol->GetNode(5), aVol->GetNode(14), aVol->GetNode(2), aVol->GetNode(7));
+        faces[i++].set(8, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(14), aVol->GetNode(5), aVol->GetNode(11), aVol->GetNode(3), aVol->GetNode(12), aVol->GetNode(0), aVol->GetNode(8));
+        break;
+    //hexa20 volume
+    case 20:
+        // face 1 = N1, N9,  N2, N10, N3, N11, N4, N12
+        // face 2 = N5, N16, N8, N15, N7, N14, N6, N13
+        // face 3 = N1, N17, N5, N13, N6, N18, N2, N9
+        // face 4 = N2, N18, N6, N14, N7, N19, N3, N10
+        // face 5 = N3, N19, N7, N15, N8, N20, N4, N11
+        // face 6 = N4, N20, N8, N16, N5, N17, N1, N12
+        faces[i++].set(8, aVol, aVol->GetID(), 1, aVol->GetNode(0),  aVol->GetNode(8), aVol->GetNode(1),  aVol->GetNode(9), aVol->GetNode(2), aVol->GetNode(10), aVol->GetNode(3), aVol->GetNode(11));
+        faces[i++].set(8, aVol, aVol->GetID(), 2, aVol->GetNode(4), aVol->GetNode(15), aVol->GetNode(7), aVol->GetNode(14), aVol->GetNode(6), aVol->GetNode(13), aVol->GetNode(5), aVol->GetNode(12));
+        faces[i++].set(8, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(16), aVol->GetNode(4), aVol->GetNode(12), aVol->GetNode(5), aVol->GetNode(17), aVol->GetNode(1),  aVol->GetNode(8));
+        faces[i++].set(8, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(17), aVol->GetNode(5), aVol->GetNode(13), aVol->GetNode(6), aVol->GetNode(18), aVol->GetNode(2),  aVol->GetNode(9));
+        faces[i++].set(8, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(18), aVol->GetNode(6), aVol->GetNode(14), aVol->GetNode(7), aVol->GetNode(19), aVol->GetNode(3), aVol->GetNode(10));
+        faces[i++].set(8, aVol, aVol->GetID(), 6, aVol->GetNode(3), aVol->GetNode(19), aVol->GetNode(7), aVol->GetNode(15), aVol->GetNode(4), aVol->GetNode(16), aVol->GetNode(0), aVol->GetNode(11));
+        break;
+    //unknown volume type
+    default:
+        throw std::runtime_error("Node count not supported by ViewProviderFemMesh, [4|5|6|8|10|13|15|20] are allowed");
+    }
+    return i;
+}
+
+/// Number of faces that setVolumeFaces() writes for a volume with numNodes nodes
+static int numVolumeFaces(int numNodes)
+{
+    switch (numNodes){
+    case 4: case 10: return 4;
+    case 5: case 13: return 5;
+    case 6: case 15: return 5;
+    case 8: case 20: return 6;
+    default: return 0;
     }
+}
 
-    return false;
+/**
+ * Hides the faces shared by two elements, these are inside of the volume. The faces are
+ * distributed into buckets by their hash key, each bucket is then sorted by key so that
+ * equal faces become neighbours. Buckets don't share faces so that they are processed
+ * in parallel.
+ */
+static void hideInnerFaces(std::vector<FemFace>& facesHelper)
+{
+    std::size_t numFaces = facesHelper.size();
+    std::vector<std::size_t> keys(numFaces);
+    Base::parallel_for(std::size_t(0), numFaces, [&](std::size_t i) {
+        keys[i] = facesHelper[i].hashKey();
+    });
+
+    const std::size_t numBuckets = std::max<std::size_t>(1, std::min<std::size_t>(4096, numFaces / 1024));
+    std::vector<std::size_t> bucketStart(numBuckets + 1, 0);
+    for (std::size_t i = 0; i < numFaces; i++)
+        bucketStart[keys[i] % numBuckets + 1]++;
+    for (std::size_t b = 0; b < numBuckets; b++)
+        bucketStart[b + 1] += bucketStart[b];
+
+    std::vector<std::size_t> order(numFaces);
+    std::vector<std::size_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (std::size_t i = 0; i < numFaces; i++)
+        order[fill[keys[i] % numBuckets]++] = i;
+
+    Base::parallel_for(std::size_t(0), numBuckets, [&](std::size_t b) {
+        std::vector<std::size_t>::iterator first = order.begin() + bucketStart[b];
+        std::vector<std::size_t>::iterator last = order.begin() + bucketStart[b + 1];
+        std::sort(first, last, [&keys](std::size_t l, std::size_t r) {
+            return keys[l] < keys[r] || (keys[l] == keys[r] && l < r);
+        });
+        for (std::vector<std::size_t>::iterator it = first; it != last; ++it) {
+            FemFace& face = facesHelper[*it];
+            if (face.hide)
+                continue;
+            // faces with the same key but different nodes are possible, check them all
+            for (std::vector<std::size_t>::iterator jt = it + 1; jt != last && keys[*jt] == keys[*it]; ++jt) {
+                FemFace& other = facesHelper[*jt];
+                if (!other.hide && face.isSameFace(other)) {
+                    face.hide = true;
+                    other.hide = true;
+                    break;
+                }
+            }
+        }
+    }, std::size_t(1));
+}
+
+/// Hash over the connectivity of all elements of the mesh
+static std::size_t meshSignature(SMESHDS_Mesh* data)
+{
+    std::size_t signature = data->NbNodes();
+    SMDS_ElemIteratorPtr aElemIter = data->elementsIterator();
+    for (; aElemIter->more();) {
+        const SMDS_MeshElement* aElem = aElemIter->next();
+        boost::hash_combine(signature, aElem->GetID());
+        int num = aElem->NbNodes();
+        for (int i = 0; i < num; i++)
+            boost::hash_combine(signature, aElem->GetNode(i)->GetID());
+    }
+    return signature;
+}
+
+/// color of a scalar value, the color bar goes from blue for min over green for 0 to red for max
+static App::Color calcColor(double value,double min, double max)
+{
+    if (max < 0) max = 0;
+    if (min > 0) min = 0;
+
+    if (value < min)
+        return App::Color (0.0,0.0,1.0);
+    if (value > max)
+        return App::Color (1.0,0.0,0.0);
+    if (value == 0.0)
+        return App::Color (0.0,1.0,0.0);
+    if ( value > max/2.0 )
+        return App::Color (1.0,1-((value-(max/2.0)) / (max/2.0)),0.0);
+    if ( value > 0.0 )
+        return App::Color (value/(max/2.0),1.0,0.0) ;
+    if ( value < min/2.0 )
+        return App::Color (0.0,1-((value-(min/2.0)) / (min/2.0)),1.0);
+    if ( value < 0.0 )
+        return App::Color (0.0,1.0,value/(min/2.0)) ;
+    return App::Color (0,0,0);
 }
 
 // ----------------------------------------------------------------------------
@@ -241,6 +437,25 @@ ViewProviderFemMesh::ViewProviderFemMesh()
     pcPointMaterial->ref();
     //PointMaterial.touch();
 
+    // node scalars mapped to colors by the texture unit, off until scalars are set
+    pcScalarSwitch = new SoSwitch;
+    pcScalarSwitch->ref();
+    pcScalarSwitch->whichChild = SO_SWITCH_NONE;
+    pcColorBar = new SoTexture2;
+    pcColorBar->wrapS = SoTexture2::CLAMP;
+    pcColorBar->wrapT = SoTexture2::CLAMP;
+    pcColorBar->model = SoTexture2::MODULATE;
+    pcScalarTransform = new SoTexture2Transform;
+    pcScalarCoords = new SoTextureCoordinate2;
+    SoTextureCoordinateBinding* pcScalarBinding = new SoTextureCoordinateBinding;
+    pcScalarBinding->value = SoTextureCoordinateBinding::PER_VERTEX_INDEXED;
+    SoGroup* pcScalarGroup = new SoGroup;
+    pcScalarGroup->addChild(pcColorBar);
+    pcScalarGroup->addChild(pcScalarTransform);
+    pcScalarGroup->addChild(pcScalarCoords);
+    pcScalarGroup->addChild(pcScalarBinding);
+    pcScalarSwitch->addChild(pcScalarGroup);
+
     DisplacementFactor = 0;
 }
 
@@ -255,6 +470,7 @@ ViewProviderFemMesh::~ViewProviderFemMesh()
     pcPointMaterial->unref();
     pcPointStyle->unref();
     pcAnoCoords->unref();
+    pcScalarSwitch->unref();
 }
 
 void ViewProviderFemMesh::attach(App::DocumentObject *pcObj)
@@ -286,7 +502,11 @@ void ViewProviderFemMesh::attach(App::DocumentObject *pcObj)
     pcFlatRoot->addChild(pShapeHints);
     pcFlatRoot->addChild(pcShapeMaterial);
     pcFlatRoot->addChild(pcMatBinding);
-    pcFlatRoot->addChild(pcFaces);
+    // keep the color bar texture away from the annotations
+    SoSeparator* pcFaceRoot = new SoSeparator();
+    pcFaceRoot->addChild(pcScalarSwitch);
+    pcFaceRoot->addChild(pcFaces);
+    pcFlatRoot->addChild(pcFaceRoot);
     pcFlatRoot->addChild(pcAnotRoot);
     addDisplayMaskMode(pcFlatRoot, Private::dm_face);
 
@@ -366,7 +586,7 @@ void ViewProviderFemMesh::updateData(const App::Property* prop)
         ViewProviderFEMMeshBuilder builder;
         resetColorByNodeId();
         resetDisplacementByNodeId();
-        builder.createMesh(prop, pcCoords, pcFaces, pcLines, vFaceElementIdx, vNodeElementIdx, onlyEdges, ShowInner.getValue(), MaxFacesShowInner.getValue());
+        builder.createMesh(prop, pcCoords, pcFaces, pcLines, vFaceElementIdx, vNodeElementIdx, onlyEdges, ShowInner.getValue(), MaxFacesShowInner.getValue(), &meshCache);
     }
     Gui::ViewProviderGeometryObject::updateData(prop);
 }
@@ -392,9 +612,11 @@ void ViewProviderFemMesh::onChanged(const App::Property* prop)
     else if (prop == &ShowInner ) {
         // recalc mesh with new settings
         ViewProviderFEMMeshBuilder builder;
+        resetColorByNodeId();
+        resetDisplacementByNodeId();
         builder.createMesh(&(static_cast<Fem::FemMeshObject*>(this->pcObject)->FemMesh),
                            pcCoords, pcFaces, pcLines, vFaceElementIdx, vNodeElementIdx,
-                           onlyEdges, ShowInner.getValue(), MaxFacesShowInner.getValue());
+                           onlyEdges, ShowInner.getValue(), MaxFacesShowInner.getValue(), &meshCache);
     }
     else if (prop == &LineWidth) {
         pcDrawStyle->lineWidth = LineWidth.getValue();
@@ -552,6 +774,7 @@ void ViewProviderFemMesh::setColorByNodeId(const std::vector<long> &NodeIds,cons
 
 void ViewProviderFemMesh::setColorByNodeIdHelper(const std::vector<App::Color> &colorVec)
 {
+    pcScalarSwitch->whichChild = SO_SWITCH_NONE;
     pcMatBinding->value = SoMaterialBinding::PER_VERTEX_INDEXED;
 
     // resizing and writing the color vector:
@@ -567,8 +790,63 @@ void ViewProviderFemMesh::setColorByNodeIdHelper(const std::vector<App::Color> &
     pcShapeMaterial->diffuseColor.finishEditing();
 }
 
+void ViewProviderFemMesh::setColorByScalars(const std::vector<long> &NodeIds,const std::vector<double> &Values)
+{
+    if (NodeIds.empty() || NodeIds.size() != Values.size())
+        return;
+
+    // nodes without a value show the color of 0
+    long endId = *(std::max_element(NodeIds.begin(), NodeIds.end()));
+    std::vector<float> scalarVec(endId+1, 0.0f);
+    for (std::size_t i=0; i<NodeIds.size(); i++)
+        scalarVec[NodeIds[i]] = static_cast<float>(Values[i]);
+
+    pcScalarCoords->point.setNum(vNodeElementIdx.size());
+    SbVec2f* coords = pcScalarCoords->point.startEditing();
+    for (std::size_t i=0; i<vNodeElementIdx.size(); i++) {
+        unsigned long id = vNodeElementIdx[i];
+        coords[i].setValue(id < scalarVec.size() ? scalarVec[id] : 0.0f, 0.5f);
+    }
+    pcScalarCoords->point.finishEditing();
+
+    std::pair<std::vector<double>::const_iterator, std::vector<double>::const_iterator> range;
+    range = std::minmax_element(Values.begin(), Values.end());
+    setColorRange(*range.first, *range.second);
+
+    // the texture modulates the material
+    pcMatBinding->value = SoMaterialBinding::OVERALL;
+    pcShapeMaterial->diffuseColor.setValue(1.0f,1.0f,1.0f);
+    pcScalarSwitch->whichChild = 0;
+}
+
+void ViewProviderFemMesh::setColorRange(double min, double max)
+{
+    // the color bar always contains 0, see calcColor()
+    double lower = std::min(min, 0.0);
+    double upper = std::max(max, 0.0);
+    if (upper - lower < 1e-12)
+        upper = lower + 1.0;
+
+    const int numTexels = 256;
+    std::vector<unsigned char> image(3*numTexels);
+    for (int i=0; i<numTexels; i++) {
+        double value = lower + (upper - lower) * (i + 0.5) / numTexels;
+        App::Color c = calcColor(value, min, max);
+        image[3*i  ] = static_cast<unsigned char>(c.r * 255.0f + 0.5f);
+        image[3*i+1] = static_cast<unsigned char>(c.g * 255.0f + 0.5f);
+        image[3*i+2] = static_cast<unsigned char>(c.b * 255.0f + 0.5f);
+    }
+    pcColorBar->image.setValue(SbVec2s(numTexels, 1), 3, image.data());
+
+    // maps [lower, upper] of the scalars to [0, 1] of the texture
+    float scale = static_cast<float>(1.0 / (upper - lower));
+    pcScalarTransform->scaleFactor.setValue(scale, 1.0f);
+    pcScalarTransform->translation.setValue(static_cast<float>(-lower) * scale, 0.0f);
+}
+
 void ViewProviderFemMesh::resetColorByNodeId(void)
 {
+    pcScalarSwitch->whichChild = SO_SWITCH_NONE;
     pcMatBinding->value = SoMaterialBinding::OVERALL;
     pcShapeMaterial->diffuseColor.setNum(0);
     const App::Color& c = ShapeColor.getValue();
@@ -605,10 +883,18 @@ void ViewProviderFemMesh::setDisplacementByNodeId(const std::vector<long> &NodeI
 
 void ViewProviderFemMesh::setDisplacementByNodeIdHelper(const std::vector<Base::Vector3d>& DispVector,long startId)
 {
+    // remember the undeformed positions, all displacements are applied relative to them
+    if (BaseCoordinates.empty()) {
+        const SbVec3f* verts = pcCoords->point.getValues(0);
+        BaseCoordinates.assign(verts, verts + pcCoords->point.getNum());
+    }
+
     DisplacementVector.resize(vNodeElementIdx.size());
     int i=0;
-    for(std::vector<unsigned long>::const_iterator it=vNodeElementIdx.begin();it!=vNodeElementIdx.end();++it,i++)
-        DisplacementVector[i] = DispVector[*it-startId];
+    for(std::vector<unsigned long>::const_iterator it=vNodeElementIdx.begin();it!=vNodeElementIdx.end();++it,i++) {
+        const Base::Vector3d& disp = DispVector[*it-startId];
+        DisplacementVector[i].setValue((float)disp.x,(float)disp.y,(float)disp.z);
+    }
     applyDisplacementToNodes(1.0);
 
 }
@@ -617,6 +903,7 @@ void ViewProviderFemMesh::resetDisplacementByNodeId(void)
 {
     applyDisplacementToNodes(0.0);
     DisplacementVector.clear();
+    BaseCoordinates.clear();
 }
 /// reaply the node displacement with a certain factor and do a redraw
 void ViewProviderFemMesh::applyDisplacementToNodes(double factor)
@@ -624,25 +911,18 @@ void ViewProviderFemMesh::applyDisplacementToNodes(double factor)
     if(DisplacementVector.size() == 0)
         return;
 
-    float x,y,z;
-    // set the point coordinates
-    long sz = pcCoords->point.getNum();
+    // set the point coordinates, a single pass over the undeformed positions
+    std::size_t sz = pcCoords->point.getNum();
+    if (sz != BaseCoordinates.size() || sz != DisplacementVector.size())
+        return;
     SbVec3f* verts = pcCoords->point.startEditing();
-    for (long i=0;i < sz ;i++) {
-        verts[i].getValue(x,y,z);
-        // undo old factor#
-        Base::Vector3d oldDisp = DisplacementVector[i] * DisplacementFactor;
-        x -= oldDisp.x;
-        y -= oldDisp.y;
-        z -= oldDisp.z;
-        // apply new factor
-        Base::Vector3d newDisp = DisplacementVector[i] * factor;
-        x += newDisp.x;
-        y += newDisp.y;
-        z += newDisp.z;
-        // set the new value
-        verts[i].setValue(x,y,z);
-    }
+    const float f = static_cast<float>(factor);
+    const std::size_t blockSize = 0x10000;
+    Base::parallel_for(std::size_t(0), (sz + blockSize - 1) / blockSize, [&](std::size_t block) {
+        std::size_t end = std::min(block * blockSize + blockSize, sz);
+        for (std::size_t i = block * blockSize; i < end; i++)
+            verts[i] = BaseCoordinates[i] + f * DisplacementVector[i];
+    }, std::size_t(1));
     pcCoords->point.finishEditing();
 
     DisplacementFactor = factor;
@@ -650,6 +930,7 @@ void ViewProviderFemMesh::applyDisplacementToNodes(double factor)
 
 void ViewProviderFemMesh::setColorByElementId(const std::map<long,App::Color> &ElementColorMap)
 {
+    pcScalarSwitch->whichChild = SO_SWITCH_NONE;
     pcMatBinding->value = SoMaterialBinding::PER_FACE ;
 
     // resizing and writing the color vector:
@@ -673,6 +954,7 @@ void ViewProviderFemMesh::setColorByElementId(const std::map<long,App::Color> &E
 
 void ViewProviderFemMesh::resetColorByElementId(void)
 {
+    pcScalarSwitch->whichChild = SO_SWITCH_NONE;
     pcMatBinding->value = SoMaterialBinding::OVERALL;
     pcShapeMaterial->diffuseColor.setNum(0);
     const App::Color& c = ShapeColor.getValue();
@@ -734,7 +1016,8 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
                                             std::vector<unsigned long> &vNodeElementIdx,
                                             bool &onlyEdges,
                                             bool ShowInner,
-                                            int MaxFacesShowInner) const
+                                            int MaxFacesShowInner,
+                                            Cache* cache) const
 {
 
     const Fem::PropertyFemMesh* mesh = static_cast<const Fem::PropertyFemMesh*>(prop);
@@ -749,11 +1032,34 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
         coords->point.setNum(0);
         faces->coordIndex.setNum(0);
         lines->coordIndex.setNum(0);
+        if (cache)
+            cache->valid = false;
         return;
     }
     Base::TimeInfo Start;
     Base::Console().Log("Start: ViewProviderFEMMeshBuilder::createMesh() =================================\n");
 
+    // if the elements didn't change only the node positions need an update
+    std::size_t signature = 0;
+    if (cache) {
+        signature = meshSignature(data);
+        boost::hash_combine(signature, ShowInner);
+        boost::hash_combine(signature, MaxFacesShowInner);
+        if (cache->valid && cache->signature == signature &&
+            coords->point.getNum() == static_cast<int>(vNodeElementIdx.size())) {
+            SbVec3f* verts = coords->point.startEditing();
+            for (std::size_t i=0; i<vNodeElementIdx.size(); i++) {
+                const SMDS_MeshNode* node = data->FindNode(static_cast<int>(vNodeElementIdx[i]));
+                if (node)
+                    verts[i].setValue((float)node->X(),(float)node->Y(),(float)node->Z());
+            }
+            coords->point.finishEditing();
+            Base::Console().Log("    %f: Finish, elements unchanged ===========================================\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
+            return;
+        }
+        cache->valid = false;
+    }
+
     const SMDS_MeshInfo& info = data->GetMeshInfo();
     int numTria = info.NbTriangles();
     int numQuad = info.NbQuadrangles();
@@ -784,8 +1090,6 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
     std::vector<FemFace> facesHelper(numTries);
 
     Base::Console().Log("    %f: Start build up %i face helper\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()),facesHelper.size());
-    Base::BoundBox3d BndBox;
-
     int i=0;
 
     if (ShowFaces){
@@ -797,19 +1101,19 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
             switch(num){
             case 3:
                 //tria3 face = N1, N2, N3
-                BndBox.Add(facesHelper[i++].set(3, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(1), aFace->GetNode(2)));
+                facesHelper[i++].set(3, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(1), aFace->GetNode(2));
                 break;
             case 4:
                 //quad4 face = N1, N2, N3, N4
-                BndBox.Add(facesHelper[i++].set(4, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(1), aFace->GetNode(2), aFace->GetNode(3)));
+                facesHelper[i++].set(4, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(1), aFace->GetNode(2), aFace->GetNode(3));
                 break;
             case 6:
                 //tria6 face = N1, N4, N2, N5, N3, N6
-                BndBox.Add(facesHelper[i++].set(6, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(3), aFace->GetNode(1), aFace->GetNode(4), aFace->GetNode(2), aFace->GetNode(5)));
+                facesHelper[i++].set(6, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(3), aFace->GetNode(1), aFace->GetNode(4), aFace->GetNode(2), aFace->GetNode(5));
                 break;
             case 8:
                 //quad8 face = N1, N5, N2, N6, N3, N7, N4, N8
-                BndBox.Add(facesHelper[i++].set(8, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(4), aFace->GetNode(1), aFace->GetNode(5), aFace->GetNode(2), aFace->GetNode(6), aFace->GetNode(3), aFace->GetNode(7)));
+                facesHelper[i++].set(8, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(4), aFace->GetNode(1), aFace->GetNode(5), aFace->GetNode(2), aFace->GetNode(6), aFace->GetNode(3), aFace->GetNode(7));
                 break;
             default:
                 //unknown face type
@@ -819,211 +1123,39 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
     }
     else{
 
-        // iterate all volumes
+        // collect all volumes, the faces are then set up in parallel
+        std::vector<const SMDS_MeshVolume*> volumes;
+        std::vector<int> offsets;
+        volumes.reserve(numVolu);
+        offsets.reserve(numVolu+1);
         SMDS_VolumeIteratorPtr aVolIter = data->volumesIterator();
         for (; aVolIter->more();) {
             const SMDS_MeshVolume* aVol = aVolIter->next();
-
-            int num = aVol->NbNodes();
-
-            switch (num){
-            //tetra4 volume
-            case 4:
-                // face 1 = N1, N2, N3
-                // face 2 = N1, N4, N2
-                // face 3 = N2, N4, N3
-                // face 4 = N3, N4, N1
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(3), aVol->GetNode(1)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(3), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(3), aVol->GetNode(0)));
-                break;
-            //pyra5 volume
-            case 5:
-                // face 1 = N1, N2, N3, N4
-                // face 2 = N1, N5, N2
-                // face 3 = N2, N5, N3
-                // face 4 = N3, N5, N4
-                // face 5 = N4, N5, N1
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2), aVol->GetNode(3)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(1)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(4), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(4), aVol->GetNode(3)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 5, aVol->GetNode(3), aVol->GetNode(4), aVol->GetNode(0)));
-                break;
-            //penta6 volume
-            case 6:
-                // face 1 = N1, N2, N3
-                // face 2 = N4, N6, N5
-                // face 3 = N1, N4, N5, N2
-                // face 4 = N2, N5, N6, N3
-                // face 5 = N3, N6, N4, N1
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(3), aVol->GetNode(5), aVol->GetNode(4)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(3), aVol->GetNode(4), aVol->GetNode(1)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(4), aVol->GetNode(5), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(5), aVol->GetNode(3), aVol->GetNode(0)));
-                break;
-            //hexa8 volume
-            case 8:
-                // face 1 = N1, N2, N3, N4
-                // face 2 = N5, N8, N7, N6
-                // face 3 = N1, N5, N6, N2
-                // face 4 = N2, N6, N7, N3
-                // face 5 = N3, N7, N8, N4
-                // face 6 = N4, N8, N5, N1
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2), aVol->GetNode(3)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 2, aVol->GetNode(4), aVol->GetNode(7), aVol->GetNode(6), aVol->GetNode(5)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(5), aVol->GetNode(1)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(5), aVol->GetNode(6), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(6), aVol->GetNode(7), aVol->GetNode(3)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 6, aVol->GetNode(3), aVol->GetNode(7), aVol->GetNode(4), aVol->GetNode(0)));
-                break;
-            //tetra10 volume
-            case 10:
-                // face 1 = N1, N5,  N2, N6,  N3, N7
-                // face 2 = N1, N8,  N4, N9,  N2, N5
-                // face 3 = N2, N9,  N4, N10, N3, N6
-                // face 4 = N3, N10, N4, N8,  N1, N7
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(1), aVol->GetNode(5), aVol->GetNode(2), aVol->GetNode(6)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(7), aVol->GetNode(3), aVol->GetNode(8), aVol->GetNode(1), aVol->GetNode(4)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(8), aVol->GetNode(3), aVol->GetNode(9), aVol->GetNode(2), aVol->GetNode(5)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(9), aVol->GetNode(3), aVol->GetNode(7), aVol->GetNode(0), aVol->GetNode(6)));
-                break;
-            //pyra13 volume
-            case 13:
-                // face 1 = N1, N6, N2, N7,  N3,  N8, N4, N9
-                // face 2 = N1, N10, N5, N11, N2, N6
-                // face 3 = N2, N11, N5, N12, N3, N7
-                // face 4 = N3, N12, N5, N13, N4, N8
-                // face 5 = N4, N13, N5, N10, N1, N9
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(5),  aVol->GetNode(1), aVol->GetNode(6),  aVol->GetNode(2), aVol->GetNode(7), aVol->GetNode(3), aVol->GetNode(8)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(9),  aVol->GetNode(4), aVol->GetNode(10), aVol->GetNode(1), aVol->GetNode(5)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(10), aVol->GetNode(4), aVol->GetNode(11), aVol->GetNode(2), aVol->GetNode(6)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(11), aVol->GetNode(4), aVol->GetNode(12), aVol->GetNode(3), aVol->GetNode(7)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 5, aVol->GetNode(3), aVol->GetNode(12), aVol->GetNode(4), aVol->GetNode(9),  aVol->GetNode(0), aVol->GetNode(8)));
-                break;
-            //penta15 volume
-            case 15:
-                // face 1 = N1, N7,  N2, N8,  N3, N9
-                // face 2 = N4, N12, N6, N11, N5, N10
-                // face 3 = N1, N13, N4, N10, N5, N14, N2, N7
-                // face 4 = N2, N14, N5, N11, N6, N15, N3, N8
-                // face 5 = N3, N15, N6, N12, N4, N13, N1, N9
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(6),  aVol->GetNode(1), aVol->GetNode(7),  aVol->GetNode(2), aVol->GetNode(8)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(3), aVol->GetNode(11), aVol->GetNode(5), aVol->GetNode(10), aVol->GetNode(4), aVol->GetNode(9)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(12), aVol->GetNode(3), aVol->GetNode(9),  aVol->GetNode(4), aVol->GetNode(13), aVol->GetNode(1), aVol->GetNode(6)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(13), aVol->GetNode(4), aVol->GetNode(10), aVol->GetNode(5), aVol->GetNode(14), aVol->GetNode(2), aVol->GetNode(7)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(14), aVol->GetNode(5), aVol->GetNode(11), aVol->GetNode(3), aVol->GetNode(12), aVol->GetNode(0), aVol->GetNode(8)));
-                break;
-            //hexa20 volume
-            case 20:
-                // face 1 = N1, N9,  N2, N10, N3, N11, N4, N12
-                // face 2 = N5, N16, N8, N15, N7, N14, N6, N13
-                // face 3 = N1, N17, N5, N13, N6, N18, N2, N9
-                // face 4 = N2, N18, N6, N14, N7, N19, N3, N10
-                // face 5 = N3, N19, N7, N15, N8, N20, N4, N11
-                // face 6 = N4, N20, N8, N16, N5, N17, N1, N12
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 1, aVol->GetNode(0),  aVol->GetNode(8), aVol->GetNode(1),  aVol->GetNode(9), aVol->GetNode(2), aVol->GetNode(10), aVol->GetNode(3), aVol->GetNode(11)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 2, aVol->GetNode(4), aVol->GetNode(15), aVol->GetNode(7), aVol->GetNode(14), aVol->GetNode(6), aVol->GetNode(13), aVol->GetNode(5), aVol->GetNode(12)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(16), aVol->GetNode(4), aVol->GetNode(12), aVol->GetNode(5), aVol->GetNode(17), aVol->GetNode(1),  aVol->GetNode(8)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(17), aVol->GetNode(5), aVol->GetNode(13), aVol->GetNode(6), aVol->GetNode(18), aVol->GetNode(2),  aVol->GetNode(9)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(18), aVol->GetNode(6), aVol->GetNode(14), aVol->GetNode(7), aVol->GetNode(19), aVol->GetNode(3), aVol->GetNode(10)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 6, aVol->GetNode(3), aVol->GetNode(19), aVol->GetNode(7), aVol->GetNode(15), aVol->GetNode(4), aVol->GetNode(16), aVol->GetNode(0), aVol->GetNode(11)));
-                break;
-            //unknown volume type
-            default:
-                throw std::runtime_error("Node count not supported by ViewProviderFemMesh, [4|5|6|8|10|13|15|20] are allowed");
-            }
+            offsets.push_back(i);
+            i += numVolumeFaces(aVol->NbNodes());
+            volumes.push_back(aVol);
         }
+        facesHelper.resize(i);
+
+        Base::parallel_for(std::size_t(0), volumes.size(), [&](std::size_t v) {
+            setVolumeFaces(facesHelper.data() + offsets[v], volumes[v]);
+        });
     }
     int FaceSize = facesHelper.size();
 
 
-    if( FaceSize < MaxFacesShowInner){
-        Base::Console().Log("    %f: Start eliminate internal faces SIMPLE\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
-
-        // search for double (inside) faces and hide them
-        if(!ShowInner){
-            for(int l=0; l< FaceSize;l++){
-                if(! facesHelper[l].hide){
-                    for(int i=l+1; i<FaceSize; i++){
-                        if(facesHelper[l].isSameFace(facesHelper[i]) ){
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-    }else{
-        Base::Console().Log("    %f: Start eliminate internal faces GRID\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
-        BndBox.Enlarge(BndBox.CalcDiagonalLength()/10000.0);
-        // calculate grid properties
-        double edge = pow(FaceSize,1.0/3.0);
-        double edgeL = BndBox.LengthX() + BndBox.LengthY() + BndBox.LengthZ();
-        double gridFactor = 5.0;
-        double size = ( edgeL /(3*edge) )*gridFactor;
-
-        unsigned int NbrX = (unsigned int)(BndBox.LengthX()/size)+1;
-        unsigned int NbrY = (unsigned int)(BndBox.LengthY()/size)+1;
-        unsigned int NbrZ = (unsigned int)(BndBox.LengthZ()/size)+1;
-        Base::Console().Log("      Size:F:%f,  X:%i  ,Y:%i  ,Z:%i\n",gridFactor,NbrX,NbrY,NbrZ);
-
-        double Xmin = BndBox.MinX;
-        double Ymin = BndBox.MinY;
-        double Zmin = BndBox.MinZ;
-        double Xln  = BndBox.LengthX() / NbrX;
-        double Yln  = BndBox.LengthY() / NbrY;
-        double Zln  = BndBox.LengthZ() / NbrZ;
-
-        std::vector<FemFaceGridItem> Grid(NbrX*NbrY*NbrZ);
-
-
-        unsigned int iX = 0;
-        unsigned int iY = 0;
-        unsigned int iZ = 0;
-
-        for(int l=0; l< FaceSize;l++){
-            Base::Vector3d point(facesHelper[l].getFirstNodePoint());
-            double x = (point.x - Xmin) / Xln;
-            double y = (point.y - Ymin) / Yln;
-            double z = (point.z - Zmin) / Zln;
-
-            iX = x;
-            iY = y;
-            iZ = z;
-
-            if(iX >= NbrX || iY >= NbrY || iZ >= NbrZ)
-                Base::Console().Log("      Outof range!\n");
-
-            Grid[iX + iY*NbrX + iZ*NbrX*NbrY].push_back(&facesHelper[l]);
-        }
-
-        unsigned int max =0, avg = 0;
-        for(std::vector<FemFaceGridItem>::iterator it=Grid.begin();it!=Grid.end();++it){
-            for(unsigned int l=0; l< it->size();l++){
-                if(! it->operator[](l)->hide){
-                    for(unsigned int i=l+1; i<it->size(); i++){
-                        if(it->operator[](l)->isSameFace(*(it->operator[](i))) ){
-                            break;
-                        }
-                    }
-                }
-            }
-            if(it->size() > max)max=it->size();
-            avg += it->size();
-        }
-        avg = avg/Grid.size();
-
-        Base::Console().Log("      VoxelSize: Max:%i ,Average:%i\n",max,avg);
-
-    } //if( FaceSize < 1000)
+    // inner faces are only shown for small meshes
+    if(!ShowInner || FaceSize >= MaxFacesShowInner){
+        Base::Console().Log("    %f: Start eliminate internal faces\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
+        hideInnerFaces(facesHelper);
+    }
 
 
     Base::Console().Log("    %f: Start build up node map\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 
     // sort out double nodes and build up index map
-    std::map<const SMDS_MeshNode*, int> mapNodeIndex;
+    std::unordered_map<const SMDS_MeshNode*, int> mapNodeIndex;
+    mapNodeIndex.reserve(numNodes);
 
     // handling the corner case beams only, means no faces/triangles only nodes and edges
     if (onlyEdges){
@@ -1055,7 +1187,7 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
     // set the point coordinates
     coords->point.setNum(mapNodeIndex.size());
     vNodeElementIdx.resize(mapNodeIndex.size() );
-    std::map<const SMDS_MeshNode*, int>::iterator it=  mapNodeIndex.begin();
+    std::unordered_map<const SMDS_MeshNode*, int>::iterator it=  mapNodeIndex.begin();
     SbVec3f* verts = coords->point.startEditing();
     for (int i=0;it != mapNodeIndex.end() ;++it,i++) {
         verts[i].setValue((float)it->first->X(),(float)it->first->Y(),(float)it->first->Z());
@@ -2483,6 +2615,11 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
     lines->coordIndex.finishEditing();
     Base::Console().Log("    NumEdges:%i\n",EdgeSize);
 
+    if (cache) {
+        cache->signature = signature;
+        cache->valid = true;
+    }
+
     Base::Console().Log("    %f: Finish =========================================================\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 
 
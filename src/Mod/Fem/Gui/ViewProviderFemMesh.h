@@ -29,6 +29,7 @@
 #include <Gui/ViewProviderPythonFeature.h>
 
 #include <CXX/Objects.hxx>
+#include <Inventor/SbVec3f.h>
 
 class SoCoordinate3;
 class SoDrawStyle;
@@ -36,6 +37,10 @@ class SoIndexedFaceSet;
 class SoIndexedLineSet;
 class SoShapeHints;
 class SoMaterialBinding;
+class SoSwitch;
+class SoTexture2;
+class SoTexture2Transform;
+class SoTextureCoordinate2;
 
 namespace FemGui
 {
@@ -43,6 +48,14 @@ namespace FemGui
 class ViewProviderFEMMeshBuilder : public Gui::ViewProviderBuilder
 {
 public:
+    /// Remembers the elements of the last build, if they didn't change
+    /// createMesh() only updates the node coordinates
+    struct Cache {
+        Cache() : signature(0), valid(false) {}
+        std::size_t signature;
+        bool valid;
+    };
+
     ViewProviderFEMMeshBuilder(){}
     virtual ~ViewProviderFEMMeshBuilder(){}
     virtual void buildNodes(const App::Property*, std::vector<SoNode*>&) const;
@@ -54,7 +67,8 @@ public:
                     std::vector<unsigned long>&,
                     bool &edgeOnly,
                     bool ShowInner,
-                    int MaxFacesShowInner
+                    int MaxFacesShowInner,
+                    Cache* cache = 0
                    ) const;
 };
 
@@ -113,6 +127,12 @@ public:
     void setColorByNodeId(const std::map<long,App::Color> &NodeColorMap);
     void setColorByNodeId(const std::vector<long> &NodeIds,const std::vector<App::Color>  &NodeColors);
 
+    /** set a scalar for each node, the scalars are uploaded once as texture
+     * coordinates and mapped to colors by a color bar texture
+     */
+    void setColorByScalars(const std::vector<long> &NodeIds,const std::vector<double> &Values);
+    /// set the range of scalars covered by the color bar, values outside get the end colors
+    void setColorRange(double min, double max);
     /// reset the view of the node colors
     void resetColorByNodeId(void);
     /// set the displacement for each node
@@ -148,7 +168,8 @@ protected:
     std::vector<unsigned long> vNodeElementIdx;
     std::vector<unsigned long> vHighlightedIdx;
 
-    std::vector<Base::Vector3d> DisplacementVector;
+    std::vector<SbVec3f>        DisplacementVector;
+    std::vector<SbVec3f>        BaseCoordinates;
     double                      DisplacementFactor;
 
     SoMaterial            * pcPointMaterial;
@@ -161,8 +182,13 @@ protected:
     SoCoordinate3         * pcAnoCoords;
     SoIndexedFaceSet      * pcFaces;
     SoIndexedLineSet      * pcLines;
+    SoSwitch              * pcScalarSwitch;
+    SoTexture2            * pcColorBar;
+    SoTexture2Transform   * pcScalarTransform;
+    SoTextureCoordinate2  * pcScalarCoords;
 
     bool onlyEdges;
+    ViewProviderFEMMeshBuilder::Cache meshCache;
 
 private:
     class Private;
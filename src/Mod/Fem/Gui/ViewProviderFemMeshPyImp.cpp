@@ -43,33 +43,8 @@ PyObject* ViewProviderFemMeshPy::applyDisplacement(PyObject * args)
 }
 
 
-App::Color calcColor(double value,double min, double max)
-{
-    if (max < 0) max = 0;
-    if (min > 0) min = 0;
-
-    if (value < min)
-        return App::Color (0.0,0.0,1.0);
-    if (value > max)
-        return App::Color (1.0,0.0,0.0);
-    if (value == 0.0)
-        return App::Color (0.0,1.0,0.0);
-    if ( value > max/2.0 )
-        return App::Color (1.0,1-((value-(max/2.0)) / (max/2.0)),0.0);
-    if ( value > 0.0 )
-        return App::Color (value/(max/2.0),1.0,0.0) ;
-    if ( value < min/2.0 )
-        return App::Color (0.0,1-((value-(min/2.0)) / (min/2.0)),1.0);
-    if ( value < 0.0 )
-        return App::Color (0.0,1.0,value/(min/2.0)) ;
-    return App::Color (0,0,0);
-}
-
-
 PyObject* ViewProviderFemMeshPy::setNodeColorByScalars(PyObject *args)
 {
-    double max = -1e12;
-    double min = +1e12;
     PyObject *node_ids_py;
     PyObject *values_py;
 
@@ -81,7 +56,10 @@ PyObject* ViewProviderFemMeshPy::setNodeColorByScalars(PyObject *args)
             PyErr_SetString(Base::BaseExceptionFreeCADError, "PyList_Size < 0. That is not a valid list!");
             Py_Return;
         }
-        std::vector<App::Color> node_colors(num_items);
+        if (PyList_Size(values_py) != num_items) {
+            PyErr_SetString(PyExc_ValueError, "Node ids and values must have the same length");
+            return 0;
+        }
         for (int i=0; i<num_items; i++){
             PyObject *id_py = PyList_GetItem(node_ids_py, i);
             long id = PyLong_AsLong(id_py);
@@ -89,15 +67,8 @@ PyObject* ViewProviderFemMeshPy::setNodeColorByScalars(PyObject *args)
             PyObject *value_py = PyList_GetItem(values_py, i);
             double val = PyFloat_AsDouble(value_py);
             values.push_back(val);
-            if(val > max)
-                max = val;
-            if(val < min)
-                min = val;
         }
-        long i=0;
-        for(std::vector<double>::const_iterator it=values.begin(); it!=values.end(); ++it, i++)
-            node_colors[i] = calcColor(*it, min, max);
-        this->getViewProviderFemMeshPtr()->setColorByNodeId(ids, node_colors);
+        this->getViewProviderFemMeshPtr()->setColorByScalars(ids, values);
     } else {
         PyErr_SetString(Base::BaseExceptionFreeCADError, "PyArg_ParseTuple failed. Invalid arguments used with setNodeByScalars");
         return 0;
@@ -106,6 +77,16 @@ PyObject* ViewProviderFemMeshPy::setNodeColorByScalars(PyObject *args)
 }
 
 
+PyObject* ViewProviderFemMeshPy::setNodeColorRange(PyObject *args)
+{
+    double min, max;
+    if (!PyArg_ParseTuple(args, "dd", &min, &max))
+        return 0;
+    this->getViewProviderFemMeshPtr()->setColorRange(min, max);
+    Py_Return;
+}
+
+
 PyObject* ViewProviderFemMeshPy::resetNodeColor(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
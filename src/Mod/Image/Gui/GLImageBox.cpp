@@ -19,6 +19,7 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <cmath>
+# include <QTimer>
 # include <QMessageBox>
 #endif
 
@@ -74,6 +75,8 @@ GLImageBox::GLImageBox(QWidget * parent, const QGLWidget * shareWidget, Qt::Wind
 // Destructor
 GLImageBox::~GLImageBox()
 {
+    makeCurrent();
+    _tiles.releaseTextures();
     try
     {
         delete [] _pColorMap;
@@ -207,9 +210,18 @@ void GLImageBox::drawImage()
         GLenum pixType;
         getPixFormat(pixFormat, pixType);
 
-        // Draw the defined source rectangle
-        glDrawPixels(dx, dy, pixFormat, pixType, (GLvoid *)pPix);
+        // Large images are drawn as textured tiles at the resolution matching the zoom factor,
+        // until its pyramid level is ready the defined source rectangle is drawn directly
+        bool complete = true;
+        bool tiled = _tiles.draw(tlx, tly, dx, dy, ICToWC_X(-0.5), ICToWC_Y(-0.5), _zoomFactor,
+                                 pixFormat, pixType, complete);
+        if (!tiled)
+            glDrawPixels(dx, dy, pixFormat, pixType, (GLvoid *)pPix);
         glFlush();
+
+        // Draw again when the missing tiles or pyramid levels are available
+        if (!complete)
+            QTimer::singleShot(tiled ? 0 : 100, this, SLOT(update()));
     }
 }
 
@@ -545,6 +557,7 @@ double GLImageBox::ICToWC_Y(double ImageY)
 // Clears the image data
 void GLImageBox::clearImage()
 {
+    _tiles.reset();
     _image.clear();
     resetDisplay();
 }
@@ -565,7 +578,10 @@ void GLImageBox::clearImage()
 int GLImageBox::createImageCopy(void* pSrcPixelData, unsigned long width, unsigned long height, int format, unsigned short numSigBitsPerSample, int displayMode)
 {
     // Copy image
+    _tiles.reset();
     int ret = _image.createCopy(pSrcPixelData, width, height, format, numSigBitsPerSample);
+    if ((ret == 0) && ImageTiles::isUseful(_image))
+        _tiles.setImage(&_image);
 
     // Set display settings depending on mode
     if (displayMode == IV_DISPLAY_RESET)
@@ -607,7 +623,10 @@ int GLImageBox::createImageCopy(void* pSrcPixelData, unsigned long width, unsign
 int GLImageBox::pointImageTo(void* pSrcPixelData, unsigned long width, unsigned long height, int format, unsigned short numSigBitsPerSample, bool takeOwnership, int displayMode)
 {
     // Point to image
+    _tiles.reset();
     int ret = _image.pointTo(pSrcPixelData, width, height, format, numSigBitsPerSample, takeOwnership);
+    if ((ret == 0) && ImageTiles::isUseful(_image))
+        _tiles.setImage(&_image);
 
     // Set display settings depending on mode
     if (displayMode == IV_DISPLAY_RESET)
@@ -642,6 +661,7 @@ void GLImageBox::clearColorMap()
     delete [] _pColorMap;
     _pColorMap = 0;
     _numMapEntries = 0;
+    _tiles.invalidate();
 }
 
 // Calculate the number of color map entries to use
@@ -712,6 +732,7 @@ int GLImageBox::createColorMap(int numEntriesReq, bool Initialise)
         }
     }
 
+    _tiles.invalidate();
     return 0;
 }
 
@@ -735,6 +756,7 @@ int GLImageBox::setColorMapRGBAValue(int index, float red, float green, float bl
     _pColorMap[_numMapEntries + index] = green;
     _pColorMap[_numMapEntries * 2 + index] = blue;
     _pColorMap[_numMapEntries * 3 + index] = alpha;
+    _tiles.invalidate();
     return 0;
 }
 
@@ -748,6 +770,7 @@ int GLImageBox::setColorMapRedValue(int index, float value)
         return -1;
 
     _pColorMap[index] = value;
+    _tiles.invalidate();
     return 0;
 }
 
@@ -761,6 +784,7 @@ int GLImageBox::setColorMapGreenValue(int index, float value)
         return -1;
 
     _pColorMap[_numMapEntries + index] = value;
+    _tiles.invalidate();
     return 0;
 }
 
@@ -774,6 +798,7 @@ int GLImageBox::setColorMapBlueValue(int index, float value)
         return -1;
 
     _pColorMap[_numMapEntries * 2 + index] = value;
+    _tiles.invalidate();
     return 0;
 }
 
@@ -787,6 +812,7 @@ int GLImageBox::setColorMapAlphaValue(int index, float value)
         return -1;
 
     _pColorMap[_numMapEntries * 3 + index] = value;
+    _tiles.invalidate();
     return 0;
 }
 
@@ -20,6 +20,7 @@
 #define GLIMAGEBOX_H
 
 #include <Mod/Image/App/ImageBase.h>
+#include "ImageTiles.h"
 #include <QGLWidget>
 
 namespace ImageGui
@@ -95,6 +96,7 @@ private:
     int calcNumColorMapEntries();
 
     Image::ImageBase _image;   // the image data
+    ImageTiles _tiles;         // tiled image pyramid for large images
 
     int _x0;            // image x-coordinate of top-left widget pixel
     int _y0;            // image y-coordinate of top-left widget pixel
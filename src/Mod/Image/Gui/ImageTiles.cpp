@@ -0,0 +1,342 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cstdint>
+#endif
+
+#if defined(__MINGW32__)
+# include <GL/gl.h>
+# include <GL/glext.h>
+#elif defined (FC_OS_MACOSX)
+# include <OpenGL/gl.h>
+#elif defined (FC_OS_WIN32)
+# include <Windows.h>
+# include <GL/gl.h>
+#else
+# include <GL/gl.h>
+#endif
+
+#ifndef GL_CLAMP_TO_EDGE
+# define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
+#include "ImageTiles.h"
+#include <Base/ThreadPool.h>
+#include <Mod/Image/App/ImageBase.h>
+
+using namespace ImageGui;
+
+namespace {
+const unsigned long TileSize = 256;
+// smaller images are drawn with glDrawPixels as before
+const unsigned long MinImageSize = 2048;
+// 64 MB of textures
+const std::size_t MaxTiles = 256;
+const int MaxUploadsPerDraw = 64;
+
+// Averages 2 x 2 pixels of src into one pixel of dst
+template <typename T>
+void halveLevel(const T* src, unsigned long srcWidth, unsigned long srcHeight,
+                T* dst, unsigned long dstWidth, unsigned long dstHeight,
+                int numSamples, const std::atomic<bool>& cancel)
+{
+    Base::parallel_for(0UL, dstHeight, [&](unsigned long y) {
+        if (cancel)
+            return;
+        const T* row0 = src + 2 * y * srcWidth * numSamples;
+        const T* row1 = src + std::min(2 * y + 1, srcHeight - 1) * srcWidth * numSamples;
+        T* out = dst + y * dstWidth * numSamples;
+        for (unsigned long x = 0; x < dstWidth; x++) {
+            unsigned long x0 = 2 * x * numSamples;
+            unsigned long x1 = std::min(2 * x + 1, srcWidth - 1) * numSamples;
+            for (int s = 0; s < numSamples; s++) {
+                std::uint64_t sum = std::uint64_t(row0[x0 + s]) + row0[x1 + s] + row1[x0 + s] + row1[x1 + s];
+                out[x * numSamples + s] = static_cast<T>((sum + 2) / 4);
+            }
+        }
+    });
+}
+}
+
+ImageTiles::ImageTiles()
+  : image(nullptr)
+  , levelsReady(0)
+  , cancel(false)
+{
+}
+
+ImageTiles::~ImageTiles()
+{
+    reset();
+}
+
+bool ImageTiles::isUseful(const Image::ImageBase& image)
+{
+    return image.hasValidData() &&
+          (image.getWidth() > MinImageSize || image.getHeight() > MinImageSize);
+}
+
+void ImageTiles::setImage(Image::ImageBase* img)
+{
+    reset();
+    if (!img || !img->hasValidData())
+        return;
+
+    image = img;
+    Level base;
+    base.width = image->getWidth();
+    base.height = image->getHeight();
+    levels.push_back(std::move(base));
+
+    // allocate all levels here, the builder only fills them
+    std::size_t bytesPerPixel = image->getNumBytesPerPixel();
+    int bitsPerSample = image->getNumBitsPerSample();
+    bool canReduce = (bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 32);
+    while (canReduce && (levels.back().width > TileSize || levels.back().height > TileSize)) {
+        Level level;
+        level.width = (levels.back().width + 1) / 2;
+        level.height = (levels.back().height + 1) / 2;
+        level.data.reset(new (std::nothrow) unsigned char[level.width * level.height * bytesPerPixel]);
+        if (!level.data)
+            break;
+        levels.push_back(std::move(level));
+    }
+
+    levelsReady = 1;
+    cancel = false;
+    if (levels.size() > 1) {
+        builder.reset(new Base::TaskGroup());
+        builder->run([this]() { buildLevels(); });
+    }
+}
+
+void ImageTiles::reset()
+{
+    cancel = true;
+    if (builder) {
+        try {
+            builder->wait();
+        }
+        catch (...) {
+        }
+        builder.reset();
+    }
+
+    invalidate();
+    image = nullptr;
+    levels.clear();
+    levelsReady = 0;
+}
+
+void ImageTiles::invalidate()
+{
+    for (const auto& it : tiles)
+        unusedTextures.push_back(it.second.texture);
+    tiles.clear();
+    lastUsed.clear();
+}
+
+void ImageTiles::releaseTextures()
+{
+    invalidate();
+    if (!unusedTextures.empty()) {
+        glDeleteTextures(static_cast<GLsizei>(unusedTextures.size()), unusedTextures.data());
+        unusedTextures.clear();
+    }
+}
+
+void ImageTiles::buildLevels()
+{
+    int numSamples = image->getNumSamples();
+    int bitsPerSample = image->getNumBitsPerSample();
+    for (std::size_t i = 1; i < levels.size(); i++) {
+        const Level& src = levels[i - 1];
+        Level& dst = levels[i];
+        const unsigned char* srcData = levelData(i - 1);
+        switch (bitsPerSample) {
+        case 8:
+            halveLevel(srcData, src.width, src.height, dst.data.get(),
+                       dst.width, dst.height, numSamples, cancel);
+            break;
+        case 16:
+            halveLevel(reinterpret_cast<const std::uint16_t*>(srcData), src.width, src.height,
+                       reinterpret_cast<std::uint16_t*>(dst.data.get()),
+                       dst.width, dst.height, numSamples, cancel);
+            break;
+        case 32:
+            halveLevel(reinterpret_cast<const std::uint32_t*>(srcData), src.width, src.height,
+                       reinterpret_cast<std::uint32_t*>(dst.data.get()),
+                       dst.width, dst.height, numSamples, cancel);
+            break;
+        default:
+            return;
+        }
+
+        if (cancel)
+            return;
+        levelsReady.store(i + 1);
+    }
+}
+
+const unsigned char* ImageTiles::levelData(std::size_t level) const
+{
+    if (level == 0)
+        return static_cast<const unsigned char*>(image->getPixelDataPtr());
+    return levels[level].data.get();
+}
+
+long long ImageTiles::tileKey(std::size_t level, unsigned long tx, unsigned long ty) const
+{
+    return (static_cast<long long>(level) << 48) | (static_cast<long long>(ty) << 24) | tx;
+}
+
+unsigned int ImageTiles::uploadTile(std::size_t level, unsigned long tx, unsigned long ty,
+                                    unsigned int pixFormat, unsigned int pixType)
+{
+    const Level& lev = levels[level];
+    unsigned long x0 = tx * TileSize;
+    unsigned long y0 = ty * TileSize;
+    GLsizei width = static_cast<GLsizei>(std::min(TileSize, lev.width - x0));
+    GLsizei height = static_cast<GLsizei>(std::min(TileSize, lev.height - y0));
+
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, TileSize, TileSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(lev.width));
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    std::size_t bytesPerPixel = image->getNumBytesPerPixel();
+    const unsigned char* data = levelData(level) + (y0 * lev.width + x0) * bytesPerPixel;
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, pixFormat, pixType, data);
+    // repeat the last column and row of a partial tile so that filtering doesn't
+    // blend in undefined texels at the image border
+    if (width < static_cast<GLsizei>(TileSize))
+        glTexSubImage2D(GL_TEXTURE_2D, 0, width, 0, 1, height, pixFormat, pixType,
+                        data + (width - 1) * bytesPerPixel);
+    if (height < static_cast<GLsizei>(TileSize))
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, height, width, 1, pixFormat, pixType,
+                        data + (height - 1) * lev.width * bytesPerPixel);
+    glPopClientAttrib();
+
+    return texture;
+}
+
+bool ImageTiles::draw(int x, int y, int dx, int dy, double originX, double originY, double zoomFactor,
+                      unsigned int pixFormat, unsigned int pixType, bool& complete)
+{
+    complete = true;
+    if (!unusedTextures.empty()) {
+        glDeleteTextures(static_cast<GLsizei>(unusedTextures.size()), unusedTextures.data());
+        unusedTextures.clear();
+    }
+    if (!image || levels.empty() || dx <= 0 || dy <= 0)
+        return false;
+
+    // the coarsest level that still has at least one pixel per widget pixel
+    std::size_t level = 0;
+    while (level + 1 < levels.size() && zoomFactor * (1UL << (level + 1)) <= 1.0)
+        level++;
+    if (level >= levelsReady.load()) {
+        complete = false;
+        return false;
+    }
+
+    const Level& lev = levels[level];
+    unsigned long factor = 1UL << level;
+    unsigned long span = TileSize * factor; // image pixels per tile
+    unsigned long imageWidth = levels[0].width;
+    unsigned long imageHeight = levels[0].height;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT);
+    glEnable(GL_TEXTURE_2D);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+    int uploads = 0;
+    for (unsigned long ty = y / span; ty <= (y + dy - 1) / span; ty++) {
+        for (unsigned long tx = x / span; tx <= (x + dx - 1) / span; tx++) {
+            long long key = tileKey(level, tx, ty);
+            GLuint texture;
+            auto it = tiles.find(key);
+            if (it == tiles.end()) {
+                if (uploads >= MaxUploadsPerDraw) {
+                    complete = false;
+                    continue;
+                }
+                texture = uploadTile(level, tx, ty, pixFormat, pixType);
+                uploads++;
+                lastUsed.push_front(key);
+                Tile tile;
+                tile.texture = texture;
+                tile.use = lastUsed.begin();
+                tiles[key] = tile;
+            }
+            else {
+                texture = it->second.texture;
+                lastUsed.splice(lastUsed.begin(), lastUsed, it->second.use);
+            }
+
+            // the tile in level pixels and in image coordinates
+            unsigned long lx0 = tx * TileSize;
+            unsigned long ly0 = ty * TileSize;
+            unsigned long width = std::min(TileSize, lev.width - lx0);
+            unsigned long height = std::min(TileSize, lev.height - ly0);
+            double u0 = static_cast<double>(lx0 * factor);
+            double v0 = static_cast<double>(ly0 * factor);
+            double u1 = static_cast<double>(std::min((lx0 + width) * factor, imageWidth));
+            double v1 = static_cast<double>(std::min((ly0 + height) * factor, imageHeight));
+            double s = static_cast<double>(width) / TileSize;
+            double t = static_cast<double>(height) / TileSize;
+
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glBegin(GL_QUADS);
+            glTexCoord2d(0, 0); glVertex2d(originX + u0 * zoomFactor, originY + v0 * zoomFactor);
+            glTexCoord2d(s, 0); glVertex2d(originX + u1 * zoomFactor, originY + v0 * zoomFactor);
+            glTexCoord2d(s, t); glVertex2d(originX + u1 * zoomFactor, originY + v1 * zoomFactor);
+            glTexCoord2d(0, t); glVertex2d(originX + u0 * zoomFactor, originY + v1 * zoomFactor);
+            glEnd();
+        }
+    }
+
+    glPopAttrib();
+
+    // drop the least recently used tiles
+    while (tiles.size() > MaxTiles) {
+        auto it = tiles.find(lastUsed.back());
+        glDeleteTextures(1, &it->second.texture);
+        tiles.erase(it);
+        lastUsed.pop_back();
+    }
+
+    return true;
+}
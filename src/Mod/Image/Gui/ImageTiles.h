@@ -0,0 +1,121 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef IMAGEGUI_IMAGETILES_H
+#define IMAGEGUI_IMAGETILES_H
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace Base {
+class TaskGroup;
+}
+
+namespace Image {
+class ImageBase;
+}
+
+namespace ImageGui
+{
+
+/**
+ * The ImageTiles class draws a large image as textured tiles from an image pyramid.
+ *
+ * Level 0 of the pyramid is the image itself, each further level halves the resolution
+ * of the one before. A zoomed out view draws the tiles of the level that matches the
+ * zoom factor, so only about as many pixels are uploaded as the widget shows. The tiles
+ * are uploaded when they become visible and are kept in a cache of limited size.
+ *
+ * The reduced levels are computed on the thread pool after the image is set. Until the
+ * needed level is ready draw() returns false and the caller draws the image as before.
+ *
+ * The tiles are uploaded with the current pixel transfer state, so the color map and the
+ * scaling of the significant bits apply as with glDrawPixels(). Call invalidate() when they
+ * change. All methods must be called from the GUI thread, draw() with the GL context current.
+ */
+class ImageTiles
+{
+public:
+    ImageTiles();
+    ~ImageTiles();
+
+    /// Returns true if an image of this size is worth being drawn with tiles
+    static bool isUseful(const Image::ImageBase& image);
+
+    /// Starts computing the pyramid of image, which must not change until reset() is called
+    void setImage(Image::ImageBase* image);
+    /// Stops computing the pyramid and forgets the image
+    void reset();
+    /// Marks the uploaded tiles as outdated, e.g. after the color map has changed
+    void invalidate();
+    /// Deletes all textures, the GL context must be current
+    void releaseTextures();
+
+    /** Draws the image pixels [x, x + dx) x [y, y + dy) in widget coordinates. The left
+     * edge of the image is at widget x-coordinate \a originX and the top edge at \a originY.
+     * \a pixFormat and \a pixType describe the pixel data of the image.
+     * Returns false if nothing was drawn, e.g. because the needed level of the pyramid isn't
+     * ready yet. \a complete is set to false if the level or some of the visible tiles are still
+     * missing, the caller should draw again soon.
+     */
+    bool draw(int x, int y, int dx, int dy, double originX, double originY, double zoomFactor,
+              unsigned int pixFormat, unsigned int pixType, bool& complete);
+
+private:
+    struct Level
+    {
+        unsigned long width = 0;
+        unsigned long height = 0;
+        std::unique_ptr<unsigned char[]> data; /**< empty for level 0 */
+    };
+    struct Tile
+    {
+        unsigned int texture;
+        std::list<long long>::iterator use;
+    };
+
+    void buildLevels();
+    const unsigned char* levelData(std::size_t level) const;
+    unsigned int uploadTile(std::size_t level, unsigned long tx, unsigned long ty,
+                            unsigned int pixFormat, unsigned int pixType);
+    long long tileKey(std::size_t level, unsigned long tx, unsigned long ty) const;
+
+private:
+    Image::ImageBase* image;
+    std::vector<Level> levels;
+    std::atomic<std::size_t> levelsReady;
+    std::atomic<bool> cancel;
+    std::unique_ptr<Base::TaskGroup> builder;
+
+    std::map<long long, Tile> tiles;
+    std::list<long long> lastUsed; /**< most recently used tile first */
+    std::vector<unsigned int> unusedTextures; /**< deleted in the next draw() */
+};
+
+} // namespace ImageGui
+
+#endif // IMAGEGUI_IMAGETILES_H
@@ -19,6 +19,7 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <cmath>
+# include <QTimer>
 # include <QDebug>
 # include <QOpenGLDebugMessage>
 # include <QOpenGLContext>
@@ -114,6 +115,8 @@ GLImageBox::GLImageBox(QWidget * parent, Qt::WindowFlags f)
 // Destructor
 GLImageBox::~GLImageBox()
 {
+    makeCurrent();
+    _tiles.releaseTextures();
     delete [] _pColorMap;
 }
 
@@ -264,9 +267,18 @@ void GLImageBox::drawImage()
         GLenum pixType;
         getPixFormat(pixFormat, pixType);
 
-        // Draw the defined source rectangle
-        glDrawPixels(dx, dy, pixFormat, pixType, (GLvoid *)pPix);
+        // Large images are drawn as textured tiles at the resolution matching the zoom factor,
+        // until its pyramid level is ready the defined source rectangle is drawn directly
+        bool complete = true;
+        bool tiled = _tiles.draw(tlx, tly, dx, dy, ICToWC_X(-0.5), ICToWC_Y(-0.5), _zoomFactor,
+                                 pixFormat, pixType, complete);
+        if (!tiled)
+            glDrawPixels(dx, dy, pixFormat, pixType, (GLvoid *)pPix);
         glFlush();
+
+        // Draw again when the missing tiles or pyramid levels are available
+        if (!complete)
+            QTimer::singleShot(tiled ? 0 : 100, this, SLOT(update()));
     }
 }
 
@@ -602,6 +614,7 @@ double GLImageBox::ICToWC_Y(double ImageY)
 // Clears the image data
 void GLImageBox::clearImage()
 {
+    _tiles.reset();
     _image.clear();
     resetDisplay();
 }
@@ -622,7 +635,10 @@ void GLImageBox::clearImage()
 int GLImageBox::createImageCopy(void* pSrcPixelData, unsigned long width, unsigned long height, int format, unsigned short numSigBitsPerSample, int displayMode)
 {
     // Copy image
+    _tiles.reset();
     int ret = _image.createCopy(pSrcPixelData, width, height, format, numSigBitsPerSample);
+    if ((ret == 0) && ImageTiles::isUseful(_image))
+        _tiles.setImage(&_image);
 
     // Set display settings depending on mode
     if (displayMode == IV_DISPLAY_RESET)
@@ -664,7 +680,10 @@ int GLImageBox::createImageCopy(void* pSrcPixelData, unsigned long width, unsign
 int GLImageBox::pointImageTo(void* pSrcPixelData, unsigned long width, unsigned long height, int format, unsigned short numSigBitsPerSample, bool takeOwnership, int displayMode)
 {
     // Point to image
+    _tiles.reset();
     int ret = _image.pointTo(pSrcPixelData, width, height, format, numSigBitsPerSample, takeOwnership);
+    if ((ret == 0) && ImageTiles::isUseful(_image))
+        _tiles.setImage(&_image);
 
     // Set display settings depending on mode
     if (displayMode == IV_DISPLAY_RESET)
@@ -699,6 +718,7 @@ void GLImageBox::clearColorMap()
     delete [] _pColorMap;
     _pColorMap = 0;
     _numMapEntries = 0;
+    _tiles.invalidate();
 }
 
 // Calculate the number of color map entries to use
@@ -769,6 +789,7 @@ int GLImageBox::createColorMap(int numEntriesReq, bool Initialise)
         }
     }
 
+    _tiles.invalidate();
     return 0;
 }
 
@@ -792,6 +813,7 @@ int GLImageBox::setColorMapRGBAValue(int index, float red, float green, float bl
     _pColorMap[_numMapEntries + index] = green;
     _pColorMap[_numMapEntries * 2 + index] = blue;
     _pColorMap[_numMapEntries * 3 + index] = alpha;
+    _tiles.invalidate();
     return 0;
 }
 
@@ -805,6 +827,7 @@ int GLImageBox::setColorMapRedValue(int index, float value)
         return -1;
 
     _pColorMap[index] = value;
+    _tiles.invalidate();
     return 0;
 }
 
@@ -818,6 +841,7 @@ int GLImageBox::setColorMapGreenValue(int index, float value)
         return -1;
 
     _pColorMap[_numMapEntries + index] = value;
+    _tiles.invalidate();
     return 0;
 }
 
@@ -831,6 +855,7 @@ int GLImageBox::setColorMapBlueValue(int index, float value)
         return -1;
 
     _pColorMap[_numMapEntries * 2 + index] = value;
+    _tiles.invalidate();
     return 0;
 }
 
@@ -844,6 +869,7 @@ int GLImageBox::setColorMapAlphaValue(int index, float value)
         return -1;
 
     _pColorMap[_numMapEntries * 3 + index] = value;
+    _tiles.invalidate();
     return 0;
 }
 
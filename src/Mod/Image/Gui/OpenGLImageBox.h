@@ -20,6 +20,7 @@
 #define OPENGLIMAGEBOX_H
 
 #include <Mod/Image/App/ImageBase.h>
+#include "ImageTiles.h"
 #include <QOpenGLWidget>
 
 class QOpenGLDebugMessage;
@@ -102,6 +103,7 @@ private:
     int calcNumColorMapEntries();
 
     Image::ImageBase _image;   // the image data
+    ImageTiles _tiles;         // tiled image pyramid for large images
 
     int _x0;            // image x-coordinate of top-left widget pixel
     int _y0;            // image y-coordinate of top-left widget pixel
@@ -37,12 +37,14 @@
 # include <QFile>
 # include <QFileInfo>
 # include <QImage>
+# include <QImageReader>
 # include <QString>
 #endif
 
 #include "ViewProviderImagePlane.h"
 
 #include <Mod/Image/App/ImagePlane.h>
+#include <App/Application.h>
 #include <App/Document.h>
 #include <Gui/BitmapFactory.h>
 #include <Base/FileInfo.h>
@@ -133,6 +135,30 @@ bool ViewProviderImagePlane::loadSvg(const char* filename, float x, float y, QIm
     return false;
 }
 
+bool ViewProviderImagePlane::loadImage(const char* filename, QImage& img)
+{
+    // The texture is never shown with more pixels than the graphics card supports, so
+    // a large image is reduced while it is decoded. Several formats (e.g. JPEG) decode
+    // faster at a smaller size and the full resolution image is never held in memory.
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Mod/Image");
+    int maxSize = hGrp->GetInt("MaxTextureSize", 4096);
+
+    QImageReader reader(QString::fromUtf8(filename));
+    QSize size = reader.size();
+    if (maxSize > 0 && size.isValid() && (size.width() > maxSize || size.height() > maxSize))
+        reader.setScaledSize(size.scaled(maxSize, maxSize, Qt::KeepAspectRatio));
+
+    img = reader.read();
+    if (img.isNull()) {
+        Base::Console().Warning("Cannot load image %s: %s\n", filename,
+                                reader.errorString().toUtf8().constData());
+        return false;
+    }
+
+    return true;
+}
+
 void ViewProviderImagePlane::updateData(const App::Property* prop)
 {
     Image::ImagePlane* pcPlaneObj = static_cast<Image::ImagePlane*>(pcObject);
@@ -160,7 +186,7 @@ void ViewProviderImagePlane::updateData(const App::Property* prop)
         float y = pcPlaneObj->YSize.getValue();
         QImage impQ;
         if (!loadSvg(pcPlaneObj->ImageFile.getValue(),x,y, impQ))
-            impQ.load(QString::fromUtf8(pcPlaneObj->ImageFile.getValue()));
+            loadImage(pcPlaneObj->ImageFile.getValue(), impQ);
         if (!impQ.isNull()) {
             SoSFImage img;
             // convert to Coin bitmap
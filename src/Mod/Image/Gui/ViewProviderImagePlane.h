@@ -52,6 +52,7 @@ public:
 
 private:
     bool loadSvg(const char*, float x, float y, QImage& img);
+    bool loadImage(const char*, QImage& img);
 
 protected:
     SoCoordinate3         * pcCoords;
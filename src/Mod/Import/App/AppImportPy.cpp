@@ -139,10 +139,11 @@ private:
         PyObject *importHidden = Py_None;
         PyObject *merge = Py_None;
         PyObject *useLinkGroup = Py_None;
+        PyObject *lightweight = Py_None;
         int mode = -1;
-        static char* kwd_list[] = {"name", "docName","importHidden","merge","useLinkGroup","mode",0};
-        if(!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "et|sOOOi", 
-                    kwd_list,"utf-8",&Name,&DocName,&importHidden,&merge,&useLinkGroup,&mode))
+        static char* kwd_list[] = {"name", "docName","importHidden","merge","useLinkGroup","mode","lightweight",0};
+        if(!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "et|sOOOiO", 
+                    kwd_list,"utf-8",&Name,&DocName,&importHidden,&merge,&useLinkGroup,&mode,&lightweight))
             throw Py::Exception();
 
         std::string Utf8Name = std::string(Name);
@@ -245,6 +246,8 @@ private:
                 ocaf.setImportHiddenObject(PyObject_IsTrue(importHidden));
             if (useLinkGroup != Py_None)
                 ocaf.setUseLinkGroup(PyObject_IsTrue(useLinkGroup));
+            if (lightweight != Py_None)
+                ocaf.setLightweight(PyObject_IsTrue(lightweight));
             if (mode >= 0)
                 ocaf.setMode(mode);
             ocaf.loadShapes();
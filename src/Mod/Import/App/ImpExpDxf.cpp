@@ -64,6 +64,7 @@
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/Annotation.h>
+#include <App/Link.h>
 #include <Mod/Part/App/PartFeature.h>
 
 using namespace Import;
@@ -83,6 +84,7 @@ void ImpExpDxfRead::setOptions(void)
     ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(getOptionSource().c_str());
     optionGroupLayers = hGrp->GetBool("groupLayers",false);
     optionImportAnnotations = hGrp->GetBool("dxftext",false);
+    optionLinkBlocks = hGrp->GetBool("dxfLinkBlocks",false);
     optionScaling = hGrp->GetFloat("dxfScaling",1.0);
 }
 
@@ -307,35 +309,80 @@ void ImpExpDxfRead::OnReadText(const double *point, const double /*height*/, con
 }
 
 
-void ImpExpDxfRead::OnReadInsert(const double* point, const double* scale, const char* name, double rotation)
+const std::vector<TopoDS_Shape>& ImpExpDxfRead::getBlockShapes(const std::string& name)
 {
-    //std::cout << "Inserting block " << name << " rotation " << rotation << " pos " << point[0] << "," << point[1] << "," << point[2] << " scale " << scale[0] << "," << scale[1] << "," << scale[2] << std::endl;
+    auto found = blockShapes.find(name);
+    if (found != blockShapes.end())
+        return found->second;
+
+    std::vector<TopoDS_Shape>& result = blockShapes[name];
     std::string prefix = "BLOCKS ";
     prefix += name;
     prefix += " ";
-    for(std::map<std::string,std::vector<Part::TopoShape*> > ::const_iterator i = layers.begin(); i != layers.end(); ++i) {
-        std::string k = i->first;
-        if(k.substr(0, prefix.size()) == prefix) {
-            BRep_Builder builder;
-            TopoDS_Compound comp;
-            builder.MakeCompound(comp);
-            std::vector<Part::TopoShape*> v = i->second;
-            for(std::vector<Part::TopoShape*>::const_iterator j = v.begin(); j != v.end(); ++j) { 
-                const TopoDS_Shape& sh = (*j)->getShape();
-                if (!sh.IsNull())
-                    builder.Add(comp, sh);
-            }
-            if (!comp.IsNull()) {
-                Part::TopoShape* pcomp = new Part::TopoShape(comp);
-                Base::Matrix4D mat;
-                mat.scale(scale[0],scale[1],scale[2]);
-                mat.rotZ(rotation);
-                mat.move(point[0]*optionScaling,point[1]*optionScaling,point[2]*optionScaling);
-                pcomp->transformShape(mat,true);
-                AddObject(pcomp);
-            }
+    // layers is sorted, so all layers of the block follow each other
+    for (auto i = layers.lower_bound(prefix); i != layers.end(); ++i) {
+        const std::string& k = i->first;
+        if (k.compare(0, prefix.size(), prefix) != 0)
+            break;
+        BRep_Builder builder;
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        for (const TopoDS_Shape& sh : i->second) {
+            if (!sh.IsNull())
+                builder.Add(comp, sh);
         }
-    } 
+        result.push_back(comp);
+    }
+    return result;
+}
+
+
+App::DocumentObject* ImpExpDxfRead::getBlockFeature(const std::string& name)
+{
+    auto found = blockFeatures.find(name);
+    if (found != blockFeatures.end())
+        return found->second;
+
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    for (const TopoDS_Shape& sh : getBlockShapes(name))
+        builder.Add(comp, sh);
+    Part::Feature *pcFeature = (Part::Feature *)document->addObject("Part::Feature", "Block");
+    pcFeature->Label.setValue(name);
+    pcFeature->Shape.setValue(comp);
+    pcFeature->Visibility.setValue(false);
+    blockFeatures[name] = pcFeature;
+    return pcFeature;
+}
+
+
+void ImpExpDxfRead::OnReadInsert(const double* point, const double* scale, const char* name, double rotation)
+{
+    //std::cout << "Inserting block " << name << " rotation " << rotation << " pos " << point[0] << "," << point[1] << "," << point[2] << " scale " << scale[0] << "," << scale[1] << "," << scale[2] << std::endl;
+    // a link can't scale, and inserts inside block definitions become part of the block shape
+    if (optionLinkBlocks && LayerName().substr(0, 6) != "BLOCKS" &&
+        scale[0] == 1.0 && scale[1] == 1.0 && scale[2] == 1.0) {
+        App::Link *link = (App::Link *)document->addObject("App::Link", "Insert");
+        link->LinkedObject.setValue(getBlockFeature(name));
+        link->Label.setValue(name);
+        link->Placement.setValue(Base::Placement(
+                    Base::Vector3d(point[0]*optionScaling,point[1]*optionScaling,point[2]*optionScaling),
+                    Base::Rotation(Base::Vector3d(0,0,1),rotation)));
+        return;
+    }
+
+    // a copy, adding to a block layer resets the cache
+    std::vector<TopoDS_Shape> comps = getBlockShapes(name);
+    for (const TopoDS_Shape& comp : comps) {
+        Part::TopoShape* pcomp = new Part::TopoShape(comp);
+        Base::Matrix4D mat;
+        mat.scale(scale[0],scale[1],scale[2]);
+        mat.rotZ(rotation);
+        mat.move(point[0]*optionScaling,point[1]*optionScaling,point[2]*optionScaling);
+        pcomp->transformShape(mat,true);
+        AddObject(pcomp);
+    }
 }
 
 
@@ -354,17 +401,21 @@ void ImpExpDxfRead::OnReadDimension(const double* s, const double* e, const doub
 void ImpExpDxfRead::AddObject(Part::TopoShape *shape)
 {
     //std::cout << "layer:" << LayerName() << std::endl;
-    std::vector <Part::TopoShape*> vec;
-    if (layers.count(LayerName()))
-        vec = layers[LayerName()];
-    vec.push_back(shape);
-    layers[LayerName()] = vec;
+    std::string layerName = LayerName();
+    bool inBlock = layerName.substr(0, 6) == "BLOCKS";
+    // the layer lists are only needed for grouping and for block inserts
+    if (optionGroupLayers || inBlock) {
+        layers[layerName].push_back(shape->getShape());
+        if (inBlock)
+            blockShapes.clear();
+    }
     if (!optionGroupLayers) {
-        if(LayerName().substr(0, 6) != "BLOCKS") {
+        if (!inBlock) {
             Part::Feature *pcFeature = (Part::Feature *)document->addObject("Part::Feature", "Shape");
             pcFeature->Shape.setValue(shape->getShape());
         }
     }
+    delete shape;
 }
 
 
@@ -410,17 +461,16 @@ std::string ImpExpDxfRead::Deformat(const char* text)
 void ImpExpDxfRead::AddGraphics() const
 {
     if (optionGroupLayers) {
-        for(std::map<std::string,std::vector<Part::TopoShape*> > ::const_iterator i = layers.begin(); i != layers.end(); ++i) {
+        for(std::map<std::string,std::vector<TopoDS_Shape> > ::const_iterator i = layers.begin(); i != layers.end(); ++i) {
             BRep_Builder builder;
             TopoDS_Compound comp;
             builder.MakeCompound(comp);
             std::string k = i->first;
             if (k == "0") // FreeCAD doesn't like an object name being '0'...
                 k = "LAYER_0";
-            std::vector<Part::TopoShape*> v = i->second;
+            const std::vector<TopoDS_Shape>& v = i->second;
             if(k.substr(0, 6) != "BLOCKS") {
-                for(std::vector<Part::TopoShape*>::const_iterator j = v.begin(); j != v.end(); ++j) { 
-                    const TopoDS_Shape& sh = (*j)->getShape();
+                for (const TopoDS_Shape& sh : v) {
                     if (!sh.IsNull())
                         builder.Add(comp, sh);
                 }
@@ -59,13 +59,19 @@ namespace Import
 
     private:
         gp_Pnt makePoint(const double* p);
+        const std::vector<TopoDS_Shape>& getBlockShapes(const std::string& name);
+        App::DocumentObject* getBlockFeature(const std::string& name);
         
     protected:
         App::Document *document;
         bool optionGroupLayers;
         bool optionImportAnnotations;
+        bool optionLinkBlocks;
         double optionScaling;
-        std::map <std::string, std::vector <Part::TopoShape*> > layers;
+        std::map <std::string, std::vector <TopoDS_Shape> > layers;
+        // one compound for each layer of a block, made on the first insert
+        std::map <std::string, std::vector <TopoDS_Shape> > blockShapes;
+        std::map <std::string, App::DocumentObject*> blockFeatures;
         std::string m_optionSource;
     };
 
@@ -158,6 +158,7 @@ ImportOCAF2::ImportOCAF2(Handle(TDocStd_Document) h, App::Document* d, const std
     reduceObjects = hGrp->GetBool("ReduceObjects",true);
     showProgress = hGrp->GetBool("ShowProgress",true);
     expandCompound = hGrp->GetBool("ExpandCompound",true);
+    lightweight = hGrp->GetBool("LightweightImport",false);
 
     if(d->isSaved()) {
         Base::FileInfo fi(d->FileName.getValue());
@@ -411,7 +412,7 @@ bool ImportOCAF2::createObject(App::Document *doc, TDF_Label label,
     if(newDoc && (mode==ObjectPerDoc || mode==ObjectPerDir))
         doc = getDocument(doc,label);
 
-    if(expandCompound && 
+    if(expandCompound && !lightweight &&
        (tshape.countSubShapes(TopAbs_SOLID)>1 || 
         (!tshape.countSubShapes(TopAbs_SOLID) && tshape.countSubShapes(TopAbs_SHELL)>1)))
     {
@@ -422,6 +423,8 @@ bool ImportOCAF2::createObject(App::Document *doc, TDF_Label label,
         feature->Shape.setValue(shape);
         // feature->Visibility.setValue(false);
     }
+    if(lightweight)
+        feature->Visibility.setValue(false);
     applyFaceColors(feature,{info.faceColor});
     applyEdgeColors(feature,{info.edgeColor});
     if(hasFaceColors)
@@ -577,6 +580,8 @@ App::DocumentObject* ImportOCAF2::loadShapes()
     }
     if(ret) {
         // ret->Visibility.setValue(true);
+        if(lightweight)
+            ret->Visibility.setValue(false);
         ret->recomputeFeature(true);
     }
     if(merge && ret && !ret->isDerivedFrom(Part::Feature::getClassTypeId())) {
@@ -858,7 +863,7 @@ bool ImportOCAF2::createAssembly(App::Document *_doc,
 // ----------------------------------------------------------------------------
 
 ExportOCAF2::ExportOCAF2(Handle(TDocStd_Document) h, GetShapeColorsFunc func)
-    : pDoc(h) , getShapeColors(func)
+    : pDoc(h) , getShapeColors(func), sequencer(0)
 {
     aShapeTool = XCAFDoc_DocumentTool::ShapeTool(pDoc->Main());
     aColorTool = XCAFDoc_DocumentTool::ColorTool(pDoc->Main());
@@ -866,6 +871,7 @@ ExportOCAF2::ExportOCAF2(Handle(TDocStd_Document) h, GetShapeColorsFunc func)
     auto hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Import");
     exportHidden = hGrp->GetBool("ExportHiddenObject",true);
     keepPlacement = hGrp->GetBool("ExportKeepPlacement",false);
+    showProgress = hGrp->GetBool("ShowProgress",true);
 
     Interface_Static::SetIVal("write.step.assembly",2);
 
@@ -1094,8 +1100,14 @@ void ExportOCAF2::exportObjects(std::vector<App::DocumentObject*> &objs, const c
     if(objs.empty())
         return;
     myObjects.clear();
+    myShapes.clear();
     myNames.clear();
     mySetups.clear();
+
+    // The total number of shapes is unknown before traversing the links
+    Base::SequencerLauncher seq("Exporting...",0);
+    sequencer = showProgress?&seq:0;
+
     if(objs.size()==1)
         exportObject(objs.front(),0,TDF_Label());
     else {
@@ -1115,6 +1127,8 @@ void ExportOCAF2::exportObjects(std::vector<App::DocumentObject*> &objs, const c
         setName(label,0,name);
     }
 
+    sequencer = 0;
+
     if(FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG))
         dumpLabels(pDoc->Main(),aShapeTool,aColorTool);
 
@@ -1182,7 +1196,12 @@ TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj,
             // a new shape every time Part::Feature::getTopoShape() is called.
             auto baseShape = aShapeTool->GetShape(it->second);
             shape.setShape(baseShape.Located(shape.getShape().Location()));
-            if(!parent.IsNull())
+            TopoDS_Shape key = baseShape.Located(TopLoc_Location());
+            key.Orientation(TopAbs_FORWARD);
+            auto itShape = myShapes.find(key);
+            if(!parent.IsNull() && itShape!=myShapes.end())
+                label = aShapeTool->AddComponent(parent,itShape->second,shape.getShape().Location());
+            else if(!parent.IsNull())
                 label = aShapeTool->AddComponent(parent,shape.getShape(),Standard_False);
             else
                 label = aShapeTool->AddShape(shape.getShape(),Standard_False,Standard_False);
@@ -1200,18 +1219,27 @@ TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj,
     // subs empty means obj is not a container.
     if(subs.empty()) {
 
+        if(sequencer)
+            sequencer->next(true);
+
         if(!parent.IsNull()) {
             // Search for non-located shape to see if we've stored the original shape before
-            if(!aShapeTool->FindShape(shape.getShape(),label)) {
+            TopoDS_Shape key = shape.getShape().Located(TopLoc_Location());
+            key.Orientation(TopAbs_FORWARD);
+            auto it = myShapes.find(key);
+            if(it == myShapes.end()) {
                 auto baseShape = linkedShape;
                 auto linked = links.empty()?obj:links.back();
                 baseShape.setShape(baseShape.getShape().Located(TopLoc_Location()));
                 label = aShapeTool->NewShape();
                 aShapeTool->SetShape(label,baseShape.getShape());
                 setupObject(label,linked,baseShape,prefix);
+                it = myShapes.emplace(key,label).first;
             }
 
-            label = aShapeTool->AddComponent(parent,shape.getShape(),Standard_False);
+            // Add the component by label, adding it by shape would make
+            // ShapeTool search all the stored shapes again
+            label = aShapeTool->AddComponent(parent,it->second,shape.getShape().Location());
             setupObject(label,name?parentObj:obj,shape,prefix,name);
 
         }else{
@@ -1306,6 +1334,9 @@ TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj,
     // Finished adding components. Now retrieve the computed non-located shape
     auto baseShape = shape;
     baseShape.setShape(aShapeTool->GetShape(label));
+    TopoDS_Shape key = baseShape.getShape();
+    key.Orientation(TopAbs_FORWARD);
+    myShapes.emplace(key,label);
 
     myObjects.emplace(obj, label);
     for(auto link : links)
@@ -80,6 +80,13 @@ public:
     void setReduceObjects(bool enable) {reduceObjects=enable;}
     void setShowProgress(bool enable) {showProgress=enable;}
     void setExpandCompound(bool enable) {expandCompound=enable;}
+    /** Lightweight import for huge assemblies
+     *
+     * The assembly tree is created as usual but compounds are not expanded and
+     * all objects are created hidden, so the view providers postpone the
+     * tessellation until a part or a branch of the tree is shown.
+     */
+    void setLightweight(bool enable) {lightweight=enable;}
 
     enum ImportMode {
         SingleDoc = 0,
@@ -153,6 +160,7 @@ private:
     bool reduceObjects;
     bool showProgress;
     bool expandCompound;
+    bool lightweight;
 
     int mode;
     std::string filePath;
@@ -194,6 +202,9 @@ private:
 
     std::unordered_map<App::DocumentObject *, TDF_Label> myObjects;
 
+    // non-located shape to label, replaces the linear search of ShapeTool::FindShape()
+    std::unordered_map<TopoDS_Shape, TDF_Label, ShapeHasher> myShapes;
+
     std::unordered_map<TDF_Label, std::vector<std::string>, LabelHasher> myNames;
 
     std::set<std::pair<App::DocumentObject*,std::string> > mySetups;
@@ -205,6 +216,9 @@ private:
     App::Color defaultColor;
     bool exportHidden;
     bool keepPlacement;
+    bool showProgress;
+
+    Base::SequencerLauncher *sequencer;
 };
 
 }
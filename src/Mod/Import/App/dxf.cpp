@@ -1755,19 +1755,28 @@ CDxfRead::CDxfRead(const char* filepath)
     memset( m_block_name, '\0', sizeof(m_block_name) );
     m_ignore_errors = true;
 
-    m_ifs = new ifstream(filepath);
-    if(!(*m_ifs)){
+    m_pos = 0;
+    m_eof = false;
+
+    // reading the file at once avoids a stream call for every line
+    ifstream ifs(filepath, ios::in | ios::binary);
+    if(!ifs){
         m_fail = true;
         printf("DXF file didn't load\n");
         return;
     }
-    m_ifs->imbue(std::locale("C"));
-
+    ifs.seekg(0, ios::end);
+    streamoff size = ifs.tellg();
+    ifs.seekg(0, ios::beg);
+    if (size > 0) {
+        m_buffer.resize(static_cast<size_t>(size));
+        ifs.read(&m_buffer[0], size);
+        m_buffer.resize(static_cast<size_t>(ifs.gcount()));
+    }
 }
 
 CDxfRead::~CDxfRead()
 {
-    delete m_ifs;
 }
 
 double CDxfRead::mm( double value ) const
@@ -1811,7 +1820,7 @@ bool CDxfRead::ReadLine()
     double e[3] = {0, 0, 0};
     bool hidden = false;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -1909,7 +1918,7 @@ bool CDxfRead::ReadPoint()
 {
     double s[3] = {0, 0, 0};
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -1993,7 +2002,7 @@ bool CDxfRead::ReadArc()
     double z_extrusion_dir = 1.0;
     bool hidden = false;
     
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2099,7 +2108,7 @@ bool CDxfRead::ReadSpline()
 
     double temp_double;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2273,7 +2282,7 @@ bool CDxfRead::ReadCircle()
     double c[3] = {0,0,0}; // centre
     bool hidden = false;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2355,7 +2364,7 @@ bool CDxfRead::ReadText()
 
     memset( c, 0, sizeof(c) );
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2434,7 +2443,7 @@ bool CDxfRead::ReadEllipse()
     double start=0; //start of arc
     double end=0;  // end of arc
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2604,7 +2613,7 @@ bool CDxfRead::ReadLwPolyLine()
     int flags;
     bool next_item_found = false;
 
-    while(!((*m_ifs).eof()) && !next_item_found)
+    while(!m_eof && !next_item_found)
     {
         get_line();
         int n;
@@ -2711,7 +2720,7 @@ bool CDxfRead::ReadVertex(double *pVertex, bool *bulge_found, double *bulge)
     pVertex[1] = 0.0;
     pVertex[2] = 0.0;
 
-    while(!(*m_ifs).eof()) {
+    while(!m_eof) {
         get_line();
         int n;
         if(sscanf(m_str, "%d", &n) != 1) {
@@ -2784,7 +2793,7 @@ bool CDxfRead::ReadPolyLine()
     bool bulge_found;
     double bulge;
 
-    while(!(*m_ifs).eof())
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2906,7 +2915,7 @@ bool CDxfRead::ReadInsert()
     double rot = 0.0; // rotation
     char name[1024] = {0};
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2998,7 +3007,7 @@ bool CDxfRead::ReadDimension()
     double p[3] = {0,0,0}; // dimpoint
     double rot = -1.0; // rotation
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -3095,7 +3104,7 @@ bool CDxfRead::ReadDimension()
 
 bool CDxfRead::ReadBlockInfo()
 {
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -3136,23 +3145,36 @@ void CDxfRead::get_line()
         return;
     }
 
-    m_ifs->getline(m_str, 1024);
+    // same result as getline() followed by trimming, without the copies
+    size_t size = m_buffer.size();
+    if (m_pos >= size) {
+        m_eof = true;
+        m_str[0] = '\0';
+        return;
+    }
+    const char* begin = m_buffer.data() + m_pos;
+    const char* nl = static_cast<const char*>(memchr(begin, '\n', size - m_pos));
+    const char* end = nl ? nl : m_buffer.data() + size;
+    if (nl) {
+        m_pos = static_cast<size_t>(nl - m_buffer.data()) + 1;
+    }
+    else {
+        m_pos = size;
+        m_eof = true;
+    }
 
-    char str[1024];
-    size_t len = strlen(m_str);
-    int j = 0;
+    size_t j = 0;
     bool non_white_found = false;
-    for(size_t i = 0; i<len; i++){
-        if(non_white_found || (m_str[i] != ' ' && m_str[i] != '\t')){
-            if(m_str[i] != '\r')
+    for(const char* p = begin; p != end && j < sizeof(m_str) - 1; ++p){
+        if(non_white_found || (*p != ' ' && *p != '\t')){
+            if(*p != '\r')
             {
-                str[j] = m_str[i]; j++;
+                m_str[j] = *p; j++;
             }
             non_white_found = true;
         }
     }
-    str[j] = 0;
-    strcpy(m_str, str);
+    m_str[j] = 0;
 }
 
 void dxf_strncpy(char* dst, const char* src, size_t size)
@@ -3195,7 +3217,7 @@ bool CDxfRead::ReadLayer()
     std::string layername;
     int aci = -1;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -3254,7 +3276,7 @@ void CDxfRead::DoRead(const bool ignore_errors /* = false */ )
 
     get_line();
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         if (!strcmp( m_str, "$INSUNITS" )){
             if (!ReadUnits())return;
@@ -244,7 +244,9 @@ public:
 // derive a class from this and implement it's virtual functions
 class ImportExport CDxfRead{
 private:
-    std::ifstream* m_ifs;
+    std::string m_buffer;   // the whole file, get_line() scans it in place
+    size_t m_pos;
+    bool m_eof;
 
     bool m_fail;
     char m_str[1024];
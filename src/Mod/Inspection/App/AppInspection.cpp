@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <memory>
 # include <Python.h>
 #endif
 
@@ -30,7 +31,12 @@
 #include <CXX/Objects.hxx>
 
 #include <Base/Console.h>
+#include <Base/MatrixPy.h>
 #include <Base/PyObjectBase.h>
+#include <Mod/Mesh/App/MeshPy.h>
+#include <Mod/Mesh/App/Core/Registration.h>
+#include <Mod/Points/App/PointsPy.h>
+#include <Mod/Part/App/TopoShapePy.h>
 #include "InspectionFeature.h"
 
 
@@ -40,12 +46,86 @@ class Module : public Py::ExtensionModule<Module>
 public:
     Module() : Py::ExtensionModule<Module>("Inspection")
     {
+        add_varargs_method("bestFit",&Module::bestFit,
+            "bestFit(actual, nominal, [trimRatio=0.9, deflection]) -> (Matrix, rms, converged)\n"
+            "Aligns a mesh, points or shape to a nominal mesh or shape with a trimmed ICP.\n"
+            "The returned matrix moves the actual geometry onto the nominal geometry.\n"
+            "A nominal shape is tessellated with the given deflection."
+        );
         initialize("This module is the Inspection module."); // register with Python
     }
 
     virtual ~Module() {}
 
 private:
+    Py::Object bestFit(const Py::Tuple& args)
+    {
+        PyObject *actual, *nominal;
+        float trimRatio = 0.9f;
+        float deflection = 0.0f;
+        if (!PyArg_ParseTuple(args.ptr(), "OO|ff", &actual, &nominal, &trimRatio, &deflection))
+            throw Py::Exception();
+
+        std::unique_ptr<InspectActualGeometry> actualGeometry;
+        if (PyObject_TypeCheck(actual, &(Mesh::MeshPy::Type))) {
+            const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(actual)->getMeshObjectPtr();
+            actualGeometry.reset(new InspectActualMesh(*mesh));
+        }
+        else if (PyObject_TypeCheck(actual, &(Points::PointsPy::Type))) {
+            const Points::PointKernel* points = static_cast<Points::PointsPy*>(actual)->getPointKernelPtr();
+            actualGeometry.reset(new InspectActualPoints(*points));
+        }
+        else if (PyObject_TypeCheck(actual, &(Part::TopoShapePy::Type))) {
+            const Part::TopoShape* shape = static_cast<Part::TopoShapePy*>(actual)->getTopoShapePtr();
+            actualGeometry.reset(new InspectActualShape(*shape));
+        }
+        else {
+            throw Py::TypeError("actual geometry must be a mesh, points or shape");
+        }
+
+        std::vector<Base::Vector3f> points(actualGeometry->countPoints());
+        for (unsigned long i = 0; i < points.size(); i++)
+            points[i] = actualGeometry->getPoint(i);
+
+        MeshCore::MeshKernel tessellation;
+        std::unique_ptr<MeshCore::MeshRegistration> icp;
+        if (PyObject_TypeCheck(nominal, &(Mesh::MeshPy::Type))) {
+            const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(nominal)->getMeshObjectPtr();
+            icp.reset(new MeshCore::MeshRegistration(mesh->getKernel(), mesh->getTransform()));
+        }
+        else if (PyObject_TypeCheck(nominal, &(Part::TopoShapePy::Type))) {
+            const Part::TopoShape* shape = static_cast<Part::TopoShapePy*>(nominal)->getTopoShapePtr();
+            if (deflection <= 0.0f) {
+                Base::BoundBox3d bbox = shape->getBoundBox();
+                deflection = float(bbox.LengthX() + bbox.LengthY() + bbox.LengthZ()) / 3000.0f;
+            }
+
+            std::vector<Base::Vector3d> nodes;
+            std::vector<Data::ComplexGeoData::Facet> facets;
+            shape->getFaces(nodes, facets, deflection);
+
+            MeshCore::MeshPointArray meshPoints;
+            meshPoints.reserve(nodes.size());
+            for (const auto& it : nodes)
+                meshPoints.push_back(MeshCore::MeshPoint(Base::Vector3f(float(it.x), float(it.y), float(it.z))));
+            MeshCore::MeshFacetArray meshFacets;
+            meshFacets.reserve(facets.size());
+            for (const auto& it : facets)
+                meshFacets.push_back(MeshCore::MeshFacet(it.I1, it.I2, it.I3));
+            tessellation.Adopt(meshPoints, meshFacets);
+            icp.reset(new MeshCore::MeshRegistration(tessellation));
+        }
+        else {
+            throw Py::TypeError("nominal geometry must be a mesh or shape");
+        }
+
+        icp->SetTrimRatio(trimRatio);
+        Base::Matrix4D mat = icp->Align(points);
+
+        return Py::TupleN(Py::asObject(new Base::MatrixPy(new Base::Matrix4D(mat))),
+                          Py::Float(icp->GetRMS()),
+                          Py::Boolean(icp->Converged()));
+    }
 };
 
 PyObject* initModule()
@@ -22,13 +22,26 @@
 
 
 #include "PreCompiled.h"
+#include <functional>
+#include <memory>
 #include <numeric>
 #include <gp_Pnt.hxx>
+#include <gp_Pnt2d.hxx>
+#include <BRep_Tool.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepTools.hxx>
+#include <BRepTopAdaptor_FClass2d.hxx>
+#include <Geom_Surface.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Vertex.hxx>
 
 #include <QEventLoop>
@@ -45,9 +58,11 @@
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 #include <App/Application.h>
+#include <App/GeoFeature.h>
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
@@ -259,33 +274,16 @@ namespace Inspection {
 
 InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offset) : _mesh(rMesh.getKernel())
 {
-    Base::Matrix4D tmp;
-    _clTrf = rMesh.getTransform();
-    _bApply = _clTrf != tmp;
-
-    // Max. limit of grid elements
-    float fMaxGridElements=8000000.0f;
-    Base::BoundBox3f box = _mesh.GetBoundBox().Transformed(rMesh.getTransform());
-
-    // estimate the minimum allowed grid length
-    float fMinGridLen = (float)pow((box.LengthX()*box.LengthY()*box.LengthZ()/fMaxGridElements), 0.3333f);
-    float fGridLen = 5.0f * MeshCore::MeshAlgorithm(_mesh).GetAverageEdgeLength();
-
-    // We want to avoid to get too small grid elements otherwise building up the grid structure would take
-    // too much time and memory. 
-    // Having quite a dense grid speeds up more the following algorithms extremely. Due to the issue above it's
-    // always a compromise between speed and memory usage.
-    fGridLen = std::max<float>(fMinGridLen, fGridLen);
-
-    // build up grid structure to speed up algorithms
-    _pGrid = new MeshInspectGrid(_mesh, fGridLen, rMesh.getTransform());
-    _box = box;
+    // The hierarchy adapts to the facet density, so unlike a grid it doesn't
+    // need a compromise between cell size, speed and memory usage.
+    _pBVH = new MeshCore::MeshFacetBVH(_mesh, rMesh.getTransform());
+    _box = _mesh.GetBoundBox().Transformed(rMesh.getTransform());
     _box.Enlarge(offset);
 }
 
 InspectNominalMesh::~InspectNominalMesh()
 {
-    delete this->_pGrid;
+    delete this->_pBVH;
 }
 
 float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
@@ -293,29 +291,13 @@ float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
     if (!_box.IsInBox(point))
         return FLT_MAX; // must be inside bbox
 
-    std::vector<unsigned long> indices;
-    //_pGrid->GetElements(point, indices);
-    if (indices.empty()) {
-        std::set<unsigned long> inds;
-        _pGrid->MeshGrid::SearchNearestFromPoint(point, inds);
-        indices.insert(indices.begin(), inds.begin(), inds.end());
-    }
-
     float fMinDist=FLT_MAX;
-    bool positive = true;
-    for (std::vector<unsigned long>::iterator it = indices.begin(); it != indices.end(); ++it) {
-        MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(*it);
-        if (_bApply) {
-            geomFace.Transform(_clTrf);
-        }
-
-        float fDist = geomFace.DistanceToPoint(point);
-        if (fabs(fDist) < fabs(fMinDist)) {
-            fMinDist = fDist;
-            positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
-        }
-    }
+    unsigned long index = _pBVH->NearestFacet(point, fMinDist);
+    if (index == ULONG_MAX)
+        return FLT_MAX;
 
+    MeshCore::MeshGeomFacet geomFace = _pBVH->GetFacet(index);
+    bool positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
     if (!positive)
         fMinDist = -fMinDist;
     return fMinDist;
@@ -406,8 +388,7 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
 InspectNominalPoints::InspectNominalPoints(const Points::PointKernel& Kernel, float /*offset*/)
   : _rKernel(Kernel)
 {
-    int uGridPerAxis = 50; // totally 125.000 grid elements 
-    this->_pGrid = new Points::PointsGrid (Kernel, uGridPerAxis);
+    this->_pGrid = new Points::PointsHashGrid (Kernel);
 }
 
 InspectNominalPoints::~InspectNominalPoints()
@@ -417,31 +398,182 @@ InspectNominalPoints::~InspectNominalPoints()
 
 float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 {
-    //TODO: Make faster
-    std::set<unsigned long> indices;
-    unsigned long x,y,z;
+    unsigned long index;
+    double fMinDist=DBL_MAX;
     Base::Vector3d pointd(point.x,point.y,point.z);
-    _pGrid->Position(pointd, x, y, z);
-    _pGrid->GetElements(x,y,z,indices);
+    _pGrid->NearestPoint(pointd, index, fMinDist);
 
-    double fMinDist=DBL_MAX;
-    for (std::set<unsigned long>::iterator it = indices.begin(); it != indices.end(); ++it) {
-        Base::Vector3d pt = _rKernel.getPoint(*it);
-        double fDist = Base::Distance(pointd, pt);
-        if (fDist < fMinDist) {
-            fMinDist = fDist;
+    return (float)fMinDist;
+}
+
+// ----------------------------------------------------------------
+
+/**
+ * The tessellation of a shape with the faces each facet belongs to. Points that are
+ * close to the tessellation are projected onto the exact surface of the face.
+ */
+class InspectNominalShape::ShapeMesh
+{
+public:
+    ShapeMesh(const TopoDS_Shape& shape, float deflection);
+    bool getDistance(const Base::Vector3f& point, unsigned long facet, float& dist) const;
+
+    MeshCore::MeshKernel kernel;
+    std::unique_ptr<MeshCore::MeshFacetBVH> bvh;
+
+private:
+    struct Face
+    {
+        TopoDS_Face face;
+        Handle(Geom_Surface) surface;
+        std::shared_ptr<BRepTopAdaptor_FClass2d> classifier;
+        Standard_Real u1, u2, v1, v2;
+        bool reversed;
+        bool hasUV;
+    };
+
+    float deflection;
+    std::vector<Face> faces;
+    std::vector<unsigned long> facetFace;
+    std::vector<gp_Pnt2d> uvNodes;
+};
+
+InspectNominalShape::ShapeMesh::ShapeMesh(const TopoDS_Shape& shape, float deflection)
+  : deflection(deflection)
+{
+    BRepMesh_IncrementalMesh mkMesh(shape, deflection);
+
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        TopoDS_Face face = TopoDS::Face(xp.Current());
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(face, loc);
+        if (mesh.IsNull())
+            continue;
+
+        Face data;
+        data.face = face;
+        data.surface = BRep_Tool::Surface(face);
+        data.classifier = std::make_shared<BRepTopAdaptor_FClass2d>(face, Precision::PConfusion());
+        BRepTools::UVBounds(face, data.u1, data.u2, data.v1, data.v2);
+        data.reversed = (face.Orientation() == TopAbs_REVERSED);
+        data.hasUV = mesh->HasUVNodes() && !data.surface.IsNull();
+        unsigned long faceIndex = faces.size();
+        faces.push_back(data);
+
+        unsigned long offset = points.size();
+        const TColgp_Array1OfPnt& nodes = mesh->Nodes();
+        gp_Trsf trsf = loc.Transformation();
+        for (Standard_Integer i = nodes.Lower(); i <= nodes.Upper(); i++) {
+            gp_Pnt p = nodes(i).Transformed(trsf);
+            points.push_back(MeshCore::MeshPoint(Base::Vector3f(p.X(), p.Y(), p.Z())));
+            uvNodes.push_back(data.hasUV ? mesh->UVNodes()(i) : gp_Pnt2d());
+        }
+
+        // the facets are oriented like the face
+        const Poly_Array1OfTriangle& triangles = mesh->Triangles();
+        for (Standard_Integer i = triangles.Lower(); i <= triangles.Upper(); i++) {
+            Standard_Integer n1, n2, n3;
+            triangles(i).Get(n1, n2, n3);
+            if (data.reversed)
+                std::swap(n1, n2);
+            facets.push_back(MeshCore::MeshFacet(offset + n1 - nodes.Lower(),
+                                                 offset + n2 - nodes.Lower(),
+                                                 offset + n3 - nodes.Lower()));
+            facetFace.push_back(faceIndex);
         }
     }
 
-    return (float)fMinDist;
+    kernel.Adopt(points, facets, false);
+    bvh.reset(new MeshCore::MeshFacetBVH(kernel));
+}
+
+bool InspectNominalShape::ShapeMesh::getDistance(const Base::Vector3f& point, unsigned long facet, float& dist) const
+{
+    const Face& data = faces[facetFace[facet]];
+    if (!data.hasUV)
+        return false;
+
+    // use the parameters of the nearest point of the facet as start value
+    MeshCore::MeshGeomFacet triangle = kernel.GetFacet(facet);
+    Base::Vector3f nearest;
+    float fTriaDist = triangle.DistanceToPoint(point, nearest);
+    float w0, w1, w2;
+    triangle.Weights(nearest, w0, w1, w2);
+    const MeshCore::MeshFacet& face = kernel.GetFacets()[facet];
+    const gp_Pnt2d& uv0 = uvNodes[face._aulPoints[0]];
+    const gp_Pnt2d& uv1 = uvNodes[face._aulPoints[1]];
+    const gp_Pnt2d& uv2 = uvNodes[face._aulPoints[2]];
+    Standard_Real u = w0 * uv0.X() + w1 * uv1.X() + w2 * uv2.X();
+    Standard_Real v = w0 * uv0.Y() + w1 * uv1.Y() + w2 * uv2.Y();
+
+    // Gauss-Newton iteration for the foot point on the surface
+    gp_Pnt pnt(point.x, point.y, point.z);
+    gp_Pnt foot;
+    gp_Vec du, dv;
+    bool converged = false;
+    for (int iter = 0; iter < 20 && !converged; iter++) {
+        data.surface->D1(u, v, foot, du, dv);
+        gp_Vec diff(foot, pnt);
+        Standard_Real a = du.Dot(du);
+        Standard_Real b = du.Dot(dv);
+        Standard_Real c = dv.Dot(dv);
+        Standard_Real det = a * c - b * b;
+        if (det <= Precision::SquareConfusion() * Precision::SquareConfusion())
+            return false;
+        Standard_Real r1 = du.Dot(diff);
+        Standard_Real r2 = dv.Dot(diff);
+        Standard_Real stepU = (c * r1 - b * r2) / det;
+        Standard_Real stepV = (a * r2 - b * r1) / det;
+        u = std::min(std::max(u + stepU, data.u1), data.u2);
+        v = std::min(std::max(v + stepV, data.v1), data.v2);
+        converged = std::fabs(stepU) < Precision::PConfusion() && std::fabs(stepV) < Precision::PConfusion();
+    }
+
+    if (!converged)
+        return false;
+
+    // the foot point must be on the trimmed face
+    if (data.classifier->Perform(gp_Pnt2d(u, v)) == TopAbs_OUT)
+        return false;
+
+    data.surface->D1(u, v, foot, du, dv);
+    gp_Vec diff(foot, pnt);
+    Standard_Real len = diff.Magnitude();
+    // the iteration may have ended in a different local minimum
+    if (len > fTriaDist + 2.0 * deflection)
+        return false;
+
+    gp_Vec normal = du.Crossed(dv);
+    if (normal.SquareMagnitude() <= Precision::SquareConfusion())
+        return false;
+    if (data.reversed)
+        normal.Reverse();
+
+    dist = static_cast<float>(normal.Dot(diff) < 0 ? -len : len);
+    return true;
 }
 
 // ----------------------------------------------------------------
 
-InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
-    : _rShape(shape)
+InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float offset, float deflection)
+    : distss(0)
+    , _rShape(shape)
     , isSolid(false)
+    , _pMesh(0)
+    , _offset(offset)
+    , _deflection(deflection)
 {
+    // With a tessellation the distances are computed from the triangles and only
+    // refined for points inside the search band
+    if (deflection > 0) {
+        _pMesh = new ShapeMesh(_rShape, deflection);
+        _box = _pMesh->kernel.GetBoundBox();
+        _box.Enlarge(offset + deflection);
+        return;
+    }
+
     distss = new BRepExtrema_DistShapeShape();
     distss->LoadS1(_rShape);
 
@@ -462,10 +594,38 @@ InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radi
 InspectNominalShape::~InspectNominalShape()
 {
     delete distss;
+    delete _pMesh;
+}
+
+float InspectNominalShape::getMeshDistance(const Base::Vector3f& point) const
+{
+    if (!_box.IsInBox(point))
+        return FLT_MAX; // must be inside bbox
+
+    float fMinDist=FLT_MAX;
+    unsigned long index = _pMesh->bvh->NearestFacet(point, fMinDist);
+    if (index == ULONG_MAX)
+        return FLT_MAX;
+
+    MeshCore::MeshGeomFacet geomFace = _pMesh->bvh->GetFacet(index);
+    if (point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) < 0)
+        fMinDist = -fMinDist;
+
+    // outside the search band the value gets discarded anyway
+    if (fabs(fMinDist) > _offset + _deflection)
+        return fMinDist;
+
+    float fDist;
+    if (_pMesh->getDistance(point, index, fDist))
+        return fDist;
+    return fMinDist;
 }
 
 float InspectNominalShape::getDistance(const Base::Vector3f& point) const
 {
+    if (_pMesh)
+        return getMeshDistance(point);
+
     gp_Pnt pnt3d(point.x,point.y,point.z);
     BRepBuilderAPI_MakeVertex mkVert(pnt3d);
     distss->LoadS2(mkVert.Vertex());
@@ -714,9 +874,17 @@ Feature::Feature()
 {
     ADD_PROPERTY(SearchRadius,(0.05));
     ADD_PROPERTY(Thickness,(0.0));
+    ADD_PROPERTY_TYPE(Deflection,(0.0),0,App::Prop_None,
+        "If greater than zero nominal shapes are tessellated with this deflection.\n"
+        "Only points inside the search radius are then checked against the exact shape.");
     ADD_PROPERTY(Actual,(0));
     ADD_PROPERTY(Nominals,(0));
     ADD_PROPERTY(Distances,(0.0));
+
+    resumeIndex = 0;
+    resumeSignature = 0;
+    resumeNumValues = 0;
+    resumeSumSq = 0.0;
 }
 
 Feature::~Feature()
@@ -729,6 +897,8 @@ short Feature::mustExecute() const
         return 1;
     if (Thickness.isTouched())
         return 1;
+    if (Deflection.isTouched())
+        return 1;
     if (Actual.isTouched())
         return 1;
     if (Nominals.isTouched())
@@ -736,6 +906,51 @@ short Feature::mustExecute() const
     return 0;
 }
 
+std::size_t Feature::inputSignature(const InspectActualGeometry* actual) const
+{
+    std::size_t seed = 0;
+    auto combine = [&seed](std::size_t value) {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+    auto combineFloat = [&combine](double value) {
+        combine(std::hash<double>()(value));
+    };
+
+    combineFloat(SearchRadius.getValue());
+    combineFloat(Deflection.getValue());
+
+    // a sparse sample of the actual points is enough to detect a modified geometry
+    unsigned long count = actual->countPoints();
+    combine(count);
+    unsigned long step = std::max<unsigned long>(1, count / 1024);
+    for (unsigned long index = 0; index < count; index += step) {
+        Base::Vector3f pnt = actual->getPoint(index);
+        combineFloat(pnt.x);
+        combineFloat(pnt.y);
+        combineFloat(pnt.z);
+    }
+
+    const std::vector<App::DocumentObject*>& nominals = Nominals.getValues();
+    for (std::vector<App::DocumentObject*>::const_iterator it = nominals.begin(); it != nominals.end(); ++it) {
+        combine(std::hash<const void*>()(*it));
+        if ((*it)->getTypeId().isDerivedFrom(App::GeoFeature::getClassTypeId())) {
+            const App::PropertyComplexGeoData* prop = static_cast<App::GeoFeature*>(*it)->getPropertyOfGeometry();
+            const Data::ComplexGeoData* data = prop ? prop->getComplexData() : 0;
+            if (data) {
+                Base::BoundBox3d bbox = data->getBoundBox();
+                combineFloat(bbox.MinX);
+                combineFloat(bbox.MinY);
+                combineFloat(bbox.MinZ);
+                combineFloat(bbox.MaxX);
+                combineFloat(bbox.MaxY);
+                combineFloat(bbox.MaxZ);
+            }
+        }
+    }
+
+    return seed;
+}
+
 App::DocumentObjectExecReturn* Feature::execute(void)
 {
     bool useMultithreading = true;
@@ -776,15 +991,20 @@ App::DocumentObjectExecReturn* Feature::execute(void)
             nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
         }
         else if ((*it)->getTypeId().isDerivedFrom(Part::Feature::getClassTypeId())) {
-            useMultithreading = false;
+            // only the tessellated shape can be used by several threads
+            if (this->Deflection.getValue() <= 0)
+                useMultithreading = false;
             Part::Feature* part = static_cast<Part::Feature*>(*it);
-            nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
+            nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue(),
+                                              this->Deflection.getValue());
         }
 
         if (nominal)
             inspectNominal.push_back(nominal);
     }
 
+    bool canceled = false;
+
 #if 0
 #if 1 // test with some huge data sets
     std::vector<unsigned long> index(actual->countPoints());
@@ -841,7 +1061,26 @@ App::DocumentObjectExecReturn* Feature::execute(void)
         this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), fRMS);
 #else
     unsigned long count = actual->countPoints();
-    std::vector<float> vals(count);
+    std::size_t signature = inputSignature(actual);
+
+    // continue a cancelled inspection if neither the geometries nor the parameters have changed
+    std::vector<float> vals;
+    unsigned long first = 0;
+    DistanceInspectionRMS res;
+    if (resumeSignature == signature && resumeDistances.size() == count) {
+        vals.swap(resumeDistances);
+        first = resumeIndex;
+        res.m_numv = resumeNumValues;
+        res.m_sumsq = resumeSumSq;
+    }
+    else {
+        vals.resize(count, FLT_MAX);
+    }
+
+    resumeDistances.clear();
+    resumeIndex = 0;
+    resumeSignature = 0;
+
     std::function<DistanceInspectionRMS(int)> fMap = [&](unsigned int index)
     {
         DistanceInspectionRMS res;
@@ -869,46 +1108,79 @@ App::DocumentObjectExecReturn* Feature::execute(void)
         return res;
     };
 
-    DistanceInspectionRMS res;
+    // The points are processed in chunks. After each chunk the distances computed so far
+    // are published so that the view provider can show them while the inspection goes on.
+    auto publish = [&](bool partial) {
+        Base::ObjectStatusLocker<App::Property::Status, App::Property> lock(App::Property::User1, &Distances, partial);
+        Distances.setValues(vals);
+    };
 
-    if (useMultithreading) {
-        // Build vector of increasing indices
-        std::vector<unsigned long> index(count);
-        std::iota(index.begin(), index.end(), 0);
-        // Perform map-reduce operation : compute distances and update sum of squares for RMS computation
-        QFuture<DistanceInspectionRMS> future = QtConcurrent::mappedReduced(
-            index, fMap, &DistanceInspectionRMS::operator+=);
-        // Setup progress bar
-        Base::FutureWatcherProgress progress("Inspecting...", actual->countPoints());
-        QFutureWatcher<DistanceInspectionRMS> watcher;
-        QObject::connect(&watcher, SIGNAL(progressValueChanged(int)),
-            &progress, SLOT(progressValueChanged(int)));
-        // Keep UI responsive during computation
-        QEventLoop loop;
-        QObject::connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
-        watcher.setFuture(future);
-        loop.exec();
-        res = future.result();
-    }
-    else {
-        // Single-threaded operation
+    const unsigned long chunkSize = std::max<unsigned long>(65536, count / 16);
+    unsigned long next = first;
+
+    try {
         std::stringstream str;
         str << "Inspecting " << this->Label.getValue() << "...";
-        Base::SequencerLauncher seq(str.str().c_str(), count);
-
-        for (unsigned int i = 0; i < count; i++)
-            res += fMap(i);
+        if (useMultithreading) {
+            Base::SequencerLauncher seq(str.str().c_str(), (count - first + chunkSize - 1) / chunkSize);
+            while (next < count) {
+                unsigned long last = std::min(count, next + chunkSize);
+                // Build vector of increasing indices
+                std::vector<unsigned long> index(last - next);
+                std::iota(index.begin(), index.end(), next);
+                // Perform map-reduce operation : compute distances and update sum of squares for RMS computation
+                QFuture<DistanceInspectionRMS> future = QtConcurrent::mappedReduced(
+                    index, fMap, &DistanceInspectionRMS::operator+=);
+                // Keep UI responsive during computation
+                QFutureWatcher<DistanceInspectionRMS> watcher;
+                QEventLoop loop;
+                QObject::connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
+                watcher.setFuture(future);
+                loop.exec();
+                res += future.result();
+                next = last;
+
+                if (next < count)
+                    publish(true);
+                seq.next(true);
+            }
+        }
+        else {
+            // Single-threaded operation
+            Base::SequencerLauncher seq(str.str().c_str(), count - first);
+            while (next < count) {
+                res += fMap(next++);
+                if (next % chunkSize == 0 && next < count)
+                    publish(true);
+                seq.next(true);
+            }
+        }
+    }
+    catch (const Base::AbortException&) {
+        canceled = next < count;
     }
 
-    Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
-        this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), res.getRMS());
-    Distances.setValues(vals);
+    if (canceled) {
+        publish(true);
+        resumeDistances = vals;
+        resumeIndex = next;
+        resumeSignature = signature;
+        resumeNumValues = res.m_numv;
+        resumeSumSq = res.m_sumsq;
+    }
+    else {
+        Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
+            this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), res.getRMS());
+        publish(false);
+    }
 #endif
 
     delete actual;
     for (std::vector<InspectNominalGeometry*>::iterator it = inspectNominal.begin(); it != inspectNominal.end(); ++it)
         delete *it;
 
+    if (canceled)
+        return new App::DocumentObjectExecReturn("Inspection canceled, recompute to continue with the remaining points");
     return 0;
 }
 
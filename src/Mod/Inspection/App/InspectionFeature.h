@@ -37,10 +37,11 @@ class BRepExtrema_DistShapeShape;
 namespace MeshCore {
 class MeshKernel;
 class MeshGrid;
+class MeshFacetBVH;
 }
 
 namespace Mesh   { class MeshObject; }
-namespace Points { class PointsGrid; }
+namespace Points { class PointsHashGrid; }
 namespace Part   { class TopoShape;  }
 
 namespace Inspection
@@ -112,10 +113,8 @@ public:
 
 private:
     const MeshCore::MeshKernel& _mesh;
-    MeshCore::MeshGrid* _pGrid;
+    MeshCore::MeshFacetBVH* _pBVH;
     Base::BoundBox3f _box;
-    bool _bApply;
-    Base::Matrix4D _clTrf;
 };
 
 class InspectionExport InspectNominalFastMesh : public InspectNominalGeometry
@@ -143,20 +142,32 @@ public:
 
 private:
     const Points::PointKernel& _rKernel;
-    Points::PointsGrid* _pGrid;
+    Points::PointsHashGrid* _pGrid;
 };
 
+/** Calculates the distance to a shape. If \a deflection is greater than zero the shape is
+ * tessellated and the distance is computed from the triangles. Only points inside the
+ * search band are then projected onto the exact surface.
+ */
 class InspectionExport InspectNominalShape : public InspectNominalGeometry
 {
 public:
-    InspectNominalShape(const TopoDS_Shape&, float offset);
+    InspectNominalShape(const TopoDS_Shape&, float offset, float deflection = 0.0f);
     ~InspectNominalShape();
     virtual float getDistance(const Base::Vector3f&) const;
 
 private:
+    float getMeshDistance(const Base::Vector3f&) const;
+
+private:
+    class ShapeMesh;
     BRepExtrema_DistShapeShape* distss;
     const TopoDS_Shape& _rShape;
     bool isSolid;
+    ShapeMesh* _pMesh;
+    Base::BoundBox3f _box;
+    float _offset;
+    float _deflection;
 };
 
 class InspectionExport PropertyDistanceList: public App::PropertyLists
@@ -227,6 +238,7 @@ public:
     //@{
     App::PropertyFloat     SearchRadius;
     App::PropertyFloat     Thickness;
+    App::PropertyFloat     Deflection;
     App::PropertyLink      Actual;
     App::PropertyLinkList  Nominals;
     PropertyDistanceList   Distances;
@@ -242,6 +254,23 @@ public:
     /// returns the type name of the ViewProvider
     const char* getViewProviderName(void) const 
     { return "InspectionGui::ViewProviderInspection"; }
+
+private:
+    std::size_t inputSignature(const InspectActualGeometry*) const;
+
+private:
+    /** @name State of a cancelled inspection
+     * The distances computed so far are kept in memory and the next
+     * recompute continues with the first unprocessed chunk as long as
+     * the input geometry and parameters are unchanged.
+     */
+    //@{
+    std::vector<float> resumeDistances;
+    unsigned long resumeIndex;
+    std::size_t resumeSignature;
+    int resumeNumValues;
+    double resumeSumSq;
+    //@}
 };
 
 class InspectionExport Group : public App::DocumentObjectGroup
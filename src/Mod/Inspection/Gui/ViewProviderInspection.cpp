@@ -281,8 +281,12 @@ void ViewProviderInspection::updateData(const App::Property* prop)
     else if (prop->getTypeId() == Inspection::PropertyDistanceList::getClassTypeId()) {
         // force an update of the Inventor data nodes
         if (this->pcObject) {
+            // partial results of a running inspection only need the colours to be updated
+            const std::vector<float>& fValues = static_cast<const Inspection::PropertyDistanceList*>(prop)->getValues();
+            bool partial = prop->testStatus(App::Property::User1) &&
+                           static_cast<int>(fValues.size()) == this->pcCoords->point.getNum();
             App::Property* link = this->pcObject->getPropertyByName("Actual");
-            if (link)
+            if (link && !partial)
                 updateData(link);
             setDistances();
         }
@@ -268,6 +268,10 @@ private:
 
             exporter.reset( new AmfExporter(outputFileName, meta, exportAmfCompressed) );
 
+        } else if (StreamExporter::isSupported(exportFormat)) {
+            // write the objects one by one without building a merged mesh
+            exporter.reset( new StreamExporter(outputFileName, exportFormat) );
+
         } else if (exportFormat != MeshIO::Undefined) {
             exporter.reset( new MergeExporter(outputFileName, exportFormat) );
 
@@ -25,6 +25,8 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <cfloat>
+# include <cmath>
 #endif
 
 #include "Algorithm.h"
@@ -32,10 +34,13 @@
 #include "Elements.h"
 #include "Iterator.h"
 #include "Grid.h"
+#include "BVH.h"
 #include "Triangulation.h"
 
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
+#include <Base/ThreadPool.h>
+#include <Base/ViewProj.h>
 
 using namespace MeshCore;
 using Base::BoundBox3f;
@@ -119,6 +124,12 @@ bool MeshAlgorithm::NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::
     return false;
 }
 
+bool MeshAlgorithm::NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, const MeshFacetBVH &rclBVH,
+                                       Base::Vector3f &rclRes, unsigned long &rulFacet) const
+{
+    return rclBVH.NearestFacetOnRay(rclPt, rclDir, rclRes, rulFacet);
+}
+
 bool MeshAlgorithm::NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, float fMaxSearchArea,
                                        const MeshFacetGrid &rclGrid, Base::Vector3f &rclRes, unsigned long &rulFacet) const
 {
@@ -2046,3 +2057,145 @@ MeshRefNormalToPoints::operator[] (unsigned long pos) const
 {
     return _norm[pos];
 }
+
+// ----------------------------------------------------------------------------
+
+static unsigned long GridIndex (double value, double minimum, double length, unsigned long count)
+{
+    double pos = (value - minimum) / length;
+    if (!(pos > 0.0)) // also handles NaN
+        return 0;
+    if (pos >= static_cast<double>(count))
+        return count - 1;
+    return static_cast<unsigned long>(pos);
+}
+
+MeshProjectedFacetGrid::MeshProjectedFacetGrid (const MeshKernel &rclM, const Base::ViewProjMethod* pclProj)
+  : _rclMesh(rclM)
+  , _ulCountPoints(0)
+  , _ulCountFacets(0)
+  , _ulCtGridsX(0)
+  , _ulCtGridsY(0)
+  , _fGridLenX(0.0)
+  , _fGridLenY(0.0)
+{
+    Rebuild(pclProj);
+}
+
+void MeshProjectedFacetGrid::Rebuild (const Base::ViewProjMethod* pclProj)
+{
+    _clMat = pclProj->getComposedProjectionMatrix();
+    _ulCountPoints = _rclMesh.CountPoints();
+    _ulCountFacets = _rclMesh.CountFacets();
+    _clMeshBox = _rclMesh.GetBoundBox();
+
+    // Cache the view projection matrix since calls to Coin's projection are expensive
+    Base::ViewProjMatrix fixedProj(_clMat);
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    _points.resize(_ulCountPoints);
+    Base::parallel_for(0UL, _ulCountPoints, [&](unsigned long i) {
+        Base::Vector3f pt2d = fixedProj(rPoints[i]);
+        _points[i].x = pt2d.x;
+        _points[i].y = pt2d.y;
+    }, 1024UL);
+
+    _clBox = Base::BoundBox2d();
+    for (std::vector<Base::Vector2d>::iterator it = _points.begin(); it != _points.end(); ++it)
+        _clBox.Add(*it);
+
+    // choose the number of cells so that there are about four facets per cell
+    double fLenX = std::max(_clBox.Width(), DBL_EPSILON);
+    double fLenY = std::max(_clBox.Height(), DBL_EPSILON);
+    double fCells = std::max(1.0, std::sqrt(static_cast<double>(_ulCountFacets) / 4.0));
+    double fAspect = std::sqrt(fLenX / fLenY);
+    _ulCtGridsX = std::min<unsigned long>(1024, std::max<unsigned long>(1, static_cast<unsigned long>(fCells * fAspect)));
+    _ulCtGridsY = std::min<unsigned long>(1024, std::max<unsigned long>(1, static_cast<unsigned long>(fCells / fAspect)));
+    _fGridLenX = fLenX / _ulCtGridsX;
+    _fGridLenY = fLenY / _ulCtGridsY;
+
+    // sort the facets into all cells overlapped by their projected bounding box
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::vector<unsigned long> aulRange(4 * _ulCountFacets);
+    std::vector<unsigned long> aulCount(_ulCtGridsX * _ulCtGridsY + 1, 0);
+    for (unsigned long i = 0; i < _ulCountFacets; i++) {
+        Base::BoundBox2d clBox;
+        for (int j = 0; j < 3; j++)
+            clBox.Add(_points[rFacets[i]._aulPoints[j]]);
+        unsigned long* range = &aulRange[4 * i];
+        range[0] = GridIndex(clBox.MinX, _clBox.MinX, _fGridLenX, _ulCtGridsX);
+        range[1] = GridIndex(clBox.MaxX, _clBox.MinX, _fGridLenX, _ulCtGridsX);
+        range[2] = GridIndex(clBox.MinY, _clBox.MinY, _fGridLenY, _ulCtGridsY);
+        range[3] = GridIndex(clBox.MaxY, _clBox.MinY, _fGridLenY, _ulCtGridsY);
+        for (unsigned long y = range[2]; y <= range[3]; y++) {
+            for (unsigned long x = range[0]; x <= range[1]; x++)
+                aulCount[y * _ulCtGridsX + x + 1]++;
+        }
+    }
+
+    _cellStart.resize(aulCount.size());
+    _cellStart[0] = 0;
+    for (std::size_t i = 1; i < aulCount.size(); i++)
+        _cellStart[i] = _cellStart[i - 1] + aulCount[i];
+
+    _cellFacets.resize(_cellStart.back());
+    std::vector<unsigned long> aulFill(_cellStart.begin(), _cellStart.end() - 1);
+    for (unsigned long i = 0; i < _ulCountFacets; i++) {
+        const unsigned long* range = &aulRange[4 * i];
+        for (unsigned long y = range[2]; y <= range[3]; y++) {
+            for (unsigned long x = range[0]; x <= range[1]; x++)
+                _cellFacets[aulFill[y * _ulCtGridsX + x]++] = i;
+        }
+    }
+}
+
+bool MeshProjectedFacetGrid::IsValid (const Base::ViewProjMethod* pclProj) const
+{
+    if (_ulCountPoints != _rclMesh.CountPoints() || _ulCountFacets != _rclMesh.CountFacets())
+        return false;
+    const Base::BoundBox3f& clBox = _rclMesh.GetBoundBox();
+    if (clBox.MinX != _clMeshBox.MinX || clBox.MinY != _clMeshBox.MinY || clBox.MinZ != _clMeshBox.MinZ ||
+        clBox.MaxX != _clMeshBox.MaxX || clBox.MaxY != _clMeshBox.MaxY || clBox.MaxZ != _clMeshBox.MaxZ)
+        return false;
+    return pclProj->getComposedProjectionMatrix() == _clMat;
+}
+
+void MeshProjectedFacetGrid::CheckFacets (const Base::Polygon2d& rclPoly, std::vector<unsigned long> &rclRes) const
+{
+    if (_ulCountFacets == 0)
+        return;
+
+    Base::BoundBox2d clPolyBBox = rclPoly.CalcBoundBox();
+    if (!clPolyBBox.Intersect(_clBox))
+        return;
+
+    unsigned long ulMinX = GridIndex(clPolyBBox.MinX, _clBox.MinX, _fGridLenX, _ulCtGridsX);
+    unsigned long ulMaxX = GridIndex(clPolyBBox.MaxX, _clBox.MinX, _fGridLenX, _ulCtGridsX);
+    unsigned long ulMinY = GridIndex(clPolyBBox.MinY, _clBox.MinY, _fGridLenY, _ulCtGridsY);
+    unsigned long ulMaxY = GridIndex(clPolyBBox.MaxY, _clBox.MinY, _fGridLenY, _ulCtGridsY);
+
+    auto isInside = [&](const Base::Vector2d& pt) {
+        return clPolyBBox.Contains(pt) && rclPoly.Contains(pt);
+    };
+
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::vector<bool> visited(_ulCountFacets, false);
+    for (unsigned long y = ulMinY; y <= ulMaxY; y++) {
+        for (unsigned long x = ulMinX; x <= ulMaxX; x++) {
+            unsigned long ulCell = y * _ulCtGridsX + x;
+            for (unsigned long i = _cellStart[ulCell]; i < _cellStart[ulCell + 1]; i++) {
+                unsigned long ulFacet = _cellFacets[i];
+                if (visited[ulFacet])
+                    continue;
+                visited[ulFacet] = true;
+
+                const MeshFacet& rFacet = rFacets[ulFacet];
+                const Base::Vector2d& p0 = _points[rFacet._aulPoints[0]];
+                const Base::Vector2d& p1 = _points[rFacet._aulPoints[1]];
+                const Base::Vector2d& p2 = _points[rFacet._aulPoints[2]];
+                Base::Vector2d clGravity((p0.x + p1.x + p2.x) / 3.0, (p0.y + p1.y + p2.y) / 3.0);
+                if (isInside(p0) || isInside(p1) || isInside(p2) || isInside(clGravity))
+                    rclRes.push_back(ulFacet);
+            }
+        }
+    }
+}
@@ -30,6 +30,8 @@
 
 #include "MeshKernel.h"
 #include "Elements.h"
+#include <Base/Matrix.h>
+#include <Base/Tools2D.h>
 #include <Base/Vector3D.h>
 
 // forward declarations
@@ -45,6 +47,7 @@ class MeshGeomFacet;
 class MeshGeomEdge;
 class MeshKernel;
 class MeshFacetGrid;
+class MeshFacetBVH;
 class MeshFacetArray;
 class MeshRefPointToFacets;
 class AbstractPolygonTriangulator;
@@ -81,6 +84,12 @@ public:
    */
   bool NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, const MeshFacetGrid &rclGrid,
                           Base::Vector3f &rclRes, unsigned long &rulFacet) const;
+  /**
+   * Does the same as the method above but uses a bounding volume hierarchy
+   * which performs better than a grid for meshes with uneven facet density.
+   */
+  bool NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, const MeshFacetBVH &rclBVH,
+                          Base::Vector3f &rclRes, unsigned long &rulFacet) const;
   /**
    * Searches for the nearest facet to the ray defined by
    * (\a rclPt, \a rclDir).
@@ -523,6 +532,50 @@ protected:
     std::vector<Base::Vector3f> _norm;
 };
 
+/**
+ * The MeshProjectedFacetGrid projects the points of a mesh once with a view projection
+ * and sorts the facets into a regular grid of screen cells. The structure can be reused
+ * for all polygon selections as long as the projection doesn't change, so that only the
+ * facets of the cells touched by the polygon must be checked.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshProjectedFacetGrid
+{
+public:
+    /// Construction
+    MeshProjectedFacetGrid (const MeshKernel &rclM, const Base::ViewProjMethod* pclProj);
+    /// Destruction
+    ~MeshProjectedFacetGrid (void)
+    { }
+
+    /// Rebuilds up data structure
+    void Rebuild (const Base::ViewProjMethod* pclProj);
+    /**
+     * Checks whether the structure was built with the projection \a pclProj for
+     * the current state of the mesh.
+     */
+    bool IsValid (const Base::ViewProjMethod* pclProj) const;
+    /**
+     * Determines all facets with at least one corner or their center of gravity inside
+     * the polygon. This gives the same result as MeshAlgorithm::CheckFacets with \a bInner
+     * set to \a true.
+     */
+    void CheckFacets (const Base::Polygon2d& rclPoly, std::vector<unsigned long> &rclRes) const;
+
+protected:
+    const MeshKernel  &_rclMesh; /**< The mesh kernel. */
+    Base::Matrix4D _clMat;
+    unsigned long _ulCountPoints, _ulCountFacets;
+    Base::BoundBox3f _clMeshBox;
+    std::vector<Base::Vector2d> _points;
+    Base::BoundBox2d _clBox;
+    unsigned long _ulCtGridsX, _ulCtGridsY;
+    double _fGridLenX, _fGridLenY;
+    std::vector<unsigned long> _cellStart;
+    std::vector<unsigned long> _cellFacets;
+};
+
 } // namespace MeshCore 
 
 #endif  // MESH_ALGORITHM_H 
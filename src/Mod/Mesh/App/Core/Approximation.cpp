@@ -140,6 +140,29 @@ bool Approximation::Done() const
 
 // -------------------------------------------------------------------------------
 
+PointMoments::PointMoments()
+{
+    Clear();
+}
+
+void PointMoments::Add(const Base::Vector3f& p)
+{
+    sxx += double(p.x * p.x); sxy += double(p.x * p.y);
+    sxz += double(p.x * p.z); syy += double(p.y * p.y);
+    syz += double(p.y * p.z); szz += double(p.z * p.z);
+    sx  += double(p.x); sy += double(p.y); sz += double(p.z);
+    count++;
+}
+
+void PointMoments::Clear()
+{
+    sx = sy = sz = 0.0;
+    sxx = sxy = sxz = syy = syz = szz = 0.0;
+    count = 0;
+}
+
+// -------------------------------------------------------------------------------
+
 PlaneFit::PlaneFit()
   : _vBase(0,0,0)
   , _vDirU(1,0,0)
@@ -153,22 +176,24 @@ PlaneFit::~PlaneFit()
 }
 
 float PlaneFit::Fit()
+{
+    PointMoments moments;
+    for (std::list<Base::Vector3f>::iterator it = _vPoints.begin(); it!=_vPoints.end(); ++it)
+        moments.Add(*it);
+    return Fit(moments);
+}
+
+float PlaneFit::Fit(const PointMoments& moments)
 {
     _bIsFitted = true;
-    if (CountPoints() < 3)
+    if (moments.count < 3)
         return FLOAT_MAX;
 
-    double sxx,sxy,sxz,syy,syz,szz,mx,my,mz;
-    sxx=sxy=sxz=syy=syz=szz=mx=my=mz=0.0;
-
-    for (std::list<Base::Vector3f>::iterator it = _vPoints.begin(); it!=_vPoints.end(); ++it) {
-        sxx += double(it->x * it->x); sxy += double(it->x * it->y);
-        sxz += double(it->x * it->z); syy += double(it->y * it->y);
-        syz += double(it->y * it->z); szz += double(it->z * it->z);
-        mx  += double(it->x); my += double(it->y); mz += double(it->z);
-    }
+    double sxx = moments.sxx, sxy = moments.sxy, sxz = moments.sxz;
+    double syy = moments.syy, syz = moments.syz, szz = moments.szz;
+    double mx = moments.sx, my = moments.sy, mz = moments.sz;
 
-    size_t nSize = _vPoints.size();
+    size_t nSize = moments.count;
     sxx = sxx - mx*mx/(double(nSize));
     sxy = sxy - mx*my/(double(nSize));
     sxz = sxz - mx*mz/(double(nSize));
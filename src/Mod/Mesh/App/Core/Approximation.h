@@ -178,6 +178,24 @@ protected:
 
 // -------------------------------------------------------------------------------
 
+/**
+ * The first and second order moments of a point set. They can be accumulated
+ * point by point so that a fit of a growing point set doesn't need to iterate
+ * over all points again.
+ */
+struct MeshExport PointMoments
+{
+    PointMoments();
+    void Add(const Base::Vector3f&);
+    void Clear();
+
+    double sx, sy, sz;
+    double sxx, sxy, sxz, syy, syz, szz;
+    std::size_t count;
+};
+
+// -------------------------------------------------------------------------------
+
 /**
  * Approximation of a plane into a given set of points.
  */
@@ -205,6 +223,11 @@ public:
      * to succeed. If the fit fails FLOAT_MAX is returned.
      */
     float Fit();
+    /**
+     * Fit a plane into the points described by \a moments instead of the added points.
+     * The result is the same as of Fit() for the same set of points.
+     */
+    float Fit(const PointMoments& moments);
     /** 
      * Returns the distance from the point \a rcPoint to the fitted plane. If Fit() has not been
      * called FLOAT_MAX is returned.
@@ -0,0 +1,439 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <climits>
+# include <cfloat>
+#endif
+
+#include "BVH.h"
+#include "MeshKernel.h"
+
+using namespace MeshCore;
+
+namespace {
+
+const unsigned long maxLeafSize = 4;
+const int numBins = 16;
+
+float surfaceArea(const Base::BoundBox3f& box)
+{
+    if (!box.IsValid())
+        return 0.0f;
+    float dx = box.LengthX();
+    float dy = box.LengthY();
+    float dz = box.LengthZ();
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+/* Computes the parameter interval of the line P + t * D inside the box */
+bool clipLine(const Base::BoundBox3f& box, const Base::Vector3f& P, const Base::Vector3f& D,
+              float& t0, float& t1)
+{
+    const float pos[3] = { P.x, P.y, P.z };
+    const float dir[3] = { D.x, D.y, D.z };
+    const float bmin[3] = { box.MinX, box.MinY, box.MinZ };
+    const float bmax[3] = { box.MaxX, box.MaxY, box.MaxZ };
+
+    t0 = -FLT_MAX;
+    t1 = FLT_MAX;
+    for (int i = 0; i < 3; i++) {
+        if (dir[i] == 0.0f) {
+            if (pos[i] < bmin[i] || pos[i] > bmax[i])
+                return false;
+            continue;
+        }
+        float inv = 1.0f / dir[i];
+        float ta = (bmin[i] - pos[i]) * inv;
+        float tb = (bmax[i] - pos[i]) * inv;
+        if (ta > tb)
+            std::swap(ta, tb);
+        t0 = std::max(t0, ta);
+        t1 = std::min(t1, tb);
+        if (t0 > t1)
+            return false;
+    }
+    return true;
+}
+
+float squaredDistance(const Base::BoundBox3f& box, const Base::Vector3f& P)
+{
+    float dx = std::max(std::max(box.MinX - P.x, 0.0f), P.x - box.MaxX);
+    float dy = std::max(std::max(box.MinY - P.y, 0.0f), P.y - box.MaxY);
+    float dz = std::max(std::max(box.MinZ - P.z, 0.0f), P.z - box.MaxZ);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+}
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& mesh)
+  : _mesh(mesh)
+  , _transform(false)
+{
+    Rebuild();
+}
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& mesh, const Base::Matrix4D& mat)
+  : _mesh(mesh)
+  , _mat(mat)
+  , _transform(mat != Base::Matrix4D())
+{
+    Rebuild();
+}
+
+MeshFacetBVH::~MeshFacetBVH()
+{
+}
+
+MeshGeomFacet MeshFacetBVH::GetFacet(unsigned long ulFacet) const
+{
+    MeshGeomFacet facet = _mesh.GetFacet(ulFacet);
+    if (_transform)
+        facet.Transform(_mat);
+    return facet;
+}
+
+void MeshFacetBVH::Rebuild()
+{
+    _nodes.clear();
+    _facets.clear();
+    _triangles.clear();
+
+    unsigned long ulCount = _mesh.CountFacets();
+    if (ulCount == 0)
+        return;
+
+    const MeshPointArray& rPoints = _mesh.GetPoints();
+    const MeshFacetArray& rFacets = _mesh.GetFacets();
+    std::vector<Base::BoundBox3f> boxes(ulCount);
+    std::vector<Base::Vector3f> centers(ulCount);
+    std::vector<Triangle> triangles(ulCount);
+    _facets.resize(ulCount);
+    for (unsigned long i = 0; i < ulCount; i++) {
+        Triangle& tria = triangles[i];
+        for (int j = 0; j < 3; j++) {
+            tria.points[j] = rPoints[rFacets[i]._aulPoints[j]];
+            if (_transform)
+                tria.points[j] = _mat * tria.points[j];
+            boxes[i].Add(tria.points[j]);
+        }
+        centers[i] = boxes[i].GetCenter();
+        _facets[i] = i;
+    }
+
+    _nodes.reserve(2 * ulCount / maxLeafSize + 1);
+    Build(0, ulCount, boxes, centers);
+
+    // store the points in leaf order
+    _triangles.resize(ulCount);
+    for (unsigned long i = 0; i < ulCount; i++)
+        _triangles[i] = triangles[_facets[i]];
+}
+
+unsigned long MeshFacetBVH::Build(unsigned long first, unsigned long last,
+                                  std::vector<Base::BoundBox3f>& boxes,
+                                  std::vector<Base::Vector3f>& centers)
+{
+    unsigned long nodeIndex = _nodes.size();
+    _nodes.push_back(Node());
+
+    Base::BoundBox3f box, centerBox;
+    for (unsigned long i = first; i < last; i++) {
+        box.Add(boxes[_facets[i]]);
+        centerBox.Add(centers[_facets[i]]);
+    }
+    _nodes[nodeIndex].box = box;
+
+    unsigned long count = last - first;
+    auto makeLeaf = [&]() {
+        _nodes[nodeIndex].index = first;
+        _nodes[nodeIndex].count = count;
+        return nodeIndex;
+    };
+
+    if (count <= maxLeafSize)
+        return makeLeaf();
+
+    // split along the longest axis of the centers
+    int axis = 0;
+    float extent = centerBox.LengthX();
+    if (centerBox.LengthY() > extent) {
+        axis = 1;
+        extent = centerBox.LengthY();
+    }
+    if (centerBox.LengthZ() > extent) {
+        axis = 2;
+        extent = centerBox.LengthZ();
+    }
+    if (extent <= 0.0f)
+        return makeLeaf();
+
+    float axisMin = axis == 0 ? centerBox.MinX : axis == 1 ? centerBox.MinY : centerBox.MinZ;
+    float scale = numBins / extent;
+    auto binOf = [&](unsigned long facet) {
+        const Base::Vector3f& c = centers[facet];
+        float v = axis == 0 ? c.x : axis == 1 ? c.y : c.z;
+        return std::min(numBins - 1, static_cast<int>((v - axisMin) * scale));
+    };
+
+    // bin the facets and evaluate the surface area heuristic for each split
+    unsigned long binCount[numBins] = {};
+    Base::BoundBox3f binBox[numBins];
+    for (unsigned long i = first; i < last; i++) {
+        int bin = binOf(_facets[i]);
+        binCount[bin]++;
+        binBox[bin].Add(boxes[_facets[i]]);
+    }
+
+    float rightArea[numBins];
+    unsigned long rightCount[numBins];
+    Base::BoundBox3f accum;
+    unsigned long accumCount = 0;
+    for (int i = numBins - 1; i > 0; i--) {
+        accum.Add(binBox[i]);
+        accumCount += binCount[i];
+        rightArea[i] = surfaceArea(accum);
+        rightCount[i] = accumCount;
+    }
+
+    int bestSplit = -1;
+    float bestCost = FLT_MAX;
+    accum = Base::BoundBox3f();
+    accumCount = 0;
+    for (int i = 1; i < numBins; i++) {
+        accum.Add(binBox[i - 1]);
+        accumCount += binCount[i - 1];
+        if (accumCount == 0 || rightCount[i] == 0)
+            continue;
+        float cost = accumCount * surfaceArea(accum) + rightCount[i] * rightArea[i];
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestSplit = i;
+        }
+    }
+
+    unsigned long mid;
+    if (bestSplit < 0) {
+        // all centers fall into one bin, split at the median
+        mid = first + count / 2;
+        std::nth_element(_facets.begin() + first, _facets.begin() + mid, _facets.begin() + last,
+                         [&](unsigned long a, unsigned long b) {
+            const Base::Vector3f& ca = centers[a];
+            const Base::Vector3f& cb = centers[b];
+            return axis == 0 ? ca.x < cb.x : axis == 1 ? ca.y < cb.y : ca.z < cb.z;
+        });
+    }
+    else {
+        // splitting is no better than testing all facets of the node
+        if (bestCost >= count * surfaceArea(box) && count <= 4 * maxLeafSize)
+            return makeLeaf();
+        auto it = std::partition(_facets.begin() + first, _facets.begin() + last,
+                                 [&](unsigned long facet) {
+            return binOf(facet) < bestSplit;
+        });
+        mid = it - _facets.begin();
+    }
+
+    Build(first, mid, boxes, centers);
+    unsigned long right = Build(mid, last, boxes, centers);
+    _nodes[nodeIndex].index = right;
+    _nodes[nodeIndex].count = 0;
+    return nodeIndex;
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(const Base::Vector3f &rclPt, const Base::Vector3f &rclDir,
+                                     Base::Vector3f &rclRes, unsigned long &rulFacet) const
+{
+    if (_nodes.empty())
+        return false;
+
+    // the line is checked in both directions, so all parameters are compared by their magnitude
+    float fBest = FLT_MAX;
+    bool bSol = false;
+    float t0, t1;
+    auto lowerBound = [&](const Node& node, float& bound) {
+        if (!clipLine(node.box, rclPt, rclDir, t0, t1))
+            return false;
+        bound = (t0 <= 0.0f && t1 >= 0.0f) ? 0.0f : std::min(fabs(t0), fabs(t1));
+        return true;
+    };
+
+    float fLength = rclDir.Length();
+    std::vector<std::pair<unsigned long, float> > stack;
+    float bound;
+    if (lowerBound(_nodes[0], bound))
+        stack.emplace_back(0, bound);
+
+    while (!stack.empty()) {
+        unsigned long nodeIndex = stack.back().first;
+        float nodeBound = stack.back().second;
+        stack.pop_back();
+        if (nodeBound * fLength >= fBest)
+            continue;
+
+        const Node& node = _nodes[nodeIndex];
+        if (node.count > 0) {
+            Base::Vector3f clRes;
+            for (unsigned long i = node.index; i < node.index + node.count; i++) {
+                const Triangle& tria = _triangles[i];
+                MeshGeomFacet facet(tria.points[0], tria.points[1], tria.points[2]);
+                if (facet.Foraminate(rclPt, rclDir, clRes)) {
+                    float fDist = (clRes - rclPt).Length();
+                    if (!bSol || fDist < fBest) {
+                        bSol = true;
+                        fBest = fDist;
+                        rclRes = clRes;
+                        rulFacet = _facets[i];
+                    }
+                }
+            }
+            continue;
+        }
+
+        // push the farther child first so that the nearer one gets processed next
+        float leftBound, rightBound;
+        bool left = lowerBound(_nodes[nodeIndex + 1], leftBound);
+        bool right = lowerBound(_nodes[node.index], rightBound);
+        if (left && right && leftBound < rightBound) {
+            stack.emplace_back(node.index, rightBound);
+            stack.emplace_back(nodeIndex + 1, leftBound);
+        }
+        else {
+            if (left)
+                stack.emplace_back(nodeIndex + 1, leftBound);
+            if (right)
+                stack.emplace_back(node.index, rightBound);
+        }
+    }
+
+    return bSol;
+}
+
+unsigned long MeshFacetBVH::NearestFacet(const Base::Vector3f &rclPt, float& rfDist) const
+{
+    if (_nodes.empty())
+        return ULONG_MAX;
+
+    unsigned long ulFacet = ULONG_MAX;
+    float fBest = FLT_MAX; // squared distance
+    std::vector<std::pair<unsigned long, float> > stack;
+    stack.emplace_back(0, squaredDistance(_nodes[0].box, rclPt));
+
+    while (!stack.empty()) {
+        unsigned long nodeIndex = stack.back().first;
+        float nodeBound = stack.back().second;
+        stack.pop_back();
+        if (nodeBound >= fBest)
+            continue;
+
+        const Node& node = _nodes[nodeIndex];
+        if (node.count > 0) {
+            for (unsigned long i = node.index; i < node.index + node.count; i++) {
+                const Triangle& tria = _triangles[i];
+                MeshGeomFacet facet(tria.points[0], tria.points[1], tria.points[2]);
+                float fDist = facet.DistanceToPoint(rclPt);
+                if (fDist * fDist < fBest) {
+                    fBest = fDist * fDist;
+                    rfDist = fDist;
+                    ulFacet = _facets[i];
+                }
+            }
+            continue;
+        }
+
+        float leftBound = squaredDistance(_nodes[nodeIndex + 1].box, rclPt);
+        float rightBound = squaredDistance(_nodes[node.index].box, rclPt);
+        if (leftBound < rightBound) {
+            stack.emplace_back(node.index, rightBound);
+            stack.emplace_back(nodeIndex + 1, leftBound);
+        }
+        else {
+            stack.emplace_back(nodeIndex + 1, leftBound);
+            stack.emplace_back(node.index, rightBound);
+        }
+    }
+
+    return ulFacet;
+}
+
+void MeshFacetBVH::OverlappingFacets(const MeshFacetBVH& other,
+                                     std::vector<std::pair<unsigned long, unsigned long> >& pairs) const
+{
+    pairs.clear();
+    if (_nodes.empty() || other._nodes.empty())
+        return;
+
+    auto boxOf = [](const Triangle& tria) {
+        Base::BoundBox3f box;
+        for (int i = 0; i < 3; i++)
+            box.Add(tria.points[i]);
+        return box;
+    };
+
+    std::vector<std::pair<unsigned long, unsigned long> > stack;
+    if (_nodes[0].box.Intersect(other._nodes[0].box))
+        stack.emplace_back(0, 0);
+
+    while (!stack.empty()) {
+        unsigned long index1 = stack.back().first;
+        unsigned long index2 = stack.back().second;
+        stack.pop_back();
+
+        const Node& node1 = _nodes[index1];
+        const Node& node2 = other._nodes[index2];
+        if (node1.count > 0 && node2.count > 0) {
+            for (unsigned long i = node1.index; i < node1.index + node1.count; i++) {
+                Base::BoundBox3f box1 = boxOf(_triangles[i]);
+                if (!box1.Intersect(node2.box))
+                    continue;
+                for (unsigned long j = node2.index; j < node2.index + node2.count; j++) {
+                    if (box1.Intersect(boxOf(other._triangles[j])))
+                        pairs.emplace_back(_facets[i], other._facets[j]);
+                }
+            }
+            continue;
+        }
+
+        // descend into the larger inner node
+        bool split1 = node2.count > 0 ||
+            (node1.count == 0 && surfaceArea(node1.box) >= surfaceArea(node2.box));
+        if (split1) {
+            unsigned long children[2] = { index1 + 1, node1.index };
+            for (int k = 0; k < 2; k++) {
+                if (_nodes[children[k]].box.Intersect(node2.box))
+                    stack.emplace_back(children[k], index2);
+            }
+        }
+        else {
+            unsigned long children[2] = { index2 + 1, node2.index };
+            for (int k = 0; k < 2; k++) {
+                if (node1.box.Intersect(other._nodes[children[k]].box))
+                    stack.emplace_back(index1, children[k]);
+            }
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+}
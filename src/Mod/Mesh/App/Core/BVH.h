@@ -0,0 +1,112 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <utility>
+#include <vector>
+
+#include "Elements.h"
+#include <Base/BoundBox.h>
+#include <Base/Matrix.h>
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH is a bounding volume hierarchy over the facets of a mesh.
+ * Unlike MeshFacetGrid its cells adapt to the distribution of the facets, so
+ * it also works well for meshes with a very uneven facet density, e.g. scans
+ * with small details next to large flat areas.
+ *
+ * The hierarchy is built with the surface area heuristic and stored as a flat
+ * array of nodes in depth-first order. The points of the facets are copied in
+ * leaf order so that a query only touches contiguous memory.
+ * The structure is not updated automatically when the mesh changes, so
+ * Rebuild() must be called in this case.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /// Construction
+    MeshFacetBVH(const MeshKernel& mesh);
+    /// Construction with the facets transformed by \a mat
+    MeshFacetBVH(const MeshKernel& mesh, const Base::Matrix4D& mat);
+    ~MeshFacetBVH();
+
+    /// Rebuilds the hierarchy
+    void Rebuild();
+    /// Return the (transformed) facet with index \a ulFacet
+    MeshGeomFacet GetFacet(unsigned long ulFacet) const;
+    /** Searches for the nearest facet intersected by the line through \a rclPt with
+     * direction \a rclDir, like MeshAlgorithm::NearestFacetOnRay.
+     * @return true if a facet was hit.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f &rclPt, const Base::Vector3f &rclDir,
+                           Base::Vector3f &rclRes, unsigned long &rulFacet) const;
+    /** Searches for the facet with the smallest distance to \a rclPt.
+     * @return the index of the facet or ULONG_MAX if the mesh is empty.
+     */
+    unsigned long NearestFacet(const Base::Vector3f &rclPt, float& rfDist) const;
+    /** Collects all pairs of facets of this and \a other whose bounding boxes overlap
+     * by traversing both hierarchies simultaneously. The first index of a pair refers
+     * to this mesh, the second one to \a other. The pairs are sorted by their indices.
+     */
+    void OverlappingFacets(const MeshFacetBVH& other,
+                           std::vector<std::pair<unsigned long, unsigned long> >& pairs) const;
+
+private:
+    struct Node {
+        Base::BoundBox3f box;
+        /// index of the first facet for leaves, of the second child otherwise
+        unsigned long index;
+        /// number of facets, 0 for inner nodes
+        unsigned long count;
+    };
+    struct Triangle {
+        Base::Vector3f points[3];
+    };
+
+    unsigned long Build(unsigned long first, unsigned long last,
+                        std::vector<Base::BoundBox3f>& boxes,
+                        std::vector<Base::Vector3f>& centers);
+
+private:
+    const MeshKernel& _mesh;
+    Base::Matrix4D _mat;
+    bool _transform;
+    std::vector<Node> _nodes;
+    std::vector<unsigned long> _facets;
+    std::vector<Triangle> _triangles;
+
+    MeshFacetBVH(const MeshFacetBVH&);
+    void operator= (const MeshFacetBVH&);
+};
+
+} // namespace MeshCore
+
+
+#endif  // MESH_BVH_H
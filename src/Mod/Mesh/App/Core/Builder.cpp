@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <cstring>
 #endif
 
 #include <Base/Sequencer.h>
@@ -34,6 +35,7 @@
 #include "MeshKernel.h"
 #include "Functional.h"
 #include <QVector>
+#include <QtConcurrentMap>
 
 using namespace MeshCore;
 
@@ -155,48 +157,8 @@ void MeshBuilder::AddFacet (Base::Vector3f* facetPoints, unsigned char flag, uns
 
 void MeshBuilder::SetNeighbourhood ()
 {
-    std::set<Edge> edges;
-    unsigned long facetIdx = 0;
-
-    for (MeshFacetArray::_TIterator it = _meshKernel._aclFacetArray.begin(); it != _meshKernel._aclFacetArray.end(); ++it)
-    {
-        this->_seq->next(true); // allow to cancel
-        MeshFacet& mf = *it;
-
-        for (int i = 0; i < 3; i++)
-        {
-            Edge edge(mf._aulPoints[i], mf._aulPoints[(i+1)%3], facetIdx);
-            std::set<Edge>::iterator e = edges.find(edge);
-            if (e != edges.end())
-            { // edge exists, set neighbourhood
-                MeshFacet& mf1 = _meshKernel._aclFacetArray[e->facetIdx];
-                if (mf1._aulPoints[0] == edge.pt1)
-                {
-                    if (mf1._aulPoints[1] == edge.pt2)
-                        mf1._aulNeighbours[0] = facetIdx;
-                    else
-                        mf1._aulNeighbours[2] = facetIdx;
-                }
-                else if (mf1._aulPoints[0] == edge.pt2)
-                {
-                    if (mf1._aulPoints[1] == edge.pt1)
-                        mf1._aulNeighbours[0] = facetIdx;
-                    else
-                        mf1._aulNeighbours[2] = facetIdx;
-                }
-                else
-                    mf1._aulNeighbours[1] = facetIdx;
-
-                mf._aulNeighbours[i] = e->facetIdx;
-            }
-            else
-            {  // new edge
-                edges.insert(edge);
-            }
-        }
-
-        facetIdx++;
-    }
+    // the sorted edge array of the kernel is much faster than a set of edges
+    _meshKernel.RebuildNeighbours();
 }
 
 void MeshBuilder::RemoveUnreferencedPoints()
@@ -322,6 +284,37 @@ void MeshFastBuilder::AddFacet (const MeshGeomFacet& facetPoints)
     }
 }
 
+void MeshFastBuilder::AddFacets (const char* data, size_type ctFacets, size_type stride)
+{
+    if (ctFacets <= 0)
+        return;
+
+    QVector<Private::Vertex>& verts = p->verts;
+    int offset = verts.size();
+    verts.resize(offset + 3 * ctFacets);
+    Private::Vertex* dest = verts.data() + offset;
+
+    const size_type blockSize = 0x10000;
+    std::vector<size_type> blocks;
+    blocks.reserve(ctFacets / blockSize + 1);
+    for (size_type i = 0; i < ctFacets; i += blockSize)
+        blocks.push_back(i);
+
+    QtConcurrent::blockingMap(blocks, [=](size_type start) {
+        size_type end = std::min(start + blockSize, ctFacets);
+        float coords[9];
+        for (size_type i = start; i < end; i++) {
+            memcpy(coords, data + static_cast<std::size_t>(i) * stride, sizeof(coords));
+            for (int j = 0; j < 3; j++) {
+                Private::Vertex& v = dest[3 * i + j];
+                v.x = coords[3 * j];
+                v.y = coords[3 * j + 1];
+                v.z = coords[3 * j + 2];
+            }
+        }
+    });
+}
+
 void MeshFastBuilder::Finish ()
 {
     typedef QVector<Private::Vertex>::size_type size_type;
@@ -201,6 +201,11 @@ public:
     /** Add new facet
      */
     void AddFacet (const MeshGeomFacet& facetPoints);
+    /** Add \a ctFacets facets from a raw memory block in parallel.
+     * The i-th facet is given by the nine floats starting at \a data + i * \a stride.
+     * The data doesn't need to be aligned.
+     */
+    void AddFacets (const char* data, size_type ctFacets, size_type stride);
 
     /** Finishes building up the mesh structure. Must be done after adding facets.
      */
@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <algorithm>
+# include <memory>
 #endif
 
 #include <QFuture>
@@ -34,8 +35,10 @@
 #ifdef OPTIMIZE_CURVATURE
 #include <Eigen/Eigenvalues>
 #else
+#include <Mod/Mesh/App/WildMagic4/Wm4Vector2.h>
 #include <Mod/Mesh/App/WildMagic4/Wm4Vector3.h>
-#include <Mod/Mesh/App/WildMagic4/Wm4MeshCurvature.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix2.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix3.h>
 #endif
 
 #include "Curvature.h"
@@ -45,20 +48,21 @@
 #include "Iterator.h"
 #include "Tools.h"
 #include <Base/Sequencer.h>
+#include <Base/ThreadPool.h>
 #include <Base/Tools.h>
 
 using namespace MeshCore;
 namespace bp = boost::placeholders;
 
 MeshCurvature::MeshCurvature(const MeshKernel& kernel)
-  : myKernel(kernel), myMinPoints(20), myRadius(0.5f)
+  : myKernel(kernel), mySearch(nullptr), myMinPoints(20), myRadius(0.5f)
 {
     mySegment.resize(kernel.CountFacets());
     std::generate(mySegment.begin(), mySegment.end(), Base::iotaGen<unsigned long>(0));
 }
 
 MeshCurvature::MeshCurvature(const MeshKernel& kernel, const std::vector<unsigned long>& segm)
-  : myKernel(kernel), myMinPoints(20), myRadius(0.5f), mySegment(segm)
+  : myKernel(kernel), mySearch(nullptr), myMinPoints(20), myRadius(0.5f), mySegment(segm)
 {
 }
 
@@ -67,8 +71,10 @@ void MeshCurvature::ComputePerFace(bool parallel)
     Base::Vector3f rkDir0, rkDir1, rkPnt;
     Base::Vector3f rkNormal;
     myCurvature.clear();
-    MeshRefPointToFacets search(myKernel);
-    FacetCurvature face(myKernel, search, myRadius, myMinPoints);
+    std::unique_ptr<MeshRefPointToFacets> search;
+    if (!mySearch)
+        search.reset(new MeshRefPointToFacets(myKernel));
+    FacetCurvature face(myKernel, mySearch ? *mySearch : *search, myRadius, myMinPoints);
 
     if (!parallel) {
         Base::SequencerLauncher seq("Curvature estimation", mySegment.size());
@@ -289,51 +295,150 @@ void MeshCurvature::ComputePerVertex()
     }
 }
 #else
+namespace {
+typedef Wm4::Vector3<double> Vector3d;
+typedef Wm4::Matrix3<double> Matrix3d;
+
+inline Vector3d toVector3d(const Base::Vector3f& p)
+{
+    return Vector3d(p.x, p.y, p.z);
+}
+}
+
+// This computes the same quantities as Wm4::MeshCurvature but gathers the
+// contributions per vertex from its adjacent facets instead of scattering them
+// per facet. Thus, each vertex can be handled independently. The facets of a
+// vertex are visited in ascending order of their indices so that the sums are
+// accumulated in the same order as Wm4::MeshCurvature does.
 void MeshCurvature::ComputePerVertex()
 {
     myCurvature.clear();
 
-    // get all points
-    std::vector< Wm4::Vector3<double> > aPnts;
-    aPnts.reserve(myKernel.CountPoints());
-    MeshPointIterator cPIt(myKernel);
-    for (cPIt.Init(); cPIt.More(); cPIt.Next()) {
-        Wm4::Vector3<double> cP(cPIt->x, cPIt->y, cPIt->z);
-        aPnts.push_back(cP);
-    }
+    // in case of an empty mesh no curvature can be calculated
+    unsigned long numPoints = myKernel.CountPoints();
+    if (numPoints == 0 || myKernel.CountFacets() == 0)
+        return;
 
-    // get all point connections
-    std::vector<int> aIdx;
-    aIdx.reserve(3*myKernel.CountFacets());
-    const MeshFacetArray& raFts = myKernel.GetFacets();
-    for (MeshFacetArray::const_iterator jt = raFts.begin(); jt != raFts.end(); ++jt) {
-        for (int i=0; i<3; i++) {
-            aIdx.push_back((int)jt->_aulPoints[i]);
+    std::unique_ptr<MeshRefPointToFacets> search;
+    if (!mySearch)
+        search.reset(new MeshRefPointToFacets(myKernel));
+    const MeshRefPointToFacets& pt2f = mySearch ? *mySearch : *search;
+
+    const MeshPointArray& rPoints = myKernel.GetPoints();
+    const MeshFacetArray& rFacets = myKernel.GetFacets();
+
+    // compute normal vectors (length of a facet normal provides a weighted sum)
+    std::vector<Vector3d> akNormal(numPoints);
+    Base::parallel_for(0UL, numPoints, [&](unsigned long i) {
+        Vector3d kNormal(0.0, 0.0, 0.0);
+        for (unsigned long index : pt2f[i]) {
+            const MeshFacet& rFacet = rFacets[index];
+            Vector3d kV0 = toVector3d(rPoints[rFacet._aulPoints[0]]);
+            Vector3d kEdge1 = toVector3d(rPoints[rFacet._aulPoints[1]]) - kV0;
+            Vector3d kEdge2 = toVector3d(rPoints[rFacet._aulPoints[2]]) - kV0;
+            Vector3d kFacetNormal = kEdge1.Cross(kEdge2);
+            // a degenerated facet may reference the vertex more than once
+            for (int j = 0; j < 3; j++) {
+                if (rFacet._aulPoints[j] == i)
+                    kNormal += kFacetNormal;
+            }
+        }
+        kNormal.Normalize();
+        akNormal[i] = kNormal;
+    });
+
+    myCurvature.resize(numPoints);
+    Base::parallel_for(0UL, numPoints, [&](unsigned long i) {
+        // compute the matrix of normal derivatives
+        Matrix3d kWWTrn(0, 0, 0, 0, 0, 0, 0, 0, 0);
+        Matrix3d kDWTrn(0, 0, 0, 0, 0, 0, 0, 0, 0);
+        const Vector3d& kN = akNormal[i];
+        Vector3d kV0 = toVector3d(rPoints[i]);
+
+        auto addEdge = [&](unsigned long iV1) {
+            // Compute edge from V0 to V1, project to tangent plane of vertex,
+            // and compute difference of adjacent normals.
+            Vector3d kE = toVector3d(rPoints[iV1]) - kV0;
+            Vector3d kW = kE - (kE.Dot(kN))*kN;
+            Vector3d kD = akNormal[iV1] - kN;
+            for (int iRow = 0; iRow < 3; iRow++) {
+                for (int iCol = 0; iCol < 3; iCol++) {
+                    kWWTrn[iRow][iCol] += kW[iRow]*kW[iCol];
+                    kDWTrn[iRow][iCol] += kD[iRow]*kW[iCol];
+                }
+            }
+        };
+
+        for (unsigned long index : pt2f[i]) {
+            const MeshFacet& rFacet = rFacets[index];
+            for (int j = 0; j < 3; j++) {
+                if (rFacet._aulPoints[j] == i) {
+                    addEdge(rFacet._aulPoints[(j+1)%3]);
+                    addEdge(rFacet._aulPoints[(j+2)%3]);
+                }
+            }
         }
-    }
 
-    // in case of an empty mesh no curvature can be calculated
-    if (myKernel.CountPoints() == 0 || myKernel.CountFacets() == 0)
-        return;
+        // Add in N*N^T to W*W^T for numerical stability.  In theory 0*0^T gets
+        // added to D*W^T, but of course no update needed in the implementation.
+        for (int iRow = 0; iRow < 3; iRow++) {
+            for (int iCol = 0; iCol < 3; iCol++) {
+                kWWTrn[iRow][iCol] = 0.5*kWWTrn[iRow][iCol] + kN[iRow]*kN[iCol];
+                kDWTrn[iRow][iCol] *= 0.5;
+            }
+        }
 
-    // compute vertex based curvatures
-    Wm4::MeshCurvature<double> meshCurv(myKernel.CountPoints(), &(aPnts[0]), myKernel.CountFacets(), &(aIdx[0]));
+        Matrix3d kDNormal = kDWTrn*kWWTrn.Inverse();
 
-    // get curvature information now
-    const Wm4::Vector3<double>* aMaxCurvDir = meshCurv.GetMaxDirections();
-    const Wm4::Vector3<double>* aMinCurvDir = meshCurv.GetMinDirections();
-    const double* aMaxCurv = meshCurv.GetMaxCurvatures();
-    const double* aMinCurv = meshCurv.GetMinCurvatures();
+        // The principal curvatures are the eigenvalues of the shape matrix
+        //   S = J^T * dN/dX * J
+        // with J = [U | V] where {U, V, N} is an orthonormal set. See
+        // Wm4::MeshCurvature for the details.
+        Vector3d kU, kV;
+        Vector3d::GenerateComplementBasis(kU, kV, kN);
 
-    myCurvature.reserve(myKernel.CountPoints());
-    for (unsigned long i=0; i<myKernel.CountPoints(); i++) {
-        CurvatureInfo ci;
-        ci.cMaxCurvDir = Base::Vector3f((float)aMaxCurvDir[i].X(), (float)aMaxCurvDir[i].Y(), (float)aMaxCurvDir[i].Z());
-        ci.cMinCurvDir = Base::Vector3f((float)aMinCurvDir[i].X(), (float)aMinCurvDir[i].Y(), (float)aMinCurvDir[i].Z());
-        ci.fMaxCurvature = (float)aMaxCurv[i];
-        ci.fMinCurvature = (float)aMinCurv[i];
-        myCurvature.push_back(ci);
-    }
+        // Compute S = J^T * dN/dX * J.  In theory S is symmetric, but
+        // because we have estimated dN/dX, we must slightly adjust our
+        // calculations to make sure S is symmetric.
+        double fS01 = kU.Dot(kDNormal*kV);
+        double fS10 = kV.Dot(kDNormal*kU);
+        double fSAvr = 0.5*(fS01+fS10);
+        Wm4::Matrix2<double> kS
+        (
+            kU.Dot(kDNormal*kU), fSAvr,
+            fSAvr, kV.Dot(kDNormal*kV)
+        );
+
+        // compute the eigenvalues of S (min and max curvatures)
+        double fTrace = kS[0][0] + kS[1][1];
+        double fDet = kS[0][0]*kS[1][1] - kS[0][1]*kS[1][0];
+        double fDiscr = fTrace*fTrace - 4.0*fDet;
+        double fRootDiscr = Wm4::Math<double>::Sqrt(Wm4::Math<double>::FAbs(fDiscr));
+        double fMinCurvature = 0.5*(fTrace - fRootDiscr);
+        double fMaxCurvature = 0.5*(fTrace + fRootDiscr);
+
+        // compute the eigenvectors of S
+        auto direction = [&](double fCurvature) {
+            Wm4::Vector2<double> kW0(kS[0][1], fCurvature-kS[0][0]);
+            Wm4::Vector2<double> kW1(fCurvature-kS[1][1], kS[1][0]);
+            Vector3d kDir;
+            if (kW0.SquaredLength() >= kW1.SquaredLength()) {
+                kW0.Normalize();
+                kDir = kW0.X()*kU + kW0.Y()*kV;
+            }
+            else {
+                kW1.Normalize();
+                kDir = kW1.X()*kU + kW1.Y()*kV;
+            }
+            return Base::Vector3f((float)kDir.X(), (float)kDir.Y(), (float)kDir.Z());
+        };
+
+        CurvatureInfo& ci = myCurvature[i];
+        ci.cMaxCurvDir = direction(fMaxCurvature);
+        ci.cMinCurvDir = direction(fMinCurvature);
+        ci.fMaxCurvature = (float)fMaxCurvature;
+        ci.fMinCurvature = (float)fMinCurvature;
+    });
 }
 #endif // OPTIMIZE_CURVATURE
 
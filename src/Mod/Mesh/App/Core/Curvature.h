@@ -56,14 +56,19 @@ class MeshExport MeshCurvature
 public:
     MeshCurvature(const MeshKernel& kernel);
     MeshCurvature(const MeshKernel& kernel, const std::vector<unsigned long>& segm);
+    /** Uses the given point-to-facets adjacency of \a kernel instead of
+     * building a new one for each computation. */
+    void SetPointToFacets(const MeshRefPointToFacets* search) { mySearch = search; }
     float GetRadius() const { return myRadius; }
     void SetRadius(float r) { myRadius = r; }
     void ComputePerFace(bool parallel);
+    /** Computes the curvature per vertex. The vertices are processed in parallel. */
     void ComputePerVertex();
     const std::vector<CurvatureInfo>& GetCurvature() const { return myCurvature; }
 
 private:
     const MeshKernel& myKernel;
+    const MeshRefPointToFacets* mySearch;
     unsigned long myMinPoints;
     float myRadius;
     std::vector<unsigned long> mySegment;
@@ -23,16 +23,24 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <climits>
+# include <limits>
 #endif
 
 #include "Decimation.h"
 #include "MeshKernel.h"
 #include "Algorithm.h"
+#include "Builder.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "TopoAlgorithm.h"
 #include <Base/Tools.h>
 #include "Simplify.h"
 
+#include <QThread>
+#include <QtConcurrentMap>
+
 
 using namespace MeshCore;
 
@@ -150,3 +158,147 @@ void MeshSimplify::simplify(int targetSize)
 
     myKernel.Adopt(new_points, new_facets, true);
 }
+
+void MeshSimplify::simplifyParallel(int targetSize)
+{
+    const MeshPointArray& points = myKernel.GetPoints();
+    const MeshFacetArray& facets = myKernel.GetFacets();
+
+    // below this size the partitioning doesn't pay off
+    const std::size_t minFacetsPerPart = 50000;
+    std::size_t numParts = static_cast<std::size_t>(std::max(1, QThread::idealThreadCount()));
+    numParts = std::min(numParts, facets.size() / minFacetsPerPart);
+    if (numParts < 2 || targetSize <= 0 || static_cast<std::size_t>(targetSize) >= facets.size()) {
+        simplify(targetSize);
+        return;
+    }
+
+    // split the mesh into slabs of equal facet count along the longest axis
+    const Base::BoundBox3f& bbox = myKernel.GetBoundBox();
+    int axis = 0;
+    if (bbox.LengthY() > bbox.LengthX() && bbox.LengthY() >= bbox.LengthZ())
+        axis = 1;
+    else if (bbox.LengthZ() > bbox.LengthX() && bbox.LengthZ() > bbox.LengthY())
+        axis = 2;
+
+    std::vector<std::pair<float, unsigned long> > order(facets.size());
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        float key = 0.0f;
+        for (int j = 0; j < 3; j++) {
+            const MeshPoint& p = points[facets[i]._aulPoints[j]];
+            key += axis == 0 ? p.x : axis == 1 ? p.y : p.z;
+        }
+        order[i] = std::make_pair(key, static_cast<unsigned long>(i));
+    }
+    MeshCore::parallel_sort(order.begin(), order.end(),
+                            std::less<std::pair<float, unsigned long> >(),
+                            static_cast<int>(numParts));
+
+    std::vector<std::size_t> facetPart(facets.size());
+    std::size_t partSize = (facets.size() + numParts - 1) / numParts;
+    for (std::size_t i = 0; i < order.size(); i++)
+        facetPart[order[i].second] = i / partSize;
+
+    // points shared by several parts are locked, so that the parts still fit together
+    const std::size_t noPart = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> pointPart(points.size(), noPart);
+    std::vector<bool> locked(points.size(), false);
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        for (int j = 0; j < 3; j++) {
+            unsigned long index = facets[i]._aulPoints[j];
+            if (pointPart[index] == noPart)
+                pointPart[index] = facetPart[i];
+            else if (pointPart[index] != facetPart[i])
+                locked[index] = true;
+        }
+    }
+
+    struct Part {
+        Simplify alg;
+        int target = 0;
+    };
+    std::vector<Part> parts(numParts);
+    std::vector<int> localIndex(points.size(), -1);
+    for (std::size_t k = 0; k < numParts; k++) {
+        Part& part = parts[k];
+        std::size_t first = k * partSize;
+        std::size_t last = std::min(first + partSize, order.size());
+        for (std::size_t i = first; i < last; i++) {
+            const MeshFacet& face = facets[order[i].second];
+            Simplify::Triangle t;
+            for (int j = 0; j < 4; j++)
+                t.err[j] = 0.0;
+            for (int j = 0; j < 3; j++) {
+                unsigned long index = face._aulPoints[j];
+                if (localIndex[index] < 0) {
+                    Simplify::Vertex v;
+                    v.tstart = 0;
+                    v.p = points[index];
+                    v.locked = locked[index] ? 1 : 0;
+                    localIndex[index] = static_cast<int>(part.alg.vertices.size());
+                    part.alg.vertices.push_back(v);
+                }
+                t.v[j] = localIndex[index];
+            }
+            part.alg.triangles.push_back(t);
+        }
+
+        // reset the mapping for the next part
+        for (std::size_t i = first; i < last; i++) {
+            const MeshFacet& face = facets[order[i].second];
+            for (int j = 0; j < 3; j++)
+                localIndex[face._aulPoints[j]] = -1;
+        }
+
+        part.target = static_cast<int>(static_cast<double>(last - first) * targetSize / facets.size());
+    }
+    order.clear();
+
+    QtConcurrent::blockingMap(parts, [](Part& part) {
+        part.alg.simplify_mesh(part.target, FLT_MAX);
+    });
+
+    // merge the parts, the locked points are welded again by their identical position
+    MeshFastBuilder builder(myKernel);
+    std::size_t numFacets = 0;
+    for (const auto& part : parts)
+        numFacets += part.alg.triangles.size();
+    builder.Initialize(static_cast<MeshFastBuilder::size_type>(numFacets));
+    for (auto& part : parts) {
+        Simplify& alg = part.alg;
+        for (std::size_t i = 0; i < alg.triangles.size(); i++) {
+            const Simplify::Triangle& t = alg.triangles[i];
+            if (t.deleted)
+                continue;
+            Base::Vector3f facetPoints[3];
+            for (int j = 0; j < 3; j++)
+                facetPoints[j] = alg.vertices[t.v[j]].p;
+            builder.AddFacet(facetPoints);
+        }
+        alg.triangles.clear();
+        alg.vertices.clear();
+        alg.refs.clear();
+    }
+    parts.clear();
+    builder.Finish();
+
+    // the locked points keep the parts from reaching the target, so do a final
+    // pass over the whole mesh which also decimates the seams
+    if (myKernel.CountFacets() > static_cast<unsigned long>(targetSize))
+        simplify(targetSize);
+}
+
+void MeshSimplify::simplifyToMemory(std::size_t maxBytes, bool parallel)
+{
+    // A closed mesh has about twice as many facets as points
+    std::size_t bytesPerFacet = sizeof(MeshFacet) + sizeof(MeshPoint) / 2;
+    std::size_t targetSize = maxBytes / bytesPerFacet;
+    if (targetSize >= myKernel.CountFacets())
+        return;
+
+    int target = static_cast<int>(std::min<std::size_t>(targetSize, INT_MAX));
+    if (parallel)
+        simplifyParallel(target);
+    else
+        simplify(target);
+}
@@ -24,6 +24,8 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
+#include <cstddef>
+
 
 namespace MeshCore
 {
@@ -36,6 +38,16 @@ public:
     ~MeshSimplify();
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /** Does the same as simplify(int) but splits the mesh into spatial parts that
+     * are decimated in parallel. The points on the borders between the parts
+     * are kept, and a final pass over the whole mesh also decimates the seams.
+     * For small meshes this falls back to simplify(int).
+     */
+    void simplifyParallel(int targetSize);
+    /** Decimates the mesh so that its points and facets need roughly not more
+     * than \a maxBytes of memory.
+     */
+    void simplifyToMemory(std::size_t maxBytes, bool parallel = true);
 
 private:
     MeshKernel& myKernel;
@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <numeric>
 # include <vector>
 #endif
 
@@ -42,8 +43,16 @@
 #include "Functional.h"
 #include <Base/Matrix.h>
 
+#include <Base/FutureWatcherProgress.h>
 #include <Base/Sequencer.h>
 
+#include <atomic>
+#include <functional>
+#include <QEventLoop>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrentMap>
+
 using namespace MeshCore;
 
 
@@ -331,6 +340,51 @@ struct Edge_Less
     }
 };
 
+/**
+ * Sorts the edges by their point indices. This is done with a counting sort over
+ * the lower point index followed by sorting each bucket, which typically holds only
+ * a few edges, by the higher point index. This is much faster than a comparison
+ * sort of the whole array.
+ */
+static void sortEdges(std::vector<Edge_Index>& edges)
+{
+    unsigned long maxIndex = 0;
+    for (std::vector<Edge_Index>::const_iterator it = edges.begin(); it != edges.end(); ++it)
+        maxIndex = std::max<unsigned long>(maxIndex, it->p0);
+
+    // for invalid point indices the buckets would waste too much memory
+    if (edges.empty() || maxIndex > edges.size()) {
+        int threads = std::max(1, QThread::idealThreadCount());
+        MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
+        return;
+    }
+
+    std::vector<std::size_t> offsets(maxIndex + 2, 0);
+    for (std::vector<Edge_Index>::const_iterator it = edges.begin(); it != edges.end(); ++it)
+        offsets[it->p0 + 1]++;
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<Edge_Index> sorted(edges.size());
+    std::vector<std::size_t> insert(offsets.begin(), offsets.end() - 1);
+    for (std::vector<Edge_Index>::const_iterator it = edges.begin(); it != edges.end(); ++it)
+        sorted[insert[it->p0]++] = *it;
+    std::vector<std::size_t>().swap(insert);
+
+    std::vector<std::pair<unsigned long, unsigned long> > blocks;
+    const unsigned long blockSize = 0x10000;
+    for (unsigned long i = 0; i <= maxIndex; i += blockSize)
+        blocks.emplace_back(i, std::min<unsigned long>(i + blockSize, maxIndex + 1));
+
+    QtConcurrent::blockingMap(blocks, [&sorted, &offsets](const std::pair<unsigned long, unsigned long>& block) {
+        for (unsigned long i = block.first; i < block.second; i++) {
+            if (offsets[i + 1] - offsets[i] > 1)
+                std::sort(sorted.begin() + offsets[i], sorted.begin() + offsets[i + 1], Edge_Less());
+        }
+    });
+
+    edges.swap(sorted);
+}
+
 }
 
 bool MeshEvalTopology::Evaluate ()
@@ -357,7 +411,7 @@ bool MeshEvalTopology::Evaluate ()
     }
 
     // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    sortEdges(edges);
 
     // search for non-manifold edges
     unsigned long p0 = ULONG_MAX, p1 = ULONG_MAX;
@@ -595,74 +649,7 @@ bool MeshFixSingleFacet::Fixup ()
 
 bool MeshEvalSelfIntersection::Evaluate ()
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<unsigned long> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.size()==0)
-            continue;
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
-                    }
-                }
-            }
-        }
-    }
-
-    return true;
+    return !CheckIntersections(nullptr);
 }
 
 void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsigned long, unsigned long> >& indices,
@@ -691,41 +678,52 @@ void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsi
 
 void MeshEvalSelfIntersection::GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >& intersection) const
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
-    //intersection.clear();
+    CheckIntersections(&intersection);
+}
+
+bool MeshEvalSelfIntersection::CheckIntersections(std::vector<std::pair<unsigned long, unsigned long> >* intersection) const
+{
+    typedef std::vector<std::pair<unsigned long, unsigned long> > PairList;
 
     // Splits the mesh using grid for speeding up the calculation
     MeshFacetGrid cMeshFacetGrid(_rclMesh);
     const MeshFacetArray& rFaces = _rclMesh.GetFacets();
     MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
 
+    // Contains bounding boxes for every facet 
+    std::vector<Base::BoundBox3f> boxes;
+    boxes.reserve(_rclMesh.CountFacets());
     MeshFacetIterator cMFI(_rclMesh);
-    for(cMFI.Begin(); cMFI.More(); cMFI.Next()) {
+    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
         boxes.push_back((*cMFI).GetBoundBox());
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
+    // Only grid elements with at least two facets need to be checked
+    std::vector<std::vector<unsigned long> > cells;
     for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
         std::vector<unsigned long> aulGridElements;
         clGridIter.GetElements(aulGridElements);
+        if (aulGridElements.size() > 1)
+            cells.push_back(std::move(aulGridElements));
+    }
 
-        seq.next(true);
-        if (aulGridElements.size()==0)
-            continue;
+    // When only checking for any self-intersection all threads stop after the first hit
+    std::atomic<bool> found(false);
+    bool stopAtFirst = (intersection == nullptr);
+    const MeshKernel& rMesh = _rclMesh;
 
+    // Calculates the intersections of all facets of a grid element
+    auto checkCell = [&](const std::vector<unsigned long>& aulGridElements) {
+        PairList pairs;
         MeshGeomFacet facet1, facet2;
         Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
+        for (std::vector<unsigned long>::const_iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
+            if (stopAtFirst && found)
+                break;
             const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
+            facet1 = rMesh.GetFacet(*it);
             const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
+            for (std::vector<unsigned long>::const_iterator jt = it; jt != aulGridElements.end(); ++jt) {
                 if (jt == it) // the identical facet
                     continue;
                 // If the facets share a common vertex we do not check for self-intersections because they 
@@ -747,16 +745,40 @@ void MeshEvalSelfIntersection::GetIntersections(std::vector<std::pair<unsigned l
 
                 const Base::BoundBox3f& box2 = boxes[*jt];
                 if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
+                    facet2 = rMesh.GetFacet(*jt);
                     int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
                     if (ret == 2) {
-                        intersection.emplace_back (*it,*jt);
+                        found = true;
+                        if (stopAtFirst)
+                            return pairs;
+                        pairs.emplace_back(*it, *jt);
                     }
                 }
             }
         }
+        return pairs;
+    };
+
+    QFuture<PairList> future = QtConcurrent::mapped(cells,
+        std::function<PairList(const std::vector<unsigned long>&)>(checkCell));
+    Base::FutureWatcherProgress progress("Checking for self-intersections...", cells.size());
+    QFutureWatcher<PairList> watcher;
+    QObject::connect(&watcher, SIGNAL(progressValueChanged(int)),
+                     &progress, SLOT(progressValueChanged(int)));
+
+    // keep it responsive during computation
+    QEventLoop loop;
+    QObject::connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
+    watcher.setFuture(future);
+    loop.exec();
+
+    if (intersection) {
+        // keep the order of the grid elements
+        for (QFuture<PairList>::const_iterator it = future.begin(); it != future.end(); ++it)
+            intersection->insert(intersection->end(), it->begin(), it->end());
     }
+
+    return found;
 }
 
 std::vector<unsigned long> MeshFixSelfIntersection::GetFacets() const
@@ -829,7 +851,7 @@ bool MeshEvalNeighbourhood::Evaluate ()
     }
 
     // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    sortEdges(edges);
 
     unsigned long p0 = ULONG_MAX, p1 = ULONG_MAX;
     unsigned long f0 = ULONG_MAX, f1 = ULONG_MAX;
@@ -895,7 +917,7 @@ std::vector<unsigned long> MeshEvalNeighbourhood::GetIndices() const
     }
 
     // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    sortEdges(edges);
 
     unsigned long p0 = ULONG_MAX, p1 = ULONG_MAX;
     unsigned long f0 = ULONG_MAX, f1 = ULONG_MAX;
@@ -969,9 +991,7 @@ void MeshKernel::RebuildNeighbours (unsigned long index)
     }
 
     // sort the edges
-    //std::sort(edges.begin(), edges.end(), Edge_Less());
-    int threads = std::max(1, QThread::idealThreadCount());
-    MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
+    sortEdges(edges);
 
     unsigned long p0 = ULONG_MAX, p1 = ULONG_MAX;
     unsigned long f0 = ULONG_MAX, f1 = ULONG_MAX;
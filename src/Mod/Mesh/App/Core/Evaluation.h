@@ -297,6 +297,13 @@ public:
         std::vector<std::pair<Base::Vector3f, Base::Vector3f> >&) const;
     /// collect the index of all facets with self intersections
     void GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >&) const;
+
+private:
+    /** Checks the facets of all grid elements in parallel. If \a intersection is null
+     * the check stops at the first self-intersection.
+     * @return true if a self-intersection was found.
+     */
+    bool CheckIntersections(std::vector<std::pair<unsigned long, unsigned long> >* intersection) const;
 };
 
 /**
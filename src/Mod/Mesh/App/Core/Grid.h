@@ -24,7 +24,9 @@
 #ifndef MESH_GRID_H
 #define MESH_GRID_H
 
+#include <algorithm>
 #include <set>
+#include <vector>
 
 #include "MeshKernel.h"
 #include <Base/Vector3D.h>
@@ -41,6 +43,44 @@ class MeshKernel;
 class MeshGeomFacet;
 class MeshGrid;
 
+/**
+ * The MeshGridCell holds the sorted indices of the elements of a grid element.
+ * It replaces a std::set to save the memory of a tree node per index. As the
+ * grids are built by iterating over the elements, indices arrive in increasing
+ * order and inserting is a push_back in nearly all cases.
+ */
+class MeshGridCell
+{
+public:
+  typedef std::vector<unsigned long>::const_iterator const_iterator;
+  typedef const_iterator iterator;
+
+  void insert (unsigned long ulIndex)
+  {
+    if (_indices.empty() || _indices.back() < ulIndex) {
+      _indices.push_back(ulIndex);
+    }
+    else {
+      std::vector<unsigned long>::iterator it = std::lower_bound(_indices.begin(), _indices.end(), ulIndex);
+      if (*it != ulIndex)
+        _indices.insert(it, ulIndex);
+    }
+  }
+  std::size_t size (void) const
+  { return _indices.size(); }
+  bool empty (void) const
+  { return _indices.empty(); }
+  void clear (void)
+  { _indices.clear(); }
+  const_iterator begin (void) const
+  { return _indices.begin(); }
+  const_iterator end (void) const
+  { return _indices.end(); }
+
+private:
+  std::vector<unsigned long> _indices;
+};
+
 //#define MESHGRID_BBOX_EXTENSION 1.0e-3f
 #define MESHGRID_BBOX_EXTENSION 10.0f
 
@@ -157,7 +197,7 @@ protected:
   virtual unsigned long HasElements (void) const = 0;
 
 protected:
-  std::vector<std::vector<std::vector<std::set<unsigned long> > > >  _aulGrid;   /**< Grid data structure. */
+  std::vector<std::vector<std::vector<MeshGridCell> > >  _aulGrid;   /**< Grid data structure. */
   const MeshKernel* _pclMesh;     /**< The mesh kernel. */
   unsigned long     _ulCtElements;/**< Number of grid elements for validation issues. */
   unsigned long     _ulCtGridsX;  /**< Number of grid elements in z. */
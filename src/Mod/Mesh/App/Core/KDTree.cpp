@@ -29,57 +29,345 @@
 #endif
 
 #include "KDTree.h"
-#include <kdtree++/kdtree.hpp>
+#include <Base/ThreadPool.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
 
 using namespace MeshCore;
 
-struct Point3d 
+MeshPointKDTree::MeshPointKDTree()
 {
-   typedef float value_type;
+}
 
-   Point3d(const Base::Vector3f& f, unsigned long i) : p(f), i(i)
-   {
-   }
+MeshPointKDTree::MeshPointKDTree(const std::vector<Base::Vector3f>& points)
+{
+    Build(points.data(), points.size());
+}
 
-   Point3d(const Point3d& pnt) : p(pnt.p), i(pnt.i)
-   {
-   }
+MeshPointKDTree::MeshPointKDTree(const MeshPointArray& points)
+{
+    Build(points);
+}
 
-   ~Point3d()
-   {
-   }
+void MeshPointKDTree::Build(const Base::Vector3f* points, std::size_t count)
+{
+    nodes.resize(count);
+    Base::parallel_for(std::size_t(0), count, [&](std::size_t i) {
+        nodes[i].point = points[i];
+        nodes[i].axis = 0;
+        nodes[i].index = static_cast<unsigned long>(i);
+    });
+    build(0, count);
+}
 
-   inline value_type operator[](const int N) const
-   {
-       return p[N];
-   }
+void MeshPointKDTree::Build(const MeshPointArray& points)
+{
+    nodes.resize(points.size());
+    Base::parallel_for(std::size_t(0), points.size(), [&](std::size_t i) {
+        nodes[i].point = points[i];
+        nodes[i].axis = 0;
+        nodes[i].index = static_cast<unsigned long>(i);
+    });
+    build(0, points.size());
+}
 
-   inline bool operator==(const Point3d& other) const
-   {
-      return (this->p) == (other.p);
-   }
+void MeshPointKDTree::build(std::size_t begin, std::size_t end)
+{
+    if (end - begin < 2)
+        return;
 
-   inline bool operator!=(const Point3d& other) const
-   {
-      return (this->p) != (other.p);
-   }
+    // split along the axis with the largest extent
+    Base::BoundBox3f box;
+    for (std::size_t i = begin; i < end; ++i)
+        box.Add(nodes[i].point);
+    int axis = 0;
+    if (box.LengthY() > box.LengthX())
+        axis = 1;
+    if (box.LengthZ() > std::max(box.LengthX(), box.LengthY()))
+        axis = 2;
 
-   inline void operator=(const Point3d& other)
-   {
-       this->p = other.p;
-       this->i = other.i;
-   }
+    std::size_t mid = begin + (end - begin) / 2;
+    std::nth_element(nodes.begin() + begin, nodes.begin() + mid, nodes.begin() + end,
+                     [axis](const Node& a, const Node& b) {
+        return a.point[axis] < b.point[axis];
+    });
+    nodes[mid].axis = axis;
 
-   Base::Vector3f p;
-   unsigned long i;
-};
+    // the subtrees are independent of each other
+    if (end - begin > 10000) {
+        Base::TaskGroup group;
+        group.run([this, begin, mid]() { build(begin, mid); });
+        build(mid + 1, end);
+        group.wait();
+    }
+    else {
+        build(begin, mid);
+        build(mid + 1, end);
+    }
+}
+
+bool MeshPointKDTree::IsEmpty() const
+{
+    return nodes.empty();
+}
+
+std::size_t MeshPointKDTree::Size() const
+{
+    return nodes.size();
+}
+
+void MeshPointKDTree::Clear()
+{
+    std::vector<Node>().swap(nodes);
+}
 
-typedef KDTree::KDTree<3, Point3d> MyKDTree;
+void MeshPointKDTree::nearest(std::size_t begin, std::size_t end, const Base::Vector3f& p,
+                              float& best, std::size_t& node) const
+{
+    while (begin < end) {
+        std::size_t mid = begin + (end - begin) / 2;
+        const Node& n = nodes[mid];
+        float dist = Base::DistanceP2(p, n.point);
+        if (dist < best || (dist == best && node == nodes.size())) {
+            best = dist;
+            node = mid;
+        }
+
+        // search the side of the query point first
+        float diff = p[n.axis] - n.point[n.axis];
+        if (diff < 0.0f) {
+            nearest(begin, mid, p, best, node);
+            begin = mid + 1;
+        }
+        else {
+            nearest(mid + 1, end, p, best, node);
+            end = mid;
+        }
+        if (diff * diff > best)
+            break;
+    }
+}
+
+void MeshPointKDTree::nearest(std::size_t begin, std::size_t end, const Base::Vector3f& p, std::size_t k,
+                              std::vector<std::pair<float, unsigned long> >& heap) const
+{
+    while (begin < end) {
+        std::size_t mid = begin + (end - begin) / 2;
+        const Node& n = nodes[mid];
+        float dist = Base::DistanceP2(p, n.point);
+        if (heap.size() < k) {
+            heap.emplace_back(dist, mid);
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else if (dist < heap.front().first) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = std::make_pair(dist, static_cast<unsigned long>(mid));
+            std::push_heap(heap.begin(), heap.end());
+        }
+
+        float diff = p[n.axis] - n.point[n.axis];
+        if (diff < 0.0f) {
+            nearest(begin, mid, p, k, heap);
+            begin = mid + 1;
+        }
+        else {
+            nearest(mid + 1, end, p, k, heap);
+            end = mid;
+        }
+        if (heap.size() == k && diff * diff > heap.front().first)
+            break;
+    }
+}
+
+std::size_t MeshPointKDTree::exact(std::size_t begin, std::size_t end, const Base::Vector3f& p) const
+{
+    // Base::Vector3f::operator== has a tolerance, so points close to the
+    // splitting plane can be on both sides
+    const float eps = Base::Vector3f::epsilon();
+    while (begin < end) {
+        std::size_t mid = begin + (end - begin) / 2;
+        const Node& n = nodes[mid];
+        if (n.point == p)
+            return mid;
+
+        float diff = p[n.axis] - n.point[n.axis];
+        if (diff < -eps) {
+            end = mid;
+        }
+        else if (diff > eps) {
+            begin = mid + 1;
+        }
+        else {
+            std::size_t found = exact(begin, mid, p);
+            if (found != nodes.size())
+                return found;
+            begin = mid + 1;
+        }
+    }
+    return nodes.size();
+}
+
+template <typename Inside>
+void MeshPointKDTree::inRange(std::size_t begin, std::size_t end, const Base::Vector3f& p, float range,
+                              Inside inside, std::vector<unsigned long>& indices) const
+{
+    while (begin < end) {
+        std::size_t mid = begin + (end - begin) / 2;
+        const Node& n = nodes[mid];
+        if (inside(n.point))
+            indices.push_back(n.index);
+
+        float value = n.point[n.axis];
+        bool left = p[n.axis] - range <= value;
+        bool right = p[n.axis] + range >= value;
+        if (left && right) {
+            inRange(begin, mid, p, range, inside, indices);
+            begin = mid + 1;
+        }
+        else if (left) {
+            end = mid;
+        }
+        else if (right) {
+            begin = mid + 1;
+        }
+        else {
+            break;
+        }
+    }
+}
+
+unsigned long MeshPointKDTree::FindNearest(const Base::Vector3f& p, float max_dist,
+                                           Base::Vector3f& n, float& dist) const
+{
+    if (max_dist < 0.0f)
+        return ULONG_MAX;
+
+    float best = max_dist < std::numeric_limits<float>::max()
+               ? max_dist * max_dist : std::numeric_limits<float>::max();
+    std::size_t node = nodes.size();
+    nearest(0, nodes.size(), p, best, node);
+    if (node == nodes.size())
+        return ULONG_MAX;
+    n = nodes[node].point;
+    dist = std::sqrt(best);
+    return nodes[node].index;
+}
+
+void MeshPointKDTree::FindNearest(const Base::Vector3f& p, std::size_t k, std::vector<unsigned long>& indices) const
+{
+    indices.clear();
+    if (k == 0)
+        return;
+
+    std::vector<std::pair<float, unsigned long> > heap;
+    heap.reserve(std::min(k, nodes.size()));
+    nearest(0, nodes.size(), p, k, heap);
+    std::sort_heap(heap.begin(), heap.end());
+    indices.reserve(heap.size());
+    for (const auto& it : heap)
+        indices.push_back(nodes[it.second].index);
+}
+
+unsigned long MeshPointKDTree::FindExact(const Base::Vector3f& p) const
+{
+    std::size_t node = exact(0, nodes.size(), p);
+    if (node == nodes.size())
+        return ULONG_MAX;
+    return nodes[node].index;
+}
+
+void MeshPointKDTree::FindInRadius(const Base::Vector3f& p, float radius, std::vector<unsigned long>& indices) const
+{
+    float radius2 = radius * radius;
+    inRange(0, nodes.size(), p, radius, [&p, radius2](const Base::Vector3f& v) {
+        return Base::DistanceP2(p, v) <= radius2;
+    }, indices);
+}
+
+void MeshPointKDTree::FindInBox(const Base::Vector3f& p, float range, std::vector<unsigned long>& indices) const
+{
+    inRange(0, nodes.size(), p, range, [&p, range](const Base::Vector3f& v) {
+        return std::fabs(v.x - p.x) <= range &&
+               std::fabs(v.y - p.y) <= range &&
+               std::fabs(v.z - p.z) <= range;
+    }, indices);
+}
+
+void MeshPointKDTree::FindNearest(const std::vector<Base::Vector3f>& points, float max_dist,
+                                  std::vector<unsigned long>& indices) const
+{
+    indices.resize(points.size());
+    Base::parallel_for(std::size_t(0), points.size(), [&](std::size_t i) {
+        Base::Vector3f n;
+        float dist;
+        indices[i] = FindNearest(points[i], max_dist, n, dist);
+    });
+}
+
+void MeshPointKDTree::FindNearest(const std::vector<Base::Vector3f>& points, std::size_t k,
+                                  std::vector<std::vector<unsigned long> >& indices) const
+{
+    indices.resize(points.size());
+    Base::parallel_for(std::size_t(0), points.size(), [&](std::size_t i) {
+        FindNearest(points[i], k, indices[i]);
+    });
+}
+
+void MeshPointKDTree::FindExact(const std::vector<Base::Vector3f>& points, std::vector<unsigned long>& indices) const
+{
+    indices.resize(points.size());
+    Base::parallel_for(std::size_t(0), points.size(), [&](std::size_t i) {
+        indices[i] = FindExact(points[i]);
+    });
+}
+
+void MeshPointKDTree::FindInRadius(const std::vector<Base::Vector3f>& points, float radius,
+                                   std::vector<std::vector<unsigned long> >& indices) const
+{
+    indices.resize(points.size());
+    Base::parallel_for(std::size_t(0), points.size(), [&](std::size_t i) {
+        indices[i].clear();
+        FindInRadius(points[i], radius, indices[i]);
+    });
+}
+
+// ----------------------------------------------------------------------------
 
 class MeshKDTree::Private
 {
 public:
-    MyKDTree kd_tree;
+    Private() : dirty(false)
+    {
+    }
+
+    const MeshPointKDTree& getTree()
+    {
+        if (dirty.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (dirty.load(std::memory_order_relaxed)) {
+                kd_tree.Build(points.data(), points.size());
+                dirty.store(false, std::memory_order_release);
+            }
+        }
+        return kd_tree;
+    }
+
+    template <typename Points>
+    void addPoints(const Points& pts)
+    {
+        points.reserve(points.size() + pts.size());
+        for (typename Points::const_iterator it = pts.begin(); it != pts.end(); ++it)
+            points.push_back(*it);
+        dirty = true;
+    }
+
+    std::vector<Base::Vector3f> points;
+    MeshPointKDTree kd_tree;
+    std::atomic<bool> dirty;
+    std::mutex mutex;
 };
 
 MeshKDTree::MeshKDTree() : d(new Private)
@@ -88,18 +376,14 @@ MeshKDTree::MeshKDTree() : d(new Private)
 
 MeshKDTree::MeshKDTree(const std::vector<Base::Vector3f>& points) : d(new Private)
 {
-    unsigned long index=0;
-    for (std::vector<Base::Vector3f>::const_iterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
-    }
+    d->addPoints(points);
+    d->getTree();
 }
 
 MeshKDTree::MeshKDTree(const MeshPointArray& points) : d(new Private)
 {
-    unsigned long index=0;
-    for (MeshPointArray::_TConstIterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
-    }
+    d->addPoints(points);
+    d->getTree();
 }
 
 MeshKDTree::~MeshKDTree()
@@ -109,81 +393,59 @@ MeshKDTree::~MeshKDTree()
 
 void MeshKDTree::AddPoint(Base::Vector3f& point)
 {
-    unsigned long index=d->kd_tree.size();
-    d->kd_tree.insert(Point3d(point, index));
+    d->points.push_back(point);
+    d->dirty = true;
 }
 
 void MeshKDTree::AddPoints(const std::vector<Base::Vector3f>& points)
 {
-    unsigned long index=d->kd_tree.size();
-    for (std::vector<Base::Vector3f>::const_iterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
-    }
+    d->addPoints(points);
 }
 
 void MeshKDTree::AddPoints(const MeshPointArray& points)
 {
-    unsigned long index=d->kd_tree.size();
-    for (MeshPointArray::_TConstIterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
-    }
+    d->addPoints(points);
 }
 
 bool MeshKDTree::IsEmpty() const
 {
-    return d->kd_tree.empty();
+    return d->points.empty();
 }
 
 void MeshKDTree::Clear()
 {
-    d->kd_tree.clear();
+    d->points.clear();
+    d->kd_tree.Clear();
+    d->dirty = false;
 }
 
 void MeshKDTree::Optimize()
 {
-    d->kd_tree.optimize();
+    d->getTree();
 }
 
 unsigned long MeshKDTree::FindNearest(const Base::Vector3f& p, Base::Vector3f& n, float& dist) const
 {
-    std::pair<MyKDTree::const_iterator, MyKDTree::distance_type> it =
-        d->kd_tree.find_nearest(Point3d(p,0));
-    if (it.first == d->kd_tree.end())
-        return ULONG_MAX;
-    unsigned long index = it.first->i;
-    n = it.first->p;
-    dist = it.second;
-    return index;
+    return d->getTree().FindNearest(p, std::numeric_limits<float>::max(), n, dist);
 }
 
 unsigned long MeshKDTree::FindNearest(const Base::Vector3f& p, float max_dist,
                                       Base::Vector3f& n, float& dist) const
 {
-    std::pair<MyKDTree::const_iterator, MyKDTree::distance_type> it =
-        d->kd_tree.find_nearest(Point3d(p,0), max_dist);
-    if (it.first == d->kd_tree.end())
-        return ULONG_MAX;
-    unsigned long index = it.first->i;
-    n = it.first->p;
-    dist = it.second;
-    return index;
+    return d->getTree().FindNearest(p, max_dist, n, dist);
 }
 
 unsigned long MeshKDTree::FindExact(const Base::Vector3f& p) const
 {
-    MyKDTree::const_iterator it = 
-        d->kd_tree.find_exact(Point3d(p,0));
-    if (it == d->kd_tree.end())
-        return ULONG_MAX;
-    unsigned long index = it->i;
-    return index;
+    return d->getTree().FindExact(p);
 }
 
 void MeshKDTree::FindInRange(const Base::Vector3f& p, float range, std::vector<unsigned long>& indices) const
 {
-    std::vector<Point3d> v;
-    d->kd_tree.find_within_range(Point3d(p,0), range, std::back_inserter(v));
-    indices.reserve(v.size());
-    for (std::vector<Point3d>::iterator it = v.begin(); it != v.end(); ++it)
-        indices.push_back(it->i);
+    d->getTree().FindInBox(p, range, indices);
+}
+
+const MeshPointKDTree& MeshKDTree::GetTree() const
+{
+    return d->getTree();
 }
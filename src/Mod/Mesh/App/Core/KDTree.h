@@ -29,6 +29,90 @@
 namespace MeshCore
 {
 
+/**
+ * \brief The MeshPointKDTree class is a static kd-tree over a set of points.
+ *
+ * The tree is built at once from all points and stored in a single array: the
+ * node of a range is the median at the middle of the range, the left subtree is
+ * in front of it and the right subtree behind it. So, there are no child links
+ * and neighbouring nodes are close in memory. The tree is built on the thread
+ * pool.
+ *
+ * All queries are read-only and can be done from several threads at a time.
+ * The batched versions distribute the query points over the thread pool.
+ * The returned indices refer to the order of the points passed to Build().
+ */
+class MeshExport MeshPointKDTree
+{
+public:
+    MeshPointKDTree();
+    MeshPointKDTree(const std::vector<Base::Vector3f>& points);
+    MeshPointKDTree(const MeshPointArray& points);
+
+    /** Builds the tree from \a count points, existing points are removed. */
+    void Build(const Base::Vector3f* points, std::size_t count);
+    void Build(const MeshPointArray& points);
+
+    bool IsEmpty() const;
+    std::size_t Size() const;
+    void Clear();
+
+    /** Returns the index of the nearest point with a distance of at most \a max_dist,
+     * or ULONG_MAX if there is none. \a n and \a dist are set to the point and its
+     * distance.
+     */
+    unsigned long FindNearest(const Base::Vector3f& p, float max_dist,
+                              Base::Vector3f& n, float& dist) const;
+    /** Returns the indices of the \a k nearest points sorted by their distance. */
+    void FindNearest(const Base::Vector3f& p, std::size_t k, std::vector<unsigned long>& indices) const;
+    /** Returns the index of a point that is equal to \a p, or ULONG_MAX. */
+    unsigned long FindExact(const Base::Vector3f& p) const;
+    /** Returns the indices of all points inside the sphere around \a p. */
+    void FindInRadius(const Base::Vector3f& p, float radius, std::vector<unsigned long>& indices) const;
+    /** Returns the indices of all points inside the axis-aligned cube around \a p
+     * with half edge length \a range.
+     */
+    void FindInBox(const Base::Vector3f& p, float range, std::vector<unsigned long>& indices) const;
+
+    /** @name Batched queries */
+    //@{
+    void FindNearest(const std::vector<Base::Vector3f>& points, float max_dist,
+                     std::vector<unsigned long>& indices) const;
+    void FindNearest(const std::vector<Base::Vector3f>& points, std::size_t k,
+                     std::vector<std::vector<unsigned long> >& indices) const;
+    void FindExact(const std::vector<Base::Vector3f>& points, std::vector<unsigned long>& indices) const;
+    void FindInRadius(const std::vector<Base::Vector3f>& points, float radius,
+                      std::vector<std::vector<unsigned long> >& indices) const;
+    //@}
+
+private:
+    struct Node
+    {
+        Base::Vector3f point;
+        int axis;
+        unsigned long index;
+    };
+
+    void build(std::size_t begin, std::size_t end);
+    void nearest(std::size_t begin, std::size_t end, const Base::Vector3f& p,
+                 float& best, std::size_t& node) const;
+    void nearest(std::size_t begin, std::size_t end, const Base::Vector3f& p, std::size_t k,
+                 std::vector<std::pair<float, unsigned long> >& heap) const;
+    std::size_t exact(std::size_t begin, std::size_t end, const Base::Vector3f& p) const;
+    template <typename Inside>
+    void inRange(std::size_t begin, std::size_t end, const Base::Vector3f& p, float range,
+                 Inside inside, std::vector<unsigned long>& indices) const;
+
+private:
+    std::vector<Node> nodes;
+};
+
+/**
+ * \brief The MeshKDTree class allows to add points incrementally.
+ *
+ * It keeps the added points and (re-)builds a MeshPointKDTree on the first
+ * query after points were added. Queries can be done from several threads.
+ */
 class MeshExport MeshKDTree
 {
 public:
@@ -51,6 +135,9 @@ public:
     unsigned long FindExact(const Base::Vector3f& p) const;
     void FindInRange(const Base::Vector3f&, float, std::vector<unsigned long>&) const;
 
+    /// Returns the built tree for batched queries
+    const MeshPointKDTree& GetTree() const;
+
 private:
     class Private;
     Private* d;
@@ -39,10 +39,15 @@
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
 #include <Base/Placement.h>
+#include <Base/ThreadPool.h>
 #include <Base/Tools.h>
 #include <zipios++/gzipoutputstream.h>
+#include <QFile>
+#include <QtConcurrentMap>
 
+#include <atomic>
 #include <cmath>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -151,6 +156,30 @@ std::vector<std::string> MeshInput::supportedMeshFormats()
     return fmt;
 }
 
+namespace MeshCore {
+
+/* Applies the same test as MeshInput::LoadSTL to a memory block */
+bool isBinarySTL(const char* data, std::size_t size)
+{
+    if (size < 84)
+        return false;
+    uint32_t ulCt, ulBytes=50;
+    memcpy(&ulCt, data + 80, sizeof(ulCt));
+    if (ulCt > 1)
+        ulBytes = 100;
+    if (size < 84 + ulBytes)
+        return false;
+
+    char szBuf[200];
+    memcpy(szBuf, data + 84, ulBytes);
+    szBuf[ulBytes] = 0;
+    upper(szBuf);
+    return (strstr(szBuf, "SOLID") == NULL)  && (strstr(szBuf, "FACET") == NULL)    && (strstr(szBuf, "NORMAL") == NULL) &&
+           (strstr(szBuf, "VERTEX") == NULL) && (strstr(szBuf, "ENDFACET") == NULL) && (strstr(szBuf, "ENDLOOP") == NULL);
+}
+
+}
+
 bool MeshInput::LoadAny(const char* FileName)
 {
     // ask for read permission
@@ -160,6 +189,24 @@ bool MeshInput::LoadAny(const char* FileName)
     if (!fi.isReadable())
         throw Base::FileException("No permission on the file",FileName);
 
+    // Parse large binary STL files directly from the mapped file
+    if (fi.hasExtension("stl") || fi.hasExtension("ast")) {
+        QFile file(QString::fromUtf8(FileName));
+        if (file.open(QIODevice::ReadOnly)) {
+            qint64 size = file.size();
+            const char* data = reinterpret_cast<const char*>(file.map(0, size));
+            if (data && isBinarySTL(data, static_cast<std::size_t>(size))) {
+                try {
+                    return LoadBinarySTL(data, static_cast<std::size_t>(size));
+                }
+                catch (const Base::MemoryException&) {
+                    _rclMesh.Clear();
+                    throw;
+                }
+            }
+        }
+    }
+
     Base::ifstream str(fi, std::ios::in | std::ios::binary);
 
     if (fi.hasExtension("bms")) {
@@ -290,43 +337,486 @@ bool MeshInput::LoadSTL (std::istream &rstrIn)
     return true;
 }
 
-/** Loads an OBJ file. */
-bool MeshInput::LoadOBJ (std::istream &rstrIn)
+// --------------------------------------------------------------
+
+namespace MeshCore {
+namespace Ascii {
+
+/* Reads the remaining content of the stream into memory at once so that large
+ * ASCII files can be parsed in parallel.
+ */
+void readRemaining(std::istream& in, std::string& buffer)
 {
-    boost::regex rx_m("^mtllib\\s+([\\x21-\\x7E]+)\\s*$");
-    boost::regex rx_u("^usemtl\\s+([\\x21-\\x7E]+)\\s*$");
-    boost::regex rx_g("^g\\s+([\\x21-\\x7E]+)\\s*$");
-    boost::regex rx_p("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::regex rx_c("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+(\\d{1,3})\\s+(\\d{1,3})\\s+(\\d{1,3})\\s*$");
-    boost::regex rx_t("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::regex rx_f3("^f\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                         "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                         "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*\\s*$");
-    boost::regex rx_f4("^f\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                         "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                         "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                         "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*\\s*$");
-    boost::cmatch what;
+    std::streambuf* buf = in.rdbuf();
+    std::streamoff pos = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+    std::streamoff end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+    if (pos >= 0 && end > pos) {
+        buffer.reserve(static_cast<std::size_t>(end - pos));
+        buf->pubseekpos(pos, std::ios::in);
+    }
+    else if (pos >= 0) {
+        buf->pubseekpos(pos, std::ios::in);
+    }
+
+    const std::size_t block = 1 << 20;
+    std::size_t size = 0;
+    for (;;) {
+        buffer.resize(size + block);
+        std::streamsize count = buf->sgetn(&buffer[size], block);
+        if (count <= 0)
+            break;
+        size += static_cast<std::size_t>(count);
+    }
+    buffer.resize(size);
+}
 
-    unsigned long segment=0;
-    MeshPointArray meshPoints;
-    MeshFacetArray meshFacets;
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
 
-    std::string line;
-    float fX, fY, fZ;
-    int  i1=1,i2=1,i3=1,i4=1;
-    MeshFacet item;
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline const char* lineEnd(const char* pos, const char* end)
+{
+    const char* eol = static_cast<const char*>(memchr(pos, '\n', end - pos));
+    return eol ? eol : end;
+}
+
+inline const char* nextLine(const char* eol, const char* end)
+{
+    return eol < end ? eol + 1 : end;
+}
+
+/* A range of complete lines of the buffer that is parsed by one task. */
+struct TextChunk
+{
+    const char* begin;
+    const char* end;
+    std::size_t lines; /**< number of lines of interest, see countLines() */
+};
+
+/* Splits the buffer at line breaks into chunks of at least 1MB. */
+std::vector<TextChunk> splitText(const char* begin, const char* end)
+{
+    std::size_t count = 4 * static_cast<std::size_t>(std::max(1, Base::ThreadPool::instance().threadCount()));
+    std::size_t size = std::max<std::size_t>(1 << 20, static_cast<std::size_t>(end - begin) / count + 1);
+
+    std::vector<TextChunk> chunks;
+    const char* pos = begin;
+    while (pos < end) {
+        const char* last = end;
+        if (static_cast<std::size_t>(end - pos) > size)
+            last = nextLine(lineEnd(pos + size, end), end);
+        chunks.push_back({pos, last, 0});
+        pos = last;
+    }
+    return chunks;
+}
+
+/* Counts the lines of each chunk in parallel for which \a counted returns true. */
+template <typename Pred>
+void countLines(std::vector<TextChunk>& chunks, Pred counted)
+{
+    Base::parallel_for(std::size_t(0), chunks.size(), [&](std::size_t i) {
+        TextChunk& chunk = chunks[i];
+        chunk.lines = 0;
+        for (const char* pos = chunk.begin; pos < chunk.end; ) {
+            const char* eol = lineEnd(pos, chunk.end);
+            if (counted(pos, eol))
+                chunk.lines++;
+            pos = nextLine(eol, chunk.end);
+        }
+    }, std::size_t(1));
+}
+
+/* Removes the chunks up to and including the \a num-th counted line from
+ * \a chunks and returns them. The counts must be up to date, see countLines().
+ */
+template <typename Pred>
+std::vector<TextChunk> takeLines(std::vector<TextChunk>& chunks, std::size_t num, Pred counted)
+{
+    std::vector<TextChunk> head;
+    std::size_t index = 0;
+    for (; index < chunks.size() && num > 0; ++index) {
+        TextChunk& chunk = chunks[index];
+        if (chunk.lines <= num) {
+            num -= chunk.lines;
+            head.push_back(chunk);
+            continue;
+        }
+
+        // split the chunk after the last requested line
+        const char* pos = chunk.begin;
+        std::size_t found = 0;
+        while (found < num) {
+            const char* eol = lineEnd(pos, chunk.end);
+            if (counted(pos, eol))
+                found++;
+            pos = nextLine(eol, chunk.end);
+        }
+        head.push_back({chunk.begin, pos, num});
+        chunk.begin = pos;
+        chunk.lines -= num;
+        num = 0;
+        break;
+    }
+    chunks.erase(chunks.begin(), chunks.begin() + index);
+    return head;
+}
+
+/* Concatenates the arrays of all chunks, copying them in parallel. */
+template <typename Array>
+void joinParts(Array& result, std::vector<Array>& parts)
+{
+    if (parts.size() == 1) {
+        result.swap(parts.front());
+        return;
+    }
+
+    std::vector<std::size_t> offsets(parts.size() + 1, 0);
+    for (std::size_t i = 0; i < parts.size(); ++i)
+        offsets[i+1] = offsets[i] + parts[i].size();
+    result.resize(offsets.back());
+    Base::parallel_for(std::size_t(0), parts.size(), [&](std::size_t i) {
+        std::copy(parts[i].begin(), parts[i].end(), result.begin() + offsets[i]);
+        Array().swap(parts[i]);
+    }, std::size_t(1));
+}
+
+/* Parses the whitespace separated tokens of a single line. The numbers are
+ * converted without the locale handling and the temporary strings of the
+ * standard stream and regex functions.
+ */
+class Scanner
+{
+public:
+    Scanner(const char* begin, const char* end)
+        : cur(begin), end(end)
+    {
+    }
+
+    const char* pos() const
+    {
+        return cur;
+    }
+
+    bool atEnd()
+    {
+        skipSpace();
+        return cur == end;
+    }
+
+    void skipSpace()
+    {
+        while (cur < end && isSpace(*cur))
+            ++cur;
+    }
+
+    /* Returns true if the current token is complete. */
+    bool tokenEnd() const
+    {
+        return cur == end || isSpace(*cur);
+    }
+
+    void skipToken()
+    {
+        while (cur < end && !isSpace(*cur))
+            ++cur;
+    }
+
+    /* Skips the keyword at the beginning of the line which must be followed by a space. */
+    bool keyword(const char* word, std::size_t len)
+    {
+        if (static_cast<std::size_t>(end - cur) <= len || memcmp(cur, word, len) != 0 || !isSpace(cur[len]))
+            return false;
+        cur += len;
+        return true;
+    }
+
+    /* Reads the last token of the line which must consist of printable ASCII characters only. */
+    bool lastWord(std::string& word)
+    {
+        skipSpace();
+        const char* start = cur;
+        while (cur < end && *cur > 0x20 && *cur < 0x7f)
+            ++cur;
+        if (start == cur || !atEnd())
+            return false;
+        word.assign(start, cur);
+        return true;
+    }
+
+    bool readInt(long& value)
+    {
+        skipSpace();
+        const char* p = cur;
+        bool neg = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            neg = *p == '-';
+            ++p;
+        }
+        if (p == end || !isDigit(*p))
+            return false;
+        long v = 0;
+        while (p < end && isDigit(*p))
+            v = v * 10 + (*p++ - '0');
+        value = neg ? -v : v;
+        cur = p;
+        return true;
+    }
+
+    bool readFloat(double& value)
+    {
+        static const double pow10[] = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        skipSpace();
+        const char* p = cur;
+        bool neg = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            neg = *p == '-';
+            ++p;
+        }
+
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int exponent = 0;
+        bool any = false;
+        for (; p < end && isDigit(*p); ++p) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa)
+                    digits++;
+            }
+            else {
+                exponent++;
+            }
+        }
+        if (p < end && *p == '.') {
+            for (++p; p < end && isDigit(*p); ++p) {
+                any = true;
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + (*p - '0');
+                    if (mantissa)
+                        digits++;
+                    exponent--;
+                }
+            }
+        }
+        if (!any)
+            return false;
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            const char* q = p + 1;
+            bool negExp = false;
+            if (q < end && (*q == '-' || *q == '+')) {
+                negExp = *q == '-';
+                ++q;
+            }
+            if (q < end && isDigit(*q)) {
+                int e = 0;
+                for (; q < end && isDigit(*q); ++q) {
+                    if (e < 10000)
+                        e = e * 10 + (*q - '0');
+                }
+                exponent += negExp ? -e : e;
+                p = q;
+            }
+        }
+
+        double v = static_cast<double>(mantissa);
+        if (mantissa == 0) {
+            v = 0.0;
+        }
+        else if (exponent >= -22 && exponent <= 22) {
+            v = exponent < 0 ? v / pow10[-exponent] : v * pow10[exponent];
+        }
+        else if (exponent > -300 && exponent < 300) {
+            v = exponent < 0 ? v / std::pow(10.0, -exponent) : v * std::pow(10.0, exponent);
+        }
+        else {
+            std::string token(cur, p);
+            v = std::strtod(token.c_str(), nullptr);
+            neg = false;
+        }
+
+        value = neg ? -v : v;
+        cur = p;
+        return true;
+    }
+
+private:
+    const char* cur;
+    const char* end;
+};
+
+/* An OBJ facet before the vertex indices are known. Relative indices are
+ * relative to the first point of the chunk.
+ */
+struct ObjFacet
+{
+    long index[3];
+    unsigned char relative;
+};
+
+/* The group and material statements of an OBJ file. They are evaluated in
+ * the order of the file once all chunks are parsed.
+ */
+struct ObjStatement
+{
+    enum Type { Group, MaterialLib, UseMaterial };
+    Type type;
+    std::size_t facet; /**< number of facets of the chunk before the statement */
+    std::string name;
+};
+
+struct ObjChunk
+{
+    MeshPointArray points;
+    std::vector<ObjFacet> facets;
+    std::vector<ObjStatement> statements;
+    std::vector<std::pair<std::size_t, unsigned long> > segments;
+    bool colors = false;
+};
+
+void parseObjChunk(const TextChunk& text, ObjChunk& chunk)
+{
+    std::string word;
+    for (const char* pos = text.begin; pos < text.end; ) {
+        const char* eol = lineEnd(pos, text.end);
+        Scanner line(pos, eol);
+        pos = nextLine(eol, text.end);
+
+        if (line.keyword("v", 1)) {
+            // x y z [r g b]
+            double values[6];
+            bool intColors = true;
+            int count = 0;
+            bool valid = true;
+            while (valid && !line.atEnd()) {
+                const char* token = line.pos();
+                if (count == 6 || !line.readFloat(values[count]) || !line.tokenEnd()) {
+                    valid = false;
+                    break;
+                }
+                if (count >= 3) {
+                    std::ptrdiff_t len = line.pos() - token;
+                    intColors = intColors && len <= 3 && std::all_of(token, line.pos(), isDigit);
+                }
+                count++;
+            }
+            if (!valid || (count != 3 && count != 6))
+                continue;
+
+            chunk.points.push_back(MeshPoint(Base::Vector3f(static_cast<float>(values[0]),
+                                                            static_cast<float>(values[1]),
+                                                            static_cast<float>(values[2]))));
+            if (count == 6) {
+                float r, g, b;
+                if (intColors) {
+                    r = std::min<int>(static_cast<int>(values[3]),255) / 255.0f;
+                    g = std::min<int>(static_cast<int>(values[4]),255) / 255.0f;
+                    b = std::min<int>(static_cast<int>(values[5]),255) / 255.0f;
+                }
+                else {
+                    r = static_cast<float>(values[3]);
+                    g = static_cast<float>(values[4]);
+                    b = static_cast<float>(values[5]);
+                }
+                App::Color c(r,g,b);
+                unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
+                chunk.points.back().SetProperty(prop);
+                chunk.colors = true;
+            }
+        }
+        else if (line.keyword("f", 1)) {
+            // 3- or 4-vertex face, the texture and normal indices are ignored
+            long index[4];
+            int count = 0;
+            bool valid = true;
+            while (!line.atEnd()) {
+                if (count == 4 || !line.readInt(index[count])) {
+                    valid = false;
+                    break;
+                }
+                line.skipToken();
+                count++;
+            }
+            if (!valid || count < 3)
+                continue;
+
+            // negative indices refer to the points read before
+            unsigned char relative = 0;
+            long numPoints = static_cast<long>(chunk.points.size());
+            for (int i = 0; i < count; i++) {
+                if (index[i] > 0) {
+                    index[i] -= 1;
+                }
+                else {
+                    index[i] += numPoints;
+                    relative |= (1 << i);
+                }
+            }
+
+            ObjFacet facet;
+            facet.index[0] = index[0];
+            facet.index[1] = index[1];
+            facet.index[2] = index[2];
+            facet.relative = relative & 7;
+            chunk.facets.push_back(facet);
+            if (count == 4) {
+                facet.index[0] = index[2];
+                facet.index[1] = index[3];
+                facet.index[2] = index[0];
+                facet.relative = ((relative >> 2) & 1) | ((relative >> 2) & 2) | ((relative & 1) << 2);
+                chunk.facets.push_back(facet);
+            }
+        }
+        else if (line.keyword("g", 1)) {
+            if (line.lastWord(word))
+                chunk.statements.push_back({ObjStatement::Group, chunk.facets.size(), word});
+        }
+        else if (line.keyword("mtllib", 6)) {
+            if (line.lastWord(word))
+                chunk.statements.push_back({ObjStatement::MaterialLib, chunk.facets.size(), word});
+        }
+        else if (line.keyword("usemtl", 6)) {
+            if (line.lastWord(word))
+                chunk.statements.push_back({ObjStatement::UseMaterial, chunk.facets.size(), word});
+        }
+    }
+}
 
+/* Reads a color in the range [0,1] or [0,255] with optional alpha value as used by OFF files. */
+bool readOffColor(Scanner& line, App::Color& color)
+{
+    double r, g, b, a;
+    if (!line.readFloat(r) || !line.readFloat(g) || !line.readFloat(b))
+        return false;
+    if (!line.readFloat(a))
+        a = 0.0;
+    if (r > 1.0 || g > 1.0 || b > 1.0 || a > 1.0) {
+        r /= 255.0;
+        g /= 255.0;
+        b /= 255.0;
+        a /= 255.0;
+    }
+    color.set(static_cast<float>(r), static_cast<float>(g), static_cast<float>(b), static_cast<float>(a));
+    return true;
+}
+
+} // namespace Ascii
+} // namespace MeshCore
+
+/** Loads an OBJ file. */
+bool MeshInput::LoadOBJ (std::istream &rstrIn)
+{
     if (!rstrIn || rstrIn.bad() == true)
         return false;
 
@@ -334,64 +824,38 @@ bool MeshInput::LoadOBJ (std::istream &rstrIn)
     if (!buf)
         return false;
 
+    std::string buffer;
+    Ascii::readRemaining(rstrIn, buffer);
+
+    // The lines are tokenized in parallel. Statements that depend on the
+    // preceding lines, i.e. groups, materials and relative vertex indices,
+    // are resolved afterwards.
+    std::vector<Ascii::TextChunk> text = Ascii::splitText(buffer.data(), buffer.data() + buffer.size());
+    std::vector<Ascii::ObjChunk> chunks(text.size());
+    Base::parallel_for(std::size_t(0), text.size(), [&](std::size_t i) {
+        Ascii::parseObjChunk(text[i], chunks[i]);
+    }, std::size_t(1));
+
+    unsigned long segment=0;
     MeshIO::Binding rgb_value = MeshIO::OVERALL;
     bool new_segment = true;
     std::string groupName;
     std::string materialName;
     unsigned long countMaterialFacets = 0;
 
-    while (std::getline(rstrIn, line)) {
-        if (boost::regex_match(line.c_str(), what, rx_p)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_c)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            float r = std::min<int>(std::atof(what[10].first),255) / 255.0f;
-            float g = std::min<int>(std::atof(what[11].first),255) / 255.0f;
-            float b = std::min<int>(std::atof(what[12].first),255) / 255.0f;
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
-
-            App::Color c(r,g,b);
-            unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
-            meshPoints.back().SetProperty(prop);
+    std::vector<std::size_t> pointOffsets(chunks.size() + 1, 0);
+    std::vector<std::size_t> facetOffsets(chunks.size() + 1, 0);
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        Ascii::ObjChunk& chunk = chunks[i];
+        pointOffsets[i+1] = pointOffsets[i] + chunk.points.size();
+        facetOffsets[i+1] = facetOffsets[i] + chunk.facets.size();
+        if (chunk.colors)
             rgb_value = MeshIO::PER_VERTEX;
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_t)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            float r = static_cast<float>(std::atof(what[10].first));
-            float g = static_cast<float>(std::atof(what[13].first));
-            float b = static_cast<float>(std::atof(what[16].first));
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
 
-            App::Color c(r,g,b);
-            unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
-            meshPoints.back().SetProperty(prop);
-            rgb_value = MeshIO::PER_VERTEX;
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_g)) {
-            new_segment = true;
-            groupName = Base::Tools::escapedUnicodeToUtf8(what[1].first);
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_m)) {
-            if (_material)
-                _material->library = Base::Tools::escapedUnicodeToUtf8(what[1].first);
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_u)) {
-            if (!materialName.empty()) {
-                _materialNames.emplace_back(materialName, countMaterialFacets);
-            }
-            materialName = Base::Tools::escapedUnicodeToUtf8(what[1].first);
-            countMaterialFacets = 0;
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_f3)) {
-            // starts a new segment
+        // a run of facets gets the current segment, a face after a group starts a new one
+        auto addFacets = [&](std::size_t first, std::size_t last) {
+            if (first == last)
+                return;
             if (new_segment) {
                 if (!groupName.empty()) {
                     _groupNames.push_back(groupName);
@@ -400,50 +864,34 @@ bool MeshInput::LoadOBJ (std::istream &rstrIn)
                 new_segment = false;
                 segment++;
             }
+            chunk.segments.emplace_back(first, segment);
+            countMaterialFacets += last - first;
+        };
 
-            // 3-vertex face
-            i1 = std::atoi(what[1].first);
-            i1 = i1 > 0 ? i1-1 : i1+static_cast<int>(meshPoints.size());
-            i2 = std::atoi(what[2].first);
-            i2 = i2 > 0 ? i2-1 : i2+static_cast<int>(meshPoints.size());
-            i3 = std::atoi(what[3].first);
-            i3 = i3 > 0 ? i3-1 : i3+static_cast<int>(meshPoints.size());
-            item.SetVertices(i1,i2,i3);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_f4)) {
-            // starts a new segment
-            if (new_segment) {
-                if (!groupName.empty()) {
-                    _groupNames.push_back(groupName);
-                    groupName.clear();
+        std::size_t facet = 0;
+        for (const Ascii::ObjStatement& it : chunk.statements) {
+            addFacets(facet, it.facet);
+            facet = it.facet;
+            switch (it.type) {
+            case Ascii::ObjStatement::Group:
+                new_segment = true;
+                groupName = Base::Tools::escapedUnicodeToUtf8(it.name);
+                break;
+            case Ascii::ObjStatement::MaterialLib:
+                if (_material)
+                    _material->library = Base::Tools::escapedUnicodeToUtf8(it.name);
+                break;
+            case Ascii::ObjStatement::UseMaterial:
+                if (!materialName.empty()) {
+                    _materialNames.emplace_back(materialName, countMaterialFacets);
                 }
-                new_segment = false;
-                segment++;
+                materialName = Base::Tools::escapedUnicodeToUtf8(it.name);
+                countMaterialFacets = 0;
+                break;
             }
-
-            // 4-vertex face
-            i1 = std::atoi(what[1].first);
-            i1 = i1 > 0 ? i1-1 : i1+static_cast<int>(meshPoints.size());
-            i2 = std::atoi(what[2].first);
-            i2 = i2 > 0 ? i2-1 : i2+static_cast<int>(meshPoints.size());
-            i3 = std::atoi(what[3].first);
-            i3 = i3 > 0 ? i3-1 : i3+static_cast<int>(meshPoints.size());
-            i4 = std::atoi(what[4].first);
-            i4 = i4 > 0 ? i4-1 : i4+static_cast<int>(meshPoints.size());
-
-            item.SetVertices(i1,i2,i3);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
-
-            item.SetVertices(i3,i4,i1);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
         }
+        addFacets(facet, chunk.facets.size());
+        chunk.statements.clear();
     }
 
     // Add the last added material name
@@ -451,18 +899,45 @@ bool MeshInput::LoadOBJ (std::istream &rstrIn)
         _materialNames.emplace_back(materialName, countMaterialFacets);
     }
 
+    // fill the facet array directly with the final indices
+    MeshFacetArray meshFacets;
+    meshFacets.resize(facetOffsets.back());
+    Base::parallel_for(std::size_t(0), chunks.size(), [&](std::size_t i) {
+        Ascii::ObjChunk& chunk = chunks[i];
+        long pointOffset = static_cast<long>(pointOffsets[i]);
+        MeshFacetArray::_TIterator jt = meshFacets.begin() + facetOffsets[i];
+        std::size_t run = 0;
+        for (std::size_t j = 0; j < chunk.facets.size(); ++j, ++jt) {
+            while (run + 1 < chunk.segments.size() && chunk.segments[run+1].first <= j)
+                run++;
+            const Ascii::ObjFacet& facet = chunk.facets[j];
+            long index[3];
+            for (int k = 0; k < 3; k++)
+                index[k] = facet.index[k] + ((facet.relative & (1 << k)) ? pointOffset : 0);
+            jt->SetVertices(index[0], index[1], index[2]);
+            jt->SetProperty(chunk.segments[run].second);
+        }
+        std::vector<Ascii::ObjFacet>().swap(chunk.facets);
+    }, std::size_t(1));
+
+    MeshPointArray meshPoints;
+    std::vector<MeshPointArray> points(chunks.size());
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+        points[i].swap(chunks[i].points);
+    chunks.clear();
+    Ascii::joinParts(meshPoints, points);
+
     // now get back the colors from the vertex property
     if (rgb_value == MeshIO::PER_VERTEX) {
         if (_material) {
             _material->binding = MeshIO::PER_VERTEX;
-            _material->diffuseColor.reserve(meshPoints.size());
+            std::size_t offset = _material->diffuseColor.size();
+            _material->diffuseColor.resize(offset + meshPoints.size());
 
-            for (MeshPointArray::iterator it = meshPoints.begin(); it != meshPoints.end(); ++it) {
-                unsigned long prop = it->_ulProp;
-                App::Color c;
-                c.setPackedValue(static_cast<uint32_t>(prop));
-                _material->diffuseColor.push_back(c);
-            }
+            Base::parallel_for(std::size_t(0), meshPoints.size(), [&](std::size_t i) {
+                unsigned long prop = meshPoints[i]._ulProp;
+                _material->diffuseColor[offset + i].setPackedValue(static_cast<uint32_t>(prop));
+            });
         }
     }
     else if (!materialName.empty()) {
@@ -615,7 +1090,6 @@ bool MeshInput::LoadOFF (std::istream &rstrIn)
     MeshFacetArray meshFacets;
 
     std::string line;
-    MeshFacet item;
 
     if (!rstrIn || rstrIn.bad() == true)
         return false;
@@ -638,7 +1112,8 @@ bool MeshInput::LoadOFF (std::istream &rstrIn)
     int numPoints=0, numFaces=0;
 
     while (true) {
-        std::getline(rstrIn, line);
+        if (!std::getline(rstrIn, line))
+            return false;
         boost::algorithm::to_lower(line);
         if (boost::regex_match(line.c_str(), what, rx_n)) {
             numPoints = std::atoi(what[1].first);
@@ -650,103 +1125,90 @@ bool MeshInput::LoadOFF (std::istream &rstrIn)
     if (numPoints == 0 || numFaces == 0)
         return false;
 
-    meshPoints.reserve(numPoints);
-    meshFacets.reserve(numFaces);
-    if (colorPerVertex)
-        diffuseColor.reserve(numPoints);
-    else
-        diffuseColor.reserve(numFaces);
+    std::string buffer;
+    Ascii::readRemaining(rstrIn, buffer);
 
-    int cntPoints = 0;
-    while (cntPoints < numPoints) {
-        if (!std::getline(rstrIn, line))
-            break;
-        std::istringstream str(line);
-        str.unsetf(std::ios_base::skipws);
-        str >> std::ws;
-        if (str.eof())
-            continue; // empty line
+    // a vertex line starts with a number, empty lines and comments are skipped
+    auto isPointLine = [](const char* pos, const char* eol) {
+        Ascii::Scanner line(pos, eol);
+        if (line.atEnd())
+            return false;
+        char c = *line.pos();
+        return Ascii::isDigit(c) || c == '-' || c == '+' || c == '.';
+    };
+    // a face line starts with the number of its vertices
+    auto isFaceLine = [](const char* pos, const char* eol) {
+        Ascii::Scanner line(pos, eol);
+        long count;
+        return line.readInt(count) && count >= 3;
+    };
 
-        float fX, fY, fZ;
-        str >> fX >> std::ws >> fY >> std::ws >> fZ;
-        if (str) {
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
-            cntPoints++;
-
-            if (colorPerVertex) {
-                std::size_t pos = std::size_t(str.tellg());
-                if (line.size() > pos) {
-                    float r,g,b,a;
-                    str >> std::ws >> r >> std::ws >> g >> std::ws >> b;
-                    if (str) {
-                        str >> std::ws >> a;
-                        // no transparency
-                        if (!str)
-                            a = 0.0f;
-
-                        if (r > 1.0f || g > 1.0f || b > 1.0f || a > 1.0f) {
-                            r = static_cast<float>(r)/255.0f;
-                            g = static_cast<float>(g)/255.0f;
-                            b = static_cast<float>(b)/255.0f;
-                            a = static_cast<float>(a)/255.0f;
-                        }
-                        diffuseColor.emplace_back(r, g, b, a);
-                    }
-                }
-            }
+    std::vector<Ascii::TextChunk> text = Ascii::splitText(buffer.data(), buffer.data() + buffer.size());
+    Ascii::countLines(text, isPointLine);
+    std::vector<Ascii::TextChunk> pointText = Ascii::takeLines(text, numPoints, isPointLine);
+    Ascii::countLines(text, isFaceLine);
+    std::vector<Ascii::TextChunk> faceText = Ascii::takeLines(text, numFaces, isFaceLine);
+
+    std::vector<MeshPointArray> points(pointText.size());
+    std::vector<std::vector<App::Color> > pointColors(pointText.size());
+    Base::parallel_for(std::size_t(0), pointText.size(), [&](std::size_t i) {
+        const Ascii::TextChunk& chunk = pointText[i];
+        points[i].reserve(chunk.lines);
+        for (const char* pos = chunk.begin; pos < chunk.end; ) {
+            const char* eol = Ascii::lineEnd(pos, chunk.end);
+            Ascii::Scanner line(pos, eol);
+            pos = Ascii::nextLine(eol, chunk.end);
+
+            double x, y, z;
+            if (!line.readFloat(x) || !line.readFloat(y) || !line.readFloat(z))
+                continue;
+            points[i].push_back(MeshPoint(Base::Vector3f(static_cast<float>(x),
+                                                         static_cast<float>(y),
+                                                         static_cast<float>(z))));
+            App::Color color;
+            if (colorPerVertex && Ascii::readOffColor(line, color))
+                pointColors[i].push_back(color);
         }
-    }
-
-    int cntFaces = 0;
-    while (cntFaces < numFaces) {
-        if (!std::getline(rstrIn, line))
-            break;
-        std::istringstream str(line);
-        str.unsetf(std::ios_base::skipws);
-        str >> std::ws;
-        if (str.eof())
-            continue; // empty line
-        int count, index;
-        str >> count;
-        if (count >= 3) {
-            std::vector<int> faces;
-            faces.reserve(count);
-
-            for (int i = 0; i < count; i++) {
-                str >> std::ws;
-                str >> index;
-                faces.push_back(index);
-            }
-
-            for (int i = 0; i < count-2; i++) {
-                item.SetVertices(faces[0],faces[i+1],faces[i+2]);
-                meshFacets.push_back(item);
-            }
-            cntFaces++;
-
-            std::size_t pos = std::size_t(str.tellg());
-            if (line.size() > pos) {
-                float r,g,b,a;
-                str >> std::ws >> r >> std::ws >> g >> std::ws >> b;
-                if (str) {
-                    str >> std::ws >> a;
-                    // no transparency
-                    if (!str)
-                        a = 0.0f;
-
-                    if (r > 1.0f || g > 1.0f || b > 1.0f || a > 1.0f) {
-                        r = static_cast<float>(r)/255.0f;
-                        g = static_cast<float>(g)/255.0f;
-                        b = static_cast<float>(b)/255.0f;
-                        a = static_cast<float>(a)/255.0f;
-                    }
-                    for (int i = 0; i < count-2; i++) {
-                        diffuseColor.emplace_back(r, g, b, a);
-                    }
-                }
+    }, std::size_t(1));
+
+    std::vector<MeshFacetArray> facets(faceText.size());
+    std::vector<std::vector<App::Color> > faceColors(faceText.size());
+    Base::parallel_for(std::size_t(0), faceText.size(), [&](std::size_t i) {
+        const Ascii::TextChunk& chunk = faceText[i];
+        std::vector<long> indices;
+        MeshFacet item;
+        facets[i].reserve(chunk.lines);
+        for (const char* pos = chunk.begin; pos < chunk.end; ) {
+            const char* eol = Ascii::lineEnd(pos, chunk.end);
+            Ascii::Scanner line(pos, eol);
+            pos = Ascii::nextLine(eol, chunk.end);
+
+            long count, index;
+            if (!line.readInt(count) || count < 3)
+                continue;
+            indices.clear();
+            for (long j = 0; j < count && line.readInt(index); j++)
+                indices.push_back(index);
+            if (static_cast<long>(indices.size()) != count)
+                continue;
+
+            for (long j = 0; j < count-2; j++) {
+                item.SetVertices(indices[0],indices[j+1],indices[j+2]);
+                facets[i].push_back(item);
             }
+
+            App::Color color;
+            if (Ascii::readOffColor(line, color))
+                faceColors[i].insert(faceColors[i].end(), count-2, color);
         }
-    }
+    }, std::size_t(1));
+
+    Ascii::joinParts(meshPoints, points);
+    Ascii::joinParts(meshFacets, facets);
+    if (colorPerVertex)
+        Ascii::joinParts(diffuseColor, pointColors);
+    else
+        Ascii::joinParts(diffuseColor, faceColors);
 
     if (_material) {
         if (colorPerVertex) {
@@ -1033,85 +1495,116 @@ bool MeshInput::LoadPLY (std::istream &inp)
     }
 
     if (format == ascii) {
-        boost::regex rx_d("(([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?))\\s*");
-        boost::regex rx_s("\\b([-+]?[0-9]+)\\s*");
-        boost::regex rx_u("\\b([0-9]+)\\s*");
-        boost::regex rx_f("^\\s*3\\s+([0-9]+)\\s+([0-9]+)\\s+([0-9]+)\\s*");
-        boost::smatch what;
+        std::string buffer;
+        Ascii::readRemaining(inp, buffer);
 
-        for (std::size_t i = 0; i < v_count && std::getline(inp, line); i++) {
-            // go through the vertex properties
-            std::map<std::string, float> prop_values;
-            for (std::vector<std::pair<std::string, Number> >::iterator it = vertex_props.begin(); it != vertex_props.end(); ++it) {
-                switch (it->second) {
-                case int8:
-                case int16:
-                case int32:
-                    {
-                        if (boost::regex_search(line, what, rx_s)) {
-                            int v;
-                            v = boost::lexical_cast<int>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                case uint8:
-                case uint16:
-                case uint32:
-                    {
-                        if (boost::regex_search(line, what, rx_u)) {
-                            int v;
-                            v = boost::lexical_cast<int>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                case float32:
-                case float64:
-                    {
-                        if (boost::regex_search(line, what, rx_d)) {
-                            double v;
-                            v = boost::lexical_cast<double>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                default:
-                    return false;
-                }
-            }
+        // every line holds one element
+        auto anyLine = [](const char*, const char*) {
+            return true;
+        };
 
-            Base::Vector3f pt;
-            pt.x = (prop_values["x"]);
-            pt.y = (prop_values["y"]);
-            pt.z = (prop_values["z"]);
-            meshPoints.push_back(pt);
+        std::vector<Ascii::TextChunk> text = Ascii::splitText(buffer.data(), buffer.data() + buffer.size());
+        Ascii::countLines(text, anyLine);
+        std::vector<Ascii::TextChunk> pointText = Ascii::takeLines(text, v_count, anyLine);
+        std::vector<Ascii::TextChunk> faceText = Ascii::takeLines(text, f_count, anyLine);
 
-            if (_material && (rgb_value == MeshIO::PER_VERTEX)) {
-                float r = (prop_values["red"]) / 255.0f;
-                float g = (prop_values["green"]) / 255.0f;
-                float b = (prop_values["blue"]) / 255.0f;
-                _material->diffuseColor.emplace_back(r, g, b);
+        auto propIndex = [&vertex_props](const char* name) {
+            for (std::size_t i = 0; i < vertex_props.size(); ++i) {
+                if (vertex_props[i].first == name)
+                    return i;
             }
-        }
+            return vertex_props.size();
+        };
+        std::size_t ix = propIndex("x");
+        std::size_t iy = propIndex("y");
+        std::size_t iz = propIndex("z");
+        std::size_t ir = propIndex("red");
+        std::size_t ig = propIndex("green");
+        std::size_t ib = propIndex("blue");
+        bool readColors = _material && (rgb_value == MeshIO::PER_VERTEX);
+
+        std::atomic<bool> valid(true);
+        std::vector<MeshPointArray> points(pointText.size());
+        std::vector<std::vector<App::Color> > colors(pointText.size());
+        Base::parallel_for(std::size_t(0), pointText.size(), [&](std::size_t i) {
+            const Ascii::TextChunk& chunk = pointText[i];
+            std::vector<float> prop_values(vertex_props.size());
+            points[i].reserve(chunk.lines);
+            for (const char* pos = chunk.begin; pos < chunk.end && valid; ) {
+                const char* eol = Ascii::lineEnd(pos, chunk.end);
+                Ascii::Scanner line(pos, eol);
+                pos = Ascii::nextLine(eol, chunk.end);
+
+                // go through the vertex properties
+                for (std::size_t j = 0; j < vertex_props.size(); ++j) {
+                    bool ok = false;
+                    switch (vertex_props[j].second) {
+                    case int8:
+                    case int16:
+                    case int32:
+                    case uint8:
+                    case uint16:
+                    case uint32:
+                        {
+                            long v;
+                            ok = line.readInt(v) && line.tokenEnd();
+                            prop_values[j] = static_cast<float>(v);
+                        } break;
+                    case float32:
+                    case float64:
+                        {
+                            double v;
+                            ok = line.readFloat(v) && line.tokenEnd();
+                            prop_values[j] = static_cast<float>(v);
+                        } break;
+                    default:
+                        break;
+                    }
+                    if (!ok) {
+                        valid = false;
+                        return;
+                    }
+                }
 
-        int f1, f2, f3;
-        for (std::size_t i = 0; i < f_count && std::getline(inp, line); i++) {
-            if (boost::regex_search(line, what, rx_f)) {
-                f1 = boost::lexical_cast<int>(what[1]);
-                f2 = boost::lexical_cast<int>(what[2]);
-                f3 = boost::lexical_cast<int>(what[3]);
-                meshFacets.push_back(MeshFacet(f1,f2,f3));
+                points[i].push_back(Base::Vector3f(prop_values[ix], prop_values[iy], prop_values[iz]));
+                if (readColors) {
+                    float r = (prop_values[ir]) / 255.0f;
+                    float g = (prop_values[ig]) / 255.0f;
+                    float b = (prop_values[ib]) / 255.0f;
+                    colors[i].emplace_back(r, g, b);
+                }
+            }
+        }, std::size_t(1));
+
+        if (!valid)
+            return false;
+
+        std::vector<MeshFacetArray> facets(faceText.size());
+        Base::parallel_for(std::size_t(0), faceText.size(), [&](std::size_t i) {
+            const Ascii::TextChunk& chunk = faceText[i];
+            facets[i].reserve(chunk.lines);
+            for (const char* pos = chunk.begin; pos < chunk.end; ) {
+                const char* eol = Ascii::lineEnd(pos, chunk.end);
+                Ascii::Scanner line(pos, eol);
+                pos = Ascii::nextLine(eol, chunk.end);
+
+                // only triangles are supported
+                long n, f1, f2, f3;
+                if (line.readInt(n) && n == 3 &&
+                    line.readInt(f1) && line.readInt(f2) && line.readInt(f3) &&
+                    f1 >= 0 && f2 >= 0 && f3 >= 0) {
+                    facets[i].push_back(MeshFacet(f1,f2,f3));
+                }
             }
+        }, std::size_t(1));
+
+        Ascii::joinParts(meshPoints, points);
+        Ascii::joinParts(meshFacets, facets);
+        if (readColors) {
+            std::vector<App::Color> diffuseColor;
+            Ascii::joinParts(diffuseColor, colors);
+            _material->diffuseColor.insert(_material->diffuseColor.end(),
+                                           diffuseColor.begin(), diffuseColor.end());
         }
     }
     // binary
@@ -1442,6 +1935,31 @@ bool MeshInput::LoadBinarySTL (std::istream &rstrIn)
     return true;
 }
 
+bool MeshInput::LoadBinarySTL (const char* data, std::size_t size)
+{
+    // header info, number of facets and 50-byte records of normal, points and attribute
+    const std::size_t headerSize = 80 + sizeof(uint32_t);
+    const std::size_t recordSize = 50;
+    if (size < headerSize)
+        return false;
+
+    uint32_t ulCt = 0;
+    memcpy(&ulCt, data + 80, sizeof(ulCt));
+
+    // compare the calculated with the read value
+    std::size_t ulFac = (size - headerSize) / recordSize;
+    if (ulCt > ulFac)
+        return false;// not a valid STL file
+
+    MeshFastBuilder builder(this->_rclMesh);
+    builder.Initialize(ulCt);
+    // skip the normal of each record
+    builder.AddFacets(data + headerSize + 3 * sizeof(float), ulCt, recordSize);
+    builder.Finish();
+
+    return true;
+}
+
 /** Loads the mesh object from an XML file. */
 void MeshInput::LoadXML (Base::XMLReader &reader)
 {
@@ -3470,6 +3988,246 @@ bool MeshOutput::SaveVRML (std::ostream &rstrOut) const
 
 // ----------------------------------------------------------------------------
 
+namespace {
+
+// A range of elements that is formatted into its own buffer
+struct OutputBlock
+{
+    std::size_t first, last;
+    std::string data;
+};
+
+std::vector<OutputBlock> makeOutputBlocks(std::size_t count)
+{
+    const std::size_t blockSize = 0x8000;
+    std::vector<OutputBlock> blocks;
+    for (std::size_t i = 0; i < count; i += blockSize) {
+        OutputBlock block;
+        block.first = i;
+        block.last = std::min<std::size_t>(i + blockSize, count);
+        blocks.push_back(block);
+    }
+    return blocks;
+}
+
+void writeOutputBlocks(std::ostream& out, const std::vector<OutputBlock>& blocks)
+{
+    for (std::vector<OutputBlock>::const_iterator it = blocks.begin(); it != blocks.end(); ++it)
+        out.write(it->data.data(), it->data.size());
+}
+
+inline void transformFacet(const MeshPointArray& points, const MeshFacet& face,
+                           const Base::Matrix4D& mat, Base::Vector3f* pnts, Base::Vector3f& normal)
+{
+    for (int i = 0; i < 3; i++)
+        pnts[i] = mat * points[face._aulPoints[i]];
+    normal = (pnts[1] - pnts[0]) % (pnts[2] - pnts[0]);
+    normal.Normalize();
+}
+
+}
+
+MeshStreamOutput::MeshStreamOutput (std::ostream &rstrOut, MeshIO::Format fmt)
+  : _rstrOut(rstrOut), _format(fmt), _numPoints(0), _numFacets(0)
+{
+}
+
+MeshStreamOutput::~MeshStreamOutput (void)
+{
+}
+
+bool MeshStreamOutput::IsSupported(MeshIO::Format fmt)
+{
+    return fmt == MeshIO::BSTL || fmt == MeshIO::ASTL || fmt == MeshIO::OBJ;
+}
+
+bool MeshStreamOutput::Begin()
+{
+    if (!_rstrOut || _rstrOut.bad() || !IsSupported(_format))
+        return false;
+
+    switch (_format) {
+    case MeshIO::BSTL:
+        {
+            // stl_header has a length of 80
+            _rstrOut.write(MeshOutput::stl_header.c_str(), 80);
+            _countPos = _rstrOut.tellp();
+            uint32_t uCtFts = 0;
+            _rstrOut.write((const char*)&uCtFts, sizeof(uCtFts));
+        }   break;
+    case MeshIO::ASTL:
+        _rstrOut << "solid Mesh\n";
+        break;
+    case MeshIO::OBJ:
+        _rstrOut << "# Created by FreeCAD <http://www.freecadweb.org>\n";
+        break;
+    default:
+        break;
+    }
+
+    return _rstrOut.good();
+}
+
+bool MeshStreamOutput::Add(const MeshKernel& rclM, const Base::Matrix4D& mat, const std::string& name)
+{
+    if (!_rstrOut || _rstrOut.bad())
+        return false;
+
+    switch (_format) {
+    case MeshIO::BSTL:
+        AddBinarySTL(rclM, mat);
+        break;
+    case MeshIO::ASTL:
+        AddAsciiSTL(rclM, mat);
+        break;
+    case MeshIO::OBJ:
+        AddOBJ(rclM, mat, name);
+        break;
+    default:
+        return false;
+    }
+
+    _numPoints += rclM.CountPoints();
+    _numFacets += rclM.CountFacets();
+    return _rstrOut.good();
+}
+
+bool MeshStreamOutput::End()
+{
+    if (!_rstrOut || _rstrOut.bad())
+        return false;
+
+    switch (_format) {
+    case MeshIO::BSTL:
+        {
+            // now the number of facets is known
+            uint32_t uCtFts = static_cast<uint32_t>(_numFacets);
+            _rstrOut.seekp(_countPos);
+            _rstrOut.write((const char*)&uCtFts, sizeof(uCtFts));
+            _rstrOut.seekp(0, std::ios::end);
+        }   break;
+    case MeshIO::ASTL:
+        _rstrOut << "endsolid Mesh\n";
+        break;
+    default:
+        break;
+    }
+
+    _rstrOut.flush();
+    return _rstrOut.good();
+}
+
+void MeshStreamOutput::AddBinarySTL(const MeshKernel& rclM, const Base::Matrix4D& mat)
+{
+    const MeshPointArray& points = rclM.GetPoints();
+    const MeshFacetArray& facets = rclM.GetFacets();
+
+    // normal, three vertices and the attribute
+    const std::size_t recordSize = 12 * sizeof(float) + sizeof(uint16_t);
+    std::vector<OutputBlock> blocks = makeOutputBlocks(facets.size());
+    QtConcurrent::blockingMap(blocks, [&points, &facets, &mat, recordSize](OutputBlock& block) {
+        block.data.assign((block.last - block.first) * recordSize, '\0');
+        char* ptr = &block.data[0];
+        for (std::size_t i = block.first; i < block.last; i++) {
+            Base::Vector3f pnts[3], normal;
+            transformFacet(points, facets[i], mat, pnts, normal);
+            float data[12] = {
+                normal.x, normal.y, normal.z,
+                pnts[0].x, pnts[0].y, pnts[0].z,
+                pnts[1].x, pnts[1].y, pnts[1].z,
+                pnts[2].x, pnts[2].y, pnts[2].z
+            };
+            memcpy(ptr, data, sizeof(data));
+            ptr += recordSize;
+        }
+    });
+
+    writeOutputBlocks(_rstrOut, blocks);
+}
+
+void MeshStreamOutput::AddAsciiSTL(const MeshKernel& rclM, const Base::Matrix4D& mat)
+{
+    const MeshPointArray& points = rclM.GetPoints();
+    const MeshFacetArray& facets = rclM.GetFacets();
+
+    std::vector<OutputBlock> blocks = makeOutputBlocks(facets.size());
+    QtConcurrent::blockingMap(blocks, [&points, &facets, &mat](OutputBlock& block) {
+        char line[128];
+        block.data.reserve((block.last - block.first) * 256);
+        for (std::size_t i = block.first; i < block.last; i++) {
+            Base::Vector3f pnts[3], normal;
+            transformFacet(points, facets[i], mat, pnts, normal);
+            snprintf(line, sizeof(line), "  facet normal %f %f %f\n", normal.x, normal.y, normal.z);
+            block.data += line;
+            block.data += "    outer loop\n";
+            for (int j = 0; j < 3; j++) {
+                snprintf(line, sizeof(line), "      vertex %f %f %f\n", pnts[j].x, pnts[j].y, pnts[j].z);
+                block.data += line;
+            }
+            block.data += "    endloop\n";
+            block.data += "  endfacet\n";
+        }
+    });
+
+    writeOutputBlocks(_rstrOut, blocks);
+}
+
+void MeshStreamOutput::AddOBJ(const MeshKernel& rclM, const Base::Matrix4D& mat, const std::string& name)
+{
+    const MeshPointArray& points = rclM.GetPoints();
+    const MeshFacetArray& facets = rclM.GetFacets();
+
+    // vertices
+    std::vector<OutputBlock> blocks = makeOutputBlocks(points.size());
+    QtConcurrent::blockingMap(blocks, [&points, &mat](OutputBlock& block) {
+        char line[128];
+        block.data.reserve((block.last - block.first) * 40);
+        for (std::size_t i = block.first; i < block.last; i++) {
+            Base::Vector3f pt = mat * points[i];
+            snprintf(line, sizeof(line), "v %f %f %f\n", pt.x, pt.y, pt.z);
+            block.data += line;
+        }
+    });
+    writeOutputBlocks(_rstrOut, blocks);
+
+    // normals
+    blocks = makeOutputBlocks(facets.size());
+    QtConcurrent::blockingMap(blocks, [&points, &facets, &mat](OutputBlock& block) {
+        char line[128];
+        block.data.reserve((block.last - block.first) * 32);
+        for (std::size_t i = block.first; i < block.last; i++) {
+            Base::Vector3f pnts[3], normal;
+            transformFacet(points, facets[i], mat, pnts, normal);
+            snprintf(line, sizeof(line), "vn %f %f %f\n", normal.x, normal.y, normal.z);
+            block.data += line;
+        }
+    });
+    writeOutputBlocks(_rstrOut, blocks);
+
+    // facet indices (no texture indices), the indices start with 1
+    if (!name.empty())
+        _rstrOut << "g " << Base::Tools::escapedUnicodeFromUtf8(name.c_str()) << '\n';
+
+    unsigned long pointOffset = _numPoints + 1;
+    unsigned long facetOffset = _numFacets + 1;
+    QtConcurrent::blockingMap(blocks, [&facets, pointOffset, facetOffset](OutputBlock& block) {
+        char line[128];
+        block.data.clear();
+        for (std::size_t i = block.first; i < block.last; i++) {
+            const MeshFacet& face = facets[i];
+            unsigned long n = facetOffset + i;
+            snprintf(line, sizeof(line), "f %lu//%lu %lu//%lu %lu//%lu\n",
+                     face._aulPoints[0] + pointOffset, n,
+                     face._aulPoints[1] + pointOffset, n,
+                     face._aulPoints[2] + pointOffset, n);
+            block.data += line;
+        }
+    });
+    writeOutputBlocks(_rstrOut, blocks);
+}
+
+// ----------------------------------------------------------------------------
+
 MeshCleanup::MeshCleanup(MeshPointArray& p, MeshFacetArray& f)
   : pointArray(p)
   , facetArray(f)
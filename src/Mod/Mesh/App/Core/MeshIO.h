@@ -111,6 +111,8 @@ public:
     bool LoadAsciiSTL (std::istream &rstrIn);
     /** Loads a binary STL file. */
     bool LoadBinarySTL (std::istream &rstrIn);
+    /** Loads a binary STL file from a memory block, e.g. a memory-mapped file. */
+    bool LoadBinarySTL (const char* data, std::size_t size);
     /** Loads an OBJ Mesh file. */
     bool LoadOBJ (std::istream &rstrIn);
     /** Loads the materials of an OBJ file. */
@@ -234,6 +236,43 @@ protected:
     static std::string stl_header;
     static std::string asyWidth;
     static std::string asyHeight;
+
+    friend class MeshStreamOutput;
+};
+
+/**
+ * The MeshStreamOutput class writes several meshes one after another to a single
+ * output stream without merging them into one mesh first. The facets are transformed
+ * and formatted block-wise in parallel into large buffers that are written at once.
+ * Supported formats are binary and ASCII STL and OBJ. For binary STL the stream must
+ * be seekable because the number of facets is written at the end.
+ */
+class MeshExport MeshStreamOutput
+{
+public:
+    MeshStreamOutput (std::ostream &rstrOut, MeshIO::Format fmt);
+    ~MeshStreamOutput (void);
+
+    /// Checks whether the format can be written by this class
+    static bool IsSupported(MeshIO::Format fmt);
+    /// Writes the header of the file, must be called before Add()
+    bool Begin();
+    /// Appends the mesh transformed by \a mat as object \a name
+    bool Add(const MeshKernel& rclM, const Base::Matrix4D& mat, const std::string& name);
+    /// Writes the end of the file
+    bool End();
+
+private:
+    void AddBinarySTL(const MeshKernel& rclM, const Base::Matrix4D& mat);
+    void AddAsciiSTL(const MeshKernel& rclM, const Base::Matrix4D& mat);
+    void AddOBJ(const MeshKernel& rclM, const Base::Matrix4D& mat, const std::string& name);
+
+private:
+    std::ostream &_rstrOut;
+    MeshIO::Format _format;
+    unsigned long _numPoints;
+    unsigned long _numFacets;
+    std::streampos _countPos;
 };
 
 /*!
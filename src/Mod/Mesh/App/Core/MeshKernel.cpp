@@ -25,11 +25,15 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <atomic>
+# include <cmath>
 # include <stdexcept>
 # include <map>
 # include <queue>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <Base/Exception.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
@@ -819,6 +823,93 @@ MeshFacetArray MeshKernel::GetFacets(const std::vector<unsigned long>& indices)
     return ary;
 }
 
+namespace {
+
+// Identifies the compressed format written by MeshKernel::WriteCompressed()
+const uint32_t compressedVersion = 0x020000;
+const uint32_t compressedBlockSize = 0x10000;
+
+struct CompressedBlock
+{
+    std::size_t first, last;
+    std::vector<unsigned char> data;
+};
+
+std::vector<CompressedBlock> makeBlocks(std::size_t count)
+{
+    std::vector<CompressedBlock> blocks;
+    for (std::size_t i = 0; i < count; i += compressedBlockSize) {
+        CompressedBlock block;
+        block.first = i;
+        block.last = std::min<std::size_t>(i + compressedBlockSize, count);
+        blocks.push_back(block);
+    }
+    return blocks;
+}
+
+inline uint64_t zigzagEncode(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline void writeVarint(std::vector<unsigned char>& data, uint64_t value)
+{
+    while (value >= 0x80) {
+        data.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<unsigned char>(value));
+}
+
+inline bool readVarint(const unsigned char*& ptr, const unsigned char* end, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && ptr != end; shift += 7) {
+        unsigned char byte = *ptr++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+void writeBlocks(Base::OutputStream& str, std::ostream& out, const std::vector<CompressedBlock>& blocks)
+{
+    str << static_cast<uint32_t>(blocks.size());
+    for (std::vector<CompressedBlock>::const_iterator it = blocks.begin(); it != blocks.end(); ++it)
+        str << static_cast<uint32_t>(it->data.size());
+    for (std::vector<CompressedBlock>::const_iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        if (!it->data.empty())
+            out.write(reinterpret_cast<const char*>(&it->data[0]), it->data.size());
+    }
+}
+
+void readBlocks(Base::InputStream& str, std::istream& in, std::vector<CompressedBlock>& blocks)
+{
+    uint32_t numBlocks = 0;
+    str >> numBlocks;
+    if (numBlocks != blocks.size())
+        throw Base::BadFormatError("Invalid data structure");
+    for (std::vector<CompressedBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        uint32_t size = 0;
+        str >> size;
+        it->data.resize(size);
+    }
+    for (std::vector<CompressedBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        if (!it->data.empty())
+            in.read(reinterpret_cast<char*>(&it->data[0]), it->data.size());
+    }
+    if (!in)
+        throw Base::BadFormatError("Reading from stream failed");
+}
+
+}
+
 void MeshKernel::Write (std::ostream &rclOut) const 
 {
     if (!rclOut || rclOut.bad())
@@ -874,6 +965,17 @@ void MeshKernel::Read (std::istream &rclIn)
     swap_version = version; Base::SwapEndian(swap_version);
     uint32_t open_edge = 0xffffffff; // value to mark an open edge
 
+    // is it the compressed format?
+    if (magic == 0xA0B0C0D0 && version == compressedVersion) {
+        ReadCompressed(str, rclIn);
+        return;
+    }
+    else if (swap_magic == 0xA0B0C0D0 && swap_version == compressedVersion) {
+        str.setByteOrder(Base::Stream::BigEndian);
+        ReadCompressed(str, rclIn);
+        return;
+    }
+
     // is it the new or old format?
     bool new_format = false;
     if (magic == 0xA0B0C0D0 && version == 0x010000) {
@@ -1031,6 +1133,179 @@ void MeshKernel::Read (std::istream &rclIn)
     }
 }
 
+void MeshKernel::WriteCompressed (std::ostream &rclOut, float tolerance) const
+{
+    if (!rclOut || rclOut.bad())
+        return;
+
+    Base::OutputStream str(rclOut);
+
+    // Write a header with the "magic number" and the version
+    str << static_cast<uint32_t>(0xA0B0C0D0);
+    str << compressedVersion;
+
+    // the quantized coordinates must fit into 64-bit integers
+    double step = 2.0 * static_cast<double>(tolerance);
+    bool quantize = tolerance > 0.0f && _clBoundBox.IsValid() &&
+                    static_cast<double>(_clBoundBox.CalcDiagonalLength()) / step < 1.0e15;
+
+    uint32_t flags = quantize ? 1 : 0;
+    str << flags << static_cast<uint32_t>(CountPoints()) << static_cast<uint32_t>(CountFacets());
+
+    // write the points
+    if (quantize) {
+        Base::Vector3f origin(_clBoundBox.MinX, _clBoundBox.MinY, _clBoundBox.MinZ);
+        str << static_cast<float>(step) << origin.x << origin.y << origin.z;
+
+        std::vector<CompressedBlock> blocks = makeBlocks(_aclPointArray.size());
+        QtConcurrent::blockingMap(blocks, [this, origin, step](CompressedBlock& block) {
+            int64_t prev[3] = {0, 0, 0};
+            block.data.reserve(6 * (block.last - block.first));
+            for (std::size_t i = block.first; i < block.last; i++) {
+                const MeshPoint& pt = this->_aclPointArray[i];
+                double coords[3] = {
+                    static_cast<double>(pt.x - origin.x),
+                    static_cast<double>(pt.y - origin.y),
+                    static_cast<double>(pt.z - origin.z)
+                };
+                for (int j = 0; j < 3; j++) {
+                    int64_t value = static_cast<int64_t>(std::floor(coords[j] / step + 0.5));
+                    writeVarint(block.data, zigzagEncode(value - prev[j]));
+                    prev[j] = value;
+                }
+            }
+        });
+        writeBlocks(str, rclOut, blocks);
+    }
+    else {
+        std::vector<float> coords;
+        coords.reserve(3 * _aclPointArray.size());
+        for (MeshPointArray::_TConstIterator it = _aclPointArray.begin(); it != _aclPointArray.end(); ++it) {
+            coords.push_back(it->x);
+            coords.push_back(it->y);
+            coords.push_back(it->z);
+        }
+        str.write(coords.data(), coords.size());
+    }
+
+    // write the facets, the first index relative to the previous facet and the
+    // other two relative to the first one
+    std::vector<CompressedBlock> blocks = makeBlocks(_aclFacetArray.size());
+    QtConcurrent::blockingMap(blocks, [this](CompressedBlock& block) {
+        int64_t prev = 0;
+        block.data.reserve(6 * (block.last - block.first));
+        for (std::size_t i = block.first; i < block.last; i++) {
+            const MeshFacet& face = this->_aclFacetArray[i];
+            int64_t p0 = static_cast<int64_t>(face._aulPoints[0]);
+            int64_t p1 = static_cast<int64_t>(face._aulPoints[1]);
+            int64_t p2 = static_cast<int64_t>(face._aulPoints[2]);
+            writeVarint(block.data, zigzagEncode(p0 - prev));
+            writeVarint(block.data, zigzagEncode(p1 - p0));
+            writeVarint(block.data, zigzagEncode(p2 - p0));
+            prev = p0;
+        }
+    });
+    writeBlocks(str, rclOut, blocks);
+}
+
+void MeshKernel::ReadCompressed (Base::InputStream &str, std::istream &rclIn)
+{
+    uint32_t flags = 0, uCtPts = 0, uCtFts = 0;
+    str >> flags >> uCtPts >> uCtFts;
+
+    try {
+        MeshPointArray pointArray;
+        pointArray.resize(uCtPts);
+        std::atomic<bool> invalid(false);
+
+        if (flags & 1) {
+            float step = 0.0f;
+            Base::Vector3f origin;
+            str >> step >> origin.x >> origin.y >> origin.z;
+
+            std::vector<CompressedBlock> blocks = makeBlocks(uCtPts);
+            readBlocks(str, rclIn, blocks);
+            QtConcurrent::blockingMap(blocks, [&pointArray, &invalid, origin, step](CompressedBlock& block) {
+                int64_t prev[3] = {0, 0, 0};
+                const unsigned char* ptr = block.data.data();
+                const unsigned char* end = ptr + block.data.size();
+                for (std::size_t i = block.first; i < block.last; i++) {
+                    double coords[3];
+                    for (int j = 0; j < 3; j++) {
+                        uint64_t value;
+                        if (!readVarint(ptr, end, value)) {
+                            invalid = true;
+                            return;
+                        }
+                        prev[j] += zigzagDecode(value);
+                        coords[j] = static_cast<double>(prev[j]) * static_cast<double>(step);
+                    }
+
+                    MeshPoint& pt = pointArray[i];
+                    pt.x = origin.x + static_cast<float>(coords[0]);
+                    pt.y = origin.y + static_cast<float>(coords[1]);
+                    pt.z = origin.z + static_cast<float>(coords[2]);
+                }
+            });
+        }
+        else {
+            std::vector<float> coords(3 * static_cast<std::size_t>(uCtPts));
+            str.read(coords.data(), coords.size());
+            for (std::size_t i = 0; i < pointArray.size(); i++)
+                pointArray[i].Set(coords[3*i], coords[3*i+1], coords[3*i+2]);
+        }
+
+        MeshFacetArray facetArray;
+        facetArray.resize(uCtFts);
+
+        std::vector<CompressedBlock> blocks = makeBlocks(uCtFts);
+        readBlocks(str, rclIn, blocks);
+        QtConcurrent::blockingMap(blocks, [&facetArray, &invalid, uCtPts](CompressedBlock& block) {
+            int64_t prev = 0;
+            const unsigned char* ptr = block.data.data();
+            const unsigned char* end = ptr + block.data.size();
+            for (std::size_t i = block.first; i < block.last; i++) {
+                uint64_t v0, v1, v2;
+                if (!readVarint(ptr, end, v0) || !readVarint(ptr, end, v1) || !readVarint(ptr, end, v2)) {
+                    invalid = true;
+                    return;
+                }
+
+                int64_t p0 = prev + zigzagDecode(v0);
+                int64_t p1 = p0 + zigzagDecode(v1);
+                int64_t p2 = p0 + zigzagDecode(v2);
+                prev = p0;
+
+                // make sure to have valid indices
+                int64_t count = static_cast<int64_t>(uCtPts);
+                if (p0 < 0 || p0 >= count || p1 < 0 || p1 >= count || p2 < 0 || p2 >= count) {
+                    invalid = true;
+                    return;
+                }
+
+                MeshFacet& face = facetArray[i];
+                face._aulPoints[0] = static_cast<unsigned long>(p0);
+                face._aulPoints[1] = static_cast<unsigned long>(p1);
+                face._aulPoints[2] = static_cast<unsigned long>(p2);
+            }
+        });
+
+        if (invalid)
+            throw Base::BadFormatError("Invalid data structure");
+
+        // If we reach this block no exception occurred and we can safely assign the mesh
+        _aclPointArray.swap(pointArray);
+        _aclFacetArray.swap(facetArray);
+    }
+    catch (std::exception&) {
+        // Special handling of std::length_error
+        throw Base::BadFormatError("Reading from stream failed");
+    }
+
+    RecalcBoundBox();
+    RebuildNeighbours();
+}
+
 void MeshKernel::operator *= (const Base::Matrix4D &rclMat)
 {
     this->Transform(rclMat);
@@ -1038,15 +1313,29 @@ void MeshKernel::operator *= (const Base::Matrix4D &rclMat)
 
 void MeshKernel::Transform (const Base::Matrix4D &rclMat)
 {
-    MeshPointArray::_TIterator  clPIter = _aclPointArray.begin(), clPEIter = _aclPointArray.end();
-    Base::Matrix4D clMatrix(rclMat);
-
     _clBoundBox.SetVoid();
-    while (clPIter < clPEIter) {
-        *clPIter *= clMatrix;
-        _clBoundBox.Add(*clPIter);
-        clPIter++;
-    }
+    if (_aclPointArray.empty())
+        return;
+
+    // Transform blocks of points in parallel, each with its own bounding box
+    const std::size_t blockSize = 0x10000;
+    MeshPoint* data = _aclPointArray.data();
+    std::size_t count = _aclPointArray.size();
+    std::vector<std::pair<std::size_t, Base::BoundBox3f> > blocks;
+    blocks.reserve(count / blockSize + 1);
+    for (std::size_t i = 0; i < count; i += blockSize)
+        blocks.emplace_back(i, Base::BoundBox3f());
+
+    QtConcurrent::blockingMap(blocks, [&rclMat, data, count, blockSize](std::pair<std::size_t, Base::BoundBox3f>& block) {
+        MeshPoint* first = data + block.first;
+        MeshPoint* last = data + std::min(block.first + blockSize, count);
+        rclMat.multVecs(first, last);
+        for (MeshPoint* it = first; it < last; ++it)
+            block.second.Add(*it);
+    });
+
+    for (const auto& block : blocks)
+        _clBoundBox.Add(block.second);
 }
 
 void MeshKernel::Smooth(int iterations, float stepsize)
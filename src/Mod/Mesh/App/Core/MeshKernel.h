@@ -35,6 +35,7 @@
 #include <Base/Matrix.h>
 
 namespace Base{
+  class InputStream;
   class Polygon2d;
   class ViewProjMethod;
 }
@@ -76,6 +77,14 @@ public:
     //@{
     /// Binary streaming of data
     void Write (std::ostream &rclOut) const;
+    /** Writes the mesh in a compact format. The point indices of the facets are
+     * delta and variable-length encoded and the neighbourhood is not stored but
+     * rebuilt when reading the data. If \a tolerance is greater than zero the
+     * coordinates are quantized so that each point is moved by at most \a tolerance
+     * in each direction. The data is split into blocks that are encoded and decoded
+     * in parallel. Read() handles this format, too.
+     */
+    void WriteCompressed (std::ostream &rclOut, float tolerance = 0.0f) const;
     void Read (std::istream &rclIn);
     //@}
 
@@ -217,11 +226,21 @@ public:
      * the facet gets marked as VISIT.
      */
     unsigned long VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, unsigned long ulStartFacet) const;
+    /**
+     * Does the same as the method above but keeps the visit state in \a visited instead of the
+     * VISIT flag of the facets. The bitset is indexed by facet and resized to the number of facets
+     * if needed. As the mesh isn't touched several traversals can run on the same mesh in parallel.
+     */
+    unsigned long VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, unsigned long ulStartFacet,
+                                        std::vector<bool>& visited) const;
     /**
      * Does basically the same as the method above unless the facets that share just a common point
      * are regared as neighbours.
      */
     unsigned long VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rclFVisitor, unsigned long ulStartFacet) const;
+    /// Like VisitNeighbourFacetsOverCorners() but with the visit state kept in \a visited
+    unsigned long VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rclFVisitor, unsigned long ulStartFacet,
+                                                   std::vector<bool>& visited) const;
     //@}
 
     /** @name Point visitors
@@ -244,6 +263,13 @@ public:
      * the point gets marked as VISIT.
      */
     unsigned long VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, unsigned long ulStartPoint) const; 
+    /**
+     * Does the same as the method above but keeps the visit state in \a visited instead of the
+     * VISIT flag of the points. The bitset is indexed by point and resized to the number of points
+     * if needed.
+     */
+    unsigned long VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, unsigned long ulStartPoint,
+                                        std::vector<bool>& visited) const;
     //@}
 
     /** @name Iterators 
@@ -429,6 +455,8 @@ public:
 protected:
     /** Rebuilds the neighbour indices for subset of all facets from index \a index on. */
     void RebuildNeighbours (unsigned long);
+    /** Reads the data written by WriteCompressed(). */
+    void ReadCompressed (Base::InputStream &str, std::istream &rclIn);
     /** Checks if this point is associated to no other facet and deletes if so.
      * The point indices of the facets get adjusted.
      * \a ulIndex is the index of the point to be deleted. \a ulFacetIndex is the index
@@ -0,0 +1,206 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cfloat>
+# include <climits>
+# include <cmath>
+# include <numeric>
+#endif
+
+#include "Registration.h"
+#include "MeshKernel.h"
+#include <Base/ThreadPool.h>
+
+#include <Eigen/LU>
+#include <Eigen/SVD>
+
+using namespace MeshCore;
+
+MeshRegistration::MeshRegistration(const MeshKernel& nominal)
+  : _bvh(nominal)
+  , _maxIter(50)
+  , _levels(3)
+  , _maxPoints(50000)
+  , _trimRatio(0.9f)
+  , _tolerance(1.0e-4f)
+  , _converged(false)
+  , _rms(FLT_MAX)
+{
+}
+
+MeshRegistration::MeshRegistration(const MeshKernel& nominal, const Base::Matrix4D& mat)
+  : _bvh(nominal, mat)
+  , _maxIter(50)
+  , _levels(3)
+  , _maxPoints(50000)
+  , _trimRatio(0.9f)
+  , _tolerance(1.0e-4f)
+  , _converged(false)
+  , _rms(FLT_MAX)
+{
+}
+
+MeshRegistration::~MeshRegistration()
+{
+}
+
+Base::Matrix4D MeshRegistration::Align(const std::vector<Base::Vector3f>& points,
+                                       const Base::Matrix4D& start)
+{
+    _iterations.clear();
+    _converged = false;
+    _rms = FLT_MAX;
+
+    Base::Matrix4D mat = start;
+    if (points.empty())
+        return mat;
+
+    // the coarser levels use a quarter of the points of the next finer level each
+    unsigned long finest = std::min<unsigned long>(points.size(), std::max<unsigned long>(_maxPoints, 1));
+    int levels = std::max(_levels, 1);
+    std::vector<Base::Vector3f> sample, source, target;
+    for (int level = 0; level < levels; level++) {
+        unsigned long count = finest >> std::min(2 * (levels - 1 - level), 30);
+        count = std::max<unsigned long>(count, std::min<unsigned long>(finest, 100));
+
+        // take evenly distributed points so that the subset covers the whole scan
+        sample.resize(count);
+        for (unsigned long i = 0; i < count; i++)
+            sample[i] = points[static_cast<std::size_t>(static_cast<double>(i) * points.size() / count)];
+
+        bool converged = false;
+        float prevRMS = FLT_MAX;
+        for (int iter = 0; iter < _maxIter; iter++) {
+            float rms = FindPairs(sample, mat, source, target);
+            if (source.size() < 3)
+                return mat;
+
+            Iteration it;
+            it.level = level;
+            it.points = source.size();
+            it.rms = rms;
+            _iterations.push_back(it);
+            _rms = rms;
+
+            if (prevRMS - rms <= _tolerance * prevRMS) {
+                converged = true;
+                break;
+            }
+            prevRMS = rms;
+
+            mat = RigidTransform(source, target) * mat;
+        }
+
+        _converged = converged;
+    }
+
+    return mat;
+}
+
+float MeshRegistration::FindPairs(const std::vector<Base::Vector3f>& points, const Base::Matrix4D& mat,
+                                  std::vector<Base::Vector3f>& source,
+                                  std::vector<Base::Vector3f>& target) const
+{
+    std::size_t count = points.size();
+    std::vector<Base::Vector3f> transformed(count), nearest(count);
+    std::vector<float> dist(count);
+
+    // the queries are independent and only read the hierarchy
+    Base::parallel_for(std::size_t(0), count, [&](std::size_t i) {
+        Base::Vector3f pnt = mat * points[i];
+        transformed[i] = pnt;
+        float fDist;
+        unsigned long facet = _bvh.NearestFacet(pnt, fDist);
+        if (facet == ULONG_MAX) {
+            dist[i] = FLT_MAX;
+            return;
+        }
+        dist[i] = _bvh.GetFacet(facet).DistanceToPoint(pnt, nearest[i]);
+    }, std::size_t(256));
+
+    // keep only the closest pairs
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::size_t keep = static_cast<std::size_t>(std::ceil(std::max(std::min(_trimRatio, 1.0f), 0.0f) * count));
+    keep = std::max<std::size_t>(std::min(keep, count), std::min<std::size_t>(count, 3));
+    std::nth_element(order.begin(), order.begin() + (keep - 1), order.end(),
+                     [&dist](std::size_t a, std::size_t b) { return dist[a] < dist[b]; });
+
+    source.clear();
+    target.clear();
+    double sum = 0.0;
+    for (std::size_t k = 0; k < keep; k++) {
+        std::size_t i = order[k];
+        if (dist[i] == FLT_MAX)
+            continue;
+        source.push_back(transformed[i]);
+        target.push_back(nearest[i]);
+        sum += static_cast<double>(dist[i]) * dist[i];
+    }
+
+    if (source.empty())
+        return FLT_MAX;
+    return static_cast<float>(std::sqrt(sum / source.size()));
+}
+
+Base::Matrix4D MeshRegistration::RigidTransform(const std::vector<Base::Vector3f>& source,
+                                                const std::vector<Base::Vector3f>& target)
+{
+    // least-squares rotation and translation (Kabsch), computed in double precision
+    Eigen::Vector3d cs(0, 0, 0), ct(0, 0, 0);
+    std::size_t count = source.size();
+    for (std::size_t i = 0; i < count; i++) {
+        cs += Eigen::Vector3d(source[i].x, source[i].y, source[i].z);
+        ct += Eigen::Vector3d(target[i].x, target[i].y, target[i].z);
+    }
+    cs /= static_cast<double>(count);
+    ct /= static_cast<double>(count);
+
+    Eigen::Matrix3d cov = Eigen::Matrix3d::Zero();
+    for (std::size_t i = 0; i < count; i++) {
+        Eigen::Vector3d s = Eigen::Vector3d(source[i].x, source[i].y, source[i].z) - cs;
+        Eigen::Vector3d t = Eigen::Vector3d(target[i].x, target[i].y, target[i].z) - ct;
+        cov += s * t.transpose();
+    }
+
+    Eigen::JacobiSVD<Eigen::Matrix3d> svd(cov, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    Eigen::Matrix3d u = svd.matrixU();
+    Eigen::Matrix3d v = svd.matrixV();
+    // avoid a reflection
+    if ((v * u.transpose()).determinant() < 0.0)
+        v.col(2) *= -1.0;
+    Eigen::Matrix3d rot = v * u.transpose();
+    Eigen::Vector3d move = ct - rot * cs;
+
+    Base::Matrix4D mat;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++)
+            mat[i][j] = rot(i, j);
+        mat[i][3] = move(i);
+    }
+    return mat;
+}
@@ -0,0 +1,130 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef MESH_REGISTRATION_H
+#define MESH_REGISTRATION_H
+
+#include <vector>
+
+#include "BVH.h"
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshRegistration class aligns a set of points, e.g. the points of a scanned
+ * mesh, to a nominal mesh with the iterative closest point (ICP) algorithm.
+ *
+ * The nominal mesh is put into a MeshFacetBVH once when the object is created, so it
+ * can be used for several alignments. In each iteration the nearest point on the
+ * nominal surface is searched for every point on the thread pool. Only the given ratio
+ * of the pairs with the smallest distances is used to compute the rigid transformation,
+ * so outliers and parts of the scan that are missing on the nominal mesh don't pull the
+ * result away (trimmed ICP).
+ *
+ * The alignment starts with a coarse subset of the points which is refined level by
+ * level, every level has four times as many points as the one before. Each level
+ * stops when the RMS distance doesn't improve by more than the tolerance any more.
+ */
+class MeshExport MeshRegistration
+{
+public:
+    /// The result of one iteration
+    struct Iteration
+    {
+        int level;
+        unsigned long points; /**< number of pairs used for the transformation */
+        float rms;            /**< RMS distance of these pairs before the transformation */
+    };
+
+    /// Construction
+    MeshRegistration(const MeshKernel& nominal);
+    /// Construction with the nominal mesh transformed by \a mat
+    MeshRegistration(const MeshKernel& nominal, const Base::Matrix4D& mat);
+    ~MeshRegistration();
+
+    /** @name Parameters */
+    //@{
+    /// Maximum number of iterations per level, the default is 50
+    void SetMaxIterations(int iter)
+    { _maxIter = iter; }
+    /// Number of levels, the default is 3
+    void SetLevels(int levels)
+    { _levels = levels; }
+    /// Maximum number of points used on the finest level, the default is 50000
+    void SetMaxPoints(unsigned long points)
+    { _maxPoints = points; }
+    /// Ratio of the closest pairs that are kept in each iteration, the default is 0.9
+    void SetTrimRatio(float ratio)
+    { _trimRatio = ratio; }
+    /// Relative change of the RMS distance at which a level is finished, the default is 1e-4
+    void SetTolerance(float tol)
+    { _tolerance = tol; }
+    //@}
+
+    /** Aligns \a points to the nominal mesh, starting with the transformation \a start.
+     * Returns the transformation that maps the points onto the nominal mesh.
+     */
+    Base::Matrix4D Align(const std::vector<Base::Vector3f>& points,
+                         const Base::Matrix4D& start = Base::Matrix4D());
+
+    /** @name Result of the last alignment */
+    //@{
+    /// True if the finest level has converged before reaching the maximum number of iterations
+    bool Converged() const
+    { return _converged; }
+    /// RMS distance of the trimmed pairs after the last iteration
+    float GetRMS() const
+    { return _rms; }
+    const std::vector<Iteration>& GetIterations() const
+    { return _iterations; }
+    //@}
+
+private:
+    float FindPairs(const std::vector<Base::Vector3f>& points, const Base::Matrix4D& mat,
+                    std::vector<Base::Vector3f>& source, std::vector<Base::Vector3f>& target) const;
+    static Base::Matrix4D RigidTransform(const std::vector<Base::Vector3f>& source,
+                                         const std::vector<Base::Vector3f>& target);
+
+private:
+    MeshFacetBVH _bvh;
+    int _maxIter;
+    int _levels;
+    unsigned long _maxPoints;
+    float _trimRatio;
+    float _tolerance;
+
+    bool _converged;
+    float _rms;
+    std::vector<Iteration> _iterations;
+
+    MeshRegistration(const MeshRegistration&);
+    void operator= (const MeshRegistration&);
+};
+
+} // namespace MeshCore
+
+
+#endif  // MESH_REGISTRATION_H
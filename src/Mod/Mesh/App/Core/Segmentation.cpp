@@ -31,6 +31,16 @@
 
 using namespace MeshCore;
 
+namespace {
+// The fits of cylinders and spheres are iterative and use all points. Instead
+// of refitting them for every added facet wait until the point set has grown
+// by a tenth.
+unsigned long nextFitCount(unsigned long count)
+{
+    return count + count / 10;
+}
+}
+
 void MeshSurfaceSegment::Initialize(unsigned long)
 {
 }
@@ -64,31 +74,35 @@ MeshSegment MeshSurfaceSegment::FindSegment(unsigned long index) const
 // --------------------------------------------------------
 
 MeshDistancePlanarSegment::MeshDistancePlanarSegment(const MeshKernel& mesh, unsigned long minFacets, float tol)
-  : MeshDistanceSurfaceSegment(mesh, minFacets, tol), fitter(new PlaneFit)
+  : MeshDistanceSurfaceSegment(mesh, minFacets, tol), fitter(new PlaneFit), moments(new PointMoments)
 {
 }
 
 MeshDistancePlanarSegment::~MeshDistancePlanarSegment()
 {
     delete fitter;
+    delete moments;
 }
 
 void MeshDistancePlanarSegment::Initialize(unsigned long index)
 {
     fitter->Clear();
+    moments->Clear();
 
     MeshGeomFacet triangle = kernel.GetFacet(index);
     basepoint = triangle.GetGravityPoint();
     normal = triangle.GetNormal();
-    fitter->AddPoint(triangle._aclPoints[0]);
-    fitter->AddPoint(triangle._aclPoints[1]);
-    fitter->AddPoint(triangle._aclPoints[2]);
+    for (int i=0; i<3; i++) {
+        fitter->AddPoint(triangle._aclPoints[i]);
+        moments->Add(triangle._aclPoints[i]);
+    }
 }
 
 bool MeshDistancePlanarSegment::TestFacet (const MeshFacet& face) const
 {
+    // the plane is computed from the accumulated moments in constant time
     if (!fitter->Done())
-        fitter->Fit();
+        fitter->Fit(*moments);
     MeshGeomFacet triangle = kernel.GetFacet(face);
     for (int i=0; i<3; i++) {
         if (fabs(fitter->GetDistanceToPlane(triangle._aclPoints[i])) > tolerance)
@@ -101,13 +115,16 @@ bool MeshDistancePlanarSegment::TestFacet (const MeshFacet& face) const
 void MeshDistancePlanarSegment::AddFacet(const MeshFacet& face)
 {
     MeshGeomFacet triangle = kernel.GetFacet(face);
-    fitter->AddPoint(triangle.GetGravityPoint());
+    Base::Vector3f center = triangle.GetGravityPoint();
+    fitter->AddPoint(center);
+    moments->Add(center);
 }
 
 // --------------------------------------------------------
 
 PlaneSurfaceFit::PlaneSurfaceFit()
     : fitter(new PlaneFit)
+    , moments(new PointMoments)
 {
 }
 
@@ -115,12 +132,14 @@ PlaneSurfaceFit::PlaneSurfaceFit(const Base::Vector3f& b, const Base::Vector3f&
     : basepoint(b)
     , normal(n)
     , fitter(nullptr)
+    , moments(nullptr)
 {
 }
 
 PlaneSurfaceFit::~PlaneSurfaceFit()
 {
     delete fitter;
+    delete moments;
 }
 
 void PlaneSurfaceFit::Initialize(const MeshCore::MeshGeomFacet& tria)
@@ -130,11 +149,13 @@ void PlaneSurfaceFit::Initialize(const MeshCore::MeshGeomFacet& tria)
         normal = tria.GetNormal();
 
         fitter->Clear();
+        moments->Clear();
 
-        fitter->AddPoint(tria._aclPoints[0]);
-        fitter->AddPoint(tria._aclPoints[1]);
-        fitter->AddPoint(tria._aclPoints[2]);
-        fitter->Fit();
+        for (int i=0; i<3; i++) {
+            fitter->AddPoint(tria._aclPoints[i]);
+            moments->Add(tria._aclPoints[i]);
+        }
+        fitter->Fit(*moments);
     }
 }
 
@@ -145,8 +166,11 @@ bool PlaneSurfaceFit::TestTriangle(const MeshGeomFacet&) const
 
 void PlaneSurfaceFit::AddTriangle(const MeshCore::MeshGeomFacet& tria)
 {
-    if (fitter)
-        fitter->AddPoint(tria.GetGravityPoint());
+    if (fitter) {
+        Base::Vector3f center = tria.GetGravityPoint();
+        fitter->AddPoint(center);
+        moments->Add(center);
+    }
 }
 
 bool PlaneSurfaceFit::Done() const
@@ -162,7 +186,7 @@ float PlaneSurfaceFit::Fit()
     if (!fitter)
         return 0;
     else
-        return fitter->Fit();
+        return fitter->Fit(*moments);
 }
 
 float PlaneSurfaceFit::GetDistanceToSurface(const Base::Vector3f& pnt) const
@@ -196,6 +220,8 @@ std::vector<float> PlaneSurfaceFit::Parameters() const
 
 CylinderSurfaceFit::CylinderSurfaceFit()
     : fitter(new CylinderFit)
+    , nextFit(0)
+    , hasFit(false)
 {
     axis.Set(0,0,0);
     radius = FLOAT_MAX;
@@ -210,6 +236,8 @@ CylinderSurfaceFit::CylinderSurfaceFit(const Base::Vector3f& b, const Base::Vect
     , axis(a)
     , radius(r)
     , fitter(nullptr)
+    , nextFit(0)
+    , hasFit(false)
 {
 }
 
@@ -221,6 +249,8 @@ CylinderSurfaceFit::~CylinderSurfaceFit()
 void CylinderSurfaceFit::Initialize(const MeshCore::MeshGeomFacet& tria)
 {
     if (fitter) {
+        nextFit = 0;
+        hasFit = false;
         fitter->Clear();
         fitter->AddPoint(tria._aclPoints[0]);
         fitter->AddPoint(tria._aclPoints[1]);
@@ -248,7 +278,7 @@ bool CylinderSurfaceFit::TestTriangle(const MeshGeomFacet& tria) const
 bool CylinderSurfaceFit::Done() const
 {
     if (fitter) {
-        return fitter->Done();
+        return fitter->Done() || fitter->CountPoints() < nextFit;
     }
 
     return true;
@@ -260,6 +290,8 @@ float CylinderSurfaceFit::Fit()
         return 0;
 
     float fit = fitter->Fit();
+    nextFit = nextFitCount(fitter->CountPoints());
+    hasFit = hasFit || fitter->Done();
     if (fit < FLOAT_MAX) {
         basepoint = fitter->GetBase();
         axis = fitter->GetAxis();
@@ -270,7 +302,7 @@ float CylinderSurfaceFit::Fit()
 
 float CylinderSurfaceFit::GetDistanceToSurface(const Base::Vector3f& pnt) const
 {
-    if (fitter && !fitter->Done()) {
+    if (fitter && !hasFit) {
         // collect some points
         return 0;
     }
@@ -304,6 +336,7 @@ std::vector<float> CylinderSurfaceFit::Parameters() const
 
 SphereSurfaceFit::SphereSurfaceFit()
     : fitter(new SphereFit)
+    , nextFit(0)
 {
     center.Set(0,0,0);
     radius = FLOAT_MAX;
@@ -313,6 +346,7 @@ SphereSurfaceFit::SphereSurfaceFit(const Base::Vector3f& c, float r)
     : center(c)
     , radius(r)
     , fitter(0)
+    , nextFit(0)
 {
 
 }
@@ -325,6 +359,7 @@ SphereSurfaceFit::~SphereSurfaceFit()
 void SphereSurfaceFit::Initialize(const MeshCore::MeshGeomFacet& tria)
 {
     if (fitter) {
+        nextFit = 0;
         fitter->Clear();
         fitter->AddPoint(tria._aclPoints[0]);
         fitter->AddPoint(tria._aclPoints[1]);
@@ -350,7 +385,7 @@ bool SphereSurfaceFit::TestTriangle(const MeshGeomFacet&) const
 bool SphereSurfaceFit::Done() const
 {
     if (fitter) {
-        return fitter->Done();
+        return fitter->Done() || fitter->CountPoints() < nextFit;
     }
 
     return true;
@@ -362,6 +397,7 @@ float SphereSurfaceFit::Fit()
         return 0;
 
     float fit = fitter->Fit();
+    nextFit = nextFitCount(fitter->CountPoints());
     if (fit < FLOAT_MAX) {
         center = fitter->GetCenter();
         radius = fitter->GetRadius();
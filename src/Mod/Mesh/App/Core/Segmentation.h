@@ -32,6 +32,7 @@
 namespace MeshCore {
 
 class PlaneFit;
+struct PointMoments;
 class CylinderFit;
 class SphereFit;
 class MeshFacet;
@@ -85,6 +86,7 @@ protected:
     Base::Vector3f basepoint;
     Base::Vector3f normal;
     PlaneFit* fitter;
+    PointMoments* moments;
 };
 
 class MeshExport AbstractSurfaceFit
@@ -121,6 +123,7 @@ private:
     Base::Vector3f basepoint;
     Base::Vector3f normal;
     PlaneFit* fitter;
+    PointMoments* moments;
 };
 
 class MeshExport CylinderSurfaceFit : public AbstractSurfaceFit
@@ -143,6 +146,8 @@ private:
     Base::Vector3f axis;
     float radius;
     CylinderFit* fitter;
+    unsigned long nextFit;
+    bool hasFit;
 };
 
 class MeshExport SphereSurfaceFit : public AbstractSurfaceFit
@@ -164,6 +169,7 @@ private:
     Base::Vector3f center;
     float radius;
     SphereFit* fitter;
+    unsigned long nextFit;
 };
 
 class MeshExport MeshDistanceGenericSurfaceFitSegment : public MeshDistanceSurfaceSegment
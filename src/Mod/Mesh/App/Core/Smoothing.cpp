@@ -23,6 +23,8 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <memory>
 #endif
 
 #include "Smoothing.h"
@@ -32,15 +34,162 @@
 #include "Iterator.h"
 #include "Approximation.h"
 
+#include <QtConcurrentMap>
+
 
 using namespace MeshCore;
 
+namespace MeshCore {
+
+/**
+ * Gives access to the neighbourhood passed to a smoothing algorithm or
+ * builds the missing structures on demand.
+ */
+class Neighbourhood
+{
+public:
+    Neighbourhood(const MeshKernel& kernel,
+                  const MeshRefPointToPoints* vv,
+                  const MeshRefPointToFacets* vf)
+      : kernel(kernel), vv_it(vv), vf_it(vf)
+    {
+    }
+
+    const MeshRefPointToPoints& pointToPoints()
+    {
+        if (!vv_it) {
+            vv_own.reset(new MeshRefPointToPoints(kernel));
+            vv_it = vv_own.get();
+        }
+        return *vv_it;
+    }
+
+    const MeshRefPointToFacets& pointToFacets()
+    {
+        if (!vf_it) {
+            vf_own.reset(new MeshRefPointToFacets(kernel));
+            vf_it = vf_own.get();
+        }
+        return *vf_it;
+    }
+
+private:
+    const MeshKernel& kernel;
+    const MeshRefPointToPoints* vv_it;
+    const MeshRefPointToFacets* vf_it;
+    std::unique_ptr<MeshRefPointToPoints> vv_own;
+    std::unique_ptr<MeshRefPointToFacets> vf_own;
+};
+
+/**
+ * Umbrella operator working on a flat adjacency array of the points to be
+ * moved. All points are moved at once so that each iteration can be
+ * processed in parallel.
+ */
+class UmbrellaOperator
+{
+public:
+    UmbrellaOperator(const MeshKernel& kernel, Neighbourhood& nb)
+    {
+        const MeshRefPointToPoints& vv_it = nb.pointToPoints();
+        const MeshRefPointToFacets& vf_it = nb.pointToFacets();
+        unsigned long numPoints = kernel.CountPoints();
+        for (unsigned long pos = 0; pos < numPoints; pos++)
+            addPoint(vv_it, vf_it, pos);
+        init(kernel);
+    }
+    UmbrellaOperator(const MeshKernel& kernel, Neighbourhood& nb,
+                     const std::vector<unsigned long>& point_indices)
+    {
+        const MeshRefPointToPoints& vv_it = nb.pointToPoints();
+        const MeshRefPointToFacets& vf_it = nb.pointToFacets();
+        for (std::vector<unsigned long>::const_iterator pos = point_indices.begin(); pos != point_indices.end(); ++pos)
+            addPoint(vv_it, vf_it, *pos);
+        init(kernel);
+    }
+
+    void apply(double stepsize)
+    {
+        QtConcurrent::blockingMap(blocks, [this, stepsize](const std::pair<std::size_t, std::size_t>& block) {
+            for (std::size_t i = block.first; i < block.second; i++) {
+                unsigned long pos = indices[i];
+                const Base::Vector3f& pnt = current[pos];
+                double w = 1.0/double(offsets[i+1] - offsets[i]);
+
+                double delx=0.0,dely=0.0,delz=0.0;
+                for (std::size_t j = offsets[i]; j < offsets[i+1]; j++) {
+                    const Base::Vector3f& nb = current[neighbours[j]];
+                    delx += static_cast<double>(nb.x-pnt.x);
+                    dely += static_cast<double>(nb.y-pnt.y);
+                    delz += static_cast<double>(nb.z-pnt.z);
+                }
+
+                Base::Vector3f& res = result[pos];
+                res.x = static_cast<float>(static_cast<double>(pnt.x)+stepsize*w*delx);
+                res.y = static_cast<float>(static_cast<double>(pnt.y)+stepsize*w*dely);
+                res.z = static_cast<float>(static_cast<double>(pnt.z)+stepsize*w*delz);
+            }
+        });
+
+        // only the moved points differ in both arrays
+        current.swap(result);
+    }
+
+    void assign(MeshKernel& kernel) const
+    {
+        for (std::vector<unsigned long>::const_iterator it = indices.begin(); it != indices.end(); ++it)
+            kernel.SetPoint(*it, current[*it]);
+    }
+
+private:
+    void addPoint(const MeshRefPointToPoints& vv_it,
+                  const MeshRefPointToFacets& vf_it, unsigned long pos)
+    {
+        const std::set<unsigned long>& cv = vv_it[pos];
+        if (cv.size() < 3)
+            return;
+        if (cv.size() != vf_it[pos].size()) {
+            // do nothing for border points
+            return;
+        }
+
+        if (offsets.empty())
+            offsets.push_back(0);
+        indices.push_back(pos);
+        neighbours.insert(neighbours.end(), cv.begin(), cv.end());
+        offsets.push_back(neighbours.size());
+    }
+
+    void init(const MeshKernel& kernel)
+    {
+        const MeshPointArray& points = kernel.GetPoints();
+        current.assign(points.begin(), points.end());
+        result = current;
+
+        const std::size_t blockSize = 4096;
+        for (std::size_t i = 0; i < indices.size(); i += blockSize)
+            blocks.emplace_back(i, std::min(i + blockSize, indices.size()));
+    }
+
+private:
+    std::vector<unsigned long> indices;
+    std::vector<std::size_t> offsets;
+    std::vector<unsigned long> neighbours;
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    std::vector<Base::Vector3f> current;
+    std::vector<Base::Vector3f> result;
+};
+
+}
+
 
 AbstractSmoothing::AbstractSmoothing(MeshKernel& m)
   : kernel(m)
   , tolerance(0)
   , component(Normal)
   , continuity(C0)
+  , pointToPoints(nullptr)
+  , pointToFacets(nullptr)
 {
 }
 
@@ -54,6 +203,13 @@ void AbstractSmoothing::initialize(Component comp, Continuity cont)
     this->continuity = cont;
 }
 
+void AbstractSmoothing::SetNeighbourhood(const MeshRefPointToPoints* vv,
+                                         const MeshRefPointToFacets* vf)
+{
+    this->pointToPoints = vv;
+    this->pointToFacets = vf;
+}
+
 PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
   : AbstractSmoothing(m)
 {
@@ -69,7 +225,8 @@ void PlaneFitSmoothing::Smooth(unsigned int iterations)
     MeshCore::MeshPointArray PointArray = kernel.GetPoints();
 
     MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
+    Neighbourhood nb(kernel, pointToPoints, pointToFacets);
+    const MeshCore::MeshRefPointToPoints& vv_it = nb.pointToPoints();
     MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
 
     for (unsigned int i=0; i<iterations; i++) {
@@ -122,7 +279,8 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<
     MeshCore::MeshPointArray PointArray = kernel.GetPoints();
 
     MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
+    Neighbourhood nb(kernel, pointToPoints, pointToFacets);
+    const MeshCore::MeshRefPointToPoints& vv_it = nb.pointToPoints();
     MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
 
     for (unsigned int i=0; i<iterations; i++) {
@@ -171,7 +329,7 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<
 }
 
 LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
-  : AbstractSmoothing(m), lambda(0.6307)
+  : AbstractSmoothing(m), lambda(0.6307), parallel(false)
 {
 }
 
@@ -252,8 +410,18 @@ void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    Neighbourhood nb(kernel, pointToPoints, pointToFacets);
+    if (parallel) {
+        UmbrellaOperator op(kernel, nb);
+        for (unsigned int i=0; i<iterations; i++) {
+            op.apply(lambda);
+        }
+        op.assign(kernel);
+        return;
+    }
+
+    const MeshCore::MeshRefPointToPoints& vv_it = nb.pointToPoints();
+    const MeshCore::MeshRefPointToFacets& vf_it = nb.pointToFacets();
 
     for (unsigned int i=0; i<iterations; i++) {
         Umbrella(vv_it, vf_it, lambda);
@@ -262,8 +430,18 @@ void LaplaceSmoothing::Smooth(unsigned int iterations)
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    Neighbourhood nb(kernel, pointToPoints, pointToFacets);
+    if (parallel) {
+        UmbrellaOperator op(kernel, nb, point_indices);
+        for (unsigned int i=0; i<iterations; i++) {
+            op.apply(lambda);
+        }
+        op.assign(kernel);
+        return;
+    }
+
+    const MeshCore::MeshRefPointToPoints& vv_it = nb.pointToPoints();
+    const MeshCore::MeshRefPointToFacets& vf_it = nb.pointToFacets();
 
     for (unsigned int i=0; i<iterations; i++) {
         Umbrella(vv_it, vf_it, lambda, point_indices);
@@ -281,11 +459,23 @@ TaubinSmoothing::~TaubinSmoothing()
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
+
+    Neighbourhood nb(kernel, pointToPoints, pointToFacets);
+    if (parallel) {
+        UmbrellaOperator op(kernel, nb);
+        for (unsigned int i=0; i<iterations; i++) {
+            op.apply(lambda);
+            op.apply(-(lambda+micro));
+        }
+        op.assign(kernel);
+        return;
+    }
+
+    const MeshCore::MeshRefPointToPoints& vv_it = nb.pointToPoints();
+    const MeshCore::MeshRefPointToFacets& vf_it = nb.pointToFacets();
+
     for (unsigned int i=0; i<iterations; i++) {
         Umbrella(vv_it, vf_it, lambda);
         Umbrella(vv_it, vf_it, -(lambda+micro));
@@ -294,11 +484,23 @@ void TaubinSmoothing::Smooth(unsigned int iterations)
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
+
+    Neighbourhood nb(kernel, pointToPoints, pointToFacets);
+    if (parallel) {
+        UmbrellaOperator op(kernel, nb, point_indices);
+        for (unsigned int i=0; i<iterations; i++) {
+            op.apply(lambda);
+            op.apply(-(lambda+micro));
+        }
+        op.assign(kernel);
+        return;
+    }
+
+    const MeshCore::MeshRefPointToPoints& vv_it = nb.pointToPoints();
+    const MeshCore::MeshRefPointToFacets& vf_it = nb.pointToFacets();
+
     for (unsigned int i=0; i<iterations; i++) {
         Umbrella(vv_it, vf_it, lambda, point_indices);
         Umbrella(vv_it, vf_it, -(lambda+micro), point_indices);
@@ -51,6 +51,11 @@ public:
     AbstractSmoothing(MeshKernel&);
     virtual ~AbstractSmoothing();
     void initialize(Component comp, Continuity cont);
+    /** Uses the given neighbourhood of the mesh kernel instead of building it
+     * for each call of Smooth() or SmoothPoints(). Since smoothing only moves
+     * points, the structures stay valid and may be shared between calls.
+     */
+    void SetNeighbourhood(const MeshRefPointToPoints*, const MeshRefPointToFacets*);
 
     /** Smooth the triangle mesh. */
     virtual void Smooth(unsigned int) = 0;
@@ -62,6 +67,8 @@ protected:
     float tolerance;
     Component   component;
     Continuity  continuity;
+    const MeshRefPointToPoints* pointToPoints;
+    const MeshRefPointToFacets* pointToFacets;
 };
 
 class MeshExport PlaneFitSmoothing : public AbstractSmoothing
@@ -81,6 +88,11 @@ public:
     void Smooth(unsigned int);
     void SmoothPoints(unsigned int, const std::vector<unsigned long>&);
     void SetLambda(double l) { lambda = l;}
+    /** If enabled all points are moved at once (Jacobi iteration) which allows
+     * to process them in parallel. Otherwise the moved points are directly used
+     * for their neighbours (Gauss-Seidel iteration). Default is off.
+     */
+    void SetParallel(bool on) { parallel = on;}
 
 protected:
     void Umbrella(const MeshRefPointToPoints&,
@@ -91,6 +103,7 @@ protected:
 
 protected:
     double lambda;
+    bool parallel;
 };
 
 class MeshExport TaubinSmoothing : public LaplaceSmoothing
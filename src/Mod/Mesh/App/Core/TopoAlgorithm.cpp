@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <memory>
 # include <utility>
 # include <queue>
 #endif
@@ -40,6 +41,7 @@
 #include "Triangulation.h"
 #include "Definitions.h"
 #include <Base/Console.h>
+#include <Base/ThreadPool.h>
 
 using namespace MeshCore;
 
@@ -1528,14 +1530,45 @@ void MeshTopoAlgorithm::FillupHoles(int level, AbstractPolygonTriangulator& cTri
     MeshRefPointToFacets cPt2Fac(_rclMesh);
     MeshAlgorithm cAlgo(_rclMesh);
 
+    // The holes are triangulated independently and this only reads the mesh, so it's
+    // done in parallel with a copy of the triangulator per hole. The patches are added
+    // afterwards in the order of the boundaries, so the result is the same as before.
+    struct Patch {
+        MeshFacetArray facets;
+        MeshPointArray points;
+        bool filled = false;
+    };
+    std::vector<const std::vector<unsigned long>*> bounds;
+    for (std::list<std::vector<unsigned long> >::const_iterator it = aBorders.begin(); it != aBorders.end(); ++it)
+        bounds.push_back(&*it);
+    std::vector<Patch> patches(bounds.size());
+
+    std::unique_ptr<AbstractPolygonTriangulator> copy;
+    if (bounds.size() > 1)
+        copy.reset(cTria.Clone());
+    if (copy) {
+        Base::parallel_for(std::size_t(0), bounds.size(), [&](std::size_t i) {
+            std::unique_ptr<AbstractPolygonTriangulator> tria(cTria.Clone());
+            Patch& patch = patches[i];
+            patch.filled = cAlgo.FillupHole(*bounds[i], *tria, patch.facets, patch.points, level, &cPt2Fac);
+        });
+    }
+    else {
+        // the triangulator can't be copied
+        for (std::size_t i = 0; i < bounds.size(); i++) {
+            Patch& patch = patches[i];
+            patch.filled = cAlgo.FillupHole(*bounds[i], cTria, patch.facets, patch.points, level, &cPt2Fac);
+        }
+    }
+
     MeshFacetArray newFacets;
     MeshPointArray newPoints;
     unsigned long numberOfOldPoints = _rclMesh._aclPointArray.size();
-    for (std::list<std::vector<unsigned long> >::const_iterator it = aBorders.begin(); it != aBorders.end(); ++it) {
-        MeshFacetArray cFacets;
-        MeshPointArray cPoints;
-        std::vector<unsigned long> bound = *it;
-        if (cAlgo.FillupHole(bound, cTria, cFacets, cPoints, level, &cPt2Fac)) {
+    for (std::size_t i = 0; i < bounds.size(); i++) {
+        MeshFacetArray& cFacets = patches[i].facets;
+        MeshPointArray& cPoints = patches[i].points;
+        std::vector<unsigned long> bound = *bounds[i];
+        if (patches[i].filled) {
             if (bound.front() == bound.back())
                 bound.pop_back();
             // the triangulation may produce additional points which we must take into account when appending to the mesh
@@ -1543,7 +1576,7 @@ void MeshTopoAlgorithm::FillupHoles(int level, AbstractPolygonTriangulator& cTri
                 unsigned long countBoundaryPoints = bound.size();
                 unsigned long countDifference = cPoints.size() - countBoundaryPoints;
                 MeshPointArray::_TIterator pt = cPoints.begin() + countBoundaryPoints;
-                for (unsigned long i=0; i<countDifference; i++, pt++) {
+                for (unsigned long k=0; k<countDifference; k++, pt++) {
                     bound.push_back(numberOfOldPoints++);
                     newPoints.push_back(*pt);
                 }
@@ -1563,7 +1596,7 @@ void MeshTopoAlgorithm::FillupHoles(int level, AbstractPolygonTriangulator& cTri
             }
         }
         else {
-            aFailed.push_back(*it);
+            aFailed.push_back(*bounds[i]);
         }
     }
 
@@ -245,6 +245,7 @@ public:
      * Closes holes in the mesh that consists of up to \a length edges. In case a fit 
      * needs to be done then the points of the neighbours of \a level rings will be used.
      * Holes for which the triangulation failed are returned in \a aFailed.
+     * If the triangulator can be cloned the holes are triangulated in parallel.
      */
     void FillupHoles(unsigned long length, int level,
         AbstractPolygonTriangulator&,
@@ -99,6 +99,25 @@ void AbstractPolygonTriangulator::SetVerifier(TriangulationVerifier* v)
     _verifier = v;
 }
 
+AbstractPolygonTriangulator* AbstractPolygonTriangulator::Clone() const
+{
+    return nullptr;
+}
+
+AbstractPolygonTriangulator* AbstractPolygonTriangulator::CopyVerifier(AbstractPolygonTriangulator* tria) const
+{
+    TriangulationVerifier* verifier = nullptr;
+    if (_verifier) {
+        verifier = _verifier->Clone();
+        if (!verifier) {
+            delete tria;
+            return nullptr;
+        }
+    }
+    tria->SetVerifier(verifier);
+    return tria;
+}
+
 void AbstractPolygonTriangulator::SetPolygon(const std::vector<Base::Vector3f>& raclPoints)
 {
     this->_points = raclPoints;
@@ -286,6 +305,11 @@ EarClippingTriangulator::~EarClippingTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* EarClippingTriangulator::Clone() const
+{
+    return CopyVerifier(new EarClippingTriangulator());
+}
+
 bool EarClippingTriangulator::Triangulate()
 {
     _facets.clear();
@@ -295,7 +319,8 @@ bool EarClippingTriangulator::Triangulate()
     std::vector<unsigned long> result;
 
     //  Invoke the triangulator to triangulate this polygon.
-    Triangulate::Process(pts,result);
+    bool invert = false;
+    Triangulate::Process(pts,result,invert);
 
     // print out the results.
     size_t tcount = result.size()/3;
@@ -307,7 +332,7 @@ bool EarClippingTriangulator::Triangulate()
     MeshGeomFacet clFacet;
     MeshFacet clTopFacet;
     for (unsigned long i=0; i<tcount; i++) {
-        if (Triangulate::_invert) {
+        if (invert) {
             clFacet._aclPoints[0] = _points[result[i*3+0]];
             clFacet._aclPoints[2] = _points[result[i*3+1]];
             clFacet._aclPoints[1] = _points[result[i*3+2]];
@@ -395,10 +420,9 @@ bool EarClippingTriangulator::Triangulate::Snip(const std::vector<Base::Vector3f
     return true;
 }
 
-bool EarClippingTriangulator::Triangulate::_invert = false;
-
 bool EarClippingTriangulator::Triangulate::Process(const std::vector<Base::Vector3f> &contour,
-                                                   std::vector<unsigned long> &result)
+                                                   std::vector<unsigned long> &result,
+                                                   bool &invert)
 {
     /* allocate and initialize list of Vertices in polygon */
 
@@ -411,12 +435,12 @@ bool EarClippingTriangulator::Triangulate::Process(const std::vector<Base::Vecto
 
     if (0.0f < Area(contour)) {
         for (int v=0; v<n; v++) V[v] = v;
-        _invert = true;
+        invert = true;
     }
 //    for(int v=0; v<n; v++) V[v] = (n-1)-v;
     else {
         for(int v=0; v<n; v++) V[v] = (n-1)-v;
-        _invert = false;
+        invert = false;
     }
 
     int nv = n;
@@ -476,6 +500,11 @@ QuasiDelaunayTriangulator::~QuasiDelaunayTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* QuasiDelaunayTriangulator::Clone() const
+{
+    return CopyVerifier(new QuasiDelaunayTriangulator());
+}
+
 bool QuasiDelaunayTriangulator::Triangulate()
 {
     if (EarClippingTriangulator::Triangulate() == false)
@@ -630,6 +659,11 @@ DelaunayTriangulator::~DelaunayTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* DelaunayTriangulator::Clone() const
+{
+    return CopyVerifier(new DelaunayTriangulator());
+}
+
 bool DelaunayTriangulator::Triangulate()
 {
     // before starting the triangulation we must make sure that all polygon 
@@ -702,6 +736,11 @@ FlatTriangulator::~FlatTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* FlatTriangulator::Clone() const
+{
+    return CopyVerifier(new FlatTriangulator());
+}
+
 bool FlatTriangulator::Triangulate()
 {
     _newpoints.clear();
@@ -746,6 +785,11 @@ ConstraintDelaunayTriangulator::~ConstraintDelaunayTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* ConstraintDelaunayTriangulator::Clone() const
+{
+    return CopyVerifier(new ConstraintDelaunayTriangulator(fMaxArea));
+}
+
 bool ConstraintDelaunayTriangulator::Triangulate()
 {
     _newpoints.clear();
@@ -36,6 +36,9 @@ class MeshExport TriangulationVerifier
 public:
     TriangulationVerifier() {}
     virtual ~TriangulationVerifier() {}
+    /** Returns a copy of the verifier, subclasses must reimplement it. */
+    virtual TriangulationVerifier* Clone() const
+    { return new TriangulationVerifier(*this); }
     virtual bool Accept(const Base::Vector3f& n,
                         const Base::Vector3f& p1,
                         const Base::Vector3f& p2,
@@ -47,6 +50,8 @@ public:
 class MeshExport TriangulationVerifierV2 : public TriangulationVerifier
 {
 public:
+    virtual TriangulationVerifier* Clone() const
+    { return new TriangulationVerifierV2(*this); }
     virtual bool Accept(const Base::Vector3f& n,
                         const Base::Vector3f& p1,
                         const Base::Vector3f& p2,
@@ -61,6 +66,13 @@ public:
     AbstractPolygonTriangulator();
     virtual ~AbstractPolygonTriangulator();
 
+    /** Returns a new triangulator of the same type and with the same settings,
+     * e.g. to triangulate several polygons in parallel. The default implementation
+     * returns null, in which case the polygons must be triangulated one after
+     * the other.
+     */
+    virtual AbstractPolygonTriangulator* Clone() const;
+
     /** Sets the polygon to be triangulated. */
     void SetPolygon(const std::vector<Base::Vector3f>& raclPoints);
     void SetIndices(const std::vector<unsigned long>& d) {_indices = d;}
@@ -128,6 +140,8 @@ protected:
      */
     virtual bool Triangulate() = 0;
     void Done();
+    /** Gives \a tria a copy of the verifier, returns \a tria or null if the verifier can't be copied. */
+    AbstractPolygonTriangulator* CopyVerifier(AbstractPolygonTriangulator* tria) const;
 
 protected:
     bool                        _discard;
@@ -150,6 +164,7 @@ class MeshExport EarClippingTriangulator : public AbstractPolygonTriangulator
 public:
     EarClippingTriangulator();
     ~EarClippingTriangulator();
+    AbstractPolygonTriangulator* Clone() const;
 
 protected:
     bool Triangulate();
@@ -168,9 +183,10 @@ private:
     {
     public:
         // triangulate a contour/polygon, places results in STL vector
-        // as series of triangles.indicating the points
+        // as series of triangles.indicating the points, invert is set if
+        // the orientation of the triangles must be reversed
         static bool Process(const std::vector<Base::Vector3f> &contour,
-            std::vector<unsigned long> &result);
+            std::vector<unsigned long> &result, bool &invert);
 
         // compute area of a contour/polygon
         static float Area(const std::vector<Base::Vector3f> &contour);
@@ -180,7 +196,6 @@ private:
         static bool InsideTriangle(float Ax, float Ay, float Bx, float By,
             float Cx, float Cy, float Px, float Py);
 
-        static bool _invert;
     private:
         static bool Snip(const std::vector<Base::Vector3f> &contour,
             int u,int v,int w,int n,int *V);
@@ -192,6 +207,7 @@ class MeshExport QuasiDelaunayTriangulator : public EarClippingTriangulator
 public:
     QuasiDelaunayTriangulator();
     ~QuasiDelaunayTriangulator();
+    AbstractPolygonTriangulator* Clone() const;
 
 protected:
     bool Triangulate();
@@ -202,6 +218,7 @@ class MeshExport DelaunayTriangulator : public AbstractPolygonTriangulator
 public:
     DelaunayTriangulator();
     ~DelaunayTriangulator();
+    AbstractPolygonTriangulator* Clone() const;
 
 protected:
     bool Triangulate();
@@ -212,6 +229,7 @@ class MeshExport FlatTriangulator : public AbstractPolygonTriangulator
 public:
     FlatTriangulator();
     ~FlatTriangulator();
+    AbstractPolygonTriangulator* Clone() const;
 
     void PostProcessing(const std::vector<Base::Vector3f>&);
 
@@ -224,6 +242,7 @@ class MeshExport ConstraintDelaunayTriangulator : public AbstractPolygonTriangul
 public:
     ConstraintDelaunayTriangulator(float area);
     ~ConstraintDelaunayTriangulator();
+    AbstractPolygonTriangulator* Clone() const;
 
 protected:
     bool Triangulate();
@@ -26,7 +26,7 @@
 #include "Trim.h"
 #include "Grid.h"
 #include "Iterator.h"
-#include <Base/Sequencer.h>
+#include <Base/ThreadPool.h>
 
 using namespace MeshCore;
 
@@ -53,10 +53,28 @@ void MeshTrimming::SetInnerOrOuter(TMode tMode)
     }
 }
 
+template <typename T>
+static std::vector<T> appendVector(std::vector<T> a, std::vector<T> b)
+{
+    a.insert(a.end(), b.begin(), b.end());
+    return a;
+}
+
 void MeshTrimming::CheckFacets(const MeshFacetGrid& rclGrid, std::vector<unsigned long> &raulFacets) const
 {
-    std::vector<unsigned long>::iterator it;
-    MeshFacetIterator clIter(myMesh, 0);
+    // The facets are checked in parallel, each chunk collects its facets in order
+    // so that the result is the same as with a sequential check.
+    auto checkFacets = [this](const std::vector<unsigned long>* indices, std::size_t count) {
+        return Base::parallel_reduce(std::size_t(0), count, std::vector<unsigned long>(),
+            [this, indices](std::size_t first, std::size_t last, std::vector<unsigned long> found) {
+                for (std::size_t i = first; i < last; i++) {
+                    unsigned long index = indices ? (*indices)[i] : static_cast<unsigned long>(i);
+                    if (HasIntersection(myMesh.GetFacet(index)))
+                        found.push_back(index);
+                }
+                return found;
+            }, appendVector<unsigned long>);
+    };
 
     // cut inner: use grid to accelerate search
     if (myInner) {
@@ -81,23 +99,13 @@ void MeshTrimming::CheckFacets(const MeshFacetGrid& rclGrid, std::vector<unsigne
         std::sort(aulAllElements.begin(), aulAllElements.end());
         aulAllElements.erase(std::unique(aulAllElements.begin(), aulAllElements.end()), aulAllElements.end());
 
-        Base::SequencerLauncher seq("Check facets for intersection...", aulAllElements.size());
-
-        for (it = aulAllElements.begin(); it != aulAllElements.end(); ++it) {
-            MeshGeomFacet clFacet = myMesh.GetFacet(*it);
-            if (HasIntersection(clFacet))
-                raulFacets.push_back(*it);
-            seq.next();
-        }
+        std::vector<unsigned long> found = checkFacets(&aulAllElements, aulAllElements.size());
+        raulFacets.insert(raulFacets.end(), found.begin(), found.end());
     }
     // cut outer
     else {
-        Base::SequencerLauncher seq("Check facets for intersection...", myMesh.CountFacets());
-        for (clIter.Init(); clIter.More(); clIter.Next()) {
-            if (HasIntersection(*clIter))
-                raulFacets.push_back(clIter.Position());
-            seq.next();
-        }
+        std::vector<unsigned long> found = checkFacets(nullptr, myMesh.CountFacets());
+        raulFacets.insert(raulFacets.end(), found.begin(), found.end());
     }
 }
 
@@ -718,29 +726,35 @@ bool MeshTrimming::CreateFacets(unsigned long ulFacetPos, int iSide, const std::
 
 void MeshTrimming::TrimFacets(const std::vector<unsigned long>& raulFacets, std::vector<MeshGeomFacet>& aclNewFacets)
 {
-    Base::Vector3f clP;
-    std::vector<Base::Vector3f> clIntsct;
-    int iSide;
-
-    Base::SequencerLauncher seq("trimming facets...", raulFacets.size());
-    for (std::vector<unsigned long>::const_iterator it=raulFacets.begin(); it!=raulFacets.end(); ++it) {
-        clIntsct.clear();
-        if (IsPolygonPointInFacet(*it, clP) == false) {
-            // facet must be trimmed
-            if (PolygonContainsCompleteFacet(myInner, *it) == false) {
-                // generate new facets
-                if (GetIntersectionPointsOfPolygonAndFacet(*it, iSide, clIntsct))
-                    CreateFacets(*it, iSide, clIntsct, myTriangles);
+    // Each facet is split independently and only the facet itself is modified, so
+    // the facets are split in parallel. The chunks are joined in order.
+    std::vector<MeshGeomFacet> triangles = Base::parallel_reduce(std::size_t(0), raulFacets.size(),
+        std::vector<MeshGeomFacet>(),
+        [this, &raulFacets](std::size_t first, std::size_t last, std::vector<MeshGeomFacet> created) {
+            Base::Vector3f clP;
+            std::vector<Base::Vector3f> clIntsct;
+            int iSide;
+            for (std::size_t i = first; i < last; i++) {
+                unsigned long index = raulFacets[i];
+                clIntsct.clear();
+                if (IsPolygonPointInFacet(index, clP) == false) {
+                    // facet must be trimmed
+                    if (PolygonContainsCompleteFacet(myInner, index) == false) {
+                        // generate new facets
+                        if (GetIntersectionPointsOfPolygonAndFacet(index, iSide, clIntsct))
+                            CreateFacets(index, iSide, clIntsct, created);
+                    }
+                }
+                // facet contains a polygon point
+                else {
+                    // generate new facets
+                    if (GetIntersectionPointsOfPolygonAndFacet(index, iSide, clIntsct))
+                        CreateFacets(index, iSide, clIntsct, clP, created);
+                }
             }
-        }
-        // facet contains a polygon point
-        else {
-            // generate new facets
-            if (GetIntersectionPointsOfPolygonAndFacet(*it, iSide, clIntsct))
-                CreateFacets(*it, iSide, clIntsct, clP, myTriangles);
-        }
-        seq.next();
-    }
+            return created;
+        }, appendVector<MeshGeomFacet>);
 
+    myTriangles.insert(myTriangles.end(), triangles.begin(), triangles.end());
     aclNewFacets = myTriangles;
 }
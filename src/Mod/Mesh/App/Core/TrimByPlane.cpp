@@ -26,6 +26,7 @@
 #include "TrimByPlane.h"
 #include "Grid.h"
 #include "Iterator.h"
+#include <Base/ThreadPool.h>
 
 using namespace MeshCore;
 
@@ -62,15 +63,27 @@ void MeshTrimByPlane::CheckFacets(const MeshFacetGrid& rclGrid, const Base::Vect
     std::sort(checkElements.begin(), checkElements.end());
     checkElements.erase(std::unique(checkElements.begin(), checkElements.end()), checkElements.end());
 
+    // classify the facets of the cut cells in parallel
+    enum Location : char { Keep, Trim, Remove };
+    std::vector<char> location(checkElements.size());
+    Base::parallel_for(std::size_t(0), checkElements.size(), [&](std::size_t i) {
+        MeshGeomFacet clFacet = myMesh.GetFacet(checkElements[i]);
+        if (clFacet.IntersectWithPlane(base, normal))
+            location[i] = Trim;
+        else if (clFacet._aclPoints[0].DistanceToPlane(base, normal) > 0.0f)
+            location[i] = Remove;
+        else
+            location[i] = Keep;
+    });
+
     trimFacets.reserve(checkElements.size()/2); // reserve some memory
-    for (auto it = checkElements.begin(); it != checkElements.end(); ++it) {
-        MeshGeomFacet clFacet = myMesh.GetFacet(*it);
-        if (clFacet.IntersectWithPlane(base, normal)) {
-            trimFacets.push_back(*it);
-            removeFacets.push_back(*it);
+    for (std::size_t i = 0; i < checkElements.size(); i++) {
+        if (location[i] == Trim) {
+            trimFacets.push_back(checkElements[i]);
+            removeFacets.push_back(checkElements[i]);
         }
-        else if (clFacet._aclPoints[0].DistanceToPlane(base, normal) > 0.0f) {
-            removeFacets.push_back(*it);
+        else if (location[i] == Remove) {
+            removeFacets.push_back(checkElements[i]);
         }
     }
 
@@ -137,32 +150,51 @@ void MeshTrimByPlane::CreateTwoFacet(const Base::Vector3f& base, const Base::Vec
 void MeshTrimByPlane::TrimFacets(const std::vector<unsigned long>& trimFacets, const Base::Vector3f& base,
                                  const Base::Vector3f& normal, std::vector<MeshGeomFacet>& trimmedFacets)
 {
-    trimmedFacets.reserve(2 * trimFacets.size());
-    for (auto it = trimFacets.begin(); it != trimFacets.end(); ++it) {
-        MeshGeomFacet facet = myMesh.GetFacet(*it);
-        float dist1 = facet._aclPoints[0].DistanceToPlane(base, normal);
-        float dist2 = facet._aclPoints[1].DistanceToPlane(base, normal);
-        float dist3 = facet._aclPoints[2].DistanceToPlane(base, normal);
-
-        // only one point below
-        if (dist1 < 0.0f && dist2 > 0.0f && dist3 > 0.0f) {
-            CreateOneFacet(base, normal, 0, facet, trimmedFacets);
-        }
-        else if (dist1 > 0.0f && dist2 < 0.0f && dist3 > 0.0f) {
-            CreateOneFacet(base, normal, 1, facet, trimmedFacets);
-        }
-        else if (dist1 > 0.0f && dist2 > 0.0f && dist3 < 0.0f) {
-            CreateOneFacet(base, normal, 2, facet, trimmedFacets);
-        }
-        // two points below
-        else if (dist1 < 0.0f && dist2 < 0.0f && dist3 > 0.0f) {
-            CreateTwoFacet(base, normal, 0, facet, trimmedFacets);
-        }
-        else if (dist1 > 0.0f && dist2 < 0.0f && dist3 < 0.0f) {
-            CreateTwoFacet(base, normal, 1, facet, trimmedFacets);
-        }
-        else if (dist1 < 0.0f && dist2 > 0.0f && dist3 < 0.0f) {
-            CreateTwoFacet(base, normal, 2, facet, trimmedFacets);
-        }
+    // split the facets in parallel and join the chunks in order
+    std::vector<MeshGeomFacet> created = Base::parallel_reduce(std::size_t(0), trimFacets.size(),
+        std::vector<MeshGeomFacet>(),
+        [&](std::size_t first, std::size_t last, std::vector<MeshGeomFacet> facets) {
+            facets.reserve(facets.size() + 2 * (last - first));
+            for (std::size_t i = first; i < last; i++)
+                TrimFacet(myMesh.GetFacet(trimFacets[i]), base, normal, facets);
+            return facets;
+        },
+        [](std::vector<MeshGeomFacet> a, std::vector<MeshGeomFacet> b) {
+            a.insert(a.end(), b.begin(), b.end());
+            return a;
+        });
+
+    if (trimmedFacets.empty())
+        trimmedFacets.swap(created);
+    else
+        trimmedFacets.insert(trimmedFacets.end(), created.begin(), created.end());
+}
+
+void MeshTrimByPlane::TrimFacet(const MeshGeomFacet& facet, const Base::Vector3f& base,
+                                const Base::Vector3f& normal, std::vector<MeshGeomFacet>& trimmedFacets) const
+{
+    float dist1 = facet._aclPoints[0].DistanceToPlane(base, normal);
+    float dist2 = facet._aclPoints[1].DistanceToPlane(base, normal);
+    float dist3 = facet._aclPoints[2].DistanceToPlane(base, normal);
+
+    // only one point below
+    if (dist1 < 0.0f && dist2 > 0.0f && dist3 > 0.0f) {
+        CreateOneFacet(base, normal, 0, facet, trimmedFacets);
+    }
+    else if (dist1 > 0.0f && dist2 < 0.0f && dist3 > 0.0f) {
+        CreateOneFacet(base, normal, 1, facet, trimmedFacets);
+    }
+    else if (dist1 > 0.0f && dist2 > 0.0f && dist3 < 0.0f) {
+        CreateOneFacet(base, normal, 2, facet, trimmedFacets);
+    }
+    // two points below
+    else if (dist1 < 0.0f && dist2 < 0.0f && dist3 > 0.0f) {
+        CreateTwoFacet(base, normal, 0, facet, trimmedFacets);
+    }
+    else if (dist1 > 0.0f && dist2 < 0.0f && dist3 < 0.0f) {
+        CreateTwoFacet(base, normal, 1, facet, trimmedFacets);
+    }
+    else if (dist1 < 0.0f && dist2 > 0.0f && dist3 < 0.0f) {
+        CreateTwoFacet(base, normal, 2, facet, trimmedFacets);
     }
 }
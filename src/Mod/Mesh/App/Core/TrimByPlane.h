@@ -52,6 +52,8 @@ public:
                     const Base::Vector3f& normal, std::vector<MeshGeomFacet>& trimmedFacets);
 
 private:
+    void TrimFacet(const MeshGeomFacet& facet, const Base::Vector3f& base, const Base::Vector3f& normal,
+                   std::vector<MeshGeomFacet>& trimmedFacets) const;
     void CreateOneFacet(const Base::Vector3f& base, const Base::Vector3f& normal, unsigned short shift,
                         const MeshGeomFacet& facet, std::vector<MeshGeomFacet>& trimmedFacets) const;
     void CreateTwoFacet(const Base::Vector3f& base, const Base::Vector3f& normal, unsigned short shift,
@@ -31,23 +31,51 @@
 using namespace MeshCore;
 
 
-unsigned long MeshKernel::VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, unsigned long ulStartFacet) const
+namespace {
+
+/* Keeps the visit state in the VISIT flag of the mesh elements */
+template <class Element>
+struct FlagMarker
+{
+    const std::vector<Element>& elements;
+    FlagMarker(const std::vector<Element>& elements) : elements(elements) {}
+    bool IsVisited(unsigned long index) const
+    { return elements[index].IsFlag(Element::VISIT); }
+    void SetVisited(unsigned long index) const
+    { elements[index].SetFlag(Element::VISIT); }
+};
+
+/* Keeps the visit state in a bitset owned by the caller */
+struct BitsetMarker
+{
+    std::vector<bool>& visited;
+    BitsetMarker(std::vector<bool>& visited, std::size_t size) : visited(visited)
+    { visited.resize(size, false); }
+    bool IsVisited(unsigned long index) const
+    { return visited[index]; }
+    void SetVisited(unsigned long index) const
+    { visited[index] = true; }
+};
+
+template <class Marker>
+unsigned long visitNeighbourFacets (const MeshFacetArray& rFacets, MeshFacetVisitor &rclFVisitor,
+                                    unsigned long ulStartFacet, const Marker& marker)
 {
     unsigned long ulVisited = 0, j, ulLevel = 0;
-    unsigned long ulCount = _aclFacetArray.size();
+    unsigned long ulCount = rFacets.size();
     std::vector<unsigned long> clCurrentLevel, clNextLevel;
     std::vector<unsigned long>::iterator  clCurrIter;  
     MeshFacetArray::_TConstIterator clCurrFacet, clNBFacet;
 
     // pick up start point
     clCurrentLevel.push_back(ulStartFacet);
-    _aclFacetArray[ulStartFacet].SetFlag(MeshFacet::VISIT);
+    marker.SetVisited(ulStartFacet);
 
     // as long as free neighbours
     while (clCurrentLevel.size() > 0) {
         // visit all neighbours of the current level
         for (clCurrIter = clCurrentLevel.begin(); clCurrIter < clCurrentLevel.end(); ++clCurrIter) {
-            clCurrFacet = _aclFacetArray.begin() + *clCurrIter;
+            clCurrFacet = rFacets.begin() + *clCurrIter;
 
             // visit all neighbours of the current level if not yet done
             for (unsigned short i = 0; i < 3; i++) {
@@ -58,17 +86,17 @@ unsigned long MeshKernel::VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, u
                 if (j >= ulCount) 
                     continue;      // error in data structure
 
-                clNBFacet = _aclFacetArray.begin() + j;
+                clNBFacet = rFacets.begin() + j;
 
                 if (!rclFVisitor.AllowVisit(*clNBFacet, *clCurrFacet, j, ulLevel, i))
                     continue;
-                if (clNBFacet->IsFlag(MeshFacet::VISIT) == true)
+                if (marker.IsVisited(j))
                     continue; // neighbour facet already visited
                 else {
                     // visit and mark
                     ulVisited++;
                     clNextLevel.push_back(j);
-                    clNBFacet->SetFlag(MeshFacet::VISIT);
+                    marker.SetVisited(j);
                     if (rclFVisitor.Visit(*clNBFacet, *clCurrFacet, j, ulLevel) == false)
                         return ulVisited;
                 }
@@ -83,16 +111,18 @@ unsigned long MeshKernel::VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, u
     return ulVisited;
 }
 
-unsigned long MeshKernel::VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rclFVisitor, unsigned long ulStartFacet) const
+template <class Marker>
+unsigned long visitNeighbourFacetsOverCorners (const MeshKernel& rMesh, MeshFacetVisitor &rclFVisitor,
+                                               unsigned long ulStartFacet, const Marker& marker)
 {
     unsigned long ulVisited = 0, ulLevel = 0;
-    MeshRefPointToFacets clRPF(*this);
-    const MeshFacetArray& raclFAry = _aclFacetArray;
+    MeshRefPointToFacets clRPF(rMesh);
+    const MeshFacetArray& raclFAry = rMesh.GetFacets();
     MeshFacetArray::_TConstIterator pFBegin = raclFAry.begin();
     std::vector<unsigned long> aclCurrentLevel, aclNextLevel;
 
     aclCurrentLevel.push_back(ulStartFacet);
-    raclFAry[ulStartFacet].SetFlag(MeshFacet::VISIT);
+    marker.SetVisited(ulStartFacet);
 
     while (aclCurrentLevel.size() > 0) {
         // visit all neighbours of the current level
@@ -101,12 +131,12 @@ unsigned long MeshKernel::VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rcl
                 const MeshFacet &rclFacet = raclFAry[*pCurrFacet];
                 const std::set<unsigned long>& raclNB = clRPF[rclFacet._aulPoints[i]];
                 for (std::set<unsigned long>::const_iterator pINb = raclNB.begin(); pINb != raclNB.end(); ++pINb) {
-                    if (pFBegin[*pINb].IsFlag(MeshFacet::VISIT) == false) {
-                        // only visit if VISIT Flag not set
+                    if (marker.IsVisited(*pINb) == false) {
+                        // only visit if not marked as visited
                         ulVisited++;
                         unsigned long ulFInd = *pINb;
                         aclNextLevel.push_back(ulFInd);
-                        pFBegin[*pINb].SetFlag(MeshFacet::VISIT);
+                        marker.SetVisited(ulFInd);
                         if (rclFVisitor.Visit(pFBegin[*pINb], raclFAry[*pCurrFacet], ulFInd, ulLevel) == false)
                             return ulVisited;
                     }
@@ -121,28 +151,30 @@ unsigned long MeshKernel::VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rcl
     return ulVisited;
 }
 
-unsigned long MeshKernel::VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, unsigned long ulStartPoint) const
+template <class Marker>
+unsigned long visitNeighbourPoints (const MeshKernel& rMesh, MeshPointVisitor &rclPVisitor,
+                                    unsigned long ulStartPoint, const Marker& marker)
 {
     unsigned long ulVisited = 0, ulLevel = 0;
     std::vector<unsigned long> aclCurrentLevel, aclNextLevel;
     std::vector<unsigned long>::iterator  clCurrIter;  
-    MeshPointArray::_TConstIterator pPBegin = _aclPointArray.begin();
-    MeshRefPointToPoints clNPs(*this);
+    MeshPointArray::_TConstIterator pPBegin = rMesh.GetPoints().begin();
+    MeshRefPointToPoints clNPs(rMesh);
 
     aclCurrentLevel.push_back(ulStartPoint);
-    (pPBegin + ulStartPoint)->SetFlag(MeshPoint::VISIT);
+    marker.SetVisited(ulStartPoint);
 
     while (aclCurrentLevel.size() > 0) {
         // visit all neighbours of the current level
         for (clCurrIter = aclCurrentLevel.begin(); clCurrIter < aclCurrentLevel.end(); ++clCurrIter) {
             const std::set<unsigned long>& raclNB = clNPs[*clCurrIter];
             for (std::set<unsigned long>::const_iterator pINb = raclNB.begin(); pINb != raclNB.end(); ++pINb) {
-                if (pPBegin[*pINb].IsFlag(MeshPoint::VISIT) == false) {
-                    // only visit if VISIT Flag not set
+                if (marker.IsVisited(*pINb) == false) {
+                    // only visit if not marked as visited
                     ulVisited++;
                     unsigned long ulPInd = *pINb;
                     aclNextLevel.push_back(ulPInd);
-                    pPBegin[*pINb].SetFlag(MeshPoint::VISIT);
+                    marker.SetVisited(ulPInd);
                     if (rclPVisitor.Visit(pPBegin[*pINb], *(pPBegin + (*clCurrIter)), ulPInd, ulLevel) == false)
                         return ulVisited;
                 }
@@ -156,6 +188,47 @@ unsigned long MeshKernel::VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, u
     return ulVisited;
 }
 
+}
+
+unsigned long MeshKernel::VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, unsigned long ulStartFacet) const
+{
+    return visitNeighbourFacets(_aclFacetArray, rclFVisitor, ulStartFacet,
+                                FlagMarker<MeshFacet>(_aclFacetArray));
+}
+
+unsigned long MeshKernel::VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, unsigned long ulStartFacet,
+                                                std::vector<bool>& visited) const
+{
+    return visitNeighbourFacets(_aclFacetArray, rclFVisitor, ulStartFacet,
+                                BitsetMarker(visited, _aclFacetArray.size()));
+}
+
+unsigned long MeshKernel::VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rclFVisitor, unsigned long ulStartFacet) const
+{
+    return visitNeighbourFacetsOverCorners(*this, rclFVisitor, ulStartFacet,
+                                           FlagMarker<MeshFacet>(_aclFacetArray));
+}
+
+unsigned long MeshKernel::VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rclFVisitor, unsigned long ulStartFacet,
+                                                           std::vector<bool>& visited) const
+{
+    return visitNeighbourFacetsOverCorners(*this, rclFVisitor, ulStartFacet,
+                                           BitsetMarker(visited, _aclFacetArray.size()));
+}
+
+unsigned long MeshKernel::VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, unsigned long ulStartPoint) const
+{
+    return visitNeighbourPoints(*this, rclPVisitor, ulStartPoint,
+                                FlagMarker<MeshPoint>(_aclPointArray));
+}
+
+unsigned long MeshKernel::VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, unsigned long ulStartPoint,
+                                                std::vector<bool>& visited) const
+{
+    return visitNeighbourPoints(*this, rclPVisitor, ulStartPoint,
+                                BitsetMarker(visited, _aclPointArray.size()));
+}
+
 // -------------------------------------------------------------------------
 
 MeshSearchNeighbourFacetsVisitor::MeshSearchNeighbourFacetsVisitor (const MeshKernel &rclMesh,
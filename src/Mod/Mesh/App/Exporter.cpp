@@ -127,14 +127,19 @@ int Exporter::addObject(App::DocumentObject *obj, float tol)
                 Py_DECREF(pyobj);
             }
         }
-        MeshObject mesh(it->second);
-        mesh.transformGeometry(matrix);
-        if (addMesh(sobj->Label.getValue(), mesh))
+        if (addMesh(sobj->Label.getValue(), it->second, matrix))
             ++count;
     }
     return count;
 }
 
+bool Exporter::addMesh(const char *name, const MeshObject & mesh, const Base::Matrix4D & mat)
+{
+    MeshObject copy(mesh);
+    copy.transformGeometry(mat);
+    return addMesh(name, copy);
+}
+
 MergeExporter::MergeExporter(std::string fileName, MeshIO::Format)
     :fName(fileName)
 {
@@ -203,6 +208,44 @@ bool MergeExporter::addMesh(const char *name, const MeshObject & mesh)
     return true;
 }
 
+StreamExporter::StreamExporter(std::string fileName, MeshIO::Format fmt)
+{
+    // ask for write permission
+    Base::FileInfo fi(fileName.c_str());
+    Base::FileInfo di(fi.dirPath().c_str());
+    if ((fi.exists() && !fi.isWritable()) || !di.exists() || !di.isWritable()) {
+        throw Base::FileException("No write permission for file", fileName);
+    }
+
+    outputStreamPtr.reset(new Base::ofstream(fi, std::ios::out | std::ios::binary));
+    writer.reset(new MeshStreamOutput(*outputStreamPtr, fmt));
+    if (!writer->Begin()) {
+        throw Base::FileException("Failed to write file", fileName);
+    }
+}
+
+StreamExporter::~StreamExporter()
+{
+    if (!writer->End()) {
+        std::cerr << "Saving mesh failed" << std::endl;
+    }
+}
+
+bool StreamExporter::isSupported(MeshIO::Format fmt)
+{
+    return MeshStreamOutput::IsSupported(fmt);
+}
+
+bool StreamExporter::addMesh(const char *name, const MeshObject & mesh)
+{
+    return writer->Add(mesh.getKernel(), mesh.getTransform(), name);
+}
+
+bool StreamExporter::addMesh(const char *name, const MeshObject & mesh, const Base::Matrix4D & mat)
+{
+    return writer->Add(mesh.getKernel(), mat * mesh.getTransform(), name);
+}
+
 AmfExporter::AmfExporter( std::string fileName,
                           const std::map<std::string, std::string> &meta,
                           bool compress ) :
@@ -24,6 +24,7 @@
 #define MESH_EXPORTER_H
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <ostream>
 
@@ -63,6 +64,8 @@ class Exporter
         int addObject(App::DocumentObject *obj, float tol);
 
         virtual bool addMesh(const char *name, const MeshObject & mesh) = 0;
+        /// Adds the mesh with placement \a mat. By default a transformed copy is passed to addMesh().
+        virtual bool addMesh(const char *name, const MeshObject & mesh, const Base::Matrix4D & mat);
 
     protected:
         /// Does some simple escaping of characters for XML-type exports
@@ -86,6 +89,26 @@ class MergeExporter : public Exporter
         std::string fName;
 };
 
+/// Writes one or more objects directly to a file without merging them first
+/*!
+ * Only the formats supported by MeshCore::MeshStreamOutput can be used.
+ */
+class StreamExporter : public Exporter
+{
+    public:
+        StreamExporter(std::string fileName, MeshCore::MeshIO::Format fmt);
+        ~StreamExporter();
+
+        static bool isSupported(MeshCore::MeshIO::Format fmt);
+
+        bool addMesh(const char *name, const MeshObject & mesh) override;
+        bool addMesh(const char *name, const MeshObject & mesh, const Base::Matrix4D & mat) override;
+
+    private:
+        std::unique_ptr<std::ostream> outputStreamPtr;
+        std::unique_ptr<MeshCore::MeshStreamOutput> writer;
+};
+
 /// Used for exporting to Additive Manufacturing File (AMF) format
 /*!
  * The constructor and destructor write the beginning and end of the AMF,
@@ -66,8 +66,9 @@ App::DocumentObjectExecReturn *Curvature::execute(void)
     }
  
     // get all points
-    const MeshCore::MeshKernel& rMesh = pcFeat->Mesh.getValue().getKernel();
-    MeshCore::MeshCurvature meshCurv(rMesh);
+    const Mesh::MeshObject& mesh = pcFeat->Mesh.getValue();
+    MeshCore::MeshCurvature meshCurv(mesh.getKernel());
+    meshCurv.SetPointToFacets(&mesh.getPointToFacets());
     meshCurv.ComputePerVertex();
     const std::vector<MeshCore::CurvatureInfo>& curv = meshCurv.GetCurvature();
 
@@ -27,6 +27,8 @@
 # include <sstream>
 #endif
 
+#include <boost/functional/hash.hpp>
+
 #include <CXX/Objects.hxx>
 #include <Base/Builder3D.h>
 #include <Base/Console.h>
@@ -38,6 +40,7 @@
 #include <Base/Tools.h>
 #include <Base/ViewProj.h>
 
+#include "Core/Algorithm.h"
 #include "Core/Builder.h"
 #include "Core/MeshKernel.h"
 #include "Core/Grid.h"
@@ -47,6 +50,7 @@
 #include "Core/Evaluation.h"
 #include "Core/Degeneration.h"
 #include "Core/Segmentation.h"
+#include "Core/Smoothing.h"
 #include "Core/SetOperations.h"
 #include "Core/Triangulation.h"
 #include "Core/Trim.h"
@@ -214,6 +218,48 @@ void MeshObject::swap(MeshObject& mesh)
     mesh._Mtrx = tmp;
 }
 
+std::size_t MeshObject::topologyKey() const
+{
+    // The neighbourhood structures only depend on the point indices of the
+    // facets. Moving points keeps them valid while any change of the facets
+    // gives a different key, regardless of how the kernel was modified.
+    std::size_t seed = 0;
+    boost::hash_combine(seed, _kernel.CountPoints());
+    const MeshCore::MeshFacetArray& facets = _kernel.GetFacets();
+    for (const auto& it : facets) {
+        boost::hash_combine(seed, it._aulPoints[0]);
+        boost::hash_combine(seed, it._aulPoints[1]);
+        boost::hash_combine(seed, it._aulPoints[2]);
+    }
+    return seed;
+}
+
+void MeshObject::validateNeighbourhood() const
+{
+    std::size_t key = topologyKey();
+    if (key != _topologyKey) {
+        _pointToFacets.reset();
+        _pointToPoints.reset();
+        _topologyKey = key;
+    }
+}
+
+const MeshCore::MeshRefPointToFacets& MeshObject::getPointToFacets() const
+{
+    validateNeighbourhood();
+    if (!_pointToFacets)
+        _pointToFacets = std::make_shared<MeshCore::MeshRefPointToFacets>(_kernel);
+    return *_pointToFacets;
+}
+
+const MeshCore::MeshRefPointToPoints& MeshObject::getPointToPoints() const
+{
+    validateNeighbourhood();
+    if (!_pointToPoints)
+        _pointToPoints = std::make_shared<MeshCore::MeshRefPointToPoints>(_kernel);
+    return *_pointToPoints;
+}
+
 std::string MeshObject::representation() const
 {
     std::stringstream str;
@@ -281,14 +327,12 @@ void MeshObject::getPoints(std::vector<Base::Vector3d> &Points,
 {
     Base::Matrix4D mat = _Mtrx;
 
-    unsigned long ctpoints = _kernel.CountPoints();
-    Points.reserve(ctpoints);
-    for (unsigned long i=0; i<ctpoints; i++) {
-        Base::Vector3f vertf = _kernel.GetPoint(i);
-        Base::Vector3d vertd(vertf.x, vertf.y, vertf.z);
-        vertd = mat * vertd;
-        Points.push_back(vertd);
-    }
+    std::size_t offset = Points.size();
+    const MeshCore::MeshPointArray& points = _kernel.GetPoints();
+    Points.reserve(offset + points.size());
+    for (const auto& it : points)
+        Points.emplace_back(it.x, it.y, it.z);
+    mat.multVecs(Points.data() + offset, Points.data() + Points.size());
 
     // nullify translation part
     mat[0][3] = 0.0;
@@ -313,11 +357,13 @@ Mesh::Facet MeshObject::getFacet(unsigned long index) const
 void MeshObject::getFaces(std::vector<Base::Vector3d> &Points,std::vector<Facet> &Topo,
                           float /*Accuracy*/, uint16_t /*flags*/) const
 {
-    unsigned long ctpoints = _kernel.CountPoints();
-    Points.reserve(ctpoints);
-    for (unsigned long i=0; i<ctpoints; i++) {
-        Points.push_back(this->getPoint(i));
-    }
+    // transform all points at once instead of creating a MeshPoint for each
+    std::size_t offset = Points.size();
+    const MeshCore::MeshPointArray& points = _kernel.GetPoints();
+    Points.reserve(offset + points.size());
+    for (const auto& it : points)
+        Points.emplace_back(it.x, it.y, it.z);
+    _Mtrx.multVecs(Points.data() + offset, Points.data() + Points.size());
 
     unsigned long ctfacets = _kernel.CountFacets();
     const MeshCore::MeshFacetArray& ary = _kernel.GetFacets();
@@ -982,7 +1028,10 @@ void MeshObject::setPoint(unsigned long index, const Base::Vector3d& p)
 
 void MeshObject::smooth(int iterations, float d_max)
 {
-    _kernel.Smooth(iterations, d_max);
+    (void)d_max;
+    MeshCore::LaplaceSmoothing smooth(_kernel);
+    smooth.SetNeighbourhood(&getPointToPoints(), &getPointToFacets());
+    smooth.Smooth(iterations);
 }
 
 void MeshObject::decimate(float fTolerance, float fReduction)
@@ -991,10 +1040,19 @@ void MeshObject::decimate(float fTolerance, float fReduction)
     dm.simplify(fTolerance, fReduction);
 }
 
-void MeshObject::decimate(int targetSize)
+void MeshObject::decimate(int targetSize, bool parallel)
+{
+    MeshCore::MeshSimplify dm(this->_kernel);
+    if (parallel)
+        dm.simplifyParallel(targetSize);
+    else
+        dm.simplify(targetSize);
+}
+
+void MeshObject::decimateToMemory(std::size_t maxBytes, bool parallel)
 {
     MeshCore::MeshSimplify dm(this->_kernel);
-    dm.simplify(targetSize);
+    dm.simplifyToMemory(maxBytes, parallel);
 }
 
 Base::Vector3d MeshObject::getPointNormal(unsigned long index) const
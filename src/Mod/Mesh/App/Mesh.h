@@ -29,6 +29,7 @@
 #include <set>
 #include <string>
 #include <map>
+#include <memory>
 
 #include <Base/Matrix.h>
 #include <Base/Vector3D.h>
@@ -56,6 +57,8 @@ namespace Base {
 
 namespace MeshCore {
 class AbstractPolygonTriangulator;
+class MeshRefPointToFacets;
+class MeshRefPointToPoints;
 }
 
 namespace Mesh
@@ -142,6 +145,21 @@ public:
     const MeshCore::MeshKernel& getKernel(void) const
     { return _kernel; }
 
+    /** @name Neighbourhood */
+    //@{
+    /**
+     * Returns the facets adjacent to each point. The structure is cached and
+     * only rebuilt after the topology of the mesh has changed, so it can be
+     * shared by curvature estimation, smoothing and segmentation.
+     */
+    const MeshCore::MeshRefPointToFacets& getPointToFacets() const;
+    /**
+     * Returns the neighbour ring of each point. The structure is cached and
+     * only rebuilt after the topology of the mesh has changed.
+     */
+    const MeshCore::MeshRefPointToPoints& getPointToPoints() const;
+    //@}
+
     virtual Base::BoundBox3d getBoundBox(void)const;
 
     /** @name I/O */
@@ -217,7 +235,8 @@ public:
     void setPoint(unsigned long, const Base::Vector3d& v);
     void smooth(int iterations, float d_max);
     void decimate(float fTolerance, float fReduction);
-    void decimate(int targetSize);
+    void decimate(int targetSize, bool parallel = false);
+    void decimateToMemory(std::size_t maxBytes, bool parallel = true);
     Base::Vector3d getPointNormal(unsigned long) const;
     std::vector<Base::Vector3d> getPointNormals() const;
     void crossSections(const std::vector<TPlane>&, std::vector<TPolylines> &sections,
@@ -393,11 +412,17 @@ private:
     void swapKernel(MeshCore::MeshKernel& m, const std::vector<std::string>& g);
     void copySegments(const MeshObject&);
     void swapSegments(MeshObject&);
+    std::size_t topologyKey() const;
+    void validateNeighbourhood() const;
 
 private:
     Base::Matrix4D _Mtrx;
     MeshCore::MeshKernel _kernel;
     std::vector<Segment> _segments;
+    // lazily built neighbourhood, valid as long as the topology key matches
+    mutable std::shared_ptr<MeshCore::MeshRefPointToFacets> _pointToFacets;
+    mutable std::shared_ptr<MeshCore::MeshRefPointToPoints> _pointToPoints;
+    mutable std::size_t _topologyKey = 0;
     static float Epsilon;
 };
 
@@ -26,6 +26,7 @@
 #endif
 
 #include <CXX/Objects.hxx>
+#include <App/Application.h>
 #include <Base/Console.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
@@ -614,7 +615,17 @@ void PropertyMeshKernel::Restore(Base::XMLReader &reader)
 
 void PropertyMeshKernel::SaveDocFile (Base::Writer &writer) const
 {
-    _meshObject->save(writer.Stream());
+    // The compressed format can't be read by older versions, so it's optional.
+    // A tolerance greater than zero enables the lossy quantization of the points.
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Mesh");
+    if (hGrp->GetBool("CompressDocFile", false)) {
+        float tolerance = static_cast<float>(hGrp->GetFloat("CompressTolerance", 0.0));
+        _meshObject->getKernel().WriteCompressed(writer.Stream(), tolerance);
+    }
+    else {
+        _meshObject->save(writer.Stream());
+    }
 }
 
 void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
@@ -624,6 +635,23 @@ void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
     hasSetValue();
 }
 
+bool PropertyMeshKernel::canRestoreDocFileAsync() const
+{
+    return true;
+}
+
+std::function<void()> PropertyMeshKernel::RestoreDocFileAsync(Base::Reader &reader)
+{
+    // read into a separate mesh and keep the placement of the restored one
+    Base::Reference<MeshObject> mesh(new MeshObject());
+    mesh->load(reader);
+    return [this, mesh]() {
+        aboutToSetValue();
+        _meshObject->swap(mesh->getKernel());
+        hasSetValue();
+    };
+}
+
 App::Property *PropertyMeshKernel::Copy(void) const
 {
     // Note: Copy the content, do NOT reference the same mesh object
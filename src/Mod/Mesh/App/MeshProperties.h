@@ -244,6 +244,8 @@ public:
 
     void SaveDocFile (Base::Writer &writer) const;
     void RestoreDocFile(Base::Reader &reader);
+    bool canRestoreDocFileAsync() const;
+    std::function<void()> RestoreDocFileAsync(Base::Reader &reader);
 
     App::Property *Copy(void) const;
     void Paste(const App::Property &from);
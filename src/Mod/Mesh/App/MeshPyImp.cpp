@@ -29,6 +29,7 @@
 #include <Base/Converter.h>
 #include <Base/GeometryPyCXX.h>
 #include <Base/MatrixPy.h>
+#include <Base/PyBuffer.h>
 #include <Base/Tools.h>
 
 #include "Mesh.h"
@@ -819,6 +820,88 @@ PyObject*  MeshPy::getPointNormals(PyObject *args)
     } PY_CATCH;
 }
 
+PyObject* MeshPy::getPointArray(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    const MeshCore::MeshPointArray& points = getMeshObjectPtr()->getKernel().GetPoints();
+    Py_ssize_t count = static_cast<Py_ssize_t>(points.size());
+    return Base::createArrayView(count, 3, "f", sizeof(float), [&points](char* data) {
+        float* coords = reinterpret_cast<float*>(data);
+        for (const auto& it : points) {
+            *coords++ = it.x;
+            *coords++ = it.y;
+            *coords++ = it.z;
+        }
+    });
+}
+
+PyObject* MeshPy::getFacetArray(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    const MeshCore::MeshFacetArray& facets = getMeshObjectPtr()->getKernel().GetFacets();
+    Py_ssize_t count = static_cast<Py_ssize_t>(facets.size());
+    return Base::createArrayView(count, 3, "I", sizeof(unsigned int), [&facets](char* data) {
+        unsigned int* indices = reinterpret_cast<unsigned int*>(data);
+        for (const auto& it : facets) {
+            *indices++ = static_cast<unsigned int>(it._aulPoints[0]);
+            *indices++ = static_cast<unsigned int>(it._aulPoints[1]);
+            *indices++ = static_cast<unsigned int>(it._aulPoints[2]);
+        }
+    });
+}
+
+PyObject* MeshPy::setArrays(PyObject *args)
+{
+    PyObject* pyPoints;
+    PyObject* pyFacets;
+    if (!PyArg_ParseTuple(args, "OO", &pyPoints, &pyFacets))
+        return NULL;
+
+    std::vector<double> coords;
+    if (!Base::readArrayBuffer(pyPoints, 3, coords))
+        return NULL;
+    std::vector<long long> indices;
+    if (!Base::readArrayBuffer(pyFacets, 3, indices))
+        return NULL;
+
+    long long numPoints = static_cast<long long>(coords.size() / 3);
+    MeshCore::MeshPointArray points;
+    points.reserve(coords.size() / 3);
+    for (std::size_t i = 0; i < coords.size(); i += 3) {
+        points.push_back(Base::Vector3f(static_cast<float>(coords[i]),
+                                        static_cast<float>(coords[i+1]),
+                                        static_cast<float>(coords[i+2])));
+    }
+
+    MeshCore::MeshFacetArray facets;
+    facets.reserve(indices.size() / 3);
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        MeshCore::MeshFacet face;
+        for (int j = 0; j < 3; j++) {
+            long long index = indices[i+j];
+            if (index < 0 || index >= numPoints) {
+                PyErr_SetString(PyExc_IndexError, "Point index of facet out of range");
+                return NULL;
+            }
+            face._aulPoints[j] = static_cast<unsigned long>(index);
+        }
+        facets.push_back(face);
+    }
+
+    PY_TRY {
+        MeshPropertyLock lock(this->parentProperty);
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        getMeshObjectPtr()->swapKernel(kernel, std::vector<std::string>());
+    } PY_CATCH;
+
+    Py_Return;
+}
+
 PyObject* MeshPy::countSegments(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
@@ -1679,30 +1762,37 @@ PyObject*  MeshPy::smooth(PyObject *args, PyObject *kwds)
     int iter=1;
     double lambda = 0;
     double micro = 0;
-    static char* keywords_smooth[] = {"Method","Iteration","Lambda","Micro",NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|sidd",keywords_smooth,
-                                     &method, &iter, &lambda, &micro))
+    PyObject* parallel = Py_False;
+    static char* keywords_smooth[] = {"Method","Iteration","Lambda","Micro","Parallel",NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|siddO!",keywords_smooth,
+                                     &method, &iter, &lambda, &micro, &PyBool_Type, &parallel))
         return 0;
 
     PY_TRY {
         MeshPropertyLock lock(this->parentProperty);
-        MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+        MeshObject* mesh = getMeshObjectPtr();
+        MeshCore::MeshKernel& kernel = mesh->getKernel();
         if (strcmp(method, "Laplace") == 0) {
             MeshCore::LaplaceSmoothing smooth(kernel);
+            smooth.SetNeighbourhood(&mesh->getPointToPoints(), &mesh->getPointToFacets());
             if (lambda > 0)
                 smooth.SetLambda(lambda);
+            smooth.SetParallel(PyObject_IsTrue(parallel) ? true : false);
             smooth.Smooth(iter);
         }
         else if (strcmp(method, "Taubin") == 0) {
             MeshCore::TaubinSmoothing smooth(kernel);
+            smooth.SetNeighbourhood(&mesh->getPointToPoints(), &mesh->getPointToFacets());
             if (lambda > 0)
                 smooth.SetLambda(lambda);
             if (micro > 0)
                 smooth.SetMicro(micro);
+            smooth.SetParallel(PyObject_IsTrue(parallel) ? true : false);
             smooth.Smooth(iter);
         }
         else if (strcmp(method, "PlaneFit") == 0) {
             MeshCore::PlaneFitSmoothing smooth(kernel);
+            smooth.SetNeighbourhood(&mesh->getPointToPoints(), nullptr);
             smooth.Smooth(iter);
         }
         else {
@@ -1726,15 +1816,16 @@ PyObject*  MeshPy::decimate(PyObject *args)
 
     PyErr_Clear();
     int targetSize;
-    if (PyArg_ParseTuple(args, "i", &targetSize)) {
+    PyObject* parallel = Py_False;
+    if (PyArg_ParseTuple(args, "i|O!", &targetSize, &PyBool_Type, &parallel)) {
         PY_TRY {
-            getMeshObjectPtr()->decimate(targetSize);
+            getMeshObjectPtr()->decimate(targetSize, PyObject_IsTrue(parallel) ? true : false);
         } PY_CATCH;
 
         Py_Return;
     }
 
-    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float) or decimate(targetSize=int)");
+    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float) or decimate(targetSize=int, [parallel=bool])");
     return nullptr;
 }
 
@@ -1871,9 +1962,11 @@ PyObject*  MeshPy::getSegmentsByCurvature(PyObject *args)
     if (!PyArg_ParseTuple(args, "O",&l))
         return NULL;
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+    const MeshObject* mesh = getMeshObjectPtr();
+    const MeshCore::MeshKernel& kernel = mesh->getKernel();
     MeshCore::MeshSegmentAlgorithm finder(kernel);
     MeshCore::MeshCurvature meshCurv(kernel);
+    meshCurv.SetPointToFacets(&mesh->getPointToFacets());
     meshCurv.ComputePerVertex();
 
     Py::Sequence func(l);
@@ -1910,9 +2003,11 @@ PyObject* MeshPy::getCurvaturePerVertex(PyObject* args)
     if (!PyArg_ParseTuple(args, ""))
         return NULL;
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+    const MeshObject* mesh = getMeshObjectPtr();
+    const MeshCore::MeshKernel& kernel = mesh->getKernel();
     MeshCore::MeshSegmentAlgorithm finder(kernel);
     MeshCore::MeshCurvature meshCurv(kernel);
+    meshCurv.SetPointToFacets(&mesh->getPointToFacets());
     meshCurv.ComputePerVertex();
 
     const std::vector<MeshCore::CurvatureInfo>& curv = meshCurv.GetCurvature();
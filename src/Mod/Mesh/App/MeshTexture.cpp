@@ -26,6 +26,7 @@
 #endif
 
 #include "MeshTexture.h"
+#include <Base/ThreadPool.h>
 
 using namespace Mesh;
 
@@ -82,10 +83,16 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh, bool addDefaultColor, cons
         const MeshCore::MeshPointArray& points = mesh.getKernel().GetPoints();
         const MeshCore::MeshFacetArray& facets = mesh.getKernel().GetFacets();
 
+        // the kd-tree can be queried from several threads
+        std::vector<unsigned long> refIndices(points.size());
+        Base::parallel_for(std::size_t(0), points.size(), [&](std::size_t index) {
+            refIndices[index] = findIndex(points[index], max_dist);
+        });
+
         if (binding == MeshCore::MeshIO::PER_VERTEX) {
             diffuseColor.reserve(points.size());
             for (size_t index=0; index<points.size(); index++) {
-                unsigned long pos = findIndex(points[index], max_dist);
+                unsigned long pos = refIndices[index];
                 if (pos < countPointsRefMesh) {
                     diffuseColor.push_back(textureColor[pos]);
                 }
@@ -104,7 +111,7 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh, bool addDefaultColor, cons
             std::vector<unsigned long> pointMap;
             pointMap.reserve(points.size());
             for (size_t index=0; index<points.size(); index++) {
-                unsigned long pos = findIndex(points[index], max_dist);
+                unsigned long pos = refIndices[index];
                 if (pos < countPointsRefMesh) {
                     pointMap.push_back(pos);
                 }
@@ -105,6 +105,11 @@ bool DlgSmoothing::smoothSelection() const
     return ui->checkBoxSelection->isChecked();
 }
 
+bool DlgSmoothing::smoothParallel() const
+{
+    return ui->checkBoxParallel->isChecked();
+}
+
 void DlgSmoothing::on_checkBoxSelection_toggled(bool on)
 {
     /*emit*/ toggledSelection(on);
@@ -121,7 +126,7 @@ SmoothingDialog::SmoothingDialog(QWidget* parent, Qt::WindowFlags fl)
     QVBoxLayout* hboxLayout = new QVBoxLayout(this);
     QDialogButtonBox* buttonBox = new QDialogButtonBox(this);
     buttonBox->setStandardButtons(QDialogButtonBox::Cancel|QDialogButtonBox::Ok);
-    
+    
     connect(buttonBox, SIGNAL(accepted()),
             this, SLOT(accept()));
     connect(buttonBox, SIGNAL(rejected()),
@@ -138,7 +143,7 @@ SmoothingDialog::~SmoothingDialog()
 // ---------------------------------------
 
 /* TRANSLATOR MeshGui::TaskSmoothing */
-
+
 TaskSmoothing::TaskSmoothing()
 {
     widget = new DlgSmoothing();
@@ -198,6 +203,7 @@ bool TaskSmoothing::accept()
                     MeshCore::TaubinSmoothing s(mm->getKernel());
                     s.SetLambda(widget->lambdaStep());
                     s.SetMicro(widget->microStep());
+                    s.SetParallel(widget->smoothParallel());
                     if (widget->smoothSelection()) {
                         s.SmoothPoints(widget->iterations(), selection);
                     }
@@ -209,6 +215,7 @@ bool TaskSmoothing::accept()
                 {
                     MeshCore::LaplaceSmoothing s(mm->getKernel());
                     s.SetLambda(widget->lambdaStep());
+                    s.SetParallel(widget->smoothParallel());
                     if (widget->smoothSelection()) {
                         s.SmoothPoints(widget->iterations(), selection);
                     }
@@ -52,6 +52,7 @@ public:
     double microStep() const;
     Smooth method() const;
     bool smoothSelection() const;
+    bool smoothParallel() const;
 
 private Q_SLOTS:
     void method_clicked(int);
@@ -86,6 +87,8 @@ public:
     { return widget->method(); }
     bool smoothSelection() const
     { return widget->smoothSelection(); }
+    bool smoothParallel() const
+    { return widget->smoothParallel(); }
 
 private:
     DlgSmoothing* widget;
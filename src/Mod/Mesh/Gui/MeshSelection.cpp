@@ -38,6 +38,7 @@
 
 #include <Base/Console.h>
 #include <Base/Tools.h>
+#include <Base/Tools2D.h>
 #include <App/Application.h>
 #include <App/Document.h>
 #include <Gui/Application.h>
@@ -113,6 +114,7 @@ void MeshSelection::setCallback(SoEventCallbackCB *cb)
 void MeshSelection::setObjects(const std::vector<Gui::SelectionObject>& obj)
 {
     meshObjects = obj;
+    projectedFacets.clear();
 }
 
 std::vector<App::DocumentObject*> MeshSelection::getObjects() const
@@ -191,6 +193,21 @@ void MeshSelection::stopInteractiveCallback(Gui::View3DInventorViewer* viewer)
     this->activeCB = 0;
 }
 
+const MeshCore::MeshProjectedFacetGrid&
+MeshSelection::getProjectedFacets(ViewProviderMesh* vp, const Base::ViewProjMethod& proj)
+{
+    // reuse the projected facets as long as neither the camera nor the mesh has changed
+    const Mesh::MeshObject& mesh = static_cast<Mesh::Feature*>(vp->getObject())->Mesh.getValue();
+    const MeshCore::MeshKernel& kernel = mesh.getKernel();
+    ProjectedFacets& cache = projectedFacets[vp];
+    if (cache.grid && cache.kernel == &kernel && cache.grid->IsValid(&proj))
+        return *cache.grid;
+
+    cache.kernel = &kernel;
+    cache.grid = std::make_shared<MeshCore::MeshProjectedFacetGrid>(kernel, &proj);
+    return *cache.grid;
+}
+
 void MeshSelection::prepareFreehandSelection(bool add,SoEventCallbackCB *cb)
 {
     // a rubberband to select a rectangle area of the meshes
@@ -468,7 +485,20 @@ void MeshSelection::selectGLCallback(void * ud, SoEventCallback * n)
     Base::Vector3f point (pnt[0],pnt[1],pnt[2]);
     Base::Vector3f normal(dir[0],dir[1],dir[2]);
 
+    Base::Polygon2d polygon2d;
+    for (std::vector<SbVec2f>::const_iterator it = polygon.begin(); it != polygon.end(); ++it)
+        polygon2d.Add(Base::Vector2d((*it)[0],(*it)[1]));
+
     std::list<ViewProviderMesh*> views = self->getViewProviders();
+
+    // drop the projections of meshes that are no longer part of the selection
+    for (auto jt = self->projectedFacets.begin(); jt != self->projectedFacets.end(); ) {
+        if (std::find(views.begin(), views.end(), jt->first) == views.end())
+            jt = self->projectedFacets.erase(jt);
+        else
+            ++jt;
+    }
+
     for (std::list<ViewProviderMesh*>::iterator it = views.begin(); it != views.end(); ++it) {
         ViewProviderMesh* vp = *it;
 
@@ -483,7 +513,7 @@ void MeshSelection::selectGLCallback(void * ud, SoEventCallback * n)
 
         Base::Placement plm = static_cast<Mesh::Feature*>(vp->getObject())->Placement.getValue();
         proj.setTransform(plm.toMatrix());
-        vp->getFacetsFromPolygon(polygon, proj, true, faces);
+        self->getProjectedFacets(vp, proj).CheckFacets(polygon2d, faces);
 
         if (self->onlyVisibleTriangles) {
             const SbVec2s& sz = view->getSoRenderManager()->getViewportRegion().getWindowSize();
@@ -24,6 +24,8 @@
 #ifndef MESHGUI_MESHSELECTION_H
 #define MESHGUI_MESHSELECTION_H
 
+#include <map>
+#include <memory>
 #include <vector>
 #include <QWidget>
 #include <Inventor/nodes/SoEventCallback.h>
@@ -31,10 +33,19 @@
 #include <Gui/TaskView/TaskDialog.h>
 #include <Gui/TaskView/TaskView.h>
 
+namespace Base {
+    class ViewProjMethod;
+}
+
 namespace Gui {
     class View3DInventorViewer;
 }
 
+namespace MeshCore {
+    class MeshKernel;
+    class MeshProjectedFacetGrid;
+}
+
 namespace MeshGui {
 
 class ViewProviderMesh;
@@ -78,6 +89,8 @@ protected:
     void prepareFreehandSelection(bool,SoEventCallbackCB *cb);
     void startInteractiveCallback(Gui::View3DInventorViewer* viewer,SoEventCallbackCB *cb);
     void stopInteractiveCallback(Gui::View3DInventorViewer* viewer);
+    const MeshCore::MeshProjectedFacetGrid& getProjectedFacets(ViewProviderMesh* vp,
+                                                               const Base::ViewProjMethod& proj);
 
 private:
     static void selectGLCallback(void * ud, SoEventCallback * n);
@@ -91,6 +104,13 @@ private:
     Gui::View3DInventorViewer* ivViewer;
     mutable std::vector<Gui::SelectionObject> meshObjects;
 
+    /// projected facets of each mesh, kept as long as the camera doesn't change
+    struct ProjectedFacets {
+        const MeshCore::MeshKernel* kernel;
+        std::shared_ptr<MeshCore::MeshProjectedFacetGrid> grid;
+    };
+    std::map<ViewProviderMesh*, ProjectedFacets> projectedFacets;
+
     static unsigned char cross_bitmap[];
     static unsigned char cross_mask_bitmap[];
 };
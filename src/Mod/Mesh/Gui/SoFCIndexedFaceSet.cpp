@@ -32,6 +32,8 @@
 #ifndef _PreComp_
 # include <algorithm>
 # include <climits>
+# include <limits>
+# include <map>
 # ifdef FC_OS_MACOSX
 # include <OpenGL/gl.h>
 # include <OpenGL/glu.h>
@@ -84,13 +86,21 @@ public:
     void generateGLArrays(SoGLRenderAction* action,
         SoMaterialBindingElement::Binding matbind,
         std::vector<float>& vertex, std::vector<int32_t>& index);
+    void writeGLArrays(SoGLRenderAction* action, std::size_t offset,
+        std::vector<float>& vertex);
     void renderFacesGLArray(SoGLRenderAction*);
     void renderCoordsGLArray(SoGLRenderAction *);
     void update();
     bool needUpdate(SoGLRenderAction *);
+    bool markDirty(std::size_t first, std::size_t last);
+    bool takeDirtyRange(SoGLRenderAction *, std::size_t &first, std::size_t &last);
 
 private:
     void renderGLArray(SoGLRenderAction *, GLenum);
+
+    // The GL contexts with an uploaded buffer and the range of triangles
+    // still to be rewritten in it. An empty range has first > last.
+    std::map<uint32_t, std::pair<std::size_t, std::size_t> > dirtyRanges;
 };
 
 MeshRenderer::Private::Private()
@@ -147,6 +157,22 @@ void MeshRenderer::Private::generateGLArrays(SoGLRenderAction* action,
                      index.size() * sizeof(int32_t));
     indices.release();
     this->matbinding = matbind;
+
+    // the buffer of this context is up-to-date now
+    dirtyRanges[action->getCacheContext()] = std::make_pair(std::size_t(1), std::size_t(0));
+}
+
+void MeshRenderer::Private::writeGLArrays(SoGLRenderAction* action, std::size_t offset,
+                                          std::vector<float>& vertex)
+{
+    if (vertex.empty() || !initialized)
+        return;
+
+    vertices.setCurrentContext(action->getCacheContext());
+    vertices.bind();
+    vertices.write(offset * sizeof(float), &(vertex[0]),
+                   vertex.size() * sizeof(float));
+    vertices.release();
 }
 
 void MeshRenderer::Private::renderGLArray(SoGLRenderAction *action, GLenum mode)
@@ -197,6 +223,37 @@ void MeshRenderer::Private::update()
 {
     vertices.destroy();
     indices.destroy();
+    dirtyRanges.clear();
+}
+
+bool MeshRenderer::Private::markDirty(std::size_t first, std::size_t last)
+{
+    if (first > last)
+        return true;
+
+    // Contexts without a buffer will upload the whole data anyway
+    for (auto &v : dirtyRanges) {
+        if (v.second.first > v.second.second) {
+            v.second = std::make_pair(first, last);
+        }
+        else {
+            v.second.first = std::min(v.second.first, first);
+            v.second.second = std::max(v.second.second, last);
+        }
+    }
+    return true;
+}
+
+bool MeshRenderer::Private::takeDirtyRange(SoGLRenderAction *action,
+                                           std::size_t &first, std::size_t &last)
+{
+    auto it = dirtyRanges.find(action->getCacheContext());
+    if (it == dirtyRanges.end() || it->second.first > it->second.second)
+        return false;
+    first = it->second.first;
+    last = it->second.second;
+    it->second = std::make_pair(std::size_t(1), std::size_t(0));
+    return true;
 }
 
 bool MeshRenderer::Private::needUpdate(SoGLRenderAction *action)
@@ -222,6 +279,9 @@ public:
     void generateGLArrays(SoGLRenderAction* action,
         SoMaterialBindingElement::Binding matbind,
         std::vector<float>& vertex, std::vector<int32_t>& index);
+    void writeGLArrays(SoGLRenderAction*, std::size_t, std::vector<float>&)
+    {
+    }
     void renderFacesGLArray(SoGLRenderAction *action);
     void renderCoordsGLArray(SoGLRenderAction *action);
     void update()
@@ -231,6 +291,14 @@ public:
     {
         return false;
     }
+    bool markDirty(std::size_t, std::size_t)
+    {
+        return false;
+    }
+    bool takeDirtyRange(SoGLRenderAction *, std::size_t &, std::size_t &)
+    {
+        return false;
+    }
 };
 
 bool MeshRenderer::Private::canRenderGLArray(SoGLRenderAction *) const
@@ -332,6 +400,9 @@ public:
         std::vector<float>&, std::vector<int32_t>&)
     {
     }
+    void writeGLArrays(SoGLRenderAction*, std::size_t, std::vector<float>&)
+    {
+    }
     void renderFacesGLArray(SoGLRenderAction *)
     {
     }
@@ -345,6 +416,14 @@ public:
     {
         return false;
     }
+    bool markDirty(std::size_t, std::size_t)
+    {
+        return false;
+    }
+    bool takeDirtyRange(SoGLRenderAction *, std::size_t &, std::size_t &)
+    {
+        return false;
+    }
 };
 #endif
 
@@ -378,6 +457,37 @@ void MeshRenderer::generateGLArrays(SoGLRenderAction* action, SoMaterialBindingE
     p->generateGLArrays(action, matbind, vertex, index);
 }
 
+void MeshRenderer::writeGLArrays(SoGLRenderAction* action, std::size_t offset,
+                                 std::vector<float>& vertex)
+{
+    SoGLLazyElement* gl = SoGLLazyElement::getInstance(action->getState());
+    if (gl) {
+        p->pcolors = gl->getDiffusePointer();
+    }
+    p->writeGLArrays(action, offset, vertex);
+}
+
+bool MeshRenderer::markDirty(SoGLRenderAction* action, std::size_t first, std::size_t last)
+{
+    if (!p->markDirty(first, last))
+        return false;
+    SoGLLazyElement* gl = SoGLLazyElement::getInstance(action->getState());
+    if (gl) {
+        p->pcolors = gl->getDiffusePointer();
+    }
+    return true;
+}
+
+bool MeshRenderer::takeDirtyRange(SoGLRenderAction* action, std::size_t &first, std::size_t &last)
+{
+    return p->takeDirtyRange(action, first, last);
+}
+
+SoMaterialBindingElement::Binding MeshRenderer::getMaterialBinding() const
+{
+    return p->matbinding;
+}
+
 // Implementation                            | FPS
 // ================================================
 // drawCoords (every 4th vertex)             | 20.0
@@ -490,6 +600,8 @@ void SoFCIndexedFaceSet::initClass()
 SoFCIndexedFaceSet::SoFCIndexedFaceSet()
   : renderTriangleLimit(UINT_MAX)
   , selectBuf(0)
+  , glTransparency(0)
+  , geometryChanged(true)
 {
     SO_NODE_CONSTRUCTOR(SoFCIndexedFaceSet);
     SO_NODE_ADD_FIELD(updateGLArray, (false));
@@ -531,13 +643,21 @@ void SoFCIndexedFaceSet::GLRender(SoGLRenderAction *action)
     if (useVBO) {
         if (updateGLArray.getValue()) {
             updateGLArray.setValue(false);
-            render.update();
-            generateGLArrays(action);
+            // A plain color change, e.g. segment coloring or face selection,
+            // only rewrites the affected range of the buffers.
+            if (geometryChanged || !updateGLColors(action)) {
+                render.update();
+                generateGLArrays(action);
+            }
         }
         else if (render.needUpdate(action)) {
             generateGLArrays(action);
         }
 
+        std::size_t first, last;
+        if (render.takeDirtyRange(action, first, last))
+            generateGLArrays(action, first, last);
+
         if (render.matchMaterial(state)) {
             SoMaterialBundle mb(action);
             mb.sendFirst();
@@ -708,11 +828,94 @@ void SoFCIndexedFaceSet::drawCoords(const SoGLCoordinateElement * const vertexli
 
 void SoFCIndexedFaceSet::invalidate()
 {
+    geometryChanged = true;
     updateGLArray.setValue(true);
 }
 
+bool SoFCIndexedFaceSet::updateGLColors(SoGLRenderAction * action)
+{
+    SoState* state = action->getState();
+    SoMaterialBindingElement::Binding matbind =
+        SoMaterialBindingElement::get(state);
+    if (matbind != SoMaterialBindingElement::PER_FACE &&
+        matbind != SoMaterialBindingElement::PER_VERTEX_INDEXED)
+        return false;
+    if (matbind != render.getMaterialBinding())
+        return false;
+    if (SoNormalBindingElement::get(state) != SoNormalBindingElement::PER_VERTEX_INDEXED)
+        return false;
+
+    SoGLLazyElement* gl = SoGLLazyElement::getInstance(state);
+    if (!gl)
+        return false;
+    const SbColor * pcolors = gl->getDiffusePointer();
+    int numcolors = gl->getNumDiffuse();
+    const float * transp = gl->getTransparencyPointer();
+    float t = transp ? transp[0] : 0;
+    if (!pcolors || numcolors != static_cast<int>(glColors.size()) || t != glTransparency)
+        return false;
+
+    std::size_t numTria = this->coordIndex.getNum() / 4;
+    if (numTria == 0)
+        return false;
+
+    std::size_t first = numTria, last = 0;
+    if (matbind == SoMaterialBindingElement::PER_FACE) {
+        std::size_t num = std::min<std::size_t>(numTria, numcolors);
+        for (std::size_t i=0; i<num; i++) {
+            if (pcolors[i] != glColors[i]) {
+                first = std::min(first, i);
+                last = i;
+            }
+        }
+    }
+    else {
+        std::vector<bool> changed(numcolors, false);
+        bool any = false;
+        for (int i=0; i<numcolors; i++) {
+            if (pcolors[i] != glColors[i]) {
+                changed[i] = true;
+                any = true;
+            }
+        }
+
+        if (any) {
+            // same fallback to the coordinate index as in generateGLArrays()
+            bool useCoordIndex = this->materialIndex.getNum() == 0 ||
+                                 this->materialIndex[0] < 0;
+            const int32_t * mindices = useCoordIndex ?
+                this->coordIndex.getValues(0) : this->materialIndex.getValues(0);
+            int num = useCoordIndex ? this->coordIndex.getNum() :
+                std::min(this->coordIndex.getNum(), this->materialIndex.getNum());
+            for (int index=0; index<num; index++) {
+                int32_t m = mindices[index];
+                if (m >= 0 && m < numcolors && changed[m]) {
+                    std::size_t i = index / 4;
+                    first = std::min(first, i);
+                    last = std::max(last, i);
+                }
+            }
+        }
+    }
+
+    if (!render.markDirty(action, first, last))
+        return false;
+    glColors.assign(pcolors, pcolors + numcolors);
+    return true;
+}
+
 void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
 {
+    generateGLArrays(action, 0, std::numeric_limits<std::size_t>::max());
+}
+
+void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action,
+                                          std::size_t first, std::size_t last)
+{
+    // If not all triangles are requested only the vertex data of the given
+    // range is written to the existing buffer.
+    bool partial = last != std::numeric_limits<std::size_t>::max();
+
     const SoCoordinateElement * coords;
     const SbVec3f * normals;
     const int32_t * cindices;
@@ -748,6 +951,13 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
     std::vector<int32_t> face_indices;
 
     std::size_t numTria = numindices / 4;
+    if (numTria == 0) {
+        first = 1;
+        last = 0;
+    }
+    else {
+        last = std::min(last, numTria - 1);
+    }
 
     if (!mindices && matbind == SoMaterialBindingElement::PER_VERTEX_INDEXED) {
         mindices = cindices;
@@ -756,8 +966,9 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
     SoNormalBindingElement::Binding normbind = SoNormalBindingElement::get(state);
     if (normbind == SoNormalBindingElement::PER_VERTEX_INDEXED) {
         if (matbind == SoMaterialBindingElement::PER_FACE) {
-            face_vertices.reserve(3 * numTria * 10); // duplicate each vertex (rgba, normal, vertex)
-            face_indices.resize(3 * numTria);
+            face_vertices.reserve(3 * (last + 1 - first) * 10); // duplicate each vertex (rgba, normal, vertex)
+            if (!partial)
+                face_indices.resize(3 * numTria);
 
             if (numcolors != static_cast<int>(numTria)) {
                 SoDebugError::postWarning("SoFCIndexedFaceSet::generateGLArrays",
@@ -765,10 +976,10 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
             }
 
             // the nindices must have the length of numindices
-            int32_t vertex = 0;
-            int index = 0;
+            int32_t vertex = 3 * first;
+            int index = 4 * first;
             float t = transp ? transp[0] : 0;
-            for (std::size_t i=0; i<numTria; i++) {
+            for (std::size_t i=first; i<=last; i++) {
                 const SbColor& c = pcolors[i];
                 for (int j=0; j<3; j++) {
                     face_vertices.push_back(c[0]);
@@ -786,7 +997,8 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
                     face_vertices.push_back(p[1]);
                     face_vertices.push_back(p[2]);
 
-                    face_indices[vertex] = vertex;
+                    if (!partial)
+                        face_indices[vertex] = vertex;
                     vertex++;
                     index++;
                 }
@@ -794,8 +1006,9 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
             }
         }
         else if (matbind == SoMaterialBindingElement::PER_VERTEX_INDEXED) {
-            face_vertices.reserve(3 * numTria * 10); // duplicate each vertex (rgba, normal, vertex)
-            face_indices.resize(3 * numTria);
+            face_vertices.reserve(3 * (last + 1 - first) * 10); // duplicate each vertex (rgba, normal, vertex)
+            if (!partial)
+                face_indices.resize(3 * numTria);
 
             if (numcolors != coords->getNum()) {
                 SoDebugError::postWarning("SoFCIndexedFaceSet::generateGLArrays",
@@ -803,10 +1016,10 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
             }
 
             // the nindices must have the length of numindices
-            int32_t vertex = 0;
-            int index = 0;
+            int32_t vertex = 3 * first;
+            int index = 4 * first;
             float t = transp ? transp[0] : 0;
-            for (std::size_t i=0; i<numTria; i++) {
+            for (std::size_t i=first; i<=last; i++) {
                 for (int j=0; j<3; j++) {
                     const SbColor& c = pcolors[mindices[index]];
                     face_vertices.push_back(c[0]);
@@ -824,7 +1037,8 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
                     face_vertices.push_back(p[1]);
                     face_vertices.push_back(p[2]);
 
-                    face_indices[vertex] = vertex;
+                    if (!partial)
+                        face_indices[vertex] = vertex;
                     vertex++;
                     index++;
                 }
@@ -892,7 +1106,24 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
         }
     }
 
-    render.generateGLArrays(action, matbind, face_vertices, face_indices);
+    if (partial) {
+        // only the colored layouts support a partial update, see updateGLColors()
+        if (matbind != SoMaterialBindingElement::OVERALL && first <= last)
+            render.writeGLArrays(action, 3 * first * 10, face_vertices);
+    }
+    else {
+        render.generateGLArrays(action, matbind, face_vertices, face_indices);
+
+        // remember the colors to detect the changed range on the next update
+        geometryChanged = false;
+        if (pcolors && matbind != SoMaterialBindingElement::OVERALL) {
+            glColors.assign(pcolors, pcolors + numcolors);
+            glTransparency = transp ? transp[0] : 0;
+        }
+        else {
+            glColors.clear();
+        }
+    }
 
     // getVertexData() internally calls readLockNormalCache() that read locks
     // the normal cache. When the cache is not needed any more we must call
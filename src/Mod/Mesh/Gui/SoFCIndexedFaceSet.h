@@ -45,6 +45,13 @@ public:
     ~MeshRenderer();
     void generateGLArrays(SoGLRenderAction*, SoMaterialBindingElement::Binding binding,
         std::vector<float>& vertex, std::vector<int32_t>& index);
+    /// Replaces the vertex data starting at \a offset (in floats)
+    void writeGLArrays(SoGLRenderAction*, std::size_t offset, std::vector<float>& vertex);
+    /// Marks a range of triangles to be rewritten in all GL contexts
+    bool markDirty(SoGLRenderAction*, std::size_t first, std::size_t last);
+    /// Returns and clears the pending range of triangles of the current GL context
+    bool takeDirtyRange(SoGLRenderAction*, std::size_t &first, std::size_t &last);
+    SoMaterialBindingElement::Binding getMaterialBinding() const;
     void renderFacesGLArray(SoGLRenderAction *action);
     void renderCoordsGLArray(SoGLRenderAction *action);
     bool canRenderGLArray(SoGLRenderAction *action) const;
@@ -130,10 +137,16 @@ private:
     void renderVisibleFaces(const SbVec3f *);
 
     void generateGLArrays(SoGLRenderAction * action);
+    void generateGLArrays(SoGLRenderAction * action, std::size_t first, std::size_t last);
+    bool updateGLColors(SoGLRenderAction * action);
 
 private:
     MeshRenderer render;
     GLuint *selectBuf;
+    // colors of the uploaded buffers
+    std::vector<SbColor> glColors;
+    float glTransparency;
+    bool geometryChanged;
 };
 
 } // namespace MeshGui
@@ -55,12 +55,17 @@
 #include <Mod/Mesh/App/Core/Algorithm.h>
 #include <Mod/Mesh/App/Core/Projection.h>
 #include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Mesh.h>
 
 #include <Base/Exception.h>
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
 
+#include <numeric>
+#include <QThread>
+#include <QtConcurrentMap>
+
 
 using namespace MeshPart;
 using MeshCore::MeshKernel;
@@ -70,6 +75,28 @@ using MeshCore::MeshAlgorithm;
 using MeshCore::MeshFacetGrid;
 using MeshCore::MeshFacet;
 
+namespace {
+
+// Calls func for all indices in [0, count) concurrently. The sequencer is
+// advanced by the calling thread after each chunk of indices.
+template <typename Func>
+void concurrentFor(std::size_t count, const char* text, Func func)
+{
+    Base::SequencerLauncher seq(text, count);
+    std::size_t chunk = std::max<std::size_t>(1, QThread::idealThreadCount()) * 4;
+    std::vector<std::size_t> indices;
+    for (std::size_t start = 0; start < count; start += chunk) {
+        std::size_t end = std::min(count, start + chunk);
+        indices.resize(end - start);
+        std::iota(indices.begin(), indices.end(), start);
+        QtConcurrent::blockingMap(indices, func);
+        for (std::size_t i = start; i < end; i++)
+            seq.next();
+    }
+}
+
+}
+
 CurveProjector::CurveProjector(const TopoDS_Shape &aShape, const MeshKernel &pMesh)
 : _Shape(aShape), _Mesh(pMesh)
 {
@@ -101,11 +128,18 @@ CurveProjectorShape::CurveProjectorShape(const TopoDS_Shape &aShape, const MeshK
   Do();
 }
 
+CurveProjectorShape::~CurveProjectorShape()
+{
+}
+
 void CurveProjectorShape::Do(void)
 {
   TopExp_Explorer Ex;
   TopoDS_Shape Edge;
 
+  // build the search structure once for all edges
+  _pBVH.reset(new MeshCore::MeshFacetBVH(_Mesh));
+
   for (Ex.Init(_Shape, TopAbs_EDGE); Ex.More(); Ex.Next())
   {
 	  const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
@@ -233,6 +267,24 @@ bool CurveProjectorShape::findStartPoint(const MeshKernel &MeshK,const Base::Vec
   float MinLength = FLOAT_MAX;
   bool bHit = false;
 
+  // If the point can be projected onto its nearest facet then no other facet
+  // can be closer. Only otherwise the whole mesh must be checked.
+  if (_pBVH && &MeshK == &_Mesh)
+  {
+    float NearestDist;
+    unsigned long NearestIndex = _pBVH->NearestFacet(Pnt, NearestDist);
+    if (NearestIndex != ULONG_MAX)
+    {
+      MeshGeomFacet Facet = MeshK.GetFacet(NearestIndex);
+      if (Facet.Foraminate(Pnt, Facet.GetNormal(), TempResultPoint))
+      {
+        Rslt = TempResultPoint;
+        FaceIndex = NearestIndex;
+        return true;
+      }
+    }
+  }
+
   // go through the whole Mesh
   MeshFacetIterator It(MeshK);
   for(It.Init();It.More();It.Next())
@@ -693,6 +745,18 @@ MeshProjection::~MeshProjection()
 {
 }
 
+const MeshFacetGrid& MeshProjection::getFacetGrid() const
+{
+    if (!_pcGrid) {
+        // calculate the average edge length and create a grid
+        MeshAlgorithm clAlg(_rcMesh);
+        float fAvgLen = clAlg.GetAverageEdgeLength();
+        _pcGrid.reset(new MeshFacetGrid(_rcMesh, 5.0f*fAvgLen));
+    }
+
+    return *_pcGrid;
+}
+
 void MeshProjection::discretize(const TopoDS_Edge& aEdge, std::vector<Base::Vector3f>& polyline, std::size_t minPoints) const
 {
     BRepAdaptor_Curve clCurve(aEdge);
@@ -818,30 +882,28 @@ void MeshProjection::findSectionParameters(const TopoDS_Edge& edge, const Base::
 
 void MeshProjection::projectToMesh (const TopoDS_Shape &aShape, float fMaxDist, std::vector<PolyLine>& rPolyLines) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg( _rcMesh );
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid( _rcMesh, 5.0f*fAvgLen );
-
-    TopExp_Explorer Ex;
+    std::vector<TopoDS_Edge> aEdges;
+    for (TopExp_Explorer Ex(aShape, TopAbs_EDGE); Ex.More(); Ex.Next())
+        aEdges.push_back(TopoDS::Edge(Ex.Current()));
 
-    int iCnt=0;
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next())
-        iCnt++;
+    projectToMesh(aEdges, fMaxDist, rPolyLines);
+}
 
-    Base::SequencerLauncher seq( "Project curve on mesh", iCnt );
+void MeshProjection::projectToMesh (const std::vector<TopoDS_Edge> &aEdges, float fMaxDist, std::vector<PolyLine>& rPolyLines) const
+{
+    const MeshFacetGrid& cGrid = getFacetGrid();
 
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
+    std::vector<PolyLine> polylines(aEdges.size());
+    concurrentFor(aEdges.size(), "Project curve on mesh", [&](std::size_t index) {
         std::vector<SplitEdge> rSplitEdges;
-        projectEdgeToEdge(aEdge, fMaxDist, cGrid, rSplitEdges);
-        PolyLine polyline;
+        projectEdgeToEdge(aEdges[index], fMaxDist, cGrid, rSplitEdges);
+        PolyLine& polyline = polylines[index];
         polyline.points.reserve(rSplitEdges.size());
-        for (auto it : rSplitEdges)
+        for (const auto& it : rSplitEdges)
             polyline.points.push_back(it.cPt);
-        rPolyLines.push_back(polyline);
-        seq.next();
-    }
+    });
+
+    rPolyLines.insert(rPolyLines.end(), polylines.begin(), polylines.end());
 }
 
 void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
@@ -849,10 +911,8 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
                                    float tolerance,
                                    std::vector<Base::Vector3f>& pointsOut) const
 {
-    // calculate the average edge length and create a grid
     MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
+    const MeshFacetGrid& cGrid = getFacetGrid();
 
     // get all boundary points and edges of the mesh
     std::vector<Base::Vector3f> boundaryPoints;
@@ -926,98 +986,70 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
 
 void MeshProjection::projectParallelToMesh (const TopoDS_Shape &aShape, const Base::Vector3f& dir, std::vector<PolyLine>& rPolyLines) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
-    TopExp_Explorer Ex;
+    std::vector<TopoDS_Edge> aEdges;
+    for (TopExp_Explorer Ex(aShape, TopAbs_EDGE); Ex.More(); Ex.Next())
+        aEdges.push_back(TopoDS::Edge(Ex.Current()));
 
-    int iCnt=0;
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next())
-        iCnt++;
+    projectParallelToMesh(aEdges, dir, rPolyLines);
+}
 
-    Base::SequencerLauncher seq( "Project curve on mesh", iCnt );
+void MeshProjection::projectParallelToMesh (const std::vector<TopoDS_Edge> &aEdges, const Base::Vector3f& dir, std::vector<PolyLine>& rPolyLines) const
+{
+    const MeshFacetGrid& cGrid = getFacetGrid();
 
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
+    std::vector<PolyLine> polylines(aEdges.size());
+    concurrentFor(aEdges.size(), "Project curve on mesh", [&](std::size_t index) {
         std::vector<Base::Vector3f> points;
-        discretize(aEdge, points, 5);
-
-        typedef std::pair<Base::Vector3f, unsigned long> HitPoint;
-        std::vector<HitPoint> hitPoints;
-        typedef std::pair<HitPoint, HitPoint> HitPoints;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            unsigned long index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size()-2];
-                    HitPoint p2 = hitPoints[hitPoints.size()-1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
-            }
-        }
-
-        MeshCore::MeshProjection meshProjection(_rcMesh);
-        PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid, it.first.first, it.first.second,
-                                                 it.second.first, it.second.second, dir, points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
-            }
-        }
-        rPolyLines.push_back(polyline);
+        discretize(aEdges[index], points, 5);
+        projectPolylineToMesh(points, dir, cGrid, polylines[index]);
+    });
 
-        seq.next();
-    }
+    rPolyLines.insert(rPolyLines.end(), polylines.begin(), polylines.end());
 }
 
 void MeshProjection::projectParallelToMesh (const std::vector<PolyLine> &aEdges, const Base::Vector3f& dir, std::vector<PolyLine>& rPolyLines) const
 {
-    // calculate the average edge length and create a grid
+    const MeshFacetGrid& cGrid = getFacetGrid();
+
+    std::vector<PolyLine> polylines(aEdges.size());
+    concurrentFor(aEdges.size(), "Project curve on mesh", [&](std::size_t index) {
+        projectPolylineToMesh(aEdges[index].points, dir, cGrid, polylines[index]);
+    });
+
+    rPolyLines.insert(rPolyLines.end(), polylines.begin(), polylines.end());
+}
+
+void MeshProjection::projectPolylineToMesh(const std::vector<Base::Vector3f>& points, const Base::Vector3f& dir,
+                                           const MeshFacetGrid& rGrid, PolyLine& rPolyLine) const
+{
     MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
-
-    Base::SequencerLauncher seq( "Project curve on mesh", aEdges.size() );
-
-    for (auto it : aEdges) {
-        std::vector<Base::Vector3f> points = it.points;
-
-        typedef std::pair<Base::Vector3f, unsigned long> HitPoint;
-        std::vector<HitPoint> hitPoints;
-        typedef std::pair<HitPoint, HitPoint> HitPoints;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            unsigned long index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size()-2];
-                    HitPoint p2 = hitPoints[hitPoints.size()-1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
-            }
-        }
 
-        MeshCore::MeshProjection meshProjection(_rcMesh);
-        PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid, it.first.first, it.first.second,
-                                                 it.second.first, it.second.second, dir, points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
+    typedef std::pair<Base::Vector3f, unsigned long> HitPoint;
+    std::vector<HitPoint> hitPoints;
+    typedef std::pair<HitPoint, HitPoint> HitPoints;
+    std::vector<HitPoints> hitPointPairs;
+    for (auto it : points) {
+        Base::Vector3f result;
+        unsigned long index;
+        if (clAlg.NearestFacetOnRay(it, dir, rGrid, result, index)) {
+            hitPoints.emplace_back(result, index);
+
+            if (hitPoints.size() > 1) {
+                HitPoint p1 = hitPoints[hitPoints.size()-2];
+                HitPoint p2 = hitPoints[hitPoints.size()-1];
+                hitPointPairs.emplace_back(p1, p2);
             }
         }
-        rPolyLines.push_back(polyline);
+    }
 
-        seq.next();
+    MeshCore::MeshProjection meshProjection(_rcMesh);
+    std::vector<Base::Vector3f> section;
+    for (auto it : hitPointPairs) {
+        section.clear();
+        if (meshProjection.projectLineOnMesh(rGrid, it.first.first, it.first.second,
+                                             it.second.first, it.second.second, dir, section)) {
+            rPolyLine.points.insert(rPolyLine.points.end(), section.begin(), section.end());
+        }
     }
 }
 
@@ -1062,11 +1094,8 @@ void MeshProjection::projectEdgeToEdge( const TopoDS_Edge &aEdge, float fMaxDist
     MeshPointIterator cPI( _rcMesh );
     MeshFacetIterator cFI( _rcMesh );
 
-    Base::SequencerLauncher seq( "Project curve on mesh", pEdgeToFace.size() );
     std::map<std::pair<unsigned long, unsigned long>, std::list<unsigned long> >::iterator it;
     for ( it = pEdgeToFace.begin(); it != pEdgeToFace.end(); ++it ) {
-        seq.next();
-
         // edge points
         unsigned long uE0 = it->first.first;
         cPI.Set( uE0 );
@@ -28,6 +28,7 @@
 #  include <gts.h>
 #endif
 
+#include <memory>
 #include <gp_Pln.hxx>
 #include <TopoDS_Edge.hxx>
 
@@ -39,6 +40,7 @@ namespace MeshCore
 class MeshKernel;
 class MeshGeomFacet;
 class MeshFacetGrid;
+class MeshFacetBVH;
 }
 
 using MeshCore::MeshKernel;
@@ -90,7 +92,7 @@ class MeshPartExport CurveProjectorShape: public CurveProjector
 {
 public:
   CurveProjectorShape(const TopoDS_Shape &aShape, const MeshKernel &pMesh);
-  virtual ~CurveProjectorShape() {}
+  virtual ~CurveProjectorShape();
 
   void projectCurve(const TopoDS_Edge& aEdge,
                     std::vector<FaceSplitEdge> &vSplitEdges);
@@ -101,6 +103,10 @@ public:
 
 protected:
   virtual void Do();
+
+private:
+  /// used to find the start points of all edges without scanning the whole mesh
+  std::unique_ptr<MeshCore::MeshFacetBVH> _pBVH;
 };
 
 
@@ -154,6 +160,9 @@ protected:
 
 /**
  * The MeshProjection class projects a shape onto a mesh.
+ * The facet grid used for the search is created on first use and kept for
+ * all further projections, so the mesh must not be modified as long as the
+ * projector is in use. Several edges are projected concurrently.
  * @author Werner Mayer
  */
 class MeshPartExport MeshProjection
@@ -196,6 +205,11 @@ public:
      * taken if the distance between the curve point and the projected point is <= \a fMaxDist.
      */
     void projectToMesh (const TopoDS_Shape &aShape, float fMaxDist, std::vector<PolyLine>& rPolyLines) const;
+    /**
+     * Does the same as above for a list of edges. For each edge a polyline is added
+     * to \a rPolyLines in the order of \a aEdges.
+     */
+    void projectToMesh (const std::vector<TopoDS_Edge> &aEdges, float fMaxDist, std::vector<PolyLine>& rPolyLines) const;
     /**
      * @brief projectOnMesh
      * Projects the given points onto the mesh along a given direction. The points can can be projected
@@ -212,6 +226,11 @@ public:
      * Project all edges of the shape onto the mesh using parallel projection.
      */
     void projectParallelToMesh (const TopoDS_Shape &aShape, const Base::Vector3f& dir, std::vector<PolyLine>& rPolyLines) const;
+    /**
+     * Project all edges onto the mesh using parallel projection. For each edge a polyline
+     * is added to \a rPolyLines in the order of \a aEdges.
+     */
+    void projectParallelToMesh (const std::vector<TopoDS_Edge> &aEdges, const Base::Vector3f& dir, std::vector<PolyLine>& rPolyLines) const;
     /**
      * Project all polylines onto the mesh using parallel projection.
      */
@@ -225,10 +244,14 @@ public:
 protected:
     void projectEdgeToEdge(const TopoDS_Edge &aCurve, float fMaxDist, const MeshCore::MeshFacetGrid& rGrid,
                            std::vector<SplitEdge>& rSplitEdges) const;
+    void projectPolylineToMesh(const std::vector<Base::Vector3f>& points, const Base::Vector3f& dir,
+                               const MeshCore::MeshFacetGrid& rGrid, PolyLine& rPolyLine) const;
     bool findIntersection(const Edge&, const Edge&, const Base::Vector3f& dir, Base::Vector3f& res) const;
+    const MeshCore::MeshFacetGrid& getFacetGrid() const;
 
 private:
     const MeshKernel& _rcMesh;
+    mutable std::unique_ptr<MeshCore::MeshFacetGrid> _pcGrid;
 };
 
 } // namespace MeshPart
@@ -158,6 +158,7 @@ void LscmRelax::relax(double weight)
         this->sol.Zero(this->vertices.cols() * 2 + 3);
     spMat K_g(this->vertices.cols() * 2 + 3, this->vertices.cols() * 2 + 3);
     std::vector<trip> K_g_triplets;
+    K_g_triplets.reserve(this->triangles.cols() * 36 + this->flat_vertices.cols() * 8);
     Vector2 v1, v2, v3, v12, v23, v31;
     long row_pos, col_pos;
     double A;
@@ -286,13 +287,22 @@ void LscmRelax::relax(double weight)
     // rhs +=  K_g * Eigen::VectorXd::Ones(K_g.rows());
     
     // solve linear system (privately store the value for guess in next step)
-    Eigen::SimplicialLDLT<spMat, Eigen::Lower> solver;
-    solver.compute(K_g);
-    this->sol = solver.solve(-rhs);
+    this->solve_relax_system(K_g, -rhs);
     this->set_shift(this->sol.head(this->vertices.cols() * 2) * weight);
     this->set_q_l_m();
 }
 
+void LscmRelax::solve_relax_system(const spMat& K_g, const Eigen::VectorXd& rhs)
+{
+    if (!this->relax_solver || this->relax_solver->rows() != K_g.rows())
+    {
+        this->relax_solver = std::make_shared<Eigen::SimplicialLDLT<spMat, Eigen::Lower>>();
+        this->relax_solver->analyzePattern(K_g);
+    }
+    this->relax_solver->factorize(K_g);
+    this->sol = this->relax_solver->solve(rhs);
+}
+
 
 void LscmRelax::area_relax(double weight)
 {
@@ -482,10 +492,26 @@ void LscmRelax::lscm()
 
     // 6. solve the system and set the flatted coordinates
     // Eigen::SparseQR<spMat, Eigen::COLAMDOrdering<int> > solver;
-    Eigen::LeastSquaresConjugateGradient<spMat > solver;
     Eigen::VectorXd sol(this->vertices.size() * 2);
-    solver.compute(A);
-    sol = solver.solve(-rhs);
+    bool solved = false;
+    {
+        // with the two fixed pins the normal equations are positive definite for a
+        // connected mesh, otherwise fall back to the iterative least squares solver
+        spMat AtA = A.transpose() * A;
+        Eigen::SimplicialLDLT<spMat> solver;
+        solver.compute(AtA);
+        if (solver.info() == Eigen::Success)
+        {
+            sol = solver.solve(A.transpose() * -rhs);
+            solved = sol.allFinite();
+        }
+    }
+    if (!solved)
+    {
+        Eigen::LeastSquaresConjugateGradient<spMat > solver;
+        solver.compute(A);
+        sol = solver.solve(-rhs);
+    }
 
     // TODO: create function, is needed also in the fem step
     this->set_position(sol);
@@ -43,6 +43,7 @@
 
 #include <Eigen/Geometry>
 #include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseCholesky>
 
 typedef Eigen::SparseMatrix<double> spMat;
 
@@ -87,6 +88,11 @@ private:
     Eigen::Matrix<double, 3, 3> C;
     Eigen::VectorXd sol;
 
+    // the sparsity pattern of the relax system doesn't change between the
+    // iterations, so the ordering and the symbolic factorization are reused
+    std::shared_ptr<Eigen::SimplicialLDLT<spMat, Eigen::Lower>> relax_solver;
+    void solve_relax_system(const spMat& K_g, const Eigen::VectorXd& rhs);
+
     std::vector<long> get_fem_fixed_pins();
     Eigen::MatrixXd get_nullspace();
 
@@ -28,11 +28,18 @@
 #include <Base/Exception.h>
 #include <Base/Tools.h>
 #include <Mod/Mesh/App/Mesh.h>
+#include <Mod/Part/App/ShapeTessellator.h>
 #include <Mod/Part/App/TopoShape.h>
 
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
+#include <BRep_Tool.hxx>
 #include <BRepTools.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
+#include <Poly_Triangulation.hxx>
 #include <Standard_Version.hxx>
 
 #ifdef HAVE_SMESH
@@ -121,41 +128,6 @@ int MeshingOutput::sync()
 
 namespace MeshPart {
 
-struct Vertex {
-    static const double deflection;
-    Standard_Real x,y,z;
-    Standard_Integer i;
-    mutable MeshCore::MeshPoint p;
-
-    Vertex(Standard_Real X, Standard_Real Y, Standard_Real Z)
-        : x(X),y(Y),z(Z),i(0)
-    {
-        p.x = static_cast<float>(x);
-        p.y = static_cast<float>(y);
-        p.z = static_cast<float>(z);
-    }
-
-    const MeshCore::MeshPoint& toPoint() const
-    {
-        return p;
-    }
-
-    bool operator < (const Vertex &v) const
-    {
-        if (fabs ( this->x - v.x) >= deflection)
-            return this->x < v.x;
-        if (fabs ( this->y - v.y) >= deflection)
-            return this->y < v.y;
-        if (fabs ( this->z - v.z) >= deflection)
-            return this->z < v.z;
-        return false; // points are considered to be equal
-    }
-};
-
-const double Vertex::deflection = gp::Resolution();
-
-// ----------------------------------------------------------------------------
-
 class BrepMesh {
     bool segments;
     std::vector<uint32_t> colors;
@@ -166,96 +138,40 @@ public:
     {
     }
 
-    Mesh::MeshObject* create(const std::vector<Part::TopoShape::Domain>& domains) const
+    Mesh::MeshObject* create(const Part::ShapeTessellator& tessellator) const
     {
         std::map<uint32_t, std::vector<std::size_t> > colorMap;
         for (std::size_t i=0; i<colors.size(); i++) {
             colorMap[colors[i]].push_back(i);
         }
 
-        bool createSegm = (colors.size() == domains.size());
-
-        MeshCore::MeshFacetArray faces;
-        std::size_t numTriangles = 0;
-        for (auto it : domains)
-            numTriangles += it.facets.size();
-        faces.reserve(numTriangles);
+        const std::vector<std::size_t>& facetsPerFace = tessellator.countFacetsPerFace();
+        bool createSegm = (colors.size() == facetsPerFace.size());
 
-        std::set<Vertex> vertices;
-        Standard_Real x1, y1, z1;
-        Standard_Real x2, y2, z2;
-        Standard_Real x3, y3, z3;
+        // the points and facets are written directly into the arrays of the kernel
+        MeshCore::MeshPointArray verts;
+        verts.resize(tessellator.countPoints());
+        tessellator.getPoints([&verts](std::size_t index, const gp_Pnt& p) {
+            verts[index].Set(static_cast<float>(p.X()),
+                             static_cast<float>(p.Y()),
+                             static_cast<float>(p.Z()));
+        });
 
+        MeshCore::MeshFacetArray faces;
+        faces.resize(tessellator.countFacets());
+        tessellator.getFacets([&faces](std::size_t index, std::size_t p1,
+                                       std::size_t p2, std::size_t p3) {
+            MeshCore::MeshFacet& face = faces[index];
+            face._aulPoints[0] = static_cast<unsigned long>(p1);
+            face._aulPoints[1] = static_cast<unsigned long>(p2);
+            face._aulPoints[2] = static_cast<unsigned long>(p3);
+        });
+
+        // add a segment for each face
         std::vector< std::vector<unsigned long> > meshSegments;
-        std::size_t numMeshFaces = 0;
-
-        for (std::size_t i = 0; i < domains.size(); ++i) {
-            std::size_t numDomainFaces = 0;
-            const Part::TopoShape::Domain& domain = domains[i];
-            for (std::size_t j = 0; j < domain.facets.size(); ++j) {
-                const Part::TopoShape::Facet& tria = domain.facets[j];
-                x1 = domain.points[tria.I1].x;
-                y1 = domain.points[tria.I1].y;
-                z1 = domain.points[tria.I1].z;
-
-                x2 = domain.points[tria.I2].x;
-                y2 = domain.points[tria.I2].y;
-                z2 = domain.points[tria.I2].z;
-
-                x3 = domain.points[tria.I3].x;
-                y3 = domain.points[tria.I3].y;
-                z3 = domain.points[tria.I3].z;
-
-                std::set<Vertex>::iterator it;
-                MeshCore::MeshFacet face;
-
-                // 1st vertex
-                Vertex v1(x1,y1,z1);
-                it = vertices.find(v1);
-                if (it == vertices.end()) {
-                    v1.i = vertices.size();
-                    face._aulPoints[0] = v1.i;
-                    vertices.insert(v1);
-                }
-                else {
-                    face._aulPoints[0] = it->i;
-                }
-
-                // 2nd vertex
-                Vertex v2(x2,y2,z2);
-                it = vertices.find(v2);
-                if (it == vertices.end()) {
-                    v2.i = vertices.size();
-                    face._aulPoints[1] = v2.i;
-                    vertices.insert(v2);
-                }
-                else {
-                    face._aulPoints[1] = it->i;
-                }
-
-                // 3rd vertex
-                Vertex v3(x3,y3,z3);
-                it = vertices.find(v3);
-                if (it == vertices.end()) {
-                    v3.i = vertices.size();
-                    face._aulPoints[2] = v3.i;
-                    vertices.insert(v3);
-                }
-                else {
-                    face._aulPoints[2] = it->i;
-                }
-
-                // make sure that we don't insert invalid facets
-                if (face._aulPoints[0] != face._aulPoints[1] &&
-                    face._aulPoints[1] != face._aulPoints[2] &&
-                    face._aulPoints[2] != face._aulPoints[0]) {
-                    faces.push_back(face);
-                    numDomainFaces++;
-                }
-            }
-
-            // add a segment for the face
-            if (createSegm || this->segments) {
+        if (createSegm || this->segments) {
+            std::size_t numMeshFaces = 0;
+            for (std::size_t numDomainFaces : facetsPerFace) {
                 std::vector<unsigned long> segment(numDomainFaces);
                 std::generate(segment.begin(), segment.end(), Base::iotaGen<unsigned long>(numMeshFaces));
                 numMeshFaces += numDomainFaces;
@@ -263,11 +179,6 @@ public:
             }
         }
 
-        MeshCore::MeshPointArray verts;
-        verts.resize(vertices.size());
-        for (auto it : vertices)
-            verts[it.i] = it.toPoint();
-
         MeshCore::MeshKernel kernel;
         kernel.Adopt(verts, faces, true);
 
@@ -315,6 +226,7 @@ Mesher::Mesher(const TopoDS_Shape& s)
   , relative(false)
   , regular(false)
   , segments(false)
+  , parallel(false)
 #if defined (HAVE_NETGEN)
   , fineness(5)
   , growthRate(0)
@@ -333,16 +245,18 @@ Mesher::~Mesher()
 
 Mesh::MeshObject* Mesher::createStandard() const
 {
-    if (!shape.IsNull()) {
+    if (!shape.IsNull())
         BRepTools::Clean(shape);
-        BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
-    }
 
-    std::vector<Part::TopoShape::Domain> domains;
-    Part::TopoShape(shape).getDomains(domains);
+    // In parallel mode the edges are still discretized once up front and only
+    // the faces are meshed concurrently. So, the mesh stays watertight.
+    Part::ShapeTessellator tessellator(shape);
+    tessellator.setDeflection(deflection, angularDeflection, relative);
+    tessellator.setParallel(parallel);
+    tessellator.perform();
 
     BrepMesh brepmesh(this->segments, this->colors);
-    return brepmesh.create(domains);
+    return brepmesh.create(tessellator);
 }
 
 Mesh::MeshObject* Mesher::createMesh() const
@@ -96,6 +96,11 @@ public:
     { return segments; }
     void setColors(const std::vector<uint32_t>& c)
     { colors = c; }
+    /// Mesh the faces concurrently, only supported by the standard mesher
+    void setParallel(bool s)
+    { parallel = s; }
+    bool isParallel() const
+    { return parallel; }
     //@}
 
 #if defined (HAVE_NETGEN)
@@ -150,6 +155,7 @@ private:
     bool relative;
     bool regular;
     bool segments;
+    bool parallel;
 #if defined (HAVE_NETGEN)
     int fineness;
     double growthRate;
@@ -32,10 +32,16 @@
 # include <sstream>
 #endif
 
+#include <Standard_Version.hxx>
+#if OCC_VERSION_HEX >= 0x070400
+# include <OSD_ThreadPool.hxx>
+#endif
+
 #include <Base/Console.h>
 #include <Base/Interpreter.h>
 #include <Base/Parameter.h>
 #include <Base/ExceptionFactory.h>
+#include <Base/ThreadPool.h>
 
 #include <App/Application.h>
 
@@ -183,6 +189,12 @@ PyMOD_INIT_FUNC(Part)
     Py::Object module(partModule);
     module.setAttr("OCC_VERSION", Py::String(OCC_VERSION_STRING_EXT));
 
+#if OCC_VERSION_HEX >= 0x070400
+    // Let the parallel algorithms of OCC use as many threads as the shared thread pool
+    // so that both together don't oversubscribe the cores
+    OSD_ThreadPool::DefaultPool(Base::ThreadPool::instance().threadCount());
+#endif
+
     // C++ exceptions
     new Base::ExceptionProducer<Part::NullShapeException>;
     new Base::ExceptionProducer<Part::AttachEngineException>;
@@ -134,6 +134,7 @@
 #include "PartFeature.h"
 #include "PartPyCXX.h"
 #include "modelRefine.h"
+#include "ShapeDistance.h"
 
 #ifdef FCUseFreeType
 #  include "FT2FC.h"
@@ -524,8 +525,17 @@ public:
         add_varargs_method("__fromPythonOCC__",&Module::fromPythonOCC,
             "__fromPythonOCC__(occ) -- Helper method to convert a pythonocc shape to an internal shape"
         );
+        add_varargs_method("shapeDistances",&Module::shapeDistances,
+            "shapeDistances(shapes, [maxDistance=-1, pairs]) -- Minimum distances of many pairs of shapes\n"
+            "pairs is a list of (index1, index2) tuples into shapes. If it is omitted all pairs\n"
+            "of different shapes are checked. If maxDistance is not negative only the pairs\n"
+            "closer than maxDistance are returned, and pairs with bounding boxes further\n"
+            "apart are skipped without computing their exact distance.\n"
+            "Returns the tuple (indexes1, indexes2, distances, points1, points2) of lists,\n"
+            "one entry per reported pair."
+        );
         add_varargs_method("clearShapeCache",&Module::clearShapeCache,
-            "clearShapeCache() -- Clears internal shape cache"
+            "clearShapeCache() -- Clears internal shape and result cache"
         );
         add_keyword_method("getShape",&Module::getShape,
             "getShape(obj,subname=None,mat=None,needSubElement=False,transform=True,retType=0):\n"
@@ -2228,6 +2238,59 @@ private:
                 subObj?Py::Object(subObj->getPyObject(),true):Py::Object());
     }
 
+    Py::Object shapeDistances(const Py::Tuple& args)
+    {
+        PyObject *pcShapes;
+        double maxDistance = -1.0;
+        PyObject *pcPairs = Py_None;
+        if (!PyArg_ParseTuple(args.ptr(), "O|dO", &pcShapes, &maxDistance, &pcPairs))
+            throw Py::Exception();
+
+        std::vector<TopoDS_Shape> shapes;
+        for (auto &s : getPyShapes(pcShapes))
+            shapes.push_back(s.getShape());
+
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;
+        if (pcPairs != Py_None) {
+            Py::Sequence list(pcPairs);
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                Py::Sequence pair(*it);
+                if (pair.size() != 2)
+                    throw Py::TypeError("pairs must be a list of (index1, index2) tuples");
+                long first = static_cast<long>(Py::Long(pair[0]));
+                long second = static_cast<long>(Py::Long(pair[1]));
+                if (first < 0 || second < 0)
+                    throw Py::IndexError("Shape index out of range");
+                pairs.emplace_back(first, second);
+            }
+        }
+
+        PY_TRY {
+            ShapeDistance distance;
+            distance.setShapes(shapes);
+            distance.setPairs(pairs);
+            distance.setMaxDistance(maxDistance);
+            distance.perform();
+
+            Py::List indexes1, indexes2, distances, points1, points2;
+            for (const auto& it : distance.results()) {
+                indexes1.append(Py::Long(static_cast<long>(it.first)));
+                indexes2.append(Py::Long(static_cast<long>(it.second)));
+                distances.append(Py::Float(it.distance));
+                points1.append(Py::Vector(Base::Vector3d(it.point1.X(), it.point1.Y(), it.point1.Z())));
+                points2.append(Py::Vector(Base::Vector3d(it.point2.X(), it.point2.Y(), it.point2.Z())));
+            }
+
+            Py::Tuple result(5);
+            result.setItem(0, indexes1);
+            result.setItem(1, indexes2);
+            result.setItem(2, distances);
+            result.setItem(3, points1);
+            result.setItem(4, points2);
+            return result;
+        } _PY_CATCH_OCC(throw Py::Exception())
+    }
+
     Py::Object clearShapeCache(const Py::Tuple &args) {
         if (!PyArg_ParseTuple(args.ptr(),""))
             throw Py::Exception();
@@ -125,7 +125,10 @@ bool AttachExtension::positionBySupport()
     try {
         if (_attacher->mapMode == mmDeactivated)
             return false;
-        getPlacement().setValue(_attacher->calculateAttachedPlacement(getPlacement().getValue()));
+        Base::Placement plm = calculateAttachedPlacement(getPlacement().getValue());
+        // don't touch the placement and its dependents if nothing moved
+        if (plm != getPlacement().getValue())
+            getPlacement().setValue(plm);
         _active = 1;
         return true;
     } catch (ExceptionCancel&) {
@@ -138,7 +141,7 @@ bool AttachExtension::isAttacherActive() const {
     if(_active < 0) {
         _active = 0;
         try {
-            _attacher->calculateAttachedPlacement(getPlacement().getValue());
+            calculateAttachedPlacement(getPlacement().getValue());
             _active = 1;
         } catch (ExceptionCancel&) {
         }
@@ -146,6 +149,77 @@ bool AttachExtension::isAttacherActive() const {
     return _active!=0;
 }
 
+bool AttachExtension::AttachmentKey::operator==(const AttachmentKey& other) const
+{
+    if (attacherType != other.attacherType
+            || objects != other.objects
+            || subNames != other.subNames
+            || placements != other.placements
+            || mapMode != other.mapMode
+            || mapReverse != other.mapReverse
+            || attachParameter != other.attachParameter
+            || surfU != other.surfU
+            || surfV != other.surfV
+            || attachmentOffset != other.attachmentOffset
+            || !(rotation == other.rotation)
+            || shapes.size() != other.shapes.size())
+        return false;
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        if (!shapes[i].IsEqual(other.shapes[i]))
+            return false;
+    }
+    return true;
+}
+
+AttachExtension::AttachmentKey AttachExtension::makeAttachmentKey(const Base::Placement& origPlacement) const
+{
+    AttachmentKey key;
+    key.attacherType = _attacher->getTypeId();
+    key.objects = _attacher->references.getValues();
+    key.subNames = _attacher->references.getSubValues();
+    key.mapMode = _attacher->mapMode;
+    key.mapReverse = _attacher->mapReverse;
+    key.attachParameter = _attacher->attachParameter;
+    key.surfU = _attacher->surfU;
+    key.surfV = _attacher->surfV;
+    key.attachmentOffset = _attacher->attachmentOffset;
+    // only the 'Translate' mode keeps the original orientation
+    if (key.mapMode == mmTranslate)
+        key.rotation = origPlacement.getRotation();
+
+    // A recomputed feature gets a new shape, so comparing the shapes is
+    // sufficient to detect modified references.
+    key.shapes.reserve(key.objects.size());
+    key.placements.reserve(key.objects.size());
+    for (auto obj : key.objects) {
+        auto geof = Base::freecad_dynamic_cast<App::GeoFeature>(obj);
+        if (geof)
+            key.placements.push_back(geof->Placement.getValue());
+        else
+            key.placements.emplace_back();
+        auto feature = Base::freecad_dynamic_cast<Part::Feature>(obj);
+        if (feature)
+            key.shapes.push_back(feature->Shape.getShape().getShape());
+        else
+            key.shapes.emplace_back();
+    }
+    return key;
+}
+
+Base::Placement AttachExtension::calculateAttachedPlacement(const Base::Placement& origPlacement) const
+{
+    AttachmentKey key = makeAttachmentKey(origPlacement);
+    if (_cacheValid && key == _cachedKey)
+        return _cachedPlacement;
+
+    _cacheValid = false;
+    Base::Placement plm = _attacher->calculateAttachedPlacement(origPlacement);
+    _cachedKey = std::move(key);
+    _cachedPlacement = plm;
+    _cacheValid = true;
+    return plm;
+}
+
 short int AttachExtension::extensionMustExecute(void) {
     return DocumentObjectExtension::extensionMustExecute();
 }
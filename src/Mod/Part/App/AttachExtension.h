@@ -128,9 +128,39 @@ protected:
 public:
     void updateAttacherVals();
 
+private:
+    /// The inputs of an attachment, see calculateAttachedPlacement()
+    struct AttachmentKey
+    {
+        Base::Type attacherType;
+        std::vector<App::DocumentObject*> objects;
+        std::vector<std::string> subNames;
+        std::vector<TopoDS_Shape> shapes;
+        std::vector<Base::Placement> placements;
+        Attacher::eMapMode mapMode = Attacher::mmDeactivated;
+        bool mapReverse = false;
+        double attachParameter = 0.0;
+        double surfU = 0.0;
+        double surfV = 0.0;
+        Base::Placement attachmentOffset;
+        Base::Rotation rotation;
+
+        bool operator==(const AttachmentKey&) const;
+    };
+
+    AttachmentKey makeAttachmentKey(const Base::Placement& origPlacement) const;
+    /** Calculates the placement with the attacher unless its references, their
+      * shapes and placements and the attachment parameters are unchanged since
+      * the last successful calculation.
+      */
+    Base::Placement calculateAttachedPlacement(const Base::Placement& origPlacement) const;
+
 private:
     Attacher::AttachEngine* _attacher;
     mutable int _active = -1;
+    mutable AttachmentKey _cachedKey;
+    mutable Base::Placement _cachedPlacement;
+    mutable bool _cacheValid = false;
 };
 
 
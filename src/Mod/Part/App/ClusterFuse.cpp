@@ -0,0 +1,233 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <numeric>
+# include <BRep_Builder.hxx>
+# include <BRepAlgoAPI_Fuse.hxx>
+# include <BRepBndLib.hxx>
+# include <Bnd_Box.hxx>
+# include <Precision.hxx>
+# include <Standard_Failure.hxx>
+# include <Standard_Version.hxx>
+# include <TopoDS_Compound.hxx>
+# include <TopTools_ListOfShape.hxx>
+#endif
+
+#include <QtConcurrentMap>
+
+#include "ClusterFuse.h"
+#include "TopoShape.h"
+#include <Base/Exception.h>
+
+using namespace Part;
+
+ClusterFuse::ClusterFuse()
+  : fuzzyValue(0.0)
+  , glue(false)
+  , numClusters(0)
+{
+}
+
+ClusterFuse::~ClusterFuse()
+{
+}
+
+void ClusterFuse::setArguments(const std::vector<TopoDS_Shape>& shapes)
+{
+    arguments = shapes;
+}
+
+void ClusterFuse::setFuzzyValue(Standard_Real value)
+{
+    fuzzyValue = value;
+}
+
+void ClusterFuse::setGlue(bool on)
+{
+    glue = on;
+}
+
+const TopoDS_Shape& ClusterFuse::shape() const
+{
+    return result;
+}
+
+std::size_t ClusterFuse::countClusters() const
+{
+    return numClusters;
+}
+
+BRepAlgoAPI_Fuse* ClusterFuse::algorithm(std::size_t index) const
+{
+    if (index >= argumentCluster.size() || argumentCluster[index] < 0)
+        return nullptr;
+    return algorithms[argumentCluster[index]].get();
+}
+
+std::vector<std::vector<std::size_t>> ClusterFuse::makeClusters() const
+{
+    std::size_t count = arguments.size();
+    std::vector<Bnd_Box> bounds(count);
+    for (std::size_t i = 0; i < count; i++) {
+        // use the exact geometry because a box of the triangulation can be too small
+        BRepBndLib::Add(arguments[i], bounds[i], Standard_False);
+        bounds[i].SetGap(fuzzyValue + Precision::Confusion());
+    }
+
+    std::vector<std::size_t> parent(count);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](std::size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    // sweep along the x-axis and only compare the boxes that overlap in x
+    std::vector<std::size_t> order(count);
+    std::vector<double> xmin(count), xmax(count);
+    for (std::size_t i = 0; i < count; i++) {
+        Standard_Real x1, y1, z1, x2, y2, z2;
+        if (bounds[i].IsVoid()) {
+            x1 = x2 = 0.0;
+        }
+        else {
+            bounds[i].Get(x1, y1, z1, x2, y2, z2);
+        }
+        xmin[i] = x1;
+        xmax[i] = x2;
+    }
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&xmin](std::size_t a, std::size_t b) {
+        return xmin[a] < xmin[b];
+    });
+
+    std::vector<std::size_t> active;
+    for (std::size_t i : order) {
+        active.erase(std::remove_if(active.begin(), active.end(), [&](std::size_t j) {
+            return xmax[j] < xmin[i];
+        }), active.end());
+        for (std::size_t j : active) {
+            if (!bounds[i].IsOut(bounds[j]))
+                parent[find(i)] = find(j);
+        }
+        active.push_back(i);
+    }
+
+    std::vector<std::vector<std::size_t>> clusters;
+    std::vector<int> clusterOfRoot(count, -1);
+    for (std::size_t i = 0; i < count; i++) {
+        std::size_t root = find(i);
+        if (clusterOfRoot[root] < 0) {
+            clusterOfRoot[root] = static_cast<int>(clusters.size());
+            clusters.emplace_back();
+        }
+        clusters[clusterOfRoot[root]].push_back(i);
+    }
+
+    return clusters;
+}
+
+void ClusterFuse::build()
+{
+    result.Nullify();
+    algorithms.clear();
+    argumentCluster.assign(arguments.size(), -1);
+
+    for (const auto& it : arguments) {
+        if (it.IsNull())
+            throw NullShapeException("Input shape is null");
+    }
+
+    std::vector<std::vector<std::size_t>> clusters = makeClusters();
+    numClusters = clusters.size();
+
+    // only clusters with at least two shapes need a boolean operation
+    std::vector<std::vector<std::size_t>> fuseClusters;
+    for (const auto& it : clusters) {
+        if (it.size() > 1) {
+            for (std::size_t index : it)
+                argumentCluster[index] = static_cast<int>(fuseClusters.size());
+            fuseClusters.push_back(it);
+        }
+    }
+
+    algorithms.resize(fuseClusters.size());
+    std::vector<std::string> errors(fuseClusters.size());
+    std::vector<int> indices(fuseClusters.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, [&](int index) {
+        const std::vector<std::size_t>& cluster = fuseClusters[index];
+        try {
+            std::unique_ptr<BRepAlgoAPI_Fuse> mkFuse(new BRepAlgoAPI_Fuse());
+            TopTools_ListOfShape shapeArguments, shapeTools;
+            shapeArguments.Append(arguments[cluster.front()]);
+            for (auto it = cluster.begin() + 1; it != cluster.end(); ++it)
+                shapeTools.Append(arguments[*it]);
+            mkFuse->SetArguments(shapeArguments);
+            mkFuse->SetTools(shapeTools);
+            mkFuse->SetRunParallel(true);
+#if OCC_VERSION_HEX >= 0x070000
+            // clusters may share sub-shapes, so the arguments must not be modified
+            mkFuse->SetNonDestructive(Standard_True);
+            if (glue)
+                mkFuse->SetGlue(BOPAlgo_GlueShift);
+#endif
+            if (fuzzyValue > 0.0)
+                mkFuse->SetFuzzyValue(fuzzyValue);
+            mkFuse->Build();
+            if (!mkFuse->IsDone())
+                errors[index] = "Fusion failed";
+            algorithms[index] = std::move(mkFuse);
+        }
+        catch (const Standard_Failure& e) {
+            errors[index] = e.GetMessageString();
+        }
+    });
+
+    for (const auto& it : errors) {
+        if (!it.empty())
+            throw Base::RuntimeError(it);
+    }
+
+    if (clusters.size() == 1 && algorithms.size() == 1) {
+        result = algorithms.front()->Shape();
+        return;
+    }
+
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    for (const auto& it : algorithms)
+        builder.Add(comp, it->Shape());
+    for (std::size_t i = 0; i < arguments.size(); i++) {
+        if (argumentCluster[i] < 0)
+            builder.Add(comp, arguments[i]);
+    }
+    result = comp;
+}
@@ -0,0 +1,82 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef PART_CLUSTERFUSE_H
+#define PART_CLUSTERFUSE_H
+
+#include <memory>
+#include <vector>
+#include <Standard_Real.hxx>
+#include <TopoDS_Shape.hxx>
+
+class BRepAlgoAPI_Fuse;
+
+namespace Part {
+
+/**
+ * The ClusterFuse class fuses a large number of shapes. The shapes are divided
+ * into clusters of shapes whose bounding boxes overlap. Shapes of different
+ * clusters cannot interact, so each cluster is fused on its own and the clusters
+ * are processed concurrently. The result is the compound of the fused clusters,
+ * or the fused shape itself if all shapes end up in one cluster.
+ */
+class PartExport ClusterFuse
+{
+public:
+    ClusterFuse();
+    ~ClusterFuse();
+
+    void setArguments(const std::vector<TopoDS_Shape>& shapes);
+    void setFuzzyValue(Standard_Real value);
+    /** The shapes only touch each other but don't overlap. This allows the boolean
+     * algorithm to skip most of the face/face intersections.
+     */
+    void setGlue(bool on);
+    /// Fuses the shapes, throws Base::RuntimeError if a cluster cannot be fused
+    void build();
+
+    const TopoDS_Shape& shape() const;
+    std::size_t countClusters() const;
+    /** Returns the algorithm that fused the argument with index \a index. It can be used
+     * to get the history of the argument. Null is returned if the argument doesn't
+     * interfere with any other argument, it is added to the result unchanged then.
+     */
+    BRepAlgoAPI_Fuse* algorithm(std::size_t index) const;
+
+private:
+    std::vector<std::vector<std::size_t>> makeClusters() const;
+
+private:
+    std::vector<TopoDS_Shape> arguments;
+    Standard_Real fuzzyValue;
+    bool glue;
+    TopoDS_Shape result;
+    std::size_t numClusters;
+    std::vector<std::unique_ptr<BRepAlgoAPI_Fuse>> algorithms;
+    std::vector<int> argumentCluster;
+};
+
+}
+
+#endif // PART_CLUSTERFUSE_H
@@ -27,12 +27,16 @@
 # include <BRepAlgoAPI_Common.hxx>
 # include <BRepAlgoAPI_Cut.hxx>
 # include <BRepAlgoAPI_Section.hxx>
+# include <BRepBndLib.hxx>
 # include <BRepBuilderAPI_MakeFace.hxx>
 # include <BRepBuilderAPI_MakeWire.hxx>
 # include <BRepGProp_Face.hxx>
 # include <BRepPrimAPI_MakeHalfSpace.hxx>
+# include <BRep_Builder.hxx>
+# include <Bnd_Box.hxx>
 # include <gp_Pln.hxx>
 # include <Precision.hxx>
+# include <Standard_Version.hxx>
 # include <ShapeFix_Wire.hxx>
 # include <ShapeAnalysis_FreeBounds.hxx>
 # include <TopExp.hxx>
@@ -42,12 +46,80 @@
 # include <TopoDS.hxx>
 # include <TopoDS_Edge.hxx>
 # include <TopoDS_Wire.hxx>
+# include <TopoDS_Compound.hxx>
+# include <TopTools_ListOfShape.hxx>
+# include <algorithm>
+# include <cfloat>
+# include <cmath>
 #endif
 
+#include <QtConcurrentMap>
+
 #include "CrossSection.h"
 
 using namespace Part;
 
+namespace {
+#if OCC_VERSION_HEX >= 0x070000
+// The arguments must not be modified because the same shape is sliced by
+// several planes at the same time
+void buildNonDestructive(BRepAlgoAPI_BooleanOperation& mkBool, const TopoDS_Shape& shape, const TopoDS_Shape& tool)
+{
+    TopTools_ListOfShape shapeArguments, shapeTools;
+    shapeArguments.Append(shape);
+    shapeTools.Append(tool);
+    mkBool.SetArguments(shapeArguments);
+    mkBool.SetTools(shapeTools);
+    mkBool.SetNonDestructive(Standard_True);
+    mkBool.Build();
+}
+#endif
+
+// The range of the plane distance in which a plane crosses a shape
+struct SliceRange
+{
+    double min;
+    double max;
+
+    SliceRange(double a, double b, double c, const TopoDS_Shape& shape)
+        : min(0.0), max(-1.0)
+    {
+        Bnd_Box box;
+        BRepBndLib::Add(shape, box);
+        if (box.IsVoid())
+            return;
+        Standard_Real x[2], y[2], z[2];
+        box.Get(x[0], y[0], z[0], x[1], y[1], z[1]);
+        min = DBL_MAX;
+        max = -DBL_MAX;
+        for (int i=0; i<2; i++) {
+            for (int j=0; j<2; j++) {
+                for (int k=0; k<2; k++) {
+                    double dist = a*x[i] + b*y[j] + c*z[k];
+                    min = std::min(min, dist);
+                    max = std::max(max, dist);
+                }
+            }
+        }
+        double tol = Precision::Confusion() * std::sqrt(a*a + b*b + c*c);
+        min -= tol;
+        max += tol;
+    }
+    bool contains(double d) const {
+        return min <= d && d <= max;
+    }
+};
+
+struct SlicePart
+{
+    TopoDS_Shape shape;
+    bool solid;
+    SliceRange range;
+    // the faces of a shell with their ranges
+    std::vector<std::pair<TopoDS_Shape, SliceRange>> faces;
+};
+}
+
 
 CrossSection::CrossSection(double a, double b, double c, const TopoDS_Shape& s)
   : a(a), b(b), c(c), s(s)
@@ -73,9 +145,78 @@ std::list<TopoDS_Wire> CrossSection::slice(double d) const
     return wires;
 }
 
+std::vector<std::list<TopoDS_Wire>> CrossSection::slices(const std::vector<double>& d) const
+{
+    // Collect the same parts as slice() does
+    std::vector<SlicePart> parts;
+    TopExp_Explorer xp;
+    for (xp.Init(s, TopAbs_SOLID); xp.More(); xp.Next()) {
+        parts.push_back(SlicePart{xp.Current(), true, SliceRange(a, b, c, xp.Current()), {}});
+    }
+    for (xp.Init(s, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
+        SlicePart part{xp.Current(), false, SliceRange(a, b, c, xp.Current()), {}};
+        for (TopExp_Explorer xf(xp.Current(), TopAbs_FACE); xf.More(); xf.Next())
+            part.faces.emplace_back(xf.Current(), SliceRange(a, b, c, xf.Current()));
+        parts.push_back(part);
+    }
+    for (xp.Init(s, TopAbs_FACE, TopAbs_SHELL); xp.More(); xp.Next()) {
+        parts.push_back(SlicePart{xp.Current(), false, SliceRange(a, b, c, xp.Current()), {}});
+    }
+
+    std::vector<std::list<TopoDS_Wire>> result(d.size());
+    auto sliceAt = [&](int index) {
+        double dist = d[index];
+        std::list<TopoDS_Wire>& wires = result[index];
+        for (const auto& part : parts) {
+            if (!part.range.contains(dist))
+                continue;
+            if (part.solid) {
+                sliceSolid(dist, part.shape, wires);
+            }
+            else if (part.faces.empty()) {
+                sliceNonSolid(dist, part.shape, wires);
+            }
+            else {
+                // only intersect the faces of the shell that the plane crosses
+                TopoDS_Compound comp;
+                BRep_Builder builder;
+                builder.MakeCompound(comp);
+                std::size_t count = 0;
+                for (const auto& face : part.faces) {
+                    if (face.second.contains(dist)) {
+                        builder.Add(comp, face.first);
+                        count++;
+                    }
+                }
+                if (count == part.faces.size())
+                    sliceNonSolid(dist, part.shape, wires);
+                else if (count > 0)
+                    sliceNonSolid(dist, comp, wires);
+            }
+        }
+    };
+
+    std::vector<int> indices(d.size());
+    for (std::size_t i = 0; i < indices.size(); i++)
+        indices[i] = static_cast<int>(i);
+#if OCC_VERSION_HEX >= 0x070000
+    QtConcurrent::blockingMap(indices, sliceAt);
+#else
+    // the boolean operations may modify the shape
+    std::for_each(indices.begin(), indices.end(), sliceAt);
+#endif
+
+    return result;
+}
+
 void CrossSection::sliceNonSolid(double d, const TopoDS_Shape& shape, std::list<TopoDS_Wire>& wires) const
 {
+#if OCC_VERSION_HEX >= 0x070000
+    BRepAlgoAPI_Section cs;
+    buildNonDestructive(cs, shape, BRepBuilderAPI_MakeFace(gp_Pln(a,b,c,-d)).Face());
+#else
     BRepAlgoAPI_Section cs(shape, gp_Pln(a,b,c,-d));
+#endif
     if (cs.IsDone()) {
         std::list<TopoDS_Edge> edges;
         TopExp_Explorer xp;
@@ -113,7 +254,12 @@ void CrossSection::sliceSolid(double d, const TopoDS_Shape& shape, std::list<Top
 
     BRepPrimAPI_MakeHalfSpace mkSolid(face, refPoint);
     TopoDS_Solid solid = mkSolid.Solid();
+#if OCC_VERSION_HEX >= 0x070000
+    BRepAlgoAPI_Cut mkCut;
+    buildNonDestructive(mkCut, shape, solid);
+#else
     BRepAlgoAPI_Cut mkCut(shape, solid);
+#endif
 
     if (mkCut.IsDone()) {
         TopTools_IndexedMapOfShape mapOfFaces;
@@ -36,6 +36,8 @@
 # include <sstream>
 # include <cstdio>
 # include <cstdlib>
+# include <map>
+# include <mutex>
 # include <stdexcept>
 # include <vector>
 
@@ -61,6 +63,8 @@
 #endif // _PreComp
 
 #include <Base/Console.h>
+#include <Base/FileInfo.h>
+#include <Base/TimeInfo.h>
 #include "TopoShape.h"
 #include "TopoShapePy.h"
 #include "TopoShapeEdgePy.h"
@@ -80,12 +84,152 @@ using namespace Part;
 
 typedef unsigned long UNICHAR;           // ul is FT2's codepoint type <=> Py_UNICODE2/4
 
+// Decomposed outline of a glyph at the size GlyphSize, in glyph units
+struct FTGlyph {
+  std::vector<TopoDS_Wire> Wires;       // oriented as needed by OCC
+  FT_Pos Advance;
+};
+
 // Private function prototypes
-PyObject* getGlyphContours(FT_Face FTFont, UNICHAR currchar, double PenPos, double Scale,int charNum, double tracking);
+FTGlyph getGlyphContours(FT_Face FTFont, UNICHAR currchar);
+std::vector<TopoDS_Wire> placeGlyph(const FTGlyph& glyph, double PenPos, double Scale, int charNum, double tracking);
 FT_Vector getKerning(FT_Face FTFont, UNICHAR lc, UNICHAR rc);
 TopoDS_Wire edgesToWire(std::vector<TopoDS_Edge> Edges);
 int calcClockDir(std::vector<Base::Vector3d> points);
 
+namespace {
+
+//  FT2 blows up if char size is not set to some non-zero value.
+//  This sets size to 48 point (in 1/64th of points). Magic.
+const FT_F26Dot6 GlyphSize = 48*64;
+
+// Process-wide cache of opened fonts and their decomposed glyphs. A font is keyed
+// on its file and reopened if the file has changed, its glyphs are keyed on the
+// character. As all glyphs are decomposed at GlyphSize the size is part of the key
+// implicitly. Only the least recently used fonts are kept.
+class FTGlyphCache
+{
+public:
+    struct Font {
+        FT_Face Face = nullptr;
+        Base::TimeInfo Modified;
+        unsigned int FileSize = 0;
+        std::map<UNICHAR, FTGlyph> Glyphs;
+        unsigned long LastUse = 0;
+    };
+
+    static FTGlyphCache& instance()
+    {
+        static FTGlyphCache cache;
+        return cache;
+    }
+
+    // FreeType objects must not be used from several threads at once
+    std::mutex& mutex()
+    {
+        return Mutex;
+    }
+
+    Font& getFont(const char *FontSpec)
+    {
+        std::stringstream ErrorMsg;
+        if (!Library) {
+            FT_Error error = FT_Init_FreeType(&Library);
+            if (error) {
+                Library = nullptr;
+                ErrorMsg << "FT_Init_FreeType failed: " << error;
+                throw std::runtime_error(ErrorMsg.str());
+            }
+        }
+
+        Base::FileInfo fi(FontSpec);
+        auto it = Fonts.find(FontSpec);
+        if (it != Fonts.end()) {
+            if (it->second.Modified == fi.lastModified() && it->second.FileSize == fi.size()) {
+                it->second.LastUse = ++UseCount;
+                return it->second;
+            }
+            FT_Done_Face(it->second.Face);
+            Fonts.erase(it);
+        }
+
+        if (Fonts.size() >= MaxFonts) {
+            auto lru = Fonts.begin();
+            for (auto jt = Fonts.begin(); jt != Fonts.end(); ++jt) {
+                if (jt->second.LastUse < lru->second.LastUse)
+                    lru = jt;
+            }
+            FT_Done_Face(lru->second.Face);
+            Fonts.erase(lru);
+        }
+
+        FT_Face FTFont;
+        FT_Long FaceIndex = 0;                   // some fonts have multiple faces
+        FT_Error error = FT_New_Face(Library,FontSpec,FaceIndex, &FTFont);
+        if (error) {
+            ErrorMsg << "FT_New_Face failed: " << error;
+            throw std::runtime_error(ErrorMsg.str());
+        }
+
+//TODO: check that FTFont is scalable?  only relevant for hinting etc?
+
+        error = FT_Set_Char_Size(FTFont,
+                                 0,             /* char_width in 1/64th of points */
+                                 GlyphSize,     /* char_height in 1/64th of points */
+                                 0,             /* horizontal device resolution */
+                                 0 );           /* vertical device resolution */
+        if (error) {
+            FT_Done_Face(FTFont);
+            ErrorMsg << "FT_Set_Char_Size failed: " << error;
+            throw std::runtime_error(ErrorMsg.str());
+        }
+
+        Font& font = Fonts[FontSpec];
+        font.Face = FTFont;
+        font.Modified = fi.lastModified();
+        font.FileSize = fi.size();
+        font.LastUse = ++UseCount;
+        return font;
+    }
+
+    const FTGlyph& getGlyph(Font& font, UNICHAR currchar)
+    {
+        auto it = font.Glyphs.find(currchar);
+        if (it != font.Glyphs.end())
+            return it->second;
+
+        FT_UInt FTLoadFlags = FT_LOAD_DEFAULT | FT_LOAD_NO_BITMAP;
+        FT_Error error = FT_Load_Char(font.Face,
+                                      currchar,
+                                      FTLoadFlags);
+        if (error) {
+            std::stringstream ErrorMsg;
+            ErrorMsg << "FT_Load_Char failed: " << error;
+            throw std::runtime_error(ErrorMsg.str());
+        }
+
+        return font.Glyphs[currchar] = getGlyphContours(font.Face, currchar);
+    }
+
+private:
+    FTGlyphCache() = default;
+    ~FTGlyphCache()
+    {
+        for (auto& it : Fonts)
+            FT_Done_Face(it.second.Face);
+        if (Library)
+            FT_Done_FreeType(Library);
+    }
+
+    static const std::size_t MaxFonts = 16;
+    std::mutex Mutex;
+    FT_Library Library = nullptr;
+    std::map<std::string, Font> Fonts;
+    unsigned long UseCount = 0;
+};
+
+}
+
 // for compatibility with old version - separate path & filename
 PyObject* FT2FC(const Py_UNICODE *PyUString,
                 const size_t length,
@@ -107,25 +251,33 @@ PyObject* FT2FC(const Py_UNICODE *PyUString,
                 const double stringheight,                 // fc coords
                 const double tracking)                     // fc coords
 {
-    FT_Library  FTLib;
-    FT_Face     FTFont;
-    FT_Error    error;
-    FT_Long     FaceIndex = 0;                   // some fonts have multiple faces
-    FT_Vector   kern;
-    FT_UInt     FTLoadFlags = FT_LOAD_DEFAULT | FT_LOAD_NO_BITMAP;
+    std::vector<std::vector<TopoDS_Wire> > chars = FT2FCWires(PyUString, length, FontSpec,
+                                                              stringheight, tracking);
+    Py::List CharList;
+    for (const auto& it : chars) {
+        Py::List WireList;
+        for (const auto& jt : it) {
+            PyObject* wire = new TopoShapeWirePy(new TopoShape(jt));
+            WireList.append(Py::asObject(wire));
+        }
+        CharList.append(WireList);
+    }
 
+    return Py::new_reference_to(CharList);
+}
+
+// get string's wires (contours) in FC/OCC coords, one list per character
+std::vector<std::vector<TopoDS_Wire> > FT2FCWires(const Py_UNICODE *PyUString,
+                                                  const size_t length,
+                                                  const char *FontSpec,
+                                                  const double stringheight,    // fc coords
+                                                  const double tracking)        // fc coords
+{
+    FT_Vector   kern;
     std::stringstream ErrorMsg;
     double PenPos = 0, scalefactor;
     UNICHAR prevchar = 0, currchar = 0;
-    int  cadv;
     size_t i;
-    Py::List CharList;
-
-    error = FT_Init_FreeType(&FTLib);
-    if (error) {
-        ErrorMsg << "FT_Init_FreeType failed: " << error;
-        throw std::runtime_error(ErrorMsg.str());
-    }
 
 #ifdef FC_OS_WIN32
     Base::FileInfo fi(FontSpec);
@@ -143,61 +295,35 @@ PyObject* FT2FC(const Py_UNICODE *PyUString,
     }
 #endif
 
-
-    error = FT_New_Face(FTLib,FontSpec,FaceIndex, &FTFont);
-    if (error) {
-        ErrorMsg << "FT_New_Face failed: " << error;
-        throw std::runtime_error(ErrorMsg.str());
-    }
-
-//TODO: check that FTFont is scalable?  only relevant for hinting etc?
-
-//  FT2 blows up if char size is not set to some non-zero value.
-//  This sets size to 48 point. Magic.
-    error = FT_Set_Char_Size(FTFont,
-                             0,             /* char_width in 1/64th of points */
-                             48*64,         /* char_height in 1/64th of points */
-                             0,             /* horizontal device resolution */
-                             0 );           /* vertical device resolution */
-    if (error) {
-        ErrorMsg << "FT_Set_Char_Size failed: " << error;
-        throw std::runtime_error(ErrorMsg.str());
-    }
-
-    scalefactor = stringheight/float(FTFont->height);
-    for (i=0; i<length; i++) {
-        currchar = PyUString[i];
-        error = FT_Load_Char(FTFont,
-                             currchar,
-                             FTLoadFlags);
-        if (error) {
-            ErrorMsg << "FT_Load_Char failed: " << error;
-            throw std::runtime_error(ErrorMsg.str());
-        }
-
-        cadv = FTFont->glyph->advance.x;
-        kern = getKerning(FTFont,prevchar,currchar);
-        PenPos += kern.x;
-        try {
-            Py::List WireList(getGlyphContours(FTFont, currchar, PenPos, scalefactor, i, tracking), true);
-            CharList.append(WireList);
-        }
-        catch (Py::Exception& e) {
-            e.clear();
-            Base::Console().Log("FT2FC char '0x%04x'/'%d' has no Wires!\n", currchar, currchar);
+    // Collect the cached glyphs with their pen positions. The wires are only
+    // handles to the cached shapes so that they can be placed without the lock.
+    std::vector<std::pair<FTGlyph, double> > glyphs;
+    glyphs.reserve(length);
+    {
+        FTGlyphCache& cache = FTGlyphCache::instance();
+        std::lock_guard<std::mutex> lock(cache.mutex());
+        FTGlyphCache::Font& font = cache.getFont(FontSpec);
+        FT_Face FTFont = font.Face;
+
+        scalefactor = stringheight/float(FTFont->height);
+        for (i=0; i<length; i++) {
+            currchar = PyUString[i];
+            const FTGlyph& glyph = cache.getGlyph(font, currchar);
+            kern = getKerning(FTFont,prevchar,currchar);
+            PenPos += kern.x;
+            glyphs.emplace_back(glyph, PenPos);
+            PenPos += glyph.Advance;
+            prevchar = currchar;
         }
-
-        PenPos += cadv;
-        prevchar = currchar;
     }
 
-    error = FT_Done_FreeType(FTLib);
-    if (error) {
-        ErrorMsg << "FT_Done_FreeType failed: " << error;
-        throw std::runtime_error(ErrorMsg.str());
+    std::vector<std::vector<TopoDS_Wire> > CharList;
+    CharList.reserve(glyphs.size());
+    for (i=0; i<glyphs.size(); i++) {
+        CharList.push_back(placeGlyph(glyphs[i].first, glyphs[i].second, scalefactor, i, tracking));
     }
 
-    return Py::new_reference_to(CharList);
+    return CharList;
 }
 
 //********** FT Decompose callbacks and data defns
@@ -312,8 +438,8 @@ static FT_Outline_Funcs FTcbFuncs = {
 };
 
 //********** FT2FC Helpers
-// get glyph outline in wires
-PyObject* getGlyphContours(FT_Face FTFont, UNICHAR currchar, double PenPos, double Scale, int charNum, double tracking) {
+// get glyph outline in wires, in glyph units
+FTGlyph getGlyphContours(FT_Face FTFont, UNICHAR currchar) {
    FT_Error error = 0;
    std::stringstream ErrorMsg;
    gp_Pnt origin = gp_Pnt(0.0,0.0,0.0);
@@ -346,16 +472,6 @@ PyObject* getGlyphContours(FT_Face FTFont, UNICHAR currchar, double PenPos, doub
         isTTF = true;
    }
 
-   Py::List list;
-
-   gp_Vec pointer = gp_Vec(PenPos * Scale + charNum*tracking,0.0,0.0);
-   gp_Trsf xForm;
-   xForm.SetScale(origin,Scale);
-   xForm.SetTranslationPart(pointer);
-   BRepBuilderAPI_Transform BRepScale(xForm);
-   bool bCopy = true;                                                           // no effect?
-
-
    int wCount = 0;
    for(std::vector<TopoDS_Wire>::iterator iWire=ctx.Wires.begin();iWire != ctx.Wires.end(); ++iWire, wCount++) {
        if ((ctx.wDir[wCount] == CLOCKWISE) && isTTF) {         //ttf outer wire. fill inside / right
@@ -370,17 +486,37 @@ PyObject* getGlyphContours(FT_Face FTFont, UNICHAR currchar, double PenPos, doub
             //this is likely a poorly constructed font (ex a ttf with outer wires ACW )
             Base::Console().Message("FT2FC::getGlyphContours - indeterminate wire direction\n");
        }
+   }
+
+   FTGlyph glyph;
+   glyph.Wires.swap(ctx.Wires);
+   glyph.Advance = FTFont->glyph->advance.x;
+   return glyph;
+}
+
+// scale and move the cached glyph wires to their place in the string
+std::vector<TopoDS_Wire> placeGlyph(const FTGlyph& glyph, double PenPos, double Scale, int charNum, double tracking) {
+   std::stringstream ErrorMsg;
+   gp_Pnt origin = gp_Pnt(0.0,0.0,0.0);
+   std::vector<TopoDS_Wire> list;
+
+   gp_Vec pointer = gp_Vec(PenPos * Scale + charNum*tracking,0.0,0.0);
+   gp_Trsf xForm;
+   xForm.SetScale(origin,Scale);
+   xForm.SetTranslationPart(pointer);
+   BRepBuilderAPI_Transform BRepScale(xForm);
+   bool bCopy = true;                    // the cached wires must not be modified
 
-       BRepScale.Perform(*iWire,bCopy);
+   for (const auto& iWire : glyph.Wires) {
+       BRepScale.Perform(iWire,bCopy);
        if (!BRepScale.IsDone())  {
           ErrorMsg << "FT2FC OCC BRepScale failed \n";
           throw std::runtime_error(ErrorMsg.str());
        }
 
-       PyObject* wire = new TopoShapeWirePy(new TopoShape(TopoDS::Wire(BRepScale.Shape())));
-       list.append(Py::asObject(wire));
+       list.push_back(TopoDS::Wire(BRepScale.Shape()));
    }
-   return Py::new_reference_to(list);
+   return list;
 }
 
 // get kerning values for this char pair
@@ -29,6 +29,10 @@
 // Public header for FT2FC.cpp
 #ifndef FT2FC_H
 #define FT2FC_H
+
+#include <vector>
+#include <TopoDS_Wire.hxx>
+
 // public functions
 PyObject* FT2FC(const Py_UNICODE *unichars,
                 const size_t length,
@@ -43,4 +47,12 @@ PyObject* FT2FC(const Py_UNICODE *unichars,
                 const double stringheight,
                 const double tracking);
 
+// The glyph outlines are cached per font file, so that strings with the same
+// font don't decompose them again
+std::vector<std::vector<TopoDS_Wire> > FT2FCWires(const Py_UNICODE *unichars,
+                                                  const size_t length,
+                                                  const char *FontSpec,
+                                                  const double stringheight,
+                                                  const double tracking);
+
 #endif // FT2FC_H
@@ -47,9 +47,14 @@
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
 # include <BRepBuilderAPI_Copy.hxx>
+# include <NCollection_UBTree.hxx>
+# include <algorithm>
+# include <numeric>
 # include <QtGlobal>
 #endif
 
+#include <QtConcurrentMap>
+
 #include "FaceMakerBullseye.h"
 #include "FaceMakerCheese.h"
 
@@ -59,6 +64,29 @@
 
 using namespace Part;
 
+namespace {
+typedef NCollection_UBTree<int, Bnd_Box> BoxTree;
+
+// Collects the indices of the boxes that contain a point
+class PointSelector : public BoxTree::Selector
+{
+public:
+    explicit PointSelector(const gp_Pnt& p) : point(p) {}
+    Standard_Boolean Reject(const Bnd_Box& box) const override {
+        return box.IsOut(point);
+    }
+    Standard_Boolean Accept(const int& index) override {
+        indices.push_back(index);
+        return Standard_True;
+    }
+
+    std::vector<int> indices;
+
+private:
+    gp_Pnt point;
+};
+}
+
 TYPESYSTEM_SOURCE(Part::FaceMakerBullseye, Part::FaceMakerPublic)
 
 void FaceMakerBullseye::setPlane(const gp_Pln &plane)
@@ -106,35 +134,69 @@ void FaceMakerBullseye::Build_Essence()
         plane = GeomAdaptor_Surface(planeFinder.Surface()).Plane();
     }
 
+    //compute the bounding boxes and the directions of all wires concurrently.
+    const std::vector<TopoDS_Wire>& wires = this->myWires;
+    std::vector<Bnd_Box> boxes(wires.size());
+    std::vector<int> directions(wires.size());
+    std::vector<int> order(wires.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<std::string> errors(wires.size());
+    QtConcurrent::blockingMap(order, [&](int i) {
+        try {
+            BRepBndLib::Add(wires[i], boxes[i]);
+            boxes[i].SetGap(0.0);
+            directions[i] = FaceDriller::getWireDirection(plane, wires[i]);
+        }
+        catch (const Standard_Failure& e) {
+            errors[i] = e.GetMessageString();
+            if (errors[i].empty())
+                errors[i] = "Unknown OCC exception";
+        }
+    });
+    for (const std::string& error : errors) {
+        if (!error.empty())
+            throw Standard_Failure(error.c_str());
+    }
+
     //sort wires by length of diagonal of bounding box.
-    std::vector<TopoDS_Wire> wires = this->myWires;
-    std::stable_sort(wires.begin(), wires.end(), FaceMakerCheese::Wire_Compare());
+    std::stable_sort(order.begin(), order.end(), [&boxes](int a, int b) {
+        return boxes[a].SquareExtent() < boxes[b].SquareExtent();
+    });
 
     //add wires one by one to current set of faces.
     //We go from last to first, to make it so that outer wires come before inner wires.
     std::vector< std::unique_ptr<FaceDriller> > faces;
-    for (int i = static_cast<int>(wires.size())-1; i >= 0; --i) {
-        TopoDS_Wire &w = wires[i];
+    BoxTree faceTree;
+    for (int i = static_cast<int>(order.size())-1; i >= 0; --i) {
+        int index = order[i];
+        const TopoDS_Wire &w = wires[index];
 
         //test if this wire is on any of existing faces (if yes, it's a hole;
         // if no, it's a beginning of a new face).
         //Since we are assuming the wires do not intersect, testing if one vertex of wire is in a face is enough.
+        //Only the faces whose bounding box contains the point need to be tested.
         gp_Pnt p = BRep_Tool::Pnt(TopoDS::Vertex(TopExp_Explorer(w, TopAbs_VERTEX).Current()));
+        PointSelector selector(p);
+        faceTree.Select(selector);
+        std::sort(selector.indices.begin(), selector.indices.end());
         FaceDriller* foundFace = nullptr;
-        for(std::unique_ptr<FaceDriller> &ff : faces){
-            if(ff->hitTest(p)){
-                foundFace = &(*ff);
+        for (int faceIndex : selector.indices) {
+            if (faces[faceIndex]->hitTest(p)) {
+                foundFace = faces[faceIndex].get();
                 break;
             }
         }
 
         if(foundFace){
             //wire is on a face.
-            foundFace->addHole(w);
+            foundFace->addHole(w, directions[index]);
         } else {
             //wire is not on a face. Start a new face.
+            Bnd_Box faceBox = boxes[index];
+            faceBox.Enlarge(Precision::Confusion());
+            faceTree.Add(static_cast<int>(faces.size()), faceBox);
             faces.push_back(std::unique_ptr<FaceDriller>(
-                                new FaceDriller(plane, w)
+                                new FaceDriller(plane, w, directions[index])
                            ));
         }
     }
@@ -147,12 +209,17 @@ void FaceMakerBullseye::Build_Essence()
 
 
 FaceMakerBullseye::FaceDriller::FaceDriller(const gp_Pln& plane, TopoDS_Wire outerWire)
+    : FaceDriller(plane, outerWire, getWireDirection(plane, outerWire))
+{
+}
+
+FaceMakerBullseye::FaceDriller::FaceDriller(const gp_Pln& plane, TopoDS_Wire outerWire, int direction)
 {
     this->myPlane = plane;
     this->myFace = TopoDS_Face();
 
     //Ensure correct orientation of the wire.
-    if (getWireDirection(myPlane, outerWire) < 0)
+    if (direction < 0)
         outerWire.Reverse();
 
     myHPlane = new Geom_Plane(this->myPlane);
@@ -178,9 +245,14 @@ bool FaceMakerBullseye::FaceDriller::hitTest(const gp_Pnt& point) const
 }
 
 void FaceMakerBullseye::FaceDriller::addHole(TopoDS_Wire w)
+{
+    addHole(w, getWireDirection(myPlane, w));
+}
+
+void FaceMakerBullseye::FaceDriller::addHole(TopoDS_Wire w, int direction)
 {
     //Ensure correct orientation of the wire.
-    if (getWireDirection(myPlane, w) > 0) //if wire is CCW..
+    if (direction > 0) //if wire is CCW..
         w.Reverse();   //.. we want CW!
 
     BRep_Builder builder;
@@ -75,6 +75,8 @@ protected:
     {
     public:
         FaceDriller(const gp_Pln& plane, TopoDS_Wire outerWire);
+        /// \a direction is the result of getWireDirection() for \a outerWire
+        FaceDriller(const gp_Pln& plane, TopoDS_Wire outerWire, int direction);
 
         /**
          * @brief hitTest: returns True if point is on the face
@@ -83,6 +85,8 @@ protected:
         bool hitTest(const gp_Pnt& point) const;
 
         void addHole(TopoDS_Wire w);
+        /// \a direction is the result of getWireDirection() for \a w
+        void addHole(TopoDS_Wire w, int direction);
 
         const TopoDS_Face& Face() const {return myFace;}
     public:
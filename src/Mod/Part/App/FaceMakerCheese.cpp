@@ -43,15 +43,82 @@
 # include <TopExp_Explorer.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
+# include <NCollection_UBTree.hxx>
+# include <NCollection_UBTreeFiller.hxx>
+# include <algorithm>
+# include <numeric>
 # include <QtGlobal>
+# include <QThread>
 #endif
 
+#include <QtConcurrentMap>
+
 #include "FaceMakerCheese.h"
 
 
 
 using namespace Part;
 
+namespace {
+typedef NCollection_UBTree<int, Bnd_Box> BoxTree;
+
+// Collects the indices of the boxes that overlap a given box
+class BoxSelector : public BoxTree::Selector
+{
+public:
+    explicit BoxSelector(const Bnd_Box& box) : box(box) {}
+    Standard_Boolean Reject(const Bnd_Box& other) const override {
+        return box.IsOut(other);
+    }
+    Standard_Boolean Accept(const int& index) override {
+        indices.push_back(index);
+        return Standard_True;
+    }
+
+    std::vector<int> indices;
+
+private:
+    Bnd_Box box;
+};
+
+// Classifies points against a planar face. The classifier caches data, so each
+// thread needs its own instance.
+class PointClassifier
+{
+public:
+    explicit PointClassifier(const TopoDS_Face& face)
+        : class2d(face, Precision::Confusion())
+        , surf(Handle(Geom_Surface)(new Geom_Plane(BRepAdaptor_Surface(face).Plane())))
+    {
+    }
+    bool isInside(const gp_Pnt& p) {
+        gp_Pnt2d uv = surf.ValueOfUV(p, Precision::Confusion());
+        return class2d.Perform(uv) == TopAbs_IN;
+    }
+
+private:
+    IntTools_FClass2d class2d;
+    ShapeAnalysis_Surface surf;
+};
+
+TopoDS_Face makeWireFace(const TopoDS_Wire& wire)
+{
+    BRepBuilderAPI_MakeFace mkFace(wire);
+    if (!mkFace.IsDone())
+        Standard_Failure::Raise("Failed to create a face from wire in sketch");
+    return FaceMakerCheese::validateFace(mkFace.Face());
+}
+
+bool firstPoint(const TopoDS_Wire& wire, gp_Pnt& p)
+{
+    TopExp_Explorer xp(wire, TopAbs_VERTEX);
+    if (!xp.More())
+        return false;
+    p = BRep_Tool::Pnt(TopoDS::Vertex(xp.Current()));
+    return true;
+}
+}
+
 TYPESYSTEM_SOURCE(Part::FaceMakerCheese, Part::FaceMakerPublic)
 
 
@@ -128,34 +195,65 @@ bool FaceMakerCheese::isInside(const TopoDS_Wire& wire1, const TopoDS_Wire& wire
     if (box1.IsOut(box2))
         return false;
 
-    double prec = Precision::Confusion();
+    PointClassifier classifier(makeWireFace(wire1));
 
-    BRepBuilderAPI_MakeFace mkFace(wire1);
-    if (!mkFace.IsDone())
-        Standard_Failure::Raise("Failed to create a face from wire in sketch");
-    TopoDS_Face face = validateFace(mkFace.Face());
-    BRepAdaptor_Surface adapt(face);
-    IntTools_FClass2d class2d(face, prec);
-    Handle(Geom_Surface) surf = new Geom_Plane(adapt.Plane());
-    ShapeAnalysis_Surface as(surf);
-
-    TopExp_Explorer xp(wire2,TopAbs_VERTEX);
-    while (xp.More())  {
-        TopoDS_Vertex v = TopoDS::Vertex(xp.Current());
-        gp_Pnt p = BRep_Tool::Pnt(v);
-        gp_Pnt2d uv = as.ValueOfUV(p, prec);
-        if (class2d.Perform(uv) == TopAbs_IN)
-            return true;
-        // TODO: We can make a check to see if all points are inside or all outside
-        // because otherwise we have some intersections which is not allowed
-        else
-            return false;
-        //xp.Next();
-    }
+    // TODO: We can make a check to see if all points are inside or all outside
+    // because otherwise we have some intersections which is not allowed
+    gp_Pnt p;
+    if (firstPoint(wire2, p))
+        return classifier.isInside(p);
 
     return false;
 }
 
+std::vector<bool> FaceMakerCheese::isInside(const TopoDS_Wire& wire, const std::vector<TopoDS_Wire>& wires)
+{
+    std::vector<bool> result(wires.size(), false);
+    if (wires.empty())
+        return result;
+
+    TopoDS_Face face = makeWireFace(wire);
+    std::vector<char> inside(wires.size(), 0);
+    std::vector<char> failed;
+    auto classify = [&](std::size_t begin, std::size_t end) {
+        PointClassifier classifier(face);
+        for (std::size_t i = begin; i < end; i++) {
+            gp_Pnt p;
+            if (firstPoint(wires[i], p))
+                inside[i] = classifier.isInside(p) ? 1 : 0;
+        }
+    };
+
+    // A small number of wires is not worth the setup of several classifiers
+    const std::size_t minWiresPerThread = 32;
+    std::size_t numThreads = std::min<std::size_t>(std::max(QThread::idealThreadCount(), 1),
+                                                   wires.size() / minWiresPerThread);
+    if (numThreads <= 1) {
+        classify(0, wires.size());
+    }
+    else {
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        std::size_t chunk = (wires.size() + numThreads - 1) / numThreads;
+        for (std::size_t begin = 0; begin < wires.size(); begin += chunk)
+            ranges.emplace_back(begin, std::min(begin + chunk, wires.size()));
+        failed.resize(ranges.size(), 0);
+        QtConcurrent::blockingMap(ranges, [&](const std::pair<std::size_t, std::size_t>& range) {
+            try {
+                classify(range.first, range.second);
+            }
+            catch (const Standard_Failure&) {
+                failed[&range - ranges.data()] = 1;
+            }
+        });
+        if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+            Standard_Failure::Raise("Failed to classify wires in sketch");
+    }
+
+    for (std::size_t i = 0; i < wires.size(); i++)
+        result[i] = inside[i] != 0;
+    return result;
+}
+
 TopoDS_Shape FaceMakerCheese::makeFace(std::list<TopoDS_Wire>& wires)
 {
     BRepBuilderAPI_MakeFace mkFace(wires.front());
@@ -193,29 +291,70 @@ TopoDS_Shape FaceMakerCheese::makeFace(const std::vector<TopoDS_Wire>& w)
     if (w.empty())
         return TopoDS_Shape();
 
+    // the bounding boxes are computed once and not in every comparison
+    std::vector<Bnd_Box> boxes(w.size());
+    std::vector<int> indices(w.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, [&](int i) {
+        if (!w[i].IsNull()) {
+            BRepBndLib::Add(w[i], boxes[i]);
+            boxes[i].SetGap(0.0);
+        }
+    });
+
     //FIXME: Need a safe method to sort wire that the outermost one comes last
     // Currently it's done with the diagonal lengths of the bounding boxes
-    std::vector<TopoDS_Wire> wires = w;
-    std::sort(wires.begin(), wires.end(), Wire_Compare());
-    std::list<TopoDS_Wire> wire_list;
-    wire_list.insert(wire_list.begin(), wires.rbegin(), wires.rend());
+    std::vector<int> order = indices;
+    std::sort(order.begin(), order.end(), [&boxes](int a, int b) {
+        return boxes[a].SquareExtent() > boxes[b].SquareExtent();
+    });
+    std::vector<int> rank(w.size());
+    for (std::size_t i = 0; i < order.size(); i++)
+        rank[order[i]] = static_cast<int>(i);
+
+    // a wire can only lie inside another wire if their bounding boxes overlap
+    BoxTree tree;
+    {
+        NCollection_UBTreeFiller<int, Bnd_Box> filler(tree);
+        for (std::size_t i = 0; i < boxes.size(); i++) {
+            if (!boxes[i].IsVoid())
+                filler.Add(static_cast<int>(i), boxes[i]);
+        }
+        filler.Fill();
+    }
 
     // separate the wires into several independent faces
+    std::vector<bool> assigned(w.size(), false);
     std::list< std::list<TopoDS_Wire> > sep_wire_list;
-    while (!wire_list.empty()) {
+    for (int outer : order) {
+        if (assigned[outer])
+            continue;
+        assigned[outer] = true;
+
         std::list<TopoDS_Wire> sep_list;
-        TopoDS_Wire wire = wire_list.front();
-        wire_list.pop_front();
-        sep_list.push_back(wire);
-
-        std::list<TopoDS_Wire>::iterator it = wire_list.begin();
-        while (it != wire_list.end()) {
-            if (isInside(wire, *it)) {
-                sep_list.push_back(*it);
-                it = wire_list.erase(it);
-            }
-            else {
-                ++it;
+        sep_list.push_back(w[outer]);
+
+        BoxSelector selector(boxes[outer]);
+        if (!boxes[outer].IsVoid())
+            tree.Select(selector);
+        std::vector<int> candidates;
+        for (int index : selector.indices) {
+            if (!assigned[index])
+                candidates.push_back(index);
+        }
+        std::sort(candidates.begin(), candidates.end(), [&rank](int a, int b) {
+            return rank[a] < rank[b];
+        });
+
+        std::vector<TopoDS_Wire> candidateWires;
+        candidateWires.reserve(candidates.size());
+        for (int index : candidates)
+            candidateWires.push_back(w[index]);
+        std::vector<bool> inside = isInside(w[outer], candidateWires);
+        for (std::size_t i = 0; i < candidates.size(); i++) {
+            if (inside[i]) {
+                sep_list.push_back(candidateWires[i]);
+                assigned[candidates[i]] = true;
             }
         }
 
@@ -26,6 +26,7 @@
 #include "FaceMaker.h"
 #include <list>
 #include <functional>
+#include <vector>
 
 namespace Part
 {
@@ -59,6 +60,8 @@ public: //in Extrusion, they used to be private. but they are also used by PartD
     static TopoDS_Shape makeFace(const std::vector<TopoDS_Wire>&);
     static TopoDS_Face validateFace(const TopoDS_Face&);
     static bool isInside(const TopoDS_Wire&, const TopoDS_Wire&);
+    /// Tests for each wire of \a wires if it lies inside \a wire. The tests run concurrently.
+    static std::vector<bool> isInside(const TopoDS_Wire& wire, const std::vector<TopoDS_Wire>& wires);
 
 private:
     static TopoDS_Shape makeFace(std::list<TopoDS_Wire>&); // for internal use only
@@ -75,6 +75,9 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn *execute(void) override;
     short mustExecute() const override;
+    bool canCacheResult() const override {
+        return true;
+    }
     /// returns the type name of the view provider
     const char* getViewProviderName(void) const override {
         return "PartGui::ViewProviderExtrusion";
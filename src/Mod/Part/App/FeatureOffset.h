@@ -51,6 +51,9 @@ public:
     /// recalculate the feature
     virtual App::DocumentObjectExecReturn *execute(void) override;
     virtual short mustExecute() const override;
+    virtual bool canCacheResult() const override {
+        return true;
+    }
     virtual const char* getViewProviderName(void) const override {
         return "PartGui::ViewProviderOffset";
     }
@@ -26,12 +26,15 @@
 # include <BRepAlgoAPI_BooleanOperation.hxx>
 # include <BRepCheck_Analyzer.hxx>
 # include <Standard_Failure.hxx>
+# include <Standard_Version.hxx>
+# include <TopTools_ListOfShape.hxx>
 # include <memory>
 #endif
 
 #include "FeaturePartBoolean.h"
 #include "modelRefine.h"
 #include <App/Application.h>
+#include <Base/Exception.h>
 #include <Base/Parameter.h>
 
 
@@ -56,6 +59,24 @@ Boolean::Boolean(void)
     this->Refine.setValue(hGrp->GetBool("RefineModel", false));
 }
 
+void Boolean::buildOperation(BRepAlgoAPI_BooleanOperation& mkBool, const TopoDS_Shape& base, const TopoDS_Shape& tool)
+{
+#if OCC_VERSION_HEX >= 0x060900
+    TopTools_ListOfShape shapeArguments, shapeTools;
+    shapeArguments.Append(base);
+    shapeTools.Append(tool);
+    mkBool.SetArguments(shapeArguments);
+    mkBool.SetTools(shapeTools);
+    mkBool.SetRunParallel(true);
+    mkBool.Build();
+#else
+    (void)mkBool;
+    (void)base;
+    (void)tool;
+    throw Base::RuntimeError("Boolean::buildOperation requires OCC 6.9.0 and up.");
+#endif
+}
+
 short Boolean::mustExecute() const
 {
     if (Base.getValue() && Tool.getValue()) {
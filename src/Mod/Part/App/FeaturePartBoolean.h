@@ -58,6 +58,8 @@ public:
 
 protected:
     virtual BRepAlgoAPI_BooleanOperation* makeOperation(const TopoDS_Shape&, const TopoDS_Shape&) const = 0;
+    /// Runs the operation \a mkBool on \a base and \a tool in parallel mode if supported
+    static void buildOperation(BRepAlgoAPI_BooleanOperation& mkBool, const TopoDS_Shape& base, const TopoDS_Shape& tool);
 };
 
 }
@@ -30,6 +30,8 @@
 # include <TopoDS_Iterator.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <TopExp.hxx>
+# include <Standard_Version.hxx>
+# include <memory>
 #endif
 
 
@@ -51,7 +53,13 @@ Common::Common(void)
 BRepAlgoAPI_BooleanOperation* Common::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a section operation:
+#if OCC_VERSION_HEX >= 0x060900
+    std::unique_ptr<BRepAlgoAPI_Common> mkBool(new BRepAlgoAPI_Common());
+    buildOperation(*mkBool, base, tool);
+    return mkBool.release();
+#else
     return new BRepAlgoAPI_Common(base, tool);
+#endif
 }
 
 // ----------------------------------------------------
@@ -24,6 +24,8 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <BRepAlgoAPI_Cut.hxx>
+# include <Standard_Version.hxx>
+# include <memory>
 #endif
 
 
@@ -43,5 +45,11 @@ Cut::Cut(void)
 BRepAlgoAPI_BooleanOperation* Cut::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a cut operation:
+#if OCC_VERSION_HEX >= 0x060900
+    std::unique_ptr<BRepAlgoAPI_Cut> mkBool(new BRepAlgoAPI_Cut());
+    buildOperation(*mkBool, base, tool);
+    return mkBool.release();
+#else
     return new BRepAlgoAPI_Cut(base, tool);
+#endif
 }
@@ -29,10 +29,13 @@
 # include <TopoDS_Iterator.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <TopExp.hxx>
+# include <Standard_Version.hxx>
+# include <memory>
 #endif
 
 
 #include "FeaturePartFuse.h"
+#include "ClusterFuse.h"
 #include "modelRefine.h"
 #include <App/Application.h>
 #include <Base/Parameter.h>
@@ -50,7 +53,13 @@ Fuse::Fuse(void)
 BRepAlgoAPI_BooleanOperation* Fuse::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a fuse operation:
+#if OCC_VERSION_HEX >= 0x060900
+    std::unique_ptr<BRepAlgoAPI_Fuse> mkBool(new BRepAlgoAPI_Fuse());
+    buildOperation(*mkBool, base, tool);
+    return mkBool.release();
+#else
     return new BRepAlgoAPI_Fuse(base, tool);
+#endif
 }
 
 // ----------------------------------------------------
@@ -67,6 +76,7 @@ MultiFuse::MultiFuse(void)
     History.setSize(0);
 
     ADD_PROPERTY_TYPE(Refine,(0),"Boolean",(App::PropertyType)(App::Prop_None),"Refine shape (clean up redundant edges) after this boolean operation");
+    ADD_PROPERTY_TYPE(Glue,(false),"Boolean",(App::PropertyType)(App::Prop_None),"Speed up the fusion of shapes that only touch each other but don't overlap");
 
     //init Refine property
     Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
@@ -79,9 +89,31 @@ short MultiFuse::mustExecute() const
 {
     if (Shapes.isTouched())
         return 1;
+    if (Glue.isTouched())
+        return 1;
     return 0;
 }
 
+/// History of a shape that was copied unchanged into the result
+static ShapeHistory identityHistory(TopAbs_ShapeEnum type, const TopoDS_Shape& newS, const TopoDS_Shape& oldS)
+{
+    ShapeHistory history;
+    history.type = type;
+
+    TopTools_IndexedMapOfShape newM, oldM;
+    TopExp::MapShapes(newS, type, newM);
+    TopExp::MapShapes(oldS, type, oldM);
+    for (int i=1; i<=oldM.Extent(); i++) {
+        int j = newM.FindIndex(oldM(i));
+        if (j > 0)
+            history.shapeMap[i-1].push_back(j-1);
+        else
+            history.shapeMap[i-1] = ShapeHistory::List();
+    }
+
+    return history;
+}
+
 App::DocumentObjectExecReturn *MultiFuse::execute(void)
 {
     std::vector<TopoDS_Shape> s;
@@ -140,28 +172,19 @@ App::DocumentObjectExecReturn *MultiFuse::execute(void)
                 }
             }
 #else
-            BRepAlgoAPI_Fuse mkFuse;
-            TopTools_ListOfShape shapeArguments,shapeTools;
-            const TopoDS_Shape& shape = s.front();
-            if (shape.IsNull())
-                throw Base::RuntimeError("Input shape is null");
-            shapeArguments.Append(shape);
-
-            for (std::vector<TopoDS_Shape>::iterator it = s.begin()+1; it != s.end(); ++it) {
-                if (it->IsNull())
-                    throw Base::RuntimeError("Input shape is null");
-                shapeTools.Append(*it);
-            }
-
-            mkFuse.SetArguments(shapeArguments);
-            mkFuse.SetTools(shapeTools);
-            mkFuse.Build();
-            if (!mkFuse.IsDone())
-                throw Base::RuntimeError("MultiFusion failed");
-
-            TopoDS_Shape resShape = mkFuse.Shape();
-            for (std::vector<TopoDS_Shape>::iterator it = s.begin(); it != s.end(); ++it) {
-                history.push_back(buildHistory(mkFuse, TopAbs_FACE, resShape, *it));
+            // Shapes whose bounding boxes don't overlap are fused in separate clusters
+            ClusterFuse mkFuse;
+            mkFuse.setArguments(s);
+            mkFuse.setGlue(this->Glue.getValue());
+            mkFuse.build();
+
+            TopoDS_Shape resShape = mkFuse.shape();
+            for (std::size_t i = 0; i < s.size(); i++) {
+                BRepAlgoAPI_Fuse* alg = mkFuse.algorithm(i);
+                if (alg)
+                    history.push_back(buildHistory(*alg, TopAbs_FACE, resShape, s[i]));
+                else
+                    history.push_back(identityHistory(TopAbs_FACE, resShape, s[i]));
             }
 #endif
             if (resShape.IsNull())
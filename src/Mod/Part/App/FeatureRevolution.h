@@ -52,6 +52,9 @@ public:
     /// recalculate the feature
     App::DocumentObjectExecReturn *execute(void) override;
     short mustExecute() const override;
+    bool canCacheResult() const override {
+        return true;
+    }
 
     void onChanged(const App::Property* prop) override;
 
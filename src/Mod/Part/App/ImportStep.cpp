@@ -34,6 +34,11 @@
 # include <TopoDS_Shell.hxx>
 # include <TopoDS_Solid.hxx>
 # include <TopoDS_Compound.hxx>
+# include <TopExp.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
+# include <TopTools_MapOfShape.hxx>
+# include <ShapeFix_Shape.hxx>
+# include <algorithm>
 # include <TopExp_Explorer.hxx>
 # include <sstream>
 # include <Standard_Version.hxx>
@@ -70,6 +75,8 @@
 # include <StepElement_AnalysisItemWithinRepresentation.hxx>
 # include <StepVisual_AnnotationCurveOccurrence.hxx>
 
+#include <QtConcurrentMap>
+
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
 #include <App/Application.h>
@@ -87,6 +94,36 @@ bool ReadColors (const Handle(XSControl_WorkSession) &WS, std::map<int, Quantity
 bool ReadNames (const Handle(XSControl_WorkSession) &WS);
 }
 
+/// Runs ShapeFix on every shape, concurrently if the shapes share no edges
+static void healShapes(std::vector<TopoDS_Shape>& shapes)
+{
+    bool shared = false;
+    TopTools_MapOfShape edges;
+    for (auto it = shapes.begin(); it != shapes.end() && !shared; ++it) {
+        TopTools_IndexedMapOfShape own;
+        TopExp::MapShapes(*it, TopAbs_EDGE, own);
+        for (int i=1; i<=own.Extent() && !shared; ++i)
+            shared = !edges.Add(own(i));
+    }
+
+    auto fix = [](TopoDS_Shape& shape) {
+        try {
+            Handle(ShapeFix_Shape) fixer = new ShapeFix_Shape(shape);
+            fixer->Perform();
+            shape = fixer->Shape();
+        }
+        catch (Standard_Failure&) {
+            // keep the shape as it was read from the file
+        }
+    };
+
+    // ShapeFix modifies edges in place so shared topology must not be fixed concurrently
+    if (shared)
+        std::for_each(shapes.begin(), shapes.end(), fix);
+    else
+        QtConcurrent::blockingMap(shapes, fix);
+}
+
 int Part::ImportStepParts(App::Document *pcDoc, const char* Name)
 {
     // Use this to force to link against TKSTEPBase, TKSTEPAttr and TKStep209
@@ -143,62 +180,18 @@ int Part::ImportStepParts(App::Document *pcDoc, const char* Name)
         //ReadColors(aReader.WS(), hash_col);
         //ReadNames(aReader.WS());
 
+        // Collect the objects to create first. Each solid and shell becomes an object
+        // of its own, all other free-flying shapes of a root go into a single compound.
+        std::vector<TopoDS_Shape> items;
         for (Standard_Integer i=1; i<=nbs; i++) {
             Base::Console().Log("STEP:   Transferring Shape %d\n",i);
             aShape = aReader.Shape(i);
 
-            // load each solid as an own object
             TopExp_Explorer ex;
             for (ex.Init(aShape, TopAbs_SOLID); ex.More(); ex.Next())
-            {
-                // get the shape
-                const TopoDS_Solid& aSolid = TopoDS::Solid(ex.Current());
-
-                std::string name = fi.fileNamePure();
-                //Handle(Standard_Transient) ent = tr->EntityFromShapeResult(aSolid, 3);
-                //if (!ent.IsNull()) {
-                //    name += ws->Model()->StringLabel(ent)->ToCString();
-                //}
-
-                Part::Feature *pcFeature;
-                pcFeature = static_cast<Part::Feature*>(pcDoc->addObject("Part::Feature", name.c_str()));
-                pcFeature->Shape.setValue(aSolid);
-
-                // This is a trick to access the GUI via Python and set the color property
-                // of the associated view provider. If no GUI is up an exception is thrown
-                // and cleared immediately
-                std::map<int, Quantity_Color>::iterator it = hash_col.find(aSolid.HashCode(INT_MAX));
-                if (it != hash_col.end()) {
-                    try {
-                        Py::Object obj(pcFeature->getPyObject(), true);
-                        Py::Object vp(obj.getAttr("ViewObject"));
-                        Py::Tuple col(3);
-                        col.setItem(0, Py::Float(it->second.Red()));
-                        col.setItem(1, Py::Float(it->second.Green()));
-                        col.setItem(2, Py::Float(it->second.Blue()));
-                        vp.setAttr("ShapeColor", col);
-                        //Base::Console().Message("Set color to shape\n");
-                    }
-                    catch (Py::Exception& e) {
-                        e.clear();
-                    }
-                }
-            }
-            // load all non-solids now
+                items.push_back(ex.Current());
             for (ex.Init(aShape, TopAbs_SHELL, TopAbs_SOLID); ex.More(); ex.Next())
-            {
-                // get the shape
-                const TopoDS_Shell& aShell = TopoDS::Shell(ex.Current());
-
-                std::string name = fi.fileNamePure();
-                //Handle(Standard_Transient) ent = tr->EntityFromShapeResult(aShell, 3);
-                //if (!ent.IsNull()) {
-                //    name += ws->Model()->StringLabel(ent)->ToCString();
-                //}
-
-                Part::Feature *pcFeature = static_cast<Part::Feature*>(pcDoc->addObject("Part::Feature", name.c_str()));
-                pcFeature->Shape.setValue(aShell);
-            }
+                items.push_back(ex.Current());
 
             // put all other free-flying shapes into a single compound
             Standard_Boolean emptyComp = Standard_True;
@@ -231,11 +224,45 @@ int Part::ImportStepParts(App::Document *pcDoc, const char* Name)
                 }
             }
 
-            if (!emptyComp) {
-                std::string name = fi.fileNamePure();
-                Part::Feature *pcFeature = static_cast<Part::Feature*>(pcDoc->addObject
-                    ("Part::Feature", name.c_str()));
-                pcFeature->Shape.setValue(comp);
+            if (!emptyComp)
+                items.push_back(comp);
+        }
+
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Mod/Import/hSTEP");
+        if (hGrp->GetBool("HealShapes", false))
+            healShapes(items);
+
+        // create all document objects in one pass
+        Base::SequencerLauncher seq("Creating objects...", items.size());
+        for (const auto& item : items) {
+            std::string name = fi.fileNamePure();
+            Part::Feature *pcFeature = static_cast<Part::Feature*>(pcDoc->addObject
+                ("Part::Feature", name.c_str()));
+            pcFeature->Shape.setValue(item);
+            seq.next();
+
+            if (item.ShapeType() != TopAbs_SOLID)
+                continue;
+
+            // This is a trick to access the GUI via Python and set the color property
+            // of the associated view provider. If no GUI is up an exception is thrown
+            // and cleared immediately
+            std::map<int, Quantity_Color>::iterator it = hash_col.find(item.HashCode(INT_MAX));
+            if (it != hash_col.end()) {
+                try {
+                    Py::Object obj(pcFeature->getPyObject(), true);
+                    Py::Object vp(obj.getAttr("ViewObject"));
+                    Py::Tuple col(3);
+                    col.setItem(0, Py::Float(it->second.Red()));
+                    col.setItem(1, Py::Float(it->second.Green()));
+                    col.setItem(2, Py::Float(it->second.Blue()));
+                    vp.setAttr("ShapeColor", col);
+                    //Base::Console().Message("Set color to shape\n");
+                }
+                catch (Py::Exception& e) {
+                    e.clear();
+                }
             }
         }
     }
@@ -24,7 +24,9 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <functional>
 # include <sstream>
+# include <BRepTools_ShapeSet.hxx>
 # include <gp_Trsf.hxx>
 # include <gp_Ax1.hxx>
 # include <BRepBuilderAPI_MakeShape.hxx>
@@ -60,8 +62,10 @@
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
 #include <Base/Stream.h>
+#include <Base/Tools.h>
 #include <Base/Placement.h>
 #include <Base/Rotation.h>
+#include <Base/ThreadPool.h>
 #include <App/Application.h>
 #include <App/FeaturePythonPyImp.h>
 #include <App/Document.h>
@@ -71,6 +75,7 @@
 #include "PartPyCXX.h"
 #include "PartFeature.h"
 #include "PartFeaturePy.h"
+#include "ResultCache.h"
 #include "TopoShapePy.h"
 
 using namespace Part;
@@ -95,10 +100,57 @@ short Feature::mustExecute(void) const
     return GeoFeature::mustExecute();
 }
 
+bool Feature::getOutputFingerprint(std::size_t &fingerprint) const
+{
+    // Like the keys of the ResultCache the triangulation is left out, the
+    // views attach it to the shapes without changing their geometry
+    std::ostringstream str;
+    TopoDS_Shape shape = Shape.getValue();
+    if (!shape.IsNull()) {
+        BRepTools_ShapeSet set(Standard_False);
+        set.Add(shape);
+        set.Write(str);
+        set.Write(shape, str);
+    }
+
+    Base::StringWriter writer;
+    Placement.Save(writer);
+    std::vector<App::Property*> props;
+    getPropertyList(props);
+    for (auto prop : props) {
+        if (prop == &Shape || prop == &Placement || prop->testStatus(App::Property::Transient))
+            continue;
+        if (prop->testStatus(App::Property::Output) || (getPropertyType(prop) & App::Prop_Output)) {
+            writer.Stream() << prop->getName();
+            prop->Save(writer);
+        }
+    }
+    str << writer.getString();
+
+    fingerprint = std::hash<std::string>()(str.str());
+    return true;
+}
+
 App::DocumentObjectExecReturn *Feature::recompute(void)
 {
     try {
-        return App::GeoFeature::recompute();
+        ResultCache& cache = ResultCache::instance();
+        if (!canCacheResult() || !cache.isEnabled())
+            return App::GeoFeature::recompute();
+
+        std::string key = cache.makeKey(this);
+        TopoDS_Shape result;
+        if (cache.find(key, result)) {
+            // assign the shape the same way as execute() does
+            Base::ObjectStatusLocker<App::ObjectStatus, App::DocumentObject> exe(App::Recompute, this);
+            this->Shape.setValue(result);
+            return App::DocumentObject::StdReturn;
+        }
+
+        App::DocumentObjectExecReturn* ret = App::GeoFeature::recompute();
+        if (ret == App::DocumentObject::StdReturn)
+            cache.insert(key, this->Shape.getValue());
+        return ret;
     }
     catch (Standard_Failure& e) {
 
@@ -278,6 +330,7 @@ static ShapeCache _ShapeCache;
 
 void Feature::clearShapeCache() {
     _ShapeCache.cache.clear();
+    ResultCache::instance().clear();
 }
 
 static TopoShape _getTopoShape(const App::DocumentObject *obj, const char *subname, 
@@ -401,8 +454,17 @@ static TopoShape _getTopoShape(const App::DocumentObject *obj, const char *subna
         if(link || owner->getExtensionByType<App::GeoFeatureGroupExtension>(true))
             linkStack.push_back(owner);
 
-        // Construct a compound of sub objects
-        std::vector<TopoShape> shapes;
+        // Construct a compound of sub objects. The elements of a link array
+        // are transformed from the shared base shape after resolving all of
+        // them, so that scaled elements, which need a copy of the geometry,
+        // are made in parallel.
+        struct ChildShape {
+            TopoShape shape;
+            Base::Matrix4D mat;
+            std::string op;
+            bool fromBase = false;
+        };
+        std::vector<ChildShape> children;
 
         // Acceleration for link array. Unlike non-array link, a link array does
         // not return the linked object when calling getLinkedObject().
@@ -440,30 +502,43 @@ static TopoShape _getTopoShape(const App::DocumentObject *obj, const char *subna
             }
             if(visible==0)
                 continue;
-            TopoShape shape;
+            ChildShape child;
             if(!subObj || baseShape.isNull()) {
-                shape = _getTopoShape(owner,sub.c_str(),true,0,&subObj,false,false,linkStack);
-                if(shape.isNull())
+                child.shape = _getTopoShape(owner,sub.c_str(),true,0,&subObj,false,false,linkStack);
+                if(child.shape.isNull())
                     continue;
                 if(visible<0 && subObj && !subObj->Visibility.getValue())
                     continue;
             }else{
+                child.fromBase = true;
+                child.mat = mat;
                 if(link && !link->getShowElementValue())
-                    shape = baseShape.makETransform(mat,(TopoShape::indexPostfix()+childName).c_str());
-                else {
-                    shape = baseShape.makETransform(mat);
+                    child.op = TopoShape::indexPostfix()+childName;
+                // else
                 //     shape.reTagElementMap(subObj->getID(),subObj->getDocument()->getStringHasher());
-                }
             }
-            shapes.push_back(shape);
+            children.push_back(std::move(child));
         }
 
         if(linkStack.size() && linkStack.back()==owner)
             linkStack.pop_back();
 
-        if(shapes.empty()) 
+        if(children.empty()) 
             return shape;
 
+        // Moving the base shape only changes its location, copies are only
+        // made for scaled elements
+        Base::parallel_for(std::size_t(0), children.size(), [&](std::size_t i) {
+            auto &child = children[i];
+            if(child.fromBase)
+                child.shape = baseShape.makETransform(child.mat,child.op.size()?child.op.c_str():0);
+        }, std::size_t(16));
+
+        std::vector<TopoShape> shapes;
+        shapes.reserve(children.size());
+        for(auto &child : children)
+            shapes.push_back(std::move(child.shape));
+
         // shape.Tag = tag;
         // shape.Hasher = hasher;
         shape.makECompound(shapes);
@@ -58,6 +58,8 @@ public:
     /** @name methods override feature */
     //@{
     virtual short mustExecute() const override;
+    /// Hash of the shape geometry, the placement and the output properties
+    virtual bool getOutputFingerprint(std::size_t &fingerprint) const override;
     //@}
 
     /// returns the type name of the ViewProvider
@@ -102,6 +104,13 @@ public:
 
     static void clearShapeCache();
 
+    /** Returns true if the shape only depends on the property values and the linked
+     * shapes. Then the result of the recompute is kept in the ResultCache.
+     */
+    virtual bool canCacheResult() const {
+        return false;
+    }
+
     static App::DocumentObject *getShapeOwner(const App::DocumentObject *obj, const char *subname=0);
 
     static bool hasShapeOwner(const App::DocumentObject *obj, const char *subname=0) {
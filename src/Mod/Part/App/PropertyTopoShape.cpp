@@ -58,6 +58,9 @@
 #include <App/Application.h>
 #include <App/DocumentObject.h>
 #include <App/ObjectIdentifier.h>
+#include <zipios++/zipios-config.h>
+#include <zipios++/zipfile.h>
+#include <mutex>
 
 #include "PropertyTopoShape.h"
 #include "TopoShapePy.h"
@@ -85,6 +88,7 @@ PropertyPartShape::~PropertyPartShape()
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
     aboutToSetValue();
+    resetLazy();
     _Shape = sh;
     hasSetValue();
 }
@@ -92,27 +96,32 @@ void PropertyPartShape::setValue(const TopoShape& sh)
 void PropertyPartShape::setValue(const TopoDS_Shape& sh)
 {
     aboutToSetValue();
+    resetLazy();
     _Shape.setShape(sh);
     hasSetValue();
 }
 
 const TopoDS_Shape& PropertyPartShape::getValue(void)const
 {
+    loadLazy();
     return _Shape.getShape();
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    loadLazy();
     return this->_Shape;
 }
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    loadLazy();
     return &(this->_Shape);
 }
 
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
+    loadLazy();
     Base::BoundBox3d box;
     if (_Shape.getShape().IsNull())
         return box;
@@ -139,13 +148,16 @@ Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 {
+    loadLazy();
     aboutToSetValue();
+    resetLazy();
     _Shape.transformGeometry(rclTrf);
     hasSetValue();
 }
 
 PyObject *PropertyPartShape::getPyObject(void)
 {
+    loadLazy();
     Base::PyObjectBase* prop = static_cast<Base::PyObjectBase*>(_Shape.getPyObject());
     if (prop)
         prop->setConst();
@@ -167,6 +179,7 @@ void PropertyPartShape::setPyObject(PyObject *value)
 
 App::Property *PropertyPartShape::Copy(void) const
 {
+    loadLazy();
     PropertyPartShape *prop = new PropertyPartShape();
     prop->_Shape = this->_Shape;
     if (!_Shape.getShape().IsNull()) {
@@ -177,15 +190,33 @@ App::Property *PropertyPartShape::Copy(void) const
     return prop;
 }
 
+App::Property *PropertyPartShape::CopyForUndo(void) const
+{
+    // Shapes are not modified in place, so Undo/Redo can share the
+    // TopoDS_TShape with this property, instead of a deep copy
+    loadLazy();
+    PropertyPartShape *prop = new PropertyPartShape();
+    prop->_Shape = this->_Shape;
+    prop->_SharedShape = true;
+    return prop;
+}
+
 void PropertyPartShape::Paste(const App::Property &from)
 {
     aboutToSetValue();
-    _Shape = dynamic_cast<const PropertyPartShape&>(from)._Shape;
+    resetLazy();
+    _Shape = dynamic_cast<const PropertyPartShape&>(from).getShape();
     hasSetValue();
 }
 
 unsigned int PropertyPartShape::getMemSize (void) const
 {
+    if (_LazyPending)
+        return sizeof(TopoShape);
+    // A shared copy only accounts for the shape once nobody else holds it
+    const TopoDS_Shape &shape = _Shape.getShape();
+    if (_SharedShape && !shape.IsNull() && shape.TShape()->GetRefCount() > 1)
+        return sizeof(TopoShape);
     return _Shape.getMemSize();
 }
 
@@ -207,7 +238,12 @@ void PropertyPartShape::Save (Base::Writer &writer) const
 {
     if(!writer.isForceXML()) {
         //See SaveDocFile(), RestoreDocFile()
-        if (writer.getMode("BinaryBrep")) {
+        if (writer.getMode("CompactBrep")) {
+            writer.Stream() << writer.ind() << "<Part file=\""
+                            << writer.addFile("PartShape.cbrp", this)
+                            << "\"/>" << std::endl;
+        }
+        else if (writer.getMode("BinaryBrep")) {
             writer.Stream() << writer.ind() << "<Part file=\""
                             << writer.addFile("PartShape.bin", this)
                             << "\"/>" << std::endl;
@@ -232,17 +268,17 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
 }
 
 // The following two functions are copied from OCCT BRepTools.cxx and modified
-// to disable saving of triangulation
+// to make saving of triangulation optional
 //
-static void BRepTools_Write(const TopoDS_Shape& Sh, Standard_OStream& S) {
-  BRepTools_ShapeSet SS(Standard_False);
+static void BRepTools_Write(const TopoDS_Shape& Sh, Standard_OStream& S, Standard_Boolean withTriangles) {
+  BRepTools_ShapeSet SS(withTriangles);
   // SS.SetProgress(PR);
   SS.Add(Sh);
   SS.Write(S);
   SS.Write(Sh,S);
 }
 
-static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_CString File)
+static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_CString File, Standard_Boolean withTriangles)
 {
   std::ofstream os;
 #if OCC_VERSION_HEX >= 0x060800
@@ -256,7 +292,7 @@ static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_
   if(!isGood)
     return isGood;
 
-  BRepTools_ShapeSet SS(Standard_False);
+  BRepTools_ShapeSet SS(withTriangles);
   // SS.SetProgress(PR);
   SS.Add(Sh);
 
@@ -279,24 +315,34 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 {
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
+    loadLazy();
     if (_Shape.getShape().IsNull())
         return;
     TopoDS_Shape myShape = _Shape.getShape();
-    if (writer.getMode("BinaryBrep")) {
+    if (writer.getMode("CompactBrep")) {
+        TopoShape shape;
+        shape.setShape(myShape);
+        shape.exportCompact(writer.Stream());
+    }
+    else if (writer.getMode("BinaryBrep")) {
         TopoShape shape;
         shape.setShape(myShape);
         shape.exportBinary(writer.Stream());
     }
     else {
-        bool direct = App::GetApplication().GetParameterGroupByPath
-            ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Mod/Part/General");
+        bool direct = hGrp->GetBool("DirectAccess", true);
+        // Keep the triangulation of the view provider with the shape. When reading the
+        // file again BRepMesh_IncrementalMesh re-uses it as long as the deflection fits.
+        bool tess = hGrp->GetBool("SaveTessellation", false);
         if (!direct) {
             // create a temporary file and copy the content to the zip stream
             // once the tmp. filename is known use always the same because otherwise
             // we may run into some problems on the Linux platform
             static Base::FileInfo fi(App::Application::getTempFileName());
 
-            if (!BRepTools_Write(myShape,(Standard_CString)fi.filePath().c_str())) {
+            if (!BRepTools_Write(myShape,(Standard_CString)fi.filePath().c_str(),tess)) {
                 // Note: Do NOT throw an exception here because if the tmp. file could
                 // not be created we should not abort.
                 // We only print an error message but continue writing the next files to the
@@ -339,22 +385,141 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
             fi.deleteFile();
         }
         else {
-            BRepTools_Write(myShape, writer.Stream());
+            BRepTools_Write(myShape, writer.Stream(), tess);
         }
     }
 }
 
 void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
+{
+    bool direct = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
+    setValue(loadDocFile(reader, direct));
+}
+
+bool PropertyPartShape::canRestoreDocFileAsync() const
+{
+    // the temporary file work-around is not meant to run concurrently
+    return App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
+}
+
+std::function<void()> PropertyPartShape::RestoreDocFileAsync(Base::Reader &reader)
+{
+    // only called if direct access is enabled, see canRestoreDocFileAsync()
+    TopoDS_Shape shape = loadDocFile(reader, true);
+    return [this, shape]() {
+        setValue(shape);
+    };
+}
+
+bool PropertyPartShape::RestoreDocFileLazy(const std::string &archive,
+        const std::string &entry, int fileVersion)
+{
+    Base::FileInfo fi(archive);
+    if (!fi.exists())
+        return false;
+    _Lazy.reset(new LazySource);
+    _Lazy->archive = archive;
+    _Lazy->entry = entry;
+    _Lazy->fileVersion = fileVersion;
+    _Lazy->modified = fi.lastModified();
+    _Shape.setShape(TopoDS_Shape());
+    _LazyPending = true;
+    return true;
+}
+
+void PropertyPartShape::loadLazy() const
+{
+    if (!_LazyPending)
+        return;
+
+    // the shape may be accessed by the workers of a parallel recompute
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!_LazyPending)
+        return;
+
+    TopoDS_Shape shape;
+    bool ok = false;
+    if (Base::FileInfo(_Lazy->archive).lastModified() == _Lazy->modified) {
+        try {
+            zipios::ZipFile zip(_Lazy->archive);
+            std::unique_ptr<std::istream> str(zip.getInputStream(_Lazy->entry));
+            if (str) {
+                bool direct = App::GetApplication().GetParameterGroupByPath
+                    ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
+                Base::Reader reader(*str, _Lazy->entry, _Lazy->fileVersion);
+                shape = loadDocFile(reader, direct);
+                ok = true;
+            }
+        }
+        catch (const std::exception &e) {
+            Base::Console().Error("%s\n", e.what());
+        }
+        catch (Standard_Failure &e) {
+            Base::Console().Error("%s\n", e.GetMessageString());
+        }
+    }
+
+    if (ok) {
+        _Lazy->loaded = shape;
+    }
+    else {
+        App::PropertyContainer* father = this->getContainer();
+        if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
+            App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
+            Base::Console().Error("Failed to read the shape of '%s' from '%s'\n",
+                obj->Label.getValue(), _Lazy->archive.c_str());
+        }
+        else {
+            Base::Console().Error("Failed to read '%s' from '%s'\n",
+                _Lazy->entry.c_str(), _Lazy->archive.c_str());
+        }
+        _Lazy.reset();
+    }
+    const_cast<PropertyPartShape*>(this)->_Shape.setShape(shape);
+    _LazyPending = false;
+}
+
+void PropertyPartShape::resetLazy()
+{
+    _Lazy.reset();
+    _LazyPending = false;
+}
+
+bool PropertyPartShape::evict()
+{
+    if (!_Lazy || _LazyPending)
+        return false;
+    // the shape must be unchanged, including its placement, and the document
+    // file must be the one it was restored from
+    if (!_Shape.getShape().IsEqual(_Lazy->loaded)
+            || Base::FileInfo(_Lazy->archive).lastModified() != _Lazy->modified)
+        return false;
+    _Lazy->loaded.Nullify();
+    _Shape.setShape(TopoDS_Shape());
+    _LazyPending = true;
+    return true;
+}
+
+TopoDS_Shape PropertyPartShape::loadDocFile(Base::Reader &reader, bool direct) const
 {
     Base::FileInfo brep(reader.getFileName());
-    if (brep.hasExtension("bin")) {
+    if (brep.hasExtension("cbrp")) {
+        // an empty file means the stored shape was empty, see SaveDocFile()
+        if (reader.peek() == std::char_traits<char>::eof())
+            return TopoDS_Shape();
+        TopoShape shape;
+        shape.importCompact(reader);
+        return shape.getShape();
+    }
+    else if (brep.hasExtension("bin")) {
         TopoShape shape;
         shape.importBinary(reader);
-        setValue(shape);
+        return shape.getShape();
     }
     else {
-        bool direct = App::GetApplication().GetParameterGroupByPath
-            ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
         if (!direct) {
             BRep_Builder builder;
             // create a temporary file and copy the content from the zip stream
@@ -394,13 +559,13 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
 
             // delete the temp file
             fi.deleteFile();
-            setValue(shape);
+            return shape;
         }
         else {
             BRep_Builder builder;
             TopoDS_Shape shape;
             BRepTools::Read(shape, reader, builder);
-            setValue(shape);
+            return shape;
         }
     }
 }
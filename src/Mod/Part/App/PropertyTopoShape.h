@@ -28,7 +28,10 @@
 #include <TopAbs_ShapeEnum.hxx>
 #include <App/DocumentObject.h>
 #include <App/PropertyGeo.h>
+#include <Base/TimeInfo.h>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace Part
@@ -82,8 +85,13 @@ public:
 
     void SaveDocFile (Base::Writer &writer) const;
     void RestoreDocFile(Base::Reader &reader);
+    bool canRestoreDocFileAsync() const;
+    std::function<void()> RestoreDocFileAsync(Base::Reader &reader);
+    bool RestoreDocFileLazy(const std::string &archive,
+            const std::string &entry, int fileVersion);
 
     App::Property *Copy(void) const;
+    App::Property *CopyForUndo(void) const;
     void Paste(const App::Property &from);
     unsigned int getMemSize (void) const;
     //@}
@@ -91,8 +99,43 @@ public:
     /// Get valid paths for this property; used by auto completer
     virtual void getPaths(std::vector<App::ObjectIdentifier> & paths) const;
 
+    /** @name Lazy restore
+     *
+     * With the document parameter LazyRestore the shape is not decoded on
+     * restore, but read from the document file on first access.
+     */
+    //@{
+    /// Returns true if the shape is not yet read from the document file
+    bool isLazyPending() const { return _LazyPending; }
+    /** Drops the shape, to be read again from the document file on next access
+     *
+     * This is only possible for lazily restored shapes that have not been
+     * changed since, and if the document file is not modified in the mean
+     * time. Returns true if the shape is dropped.
+     */
+    bool evict();
+    //@}
+
+private:
+    TopoDS_Shape loadDocFile(Base::Reader &reader, bool direct) const;
+    void loadLazy() const;
+    void resetLazy();
+
 private:
     TopoShape _Shape;
+    /// Set on copies made by CopyForUndo() that share the shape
+    bool _SharedShape = false;
+
+    /// Source of a lazily restored shape, kept while the shape is unchanged
+    struct LazySource {
+        std::string archive;
+        std::string entry;
+        int fileVersion;
+        Base::TimeInfo modified;
+        TopoDS_Shape loaded;
+    };
+    mutable std::unique_ptr<LazySource> _Lazy;
+    mutable std::atomic<bool> _LazyPending{false};
 };
 
 struct PartExport ShapeHistory {
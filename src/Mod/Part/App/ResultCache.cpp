@@ -0,0 +1,215 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <sstream>
+# include <BRepTools_ShapeSet.hxx>
+# include <Standard_Failure.hxx>
+#endif
+
+#include <QCryptographicHash>
+
+#include "ResultCache.h"
+#include "PartFeature.h"
+#include <App/Application.h>
+#include <App/PropertyLinks.h>
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Parameter.h>
+#include <Base/Writer.h>
+
+FC_LOG_LEVEL_INIT("Part",true,true)
+
+using namespace Part;
+
+namespace {
+void addShapeToHash(QCryptographicHash& hash, const TopoDS_Shape& shape)
+{
+    // The triangulation is not part of the key because the views attach it to the
+    // input shapes without changing their geometry
+    std::ostringstream str;
+    BRepTools_ShapeSet set(Standard_False);
+    set.Add(shape);
+    set.Write(str);
+    set.Write(shape, str);
+    std::string data = str.str();
+    hash.addData(data.c_str(), static_cast<int>(data.size()));
+}
+}
+
+ResultCache& ResultCache::instance()
+{
+    static ResultCache cache;
+    return cache;
+}
+
+ResultCache::ResultCache()
+  : capacity(50)
+{
+}
+
+bool ResultCache::isEnabled()
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part/General");
+    if (!hGrp->GetBool("EnableResultCache", false)) {
+        clear();
+        return false;
+    }
+
+    capacity = static_cast<std::size_t>(std::max<long>(hGrp->GetInt("ResultCacheSize", 50), 1));
+    spillDirectory = hGrp->GetASCII("ResultCacheDir", "");
+    shrink();
+    return true;
+}
+
+std::string ResultCache::makeKey(const Feature* feature) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(feature->getTypeId().getName());
+
+    std::vector<App::Property*> props;
+    feature->getPropertyList(props);
+    for (auto prop : props) {
+        if (prop == &feature->Shape || prop == &feature->Label || prop == &feature->Label2
+                || prop == &feature->ExpressionEngine || prop == &feature->Visibility)
+            continue;
+        if (prop->testStatus(App::Property::Output) || prop->testStatus(App::Property::Transient))
+            continue;
+        if (feature->getPropertyType(prop) & (App::Prop_Output | App::Prop_Transient))
+            continue;
+
+        hash.addData(prop->getName());
+        if (prop->isDerivedFrom(App::PropertyLinkBase::getClassTypeId())) {
+            // use the content of the linked shapes so that the key doesn't depend on
+            // the object names
+            std::vector<App::DocumentObject*> objs;
+            std::vector<std::string> subs;
+            static_cast<App::PropertyLinkBase*>(prop)->getLinks(objs, true, &subs, false);
+            for (auto obj : objs)
+                addShapeToHash(hash, Feature::getShape(obj));
+            for (const auto& sub : subs)
+                hash.addData(sub.c_str(), static_cast<int>(sub.size()));
+        }
+        else {
+            Base::StringWriter writer;
+            prop->Save(writer);
+            std::string data = writer.getString();
+            hash.addData(data.c_str(), static_cast<int>(data.size()));
+        }
+    }
+
+    return std::string(hash.result().toHex().constData());
+}
+
+bool ResultCache::find(const std::string& key, TopoDS_Shape& shape)
+{
+    auto it = entryMap.find(key);
+    if (it != entryMap.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+        shape = it->second->second;
+        return true;
+    }
+
+    if (spillDirectory.empty())
+        return false;
+
+    Base::FileInfo fi(spillFileName(key));
+    if (!fi.isReadable())
+        return false;
+
+    try {
+        TopoShape spilled;
+        spilled.importBrep(fi.filePath().c_str());
+        if (spilled.isNull())
+            return false;
+        shape = spilled.getShape();
+        insert(key, shape);
+        return true;
+    }
+    catch (const Base::Exception& e) {
+        FC_WARN("Failed to read cached result " << fi.filePath() << ": " << e.what());
+        return false;
+    }
+}
+
+void ResultCache::insert(const std::string& key, const TopoDS_Shape& shape)
+{
+    if (shape.IsNull())
+        return;
+
+    auto it = entryMap.find(key);
+    if (it != entryMap.end()) {
+        it->second->second = shape;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    entries.emplace_front(key, shape);
+    entryMap[key] = entries.begin();
+    shrink();
+}
+
+void ResultCache::clear()
+{
+    entries.clear();
+    entryMap.clear();
+}
+
+void ResultCache::shrink()
+{
+    while (entries.size() > capacity) {
+        const auto& entry = entries.back();
+        if (!spillDirectory.empty()) {
+            Base::FileInfo fi(spillFileName(entry.first));
+            if (!fi.exists()) {
+                try {
+                    TopoShape(entry.second).exportBrep(fi.filePath().c_str());
+                }
+                catch (const Base::Exception& e) {
+                    FC_WARN("Failed to spill cached result " << fi.filePath() << ": " << e.what());
+                }
+                catch (const Standard_Failure& e) {
+                    FC_WARN("Failed to spill cached result " << fi.filePath() << ": " << e.GetMessageString());
+                }
+            }
+        }
+
+        entryMap.erase(entry.first);
+        entries.pop_back();
+    }
+}
+
+std::string ResultCache::spillFileName(const std::string& key) const
+{
+    std::string name = spillDirectory;
+    if (name.back() != '/' && name.back() != '\\')
+        name += '/';
+    name += key;
+    name += ".brep";
+    return name;
+}
@@ -0,0 +1,84 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef PART_RESULTCACHE_H
+#define PART_RESULTCACHE_H
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <TopoDS_Shape.hxx>
+
+namespace Part {
+
+class Feature;
+
+/**
+ * The ResultCache class memorizes the shapes computed by features. The key of a
+ * result is built from the feature type, the content of its input shapes and the
+ * values of its properties. So, a feature that is recomputed with the same input
+ * as before, e.g. after undo/redo, reloading a document or by a parameter sweep,
+ * gets its shape without running the OCC algorithm again.
+ *
+ * The cache keeps the most recently used results in memory. If a spill directory
+ * is set the least recently used results are written there as BRep files instead
+ * of being discarded.
+ *
+ * The cache is disabled by default and is controlled by the parameters
+ * EnableResultCache, ResultCacheSize and ResultCacheDir of the group
+ * BaseApp/Preferences/Mod/Part/General.
+ */
+class PartExport ResultCache
+{
+public:
+    static ResultCache& instance();
+
+    /// Reads the settings from the user parameters and returns whether the cache is used
+    bool isEnabled();
+    /// Returns the key of the current input of \a feature
+    std::string makeKey(const Feature* feature) const;
+    /// Looks for the result of \a key in memory and then in the spill directory
+    bool find(const std::string& key, TopoDS_Shape& shape);
+    void insert(const std::string& key, const TopoDS_Shape& shape);
+    /// Removes all results from memory, the spilled results are kept
+    void clear();
+
+private:
+    ResultCache();
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    void shrink();
+    std::string spillFileName(const std::string& key) const;
+
+private:
+    typedef std::list<std::pair<std::string, TopoDS_Shape>> EntryList;
+    EntryList entries; // most recently used first
+    std::unordered_map<std::string, EntryList::iterator> entryMap;
+    std::size_t capacity;
+    std::string spillDirectory;
+};
+
+}
+
+#endif // PART_RESULTCACHE_H
@@ -0,0 +1,205 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <numeric>
+# include <BRepBndLib.hxx>
+# include <BRepExtrema_DistShapeShape.hxx>
+# include <Bnd_Box.hxx>
+# include <Precision.hxx>
+# include <Standard_Failure.hxx>
+#endif
+
+#include <QtConcurrentMap>
+
+#include "ShapeDistance.h"
+#include "TopoShape.h"
+#include <Base/Exception.h>
+#include <Base/Sequencer.h>
+
+using namespace Part;
+
+ShapeDistance::ShapeDistance()
+  : maxDistance(-1.0)
+  , numRefined(0)
+{
+}
+
+ShapeDistance::~ShapeDistance()
+{
+}
+
+void ShapeDistance::setShapes(const std::vector<TopoDS_Shape>& list)
+{
+    shapes = list;
+}
+
+void ShapeDistance::setPairs(const std::vector<std::pair<std::size_t, std::size_t>>& list)
+{
+    pairs = list;
+}
+
+void ShapeDistance::setMaxDistance(Standard_Real value)
+{
+    maxDistance = value;
+}
+
+const std::vector<ShapeDistance::Result>& ShapeDistance::results() const
+{
+    return distances;
+}
+
+std::size_t ShapeDistance::countRefined() const
+{
+    return numRefined;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> ShapeDistance::candidates() const
+{
+    std::size_t count = shapes.size();
+    std::vector<std::pair<std::size_t, std::size_t>> result;
+    if (maxDistance < 0.0) {
+        if (!pairs.empty())
+            return pairs;
+        for (std::size_t i = 0; i < count; i++) {
+            for (std::size_t j = i + 1; j < count; j++)
+                result.emplace_back(i, j);
+        }
+        return result;
+    }
+
+    // the distance of the boxes is a lower bound of the distance of the shapes
+    std::vector<Bnd_Box> bounds(count);
+    for (std::size_t i = 0; i < count; i++) {
+        // use the exact geometry because a box of the triangulation can be too small
+        BRepBndLib::Add(shapes[i], bounds[i], Standard_False);
+    }
+    Standard_Real tolerance = maxDistance + Precision::Confusion();
+    auto isClose = [&bounds, tolerance](std::size_t i, std::size_t j) {
+        if (bounds[i].IsVoid() || bounds[j].IsVoid())
+            return true;
+        return bounds[i].Distance(bounds[j]) <= tolerance;
+    };
+
+    if (!pairs.empty()) {
+        for (const auto& it : pairs) {
+            if (isClose(it.first, it.second))
+                result.push_back(it);
+        }
+        return result;
+    }
+
+    // sweep along the x-axis and only compare the boxes that are close in x
+    std::vector<std::size_t> order(count);
+    std::vector<double> xmin(count), xmax(count);
+    for (std::size_t i = 0; i < count; i++) {
+        Standard_Real x1, y1, z1, x2, y2, z2;
+        if (bounds[i].IsVoid()) {
+            x1 = x2 = 0.0;
+        }
+        else {
+            bounds[i].Get(x1, y1, z1, x2, y2, z2);
+        }
+        xmin[i] = x1;
+        xmax[i] = x2;
+    }
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&xmin](std::size_t a, std::size_t b) {
+        return xmin[a] < xmin[b];
+    });
+
+    std::vector<std::size_t> active;
+    for (std::size_t i : order) {
+        active.erase(std::remove_if(active.begin(), active.end(), [&](std::size_t j) {
+            return xmax[j] + tolerance < xmin[i];
+        }), active.end());
+        for (std::size_t j : active) {
+            if (isClose(i, j))
+                result.emplace_back(std::min(i, j), std::max(i, j));
+        }
+        active.push_back(i);
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void ShapeDistance::perform()
+{
+    distances.clear();
+    numRefined = 0;
+
+    for (const auto& it : shapes) {
+        if (it.IsNull())
+            throw NullShapeException("Input shape is null");
+    }
+    for (const auto& it : pairs) {
+        if (it.first >= shapes.size() || it.second >= shapes.size())
+            throw Base::IndexError("Shape index out of range");
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> checks = candidates();
+    numRefined = checks.size();
+
+    std::vector<Result> refined(checks.size());
+    std::vector<std::string> errors(checks.size());
+    std::vector<int> indices(checks.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    Base::ProgressCounter progress("Computing distances...", checks.size());
+    QtConcurrent::blockingMap(indices, [&](int index) {
+        if (progress.isCanceled())
+            return;
+        const auto& check = checks[index];
+        Result& res = refined[index];
+        res.first = check.first;
+        res.second = check.second;
+        try {
+            BRepExtrema_DistShapeShape extrema(shapes[check.first], shapes[check.second]);
+            if (!extrema.IsDone() || extrema.NbSolution() < 1) {
+                errors[index] = "Failed to compute the distance of two shapes";
+                return;
+            }
+            res.distance = extrema.Value();
+            res.point1 = extrema.PointOnShape1(1);
+            res.point2 = extrema.PointOnShape2(1);
+        }
+        catch (const Standard_Failure& e) {
+            errors[index] = e.GetMessageString();
+        }
+        progress.add();
+    });
+
+    progress.checkCanceled();
+
+    for (const auto& it : errors) {
+        if (!it.empty())
+            throw Base::RuntimeError(it);
+    }
+
+    for (const auto& it : refined) {
+        if (maxDistance < 0.0 || it.distance <= maxDistance)
+            distances.push_back(it);
+    }
+}
@@ -0,0 +1,86 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef PART_SHAPEDISTANCE_H
+#define PART_SHAPEDISTANCE_H
+
+#include <utility>
+#include <vector>
+#include <gp_Pnt.hxx>
+#include <Standard_Real.hxx>
+#include <TopoDS_Shape.hxx>
+
+namespace Part {
+
+/**
+ * The ShapeDistance class computes the minimum distances of many pairs of shapes
+ * at once. If a maximum distance is set, pairs whose bounding boxes are further apart
+ * are rejected without computing the exact distance, so that checking the clearances
+ * of a large assembly only has to refine the pairs that are close to each other.
+ * The exact distances are computed with BRepExtrema_DistShapeShape, concurrently.
+ */
+class PartExport ShapeDistance
+{
+public:
+    struct Result {
+        std::size_t first;
+        std::size_t second;
+        Standard_Real distance;
+        gp_Pnt point1;          // the nearest point on the first shape
+        gp_Pnt point2;          // the nearest point on the second shape
+    };
+
+    ShapeDistance();
+    ~ShapeDistance();
+
+    void setShapes(const std::vector<TopoDS_Shape>& shapes);
+    /** The pairs of shape indexes to check. If no pairs are set all pairs
+     * of different shapes are checked.
+     */
+    void setPairs(const std::vector<std::pair<std::size_t, std::size_t>>& pairs);
+    /** Only pairs with a distance up to \a value are reported. A negative value,
+     * the default, reports all pairs.
+     */
+    void setMaxDistance(Standard_Real value);
+    /// Computes the distances, throws Base::RuntimeError if a distance cannot be computed
+    void perform();
+
+    /// The results in the order of the checked pairs
+    const std::vector<Result>& results() const;
+    /// The number of pairs whose exact distance had to be computed
+    std::size_t countRefined() const;
+
+private:
+    std::vector<std::pair<std::size_t, std::size_t>> candidates() const;
+
+private:
+    std::vector<TopoDS_Shape> shapes;
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    Standard_Real maxDistance;
+    std::vector<Result> distances;
+    std::size_t numRefined;
+};
+
+}
+
+#endif // PART_SHAPEDISTANCE_H
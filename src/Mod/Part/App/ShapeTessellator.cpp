@@ -0,0 +1,368 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+# include <map>
+# include <set>
+# include <BRep_Tool.hxx>
+# include <BRepMesh_IncrementalMesh.hxx>
+# include <Poly_PolygonOnTriangulation.hxx>
+# include <TColStd_Array1OfInteger.hxx>
+# include <TColStd_HArray1OfReal.hxx>
+# include <TopExp.hxx>
+# include <TopExp_Explorer.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
+# include <TopoDS.hxx>
+# include <TopoDS_Edge.hxx>
+# include <TopoDS_Face.hxx>
+# include <TopoDS_Vertex.hxx>
+# include <gp.hxx>
+#endif
+
+#include "ShapeTessellator.h"
+
+using namespace Part;
+
+namespace {
+
+// Where a node of a face triangulation lies on the shape
+struct NodeKey {
+    enum Type { Interior, Free, OnVertex, OnEdge };
+    Type type = Interior;
+    int shape = 0;      // index of the vertex or edge in the shape maps
+    int position = 0;   // index of the node inside the edge
+};
+
+struct FaceNodes {
+    std::vector<NodeKey> keys;
+    // the edges of the face with the number of their nodes
+    std::vector<std::pair<int, int>> edges;
+};
+
+// Points closer than gp::Resolution() are considered equal
+struct WeldPoint
+{
+    Standard_Real x,y,z;
+    std::size_t index;
+
+    WeldPoint(const gp_Pnt& p, std::size_t i)
+        : x(p.X()),y(p.Y()),z(p.Z()),index(i)
+    {
+    }
+
+    bool operator < (const WeldPoint &v) const
+    {
+        const double tolerance = gp::Resolution();
+        if (fabs (this->x - v.x) >= tolerance)
+            return this->x < v.x;
+        if (fabs (this->y - v.y) >= tolerance)
+            return this->y < v.y;
+        if (fabs (this->z - v.z) >= tolerance)
+            return this->z < v.z;
+        return false; // points are considered to be equal
+    }
+};
+
+void markBoundaryNodes(const Poly_Triangulation& triangulation, std::vector<NodeKey>& keys)
+{
+    std::map<std::pair<int, int>, int> edges;
+    const Poly_Array1OfTriangle& triangles = triangulation.Triangles();
+    for (int i = triangles.Lower(); i <= triangles.Upper(); i++) {
+        Standard_Integer n[3];
+        triangles(i).Get(n[0], n[1], n[2]);
+        for (int j = 0; j < 3; j++) {
+            int a = n[j], b = n[(j+1)%3];
+            edges[std::make_pair(std::min(a, b), std::max(a, b))]++;
+        }
+    }
+
+    for (const auto& it : edges) {
+        if (it.second != 1)
+            continue;
+        for (int node : {it.first.first, it.first.second}) {
+            NodeKey& key = keys[node-1];
+            if (key.type == NodeKey::Interior)
+                key.type = NodeKey::Free;
+        }
+    }
+}
+
+}
+
+ShapeTessellator::ShapeTessellator(const TopoDS_Shape& shape)
+  : shape(shape)
+  , linearDeflection(0)
+  , angularDeflection(0)
+  , relative(false)
+  , parallel(true)
+  , numFacets(0)
+{
+}
+
+ShapeTessellator::~ShapeTessellator()
+{
+}
+
+void ShapeTessellator::setDeflection(double linear, double angular, bool rel)
+{
+    linearDeflection = linear;
+    angularDeflection = angular;
+    relative = rel;
+}
+
+void ShapeTessellator::setParallel(bool on)
+{
+    parallel = on;
+}
+
+std::size_t ShapeTessellator::countPoints() const
+{
+    return points.size();
+}
+
+std::size_t ShapeTessellator::countFacets() const
+{
+    return numFacets;
+}
+
+const std::vector<std::size_t>& ShapeTessellator::countFacetsPerFace() const
+{
+    return facetsPerFace;
+}
+
+void ShapeTessellator::perform()
+{
+    faces.clear();
+    points.clear();
+    facetsPerFace.clear();
+    numFacets = 0;
+    if (shape.IsNull())
+        return;
+
+    if (linearDeflection > 0) {
+        // The edges are discretized once up front and only the faces are
+        // meshed concurrently. So, adjacent faces share their edge nodes.
+        BRepMesh_IncrementalMesh aMesh(shape, linearDeflection, relative,
+                                       angularDeflection, parallel);
+    }
+
+    std::vector<TopoDS_Face> shapeFaces;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next())
+        shapeFaces.push_back(TopoDS::Face(xp.Current()));
+
+    TopTools_IndexedMapOfShape edgeMap, vertexMap;
+    TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+    TopExp::MapShapes(shape, TopAbs_VERTEX, vertexMap);
+
+    // For a face that cannot be meshed an empty entry is kept so that the
+    // numbers of faces and entries match
+    faces.resize(shapeFaces.size());
+    facetsPerFace.resize(shapeFaces.size());
+    std::vector<FaceNodes> faceNodes(shapeFaces.size());
+
+    // find the nodes of each face that lie on its edges and vertices
+    forEach(shapeFaces.size(), [&](std::size_t index) {
+        const TopoDS_Face& face = shapeFaces[index];
+        FaceData& data = faces[index];
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, loc);
+        if (triangulation.IsNull())
+            return;
+
+        data.triangulation = triangulation;
+        data.location = loc;
+        data.reversed = (face.Orientation() == TopAbs_REVERSED);
+
+        FaceNodes& nodes = faceNodes[index];
+        nodes.keys.resize(triangulation->NbNodes());
+        bool incomplete = false;
+        for (TopExp_Explorer xp(face, TopAbs_EDGE); xp.More(); xp.Next()) {
+            const TopoDS_Edge& edge = TopoDS::Edge(xp.Current());
+            Handle(Poly_PolygonOnTriangulation) polygon =
+                BRep_Tool::PolygonOnTriangulation(edge, triangulation, loc);
+            TopoDS_Vertex v1, v2;
+            TopExp::Vertices(edge, v1, v2);
+            if (polygon.IsNull() || v1.IsNull() || v2.IsNull()) {
+                incomplete = true;
+                continue;
+            }
+
+            const TColStd_Array1OfInteger& polyNodes = polygon->Nodes();
+            int count = polyNodes.Length();
+            int edgeIndex = edgeMap.FindIndex(edge);
+            nodes.edges.emplace_back(edgeIndex, count);
+
+            // the nodes of a seam edge are stored against its parameters
+            // for one of the two sides
+            bool forward = true;
+            Handle(TColStd_HArray1OfReal) params = polygon->Parameters();
+            if (!params.IsNull() && params->Length() == count && count > 1)
+                forward = params->Value(params->Lower()) <= params->Value(params->Upper());
+
+            bool degenerated = BRep_Tool::Degenerated(edge);
+            for (int i = 0; i < count; i++) {
+                int position = forward ? i : count - 1 - i;
+                NodeKey& key = nodes.keys[polyNodes(polyNodes.Lower() + i) - 1];
+                if (degenerated || position == 0) {
+                    key.type = NodeKey::OnVertex;
+                    key.shape = vertexMap.FindIndex(v1);
+                }
+                else if (position == count - 1) {
+                    key.type = NodeKey::OnVertex;
+                    key.shape = vertexMap.FindIndex(v2);
+                }
+                else {
+                    key.type = NodeKey::OnEdge;
+                    key.shape = edgeIndex;
+                    key.position = position - 1;
+                }
+            }
+        }
+
+        // without the discretization of an edge its nodes can only be welded
+        // by their positions
+        if (incomplete)
+            markBoundaryNodes(*triangulation, nodes.keys);
+    });
+
+    // Edges of only one face and edges whose faces disagree about their
+    // discretization are welded by position, together with their vertices
+    int numEdges = edgeMap.Extent();
+    int numVertices = vertexMap.Extent();
+    std::vector<int> edgeNodes(numEdges + 1, -1);
+    std::vector<int> edgeFaces(numEdges + 1, 0);
+    std::vector<std::size_t> edgeLastFace(numEdges + 1, faceNodes.size());
+    std::vector<bool> edgeFree(numEdges + 1, false);
+    for (std::size_t i = 0; i < faceNodes.size(); i++) {
+        for (const auto& it : faceNodes[i].edges) {
+            if (edgeLastFace[it.first] != i) {
+                edgeLastFace[it.first] = i;
+                edgeFaces[it.first]++;
+            }
+            if (edgeNodes[it.first] < 0)
+                edgeNodes[it.first] = it.second;
+            else if (edgeNodes[it.first] != it.second)
+                edgeFree[it.first] = true;
+        }
+    }
+
+    std::vector<bool> vertexFree(numVertices + 1, false);
+    for (int i = 1; i <= numEdges; i++) {
+        if (edgeFaces[i] == 1)
+            edgeFree[i] = true;
+        if (edgeFree[i]) {
+            TopoDS_Vertex v1, v2;
+            TopExp::Vertices(TopoDS::Edge(edgeMap(i)), v1, v2);
+            if (!v1.IsNull())
+                vertexFree[vertexMap.FindIndex(v1)] = true;
+            if (!v2.IsNull())
+                vertexFree[vertexMap.FindIndex(v2)] = true;
+        }
+    }
+
+    // number the points in the order of the faces and their nodes
+    const std::size_t none = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> vertexPoints(numVertices + 1, none);
+    std::vector<std::vector<std::size_t>> edgePoints(numEdges + 1);
+    std::set<WeldPoint> weldPoints;
+
+    for (std::size_t i = 0; i < faces.size(); i++) {
+        FaceData& data = faces[i];
+        const std::vector<NodeKey>& keys = faceNodes[i].keys;
+        data.nodes.resize(keys.size());
+
+        auto addPoint = [&](Standard_Integer node) {
+            points.emplace_back(i, node);
+            return points.size() - 1;
+        };
+        auto weldPoint = [&](Standard_Integer node) {
+            gp_Pnt p = data.triangulation->Nodes()(node);
+            p.Transform(data.location.Transformation());
+            WeldPoint wp(p, points.size());
+            auto it = weldPoints.find(wp);
+            if (it != weldPoints.end())
+                return it->index;
+            weldPoints.insert(wp);
+            return addPoint(node);
+        };
+
+        for (std::size_t j = 0; j < keys.size(); j++) {
+            const NodeKey& key = keys[j];
+            Standard_Integer node = static_cast<Standard_Integer>(j + 1);
+            switch (key.type) {
+            case NodeKey::Interior:
+                data.nodes[j] = addPoint(node);
+                break;
+            case NodeKey::Free:
+                data.nodes[j] = weldPoint(node);
+                break;
+            case NodeKey::OnVertex:
+                if (vertexFree[key.shape]) {
+                    data.nodes[j] = weldPoint(node);
+                }
+                else {
+                    if (vertexPoints[key.shape] == none)
+                        vertexPoints[key.shape] = addPoint(node);
+                    data.nodes[j] = vertexPoints[key.shape];
+                }
+                break;
+            case NodeKey::OnEdge:
+                if (edgeFree[key.shape]) {
+                    data.nodes[j] = weldPoint(node);
+                }
+                else {
+                    std::vector<std::size_t>& ids = edgePoints[key.shape];
+                    if (ids.empty())
+                        ids.resize(edgeNodes[key.shape] - 2, none);
+                    if (ids[key.position] == none)
+                        ids[key.position] = addPoint(node);
+                    data.nodes[j] = ids[key.position];
+                }
+                break;
+            }
+        }
+    }
+
+    // count the facets that don't degenerate by welding
+    forEach(faces.size(), [&](std::size_t index) {
+        const FaceData& data = faces[index];
+        if (data.triangulation.IsNull())
+            return;
+        std::size_t count = 0;
+        std::size_t p1, p2, p3;
+        const Poly_Array1OfTriangle& triangles = data.triangulation->Triangles();
+        for (int i = triangles.Lower(); i <= triangles.Upper(); i++) {
+            if (getTriangle(data, triangles(i), p1, p2, p3))
+                count++;
+        }
+        facetsPerFace[index] = count;
+    });
+
+    for (std::size_t i = 0; i < faces.size(); i++) {
+        faces[i].firstFacet = numFacets;
+        numFacets += facetsPerFace[i];
+    }
+}
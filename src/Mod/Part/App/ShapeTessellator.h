@@ -0,0 +1,152 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef PART_SHAPETESSELLATOR_H
+#define PART_SHAPETESSELLATOR_H
+
+#include <utility>
+#include <vector>
+#include <gp_Pnt.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Shape.hxx>
+#include <Base/ThreadPool.h>
+
+namespace Part {
+
+/**
+ * The ShapeTessellator class meshes the faces of a shape and joins their triangulations
+ * into one indexed triangle mesh. The nodes are welded by topology: the edges are
+ * discretized once for all faces, so nodes on a shared edge or vertex get the same point
+ * index. Only the nodes on free edges, e.g. of faces that are not sewn, are welded by
+ * their positions.
+ * Meshing the faces, reading their triangulations and handing out the results is done
+ * concurrently. The points and facets are passed to the caller by index so that they
+ * can be written directly into the target arrays without an intermediate copy.
+ */
+class PartExport ShapeTessellator
+{
+public:
+    ShapeTessellator(const TopoDS_Shape& shape);
+    ~ShapeTessellator();
+
+    /** Sets the deflections to mesh the shape with. If \a linear is not positive the
+     * existing triangulations of the faces are used.
+     */
+    void setDeflection(double linear, double angular, bool relative = false);
+    /// Meshes and joins the faces concurrently, the default is on
+    void setParallel(bool on);
+    /// Meshes the shape and computes the point indexes of all nodes
+    void perform();
+
+    std::size_t countPoints() const;
+    std::size_t countFacets() const;
+    /// The number of facets of each face in the order of TopExp_Explorer
+    const std::vector<std::size_t>& countFacetsPerFace() const;
+
+    /** Calls \a func(index, point) for each point of the mesh. The calls are
+     * made concurrently.
+     */
+    template <typename Func>
+    void getPoints(Func func) const
+    {
+        forEach(points.size(), [&](std::size_t index) {
+            const FaceData& data = faces[points[index].first];
+            gp_Pnt p = data.triangulation->Nodes()(points[index].second);
+            p.Transform(data.location.Transformation());
+            func(index, p);
+        });
+    }
+    /** Calls \a func(index, p1, p2, p3) for each facet of the mesh with the point
+     * indexes of its corners. The facets of a face are numbered consecutively and
+     * the faces follow each other. The calls are made concurrently.
+     */
+    template <typename Func>
+    void getFacets(Func func) const
+    {
+        forEach(faces.size(), [&](std::size_t face) {
+            const FaceData& data = faces[face];
+            if (data.triangulation.IsNull())
+                return;
+            std::size_t index = data.firstFacet;
+            const Poly_Array1OfTriangle& triangles = data.triangulation->Triangles();
+            for (int i = triangles.Lower(); i <= triangles.Upper(); i++) {
+                std::size_t p1, p2, p3;
+                if (getTriangle(data, triangles(i), p1, p2, p3))
+                    func(index++, p1, p2, p3);
+            }
+        });
+    }
+
+private:
+    struct FaceData {
+        Handle(Poly_Triangulation) triangulation;
+        TopLoc_Location location;
+        bool reversed = false;
+        std::vector<std::size_t> nodes;   // the point index of each node
+        std::size_t firstFacet = 0;
+    };
+
+    static bool getTriangle(const FaceData& data, const Poly_Triangle& triangle,
+                            std::size_t& p1, std::size_t& p2, std::size_t& p3)
+    {
+        Standard_Integer n1, n2, n3;
+        triangle.Get(n1, n2, n3);
+        p1 = data.nodes[n1-1];
+        p2 = data.nodes[n2-1];
+        p3 = data.nodes[n3-1];
+        if (data.reversed)
+            std::swap(p1, p2);
+        // skip facets that degenerated by welding
+        return p1 != p2 && p2 != p3 && p3 != p1;
+    }
+
+    template <typename Func>
+    void forEach(std::size_t count, Func func) const
+    {
+        if (parallel) {
+            Base::parallel_for(std::size_t(0), count, func);
+        }
+        else {
+            for (std::size_t i = 0; i < count; i++)
+                func(i);
+        }
+    }
+
+private:
+    TopoDS_Shape shape;
+    double linearDeflection;
+    double angularDeflection;
+    bool relative;
+    bool parallel;
+    std::vector<FaceData> faces;
+    // the face and node (1-based) each point is taken from
+    std::vector<std::pair<std::size_t, Standard_Integer>> points;
+    std::vector<std::size_t> facetsPerFace;
+    std::size_t numFacets;
+};
+
+}
+
+#endif // PART_SHAPETESSELLATOR_H
@@ -27,7 +27,13 @@
 # include <algorithm>
 # include <array>
 # include <cmath>
+# include <cstdint>
+# include <cstring>
 # include <cstdlib>
+# include <list>
+# include <map>
+# include <memory>
+# include <mutex>
 # include <sstream>
 # include <QString>
 
@@ -141,6 +147,7 @@
 # include <Geom_CartesianPoint.hxx>
 # include <Geom_SphericalSurface.hxx>
 # include <Geom_ToroidalSurface.hxx>
+# include <Poly_Triangle.hxx>
 # include <Poly_Triangulation.hxx>
 # include <Standard_Failure.hxx>
 # include <StlAPI_Writer.hxx>
@@ -148,6 +155,7 @@
 # include <gp_Circ.hxx>
 # include <gp_GTrsf.hxx>
 # include <gp_Pln.hxx>
+# include <gp_Pnt2d.hxx>
 # include <ShapeAnalysis_Shell.hxx>
 # include <ShapeBuild_ReShape.hxx>
 # include <ShapeExtend_Explorer.hxx>
@@ -189,6 +197,7 @@
 #endif // _PreComp_
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <QtConcurrentMap>
 
 #include <Base/Builder3D.h>
 #include <Base/FileInfo.h>
@@ -209,6 +218,7 @@
 #include "TopoShapeCompoundPy.h"
 #include "TopoShapeCompSolidPy.h"
 #include "ProgressIndicator.h"
+#include "ShapeTessellator.h"
 #include "modelRefine.h"
 #include "Tools.h"
 #include "encodeFilename.h"
@@ -321,6 +331,7 @@ TopoShape::TopoShape(const TopoDS_Shape& shape)
 
 TopoShape::TopoShape(const TopoShape& shape)
   : _Shape(shape._Shape)
+  , _Cache(std::atomic_load(&shape._Cache))
 {
     Tag = shape.Tag;
 }
@@ -372,8 +383,7 @@ TopoDS_Shape TopoShape::getSubShape(TopAbs_ShapeEnum type, int index, bool silen
                     return it.Value();
             }
         } else {
-            TopTools_IndexedMapOfShape anIndices;
-            TopExp::MapShapes(this->_Shape, type, anIndices);
+            const auto &anIndices = getShapeMap(type);
             if(index <= anIndices.Extent())
                 return anIndices.FindKey(index);
         }
@@ -406,9 +416,7 @@ unsigned long TopoShape::countSubShapes(TopAbs_ShapeEnum Type) const
             ++count;
         return count;
     }
-    TopTools_IndexedMapOfShape anIndices;
-    TopExp::MapShapes(this->_Shape, Type, anIndices);
-    return anIndices.Extent();
+    return getShapeMap(Type).Extent();
 }
 
 bool TopoShape::hasSubShape(TopAbs_ShapeEnum type) const {
@@ -425,9 +433,63 @@ bool TopoShape::hasSubShape(const char *Type) const {
     return idx.second>0 && idx.second<=(int)countSubShapes(idx.first);
 }
 
+struct TopoShape::Cache
+{
+    explicit Cache(const TopoDS_Shape &s)
+        : shape(s)
+    {
+    }
+
+    TopoDS_Shape shape;
+    std::mutex mutex;
+    std::array<std::unique_ptr<TopTools_IndexedMapOfShape>, TopAbs_SHAPE> shapeMaps;
+    std::map<std::pair<int,int>,
+        std::unique_ptr<TopTools_IndexedDataMapOfShapeListOfShape> > ancestorMaps;
+};
+
+std::shared_ptr<TopoShape::Cache> TopoShape::getCache() const
+{
+    // The cache is also dropped if _Shape is assigned or relocated directly
+    auto cache = std::atomic_load(&_Cache);
+    if(!cache || !cache->shape.IsEqual(_Shape)) {
+        cache = std::make_shared<Cache>(_Shape);
+        std::atomic_store(&_Cache, cache);
+    }
+    return cache;
+}
+
+const TopTools_IndexedMapOfShape &TopoShape::getShapeMap(TopAbs_ShapeEnum type) const
+{
+    if(type < TopAbs_COMPOUND || type >= TopAbs_SHAPE)
+        Standard_Failure::Raise("Unsupported sub-shape type");
+
+    auto cache = getCache();
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    auto &map = cache->shapeMaps[type];
+    if(!map) {
+        map.reset(new TopTools_IndexedMapOfShape);
+        TopExp::MapShapes(cache->shape, type, *map);
+    }
+    return *map;
+}
+
+const TopTools_IndexedDataMapOfShapeListOfShape &TopoShape::getAncestorMap(
+        TopAbs_ShapeEnum type, TopAbs_ShapeEnum ancestor) const
+{
+    auto cache = getCache();
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    auto &map = cache->ancestorMaps[std::make_pair((int)type,(int)ancestor)];
+    if(!map) {
+        map.reset(new TopTools_IndexedDataMapOfShapeListOfShape);
+        TopExp::MapShapesAndAncestors(cache->shape, type, ancestor, *map);
+    }
+    return *map;
+}
+
 template<class T>
-static inline std::vector<T> _getSubShapes(const TopoDS_Shape &s, TopAbs_ShapeEnum type) {
+static inline std::vector<T> _getSubShapes(const TopoShape &shape, TopAbs_ShapeEnum type) {
     std::vector<T> shapes;
+    const TopoDS_Shape &s = shape.getShape();
     if(s.IsNull())
         return shapes;
 
@@ -437,8 +499,7 @@ static inline std::vector<T> _getSubShapes(const TopoDS_Shape &s, TopAbs_ShapeEn
         return shapes;
     }
 
-    TopTools_IndexedMapOfShape anIndices;
-    TopExp::MapShapes(s, type, anIndices);
+    const auto &anIndices = shape.getShapeMap(type);
     int count = anIndices.Extent();
     shapes.reserve(count);
     for(int i=1;i<=count;++i)
@@ -447,11 +508,11 @@ static inline std::vector<T> _getSubShapes(const TopoDS_Shape &s, TopAbs_ShapeEn
 }
 
 std::vector<TopoShape> TopoShape::getSubTopoShapes(TopAbs_ShapeEnum type) const {
-    return _getSubShapes<TopoShape>(_Shape,type);
+    return _getSubShapes<TopoShape>(*this,type);
 }
 
 std::vector<TopoDS_Shape> TopoShape::getSubShapes(TopAbs_ShapeEnum type) const {
-    return _getSubShapes<TopoDS_Shape>(_Shape,type);
+    return _getSubShapes<TopoDS_Shape>(*this,type);
 }
 
 static std::array<std::string,TopAbs_SHAPE> _ShapeNames;
@@ -613,6 +674,7 @@ void TopoShape::operator = (const TopoShape& sh)
     if (this != &sh) {
         this->Tag = sh.Tag;
         this->_Shape = sh._Shape;
+        std::atomic_store(&this->_Cache, std::atomic_load(&sh._Cache));
     }
 }
 
@@ -935,6 +997,204 @@ void TopoShape::importBinary(std::istream& str)
     }
 }
 
+namespace {
+
+// Header of the compact shape format: magic, version, block count, split flag
+// followed by the byte size of every block.
+const char CompactMagic[8] = {'F','C','S','H','A','P','E','\0'};
+const int32_t CompactVersion = 1;
+
+void putUInt64(std::ostream& out, uint64_t value)
+{
+    char buf[8];
+    for (int i=0; i<8; ++i)
+        buf[i] = static_cast<char>((value >> (8*i)) & 0xff);
+    out.write(buf, 8);
+}
+
+uint64_t getUInt64(std::istream& in)
+{
+    unsigned char buf[8];
+    in.read(reinterpret_cast<char*>(buf), 8);
+    if (!in)
+        throw Base::RuntimeError("Unexpected end of compact shape stream");
+    uint64_t value = 0;
+    for (int i=0; i<8; ++i)
+        value |= static_cast<uint64_t>(buf[i]) << (8*i);
+    return value;
+}
+
+void putInt32(std::ostream& out, int32_t value)
+{
+    putUInt64(out, static_cast<uint32_t>(value));
+}
+
+int32_t getInt32(std::istream& in)
+{
+    return static_cast<int32_t>(static_cast<uint32_t>(getUInt64(in)));
+}
+
+std::string encodeBlock(const TopoDS_Shape& shape)
+{
+    std::ostringstream str(std::ios::out | std::ios::binary);
+    TopoShape(shape).exportBinary(str);
+    return str.str();
+}
+
+TopoDS_Shape decodeBlock(const std::string& data)
+{
+    std::istringstream str(data, std::ios::in | std::ios::binary);
+    TopoShape shape;
+    shape.importBinary(str);
+    return shape.getShape();
+}
+
+// A compound can be written as independent blocks only if its children do not
+// share any topology, otherwise decoding them separately would break the links.
+bool canSplit(const TopoDS_Shape& shape)
+{
+    if (shape.IsNull() || shape.ShapeType() != TopAbs_COMPOUND)
+        return false;
+
+    int count = 0;
+    TopTools_MapOfShape seen;
+    for (TopoDS_Iterator it(shape, false, false); it.More(); it.Next(), ++count) {
+        TopTools_IndexedMapOfShape sub;
+        TopExp::MapShapes(it.Value(), TopAbs_VERTEX, sub);
+        TopExp::MapShapes(it.Value(), TopAbs_EDGE, sub);
+        if (sub.IsEmpty() && !seen.Add(it.Value()))
+            return false;
+        for (int i=1; i<=sub.Extent(); ++i) {
+            if (!seen.Add(sub(i)))
+                return false;
+        }
+    }
+    return count > 1;
+}
+
+} // anonymous namespace
+
+void TopoShape::exportCompact(std::ostream& out) const
+{
+    std::vector<TopoDS_Shape> shapes;
+    bool split = canSplit(this->_Shape);
+    if (split) {
+        // block 0 keeps the placement and orientation of the root compound
+        TopoDS_Compound root;
+        BRep_Builder builder;
+        builder.MakeCompound(root);
+        root.Location(this->_Shape.Location());
+        root.Orientation(this->_Shape.Orientation());
+        shapes.push_back(root);
+        for (TopoDS_Iterator it(this->_Shape, false, false); it.More(); it.Next())
+            shapes.push_back(it.Value());
+    }
+    else {
+        shapes.push_back(this->_Shape);
+    }
+
+    std::vector<std::string> blocks(shapes.size());
+    std::vector<std::string> errors(shapes.size());
+    std::vector<std::size_t> indices(shapes.size());
+    for (std::size_t i=0; i<indices.size(); ++i)
+        indices[i] = i;
+
+    QtConcurrent::blockingMap(indices, [&](std::size_t i) {
+        try {
+            blocks[i] = encodeBlock(shapes[i]);
+        }
+        catch (Standard_Failure& e) {
+            errors[i] = e.GetMessageString();
+        }
+        catch (const std::exception& e) {
+            errors[i] = e.what();
+        }
+    });
+
+    for (const auto& error : errors) {
+        if (!error.empty())
+            throw Base::CADKernelError(error.c_str());
+    }
+
+    out.write(CompactMagic, sizeof(CompactMagic));
+    putInt32(out, CompactVersion);
+    putInt32(out, static_cast<int32_t>(blocks.size()));
+    putInt32(out, split ? 1 : 0);
+    for (const auto& block : blocks)
+        putUInt64(out, block.size());
+    for (const auto& block : blocks)
+        out.write(block.c_str(), block.size());
+}
+
+void TopoShape::importCompact(std::istream& in)
+{
+    char magic[sizeof(CompactMagic)];
+    in.read(magic, sizeof(magic));
+    if (!in || memcmp(magic, CompactMagic, sizeof(magic)) != 0)
+        throw Base::RuntimeError("Stream does not contain a compact shape");
+
+    int32_t version = getInt32(in);
+    if (version > CompactVersion)
+        throw Base::RuntimeError("Unsupported version of compact shape stream");
+
+    int32_t count = getInt32(in);
+    bool split = getInt32(in) != 0;
+    if (count <= 0)
+        throw Base::RuntimeError("Invalid block count in compact shape stream");
+
+    std::vector<uint64_t> sizes(count);
+    for (auto& size : sizes)
+        size = getUInt64(in);
+
+    std::vector<std::string> blocks(count);
+    for (int32_t i=0; i<count; ++i) {
+        blocks[i].resize(static_cast<std::size_t>(sizes[i]));
+        in.read(&blocks[i][0], sizes[i]);
+        if (!in)
+            throw Base::RuntimeError("Unexpected end of compact shape stream");
+    }
+
+    std::vector<TopoDS_Shape> shapes(count);
+    std::vector<std::string> errors(count);
+    std::vector<int> indices(count);
+    for (int32_t i=0; i<count; ++i)
+        indices[i] = i;
+
+    QtConcurrent::blockingMap(indices, [&](int i) {
+        try {
+            shapes[i] = decodeBlock(blocks[i]);
+        }
+        catch (Standard_Failure& e) {
+            errors[i] = e.GetMessageString();
+        }
+        catch (const Base::Exception& e) {
+            errors[i] = e.what();
+        }
+        catch (const std::exception& e) {
+            errors[i] = e.what();
+        }
+    });
+
+    for (const auto& error : errors) {
+        if (!error.empty())
+            throw Base::RuntimeError(error.c_str());
+    }
+
+    if (!split) {
+        this->_Shape = shapes.front();
+        return;
+    }
+
+    TopoDS_Compound comp;
+    BRep_Builder builder;
+    builder.MakeCompound(comp);
+    for (std::size_t i=1; i<shapes.size(); ++i)
+        builder.Add(comp, shapes[i]);
+    comp.Location(shapes.front().Location());
+    comp.Orientation(shapes.front().Orientation());
+    this->_Shape = comp;
+}
+
 void TopoShape::write(const char *FileName) const
 {
     Base::FileInfo File(FileName);
@@ -1177,12 +1437,11 @@ void TopoShape::exportLineSet(std::ostream& str) const
 {
     Base::InventorBuilder builder(str);
     // get a indexed map of edges
-    TopTools_IndexedMapOfShape M;
-    TopExp::MapShapes(this->_Shape, TopAbs_EDGE, M);
+    const TopTools_IndexedMapOfShape &M = getShapeMap(TopAbs_EDGE);
 
     // build up map edge->face
-    TopTools_IndexedDataMapOfShapeListOfShape edge2Face;
-    TopExp::MapShapesAndAncestors(this->_Shape, TopAbs_EDGE, TopAbs_FACE, edge2Face);
+    const TopTools_IndexedDataMapOfShapeListOfShape &edge2Face =
+        getAncestorMap(TopAbs_EDGE, TopAbs_FACE);
     for (int i=0; i<M.Extent(); i++)
     {
         const TopoDS_Edge& aEdge = TopoDS::Edge(M(i+1));
@@ -1360,6 +1619,20 @@ unsigned int TopoShape::getMemSize (void) const
                     // first, last, tolerance
                     memsize += 5*sizeof(Standard_Real);
                     const TopoDS_Face& face = TopoDS::Face(shape);
+
+                    // the triangulation created for the visualization or export
+                    TopLoc_Location loc;
+                    Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(face, loc);
+                    if (!mesh.IsNull()) {
+                        memsize += sizeof(Poly_Triangulation);
+                        memsize += mesh->NbNodes() * sizeof(gp_Pnt);
+                        memsize += mesh->NbTriangles() * sizeof(Poly_Triangle);
+                        if (mesh->HasUVNodes())
+                            memsize += mesh->NbNodes() * sizeof(gp_Pnt2d);
+                        if (mesh->HasNormals())
+                            memsize += mesh->NbNodes() * 3 * sizeof(Standard_ShortReal);
+                    }
+
                     // if no geometry is attached to a face an exception is raised
                     BRepAdaptor_Surface surface;
                     try {
@@ -1416,6 +1689,22 @@ unsigned int TopoShape::getMemSize (void) const
                     // first, last, tolerance
                     memsize += 3*sizeof(Standard_Real);
                     const TopoDS_Edge& edge = TopoDS::Edge(shape);
+
+                    // the polygons of the edge in the triangulations of its faces
+                    TopLoc_Location loc;
+                    Handle(Poly_Polygon3D) polygon = BRep_Tool::Polygon3D(edge, loc);
+                    if (!polygon.IsNull())
+                        memsize += sizeof(Poly_Polygon3D) + polygon->NbNodes() * sizeof(gp_Pnt);
+                    Handle(Poly_PolygonOnTriangulation) polyOnTria;
+                    Handle(Poly_Triangulation) tria;
+                    for (int index = 1; ; index++) {
+                        BRep_Tool::PolygonOnTriangulation(edge, polyOnTria, tria, loc, index);
+                        if (polyOnTria.IsNull())
+                            break;
+                        memsize += sizeof(Poly_PolygonOnTriangulation);
+                        memsize += polyOnTria->NbNodes() * (sizeof(Standard_Integer) + sizeof(Standard_Real));
+                    }
+
                     // if no geometry is attached to an edge an exception is raised
                     BRepAdaptor_Curve curve;
                     try {
@@ -1485,10 +1774,109 @@ bool TopoShape::isNull() const
     return this->_Shape.IsNull() ? true : false;
 }
 
-bool TopoShape::isValid() const
+namespace {
+// Results of BRepCheck_Analyzer for the recently checked shapes. The entries
+// hold a reference to the shapes so the address of a TShape cannot be reused
+// for a different shape while it is in the cache.
+class ValidityCache
 {
-    BRepCheck_Analyzer aChecker(this->_Shape);
-    return aChecker.IsValid() ? true : false;
+public:
+    enum Result { Unknown, Valid, Invalid };
+
+    Result find(const TopoDS_Shape& shape, bool exact) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (!it->shape.IsSame(shape))
+                continue;
+            // a shape that passes the exact check passes the fast check, too, and
+            // a shape that fails the fast check fails the exact one
+            if ((it->valid && (it->exact || !exact)) || (!it->valid && (!it->exact || exact))) {
+                entries.splice(entries.begin(), entries, it);
+                return it->valid ? Valid : Invalid;
+            }
+        }
+        return Unknown;
+    }
+
+    void insert(const TopoDS_Shape& shape, bool exact, bool valid) {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.push_front(Entry{shape, exact, valid});
+        if (entries.size() > maxEntries)
+            entries.pop_back();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+    }
+
+private:
+    struct Entry {
+        TopoDS_Shape shape;
+        bool exact;
+        bool valid;
+    };
+    std::list<Entry> entries;
+    std::mutex mutex;
+    static const std::size_t maxEntries = 64;
+};
+
+ValidityCache validityCache;
+
+BRepCheck_Analyzer* makeAnalyzer(const TopoDS_Shape& shape, bool exact)
+{
+    Standard_Boolean geomControls = exact ? Standard_True : Standard_False;
+#if OCC_VERSION_HEX >= 0x070600
+    return new BRepCheck_Analyzer(shape, geomControls, Standard_True);
+#else
+    return new BRepCheck_Analyzer(shape, geomControls);
+#endif
+}
+
+bool runAnalyzer(const TopoDS_Shape& shape, bool exact)
+{
+#if OCC_VERSION_HEX < 0x070600
+    // The analyzer has no parallel mode, so check the children of a compound
+    // concurrently. A compound is valid if all its children are.
+    if (!shape.IsNull() && shape.ShapeType() == TopAbs_COMPOUND) {
+        std::vector<TopoDS_Shape> children;
+        for (TopoDS_Iterator it(shape); it.More(); it.Next())
+            children.push_back(it.Value());
+        if (children.size() > 1) {
+            std::vector<char> valid(children.size(), 0);
+            std::vector<int> indices(children.size());
+            for (std::size_t i = 0; i < indices.size(); i++)
+                indices[i] = static_cast<int>(i);
+            QtConcurrent::blockingMap(indices, [&](int index) {
+                try {
+                    std::unique_ptr<BRepCheck_Analyzer> aChecker(makeAnalyzer(children[index], exact));
+                    valid[index] = aChecker->IsValid() ? 1 : 0;
+                }
+                catch (const Standard_Failure&) {
+                    valid[index] = 0;
+                }
+            });
+            return std::find(valid.begin(), valid.end(), 0) == valid.end();
+        }
+    }
+#endif
+    std::unique_ptr<BRepCheck_Analyzer> aChecker(makeAnalyzer(shape, exact));
+    return aChecker->IsValid() ? true : false;
+}
+}
+
+bool TopoShape::isValid(bool exact) const
+{
+    if (this->_Shape.IsNull())
+        return runAnalyzer(this->_Shape, exact);
+
+    ValidityCache::Result result = validityCache.find(this->_Shape, exact);
+    if (result != ValidityCache::Unknown)
+        return result == ValidityCache::Valid;
+
+    bool valid = runAnalyzer(this->_Shape, exact);
+    validityCache.insert(this->_Shape, exact, valid);
+    return valid;
 }
 
 namespace Part {
@@ -1526,11 +1914,18 @@ std::vector<std::string> buildBOPCheckResultVector()
 }
 }
 
-bool TopoShape::analyze(bool runBopCheck, std::ostream& str) const
+bool TopoShape::analyze(bool runBopCheck, std::ostream& str, bool exact) const
 {
     if (!this->_Shape.IsNull()) {
-        BRepCheck_Analyzer aChecker(this->_Shape);
-        if (!aChecker.IsValid()) {
+        // the analyzer is only needed to report the errors of an invalid shape
+        std::unique_ptr<BRepCheck_Analyzer> aChecker;
+        bool valid = validityCache.find(this->_Shape, exact) == ValidityCache::Valid;
+        if (!valid) {
+            aChecker.reset(makeAnalyzer(this->_Shape, exact));
+            valid = aChecker->IsValid() ? true : false;
+            validityCache.insert(this->_Shape, exact, valid);
+        }
+        if (!valid) {
             std::vector<TopoDS_Shape> shapes;
 
             TopTools_IndexedMapOfShape vertexOfShape;
@@ -1574,8 +1969,8 @@ bool TopoShape::analyze(bool runBopCheck, std::ostream& str) const
                 shapes.push_back(compsOfShape(i));
 
             for (std::vector<TopoDS_Shape>::iterator xp = shapes.begin(); xp != shapes.end(); ++xp) {
-                if (!aChecker.IsValid(*xp)) {
-                    const Handle(BRepCheck_Result)& result = aChecker.Result(*xp);
+                if (!aChecker->IsValid(*xp)) {
+                    const Handle(BRepCheck_Result)& result = aChecker->Result(*xp);
                     if (result.IsNull())
                         continue;
                     const BRepCheck_ListOfStatus& status = result->StatusOnShape(*xp);
@@ -1708,7 +2103,8 @@ bool TopoShape::analyze(bool runBopCheck, std::ostream& str) const
             BOPCheck.SetShape1(BOPCopy);
             //all settings are false by default. so only turn on what we want.
             BOPCheck.ArgumentTypeMode() = true;
-            BOPCheck.SelfInterMode() = true;
+            // the self-interference test is by far the slowest one
+            BOPCheck.SelfInterMode() = exact;
             BOPCheck.SmallEdgeMode() = true;
             BOPCheck.RebuildFaceMode() = true;
 #if OCC_VERSION_HEX >= 0x060700
@@ -1809,13 +2205,32 @@ bool TopoShape::isClosed() const
     return closed;
 }
 
+#if OCC_VERSION_HEX >= 0x060900
+// The two-shape constructors of the boolean operations always run sequentially
+static void buildBoolean(BRepAlgoAPI_BooleanOperation& mkBool, const TopoDS_Shape& base, const TopoDS_Shape& tool)
+{
+    TopTools_ListOfShape shapeArguments, shapeTools;
+    shapeArguments.Append(base);
+    shapeTools.Append(tool);
+    mkBool.SetArguments(shapeArguments);
+    mkBool.SetTools(shapeTools);
+    mkBool.SetRunParallel(true);
+    mkBool.Build();
+}
+#endif
+
 TopoDS_Shape TopoShape::cut(TopoDS_Shape shape) const
 {
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
     if (shape.IsNull())
         Standard_Failure::Raise("Tool shape is null");
+#if OCC_VERSION_HEX >= 0x060900
+    BRepAlgoAPI_Cut mkCut;
+    buildBoolean(mkCut, this->_Shape, shape);
+#else
     BRepAlgoAPI_Cut mkCut(this->_Shape, shape);
+#endif
     return makeShell(mkCut.Shape());
 }
 
@@ -1861,7 +2276,12 @@ TopoDS_Shape TopoShape::common(TopoDS_Shape shape) const
         Standard_Failure::Raise("Base shape is null");
     if (shape.IsNull())
         Standard_Failure::Raise("Tool shape is null");
+#if OCC_VERSION_HEX >= 0x060900
+    BRepAlgoAPI_Common mkCommon;
+    buildBoolean(mkCommon, this->_Shape, shape);
+#else
     BRepAlgoAPI_Common mkCommon(this->_Shape, shape);
+#endif
     return makeShell(mkCommon.Shape());
 }
 
@@ -1907,7 +2327,12 @@ TopoDS_Shape TopoShape::fuse(TopoDS_Shape shape) const
         Standard_Failure::Raise("Base shape is null");
     if (shape.IsNull())
         Standard_Failure::Raise("Tool shape is null");
+#if OCC_VERSION_HEX >= 0x060900
+    BRepAlgoAPI_Fuse mkFuse;
+    buildBoolean(mkFuse, this->_Shape, shape);
+#else
     BRepAlgoAPI_Fuse mkFuse(this->_Shape, shape);
+#endif
     return makeShell(mkFuse.Shape());
 }
 
@@ -2043,11 +2468,8 @@ std::list<TopoDS_Wire> TopoShape::slice(const Base::Vector3d& dir, double d) con
 
 TopoDS_Compound TopoShape::slices(const Base::Vector3d& dir, const std::vector<double>& d) const
 {
-    std::vector< std::list<TopoDS_Wire> > wire_list;
     CrossSection cs(dir.x, dir.y, dir.z, this->_Shape);
-    for (std::vector<double>::const_iterator jt = d.begin(); jt != d.end(); ++jt) {
-        wire_list.push_back(cs.slice(*jt));
-    }
+    std::vector< std::list<TopoDS_Wire> > wire_list = cs.slices(d);
 
     std::vector< std::list<TopoDS_Wire> >::const_iterator ft;
     TopoDS_Compound comp;
@@ -3293,6 +3715,9 @@ bool TopoShape::fix(double precision, double mintol, double maxtol)
 
     TopAbs_ShapeEnum type = this->_Shape.ShapeType();
 
+    // the fixes may modify sub-shapes in place
+    validityCache.clear();
+
     ShapeFix_Shape fix(this->_Shape);
     fix.SetPrecision(precision);
     fix.SetMinTolerance(mintol);
@@ -3531,86 +3956,25 @@ void TopoShape::getFaces(std::vector<Base::Vector3d> &aPoints,
     if (this->_Shape.IsNull())
         return;
 
-    // get the meshes of all faces and then merge them
-    BRepMesh_IncrementalMesh aMesh(this->_Shape, accuracy,
-                                   /*isRelative*/ Standard_False,
-                                   /*theAngDeflection*/
-                                   defaultAngularDeflection(accuracy),
-                                   /*isInParallel*/ true);
-    std::vector<Domain> domains;
-    getDomains(domains);
-
-    std::set<MeshVertex> vertices;
-    Standard_Real x1, y1, z1;
-    Standard_Real x2, y2, z2;
-    Standard_Real x3, y3, z3;
-
-    for (std::vector<Domain>::const_iterator it = domains.begin(); it != domains.end(); ++it) {
-        const Domain& domain = *it;
-        for (std::vector<Facet>::const_iterator jt = domain.facets.begin(); jt != domain.facets.end(); ++jt) {
-            x1 = domain.points[jt->I1].x;
-            y1 = domain.points[jt->I1].y;
-            z1 = domain.points[jt->I1].z;
-
-            x2 = domain.points[jt->I2].x;
-            y2 = domain.points[jt->I2].y;
-            z2 = domain.points[jt->I2].z;
-
-            x3 = domain.points[jt->I3].x;
-            y3 = domain.points[jt->I3].y;
-            z3 = domain.points[jt->I3].z;
-
-            TopoShape::Facet face;
-            std::set<MeshVertex>::iterator vIt;
-
-            // 1st vertex
-            MeshVertex v1(x1,y1,z1);
-            vIt = vertices.find(v1);
-            if (vIt == vertices.end()) {
-                v1.i = vertices.size();
-                face.I1 = v1.i;
-                vertices.insert(v1);
-            }
-            else {
-                face.I1 = vIt->i;
-            }
-
-            // 2nd vertex
-            MeshVertex v2(x2,y2,z2);
-            vIt = vertices.find(v2);
-            if (vIt == vertices.end()) {
-                v2.i = vertices.size();
-                face.I2 = v2.i;
-                vertices.insert(v2);
-            }
-            else {
-                face.I2 = vIt->i;
-            }
-
-            // 3rd vertex
-            MeshVertex v3(x3,y3,z3);
-            vIt = vertices.find(v3);
-            if (vIt == vertices.end()) {
-                v3.i = vertices.size();
-                face.I3 = v3.i;
-                vertices.insert(v3);
-            }
-            else {
-                face.I3 = vIt->i;
-            }
-
-            // make sure that we don't insert invalid facets
-            if (face.I1 != face.I2 &&
-                face.I2 != face.I3 &&
-                face.I3 != face.I1)
-                aTopo.push_back(face);
-        }
-    }
-
-    std::vector<Base::Vector3d> points;
-    points.resize(vertices.size());
-    for (std::set<MeshVertex>::iterator it = vertices.begin(); it != vertices.end(); ++it)
-        points[it->i] = it->toPoint();
+    // mesh all faces and join them at their shared edges and vertices
+    ShapeTessellator tessellator(this->_Shape);
+    tessellator.setDeflection(accuracy, defaultAngularDeflection(accuracy));
+    tessellator.perform();
+
+    std::vector<Base::Vector3d> points(tessellator.countPoints());
+    tessellator.getPoints([&points](std::size_t index, const gp_Pnt& p) {
+        points[index].Set(p.X(), p.Y(), p.Z());
+    });
+
+    std::size_t offset = aTopo.size();
+    aTopo.resize(offset + tessellator.countFacets());
+    tessellator.getFacets([&aTopo, offset](std::size_t index, std::size_t p1,
+                                           std::size_t p2, std::size_t p3) {
+        Facet& face = aTopo[offset + index];
+        face.I1 = static_cast<uint32_t>(p1);
+        face.I2 = static_cast<uint32_t>(p2);
+        face.I3 = static_cast<uint32_t>(p3);
+    });
     aPoints.swap(points);
 }
 
@@ -3790,6 +4154,38 @@ void TopoShape::getPoints(std::vector<Base::Vector3d> &Points,
         Normals.clear();
 }
 
+Base::BoundBox3d TopoShape::getSubElementBoundBox(const Data::Segment* element) const
+{
+    Base::BoundBox3d box;
+    if (element->getTypeId() != ShapeSegment::getClassTypeId())
+        return box;
+    const TopoDS_Shape& shape = static_cast<const ShapeSegment*>(element)->Shape;
+    if (shape.IsNull())
+        return box;
+    try {
+        // the triangulation is used if available, which is much faster
+        // than the exact geometry
+        Bnd_Box bounds;
+        BRepBndLib::Add(shape, bounds, Standard_True);
+        if (bounds.IsVoid())
+            return box;
+        bounds.SetGap(0.0);
+        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+
+        box.MinX = xMin;
+        box.MaxX = xMax;
+        box.MinY = yMin;
+        box.MaxY = yMax;
+        box.MinZ = zMin;
+        box.MaxZ = zMax;
+    }
+    catch (Standard_Failure&) {
+    }
+
+    return box;
+}
+
 void TopoShape::getLinesFromSubelement(const Data::Segment* element,
                                        std::vector<Base::Vector3d> &vertices,
                                        std::vector<Line> &lines) const
@@ -3805,8 +4201,8 @@ void TopoShape::getLinesFromSubelement(const Data::Segment* element,
         }
 
         // build up map edge->face
-        TopTools_IndexedDataMapOfShapeListOfShape edge2Face;
-        TopExp::MapShapesAndAncestors(this->_Shape, TopAbs_EDGE, TopAbs_FACE, edge2Face);
+        const TopTools_IndexedDataMapOfShapeListOfShape &edge2Face =
+            getAncestorMap(TopAbs_EDGE, TopAbs_FACE);
 
         for(TopExp_Explorer exp(shape,TopAbs_EDGE);exp.More();exp.Next()) {
 
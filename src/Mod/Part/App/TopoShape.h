@@ -25,9 +25,12 @@
 #define PART_TOPOSHAPE_H
 
 #include <iosfwd>
+#include <memory>
 #include <TopoDS_Compound.hxx>
 #include <TopoDS_Wire.hxx>
 #include <TopTools_ListOfShape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
 #include <App/ComplexGeoData.h>
 #include <Base/Exception.h>
 
@@ -97,6 +100,7 @@ public:
 
     inline void setShape(const TopoDS_Shape& shape) {
         this->_Shape = shape;
+        this->_Cache.reset();
     }
 
     inline const TopoDS_Shape& getShape() const {
@@ -145,6 +149,8 @@ public:
         std::vector<Base::Vector3d> &Points,
         std::vector<Base::Vector3d> &PointNormals,
         std::vector<Facet> &faces) const;
+    /** Get the bounding box of the segment, using the triangulation if any */
+    virtual Base::BoundBox3d getSubElementBoundBox(const Data::Segment*) const;
     //@}
     /// get the Topo"sub"Shape with the given name
     TopoDS_Shape getSubShape(const char* Type, bool silent=false) const;
@@ -155,6 +161,19 @@ public:
     unsigned long countSubShapes(TopAbs_ShapeEnum type) const;
     bool hasSubShape(const char *Type) const;
     bool hasSubShape(TopAbs_ShapeEnum type) const;
+    /** Return the index map of all sub-shapes of the given type
+     *
+     * The map is built on first access and kept until the shape changes.
+     * The returned reference is only valid as long as the shape is not
+     * modified.
+     */
+    const TopTools_IndexedMapOfShape &getShapeMap(TopAbs_ShapeEnum type) const;
+    /** Return the map of all sub-shapes of the given type to their ancestors
+     *
+     * The map is cached the same way as the one of getShapeMap().
+     */
+    const TopTools_IndexedDataMapOfShapeListOfShape &getAncestorMap(
+            TopAbs_ShapeEnum type, TopAbs_ShapeEnum ancestor) const;
     /// get the Topo"sub"Shape with the given name
     PyObject * getPySubShape(const char* Type, bool silent=false) const;
     PyObject * getPyObject();
@@ -185,6 +204,9 @@ public:
     void exportBrep(const char *FileName) const;
     void exportBrep(std::ostream&) const;
     void exportBinary(std::ostream&);
+    /// Compact format: binary blocks of independent sub-shapes, coded in parallel
+    void exportCompact(std::ostream&) const;
+    void importCompact(std::istream&);
     void exportStl (const char *FileName, double deflection) const;
     void exportFaceSet(double, double, const std::vector<App::Color>&, std::ostream&) const;
     void exportLineSet(std::ostream&) const;
@@ -193,8 +215,13 @@ public:
     /** @name Query*/
     //@{
     bool isNull() const;
-    bool isValid() const;
-    bool analyze(bool runBopCheck, std::ostream&) const;
+    /** Checks the shape with BRepCheck_Analyzer. If \a exact is false the geometric
+     * checks are skipped, which is much faster for big shapes. The results of the
+     * recently checked shapes are cached.
+     */
+    bool isValid(bool exact = true) const;
+    /// If \a exact is false the geometric checks and the BOP self-interference check are skipped
+    bool analyze(bool runBopCheck, std::ostream&, bool exact = true) const;
     bool isClosed() const;
     bool isCoplanar(const TopoShape &other, double tol=-1) const;
     bool findPlane(gp_Pln &pln, double tol=-1) const;
@@ -368,8 +395,13 @@ public:
     static const std::string &shapeName(TopAbs_ShapeEnum type,bool silent=false);
     const std::string &shapeName(bool silent=false) const;
     static std::pair<TopAbs_ShapeEnum,int> shapeTypeAndIndex(const char *name);
+private:
+    struct Cache;
+    std::shared_ptr<Cache> getCache() const;
+
 private:
     TopoDS_Shape _Shape;
+    mutable std::shared_ptr<Cache> _Cache;
 };
 
 } //namespace Part
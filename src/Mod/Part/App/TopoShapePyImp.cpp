@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <mutex>
 # include <sstream>
 # include <BRepMesh_IncrementalMesh.hxx>
 # include <BRepBuilderAPI_Copy.hxx>
@@ -70,6 +71,7 @@
 #endif
 
 #include <Base/GeometryPyCXX.h>
+#include <Base/Interpreter.h>
 #include <Base/Matrix.h>
 #include <Base/Rotation.h>
 #include <Base/MatrixPy.h>
@@ -105,6 +107,28 @@ using namespace Part;
     #define M_PI_2  1.57079632679489661923 /* pi/2 */
 #endif
 
+namespace {
+
+// The OCC data exchange writers keep their settings in static variables
+std::mutex exportMutex;
+
+/**
+ * Calls \a func with a copy of \a shape while the GIL is released, so that other Python
+ * threads can run during long OCC operations. The copy keeps the geometry alive even if
+ * the Python object is changed or deleted by another thread in the meantime. All
+ * arguments must be copied before and \a func must neither access Python objects nor
+ * the document.
+ */
+template <typename Func>
+auto callWithoutGIL(const TopoShape& shape, Func func) -> decltype(func(shape))
+{
+    TopoShape copy(shape.getShape());
+    Base::PyGILStateRelease release;
+    return func(copy);
+}
+
+}
+
 // returns a string which represents the object e.g. when printed in python
 std::string TopoShapePy::representation(void) const
 {
@@ -330,7 +354,10 @@ PyObject*  TopoShapePy::exportIges(PyObject *args)
 
     try {
         // write iges file
-        getTopoShapePtr()->exportIges(EncodedName.c_str());
+        callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+            std::lock_guard<std::mutex> lock(exportMutex);
+            self.exportIges(EncodedName.c_str());
+        });
     }
     catch (const Base::Exception& e) {
         PyErr_SetString(PartExceptionOCCError,e.what());
@@ -350,7 +377,10 @@ PyObject*  TopoShapePy::exportStep(PyObject *args)
 
     try {
         // write step file
-        getTopoShapePtr()->exportStep(EncodedName.c_str());
+        callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+            std::lock_guard<std::mutex> lock(exportMutex);
+            self.exportStep(EncodedName.c_str());
+        });
     }
     catch (const Base::Exception& e) {
         PyErr_SetString(PartExceptionOCCError,e.what());
@@ -718,11 +748,13 @@ PyObject* TopoShapePy::revolve(PyObject *args)
 PyObject*  TopoShapePy::check(PyObject *args)
 {
     PyObject* runBopCheck = Py_False;
-    if (!PyArg_ParseTuple(args, "|O!", &(PyBool_Type), &runBopCheck))
+    PyObject* exact = Py_True;
+    if (!PyArg_ParseTuple(args, "|O!O!", &(PyBool_Type), &runBopCheck, &(PyBool_Type), &exact))
         return NULL;
     if (!getTopoShapePtr()->getShape().IsNull()) {
         std::stringstream str;
-        if (!getTopoShapePtr()->analyze(PyObject_IsTrue(runBopCheck) ? true : false, str)) {
+        if (!getTopoShapePtr()->analyze(PyObject_IsTrue(runBopCheck) ? true : false, str,
+                                        PyObject_IsTrue(exact) ? true : false)) {
             PyErr_SetString(PyExc_ValueError, str.str().c_str());
             return NULL;
         }
@@ -738,7 +770,9 @@ PyObject*  TopoShapePy::fuse(PyObject *args)
         TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
         try {
             // Let's call algorithm computing a fuse operation:
-            TopoDS_Shape fusShape = this->getTopoShapePtr()->fuse(shape);
+            TopoDS_Shape fusShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.fuse(shape);
+            });
             return new TopoShapePy(new TopoShape(fusShape));
         }
         catch (Standard_Failure& e) {
@@ -759,7 +793,9 @@ PyObject*  TopoShapePy::fuse(PyObject *args)
         shapeVec.push_back(static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape());
         try {
             // Let's call algorithm computing a fuse operation:
-            TopoDS_Shape fuseShape = this->getTopoShapePtr()->fuse(shapeVec,tolerance);
+            TopoDS_Shape fuseShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.fuse(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(fuseShape));
         }
         catch (Standard_Failure& e) {
@@ -787,7 +823,9 @@ PyObject*  TopoShapePy::fuse(PyObject *args)
            }
         }
         try {
-            TopoDS_Shape multiFusedShape = this->getTopoShapePtr()->fuse(shapeVec,tolerance);
+            TopoDS_Shape multiFusedShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.fuse(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(multiFusedShape));
         }
         catch (Standard_Failure& e) {
@@ -823,7 +861,9 @@ PyObject*  TopoShapePy::multiFuse(PyObject *args)
        }
     }
     try {
-        TopoDS_Shape multiFusedShape = this->getTopoShapePtr()->fuse(shapeVec,tolerance);
+        TopoDS_Shape multiFusedShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+            return self.fuse(shapeVec,tolerance);
+        });
         return new TopoShapePy(new TopoShape(multiFusedShape));
     }
     catch (Standard_Failure& e) {
@@ -867,7 +907,9 @@ PyObject*  TopoShapePy::common(PyObject *args)
         TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
         try {
             // Let's call algorithm computing a common operation:
-            TopoDS_Shape comShape = this->getTopoShapePtr()->common(shape);
+            TopoDS_Shape comShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.common(shape);
+            });
             return new TopoShapePy(new TopoShape(comShape));
         }
         catch (Standard_Failure& e) {
@@ -887,7 +929,9 @@ PyObject*  TopoShapePy::common(PyObject *args)
         std::vector<TopoDS_Shape> shapeVec;
         shapeVec.push_back(static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape());
         try {
-            TopoDS_Shape commonShape = this->getTopoShapePtr()->common(shapeVec,tolerance);
+            TopoDS_Shape commonShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.common(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(commonShape));
         }
         catch (Standard_Failure& e) {
@@ -915,7 +959,9 @@ PyObject*  TopoShapePy::common(PyObject *args)
            }
         }
         try {
-            TopoDS_Shape multiCommonShape = this->getTopoShapePtr()->common(shapeVec,tolerance);
+            TopoDS_Shape multiCommonShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.common(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(multiCommonShape));
         }
         catch (Standard_Failure& e) {
@@ -941,7 +987,10 @@ PyObject*  TopoShapePy::section(PyObject *args)
         TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
         try {
             // Let's call algorithm computing a section operation:
-            TopoDS_Shape secShape = this->getTopoShapePtr()->section(shape,PyObject_IsTrue(approx) ? true : false);
+            bool approximate = PyObject_IsTrue(approx) ? true : false;
+            TopoDS_Shape secShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.section(shape,approximate);
+            });
             return new TopoShapePy(new TopoShape(secShape));
         }
         catch (Standard_Failure& e) {
@@ -961,7 +1010,10 @@ PyObject*  TopoShapePy::section(PyObject *args)
         std::vector<TopoDS_Shape> shapeVec;
         shapeVec.push_back(static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape());
         try {
-            TopoDS_Shape sectionShape = this->getTopoShapePtr()->section(shapeVec,tolerance,PyObject_IsTrue(approx) ? true : false);
+            bool approximate = PyObject_IsTrue(approx) ? true : false;
+            TopoDS_Shape sectionShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.section(shapeVec,tolerance,approximate);
+            });
             return new TopoShapePy(new TopoShape(sectionShape));
         }
         catch (Standard_Failure& e) {
@@ -989,7 +1041,10 @@ PyObject*  TopoShapePy::section(PyObject *args)
            }
         }
         try {
-            TopoDS_Shape multiSectionShape = this->getTopoShapePtr()->section(shapeVec,tolerance,PyObject_IsTrue(approx) ? true : false);
+            bool approximate = PyObject_IsTrue(approx) ? true : false;
+            TopoDS_Shape multiSectionShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.section(shapeVec,tolerance,approximate);
+            });
             return new TopoShapePy(new TopoShape(multiSectionShape));
         }
         catch (Standard_Failure& e) {
@@ -1048,7 +1103,9 @@ PyObject*  TopoShapePy::slices(PyObject *args)
         d.reserve(list.size());
         for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it)
             d.push_back((double)Py::Float(*it));
-        TopoDS_Compound slice = this->getTopoShapePtr()->slices(vec, d);
+        TopoDS_Compound slice = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+            return self.slices(vec, d);
+        });
         return new TopoShapeCompoundPy(new TopoShape(slice));
     }
     catch (Standard_Failure& e) {
@@ -1069,7 +1126,9 @@ PyObject*  TopoShapePy::cut(PyObject *args)
         TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
         try {
             // Let's call algorithm computing a cut operation:
-            TopoDS_Shape cutShape = this->getTopoShapePtr()->cut(shape);
+            TopoDS_Shape cutShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.cut(shape);
+            });
             return new TopoShapePy(new TopoShape(cutShape));
         }
         catch (Standard_Failure& e) {
@@ -1089,7 +1148,9 @@ PyObject*  TopoShapePy::cut(PyObject *args)
         std::vector<TopoDS_Shape> shapeVec;
         shapeVec.push_back(static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape());
         try {
-            TopoDS_Shape cutShape = this->getTopoShapePtr()->cut(shapeVec,tolerance);
+            TopoDS_Shape cutShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.cut(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(cutShape));
         }
         catch (Standard_Failure& e) {
@@ -1117,7 +1178,9 @@ PyObject*  TopoShapePy::cut(PyObject *args)
            }
         }
         try {
-            TopoDS_Shape multiCutShape = this->getTopoShapePtr()->cut(shapeVec,tolerance);
+            TopoDS_Shape multiCutShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+                return self.cut(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(multiCutShape));
         }
         catch (Standard_Failure& e) {
@@ -1155,7 +1218,9 @@ PyObject*  TopoShapePy::generalFuse(PyObject *args)
     }
     try {
         std::vector<TopTools_ListOfShape> map;
-        TopoDS_Shape gfaResultShape = this->getTopoShapePtr()->generalFuse(shapeVec,tolerance,&map);
+        TopoDS_Shape gfaResultShape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+            return self.generalFuse(shapeVec,tolerance,&map);
+        });
 
         Py::Object shapePy = shape2pyshape(gfaResultShape);
 
@@ -1694,8 +1759,12 @@ PyObject* TopoShapePy::makeThickness(PyObject *args)
             }
         }
 
-        TopoDS_Shape shape = this->getTopoShapePtr()->makeThickSolid(facesToRemove, offset, tolerance,
-            PyObject_IsTrue(inter) ? true : false, PyObject_IsTrue(self_inter) ? true : false, offsetMode, join);
+        bool intersection = PyObject_IsTrue(inter) ? true : false;
+        bool selfInter = PyObject_IsTrue(self_inter) ? true : false;
+        TopoDS_Shape shape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+            return self.makeThickSolid(facesToRemove, offset, tolerance,
+                intersection, selfInter, offsetMode, join);
+        });
         return new TopoShapeSolidPy(new TopoShape(shape));
     }
     catch (Standard_Failure& e) {
@@ -1722,10 +1791,13 @@ PyObject* TopoShapePy::makeOffsetShape(PyObject *args, PyObject *keywds)
         return 0;
 
     try {
-        TopoDS_Shape shape = this->getTopoShapePtr()->makeOffsetShape(offset, tolerance,
-            PyObject_IsTrue(inter) ? true : false,
-            PyObject_IsTrue(self_inter) ? true : false, offsetMode, join,
-            PyObject_IsTrue(fill) ? true : false);
+        bool intersection = PyObject_IsTrue(inter) ? true : false;
+        bool selfInter = PyObject_IsTrue(self_inter) ? true : false;
+        bool fillGap = PyObject_IsTrue(fill) ? true : false;
+        TopoDS_Shape shape = callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+            return self.makeOffsetShape(offset, tolerance,
+                intersection, selfInter, offsetMode, join, fillGap);
+        });
         return new TopoShapePy(new TopoShape(shape));
     }
     catch (Standard_Failure& e) {
@@ -1877,10 +1949,11 @@ PyObject*  TopoShapePy::isPartner(PyObject *args)
 
 PyObject*  TopoShapePy::isValid(PyObject *args)
 {
-    if (!PyArg_ParseTuple(args, ""))
+    PyObject* exact = Py_True;
+    if (!PyArg_ParseTuple(args, "|O!", &(PyBool_Type), &exact))
         return NULL;
     PY_TRY {
-        return Py_BuildValue("O", (getTopoShapePtr()->isValid() ? Py_True : Py_False));
+        return Py_BuildValue("O", (getTopoShapePtr()->isValid(PyObject_IsTrue(exact) ? true : false) ? Py_True : Py_False));
     } PY_CATCH_OCC
 }
 
@@ -1952,9 +2025,12 @@ PyObject* TopoShapePy::tessellate(PyObject *args)
             return 0;
         std::vector<Base::Vector3d> Points;
         std::vector<Data::ComplexGeoData::Facet> Facets;
-        if (PyObject_IsTrue(ok))
-            BRepTools::Clean(getTopoShapePtr()->getShape());
-        getTopoShapePtr()->getFaces(Points, Facets,tolerance);
+        bool clean = PyObject_IsTrue(ok) ? true : false;
+        callWithoutGIL(*getTopoShapePtr(), [&](const TopoShape& self) {
+            if (clean)
+                BRepTools::Clean(self.getShape());
+            self.getFaces(Points, Facets,tolerance);
+        });
         Py::Tuple tuple(2);
         Py::List vertex;
         for (std::vector<Base::Vector3d>::const_iterator it = Points.begin();
@@ -31,6 +31,7 @@
 # include <GeomAdaptor_Surface.hxx>
 # include <Geom_Plane.hxx>
 # include <Geom_CylindricalSurface.hxx>
+# include <gp.hxx>
 # include <gp_Ax3.hxx>
 # include <Geom_BSplineSurface.hxx>
 # include <gp_Pln.hxx>
@@ -65,12 +66,14 @@
 # include <GeomAPI_ProjectPointOnSurf.hxx>
 # include <BRepGProp.hxx>
 # include <GProp_GProps.hxx>
+# include <Precision.hxx>
 # include <Standard_Version.hxx>
 #endif // _PreComp_
 
 #include <Base/Tools.h>
 
 #include <Base/Console.h>
+#include <Base/ThreadPool.h>
 #include <Base/Tools.h>
 
 #include "modelRefine.h"
@@ -256,40 +259,98 @@ void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, FaceVectorTyp
     }
 }
 
+void FaceAdjacencySplitter::removeIsolated(FaceVectorType &faces) const
+{
+    TopTools_MapOfShape facesMap;
+    for (FaceVectorType::const_iterator it = faces.begin(); it != faces.end(); ++it)
+        facesMap.Add(*it);
+
+    FaceVectorType::iterator last = std::remove_if(faces.begin(), faces.end(), [&](const TopoDS_Face &face) {
+        const TopTools_ListOfShape &edges = faceToEdgeMap.FindFromKey(face);
+        TopTools_ListIteratorOfListOfShape edgeIt;
+        for (edgeIt.Initialize(edges); edgeIt.More(); edgeIt.Next())
+        {
+            const TopTools_ListOfShape &neighbours = edgeToFaceMap.FindFromKey(edgeIt.Value());
+            TopTools_ListIteratorOfListOfShape faceIt;
+            for (faceIt.Initialize(neighbours); faceIt.More(); faceIt.Next())
+            {
+                if (!faceIt.Value().IsSame(face) && facesMap.Contains(faceIt.Value()))
+                    return false;
+            }
+        }
+        return true;
+    });
+    faces.erase(last, faces.end());
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void FaceEqualitySplitter::split(const FaceVectorType &faces, FaceTypedBase *object)
 {
-    std::vector<FaceVectorType> tempVector;
-    tempVector.reserve(faces.size());
-    FaceVectorType::const_iterator faceIt;
-    for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
+    // Sort the faces by a key of their surface so that only faces with close keys
+    // must be compared instead of all pairs of faces.
+    std::size_t count = faces.size();
+    std::vector<double> keys(count, 0.0);
+    double window = 0.0;
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        double tolerance = 0.0;
+        if (object->getSortKey(faces[index], keys[index], tolerance))
+            window = std::max(window, tolerance);
+    }
+    window *= 2.0;
+
+    std::vector<std::size_t> order(count);
+    for (std::size_t index = 0; index < count; ++index)
+        order[index] = index;
+    std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) {
+        return keys[a] < keys[b];
+    });
+
+    std::vector<std::vector<std::size_t> > groups;
+    std::vector<std::size_t> active;
+    std::size_t firstActive = 0;
+    for (std::size_t faceIndex : order)
     {
+        // groups whose first face is too far away can't get any further faces
+        while (firstActive < active.size() &&
+               keys[groups[active[firstActive]].front()] < keys[faceIndex] - window)
+            ++firstActive;
+
         bool foundMatch(false);
-        std::vector<FaceVectorType>::iterator tempIt;
-        for (tempIt = tempVector.begin(); tempIt != tempVector.end(); ++tempIt)
+        for (std::size_t activeIndex = firstActive; activeIndex < active.size(); ++activeIndex)
         {
-            if (object->isEqual((*tempIt).front(), *faceIt))
+            std::vector<std::size_t> &group = groups[active[activeIndex]];
+            if (object->isEqual(faces[group.front()], faces[faceIndex]))
             {
-                (*tempIt).push_back(*faceIt);
+                group.push_back(faceIndex);
                 foundMatch = true;
                 break;
             }
         }
         if (!foundMatch)
         {
-            FaceVectorType another;
-            another.reserve(faces.size());
-            another.push_back(*faceIt);
-            tempVector.push_back(another);
+            active.push_back(groups.size());
+            groups.push_back(std::vector<std::size_t>(1, faceIndex));
         }
     }
-    std::vector<FaceVectorType>::iterator it;
-    for (it = tempVector.begin(); it != tempVector.end(); ++it)
+
+    // keep the input order of the faces and groups to get reproducible results
+    for (std::vector<std::size_t> &group : groups)
+        std::sort(group.begin(), group.end());
+    std::sort(groups.begin(), groups.end(), [](const std::vector<std::size_t> &a, const std::vector<std::size_t> &b) {
+        return a.front() < b.front();
+    });
+
+    for (const std::vector<std::size_t> &group : groups)
     {
-        if ((*it).size() < 2)
+        if (group.size() < 2)
             continue;
-        equalityVector.push_back(*it);
+        FaceVectorType equalFaces;
+        equalFaces.reserve(group.size());
+        for (std::size_t faceIndex : group)
+            equalFaces.push_back(faces[faceIndex]);
+        equalityVector.push_back(equalFaces);
     }
 }
 
@@ -302,6 +363,11 @@ GeomAbs_SurfaceType FaceTypedBase::getFaceType(const TopoDS_Face &faceIn)
     return surfaceTest.GetType();
 }
 
+bool FaceTypedBase::getSortKey(const TopoDS_Face &, double &, double &) const
+{
+    return false;
+}
+
 void FaceTypedBase::boundarySplit(const FaceVectorType &facesIn, std::vector<EdgeVectorType> &boundariesOut) const
 {
     EdgeVectorType bEdges;
@@ -386,6 +452,22 @@ bool FaceTypedPlane::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &face
             planeOne.Distance(planeTwo.Position().Location()) < Precision::Confusion());
 }
 
+bool FaceTypedPlane::getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const
+{
+    Handle(Geom_Plane) planeSurface = getGeomPlane(face);
+    if (planeSurface.IsNull())
+        return false;
+
+    // The distance of the plane to the origin doesn't depend on the orientation of
+    // the normal. A tilt within the angular tolerance of isEqual() changes it by up
+    // to the tolerance times the distance of the plane's location to the origin.
+    gp_Pln plane(planeSurface->Pln());
+    const gp_Pnt &location = plane.Location();
+    key = plane.Distance(gp::Origin());
+    tolerance = Precision::Confusion() * (2.0 + location.Distance(gp::Origin()));
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedPlane::getType() const
 {
     return GeomAbs_Plane;
@@ -482,6 +564,17 @@ bool FaceTypedCylinder::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &f
     return true;
 }
 
+bool FaceTypedCylinder::getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const
+{
+    Handle(Geom_CylindricalSurface) cylinderSurface = getGeomCylinder(face);
+    if (cylinderSurface.IsNull())
+        return false;
+
+    key = cylinderSurface->Radius();
+    tolerance = Precision::Confusion();
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedCylinder::getType() const
 {
     return GeomAbs_Cylinder;
@@ -1049,6 +1142,10 @@ bool FaceUniter::process()
     for(typeIt = typeObjects.begin(); typeIt != typeObjects.end(); ++typeIt)
     {
         ModelRefine::FaceVectorType typedFaces = splitter.getTypedFaceVector((*typeIt)->getType());
+        // a face without a neighbour of the same type can't be united with another face
+        adjacencySplitter.removeIsolated(typedFaces);
+        if (typedFaces.size() < 2)
+            continue;
         ModelRefine::FaceEqualitySplitter equalitySplitter;
         equalitySplitter.split(typedFaces, *typeIt);
         for (std::size_t indexEquality(0); indexEquality < equalitySplitter.getGroupCount(); ++indexEquality)
@@ -1195,6 +1292,23 @@ Part::BRepBuilderAPI_RefineModel::BRepBuilderAPI_RefineModel(const TopoDS_Shape&
     Build();
 }
 
+namespace {
+// The shells of a shape don't share any faces and can be refined independently
+struct ShellUniter
+{
+    explicit ShellUniter(const TopoDS_Shell &shell) : uniter(shell), done(false) {}
+    ModelRefine::FaceUniter uniter;
+    bool done;
+};
+
+void processShells(std::vector<ShellUniter> &shells)
+{
+    Base::parallel_for(std::size_t(0), shells.size(), [&shells](std::size_t index) {
+        shells[index].done = shells[index].uniter.process();
+    }, std::size_t(1));
+}
+}
+
 void Part::BRepBuilderAPI_RefineModel::Build()
 {
     if (myShape.IsNull())
@@ -1203,11 +1317,16 @@ void Part::BRepBuilderAPI_RefineModel::Build()
     if (myShape.ShapeType() == TopAbs_SOLID) {
         const TopoDS_Solid &solid = TopoDS::Solid(myShape);
         BRepBuilderAPI_MakeSolid mkSolid;
+        std::vector<ShellUniter> shells;
         TopExp_Explorer it;
-        for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next()) {
+        for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next())
+            shells.emplace_back(TopoDS::Shell(it.Current()));
+        processShells(shells);
+        std::size_t index = 0;
+        for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next(), ++index) {
             const TopoDS_Shell &currentShell = TopoDS::Shell(it.Current());
-            ModelRefine::FaceUniter uniter(currentShell);
-            if (uniter.process()) {
+            ModelRefine::FaceUniter &uniter = shells[index].uniter;
+            if (shells[index].done) {
                 if (uniter.isModified()) {
                     const TopoDS_Shell &newShell = uniter.getShell();
                     mkSolid.Add(newShell);
@@ -1250,16 +1369,26 @@ void Part::BRepBuilderAPI_RefineModel::Build()
         TopoDS_Compound comp;
         builder.MakeCompound(comp);
 
-        TopExp_Explorer xp;
+        // refine the shells of all solids and the free shells at once
+        std::vector<ShellUniter> shells;
+        TopExp_Explorer xp, it;
+        for (xp.Init(myShape, TopAbs_SOLID); xp.More(); xp.Next()) {
+            for (it.Init(xp.Current(), TopAbs_SHELL); it.More(); it.Next())
+                shells.emplace_back(TopoDS::Shell(it.Current()));
+        }
+        for (xp.Init(myShape, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next())
+            shells.emplace_back(TopoDS::Shell(xp.Current()));
+        processShells(shells);
+
+        std::size_t index = 0;
         // solids
         for (xp.Init(myShape, TopAbs_SOLID); xp.More(); xp.Next()) {
             const TopoDS_Solid &solid = TopoDS::Solid(xp.Current());
             BRepTools_ReShape reshape;
-            TopExp_Explorer it;
-            for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next()) {
+            for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next(), ++index) {
                 const TopoDS_Shell &currentShell = TopoDS::Shell(it.Current());
-                ModelRefine::FaceUniter uniter(currentShell);
-                if (uniter.process()) {
+                ModelRefine::FaceUniter &uniter = shells[index].uniter;
+                if (shells[index].done) {
                     if (uniter.isModified()) {
                         const TopoDS_Shell &newShell = uniter.getShell();
                         reshape.Replace(currentShell, newShell);
@@ -1270,10 +1399,9 @@ void Part::BRepBuilderAPI_RefineModel::Build()
             builder.Add(comp, reshape.Apply(solid));
         }
         // free shells
-        for (xp.Init(myShape, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
-            const TopoDS_Shell& shell = TopoDS::Shell(xp.Current());
-            ModelRefine::FaceUniter uniter(shell);
-            if (uniter.process()) {
+        for (xp.Init(myShape, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next(), ++index) {
+            ModelRefine::FaceUniter &uniter = shells[index].uniter;
+            if (shells[index].done) {
                 builder.Add(comp, uniter.getShell());
                 LogModifications(uniter);
             }
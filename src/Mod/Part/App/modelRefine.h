@@ -61,6 +61,11 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const = 0;
         virtual GeomAbs_SurfaceType getType() const = 0;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const = 0;
+        /** Returns a value that differs by at most \a tolerance for faces that are equal
+         * according to isEqual(). It is used to only compare faces with close values.
+         * Types without such a value return false and all their faces are compared.
+         */
+        virtual bool getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const;
 
         static GeomAbs_SurfaceType getFaceType(const TopoDS_Face &faceIn);
 
@@ -77,6 +82,7 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const;
         virtual GeomAbs_SurfaceType getType() const;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const;
+        virtual bool getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const;
         friend FaceTypedPlane& getPlaneObject();
     };
     FaceTypedPlane& getPlaneObject();
@@ -89,6 +95,7 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const;
         virtual GeomAbs_SurfaceType getType() const;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const;
+        virtual bool getSortKey(const TopoDS_Face &face, double &key, double &tolerance) const;
         friend FaceTypedCylinder& getCylinderObject();
 
     protected:
@@ -128,6 +135,8 @@ namespace ModelRefine
     public:
         FaceAdjacencySplitter(const TopoDS_Shell &shell);
         void split(const FaceVectorType &facesIn);
+        /** Removes the faces that share no edge with another face of \a faces. */
+        void removeIsolated(FaceVectorType &faces) const;
         std::size_t getGroupCount() const {return adjacencyArray.size();}
         const FaceVectorType& getGroup(const std::size_t &index) const {return adjacencyArray[index];}
 
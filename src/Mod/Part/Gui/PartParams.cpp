@@ -0,0 +1,61 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#include <App/Application.h>
+#include "PartParams.h"
+
+using namespace PartGui;
+
+PartParams::PartParams() {
+    handle = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part");
+    handle->Attach(this);
+#undef FC_PART_PARAM
+#define FC_PART_PARAM(_name,_ctype,_type,_def) \
+    _name = handle->Get##_type(#_name,_def);
+
+    FC_PART_PARAMS
+}
+
+PartParams::~PartParams() {
+}
+
+void PartParams::OnChange(Base::Subject<const char*> &, const char* sReason) {
+    if(!sReason)
+        return;
+#undef FC_PART_PARAM
+#define FC_PART_PARAM(_name,_ctype,_type,_def) \
+    if(strcmp(sReason,#_name)==0) {\
+        _name = handle->Get##_type(#_name,_def);\
+        return;\
+    }
+    FC_PART_PARAMS
+}
+
+PartParams *PartParams::instance() {
+    static PartParams *inst;
+    if(!inst)
+        inst = new PartParams;
+    return inst;
+}
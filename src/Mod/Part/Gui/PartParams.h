@@ -0,0 +1,77 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef PARTGUI_PART_PARAMS_H
+#define PARTGUI_PART_PARAMS_H
+
+#include <Base/Parameter.h>
+
+namespace PartGui {
+
+/** Convenient class to obtain Part view provider related parameters
+ *
+ * The parameters are under group "User parameter:BaseApp/Preferences/Mod/Part".
+ * The values are cached and kept up to date through the parameter observer,
+ * so that reading them does not need a lookup in the parameter tree.
+ */
+class PartGuiExport PartParams: public ParameterGrp::ObserverType {
+public:
+    PartParams();
+    virtual ~PartParams();
+    void OnChange(Base::Subject<const char*> &, const char* sReason);
+    static PartParams *instance();
+
+    ParameterGrp::handle getHandle() {
+        return handle;
+    }
+
+#define FC_PART_PARAMS \
+    FC_PART_PARAM(MeshDeviation,double,Float,0.2) \
+    FC_PART_PARAM(MeshAngularDeflection,double,Float,28.65) \
+    FC_PART_PARAM(MinimumDeviation,double,Float,0.01) \
+    FC_PART_PARAM(NormalsFromUVNodes,bool,Bool,true) \
+    FC_PART_PARAM(TwoSideRendering,bool,Bool,true) \
+    FC_PART_PARAM(LevelOfDetail,bool,Bool,false) \
+    FC_PART_PARAM(BackgroundTessellation,bool,Bool,false) \
+
+#undef FC_PART_PARAM
+#define FC_PART_PARAM(_name,_ctype,_type,_def) \
+    _ctype get##_name() const { return _name; }\
+    void set##_name(_ctype _v) { handle->Set##_type(#_name,_v); _name=_v; }
+
+    FC_PART_PARAMS
+
+private:
+#undef FC_PART_PARAM
+#define FC_PART_PARAM(_name,_ctype,_type,_def) \
+    _ctype _name;
+
+    FC_PART_PARAMS
+    ParameterGrp::handle handle;
+};
+
+#undef FC_PART_PARAM
+
+} // namespace PartGui
+
+#endif // PARTGUI_PART_PARAMS_H
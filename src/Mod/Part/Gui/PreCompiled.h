@@ -211,6 +211,7 @@
 #include <Inventor/nodes/SoNurbsCurve.h>
 #include <Inventor/engines/SoCalculator.h>
 #include <Inventor/nodes/SoResetTransform.h>
+#include <Inventor/elements/SoMaterialBindingElement.h>
 #include <Inventor/elements/SoOverrideElement.h>
 #include <Inventor/elements/SoPointSizeElement.h>
 #include <Inventor/engines/SoConcatenate.h>
@@ -50,6 +50,8 @@
 # include <Inventor/elements/SoGLCoordinateElement.h>
 # include <Inventor/elements/SoGLCacheContextElement.h>
 # include <Inventor/elements/SoLineWidthElement.h>
+# include <Inventor/elements/SoMaterialBindingElement.h>
+# include <Inventor/elements/SoNormalElement.h>
 # include <Inventor/elements/SoPointSizeElement.h>
 # include <Inventor/errors/SoDebugError.h>
 # include <Inventor/errors/SoReadError.h>
@@ -60,6 +62,7 @@
 #endif
 
 #include "SoBrepEdgeSet.h"
+#include "SoBrepVertexBuffer.h"
 #include <Gui/SoFCUnifiedSelection.h>
 #include <Gui/SoFCSelectionAction.h>
 
@@ -80,13 +83,24 @@ SoBrepEdgeSet::SoBrepEdgeSet()
     : selContext(std::make_shared<SelContext>())
     , selContext2(std::make_shared<SelContext>())
     , packedColor(0)
+    , vbo(new SoBrepVertexBuffer)
+    , vboIndexCount(-1)
 {
     SO_NODE_CONSTRUCTOR(SoBrepEdgeSet);
 }
 
+SoBrepEdgeSet::~SoBrepEdgeSet()
+{
+}
+
 void SoBrepEdgeSet::GLRender(SoGLRenderAction *action)
 {
     auto state = action->getState();
+    if (Gui::SoFCSelectionRoot::isHidingLines()) {
+        // skipped while the camera is moving, don't let it end up in a render cache
+        SoCacheElement::invalidate(state);
+        return;
+    }
     selCounter.checkRenderCache(state);
 
     SelContextPtr ctx2;
@@ -146,7 +160,7 @@ void SoBrepEdgeSet::GLRender(SoGLRenderAction *action)
     }
     if(ctx2 && ctx2->selectionIndex.size())
         renderSelection(action,ctx2,false);
-    else
+    else if(!renderAllEdges(action))
         inherited::GLRender(action);
 
     // Workaround for #0000433
@@ -251,8 +265,10 @@ void SoBrepEdgeSet::renderHighlight(SoGLRenderAction *action, SelContextPtr ctx)
     SoMaterialBundle mb(action);
     mb.sendFirst(); // make sure we have the correct material
 
+    std::set<int> edges;
+    edges.insert(ctx->highlightIndex == INT_MAX ? -1 : ctx->highlightIndex);
     int num = (int)ctx->hl.size();
-    if (num > 0) {
+    if (num > 0 && !renderEdges(action, coords, edges)) {
         if (ctx->hl[0] < 0) {
             renderShape(static_cast<const SoGLCoordinateElement*>(coords), cindices, numcindices);
         }
@@ -297,7 +313,7 @@ void SoBrepEdgeSet::renderSelection(SoGLRenderAction *action, SelContextPtr ctx,
     mb.sendFirst(); // make sure we have the correct material
 
     int num = (int)ctx->sl.size();
-    if (num > 0) {
+    if (num > 0 && !renderEdges(action, coords, ctx->selectionIndex)) {
         if (ctx->sl[0] < 0) {
             renderShape(static_cast<const SoGLCoordinateElement*>(coords), cindices, numcindices);
         }
@@ -315,6 +331,95 @@ void SoBrepEdgeSet::renderSelection(SoGLRenderAction *action, SelContextPtr ctx,
     if(push) state->pop();
 }
 
+bool SoBrepEdgeSet::renderEdges(SoGLRenderAction *action, const SoCoordinateElement* coords,
+                                const std::set<int>& edges)
+{
+    if (edges.empty() || !SoBrepVertexBuffer::isAvailable(action))
+        return false;
+
+    const int32_t* cindices = this->coordIndex.getValues(0);
+    int numcindices = this->coordIndex.getNum();
+    if (vboIndexCount != numcindices) {
+        vbo->invalidate();
+        vboIndexCount = numcindices;
+    }
+
+    // convert the line strips into line segments and remember where each edge starts
+    bool ok = vbo->bind(action, coords->getNodeId(), coords->getArrayPtr3(), coords->getNum(),
+                        [&](std::vector<uint32_t>& index_array) {
+        edgeOffsets.clear();
+        edgeOffsets.push_back(0);
+        int32_t previ = -1;
+        for (int i=0; i<numcindices; i++) {
+            int32_t ci = cindices[i];
+            if (ci < 0) {
+                edgeOffsets.push_back(static_cast<int>(index_array.size()));
+                previ = -1;
+                continue;
+            }
+            if (previ >= 0) {
+                index_array.push_back(previ);
+                index_array.push_back(ci);
+            }
+            previ = ci;
+        }
+        if (numcindices > 0 && cindices[numcindices-1] >= 0)
+            edgeOffsets.push_back(static_cast<int>(index_array.size()));
+    });
+    if (!ok)
+        return false;
+
+    if (*edges.begin() < 0) {
+        vbo->drawElements(GL_LINES, 0, vbo->countIndices());
+    }
+    else {
+        // merge adjacent edges into one range, the edge indices are sorted
+        int numedges = static_cast<int>(edgeOffsets.size()) - 1;
+        int first = -1, last = -1;
+        for (int edge : edges) {
+            if (edge >= numedges)
+                break;
+            if (edge != last) {
+                if (first >= 0)
+                    vbo->drawElements(GL_LINES, edgeOffsets[first], edgeOffsets[last] - edgeOffsets[first]);
+                first = edge;
+            }
+            last = edge + 1;
+        }
+        if (first >= 0)
+            vbo->drawElements(GL_LINES, edgeOffsets[first], edgeOffsets[last] - edgeOffsets[first]);
+    }
+
+    vbo->release(action);
+    return true;
+}
+
+bool SoBrepEdgeSet::renderAllEdges(SoGLRenderAction *action)
+{
+    // Same as SoIndexedLineSet without normals and with an overall material
+    SoState * state = action->getState();
+    if (SoMaterialBindingElement::get(state) != SoMaterialBindingElement::OVERALL ||
+        SoNormalElement::getInstance(state)->getNum() > 0 ||
+        !SoBrepVertexBuffer::isAvailable(action))
+        return false;
+
+    if (!this->shouldGLRender(action))
+        return true;
+
+    state->push();
+    SoLazyElement::setLightModel(state, SoLazyElement::BASE_COLOR);
+
+    const SoCoordinateElement * coords = SoCoordinateElement::getInstance(state);
+    SoMaterialBundle mb(action);
+    mb.sendFirst();
+
+    std::set<int> edges;
+    edges.insert(-1);
+    bool ok = renderEdges(action, coords, edges);
+    state->pop();
+    return ok;
+}
+
 bool SoBrepEdgeSet::validIndexes(const SoCoordinateElement* coords, const std::vector<int32_t>& pts) const
 {
     for (std::vector<int32_t>::const_iterator it = pts.begin(); it != pts.end(); ++it) {
@@ -327,7 +432,10 @@ bool SoBrepEdgeSet::validIndexes(const SoCoordinateElement* coords, const std::v
 
 void SoBrepEdgeSet::doAction(SoAction* action)
 {
-    if (action->getTypeId() == Gui::SoHighlightElementAction::getClassTypeId()) {
+    if (action->getTypeId() == Gui::SoUpdateVBOAction::getClassTypeId()) {
+        vbo->invalidate();
+    }
+    else if (action->getTypeId() == Gui::SoHighlightElementAction::getClassTypeId()) {
         Gui::SoHighlightElementAction* hlaction = static_cast<Gui::SoHighlightElementAction*>(action);
         selCounter.checkAction(hlaction);
         if (!hlaction->isHighlighted()) {
@@ -31,6 +31,7 @@
 #include <Inventor/nodes/SoIndexedLineSet.h>
 #include <Inventor/elements/SoLazyElement.h>
 #include <Inventor/elements/SoReplacedElement.h>
+#include <set>
 #include <vector>
 #include <memory>
 #include <Gui/SoFCSelectionContext.h>
@@ -41,6 +42,8 @@ class SoTextureCoordinateBundle;
 
 namespace PartGui {
 
+class SoBrepVertexBuffer;
+
 class PartGuiExport SoBrepEdgeSet : public SoIndexedLineSet {
     typedef SoIndexedLineSet inherited;
 
@@ -51,7 +54,7 @@ public:
     SoBrepEdgeSet();
 
 protected:
-    virtual ~SoBrepEdgeSet() {};
+    virtual ~SoBrepEdgeSet();
     virtual void GLRender(SoGLRenderAction *action);
     virtual void GLRenderBelowPath(SoGLRenderAction * action);
     virtual void doAction(SoAction* action); 
@@ -72,12 +75,19 @@ private:
     void renderHighlight(SoGLRenderAction *action, SelContextPtr);
     void renderSelection(SoGLRenderAction *action, SelContextPtr, bool push=true);
     bool validIndexes(const SoCoordinateElement*, const std::vector<int32_t>&) const;
+    bool renderEdges(SoGLRenderAction *action, const SoCoordinateElement*, const std::set<int>& edges);
+    bool renderAllEdges(SoGLRenderAction *action);
 
 private:
     SelContextPtr selContext;
     SelContextPtr selContext2;
     Gui::SoFCSelectionCounter selCounter;
     uint32_t packedColor;
+
+    // The coordinates are kept in a vertex buffer, the edges are ranges of the index buffer
+    std::unique_ptr<SoBrepVertexBuffer> vbo;
+    std::vector<int> edgeOffsets;
+    int vboIndexCount;
 };
 
 } // namespace PartGui
@@ -137,6 +137,9 @@ public:
                 const int nbind,
                 const int mbind,
                 SbBool texture);
+    bool renderRanges(SoGLRenderAction * action,
+                      int num_vertexindices,
+                      const std::vector<std::pair<int,int> > &ranges);
 
     static void context_destruction_cb(uint32_t context, void * userdata)
     {
@@ -178,6 +181,7 @@ SoBrepFaceSet::SoBrepFaceSet()
     selContext = std::make_shared<SelContext>();
     selContext2 = std::make_shared<SelContext>();
     packedColor = 0;
+    detailIndexCount = 0;
 
     pimpl.reset(new VBO);
 }
@@ -186,6 +190,35 @@ SoBrepFaceSet::~SoBrepFaceSet()
 {
 }
 
+void SoBrepFaceSet::setDetailLevels(const SbBox3f& bbox, std::vector<DetailLevel>&& levels)
+{
+    detailBBox = bbox;
+    detailLevels = std::move(levels);
+    detailIndexCount = this->coordIndex.getNum();
+    touch();
+}
+
+const SoBrepFaceSet::DetailLevel* SoBrepFaceSet::findDetailLevel(SoState *state) const
+{
+    // the levels are outdated if the triangulation has been changed in the meantime
+    if (detailLevels.empty() || detailBBox.isEmpty() ||
+        detailIndexCount != this->coordIndex.getNum())
+        return nullptr;
+
+    SbVec2s size;
+    SoShape::getScreenSize(state, detailBBox, size);
+    short pixels = std::max(size[0], size[1]);
+
+    const DetailLevel* level = nullptr;
+    for (const auto& it : detailLevels) {
+        if (pixels > it.maxScreenSize)
+            break;
+        if (static_cast<int>(it.partIndex.size()) == this->partIndex.getNum())
+            level = &it;
+    }
+    return level;
+}
+
 void SoBrepFaceSet::doAction(SoAction* action)
 {
     if (action->getTypeId() == Gui::SoHighlightElementAction::getClassTypeId()) {
@@ -653,7 +686,26 @@ void SoBrepFaceSet::GLRender(SoGLRenderAction *action)
         pindices = this->partIndex.getValues(0);
         numparts = this->partIndex.getNum();
 
+        // Use a coarser triangulation if the shape is small on screen. This is only
+        // possible if normals and materials are bound to the vertexes or parts.
+        const DetailLevel* level = nullptr;
+        if (!detailLevels.empty() && !doTextures &&
+            nindices == cindices && mindices == cindices &&
+            (nbind == OVERALL || nbind == PER_VERTEX_INDEXED) &&
+            (mbind == OVERALL || mbind == PER_PART ||
+             mbind == PER_PART_INDEXED || mbind == PER_VERTEX_INDEXED)) {
+            level = findDetailLevel(state);
+        }
+
         SbBool hasVBO = !ctx2 && PRIVATE(this)->vboAvailable;
+        if (level) {
+            cindices = nindices = mindices = level->coordIndex.data();
+            numindices = static_cast<int>(level->coordIndex.size());
+            pindices = level->partIndex.data();
+            numparts = static_cast<int>(level->partIndex.size());
+            // the buffer objects hold the full triangulation
+            hasVBO = false;
+        }
         if (hasVBO) {
             // get the VBO status of the viewer
             Gui::SoGLVBOActivatedElement::get(state, hasVBO);
@@ -1260,6 +1312,15 @@ void SoBrepFaceSet::renderHighlight(SoGLRenderAction *action, SelContextPtr ctx)
         if (!nindices) nindices = cindices;
         pindices = this->partIndex.getValues(0);
 
+        std::set<int> ids;
+        ids.insert(id==INT_MAX ? -1 : id);
+        if (renderParts(action, ids, -1, numindices)) {
+            state->pop();
+            if (normalCacheUsed)
+                this->readUnlockNormalCache();
+            return;
+        }
+
         // coords
         int start=0;
         int length;
@@ -1349,6 +1410,15 @@ void SoBrepFaceSet::renderSelection(SoGLRenderAction *action, SelContextPtr ctx,
         doTextures = false;
     }
 
+    // With an overridden color the parts can be drawn directly from the buffer
+    // object, which saves sending all the selected triangles again.
+    if(push && renderParts(action, ctx->selectionIndex, ctx->highlightIndex, numindices)) {
+        state->pop();
+        if (normalCacheUsed)
+            this->readUnlockNormalCache();
+        return;
+    }
+
     for(auto id : ctx->selectionIndex) {
         if (id >= this->partIndex.getNum()) {
             SoDebugError::postWarning("SoBrepFaceSet::renderSelection", "selectionIndex out of range");
@@ -1394,6 +1464,95 @@ void SoBrepFaceSet::renderSelection(SoGLRenderAction *action, SelContextPtr ctx,
         this->readUnlockNormalCache();
 }
 
+bool SoBrepFaceSet::renderParts(SoGLRenderAction *action, const std::set<int> &ids,
+                                int exclude, int numindices)
+{
+    int numparts = this->partIndex.getNum();
+    if (!PRIVATE(this)->vboAvailable || ids.empty() || numparts <= 0)
+        return false;
+    // let the caller report any index out of range
+    if (*ids.rbegin() >= numparts)
+        return false;
+
+    SbBool hasVBO = true;
+    Gui::SoGLVBOActivatedElement::get(action->getState(), hasVBO);
+    if (!hasVBO)
+        return false;
+
+    // Merge the parts into consecutive ranges of triangles. The ids are
+    // sorted, so a single pass over the part index is enough.
+    const int32_t *pindices = this->partIndex.getValues(0);
+    std::vector<std::pair<int,int> > ranges;
+    if (*ids.begin() < 0) {
+        // select everything
+        int count = 0;
+        for (int i=0; i<numparts; i++)
+            count += pindices[i];
+        ranges.emplace_back(0, count);
+    }
+    else {
+        int part = 0;
+        int start = 0;
+        for (int id : ids) {
+            if (id == exclude)
+                continue;
+            for (; part < id; ++part)
+                start += pindices[part];
+            if (!ranges.empty() && ranges.back().first + ranges.back().second == start)
+                ranges.back().second += pindices[id];
+            else
+                ranges.emplace_back(start, pindices[id]);
+        }
+    }
+
+    return PRIVATE(this)->renderRanges(action, numindices, ranges);
+}
+
+bool SoBrepFaceSet::VBO::renderRanges(SoGLRenderAction * action,
+                                      int num_vertexindices,
+                                      const std::vector<std::pair<int,int> > &ranges)
+{
+    // Only use a buffer that has been loaded for the current triangulation
+    auto it = this->vbomap.find(action->getCacheContext());
+    if (it == this->vbomap.end())
+        return false;
+    const VBO::Buffer &buf = it->second;
+    if (!buf.vboLoaded || buf.updateVbo ||
+        buf.vertex_array_size != sizeof(float) * num_vertexindices * 10)
+        return false;
+
+#ifdef FC_OS_WIN32
+    const cc_glglue * glue = cc_glglue_instance(action->getCacheContext());
+    PFNGLBINDBUFFERARBPROC glBindBufferARB = (PFNGLBINDBUFFERARBPROC)cc_glglue_getprocaddress(glue, "glBindBufferARB");
+#endif
+
+    glBindBufferARB(GL_ARRAY_BUFFER_ARB, buf.myvbo[0]);
+    glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, buf.myvbo[1]);
+
+    // No color array, so that the current (selection) material is used
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+
+    glVertexPointer(3,GL_FLOAT,10*sizeof(GLfloat),0);
+    glNormalPointer(GL_FLOAT,10*sizeof(GLfloat),(GLvoid *)(3*sizeof(GLfloat)));
+
+    // the index array holds three indices per triangle
+    for (const auto &range : ranges) {
+        uint32_t first = range.first * 3;
+        if (first >= this->indice_array)
+            break;
+        uint32_t count = std::min<uint32_t>(range.second * 3, this->indice_array - first);
+        glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT,
+                       (GLvoid *)(first * sizeof(GLuint)));
+    }
+
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0);
+    glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
+    return true;
+}
+
 void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
                                 const SoGLCoordinateElement * const vertexlist,
                                 const int32_t *vertexindices,
@@ -31,6 +31,8 @@
 #include <Inventor/nodes/SoIndexedFaceSet.h>
 #include <Inventor/elements/SoLazyElement.h>
 #include <Inventor/elements/SoReplacedElement.h>
+#include <Inventor/SbBox3f.h>
+#include <set>
 #include <vector>
 #include <memory>
 #include <Gui/SoFCSelectionContext.h>
@@ -86,6 +88,20 @@ public:
 
     SoMFInt32 partIndex;
 
+    /// A coarser triangulation using the same coordinates and parts as coordIndex
+    struct DetailLevel {
+        std::vector<int32_t> coordIndex;
+        std::vector<int32_t> partIndex;
+        /// The level is rendered if the shape covers at most this number of pixels
+        short maxScreenSize;
+    };
+    /** Sets the coarser levels of detail for the current coordIndex and partIndex.
+     * \a bbox is the bounding box of the coordinates, the levels are expected to
+     * be ordered from fine to coarse. Selection and highlighting always use the
+     * full triangulation.
+     */
+    void setDetailLevels(const SbBox3f& bbox, std::vector<DetailLevel>&& levels);
+
 protected:
     virtual ~SoBrepFaceSet();
     virtual void GLRender(SoGLRenderAction *action);
@@ -135,8 +151,11 @@ private:
 
     void renderHighlight(SoGLRenderAction *action, SelContextPtr);
     void renderSelection(SoGLRenderAction *action, SelContextPtr, bool push=true);
+    bool renderParts(SoGLRenderAction *action, const std::set<int> &ids,
+                     int exclude, int numindices);
 
     bool overrideMaterialBinding(SoGLRenderAction *action, SelContextPtr ctx, SelContextPtr ctx2);
+    const DetailLevel* findDetailLevel(SoState *state) const;
 
 #ifdef RENDER_GLARRAYS
     void renderSimpleArray();
@@ -155,6 +174,10 @@ private:
     uint32_t packedColor;
     Gui::SoFCSelectionCounter selCounter;
 
+    std::vector<DetailLevel> detailLevels;
+    SbBox3f detailBBox;
+    int detailIndexCount;
+
     // Define some VBO pointer for the current mesh
     class VBO;
     std::unique_ptr<VBO> pimpl;
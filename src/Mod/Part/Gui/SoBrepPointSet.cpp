@@ -50,15 +50,19 @@
 # include <Inventor/elements/SoGLCoordinateElement.h>
 # include <Inventor/elements/SoGLCacheContextElement.h>
 # include <Inventor/elements/SoLineWidthElement.h>
+# include <Inventor/elements/SoMaterialBindingElement.h>
+# include <Inventor/elements/SoNormalElement.h>
 # include <Inventor/elements/SoPointSizeElement.h>
 # include <Inventor/errors/SoDebugError.h>
 # include <Inventor/errors/SoReadError.h>
 # include <Inventor/details/SoFaceDetail.h>
 # include <Inventor/details/SoLineDetail.h>
 # include <Inventor/misc/SoState.h>
+# include <Inventor/elements/SoCacheElement.h>
 #endif
 
 #include "SoBrepPointSet.h"
+#include "SoBrepVertexBuffer.h"
 #include <Gui/SoFCUnifiedSelection.h>
 #include <Gui/SoFCSelectionAction.h>
 
@@ -75,13 +79,23 @@ SoBrepPointSet::SoBrepPointSet()
     : selContext(std::make_shared<SelContext>())
     , selContext2(std::make_shared<SelContext>())
     , packedColor(0)
+    , vbo(new SoBrepVertexBuffer)
 {
     SO_NODE_CONSTRUCTOR(SoBrepPointSet);
 }
 
+SoBrepPointSet::~SoBrepPointSet()
+{
+}
+
 void SoBrepPointSet::GLRender(SoGLRenderAction *action)
 {
     auto state = action->getState();
+    if (Gui::SoFCSelectionRoot::isHidingLines()) {
+        // skipped while the camera is moving, don't let it end up in a render cache
+        SoCacheElement::invalidate(state);
+        return;
+    }
     selCounter.checkRenderCache(state);
 
     const SoCoordinateElement* coords = SoCoordinateElement::getInstance(state);
@@ -136,7 +150,7 @@ void SoBrepPointSet::GLRender(SoGLRenderAction *action)
     }
     if(ctx2 && ctx2->selectionIndex.size())
         renderSelection(action,ctx2,false);
-    else
+    else if(!renderAllPoints(action))
         inherited::GLRender(action);
 
     // Workaround for #0000433
@@ -205,8 +219,10 @@ void SoBrepPointSet::renderHighlight(SoGLRenderAction *action, SelContextPtr ctx
     mb.sendFirst(); // make sure we have the correct material
 
     int id = ctx->highlightIndex;
+    std::set<int> points;
+    points.insert(id == INT_MAX ? -1 : id);
     const SbVec3f * coords3d = coords->getArrayPtr3();
-    if(coords3d) {
+    if(coords3d && !renderPoints(action, coords, points)) {
         if(id == INT_MAX) {
             glBegin(GL_POINTS);
             for(int idx=startIndex.getValue();idx<coords->getNum();++idx)
@@ -248,7 +264,7 @@ void SoBrepPointSet::renderSelection(SoGLRenderAction *action, SelContextPtr ctx
     bool warn = false;
     int startIndex = this->startIndex.getValue();
     const SbVec3f * coords3d = coords->getArrayPtr3();
-    if(coords3d) {
+    if(coords3d && !renderPoints(action, coords, ctx->selectionIndex)) {
         glBegin(GL_POINTS);
         if(ctx->isSelectAll()) {
             for(int idx=startIndex;idx<coords->getNum();++idx)
@@ -268,9 +284,76 @@ void SoBrepPointSet::renderSelection(SoGLRenderAction *action, SelContextPtr ctx
     if(push) state->pop();
 }
 
+bool SoBrepPointSet::renderPoints(SoGLRenderAction *action, const SoCoordinateElement* coords,
+                                  const std::set<int>& points)
+{
+    if (points.empty() || !SoBrepVertexBuffer::isAvailable(action))
+        return false;
+
+    // let the caller report any index out of range
+    int startIndex = this->startIndex.getValue();
+    int numverts = coords->getNum();
+    if (*points.begin() >= 0 && (*points.begin() < startIndex || *points.rbegin() >= numverts))
+        return false;
+
+    if (!vbo->bind(action, coords->getNodeId(), coords->getArrayPtr3(), numverts))
+        return false;
+
+    if (*points.begin() < 0) {
+        vbo->drawArrays(GL_POINTS, startIndex, numverts - startIndex);
+    }
+    else {
+        // merge adjacent points into one range, the indices are sorted
+        int first = -1, last = -1;
+        for (int idx : points) {
+            if (idx != last) {
+                if (first >= 0)
+                    vbo->drawArrays(GL_POINTS, first, last - first);
+                first = idx;
+            }
+            last = idx + 1;
+        }
+        if (first >= 0)
+            vbo->drawArrays(GL_POINTS, first, last - first);
+    }
+
+    vbo->release(action);
+    return true;
+}
+
+bool SoBrepPointSet::renderAllPoints(SoGLRenderAction *action)
+{
+    // Same as SoPointSet without normals and with an overall material
+    SoState * state = action->getState();
+    if (this->numPoints.getValue() >= 0 ||
+        SoMaterialBindingElement::get(state) != SoMaterialBindingElement::OVERALL ||
+        SoNormalElement::getInstance(state)->getNum() > 0 ||
+        !SoBrepVertexBuffer::isAvailable(action))
+        return false;
+
+    if (!this->shouldGLRender(action))
+        return true;
+
+    state->push();
+    SoLazyElement::setLightModel(state, SoLazyElement::BASE_COLOR);
+
+    const SoCoordinateElement * coords = SoCoordinateElement::getInstance(state);
+    SoMaterialBundle mb(action);
+    mb.sendFirst();
+
+    std::set<int> points;
+    points.insert(-1);
+    bool ok = renderPoints(action, coords, points);
+    state->pop();
+    return ok;
+}
+
 void SoBrepPointSet::doAction(SoAction* action)
 {
-    if (action->getTypeId() == Gui::SoHighlightElementAction::getClassTypeId()) {
+    if (action->getTypeId() == Gui::SoUpdateVBOAction::getClassTypeId()) {
+        vbo->invalidate();
+    }
+    else if (action->getTypeId() == Gui::SoHighlightElementAction::getClassTypeId()) {
         Gui::SoHighlightElementAction* hlaction = static_cast<Gui::SoHighlightElementAction*>(action);
         selCounter.checkAction(hlaction);
         if (!hlaction->isHighlighted()) {
@@ -31,6 +31,7 @@
 #include <Inventor/nodes/SoPointSet.h>
 #include <Inventor/elements/SoLazyElement.h>
 #include <Inventor/elements/SoReplacedElement.h>
+#include <set>
 #include <vector>
 #include <memory>
 #include <Gui/SoFCSelectionContext.h>
@@ -41,6 +42,8 @@ class SoTextureCoordinateBundle;
 
 namespace PartGui {
 
+class SoBrepVertexBuffer;
+
 class PartGuiExport SoBrepPointSet : public SoPointSet {
     typedef SoPointSet inherited;
 
@@ -51,7 +54,7 @@ public:
     SoBrepPointSet();
 
 protected:
-    virtual ~SoBrepPointSet() {};
+    virtual ~SoBrepPointSet();
     virtual void GLRender(SoGLRenderAction *action);
     virtual void GLRenderBelowPath(SoGLRenderAction * action);
     virtual void doAction(SoAction* action); 
@@ -63,12 +66,17 @@ private:
     typedef Gui::SoFCSelectionContextPtr SelContextPtr;
     void renderHighlight(SoGLRenderAction *action, SelContextPtr);
     void renderSelection(SoGLRenderAction *action, SelContextPtr, bool push=true);
+    bool renderPoints(SoGLRenderAction *action, const SoCoordinateElement*, const std::set<int>& points);
+    bool renderAllPoints(SoGLRenderAction *action);
 
 private:
     SelContextPtr selContext;
     SelContextPtr selContext2;
     Gui::SoFCSelectionCounter selCounter;
     uint32_t packedColor;
+
+    // The coordinates are kept in a vertex buffer, the points are ranges of it
+    std::unique_ptr<SoBrepVertexBuffer> vbo;
 };
 
 } // namespace PartGui
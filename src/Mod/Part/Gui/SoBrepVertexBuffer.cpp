@@ -0,0 +1,189 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <Inventor/SbVec3f.h>
+# include <Inventor/actions/SoGLRenderAction.h>
+# include <Inventor/elements/SoGLCacheContextElement.h>
+# include <Inventor/misc/SoContextHandler.h>
+# ifdef FC_OS_WIN32
+#  include <windows.h>
+#  include <GL/gl.h>
+#  include <GL/glext.h>
+# else
+#  ifdef FC_OS_MACOSX
+#   include <OpenGL/gl.h>
+#   include <OpenGL/glext.h>
+#  else
+#   include <GL/gl.h>
+#   include <GL/glext.h>
+#  endif //FC_OS_MACOSX
+# endif //FC_OS_WIN32
+// Should come after glext.h to avoid warnings
+# include <Inventor/C/glue/gl.h>
+#endif
+
+#include "SoBrepVertexBuffer.h"
+#include <Gui/SoFCInteractiveElement.h>
+
+using namespace PartGui;
+
+SoBrepVertexBuffer::SoBrepVertexBuffer()
+  : numcoords(0)
+  , numindices(0)
+{
+    SoContextHandler::addContextDestructionCallback(context_destruction_cb, this);
+}
+
+SoBrepVertexBuffer::~SoBrepVertexBuffer()
+{
+    SoContextHandler::removeContextDestructionCallback(context_destruction_cb, this);
+
+    // schedule delete for all allocated GL resources
+    std::map<uint32_t, Buffer>::iterator it;
+    for (it = vbomap.begin(); it != vbomap.end(); ++it) {
+        void * ptr0 = (void*) ((uintptr_t) it->second.myvbo[0]);
+        SoGLCacheContextElement::scheduleDeleteCallback(it->first, vbo_delete, ptr0);
+        void * ptr1 = (void*) ((uintptr_t) it->second.myvbo[1]);
+        SoGLCacheContextElement::scheduleDeleteCallback(it->first, vbo_delete, ptr1);
+    }
+}
+
+void SoBrepVertexBuffer::context_destruction_cb(uint32_t context, void * userdata)
+{
+    SoBrepVertexBuffer * self = static_cast<SoBrepVertexBuffer*>(userdata);
+
+    std::map<uint32_t, Buffer>::iterator it = self->vbomap.find(context);
+    if (it != self->vbomap.end()) {
+        const cc_glglue * glue = cc_glglue_instance((int) context);
+        cc_glglue_glDeleteBuffers(glue, 2, it->second.myvbo);
+        self->vbomap.erase(it);
+    }
+}
+
+void SoBrepVertexBuffer::vbo_delete(void * closure, uint32_t contextid)
+{
+    const cc_glglue * glue = cc_glglue_instance((int) contextid);
+    GLuint id = (GLuint) ((uintptr_t) closure);
+    cc_glglue_glDeleteBuffers(glue, 1, &id);
+}
+
+bool SoBrepVertexBuffer::isAvailable(SoGLRenderAction *action)
+{
+    const cc_glglue * glue = cc_glglue_instance(action->getCacheContext());
+    if (!cc_glglue_has_vertex_buffer_object(glue))
+        return false;
+
+    // get the VBO status of the viewer
+    SbBool hasVBO = true;
+    Gui::SoGLVBOActivatedElement::get(action->getState(), hasVBO);
+    return hasVBO ? true : false;
+}
+
+void SoBrepVertexBuffer::invalidate()
+{
+    for (auto &v : vbomap)
+        v.second.vboLoaded = false;
+}
+
+bool SoBrepVertexBuffer::bind(SoGLRenderAction *action, SbUniqueId key,
+                              const SbVec3f *coords, int numcoords, const IndexFunc &indices)
+{
+    if (!coords || numcoords <= 0)
+        return false;
+
+    uint32_t contextId = action->getCacheContext();
+    const cc_glglue * glue = cc_glglue_instance(contextId);
+    auto res = this->vbomap.insert(std::make_pair(contextId, Buffer()));
+    Buffer &buf = res.first->second;
+    if (res.second) {
+        cc_glglue_glGenBuffers(glue, 2, buf.myvbo);
+        buf.key = 0;
+        buf.numcoords = 0;
+        buf.numindices = 0;
+        buf.vboLoaded = false;
+    }
+
+    if (!buf.vboLoaded || buf.key != key || buf.numcoords != numcoords) {
+        std::vector<uint32_t> index_array;
+        if (indices)
+            indices(index_array);
+        for (std::vector<uint32_t>::iterator it = index_array.begin(); it != index_array.end(); ++it) {
+            if (*it >= static_cast<uint32_t>(numcoords)) {
+                buf.vboLoaded = false;
+                return false;
+            }
+        }
+
+        cc_glglue_glBindBuffer(glue, GL_ARRAY_BUFFER_ARB, buf.myvbo[0]);
+        cc_glglue_glBufferData(glue, GL_ARRAY_BUFFER_ARB, sizeof(SbVec3f) * numcoords,
+                               coords, GL_STATIC_DRAW_ARB);
+        cc_glglue_glBindBuffer(glue, GL_ELEMENT_ARRAY_BUFFER_ARB, buf.myvbo[1]);
+        cc_glglue_glBufferData(glue, GL_ELEMENT_ARRAY_BUFFER_ARB, sizeof(GLuint) * index_array.size(),
+                               index_array.empty() ? 0 : &index_array[0], GL_STATIC_DRAW_ARB);
+
+        buf.key = key;
+        buf.numcoords = numcoords;
+        buf.numindices = static_cast<int>(index_array.size());
+        buf.vboLoaded = true;
+    }
+    else {
+        cc_glglue_glBindBuffer(glue, GL_ARRAY_BUFFER_ARB, buf.myvbo[0]);
+        cc_glglue_glBindBuffer(glue, GL_ELEMENT_ARRAY_BUFFER_ARB, buf.myvbo[1]);
+    }
+
+    this->numcoords = buf.numcoords;
+    this->numindices = buf.numindices;
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, 0);
+    return true;
+}
+
+void SoBrepVertexBuffer::drawArrays(unsigned int mode, int first, int count) const
+{
+    if (first < 0 || first >= this->numcoords || count <= 0)
+        return;
+    count = std::min(count, this->numcoords - first);
+    glDrawArrays(mode, first, count);
+}
+
+void SoBrepVertexBuffer::drawElements(unsigned int mode, int first, int count) const
+{
+    if (first < 0 || first >= this->numindices || count <= 0)
+        return;
+    count = std::min(count, this->numindices - first);
+    glDrawElements(mode, count, GL_UNSIGNED_INT, (GLvoid *)(first * sizeof(GLuint)));
+}
+
+void SoBrepVertexBuffer::release(SoGLRenderAction *action) const
+{
+    const cc_glglue * glue = cc_glglue_instance(action->getCacheContext());
+    glDisableClientState(GL_VERTEX_ARRAY);
+    cc_glglue_glBindBuffer(glue, GL_ARRAY_BUFFER_ARB, 0);
+    cc_glglue_glBindBuffer(glue, GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
+}
@@ -0,0 +1,105 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef PARTGUI_SOBREPVERTEXBUFFER_H
+#define PARTGUI_SOBREPVERTEXBUFFER_H
+
+#include <Inventor/elements/SoReplacedElement.h>
+#include <functional>
+#include <map>
+#include <vector>
+
+class SbVec3f;
+class SoGLRenderAction;
+
+namespace PartGui {
+
+/**
+ * Keeps the coordinates of a shape node and an optional index array in vertex
+ * buffer objects, one pair of buffers per GL context. The buffers are only
+ * uploaded again after invalidate() was called or the key passed to bind()
+ * changes, e.g. because the coordinate node was modified.
+ * Parts of the shape like the highlighted or selected elements are rendered
+ * as sub-ranges of the same buffers.
+ */
+class SoBrepVertexBuffer
+{
+public:
+    typedef std::function<void(std::vector<uint32_t>&)> IndexFunc;
+
+    SoBrepVertexBuffer();
+    ~SoBrepVertexBuffer();
+
+    /// Checks whether vertex buffer objects can be used for the current render action
+    static bool isAvailable(SoGLRenderAction *action);
+
+    /// Forces the buffers of all contexts to be uploaded again
+    void invalidate();
+    /**
+     * Binds the buffers of the current context and uploads \a coords if the buffers
+     * are not loaded for \a key. If \a indices is set it's called to fill the index
+     * array. Returns false if the buffers can't be used.
+     */
+    bool bind(SoGLRenderAction *action, SbUniqueId key,
+              const SbVec3f *coords, int numcoords, const IndexFunc &indices = IndexFunc());
+    /// Renders \a count vertices starting at \a first of the coordinate buffer
+    void drawArrays(unsigned int mode, int first, int count) const;
+    /// Renders \a count indices starting at \a first of the index buffer
+    void drawElements(unsigned int mode, int first, int count) const;
+    /// Unbinds the buffers
+    void release(SoGLRenderAction *action) const;
+
+    /// Number of coordinates of the bound buffer
+    int countCoords() const {
+        return numcoords;
+    }
+    /// Number of indices of the bound buffer
+    int countIndices() const {
+        return numindices;
+    }
+
+private:
+    struct Buffer {
+        uint32_t myvbo[2];
+        SbUniqueId key;
+        int numcoords;
+        int numindices;
+        bool vboLoaded;
+    };
+
+    static void context_destruction_cb(uint32_t context, void * userdata);
+    static void vbo_delete(void * closure, uint32_t contextid);
+
+private:
+    std::map<uint32_t, Buffer> vbomap;
+    int numcoords;
+    int numindices;
+
+    SoBrepVertexBuffer(const SoBrepVertexBuffer&);
+    void operator= (const SoBrepVertexBuffer&);
+};
+
+} // namespace PartGui
+
+
+#endif // PARTGUI_SOBREPVERTEXBUFFER_H
@@ -452,7 +452,11 @@ void TaskCheckGeometryResults::goCheck()
 
         buildShapeContent(baseName, shape);
 
+#if OCC_VERSION_HEX >= 0x070600
+        BRepCheck_Analyzer shapeCheck(shape, Standard_True, Standard_True);
+#else
         BRepCheck_Analyzer shapeCheck(shape);
+#endif
         if (!shapeCheck.IsValid())
         {
             invalidShapes++;
@@ -95,19 +95,32 @@
 # include <Inventor/nodes/SoLightModel.h>
 # include <QAction>
 # include <QMenu>
+# include <QFutureWatcher>
+# include <QtConcurrentRun>
+# include <QTimer>
+# include <Inventor/nodes/SoCamera.h>
 #endif
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+
 #include <boost/algorithm/string/predicate.hpp>
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include <Base/Console.h>
 #include <Base/Parameter.h>
 #include <Base/Exception.h>
+#include <Base/Profiler.h>
 #include <Base/TimeInfo.h>
 
 #include <App/Application.h>
 #include <App/Document.h>
 
+#include <Gui/Application.h>
+#include <Gui/Document.h>
+#include <Gui/View3DInventor.h>
 #include <Gui/SoFCUnifiedSelection.h>
 #include <Gui/SoFCSelectionAction.h>
 #include <Gui/Selection.h>
@@ -118,6 +131,7 @@
 
 #include <Gui/ViewParams.h>
 #include "ViewProviderExt.h"
+#include "PartParams.h"
 #include "SoBrepPointSet.h"
 #include "SoBrepEdgeSet.h"
 #include "SoBrepFaceSet.h"
@@ -221,6 +235,146 @@ void ViewProviderPartExt::getNormals(const TopoDS_Face&  theFace,
     }
 }
 
+namespace {
+
+// Serializes the tessellation of the same shape by several threads because
+// the triangulation is stored on the shared TopoDS_TShape
+class ShapeMeshLock
+{
+public:
+    explicit ShapeMeshLock(const TopoDS_Shape& shape)
+        : tshape(shape.TShape().get())
+    {
+        std::unique_lock<std::mutex> lock(mutex());
+        cond().wait(lock, [this]() { return busy().count(tshape) == 0; });
+        busy().insert(tshape);
+    }
+    ~ShapeMeshLock()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex());
+            busy().erase(tshape);
+        }
+        cond().notify_all();
+    }
+
+private:
+    static std::mutex& mutex() {
+        static std::mutex m;
+        return m;
+    }
+    static std::condition_variable& cond() {
+        static std::condition_variable c;
+        return c;
+    }
+    static std::set<const void*>& busy() {
+        static std::set<const void*> s;
+        return s;
+    }
+
+private:
+    const void* tshape;
+};
+
+// Simplifies the triangulation by clustering its vertexes in a grid of the given
+// resolution. The vertex of a cluster is one of the original ones, so that the
+// coordinates and normals can be shared with the full triangulation.
+void makeDetailLevel(const std::vector<SbVec3f>& verts, const SbBox3f& bbox, int resolution,
+                     const std::vector<int32_t>& index, const std::vector<int32_t>& parts,
+                     SoBrepFaceSet::DetailLevel& level)
+{
+    float dx, dy, dz;
+    bbox.getSize(dx, dy, dz);
+    float cell = std::max(std::max(dx, dy), dz) / resolution;
+    if (cell <= 0.0f)
+        return;
+
+    const SbVec3f& bmin = bbox.getMin();
+    const int64_t res = resolution + 1;
+    std::unordered_map<int64_t, int32_t> clusters;
+    std::vector<int32_t> vertexMap(verts.size(), -1);
+    auto mapVertex = [&](int32_t v) {
+        int32_t& m = vertexMap[v];
+        if (m < 0) {
+            SbVec3f p = (verts[v] - bmin) / cell;
+            int64_t key = (static_cast<int64_t>(p[0]) * res + static_cast<int64_t>(p[1])) * res
+                        + static_cast<int64_t>(p[2]);
+            m = clusters.emplace(key, v).first->second;
+        }
+        return m;
+    };
+
+    level.coordIndex.clear();
+    level.partIndex.clear();
+    level.partIndex.reserve(parts.size());
+
+    std::size_t tria = 0;
+    for (int32_t count : parts) {
+        int32_t kept = 0;
+        for (int32_t i = 0; i < count && tria*4+3 < index.size(); ++i, ++tria) {
+            int32_t v1 = mapVertex(index[tria*4]);
+            int32_t v2 = mapVertex(index[tria*4+1]);
+            int32_t v3 = mapVertex(index[tria*4+2]);
+            if (v1 == v2 || v2 == v3 || v3 == v1)
+                continue;
+            level.coordIndex.push_back(v1);
+            level.coordIndex.push_back(v2);
+            level.coordIndex.push_back(v3);
+            level.coordIndex.push_back(SO_END_FACE_INDEX);
+            ++kept;
+        }
+        level.partIndex.push_back(kept);
+    }
+}
+
+}
+
+struct ViewProviderPartExt::TessellationData
+{
+    // input
+    TopoDS_Shape shape;
+    double deviation = 0.5;
+    double angularDeflection = 28.65;
+    bool normalsFromUV = true;
+
+    // output
+    std::vector<SbVec3f> verts;
+    std::vector<SbVec3f> norms;
+    std::vector<int32_t> index;
+    std::vector<int32_t> parts;
+    std::vector<int32_t> lines;
+    int nodeStart = 0;
+    bool failed = false;
+
+    // coarser triangulations for rendering at small screen sizes
+    bool levelOfDetail = false;
+    SbBox3f bbox;
+    std::vector<SoBrepFaceSet::DetailLevel> levels;
+
+    // progress in per mille and cancel request
+    std::atomic<int> progress{0};
+    std::atomic<bool> canceled{false};
+};
+
+class ViewProviderPartExt::TessellationJob
+{
+public:
+    TessellationJob(const std::shared_ptr<TessellationData>& data)
+        : data(data), watcher(new QFutureWatcher<void>())
+    {
+    }
+    ~TessellationJob()
+    {
+        // the job may be released while the watcher emits its signal
+        data->canceled = true;
+        watcher->disconnect();
+        watcher->deleteLater();
+    }
+
+    std::shared_ptr<TessellationData> data;
+    QFutureWatcher<void>* watcher;
+};
+
 //**************************************************************************
 // Construction/Destruction
 
@@ -229,6 +383,7 @@ App::PropertyFloatConstraint::Constraints ViewProviderPartExt::tessRange = {0.01
 App::PropertyQuantityConstraint::Constraints ViewProviderPartExt::angDeflectionRange = {1.0,180.0,0.05};
 const char* ViewProviderPartExt::LightingEnums[]= {"One side","Two side",NULL};
 const char* ViewProviderPartExt::DrawStyleEnums[]= {"Solid","Dashed","Dotted","Dashdot",NULL};
+std::vector<ViewProviderPartExt*> ViewProviderPartExt::pendingTessellations;
 
 ViewProviderPartExt::ViewProviderPartExt() 
 {
@@ -242,15 +397,14 @@ ViewProviderPartExt::ViewProviderPartExt()
     int lwidth = Gui::ViewParams::instance()->getDefaultShapeLineWidth();
     int psize = Gui::ViewParams::instance()->getDefaultShapePointSize();
 
-    ParameterGrp::handle hPart = App::GetApplication().GetParameterGroupByPath
-        ("User parameter:BaseApp/Preferences/Mod/Part");
-    NormalsFromUV = hPart->GetBool("NormalsFromUVNodes", NormalsFromUV);
+    PartParams *params = PartParams::instance();
+    NormalsFromUV = params->getNormalsFromUVNodes();
 
-    long twoside = hPart->GetBool("TwoSideRendering", true) ? 1 : 0;
+    long twoside = params->getTwoSideRendering() ? 1 : 0;
 
     // Let the user define a custom lower limit but a value less than
     // OCCT's epsilon is not allowed
-    double lowerLimit = hPart->GetFloat("MinimumDeviation", tessRange.LowerBound);
+    double lowerLimit = params->getMinimumDeviation();
     lowerLimit = std::max(lowerLimit, Precision::Confusion());
     tessRange.LowerBound = lowerLimit;
 
@@ -340,6 +494,7 @@ ViewProviderPartExt::ViewProviderPartExt()
 
 ViewProviderPartExt::~ViewProviderPartExt()
 {
+    cancelTessellation();
     pcFaceBind->unref();
     pcLineBind->unref();
     pcPointBind->unref();
@@ -472,6 +627,9 @@ void ViewProviderPartExt::onChanged(const App::Property* prop)
         // if the object was invisible and has been changed, recreate the visual
         if (prop == &Visibility && (isUpdateForced() || Visibility.getValue()) && VisualTouched) {
             updateVisual();
+            auto feature = dynamic_cast<Part::Feature*>(getObject());
+            if (feature)
+                ViewProviderGeometryObject::updateData(&feature->Shape);
             // The material has to be checked again (#0001736)
             onChanged(&DiffuseColor);
         }
@@ -912,11 +1070,10 @@ void ViewProviderPartExt::unsetHighlightedPoints()
 bool ViewProviderPartExt::loadParameter()
 {
     bool changed = false;
-    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
-        ("User parameter:BaseApp/Preferences/Mod/Part");
-    float deviation = hGrp->GetFloat("MeshDeviation",0.2);
-    float angularDeflection = hGrp->GetFloat("MeshAngularDeflection",28.65);
-    NormalsFromUV = hGrp->GetBool("NormalsFromUVNodes", NormalsFromUV);
+    PartParams *params = PartParams::instance();
+    float deviation = params->getMeshDeviation();
+    float angularDeflection = params->getMeshAngularDeflection();
+    NormalsFromUV = params->getNormalsFromUVNodes();
 
     if (Deviation.getValue() != deviation) {
         Deviation.setValue(deviation);
@@ -937,6 +1094,18 @@ void ViewProviderPartExt::reload()
 
 void ViewProviderPartExt::updateData(const App::Property* prop)
 {
+    // Keep the lazily restored shape of a hidden object in the document file.
+    // The bounding box is updated once the object is shown, see onChanged().
+    if (!isUpdateForced() && !Visibility.getValue()) {
+        auto feature = dynamic_cast<Part::Feature*>(getObject());
+        if (feature && feature->Shape.isLazyPending()
+                && (prop == &feature->Shape || prop == &feature->Placement)) {
+            VisualTouched = true;
+            Gui::ViewProviderDragger::updateData(prop);
+            return;
+        }
+    }
+
     const char *propName = prop->getName();
     if (propName && (strcmp(propName, "Shape") == 0 || strstr(propName, "Touched") != nullptr)) {
         // calculate the visual only if visible
@@ -999,9 +1168,169 @@ void ViewProviderPartExt::unsetEdit(int ModNum)
 }
 
 void ViewProviderPartExt::updateVisual()
+{
+    FC_PROFILE_ZONE_DETAIL("ViewProviderPartExt::updateVisual",
+                           getObject() ? getObject()->getNameInDocument() : nullptr);
+    TopoDS_Shape cShape = Part::Feature::getShape(getObject());
+    if (cShape.IsNull()) {
+        cancelTessellation();
+        clearVisual();
+        coords  ->point      .setNum(0);
+        norm    ->vector     .setNum(0);
+        faceset ->coordIndex .setNum(0);
+        faceset ->partIndex  .setNum(0);
+        lineset ->coordIndex .setNum(0);
+        nodeset ->startIndex .setValue(0);
+        faceset ->setDetailLevels(SbBox3f(), std::vector<SoBrepFaceSet::DetailLevel>());
+        VisualTouched = false;
+        return;
+    }
+
+    auto data = std::make_shared<TessellationData>();
+    data->shape = cShape;
+    data->deviation = Deviation.getValue();
+    data->angularDeflection = AngularDeflection.getValue();
+    data->normalsFromUV = NormalsFromUV;
+
+    data->levelOfDetail = PartParams::instance()->getLevelOfDetail();
+
+    // A forced update expects the new representation to be available on return
+    if (!isUpdateForced() && PartParams::instance()->getBackgroundTessellation()) {
+        // The old representation stays until the new one is complete
+        cancelTessellation();
+        tessJob.reset(new TessellationJob(data));
+        App::Document* doc = getObject() ? getObject()->getDocument() : nullptr;
+        if (doc && doc->testStatus(App::Document::Restoring)) {
+            // Wait until all objects are known to decide on the order
+            if (pendingTessellations.empty())
+                QTimer::singleShot(0, &ViewProviderPartExt::startPendingTessellations);
+            pendingTessellations.push_back(this);
+        }
+        else {
+            startTessellation();
+        }
+        VisualTouched = false;
+        return;
+    }
+
+    cancelTessellation();
+    tessellate(*data);
+    applyVisual(*data);
+    VisualTouched = false;
+}
+
+void ViewProviderPartExt::cancelTessellation()
+{
+    auto it = std::find(pendingTessellations.begin(), pendingTessellations.end(), this);
+    if (it != pendingTessellations.end())
+        pendingTessellations.erase(it);
+    tessJob.reset();
+}
+
+void ViewProviderPartExt::startTessellation()
+{
+    std::shared_ptr<TessellationData> data = tessJob->data;
+    QFutureWatcher<void>* watcher = tessJob->watcher;
+    QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, [this]() {
+        finishTessellation();
+    });
+    watcher->setFuture(QtConcurrent::run([data]() {
+        tessellate(*data);
+    }));
+}
+
+void ViewProviderPartExt::startPendingTessellations()
+{
+    // The event loop may run while documents are still being restored
+    std::vector<std::pair<double, ViewProviderPartExt*> > jobs;
+    std::vector<ViewProviderPartExt*> waiting;
+    std::map<App::Document*, std::unique_ptr<SbVec3f> > cameras;
+    for (auto vp : pendingTessellations) {
+        App::Document* doc = vp->getObject()->getDocument();
+        if (doc->testStatus(App::Document::Restoring)) {
+            waiting.push_back(vp);
+            continue;
+        }
+
+        auto res = cameras.emplace(doc, std::unique_ptr<SbVec3f>());
+        if (res.second) {
+            Gui::Document* gdoc = Gui::Application::Instance->getDocument(doc);
+            auto views = gdoc ? gdoc->getMDIViewsOfType(Gui::View3DInventor::getClassTypeId())
+                              : std::list<Gui::MDIView*>();
+            if (!views.empty()) {
+                SoCamera* cam = static_cast<Gui::View3DInventor*>(views.front())
+                    ->getViewer()->getSoRenderManager()->getCamera();
+                if (cam)
+                    res.first->second.reset(new SbVec3f(cam->position.getValue()));
+            }
+        }
+
+        // sort by the distance of the bounding box center to the camera
+        double dist = 0.0;
+        const SbVec3f* pos = res.first->second.get();
+        const TopoDS_Shape& shape = vp->tessJob->data->shape;
+        if (pos && !shape.IsNull()) {
+            Bnd_Box bounds;
+            BRepBndLib::Add(shape, bounds);
+            if (!bounds.IsVoid()) {
+                Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+                bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+                SbVec3f center(0.5*(xMin+xMax), 0.5*(yMin+yMax), 0.5*(zMin+zMax));
+                dist = (center - *pos).sqrLength();
+            }
+        }
+        jobs.emplace_back(dist, vp);
+    }
+
+    pendingTessellations = std::move(waiting);
+    if (!pendingTessellations.empty())
+        QTimer::singleShot(100, &ViewProviderPartExt::startPendingTessellations);
+
+    // The thread pool runs the jobs in the order they are started
+    std::stable_sort(jobs.begin(), jobs.end(),
+        [](const std::pair<double, ViewProviderPartExt*>& a,
+           const std::pair<double, ViewProviderPartExt*>& b) {
+            return a.first < b.first;
+        });
+    for (auto &job : jobs)
+        job.second->startTessellation();
+}
+
+bool ViewProviderPartExt::isTessellating() const
+{
+    return tessJob != nullptr;
+}
+
+float ViewProviderPartExt::tessellationProgress() const
+{
+    if (!tessJob)
+        return 1.0f;
+    return tessJob->data->progress / 1000.0f;
+}
+
+void ViewProviderPartExt::finishTessellation()
+{
+    if (!tessJob)
+        return;
+
+    std::shared_ptr<TessellationData> data = tessJob->data;
+    tessJob.reset();
+    applyVisual(*data);
+
+    // The material binding depends on the number of faces
+    setHighlightedFaces(DiffuseColor.getValues());
+    if (this->faceset->partIndex.getNum() >
+        this->pcShapeMaterial->diffuseColor.getNum()) {
+        this->pcFaceBind->value = SoMaterialBinding::OVERALL;
+    }
+}
+
+void ViewProviderPartExt::clearVisual()
 {
     Gui::SoUpdateVBOAction action;
     action.apply(this->faceset);
+    action.apply(this->lineset);
+    action.apply(this->nodeset);
 
     // Clear selection
     Gui::SoSelectionElementAction saction(Gui::SoSelectionElementAction::None);
@@ -1014,23 +1343,48 @@ void ViewProviderPartExt::updateVisual()
     haction.apply(this->faceset);
     haction.apply(this->lineset);
     haction.apply(this->nodeset);
+}
 
-    TopoDS_Shape cShape = Part::Feature::getShape(getObject());
-    if (cShape.IsNull()) {
-        coords  ->point      .setNum(0);
-        norm    ->vector     .setNum(0);
-        faceset ->coordIndex .setNum(0);
-        faceset ->partIndex  .setNum(0);
-        lineset ->coordIndex .setNum(0);
-        nodeset ->startIndex .setValue(0);
-        VisualTouched = false;
+void ViewProviderPartExt::applyVisual(TessellationData& data)
+{
+    FC_PROFILE_ZONE("ViewProviderPartExt::applyVisual");
+    if (data.failed) {
+        FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
         return;
     }
 
+    clearVisual();
+
+    // replace all arrays at once
+    coords  ->point      .setNum(static_cast<int>(data.verts.size()));
+    norm    ->vector     .setNum(static_cast<int>(data.norms.size()));
+    faceset ->coordIndex .setNum(static_cast<int>(data.index.size()));
+    faceset ->partIndex  .setNum(static_cast<int>(data.parts.size()));
+    lineset ->coordIndex .setNum(static_cast<int>(data.lines.size()));
+
+    if (!data.verts.empty())
+        coords  ->point      .setValues(0, static_cast<int>(data.verts.size()), &data.verts[0]);
+    if (!data.norms.empty())
+        norm    ->vector     .setValues(0, static_cast<int>(data.norms.size()), &data.norms[0]);
+    if (!data.index.empty())
+        faceset ->coordIndex .setValues(0, static_cast<int>(data.index.size()), &data.index[0]);
+    if (!data.parts.empty())
+        faceset ->partIndex  .setValues(0, static_cast<int>(data.parts.size()), &data.parts[0]);
+    if (!data.lines.empty())
+        lineset ->coordIndex .setValues(0, static_cast<int>(data.lines.size()), &data.lines[0]);
+    nodeset ->startIndex .setValue(data.nodeStart);
+    faceset ->setDetailLevels(data.bbox, std::move(data.levels));
+}
+
+void ViewProviderPartExt::tessellate(TessellationData& data)
+{
+    // may run in a worker thread, see startTessellation()
+    FC_PROFILE_ZONE("ViewProviderPartExt::tessellate");
     // time measurement and book keeping
     Base::TimeInfo start_time;
     int numTriangles=0,numNodes=0,numNorms=0,numFaces=0,numEdges=0,numLines=0;
     std::set<int> faceEdges;
+    TopoDS_Shape cShape = data.shape;
 
     try {
         // calculating the deflection value
@@ -1040,16 +1394,24 @@ void ViewProviderPartExt::updateVisual()
         Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
         bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
         Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 *
-            Deviation.getValue();
+            data.deviation;
+
+        ShapeMeshLock meshLock(cShape);
+        if (data.canceled)
+            return;
 
         // create or use the mesh on the data structure
 #if OCC_VERSION_HEX >= 0x060600
-        Standard_Real AngDeflectionRads = AngularDeflection.getValue() / 180.0 * M_PI;
+        Standard_Real AngDeflectionRads = data.angularDeflection / 180.0 * M_PI;
         BRepMesh_IncrementalMesh(cShape,deflection,Standard_False,
                 AngDeflectionRads,Standard_True);
 #else
         BRepMesh_IncrementalMesh(cShape,deflection);
 #endif
+        data.progress = 500;
+        if (data.canceled)
+            return;
+
         // We must reset the location here because the transformation data
         // are set in the placement property
         TopLoc_Location aLoc;
@@ -1112,23 +1474,24 @@ void ViewProviderPartExt::updateVisual()
         TopExp::MapShapes(cShape, TopAbs_VERTEX, vertexMap);
         numNodes += vertexMap.Extent();
 
-        // create memory for the nodes and indexes
-        coords  ->point      .setNum(numNodes);
-        norm    ->vector     .setNum(numNorms);
-        faceset ->coordIndex .setNum(numTriangles*4);
-        faceset ->partIndex  .setNum(numFaces);
-        // get the raw memory for fast fill up
-        SbVec3f* verts = coords  ->point       .startEditing();
-        SbVec3f* norms = norm    ->vector      .startEditing();
-        int32_t* index = faceset ->coordIndex  .startEditing();
-        int32_t* parts = faceset ->partIndex   .startEditing();
-
+        // create memory for the nodes and indexes and
         // preset the normal vector with null vector
-        for (int i=0;i < numNorms;i++)
-            norms[i]= SbVec3f(0.0,0.0,0.0);
+        data.verts.resize(numNodes);
+        data.norms.assign(numNorms, SbVec3f(0.0,0.0,0.0));
+        data.index.resize(numTriangles*4);
+        data.parts.resize(numFaces);
+        // get the raw memory for fast fill up
+        SbVec3f* verts = data.verts.data();
+        SbVec3f* norms = data.norms.data();
+        int32_t* index = data.index.data();
+        int32_t* parts = data.parts.data();
 
         int ii = 0,faceNodeOffset=0,faceTriaOffset=0;
         for (int i=1; i <= faceMap.Extent(); i++, ii++) {
+            if (data.canceled)
+                return;
+            data.progress = 500 + 500 * i / (faceMap.Extent() + 1);
+
             TopLoc_Location aLoc;
             const TopoDS_Face &actFace = TopoDS::Face(faceMap(i));
             // get the mesh of the shape
@@ -1157,7 +1520,7 @@ void ViewProviderPartExt::updateVisual()
             const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
             const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
             TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
-            if (NormalsFromUV)
+            if (data.normalsFromUV)
                 getNormals(actFace, mesh, Normals);
             
             for (int g=1;g<=nbTriInFace;g++) {
@@ -1177,7 +1540,7 @@ void ViewProviderPartExt::updateVisual()
 
                 // get the 3 normals of this triangle
                 gp_Vec NV1, NV2, NV3;
-                if (NormalsFromUV) {
+                if (data.normalsFromUV) {
                     NV1.SetXYZ(Normals(N1).XYZ());
                     NV2.SetXYZ(Normals(N2).XYZ());
                     NV3.SetXYZ(Normals(N3).XYZ());
@@ -1197,7 +1560,7 @@ void ViewProviderPartExt::updateVisual()
                     V1.Transform(myTransf);
                     V2.Transform(myTransf);
                     V3.Transform(myTransf);
-                    if (NormalsFromUV) {
+                    if (data.normalsFromUV) {
                         NV1.Transform(myTransf);
                         NV2.Transform(myTransf);
                         NV3.Transform(myTransf);
@@ -1303,7 +1666,7 @@ void ViewProviderPartExt::updateVisual()
             }
         }
 
-        nodeset->startIndex.setValue(faceNodeOffset);
+        data.nodeStart = faceNodeOffset;
         for (int i=0; i<vertexMap.Extent(); i++) {
             const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i+1));
             gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
@@ -1314,30 +1677,38 @@ void ViewProviderPartExt::updateVisual()
         for (int i = 0; i< numNorms ;i++)
             norms[i].normalize();
         
-        std::vector<int32_t> lineSetCoords;
+        std::vector<int32_t>& lineSetCoords = data.lines;
         for (std::map<int, std::vector<int32_t> >::iterator it = lineSetMap.begin(); it != lineSetMap.end(); ++it) {
             lineSetCoords.insert(lineSetCoords.end(), it->second.begin(), it->second.end());
             lineSetCoords.push_back(-1);
         }
-
-        // preset the index vector size
         numLines =  lineSetCoords.size();
-        lineset ->coordIndex .setNum(numLines);
-        int32_t* lines = lineset ->coordIndex  .startEditing();
-
-        int l=0;
-        for (std::vector<int32_t>::const_iterator it=lineSetCoords.begin();it!=lineSetCoords.end();++it,l++)
-            lines[l] = *it;
-
-        // end the editing of the nodes
-        coords  ->point       .finishEditing();
-        norm    ->vector      .finishEditing();
-        faceset ->coordIndex  .finishEditing();
-        faceset ->partIndex   .finishEditing();
-        lineset ->coordIndex  .finishEditing();
+
+        // levels of detail are only worth it for larger triangulations
+        if (data.levelOfDetail && numTriangles > 2000) {
+            for (const auto& vert : data.verts)
+                data.bbox.extendBy(vert);
+
+            // grid resolution and the screen size in pixels up to which the level is used
+            static const int detailLevels[][2] = {{128, 256}, {32, 64}, {8, 16}};
+            std::size_t numIndexes = data.index.size();
+            for (const auto& it : detailLevels) {
+                if (data.canceled)
+                    return;
+                SoBrepFaceSet::DetailLevel level;
+                level.maxScreenSize = static_cast<short>(it[1]);
+                makeDetailLevel(data.verts, data.bbox, it[0], data.index, data.parts, level);
+                // skip levels that don't reduce the number of triangles considerably
+                if (level.coordIndex.size() * 2 > numIndexes)
+                    continue;
+                numIndexes = level.coordIndex.size();
+                data.levels.push_back(std::move(level));
+            }
+        }
+        data.progress = 1000;
     }
     catch (...) {
-        FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
+        data.failed = true;
     }
 
 #   ifdef FC_DEBUG
@@ -1345,8 +1716,8 @@ void ViewProviderPartExt::updateVisual()
         Base::Console().Log("ViewProvider update time: %f s\n",Base::TimeInfo::diffTimeF(start_time,Base::TimeInfo()));
         Base::Console().Log("Shape tria info: Faces:%d Edges:%d Nodes:%d Triangles:%d IdxVec:%d\n",numFaces,numEdges,numNodes,numTriangles,numLines);
 #   endif
-    VisualTouched = false;
 }
+
 void ViewProviderPartExt::forceUpdate(bool enable) {
     if(enable) {
         if(++forceUpdateCount == 1) {
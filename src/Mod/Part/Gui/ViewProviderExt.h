@@ -33,6 +33,8 @@
 #include <App/PropertyUnits.h>
 #include <Gui/ViewProviderGeometryObject.h>
 #include <map>
+#include <memory>
+#include <vector>
 #include <Mod/Part/App/PartFeature.h>
 
 class TopoDS_Shape;
@@ -144,6 +146,21 @@ public:
 
     virtual bool allowOverride(const App::DocumentObject &) const override;
 
+    /** @name Background tessellation
+     * If enabled with the BackgroundTessellation parameter the shape is meshed
+     * in a worker thread and the current representation is kept until the new
+     * one has been computed. While a document is being restored the jobs are
+     * held back and started afterwards, the objects nearest to the camera first.
+     */
+    //@{
+    /// discard a running tessellation
+    void cancelTessellation();
+    /// returns true while a tessellation is running in the background
+    bool isTessellating() const;
+    /// progress of the running tessellation in the range [0,1]
+    float tessellationProgress() const;
+    //@}
+
     /** @name Edit methods */
     //@{
     void setupContextMenu(QMenu*, QObject*, const char*) override;
@@ -158,8 +175,8 @@ protected:
     virtual void onChanged(const App::Property* prop) override;
     bool loadParameter();
     void updateVisual();
-    void getNormals(const TopoDS_Face&  theFace, const Handle(Poly_Triangulation)& aPolyTri,
-                    TColgp_Array1OfDir& theNormals);
+    static void getNormals(const TopoDS_Face&  theFace, const Handle(Poly_Triangulation)& aPolyTri,
+                           TColgp_Array1OfDir& theNormals);
 
     // nodes for the data representation
     SoMaterialBinding * pcFaceBind;
@@ -182,6 +199,19 @@ protected:
     bool NormalsFromUV;
 
 private:
+    struct TessellationData;
+    class TessellationJob;
+    static void tessellate(TessellationData&);
+    void applyVisual(TessellationData&);
+    void clearVisual();
+    void finishTessellation();
+    void startTessellation();
+    static void startPendingTessellations();
+
+    std::unique_ptr<TessellationJob> tessJob;
+    /// providers whose tessellation waits for the end of a document restore
+    static std::vector<ViewProviderPartExt*> pendingTessellations;
+
     // settings stuff
     int forceUpdateCount;
     static App::PropertyFloatConstraint::Constraints sizeRange;
@@ -24,6 +24,8 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <set>
 #endif
 
 #include <Base/Console.h>
@@ -55,6 +57,9 @@ using namespace PartDesign;
 PROPERTY_SOURCE(PartDesign::Body, Part::BodyBase)
 
 Body::Body() {
+    ADD_PROPERTY_TYPE(KeepIntermediateShapes,(true),"Base",App::Prop_None,
+        "Keep the shapes of all features. If false, only the shapes of the tip and of\n"
+        "features that are shown or used by other objects are kept to save memory and file size.");
     _GroupTouched.setStatus(App::Property::Output,true);
 }
 
@@ -431,6 +436,10 @@ App::DocumentObjectExecReturn *Body::execute(void)
     }
 
     Shape.setValue ( tipShape );
+
+    if (!KeepIntermediateShapes.getValue())
+        evictIntermediateShapes();
+
     return App::DocumentObject::StdReturn;
 
 }
@@ -470,6 +479,15 @@ void Body::onChanged (const App::Property* prop) {
             if (bf && (bf->BaseFeature.getValue() != BaseFeature.getValue()))
                 bf->BaseFeature.setValue(BaseFeature.getValue());
         }
+        else if (prop == &KeepIntermediateShapes) {
+            // the next recompute brings back the dropped shapes
+            if (KeepIntermediateShapes.getValue()) {
+                for (auto obj : Group.getValues()) {
+                    if (isSolidFeature(obj) && static_cast<Part::Feature*>(obj)->Shape.getValue().IsNull())
+                        obj->touch();
+                }
+            }
+        }
         else if( prop == &Group ) {
 
             //if the FeatureBase was deleted we set the BaseFeature link to nullptr
@@ -547,6 +565,40 @@ void Body::onDocumentRestored()
     DocumentObject::onDocumentRestored();
 }
 
+static bool isShapeNeeded(const PartDesign::Feature* feature, const Body* body)
+{
+    std::set<App::DocumentObject*> checked;
+    for (auto obj : feature->getInList()) {
+        if (obj == body || !checked.insert(obj).second)
+            continue;
+        // The next feature gets the shape through getBaseObject() that restores it on demand.
+        // If it links the feature in any other way the shape must be kept.
+        auto next = Base::freecad_dynamic_cast<PartDesign::Feature>(obj);
+        if (next && next->BaseFeature.getValue() == feature) {
+            auto outList = next->getOutList();
+            if (std::count(outList.begin(), outList.end(), feature) == 1)
+                continue;
+        }
+        return true;
+    }
+    return false;
+}
+
+void Body::evictIntermediateShapes()
+{
+    App::DocumentObject* tip = Tip.getValue();
+    for (auto obj : Group.getValues()) {
+        if (obj == tip || !isSolidFeature(obj))
+            continue;
+        auto feature = static_cast<PartDesign::Feature*>(obj);
+        // shown features are usually being edited or inspected
+        if (feature->Visibility.getValue() || feature->isError() || feature->isShapeEvicted())
+            continue;
+        if (!isShapeNeeded(feature, this))
+            feature->evictShape();
+    }
+}
+
 // a body is solid if it has features that are solid
 bool Body::isSolid()
 {
@@ -47,6 +47,11 @@ public:
     /// True if this body feature is active or was active when the document was last closed
     //App::PropertyBool IsActive;
 
+    /** If false only the shapes of the tip and of the features that are shown or
+      * used by other objects are kept. The others are recomputed when needed.
+      */
+    App::PropertyBool KeepIntermediateShapes;
+
     Body();
 
     /** @name methods override feature */
@@ -140,6 +145,12 @@ public:
     // a body is solid if it has features that are solid according to member isSolidFeature.
     bool isSolid(void);
 
+    /**
+      * Drops the shapes of the solid features that are not needed anymore, see
+      * KeepIntermediateShapes. Called after the body is recomputed.
+      */
+    void evictIntermediateShapes();
+
 protected:
     virtual void onSettingDocument() override;
 
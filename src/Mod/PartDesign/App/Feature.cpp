@@ -23,6 +23,8 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <memory>
+# include <sstream>
 # include <Standard_Failure.hxx>
 # include <TopoDS_Solid.hxx>
 # include <TopExp_Explorer.hxx>
@@ -35,6 +37,7 @@
 
 // TODO Cleanup headers (2015-09-04, Fat-Zer)
 #include <Base/Exception.h>
+#include <Base/Tools.h>
 #include "App/Document.h"
 #include <App/FeaturePythonPyImp.h>
 #include "App/OriginFeature.h"
@@ -134,6 +137,10 @@ Part::Feature* Feature::getBaseObject(bool silent) const {
         throw Base::RuntimeError(err);
     }
 
+    auto baseFeature = Base::freecad_dynamic_cast<PartDesign::Feature>(BaseObject);
+    if (baseFeature)
+        baseFeature->restoreShape();
+
     return BaseObject;
 }
 
@@ -183,6 +190,51 @@ Part::TopoShape Feature::getBaseTopoShape(bool silent) const {
     return result;
 }
 
+void Feature::evictShape()
+{
+    Base::ObjectStatusLocker<App::ObjectStatus, App::DocumentObject> guard(App::NoTouch, this);
+    Shape.setValue(TopoDS_Shape());
+}
+
+void Feature::restoreShape()
+{
+    if (!isShapeEvicted())
+        return;
+
+    // the evicted shape of the base feature is restored by getBaseObject()
+    FC_LOG("Restoring the shape of " << getFullName());
+    Base::ObjectStatusLocker<App::ObjectStatus, App::DocumentObject> guard(App::NoTouch, this);
+    std::unique_ptr<App::DocumentObjectExecReturn> ret(recompute());
+    if (ret) {
+        std::stringstream str;
+        str << "Failed to restore the shape of " << getNameInDocument() << ": " << ret->Why;
+        throw Base::RuntimeError(str.str());
+    }
+}
+
+bool Feature::isShapeEvicted() const
+{
+    if (!Shape.getValue().IsNull())
+        return false;
+    Body* body = getFeatureBody();
+    return body && !body->KeepIntermediateShapes.getValue();
+}
+
+void Feature::onChanged(const App::Property* prop)
+{
+    // a feature that is shown again needs its shape
+    if (prop == &Visibility && Visibility.getValue() && !isRestoring() && isShapeEvicted()) {
+        try {
+            restoreShape();
+        }
+        catch (Base::Exception& e) {
+            e.ReportException();
+        }
+    }
+
+    Part::Feature::onChanged(prop);
+}
+
 PyObject* Feature::getPyObject()
 {
     if (PythonObject.is(Py::_None())){
@@ -74,6 +74,19 @@ public:
     /// Returns the BaseFeature property's TopoShape (if any)
     Part::TopoShape getBaseTopoShape(bool silent=false) const;
 
+    /** @name Evictable shapes
+     * A body can drop the shapes of intermediate features, see Body::KeepIntermediateShapes.
+     * They are recomputed from the nearest feature with a shape when needed.
+     */
+    //@{
+    /// Clears the result shapes without touching the feature
+    virtual void evictShape();
+    /// Recomputes the shape if it was evicted. Throws if the recomputation fails.
+    void restoreShape();
+    /// Returns true if the shape was dropped by the body
+    bool isShapeEvicted() const;
+    //@}
+
     virtual PyObject* getPyObject(void);
 
     virtual const char* getViewProviderName() const {
@@ -81,6 +94,7 @@ public:
     }
 
 protected:
+    virtual void onChanged(const App::Property* prop);
 
     /**
      * Get a solid of the given shape. If no solid is found an exception is raised.
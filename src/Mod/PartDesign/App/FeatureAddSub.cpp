@@ -28,6 +28,7 @@
 
 
 #include <Base/Parameter.h>
+#include <Base/Tools.h>
 #include <App/Application.h>
 #include <App/FeaturePythonPyImp.h>
 #include <Mod/Part/App/modelRefine.h>
@@ -84,6 +85,13 @@ TopoDS_Shape FeatureAddSub::refineShapeIfActive(const TopoDS_Shape& oldShape) co
     return oldShape;
 }
 
+void FeatureAddSub::evictShape()
+{
+    Base::ObjectStatusLocker<App::ObjectStatus, App::DocumentObject> guard(App::NoTouch, this);
+    AddSubShape.setValue(TopoDS_Shape());
+    Feature::evictShape();
+}
+
 void FeatureAddSub::getAddSubShape(Part::TopoShape &addShape, Part::TopoShape &subShape)
 {
     if (addSubType == Additive)
@@ -50,6 +50,7 @@ public:
     virtual short mustExecute() const override;
 
     virtual void getAddSubShape(Part::TopoShape &addShape, Part::TopoShape &subShape);
+    virtual void evictShape() override;
 
     Part::PropertyPartShape   AddSubShape;
     App::PropertyBool Refine;
@@ -112,43 +112,65 @@ App::DocumentObjectExecReturn *Boolean::execute(void)
 
     TopoDS_Shape result = baseTopShape.getShape();
 
+    std::vector<TopoDS_Shape> shapes;
     for (auto tool : tools)
     {
         if(!tool->isDerivedFrom(Part::Feature::getClassTypeId()))
             return new App::DocumentObjectExecReturn("Cannot do boolean with anything but Part::Feature and its derivatives");
 
         TopoDS_Shape shape = static_cast<Part::Feature*>(tool)->Shape.getValue();
-        TopoDS_Shape boolOp;
 
         // Must not pass null shapes to the boolean operations
-        if (result.IsNull())
-            return new App::DocumentObjectExecReturn("Base shape is null");
-
         if (shape.IsNull())
             return new App::DocumentObjectExecReturn("Tool shape is null");
 
-        if (type == "Fuse") {
-            BRepAlgoAPI_Fuse mkFuse(result, shape);
-            if (!mkFuse.IsDone())
-                return new App::DocumentObjectExecReturn("Fusion of tools failed");
-            // we have to get the solids (fuse sometimes creates compounds)
-            boolOp = this->getSolid(mkFuse.Shape());
-            // lets check if the result is a solid
-            if (boolOp.IsNull())
-                return new App::DocumentObjectExecReturn("Resulting shape is not a solid");
-        } else if (type == "Cut") {
-            BRepAlgoAPI_Cut mkCut(result, shape);
-            if (!mkCut.IsDone())
-                return new App::DocumentObjectExecReturn("Cut out failed");
-            boolOp = mkCut.Shape();
-        } else if (type == "Common") {
-            BRepAlgoAPI_Common mkCommon(result, shape);
-            if (!mkCommon.IsDone())
+        shapes.push_back(shape);
+    }
+
+    // Fuse and cut pass all tools to a single boolean operation. This is much faster
+    // than a chain of operations because the base shape is intersected only once.
+    if (type == "Fuse") {
+        try {
+            result = Part::TopoShape(result).fuse(shapes);
+        }
+        catch (const Standard_Failure&) {
+            return new App::DocumentObjectExecReturn("Fusion of tools failed");
+        }
+        catch (const Base::Exception&) {
+            return new App::DocumentObjectExecReturn("Fusion of tools failed");
+        }
+        // we have to get the solids (fuse sometimes creates compounds)
+        result = this->getSolid(result);
+        // lets check if the result is a solid
+        if (result.IsNull())
+            return new App::DocumentObjectExecReturn("Resulting shape is not a solid");
+    } else if (type == "Cut") {
+        try {
+            result = Part::TopoShape(result).cut(shapes);
+        }
+        catch (const Standard_Failure&) {
+            return new App::DocumentObjectExecReturn("Cut out failed");
+        }
+        catch (const Base::Exception&) {
+            return new App::DocumentObjectExecReturn("Cut out failed");
+        }
+    } else if (type == "Common") {
+        // A single operation with several tools would intersect the base with the
+        // union of the tools, so the tools are applied one after another
+        for (const auto& shape : shapes) {
+            if (result.IsNull())
+                return new App::DocumentObjectExecReturn("Base shape is null");
+            try {
+                std::vector<TopoDS_Shape> tool(1, shape);
+                result = Part::TopoShape(result).common(tool);
+            }
+            catch (const Standard_Failure&) {
+                return new App::DocumentObjectExecReturn("Common operation failed");
+            }
+            catch (const Base::Exception&) {
                 return new App::DocumentObjectExecReturn("Common operation failed");
-            boolOp = mkCommon.Shape();
+            }
         }
-
-        result = boolOp; // Use result of this operation for fuse/cut of next body
     }
 
     result = refineShapeIfActive(result);
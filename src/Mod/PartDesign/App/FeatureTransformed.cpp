@@ -34,6 +34,9 @@
 # include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBndLib.hxx>
 # include <Bnd_Box.hxx>
+# include <TopLoc_Location.hxx>
+# include <TopTools_ListOfShape.hxx>
+# include <Standard_Version.hxx>
 #endif
 
 #ifndef FC_DEBUG
@@ -58,6 +61,31 @@
 
 using namespace PartDesign;
 
+namespace {
+
+// A transformation without scaling and mirroring can be applied as a location
+// so that the transformed shape shares the geometry of the original
+bool isLocationTransform(const gp_Trsf& trsf)
+{
+    return !trsf.IsNegative() && std::fabs(trsf.ScaleFactor() - 1.0) <= Precision::Confusion();
+}
+
+// Fuses or cuts all tool shapes with the support in one general fuse run
+void performBoolean(BRepAlgoAPI_BooleanOperation& mkBool, const TopoDS_Shape& support, const TopoDS_Shape& tools)
+{
+    TopTools_ListOfShape shapeArguments, shapeTools;
+    shapeArguments.Append(support);
+    shapeTools.Append(tools);
+    mkBool.SetArguments(shapeArguments);
+    mkBool.SetTools(shapeTools);
+#if OCC_VERSION_HEX >= 0x060900
+    mkBool.SetRunParallel(true);
+#endif
+    mkBool.Build();
+}
+
+}
+
 namespace PartDesign {
 
 const char* Transformed::OverlapEnums[] = { "Detect", "Overlap mode", "Non-overlap mode", NULL};
@@ -295,25 +323,40 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
         std::vector<TopoDS_Shape> shapes;
         bool overlapping = false;
 
+        // An instance can only overlap the original if their bounding boxes intersect,
+        // the exact check with a boolean fuse is done only for these candidates
+        Bnd_Box origBound;
+        if (overlapDetectionMode) {
+            BRepBndLib::Add(origShape, origBound);
+            origBound.SetGap(Precision::Confusion());
+        }
+
         std::vector<gp_Trsf>::const_iterator t = transformations.begin();
         bool first = true;
         for (; t != transformations.end(); ++t) {
-            // Make an explicit copy of the shape because the "true" parameter to BRepBuilderAPI_Transform
-            // seems to be pretty broken
-            BRepBuilderAPI_Copy copy(origShape);
+            if (isLocationTransform(*t)) {
+                shape = origShape.Moved(TopLoc_Location(*t));
+            }
+            else {
+                // Make an explicit copy of the shape because the "true" parameter to BRepBuilderAPI_Transform
+                // seems to be pretty broken
+                BRepBuilderAPI_Copy copy(origShape);
 
-            shape = copy.Shape();
+                shape = copy.Shape();
 
-            BRepBuilderAPI_Transform mkTrf(shape, *t, false); // No need to copy, now
-            if (!mkTrf.IsDone())
-                return new App::DocumentObjectExecReturn("Transformation failed", (*o));
-            shape = mkTrf.Shape();
+                BRepBuilderAPI_Transform mkTrf(shape, *t, false); // No need to copy, now
+                if (!mkTrf.IsDone())
+                    return new App::DocumentObjectExecReturn("Transformation failed", (*o));
+                shape = mkTrf.Shape();
+            }
 
             shapes.emplace_back(shape);
             builder.Add(compShape, shape);
 
-            if (overlapDetectionMode && !first)
-                overlapping =  overlapping || (countSolids(TopoShape(origShape).fuse(shape))==1);
+            if (overlapDetectionMode && !first && !overlapping) {
+                if (!origBound.Transformed(*t).IsOut(origBound))
+                    overlapping = (countSolids(TopoShape(origShape).fuse(shape))==1);
+            }
 
             if (first)
                 first = false;
@@ -334,7 +377,8 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
             toolShape = compShape;
 
         if (!fuseShape.isNull()) {
-            std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(new BRepAlgoAPI_Fuse(current, toolShape));
+            std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(new BRepAlgoAPI_Fuse());
+            performBoolean(*mkBool, current, toolShape);
             if (!mkBool->IsDone()) {
                 std::stringstream error;
                 error << "Boolean operation failed";
@@ -342,7 +386,8 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
             }
             current = mkBool->Shape();
         } else {
-            std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(new BRepAlgoAPI_Cut(current, toolShape));
+            std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(new BRepAlgoAPI_Cut());
+            performBoolean(*mkBool, current, toolShape);
             if (!mkBool->IsDone()) {
                 std::stringstream error;
                 error << "Boolean operation failed";
@@ -0,0 +1,184 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <boost_bind_bind.hpp>
+#endif
+
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/DocumentObject.h>
+#include <Gui/MainWindow.h>
+#include <Mod/PartDesign/App/Body.h>
+
+#include "BodyRecomputeScheduler.h"
+
+
+using namespace PartDesignGui;
+namespace bp = boost::placeholders;
+
+
+BodyRecomputeScheduler * BodyRecomputeScheduler::_instance = nullptr;
+
+
+BodyRecomputeScheduler::BodyRecomputeScheduler() {
+    timer.setSingleShot(true);
+    // zero interval, the next step runs as soon as the pending events are processed
+    timer.setInterval(0);
+    QObject::connect(&timer, &QTimer::timeout, [this]() { step(); });
+
+    for (auto doc : App::GetApplication().getDocuments())
+        manageDocument(*doc);
+
+    connectNewDocument = App::GetApplication().signalNewDocument.connect(
+            boost::bind(&BodyRecomputeScheduler::slotNewDocument, this, bp::_1));
+    connectFinishRestoreDocument = App::GetApplication().signalFinishRestoreDocument.connect(
+            boost::bind(&BodyRecomputeScheduler::slotFinishRestoreDocument, this, bp::_1));
+    connectDeleteDocument = App::GetApplication().signalDeleteDocument.connect(
+            boost::bind(&BodyRecomputeScheduler::slotDeleteDocument, this, bp::_1));
+}
+
+BodyRecomputeScheduler::~BodyRecomputeScheduler() {
+    // they won't be automatically disconnected on destruction!
+    connectNewDocument.disconnect();
+    connectFinishRestoreDocument.disconnect();
+    connectDeleteDocument.disconnect();
+}
+
+void BodyRecomputeScheduler::init() {
+    if (!_instance)
+        _instance = new BodyRecomputeScheduler();
+}
+
+BodyRecomputeScheduler *BodyRecomputeScheduler::instance() {
+    if (!_instance)
+        BodyRecomputeScheduler::init();
+    return _instance;
+}
+
+void BodyRecomputeScheduler::destruct() {
+    if (_instance) {
+        delete _instance;
+        _instance = nullptr;
+    }
+}
+
+bool BodyRecomputeScheduler::isStepwise(const App::Document *doc) const {
+    return managed.find(doc) != managed.end();
+}
+
+bool BodyRecomputeScheduler::isPending(const App::Document *doc) const {
+    return pending.find(const_cast<App::Document*>(doc)) != pending.end();
+}
+
+void BodyRecomputeScheduler::manageDocument(const App::Document &doc) {
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/PartDesign");
+    if (!hGrp->GetBool("StepwiseRecompute", false) || isStepwise(&doc))
+        return;
+
+    // the signals pass the document as const, get the mutable one to change its status
+    App::Document *pcDoc = App::GetApplication().getDocument(doc.getName());
+    if (!pcDoc || pcDoc->testStatus(App::Document::TempDoc))
+        return;
+
+    pcDoc->setStatus(App::Document::SkipRecompute, true);
+    managed[&doc] = pcDoc->signalSkipRecompute.connect(
+            boost::bind(&BodyRecomputeScheduler::slotSkipRecompute, this, bp::_1, bp::_2));
+}
+
+void BodyRecomputeScheduler::slotNewDocument(const App::Document &doc) {
+    manageDocument(doc);
+}
+
+void BodyRecomputeScheduler::slotFinishRestoreDocument(const App::Document &doc) {
+    manageDocument(doc);
+}
+
+void BodyRecomputeScheduler::slotDeleteDocument(const App::Document &doc) {
+    managed.erase(&doc);
+    pending.erase(const_cast<App::Document*>(&doc));
+}
+
+void BodyRecomputeScheduler::slotSkipRecompute(const App::Document &doc,
+                                               const std::vector<App::DocumentObject*> &)
+{
+    // The request is served as a whole, the objects of a partial request are recomputed
+    // by the final recompute of the document anyway.
+    App::Document *pcDoc = App::GetApplication().getDocument(doc.getName());
+    if (!pcDoc || !isStepwise(pcDoc))
+        return;
+
+    pending.insert(pcDoc);
+    if (!timer.isActive())
+        timer.start();
+}
+
+App::DocumentObject *BodyRecomputeScheduler::nextFeature(App::Document *doc) const {
+    for (auto body : doc->getObjectsOfType<PartDesign::Body>()) {
+        // the group is in feature order, everything a feature depends on comes before it
+        for (auto obj : body->Group.getValues()) {
+            if (obj->isTouched() || obj->mustExecute())
+                return obj;
+        }
+    }
+    return nullptr;
+}
+
+void BodyRecomputeScheduler::step() {
+    std::vector<App::Document*> docs(pending.begin(), pending.end());
+    for (auto doc : docs) {
+        // undo, redo and nested recomputes are left to finish first
+        if (doc->testStatus(App::Document::Recomputing) || doc->isPerformingTransaction())
+            continue;
+
+        try {
+            App::DocumentObject *feature = nextFeature(doc);
+            if (feature) {
+                Gui::getMainWindow()->showMessage(QObject::tr("Recomputing %1...")
+                        .arg(QString::fromUtf8(feature->Label.getValue())));
+                doc->recompute(std::vector<App::DocumentObject*>(1, feature), true);
+
+                // a feature that stays touched failed, leave the rest of the chain to the
+                // final recompute instead of trying it again in every step
+                if (!feature->isTouched() && !feature->mustExecute())
+                    continue;
+            }
+
+            pending.erase(doc);
+            Gui::getMainWindow()->showMessage(QString());
+            doc->recompute(std::vector<App::DocumentObject*>(), true);
+        }
+        catch (const Base::Exception& e) {
+            pending.erase(doc);
+            e.ReportException();
+        }
+    }
+
+    if (!pending.empty())
+        timer.start();
+}
@@ -0,0 +1,105 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef PARTDESIGNGUI_BODYRECOMPUTESCHEDULER_H
+#define PARTDESIGNGUI_BODYRECOMPUTESCHEDULER_H
+
+#include <boost_signals2.hpp>
+#include <map>
+#include <set>
+#include <vector>
+#include <QTimer>
+
+namespace App {
+    class Document;
+    class DocumentObject;
+}
+
+namespace PartDesignGui {
+
+/**
+ * Recomputes the features of long bodies one at a time from the event loop instead of in one
+ * blocking recompute.
+ *
+ * If the parameter "StepwiseRecompute" of the PartDesign preferences is set, the documents are
+ * marked as SkipRecompute, so a plain recompute request only emits
+ * App::Document::signalSkipRecompute. The scheduler then recomputes the first touched feature of each
+ * body per event loop iteration with App::Document::recompute() restricted to that feature, and
+ * finally the remaining objects of the document. The displayed body keeps its last result until
+ * the chain has reached the tip. An edit made while the chain runs touches its feature again,
+ * so the next step continues from there and the rest of the outdated chain is never computed.
+ *
+ * Forced recomputes, for example from Python with doc.recompute(None, True), are not affected.
+ */
+class PartDesignGuiExport BodyRecomputeScheduler {
+public:
+    virtual ~BodyRecomputeScheduler();
+
+    /// Returns true if the document is recomputed step by step
+    bool isStepwise(const App::Document *doc) const;
+    /// Returns true if a stepwise recompute of the document has not finished yet
+    bool isPending(const App::Document *doc) const;
+
+    /** @name Init, Destruct an Access methods */
+    //@{
+    /// Creates an instance of the scheduler, should be called before any instance()
+    static void init();
+    /// Return an instance of the scheduler
+    static BodyRecomputeScheduler* instance();
+    /// destroy the scheduler
+    static void destruct();
+    //@}
+
+private:
+    /// The class is not intended to be constructed outside of itself
+    BodyRecomputeScheduler();
+
+    /// Marks the document as SkipRecompute if stepwise recomputes are enabled
+    void manageDocument(const App::Document& doc);
+    void slotNewDocument(const App::Document& doc);
+    void slotFinishRestoreDocument(const App::Document& doc);
+    void slotDeleteDocument(const App::Document& doc);
+    void slotSkipRecompute(const App::Document& doc, const std::vector<App::DocumentObject*>& objs);
+
+    /// Recomputes the next feature of every pending document
+    void step();
+    /// Returns the first feature of a body of the document that needs to be recomputed
+    App::DocumentObject* nextFeature(App::Document* doc) const;
+
+private:
+    /// documents marked as SkipRecompute by the scheduler, with their signalSkipRecompute connection
+    std::map<const App::Document*, boost::signals2::scoped_connection> managed;
+    /// documents with a recompute request not yet processed
+    std::set<App::Document*> pending;
+    QTimer timer;
+
+    boost::signals2::connection connectNewDocument;
+    boost::signals2::connection connectFinishRestoreDocument;
+    boost::signals2::connection connectDeleteDocument;
+
+    static BodyRecomputeScheduler* _instance;
+};
+
+} /* PartDesignGui */
+
+#endif // PARTDESIGNGUI_BODYRECOMPUTESCHEDULER_H
@@ -44,6 +44,7 @@
 #include "Workbench.h"
 
 #include "WorkflowManager.h"
+#include "BodyRecomputeScheduler.h"
 
 using namespace PartDesignGui;
 namespace bp = boost::placeholders;
@@ -69,6 +70,7 @@ Workbench::Workbench() {
 
 Workbench::~Workbench() {
     WorkflowManager::destruct();
+    BodyRecomputeScheduler::destruct();
 }
 
 void Workbench::_switchToDocument(const App::Document* /*doc*/)
@@ -255,6 +257,7 @@ void Workbench::activated()
     Gui::Workbench::activated();
 
     WorkflowManager::init();
+    BodyRecomputeScheduler::init();
 
     std::vector<Gui::TaskView::TaskWatcher*> Watcher;
 
@@ -28,6 +28,8 @@
 
 #ifndef _PreComp_
 # include <cfloat>
+# include <chrono>
+# include <mutex>
 # include <boost/version.hpp>
 # include <boost/config.hpp>
 # if defined(BOOST_MSVC) && (BOOST_VERSION == 105500)
@@ -181,6 +183,7 @@ CAreaConfig::~CAreaConfig() {
 TYPESYSTEM_SOURCE(Path::Area, Base::BaseClass)
 
 bool Area::s_aborting;
+std::list<std::shared_ptr<Area::BuildCacheEntry> > Area::s_buildCache;
 
 Area::Area(const AreaParams *params)
 :myParams(s_params)
@@ -188,6 +191,7 @@ Area::Area(const AreaParams *params)
 ,myHaveSolid(false)
 ,myShapeDone(false)
 ,myProjecting(false)
+,myCacheBuild(true)
 ,mySkippedShapes(0)
 {
     if(params)
@@ -204,6 +208,7 @@ Area::Area(const Area &other, bool deep_copy)
 ,myHaveSolid(other.myHaveSolid)
 ,myShapeDone(false)
 ,myProjecting(false)
+,myCacheBuild(other.myCacheBuild)
 ,mySkippedShapes(0)
 {
     if(!deep_copy || !other.isBuilt())
@@ -1460,9 +1465,26 @@ std::vector<shared_ptr<Area> > Area::makeSections(
     bool can_retry = fabs(tolerance)>Precision::Confusion();
     TopLoc_Location locInverse(loc.Inverted());
 
+    // Slice every solid at all heights up front, Part::CrossSection cuts the
+    // levels concurrently. Only the retried sections are sliced one by one
+    // below.
+    std::vector<std::vector<std::vector<std::list<TopoDS_Wire> > > > solidSlices;
+    if(!project) {
+        solidSlices.reserve(myShapes.size());
+        for(const auto &s : myShapes) {
+            solidSlices.emplace_back();
+            for(TopExp_Explorer xp(s.shape.Moved(loc), TopAbs_SOLID); xp.More(); xp.Next()) {
+                Part::CrossSection section(0,0,1,xp.Current());
+                solidSlices.back().push_back(section.slices(heights));
+            }
+        }
+        FC_TIME_LOG(t1,"makeSection slices");
+    }
+
     for(size_t i=0;i<heights.size();++i) {
         double z = heights[i];
         bool retried = !can_retry;
+        bool sliced = true;
         while(true) {
             gp_Pln pln(gp_Pnt(0,0,z),gp_Dir(0,0,1));
             Standard_Real a,b,c,d;
@@ -1472,6 +1494,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
 
             shared_ptr<Area> area(std::make_shared<Area>(&myParams));
             area->myParams.Outline = false;
+            area->myCacheBuild = false;
             area->setPlane(face.Moved(locInverse));
 
             if(project) {
@@ -1485,17 +1508,23 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                 break;
             }
 
-            for(auto it=myShapes.begin();it!=myShapes.end();++it) {
+            size_t shapeIndex = 0;
+            for(auto it=myShapes.begin();it!=myShapes.end();++it,++shapeIndex) {
                 const auto &s = *it;
                 BRep_Builder builder;
                 TopoDS_Compound comp;
                 builder.MakeCompound(comp);
 
-                for(TopExp_Explorer xp(s.shape.Moved(loc), TopAbs_SOLID); xp.More(); xp.Next()) {
+                size_t solidIndex = 0;
+                for(TopExp_Explorer xp(s.shape.Moved(loc), TopAbs_SOLID); xp.More(); xp.Next(),++solidIndex) {
                     showShape(xp.Current(),0,"section_%u_shape",i);
                     std::list<TopoDS_Wire> wires;
-                    Part::CrossSection section(a,b,c,xp.Current());
-                    wires = section.slice(-d);
+                    if(sliced)
+                        wires.swap(solidSlices[shapeIndex][solidIndex][i]);
+                    else {
+                        Part::CrossSection section(a,b,c,xp.Current());
+                        wires = section.slice(-d);
+                    }
                     showShapes(wires,0,"section_%u_wire",i);
                     if(wires.empty()) {
                         AREA_LOG("Section returns no wires");
@@ -1562,6 +1591,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                 AREA_TRACE("retry section " <<z<<"->"<<z+tolerance);
                 z += tolerance;
                 retried = true;
+                sliced = false;
             }
         }
     }
@@ -1615,6 +1645,170 @@ std::list<Area::Shape> Area::getProjectedShapes(const gp_Trsf &trsf, bool invers
     return ret;
 }
 
+struct Area::BuildCacheEntry {
+    // key
+    std::vector<Shape> shapes;
+    TopoDS_Shape workPlane;
+    AreaParams params;
+    bool projecting;
+
+    // result of a planar build
+    std::unique_ptr<CArea> area;
+    TopoDS_Shape shapePlane;
+    gp_Trsf trsf;
+    bool haveFace;
+    int skippedShapes;
+
+    // result of a solid build, the sections are kept here instead of in
+    // Area::s_buildCache so that many sections don't push out other entries
+    struct Section {
+        TopoDS_Shape workPlane;
+        gp_Trsf trsf;
+        std::list<Shape> shapes;
+        std::shared_ptr<BuildCacheEntry> result;
+    };
+    std::vector<Section> sections;
+
+    BuildCacheEntry()
+        :projecting(false),haveFace(false),skippedShapes(0)
+    {}
+
+    static bool isSame(const TopoDS_Shape &s1, const TopoDS_Shape &s2) {
+        if(s1.IsNull() || s2.IsNull())
+            return s1.IsNull() && s2.IsNull();
+        if(s1.TShape()!=s2.TShape() || s1.Orientation()!=s2.Orientation())
+            return false;
+        // The same placement is often applied through different location
+        // objects, so compare the transformation instead.
+        const gp_Trsf &t1 = s1.Location().Transformation();
+        const gp_Trsf &t2 = s2.Location().Transformation();
+        for(int r=1;r<=3;++r) {
+            for(int c=1;c<=4;++c) {
+                if(fabs(t1.Value(r,c)-t2.Value(r,c))>Precision::Confusion())
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool matches(const Area &other) const {
+        if(projecting!=other.myProjecting
+                || shapes.size()!=other.myShapes.size()
+                || !isSame(workPlane,other.myWorkPlane))
+            return false;
+
+        // only the parameters used by build() and makeSections()
+#define AREA_BUILD_COMPARE(_param) \
+        if(params.PARAM_FNAME(_param)!=other.myParams.PARAM_FNAME(_param)) return false;
+        PARAM_FOREACH(AREA_BUILD_COMPARE,AREA_PARAMS_CAREA)
+        PARAM_FOREACH(AREA_BUILD_COMPARE,AREA_PARAMS_BASE)
+        PARAM_FOREACH(AREA_BUILD_COMPARE,AREA_PARAMS_SECTION)
+
+        auto it = other.myShapes.begin();
+        for(const auto &s : shapes) {
+            if(s.op!=it->op || !isSame(s.shape,it->shape))
+                return false;
+            ++it;
+        }
+        return true;
+    }
+
+    static std::shared_ptr<BuildCacheEntry> capture(const Area &from) {
+        auto entry = std::make_shared<BuildCacheEntry>();
+        entry->shapes.insert(entry->shapes.end(),from.myShapes.begin(),from.myShapes.end());
+        entry->workPlane = from.myWorkPlane;
+        entry->params = from.myParams;
+        entry->projecting = from.myProjecting;
+        if(from.myArea) {
+            entry->area.reset(new CArea(*from.myArea));
+            entry->shapePlane = from.myShapePlane;
+            entry->trsf = from.myTrsf;
+            entry->haveFace = from.myHaveFace;
+            entry->skippedShapes = from.mySkippedShapes;
+            return entry;
+        }
+        entry->sections.reserve(from.mySections.size());
+        for(const auto &sectionArea : from.mySections) {
+            Section section;
+            section.workPlane = sectionArea->myWorkPlane;
+            section.trsf = sectionArea->myTrsf;
+            section.shapes = sectionArea->myShapes;
+            if(sectionArea->myArea)
+                section.result = capture(*sectionArea);
+            entry->sections.push_back(std::move(section));
+        }
+        return entry;
+    }
+
+    void restore(Area &to) const {
+        if(area) {
+            to.myArea.reset(new CArea(*area));
+            to.myAreaOpen.reset(new CArea());
+            to.myShapePlane = shapePlane;
+            to.myTrsf = trsf;
+            to.myHaveFace = haveFace;
+            to.mySkippedShapes = skippedShapes;
+            return;
+        }
+        for(const auto &section : sections) {
+            shared_ptr<Area> sectionArea(std::make_shared<Area>(&to.myParams));
+            sectionArea->myParams.Outline = false;
+            sectionArea->myCacheBuild = false;
+            sectionArea->myWorkPlane = section.workPlane;
+            sectionArea->myTrsf = section.trsf;
+            for(const auto &s : section.shapes)
+                sectionArea->add(s.shape,s.op);
+            if(section.result)
+                section.result->restore(*sectionArea);
+            to.mySections.push_back(sectionArea);
+        }
+    }
+};
+
+// maximum number of build results kept in Area::s_buildCache
+static const std::size_t BuildCacheSize = 16;
+static std::mutex BuildCacheMutex;
+
+bool Area::restoreBuild() {
+    if(!myCacheBuild)
+        return false;
+
+    std::shared_ptr<BuildCacheEntry> entry;
+    {
+        std::lock_guard<std::mutex> lock(BuildCacheMutex);
+        for(auto it=s_buildCache.begin();it!=s_buildCache.end();++it) {
+            if((*it)->matches(*this)) {
+                entry = *it;
+                s_buildCache.splice(s_buildCache.begin(),s_buildCache,it);
+                break;
+            }
+        }
+    }
+    if(!entry)
+        return false;
+
+    // entries are not changed after they are stored, so no lock is needed here
+    entry->restore(*this);
+    return true;
+}
+
+void Area::storeBuild() const {
+    if(!myCacheBuild || !isBuilt())
+        return;
+
+    auto entry = BuildCacheEntry::capture(*this);
+
+    std::lock_guard<std::mutex> lock(BuildCacheMutex);
+    s_buildCache.push_front(entry);
+    if(s_buildCache.size()>BuildCacheSize)
+        s_buildCache.pop_back();
+}
+
+void Area::clearBuildCache() {
+    std::lock_guard<std::mutex> lock(BuildCacheMutex);
+    s_buildCache.clear();
+}
+
 void Area::build() {
     if(isBuilt()) return;
 
@@ -1624,8 +1818,12 @@ void Area::build() {
 #define AREA_MY(_param) myParams.PARAM_FNAME(_param)
     PARAM_ENUM_CONVERT(AREA_MY,PARAM_FNAME,PARAM_ENUM_EXCEPT,AREA_PARAMS_CLIPPER_FILL);
 
+    if(restoreBuild())
+        return;
+
     if(myHaveSolid && myParams.SectionCount) {
         mySections = makeSections(PARAM_FIELDS(AREA_MY,AREA_PARAMS_SECTION_EXTRA));
+        storeBuild();
         return;
     }
 
@@ -1696,6 +1894,7 @@ void Area::build() {
             Area area(&myParams);
             area.myParams.Explode = false;
             area.myParams.Coplanar = CoplanarNone;
+            area.myCacheBuild = false;
             area.myWorkPlane = getPlane(&area.myTrsf);
             area.add(joiner.comp,OperationCompound);
             area.build();
@@ -1717,6 +1916,8 @@ void Area::build() {
 
         FC_TIME_TRACE(t,"prepare");
 
+        storeBuild();
+
     }catch(...) {
         clean();
         throw;
@@ -2439,6 +2640,7 @@ struct ShapeInfo{
     gp_Pnt myStartPt;
     Wires::iterator myBestWire;
     TopoDS_Shape mySupport;
+    Bnd_Box myBound;
     ShapeParams &myParams;
     Standard_Real myBestParameter;
     bool mySupportEdge;
@@ -2468,6 +2670,22 @@ struct ShapeInfo{
         , myRebase(false)
         , myStart(false)
     {}
+    // Returns a lower bound of the square distance from the given point to
+    // the remaining wires of this shape, using the bound box of the shape.
+    double boundDistance(const gp_Pnt &pt) {
+        if(myBound.IsVoid()) {
+            BRepBndLib::Add(myShape, myBound, Standard_False);
+            if(myBound.IsVoid())
+                return 0.0;
+        }
+        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+        myBound.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        double dx = std::max(0.0, std::max(xMin-pt.X(), pt.X()-xMax));
+        double dy = std::max(0.0, std::max(yMin-pt.Y(), pt.Y()-yMax));
+        double dz = std::max(0.0, std::max(zMin-pt.Z(), pt.Z()-zMax));
+        return dx*dx + dy*dy + dz*dz;
+    }
+
     double nearest(const gp_Pnt &pt) {
         myStartPt = pt;
 
@@ -2866,6 +3084,149 @@ struct WireOrienter {
 typedef Standard_Real (gp_Pnt::*AxisGetter)() const;
 typedef void (gp_Pnt::*AxisSetter)(Standard_Real);
 
+// Shortens the rapid moves through a run of closed wires using 2-opt and
+// Or-opt moves. 'order' holds the indices of the wire entry points in 'pts'.
+// The run starts from 'pstart', and ends at 'pend' if 'has_end' is set, or is
+// free otherwise. Returns the distance saved.
+typedef std::chrono::steady_clock::time_point SortDeadline;
+static double improveRun(std::vector<size_t> &order, const std::vector<gp_Pnt> &pts,
+        const gp_Pnt &pstart, bool has_end, const gp_Pnt &pend, const SortDeadline &deadline)
+{
+    const int count = static_cast<int>(order.size());
+    auto point = [&](int i) -> const gp_Pnt & {
+        if(i < 0) return pstart;
+        if(i >= count) return pend;
+        return pts[order[i]];
+    };
+    // distance of the move from position i to position j, no move after the
+    // free end of the run
+    auto dist = [&](int i, int j) {
+        if(j >= count && !has_end) return 0.0;
+        return point(i).Distance(point(j));
+    };
+    auto length = [&]() {
+        double l = 0.0;
+        for(int i=0;i<=count;++i)
+            l += dist(i-1,i);
+        return l;
+    };
+    const double before = length();
+    const double tol = Precision::Confusion();
+
+    bool improved = true;
+    while(improved) {
+        improved = false;
+
+        // 2-opt, reverse the wires from i to j
+        for(int i=0;i<count-1;++i) {
+            if(std::chrono::steady_clock::now() > deadline)
+                return before - length();
+            for(int j=i+1;j<count;++j) {
+                double delta = point(i-1).Distance(point(j)) - dist(i-1,i);
+                if(j+1<count || has_end)
+                    delta += point(i).Distance(point(j+1)) - dist(j,j+1);
+                if(delta < -tol) {
+                    std::reverse(order.begin()+i, order.begin()+j+1);
+                    improved = true;
+                }
+            }
+        }
+
+        // Or-opt, move up to three consecutive wires to another place,
+        // optionally reversed
+        for(int len=1;len<=3 && len<count;++len) {
+            for(int i=0;i+len<=count;++i) {
+                if(std::chrono::steady_clock::now() > deadline)
+                    return before - length();
+                const int last = i+len-1;
+                double gain = dist(i-1,i) + dist(last,last+1);
+                if(last+1<count || has_end)
+                    gain -= point(i-1).Distance(point(last+1));
+                double best = -tol;
+                int bestPos = -2;
+                bool bestReversed = false;
+                for(int k=-1;k<count;++k) {
+                    // insert between k and k+1
+                    if(k >= i-1 && k <= last)
+                        continue;
+                    const gp_Pnt &from = point(k);
+                    bool open = k+1>=count && !has_end;
+                    double removed = open?0.0:from.Distance(point(k+1));
+                    double forward = from.Distance(point(i))
+                        + (open?0.0:point(last).Distance(point(k+1))) - removed - gain;
+                    double backward = from.Distance(point(last))
+                        + (open?0.0:point(i).Distance(point(k+1))) - removed - gain;
+                    if(forward < best) {
+                        best = forward;
+                        bestPos = k;
+                        bestReversed = false;
+                    }
+                    if(backward < best) {
+                        best = backward;
+                        bestPos = k;
+                        bestReversed = true;
+                    }
+                }
+                if(bestPos == -2)
+                    continue;
+                if(bestReversed)
+                    std::reverse(order.begin()+i, order.begin()+last+1);
+                if(bestPos > last)
+                    std::rotate(order.begin()+i, order.begin()+last+1, order.begin()+bestPos+1);
+                else
+                    std::rotate(order.begin()+bestPos+1, order.begin()+i, order.begin()+last+1);
+                improved = true;
+            }
+        }
+    }
+    return before - length();
+}
+
+// Reorders the closed wires of a sorted group to shorten the rapid moves
+// between them. A closed wire starts and ends at the same point, so the
+// wires themselves are not changed. Open wires keep their place and split
+// the group into runs. Returns the distance saved.
+static double improveWireOrder(std::list<TopoDS_Shape> &wires, const gp_Pnt &pstart,
+        gp_Pnt &pentry, gp_Pnt &pend, const SortDeadline &deadline)
+{
+    std::vector<TopoDS_Shape> shapes(wires.begin(),wires.end());
+    std::vector<gp_Pnt> entries(shapes.size()), exits(shapes.size());
+    std::vector<bool> closed(shapes.size());
+    for(size_t i=0;i<shapes.size();++i) {
+        const TopoDS_Wire &wire = TopoDS::Wire(shapes[i]);
+        getEndPoints(wire,entries[i],exits[i]);
+        closed[i] = BRep_Tool::IsClosed(wire);
+    }
+
+    double saved = 0.0;
+    std::vector<size_t> order(shapes.size());
+    for(size_t i=0;i<order.size();++i)
+        order[i] = i;
+    for(size_t begin=0;begin<order.size();) {
+        if(!closed[begin]) {
+            ++begin;
+            continue;
+        }
+        size_t end = begin;
+        while(end<order.size() && closed[end])
+            ++end;
+        if(end-begin > 2) {
+            std::vector<size_t> run(order.begin()+begin,order.begin()+end);
+            saved += improveRun(run, entries, begin?exits[begin-1]:pstart,
+                    end<order.size(), end<order.size()?entries[end]:pstart, deadline);
+            std::copy(run.begin(),run.end(),order.begin()+begin);
+        }
+        begin = end;
+    }
+
+    wires.clear();
+    for(size_t i : order)
+        wires.push_back(shapes[i]);
+    pentry = entries[order.front()];
+    pend = exits[order.back()];
+    return saved;
+}
+
 std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
     bool has_start, gp_Pnt *_pstart, gp_Pnt *_pend,
     double *stepdown_hint, short *_parc_plane,
@@ -3040,6 +3401,10 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
     auto current_it = shape_list.end();
     double current_height = (pstart.*getter)();
     double max_dist = sort_mode==SortModeGreedy?threshold*threshold:0;
+    double saved = 0.0;
+    SortDeadline deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(std::max(improve_time,0.0)));
     while(shape_list.size()) {
         AREA_TRACE("sorting " << shape_list.size() << ' ' << AREA_XYZ(pstart));
         double best_d = DBL_MAX;
@@ -3049,6 +3414,8 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
             gp_Pnt pt;
             if(it->myPlanar && current_it==shape_list.end())
                 d = it->myPln.SquareDistance(pstart);
+            else if(it->boundDistance(pstart) >= best_d)
+                continue; // none of its wires can be nearer
             else
                 d = it->nearest(pstart);
             if(d < best_d) {
@@ -3073,8 +3440,11 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
             }
         }
 
-        wires.splice(wires.end(),
+        std::list<TopoDS_Shape> sorted(
             best_it->sortWires(pstart,pend,min_dist,max_dist,&pentry));
+        if(improve_time>0.0 && sorted.size()>2)
+            saved += improveWireOrder(sorted,pstart,pentry,pend,deadline);
+        wires.splice(wires.end(),sorted);
 
         if(use_bound && _pstart) {
             use_bound = false;
@@ -3116,6 +3486,8 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
     if(stepdown_hint && hint!=0.0)
         *stepdown_hint = hint;
     if(_pend) *_pend = pend;
+    if(improve_time>0.0)
+        AREA_LOG("sort improvement saved " << saved << " of rapid moves");
     FC_DURATION_LOG(rparams.bd,"rtree build");
     FC_DURATION_LOG(rparams.qd,"rtree query");
     FC_DURATION_LOG(rparams.rd,"rtree clean");
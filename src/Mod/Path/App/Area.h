@@ -131,14 +131,31 @@ protected:
     bool myHaveSolid;
     bool myShapeDone;
     bool myProjecting;
+    bool myCacheBuild;
     mutable int mySkippedShapes;
 
     static bool s_aborting;
     static AreaStaticParams s_params;
 
-    /** Called internally to combine children shapes for further processing */
+    struct BuildCacheEntry;
+    /** Results of build() shared between Area objects, most recently used first */
+    static std::list<std::shared_ptr<BuildCacheEntry> > s_buildCache;
+
+    /** Called internally to combine children shapes for further processing
+     *
+     * The projected and discretized children shapes (or the section shapes of
+     * solids) are shared with other Area objects having the same children shapes,
+     * work plane and build parameters, so that e.g. only changing the offset or
+     * stepover of an operation doesn't project its base shapes again.
+     */
     void build();
 
+    /** Restore the result of build() from the cache, returns false if not found */
+    bool restoreBuild();
+
+    /** Store the result of build() in the cache */
+    void storeBuild() const;
+
     /** Called by build() to add children shape
      *
      * Mainly for checking if there is any faces for auto fill*/
@@ -381,6 +398,9 @@ public:
     static void abort(bool aborting);
     static bool aborting();
 
+    /** Clear the results of build() shared between Area objects */
+    static void clearBuildCache();
+
     static void setDefaultParams(const AreaStaticParams &params);
     static const AreaStaticParams &getDefaultParams();
 
@@ -225,7 +225,11 @@
         "If two wire's end points are separated within this threshold, they are consider\n"\
         "as connected. You may want to set this to the tool diameter to keep the tool down.",\
         App::PropertyLength))\
-    ((enum, retract_axis, RetractAxis, 2,"Tool retraction axis",(X)(Y)(Z)))
+    ((enum, retract_axis, RetractAxis, 2,"Tool retraction axis",(X)(Y)(Z)))\
+    ((double, improve_time, SortImproveTime, 0.0,\
+        "Time limit in seconds to shorten the rapid moves of the sorted wires. Consecutive closed\n"\
+        "wires of each sorted group are reordered using 2-opt and Or-opt moves until no move helps\n"\
+        "or the time runs out. Open wires keep their place. 0 disables the improvement."))
 
 /** Area path generation parameters */
 #define AREA_PARAMS_PATH \
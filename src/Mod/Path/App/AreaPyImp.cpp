@@ -78,6 +78,14 @@ static PyObject * areaSetParams(PyObject *, PyObject *args, PyObject *kwd) {
     return Py_None;
 }
 
+static PyObject* areaClearBuildCache(PyObject *, PyObject *args) {
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+    Area::clearBuildCache();
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyObject* areaGetParams(PyObject *, PyObject *args) {
     if (!PyArg_ParseTuple(args, ""))
         return 0;
@@ -163,6 +171,11 @@ static const PyMethodDef areaOverrides[] = {
         "\nTo ensure no stray abortion is left in the previous operation, it is advised to manually clear\n"
         "the aborting flag by calling abort(False) before starting a new operation.",
     },
+    {
+        "clearBuildCache",(PyCFunction)areaClearBuildCache, METH_VARARGS|METH_STATIC,
+        "clearBuildCache(): Static method to release the projected children shapes shared\n"
+        "between Area objects with the same shapes, work plane and build parameters."
+    },
     {
         "getParamsDesc",reinterpret_cast<PyCFunction>(reinterpret_cast<void (*) (void)>(areaGetParamsDesc)), METH_VARARGS|METH_KEYWORDS|METH_STATIC,
         "getParamsDesc(as_string=False): Returns a list of supported parameters and their descriptions.\n"
@@ -439,6 +452,10 @@ PyObject* AreaPy::abort(PyObject *, PyObject *) {
     return 0;
 }
 
+PyObject* AreaPy::clearBuildCache(PyObject *) {
+    return 0;
+}
+
 PyObject* AreaPy::getParamsDesc(PyObject *, PyObject *)
 {
     return 0;
@@ -98,11 +98,30 @@ bool Command::has(const std::string& attr) const
     return Parameters.count(a) > 0;
 }
 
+static void appendInteger(std::string &out, std::int64_t v, int width = 0)
+{
+    char buf[24];
+    char *end = buf + sizeof(buf);
+    char *p = end;
+    do {
+        *--p = static_cast<char>('0' + v%10);
+        v /= 10;
+    } while (v);
+    while (end - p < width)
+        *--p = '0';
+    out.append(p, end - p);
+}
+
 std::string Command::toGCode (int precision, bool padzero) const
 {
-    std::stringstream str;
-    str.fill('0');
-    str << Name;
+    std::string str;
+    appendGCode(str, precision, padzero);
+    return str;
+}
+
+void Command::appendGCode (std::string &str, int precision, bool padzero) const
+{
+    str += Name;
     if(precision<0)
         precision = 0;
     double scale = std::pow(10.0,precision+1);
@@ -110,16 +129,17 @@ std::string Command::toGCode (int precision, bool padzero) const
     for(std::map<std::string,double>::const_iterator i = Parameters.begin(); i != Parameters.end(); ++i) {
         if(i->first == "N") continue;
 
-        str << " " << i->first;
+        str += ' ';
+        str += i->first;
 
         std::int64_t v = static_cast<std::int64_t>(i->second*scale);
         if(v<0) {
             v = -v;
-            str << '-'; //shall we allow -0 ?
+            str += '-'; //shall we allow -0 ?
         }
         v+=5;
         v /= 10;
-        str << (v/iscale);
+        appendInteger(str, v/iscale);
         if(!precision) continue;
 
         int width = precision;
@@ -131,71 +151,73 @@ std::string Command::toGCode (int precision, bool padzero) const
                 --width;
             }
         }
-        str << '.' << std::setw(width) << std::right << digits;
+        str += '.';
+        appendInteger(str, digits, width);
     }
-    return str.str();
 }
 
 void Command::setFromGCode (const std::string& str)
 {
+    setFromGCode(str.c_str(), str.size());
+}
+
+void Command::setFromGCode (const char *str, std::size_t len)
+{
+    enum { None, Cmd, Argument, Comment } mode = None;
+
     Parameters.clear();
-    std::string mode = "none";
     std::string key;
     std::string value;
-    for (unsigned int i=0; i < str.size(); i++) {
-        if ( (isdigit(str[i])) || (str[i] == '-') || (str[i] == '.') ) {
-            value += str[i];
-        } else if (isalpha(str[i])) {
-            if (mode == "command") {
+    for (std::size_t i=0; i < len; i++) {
+        const char c = str[i];
+        if ( (isdigit(c)) || (c == '-') || (c == '.') ) {
+            value += c;
+        } else if (isalpha(c)) {
+            if (mode == Cmd) {
                 if (!key.empty() && !value.empty()) {
-                    std::string cmd = key + value;
-                    boost::to_upper(cmd);
-                    Name = cmd;
-                    key = "";
-                    value = "";
-                    mode = "argument";
+                    Name = key;
+                    boost::to_upper(Name);
+                    Name += value;
+                    value.clear();
                 } else {
                     throw Base::BadFormatError("Badly formatted GCode command");
                 }
-                mode = "argument";
-            } else if (mode == "none") {
-                mode = "command";
-            } else if (mode == "argument") {
+                mode = Argument;
+            } else if (mode == None) {
+                mode = Cmd;
+            } else if (mode == Argument) {
                 if (!key.empty() && !value.empty()) {
-                    double val = std::atof(value.c_str());
                     boost::to_upper(key);
-                    Parameters[key] = val;
-                    key = "";
-                    value = "";
+                    Parameters[key] = std::atof(value.c_str());
+                    value.clear();
                 } else {
                     throw Base::BadFormatError("Badly formatted GCode argument");
                 }
-            } else if (mode == "comment") {
-                value += str[i];
+            } else if (mode == Comment) {
+                value += c;
             }
-            key = str[i];
-        } else if (str[i] == '(') {
-            mode = "comment";
-        } else if (str[i] == ')') {
+            key.assign(1, c);
+        } else if (c == '(') {
+            mode = Comment;
+        } else if (c == ')') {
             key = "(";
-            value += ")";
+            value += ')';
         } else {
             // add non-ascii characters only if this is a comment
-            if (mode == "comment") {
-                value += str[i];
+            if (mode == Comment) {
+                value += c;
             }
         }
     }
     if (!key.empty() && !value.empty()) {
-        if ( (mode == "command") || (mode == "comment") ) {
-            std::string cmd = key + value;
-            if (mode == "command")
-                boost::to_upper(cmd);
-            Name = cmd;
+        if ( (mode == Cmd) || (mode == Comment) ) {
+            Name = key;
+            if (mode == Cmd)
+                boost::to_upper(Name);
+            Name += value;
         } else {
-            double val = std::atof(value.c_str());
             boost::to_upper(key);
-            Parameters[key] = val;
+            Parameters[key] = std::atof(value.c_str());
         }
     } else {
         throw Base::BadFormatError("Badly formatted GCode argument");
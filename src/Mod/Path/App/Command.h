@@ -53,7 +53,9 @@ namespace Path
         Base::Vector3d getCenter (void) const; // returns a 3d vector from the i,j,k parameters
         void setCenter(const Base::Vector3d&, bool clockwise=true); // sets the center coordinates and the command name
         std::string toGCode (int precision=6, bool padzero=true) const; // returns a GCode string representation of the command
+        void appendGCode (std::string&, int precision=6, bool padzero=true) const; // appends the GCode representation of the command to the given string
         void setFromGCode (const std::string&); // sets the parameters from the contents of the given GCode string
+        void setFromGCode (const char*, std::size_t); // sets the parameters from the given GCode characters
         void setFromPlacement (const Base::Placement&); // sets the parameters from the contents of the given placement
         bool has(const std::string&) const; // returns true if the given string exists in the parameters
         Command transform(const Base::Placement&); // returns a transformed copy of this command
@@ -50,20 +50,19 @@ using namespace Base;
 TYPESYSTEM_SOURCE(Path::Toolpath , Base::Persistence)
 
 Toolpath::Toolpath()
+    : vpcCommands(makeCommands())
 {
 }
 
 Toolpath::Toolpath(const Toolpath& otherPath)
-    : vpcCommands(otherPath.vpcCommands.size())
+    : vpcCommands(otherPath.vpcCommands)
     , center(otherPath.center)
 {
-    *this = otherPath;
     recalculate();
 }
 
 Toolpath::~Toolpath()
 {
-    clear();
 }
 
 Toolpath &Toolpath::operator=(const Toolpath& otherPath)
@@ -71,29 +70,45 @@ Toolpath &Toolpath::operator=(const Toolpath& otherPath)
     if (this == &otherPath)
         return *this;
 
-    clear();
-    vpcCommands.resize(otherPath.vpcCommands.size());
-    int i = 0;
-    for (std::vector<Command*>::const_iterator it=otherPath.vpcCommands.begin();it!=otherPath.vpcCommands.end();++it,i++) {
-        vpcCommands[i] = new Command(**it);
-    }
+    // the commands are only copied once one of the paths gets modified
+    vpcCommands = otherPath.vpcCommands;
     center = otherPath.center;
     recalculate();
     return *this;
 }
 
+std::shared_ptr<Toolpath::CommandList> Toolpath::makeCommands(void)
+{
+    return std::shared_ptr<CommandList>(new CommandList(), [](CommandList *commands) {
+        for (std::vector<Command*>::iterator it = commands->begin(); it != commands->end(); ++it)
+            delete ( *it );
+        delete commands;
+    });
+}
+
+Toolpath::CommandList &Toolpath::modifyCommands(void)
+{
+    if (vpcCommands.use_count() > 1) {
+        std::shared_ptr<CommandList> copy = makeCommands();
+        copy->reserve(vpcCommands->size());
+        for (std::vector<Command*>::const_iterator it = vpcCommands->begin(); it != vpcCommands->end(); ++it)
+            copy->push_back(new Command(**it));
+        vpcCommands = copy;
+    }
+    return *vpcCommands;
+}
+
 void Toolpath::clear(void)
 {
-    for(std::vector<Command*>::iterator it = vpcCommands.begin();it!=vpcCommands.end();++it)
-        delete ( *it );
-    vpcCommands.clear();
+    // other paths may still hold the old commands
+    vpcCommands = makeCommands();
     recalculate();
 }
 
 void Toolpath::addCommand(const Command &Cmd)
 {
     Command *tmp = new Command(Cmd);
-    vpcCommands.push_back(tmp);
+    modifyCommands().push_back(tmp);
     recalculate();
 }
 
@@ -101,9 +116,10 @@ void Toolpath::insertCommand(const Command &Cmd, int pos)
 {
     if (pos == -1) {
         addCommand(Cmd);
-    } else if (pos <= static_cast<int>(vpcCommands.size())) {
+    } else if (pos <= static_cast<int>(vpcCommands->size())) {
+        CommandList &commands = modifyCommands();
         Command *tmp = new Command(Cmd);
-        vpcCommands.insert(vpcCommands.begin()+pos,tmp);
+        commands.insert(commands.begin()+pos,tmp);
     } else {
         throw Base::IndexError("Index not in range");
     }
@@ -114,9 +130,10 @@ void Toolpath::deleteCommand(int pos)
 {
     if (pos == -1) {
         //delete(*vpcCommands.rbegin()); // causes crash
-        vpcCommands.pop_back();
-    } else if (pos <= static_cast<int>(vpcCommands.size())) {
-        vpcCommands.erase (vpcCommands.begin()+pos);
+        modifyCommands().pop_back();
+    } else if (pos <= static_cast<int>(vpcCommands->size())) {
+        CommandList &commands = modifyCommands();
+        commands.erase (commands.begin()+pos);
     } else {
         throw Base::IndexError("Index not in range");
     }
@@ -125,12 +142,12 @@ void Toolpath::deleteCommand(int pos)
 
 double Toolpath::getLength()
 {
-    if(vpcCommands.size()==0)
+    if(vpcCommands->size()==0)
         return 0;
     double l = 0;
     Vector3d last(0,0,0);
     Vector3d next;
-    for(std::vector<Command*>::const_iterator it = vpcCommands.begin();it!=vpcCommands.end();++it) {
+    for(std::vector<Command*>::const_iterator it = vpcCommands->begin();it!=vpcCommands->end();++it) {
         std::string name = (*it)->Name;
         next = (*it)->getPlacement(last).getPosition();
         if ( (name == "G0") || (name == "G00") || (name == "G1") || (name == "G01") ) {
@@ -168,7 +185,7 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
         vRapid = vFeed;
     }
 
-    if (vpcCommands.size() == 0) {
+    if (vpcCommands->size() == 0) {
         return 0;
     }
     double l = 0;
@@ -176,7 +193,7 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
     bool verticalMove = false;
     Vector3d last(0,0,0);
     Vector3d next;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin();it!=vpcCommands.end();++it) {
+    for (std::vector<Command*>::const_iterator it = vpcCommands->begin();it!=vpcCommands->end();++it) {
         std::string name = (*it)->Name;
         float feedrate = (*it)->getParam("F");
 
@@ -286,10 +303,16 @@ Base::BoundBox3d Toolpath::getBoundBox() const
     return visitor.bb;
 }
 
-static void bulkAddCommand(const std::string &gcodestr, std::vector<Command*> &commands, bool &inches)
+static void bulkAddCommand(const char *gcodestr, std::size_t len, std::vector<Command*> &commands, bool &inches)
 {
     Command *cmd = new Command();
-    cmd->setFromGCode(gcodestr);
+    try {
+        cmd->setFromGCode(gcodestr, len);
+    }
+    catch (...) {
+        delete cmd;
+        throw;
+    }
     if ("G20" == cmd->Name) {
         inches = true;
         delete cmd;
@@ -304,54 +327,54 @@ static void bulkAddCommand(const std::string &gcodestr, std::vector<Command*> &c
     }
 }
 
-void Toolpath::setFromGCode(const std::string instr)
+void Toolpath::setFromGCode(const std::string &str)
 {
     clear();
 
     // remove comments
     //boost::regex e("\\(.*?\\)");
     //std::string str = boost::regex_replace(instr, e, "");
-    std::string str(instr);
 
-    // split input string by () or G or M commands
-    std::string mode = "command";
+    CommandList &commands = modifyCommands();
+
+    // split input string by () or G or M commands, the commands are parsed
+    // in place so that large programs are not copied piece by piece
+    const char *data = str.c_str();
+    const std::size_t none = std::string::npos;
+    bool comment = false;
     std::size_t found = str.find_first_of("(gGmM");
-    int last = -1;
+    std::size_t last = none;
     bool inches = false;
-    while (found != std::string::npos)
+    while (found != none)
     {
         if (str[found] == '(') {
             // start of comment
-            if ( (last > -1) && (mode == "command") ) {
+            if ( (last != none) && !comment ) {
                 // before opening a comment, add the last found command
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+                bulkAddCommand(data+last, found-last, commands, inches);
             }
-            mode = "comment";
+            comment = true;
             last = found;
             found = str.find_first_of(')', found+1);
         } else if (str[found] == ')') {
             // end of comment
-            std::string gcodestr = str.substr(last, found-last+1);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-            last = -1;
+            bulkAddCommand(data+last, found-last+1, commands, inches);
+            last = none;
             found = str.find_first_of("(gGmM", found+1);
-            mode = "command";
-        } else if (mode == "command") {
+            comment = false;
+        } else if (!comment) {
             // command
-            if (last > -1) {
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+            if (last != none) {
+                bulkAddCommand(data+last, found-last, commands, inches);
             }
             last = found;
             found = str.find_first_of("(gGmM", found+1);
         }
     }
     // add the last command found, if any
-    if (last > -1) {
-        if (mode == "command") {
-            std::string gcodestr = str.substr(last,std::string::npos);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
+    if (last != none) {
+        if (!comment) {
+            bulkAddCommand(data+last, str.size()-last, commands, inches);
         }
     }
     recalculate();
@@ -360,17 +383,35 @@ void Toolpath::setFromGCode(const std::string instr)
 std::string Toolpath::toGCode(void) const
 {
     std::string result;
-    for (std::vector<Command*>::const_iterator it=vpcCommands.begin();it!=vpcCommands.end();++it) {
-        result += (*it)->toGCode();
-        result += "\n";
+    result.reserve(vpcCommands->size() * 32);
+    for (std::vector<Command*>::const_iterator it=vpcCommands->begin();it!=vpcCommands->end();++it) {
+        (*it)->appendGCode(result);
+        result += '\n';
     }
     return result;
 }
 
+void Toolpath::toGCode(std::ostream &out) const
+{
+    // format into a reused buffer and write it out in blocks, so that no
+    // string of the whole program is needed
+    std::string buffer;
+    buffer.reserve(0x20000);
+    for (std::vector<Command*>::const_iterator it=vpcCommands->begin();it!=vpcCommands->end();++it) {
+        (*it)->appendGCode(buffer);
+        buffer += '\n';
+        if (buffer.size() >= 0x10000) {
+            out.write(buffer.c_str(), buffer.size());
+            buffer.clear();
+        }
+    }
+    out.write(buffer.c_str(), buffer.size());
+}
+
 void Toolpath::recalculate(void) // recalculates the path cache
 {
 
-    if(vpcCommands.size()==0)
+    if(vpcCommands->size()==0)
         return;
 
     // TODO recalculate the KDL stuff. At the moment, this is unused.
@@ -389,7 +430,7 @@ void Toolpath::recalculate(void) // recalculates the path cache
         // handle the first waypoint differently
         bool first=true;
 
-        for(std::vector<Command*>::const_iterator it = vpcCommands.begin();it!=vpcCommands.end();++it) {
+        for(std::vector<Command*>::const_iterator it = vpcCommands->begin();it!=vpcCommands->end();++it) {
             if(first){
                 Last = toFrame((*it)->getPlacement());
                 first = false;
@@ -434,7 +475,10 @@ void Toolpath::recalculate(void) // recalculates the path cache
 
 unsigned int Toolpath::getMemSize (void) const
 {
-    return toGCode().size();
+    unsigned int size = 0;
+    for (std::vector<Command*>::const_iterator it = vpcCommands->begin(); it != vpcCommands->end(); ++it)
+        size += (*it)->getMemSize();
+    return size;
 }
 
 void Toolpath::setCenter(const Base::Vector3d &c)
@@ -455,7 +499,7 @@ void Toolpath::Save (Writer &writer) const
         writer.incInd();
         saveCenter(writer, center);
         for(unsigned int i = 0; i < getSize(); i++) {
-            vpcCommands[i]->Save(writer);
+            (*vpcCommands)[i]->Save(writer);
         }
         writer.decInd();
     } else {
@@ -470,9 +514,9 @@ void Toolpath::Save (Writer &writer) const
 
 void Toolpath::SaveDocFile (Base::Writer &writer) const
 {
-    if (toGCode().empty())
+    if (vpcCommands->empty())
         return;
-    writer.Stream() << toGCode();
+    toGCode(writer.Stream());
 }
 
 void Toolpath::Restore(XMLReader &reader)
@@ -24,6 +24,8 @@
 #ifndef PATH_Path_H
 #define PATH_Path_H
 
+#include <memory>
+
 #include "Command.h"
 //#include "Mod/Robot/App/kdl_cp/path_composite.hpp"
 //#include "Mod/Robot/App/kdl_cp/frames_io.hpp"
@@ -62,14 +64,17 @@ namespace Path
             double getLength(void); // return the Length (mm) of the Path
             double getCycleTime(double, double, double, double); // return the Cycle Time (s) of the Path
             void recalculate(void); // recalculates the points
-            void setFromGCode(const std::string); // sets the path from the contents of the given GCode string
+            void setFromGCode(const std::string&); // sets the path from the contents of the given GCode string
             std::string toGCode(void) const; // gets a gcode string representation from the Path
+            void toGCode(std::ostream&) const; // writes the gcode representation of the Path to the given stream
             Base::BoundBox3d getBoundBox(void) const;
             
             // shortcut functions
-            unsigned int getSize(void) const { return vpcCommands.size(); }
-            const std::vector<Command*> &getCommands(void) const { return vpcCommands; }
-            const Command &getCommand(unsigned int pos)    const { return *vpcCommands[pos]; }
+            unsigned int getSize(void) const { return vpcCommands->size(); }
+            // the commands are shared between copies of a toolpath until one
+            // of them is modified, so change them only through this interface
+            const std::vector<Command*> &getCommands(void) const { return *vpcCommands; }
+            const Command &getCommand(unsigned int pos)    const { return *(*vpcCommands)[pos]; }
         
             // support for rotation
             const Base::Vector3d& getCenter() const { return center; }
@@ -78,7 +83,11 @@ namespace Path
             static const int SchemaVersion = 2;
 
         protected:
-            std::vector<Command*> vpcCommands;
+            typedef std::vector<Command*> CommandList;
+            static std::shared_ptr<CommandList> makeCommands(void);
+            CommandList &modifyCommands(void); // unshares the commands before a change
+
+            std::shared_ptr<CommandList> vpcCommands;
             Base::Vector3d center;
             //KDL::Path_Composite *pcPath;
             
@@ -52,6 +52,7 @@
 #include <set>
 #include <bitset>
 #include <cctype>
+#include <chrono>
 
 #include <cinttypes>
 #include <iomanip>
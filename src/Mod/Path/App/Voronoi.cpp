@@ -35,6 +35,7 @@
 #include <Base/Writer.h>
 #include <Base/Reader.h>
 #include <Base/Exception.h>
+#include <Base/ThreadPool.h>
 #include "Voronoi.h"
 
 using namespace Base;
@@ -72,46 +73,23 @@ Base::Vector3d Voronoi::diagram_type::scaledVector(const vertex_type &v, double
 }
 
 
-int Voronoi::diagram_type::index(const Voronoi::diagram_type::cell_type   *cell)   const {
-  auto it = cell_index.find(intptr_t(cell));
-  if (it == cell_index.end()) {
+// The elements are stored in vectors, their index is the offset into them
+template<typename T>
+static int indexOf(const std::vector<T> &elements, const T *element) {
+  if (elements.empty() || element < &elements.front() || element > &elements.back()) {
     return Voronoi::InvalidIndex;
   }
-  return it->second;
+  return int(element - &elements.front());
+}
+
+int Voronoi::diagram_type::index(const Voronoi::diagram_type::cell_type   *cell)   const {
+  return indexOf(cells(), cell);
 }
 int Voronoi::diagram_type::index(const Voronoi::diagram_type::edge_type   *edge)   const {
-  auto it = edge_index.find(intptr_t(edge));
-  if (it == edge_index.end()) {
-    return Voronoi::InvalidIndex;
-  }
-  return it->second;
+  return indexOf(edges(), edge);
 }
 int Voronoi::diagram_type::index(const Voronoi::diagram_type::vertex_type *vertex) const {
-  auto it = vertex_index.find(intptr_t(vertex));
-  if (it == vertex_index.end()) {
-    return Voronoi::InvalidIndex;
-  }
-  return it->second;
-}
-
-void Voronoi::diagram_type::reIndex() {
-  int idx = 0;
-  cell_index.clear();
-  edge_index.clear();
-  vertex_index.clear();
-
-  idx = 0;
-  for (auto it = cells().begin(); it != cells().end(); ++it, ++idx) {
-    cell_index[intptr_t(&(*it))] = idx;
-  }
-  idx = 0;
-  for (auto it = edges().begin(); it != edges().end(); ++it, ++idx) {
-    edge_index[intptr_t(&(*it))] = idx;
-  }
-  idx = 0;
-  for (auto it = vertices().begin(); it != vertices().end(); ++it, ++idx) {
-    vertex_index[intptr_t(&(*it))] = idx;
-  }
+  return indexOf(vertices(), vertex);
 }
 
 Voronoi::point_type Voronoi::diagram_type::retrievePoint(const Voronoi::diagram_type::cell_type *cell) const {
@@ -187,26 +165,30 @@ void Voronoi::construct()
 {
   vd->clear();
   construct_voronoi(vd->points.begin(), vd->points.end(), vd->segments.begin(), vd->segments.end(), (voronoi_diagram_type*)vd);
-  vd->reIndex();
 }
 
 void Voronoi::colorExterior(const Voronoi::diagram_type::edge_type *edge, std::size_t colorValue) {
-  if (edge->color()) {
-    // end recursion
-    return;
-  }
-  edge->color(colorValue);
-  edge->twin()->color(colorValue);
-  auto v = edge->vertex1();
-  if (v == NULL || !edge->is_primary()) {
-    return;
+  // depth first walk with an explicit stack, large diagrams overflow the call stack otherwise
+  std::vector<const Voronoi::diagram_type::edge_type*> stack(1, edge);
+  while (!stack.empty()) {
+    edge = stack.back();
+    stack.pop_back();
+    if (edge->color()) {
+      continue;
+    }
+    edge->color(colorValue);
+    edge->twin()->color(colorValue);
+    auto v = edge->vertex1();
+    if (v == NULL || !edge->is_primary()) {
+      continue;
+    }
+    v->color(colorValue);
+    auto e = v->incident_edge();
+    do {
+      stack.push_back(e);
+      e = e->rot_next();
+    } while (e != v->incident_edge());
   }
-  v->color(colorValue);
-  auto e = v->incident_edge();
-  do {
-    colorExterior(e, colorValue);
-    e = e->rot_next();
-  } while (e != v->incident_edge());
 }
 
 void Voronoi::colorExterior(Voronoi::color_type color) {
@@ -266,29 +248,41 @@ bool Voronoi::diagram_type::segmentsAreConnected(int i, int j) const {
 void Voronoi::colorColinear(Voronoi::color_type color, double degree) {
   double rad = degree * M_PI / 180;
 
-  Voronoi::diagram_type::angle_map_t angle;
   int psize = vd->points.size();
-
-  for (diagram_type::const_edge_iterator it = vd->edges().begin(); it != vd->edges().end(); ++it) {
-    int i0 = it->cell()->source_index() - psize;
-    int i1 = it->twin()->cell()->source_index() - psize;
-    if (it->color() == 0
-        && it->cell()->contains_segment()
-        && it->twin()->cell()->contains_segment()
-        && vd->segmentsAreConnected(i0, i1)) {
-      double a0 = vd->angleOfSegment(i0, &angle);
-      double a1 = vd->angleOfSegment(i1, &angle);
-      double a = a0 - a1;
-      if (a > M_PI_2) {
-        a -= M_PI;
-      } else if (a < -M_PI_2) {
-        a += M_PI;
-      }
-      if (fabs(a) < rad) {
-        it->color(color);
-        it->twin()->color(color);
+  int ssize = vd->segments.size();
+  std::vector<double> angle(ssize);
+  Base::parallel_for(0, ssize, [&](int i) {
+    angle[i] = vd->angleOfSegment(i);
+  });
+
+  // The edges are only tested in parallel, the color shares its storage with the
+  // flags of the edge and is assigned afterwards.
+  const auto &edges = vd->edges();
+  std::vector<char> colinear(edges.size(), 0);
+  Base::parallel_for(std::size_t(0), edges.size(), [&](std::size_t idx) {
+    const diagram_type::edge_type &edge = edges[idx];
+    if (edge.color() == 0
+        && edge.cell()->contains_segment()
+        && edge.twin()->cell()->contains_segment()) {
+      int i0 = edge.cell()->source_index() - psize;
+      int i1 = edge.twin()->cell()->source_index() - psize;
+      if (vd->segmentsAreConnected(i0, i1)) {
+        double a = angle[i0] - angle[i1];
+        if (a > M_PI_2) {
+          a -= M_PI;
+        } else if (a < -M_PI_2) {
+          a += M_PI;
+        }
+        colinear[idx] = fabs(a) < rad;
       }
     }
+  });
+
+  for (std::size_t idx = 0; idx < edges.size(); ++idx) {
+    if (colinear[idx]) {
+      edges[idx].color(color);
+      edges[idx].twin()->color(color);
+    }
   }
 }
 
@@ -77,16 +77,10 @@ namespace Path
       Base::Vector3d scaledVector(const point_type &p, double z) const;
       Base::Vector3d scaledVector(const vertex_type &v, double z) const;
 
-      typedef std::map<intptr_t, int> cell_map_type;
-      typedef std::map<intptr_t, int> edge_map_type;
-      typedef std::map<intptr_t, int> vertex_map_type;
-
       int index(const cell_type   *cell)   const;
       int index(const edge_type   *edge)   const;
       int index(const vertex_type *vertex) const;
 
-      void reIndex();
-
       std::vector<point_type>       points;
       std::vector<segment_type>     segments;
 
@@ -99,9 +93,6 @@ namespace Path
 
     private:
       double          scale;
-      cell_map_type   cell_index;
-      edge_map_type   edge_index;
-      vertex_map_type vertex_index;
     };
 
     void addPoint(const point_type &p);
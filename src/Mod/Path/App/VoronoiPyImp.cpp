@@ -333,6 +333,39 @@ PyObject* VoronoiPy::numSegments(PyObject *args)
   return PyLong_FromLong(getVoronoiPtr()->vd->segments.size());
 }
 
+PyObject* VoronoiPy::getVertexPoints(PyObject *args) {
+  double z = 0;
+  if (!PyArg_ParseTuple(args, "|d", &z)) {
+    throw Py::RuntimeError("Optional z argument (double) accepted");
+  }
+  Voronoi *vo = getVoronoiPtr();
+  Py::List list(vo->vd->vertices().size());
+  int i = 0;
+  for (auto it = vo->vd->vertices().begin(); it != vo->vd->vertices().end(); ++it, ++i) {
+    list.setItem(i, Py::asObject(new Base::VectorPy(new Base::Vector3d(vo->vd->scaledVector(*it, z)))));
+  }
+  return Py::new_reference_to(list);
+}
+
+PyObject* VoronoiPy::getEdgeData(PyObject *args) {
+  if (!PyArg_ParseTuple(args, "")) {
+    throw  Py::RuntimeError("no arguments accepted");
+  }
+  Voronoi *vo = getVoronoiPtr();
+  Py::List list(vo->vd->edges().size());
+  int i = 0;
+  for (auto it = vo->vd->edges().begin(); it != vo->vd->edges().end(); ++it, ++i) {
+    Py::Tuple tp(6);
+    tp.setItem(0, Py::Long(it->vertex0() ? vo->vd->index(it->vertex0()) : -1));
+    tp.setItem(1, Py::Long(it->vertex1() ? vo->vd->index(it->vertex1()) : -1));
+    tp.setItem(2, Py::Long(vo->vd->index(it->twin())));
+    tp.setItem(3, Py::Long(PyLong_FromSize_t(it->color() & Voronoi::ColorMask), true));
+    tp.setItem(4, Py::Boolean(it->is_primary()));
+    tp.setItem(5, Py::Boolean(it->is_linear()));
+    list.setItem(i, tp);
+  }
+  return Py::new_reference_to(list);
+}
 
 // custom attributes get/set
 
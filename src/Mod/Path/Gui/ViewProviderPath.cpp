@@ -24,7 +24,9 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <Python.h>
+# include <Inventor/SbBox3f.h>
 # include <Inventor/SbVec3f.h>
 # include <Inventor/nodes/SoSeparator.h>
 # include <Inventor/nodes/SoTransform.h>
@@ -35,6 +37,8 @@
 # include <Inventor/nodes/SoCoordinate3.h>
 # include <Inventor/nodes/SoDrawStyle.h>
 # include <Inventor/nodes/SoIndexedLineSet.h>
+# include <Inventor/nodes/SoLOD.h>
+# include <Inventor/nodes/SoPickStyle.h>
 # include <Inventor/nodes/SoPointSet.h>
 # include <Inventor/nodes/SoShapeHints.h>
 # include <Inventor/details/SoLineDetail.h>
@@ -142,7 +146,7 @@ public:
 PROPERTY_SOURCE(PathGui::ViewProviderPath, Gui::ViewProviderGeometryObject)
 
 ViewProviderPath::ViewProviderPath()
-    :pt0Index(-1),blockPropertyChange(false),edgeStart(-1),coordStart(-1),coordEnd(-1)
+    :pt0Index(-1),blockPropertyChange(false),edgeStart(-1),edgeEnd(-1),coordStart(-1),coordEnd(-1)
 {
     ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Path");
     unsigned long lcol = hGrp->GetUnsigned("DefaultNormalPathColor",11141375UL); // dark green (0,170,0)
@@ -197,6 +201,14 @@ ViewProviderPath::ViewProviderPath()
     pcLineColor = new SoMaterial;
     pcLineColor->ref();
 
+    // decimated lines for distant views of large paths, they can't be picked
+    pcLineLOD = new SoLOD;
+    pcLineLOD->ref();
+    pcLinesLOD = new SoIndexedLineSet;
+    pcLinesLOD->ref();
+    pcLineColorLOD = new SoMaterial;
+    pcLineColorLOD->ref();
+
     pcMatBind = new SoMaterialBinding;
     pcMatBind->ref();
     pcMatBind->value = SoMaterialBinding::OVERALL;
@@ -241,6 +253,12 @@ ViewProviderPath::ViewProviderPath()
 
 ViewProviderPath::~ViewProviderPath()
 {
+    // the fields point into buffers of this class
+    pcLines->coordIndex.setNum(0);
+    pcLinesLOD->coordIndex.setNum(0);
+    pcLineColor->diffuseColor.setNum(0);
+    pcLineColorLOD->diffuseColor.setNum(0);
+
     pcLineCoords->unref();
     pcMarkerCoords->unref();
     pcMarkerSwitch->unref();
@@ -248,6 +266,9 @@ ViewProviderPath::~ViewProviderPath()
     pcMarkerStyle->unref();
     pcLines->unref();
     pcLineColor->unref();
+    pcLineLOD->unref();
+    pcLinesLOD->unref();
+    pcLineColorLOD->unref();
     pcMatBind->unref();
     pcMarkerColor->unref();
     pcArrowSwitch->unref();
@@ -259,11 +280,23 @@ void ViewProviderPath::attach(App::DocumentObject *pcObj)
 
     // Draw trajectory lines
     SoSeparator* linesep = new SoSeparator;
-    linesep->addChild(pcLineColor);
     linesep->addChild(pcMatBind);
     linesep->addChild(pcDrawStyle);
     linesep->addChild(pcLineCoords);
-    linesep->addChild(pcLines);
+    linesep->addChild(pcLineLOD);
+
+    SoSeparator* fullsep = new SoSeparator;
+    fullsep->addChild(pcLineColor);
+    fullsep->addChild(pcLines);
+    pcLineLOD->addChild(fullsep);
+
+    SoSeparator* lodsep = new SoSeparator;
+    SoPickStyle* lodPickStyle = new SoPickStyle;
+    lodPickStyle->style = SoPickStyle::UNPICKABLE;
+    lodsep->addChild(lodPickStyle);
+    lodsep->addChild(pcLineColorLOD);
+    lodsep->addChild(pcLinesLOD);
+    pcLineLOD->addChild(lodsep);
 
     // Draw markers
     SoSeparator* markersep = new SoSeparator;
@@ -345,38 +378,8 @@ void ViewProviderPath::onChanged(const App::Property* prop)
     if (prop == &LineWidth) {
         pcDrawStyle->lineWidth = LineWidth.getValue();
     } else if (prop == &NormalColor) {
-        if (colorindex.size() > 0 && coordStart>=0 && coordStart<(int)colorindex.size()) {
-            const App::Color& c = NormalColor.getValue();
-            ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Path");
-            unsigned long rcol = hGrp->GetUnsigned("DefaultRapidPathColor",2852126975UL); // dark red (170,0,0)
-            float rr,rg,rb;
-            rr = ((rcol >> 24) & 0xff) / 255.0; rg = ((rcol >> 16) & 0xff) / 255.0; rb = ((rcol >> 8) & 0xff) / 255.0;
-
-            unsigned long pcol = hGrp->GetUnsigned("DefaultProbePathColor",4293591295UL); // yellow (255,255,5)
-            float pr,pg,pb;
-            pr = ((pcol >> 24) & 0xff) / 255.0; pg = ((pcol >> 16) & 0xff) / 255.0; pb = ((pcol >> 8) & 0xff) / 255.0;
-
-            pcMatBind->value = SoMaterialBinding::PER_PART;
-            // resizing and writing the color vector:
-
-            int count = coordEnd-coordStart;
-            if(count > (int)colorindex.size()-coordStart) count = colorindex.size()-coordStart;
-            pcLineColor->diffuseColor.setNum(count);
-            SbColor* colors = pcLineColor->diffuseColor.startEditing();
-            for(int i=0;i<count;i++) {
-                switch(colorindex[i+coordStart]){
-                case 0:
-                    colors[i] = SbColor(rr,rg,rb);
-                    break;
-                case 1:
-                    colors[i] = SbColor(c.r,c.g,c.b);
-                    break;
-                default:
-                    colors[i] = SbColor(pr,pg,pb);
-                }
-            }
-            pcLineColor->diffuseColor.finishEditing();
-        }
+        updateColors();
+        showColorRange();
     } else if (prop == &MarkerColor) {
         const App::Color& c = MarkerColor.getValue();
         pcMarkerColor->rgb.setValue(c.r,c.g,c.b);
@@ -599,13 +602,126 @@ private:
     }
 };
 
+void ViewProviderPath::updateColors()
+{
+    // detach the fields before the buffers change
+    pcLineColor->diffuseColor.setNum(0);
+    pcLineColorLOD->diffuseColor.setNum(0);
+
+    const App::Color& c = NormalColor.getValue();
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Path");
+    unsigned long rcol = hGrp->GetUnsigned("DefaultRapidPathColor",2852126975UL); // dark red (170,0,0)
+    float rr,rg,rb;
+    rr = ((rcol >> 24) & 0xff) / 255.0; rg = ((rcol >> 16) & 0xff) / 255.0; rb = ((rcol >> 8) & 0xff) / 255.0;
+
+    unsigned long pcol = hGrp->GetUnsigned("DefaultProbePathColor",4293591295UL); // yellow (255,255,5)
+    float pr,pg,pb;
+    pr = ((pcol >> 24) & 0xff) / 255.0; pg = ((pcol >> 16) & 0xff) / 255.0; pb = ((pcol >> 8) & 0xff) / 255.0;
+
+    SbColor colors[3] = { SbColor(rr,rg,rb), SbColor(c.r,c.g,c.b), SbColor(pr,pg,pb) };
+
+    lineColors.resize(colorindex.size());
+    for (std::size_t i=0; i<colorindex.size(); i++)
+        lineColors[i] = colors[std::min(colorindex[i], 2)];
+
+    lodColors.resize(lodColorIndex.size());
+    for (std::size_t i=0; i<lodColorIndex.size(); i++)
+        lodColors[i] = colors[std::min(lodColorIndex[i], 2)];
+}
+
+void ViewProviderPath::showColorRange()
+{
+    if (colorindex.empty() || coordStart<0 || coordStart>=(int)colorindex.size() || edgeStart<0)
+        return;
+
+    pcMatBind->value = SoMaterialBinding::PER_PART;
+
+    // one color per line segment of the shown edges
+    int count = coordEnd-coordStart;
+    if(count > (int)colorindex.size()-coordStart) count = colorindex.size()-coordStart;
+    pcLineColor->diffuseColor.setValuesPointer(count, &lineColors[coordStart]);
+
+    int lodStart = lodColorStart[edgeStart];
+    int lodCount = lodColorStart[edgeEnd] - lodStart;
+    if (lodCount > 0)
+        pcLineColorLOD->diffuseColor.setValuesPointer(lodCount, &lodColors[lodStart]);
+    else
+        pcLineColorLOD->diffuseColor.setNum(0);
+}
+
+void ViewProviderPath::buildLineIndices()
+{
+    lineIndices.clear();
+    edgeIndexStart.assign(1, 0);
+    lodIndices.clear();
+    lodEdgeIndexStart.assign(1, 0);
+    lodColorStart.assign(1, 0);
+    lodColorIndex.clear();
+
+    std::size_t numEdges = edgeIndices.size();
+    int numPoints = pcLineCoords->point.getNum();
+    if (numEdges == 0 || numPoints == 0)
+        return;
+
+    lineIndices.reserve(numPoints + 2*numEdges);
+    edgeIndexStart.reserve(numEdges + 1);
+    lodEdgeIndexStart.reserve(numEdges + 1);
+    lodColorStart.reserve(numEdges + 1);
+
+    // the overview drops points closer than a fraction of the path size to the last kept one
+    const SbVec3f* pts = pcLineCoords->point.getValues(0);
+    SbBox3f box;
+    for (int i=0; i<numPoints; i++)
+        box.extendBy(pts[i]);
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Path");
+    float diagonal = (box.getMax() - box.getMin()).length();
+    float tolerance = diagonal * static_cast<float>(hGrp->GetFloat("OverviewTolerance", 0.002));
+    float tolerance2 = tolerance * tolerance;
+
+    // edges share their first point with the last point of the previous edge
+    for (std::size_t e=0; e<numEdges; e++) {
+        int first = e==0 ? 0 : edgeIndices[e-1]-1;
+        int last = edgeIndices[e]-1;
+        for (int i=first; i<=last; i++)
+            lineIndices.push_back(i);
+        lineIndices.push_back(-1);
+        edgeIndexStart.push_back(lineIndices.size());
+
+        lodIndices.push_back(first);
+        int kept = first;
+        for (int i=first+1; i<=last; i++) {
+            if (i == last || (pts[i] - pts[kept]).sqrLength() > tolerance2) {
+                lodIndices.push_back(i);
+                // a segment gets the color of the move it ends in
+                lodColorIndex.push_back(i-1 < (int)colorindex.size() ? colorindex[i-1] : 1);
+                kept = i;
+            }
+        }
+        lodIndices.push_back(-1);
+        lodEdgeIndexStart.push_back(lodIndices.size());
+        lodColorStart.push_back(lodColorIndex.size());
+    }
+
+    // the overview is only worth it for large paths
+    if (numPoints > hGrp->GetInt("OverviewPointCount", 500000)) {
+        SbVec3f center = box.getCenter();
+        pcLineLOD->center.setValue(center);
+        pcLineLOD->range.setValue(diagonal * static_cast<float>(hGrp->GetFloat("OverviewDistance", 3.0)));
+    }
+    else {
+        pcLineLOD->range.setNum(0);
+    }
+}
+
 void ViewProviderPath::updateVisual(bool rebuild) {
 
     hideSelection();
 
     updateShowConstraints();
 
-    pcLines->coordIndex.deleteValues(0);
+    // detach the fields before the buffers change
+    pcLines->coordIndex.setNum(0);
+    pcLinesLOD->coordIndex.setNum(0);
 
     if(rebuild) {
         Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
@@ -637,11 +753,17 @@ void ViewProviderPath::updateVisual(bool rebuild) {
             pcLineCoords->point.finishEditing();
 
             pcMarkerCoords->point.setNum(markers.size());
-            for(unsigned int i=0;i<markers.size();i++)
-                pcMarkerCoords->point.set1Value(i,markers[i].x,markers[i].y,markers[i].z);
+            verts = pcMarkerCoords->point.startEditing();
+            i=0;
+            for(const auto &pt : markers)
+                verts[i++].setValue(pt.x,pt.y,pt.z);
+            pcMarkerCoords->point.finishEditing();
 
             recomputeBoundingBox();
         }
+
+        buildLineIndices();
+        updateColors();
     }
 
     // count = index + separators
@@ -659,7 +781,7 @@ void ViewProviderPath::updateVisual(bool rebuild) {
         StartIndex.purgeTouched();
     }
 
-    int edgeEnd = edgeStart+ShowCount.getValue();
+    edgeEnd = edgeStart+ShowCount.getValue();
     if(edgeEnd==edgeStart || edgeEnd>(int)edgeIndices.size())
         edgeEnd = edgeIndices.size();
 
@@ -667,23 +789,13 @@ void ViewProviderPath::updateVisual(bool rebuild) {
     coordStart = edgeStart==0?0:(edgeIndices[edgeStart-1]-1);
     coordEnd = edgeIndices[edgeEnd-1];
 
-    // count = coord indices + index separators
-    int count = coordEnd-coordStart+2*(edgeEnd-edgeStart-1)+1;
-
-    pcLines->coordIndex.setNum(count);
-    int32_t *idx = pcLines->coordIndex.startEditing();
-    i=0;
-    int start = coordStart;
-    for(int e=edgeStart;e!=edgeEnd;++e) {
-        for(int end=edgeIndices[e];start<end;++start)
-            idx[i++] = start;
-        idx[i++]=-1;
-        --start;
-    }
-    pcLines->coordIndex.finishEditing();
-    assert(i==count);
+    // the shown edges are a window into the indices of all edges
+    int first = edgeIndexStart[edgeStart];
+    pcLines->coordIndex.setValuesPointer(edgeIndexStart[edgeEnd]-first, &lineIndices[first]);
+    first = lodEdgeIndexStart[edgeStart];
+    pcLinesLOD->coordIndex.setValuesPointer(lodEdgeIndexStart[edgeEnd]-first, &lodIndices[first]);
 
-    NormalColor.touch();
+    showColorRange();
 }
 
 void ViewProviderPath::recomputeBoundingBox()
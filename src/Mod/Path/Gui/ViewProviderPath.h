@@ -30,8 +30,11 @@
 #include <Gui/SoFCSelection.h>
 #include <Gui/ViewProviderPythonFeature.h>
 #include <Mod/Part/Gui/SoBrepEdgeSet.h>
+#include <Inventor/SbColor.h>
 
 class SoCoordinate3;
+class SoIndexedLineSet;
+class SoLOD;
 class SoDrawStyle;
 class SoMaterial;
 class SoBaseColor;
@@ -81,6 +84,7 @@ public:
 
     void updateShowConstraints();
     void updateVisual(bool rebuild = false);
+    void updateColors();
     void hideSelection();
 
     virtual void showBoundingBox(bool show);
@@ -92,12 +96,18 @@ protected:
     virtual void onChanged(const App::Property* prop);
     virtual unsigned long getBoundColor() const;
 
+    void buildLineIndices();
+    void showColorRange();
+
     SoCoordinate3         * pcLineCoords;
     SoCoordinate3         * pcMarkerCoords;
     SoDrawStyle           * pcDrawStyle;
     SoDrawStyle           * pcMarkerStyle;
     PartGui::SoBrepEdgeSet         * pcLines;
     SoMaterial            * pcLineColor;
+    SoLOD                 * pcLineLOD;
+    SoIndexedLineSet      * pcLinesLOD;
+    SoMaterial            * pcLineColorLOD;
     SoBaseColor           * pcMarkerColor;
     SoMaterialBinding     * pcMatBind;
     std::vector<int>        colorindex;
@@ -109,9 +119,22 @@ protected:
     std::deque<int>   edge2Command;
     std::deque<int>   edgeIndices;
 
+    // coordinate indices and colors of all edges, the shown range of edges
+    // only points the fields of the line sets into these buffers
+    std::vector<int32_t> lineIndices;
+    std::vector<int>     edgeIndexStart;
+    std::vector<SbColor> lineColors;
+    // the same for the decimated overview shown from far away
+    std::vector<int32_t> lodIndices;
+    std::vector<int>     lodEdgeIndexStart;
+    std::vector<int>     lodColorStart;
+    std::vector<int>     lodColorIndex;
+    std::vector<SbColor> lodColors;
+
     mutable int pt0Index;
     bool blockPropertyChange;
     int edgeStart;
+    int edgeEnd;
     int coordStart;
     int coordEnd;
 
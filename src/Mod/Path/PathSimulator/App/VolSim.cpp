@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #include <Base/Console.h>
+#include <Base/ThreadPool.h>
 
 #include <BRepCheck_Analyzer.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
@@ -29,6 +30,7 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <cfloat>
 #endif
 
 #include "VolSim.h"
@@ -50,6 +52,20 @@ cStock::cStock(float px, float py, float pz, float lx, float ly, float lz, float
 			m_stock[x][y] = m_plane;
 			m_attr[x][y] = 0;
 		}
+
+	m_tx = (m_x + SIM_TILE_SIZE - 1) / SIM_TILE_SIZE;
+	m_ty = (m_y + SIM_TILE_SIZE - 1) / SIM_TILE_SIZE;
+	m_tiles.resize(m_tx * m_ty);
+	for (int ty = 0; ty < m_ty; ty++)
+		for (int tx = 0; tx < m_tx; tx++)
+		{
+			cStockTile & tile = m_tiles[ty * m_tx + tx];
+			tile.x0 = tx * SIM_TILE_SIZE;
+			tile.y0 = ty * SIM_TILE_SIZE;
+			tile.x1 = std::min(m_x, tile.x0 + SIM_TILE_SIZE);
+			tile.y1 = std::min(m_y, tile.y0 + SIM_TILE_SIZE);
+			tile.dirty = true;
+		}
 }
 
 cStock::~cStock()
@@ -57,7 +73,7 @@ cStock::~cStock()
 }
 
 
-float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz)
+float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz, const cStockTile & tile)
 {
 	float z = m_stock[xp][yp];
 	bool xr_ok = true;
@@ -71,7 +87,7 @@ float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool s
 		if (xr_ok)
 		{
 			int tx = xp + x_size;
-			if (tx >= m_x)
+			if (tx >= tile.x1)
 				xr_ok = false;
 			else
 			{
@@ -92,7 +108,7 @@ float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool s
 		if (xl_ok)
 		{
 			int tx = xp - 1;
-			if (tx < 0)
+			if (tx < tile.x0)
 				xl_ok = false;
 			else
 			{
@@ -116,7 +132,7 @@ float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool s
 		if (yu_ok)
 		{
 			int ty = yp + y_size;
-			if (ty >= m_y)
+			if (ty >= tile.y1)
 				yu_ok = false;
 			else
 			{
@@ -137,7 +153,7 @@ float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool s
 		if (yd_ok)
 		{
 			int ty = yp - 1;
-			if (ty < 0)
+			if (ty < tile.y0)
 				yd_ok = false;
 			else
 			{
@@ -160,23 +176,23 @@ float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool s
 	return z;
 }
 
-int cStock::TesselTop(int xp, int yp)
+int cStock::TesselTop(int xp, int yp, cStockTile & tile)
 {
 	int x_size, y_size;
-	float z = FindRectTop(xp, yp, x_size, y_size, true);
+	float z = FindRectTop(xp, yp, x_size, y_size, true, tile);
 	bool farRect = false;
 	while (y_size / x_size > 5)
 	{
 		farRect = true;
 		yp += x_size * 5;
-		z = FindRectTop(xp, yp, x_size, y_size, true);
+		z = FindRectTop(xp, yp, x_size, y_size, true, tile);
 	}
 
 	while (x_size / y_size > 5)
 	{
 		farRect = true;
 		xp += y_size * 5;
-		z = FindRectTop(xp, yp, x_size, y_size, false);
+		z = FindRectTop(xp, yp, x_size, y_size, false, tile);
 	}
 
 	// mark all points inside
@@ -192,9 +208,9 @@ int cStock::TesselTop(int xp, int yp)
 		Point3D ptl(xp, yp + y_size, z);
 		Point3D ptr(xp + x_size, yp + y_size, z);
 		if (fabs(m_pz + m_lz - z) < SIM_EPSILON)
-			AddQuad(pbl, pbr, ptr, ptl, facetsOuter);
+			AddQuad(pbl, pbr, ptr, ptl, tile.facetsOuter);
 		else
-			AddQuad(pbl, pbr, ptr, ptl, facetsInner);
+			AddQuad(pbl, pbr, ptr, ptl, tile.facetsInner);
 	}
 
 	if (farRect)
@@ -204,7 +220,7 @@ int cStock::TesselTop(int xp, int yp)
 }
 
 
-void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz)
+void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz, const cStockTile & tile)
 {
 	bool xr_ok = true;
 	bool xl_ok = scanHoriz;
@@ -217,7 +233,7 @@ void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool sc
 		if (xr_ok)
 		{
 			int tx = xp + x_size;
-			if (tx >= m_x)
+			if (tx >= tile.x1)
 				xr_ok = false;
 			else
 			{
@@ -238,7 +254,7 @@ void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool sc
 		if (xl_ok)
 		{
 			int tx = xp - 1;
-			if (tx < 0)
+			if (tx < tile.x0)
 				xl_ok = false;
 			else
 			{
@@ -262,7 +278,7 @@ void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool sc
 		if (yu_ok)
 		{
 			int ty = yp + y_size;
-			if (ty >= m_y)
+			if (ty >= tile.y1)
 				yu_ok = false;
 			else
 			{
@@ -283,7 +299,7 @@ void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool sc
 		if (yd_ok)
 		{
 			int ty = yp - 1;
-			if (ty < 0)
+			if (ty < tile.y0)
 				yd_ok = false;
 			else
 			{
@@ -306,23 +322,23 @@ void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool sc
 }
 
 
-int cStock::TesselBot(int xp, int yp)
+int cStock::TesselBot(int xp, int yp, cStockTile & tile)
 {
 	int x_size, y_size;
-	FindRectBot(xp, yp, x_size, y_size, true);
+	FindRectBot(xp, yp, x_size, y_size, true, tile);
 	bool farRect = false;
 	while (y_size / x_size > 5)
 	{
 		farRect = true;
 		yp += x_size * 5;
-		FindRectTop(xp, yp, x_size, y_size, true);
+		FindRectTop(xp, yp, x_size, y_size, true, tile);
 	}
 
 	while (x_size / y_size > 5)
 	{
 		farRect = true;
 		xp += y_size * 5;
-		FindRectTop(xp, yp, x_size, y_size, false);
+		FindRectTop(xp, yp, x_size, y_size, false, tile);
 	}
 
 	// mark all points inside
@@ -335,7 +351,7 @@ int cStock::TesselBot(int xp, int yp)
 	Point3D pbr(xp + x_size, yp, m_pz);
 	Point3D ptl(xp, yp + y_size, m_pz);
 	Point3D ptr(xp + x_size, yp + y_size, m_pz);
-	AddQuad(pbl, ptl, ptr, pbr, facetsOuter);
+	AddQuad(pbl, ptl, ptr, pbr, tile.facetsOuter);
 
 	if (farRect)
 		return -1;
@@ -344,22 +360,23 @@ int cStock::TesselBot(int xp, int yp)
 }
 
 
-int cStock::TesselSidesX(int yp)
+// walls along x at line yp between the rows yp - 1 and yp, within the columns of tile
+int cStock::TesselSidesX(int yp, cStockTile & tile)
 {
 	float lastz1 = m_pz;
 	if (yp < m_y)
-		lastz1 = std::max(m_stock[0][yp], m_pz);
+		lastz1 = std::max(m_stock[tile.x0][yp], m_pz);
 	float lastz2 = m_pz;
 	if (yp > 0)
-		lastz2 = std::max(m_stock[0][yp - 1], m_pz);
+		lastz2 = std::max(m_stock[tile.x0][yp - 1], m_pz);
 
-	std::vector<MeshCore::MeshGeomFacet> *facets = &facetsInner;
+	std::vector<MeshCore::MeshGeomFacet> *facets = &tile.facetsInner;
 	if (yp == 0 || yp == m_y)
-		facets = &facetsOuter;
+		facets = &tile.facetsOuter;
 
 	//bool lastzclip = (lastz - m_pz) < m_res;
-	int lastpoint = 0;
-	for (int x = 1; x <= m_x; x++)
+	int lastpoint = tile.x0;
+	for (int x = tile.x0 + 1; x <= tile.x1; x++)
 	{
 		float newz1 = m_pz;
 		if (yp < m_y && x < m_x)
@@ -370,7 +387,8 @@ int cStock::TesselSidesX(int yp)
 
 		if (fabs(lastz1 - lastz2) > m_res)
 		{
-			if (fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res)
+			// a wall is closed at the end of the tile
+			if (x < tile.x1 && fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res)
 				continue;
 			Point3D pbl(lastpoint, yp, lastz1);
 			Point3D pbr(x, yp, lastz1);
@@ -385,22 +403,23 @@ int cStock::TesselSidesX(int yp)
 	return 0;
 }
 
-int cStock::TesselSidesY(int xp)
+// walls along y at line xp between the columns xp - 1 and xp, within the rows of tile
+int cStock::TesselSidesY(int xp, cStockTile & tile)
 {
 	float lastz1 = m_pz;
 	if (xp < m_x)
-		lastz1 = std::max(m_stock[xp][0], m_pz);
+		lastz1 = std::max(m_stock[xp][tile.y0], m_pz);
 	float lastz2 = m_pz;
 	if (xp > 0)
-		lastz2 = std::max(m_stock[xp - 1][0], m_pz);
+		lastz2 = std::max(m_stock[xp - 1][tile.y0], m_pz);
 
-	std::vector<MeshCore::MeshGeomFacet> *facets = &facetsInner;
+	std::vector<MeshCore::MeshGeomFacet> *facets = &tile.facetsInner;
 	if (xp == 0 || xp == m_x)
-		facets = &facetsOuter;
+		facets = &tile.facetsOuter;
 
 	//bool lastzclip = (lastz - m_pz) < m_res;
-	int lastpoint = 0;
-	for (int y = 1; y <= m_y; y++)
+	int lastpoint = tile.y0;
+	for (int y = tile.y0 + 1; y <= tile.y1; y++)
 	{
 		float newz1 = m_pz;
 		if (xp < m_x && y < m_y)
@@ -411,7 +430,8 @@ int cStock::TesselSidesY(int xp)
 
 		if (fabs(lastz1 - lastz2) > m_res)
 		{
-			if (fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res)
+			// a wall is closed at the end of the tile
+			if (y < tile.y1 && fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res)
 				continue;
 			Point3D pbr(xp, lastpoint, lastz1);
 			Point3D pbl(xp, y, lastz1);
@@ -449,45 +469,112 @@ void cStock::AddQuad(Point3D & p1, Point3D & p2, Point3D & p3, Point3D & p4, std
 	facets.push_back(facet);
 }
 
-void cStock::Tessellate(Mesh::MeshObject & meshOuter, Mesh::MeshObject & meshInner)
+void cStock::TessellateTile(cStockTile & tile)
 {
+	tile.facetsOuter.clear();
+	tile.facetsInner.clear();
+
 	// reset attribs
-	for (int y = 0; y < m_y; y++)
-	for (int x = 0; x < m_x; x++)
+	for (int y = tile.y0; y < tile.y1; y++)
+	for (int x = tile.x0; x < tile.x1; x++)
 		m_attr[x][y] = 0;
 
-	facetsOuter.clear();
-	facetsInner.clear();
-
-	for (int y = 0; y < m_y; y++)
+	for (int y = tile.y0; y < tile.y1; y++)
 	{
-		for (int x = 0; x < m_x; x++)
+		for (int x = tile.x0; x < tile.x1; x++)
 		{
 			int attr = m_attr[x][y];
 			if ((attr & SIM_TESSEL_TOP) == 0)
-				x += TesselTop(x, y);
+				x += TesselTop(x, y, tile);
 		}
 	}
-	for (int y = 0; y < m_y; y++)
+	for (int y = tile.y0; y < tile.y1; y++)
 	{
-		for (int x = 0; x < m_x; x++)
+		for (int x = tile.x0; x < tile.x1; x++)
 		{
 			if ((m_stock[x][y] - m_pz) < m_res)
 				m_attr[x][y] |= SIM_TESSEL_BOT;
 			if ((m_attr[x][y] & SIM_TESSEL_BOT) == 0)
-				x += TesselBot(x, y);
+				x += TesselBot(x, y, tile);
 		}
 	}
-	for (int y = 0; y <= m_y; y++)
-		TesselSidesX(y);
-	for (int x = 0; x <= m_x; x++)
-		TesselSidesY(x);
+
+	// a tile owns the wall lines at the start of its rows and columns, the last tiles
+	// also the stock border
+	int ye = tile.y1 == m_y ? m_y : tile.y1 - 1;
+	for (int y = tile.y0; y <= ye; y++)
+		TesselSidesX(y, tile);
+	int xe = tile.x1 == m_x ? m_x : tile.x1 - 1;
+	for (int x = tile.x0; x <= xe; x++)
+		TesselSidesY(x, tile);
+	tile.dirty = false;
+}
+
+void cStock::Tessellate(Mesh::MeshObject & meshOuter, Mesh::MeshObject & meshInner)
+{
+	// only the tiles modified since the last call are tessellated again, they don't
+	// share any cells so this is done in parallel
+	std::vector<cStockTile*> dirtyTiles;
+	for (auto & tile : m_tiles)
+	{
+		if (tile.dirty)
+			dirtyTiles.push_back(&tile);
+	}
+	Base::parallel_for(std::size_t(0), dirtyTiles.size(), [&](std::size_t i) {
+		TessellateTile(*dirtyTiles[i]);
+	}, std::size_t(1));
+
+	std::size_t numOuter = 0, numInner = 0;
+	for (auto & tile : m_tiles)
+	{
+		numOuter += tile.facetsOuter.size();
+		numInner += tile.facetsInner.size();
+	}
+	std::vector<MeshCore::MeshGeomFacet> facetsOuter;
+	std::vector<MeshCore::MeshGeomFacet> facetsInner;
+	facetsOuter.reserve(numOuter);
+	facetsInner.reserve(numInner);
+	for (auto & tile : m_tiles)
+	{
+		facetsOuter.insert(facetsOuter.end(), tile.facetsOuter.begin(), tile.facetsOuter.end());
+		facetsInner.insert(facetsInner.end(), tile.facetsInner.begin(), tile.facetsInner.end());
+	}
 	meshOuter.addFacets(facetsOuter);
 	meshInner.addFacets(facetsInner);
-	facetsOuter.clear();
-	facetsInner.clear();
 }
 
+// marks the tiles of the cells [xs, xe] x [ys, ye] and of the walls around them as modified
+void cStock::SetDirty(int xs, int ys, int xe, int ye)
+{
+	int txs = std::max(0, xs - 1) / SIM_TILE_SIZE;
+	int tys = std::max(0, ys - 1) / SIM_TILE_SIZE;
+	int txe = std::min(m_x - 1, xe + 1) / SIM_TILE_SIZE;
+	int tye = std::min(m_y - 1, ye + 1) / SIM_TILE_SIZE;
+	for (int ty = tys; ty <= tye; ty++)
+		for (int tx = txs; tx <= txe; tx++)
+			m_tiles[ty * m_tx + tx].dirty = true;
+}
+
+// Lowers every cell of [xs, xe] x [ys, ye] to heightAt(x, y) of its center, the columns are
+// processed in parallel
+template <typename Func>
+void cStock::ApplyFootprint(int xs, int ys, int xe, int ye, Func heightAt)
+{
+	xs = std::max(xs, 0);
+	ys = std::max(ys, 0);
+	xe = std::min(xe, m_x - 1);
+	ye = std::min(ye, m_y - 1);
+	if (xs > xe || ys > ye)
+		return;
+
+	Base::parallel_for(xs, xe + 1, [&](int x) {
+		float *column = m_stock[x];
+		float qx = x + 0.5f;
+		for (int y = ys; y <= ye; y++)
+			column[y] = std::min(column[y], heightAt(qx, y + 0.5f));
+	}, 16);
+	SetDirty(xs, ys, xe, ye);
+}
 
 void cStock::CreatePocket(float cxf, float cyf, float radf, float height)
 {
@@ -496,7 +583,7 @@ void cStock::CreatePocket(float cxf, float cyf, float radf, float height)
 	int rad = (int)(radf / m_res);
 	int drad = rad * rad;
 	int ys = std::max(0, cy - rad);
-	int ye = std::min(m_x, cy + rad);
+	int ye = std::min(m_y, cy + rad);
 	int xs = std::max(0, cx - rad);
 	int xe = std::min(m_x, cx + rad);
 	for (int y = ys; y < ye; y++)
@@ -507,6 +594,7 @@ void cStock::CreatePocket(float cxf, float cyf, float radf, float height)
 				if (m_stock[x][y] > height) m_stock[x][y] = height;
 		}
 	}
+	SetDirty(xs, ys, xe - 1, ye - 1);
 }
 
 void cStock::ApplyLinearTool(Point3D & p1, Point3D & p2, cSimTool & tool)
@@ -516,154 +604,107 @@ void cStock::ApplyLinearTool(Point3D & p1, Point3D & p2, cSimTool & tool)
 	Point3D pi2 = ToInner(p2);
 	float rad = tool.radius;
 	rad /= m_res;
-	float cupAngle = 180;
-
-	// strait motion
-	float perpDirX = 1;
-	float perpDirY = 0;
-	cLineSegment path(pi1, pi2);
-	if (path.lenXY > SIM_EPSILON) // only if moving along xy
-	{
-		perpDirX = -path.pDirXY.y;
-		perpDirY = path.pDirXY.x;
-		Point3D start(perpDirX * rad + pi1.x, perpDirY * rad + pi1.y, pi1.z);
-		Point3D mainWay = path.pDir * SIM_WALK_RES;
-		Point3D sideWay(-perpDirX * SIM_WALK_RES, -perpDirY * SIM_WALK_RES, 0);
-		int lenSteps = (int)(path.len / SIM_WALK_RES) + 1;
-		int radSteps = (int)(rad * 2 / SIM_WALK_RES) + 1;
-		float zstep = (pi2.z - pi1.z) / radSteps;
-		float tstep = 2.0 / radSteps;
-		float t = -1;
-		for (int j = 0; j < radSteps; j++)
-		{
-			float z = pi1.z + tool.GetToolProfileAt(t);
-			Point3D p = start;
-			for (int i = 0; i < lenSteps; i++)
-			{
-				int x = (int)p.x;
-				int y = (int)p.y;
-				if (x >= 0 && y >= 0 && x < m_x && y < m_y)
-				{
-					if (m_stock[x][y] > z)
-						m_stock[x][y] = z;
-				}
-				p.Add(mainWay);
-				z += zstep;
-			}
-			t += tstep;
-			start.Add(sideWay);
-		}
-	}
-	else
-		cupAngle = 360;
-
-	// end cup
-	for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES)
-	{
-		Point3D cupCirc(perpDirX * r, perpDirY * r, pi2.z);
-		float rotang = 180 * SIM_WALK_RES / (3.1415926535 * r);
-		cupCirc.SetRotationAngle(-rotang);
-		float z = pi2.z + tool.GetToolProfileAt(r / rad);
-		for (float a = 0; a < cupAngle; a += rotang)
-		{
-			int x = (int)(pi2.x + cupCirc.x);
-			int y = (int)(pi2.y + cupCirc.y);
-			if (x >= 0 && y >= 0 && x < m_x && y < m_y)
-			{
-				if (m_stock[x][y] > z)
-					m_stock[x][y] = z;
-			}
-			cupCirc.Rotate();
-		}
-	}
+	float rad2 = rad * rad;
+	float res = m_res;
+
+	float dx = pi2.x - pi1.x;
+	float dy = pi2.y - pi1.y;
+	float dz = pi2.z - pi1.z;
+	float lenXY2 = dx * dx + dy * dy;
+	float invLenXY2 = lenXY2 > SIM_EPSILON ? 1.0f / lenXY2 : 0.0f;
+
+	// every cell gets the height of the tool at the closest point of the path in xy
+	ApplyFootprint((int)(std::min(pi1.x, pi2.x) - rad), (int)(std::min(pi1.y, pi2.y) - rad),
+		(int)(std::max(pi1.x, pi2.x) + rad), (int)(std::max(pi1.y, pi2.y) + rad),
+		[&](float qx, float qy) {
+			float px = qx - pi1.x;
+			float py = qy - pi1.y;
+			float t = std::min(1.0f, std::max(0.0f, (px * dx + py * dy) * invLenXY2));
+			float ex = px - t * dx;
+			float ey = py - t * dy;
+			float d2 = ex * ex + ey * ey;
+			if (d2 > rad2)
+				return FLT_MAX;
+			return pi1.z + t * dz + tool.GetProfileAtDist(sqrtf(d2) * res);
+		});
 }
 
 void cStock::ApplyCircularTool(Point3D & p1, Point3D & p2, Point3D & cent, cSimTool & tool, bool isCCW)
 {
+	const float twoPi = 2 * 3.1415926535f;
+
 	// translate coordinates
 	Point3D pi1 = ToInner(p1);
 	Point3D pi2 = ToInner(p2);
-	Point3D centi(cent.x / m_res, cent.y / m_res, cent.z);
 	float rad = tool.radius;
 	rad /= m_res;
-	float cpx = centi.x;
-	float cpy = centi.y;
+	float rad2 = rad * rad;
+	float res = m_res;
 
-	Point3D xynorm = unit(Point3D(-cpx, -cpy, 0));
-	float crad = sqrt(cpx * cpx + cpy * cpy);
-	//bool shortRad = (crad - rad) < 0.0001;
-	//if (shortRad)
-	//	rad = crad;
-	float crad1 = std::max((float)0.5, crad - rad);
-	float crad2 = crad + rad;
+	// the center is relative to the start point
+	float cpx = pi1.x + cent.x / m_res;
+	float cpy = pi1.y + cent.y / m_res;
+	float crad = sqrtf((pi1.x - cpx) * (pi1.x - cpx) + (pi1.y - cpy) * (pi1.y - cpy));
 
-	float sang = atan2(-cpy, -cpx); // start angle
-
-	cpx += pi1.x;
-	cpy += pi1.y;
-	double eang = atan2(pi2.y - cpy, pi2.x - cpx); // end angle
-
-	double ang = eang - sang;
+	float sang = atan2(pi1.y - cpy, pi1.x - cpx); // start angle
+	float eang = atan2(pi2.y - cpy, pi2.x - cpx); // end angle
+	float ang = eang - sang;
 	if (!isCCW && ang > 0)
-		ang -= 2 * 3.1415926;
+		ang -= twoPi;
 	if (isCCW && ang < 0)
-		ang += 2 * 3.1415926;
+		ang += twoPi;
 	ang = fabs(ang);
-
-	// apply path
-	Point3D cupCirc;
-	float tstep = (float)SIM_WALK_RES / rad;
-	float t = -1;
-	for (float r = crad1; r <= crad2; r += (float)SIM_WALK_RES)
+	if (ang < SIM_EPSILON)
+		ang = twoPi; // full circle
+	float dir = isCCW ? 1.0f : -1.0f;
+	float dz = pi2.z - pi1.z;
+
+	// bounding box of the arc: the end points and the extremes of the circle it passes
+	float minx = std::min(pi1.x, pi2.x), maxx = std::max(pi1.x, pi2.x);
+	float miny = std::min(pi1.y, pi2.y), maxy = std::max(pi1.y, pi2.y);
+	for (int i = 0; i < 4; i++)
 	{
-		cupCirc.x = xynorm.x * r;
-		cupCirc.y = xynorm.y * r;
-		float rotang = (float)SIM_WALK_RES / r;
-		int ndivs = (int)(ang / rotang) + 1;
-		if (!isCCW)
-			rotang = -rotang;
-		cupCirc.SetRotationAngleRad(rotang);
-		float z = pi1.z + tool.GetToolProfileAt(t);
-		float zstep = (pi2.z - pi1.z) / ndivs;
-		for (int i = 0; i< ndivs; i++)
+		float t = fmod(dir * (i * twoPi / 4 - sang), twoPi);
+		if (t < 0)
+			t += twoPi;
+		if (t <= ang)
 		{
-			int x = (int)(cpx + cupCirc.x);
-			int y = (int)(cpy + cupCirc.y);
-			if (x >= 0 && y >= 0 && x < m_x && y < m_y)
-			{
-				if (m_stock[x][y] > z)
-					m_stock[x][y] = z;
-			}
-			z += zstep;
-			cupCirc.Rotate();
+			float x = cpx + crad * cos(i * twoPi / 4);
+			float y = cpy + crad * sin(i * twoPi / 4);
+			minx = std::min(minx, x);
+			maxx = std::max(maxx, x);
+			miny = std::min(miny, y);
+			maxy = std::max(maxy, y);
 		}
-		t += tstep;
 	}
 
-	// apply end cup
-	xynorm.SetRotationAngleRad(ang);
-	xynorm.Rotate();
-	for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES)
-	{
-		Point3D cupCirc(xynorm.x * r, xynorm.y * r, 0);
-		float rotang = (float)SIM_WALK_RES / r;
-		int ndivs = (int)(3.1415926535 / rotang) + 1;
-		if (!isCCW)
-			rotang = -rotang;
-		cupCirc.SetRotationAngleRad(rotang);
-		float z = pi2.z + tool.GetToolProfileAt(r / rad);
-		for (int i = 0; i < ndivs; i++)
-		{
-			int x = (int)(pi2.x + cupCirc.x);
-			int y = (int)(pi2.y + cupCirc.y);
-			if (x >= 0 && y >= 0 && x < m_x && y < m_y)
+	// every cell gets the lowest of the tool along the arc and at both end points
+	ApplyFootprint((int)(minx - rad), (int)(miny - rad), (int)(maxx + rad), (int)(maxy + rad),
+		[&](float qx, float qy) {
+			float z = FLT_MAX;
+			float vx = qx - cpx;
+			float vy = qy - cpy;
+			float dr = fabsf(sqrtf(vx * vx + vy * vy) - crad);
+			if (dr <= rad)
 			{
-				if (m_stock[x][y] > z)
-					m_stock[x][y] = z;
+				float t = fmodf(dir * (atan2f(vy, vx) - sang), twoPi);
+				if (t < 0)
+					t += twoPi;
+				if (t <= ang)
+					z = pi1.z + dz * t / ang + tool.GetProfileAtDist(dr * res);
 			}
-			cupCirc.Rotate();
-		}
-	}
+			float ex = qx - pi2.x;
+			float ey = qy - pi2.y;
+			float d2 = ex * ex + ey * ey;
+			if (d2 <= rad2)
+				z = std::min(z, pi2.z + tool.GetProfileAtDist(sqrtf(d2) * res));
+			ex = qx - pi1.x;
+			ey = qy - pi1.y;
+			d2 = ex * ex + ey * ey;
+			if (d2 <= rad2)
+				z = std::min(z, pi1.z + tool.GetProfileAtDist(sqrtf(d2) * res));
+			return z;
+		});
 }
 
 
@@ -774,6 +815,20 @@ cSimTool::cSimTool(const TopoDS_Shape& toolShape, float res){
 		}
 	}
 
+	// sample the profile for the stock kernels
+	m_profileStep = std::max(res / SIM_PROFILE_SUBDIV, (float)SIM_EPSILON);
+	int numSteps = (int)(radius / m_profileStep) + 2;
+	m_profile.resize(numSteps, 0.0f);
+	if (!m_toolShape.empty())
+	{
+		for (int i = 0; i < numSteps; i++)
+		{
+			toolShapePoint test; test.radiusPos = i * m_profileStep;
+			auto it = std::lower_bound(m_toolShape.begin(), m_toolShape.end(), test, toolShapePoint::less_than());
+			m_profile[i] = it != m_toolShape.end() ? it->heightPos : m_toolShape.back().heightPos;
+		}
+	}
+
 	// Report the performance of the profile extraction
 	//auto stop = std::chrono::high_resolution_clock::now();
 	//auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
@@ -26,6 +26,7 @@
 #ifndef PATHSIMULATOR_VolSim_H
 #define PATHSIMULATOR_VolSim_H
 
+#include <algorithm>
 #include <vector>
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Path/App/Command.h>
@@ -34,6 +35,8 @@
 #define SIM_TESSEL_TOP		1
 #define SIM_TESSEL_BOT		2
 #define SIM_WALK_RES		0.6   // step size in pixel units (to make sure all pixels in the path are visited)
+#define SIM_TILE_SIZE		64    // stock cells per tile side, only modified tiles are tessellated again
+#define SIM_PROFILE_SUBDIV	4     // tool profile samples per resolution step
 
 struct toolShapePoint {
   float radiusPos;
@@ -104,9 +107,15 @@ public:
 	~cSimTool() {}
 
 	float GetToolProfileAt(float pos);
+	inline float GetProfileAtDist(float dist) const {  // dist is the distance from the tool axis
+		int i = (int)(dist / m_profileStep);
+		return m_profile[std::min(i, (int)m_profile.size() - 1)];
+	}
 	bool isInside(const TopoDS_Shape& toolShape, Base::Vector3d pnt, float res);
 
 	std::vector< toolShapePoint > m_toolShape;
+	std::vector<float> m_profile;  // profile height sampled at m_profileStep distances from the axis
+	float m_profileStep;
 	float radius;
 	float length;
 };
@@ -136,6 +145,14 @@ private:
 	int height;
 };
 
+struct cStockTile
+{
+	int x0, y0, x1, y1;  // cell range [x0, x1) x [y0, y1)
+	bool dirty;          // modified since it was tessellated
+	std::vector<MeshCore::MeshGeomFacet> facetsOuter;
+	std::vector<MeshCore::MeshGeomFacet> facetsInner;
+};
+
 class cStock
 {
 public:
@@ -150,14 +167,18 @@ public:
 	}
 
 private:
-	float FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz);
-	void FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz);
+	template <typename Func>
+	void ApplyFootprint(int xs, int ys, int xe, int ye, Func heightAt);
+	void SetDirty(int xs, int ys, int xe, int ye);
+	void TessellateTile(cStockTile & tile);
+	float FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz, const cStockTile & tile);
+	void FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz, const cStockTile & tile);
 	void SetFacetPoints(MeshCore::MeshGeomFacet & facet, Point3D & p1, Point3D & p2, Point3D & p3);
 	void AddQuad(Point3D & p1, Point3D & p2, Point3D & p3, Point3D & p4, std::vector<MeshCore::MeshGeomFacet> & facets);
-	int TesselTop(int x, int y);
-	int TesselBot(int x, int y);
-	int TesselSidesX(int yp);
-	int TesselSidesY(int xp);
+	int TesselTop(int x, int y, cStockTile & tile);
+	int TesselBot(int x, int y, cStockTile & tile);
+	int TesselSidesX(int yp, cStockTile & tile);
+	int TesselSidesY(int xp, cStockTile & tile);
 	Array2D<float>  m_stock;
 	Array2D<char> m_attr;
 	float m_px, m_py, m_pz;  // stock zero position
@@ -165,8 +186,8 @@ private:
 	float m_res;        // resoulution
 	float m_plane;		// stock plane height
 	int m_x, m_y;            // stock array size
-	std::vector<MeshCore::MeshGeomFacet> facetsOuter;
-	std::vector<MeshCore::MeshGeomFacet> facetsInner;
+	int m_tx, m_ty;          // number of tiles
+	std::vector<cStockTile> m_tiles;
 };
 
 class cVolSim
@@ -28,22 +28,18 @@
 #endif
 
 #include <boost/math/special_functions/fpclassify.hpp>
-#include <QtConcurrentMap>
 
 #include <Base/Exception.h>
 #include <Base/Matrix.h>
 #include <Base/Persistence.h>
 #include <Base/Stream.h>
+#include <Base/ThreadPool.h>
 #include <Base/Writer.h>
 
 #include "Points.h"
 #include "PointsAlgos.h"
 #include "PointsPy.h"
 
-#ifdef _WIN32
-# include <ppl.h>
-#endif
-
 using namespace Points;
 using namespace std;
 
@@ -85,41 +81,36 @@ Data::Segment* PointKernel::getSubElement(const char* /*Type*/, unsigned long /*
 void PointKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     std::vector<value_type>& kernel = getBasicPoints();
-#ifdef _WIN32
-    // Win32-only at the moment since ppl.h is a Microsoft library. Points is not using Qt so we cannot use QtConcurrent
-    // We could also rewrite Points to leverage SIMD instructions
-    // Other option: openMP. But with VC2013 results in high CPU usage even after computation (busy-waits for >100ms)
-    Concurrency::parallel_for_each(kernel.begin(), kernel.end(), [rclMat](value_type& value) {
-        value = rclMat * value;
-    });
-#else
-    QtConcurrent::blockingMap(kernel, [rclMat](value_type& value) {
-        rclMat.multVec(value, value);
-    });
-#endif
+    if (kernel.empty())
+        return;
+
+    // Hand out blocks of points instead of single points to the threads
+    // so that Matrix4D::multVecs can run over contiguous memory
+    const std::size_t blockSize = 0x10000;
+    value_type* data = kernel.data();
+    std::size_t count = kernel.size();
+    Base::parallel_for(std::size_t(0), (count + blockSize - 1) / blockSize, [&rclMat, data, count, blockSize](std::size_t block) {
+        std::size_t start = block * blockSize;
+        rclMat.multVecs(data + start, data + std::min(start + blockSize, count));
+    }, std::size_t(1));
 }
 
 Base::BoundBox3d PointKernel::getBoundBox(void)const
 {
-    Base::BoundBox3d bnd;
-
-#ifdef _WIN32
-    // Thread-local bounding boxes
-    Concurrency::combinable<Base::BoundBox3d> bbs;
-    // Cannot use a const_point_iterator here as it is *not* a proper iterator (fails the for_each template)
-    Concurrency::parallel_for_each(_Points.begin(), _Points.end(), [this, &bbs](const value_type& value) {
-        Base::Vector3d vertd(value.x, value.y, value.z);
-        bbs.local().Add(this->_Mtrx * vertd);
-    });
-    // Combine each thread-local bounding box in the final bounding box
-    bbs.combine_each([&bnd](const Base::BoundBox3d& lbb) {
-        bnd.Add(lbb);
-    });
-#else
-    for (const_point_iterator it = begin(); it != end(); ++it)
-        bnd.Add(*it);
-#endif
-    return bnd;
+    // Thread-local bounding boxes combined in the final bounding box
+    return Base::parallel_reduce(std::size_t(0), _Points.size(), Base::BoundBox3d(),
+        [this](std::size_t first, std::size_t last, Base::BoundBox3d bnd) {
+            for (std::size_t i = first; i < last; ++i) {
+                const value_type& value = _Points[i];
+                Base::Vector3d vertd(value.x, value.y, value.z);
+                bnd.Add(this->_Mtrx * vertd);
+            }
+            return bnd;
+        },
+        [](Base::BoundBox3d bnd, const Base::BoundBox3d& part) {
+            bnd.Add(part);
+            return bnd;
+        }, std::size_t(0x10000));
 }
 
 void PointKernel::operator = (const PointKernel& Kernel)
@@ -179,9 +170,9 @@ void PointKernel::SaveDocFile (Base::Writer &writer) const
     uint32_t uCt = (uint32_t)size();
     str << uCt;
     // store the data without transforming it
-    for (std::vector<value_type>::const_iterator it = _Points.begin(); it != _Points.end(); ++it) {
-        str << it->x << it->y << it->z;
-    }
+    static_assert(sizeof(value_type) == 3 * sizeof(float_type), "Unexpected padding in point type");
+    if (uCt > 0)
+        str.write(&_Points[0].x, 3 * _Points.size());
 }
 
 void PointKernel::Restore(Base::XMLReader &reader)
@@ -207,11 +198,8 @@ void PointKernel::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt = 0;
     str >> uCt;
     _Points.resize(uCt);
-    for (unsigned long i=0; i < uCt; i++) {
-        float x, y, z;
-        str >> x >> y >> z;
-        _Points[i].Set(x,y,z);
-    }
+    if (uCt > 0)
+        str.read(&_Points[0].x, 3 * _Points.size());
 }
 
 void PointKernel::save(const char* file) const
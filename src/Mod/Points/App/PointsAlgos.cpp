@@ -39,8 +39,15 @@
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
 #include <memory>
+#include <QFile>
+#include <QtConcurrentMap>
 #include <boost/regex.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
@@ -48,6 +55,261 @@
 
 using namespace Points;
 
+namespace Points {
+
+/// Gives access to the content of a file from the current position of the stream
+/// on. If possible the file is memory-mapped, otherwise the data is read into a buffer.
+class FileData
+{
+public:
+    FileData(const Base::FileInfo& fi, std::istream& inp)
+        : mapped(nullptr), _begin(nullptr), _end(nullptr)
+    {
+        std::streamoff pos = inp.tellg();
+        file.setFileName(QString::fromUtf8(fi.filePath().c_str()));
+        if (pos >= 0 && file.open(QIODevice::ReadOnly)) {
+            qint64 size = file.size() - static_cast<qint64>(pos);
+            if (size > 0)
+                mapped = file.map(static_cast<qint64>(pos), size);
+            if (mapped) {
+                _begin = reinterpret_cast<const char*>(mapped);
+                _end = _begin + size;
+                return;
+            }
+        }
+
+        buffer.assign(std::istreambuf_iterator<char>(inp), std::istreambuf_iterator<char>());
+        _begin = buffer.data();
+        _end = _begin + buffer.size();
+    }
+    ~FileData()
+    {
+        if (mapped)
+            file.unmap(mapped);
+    }
+    const char* begin() const
+    {
+        return _begin;
+    }
+    const char* end() const
+    {
+        return _end;
+    }
+
+private:
+    QFile file;
+    uchar* mapped;
+    std::vector<char> buffer;
+    const char* _begin;
+    const char* _end;
+};
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline bool isBlankLine(const char* begin, const char* end)
+{
+    for (; begin != end; ++begin) {
+        if (!isSpace(*begin))
+            return false;
+    }
+    return true;
+}
+
+inline const char* lineEnd(const char* begin, const char* end)
+{
+    const char* eol = static_cast<const char*>(memchr(begin, '\n', end - begin));
+    return eol ? eol : end;
+}
+
+/// Skips \a count non-empty lines
+const char* skipLines(const char* begin, const char* end, std::size_t count)
+{
+    while (count > 0 && begin < end) {
+        const char* eol = lineEnd(begin, end);
+        if (!isBlankLine(begin, eol))
+            count--;
+        begin = eol + 1;
+    }
+    return std::min(begin, end);
+}
+
+/// Parses the next number of the line. Returns false if there is no valid number.
+inline bool parseNumber(const char*& ptr, const char* end, double& value)
+{
+    while (ptr != end && isSpace(*ptr))
+        ++ptr;
+    const char* start = ptr;
+    while (ptr != end && !isSpace(*ptr))
+        ++ptr;
+
+    char token[64];
+    std::size_t len = ptr - start;
+    if (len == 0 || len >= sizeof(token))
+        return false;
+    memcpy(token, start, len);
+    token[len] = '\0';
+
+    char* last = nullptr;
+    value = std::strtod(token, &last);
+    return last == token + len;
+}
+
+/// A part of the text that ends at a line boundary
+struct TextBlock
+{
+    const char* begin;
+    const char* end;
+    std::size_t rows;
+    std::size_t first;
+};
+
+std::vector<TextBlock> splitText(const char* begin, const char* end)
+{
+    const std::size_t blockSize = 0x400000;
+    std::vector<TextBlock> blocks;
+    while (begin < end) {
+        const char* last = end;
+        if (static_cast<std::size_t>(end - begin) > blockSize)
+            last = std::min(lineEnd(begin + blockSize, end) + 1, end);
+        TextBlock block = {begin, last, 0, 0};
+        blocks.push_back(block);
+        begin = last;
+    }
+    return blocks;
+}
+
+/// Parses in parallel the whitespace separated numbers of each non-empty line into a row of \a data
+void parseAsciiData(const char* begin, const char* end, Eigen::MatrixXd& data)
+{
+    std::size_t numPoints = data.rows();
+    std::size_t numFields = data.cols();
+
+    // the first row of each block is needed for the parallel parsing
+    std::vector<TextBlock> blocks = splitText(begin, end);
+    QtConcurrent::blockingMap(blocks, [](TextBlock& block) {
+        for (const char* ptr = block.begin; ptr < block.end;) {
+            const char* eol = lineEnd(ptr, block.end);
+            if (!isBlankLine(ptr, eol))
+                block.rows++;
+            ptr = eol + 1;
+        }
+    });
+
+    std::size_t rows = 0;
+    for (std::vector<TextBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        it->first = rows;
+        rows += it->rows;
+    }
+
+    std::atomic<bool> invalid(false);
+    QtConcurrent::blockingMap(blocks, [&data, &invalid, numPoints, numFields](TextBlock& block) {
+        std::size_t row = block.first;
+        for (const char* ptr = block.begin; ptr < block.end && row < numPoints;) {
+            const char* eol = lineEnd(ptr, block.end);
+            if (!isBlankLine(ptr, eol)) {
+                const char* pos = ptr;
+                for (std::size_t col = 0; col < numFields; col++) {
+                    if (isBlankLine(pos, eol))
+                        break;
+                    double value;
+                    if (!parseNumber(pos, eol, value)) {
+                        invalid = true;
+                        return;
+                    }
+                    data(row, col) = value;
+                }
+                ++row;
+            }
+            ptr = eol + 1;
+        }
+    });
+
+    if (invalid)
+        throw Base::BadFormatError("Invalid number");
+}
+
+/// Describes where the values of a field are located in binary data
+struct BinaryField
+{
+    std::size_t offset;
+    std::size_t stride;
+    char type;  // 'I' (signed), 'U' (unsigned) or 'F' (floating point)
+    int size;
+};
+
+template <typename T>
+void decodeValues(const char* base, std::size_t stride, bool swapByteOrder,
+                  std::size_t first, std::size_t last, std::size_t col, Eigen::MatrixXd& data)
+{
+    for (std::size_t i = first; i < last; i++) {
+        T value;
+        memcpy(&value, base + i * stride, sizeof(T));
+        if (swapByteOrder)
+            Base::SwapEndian<T>(value);
+        data(i, col) = static_cast<double>(value);
+    }
+}
+
+/// Copies the values of the fields in parallel blocks into the columns of \a data
+void decodeBinaryData(const char* begin, const char* end, bool swapByteOrder,
+                      const std::vector<BinaryField>& fields, Eigen::MatrixXd& data)
+{
+    std::size_t numPoints = data.rows();
+    if (numPoints == 0)
+        return;
+
+    std::size_t available = end - begin;
+    for (std::vector<BinaryField>::const_iterator it = fields.begin(); it != fields.end(); ++it) {
+        if (it->offset + (numPoints - 1) * it->stride + it->size > available)
+            throw Base::BadFormatError("File expects too many elements");
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    const std::size_t blockSize = 0x10000;
+    for (std::size_t i = 0; i < numPoints; i += blockSize)
+        blocks.emplace_back(i, std::min(i + blockSize, numPoints));
+
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t col = 0; col < fields.size(); col++) {
+            const BinaryField& field = fields[col];
+            const char* base = begin + field.offset;
+            std::size_t stride = field.stride;
+            std::size_t first = block.first;
+            std::size_t last = block.second;
+            switch (field.size) {
+            case 1:
+                if (field.type == 'I')
+                    decodeValues<int8_t>(base, stride, swapByteOrder, first, last, col, data);
+                else
+                    decodeValues<uint8_t>(base, stride, swapByteOrder, first, last, col, data);
+                break;
+            case 2:
+                if (field.type == 'I')
+                    decodeValues<int16_t>(base, stride, swapByteOrder, first, last, col, data);
+                else
+                    decodeValues<uint16_t>(base, stride, swapByteOrder, first, last, col, data);
+                break;
+            case 4:
+                if (field.type == 'I')
+                    decodeValues<int32_t>(base, stride, swapByteOrder, first, last, col, data);
+                else if (field.type == 'U')
+                    decodeValues<uint32_t>(base, stride, swapByteOrder, first, last, col, data);
+                else
+                    decodeValues<float>(base, stride, swapByteOrder, first, last, col, data);
+                break;
+            case 8:
+                decodeValues<double>(base, stride, swapByteOrder, first, last, col, data);
+                break;
+            }
+        }
+    });
+}
+
+}
+
 void PointsAlgos::Load(PointKernel &points, const char *FileName)
 {
     Base::FileInfo File(FileName);
@@ -64,57 +326,54 @@ void PointsAlgos::Load(PointKernel &points, const char *FileName)
 
 void PointsAlgos::LoadAscii(PointKernel &points, const char *FileName)
 {
-    boost::regex rx("^\\s*([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                     "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                     "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    //boost::regex rx("(\\b[0-9]+\\.([0-9]+\\b)?|\\.[0-9]+\\b)");
-    //boost::regex rx("^\\s*(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s*$");
-    boost::cmatch what;
-
-    Base::Vector3d pt;
-    int LineCnt=0;
-    std::string line;
     Base::FileInfo fi(FileName);
+    Base::ifstream file(fi, std::ios::in | std::ios::binary);
+    FileData buffer(fi, file);
+
+    // a valid line consists of exactly three numbers
+    auto parseLine = [](const char* ptr, const char* eol, Base::Vector3d& pt) {
+        return parseNumber(ptr, eol, pt.x) &&
+               parseNumber(ptr, eol, pt.y) &&
+               parseNumber(ptr, eol, pt.z) &&
+               isBlankLine(ptr, eol);
+    };
+
+    // count the points of each block to parse the blocks in parallel
+    std::vector<TextBlock> blocks = splitText(buffer.begin(), buffer.end());
+    QtConcurrent::blockingMap(blocks, [parseLine](TextBlock& block) {
+        Base::Vector3d pt;
+        for (const char* ptr = block.begin; ptr < block.end;) {
+            const char* eol = lineEnd(ptr, block.end);
+            if (parseLine(ptr, eol, pt))
+                block.rows++;
+            ptr = eol + 1;
+        }
+    });
 
-    Base::ifstream tmp_str(fi, std::ios::in);
-
-    // estimating size
-    while (std::getline(tmp_str,line))
-        LineCnt++;
-
-    // resize the PointKernel
-    points.resize(LineCnt);
-
-    Base::SequencerLauncher seq( "Loading points...", LineCnt );
-
-    // again to the beginning
-    Base::ifstream file(fi, std::ios::in);
-    LineCnt = 0;
+    std::size_t numPoints = 0;
+    for (std::vector<TextBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        it->first = numPoints;
+        numPoints += it->rows;
+    }
 
     try {
-        // read file
-        while (std::getline(file, line)) {
-            if (boost::regex_match(line.c_str(), what, rx)) {
-                pt.x = std::atof(what[1].first);
-                pt.y = std::atof(what[4].first);
-                pt.z = std::atof(what[7].first);
-
-                points.setPoint(LineCnt,pt);
-                seq.next();
-                LineCnt++;
+        points.clear();
+        points.resize(numPoints);
+        QtConcurrent::blockingMap(blocks, [parseLine, &points](const TextBlock& block) {
+            Base::Vector3d pt;
+            std::size_t index = block.first;
+            for (const char* ptr = block.begin; ptr < block.end;) {
+                const char* eol = lineEnd(ptr, block.end);
+                if (parseLine(ptr, eol, pt))
+                    points.setPoint(static_cast<int>(index++), pt);
+                ptr = eol + 1;
             }
-        }
+        });
     }
     catch (...) {
         points.clear();
         throw Base::BadFormatError("Reading in points failed.");
     }
-
-    // now remove the last points from the kernel
-    // Note: first we allocate memory corresponding to the number of lines (points and comments)
-    //       and read in the file twice. But then the size of the kernel is too high
-    if (LineCnt < (int)points.size())
-        points.erase(LineCnt, points.size());
 }
 
 // ----------------------------------------------------------------------------
@@ -240,73 +499,6 @@ public:
 
 typedef std::shared_ptr<Converter> ConverterPtr;
 
-class DataStreambuf : public std::streambuf
-{
-public:
-    explicit DataStreambuf(const std::vector<char>& data) : _buffer(data) {
-        _beg = 0;
-        _end = data.size();
-        _cur = 0;
-    }
-    ~DataStreambuf() {
-    }
-
-protected:
-    virtual int_type uflow() {
-        if (_cur == _end)
-            return traits_type::eof();
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur++]) & 0x000000ff;
-    }
-    virtual int_type underflow() {
-        if (_cur == _end)
-            return traits_type::eof();
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur]) & 0x000000ff;
-    }
-    virtual int_type pbackfail(int_type ch) {
-        if (_cur == _beg || (ch != traits_type::eof() && ch != _buffer[_cur-1]))
-            return traits_type::eof();
-
-        return static_cast<DataStreambuf::int_type>(_buffer[--_cur]) & 0x000000ff;
-    }
-    virtual std::streamsize showmanyc() {
-        return _end - _cur;
-    }
-    virtual pos_type seekoff(std::streambuf::off_type off,
-        std::ios_base::seekdir way,
-        std::ios_base::openmode = 
-            std::ios::in | std::ios::out) {
-        int p_pos=-1;
-        if (way == std::ios_base::beg)
-            p_pos = _beg;
-        else if (way == std::ios_base::end)
-            p_pos = _end;
-        else if (way == std::ios_base::cur)
-            p_pos = _cur;
-
-        if (p_pos > _end)
-            return traits_type::eof();
-
-        if (((p_pos + off) > _end) || ((p_pos + off) < _beg))
-            return traits_type::eof();
-
-        _cur = p_pos+ off;
-
-        return ((p_pos+off) - _beg);
-    }
-    virtual pos_type seekpos(std::streambuf::pos_type pos,
-        std::ios_base::openmode which =
-        std::ios::in | std::ios::out) {
-        (void)which;
-        return seekoff(pos, std::ios_base::beg);
-    }
-
-private:
-    const std::vector<char>& _buffer;
-    int _beg, _end, _cur;
-};
-
 //Taken from https://github.com/PointCloudLibrary/pcl/blob/master/io/src/lzf.cpp
 unsigned int 
 lzfDecompress (const void *const in_data,  unsigned int in_len,
@@ -518,14 +710,15 @@ void PlyReader::read(const std::string& filename)
     std::size_t numPoints = readHeader(inp, format, offset, fields, types, sizes);
 
     Eigen::MatrixXd data(numPoints, fields.size());
+    FileData buffer(fi, inp);
     if (format == "ascii") {
-        readAscii(inp, offset, data);
+        readAscii(buffer.begin(), buffer.end(), offset, data);
     }
     else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
+        readBinary(false, buffer.begin(), buffer.end(), offset, types, sizes, data);
     }
     else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
+        readBinary(true, buffer.begin(), buffer.end(), offset, types, sizes, data);
     }
 
     std::vector<std::string>::iterator it;
@@ -821,90 +1014,60 @@ std::size_t PlyReader::readHeader(std::istream& in,
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
+void PlyReader::readAscii(const char* begin, const char* end, std::size_t offset, Eigen::MatrixXd& data)
 {
-    std::string line;
-    std::size_t row = 0;
-    std::size_t numPoints = data.rows();
-    std::size_t numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty())
-            continue;
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        for (std::size_t col = 0; col < list.size() && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
+    // skip the lines of the elements before the vertices
+    begin = skipLines(begin, end, offset);
+    parseAsciiData(begin, end, data);
 }
 
 void PlyReader::readBinary(bool swapByteOrder,
-                           std::istream& inp,
+                           const char* begin,
+                           const char* end,
                            std::size_t offset,
                            const std::vector<std::string>& types,
                            const std::vector<int>& sizes,
                            Eigen::MatrixXd& data)
 {
-    std::size_t numPoints = data.rows();
     std::size_t numFields = data.cols();
 
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
+    std::size_t neededSize = 0;
+    std::vector<BinaryField> fields;
     for (std::size_t j=0; j<numFields; j++) {
         std::string t = types[j];
+        BinaryField field;
+        field.offset = offset + neededSize;
+        field.size = sizes[j];
         switch (sizes[j]) {
         case 1:
             if (t == "char" || t == "int8")
-                converters.push_back(convert_int8);
+                field.type = 'I';
             else if (t == "uchar" || t == "uint8")
-                converters.push_back(convert_uint8);
+                field.type = 'U';
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
         case 2:
             if (t == "short" || t == "int16")
-                converters.push_back(convert_int16);
+                field.type = 'I';
             else if (t == "ushort" || t == "uint16")
-                converters.push_back(convert_uint16);
+                field.type = 'U';
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
         case 4:
             if (t == "int" || t == "int32")
-                converters.push_back(convert_int32);
+                field.type = 'I';
             else if (t == "uint" || t == "uint32")
-                converters.push_back(convert_uint32);
+                field.type = 'U';
             else if (t == "float" || t == "float32")
-                converters.push_back(convert_float32);
+                field.type = 'F';
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
         case 8:
             if (t == "double" || t == "float64")
-                converters.push_back(convert_float64);
+                field.type = 'F';
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
@@ -912,28 +1075,15 @@ void PlyReader::readBinary(bool swapByteOrder,
             throw Base::BadFormatError("Unexpected type");
         }
 
-        neededSize += converters.back()->getSizeOf();
+        neededSize += field.size;
+        fields.push_back(field);
     }
 
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(static_cast<std::streamoff>(offset), std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize*static_cast<std::streamoff>(numPoints) > ulSize)
-            throw Base::BadFormatError("File expects too many elements");
-    }
+    // the properties of a vertex are stored one after another
+    for (std::vector<BinaryField>::iterator it = fields.begin(); it != fields.end(); ++it)
+        it->stride = neededSize;
 
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (std::size_t i=0; i<numPoints; i++) {
-        for (std::size_t j=0; j<numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
+    decodeBinaryData(begin, end, swapByteOrder, fields, data);
 }
 
 // ----------------------------------------------------------------------------
@@ -963,10 +1113,12 @@ void PcdReader::read(const std::string& filename)
 
     Eigen::MatrixXd data(numPoints, fields.size());
     if (format == "ascii") {
-        readAscii(inp, data);
+        FileData buffer(fi, inp);
+        readAscii(buffer.begin(), buffer.end(), data);
     }
     else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
+        FileData buffer(fi, inp);
+        readBinary(false, buffer.begin(), buffer.end(), types, sizes, data);
     }
     else if (format == "binary_compressed") {
         unsigned int c, u;
@@ -977,10 +1129,7 @@ void PcdReader::read(const std::string& filename)
         inp.read(&compressed[0], c);
         std::vector<char> uncompressed(u);
         if (lzfDecompress(&compressed[0], c, &uncompressed[0], u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(0);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
+            readBinary(true, uncompressed.data(), uncompressed.data() + uncompressed.size(), types, sizes, data);
         }
         else {
             throw Base::BadFormatError("Failed to decompress binary data");
@@ -1183,34 +1332,14 @@ std::size_t PcdReader::readHeader(std::istream& in,
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
+void PcdReader::readAscii(const char* begin, const char* end, Eigen::MatrixXd& data)
 {
-    std::string line;
-    std::size_t row = 0;
-    std::size_t numPoints = data.rows();
-    std::size_t numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty())
-            continue;
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        for (std::size_t col = 0; col < list.size() && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
+    parseAsciiData(begin, end, data);
 }
 
 void PcdReader::readBinary(bool transpose,
-                           std::istream& inp,
+                           const char* begin,
+                           const char* end,
                            const std::vector<std::string>& types,
                            const std::vector<int>& sizes,
                            Eigen::MatrixXd& data)
@@ -1218,87 +1347,50 @@ void PcdReader::readBinary(bool transpose,
     std::size_t numPoints = data.rows();
     std::size_t numFields = data.cols();
 
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
+    std::size_t neededSize = 0;
+    std::vector<BinaryField> fields;
     for (std::size_t j=0; j<numFields; j++) {
         char t = types[j][0];
+        BinaryField field;
+        field.type = t;
+        field.size = sizes[j];
         switch (sizes[j]) {
         case 1:
-            if (t == 'I')
-                converters.push_back(convert_int8);
-            else if (t == 'U')
-                converters.push_back(convert_uint8);
-            else
-                throw Base::BadFormatError("Unexpected type");
-            break;
         case 2:
-            if (t == 'I')
-                converters.push_back(convert_int16);
-            else if (t == 'U')
-                converters.push_back(convert_uint16);
-            else
+            if (t != 'I' && t != 'U')
                 throw Base::BadFormatError("Unexpected type");
             break;
         case 4:
-            if (t == 'I')
-                converters.push_back(convert_int32);
-            else if (t == 'U')
-                converters.push_back(convert_uint32);
-            else if (t == 'F')
-                converters.push_back(convert_float32);
-            else
+            if (t != 'I' && t != 'U' && t != 'F')
                 throw Base::BadFormatError("Unexpected type");
             break;
         case 8:
-            if (t == 'F')
-                converters.push_back(convert_float64);
-            else
+            if (t != 'F')
                 throw Base::BadFormatError("Unexpected type");
             break;
         default:
             throw Base::BadFormatError("Unexpected type");
         }
 
-        neededSize += converters.back()->getSizeOf();
-    }
+        // with transposed data all values of a field are stored one after another
+        if (transpose) {
+            field.offset = numPoints * neededSize;
+            field.stride = field.size;
+        }
+        else {
+            field.offset = neededSize;
+        }
 
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize*static_cast<std::streamoff>(numPoints) > ulSize)
-            throw Base::BadFormatError("File expects too many elements");
+        neededSize += field.size;
+        fields.push_back(field);
     }
 
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (std::size_t j=0; j<numFields; j++) {
-            for (std::size_t i=0; i<numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (std::size_t i=0; i<numPoints; i++) {
-            for (std::size_t j=0; j<numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
+    if (!transpose) {
+        for (std::vector<BinaryField>::iterator it = fields.begin(); it != fields.end(); ++it)
+            it->stride = neededSize;
     }
+
+    decodeBinaryData(begin, end, false, fields, data);
 }
 
 // ----------------------------------------------------------------------------
@@ -44,7 +44,7 @@ public:
     static void LoadAscii(PointKernel&, const char *FileName);
 };
 
-class Reader
+class PointsExport Reader
 {
 public:
     Reader();
@@ -72,7 +72,7 @@ protected:
     int width, height;
 };
 
-class AscReader : public Reader
+class PointsExport AscReader : public Reader
 {
 public:
     AscReader();
@@ -80,7 +80,7 @@ public:
     void read(const std::string& filename);
 };
 
-class PlyReader : public Reader
+class PointsExport PlyReader : public Reader
 {
 public:
     PlyReader();
@@ -91,14 +91,14 @@ private:
     std::size_t readHeader(std::istream&, std::string& format, std::size_t& offset,
         std::vector<std::string>& fields, std::vector<std::string>& types,
         std::vector<int>& sizes);
-    void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
-    void readBinary(bool swapByteOrder, std::istream&, std::size_t offset,
+    void readAscii(const char* begin, const char* end, std::size_t offset, Eigen::MatrixXd& data);
+    void readBinary(bool swapByteOrder, const char* begin, const char* end, std::size_t offset,
         const std::vector<std::string>& types,
         const std::vector<int>& sizes,
         Eigen::MatrixXd& data);
 };
 
-class PcdReader : public Reader
+class PointsExport PcdReader : public Reader
 {
 public:
     PcdReader();
@@ -108,14 +108,14 @@ public:
 private:
     std::size_t readHeader(std::istream&, std::string& format, std::vector<std::string>& fields,
         std::vector<std::string>& types, std::vector<int>& sizes);
-    void readAscii(std::istream&, Eigen::MatrixXd& data);
-    void readBinary(bool transpose, std::istream&,
+    void readAscii(const char* begin, const char* end, Eigen::MatrixXd& data);
+    void readBinary(bool transpose, const char* begin, const char* end,
         const std::vector<std::string>& types,
         const std::vector<int>& sizes,
         Eigen::MatrixXd& data);
 };
 
-class Writer
+class PointsExport Writer
 {
 public:
     Writer(const PointKernel&);
@@ -138,7 +138,7 @@ protected:
     Base::Placement placement;
 };
 
-class AscWriter : public Writer
+class PointsExport AscWriter : public Writer
 {
 public:
     AscWriter(const PointKernel&);
@@ -146,7 +146,7 @@ public:
     void write(const std::string& filename);
 };
 
-class PlyWriter : public Writer
+class PointsExport PlyWriter : public Writer
 {
 public:
     PlyWriter(const PointKernel&);
@@ -154,7 +154,7 @@ public:
     void write(const std::string& filename);
 };
 
-class PcdWriter : public Writer
+class PointsExport PcdWriter : public Writer
 {
 public:
     PcdWriter(const PointKernel&);
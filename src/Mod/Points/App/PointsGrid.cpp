@@ -25,9 +25,15 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <cfloat>
+# include <climits>
+# include <cmath>
+# include <functional>
+# include <queue>
 #endif
 
-
+#include <QtConcurrentMap>
+#include <boost/math/special_functions/fpclassify.hpp>
 
 #include "PointsGrid.h"
 
@@ -822,3 +828,368 @@ bool PointsGridIterator::NextOnRay (std::vector<unsigned long> &raulElements)
 
   return _bValidRay;
 }
+
+// ----------------------------------------------------------------
+
+namespace {
+struct HashBlock
+{
+  std::size_t first;
+  std::size_t last;
+  Base::BoundBox3d box;
+};
+
+std::vector<HashBlock> makeBlocks(std::size_t count, std::size_t blockSize = 0x10000)
+{
+  std::vector<HashBlock> blocks;
+  for (std::size_t i = 0; i < count; i += blockSize) {
+    HashBlock block;
+    block.first = i;
+    block.last = std::min(i + blockSize, count);
+    blocks.push_back(block);
+  }
+  return blocks;
+}
+
+inline bool isValid(const Base::Vector3d& pt)
+{
+  return !(boost::math::isnan(pt.x) || boost::math::isnan(pt.y) || boost::math::isnan(pt.z));
+}
+
+/// Collects the k nearest points
+struct NearestVisitor
+{
+  NearestVisitor(const Base::Vector3d& pt, unsigned long k) : pt(pt), k(k) {}
+  bool isFull() const
+  { return heap.size() >= k; }
+  double maxDist() const
+  { return heap.empty() ? DBL_MAX : heap.top().first; }
+  void operator()(std::size_t pos, const Base::Vector3f& p)
+  {
+    double dist = Base::DistanceP2(pt, Base::Vector3d(p.x, p.y, p.z));
+    if (heap.size() < k) {
+      heap.push(std::make_pair(dist, pos));
+    }
+    else if (dist < heap.top().first) {
+      heap.pop();
+      heap.push(std::make_pair(dist, pos));
+    }
+  }
+
+  Base::Vector3d pt;
+  std::size_t k;
+  std::priority_queue<std::pair<double, std::size_t> > heap;
+};
+
+/// Collects the points inside a sphere
+struct RadiusVisitor
+{
+  RadiusVisitor(const Base::Vector3d& pt, double radius, const std::vector<unsigned long>& index,
+                std::vector<unsigned long>& elements)
+    : pt(pt), radius2(radius * radius), index(index), elements(elements) {}
+  void operator()(std::size_t pos, const Base::Vector3f& p)
+  {
+    if (Base::DistanceP2(pt, Base::Vector3d(p.x, p.y, p.z)) <= radius2)
+      elements.push_back(index[pos]);
+  }
+
+  Base::Vector3d pt;
+  double radius2;
+  const std::vector<unsigned long>& index;
+  std::vector<unsigned long>& elements;
+};
+
+/// Collects the points inside a box
+struct BoxVisitor
+{
+  BoxVisitor(const Base::BoundBox3d& box, const std::vector<unsigned long>& index,
+             std::vector<unsigned long>& elements)
+    : box(box), index(index), elements(elements) {}
+  void operator()(std::size_t pos, const Base::Vector3f& p)
+  {
+    if (box.IsInBox(Base::Vector3d(p.x, p.y, p.z)))
+      elements.push_back(index[pos]);
+  }
+
+  Base::BoundBox3d box;
+  const std::vector<unsigned long>& index;
+  std::vector<unsigned long>& elements;
+};
+}
+
+PointsHashGrid::PointsHashGrid (const PointKernel &rclM, unsigned long ulPerGrid)
+: _rclPoints(rclM),
+  _ulMask(0),
+  _lCtGridsX(0), _lCtGridsY(0), _lCtGridsZ(0),
+  _fGridLen(1.0)
+{
+  Rebuild(ulPerGrid);
+}
+
+void PointsHashGrid::Rebuild (unsigned long ulPerGrid)
+{
+  std::size_t ulCtPoints = _rclPoints.size();
+  ulPerGrid = std::max<unsigned long>(ulPerGrid, 1);
+
+  // transform the points and compute the bounding box of the valid points in parallel,
+  // the points are rounded to the precision they are stored with
+  std::vector<Base::Vector3d> aclPoints(ulCtPoints);
+  std::vector<HashBlock> blocks = makeBlocks(ulCtPoints);
+  QtConcurrent::blockingMap(blocks, [this, &aclPoints](HashBlock& block) {
+    for (std::size_t i = block.first; i < block.last; i++) {
+      Base::Vector3d pt = _rclPoints.getPoint(static_cast<int>(i));
+      aclPoints[i].Set(static_cast<float>(pt.x), static_cast<float>(pt.y), static_cast<float>(pt.z));
+      if (isValid(aclPoints[i]))
+        block.box.Add(aclPoints[i]);
+    }
+  });
+
+  Base::BoundBox3d clBB;
+  for (std::vector<HashBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+    if (it->box.IsValid())
+      clBB.Add(it->box);
+  }
+
+  std::size_t ulCtValid = 0;
+  if (clBB.IsValid()) {
+    // choose the grid length so that a grid element on average contains ulPerGrid points,
+    // flat or linear clouds are handled by ignoring the collapsed directions
+    double ext[3] = {clBB.LengthX(), clBB.LengthY(), clBB.LengthZ()};
+    std::sort(ext, ext + 3, std::greater<double>());
+    double fRatio = double(ulPerGrid) / double(ulCtPoints);
+    double fLen = std::cbrt(ext[0] * ext[1] * ext[2] * fRatio);
+    if (ext[2] <= fLen)
+      fLen = std::sqrt(ext[0] * ext[1] * fRatio);
+    if (ext[1] <= fLen)
+      fLen = ext[0] * fRatio;
+    if (!(fLen > 0.0))
+      fLen = 1.0;
+
+    _fGridLen = fLen;
+    _clMin = Base::Vector3d(clBB.MinX, clBB.MinY, clBB.MinZ);
+    _lCtGridsX = static_cast<long>(clBB.LengthX() / fLen) + 1;
+    _lCtGridsY = static_cast<long>(clBB.LengthY() / fLen) + 1;
+    _lCtGridsZ = static_cast<long>(clBB.LengthZ() / fLen) + 1;
+  }
+  else {
+    _fGridLen = 1.0;
+    _clMin = Base::Vector3d();
+    _lCtGridsX = _lCtGridsY = _lCtGridsZ = 0;
+  }
+
+  std::size_t ulCtBuckets = 1;
+  while (ulCtBuckets * ulPerGrid < ulCtPoints)
+    ulCtBuckets <<= 1;
+  _ulMask = ulCtBuckets - 1;
+
+  // compute the bucket of each point in parallel, invalid points are skipped
+  const std::size_t ulInvalid = ulCtBuckets;
+  std::vector<std::size_t> aulBucket(ulCtPoints);
+  QtConcurrent::blockingMap(blocks, [this, &aclPoints, &aulBucket, ulInvalid](const HashBlock& block) {
+    long x, y, z;
+    for (std::size_t i = block.first; i < block.last; i++) {
+      if (isValid(aclPoints[i])) {
+        Pos(aclPoints[i], x, y, z);
+        aulBucket[i] = Bucket(x, y, z);
+      }
+      else {
+        aulBucket[i] = ulInvalid;
+      }
+    }
+  });
+
+  // counting sort of the points by bucket
+  _aulStart.assign(ulCtBuckets + 1, 0);
+  for (std::vector<std::size_t>::iterator it = aulBucket.begin(); it != aulBucket.end(); ++it) {
+    if (*it != ulInvalid) {
+      _aulStart[*it + 1]++;
+      ulCtValid++;
+    }
+  }
+  for (std::size_t i = 0; i < ulCtBuckets; i++)
+    _aulStart[i + 1] += _aulStart[i];
+
+  _aclPoints.resize(ulCtValid);
+  _aulIndex.resize(ulCtValid);
+  std::vector<unsigned long> aulPos(_aulStart.begin(), _aulStart.end() - 1);
+  for (std::size_t i = 0; i < ulCtPoints; i++) {
+    std::size_t ulBucket = aulBucket[i];
+    if (ulBucket != ulInvalid) {
+      unsigned long ulPos = aulPos[ulBucket]++;
+      const Base::Vector3d& pt = aclPoints[i];
+      _aclPoints[ulPos].Set(static_cast<float>(pt.x), static_cast<float>(pt.y), static_cast<float>(pt.z));
+      _aulIndex[ulPos] = static_cast<unsigned long>(i);
+    }
+  }
+}
+
+inline void PointsHashGrid::Pos (const Base::Vector3d &rclPt, long &rlX, long &rlY, long &rlZ) const
+{
+  rlX = static_cast<long>(std::floor((rclPt.x - _clMin.x) / _fGridLen));
+  rlY = static_cast<long>(std::floor((rclPt.y - _clMin.y) / _fGridLen));
+  rlZ = static_cast<long>(std::floor((rclPt.z - _clMin.z) / _fGridLen));
+}
+
+inline std::size_t PointsHashGrid::Bucket (long lX, long lY, long lZ) const
+{
+  std::size_t ulHash = (static_cast<std::size_t>(lX) * 73856093) ^
+                       (static_cast<std::size_t>(lY) * 19349663) ^
+                       (static_cast<std::size_t>(lZ) * 83492791);
+  return ulHash & _ulMask;
+}
+
+template <class Visitor>
+void PointsHashGrid::VisitElements (long lX, long lY, long lZ, Visitor& visit) const
+{
+  if (lX < 0 || lY < 0 || lZ < 0 || lX >= _lCtGridsX || lY >= _lCtGridsY || lZ >= _lCtGridsZ)
+    return;
+
+  // a bucket can be shared by several grid elements
+  std::size_t ulBucket = Bucket(lX, lY, lZ);
+  long x, y, z;
+  for (unsigned long i = _aulStart[ulBucket]; i < _aulStart[ulBucket + 1]; i++) {
+    const Base::Vector3f& p = _aclPoints[i];
+    Pos(Base::Vector3d(p.x, p.y, p.z), x, y, z);
+    if (x == lX && y == lY && z == lZ)
+      visit(i, p);
+  }
+}
+
+unsigned long PointsHashGrid::InSide (const Base::BoundBox3d &rclBB, std::vector<unsigned long> &raulElements) const
+{
+  std::size_t ulCt = raulElements.size();
+  if (_aclPoints.empty() || !rclBB.IsValid())
+    return 0;
+
+  long minX, minY, minZ, maxX, maxY, maxZ;
+  Pos(Base::Vector3d(rclBB.MinX, rclBB.MinY, rclBB.MinZ), minX, minY, minZ);
+  Pos(Base::Vector3d(rclBB.MaxX, rclBB.MaxY, rclBB.MaxZ), maxX, maxY, maxZ);
+
+  BoxVisitor visit(rclBB, _aulIndex, raulElements);
+  for (long x = std::max<long>(minX, 0); x <= std::min<long>(maxX, _lCtGridsX - 1); x++) {
+    for (long y = std::max<long>(minY, 0); y <= std::min<long>(maxY, _lCtGridsY - 1); y++) {
+      for (long z = std::max<long>(minZ, 0); z <= std::min<long>(maxZ, _lCtGridsZ - 1); z++)
+        VisitElements(x, y, z, visit);
+    }
+  }
+
+  return static_cast<unsigned long>(raulElements.size() - ulCt);
+}
+
+unsigned long PointsHashGrid::SearchRadius (const Base::Vector3d &rclPt, double fRadius, std::vector<unsigned long> &raulElements) const
+{
+  std::size_t ulCt = raulElements.size();
+  if (_aclPoints.empty() || fRadius < 0.0 || !isValid(rclPt))
+    return 0;
+
+  long minX, minY, minZ, maxX, maxY, maxZ;
+  Pos(Base::Vector3d(rclPt.x - fRadius, rclPt.y - fRadius, rclPt.z - fRadius), minX, minY, minZ);
+  Pos(Base::Vector3d(rclPt.x + fRadius, rclPt.y + fRadius, rclPt.z + fRadius), maxX, maxY, maxZ);
+
+  RadiusVisitor visit(rclPt, fRadius, _aulIndex, raulElements);
+  for (long x = std::max<long>(minX, 0); x <= std::min<long>(maxX, _lCtGridsX - 1); x++) {
+    for (long y = std::max<long>(minY, 0); y <= std::min<long>(maxY, _lCtGridsY - 1); y++) {
+      for (long z = std::max<long>(minZ, 0); z <= std::min<long>(maxZ, _lCtGridsZ - 1); z++)
+        VisitElements(x, y, z, visit);
+    }
+  }
+
+  return static_cast<unsigned long>(raulElements.size() - ulCt);
+}
+
+unsigned long PointsHashGrid::SearchNearest (const Base::Vector3d &rclPt, unsigned long ulK, std::vector<unsigned long> &raulElements,
+                                             std::vector<double>* pDistances) const
+{
+  if (_aclPoints.empty() || ulK == 0 || !isValid(rclPt))
+    return 0;
+
+  long cX, cY, cZ;
+  Pos(rclPt, cX, cY, cZ);
+
+  // the distance to the border of the grid element of the point
+  double fBorder = _fGridLen;
+  double fOff[3] = {rclPt.x - _clMin.x - cX * _fGridLen,
+                    rclPt.y - _clMin.y - cY * _fGridLen,
+                    rclPt.z - _clMin.z - cZ * _fGridLen};
+  for (int i = 0; i < 3; i++)
+    fBorder = std::min(fBorder, std::min(fOff[i], _fGridLen - fOff[i]));
+  fBorder = std::max(fBorder, 0.0);
+
+  // the first shell that touches the grid and the shell where all grid elements are visited
+  long lMinShell = std::max(std::max(std::max(-cX, cX - _lCtGridsX + 1), std::max(-cY, cY - _lCtGridsY + 1)),
+                            std::max(std::max(-cZ, cZ - _lCtGridsZ + 1), 0L));
+  long lMaxShell = std::max(std::max(std::max(cX, _lCtGridsX - 1 - cX), std::max(cY, _lCtGridsY - 1 - cY)),
+                            std::max(cZ, _lCtGridsZ - 1 - cZ));
+
+  // search in shells of grid elements around the point until the found points are closer
+  // than the elements of the next shell can be
+  NearestVisitor visit(rclPt, ulK);
+  for (long s = lMinShell; s <= lMaxShell; s++) {
+    for (long x = std::max<long>(cX - s, 0); x <= std::min<long>(cX + s, _lCtGridsX - 1); x++) {
+      for (long y = std::max<long>(cY - s, 0); y <= std::min<long>(cY + s, _lCtGridsY - 1); y++) {
+        if (std::abs(x - cX) == s || std::abs(y - cY) == s) {
+          for (long z = std::max<long>(cZ - s, 0); z <= std::min<long>(cZ + s, _lCtGridsZ - 1); z++)
+            VisitElements(x, y, z, visit);
+        }
+        else {
+          VisitElements(x, y, cZ - s, visit);
+          VisitElements(x, y, cZ + s, visit);
+        }
+      }
+    }
+
+    double fReach = s * _fGridLen + fBorder;
+    if (visit.isFull() && visit.maxDist() <= fReach * fReach)
+      break;
+  }
+
+  std::size_t ulCt = visit.heap.size();
+  std::size_t ulOffset = raulElements.size();
+  raulElements.resize(ulOffset + ulCt);
+  if (pDistances)
+    pDistances->resize(pDistances->size() + ulCt);
+  for (std::size_t i = ulCt; i > 0; i--) {
+    raulElements[ulOffset + i - 1] = _aulIndex[visit.heap.top().second];
+    if (pDistances)
+      (*pDistances)[pDistances->size() - ulCt + i - 1] = std::sqrt(visit.heap.top().first);
+    visit.heap.pop();
+  }
+
+  return static_cast<unsigned long>(ulCt);
+}
+
+bool PointsHashGrid::NearestPoint (const Base::Vector3d &rclPt, unsigned long &rulIndex, double &rfDistance) const
+{
+  std::vector<unsigned long> aulElements;
+  std::vector<double> afDistances;
+  if (SearchNearest(rclPt, 1, aulElements, &afDistances) == 0)
+    return false;
+  rulIndex = aulElements.front();
+  rfDistance = afDistances.front();
+  return true;
+}
+
+void PointsHashGrid::SearchNearest (const std::vector<Base::Vector3d> &rclPts, unsigned long ulK, std::vector<unsigned long> &raulElements) const
+{
+  raulElements.assign(rclPts.size() * ulK, ULONG_MAX);
+  std::vector<HashBlock> blocks = makeBlocks(rclPts.size(), 0x1000);
+  QtConcurrent::blockingMap(blocks, [this, &rclPts, ulK, &raulElements](const HashBlock& block) {
+    std::vector<unsigned long> aulNear;
+    for (std::size_t i = block.first; i < block.last; i++) {
+      aulNear.clear();
+      SearchNearest(rclPts[i], ulK, aulNear);
+      std::copy(aulNear.begin(), aulNear.end(), raulElements.begin() + i * ulK);
+    }
+  });
+}
+
+void PointsHashGrid::SearchRadius (const std::vector<Base::Vector3d> &rclPts, double fRadius, std::vector<std::vector<unsigned long> > &raulElements) const
+{
+  raulElements.clear();
+  raulElements.resize(rclPts.size());
+  std::vector<HashBlock> blocks = makeBlocks(rclPts.size(), 0x1000);
+  QtConcurrent::blockingMap(blocks, [this, &rclPts, fRadius, &raulElements](const HashBlock& block) {
+    for (std::size_t i = block.first; i < block.last; i++)
+      SearchRadius(rclPts[i], fRadius, raulElements[i]);
+  });
+}
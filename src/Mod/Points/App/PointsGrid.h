@@ -34,6 +34,7 @@
 #define  POINTS_MAX_GRIDS        100000  // Default value for maximum number of grids
 #define  POINTS_CT_GRID_PER_AXIS 20
 #define  PONTSGRID_BBOX_EXTENSION 10.0f
+#define  POINTS_CT_HASHGRID      8       // Default value for average number of points per hash grid element
 
 
 namespace Points {
@@ -243,6 +244,78 @@ protected:
 
 // --------------------------------------------------------------
 
+/**
+ * The PointsHashGrid class is a compact spatial index for the points of a point kernel.
+ * The points are assigned to cubic cells that are mapped by a hash function onto a fixed
+ * number of buckets, so the memory usage only depends on the number of points and not
+ * on the extent of the cloud. The points of each bucket are stored contiguously.
+ * The grid is built in parallel and once built all search methods are read-only and can
+ * be called from several threads at the same time.
+ */
+class PointsExport PointsHashGrid
+{
+public:
+  /// Construction
+  PointsHashGrid (const PointKernel &rclM, unsigned long ulPerGrid = POINTS_CT_HASHGRID);
+  /// Destruction
+  ~PointsHashGrid (void) { }
+
+  /** Rebuilds the grid for the current state of the point kernel. \a ulPerGrid is
+   * the average number of points per grid element. */
+  void Rebuild (unsigned long ulPerGrid = POINTS_CT_HASHGRID);
+
+  /** @name Search */
+  //@{
+  /** Searches for the points inside the bounding box and returns their number. */
+  unsigned long InSide (const Base::BoundBox3d &rclBB, std::vector<unsigned long> &raulElements) const;
+  /** Searches for the points with a distance of at most \a fRadius to \a rclPt and returns
+   * their number. */
+  unsigned long SearchRadius (const Base::Vector3d &rclPt, double fRadius, std::vector<unsigned long> &raulElements) const;
+  /** Searches for the \a ulK nearest points of \a rclPt sorted by increasing distance and
+   * returns their number. If \a pDistances is not null the distances are returned, too. */
+  unsigned long SearchNearest (const Base::Vector3d &rclPt, unsigned long ulK, std::vector<unsigned long> &raulElements,
+                               std::vector<double>* pDistances = 0) const;
+  /** Searches for the nearest point of \a rclPt. Returns false if the grid is empty. */
+  bool NearestPoint (const Base::Vector3d &rclPt, unsigned long &rulIndex, double &rfDistance) const;
+  /** Searches in parallel for the \a ulK nearest points of each point of \a rclPts. The indices
+   * of the i-th point are stored at position i*ulK of \a raulElements. If fewer than \a ulK
+   * points exist the remaining positions are set to ULONG_MAX. */
+  void SearchNearest (const std::vector<Base::Vector3d> &rclPts, unsigned long ulK, std::vector<unsigned long> &raulElements) const;
+  /** Searches in parallel for the points with a distance of at most \a fRadius to each point of \a rclPts. */
+  void SearchRadius (const std::vector<Base::Vector3d> &rclPts, double fRadius, std::vector<std::vector<unsigned long> > &raulElements) const;
+  //@}
+
+  /** Returns the edge length of the grid elements. */
+  double GetGridLength (void) const
+  { return _fGridLen; }
+  /** Returns the number of stored points. */
+  unsigned long HasElements (void) const
+  { return static_cast<unsigned long>(_aulIndex.size()); }
+
+protected:
+  /** Returns the position of the grid element that contains \a rclPt. */
+  inline void Pos (const Base::Vector3d &rclPt, long &rlX, long &rlY, long &rlZ) const;
+  /** Returns the bucket of the given grid element. */
+  inline std::size_t Bucket (long lX, long lY, long lZ) const;
+  /** Checks the points of the given grid element against the query of the visitor. */
+  template <class Visitor>
+  void VisitElements (long lX, long lY, long lZ, Visitor& visit) const;
+
+private:
+  const PointKernel &_rclPoints;       /**< The point kernel. */
+  std::vector<Base::Vector3f> _aclPoints; /**< The transformed points in bucket order. */
+  std::vector<unsigned long> _aulIndex; /**< The index of each point in the point kernel. */
+  std::vector<unsigned long> _aulStart; /**< The first point of each bucket. */
+  std::size_t        _ulMask;          /**< The number of buckets minus one. */
+  long               _lCtGridsX;       /**< Number of grid elements in x. */
+  long               _lCtGridsY;       /**< Number of grid elements in y. */
+  long               _lCtGridsZ;       /**< Number of grid elements in z. */
+  double             _fGridLen;        /**< Length of grid elements. */
+  Base::Vector3d     _clMin;           /**< Grid null position. */
+};
+
+// --------------------------------------------------------------
+
 inline Base::BoundBox3d  PointsGrid::GetBoundBox (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
 {
   double fX, fY, fZ;
@@ -27,6 +27,7 @@
 #include <Base/Builder3D.h>
 #include <Base/VectorPy.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/PyBuffer.h>
 #include <boost/math/special_functions/fpclassify.hpp>
 
 // inclusion of the generated files (generated out of PointsPy.xml)
@@ -169,6 +170,45 @@ PyObject* PointsPy::addPoints(PyObject * args)
     Py_Return;
 }
 
+PyObject* PointsPy::getPointArray(PyObject * args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    const std::vector<PointKernel::value_type>& points = getPointKernelPtr()->getBasicPoints();
+    Py_ssize_t count = static_cast<Py_ssize_t>(points.size());
+    return Base::createArrayView(count, 3, "f", sizeof(float), [&points](char* data) {
+        float* coords = reinterpret_cast<float*>(data);
+        for (const auto& it : points) {
+            *coords++ = it.x;
+            *coords++ = it.y;
+            *coords++ = it.z;
+        }
+    });
+}
+
+PyObject* PointsPy::setPointArray(PyObject * args)
+{
+    PyObject *obj;
+    if (!PyArg_ParseTuple(args, "O", &obj))
+        return 0;
+
+    std::vector<double> coords;
+    if (!Base::readArrayBuffer(obj, 3, coords))
+        return 0;
+
+    std::vector<PointKernel::value_type> points;
+    points.reserve(coords.size() / 3);
+    for (std::size_t i = 0; i < coords.size(); i += 3) {
+        points.emplace_back(static_cast<PointKernel::float_type>(coords[i]),
+                            static_cast<PointKernel::float_type>(coords[i+1]),
+                            static_cast<PointKernel::float_type>(coords[i+2]));
+    }
+    getPointKernelPtr()->swap(points);
+
+    Py_Return;
+}
+
 PyObject* PointsPy::fromSegment(PyObject * args)
 {
     PyObject *obj;
@@ -35,16 +35,12 @@
 #include <Base/Stream.h>
 #include <Base/Writer.h>
 #include <Base/VectorPy.h>
+#include <Base/ThreadPool.h>
 
 #include "Points.h"
 #include "Properties.h"
 #include "PointsPy.h"
 
-#include <QtConcurrentMap>
-#ifdef _WIN32
-# include <ppl.h>
-#endif
-
 using namespace Points;
 using namespace std;
 
@@ -158,9 +154,8 @@ void PropertyGreyValueList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (std::vector<float>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << *it;
-    }
+    if (uCt > 0)
+        str.write(_lValueList.data(), _lValueList.size());
 }
 
 void PropertyGreyValueList::RestoreDocFile(Base::Reader &reader)
@@ -169,9 +164,8 @@ void PropertyGreyValueList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<float> values(uCt);
-    for (std::vector<float>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> *it;
-    }
+    if (uCt > 0)
+        str.read(values.data(), values.size());
     setValues(values);
 }
 
@@ -332,9 +326,9 @@ void PropertyNormalList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (std::vector<Base::Vector3f>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << it->x << it->y << it->z;
-    }
+    static_assert(sizeof(Base::Vector3f) == 3 * sizeof(float), "Unexpected padding in vector type");
+    if (uCt > 0)
+        str.write(&_lValueList[0].x, 3 * _lValueList.size());
 }
 
 void PropertyNormalList::RestoreDocFile(Base::Reader &reader)
@@ -343,9 +337,8 @@ void PropertyNormalList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<Base::Vector3f> values(uCt);
-    for (std::vector<Base::Vector3f>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> it->x >> it->y >> it->z;
-    }
+    if (uCt > 0)
+        str.read(&values[0].x, 3 * values.size());
     setValues(values);
 }
 
@@ -392,16 +385,16 @@ void PropertyNormalList::transformGeometry(const Base::Matrix4D &mat)
 
     aboutToSetValue();
 
-    // Rotate the normal vectors
-#ifdef _WIN32
-    Concurrency::parallel_for_each(_lValueList.begin(), _lValueList.end(), [rot](Base::Vector3f& value) {
-        value = rot * value;
-    });
-#else
-    QtConcurrent::blockingMap(_lValueList, [rot](Base::Vector3f& value) {
-        rot.multVec(value, value);
-    });
-#endif
+    // Rotate the normal vectors block-wise, see PointKernel::transformGeometry
+    if (!_lValueList.empty()) {
+        const std::size_t blockSize = 0x10000;
+        Base::Vector3f* data = _lValueList.data();
+        std::size_t count = _lValueList.size();
+        Base::parallel_for(std::size_t(0), (count + blockSize - 1) / blockSize, [&rot, data, count, blockSize](std::size_t block) {
+            std::size_t start = block * blockSize;
+            rot.multDirs(data + start, data + std::min(start + blockSize, count));
+        }, std::size_t(1));
+    }
 
     hasSetValue();
 }
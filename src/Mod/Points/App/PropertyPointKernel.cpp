@@ -132,6 +132,25 @@ void PropertyPointKernel::RestoreDocFile(Base::Reader &reader)
     hasSetValue();
 }
 
+bool PropertyPointKernel::canRestoreDocFileAsync() const
+{
+    return true;
+}
+
+std::function<void()> PropertyPointKernel::RestoreDocFileAsync(Base::Reader &reader)
+{
+    // read into a separate kernel and keep the placement of the restored one
+    auto points = std::make_shared<PointKernel>();
+    points->RestoreDocFile(reader);
+    return [this, points]() {
+        std::vector<PointKernel::value_type> pts;
+        points->swap(pts);
+        aboutToSetValue();
+        _cPoints->swap(pts);
+        hasSetValue();
+    };
+}
+
 App::Property *PropertyPointKernel::Copy(void) const 
 {
     PropertyPointKernel* prop = new PropertyPointKernel();
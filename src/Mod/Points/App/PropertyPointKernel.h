@@ -75,6 +75,8 @@ public:
     void Restore(Base::XMLReader &reader);
     void SaveDocFile (Base::Writer &writer) const;
     void RestoreDocFile(Base::Reader &reader);
+    bool canRestoreDocFileAsync() const;
+    std::function<void()> RestoreDocFileAsync(Base::Reader &reader);
     //@}
 
     /** @name Modification */
@@ -0,0 +1,232 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+# include <random>
+# include <Inventor/actions/SoGLRenderAction.h>
+# include <Inventor/elements/SoCacheElement.h>
+# include <Inventor/elements/SoModelMatrixElement.h>
+# include <Inventor/elements/SoPointSizeElement.h>
+# include <Inventor/elements/SoViewVolumeElement.h>
+# include <Inventor/elements/SoViewportRegionElement.h>
+# include <Inventor/nodes/SoCoordinate3.h>
+#endif
+
+#include "SoFCPointSetLOD.h"
+
+
+using namespace PointsGui;
+
+namespace {
+// The depth of the octree. The points of the last level are the ones that share
+// the finest cell with another point.
+const int maxDepth = 10;
+
+inline uint32_t spreadBits(uint32_t v)
+{
+    v = (v | (v << 16)) & 0x030000FF;
+    v = (v | (v <<  8)) & 0x0300F00F;
+    v = (v | (v <<  4)) & 0x030C30C3;
+    v = (v | (v <<  2)) & 0x09249249;
+    return v;
+}
+}
+
+SO_NODE_SOURCE(SoFCPointSetLOD)
+
+void SoFCPointSetLOD::initClass()
+{
+    SO_NODE_INIT_CLASS(SoFCPointSetLOD, SoPointSet, "PointSet");
+}
+
+SoFCPointSetLOD::SoFCPointSetLOD()
+{
+    SO_NODE_CONSTRUCTOR(SoFCPointSetLOD);
+    SO_NODE_ADD_FIELD(levels, (0));
+    SO_NODE_ADD_FIELD(extent, (SbBox3f()));
+    SO_NODE_ADD_FIELD(pointBudget, (0));
+    levels.setNum(0);
+}
+
+void SoFCPointSetLOD::sortPoints(SoCoordinate3* coords, std::vector<int32_t>& order)
+{
+    int32_t numPts = coords->point.getNum();
+    const SbVec3f* pts = coords->point.getValues(0);
+
+    SbBox3f box;
+    for (int32_t i = 0; i < numPts; i++) {
+        const SbVec3f& p = pts[i];
+        if (!std::isnan(p[0]) && !std::isnan(p[1]) && !std::isnan(p[2]))
+            box.extendBy(p);
+    }
+
+    // the cells of the octree are cubes
+    const uint32_t numCells = 1 << maxDepth;
+    float size = 0.0f;
+    if (!box.isEmpty()) {
+        float dx, dy, dz;
+        box.getSize(dx, dy, dz);
+        size = std::max(std::max(dx, dy), dz);
+    }
+    float scale = size > 0.0f ? numCells / size : 0.0f;
+
+    // Morton code of the finest cell in the upper bits, the point index in the lower bits
+    std::vector<uint64_t> keys(numPts);
+    for (int32_t i = 0; i < numPts; i++) {
+        uint32_t cell[3] = {0, 0, 0};
+        const SbVec3f& p = pts[i];
+        for (int j = 0; j < 3; j++) {
+            float v = (p[j] - box.getMin()[j]) * scale;
+            if (v > 0.0f)
+                cell[j] = std::min(static_cast<uint32_t>(v), numCells - 1);
+        }
+        uint64_t code = spreadBits(cell[0]) | (spreadBits(cell[1]) << 1) | (spreadBits(cell[2]) << 2);
+        keys[i] = (code << 32) | static_cast<uint32_t>(i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    // A point belongs to the first level where it's the first point of its cell. Its
+    // predecessor in Morton order tells where the paths in the octree diverge.
+    std::vector<unsigned char> pointLevel(numPts);
+    std::vector<int32_t> levelCount(maxDepth + 2, 0);
+    for (int32_t i = 0; i < numPts; i++) {
+        int level = 0;
+        if (i > 0) {
+            uint32_t diff = static_cast<uint32_t>((keys[i] ^ keys[i-1]) >> 32);
+            if (diff == 0) {
+                level = maxDepth + 1;
+            }
+            else {
+                int bit = 31;
+                while (!(diff & (1u << bit)))
+                    bit--;
+                level = maxDepth - bit / 3;
+            }
+        }
+        pointLevel[i] = static_cast<unsigned char>(level);
+        levelCount[level]++;
+    }
+
+    std::vector<int32_t> offsets(maxDepth + 2, 0);
+    for (int i = 1; i < maxDepth + 2; i++)
+        offsets[i] = offsets[i-1] + levelCount[i-1];
+
+    order.resize(numPts);
+    for (int32_t i = 0; i < numPts; i++) {
+        order[offsets[pointLevel[i]]++] = static_cast<int32_t>(keys[i] & 0xffffffff);
+    }
+
+    // Inside a level the points are shuffled so that a part of a level is still evenly
+    // distributed. A fixed seed keeps the order the same for the same cloud.
+    std::minstd_rand rng(1);
+    std::vector<int32_t>::iterator first = order.begin();
+    levels.setNum(maxDepth + 2);
+    int32_t* lev = levels.startEditing();
+    for (int i = 0; i < maxDepth + 2; i++) {
+        std::shuffle(first, first + levelCount[i], rng);
+        first += levelCount[i];
+        lev[i] = offsets[i];
+    }
+    levels.finishEditing();
+
+    std::vector<SbVec3f> sorted(numPts);
+    for (int32_t i = 0; i < numPts; i++)
+        sorted[i] = pts[order[i]];
+    coords->point.setValues(0, numPts, sorted.data());
+
+    extent.setValue(box);
+    numPoints.setValue(numPts);
+}
+
+int32_t SoFCPointSetLOD::getNumRenderPoints(SoState* state) const
+{
+    int32_t numPts = numPoints.getValue();
+    int32_t budget = pointBudget.getValue();
+    if (budget > 0)
+        numPts = std::min(numPts, budget);
+
+    int32_t numLevels = levels.getNum();
+    SbBox3f box = extent.getValue();
+    if (numLevels == 0 || box.isEmpty())
+        return numPts;
+
+    float dx, dy, dz;
+    box.getSize(dx, dy, dz);
+    float cellSize = std::max(std::max(dx, dy), dz);
+
+    const SbMatrix& mat = SoModelMatrixElement::get(state);
+    const SbViewVolume& vv = SoViewVolumeElement::get(state);
+    const SbViewportRegion& vp = SoViewportRegionElement::get(state);
+
+    // the scale is determined at the nearest point of the cloud
+    SbVec3f eye = vv.getProjectionPoint();
+    SbMatrix inv = mat.inverse();
+    inv.multVecMatrix(eye, eye);
+    SbVec3f nearest;
+    for (int i = 0; i < 3; i++)
+        nearest[i] = std::max(box.getMin()[i], std::min(eye[i], box.getMax()[i]));
+    mat.multVecMatrix(nearest, nearest);
+
+    SbVec3f unit(cellSize, 0.0f, 0.0f);
+    mat.multDirMatrix(unit, unit);
+    cellSize = unit.length();
+
+    float pointSize = std::max(SoPointSizeElement::get(state), 1.0f);
+    float pixels = static_cast<float>(std::max(vp.getViewportSizePixels()[1], static_cast<short>(1)));
+    float worldPerPixel = vv.getWorldToScreenScale(nearest, 1.0f) / pixels;
+
+    // refine the octree until its cells are covered by a point
+    int level = 0;
+    while (level < numLevels - 1 && cellSize > worldPerPixel * pointSize) {
+        cellSize *= 0.5f;
+        level++;
+    }
+
+    return std::min(numPts, levels[level]);
+}
+
+void SoFCPointSetLOD::GLRender(SoGLRenderAction *action)
+{
+    SoState* state = action->getState();
+
+    // the number of rendered points depends on the camera
+    SoCacheElement::invalidate(state);
+
+    int32_t num = numPoints.getValue();
+    int32_t renderNum = getNumRenderPoints(state);
+    if (renderNum == num) {
+        inherited::GLRender(action);
+        return;
+    }
+
+    SbBool notify = numPoints.enableNotify(false);
+    numPoints.setValue(renderNum);
+    inherited::GLRender(action);
+    numPoints.setValue(num);
+    numPoints.enableNotify(notify);
+}
@@ -0,0 +1,82 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef POINTSGUI_SOFCPOINTSETLOD_H
+#define POINTSGUI_SOFCPOINTSETLOD_H
+
+#include <Inventor/nodes/SoPointSet.h>
+#include <Inventor/fields/SoMFInt32.h>
+#include <Inventor/fields/SoSFBox3f.h>
+#include <Inventor/fields/SoSFInt32.h>
+#include <vector>
+
+class SoCoordinate3;
+class SoState;
+
+namespace PointsGui {
+
+/**
+ * class SoFCPointSetLOD
+ * \brief The SoFCPointSetLOD class renders large point clouds with a level of detail.
+ *
+ * The points are expected in the order created by sortPoints(): the points of the
+ * coarse levels of an octree come first, so each prefix of the coordinates is an evenly
+ * distributed subset of the cloud. When rendering only as many points are drawn as are
+ * needed to fill the projected octree cells of the cloud, but not more than \a pointBudget.
+ */
+class PointsGuiExport SoFCPointSetLOD : public SoPointSet {
+    typedef SoPointSet inherited;
+
+    SO_NODE_HEADER(SoFCPointSetLOD);
+
+public:
+    static void initClass();
+    SoFCPointSetLOD();
+
+    /// The number of points up to and including each level
+    SoMFInt32 levels;
+    /// The bounding box of the points
+    SoSFBox3f extent;
+    /// The maximum number of points rendered at once, 0 means no limit
+    SoSFInt32 pointBudget;
+
+    /*!
+     * \brief sortPoints
+     * Reorders the points of \a coords into octree levels and sets up the fields of this
+     * node accordingly. \a order is filled with the original index of each point and can
+     * be used to reorder per-vertex data like colors or normals the same way.
+     */
+    void sortPoints(SoCoordinate3* coords, std::vector<int32_t>& order);
+
+protected:
+    // Force using the reference count mechanism.
+    virtual ~SoFCPointSetLOD() {}
+    virtual void GLRender(SoGLRenderAction *action);
+
+private:
+    int32_t getNumRenderPoints(SoState*) const;
+};
+
+} // namespace PointsGui
+
+
+#endif // POINTSGUI_SOFCPOINTSETLOD_H
@@ -58,6 +58,7 @@
 #include <Mod/Points/App/PointsFeature.h>
 
 #include "ViewProvider.h"
+#include "SoFCPointSetLOD.h"
 #include "../App/Properties.h"
 
 
@@ -129,9 +130,17 @@ void ViewProviderPoints::setVertexColorMode(App::PropertyColorList* pcProperty)
     pcColorMat->diffuseColor.setNum(val.size());
     SbColor* col = pcColorMat->diffuseColor.startEditing();
 
-    std::size_t i=0;
-    for (std::vector<App::Color>::const_iterator it = val.begin(); it != val.end(); ++it) {
-        col[i++].setValue(it->r, it->g, it->b);
+    if (pointOrder.size() == val.size()) {
+        for (std::size_t i=0; i<pointOrder.size(); i++) {
+            const App::Color& c = val[pointOrder[i]];
+            col[i].setValue(c.r, c.g, c.b);
+        }
+    }
+    else {
+        std::size_t i=0;
+        for (std::vector<App::Color>::const_iterator it = val.begin(); it != val.end(); ++it) {
+            col[i++].setValue(it->r, it->g, it->b);
+        }
     }
 
     pcColorMat->diffuseColor.finishEditing();
@@ -144,9 +153,17 @@ void ViewProviderPoints::setVertexGreyvalueMode(Points::PropertyGreyValueList* p
     pcColorMat->diffuseColor.setNum(val.size());
     SbColor* col = pcColorMat->diffuseColor.startEditing();
 
-    std::size_t i=0;
-    for (std::vector<float>::const_iterator it = val.begin(); it != val.end(); ++it) {
-        col[i++].setValue(*it, *it, *it);
+    if (pointOrder.size() == val.size()) {
+        for (std::size_t i=0; i<pointOrder.size(); i++) {
+            float c = val[pointOrder[i]];
+            col[i].setValue(c, c, c);
+        }
+    }
+    else {
+        std::size_t i=0;
+        for (std::vector<float>::const_iterator it = val.begin(); it != val.end(); ++it) {
+            col[i++].setValue(*it, *it, *it);
+        }
     }
 
     pcColorMat->diffuseColor.finishEditing();
@@ -159,9 +176,17 @@ void ViewProviderPoints::setVertexNormalMode(Points::PropertyNormalList* pcPrope
     pcPointsNormal->vector.setNum(val.size());
     SbVec3f* norm = pcPointsNormal->vector.startEditing();
 
-    std::size_t i=0;
-    for (std::vector<Base::Vector3f>::const_iterator it = val.begin(); it != val.end(); ++it) {
-        norm[i++].setValue(it->x, it->y, it->z);
+    if (pointOrder.size() == val.size()) {
+        for (std::size_t i=0; i<pointOrder.size(); i++) {
+            const Base::Vector3f& n = val[pointOrder[i]];
+            norm[i].setValue(n.x, n.y, n.z);
+        }
+    }
+    else {
+        std::size_t i=0;
+        for (std::vector<Base::Vector3f>::const_iterator it = val.begin(); it != val.end(); ++it) {
+            norm[i++].setValue(it->x, it->y, it->z);
+        }
     }
 
     pcPointsNormal->vector.finishEditing();
@@ -356,7 +381,16 @@ PROPERTY_SOURCE(PointsGui::ViewProviderScattered, PointsGui::ViewProviderPoints)
 
 ViewProviderScattered::ViewProviderScattered()
 {
-    pcPoints = new SoPointSet();
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Points");
+    if (hGrp->GetBool("LevelOfDetail", true)) {
+        SoFCPointSetLOD* lod = new SoFCPointSetLOD();
+        lod->pointBudget = hGrp->GetInt("PointBudget", 10000000);
+        pcPoints = lod;
+    }
+    else {
+        pcPoints = new SoPointSet();
+    }
     pcPoints->ref();
 }
 
@@ -418,6 +452,10 @@ void ViewProviderScattered::updateData(const App::Property* prop)
         ViewProviderPointsBuilder builder;
         builder.createPoints(prop, pcPointsCoord, pcPoints);
 
+        // sort the points into levels of detail
+        if (pcPoints->isOfType(SoFCPointSetLOD::getClassTypeId()))
+            static_cast<SoFCPointSetLOD*>(pcPoints)->sortPoints(pcPointsCoord, pointOrder);
+
         // The number of points might have changed, so force also a resize of the Inventor internals
         setActiveMode();
     }
@@ -107,6 +107,8 @@ protected:
     SoMaterial          * pcColorMat;
     SoNormal            * pcPointsNormal;
     SoDrawStyle         * pcPointStyle;
+    /// The original index of each rendered point if the points are reordered
+    std::vector<int32_t> pointOrder;
 
 private:
     static App::PropertyFloatConstraint::Constraints floatRange;
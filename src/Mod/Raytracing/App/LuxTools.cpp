@@ -34,6 +34,8 @@
 # include <sstream>
 #endif
 
+#include <algorithm>
+
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Sequencer.h>
@@ -70,13 +72,23 @@ void LuxTools::writeShape(std::ostream &out, const char *PartName, const TopoDS_
 {
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
-    TopExp_Explorer ex;
-    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
+    std::vector<TopoDS_Face> faces = PovTools::meshFaces(Shape, fMeshDeviation);
 
-    // counting faces and start sequencer
-    int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
+    // the vertex offset of every face, up to the first face without a mesh
+    std::vector<int> offsets;
+    int vi = 0;
+    for (const TopoDS_Face& aFace : faces) {
+        TopLoc_Location aLoc;
+        Handle(Poly_Triangulation) aPoly = BRep_Tool::Triangulation(aFace,aLoc);
+        if (aPoly.IsNull())
+            break;
+        offsets.push_back(vi);
+        vi = vi + aPoly->NbNodes();
+    }
+    int numFaces = static_cast<int>(offsets.size());
+
+    // start sequencer
+    Base::SequencerLauncher seq("Writing file", faces.size() + 1);
     
     // write object
     out << "AttributeBegin #  \"" << PartName << "\"" << endl;
@@ -84,49 +96,67 @@ void LuxTools::writeShape(std::ostream &out, const char *PartName, const TopoDS_
     out << "NamedMaterial \"FreeCADMaterial_" << PartName << "\"" << endl;
     out << "Shape \"mesh\"" << endl;
     
-    // gather vertices, normals and face indices
+    // gather vertices, normals and face indices, a block of faces at a time in parallel
     std::stringstream triindices;
     std::stringstream N;
     std::stringstream P;
-    l = 1;
-    int vi = 0;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
-
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
-
-        // this block mesh the face and transfers it in a C array of vertices and face indexes
-        Standard_Integer nbNodesInFace,nbTriInFace;
-        gp_Vec* vertices=0;
-        gp_Vec* vertexnormals=0;
-        long* cons=0;
-
-        PovTools::transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
-
-        if (!vertices) break;
-        // writing vertices
-        for (int i=0; i < nbNodesInFace; i++) {
-            P << vertices[i].X() << " " << vertices[i].Y() << " " << vertices[i].Z() << " ";
+    triindices.copyfmt(out);
+    N.copyfmt(out);
+    P.copyfmt(out);
+    struct FaceText {
+        std::string P, N, triindices;
+    };
+    std::vector<FaceText> texts(PovTools::FaceBlock);
+    for (int first = 0; first < numFaces; first += PovTools::FaceBlock) {
+        int last = std::min(first + PovTools::FaceBlock, numFaces);
+        PovTools::parallelFor(first, last, [&](int f) {
+            // this block transfers the face mesh in a C array of vertices and face indexes
+            Standard_Integer nbNodesInFace,nbTriInFace;
+            gp_Vec* vertices=0;
+            gp_Vec* vertexnormals=0;
+            long* cons=0;
+
+            PovTools::transferToArray(faces[f],&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
+
+            if (!vertices) return;
+            std::ostringstream fP, fN, fTri;
+            fP.copyfmt(out);
+            fN.copyfmt(out);
+            fTri.copyfmt(out);
+            int offset = offsets[f];
+            // writing vertices
+            for (int i=0; i < nbNodesInFace; i++) {
+                fP << vertices[i].X() << " " << vertices[i].Y() << " " << vertices[i].Z() << " ";
+            }
+
+            // writing per vertex normals
+            for (int j=0; j < nbNodesInFace; j++) {
+                fN << vertexnormals[j].X() << " "  << vertexnormals[j].Y() << " " << vertexnormals[j].Z() << " ";
+            }
+
+            // writing triangle indices
+            for (int k=0; k < nbTriInFace; k++) {
+                fTri << cons[3*k]+offset << " " << cons[3*k+2]+offset << " " << cons[3*k+1]+offset << " ";
+            }
+
+            delete [] vertexnormals;
+            delete [] vertices;
+            delete [] cons;
+
+            FaceText& text = texts[f - first];
+            text.P = fP.str();
+            text.N = fN.str();
+            text.triindices = fTri.str();
+        });
+
+        for (int f = first; f < last; f++) {
+            FaceText& text = texts[f - first];
+            P << text.P;
+            N << text.N;
+            triindices << text.triindices;
+            text = FaceText();
+            seq.next();
         }
-
-        // writing per vertex normals
-        for (int j=0; j < nbNodesInFace; j++) {
-            N << vertexnormals[j].X() << " "  << vertexnormals[j].Y() << " " << vertexnormals[j].Z() << " ";
-        }
-
-        // writing triangle indices
-        for (int k=0; k < nbTriInFace; k++) {
-            triindices << cons[3*k]+vi << " " << cons[3*k+2]+vi << " " << cons[3*k+1]+vi << " ";
-        }
-        
-        vi = vi + nbNodesInFace;
-        
-        delete [] vertexnormals;
-        delete [] vertices;
-        delete [] cons;
-
-        seq.next();
-
     } // end of face loop
 
     // write mesh data
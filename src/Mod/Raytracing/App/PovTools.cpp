@@ -34,6 +34,12 @@
 # include <sstream>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <thread>
+
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Sequencer.h>
@@ -225,72 +231,88 @@ void PovTools::writeShape(std::ostream &out, const char *PartName,
 {
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
-    TopExp_Explorer ex;
-    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
+    std::vector<TopoDS_Face> faces = meshFaces(Shape, fMeshDeviation);
+    int numFaces = static_cast<int>(faces.size());
 
-
-    // counting faces and start sequencer
-    int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
+    // start sequencer
+    Base::SequencerLauncher seq("Writing file", numFaces + 1);
 
     // write the file
     out <<  "// Written by FreeCAD http://www.freecadweb.org/" << endl;
-    l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
-
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
 
-        // this block mesh the face and transfers it in a C array of vertices and face indexes
-        Standard_Integer nbNodesInFace,nbTriInFace;
-        gp_Vec* vertices=0;
-        gp_Vec* vertexnormals=0;
-        long* cons=0;
-
-        transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
-
-        if (!vertices) break;
-        // writing per face header
-        out << "// face number" << l << " +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << endl
-        << "#declare " << PartName << l << " = mesh2{" << endl
-        << "  vertex_vectors {" << endl
-        << "    " << nbNodesInFace << "," << endl;
-        // writing vertices
-        for (int i=0; i < nbNodesInFace; i++) {
-            out << "    <" << vertices[i].X() << ","
-            << vertices[i].Z() << ","
-            << vertices[i].Y() << ">,"
-            << endl;
-        }
-        out << "  }" << endl
-        // writing per vertex normals
-        << "  normal_vectors {" << endl
-        << "    " << nbNodesInFace << "," << endl;
-        for (int j=0; j < nbNodesInFace; j++) {
-            out << "    <" << vertexnormals[j].X() << ","
-            << vertexnormals[j].Z() << ","
-            << vertexnormals[j].Y() << ">,"
-            << endl;
-        }
-
-        out << "  }" << endl
-        // writing triangle indices
-        << "  face_indices {" << endl
-        << "    " << nbTriInFace << "," << endl;
-        for (int k=0; k < nbTriInFace; k++) {
-            out << "    <" << cons[3*k] << ","<< cons[3*k+2] << ","<< cons[3*k+1] << ">," << endl;
+    // the faces of a block are formatted in parallel, then written in order
+    std::vector<std::string> texts(FaceBlock);
+    std::vector<char> meshed(FaceBlock);
+    int l = 1;
+    bool done = false;
+    for (int first = 0; first < numFaces && !done; first += FaceBlock) {
+        int last = std::min(first + FaceBlock, numFaces);
+        parallelFor(first, last, [&](int f) {
+            // this block transfers the face mesh in a C array of vertices and face indexes
+            Standard_Integer nbNodesInFace,nbTriInFace;
+            gp_Vec* vertices=0;
+            gp_Vec* vertexnormals=0;
+            long* cons=0;
+
+            transferToArray(faces[f],&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
+
+            meshed[f - first] = vertices ? 1 : 0;
+            if (!vertices) return;
+
+            std::ostringstream fout;
+            fout.copyfmt(out);
+            int face = f + 1;
+            // writing per face header
+            fout << "// face number" << face << " +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << endl
+            << "#declare " << PartName << face << " = mesh2{" << endl
+            << "  vertex_vectors {" << endl
+            << "    " << nbNodesInFace << "," << endl;
+            // writing vertices
+            for (int i=0; i < nbNodesInFace; i++) {
+                fout << "    <" << vertices[i].X() << ","
+                << vertices[i].Z() << ","
+                << vertices[i].Y() << ">,"
+                << endl;
+            }
+            fout << "  }" << endl
+            // writing per vertex normals
+            << "  normal_vectors {" << endl
+            << "    " << nbNodesInFace << "," << endl;
+            for (int j=0; j < nbNodesInFace; j++) {
+                fout << "    <" << vertexnormals[j].X() << ","
+                << vertexnormals[j].Z() << ","
+                << vertexnormals[j].Y() << ">,"
+                << endl;
+            }
+
+            fout << "  }" << endl
+            // writing triangle indices
+            << "  face_indices {" << endl
+            << "    " << nbTriInFace << "," << endl;
+            for (int k=0; k < nbTriInFace; k++) {
+                fout << "    <" << cons[3*k] << ","<< cons[3*k+2] << ","<< cons[3*k+1] << ">," << endl;
+            }
+            // end of face
+            fout << "  }" << endl
+            << "} // end of Face"<< face << endl << endl;
+
+            delete [] vertexnormals;
+            delete [] vertices;
+            delete [] cons;
+
+            texts[f - first] = fout.str();
+        });
+
+        for (int f = first; f < last; f++, l++) {
+            // the output ends at the first face without a mesh
+            if (!meshed[f - first]) {
+                done = true;
+                break;
+            }
+            out << texts[f - first];
+            texts[f - first].clear();
+            seq.next();
         }
-        // end of face
-        out << "  }" << endl
-        << "} // end of Face"<< l << endl << endl;
-
-        delete [] vertexnormals;
-        delete [] vertices;
-        delete [] cons;
-
-        seq.next();
-
     } // end of face loop
 
 
@@ -302,6 +324,47 @@ void PovTools::writeShape(std::ostream &out, const char *PartName,
     out << "}" << endl;
 }
 
+std::vector<TopoDS_Face> PovTools::meshFaces(const TopoDS_Shape& Shape, float fMeshDeviation)
+{
+    // faces that already have a fine enough triangulation, e.g. from the
+    // view provider, are kept as they are
+    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation,Standard_False,0.5,Standard_True);
+
+    std::vector<TopoDS_Face> faces;
+    TopExp_Explorer ex;
+    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next()) {
+        faces.push_back(TopoDS::Face(ex.Current()));
+    }
+    return faces;
+}
+
+void PovTools::parallelFor(int begin, int end, const std::function<void(int)>& fn)
+{
+    std::atomic<int> next(begin);
+    std::exception_ptr error;
+    std::atomic<bool> failed(false);
+    auto worker = [&]() {
+        for (int i; !failed && (i = next++) < end;) {
+            try {
+                fn(i);
+            }
+            catch (...) {
+                if (!failed.exchange(true))
+                    error = std::current_exception();
+            }
+        }
+    };
+    int nthreads = std::min<int>(std::max(1u, std::thread::hardware_concurrency()), end - begin);
+    std::vector<std::future<void> > futures;
+    for (int t=1; t < nthreads; t++)
+        futures.push_back(std::async(std::launch::async, worker));
+    worker();
+    for (auto &fut : futures)
+        fut.get();
+    if (error)
+        std::rethrow_exception(error);
+}
+
 void PovTools::writeShapeCSV(const char *FileName,
                              const TopoDS_Shape& Shape,
                              float fMeshDeviation,
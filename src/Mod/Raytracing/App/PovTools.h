@@ -25,6 +25,7 @@
 #define _PovTools_h_
 
 #include <gp_Vec.hxx>
+#include <functional>
 #include <vector>
 
 class TopoDS_Shape;
@@ -113,6 +114,13 @@ public:
 
 
     static void transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec** vertexnormals, long** cons,int &nbNodesInFace,int &nbTriInFace );
+
+    /// meshes the shape using all cores and returns its faces
+    static std::vector<TopoDS_Face> meshFaces(const TopoDS_Shape& Shape, float fMeshDeviation);
+    /// calls fn(i) for every i in [begin, end) from several threads
+    static void parallelFor(int begin, int end, const std::function<void(int)>& fn);
+    /// number of faces formatted before their text is written out
+    static const int FaceBlock = 1024;
 };
 
 
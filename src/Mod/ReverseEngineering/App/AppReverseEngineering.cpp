@@ -44,6 +44,7 @@
 
 #include "ApproxSurface.h"
 #include "BSplineFitting.h"
+#include "OrganizedCloud.h"
 #include "SurfaceTriangulation.h"
 #include "RegionGrowing.h"
 #include "Segmentation.h"
@@ -114,6 +115,7 @@ public:
         add_keyword_method("filterVoxelGrid",&Module::filterVoxelGrid,
             "filterVoxelGrid(dim)."
         );
+#endif
         add_keyword_method("normalEstimation",&Module::normalEstimation,
             "normalEstimation(Points,[KSearch=0, SearchRadius=0]) -> Normals\n"
             "KSearch is an int and used to search the k-nearest neighbours in\n"
@@ -132,7 +134,40 @@ public:
             "f.ViewObject.Proxy=0\n"
             "f.ViewObject.DisplayMode=1\n"
         );
-#endif
+        add_keyword_method("organizedNormals",&Module::organizedNormals,
+            "organizedNormals(Points, Width, Height, [MaxEdgeLength=0]) -> Normals\n"
+            "Computes the normals of a structured point cloud from its neighbours\n"
+            "on the Width x Height lattice. Neighbours farther away than\n"
+            "MaxEdgeLength are ignored, 0 means no limit."
+        );
+        add_keyword_method("organizedTriangulation",&Module::organizedTriangulation,
+            "organizedTriangulation(Points, Width, Height, [MaxEdgeLength=0]) -> Mesh\n"
+            "Triangulates a structured point cloud along its Width x Height lattice.\n"
+            "Triangles with an edge longer than MaxEdgeLength are skipped, 0 means no limit."
+        );
+        add_keyword_method("organizedDecimation",&Module::organizedDecimation,
+            "organizedDecimation(Points, Width, Height, Stride) -> (Points, Width, Height)\n"
+            "Keeps every Stride-th point of a structured point cloud in both directions."
+        );
+        add_keyword_method("detectPrimitives",&Module::detectPrimitives,
+            "detectPrimitives(Points,[Normals, Types, Epsilon=0.01, NormalThreshold=0.35,\n"
+            "                 ClusterEpsilon=0, MinSupport=100, Probability=0.99]) -> dict\n"
+            "Detects several planes, spheres, cylinders and cones in the points.\n"
+            "Types is a sequence of the names 'Plane', 'Sphere', 'Cylinder' and 'Cone',\n"
+            "NormalThreshold is the maximum deviation angle of the normals in radians\n"
+            "and ClusterEpsilon the maximum gap between points of the same primitive.\n"
+            "If no normals are given they are estimated with the ten nearest neighbours.\n"
+            "The result contains the list of primitives, each a dict with Type, Parameters\n"
+            "and Indices, and the label of each point (-1 for unassigned points).\n"
+            "Example:\n"
+            "\n"
+            "import ReverseEngineering as Reen\n"
+            "pts=App.ActiveDocument.ActiveObject.Points\n"
+            "res=Reen.detectPrimitives(pts,Epsilon=0.05,ClusterEpsilon=0.5)\n"
+            "for prim in res['Primitives']:\n"
+            "    sub=Points.Points([pts.Points[i] for i in prim['Indices']])\n"
+            "    spline=Reen.approxSurface(sub)\n"
+        );
 #if defined(HAVE_PCL_SEGMENTATION)
         add_keyword_method("regionGrowingSegmentation",&Module::regionGrowingSegmentation,
             "regionGrowingSegmentation()."
@@ -342,12 +377,14 @@ Mesh.show(m)
         int octreeDepth=-1;
         int solverDivide=-1;
         double samplesPerNode=-1.0;
+        int threads=-1;
 
         static char* kwds_poisson[] = {"Points", "KSearch", "OctreeDepth", "SolverDivide",
-                                      "SamplesPerNode", "Normals", NULL};
-        if (!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!|iiidO", kwds_poisson,
+                                      "SamplesPerNode", "Normals", "Threads", NULL};
+        if (!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!|iiidOi", kwds_poisson,
                                         &(Points::PointsPy::Type), &pts,
-                                        &ksearch, &octreeDepth, &solverDivide, &samplesPerNode, &vec))
+                                        &ksearch, &octreeDepth, &solverDivide, &samplesPerNode, &vec,
+                                        &threads))
             throw Py::Exception();
 
         Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
@@ -357,6 +394,7 @@ Mesh.show(m)
         poisson.setDepth(octreeDepth);
         poisson.setSolverDivide(solverDivide);
         poisson.setSamplesPerNode(samplesPerNode);
+        poisson.setThreads(threads);
         if (vec) {
             Py::Sequence list(vec);
             std::vector<Base::Vector3f> normals;
@@ -630,7 +668,6 @@ Mesh.show(m)
         return Py::asObject(new Points::PointsPy(points_sample));
     }
 #endif
-#if defined(HAVE_PCL_FILTERS)
     Py::Object normalEstimation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -658,7 +695,186 @@ Mesh.show(m)
 
         return list;
     }
-#endif
+    Py::Object organizedNormals(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *pts;
+        int width;
+        int height;
+        double maxEdgeLength=0;
+
+        static char* kwds_normals[] = {"Points", "Width", "Height", "MaxEdgeLength", NULL};
+        if (!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!ii|d", kwds_normals,
+                                        &(Points::PointsPy::Type), &pts,
+                                        &width, &height, &maxEdgeLength))
+            throw Py::Exception();
+
+        Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
+
+        std::vector<Base::Vector3f> normals;
+        OrganizedCloud cloud(width, height, *points);
+        cloud.setMaxEdgeLength(static_cast<float>(maxEdgeLength));
+        cloud.computeNormals(normals);
+
+        Py::List list;
+        for (std::vector<Base::Vector3f>::iterator it = normals.begin(); it != normals.end(); ++it) {
+            list.append(Py::Vector(*it));
+        }
+
+        return list;
+    }
+    Py::Object organizedTriangulation(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *pts;
+        int width;
+        int height;
+        double maxEdgeLength=0;
+
+        static char* kwds_triangulation[] = {"Points", "Width", "Height", "MaxEdgeLength", NULL};
+        if (!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!ii|d", kwds_triangulation,
+                                        &(Points::PointsPy::Type), &pts,
+                                        &width, &height, &maxEdgeLength))
+            throw Py::Exception();
+
+        Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
+
+        Mesh::MeshObject* mesh = new Mesh::MeshObject();
+        OrganizedCloud cloud(width, height, *points);
+        cloud.setMaxEdgeLength(static_cast<float>(maxEdgeLength));
+        cloud.triangulate(*mesh);
+
+        return Py::asObject(new Mesh::MeshPy(mesh));
+    }
+    Py::Object organizedDecimation(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *pts;
+        int width;
+        int height;
+        int stride;
+
+        static char* kwds_decimation[] = {"Points", "Width", "Height", "Stride", NULL};
+        if (!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!iii", kwds_decimation,
+                                        &(Points::PointsPy::Type), &pts,
+                                        &width, &height, &stride))
+            throw Py::Exception();
+
+        Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
+
+        Points::PointKernel* points_sample = new Points::PointKernel();
+        OrganizedCloud cloud(width, height, *points);
+        cloud.decimate(stride, *points_sample, width, height);
+
+        Py::Tuple tuple(3);
+        tuple.setItem(0, Py::asObject(new Points::PointsPy(points_sample)));
+        tuple.setItem(1, Py::Long(width));
+        tuple.setItem(2, Py::Long(height));
+        return tuple;
+    }
+    Py::Object detectPrimitives(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *pts;
+        PyObject *vec = nullptr;
+        PyObject *typ = nullptr;
+        double epsilon = 0.01;
+        double normalThreshold = 0.35;
+        double clusterEpsilon = 0;
+        int minSupport = 100;
+        double probability = 0.99;
+
+        static char* kwds_detect[] = {"Points", "Normals", "Types", "Epsilon", "NormalThreshold",
+                                      "ClusterEpsilon", "MinSupport", "Probability", NULL};
+        if (!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!|OOdddid", kwds_detect,
+                                        &(Points::PointsPy::Type), &pts, &vec, &typ,
+                                        &epsilon, &normalThreshold, &clusterEpsilon,
+                                        &minSupport, &probability))
+            throw Py::Exception();
+
+        Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
+        std::vector<Base::Vector3d> normals;
+        if (vec && vec != Py_None) {
+            Py::Sequence list(vec);
+            normals.reserve(list.size());
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                Base::Vector3d v = Py::Vector(*it).toVector();
+                normals.push_back(v);
+            }
+        }
+        else {
+            NormalEstimation estimate(*points);
+            estimate.setKSearch(10);
+            estimate.setSearchRadius(0);
+            estimate.perform(normals);
+        }
+
+        int types = PrimitiveDetection::Plane | PrimitiveDetection::Sphere |
+                    PrimitiveDetection::Cylinder | PrimitiveDetection::Cone;
+        if (typ && typ != Py_None) {
+            types = 0;
+            Py::Sequence list(typ);
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                std::string name = static_cast<std::string>(Py::String(*it));
+                if (name == "Plane")
+                    types |= PrimitiveDetection::Plane;
+                else if (name == "Sphere")
+                    types |= PrimitiveDetection::Sphere;
+                else if (name == "Cylinder")
+                    types |= PrimitiveDetection::Cylinder;
+                else if (name == "Cone")
+                    types |= PrimitiveDetection::Cone;
+                else
+                    throw Py::ValueError(std::string("Unknown primitive type: ") + name);
+            }
+        }
+
+        PrimitiveDetection detect(*points, normals);
+        detect.setTypes(types);
+        detect.setEpsilon(epsilon);
+        detect.setNormalThreshold(normalThreshold);
+        detect.setClusterEpsilon(clusterEpsilon);
+        detect.setMinSupport(minSupport);
+        detect.setProbability(probability);
+
+        std::vector<PrimitiveDetection::Primitive> primitives;
+        std::vector<int> labels;
+        try {
+            detect.perform(primitives, labels);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        Py::List list;
+        for (std::vector<PrimitiveDetection::Primitive>::iterator it = primitives.begin(); it != primitives.end(); ++it) {
+            const char* name = "Plane";
+            if (it->type == PrimitiveDetection::Sphere)
+                name = "Sphere";
+            else if (it->type == PrimitiveDetection::Cylinder)
+                name = "Cylinder";
+            else if (it->type == PrimitiveDetection::Cone)
+                name = "Cone";
+
+            Py::Tuple param(it->parameters.size());
+            for (std::size_t i = 0; i < it->parameters.size(); i++)
+                param.setItem(i, Py::Float(it->parameters[i]));
+            Py::Tuple indices(it->indices.size());
+            for (std::size_t i = 0; i < it->indices.size(); i++)
+                indices.setItem(i, Py::Long(it->indices[i]));
+
+            Py::Dict prim;
+            prim.setItem(Py::String("Type"), Py::String(name));
+            prim.setItem(Py::String("Parameters"), param);
+            prim.setItem(Py::String("Indices"), indices);
+            list.append(prim);
+        }
+
+        Py::Tuple label(labels.size());
+        for (std::size_t i = 0; i < labels.size(); i++)
+            label.setItem(i, Py::Long(labels[i]));
+
+        Py::Dict dict;
+        dict.setItem(Py::String("Primitives"), list);
+        dict.setItem(Py::String("Labels"), label);
+        return dict;
+    }
 #if defined(HAVE_PCL_SEGMENTATION)
     Py::Object regionGrowingSegmentation(const Py::Tuple& args, const Py::Dict& kwds)
     {
@@ -22,15 +22,13 @@
 
 
 #include "PreCompiled.h"
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
 
-#include <QFuture>
-#include <QFutureWatcher>
+#include <QThread>
 #include <QtConcurrentMap>
-#include <boost_bind_bind.hpp>
+#include <Eigen/SparseCholesky>
+#include <Eigen/IterativeLinearSolvers>
 
 #include <Mod/Mesh/App/Core/Approximation.h>
 #include <Base/Sequencer.h>
@@ -40,7 +38,6 @@
 #include "ApproxSurface.h"
 
 using namespace Reen;
-namespace bp = boost::placeholders;
 
 // SplineBasisfunction
 
@@ -768,14 +765,10 @@ BSplineParameterCorrection::BSplineParameterCorrection(unsigned usUOrder, unsign
   : ParameterCorrection(usUOrder, usVOrder, usUCtrlpoints, usVCtrlpoints)
   , _clUSpline(usUCtrlpoints+usUOrder)
   , _clVSpline(usVCtrlpoints+usVOrder)
-  , _clSmoothMatrix(0,usUCtrlpoints*usVCtrlpoints-1,
-                    0,usUCtrlpoints*usVCtrlpoints-1)
-  , _clFirstMatrix (0,usUCtrlpoints*usVCtrlpoints-1,
-                    0,usUCtrlpoints*usVCtrlpoints-1)
-  , _clSecondMatrix(0,usUCtrlpoints*usVCtrlpoints-1,
-                    0,usUCtrlpoints*usVCtrlpoints-1)
-  , _clThirdMatrix (0,usUCtrlpoints*usVCtrlpoints-1,
-                    0,usUCtrlpoints*usVCtrlpoints-1)
+  , _clSmoothMatrix(usUCtrlpoints*usVCtrlpoints, usUCtrlpoints*usVCtrlpoints)
+  , _clFirstMatrix (usUCtrlpoints*usVCtrlpoints, usUCtrlpoints*usVCtrlpoints)
+  , _clSecondMatrix(usUCtrlpoints*usVCtrlpoints, usUCtrlpoints*usVCtrlpoints)
+  , _clThirdMatrix (usUCtrlpoints*usVCtrlpoints, usUCtrlpoints*usVCtrlpoints)
 {
     Init();
 }
@@ -785,10 +778,10 @@ void BSplineParameterCorrection::Init()
     // Initialisierungen
     _pvcUVParam       = NULL;
     _pvcPoints        = NULL;
-    _clFirstMatrix.Init(0.0);
-    _clSecondMatrix.Init(0.0);
-    _clThirdMatrix.Init(0.0);
-    _clSmoothMatrix.Init(0.0);
+    _clFirstMatrix.setZero();
+    _clSecondMatrix.setZero();
+    _clThirdMatrix.setZero();
+    _clSmoothMatrix.setZero();
 
     /* Berechne die Knotenvektoren */
     unsigned usUMax = _usUCtrlpoints-_usUOrder+1;
@@ -931,72 +924,174 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
 
 bool BSplineParameterCorrection::SolveWithoutSmoothing()
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim  = _usUCtrlpoints*_usVCtrlpoints;
-    math_Matrix M  (0, ulSize-1, 0, ulDim-1);
-    math_Matrix Xx (0, ulDim-1, 0, 0);
-    math_Matrix Xy (0, ulDim-1, 0, 0);
-    math_Matrix Xz (0, ulDim-1, 0, 0);
-    math_Vector bx (0, ulSize-1);
-    math_Vector by (0, ulSize-1);
-    math_Vector bz (0, ulSize-1);
-
-    //Bestimmung der Koeffizientenmatrix des ueberbestimmten LGS
-    for (unsigned i=0; i<ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        unsigned ulIdx=0;
-
-        // Vorberechnung der Werte der Basis-Funktionen
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j,fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k=0; k<_usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k,fV);
-        }
+    return SolveNormalEquations(0.0);
+}
 
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = 0.0;
-                    ulIdx++;
+bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+{
+    return SolveNormalEquations(fWeight);
+}
+
+namespace Reen {
+// Banded storage of the normal equations. Because of the local support of the B-spline basis
+// the control point (j,k) only couples with the control points (j+dj,k+dk) with |dj| < uorder
+// and |dk| < vorder.
+class NormalEquations
+{
+public:
+    NormalEquations(unsigned uPoles, unsigned vPoles, unsigned uOrder, unsigned vOrder)
+      : uPoles(uPoles), vPoles(vPoles), uOrder(uOrder), vOrder(vOrder)
+      , uBand(2*uOrder-1), vBand(2*vOrder-1)
+      , matrix(uPoles*vPoles*uBand*vBand, 0.0)
+      , rhs(3*uPoles*vPoles, 0.0)
+    {
+    }
+    // Adds a point with the non-zero basis functions starting at the poles uFirst and vFirst
+    void add(unsigned uFirst, unsigned vFirst, const double* basisU, const double* basisV, const gp_Pnt& pnt)
+    {
+        for (unsigned a=0; a<uOrder; a++) {
+            for (unsigned b=0; b<vOrder; b++) {
+                double valueAB = basisU[a] * basisV[b];
+                if (valueAB == 0.0)
+                    continue;
+                std::size_t row = (uFirst+a)*vPoles + vFirst+b;
+                rhs[3*row  ] += valueAB * pnt.X();
+                rhs[3*row+1] += valueAB * pnt.Y();
+                rhs[3*row+2] += valueAB * pnt.Z();
+                double* band = &matrix[row*uBand*vBand];
+                for (unsigned c=0; c<uOrder; c++) {
+                    for (unsigned d=0; d<vOrder; d++) {
+                        band[(c+uOrder-1-a)*vBand + d+vOrder-1-b] += valueAB * basisU[c] * basisV[d];
+                    }
                 }
             }
-            else {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+        }
+    }
+    NormalEquations& operator += (const NormalEquations& other)
+    {
+        std::transform(matrix.begin(), matrix.end(), other.matrix.begin(), matrix.begin(), std::plus<double>());
+        std::transform(rhs.begin(), rhs.end(), other.rhs.begin(), rhs.begin(), std::plus<double>());
+        return *this;
+    }
+    void toSparse(Eigen::SparseMatrix<double>& mat) const
+    {
+        std::vector< Eigen::Triplet<double> > triplets;
+        triplets.reserve(uPoles*vPoles*uBand*vBand);
+        for (unsigned j=0; j<uPoles; j++) {
+            for (unsigned k=0; k<vPoles; k++) {
+                std::size_t row = j*vPoles + k;
+                const double* band = &matrix[row*uBand*vBand];
+                for (unsigned dj=0; dj<uBand; dj++) {
+                    int col_j = static_cast<int>(j+dj) - static_cast<int>(uOrder-1);
+                    if (col_j < 0 || col_j >= static_cast<int>(uPoles))
+                        continue;
+                    for (unsigned dk=0; dk<vBand; dk++) {
+                        int col_k = static_cast<int>(k+dk) - static_cast<int>(vOrder-1);
+                        if (col_k < 0 || col_k >= static_cast<int>(vPoles))
+                            continue;
+                        double value = band[dj*vBand + dk];
+                        if (value != 0.0)
+                            triplets.emplace_back(row, col_j*vPoles + col_k, value);
+                    }
                 }
             }
         }
-    }
 
-    //Bestimmen der rechten Seite
-    for (int ii=_pvcPoints->Lower(); ii<=_pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X(); by(ii) = pnt.Y(); bz(ii) = pnt.Z();
+        mat.resize(uPoles*vPoles, uPoles*vPoles);
+        mat.setFromTriplets(triplets.begin(), triplets.end());
+    }
+    Eigen::VectorXd rightHandSide(int coord) const
+    {
+        Eigen::VectorXd b(uPoles*vPoles);
+        for (unsigned i=0; i<uPoles*vPoles; i++)
+            b(i) = rhs[3*i+coord];
+        return b;
     }
 
-    // Loese das ueberbest. LGS mit der Householder-Transformation
-    math_Householder hhX(M,bx);
-    math_Householder hhY(M,by);
-    math_Householder hhZ(M,bz);
+private:
+    unsigned uPoles, vPoles, uOrder, vOrder, uBand, vBand;
+    std::vector<double> matrix;
+    std::vector<double> rhs;
+};
+}
 
-    if (!(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone()))
-        //LGS konnte nicht geloest werden
-        return false;
-    Xx = hhX.AllValues();
-    Xy = hhY.AllValues();
-    Xz = hhZ.AllValues();
+bool BSplineParameterCorrection::SolveNormalEquations(double fWeight)
+{
+    int iLower = _pvcPoints->Lower();
+    int iUpper = _pvcPoints->Upper();
+    double fUMin = _vUKnots(_vUKnots.Lower()), fUMax = _vUKnots(_vUKnots.Upper());
+    double fVMin = _vVKnots(_vVKnots.Lower()), fVMax = _vVKnots(_vVKnots.Upper());
+
+    // Every thread accumulates the contributions of its points to its own equations
+    int numThreads = std::max(1, QThread::idealThreadCount());
+    int numPoints = iUpper - iLower + 1;
+    std::vector< std::pair<int,int> > ranges;
+    for (int i=0; i<numThreads; i++) {
+        int first = iLower + static_cast<int>(static_cast<long long>(numPoints) * i / numThreads);
+        int last  = iLower + static_cast<int>(static_cast<long long>(numPoints) * (i+1) / numThreads);
+        if (first < last)
+            ranges.emplace_back(first, last);
+    }
+
+    std::vector<NormalEquations> partial(ranges.size(),
+        NormalEquations(_usUCtrlpoints, _usVCtrlpoints, _usUOrder, _usVOrder));
+    QtConcurrent::blockingMap(ranges, [&](const std::pair<int,int>& range) {
+        NormalEquations& equations = partial[&range - ranges.data()];
+        TColStd_Array1OfReal basisU(0, _usUOrder-1);
+        TColStd_Array1OfReal basisV(0, _usVOrder-1);
+        for (int ii=range.first; ii<range.second; ii++) {
+            const gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
+            double fU = uvValue.X();
+            double fV = uvValue.Y();
+            // outside the parameter range all basis functions vanish
+            if (fU < fUMin || fU > fUMax || fV < fVMin || fV > fVMax)
+                continue;
+
+            int iUSpan = _clUSpline.FindSpan(fU);
+            int iVSpan = _clVSpline.FindSpan(fV);
+            _clUSpline.AllBasisFunctions(fU, basisU);
+            _clVSpline.AllBasisFunctions(fV, basisV);
+            equations.add(iUSpan-_usUOrder+1, iVSpan-_usVOrder+1,
+                          &basisU(0), &basisV(0), (*_pvcPoints)(ii));
+        }
+    });
+
+    for (std::size_t i=1; i<partial.size(); i++)
+        partial[0] += partial[i];
+
+    unsigned ulDim = _usUCtrlpoints*_usVCtrlpoints;
+    Eigen::SparseMatrix<double> MTM(ulDim, ulDim);
+    if (!partial.empty())
+        partial[0].toSparse(MTM);
+    if (fWeight != 0.0 && _clSmoothMatrix.rows() == MTM.rows())
+        MTM += fWeight * _clSmoothMatrix;
+
+    Eigen::VectorXd Mb[3];
+    for (int i=0; i<3; i++)
+        Mb[i] = partial.empty() ? Eigen::VectorXd::Zero(ulDim) : partial[0].rightHandSide(i);
+
+    Eigen::VectorXd X[3];
+    Eigen::SimplicialLDLT< Eigen::SparseMatrix<double> > ldlt(MTM);
+    if (ldlt.info() == Eigen::Success) {
+        for (int i=0; i<3; i++) {
+            X[i] = ldlt.solve(Mb[i]);
+            if (ldlt.info() != Eigen::Success)
+                return false;
+        }
+    }
+    else {
+        Eigen::ConjugateGradient< Eigen::SparseMatrix<double>, Eigen::Lower|Eigen::Upper > cg(MTM);
+        for (int i=0; i<3; i++) {
+            X[i] = cg.solve(Mb[i]);
+            if (cg.info() != Eigen::Success)
+                return false;
+        }
+    }
 
     unsigned ulIdx=0;
     for (unsigned j=0;j<_usUCtrlpoints;j++) {
         for (unsigned k=0;k<_usVCtrlpoints;k++) {
-            _vCtrlPntsOfSurf(j,k) = gp_Pnt(Xx(ulIdx,0),Xy(ulIdx,0),Xz(ulIdx,0));
+            _vCtrlPntsOfSurf(j,k) = gp_Pnt(X[0](ulIdx),X[1](ulIdx),X[2](ulIdx));
             ulIdx++;
         }
     }
@@ -1005,151 +1100,70 @@ bool BSplineParameterCorrection::SolveWithoutSmoothing()
 }
 
 namespace Reen {
-class ScalarProduct
+// Integrals of the products of two derivatives of the basis functions of a spline.
+// The integral of the basis functions i and k vanishes if |i-k| >= order.
+class BasisIntegrals
 {
 public:
-    ScalarProduct(const math_Matrix& mat) : mat(mat)
+    BasisIntegrals(BSplineBasis& basis, unsigned numPoles, unsigned order, int iOrd1, int iOrd2)
+      : order(order), band(2*order-1), values(numPoles*band, 0.0)
     {
+        for (unsigned i=0; i<numPoles; i++) {
+            for (unsigned d=0; d<band; d++) {
+                int k = static_cast<int>(i+d) - static_cast<int>(order-1);
+                if (k >= 0 && k < static_cast<int>(numPoles))
+                    values[i*band+d] = basis.GetIntegralOfProductOfBSplines(i, k, iOrd1, iOrd2);
+            }
+        }
     }
-    std::vector<double> multiply(int col) const
+    double operator() (unsigned i, unsigned k) const
     {
-        math_Vector vec = mat.Col(col);
-        std::vector<double> out(mat.ColNumber());
-        for (int n=mat.LowerCol(); n<=mat.UpperCol(); n++) {
-            out[n] = vec * mat.Col(n);
-        }
-        return out;
+        int d = static_cast<int>(k) - static_cast<int>(i) + static_cast<int>(order-1);
+        if (d < 0 || d >= static_cast<int>(band))
+            return 0.0;
+        return values[i*band+d];
     }
 
 private:
-    const math_Matrix& mat;
+    unsigned order, band;
+    std::vector<double> values;
 };
 }
 
-bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+template <typename Function>
+static void AssembleSmoothMatrix(unsigned uPoles, unsigned vPoles, unsigned uOrder, unsigned vOrder,
+                                 Function entry, Eigen::SparseMatrix<double>& mat,
+                                 Base::SequencerLauncher& seq)
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim  = _usUCtrlpoints*_usVCtrlpoints;
-    math_Matrix M  (0, ulSize-1, 0, ulDim-1);
-    math_Vector Xx (0, ulDim-1);
-    math_Vector Xy (0, ulDim-1);
-    math_Vector Xz (0, ulDim-1);
-    math_Vector bx (0, ulSize-1);
-    math_Vector by (0, ulSize-1);
-    math_Vector bz (0, ulSize-1);
-    math_Vector Mbx(0, ulDim-1);
-    math_Vector Mby(0, ulDim-1);
-    math_Vector Mbz(0, ulDim-1);
-
-    //Bestimmung der Koeffizientenmatrix des ueberbestimmten LGS
-    for (unsigned i=0; i<ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        int ulIdx=0;
-
-        // Vorberechnung der Werte der Basis-Funktionen
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j,fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k=0; k<_usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k,fV);
-        }
-
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+    std::vector< Eigen::Triplet<double> > triplets;
+    triplets.reserve(uPoles*vPoles*(2*uOrder-1)*(2*vOrder-1));
+    unsigned m=0;
+    for (unsigned k=0; k<uPoles; k++) {
+        for (unsigned l=0; l<vPoles; l++) {
+            unsigned iMin = k+1 > uOrder ? k+1-uOrder : 0;
+            unsigned iMax = std::min(uPoles, k+uOrder);
+            unsigned jMin = l+1 > vOrder ? l+1-vOrder : 0;
+            unsigned jMax = std::min(vPoles, l+vOrder);
+            for (unsigned i=iMin; i<iMax; i++) {
+                for (unsigned j=jMin; j<jMax; j++) {
+                    double value = entry(i, k, j, l);
+                    if (value != 0.0)
+                        triplets.emplace_back(m, i*vPoles+j, value);
                 }
             }
+            seq.next();
+            m++;
         }
     }
 
-    //Das Produkt aus ihrer Transformierten und ihr selbst ergibt die quadratische Systemmatrix (langsam)
-#if 0
-    math_Matrix MTM = M.TMultiply(M);
-#elif 0
-    math_Matrix MTM(0, ulDim-1, 0, ulDim-1);
-    for (unsigned m=0; m<ulDim; m++) {
-        math_Vector Mm = M.Col(m);
-        for (unsigned n=m; n<ulDim; n++) {
-            MTM(m,n) = MTM(n,m) = Mm * M.Col(n);
-        }
-    }
-#else // multi-threaded
-    std::vector<int> columns(ulDim);
-    std::generate(columns.begin(), columns.end(), Base::iotaGen<int>(0));
-    ScalarProduct scalar(M);
-    QFuture< std::vector<double> > future = QtConcurrent::mapped
-        (columns, boost::bind(&ScalarProduct::multiply, &scalar, bp::_1));
-    QFutureWatcher< std::vector<double> > watcher;
-    watcher.setFuture(future);
-    watcher.waitForFinished();
-
-    math_Matrix MTM(0, ulDim-1, 0, ulDim-1);
-    int rowIndex=0;
-    for (QFuture< std::vector<double> >::const_iterator it = future.begin(); it != future.end(); ++it) {
-        int colIndex=0;
-        for (std::vector<double>::const_iterator jt = it->begin(); jt != it->end(); ++jt, colIndex++)
-            MTM(rowIndex, colIndex) = *jt;
-        rowIndex++;
-    }
-#endif
-
-    //Bestimmen der rechten Seite
-    for (int ii=_pvcPoints->Lower(); ii<=_pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X(); by(ii) = pnt.Y(); bz(ii) = pnt.Z();
-    }
-    for (unsigned i=0; i<ulDim; i++) {
-        math_Vector Mi = M.Col(i);
-        Mbx(i) = Mi * bx;
-        Mby(i) = Mi * by;
-        Mbz(i) = Mi * bz;
-    }
-
-    // Loese das LGS mit der LU-Zerlegung
-    math_Gauss mgGaussX(MTM+fWeight*_clSmoothMatrix);
-    math_Gauss mgGaussY(MTM+fWeight*_clSmoothMatrix);
-    math_Gauss mgGaussZ(MTM+fWeight*_clSmoothMatrix);
-
-    mgGaussX.Solve(Mbx,Xx);
-    if (!mgGaussX.IsDone())
-        return false;
-
-    mgGaussY.Solve(Mby,Xy);
-    if (!mgGaussY.IsDone())
-        return false;
-
-    mgGaussZ.Solve(Mbz,Xz);
-    if (!mgGaussZ.IsDone())
-        return false;
-
-    unsigned ulIdx=0;
-    for (unsigned j=0;j<_usUCtrlpoints;j++) {
-        for (unsigned k=0;k<_usVCtrlpoints;k++) {
-            _vCtrlPntsOfSurf(j,k) = gp_Pnt(Xx(ulIdx),Xy(ulIdx),Xz(ulIdx));
-            ulIdx++;
-        }
-    }
-
-    return true;
+    mat.resize(uPoles*vPoles, uPoles*vPoles);
+    mat.setFromTriplets(triplets.begin(), triplets.end());
 }
 
 void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc, double fFirst, double fSecond, double fThird)
 {
     if (bRecalc) {
-        Base::SequencerLauncher seq("Initializing...", 3 * _usUCtrlpoints * _usUCtrlpoints * _usVCtrlpoints * _usVCtrlpoints);
+        Base::SequencerLauncher seq("Initializing...", 3 * _usUCtrlpoints * _usVCtrlpoints);
         CalcFirstSmoothMatrix(seq);
         CalcSecondSmoothMatrix(seq);
         CalcThirdSmoothMatrix(seq);
@@ -1162,82 +1176,65 @@ void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc, double fFirst,
 
 void BSplineParameterCorrection::CalcFirstSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m=0;
-    for (unsigned k=0; k<_usUCtrlpoints; k++) {
-        for (unsigned l=0; l<_usVCtrlpoints; l++) {
-            unsigned n=0;
-
-            for (unsigned i=0; i<_usUCtrlpoints; i++) {
-                for (unsigned j=0; j<_usVCtrlpoints; j++) {
-                    _clFirstMatrix(m,n) =   _clUSpline.GetIntegralOfProductOfBSplines(i,k,1,1) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,0) +
-                                            _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,0) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,1);
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    BasisIntegrals u00(_clUSpline, _usUCtrlpoints, _usUOrder, 0, 0);
+    BasisIntegrals u11(_clUSpline, _usUCtrlpoints, _usUOrder, 1, 1);
+    BasisIntegrals v00(_clVSpline, _usVCtrlpoints, _usVOrder, 0, 0);
+    BasisIntegrals v11(_clVSpline, _usVCtrlpoints, _usVOrder, 1, 1);
+
+    AssembleSmoothMatrix(_usUCtrlpoints, _usVCtrlpoints, _usUOrder, _usVOrder,
+                         [&](unsigned i, unsigned k, unsigned j, unsigned l) {
+        return u11(i,k) * v00(j,l) +
+               u00(i,k) * v11(j,l);
+    }, _clFirstMatrix, seq);
 }
 
 void BSplineParameterCorrection::CalcSecondSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m=0;
-    for (unsigned k=0; k<_usUCtrlpoints; k++) {
-        for (unsigned l=0; l<_usVCtrlpoints; l++) {
-            unsigned n=0;
-
-            for (unsigned i=0; i<_usUCtrlpoints; i++) {
-                for (unsigned j=0; j<_usVCtrlpoints; j++) {
-                    _clSecondMatrix(m,n) =  _clUSpline.GetIntegralOfProductOfBSplines(i,k,2,2) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,0) +
-                                          2*_clUSpline.GetIntegralOfProductOfBSplines(i,k,1,1) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,1) +
-                                            _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,0) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,2,2);
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    BasisIntegrals u00(_clUSpline, _usUCtrlpoints, _usUOrder, 0, 0);
+    BasisIntegrals u11(_clUSpline, _usUCtrlpoints, _usUOrder, 1, 1);
+    BasisIntegrals u22(_clUSpline, _usUCtrlpoints, _usUOrder, 2, 2);
+    BasisIntegrals v00(_clVSpline, _usVCtrlpoints, _usVOrder, 0, 0);
+    BasisIntegrals v11(_clVSpline, _usVCtrlpoints, _usVOrder, 1, 1);
+    BasisIntegrals v22(_clVSpline, _usVCtrlpoints, _usVOrder, 2, 2);
+
+    AssembleSmoothMatrix(_usUCtrlpoints, _usVCtrlpoints, _usUOrder, _usVOrder,
+                         [&](unsigned i, unsigned k, unsigned j, unsigned l) {
+        return   u22(i,k) * v00(j,l) +
+               2*u11(i,k) * v11(j,l) +
+                 u00(i,k) * v22(j,l);
+    }, _clSecondMatrix, seq);
 }
 
 void BSplineParameterCorrection::CalcThirdSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m=0;
-    for (unsigned k=0; k<_usUCtrlpoints; k++) {
-        for (unsigned l=0; l<_usVCtrlpoints; l++) {
-            unsigned n=0;
-
-            for (unsigned i=0; i<_usUCtrlpoints; i++) {
-                for (unsigned j=0; j<_usVCtrlpoints; j++) {
-                    _clThirdMatrix(m,n) = _clUSpline.GetIntegralOfProductOfBSplines(i,k,3,3) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,0) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,3,1) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,2) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,1,3) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,2,0) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,1,1) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,2,2) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,2,2) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,1) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,2) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,3,1) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,2,0) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,3) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,0) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,3,3) ;
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    BasisIntegrals u00(_clUSpline, _usUCtrlpoints, _usUOrder, 0, 0);
+    BasisIntegrals u02(_clUSpline, _usUCtrlpoints, _usUOrder, 0, 2);
+    BasisIntegrals u11(_clUSpline, _usUCtrlpoints, _usUOrder, 1, 1);
+    BasisIntegrals u13(_clUSpline, _usUCtrlpoints, _usUOrder, 1, 3);
+    BasisIntegrals u20(_clUSpline, _usUCtrlpoints, _usUOrder, 2, 0);
+    BasisIntegrals u22(_clUSpline, _usUCtrlpoints, _usUOrder, 2, 2);
+    BasisIntegrals u31(_clUSpline, _usUCtrlpoints, _usUOrder, 3, 1);
+    BasisIntegrals u33(_clUSpline, _usUCtrlpoints, _usUOrder, 3, 3);
+    BasisIntegrals v00(_clVSpline, _usVCtrlpoints, _usVOrder, 0, 0);
+    BasisIntegrals v02(_clVSpline, _usVCtrlpoints, _usVOrder, 0, 2);
+    BasisIntegrals v11(_clVSpline, _usVCtrlpoints, _usVOrder, 1, 1);
+    BasisIntegrals v13(_clVSpline, _usVCtrlpoints, _usVOrder, 1, 3);
+    BasisIntegrals v20(_clVSpline, _usVCtrlpoints, _usVOrder, 2, 0);
+    BasisIntegrals v22(_clVSpline, _usVCtrlpoints, _usVOrder, 2, 2);
+    BasisIntegrals v31(_clVSpline, _usVCtrlpoints, _usVOrder, 3, 1);
+    BasisIntegrals v33(_clVSpline, _usVCtrlpoints, _usVOrder, 3, 3);
+
+    AssembleSmoothMatrix(_usUCtrlpoints, _usVCtrlpoints, _usUOrder, _usVOrder,
+                         [&](unsigned i, unsigned k, unsigned j, unsigned l) {
+        return u33(i,k) * v00(j,l) +
+               u31(i,k) * v02(j,l) +
+               u13(i,k) * v20(j,l) +
+               u11(i,k) * v22(j,l) +
+               u22(i,k) * v11(j,l) +
+               u02(i,k) * v31(j,l) +
+               u20(i,k) * v13(j,l) +
+               u00(i,k) * v33(j,l) ;
+    }, _clThirdMatrix, seq);
 }
 
 void BSplineParameterCorrection::EnableSmoothing(bool bSmooth, double fSmoothInfl)
@@ -1256,32 +1253,32 @@ void BSplineParameterCorrection::EnableSmoothing(bool bSmooth, double fSmoothInf
     ParameterCorrection::EnableSmoothing(bSmooth, fSmoothInfl);
 }
 
-const math_Matrix& BSplineParameterCorrection::GetFirstSmoothMatrix() const
+const Eigen::SparseMatrix<double>& BSplineParameterCorrection::GetFirstSmoothMatrix() const
 {
     return _clFirstMatrix;
 }
 
-const math_Matrix& BSplineParameterCorrection::GetSecondSmoothMatrix() const
+const Eigen::SparseMatrix<double>& BSplineParameterCorrection::GetSecondSmoothMatrix() const
 {
     return _clSecondMatrix;
 }
 
-const math_Matrix& BSplineParameterCorrection::GetThirdSmoothMatrix() const
+const Eigen::SparseMatrix<double>& BSplineParameterCorrection::GetThirdSmoothMatrix() const
 {
     return _clThirdMatrix;
 }
 
-void BSplineParameterCorrection::SetFirstSmoothMatrix(const math_Matrix& rclMat)
+void BSplineParameterCorrection::SetFirstSmoothMatrix(const Eigen::SparseMatrix<double>& rclMat)
 {
     _clFirstMatrix = rclMat;
 }
 
-void BSplineParameterCorrection::SetSecondSmoothMatrix(const math_Matrix& rclMat)
+void BSplineParameterCorrection::SetSecondSmoothMatrix(const Eigen::SparseMatrix<double>& rclMat)
 {
     _clSecondMatrix = rclMat;
 }
 
-void BSplineParameterCorrection::SetThirdSmoothMatrix(const math_Matrix& rclMat)
+void BSplineParameterCorrection::SetThirdSmoothMatrix(const Eigen::SparseMatrix<double>& rclMat)
 {
     _clThirdMatrix = rclMat;
 }
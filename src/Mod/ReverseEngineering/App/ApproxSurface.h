@@ -31,6 +31,7 @@
 #include <TColgp_Array1OfPnt2d.hxx>
 #include <Geom_BSplineSurface.hxx>
 #include <math_Matrix.hxx>
+#include <Eigen/SparseCore>
 
 #include <Base/Vector3D.h>
 
@@ -390,16 +391,23 @@ protected:
     virtual void DoParameterCorrection(int iIter);
 
     /**
-     * Loest ein ueberbestimmtes LGS mit Hilfe der Householder-Transformation
+     * Loest das ueberbestimmte LGS ueber die Normalengleichungen
      */
     virtual bool SolveWithoutSmoothing();
 
     /**
-     * Loest ein regulaeres Gleichungssystem durch LU-Zerlegung. Es fliessen je nach Gewichtung
-     * Glaettungsterme mit ein
+     * Loest die Normalengleichungen, in die je nach Gewichtung Glaettungsterme mit einfliessen
      */
     virtual bool SolveWithSmoothing(double fWeight);
 
+    /**
+     * Assembles the sparse normal equations of the least-squares problem in parallel
+     * and solves them with a sparse Cholesky decomposition. Because of the local support
+     * of the basis functions each row has at most (2*uorder-1)*(2*vorder-1) non-zeros.
+     * If the decomposition fails the conjugate gradient method is used instead.
+     */
+    bool SolveNormalEquations(double fWeight);
+
 public:
     /**
      * Setzen des Knotenvektors
@@ -414,32 +422,32 @@ public:
     /**
      * Gibt die erste Matrix der Glaettungsterme zurueck, falls berechnet
      */
-    virtual const math_Matrix& GetFirstSmoothMatrix() const;
+    virtual const Eigen::SparseMatrix<double>& GetFirstSmoothMatrix() const;
 
     /**
      * Gibt die zweite Matrix der Glaettungsterme zurueck, falls berechnet
      */
-    virtual const math_Matrix& GetSecondSmoothMatrix() const;
+    virtual const Eigen::SparseMatrix<double>& GetSecondSmoothMatrix() const;
 
     /**
      * Gibt die dritte Matrix der Glaettungsterme zurueck, falls berechnet
      */
-    virtual const math_Matrix& GetThirdSmoothMatrix() const;
+    virtual const Eigen::SparseMatrix<double>& GetThirdSmoothMatrix() const;
 
     /**
      * Setzt die erste Matrix der Glaettungsterme
      */
-    virtual void SetFirstSmoothMatrix(const math_Matrix& rclMat);
+    virtual void SetFirstSmoothMatrix(const Eigen::SparseMatrix<double>& rclMat);
 
     /**
      * Setzt die zweite Matrix der Glaettungsterme
      */
-    virtual void SetSecondSmoothMatrix(const math_Matrix& rclMat);
+    virtual void SetSecondSmoothMatrix(const Eigen::SparseMatrix<double>& rclMat);
 
     /**
      * Setzt die dritte Matrix der Glaettungsterme
      */
-    virtual void SetThirdSmoothMatrix(const math_Matrix& rclMat);
+    virtual void SetThirdSmoothMatrix(const Eigen::SparseMatrix<double>& rclMat);
 
     /**
      * Verwende Glaettungsterme
@@ -479,10 +487,10 @@ protected:
 protected:
     BSplineBasis           _clUSpline;        //! B-Spline-Basisfunktion in u-Richtung
     BSplineBasis           _clVSpline;        //! B-Spline-Basisfunktion in v-Richtung
-    math_Matrix            _clSmoothMatrix;   //! Matrix der Glaettungsfunktionale
-    math_Matrix            _clFirstMatrix;    //! Matrix der 1. Glaettungsfunktionale
-    math_Matrix            _clSecondMatrix;   //! Matrix der 2. Glaettungsfunktionale
-    math_Matrix            _clThirdMatrix;    //! Matrix der 3. Glaettungsfunktionale
+    Eigen::SparseMatrix<double> _clSmoothMatrix; //! Matrix der Glaettungsfunktionale
+    Eigen::SparseMatrix<double> _clFirstMatrix;  //! Matrix der 1. Glaettungsfunktionale
+    Eigen::SparseMatrix<double> _clSecondMatrix; //! Matrix der 2. Glaettungsfunktionale
+    Eigen::SparseMatrix<double> _clThirdMatrix;  //! Matrix der 3. Glaettungsfunktionale
 };
 
 } // namespace Reen
@@ -0,0 +1,196 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <climits>
+# include <cmath>
+#endif
+
+#include "OrganizedCloud.h"
+#include <Mod/Points/App/Points.h>
+#include <Mod/Mesh/App/Mesh.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Base/Exception.h>
+#include <Base/ThreadPool.h>
+
+using namespace Reen;
+
+OrganizedCloud::OrganizedCloud(int width, int height, const Points::PointKernel& pts)
+  : width(width)
+  , height(height)
+  , myPoints(pts.getBasicPoints())
+  , maxEdgeLength(0.0f)
+{
+    if (width < 1 || height < 1 || myPoints.size() != static_cast<std::size_t>(width) * height)
+        throw Base::ValueError("Number of points doesn't match with given width and height");
+}
+
+bool OrganizedCloud::isValid(int row, int col) const
+{
+    if (row < 0 || row >= height || col < 0 || col >= width)
+        return false;
+    const Base::Vector3f& p = myPoints[row * width + col];
+    return !std::isnan(p.x) && !std::isnan(p.y) && !std::isnan(p.z);
+}
+
+bool OrganizedCloud::isConnected(int index1, int index2) const
+{
+    if (maxEdgeLength <= 0.0f)
+        return true;
+    return Base::DistanceP2(myPoints[index1], myPoints[index2]) <= maxEdgeLength * maxEdgeLength;
+}
+
+void OrganizedCloud::computeNormals(std::vector<Base::Vector3f>& normals) const
+{
+    normals.resize(myPoints.size());
+
+    Base::parallel_for(0, height, [&](int row) {
+        for (int col = 0; col < width; col++) {
+            int index = row * width + col;
+            Base::Vector3f& normal = normals[index];
+            normal.Set(0.0f, 0.0f, 0.0f);
+            if (!isValid(row, col))
+                continue;
+
+            // use the neighbours on both sides if possible, otherwise the point itself
+            auto neighbour = [&](int r, int c) {
+                int other = r * width + c;
+                return isValid(r, c) && isConnected(index, other) ? other : index;
+            };
+            int left = neighbour(row, col - 1);
+            int right = neighbour(row, col + 1);
+            int top = neighbour(row - 1, col);
+            int bottom = neighbour(row + 1, col);
+            if (left == right || top == bottom)
+                continue;
+
+            normal = (myPoints[right] - myPoints[left]) % (myPoints[bottom] - myPoints[top]);
+            if (normal.Length() > 0.0f)
+                normal.Normalize();
+        }
+    });
+}
+
+void OrganizedCloud::triangulate(Mesh::MeshObject& mesh) const
+{
+    // the facets of each row of cells, referring to the lattice indices
+    std::vector<MeshCore::MeshFacetArray> rows(height > 1 ? height - 1 : 0);
+    Base::parallel_for(std::size_t(0), rows.size(), [&](std::size_t r) {
+        int row = static_cast<int>(r);
+        MeshCore::MeshFacetArray& facets = rows[r];
+        auto addFacet = [&](int p0, int p1, int p2) {
+            if (isConnected(p0, p1) && isConnected(p1, p2) && isConnected(p2, p0))
+                facets.push_back(MeshCore::MeshFacet(p0, p1, p2));
+        };
+
+        for (int col = 0; col + 1 < width; col++) {
+            // corners of the cell, the triangles are oriented like the normals
+            int a = row * width + col;
+            int b = a + 1;
+            int c = a + width;
+            int d = c + 1;
+            bool va = isValid(row, col);
+            bool vb = isValid(row, col + 1);
+            bool vc = isValid(row + 1, col);
+            bool vd = isValid(row + 1, col + 1);
+            if (va && vb && vc && vd) {
+                if (Base::DistanceP2(myPoints[a], myPoints[d]) <= Base::DistanceP2(myPoints[b], myPoints[c])) {
+                    addFacet(a, b, d);
+                    addFacet(a, d, c);
+                }
+                else {
+                    addFacet(a, b, c);
+                    addFacet(b, d, c);
+                }
+            }
+            else if (va && vb && vc) {
+                addFacet(a, b, c);
+            }
+            else if (va && vb && vd) {
+                addFacet(a, b, d);
+            }
+            else if (va && vc && vd) {
+                addFacet(a, d, c);
+            }
+            else if (vb && vc && vd) {
+                addFacet(b, d, c);
+            }
+        }
+    });
+
+    // keep only the points that are used by a facet
+    std::vector<char> used(myPoints.size(), 0);
+    std::size_t numFacets = 0;
+    for (const auto& facets : rows) {
+        numFacets += facets.size();
+        for (const auto& facet : facets) {
+            for (int i = 0; i < 3; i++)
+                used[facet._aulPoints[i]] = 1;
+        }
+    }
+
+    std::vector<unsigned long> index(myPoints.size(), ULONG_MAX);
+    MeshCore::MeshPointArray points;
+    for (std::size_t i = 0; i < myPoints.size(); i++) {
+        if (used[i]) {
+            index[i] = points.size();
+            points.push_back(MeshCore::MeshPoint(myPoints[i]));
+        }
+    }
+
+    MeshCore::MeshFacetArray facets;
+    facets.reserve(numFacets);
+    for (auto& row : rows) {
+        for (auto& facet : row) {
+            for (int i = 0; i < 3; i++)
+                facet._aulPoints[i] = index[facet._aulPoints[i]];
+            facets.push_back(facet);
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    mesh.swap(kernel);
+}
+
+void OrganizedCloud::decimate(int stride, Points::PointKernel& points, int& w, int& h) const
+{
+    if (stride < 1)
+        throw Base::ValueError("Stride must be positive");
+
+    w = (width + stride - 1) / stride;
+    h = (height + stride - 1) / stride;
+
+    std::vector<Base::Vector3f> kept(static_cast<std::size_t>(w) * h);
+    Base::parallel_for(0, h, [&](int row) {
+        const Base::Vector3f* src = &myPoints[static_cast<std::size_t>(row) * stride * width];
+        Base::Vector3f* dst = &kept[static_cast<std::size_t>(row) * w];
+        for (int col = 0; col < w; col++)
+            dst[col] = src[col * stride];
+    });
+
+    points.swap(kept);
+}
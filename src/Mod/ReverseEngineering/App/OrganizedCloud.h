@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef REEN_ORGANIZEDCLOUD_H
+#define REEN_ORGANIZEDCLOUD_H
+
+#include <Base/Vector3D.h>
+#include <vector>
+
+namespace Points {class PointKernel;}
+namespace Mesh {class MeshObject;}
+
+namespace Reen {
+
+/**
+ * The OrganizedCloud class handles point clouds whose points lie on a width x height
+ * lattice row by row, like the points of Points::Structured. The neighbours of a point
+ * are given by the lattice, so no search structure is needed. Invalid points have a NaN
+ * coordinate and are skipped. All methods process the rows in parallel.
+ */
+class OrganizedCloud
+{
+public:
+    /// Throws Base::ValueError if width * height doesn't match with the number of points
+    OrganizedCloud(int width, int height, const Points::PointKernel&);
+
+    /** \brief Set the maximum length of an edge between neighbouring points.
+      * \note Longer edges are treated as depth discontinuities, such points are neither
+      * connected by a triangle nor used for the normal of each other. A value of 0 means no limit.
+      * \param[in] length the maximum edge length
+      */
+    inline void
+    setMaxEdgeLength(float length) { this->maxEdgeLength = length; }
+
+    /** \brief Computes the normals from the cross product of the differences to the
+      * neighbours in row and column direction. Points without valid neighbours get a null vector.
+      */
+    void computeNormals(std::vector<Base::Vector3f>& normals) const;
+    /** \brief Creates two triangles per lattice cell, split along the shorter diagonal, or one
+      * if a corner is missing. Points that are not part of a triangle are not added to the mesh.
+      */
+    void triangulate(Mesh::MeshObject& mesh) const;
+    /** \brief Keeps every stride-th point in both directions.
+      * \param[in] stride the distance of the kept points on the lattice
+      * \param[out] points the kept points, also ordered row by row
+      * \param[out] width the width of the new lattice
+      * \param[out] height the height of the new lattice
+      */
+    void decimate(int stride, Points::PointKernel& points, int& width, int& height) const;
+
+private:
+    bool isValid(int row, int col) const;
+    bool isConnected(int index1, int index2) const;
+
+private:
+    int width;
+    int height;
+    const std::vector<Base::Vector3f>& myPoints;
+    float maxEdgeLength;
+};
+
+} // namespace Reen
+
+#endif // REEN_ORGANIZEDCLOUD_H
@@ -23,11 +23,28 @@
 
 #include "PreCompiled.h"
 
+#ifndef _PreComp_
+# include <algorithm>
+# include <cfloat>
+# include <cmath>
+# include <memory>
+# include <numeric>
+# include <random>
+#endif
+
+#include <QtConcurrentMap>
+
 #include "SampleConsensus.h"
+#include <Mod/Mesh/App/Core/Approximation.h>
 #include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsGrid.h>
+#include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <boost/math/special_functions/fpclassify.hpp>
 
+using namespace std;
+using namespace Reen;
+
 #if defined(HAVE_PCL_SAMPLE_CONSENSUS)
 #include <pcl/point_types.h>
 #include <pcl/features/normal_3d.h>
@@ -37,8 +54,6 @@
 #include <pcl/sample_consensus/sac_model_cylinder.h>
 #include <pcl/sample_consensus/sac_model_cone.h>
 
-using namespace std;
-using namespace Reen;
 using pcl::PointXYZ;
 using pcl::PointNormal;
 using pcl::PointCloud;
@@ -135,3 +150,731 @@ double SampleConsensus::perform(std::vector<float>& parameters, std::vector<int>
 
 #endif // HAVE_PCL_SAMPLE_CONSENSUS
 
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// depth of the octree used for the local sampling of minimal sets
+const int OctreeDepth = 10;
+// number of points of a minimal set
+const int MinimalSet = 3;
+
+struct Shape
+{
+    PrimitiveDetection::PrimitiveType type;
+    Base::Vector3d base;
+    Base::Vector3d axis;
+    // radius of a sphere or cylinder or the opening angle of a cone
+    double radius;
+
+    /// Returns the signed distance of \a pnt to the shape and the surface normal there.
+    double distance(const Base::Vector3d& pnt, Base::Vector3d& normal) const
+    {
+        Base::Vector3d v = pnt - base;
+        switch (type) {
+        case PrimitiveDetection::Plane:
+        {
+            normal = axis;
+            return v * axis;
+        }
+        case PrimitiveDetection::Sphere:
+        {
+            double len = v.Length();
+            normal = len > 0 ? v / len : axis;
+            return len - radius;
+        }
+        case PrimitiveDetection::Cylinder:
+        {
+            Base::Vector3d radial = v - axis * (v * axis);
+            double len = radial.Length();
+            normal = len > 0 ? radial / len : axis;
+            return len - radius;
+        }
+        case PrimitiveDetection::Cone:
+        {
+            double h = v * axis;
+            Base::Vector3d radial = v - axis * h;
+            double len = radial.Length();
+            double c = cos(radius);
+            double s = sin(radius);
+            normal = (len > 0 ? radial / len : radial) * c - axis * s;
+            // behind the apex the apex itself is the nearest point
+            if (h * c + len * s < 0)
+                return v.Length();
+            return len * c - h * s;
+        }
+        }
+
+        return DBL_MAX;
+    }
+    bool isCompatible(const Base::Vector3d& pnt, const Base::Vector3d& nor, double eps, double cosAngle) const
+    {
+        Base::Vector3d normal;
+        double dist = distance(pnt, normal);
+        return fabs(dist) < eps && fabs(normal * nor) >= cosAngle;
+    }
+    std::vector<float> parameters() const
+    {
+        std::vector<float> param;
+        if (type == PrimitiveDetection::Plane) {
+            param = {float(axis.x), float(axis.y), float(axis.z), float(-(axis * base))};
+        }
+        else if (type == PrimitiveDetection::Sphere) {
+            param = {float(base.x), float(base.y), float(base.z), float(radius)};
+        }
+        else {
+            param = {float(base.x), float(base.y), float(base.z),
+                     float(axis.x), float(axis.y), float(axis.z), float(radius)};
+        }
+        return param;
+    }
+};
+
+// Midpoint of the shortest connection between the lines p1 + t * n1 and p2 + s * n2
+bool closestPoint(const Base::Vector3d& p1, const Base::Vector3d& n1,
+                  const Base::Vector3d& p2, const Base::Vector3d& n2,
+                  Base::Vector3d& center)
+{
+    Base::Vector3d w = p1 - p2;
+    double b = n1 * n2;
+    double d = n1 * w;
+    double e = n2 * w;
+    double denom = 1.0 - b * b;
+    if (denom < 1e-6)
+        return false;
+    double t = (b * e - d) / denom;
+    double s = (e - b * d) / denom;
+    center = ((p1 + n1 * t) + (p2 + n2 * s)) * 0.5;
+    return true;
+}
+
+bool makePlane(const Base::Vector3d* p, Shape& shape)
+{
+    Base::Vector3d normal = (p[1] - p[0]) % (p[2] - p[0]);
+    double len = normal.Length();
+    if (len < 1e-12)
+        return false;
+    shape.type = PrimitiveDetection::Plane;
+    shape.base = p[0];
+    shape.axis = normal / len;
+    shape.radius = 0;
+    return true;
+}
+
+bool makeSphere(const Base::Vector3d* p, const Base::Vector3d* n, Shape& shape)
+{
+    Base::Vector3d center;
+    if (!closestPoint(p[0], n[0], p[1], n[1], center))
+        return false;
+    shape.type = PrimitiveDetection::Sphere;
+    shape.base = center;
+    shape.axis = n[0];
+    shape.radius = 0.5 * (Base::Distance(p[0], center) + Base::Distance(p[1], center));
+    return shape.radius > 0;
+}
+
+bool makeCylinder(const Base::Vector3d* p, const Base::Vector3d* n, Shape& shape)
+{
+    Base::Vector3d axis = n[0] % n[1];
+    double len = axis.Length();
+    if (len < 1e-3)
+        return false;
+    axis = axis / len;
+    Base::Vector3d center;
+    if (!closestPoint(p[0], n[0], p[1], n[1], center))
+        return false;
+    shape.type = PrimitiveDetection::Cylinder;
+    shape.base = center;
+    shape.axis = axis;
+    shape.radius = 0;
+    for (int i = 0; i < 2; i++) {
+        Base::Vector3d v = p[i] - center;
+        shape.radius += 0.5 * (v - axis * (v * axis)).Length();
+    }
+    return shape.radius > 0;
+}
+
+bool makeCone(const Base::Vector3d* p, const Base::Vector3d* n, Shape& shape)
+{
+    // the apex is the intersection of the three tangent planes
+    double det = n[0] * (n[1] % n[2]);
+    if (fabs(det) < 1e-3)
+        return false;
+    Base::Vector3d apex = ((n[1] % n[2]) * (n[0] * p[0]) +
+                           (n[2] % n[0]) * (n[1] * p[1]) +
+                           (n[0] % n[1]) * (n[2] * p[2])) / det;
+
+    // the directions from the apex to the points lie on a circle around the axis
+    Base::Vector3d dir[3];
+    for (int i = 0; i < 3; i++) {
+        dir[i] = p[i] - apex;
+        double len = dir[i].Length();
+        if (len < 1e-12)
+            return false;
+        dir[i] = dir[i] / len;
+    }
+    Base::Vector3d axis = (dir[1] - dir[0]) % (dir[2] - dir[0]);
+    double len = axis.Length();
+    if (len < 1e-12)
+        return false;
+    axis = axis / len;
+    if (axis * dir[0] < 0)
+        axis = -axis;
+
+    double angle = 0;
+    for (int i = 0; i < 3; i++)
+        angle += acos(std::min(1.0, axis * dir[i])) / 3.0;
+    // reject cones that degenerate to a line or a plane
+    if (angle < 0.02 || angle > M_PI / 2 - 0.02)
+        return false;
+
+    shape.type = PrimitiveDetection::Cone;
+    shape.base = apex;
+    shape.axis = axis;
+    shape.radius = angle;
+    return true;
+}
+
+uint32_t spreadBits(uint32_t v)
+{
+    v = (v | (v << 16)) & 0x030000FF;
+    v = (v | (v <<  8)) & 0x0300F00F;
+    v = (v | (v <<  4)) & 0x030C30C3;
+    v = (v | (v <<  2)) & 0x09249249;
+    return v;
+}
+
+class Detector
+{
+public:
+    Detector(const Points::PointKernel& pts, const std::vector<Base::Vector3d>& nor)
+      : myPoints(pts)
+      , types(0)
+      , epsilon(0)
+      , cosAngle(0)
+      , clusterEpsilon(0)
+      , minSupport(0)
+      , probability(0)
+      , visitStamp(0)
+    {
+        std::size_t numPoints = pts.size();
+        points.resize(numPoints);
+        normals.resize(numPoints);
+        for (std::size_t i = 0; i < numPoints; i++) {
+            const Base::Vector3d& p = pts.getPoint(static_cast<int>(i));
+            Base::Vector3d n = nor[i];
+            if (boost::math::isnan(p.x) || boost::math::isnan(p.y) || boost::math::isnan(p.z))
+                continue;
+            if (boost::math::isnan(n.x) || boost::math::isnan(n.y) || boost::math::isnan(n.z))
+                continue;
+            double len = n.Length();
+            if (len <= 0)
+                continue;
+            points[i] = p;
+            normals[i] = n / len;
+            remaining.push_back(static_cast<int>(i));
+        }
+    }
+
+    int types;
+    double epsilon;
+    double cosAngle;
+    double clusterEpsilon;
+    std::size_t minSupport;
+    double probability;
+
+    void run(std::vector<PrimitiveDetection::Primitive>& primitives, std::vector<int>& labels)
+    {
+        std::size_t numPoints = points.size();
+        assigned.assign(numPoints, 0);
+        labels.assign(numPoints, -1);
+        primitives.clear();
+        if (remaining.size() < minSupport)
+            return;
+
+        buildOctree();
+        if (clusterEpsilon > 0) {
+            grid.reset(new Points::PointsHashGrid(myPoints));
+            visitMark.assign(numPoints, 0);
+        }
+
+        std::mt19937 rng(0);
+        resetSubsets(rng);
+
+        const std::size_t batchSize = 512;
+        std::size_t numDrawn = 0;
+        levelScore.assign(OctreeDepth, 1.0);
+
+        while (remaining.size() >= minSupport) {
+            drawCandidates(batchSize, rng);
+            numDrawn += batchSize;
+
+            Candidate* best = findBest();
+            if (best && best->count >= minSupport && missProbability(best->count, numDrawn) < 1.0 - probability) {
+                Candidate cand = *best;
+                candidates.erase(candidates.begin() + (best - candidates.data()));
+                if (extract(cand.shape, primitives, labels)) {
+                    resetSubsets(rng);
+                    rescoreCandidates();
+                }
+            }
+            else if (missProbability(minSupport, numDrawn) < 1.0 - probability) {
+                // no primitive with the minimum support can be missed any more
+                break;
+            }
+        }
+    }
+
+private:
+    struct Candidate
+    {
+        Shape shape;
+        // octree level of the minimal set
+        int level;
+        // compatible points in the subsets up to 'subset'
+        std::size_t count;
+        std::size_t subset;
+        // 'count' is the size of the largest connected component
+        bool connected;
+    };
+
+    void buildOctree()
+    {
+        Base::BoundBox3d bbox;
+        for (std::vector<int>::iterator it = remaining.begin(); it != remaining.end(); ++it)
+            bbox.Add(points[*it]);
+        double size = std::max(bbox.LengthX(), std::max(bbox.LengthY(), bbox.LengthZ()));
+        double scale = size > 0 ? ((1 << OctreeDepth) - 1) / size : 0;
+
+        std::vector<std::pair<uint32_t, int> > codes;
+        codes.reserve(remaining.size());
+        for (std::vector<int>::iterator it = remaining.begin(); it != remaining.end(); ++it) {
+            const Base::Vector3d& p = points[*it];
+            uint32_t x = static_cast<uint32_t>((p.x - bbox.MinX) * scale);
+            uint32_t y = static_cast<uint32_t>((p.y - bbox.MinY) * scale);
+            uint32_t z = static_cast<uint32_t>((p.z - bbox.MinZ) * scale);
+            codes.emplace_back(spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2), *it);
+        }
+        std::sort(codes.begin(), codes.end());
+
+        pointCode.assign(points.size(), 0);
+        sortedCodes.resize(codes.size());
+        sortedIndex.resize(codes.size());
+        for (std::size_t i = 0; i < codes.size(); i++) {
+            sortedCodes[i] = codes[i].first;
+            sortedIndex[i] = codes[i].second;
+            pointCode[codes[i].second] = codes[i].first;
+        }
+    }
+
+    // The remaining points are shuffled and split into subsets of growing size. A candidate
+    // is first scored on the smallest one and only refined on demand.
+    void resetSubsets(std::mt19937& rng)
+    {
+        order = remaining;
+        std::shuffle(order.begin(), order.end(), rng);
+        subsetEnd.clear();
+        std::size_t size = std::min<std::size_t>(order.size(), 1000);
+        subsetEnd.push_back(size);
+        while (size < order.size()) {
+            size = std::min(order.size(), size * 4);
+            subsetEnd.push_back(size);
+        }
+    }
+
+    std::size_t countCompatible(const Shape& shape, std::size_t begin, std::size_t end) const
+    {
+        std::size_t count = 0;
+        for (std::size_t i = begin; i < end; i++) {
+            int index = order[i];
+            if (shape.isCompatible(points[index], normals[index], epsilon, cosAngle))
+                count++;
+        }
+        return count;
+    }
+
+    std::size_t countCompatibleParallel(const Shape& shape, std::size_t begin, std::size_t end) const
+    {
+        std::vector<std::pair<std::size_t, std::size_t> > blocks;
+        for (std::size_t i = begin; i < end; i += 0x4000)
+            blocks.emplace_back(i, std::min<std::size_t>(i + 0x4000, end));
+        std::vector<std::size_t> counts(blocks.size());
+        QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+            counts[&block - blocks.data()] = countCompatible(shape, block.first, block.second);
+        });
+        return std::accumulate(counts.begin(), counts.end(), std::size_t(0));
+    }
+
+    std::vector<int> collectInliers(const Shape& shape) const
+    {
+        std::vector<std::pair<std::size_t, std::size_t> > blocks;
+        for (std::size_t i = 0; i < order.size(); i += 0x4000)
+            blocks.emplace_back(i, std::min<std::size_t>(i + 0x4000, order.size()));
+        std::vector<std::vector<int> > inliers(blocks.size());
+        QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+            std::vector<int>& local = inliers[&block - blocks.data()];
+            for (std::size_t i = block.first; i < block.second; i++) {
+                int index = order[i];
+                if (shape.isCompatible(points[index], normals[index], epsilon, cosAngle))
+                    local.push_back(index);
+            }
+        });
+
+        std::vector<int> result;
+        for (std::vector<std::vector<int> >::iterator it = inliers.begin(); it != inliers.end(); ++it)
+            result.insert(result.end(), it->begin(), it->end());
+        return result;
+    }
+
+    // Keeps the largest subset of points that are connected by gaps of at most the cluster epsilon
+    void largestComponent(std::vector<int>& inliers)
+    {
+        if (!grid)
+            return;
+
+        int inSet = ++visitStamp;
+        int visited = ++visitStamp;
+        for (std::vector<int>::iterator it = inliers.begin(); it != inliers.end(); ++it)
+            visitMark[*it] = inSet;
+
+        std::vector<int> best, component, front;
+        std::vector<unsigned long> neighbours;
+        for (std::vector<int>::iterator it = inliers.begin(); it != inliers.end(); ++it) {
+            if (visitMark[*it] != inSet)
+                continue;
+            component.clear();
+            front.clear();
+            front.push_back(*it);
+            visitMark[*it] = visited;
+            while (!front.empty()) {
+                int index = front.back();
+                front.pop_back();
+                component.push_back(index);
+                neighbours.clear();
+                grid->SearchRadius(points[index], clusterEpsilon, neighbours);
+                for (std::vector<unsigned long>::iterator jt = neighbours.begin(); jt != neighbours.end(); ++jt) {
+                    if (visitMark[*jt] == inSet) {
+                        visitMark[*jt] = visited;
+                        front.push_back(static_cast<int>(*jt));
+                    }
+                }
+            }
+            if (component.size() > best.size())
+                best.swap(component);
+        }
+
+        inliers.swap(best);
+    }
+
+    bool sampleMinimalSet(std::minstd_rand& rng, const std::vector<double>& levelDistribution,
+                          int& level, int* sample) const
+    {
+        std::uniform_int_distribution<std::size_t> pick(0, remaining.size() - 1);
+        sample[0] = remaining[pick(rng)];
+
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        double r = uniform(rng);
+        level = static_cast<int>(std::lower_bound(levelDistribution.begin(), levelDistribution.end(), r)
+                                 - levelDistribution.begin());
+        level = std::min(level, OctreeDepth - 1);
+
+        // the other points are taken from the octree cell of the first point at this level
+        int shift = 3 * (OctreeDepth - level);
+        uint64_t prefix = pointCode[sample[0]] >> shift;
+        std::vector<uint32_t>::const_iterator lo = std::lower_bound(sortedCodes.begin(), sortedCodes.end(),
+            static_cast<uint32_t>(prefix << shift));
+        std::vector<uint32_t>::const_iterator hi = std::lower_bound(lo, sortedCodes.end(),
+            static_cast<uint32_t>(std::min<uint64_t>((prefix + 1) << shift, UINT32_MAX)));
+        if (level == 0)
+            hi = sortedCodes.end();
+        std::size_t first = lo - sortedCodes.begin();
+        std::size_t count = hi - lo;
+        if (count < MinimalSet)
+            return false;
+
+        std::uniform_int_distribution<std::size_t> cell(0, count - 1);
+        for (int i = 1; i < MinimalSet; i++) {
+            int trials = 0;
+            do {
+                if (++trials > 20)
+                    return false;
+                sample[i] = sortedIndex[first + cell(rng)];
+            }
+            while (assigned[sample[i]] || std::find(sample, sample + i, sample[i]) != sample + i);
+        }
+
+        return true;
+    }
+
+    std::vector<Candidate> generate(unsigned int seed, const std::vector<double>& levelDistribution) const
+    {
+        std::vector<Candidate> result;
+        std::minstd_rand rng(seed);
+        int level;
+        int sample[MinimalSet];
+        if (!sampleMinimalSet(rng, levelDistribution, level, sample))
+            return result;
+
+        Base::Vector3d p[MinimalSet], n[MinimalSet];
+        for (int i = 0; i < MinimalSet; i++) {
+            p[i] = points[sample[i]];
+            n[i] = normals[sample[i]];
+        }
+
+        Shape shape;
+        std::vector<Shape> shapes;
+        if ((types & PrimitiveDetection::Plane) && makePlane(p, shape))
+            shapes.push_back(shape);
+        if ((types & PrimitiveDetection::Sphere) && makeSphere(p, n, shape))
+            shapes.push_back(shape);
+        if ((types & PrimitiveDetection::Cylinder) && makeCylinder(p, n, shape))
+            shapes.push_back(shape);
+        if ((types & PrimitiveDetection::Cone) && makeCone(p, n, shape))
+            shapes.push_back(shape);
+
+        // all points of the minimal set must be compatible with the shape
+        for (std::vector<Shape>::iterator it = shapes.begin(); it != shapes.end(); ++it) {
+            bool ok = true;
+            for (int i = 0; i < MinimalSet && ok; i++)
+                ok = it->isCompatible(p[i], n[i], epsilon, cosAngle);
+            if (ok) {
+                Candidate cand;
+                cand.shape = *it;
+                cand.level = level;
+                cand.subset = 0;
+                cand.count = countCompatible(*it, 0, subsetEnd[0]);
+                cand.connected = false;
+                result.push_back(cand);
+            }
+        }
+
+        return result;
+    }
+
+    void drawCandidates(std::size_t num, std::mt19937& rng)
+    {
+        // prefer the octree levels that have produced good candidates so far
+        double total = std::accumulate(levelScore.begin(), levelScore.end(), 0.0);
+        std::vector<double> levelDistribution(OctreeDepth);
+        double sum = 0;
+        for (int i = 0; i < OctreeDepth; i++) {
+            sum += 0.9 * levelScore[i] / total + 0.1 / OctreeDepth;
+            levelDistribution[i] = sum;
+        }
+
+        std::vector<unsigned int> seeds(num);
+        for (std::vector<unsigned int>::iterator it = seeds.begin(); it != seeds.end(); ++it)
+            *it = rng();
+        std::vector<std::vector<Candidate> > batch(num);
+        QtConcurrent::blockingMap(seeds, [&](const unsigned int& seed) {
+            batch[&seed - seeds.data()] = generate(seed, levelDistribution);
+        });
+
+        for (std::vector<std::vector<Candidate> >::iterator it = batch.begin(); it != batch.end(); ++it) {
+            for (std::vector<Candidate>::iterator jt = it->begin(); jt != it->end(); ++jt) {
+                levelScore[jt->level] += static_cast<double>(jt->count) / subsetEnd[0];
+                if (upperBound(*jt) >= minSupport)
+                    candidates.push_back(*jt);
+            }
+        }
+    }
+
+    void rescoreCandidates()
+    {
+        QtConcurrent::blockingMap(candidates, [&](Candidate& cand) {
+            cand.subset = 0;
+            cand.count = countCompatible(cand.shape, 0, subsetEnd[0]);
+            cand.connected = false;
+        });
+
+        std::size_t minSize = minSupport;
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](const Candidate& cand) {
+            return upperBound(cand) < minSize;
+        }), candidates.end());
+    }
+
+    bool isExact(const Candidate& cand) const
+    {
+        return cand.subset + 1 == subsetEnd.size() && (!grid || cand.connected);
+    }
+
+    double upperBound(const Candidate& cand) const
+    {
+        std::size_t size = subsetEnd[cand.subset];
+        if (size == order.size())
+            return static_cast<double>(cand.count);
+        double scale = static_cast<double>(order.size()) / size;
+        double count = static_cast<double>(cand.count);
+        return (count + 2.0 * sqrt(count) + 1.0) * scale;
+    }
+
+    // Refine the candidate with the highest upper bound until its score is exact
+    Candidate* findBest()
+    {
+        while (!candidates.empty()) {
+            Candidate* best = &candidates[0];
+            double bestBound = upperBound(*best);
+            for (std::vector<Candidate>::iterator it = candidates.begin() + 1; it != candidates.end(); ++it) {
+                double bound = upperBound(*it);
+                if (bound > bestBound) {
+                    bestBound = bound;
+                    best = &*it;
+                }
+            }
+
+            if (isExact(*best))
+                return best;
+
+            if (best->subset + 1 < subsetEnd.size()) {
+                std::size_t begin = subsetEnd[best->subset];
+                std::size_t end = subsetEnd[++best->subset];
+                best->count += countCompatibleParallel(best->shape, begin, end);
+            }
+            else {
+                std::vector<int> inliers = collectInliers(best->shape);
+                largestComponent(inliers);
+                best->count = inliers.size();
+                best->connected = true;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Probability to have missed a primitive of the given size after drawing num candidates
+    double missProbability(std::size_t size, std::size_t num) const
+    {
+        double p = static_cast<double>(size) /
+                   (static_cast<double>(remaining.size()) * OctreeDepth * (1 << (MinimalSet - 1)));
+        return pow(1.0 - std::min(p, 1.0), static_cast<double>(num));
+    }
+
+    // Least-squares refinement with the inliers of the candidate
+    Shape refit(const Shape& shape, const std::vector<int>& inliers) const
+    {
+        Shape result = shape;
+        if (shape.type == PrimitiveDetection::Plane) {
+            MeshCore::PlaneFit fit;
+            for (std::vector<int>::const_iterator it = inliers.begin(); it != inliers.end(); ++it)
+                fit.AddPoint(Base::convertTo<Base::Vector3f>(points[*it]));
+            if (fit.Fit() < FLT_MAX) {
+                result.base = Base::convertTo<Base::Vector3d>(fit.GetBase());
+                result.axis = Base::convertTo<Base::Vector3d>(fit.GetNormal());
+            }
+        }
+        else if (shape.type == PrimitiveDetection::Sphere) {
+            MeshCore::SphereFit fit;
+            for (std::vector<int>::const_iterator it = inliers.begin(); it != inliers.end(); ++it)
+                fit.AddPoint(Base::convertTo<Base::Vector3f>(points[*it]));
+            if (fit.Fit() < FLT_MAX) {
+                result.base = Base::convertTo<Base::Vector3d>(fit.GetCenter());
+                result.radius = fit.GetRadius();
+            }
+        }
+        else if (shape.type == PrimitiveDetection::Cylinder) {
+            MeshCore::CylinderFit fit;
+            for (std::vector<int>::const_iterator it = inliers.begin(); it != inliers.end(); ++it)
+                fit.AddPoint(Base::convertTo<Base::Vector3f>(points[*it]));
+            fit.SetInitialValues(Base::convertTo<Base::Vector3f>(shape.base),
+                                 Base::convertTo<Base::Vector3f>(shape.axis));
+            if (fit.Fit() < FLT_MAX) {
+                result.base = Base::convertTo<Base::Vector3d>(fit.GetBase());
+                result.axis = Base::convertTo<Base::Vector3d>(fit.GetAxis());
+                result.radius = fit.GetRadius();
+            }
+        }
+
+        return result;
+    }
+
+    bool extract(const Shape& shape, std::vector<PrimitiveDetection::Primitive>& primitives, std::vector<int>& labels)
+    {
+        std::vector<int> inliers = collectInliers(shape);
+        largestComponent(inliers);
+
+        Shape refined = refit(shape, inliers);
+        std::vector<int> refinedInliers = collectInliers(refined);
+        largestComponent(refinedInliers);
+        if (refinedInliers.size() >= inliers.size()) {
+            inliers.swap(refinedInliers);
+        }
+        else {
+            refined = shape;
+        }
+
+        if (inliers.size() < minSupport)
+            return false;
+
+        int label = static_cast<int>(primitives.size());
+        PrimitiveDetection::Primitive prim;
+        prim.type = refined.type;
+        prim.parameters = refined.parameters();
+        std::sort(inliers.begin(), inliers.end());
+        prim.indices = inliers;
+        primitives.push_back(prim);
+
+        for (std::vector<int>::iterator it = inliers.begin(); it != inliers.end(); ++it) {
+            assigned[*it] = 1;
+            labels[*it] = label;
+        }
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [this](int index) {
+            return assigned[index] != 0;
+        }), remaining.end());
+
+        return true;
+    }
+
+private:
+    const Points::PointKernel& myPoints;
+    std::vector<Base::Vector3d> points;
+    std::vector<Base::Vector3d> normals;
+    std::vector<int> remaining;
+    std::vector<char> assigned;
+
+    std::vector<uint32_t> pointCode;
+    std::vector<uint32_t> sortedCodes;
+    std::vector<int> sortedIndex;
+    std::vector<double> levelScore;
+
+    std::vector<int> order;
+    std::vector<std::size_t> subsetEnd;
+    std::vector<Candidate> candidates;
+
+    std::unique_ptr<Points::PointsHashGrid> grid;
+    std::vector<int> visitMark;
+    int visitStamp;
+};
+
+}
+
+PrimitiveDetection::PrimitiveDetection(const Points::PointKernel& pts, const std::vector<Base::Vector3d>& nor)
+  : myPoints(pts)
+  , myNormals(nor)
+  , myTypes(Plane | Sphere | Cylinder | Cone)
+  , myEpsilon(0.01)
+  , myNormalThreshold(0.35)
+  , myClusterEpsilon(0)
+  , myMinSupport(100)
+  , myProbability(0.99)
+{
+}
+
+void PrimitiveDetection::perform(std::vector<Primitive>& primitives, std::vector<int>& labels)
+{
+    if (myNormals.size() != myPoints.size())
+        throw Base::ValueError("The number of normals doesn't match the number of points");
+    if (myEpsilon <= 0)
+        throw Base::ValueError("The distance threshold must be greater than zero");
+    if (myProbability <= 0 || myProbability >= 1)
+        throw Base::ValueError("The probability must be in the range (0,1)");
+
+    Detector detector(myPoints, myNormals);
+    detector.types = myTypes;
+    detector.epsilon = myEpsilon;
+    detector.cosAngle = cos(myNormalThreshold);
+    detector.clusterEpsilon = myClusterEpsilon;
+    detector.minSupport = static_cast<std::size_t>(std::max(myMinSupport, MinimalSet));
+    detector.probability = myProbability;
+    detector.run(primitives, labels);
+}
@@ -54,6 +54,73 @@ private:
     const std::vector<Base::Vector3d>& myNormals;
 };
 
+/** Detects several planes, spheres, cylinders and cones in a point cloud with normals.
+ * The primitives are extracted one after another with the efficient RANSAC scheme of
+ * Schnabel et al.: minimal sets are sampled locally inside the cells of an octree,
+ * the candidates are generated and scored in parallel on growing random subsets and
+ * the best candidate is extracted once the probability to have missed a larger one
+ * falls below the given threshold.
+ */
+class PrimitiveDetection
+{
+public:
+    enum PrimitiveType
+    {
+      Plane    = 1,
+      Sphere   = 2,
+      Cylinder = 4,
+      Cone     = 8,
+    };
+    struct Primitive
+    {
+        PrimitiveType type;
+        /** The parameters use the same layout as SampleConsensus:
+          * plane: normal, distance, sphere: center, radius,
+          * cylinder: point on axis, axis, radius, cone: apex, axis, opening angle
+          */
+        std::vector<float> parameters;
+        std::vector<int> indices;
+    };
+
+    PrimitiveDetection(const Points::PointKernel&, const std::vector<Base::Vector3d>&);
+    /** \brief Set the primitive types to detect as combination of PrimitiveType. */
+    inline void
+    setTypes(int types) { myTypes = types; }
+    /** \brief Set the maximum distance of a point to a primitive. */
+    inline void
+    setEpsilon(double eps) { myEpsilon = eps; }
+    /** \brief Set the maximum deviation in radians of a point normal to the primitive normal. */
+    inline void
+    setNormalThreshold(double angle) { myNormalThreshold = angle; }
+    /** \brief Set the maximum gap between points of the same primitive. If not greater than
+      * zero the points of a primitive are not checked for connectivity.
+      */
+    inline void
+    setClusterEpsilon(double eps) { myClusterEpsilon = eps; }
+    /** \brief Set the minimum number of points of a primitive. */
+    inline void
+    setMinSupport(int num) { myMinSupport = num; }
+    /** \brief Set the probability to not miss the largest primitive in each extraction step. */
+    inline void
+    setProbability(double prob) { myProbability = prob; }
+
+    /** \brief Perform the detection.
+      * \param[out] primitives the detected primitives in the order of their extraction
+      * \param[out] labels the index of the primitive of each point or -1 if unassigned
+      */
+    void perform(std::vector<Primitive>& primitives, std::vector<int>& labels);
+
+private:
+    const Points::PointKernel& myPoints;
+    const std::vector<Base::Vector3d>& myNormals;
+    int myTypes;
+    double myEpsilon;
+    double myNormalThreshold;
+    double myClusterEpsilon;
+    int myMinSupport;
+    double myProbability;
+};
+
 } // namespace Reen
 
 #endif // REEN_SAMPLECONSENSUS_H
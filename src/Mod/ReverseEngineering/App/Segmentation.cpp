@@ -23,8 +23,17 @@
 
 #include "PreCompiled.h"
 
+#ifndef _PreComp_
+# include <algorithm>
+# include <limits>
+#endif
+
+#include <QtConcurrentMap>
+#include <Eigen/Eigenvalues>
+
 #include "Segmentation.h"
 #include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsGrid.h>
 #include <Base/Exception.h>
 
 #if defined(HAVE_PCL_FILTERS)
@@ -159,7 +168,6 @@ void Segmentation::perform(int ksearch)
 
 // ----------------------------------------------------------------------------
 
-#if defined (HAVE_PCL_FILTERS)
 NormalEstimation::NormalEstimation(const Points::PointKernel& pts)
   : myPoints(pts)
   , kSearch(0)
@@ -169,43 +177,57 @@ NormalEstimation::NormalEstimation(const Points::PointKernel& pts)
 
 void NormalEstimation::perform(std::vector<Base::Vector3d>& normals)
 {
-    // Copy the points
-    pcl::PointCloud<PointXYZ>::Ptr cloud (new pcl::PointCloud<PointXYZ>);
-    cloud->reserve(myPoints.size());
-    for (Points::PointKernel::const_iterator it = myPoints.begin(); it != myPoints.end(); ++it) {
-        cloud->push_back(pcl::PointXYZ(it->x, it->y, it->z));
-    }
-
-    cloud->width = int (cloud->points.size ());
-    cloud->height = 1;
-
-#if 0
-    // Build a passthrough filter to remove spurious NaNs
-    pcl::PointCloud<PointXYZ>::Ptr cloud_filtered (new pcl::PointCloud<PointXYZ>);
-    pcl::PassThrough<PointXYZ> pass;
-    pass.setInputCloud (cloud);
-    pass.setFilterFieldName ("z");
-    pass.setFilterLimits (0, 1.5);
-    pass.filter (*cloud_filtered);
-#endif
-
-    // Estimate point normals
-    pcl::PointCloud<pcl::Normal>::Ptr cloud_normals (new pcl::PointCloud<pcl::Normal>);
-    pcl::search::KdTree<PointXYZ>::Ptr tree (new pcl::search::KdTree<PointXYZ> ());
-    pcl::NormalEstimation<PointXYZ, pcl::Normal> ne;
-    ne.setSearchMethod (tree);
-    //ne.setInputCloud (cloud_filtered);
-    ne.setInputCloud (cloud);
-    if (kSearch > 0)
-        ne.setKSearch (kSearch);
-    if (searchRadius > 0)
-        ne.setRadiusSearch (searchRadius);
-    ne.compute (*cloud_normals);
-
-    normals.reserve(cloud_normals->size());
-    for (pcl::PointCloud<pcl::Normal>::const_iterator it = cloud_normals->begin(); it != cloud_normals->end(); ++it) {
-        normals.push_back(Base::Vector3d(it->normal_x, it->normal_y, it->normal_z));
-    }
+    if (kSearch <= 0 && searchRadius <= 0)
+        throw Base::ValueError("Neither the number of neighbours nor the search radius is set");
+
+    Points::PointsHashGrid grid(myPoints);
+    std::size_t numPoints = myPoints.size();
+    normals.resize(numPoints);
+
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    for (std::size_t i = 0; i < numPoints; i += 0x1000)
+        blocks.emplace_back(i, std::min<std::size_t>(i + 0x1000, numPoints));
+
+    // Fit a plane through the neighbours of each point. The normal is the eigenvector of
+    // the covariance matrix with the smallest eigenvalue and is flipped towards the origin.
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        std::vector<unsigned long> neighbours;
+        for (std::size_t i = block.first; i < block.second; i++) {
+            Base::Vector3d pnt = myPoints.getPoint(static_cast<int>(i));
+            neighbours.clear();
+            if (searchRadius > 0)
+                grid.SearchRadius(pnt, searchRadius, neighbours);
+            else
+                grid.SearchNearest(pnt, static_cast<unsigned long>(kSearch), neighbours);
+
+            if (neighbours.size() < 3) {
+                normals[i].Set(nan, nan, nan);
+                continue;
+            }
+
+            Eigen::Vector3d mean(0, 0, 0);
+            std::vector<Eigen::Vector3d> local;
+            local.reserve(neighbours.size());
+            for (std::vector<unsigned long>::iterator it = neighbours.begin(); it != neighbours.end(); ++it) {
+                Base::Vector3d p = myPoints.getPoint(static_cast<int>(*it));
+                local.emplace_back(p.x, p.y, p.z);
+                mean += local.back();
+            }
+            mean /= static_cast<double>(local.size());
+
+            Eigen::Matrix3d cov = Eigen::Matrix3d::Zero();
+            for (std::vector<Eigen::Vector3d>::iterator it = local.begin(); it != local.end(); ++it) {
+                Eigen::Vector3d d = *it - mean;
+                cov += d * d.transpose();
+            }
+
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigen(cov);
+            Eigen::Vector3d n = eigen.eigenvectors().col(0);
+            Base::Vector3d normal(n.x(), n.y(), n.z());
+            if (normal * pnt > 0)
+                normal = -normal;
+            normals[i] = normal;
+        }
+    });
 }
-
-#endif // HAVE_PCL_FILTERS
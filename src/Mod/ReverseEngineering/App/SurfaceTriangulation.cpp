@@ -30,12 +30,15 @@
 #include <Mod/Mesh/App/Core/Elements.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Base/Exception.h>
+#include <Base/Sequencer.h>
+#include <Base/ThreadPool.h>
 
 // http://svn.pointclouds.org/pcl/tags/pcl-1.5.1/test/
 #if defined(HAVE_PCL_SURFACE)
 #include <pcl/pcl_config.h>
 #include <pcl/point_types.h>
 #include <pcl/features/normal_3d.h>
+#include <pcl/features/normal_3d_omp.h>
 #include <pcl/surface/mls.h>
 #include <pcl/point_traits.h>
 #include <pcl/surface/gp3.h>
@@ -89,7 +92,7 @@ void SurfaceTriangulation::perform(int ksearch)
     tree->setInputCloud (cloud);
 
     // Normal estimation
-    NormalEstimation<PointXYZ, Normal> n;
+    NormalEstimationOMP<PointXYZ, Normal> n (Base::ThreadPool::instance().threadCount());
     PointCloud<Normal>::Ptr normals (new PointCloud<Normal> ());
     n.setInputCloud (cloud);
     //n.setIndices (indices[B);
@@ -196,11 +199,15 @@ PoissonReconstruction::PoissonReconstruction(const Points::PointKernel& pts, Mes
   , depth(-1)
   , solverDivide(-1)
   , samplesPerNode(-1.0f)
+  , threads(0)
 {
 }
 
 void PoissonReconstruction::perform(int ksearch)
 {
+    // PCL can't be interrupted, so the user can only cancel between the stages
+    Base::SequencerLauncher seq("Poisson reconstruction...", 3);
+
     PointCloud<PointXYZ>::Ptr cloud (new PointCloud<PointXYZ>);
     PointCloud<PointNormal>::Ptr cloud_with_normals (new PointCloud<PointNormal>);
     search::KdTree<PointXYZ>::Ptr tree;
@@ -217,13 +224,14 @@ void PoissonReconstruction::perform(int ksearch)
     tree->setInputCloud (cloud);
 
     // Normal estimation
-    NormalEstimation<PointXYZ, Normal> n;
+    NormalEstimationOMP<PointXYZ, Normal> n (Base::ThreadPool::instance().threadCount());
     PointCloud<Normal>::Ptr normals (new PointCloud<Normal> ());
     n.setInputCloud (cloud);
     //n.setIndices (indices[B);
     n.setSearchMethod (tree);
     n.setKSearch (ksearch);
     n.compute (*normals);
+    seq.next(true);
 
     // Concatenate XYZ and normal information
     pcl::concatenateFields (*cloud, *normals, *cloud_with_normals);
@@ -244,11 +252,16 @@ void PoissonReconstruction::perform(int ksearch)
         poisson.setSolverDivide(solverDivide);
     if (samplesPerNode >= 1.0f)
         poisson.setSamplesPerNode(samplesPerNode);
+#if PCL_VERSION_COMPARE(>=,1,8,0)
+    poisson.setThreads(threads >= 1 ? threads : Base::ThreadPool::instance().threadCount());
+#endif
 
     // Reconstruct
+    seq.next(true);
     PolygonMesh mesh;
     poisson.reconstruct (mesh);
 
+    seq.next(true);
     MeshConversion::convert(mesh, myMesh);
 }
 
@@ -257,6 +270,8 @@ void PoissonReconstruction::perform(const std::vector<Base::Vector3f>& normals)
     if (myPoints.size() != normals.size())
         throw Base::RuntimeError("Number of points doesn't match with number of normals");
 
+    Base::SequencerLauncher seq("Poisson reconstruction...", 2);
+
     PointCloud<PointNormal>::Ptr cloud_with_normals (new PointCloud<PointNormal>);
     search::KdTree<PointNormal>::Ptr tree;
 
@@ -294,11 +309,16 @@ void PoissonReconstruction::perform(const std::vector<Base::Vector3f>& normals)
         poisson.setSolverDivide(solverDivide);
     if (samplesPerNode >= 1.0f)
         poisson.setSamplesPerNode(samplesPerNode);
+#if PCL_VERSION_COMPARE(>=,1,8,0)
+    poisson.setThreads(threads >= 1 ? threads : Base::ThreadPool::instance().threadCount());
+#endif
 
     // Reconstruct
+    seq.next(true);
     PolygonMesh mesh;
     poisson.reconstruct (mesh);
 
+    seq.next(true);
     MeshConversion::convert(mesh, myMesh);
 }
 
@@ -312,6 +332,9 @@ GridReconstruction::GridReconstruction(const Points::PointKernel& pts, Mesh::Mes
 
 void GridReconstruction::perform(int ksearch)
 {
+    // PCL can't be interrupted, so the user can only cancel between the stages
+    Base::SequencerLauncher seq("Grid reconstruction...", 3);
+
     PointCloud<PointXYZ>::Ptr cloud (new PointCloud<PointXYZ>);
     PointCloud<PointNormal>::Ptr cloud_with_normals (new PointCloud<PointNormal>);
     search::KdTree<PointXYZ>::Ptr tree;
@@ -328,13 +351,14 @@ void GridReconstruction::perform(int ksearch)
     tree->setInputCloud (cloud);
 
     // Normal estimation
-    NormalEstimation<PointXYZ, Normal> n;
+    NormalEstimationOMP<PointXYZ, Normal> n (Base::ThreadPool::instance().threadCount());
     PointCloud<Normal>::Ptr normals (new PointCloud<Normal> ());
     n.setInputCloud (cloud);
     //n.setIndices (indices[B);
     n.setSearchMethod (tree);
     n.setKSearch (ksearch);
     n.compute (*normals);
+    seq.next(true);
 
     // Concatenate XYZ and normal information
     pcl::concatenateFields (*cloud, *normals, *cloud_with_normals);
@@ -355,9 +379,11 @@ void GridReconstruction::perform(int ksearch)
     grid.setSearchMethod (tree2);
 
     // Reconstruct
+    seq.next(true);
     PolygonMesh mesh;
     grid.reconstruct (mesh);
 
+    seq.next(true);
     MeshConversion::convert(mesh, myMesh);
 }
 
@@ -366,6 +392,8 @@ void GridReconstruction::perform(const std::vector<Base::Vector3f>& normals)
     if (myPoints.size() != normals.size())
         throw Base::RuntimeError("Number of points doesn't match with number of normals");
 
+    Base::SequencerLauncher seq("Grid reconstruction...", 2);
+
     PointCloud<PointNormal>::Ptr cloud_with_normals (new PointCloud<PointNormal>);
     search::KdTree<PointNormal>::Ptr tree;
 
@@ -403,9 +431,11 @@ void GridReconstruction::perform(const std::vector<Base::Vector3f>& normals)
     grid.setSearchMethod (tree);
 
     // Reconstruct
+    seq.next(true);
     PolygonMesh mesh;
     grid.reconstruct (mesh);
 
+    seq.next(true);
     MeshConversion::convert(mesh, myMesh);
 }
 
@@ -514,7 +544,7 @@ void Reen::MarchingCubesRBF::perform(int ksearch)
     tree->setInputCloud (cloud);
 
     // Normal estimation
-    NormalEstimation<PointXYZ, Normal> n;
+    NormalEstimationOMP<PointXYZ, Normal> n (Base::ThreadPool::instance().threadCount());
     PointCloud<Normal>::Ptr normals (new PointCloud<Normal> ());
     n.setInputCloud (cloud);
     //n.setIndices (indices[B);
@@ -624,7 +654,7 @@ void Reen::MarchingCubesHoppe::perform(int ksearch)
     tree->setInputCloud (cloud);
 
     // Normal estimation
-    NormalEstimation<PointXYZ, Normal> n;
+    NormalEstimationOMP<PointXYZ, Normal> n (Base::ThreadPool::instance().threadCount());
     PointCloud<Normal>::Ptr normals (new PointCloud<Normal> ());
     n.setInputCloud (cloud);
     //n.setIndices (indices[B);
@@ -712,50 +742,51 @@ void MeshConversion::convert(const pcl::PolygonMesh& pclMesh, Mesh::MeshObject&
 {
     // number of points
     size_t nr_points  = pclMesh.cloud.width * pclMesh.cloud.height;
-    size_t point_size = pclMesh.cloud.data.size () / nr_points;
+    size_t point_size = nr_points > 0 ? pclMesh.cloud.data.size () / nr_points : 0;
     // number of faces for header
     size_t nr_faces = pclMesh.polygons.size ();
 
-    MeshCore::MeshPointArray points;
-    points.reserve(nr_points);
-    MeshCore::MeshFacetArray facets;
-    facets.reserve(nr_faces);
-
-    // get vertices
-    MeshCore::MeshPoint vertex;
-    for (size_t i = 0; i < nr_points; ++i) {
-        int xyz = 0;
-        for (size_t d = 0; d < pclMesh.cloud.fields.size(); ++d) {
-            int c = 0;
-            // adding vertex
-            if ((pclMesh.cloud.fields[d].datatype ==
+    // look up the offsets of the coordinates once instead of for every point
+    int offsets[3] = {-1, -1, -1};
+    int xyz = 0;
+    for (size_t d = 0; d < pclMesh.cloud.fields.size() && xyz < 3; ++d) {
+        if ((pclMesh.cloud.fields[d].datatype ==
 #if PCL_VERSION_COMPARE(>,1,6,0)
-                 pcl::PCLPointField::FLOAT32) &&
+             pcl::PCLPointField::FLOAT32) &&
 #else
-                 sensor_msgs::PointField::FLOAT32) &&
+             sensor_msgs::PointField::FLOAT32) &&
 #endif
-                (pclMesh.cloud.fields[d].name == "x" ||
-                 pclMesh.cloud.fields[d].name == "y" ||
-                 pclMesh.cloud.fields[d].name == "z"))
-            {
-                float value;
-                memcpy (&value, &pclMesh.cloud.data[i * point_size + pclMesh.cloud.fields[d].offset + c * sizeof (float)], sizeof (float));
-                vertex[xyz] = value;
-                if (++xyz == 3) {
-                    points.push_back(vertex);
-                    break;
-                }
-            }
+            (pclMesh.cloud.fields[d].name == "x" ||
+             pclMesh.cloud.fields[d].name == "y" ||
+             pclMesh.cloud.fields[d].name == "z"))
+        {
+            offsets[xyz++] = pclMesh.cloud.fields[d].offset;
         }
     }
+    if (xyz < 3)
+        nr_points = 0;
+
+    MeshCore::MeshPointArray points(nr_points);
+    MeshCore::MeshFacetArray facets(nr_faces);
+
+    // get vertices
+    const uint8_t* data = pclMesh.cloud.data.data();
+    Base::parallel_for(size_t(0), nr_points, [&](size_t i) {
+        const uint8_t* point = data + i * point_size;
+        MeshCore::MeshPoint& vertex = points[i];
+        for (int c = 0; c < 3; ++c) {
+            float value;
+            memcpy (&value, point + offsets[c], sizeof (float));
+            vertex[c] = value;
+        }
+    });
     // get faces
-    MeshCore::MeshFacet face;
-    for (size_t i = 0; i < nr_faces; i++) {
+    Base::parallel_for(size_t(0), nr_faces, [&](size_t i) {
+        MeshCore::MeshFacet& face = facets[i];
         face._aulPoints[0] = pclMesh.polygons[i].vertices[0];
         face._aulPoints[1] = pclMesh.polygons[i].vertices[1];
         face._aulPoints[2] = pclMesh.polygons[i].vertices[2];
-        facets.push_back(face);
-    }
+    });
 
     MeshCore::MeshKernel kernel;
     kernel.Adopt(points, facets, true);
@@ -113,12 +113,21 @@ public:
     inline void
     setSamplesPerNode(float samplesPerNode) { this->samplesPerNode = samplesPerNode; }
 
+    /** \brief Set the number of threads used by the solver.
+      * \note A value less than 1 uses as many threads as the application thread pool. The value is
+      * ignored with PCL versions before 1.8 that solve on a single thread.
+      * \param[in] threads the number of threads
+      */
+    inline void
+    setThreads(int threads) { this->threads = threads; }
+
 private:
     const Points::PointKernel& myPoints;
     Mesh::MeshObject& myMesh;
     int depth;
     int solverDivide;
     float samplesPerNode;
+    int threads;
 };
 
 class GridReconstruction
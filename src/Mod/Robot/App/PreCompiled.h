@@ -51,6 +51,11 @@
 #include <vector>
 #include <set>
 #include <bitset>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <thread>
 
 #include <Python.h>
 
@@ -24,6 +24,10 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
+# include <future>
+# include <thread>
 #endif
 
 #include <Base/Writer.h>
@@ -38,6 +42,7 @@
 #include "kdl_cp/chainjnttojacsolver.hpp"
 #include "kdl_cp/chainiksolverpos_nr.hpp"
 #include "kdl_cp/chainiksolverpos_nr_jl.hpp"
+#include <Eigen/SVD>
 
 #include "Robot6Axis.h"
 #include "RobotAlgos.h"
@@ -250,6 +255,86 @@ bool Robot6Axis::setTo(const Placement &To)
     }
 }
 
+namespace {
+/// the KDL solvers keep state, every thread needs its own set
+struct IkSolvers {
+    ChainFkSolverPos_recursive fksolver;
+    ChainIkSolverVel_pinv iksolverv;
+    ChainIkSolverPos_NR_JL iksolver;
+    ChainJntToJacSolver jacsolver;
+
+    IkSolvers(const Chain &Kinematic, const JntArray &Min, const JntArray &Max)
+        : fksolver(Kinematic)
+        , iksolverv(Kinematic)
+        , iksolver(Kinematic,Min,Max,fksolver,iksolverv,100,1e-6) //Maximum 100 iterations, stop at accuracy 1e-6
+        , jacsolver(Kinematic)
+    {}
+};
+
+/// solve one pose starting at q, on success q is set to the solution
+void solvePose(IkSolvers &solvers, const Placement &To, JntArray &q,
+               const JntArray &Min, const JntArray &Max, const double RotDir[6], IkSolution &solution)
+{
+    Frame F_dest = Frame(KDL::Rotation::Quaternion(To.getRotation()[0],To.getRotation()[1],To.getRotation()[2],To.getRotation()[3]),KDL::Vector(To.getPosition()[0],To.getPosition()[1],To.getPosition()[2]));
+    JntArray result(q.rows());
+    solution.Reached = solvers.iksolver.CartToJnt(q,F_dest,result) >= 0;
+    if (solution.Reached)
+        q = result;
+
+    solution.AtLimit = false;
+    for (int i=0; i<6; i++) {
+        solution.Axis[i] = RotDir[i] * (q(i)/(M_PI/180)); // radian to degree
+        if (q(i) <= Min(i) + 1e-6 || q(i) >= Max(i) - 1e-6)
+            solution.AtLimit = true;
+    }
+
+    // a vanishing singular value of the Jacobian means a lost degree of freedom
+    Jacobian jac(q.rows());
+    solvers.jacsolver.JntToJac(q,jac);
+    Eigen::JacobiSVD<Eigen::Matrix<double,6,Eigen::Dynamic> > svd(jac.data);
+    const Eigen::VectorXd &sv = svd.singularValues();
+    solution.Singular = sv(0) <= 0.0 || sv(sv.size()-1) / sv(0) < 1e-4;
+}
+}
+
+std::vector<IkSolution> Robot6Axis::solvePoses(const std::vector<Placement> &Poses) const
+{
+    // every run starts at the solution of a coarse serial pass over its first pose
+    const std::size_t RunLength = 16;
+    std::size_t n = Poses.size();
+    std::vector<IkSolution> result(n);
+    std::vector<JntArray> starts;
+    {
+        IkSolvers solvers(Kinematic,Min,Max);
+        JntArray q = Actuall;
+        for (std::size_t i=0; i<n; i+=RunLength) {
+            solvePose(solvers,Poses[i],q,Min,Max,RotDir,result[i]);
+            starts.push_back(q);
+        }
+    }
+
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        IkSolvers solvers(Kinematic,Min,Max);
+        for (std::size_t run; (run = next++) < starts.size();) {
+            JntArray q = starts[run];
+            std::size_t end = std::min(n, (run+1)*RunLength);
+            for (std::size_t i=run*RunLength+1; i<end; i++)
+                solvePose(solvers,Poses[i],q,Min,Max,RotDir,result[i]);
+        }
+    };
+    std::size_t nthreads = std::min<std::size_t>(
+        std::max(1u, std::thread::hardware_concurrency()), starts.size());
+    std::vector<std::future<void> > futures;
+    for (std::size_t t=1; t < nthreads; t++)
+        futures.push_back(std::async(std::launch::async, worker));
+    worker();
+    for (auto &fut : futures)
+        fut.get();
+
+    return result;
+}
+
 Base::Placement Robot6Axis::getTcp(void)
 {
     double x,y,z,w;
@@ -30,6 +30,8 @@
 #include <Base/Persistence.h>
 #include <Base/Placement.h>
 
+#include <vector>
+
 namespace Robot
 {
 
@@ -45,6 +47,14 @@ struct AxisDefinition {
     double velocity; // max vlocity of the axle in °/s
 };
 
+/// Result of solving one pose of a batch
+struct IkSolution {
+    double Axis[6];  // axis values in degrees
+    bool Reached;    // the inverse kinematics converged, else Axis holds the start values
+    bool AtLimit;    // at least one axis is at its soft end
+    bool Singular;   // the pose is at or close to a singularity
+};
+
 
 /** The representation for a 6-Axis industry grade robot
  */
@@ -76,6 +86,10 @@ public:
 	/// calculate the new Tcp out of the Axis
 	bool calcTcp(void);
 	Base::Placement getTcp(void);
+    /** solve a sequence of Tcp poses, each one starting at the axes of the previous one.
+     *  The sequence is cut into runs which are solved in parallel. The robot is not moved.
+     */
+    std::vector<IkSolution> solvePoses(const std::vector<Base::Placement> &Poses) const;
 
     //void setKinematik(const std::vector<std::vector<float> > &KinTable);
 
@@ -76,6 +76,43 @@ PyObject* Robot6AxisPy::check(PyObject * /*args*/)
     return 0;
 }
 
+PyObject* Robot6AxisPy::solvePoses(PyObject * args)
+{
+    PyObject *obj;
+    if (!PyArg_ParseTuple(args, "O", &obj))
+        return 0;
+
+    std::vector<Base::Placement> poses;
+    try {
+        Py::Sequence list(obj);
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+            if (!PyObject_TypeCheck((*it).ptr(), &(Base::PlacementPy::Type))) {
+                PyErr_SetString(PyExc_TypeError, "expected a list of Placements");
+                return 0;
+            }
+            poses.push_back(*static_cast<Base::PlacementPy*>((*it).ptr())->getPlacementPtr());
+        }
+    }
+    catch (Py::Exception&) {
+        return 0;
+    }
+
+    std::vector<IkSolution> solutions = getRobot6AxisPtr()->solvePoses(poses);
+    Py::List result;
+    for (const IkSolution &sol : solutions) {
+        Py::Tuple axes(6);
+        for (int i=0; i<6; i++)
+            axes.setItem(i, Py::Float(sol.Axis[i]));
+        Py::Tuple item(4);
+        item.setItem(0, axes);
+        item.setItem(1, Py::Boolean(sol.Reached));
+        item.setItem(2, Py::Boolean(sol.AtLimit));
+        item.setItem(3, Py::Boolean(sol.Singular));
+        result.append(item);
+    }
+    return Py::new_reference_to(result);
+}
+
 
 
 Py::Float Robot6AxisPy::getAxis1(void) const
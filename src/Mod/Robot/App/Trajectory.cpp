@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 # include <memory>
+# include <cmath>
 #endif
 
 #include <Base/Writer.h>
@@ -127,6 +128,23 @@ Placement Trajectory::getPosition(double time)const
         return Placement();
 }
 
+std::vector<Placement> Trajectory::getPositions(double step)const
+{
+    // the composite caches the segment of the last lookup, so this stays serial
+    std::vector<Placement> result;
+    if (!pcTrajectory || step <= 0)
+        return result;
+    double duration = pcTrajectory->Duration();
+    std::size_t count = static_cast<std::size_t>(std::floor(duration / step)) + 1;
+    result.reserve(count + 1);
+    for (std::size_t i=0; i<count; i++)
+        result.push_back(toPlacement(pcTrajectory->Pos(i * step)));
+    // always end at the last waypoint
+    if ((count - 1) * step < duration)
+        result.push_back(toPlacement(pcTrajectory->Pos(duration)));
+    return result;
+}
+
 double Trajectory::getVelocity(double time)const
 {
     if(pcTrajectory){
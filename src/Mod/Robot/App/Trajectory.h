@@ -72,6 +72,8 @@ public:
     /// return the duration (s) of the Trajectory if -1 or of the Waypoint with the given number
     double getDuration (int n=-1) const;
     Base::Placement getPosition(double time)const;
+    /// return the positions at every step (s) from the start to the end of the Trajectory
+    std::vector<Base::Placement> getPositions(double step)const;
     double getVelocity(double time)const;
 
 
@@ -124,6 +124,23 @@ PyObject* TrajectoryPy::position(PyObject * args)
     return (new Base::PlacementPy(new Base::Placement(getTrajectoryPtr()->getPosition(pos))));
 }
 
+PyObject* TrajectoryPy::positions(PyObject * args)
+{
+    double step;
+    if (!PyArg_ParseTuple(args, "d", &step))
+        return NULL;
+    if (step <= 0) {
+        PyErr_SetString(PyExc_ValueError, "step must be positive");
+        return NULL;
+    }
+
+    std::vector<Base::Placement> positions = getTrajectoryPtr()->getPositions(step);
+    Py::List list;
+    for (const Base::Placement &pos : positions)
+        list.append(Py::asObject(new Base::PlacementPy(new Base::Placement(pos))));
+    return Py::new_reference_to(list);
+}
+
 PyObject* TrajectoryPy::velocity(PyObject * args)
 {
     double pos;
@@ -102,14 +102,11 @@ void Sketch::clear(void)
     BSplines.clear();
     resolveAfterGeometryUpdated = false;
 
-    // deleting the doubles allocated with new
-    for (std::vector<double*>::iterator it = Parameters.begin(); it != Parameters.end(); ++it)
-        if (*it) delete *it;
+    // releasing the doubles allocated in the parameter storage
     Parameters.clear();
     DrivenParameters.clear();
-    for (std::vector<double*>::iterator it = FixParameters.begin(); it != FixParameters.end(); ++it)
-        if (*it) delete *it;
     FixParameters.clear();
+    ParameterStorage.reset();
 
     param2geoelement.clear();
     pDependencyGroups.clear();
@@ -671,8 +668,8 @@ int Sketch::addPoint(const Part::GeomPoint &point, bool fixed)
     def.type = Point;
 
     // set the parameter for the solver
-    params.push_back(new double(p->getPoint().x));
-    params.push_back(new double(p->getPoint().y));
+    params.push_back(ParameterStorage.create(p->getPoint().x));
+    params.push_back(ParameterStorage.create(p->getPoint().y));
 
     // set the points for later constraints
     GCS::Point p1;
@@ -719,13 +716,13 @@ int Sketch::addLineSegment(const Part::GeomLineSegment &lineSegment, bool fixed)
     // the points for later constraints
     GCS::Point p1, p2;
 
-    params.push_back(new double(start.x));
-    params.push_back(new double(start.y));
+    params.push_back(ParameterStorage.create(start.x));
+    params.push_back(ParameterStorage.create(start.y));
     p1.x = params[params.size()-2];
     p1.y = params[params.size()-1];
 
-    params.push_back(new double(end.x));
-    params.push_back(new double(end.y));
+    params.push_back(ParameterStorage.create(end.x));
+    params.push_back(ParameterStorage.create(end.y));
     p2.x = params[params.size()-2];
     p2.y = params[params.size()-1];
 
@@ -776,18 +773,18 @@ int Sketch::addArc(const Part::GeomArcOfCircle &circleSegment, bool fixed)
 
     GCS::Point p1, p2, p3;
 
-    params.push_back(new double(startPnt.x));
-    params.push_back(new double(startPnt.y));
+    params.push_back(ParameterStorage.create(startPnt.x));
+    params.push_back(ParameterStorage.create(startPnt.y));
     p1.x = params[params.size()-2];
     p1.y = params[params.size()-1];
 
-    params.push_back(new double(endPnt.x));
-    params.push_back(new double(endPnt.y));
+    params.push_back(ParameterStorage.create(endPnt.x));
+    params.push_back(ParameterStorage.create(endPnt.y));
     p2.x = params[params.size()-2];
     p2.y = params[params.size()-1];
 
-    params.push_back(new double(center.x));
-    params.push_back(new double(center.y));
+    params.push_back(ParameterStorage.create(center.x));
+    params.push_back(ParameterStorage.create(center.y));
     p3.x = params[params.size()-2];
     p3.y = params[params.size()-1];
 
@@ -798,11 +795,11 @@ int Sketch::addArc(const Part::GeomArcOfCircle &circleSegment, bool fixed)
     def.midPointId = Points.size();
     Points.push_back(p3);
 
-    params.push_back(new double(radius));
+    params.push_back(ParameterStorage.create(radius));
     double *r = params[params.size()-1];
-    params.push_back(new double(startAngle));
+    params.push_back(ParameterStorage.create(startAngle));
     double *a1 = params[params.size()-1];
-    params.push_back(new double(endAngle));
+    params.push_back(ParameterStorage.create(endAngle));
     double *a2 = params[params.size()-1];
 
     // set the arc for later constraints
@@ -866,23 +863,23 @@ int Sketch::addArcOfEllipse(const Part::GeomArcOfEllipse &ellipseSegment, bool f
 
     GCS::Point p1, p2, p3;
 
-    params.push_back(new double(startPnt.x));
-    params.push_back(new double(startPnt.y));
+    params.push_back(ParameterStorage.create(startPnt.x));
+    params.push_back(ParameterStorage.create(startPnt.y));
     p1.x = params[params.size()-2];
     p1.y = params[params.size()-1];
 
-    params.push_back(new double(endPnt.x));
-    params.push_back(new double(endPnt.y));
+    params.push_back(ParameterStorage.create(endPnt.x));
+    params.push_back(ParameterStorage.create(endPnt.y));
     p2.x = params[params.size()-2];
     p2.y = params[params.size()-1];
 
-    params.push_back(new double(center.x));
-    params.push_back(new double(center.y));
+    params.push_back(ParameterStorage.create(center.x));
+    params.push_back(ParameterStorage.create(center.y));
     p3.x = params[params.size()-2];
     p3.y = params[params.size()-1];
 
-    params.push_back(new double(focus1.x));
-    params.push_back(new double(focus1.y));
+    params.push_back(ParameterStorage.create(focus1.x));
+    params.push_back(ParameterStorage.create(focus1.y));
     double *f1X = params[params.size()-2];
     double *f1Y = params[params.size()-1];
 
@@ -896,11 +893,11 @@ int Sketch::addArcOfEllipse(const Part::GeomArcOfEllipse &ellipseSegment, bool f
     //Points.push_back(f1);
 
     // add the radius parameters
-    params.push_back(new double(radmin));
+    params.push_back(ParameterStorage.create(radmin));
     double *rmin = params[params.size()-1];
-    params.push_back(new double(startAngle));
+    params.push_back(ParameterStorage.create(startAngle));
     double *a1 = params[params.size()-1];
-    params.push_back(new double(endAngle));
+    params.push_back(ParameterStorage.create(endAngle));
     double *a2 = params[params.size()-1];
 
     // set the arc for later constraints
@@ -968,23 +965,23 @@ int Sketch::addArcOfHyperbola(const Part::GeomArcOfHyperbola &hyperbolaSegment,
 
     GCS::Point p1, p2, p3;
 
-    params.push_back(new double(startPnt.x));
-    params.push_back(new double(startPnt.y));
+    params.push_back(ParameterStorage.create(startPnt.x));
+    params.push_back(ParameterStorage.create(startPnt.y));
     p1.x = params[params.size()-2];
     p1.y = params[params.size()-1];
 
-    params.push_back(new double(endPnt.x));
-    params.push_back(new double(endPnt.y));
+    params.push_back(ParameterStorage.create(endPnt.x));
+    params.push_back(ParameterStorage.create(endPnt.y));
     p2.x = params[params.size()-2];
     p2.y = params[params.size()-1];
 
-    params.push_back(new double(center.x));
-    params.push_back(new double(center.y));
+    params.push_back(ParameterStorage.create(center.x));
+    params.push_back(ParameterStorage.create(center.y));
     p3.x = params[params.size()-2];
     p3.y = params[params.size()-1];
 
-    params.push_back(new double(focus1.x));
-    params.push_back(new double(focus1.y));
+    params.push_back(ParameterStorage.create(focus1.x));
+    params.push_back(ParameterStorage.create(focus1.y));
     double *f1X = params[params.size()-2];
     double *f1Y = params[params.size()-1];
 
@@ -996,11 +993,11 @@ int Sketch::addArcOfHyperbola(const Part::GeomArcOfHyperbola &hyperbolaSegment,
     Points.push_back(p3);
 
     // add the radius parameters
-    params.push_back(new double(radmin));
+    params.push_back(ParameterStorage.create(radmin));
     double *rmin = params[params.size()-1];
-    params.push_back(new double(startAngle));
+    params.push_back(ParameterStorage.create(startAngle));
     double *a1 = params[params.size()-1];
-    params.push_back(new double(endAngle));
+    params.push_back(ParameterStorage.create(endAngle));
     double *a2 = params[params.size()-1];
 
     // set the arc for later constraints
@@ -1063,23 +1060,23 @@ int Sketch::addArcOfParabola(const Part::GeomArcOfParabola &parabolaSegment, boo
 
     GCS::Point p1, p2, p3, p4;
 
-    params.push_back(new double(startPnt.x));
-    params.push_back(new double(startPnt.y));
+    params.push_back(ParameterStorage.create(startPnt.x));
+    params.push_back(ParameterStorage.create(startPnt.y));
     p1.x = params[params.size()-2];
     p1.y = params[params.size()-1];
 
-    params.push_back(new double(endPnt.x));
-    params.push_back(new double(endPnt.y));
+    params.push_back(ParameterStorage.create(endPnt.x));
+    params.push_back(ParameterStorage.create(endPnt.y));
     p2.x = params[params.size()-2];
     p2.y = params[params.size()-1];
 
-    params.push_back(new double(vertex.x));
-    params.push_back(new double(vertex.y));
+    params.push_back(ParameterStorage.create(vertex.x));
+    params.push_back(ParameterStorage.create(vertex.y));
     p3.x = params[params.size()-2];
     p3.y = params[params.size()-1];
 
-    params.push_back(new double(focus.x));
-    params.push_back(new double(focus.y));
+    params.push_back(ParameterStorage.create(focus.x));
+    params.push_back(ParameterStorage.create(focus.y));
     p4.x = params[params.size()-2];
     p4.y = params[params.size()-1];
 
@@ -1091,9 +1088,9 @@ int Sketch::addArcOfParabola(const Part::GeomArcOfParabola &parabolaSegment, boo
     Points.push_back(p3);
 
     // add the radius parameters
-    params.push_back(new double(startAngle));
+    params.push_back(ParameterStorage.create(startAngle));
     double *a1 = params[params.size()-1];
-    params.push_back(new double(endAngle));
+    params.push_back(ParameterStorage.create(endAngle));
     double *a2 = params[params.size()-1];
 
     // set the arc for later constraints
@@ -1181,8 +1178,8 @@ int Sketch::addBSpline(const Part::GeomBSplineCurve &bspline, bool fixed)
     std::vector<GCS::Point> spoles;
 
     for(std::vector<Base::Vector3d>::const_iterator it = poles.begin(); it != poles.end(); ++it){
-        params.push_back(new double( (*it).x ));
-        params.push_back(new double( (*it).y ));
+        params.push_back(ParameterStorage.create( (*it).x ));
+        params.push_back(ParameterStorage.create( (*it).y ));
 
         GCS::Point p;
         p.x = params[params.size()-2];
@@ -1199,7 +1196,7 @@ int Sketch::addBSpline(const Part::GeomBSplineCurve &bspline, bool fixed)
     std::vector<double *> sweights;
 
     for(std::vector<double>::const_iterator it = weights.begin(); it != weights.end(); ++it) {
-        auto r = new double( (*it) );
+        auto r = ParameterStorage.create( (*it) );
         params.push_back(r);
         sweights.push_back(params[params.size()-1]);
 
@@ -1211,15 +1208,15 @@ int Sketch::addBSpline(const Part::GeomBSplineCurve &bspline, bool fixed)
     std::vector<double *> sknots;
 
     for(std::vector<double>::const_iterator it = knots.begin(); it != knots.end(); ++it) {
-        double * knot = new double( (*it) );
+        double * knot = ParameterStorage.create( (*it) );
         //params.push_back(knot);
         sknots.push_back(knot);
     }
 
     GCS::Point p1, p2;
 
-    double * p1x = new double(startPnt.x);
-    double * p1y = new double(startPnt.y);
+    double * p1x = ParameterStorage.create(startPnt.x);
+    double * p1y = ParameterStorage.create(startPnt.y);
 
     // if periodic, startpoint and endpoint do not play a role in the solver, this removes unnecessary DoF of determining where in the curve
     // the start and the stop should be
@@ -1231,8 +1228,8 @@ int Sketch::addBSpline(const Part::GeomBSplineCurve &bspline, bool fixed)
     p1.x = p1x;
     p1.y = p1y;
 
-    double * p2x = new double(endPnt.x);
-    double * p2y = new double(endPnt.y);
+    double * p2x = ParameterStorage.create(endPnt.x);
+    double * p2y = ParameterStorage.create(endPnt.y);
 
     // if periodic, startpoint and endpoint do not play a role in the solver, this removes unnecessary DoF of determining where in the curve
     // the start and the stop should be
@@ -1312,12 +1309,12 @@ int Sketch::addCircle(const Part::GeomCircle &cir, bool fixed)
 
     GCS::Point p1;
 
-    params.push_back(new double(center.x));
-    params.push_back(new double(center.y));
+    params.push_back(ParameterStorage.create(center.x));
+    params.push_back(ParameterStorage.create(center.y));
     p1.x = params[params.size()-2];
     p1.y = params[params.size()-1];
 
-    params.push_back(new double(radius));
+    params.push_back(ParameterStorage.create(radius));
 
     def.midPointId = Points.size();
     Points.push_back(p1);
@@ -1369,21 +1366,21 @@ int Sketch::addEllipse(const Part::GeomEllipse &elip, bool fixed)
 
     GCS::Point c;
 
-    params.push_back(new double(center.x));
-    params.push_back(new double(center.y));
+    params.push_back(ParameterStorage.create(center.x));
+    params.push_back(ParameterStorage.create(center.y));
     c.x = params[params.size()-2];
     c.y = params[params.size()-1];
 
     def.midPointId = Points.size(); // this takes midPointId+1
     Points.push_back(c);
 
-    params.push_back(new double(focus1.x));
-    params.push_back(new double(focus1.y));
+    params.push_back(ParameterStorage.create(focus1.x));
+    params.push_back(ParameterStorage.create(focus1.y));
     double *f1X = params[params.size()-2];
     double *f1Y = params[params.size()-1];
 
     // add the radius parameters
-    params.push_back(new double(radmin));
+    params.push_back(ParameterStorage.create(radmin));
     double *rmin = params[params.size()-1];
 
     // set the ellipse for later constraints
@@ -1536,7 +1533,7 @@ int Sketch::addConstraint(const Constraint *constraint)
     switch (constraint->Type) {
     case DistanceX:
         if (constraint->FirstPos == none){ // horizontal length of a line
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1547,7 +1544,7 @@ int Sketch::addConstraint(const Constraint *constraint)
             rtn = addDistanceXConstraint(constraint->First,c.value,c.driving);
         }
         else if (constraint->Second == Constraint::GeoUndef) {// point on fixed x-coordinate
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1558,7 +1555,7 @@ int Sketch::addConstraint(const Constraint *constraint)
             rtn = addCoordinateXConstraint(constraint->First,constraint->FirstPos,c.value,c.driving);
         }
         else if (constraint->SecondPos != none) {// point to point horizontal distance
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1572,7 +1569,7 @@ int Sketch::addConstraint(const Constraint *constraint)
         break;
     case DistanceY:
         if (constraint->FirstPos == none){ // vertical length of a line
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1583,7 +1580,7 @@ int Sketch::addConstraint(const Constraint *constraint)
             rtn = addDistanceYConstraint(constraint->First,c.value,c.driving);
         }
         else if (constraint->Second == Constraint::GeoUndef){ // point on fixed y-coordinate
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1594,7 +1591,7 @@ int Sketch::addConstraint(const Constraint *constraint)
             rtn = addCoordinateYConstraint(constraint->First,constraint->FirstPos,c.value,c.driving);
         }
         else if (constraint->SecondPos != none){ // point to point vertical distance
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1637,7 +1634,7 @@ int Sketch::addConstraint(const Constraint *constraint)
             rtn = addPerpendicularConstraint(constraint->First,constraint->Second);
         } else {
             //any other point-wise perpendicularity
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1660,7 +1657,7 @@ int Sketch::addConstraint(const Constraint *constraint)
             rtn = addTangentConstraint(constraint->First,constraint->Second);
         } else {
             //any other point-wise tangency (endpoint-to-curve, endpoint-to-endpoint, tangent-via-point)
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1677,7 +1674,7 @@ int Sketch::addConstraint(const Constraint *constraint)
         break;
     case Distance:
         if (constraint->SecondPos != none){ // point to point distance
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1690,7 +1687,7 @@ int Sketch::addConstraint(const Constraint *constraint)
         }
         else if (constraint->Second != Constraint::GeoUndef) {
             if (constraint->FirstPos != none) { // point to line distance
-                c.value = new double(constraint->getValue());
+                c.value = ParameterStorage.create(constraint->getValue());
                 if(c.driving)
                     FixParameters.push_back(c.value);
                 else {
@@ -1702,7 +1699,7 @@ int Sketch::addConstraint(const Constraint *constraint)
             }
         }
         else {// line length
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1715,7 +1712,7 @@ int Sketch::addConstraint(const Constraint *constraint)
         break;
     case Angle:
         if (constraint->Third != Constraint::GeoUndef){
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1729,7 +1726,7 @@ int Sketch::addConstraint(const Constraint *constraint)
                         constraint->Third, constraint->ThirdPos,
                         c.value, constraint->Type,c.driving);
         } else if (constraint->SecondPos != none){ // angle between two lines (with explicit start points)
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1741,7 +1738,7 @@ int Sketch::addConstraint(const Constraint *constraint)
                                      constraint->Second,constraint->SecondPos,c.value,c.driving);
         }
         else if (constraint->Second != Constraint::GeoUndef){ // angle between two lines
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1752,7 +1749,7 @@ int Sketch::addConstraint(const Constraint *constraint)
             rtn = addAngleConstraint(constraint->First,constraint->Second,c.value,c.driving);
         }
         else if (constraint->First != Constraint::GeoUndef) {// orientation angle of a line
-            c.value = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
             if(c.driving)
                 FixParameters.push_back(c.value);
             else {
@@ -1765,7 +1762,7 @@ int Sketch::addConstraint(const Constraint *constraint)
         break;
     case Radius:
     {
-        c.value = new double(constraint->getValue());
+        c.value = ParameterStorage.create(constraint->getValue());
         if(c.driving)
             FixParameters.push_back(c.value);
         else {
@@ -1778,7 +1775,7 @@ int Sketch::addConstraint(const Constraint *constraint)
     }
     case Diameter:
     {
-        c.value = new double(constraint->getValue());
+        c.value = ParameterStorage.create(constraint->getValue());
         if(c.driving)
             FixParameters.push_back(c.value);
         else {
@@ -1791,7 +1788,7 @@ int Sketch::addConstraint(const Constraint *constraint)
     }
     case Weight:
     {
-        c.value = new double(constraint->getValue());
+        c.value = ParameterStorage.create(constraint->getValue());
         if(c.driving)
             FixParameters.push_back(c.value);
         else {
@@ -1852,8 +1849,8 @@ int Sketch::addConstraint(const Constraint *constraint)
         break;
     case SnellsLaw:
         {
-            c.value = new double(constraint->getValue());
-            c.secondvalue = new double(constraint->getValue());
+            c.value = ParameterStorage.create(constraint->getValue());
+            c.secondvalue = ParameterStorage.create(constraint->getValue());
 
             if(c.driving) {
                 FixParameters.push_back(c.value);
@@ -3565,7 +3562,10 @@ int Sketch::internalSolve(std::string & solvername, int level)
 
     if(isInitMove){
         solvername = "DogLeg"; // DogLeg is used for dragging (same as before)
+        // only the dragged cluster is solved, warm started from the previous mouse event
+        GCSsys.setDragMode(true);
         ret = GCSsys.solve(isFine, GCS::DogLeg);
+        GCSsys.setDragMode(false);
     }
     else{
         switch (defaultSolver) {
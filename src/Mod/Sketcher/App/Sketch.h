@@ -443,9 +443,10 @@ protected:
     std::map<double *, std::pair<int,Sketcher::PointPos>> param2geoelement;
 
     // solving parameters
-    std::vector<double*> Parameters;    // with memory allocation
-    std::vector<double*> DrivenParameters;    // with memory allocation
-    std::vector<double*> FixParameters; // with memory allocation
+    GCS::ParameterArena ParameterStorage; // owns the memory of all solver parameters
+    std::vector<double*> Parameters;    // allocated in ParameterStorage
+    std::vector<double*> DrivenParameters;    // allocated in ParameterStorage
+    std::vector<double*> FixParameters; // allocated in ParameterStorage
     std::vector<double> MoveParameters, InitParameters;
     std::vector<GCS::Point>  Points;
     std::vector<GCS::Line>   Lines;
@@ -477,6 +478,7 @@ public:
     inline void setQRAlgorithm(GCS::QRAlgorithm alg){GCSsys.qrAlgorithm=alg;}
     inline GCS::QRAlgorithm getQRAlgorithm(){return GCSsys.qrAlgorithm;}
     inline void setQRPivotThreshold(double val){GCSsys.qrpivotThreshold=val;}
+    inline void setReuseDiagnosis(bool reuse){GCSsys.reuseDiagnosis=reuse;}
     inline void setLM_eps(double val){GCSsys.LM_eps=val;}
     inline void setLM_eps1(double val){GCSsys.LM_eps1=val;}
     inline void setLM_tau(double val){GCSsys.LM_tau=val;}
@@ -38,8 +38,12 @@
 # include <TopoDS_Vertex.hxx>
 # include <algorithm>
 # include <cmath>
+# include <map>
+# include <unordered_map>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <Base/Console.h>
 #include <App/Document.h>
 
@@ -52,6 +56,70 @@
 
 using namespace Sketcher;
 
+namespace {
+
+// Cell of the uniform grid used to look up vertices lying within the tolerance
+struct GridCell {
+    long long x;
+    long long y;
+    bool operator==(const GridCell& other) const {
+        return x == other.x && y == other.y;
+    }
+};
+
+struct GridCellHash {
+    std::size_t operator()(const GridCell& c) const {
+        std::size_t seed = std::hash<long long>()(c.x);
+        seed ^= std::hash<long long>()(c.y) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+
+// Order independent key of the two elements referenced by a constraint
+typedef std::pair<long long, long long> ConstraintKey;
+
+ConstraintKey makeConstraintKey(int first, PointPos firstPos, int second, PointPos secondPos)
+{
+    long long a = static_cast<long long>(first) * 8 + firstPos;
+    long long b = static_cast<long long>(second) * 8 + secondPos;
+    return a < b ? ConstraintKey(a, b) : ConstraintKey(b, a);
+}
+
+// For every constraint accepted by 'accept' drop one candidate referencing the same
+// pair of elements. The candidates are indexed once instead of searched per constraint.
+template <typename Accept>
+void eraseExistingConstraints(std::vector<ConstraintIds>& candidates,
+                              const std::vector<Sketcher::Constraint*>& constraints,
+                              Accept accept)
+{
+    std::multimap<ConstraintKey, std::size_t> index;
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        const ConstraintIds& id = candidates[i];
+        index.emplace(makeConstraintKey(id.First, id.FirstPos, id.Second, id.SecondPos), i);
+    }
+
+    std::vector<bool> erased(candidates.size(), false);
+    for (auto constr : constraints) {
+        if (!accept(constr))
+            continue;
+        auto it = index.find(makeConstraintKey(constr->First, constr->FirstPos,
+                                               constr->Second, constr->SecondPos));
+        if (it != index.end()) {
+            erased[it->second] = true;
+            index.erase(it);
+        }
+    }
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        if (!erased[i])
+            candidates[kept++] = candidates[i];
+    }
+    candidates.resize(kept);
+}
+
+}
+
 SketchAnalysis::SketchAnalysis(Sketcher::SketchObject* Obj)
   : sketch(Obj)
 {
@@ -224,64 +292,87 @@ int SketchAnalysis::detectMissingPointOnPointConstraints(double precision, bool
         }
     }
 
-    std::sort(vertexIds.begin(), vertexIds.end(), Vertex_Less(precision));
-    std::vector<VertexIds>::iterator vt = vertexIds.begin();
+    // A tolerant comparison is not a strict weak ordering, so sort exactly to get a
+    // deterministic order and leave the tolerance to the grid lookup below.
+    std::sort(vertexIds.begin(), vertexIds.end(), Vertex_Less(0.0));
     Vertex_EqualTo pred(precision);
 
-    std::list<ConstraintIds> coincidences;
-    // Make a list of constraint we expect for coincident vertexes
-    while (vt < vertexIds.end()) {
-        // get first item whose adjacent element has the same vertex coordinates
-        vt = std::adjacent_find(vt, vertexIds.end(), pred);
-        if (vt < vertexIds.end()) {
-            std::vector<VertexIds>::iterator vn;
-            for (vn = vt+1; vn != vertexIds.end(); ++vn) {
-                if (pred(*vt,*vn)) {
-                    ConstraintIds id;
-                    id.Type = Coincident; // default point on point restriction
-                    id.v = vt->v;
-                    id.First = vt->GeoId;
-                    id.FirstPos = vt->PosId;
-                    id.Second = vn->GeoId;
-                    id.SecondPos = vn->PosId;
-                    coincidences.push_back(id);
-                }
-                else {
-                    break;
+    // Bucket the vertexes into a grid whose cells are not smaller than the tolerance so
+    // that all the vertexes close to a given one are in the 3x3 cells around it.
+    double cellSize = std::max(precision, Precision::Confusion());
+    auto cellOf = [cellSize](const Base::Vector3d& v) {
+        GridCell cell;
+        cell.x = static_cast<long long>(std::floor(v.x / cellSize));
+        cell.y = static_cast<long long>(std::floor(v.y / cellSize));
+        return cell;
+    };
+
+    std::unordered_map<GridCell, std::vector<std::size_t>, GridCellHash> grid;
+    grid.reserve(vertexIds.size());
+    for (std::size_t i = 0; i < vertexIds.size(); i++)
+        grid[cellOf(vertexIds[i].v)].push_back(i);
+
+    // For each vertex collect the following vertexes that can be considered equal.
+    // The grid is only read here so the lookups run concurrently.
+    struct Neighbours {
+        std::size_t index;
+        std::vector<std::size_t> others;
+    };
+    std::vector<Neighbours> neighbours(vertexIds.size());
+    for (std::size_t i = 0; i < neighbours.size(); i++)
+        neighbours[i].index = i;
+
+    QtConcurrent::blockingMap(neighbours, [&](Neighbours& n) {
+        const VertexIds& vt = vertexIds[n.index];
+        GridCell cell = cellOf(vt.v);
+        for (long long dx = -1; dx <= 1; dx++) {
+            for (long long dy = -1; dy <= 1; dy++) {
+                auto it = grid.find(GridCell{cell.x + dx, cell.y + dy});
+                if (it == grid.end())
+                    continue;
+                for (std::size_t j : it->second) {
+                    if (j > n.index && pred(vt, vertexIds[j]))
+                        n.others.push_back(j);
                 }
             }
+        }
+        std::sort(n.others.begin(), n.others.end());
+    });
 
-            vt = vn;
+    std::vector<ConstraintIds> coincidences;
+    // Make a list of constraint we expect for coincident vertexes. Like before, the
+    // first vertex of a group is constrained to each of the others.
+    std::vector<bool> grouped(vertexIds.size(), false);
+    for (const Neighbours& n : neighbours) {
+        if (grouped[n.index])
+            continue;
+        const VertexIds& vt = vertexIds[n.index];
+        for (std::size_t j : n.others) {
+            if (grouped[j])
+                continue;
+            grouped[j] = true;
+            const VertexIds& vn = vertexIds[j];
+            ConstraintIds id;
+            id.Type = Coincident; // default point on point restriction
+            id.v = vt.v;
+            id.First = vt.GeoId;
+            id.FirstPos = vt.PosId;
+            id.Second = vn.GeoId;
+            id.SecondPos = vn.PosId;
+            coincidences.push_back(id);
         }
     }
 
     // Go through the available 'Coincident', 'Tangent' or 'Perpendicular' constraints
     // and check which of them is forcing two vertexes to be coincident.
     // If there is none but two vertexes can be considered equal a coincident constraint is missing.
-    std::vector<Sketcher::Constraint*> constraint = sketch->Constraints.getValues();
-    for (std::vector<Sketcher::Constraint*>::iterator it = constraint.begin(); it != constraint.end(); ++it) {
-        if ((*it)->Type == Sketcher::Coincident ||
-            (*it)->Type == Sketcher::Tangent ||
-            (*it)->Type == Sketcher::Perpendicular) {
-            ConstraintIds id;
-            id.First = (*it)->First;
-            id.FirstPos = (*it)->FirstPos;
-            id.Second = (*it)->Second;
-            id.SecondPos = (*it)->SecondPos;
-            std::list<ConstraintIds>::iterator pos = std::find_if
-                    (coincidences.begin(), coincidences.end(), Constraint_Equal(id));
-            if (pos != coincidences.end()) {
-                coincidences.erase(pos);
-            }
-        }
-    }
+    eraseExistingConstraints(coincidences, sketch->Constraints.getValues(), [](const Sketcher::Constraint* constr) {
+        return constr->Type == Sketcher::Coincident ||
+               constr->Type == Sketcher::Tangent ||
+               constr->Type == Sketcher::Perpendicular;
+    });
 
-    this->vertexConstraints.clear();
-    this->vertexConstraints.reserve(coincidences.size());
-
-    for (std::list<ConstraintIds>::iterator it = coincidences.begin(); it != coincidences.end(); ++it) {
-        this->vertexConstraints.push_back(*it);
-    }
+    this->vertexConstraints = std::move(coincidences);
 
     return this->vertexConstraints.size();
 }
@@ -511,11 +602,11 @@ int SketchAnalysis::detectMissingEqualityConstraints(double precision)
         }
     }
 
-    std::sort(lineedgeIds.begin(), lineedgeIds.end(), Edge_Less(precision));
+    std::sort(lineedgeIds.begin(), lineedgeIds.end(), Edge_Less(0.0));
     std::vector<EdgeIds>::iterator vt = lineedgeIds.begin();
     Edge_EqualTo pred(precision);
 
-    std::list<ConstraintIds> equallines;
+    std::vector<ConstraintIds> equallines;
     // Make a list of constraint we expect for coincident vertexes
     while (vt < lineedgeIds.end()) {
         // get first item whose adjacent element has the same vertex coordinates
@@ -542,10 +633,10 @@ int SketchAnalysis::detectMissingEqualityConstraints(double precision)
         }
     }
 
-    std::sort(radiusedgeIds.begin(), radiusedgeIds.end(), Edge_Less(precision));
+    std::sort(radiusedgeIds.begin(), radiusedgeIds.end(), Edge_Less(0.0));
     vt = radiusedgeIds.begin();
 
-    std::list<ConstraintIds> equalradius;
+    std::vector<ConstraintIds> equalradius;
     // Make a list of constraint we expect for coincident vertexes
     while (vt < radiusedgeIds.end()) {
         // get first item whose adjacent element has the same vertex coordinates
@@ -573,47 +664,16 @@ int SketchAnalysis::detectMissingEqualityConstraints(double precision)
     }
 
 
-    // Go through the available 'Coincident', 'Tangent' or 'Perpendicular' constraints
-    // and check which of them is forcing two vertexes to be coincident.
-    // If there is none but two vertexes can be considered equal a coincident constraint is missing.
-    std::vector<Sketcher::Constraint*> constraint = sketch->Constraints.getValues();
-    for (std::vector<Sketcher::Constraint*>::iterator it = constraint.begin(); it != constraint.end(); ++it) {
-        if ((*it)->Type == Sketcher::Equal) {
-            ConstraintIds id;
-            id.First = (*it)->First;
-            id.FirstPos = (*it)->FirstPos;
-            id.Second = (*it)->Second;
-            id.SecondPos = (*it)->SecondPos;
-
-            std::list<ConstraintIds>::iterator pos = std::find_if
-                (equallines.begin(), equallines.end(), Constraint_Equal(id));
-
-            if (pos != equallines.end()) {
-                equallines.erase(pos);
-            }
-
-            pos = std::find_if
-                (equalradius.begin(), equalradius.end(), Constraint_Equal(id));
+    // Go through the available 'Equal' constraints and drop the pairs they already cover.
+    const std::vector<Sketcher::Constraint*>& constraint = sketch->Constraints.getValues();
+    auto isEqual = [](const Sketcher::Constraint* constr) {
+        return constr->Type == Sketcher::Equal;
+    };
+    eraseExistingConstraints(equallines, constraint, isEqual);
+    eraseExistingConstraints(equalradius, constraint, isEqual);
 
-            if (pos != equalradius.end()) {
-                equalradius.erase(pos);
-            }
-        }
-    }
-
-    this->lineequalityConstraints.clear();
-    this->lineequalityConstraints.reserve(equallines.size());
-
-    for (std::list<ConstraintIds>::iterator it = equallines.begin(); it != equallines.end(); ++it) {
-        this->lineequalityConstraints.push_back(*it);
-    }
-
-    this->radiusequalityConstraints.clear();
-    this->radiusequalityConstraints.reserve(equalradius.size());
-
-    for (std::list<ConstraintIds>::iterator it = equalradius.begin(); it != equalradius.end(); ++it) {
-        this->radiusequalityConstraints.push_back(*it);
-    }
+    this->lineequalityConstraints = std::move(equallines);
+    this->radiusequalityConstraints = std::move(equalradius);
 
     return this->lineequalityConstraints.size() + this->radiusequalityConstraints.size();
 }
@@ -63,6 +63,10 @@
 //# include <QtGlobal>
 #endif
 
+#include <climits>
+#include <exception>
+#include <QtConcurrentMap>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/FeaturePythonPyImp.h>
@@ -152,6 +156,9 @@ SketchObject::SketchObject()
 
     internaltransaction=false;
     managedoperation=false;
+
+    batchLevel=0;
+    batchSeeded=false;
 }
 
 SketchObject::~SketchObject()
@@ -160,6 +167,12 @@ SketchObject::~SketchObject()
         if (*it) delete *it;
     ExternalGeo.clear();
 
+    // elements added by a batch edit that was never closed are not owned by the properties
+    for (auto geo : batchNewGeometry)
+        delete geo;
+    for (auto constr : batchNewConstraints)
+        delete constr;
+
     delete analyser;
 }
 
@@ -256,6 +269,10 @@ void SketchObject::retrieveSolverDiagnostics()
 
 int SketchObject::solve(bool updateGeoAfterSolving/*=true*/)
 {
+    // while a batch edit is open solving is deferred to closeBatchEdit()
+    if (batchLevel > 0)
+        return 0;
+
     Base::StateLocker lock(managedoperation, true); // no need to check input data validity as this is an sketchobject managed operation.
 
     // Reset the initial movement in case of a dragging operation was ongoing on the solver.
@@ -864,14 +881,92 @@ std::vector<Part::Geometry *> SketchObject::supportedGeometry(const std::vector<
     return supportedGeoList;
 }
 
+void SketchObject::openBatchEdit()
+{
+    ++batchLevel;
+}
+
+int SketchObject::closeBatchEdit()
+{
+    if (batchLevel == 0 || --batchLevel > 0)
+        return 0;
+
+    applyBatchEdit();
+
+    // rebuild the solver system and solve once for the whole batch
+    return solve();
+}
+
+SketchObject::BatchEdit::~BatchEdit()
+{
+    try {
+        obj->closeBatchEdit();
+    }
+    catch (const Base::Exception& e) {
+        Base::Console().Error("SketchObject::BatchEdit: %s\n", e.what());
+    }
+}
+
+void SketchObject::seedBatchEdit()
+{
+    if (batchSeeded)
+        return;
+
+    batchGeometry = Geometry.getValues();
+    batchConstraints = Constraints.getValuesForce();
+    batchSeeded = true;
+}
+
+void SketchObject::applyBatchEdit()
+{
+    if (!batchSeeded)
+        return;
+
+    Base::StateLocker lock(managedoperation, true); // no need to check input data validity as this is an sketchobject managed operation.
+
+    std::vector< Part::Geometry * > newVals;
+    std::vector< Constraint * > newConstraints;
+    newVals.swap(batchGeometry);
+    newConstraints.swap(batchConstraints);
+    batchNewGeometry.clear();
+    batchNewConstraints.clear();
+    batchSeeded = false;
+
+    // Block acceptGeometry in OnChanged to avoid unnecessary checks and updates
+    {
+        Base::StateLocker lock(internaltransaction, true);
+        this->Geometry.setValues(std::move(newVals));
+        this->Constraints.setValues(std::move(newConstraints));
+    }
+
+    // Update geometry indices and rebuild vertexindex now via onChanged, so that ViewProvider::UpdateData is triggered.
+    Geometry.touch();
+}
+
+void SketchObject::eraseBatchConstraint(std::size_t index)
+{
+    Constraint *constr = batchConstraints[index];
+    batchConstraints.erase(batchConstraints.begin() + index);
+
+    // constraints added during the batch are not owned by the property yet
+    if (batchNewConstraints.erase(constr))
+        delete constr;
+}
+
 int SketchObject::addGeometry(const std::vector<Part::Geometry *> &geoList, bool construction/*=false*/)
 {
     Base::StateLocker lock(managedoperation, true); // no need to check input data validity as this is an sketchobject managed operation.
 
-    const std::vector< Part::Geometry * > &vals = getInternalGeometry();
+    std::vector< Part::Geometry * > newVals;
+    if (batchLevel > 0) {
+        seedBatchEdit();
+        newVals.reserve(geoList.size());
+    }
+    else {
+        newVals = getInternalGeometry();
+        newVals.reserve(newVals.size() + geoList.size());
+    }
 
-    std::vector< Part::Geometry * > newVals(vals);
-    newVals.reserve(newVals.size() + geoList.size());
     for( auto & v : geoList) {
         Part::Geometry* copy = v->copy();
 
@@ -887,6 +982,12 @@ int SketchObject::addGeometry(const std::vector<Part::Geometry *> &geoList, bool
         newVals.push_back(copy);
     }
 
+    if (batchLevel > 0) {
+        batchGeometry.insert(batchGeometry.end(), newVals.begin(), newVals.end());
+        batchNewGeometry.insert(newVals.begin(), newVals.end());
+        return int(batchGeometry.size())-1;
+    }
+
     // On setting geometry the onChanged method will call acceptGeometry(), thereby updating constraint geometry indices and rebuilding the vertex index
     Geometry.setValues(std::move(newVals));
 
@@ -897,10 +998,6 @@ int SketchObject::addGeometry(const Part::Geometry *geo, bool construction/*=fal
 {
     Base::StateLocker lock(managedoperation, true); // no need to check input data validity as this is an sketchobject managed operation.
 
-    const std::vector< Part::Geometry * > &vals = getInternalGeometry();
-
-    std::vector< Part::Geometry * > newVals(vals);
-
     Part::Geometry *geoNew = geo->copy();
 
     if( geoNew->getTypeId() == Part::GeomPoint::getClassTypeId()) {
@@ -912,6 +1009,17 @@ int SketchObject::addGeometry(const Part::Geometry *geo, bool construction/*=fal
         GeometryFacade::setConstruction(geoNew, construction);
     }
 
+    if (batchLevel > 0) {
+        seedBatchEdit();
+        batchGeometry.push_back(geoNew);
+        batchNewGeometry.insert(geoNew);
+        return int(batchGeometry.size())-1;
+    }
+
+    const std::vector< Part::Geometry * > &vals = getInternalGeometry();
+
+    std::vector< Part::Geometry * > newVals(vals);
+
     newVals.push_back(geoNew);
 
     // On setting geometry the onChanged method will call acceptGeometry(), thereby updating constraint geometry indices and rebuilding the vertex index
@@ -922,6 +1030,9 @@ int SketchObject::addGeometry(const Part::Geometry *geo, bool construction/*=fal
 
 int SketchObject::delGeometry(int GeoId, bool deleteinternalgeo)
 {
+    // deleting geometry relies on the vertex index and the committed constraints
+    applyBatchEdit();
+
     Base::StateLocker lock(managedoperation, true); // no need to check input data validity as this is an sketchobject managed operation.
 
     const std::vector< Part::Geometry * > &vals = getInternalGeometry();
@@ -995,6 +1106,8 @@ int SketchObject::delGeometry(int GeoId, bool deleteinternalgeo)
 
 int SketchObject::delGeometries(const std::vector<int>& GeoIds)
 {
+    applyBatchEdit();
+
     std::vector<int> sGeoIds(GeoIds);
 
     // if a GeoId has internal geometry, it must delete internal geometries too
@@ -1018,6 +1131,8 @@ int SketchObject::delGeometries(const std::vector<int>& GeoIds)
 
 int SketchObject::delGeometriesExclusiveList(const std::vector<int>& GeoIds)
 {
+    applyBatchEdit();
+
     std::vector<int> sGeoIds(GeoIds);
 
     std::sort(sGeoIds.begin(), sGeoIds.end());
@@ -1215,6 +1330,23 @@ int SketchObject::addConstraints(const std::vector<Constraint *> &ConstraintList
 {
     Base::StateLocker lock(managedoperation, true); // no need to check input data validity as this is an sketchobject managed operation.
 
+    if (batchLevel > 0) {
+        seedBatchEdit();
+        for (auto constr : ConstraintList) {
+            Constraint *cnew = constr->clone();
+
+            if( cnew->Type == Tangent || cnew->Type == Perpendicular ){
+                AutoLockTangencyAndPerpty(cnew);
+            }
+
+            addGeometryState(cnew);
+
+            batchConstraints.push_back(cnew);
+            batchNewConstraints.insert(cnew);
+        }
+        return int(batchConstraints.size())-1;
+    }
+
     const std::vector< Constraint * > &vals = this->Constraints.getValues();
 
     std::vector< Constraint * > newVals(vals);
@@ -1284,10 +1416,6 @@ int SketchObject::addConstraint(std::unique_ptr<Constraint> constraint)
 {
     Base::StateLocker lock(managedoperation, true); // no need to check input data validity as this is an sketchobject managed operation.
 
-    const std::vector< Constraint * > &vals = this->Constraints.getValues();
-
-    std::vector< Constraint * > newVals(vals);
-
     Constraint *constNew = constraint.release();
 
     if (constNew->Type == Tangent || constNew->Type == Perpendicular)
@@ -1295,6 +1423,17 @@ int SketchObject::addConstraint(std::unique_ptr<Constraint> constraint)
 
     addGeometryState(constNew);
 
+    if (batchLevel > 0) {
+        seedBatchEdit();
+        batchConstraints.push_back(constNew);
+        batchNewConstraints.insert(constNew);
+        return int(batchConstraints.size())-1;
+    }
+
+    const std::vector< Constraint * > &vals = this->Constraints.getValues();
+
+    std::vector< Constraint * > newVals(vals);
+
     newVals.push_back(constNew); // add new constraint at the back
 
     this->Constraints.setValues(std::move(newVals));
@@ -1306,6 +1445,15 @@ int SketchObject::delConstraint(int ConstrId)
 {
     Base::StateLocker lock(managedoperation, true); // no need to check input data validity as this is an sketchobject managed operation.
 
+    if (batchLevel > 0) {
+        seedBatchEdit();
+        if (ConstrId < 0 || ConstrId >= int(batchConstraints.size()))
+            return -1;
+        removeGeometryState(batchConstraints[ConstrId]);
+        eraseBatchConstraint(ConstrId);
+        return 0;
+    }
+
     const std::vector< Constraint * > &vals = this->Constraints.getValues();
     if (ConstrId < 0 || ConstrId >= int(vals.size()))
         return -1;
@@ -1328,6 +1476,18 @@ int SketchObject::delConstraints(std::vector<int> ConstrIds, bool updategeometry
     if (ConstrIds.empty())
         return 0;
 
+    if (batchLevel > 0) {
+        seedBatchEdit();
+        std::sort(ConstrIds.begin(),ConstrIds.end());
+        if (ConstrIds.front() < 0 || ConstrIds.back() >= int(batchConstraints.size()))
+            return -1;
+        for(auto rit = ConstrIds.rbegin(); rit!=ConstrIds.rend(); rit++) {
+            removeGeometryState(batchConstraints[*rit]);
+            eraseBatchConstraint(*rit);
+        }
+        return 0;
+    }
+
     const std::vector< Constraint * > &vals = this->Constraints.getValues();
 
     std::vector< Constraint * > newVals(vals);
@@ -6338,8 +6498,6 @@ void SketchObject::rebuildExternalGeometry(void)
     gp_Pln sketchPlane(sketchAx3);
 
     Handle(Geom_Plane) gPlane = new Geom_Plane(sketchPlane);
-    BRepBuilderAPI_MakeFace mkFace(sketchPlane);
-    TopoDS_Shape aProjFace = mkFace.Shape();
 
     for (std::vector<Part::Geometry *>::iterator it=ExternalGeo.begin(); it != ExternalGeo.end(); ++it)
         if (*it) delete *it;
@@ -6352,11 +6510,13 @@ void SketchObject::rebuildExternalGeometry(void)
     GeometryFacade::setConstruction(VLine, true);
     ExternalGeo.push_back(HLine);
     ExternalGeo.push_back(VLine);
+
+    std::vector<TopoDS_Shape> refSubShapes(Objects.size());
     for (int i=0; i < int(Objects.size()); i++) {
         const App::DocumentObject *Obj=Objects[i];
         const std::string SubElement=SubElements[i];
 
-        TopoDS_Shape refSubShape;
+        TopoDS_Shape &refSubShape = refSubShapes[i];
 
         if (Obj->getTypeId().isDerivedFrom(Part::Datum::getClassTypeId())) {
             const Part::Datum* datum = static_cast<const Part::Datum*>(Obj);
@@ -6387,6 +6547,71 @@ void SketchObject::rebuildExternalGeometry(void)
         } else {
             throw Base::TypeError("Datum feature type is not yet supported as external geometry for a sketch");
         }
+    }
+
+    // The projection of a reference is reused as long as neither the referenced sub-shape nor the
+    // sketch placement changed. Shapes of a recomputed feature are new TopoDS_TShapes, so they do
+    // not match their cached predecessors.
+    if (!(externalProjectionPlacement == Plm)) {
+        externalProjections.clear();
+        externalProjectionPlacement = Plm;
+    }
+
+    auto findProjection = [this](const TopoDS_Shape &shape) -> const ExternalProjection * {
+        auto range = externalProjections.equal_range(shape.HashCode(INT_MAX));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.source.IsEqual(shape))
+                return &it->second;
+        }
+        return nullptr;
+    };
+
+    // Edges other than lines, circles and ellipses are projected by BRepOffsetAPI_NormalProjection,
+    // which dominates the rebuild of sketches referencing many such edges. These projections do not
+    // depend on each other and are computed concurrently up front, the geometries built from them
+    // are created below in reference order.
+    std::vector<int> normalProjectionIds;
+    for (int i=0; i < int(refSubShapes.size()); i++) {
+        const TopoDS_Shape &refSubShape = refSubShapes[i];
+        if (refSubShape.ShapeType() != TopAbs_EDGE || findProjection(refSubShape))
+            continue;
+        BRepAdaptor_Curve curve(TopoDS::Edge(refSubShape));
+        if (curve.GetType() != GeomAbs_Line && curve.GetType() != GeomAbs_Circle &&
+            curve.GetType() != GeomAbs_Ellipse)
+            normalProjectionIds.push_back(i);
+    }
+
+    std::vector<TopoDS_Shape> normalProjections(refSubShapes.size());
+    std::vector<std::exception_ptr> normalProjectionErrors(refSubShapes.size());
+    QtConcurrent::blockingMap(normalProjectionIds, [&](int i) {
+        try {
+            // every task builds its own face, only the referenced edges are shared between threads
+            BRepBuilderAPI_MakeFace mkFace(sketchPlane);
+            BRepOffsetAPI_NormalProjection mkProj(mkFace.Shape());
+            mkProj.Add(refSubShapes[i]);
+            mkProj.Build();
+            normalProjections[i] = mkProj.Projection();
+        }
+        catch (...) {
+            normalProjectionErrors[i] = std::current_exception();
+        }
+    });
+
+    std::multimap<int, ExternalProjection> projections;
+    for (int i=0; i < int(refSubShapes.size()); i++) {
+        const TopoDS_Shape &refSubShape = refSubShapes[i];
+
+        if (const ExternalProjection *cached = findProjection(refSubShape)) {
+            for (const auto &geo : cached->geometry)
+                ExternalGeo.push_back(geo->clone());
+            ExternalProjection &projection = projections.emplace(refSubShape.HashCode(INT_MAX), ExternalProjection())->second;
+            projection.source = refSubShape;
+            for (const auto &geo : cached->geometry)
+                projection.geometry.emplace_back(geo->clone());
+            continue;
+        }
+
+        std::size_t firstGeo = ExternalGeo.size();
 
         switch (refSubShape.ShapeType())
         {
@@ -6687,10 +6912,9 @@ void SketchObject::rebuildExternalGeometry(void)
                 }
                 else {
                     try {
-                        BRepOffsetAPI_NormalProjection mkProj(aProjFace);
-                        mkProj.Add(edge);
-                        mkProj.Build();
-                        const TopoDS_Shape& projShape = mkProj.Projection();
+                        if (normalProjectionErrors[i])
+                            std::rethrow_exception(normalProjectionErrors[i]);
+                        const TopoDS_Shape& projShape = normalProjections[i];
                         if (!projShape.IsNull()) {
                             TopExp_Explorer xp;
                             for (xp.Init(projShape, TopAbs_EDGE); xp.More(); xp.Next()) {
@@ -6878,8 +7102,15 @@ void SketchObject::rebuildExternalGeometry(void)
             throw Base::TypeError("Unknown type of geometry");
             break;
         }
+
+        ExternalProjection &projection = projections.emplace(refSubShape.HashCode(INT_MAX), ExternalProjection())->second;
+        projection.source = refSubShape;
+        for (std::size_t j = firstGeo; j < ExternalGeo.size(); j++)
+            projection.geometry.emplace_back(ExternalGeo[j]->clone());
     }
 
+    externalProjections.swap(projections);
+
     rebuildVertexIndex();
 }
 
@@ -7621,6 +7852,15 @@ void SketchObject::onChanged(const App::Property* prop)
     Part::Part2DObject::onChanged(prop);
 }
 
+void SketchObject::onBeforeChange(const App::Property* prop)
+{
+    // the pending lists of a batch edit would overwrite any other change of these properties
+    if (batchSeeded && (prop == &Geometry || prop == &Constraints))
+        throw Base::RuntimeError("SketchObject: the sketch has a pending batch edit, close it before this operation");
+
+    Part::Part2DObject::onBeforeChange(prop);
+}
+
 void SketchObject::onUndoRedoFinished()
 {
     // upon undo/redo, PropertyConstraintList does not have updated valid geometry keys, which results in empty constraint lists
@@ -99,6 +99,32 @@ public:
     */
     bool noRecomputes;
 
+    /** Batch editing of geometry and constraints
+        Between openBatchEdit() and closeBatchEdit() the additions of geometry and the additions
+        and deletions of constraints are collected in working copies of the Geometry and Constraints
+        lists instead of being set on the properties one by one. closeBatchEdit() sets both properties
+        once, rebuilds the solver system and solves the sketch.
+
+        Batches may be nested, only closing the outermost one commits. While a batch is open
+        getInternalGeometry() returns the pending geometry. Deleting geometry commits the pending
+        changes first. Any other operation writing the Geometry or Constraints properties throws,
+        the batch must be closed before it is used.
+    */
+    void openBatchEdit();
+    /// closes a batch edit, returns the result of solve() when the outermost batch is closed, 0 otherwise
+    int closeBatchEdit();
+    /// returns true while a batch edit is open
+    bool isBatchEditing() const { return batchLevel > 0; }
+
+    /// Scoped batch edit, see openBatchEdit()
+    class SketcherExport BatchEdit {
+    public:
+        explicit BatchEdit(SketchObject *obj) : obj(obj) { obj->openBatchEdit(); }
+        ~BatchEdit();
+    private:
+        SketchObject *obj;
+    };
+
     /*!
      \brief Returns true if the sketcher supports the given geometry
      \param geo - the geometry
@@ -189,7 +215,7 @@ public:
     std::unique_ptr<const GeometryFacade> getGeometryFacade(int GeoId) const;
 
     /// returns a list of all internal geometries
-    const std::vector<Part::Geometry *> &getInternalGeometry(void) const { return Geometry.getValues(); }
+    const std::vector<Part::Geometry *> &getInternalGeometry(void) const { return batchSeeded ? batchGeometry : Geometry.getValues(); }
     /// returns a list of projected external geometries
     const std::vector<Part::Geometry *> &getExternalGeometry(void) const { return ExternalGeo; }
     /// rebuilds external geometry (projection onto the sketch plane)
@@ -341,7 +367,7 @@ public:
     /// retrieves for a Vertex number the corresponding GeoId and PosId
     void getGeoVertexIndex(int VertexId, int &GeoId, PointPos &PosId) const;
     int getHighestVertexIndex(void) const { return VertexId2GeoId.size() - 1; } // Most recently created
-    int getHighestCurveIndex(void) const { return Geometry.getSize() - 1; }
+    int getHighestCurveIndex(void) const { return int(getInternalGeometry().size()) - 1; }
     void rebuildVertexIndex(void);
 
     /// retrieves for a GeoId and PosId the Vertex number
@@ -531,6 +557,8 @@ public: // geometry extension functionalities for single element sketch object u
 protected:
     /// get called by the container when a property has changed
     virtual void onChanged(const App::Property* /*prop*/) override;
+    /// get called by the container before a property is changed
+    virtual void onBeforeChange(const App::Property* /*prop*/) override;
     virtual void onDocumentRestored() override;
     virtual void restoreFinished() override;
 
@@ -617,6 +645,16 @@ private:
 
     std::vector<Part::Geometry *> ExternalGeo;
 
+    /// projection of one external reference, see rebuildExternalGeometry()
+    struct ExternalProjection {
+        TopoDS_Shape source;
+        std::vector<std::unique_ptr<Part::Geometry>> geometry;
+    };
+    /// projections of the last rebuildExternalGeometry(), by hash code of the referenced sub-shape
+    std::multimap<int, ExternalProjection> externalProjections;
+    /// the sketch placement the external references were projected with
+    Base::Placement externalProjectionPlacement;
+
     std::vector<int> VertexId2GeoId;
     std::vector<PointPos> VertexId2PosId;
 
@@ -665,6 +703,18 @@ private:
     bool internaltransaction;
 
     bool managedoperation; // indicates whether changes to properties are the deed of SketchObject or not (for input validation)
+
+    // Batch edit state (see openBatchEdit())
+    void seedBatchEdit();
+    void applyBatchEdit();
+    void eraseBatchConstraint(std::size_t index);
+
+    int batchLevel;
+    bool batchSeeded; // batchGeometry/batchConstraints hold the pending lists
+    std::vector<Part::Geometry *> batchGeometry;
+    std::vector<Constraint *> batchConstraints;
+    std::set<Part::Geometry *> batchNewGeometry; // owned by the batch until it is applied
+    std::set<Constraint *> batchNewConstraints;
 };
 
 inline int SketchObject::initTemporaryMove(int geoId, PointPos pos, bool fine/*=true*/)
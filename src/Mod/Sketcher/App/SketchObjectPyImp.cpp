@@ -65,6 +65,22 @@ PyObject* SketchObjectPy::solve(PyObject *args)
     return Py_BuildValue("i", ret);
 }
 
+PyObject* SketchObjectPy::openBatchEdit(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+    this->getSketchObjectPtr()->openBatchEdit();
+    Py_Return;
+}
+
+PyObject* SketchObjectPy::closeBatchEdit(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+    int ret = this->getSketchObjectPtr()->closeBatchEdit();
+    return Py_BuildValue("i", ret);
+}
+
 PyObject* SketchObjectPy::addGeometry(PyObject *args)
 {
     PyObject *pcObj;
@@ -355,11 +371,12 @@ PyObject* SketchObjectPy::addConstraint(PyObject *args)
         //
         // N.B.: However, the solve itself may be inhibited in cases where groups of geometry/constraints
         //      are added together, because in that case undoing will also make the geometry disappear.
+        //      Within a batch edit the solve is deferred to closeBatchEdit().
         this->getSketchObjectPtr()->solve();
         // if the geometry moved during the solve, then the initial solution is invalid
         // at this point, so a point movement may not work in cases where redundant constraints exist.
         // this forces recalculation of the initial solution (not a full solve)
-        if(this->getSketchObjectPtr()->noRecomputes) {
+        if(this->getSketchObjectPtr()->noRecomputes && !this->getSketchObjectPtr()->isBatchEditing()) {
             this->getSketchObjectPtr()->setUpSketch();
             this->getSketchObjectPtr()->Constraints.touch(); // update solver information
         }
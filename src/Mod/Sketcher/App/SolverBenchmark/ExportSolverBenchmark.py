@@ -0,0 +1,235 @@
+# ExportSolverBenchmark
+#***************************************************************************
+#*   Copyright (c) 2021 FreeCAD contributors                               *
+#*                                                                         *
+#*   This file is part of the FreeCAD CAx development system.              *
+#*                                                                         *
+#*   This program is free software; you can redistribute it and/or modify  *
+#*   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#*   as published by the Free Software Foundation; either version 2 of     *
+#*   the License, or (at your option) any later version.                   *
+#*   for detail see the LICENCE text file.                                 *
+#*                                                                         *
+#*   FreeCAD is distributed in the hope that it will be useful,            *
+#*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#*   GNU Lesser General Public License for more details.                   *
+#*                                                                         *
+#*   You should have received a copy of the GNU Library General Public     *
+#*   License along with FreeCAD; if not, write to the Free Software        *
+#*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#*   USA                                                                   *
+#*                                                                         *
+#***************************************************************************/
+
+"""Writes the sketches of a FreeCAD document in the corpus format of SketcherSolverBenchmark.
+
+Run it with FreeCADCmd, for example:
+
+    FreeCADCmd -c "import sys; sys.path.append('<this directory>'); \
+import ExportSolverBenchmark; ExportSolverBenchmark.exportDocument('part.FCStd', 'part.gcs')"
+
+Line segments, circles, arcs of circle, points and B-splines are exported together with the driving
+constraints between them that the benchmark knows. Other geometry, external geometry except the
+sketch axes and the constraints referring to them are skipped and reported.
+"""
+
+import FreeCAD
+import Part
+
+GeoUndef = -2000
+
+
+class SketchWriter:
+    def __init__(self, sketch):
+        self.sketch = sketch
+        self.lines = []
+        self.kinds = {}
+        self.poles = {}
+        self.skipped = 0
+
+    def point(self, geo, pos):
+        kind = self.kinds.get(geo)
+        if kind is None:
+            return None
+        if kind == "point":
+            return "g%d" % geo if pos == 1 else None
+        if kind == "line" and pos == 3:
+            return None
+        if kind == "circle" and pos != 3:
+            return None
+        return "g%d%s" % (geo, {1: "s", 2: "e", 3: "m"}.get(pos, "?"))
+
+    def edge(self, geo, *kinds):
+        if self.kinds.get(geo) in kinds:
+            return "g%d" % geo
+        return None
+
+    def addPoint(self, name, v, fixed=False):
+        self.lines.append("point %s %.17g %.17g%s" % (name, v.x, v.y, " fixed" if fixed else ""))
+
+    def writeGeometry(self):
+        # the sketch axes, GeoId -1 and -2
+        for geo, direction in ((-1, FreeCAD.Vector(1, 0, 0)), (-2, FreeCAD.Vector(0, 1, 0))):
+            self.addPoint("g%ds" % geo, FreeCAD.Vector(0, 0, 0), True)
+            self.addPoint("g%de" % geo, direction, True)
+            self.lines.append("line g%d g%ds g%de" % (geo, geo, geo))
+            self.kinds[geo] = "line"
+
+        for geo, g in enumerate(self.sketch.Geometry):
+            name = "g%d" % geo
+            if isinstance(g, Part.LineSegment):
+                self.addPoint(name + "s", g.StartPoint)
+                self.addPoint(name + "e", g.EndPoint)
+                self.lines.append("line %s %ss %se" % (name, name, name))
+                self.kinds[geo] = "line"
+            elif isinstance(g, Part.ArcOfCircle):
+                self.addPoint(name + "m", g.Center)
+                self.addPoint(name + "s", g.StartPoint)
+                self.addPoint(name + "e", g.EndPoint)
+                self.lines.append("arc %s %sm %ss %se %.17g %.17g %.17g" %
+                                  (name, name, name, name, g.Radius, g.FirstParameter, g.LastParameter))
+                self.kinds[geo] = "arc"
+            elif isinstance(g, Part.Circle):
+                self.addPoint(name + "m", g.Center)
+                self.lines.append("circle %s %sm %.17g" % (name, name, g.Radius))
+                self.kinds[geo] = "circle"
+            elif isinstance(g, Part.Point):
+                self.addPoint(name, FreeCAD.Vector(g.X, g.Y, g.Z))
+                self.kinds[geo] = "point"
+            elif isinstance(g, Part.BSplineCurve):
+                poles = g.getPoles()
+                knots = g.getKnots()
+                for k, p in enumerate(poles):
+                    self.addPoint("%sp%d" % (name, k), p)
+                self.addPoint(name + "s", g.StartPoint)
+                self.addPoint(name + "e", g.EndPoint)
+                record = "bspline %s %d %d %ss %se poles %d %s weights %s knots %d %s mults %s" % (
+                    name, g.Degree, 1 if g.isPeriodic() else 0, name, name, len(poles),
+                    " ".join("%sp%d" % (name, k) for k in range(len(poles))),
+                    " ".join("%.17g" % w for w in g.getWeights()),
+                    len(knots), " ".join("%.17g" % k for k in knots),
+                    " ".join(str(m) for m in g.getMultiplicities()))
+                self.lines.append(record)
+                self.kinds[geo] = "bspline"
+                self.poles[geo] = poles
+            else:
+                FreeCAD.Console.PrintWarning("%s: geometry %d (%s) is skipped\n"
+                                             % (self.sketch.Label, geo, g.TypeId))
+
+    def constraint(self, c):
+        t = c.Type
+        undef = c.Second == GeoUndef
+        if t == "Coincident":
+            p1, p2 = self.point(c.First, c.FirstPos), self.point(c.Second, c.SecondPos)
+            return p1 and p2 and "coincident %s %s" % (p1, p2)
+        if t in ("Horizontal", "Vertical"):
+            l = undef and self.edge(c.First, "line")
+            return l and "%s %s" % (t.lower(), l)
+        if t in ("Parallel", "Perpendicular"):
+            if c.FirstPos != 0 or c.SecondPos != 0:
+                return None
+            l1, l2 = self.edge(c.First, "line"), self.edge(c.Second, "line")
+            return l1 and l2 and "%s %s %s" % (t.lower(), l1, l2)
+        if t == "Tangent":
+            if c.FirstPos != 0 or c.SecondPos != 0:
+                return None
+            l, crv = self.edge(c.First, "line"), self.edge(c.Second, "circle", "arc")
+            if not (l and crv):
+                l, crv = self.edge(c.Second, "line"), self.edge(c.First, "circle", "arc")
+            return l and crv and "tangent %s %s" % (l, crv)
+        if t == "Distance":
+            if undef and c.FirstPos == 0:
+                l = self.edge(c.First, "line")
+                return l and "distance %ss %se %.17g" % (l, l, c.Value)
+            p1 = self.point(c.First, c.FirstPos)
+            if c.SecondPos == 0:
+                l = self.edge(c.Second, "line")
+                return p1 and l and "pointlinedistance %s %s %.17g" % (p1, l, c.Value)
+            p2 = self.point(c.Second, c.SecondPos)
+            return p1 and p2 and "distance %s %s %.17g" % (p1, p2, c.Value)
+        if t in ("DistanceX", "DistanceY"):
+            axis = t[-1].lower()
+            if undef and c.FirstPos == 0:
+                l = self.edge(c.First, "line")
+                return l and "distance%s %ss %se %.17g" % (axis, l, l, c.Value)
+            p1 = self.point(c.First, c.FirstPos)
+            if undef:
+                return p1 and "fix%s %s %.17g" % (axis, p1, c.Value)
+            p2 = self.point(c.Second, c.SecondPos)
+            return p1 and p2 and "distance%s %s %s %.17g" % (axis, p1, p2, c.Value)
+        if t in ("Radius", "Diameter"):
+            crv = self.edge(c.First, "circle", "arc")
+            return crv and "%s %s %.17g" % (t.lower(), crv, c.Value)
+        if t == "Equal":
+            l1, l2 = self.edge(c.First, "line"), self.edge(c.Second, "line")
+            if l1 and l2:
+                return "equallength %s %s" % (l1, l2)
+            c1, c2 = self.edge(c.First, "circle", "arc"), self.edge(c.Second, "circle", "arc")
+            return c1 and c2 and "equalradius %s %s" % (c1, c2)
+        if t == "PointOnObject":
+            p = self.point(c.First, c.FirstPos)
+            for kind, record in (("line", "pointonline"), ("circle", "pointoncircle"), ("arc", "pointonarc")):
+                crv = self.edge(c.Second, kind)
+                if p and crv:
+                    return "%s %s %s" % (record, p, crv)
+            return None
+        if t == "Angle":
+            if undef:
+                l = self.edge(c.First, "line")
+                return l and "lineangle %s %.17g" % (l, c.Value)
+            if c.FirstPos != 0 or c.SecondPos != 0:
+                return None
+            l1, l2 = self.edge(c.First, "line"), self.edge(c.Second, "line")
+            return l1 and l2 and "angle %s %s %.17g" % (l1, l2, c.Value)
+        if t == "Symmetric":
+            p1, p2 = self.point(c.First, c.FirstPos), self.point(c.Second, c.SecondPos)
+            ref = self.edge(c.Third, "line") if c.ThirdPos == 0 else self.point(c.Third, c.ThirdPos)
+            return p1 and p2 and ref and "symmetric %s %s %s" % (p1, p2, ref)
+        if t == "InternalAlignment":
+            crv, bs = self.edge(c.First, "circle"), self.edge(c.Second, "bspline")
+            if not (crv and bs):
+                return None
+            # the pole index is not exposed to Python, the pole circle is centered on its pole
+            center = self.sketch.Geometry[c.First].Center
+            poles = self.poles[c.Second]
+            index = min(range(len(poles)), key=lambda k: (poles[k] - center).Length)
+            return "bsplinecontrolpoint %s %s %d" % (bs, crv, index)
+        return None
+
+    def writeConstraints(self):
+        for i, c in enumerate(self.sketch.Constraints):
+            if not c.Driving or not c.IsActive:
+                continue
+            record = self.constraint(c)
+            if record:
+                self.lines.append("constraint " + record)
+            else:
+                self.skipped += 1
+        if self.skipped:
+            FreeCAD.Console.PrintWarning("%s: %d constraints are skipped\n"
+                                         % (self.sketch.Label, self.skipped))
+
+    def write(self, stream):
+        self.writeGeometry()
+        self.writeConstraints()
+        stream.write("sketch %s\n" % self.sketch.Name)
+        for line in self.lines:
+            stream.write(line + "\n")
+        stream.write("end\n\n")
+
+
+def exportSketch(sketch, stream):
+    SketchWriter(sketch).write(stream)
+
+
+def exportDocument(filename, output):
+    doc = FreeCAD.openDocument(filename)
+    try:
+        with open(output, "w") as stream:
+            stream.write("# exported from %s\n" % filename)
+            for obj in doc.Objects:
+                if obj.isDerivedFrom("Sketcher::SketchObject"):
+                    exportSketch(obj, stream)
+    finally:
+        FreeCAD.closeDocument(doc.Name)
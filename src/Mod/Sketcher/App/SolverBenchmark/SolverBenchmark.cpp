@@ -0,0 +1,879 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+/* Standalone timing harness for the planegcs solver.
+ *
+ * SketcherSolverBenchmark [options] <corpus file or directory>...
+ *
+ *   --repeat N       number of timed runs per measurement (default 5)
+ *   --output FILE    write the results as JSON to FILE instead of stdout
+ *   --qr ALG         only use the QRAlgorithm 'dense' or 'sparse' (default both)
+ *   --generate DIR   write the synthetic corpus (DXF-like and B-spline sketches) to DIR and exit
+ *   --size N         scale of the generated sketches (default 20)
+ *
+ * For each sketch of the corpus it times:
+ *   - setup:    building the GCS::System, declareUnknowns() and initSolution()
+ *   - diagnose: diagnose() with each QRAlgorithm
+ *   - solve:    solve() with each Algorithm and each QRAlgorithm
+ *   - drag:     the drag sequences of the sketch, solved like Sketch::movePoint() does
+ *
+ * Corpus files (*.gcs) are line based, '#' starts a comment and names are free form tokens:
+ *
+ *   sketch <name>
+ *   point <name> <x> <y> [fixed]
+ *   line <name> <point> <point>
+ *   circle <name> <center> <radius>
+ *   arc <name> <center> <start> <end> <radius> <startangle> <endangle>
+ *   bspline <name> <degree> <periodic> <start> <end> poles <n> <point>... weights <w>...
+ *           knots <k> <knot>... mults <m>...
+ *   constraint <type> <arguments>...
+ *   drag <point> <dx> <dy> <steps>
+ *   end
+ *
+ * The constraint types follow the GCS::System API: coincident, horizontal, vertical, parallel,
+ * perpendicular, distance, distancex, distancey, fixx, fixy, pointonline, pointoncircle, pointonarc,
+ * pointlinedistance, equallength, equalradius, radius, diameter, angle, lineangle, tangent,
+ * symmetric, midpointonline and bsplinecontrolpoint. Dimensional constraints take their value
+ * as last argument. ExportSolverBenchmark.py writes the sketches of a FreeCAD document in this format.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "../planegcs/GCS.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+typedef std::vector<std::string> Record;
+
+struct SketchDescription
+{
+    std::string name;
+    std::string file;
+    std::vector<std::pair<int, Record>> records; // line number and tokens
+};
+
+std::vector<SketchDescription> readCorpusFile(const std::string &file)
+{
+    std::ifstream str(file);
+    if (!str)
+        throw std::runtime_error("Cannot open " + file);
+
+    std::vector<SketchDescription> sketches;
+    SketchDescription *current = nullptr;
+    std::string line;
+    int lineno = 0;
+    while (std::getline(str, line)) {
+        ++lineno;
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        std::istringstream tokens(line);
+        Record record;
+        std::string token;
+        while (tokens >> token)
+            record.push_back(token);
+        if (record.empty())
+            continue;
+
+        if (record[0] == "sketch") {
+            sketches.emplace_back();
+            current = &sketches.back();
+            current->name = record.size() > 1 ? record[1] : file;
+            current->file = file;
+        }
+        else if (record[0] == "end") {
+            current = nullptr;
+        }
+        else if (!current) {
+            std::stringstream msg;
+            msg << file << ":" << lineno << ": '" << record[0] << "' outside of a sketch";
+            throw std::runtime_error(msg.str());
+        }
+        else {
+            current->records.emplace_back(lineno, std::move(record));
+        }
+    }
+    return sketches;
+}
+
+struct DragSequence
+{
+    std::string point;
+    double dx;
+    double dy;
+    int steps;
+};
+
+/// A GCS::System built from a sketch description. Parameters live in a deque so that their
+/// addresses stay valid while the sketch grows.
+class BenchmarkSketch
+{
+public:
+    explicit BenchmarkSketch(const SketchDescription &desc);
+
+    GCS::System system;
+    GCS::VEC_pD unknowns;
+    std::vector<DragSequence> drags;
+    int constraintCount = 0;
+
+    GCS::Point &point(const std::string &name);
+
+private:
+    double *addParameter(double value, bool unknown);
+    double value(const std::string &token) const;
+    GCS::Line &line(const std::string &name);
+    GCS::Circle &circle(const std::string &name);
+    GCS::Arc &arc(const std::string &name);
+    void addRecord(const Record &r);
+    void addConstraint(const Record &r);
+
+    std::deque<double> params;
+    std::map<std::string, GCS::Point> points;
+    std::map<std::string, GCS::Line> lines;
+    std::map<std::string, GCS::Circle> circles;
+    std::map<std::string, GCS::Arc> arcs;
+    std::map<std::string, GCS::BSpline> bsplines;
+    std::string context;
+};
+
+BenchmarkSketch::BenchmarkSketch(const SketchDescription &desc)
+{
+    for (const auto &it : desc.records) {
+        std::stringstream ctx;
+        ctx << desc.file << ":" << it.first << ": ";
+        context = ctx.str();
+        addRecord(it.second);
+    }
+}
+
+double *BenchmarkSketch::addParameter(double value, bool unknown)
+{
+    params.push_back(value);
+    double *param = &params.back();
+    if (unknown)
+        unknowns.push_back(param);
+    return param;
+}
+
+double BenchmarkSketch::value(const std::string &token) const
+{
+    try {
+        return std::stod(token);
+    }
+    catch (const std::exception &) {
+        throw std::runtime_error(context + "'" + token + "' is not a number");
+    }
+}
+
+template <typename T>
+T &lookup(std::map<std::string, T> &map, const std::string &name, const std::string &context, const char *kind)
+{
+    auto it = map.find(name);
+    if (it == map.end())
+        throw std::runtime_error(context + "unknown " + kind + " '" + name + "'");
+    return it->second;
+}
+
+GCS::Point &BenchmarkSketch::point(const std::string &name)
+{
+    return lookup(points, name, context, "point");
+}
+
+GCS::Line &BenchmarkSketch::line(const std::string &name)
+{
+    return lookup(lines, name, context, "line");
+}
+
+GCS::Circle &BenchmarkSketch::circle(const std::string &name)
+{
+    // arcs can be used wherever a circle is expected
+    auto it = arcs.find(name);
+    if (it != arcs.end())
+        return it->second;
+    return lookup(circles, name, context, "circle");
+}
+
+GCS::Arc &BenchmarkSketch::arc(const std::string &name)
+{
+    return lookup(arcs, name, context, "arc");
+}
+
+void BenchmarkSketch::addRecord(const Record &r)
+{
+    auto require = [&](std::size_t n) {
+        if (r.size() < n)
+            throw std::runtime_error(context + "too few arguments for '" + r[0] + "'");
+    };
+
+    const std::string &kind = r[0];
+    if (kind == "point") {
+        require(4);
+        bool fixed = r.size() > 4 && r[4] == "fixed";
+        GCS::Point p;
+        p.x = addParameter(value(r[2]), !fixed);
+        p.y = addParameter(value(r[3]), !fixed);
+        points[r[1]] = p;
+    }
+    else if (kind == "line") {
+        require(4);
+        GCS::Line l;
+        l.p1 = point(r[2]);
+        l.p2 = point(r[3]);
+        lines[r[1]] = l;
+    }
+    else if (kind == "circle") {
+        require(4);
+        GCS::Circle c;
+        c.center = point(r[2]);
+        c.rad = addParameter(value(r[3]), true);
+        circles[r[1]] = c;
+    }
+    else if (kind == "arc") {
+        require(8);
+        GCS::Arc a;
+        a.center = point(r[2]);
+        a.start = point(r[3]);
+        a.end = point(r[4]);
+        a.rad = addParameter(value(r[5]), true);
+        a.startAngle = addParameter(value(r[6]), true);
+        a.endAngle = addParameter(value(r[7]), true);
+        arcs[r[1]] = a;
+        // like Sketch::addArc, the end points follow the angles and the radius
+        system.addConstraintArcRules(arcs[r[1]]);
+    }
+    else if (kind == "bspline") {
+        require(8);
+        GCS::BSpline bs;
+        bs.degree = int(value(r[2]));
+        bs.periodic = r[3] == "1";
+        bs.start = point(r[4]);
+        bs.end = point(r[5]);
+
+        std::size_t i = 6;
+        auto expect = [&](const char *keyword) {
+            if (i >= r.size() || r[i] != keyword)
+                throw std::runtime_error(context + "expected '" + keyword + "' in bspline");
+            ++i;
+        };
+        auto count = [&]() {
+            require(i + 1);
+            return std::size_t(value(r[i++]));
+        };
+
+        expect("poles");
+        std::size_t npoles = count();
+        require(i + npoles);
+        for (std::size_t k = 0; k < npoles; k++)
+            bs.poles.push_back(point(r[i++]));
+        expect("weights");
+        require(i + npoles);
+        for (std::size_t k = 0; k < npoles; k++)
+            bs.weights.push_back(addParameter(value(r[i++]), true));
+        expect("knots");
+        std::size_t nknots = count();
+        require(i + nknots);
+        for (std::size_t k = 0; k < nknots; k++)
+            bs.knots.push_back(addParameter(value(r[i++]), false));
+        expect("mults");
+        require(i + nknots);
+        for (std::size_t k = 0; k < nknots; k++)
+            bs.mult.push_back(int(value(r[i++])));
+
+        bsplines[r[1]] = bs;
+
+        // like Sketch::addBSpline, a clamped B-spline starts and ends at its end poles
+        if (!bs.periodic && !bs.mult.empty()) {
+            if (bs.mult.front() > bs.degree)
+                system.addConstraintP2PCoincident(bs.poles.front(), bs.start);
+            if (bs.mult.back() > bs.degree)
+                system.addConstraintP2PCoincident(bs.poles.back(), bs.end);
+        }
+    }
+    else if (kind == "constraint") {
+        require(2);
+        addConstraint(r);
+    }
+    else if (kind == "drag") {
+        require(5);
+        point(r[1]); // validate
+        DragSequence drag;
+        drag.point = r[1];
+        drag.dx = value(r[2]);
+        drag.dy = value(r[3]);
+        drag.steps = std::max(1, int(value(r[4])));
+        drags.push_back(drag);
+    }
+    else {
+        throw std::runtime_error(context + "unknown record '" + kind + "'");
+    }
+}
+
+void BenchmarkSketch::addConstraint(const Record &r)
+{
+    const std::string &type = r[1];
+    auto args = [&](std::size_t n) {
+        if (r.size() != n + 2)
+            throw std::runtime_error(context + "wrong number of arguments for constraint '" + type + "'");
+    };
+    // dimensional values are not unknowns of the solver, as for driving constraints in Sketch
+    auto datum = [&](std::size_t i) { return addParameter(value(r[i]), false); };
+
+    int tag = ++constraintCount;
+    if (type == "coincident") {
+        args(2);
+        system.addConstraintP2PCoincident(point(r[2]), point(r[3]), tag);
+    }
+    else if (type == "horizontal") {
+        args(1);
+        system.addConstraintHorizontal(line(r[2]), tag);
+    }
+    else if (type == "vertical") {
+        args(1);
+        system.addConstraintVertical(line(r[2]), tag);
+    }
+    else if (type == "parallel") {
+        args(2);
+        system.addConstraintParallel(line(r[2]), line(r[3]), tag);
+    }
+    else if (type == "perpendicular") {
+        args(2);
+        system.addConstraintPerpendicular(line(r[2]), line(r[3]), tag);
+    }
+    else if (type == "distance") {
+        args(3);
+        system.addConstraintP2PDistance(point(r[2]), point(r[3]), datum(4), tag);
+    }
+    else if (type == "distancex") {
+        args(3);
+        system.addConstraintDifference(point(r[2]).x, point(r[3]).x, datum(4), tag);
+    }
+    else if (type == "distancey") {
+        args(3);
+        system.addConstraintDifference(point(r[2]).y, point(r[3]).y, datum(4), tag);
+    }
+    else if (type == "fixx") {
+        args(2);
+        system.addConstraintCoordinateX(point(r[2]), datum(3), tag);
+    }
+    else if (type == "fixy") {
+        args(2);
+        system.addConstraintCoordinateY(point(r[2]), datum(3), tag);
+    }
+    else if (type == "pointonline") {
+        args(2);
+        system.addConstraintPointOnLine(point(r[2]), line(r[3]), tag);
+    }
+    else if (type == "pointoncircle") {
+        args(2);
+        system.addConstraintPointOnCircle(point(r[2]), circle(r[3]), tag);
+    }
+    else if (type == "pointonarc") {
+        args(2);
+        system.addConstraintPointOnArc(point(r[2]), arc(r[3]), tag);
+    }
+    else if (type == "pointlinedistance") {
+        args(3);
+        system.addConstraintP2LDistance(point(r[2]), line(r[3]), datum(4), tag);
+    }
+    else if (type == "equallength") {
+        args(2);
+        system.addConstraintEqualLength(line(r[2]), line(r[3]), tag);
+    }
+    else if (type == "equalradius") {
+        args(2);
+        system.addConstraintEqualRadius(circle(r[2]), circle(r[3]), tag);
+    }
+    else if (type == "radius") {
+        args(2);
+        system.addConstraintCircleRadius(circle(r[2]), datum(3), tag);
+    }
+    else if (type == "diameter") {
+        args(2);
+        system.addConstraintCircleDiameter(circle(r[2]), datum(3), tag);
+    }
+    else if (type == "angle") {
+        args(3);
+        system.addConstraintL2LAngle(line(r[2]), line(r[3]), datum(4), tag);
+    }
+    else if (type == "lineangle") {
+        args(2);
+        GCS::Line &l = line(r[2]);
+        system.addConstraintP2PAngle(l.p1, l.p2, datum(3), tag);
+    }
+    else if (type == "tangent") {
+        args(2);
+        auto a = arcs.find(r[3]);
+        if (a != arcs.end())
+            system.addConstraintTangent(line(r[2]), a->second, tag);
+        else
+            system.addConstraintTangent(line(r[2]), circle(r[3]), tag);
+    }
+    else if (type == "symmetric") {
+        args(3);
+        if (lines.count(r[4]))
+            system.addConstraintP2PSymmetric(point(r[2]), point(r[3]), line(r[4]), tag);
+        else
+            system.addConstraintP2PSymmetric(point(r[2]), point(r[3]), point(r[4]), tag);
+    }
+    else if (type == "midpointonline") {
+        args(2);
+        system.addConstraintMidpointOnLine(line(r[2]), line(r[3]), tag);
+    }
+    else if (type == "bsplinecontrolpoint") {
+        args(3);
+        GCS::BSpline &bs = lookup(bsplines, r[2], context, "bspline");
+        int index = int(value(r[4]));
+        if (index < 0 || index >= int(bs.poles.size()))
+            throw std::runtime_error(context + "pole index out of range");
+        system.addConstraintInternalAlignmentBSplineControlPoint(bs, circle(r[3]), index, tag);
+    }
+    else {
+        throw std::runtime_error(context + "unknown constraint type '" + type + "'");
+    }
+}
+
+const GCS::Algorithm algorithms[] = { GCS::BFGS, GCS::LevenbergMarquardt, GCS::DogLeg };
+
+const char *algorithmName(GCS::Algorithm alg)
+{
+    switch (alg) {
+    case GCS::BFGS: return "BFGS";
+    case GCS::LevenbergMarquardt: return "LevenbergMarquardt";
+    case GCS::DogLeg: return "DogLeg";
+    }
+    return "";
+}
+
+const char *qrAlgorithmName(GCS::QRAlgorithm alg)
+{
+    return alg == GCS::EigenSparseQR ? "EigenSparseQR" : "EigenDenseQR";
+}
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Result
+{
+    std::string sketch;
+    std::string file;
+    std::string phase;
+    std::string algorithm;
+    std::string qrAlgorithm;
+    std::size_t params = 0;
+    int constraints = 0;
+    int dofs = 0;
+    int status = 0;
+    std::vector<double> times;
+};
+
+std::string jsonString(const std::string &s)
+{
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+void writeJson(std::ostream &str, const std::vector<Result> &results)
+{
+    str << "{\n  \"benchmark\": \"planegcs\",\n  \"results\": [";
+    const char *sep = "\n";
+    for (const Result &r : results) {
+        std::vector<double> t(r.times);
+        std::sort(t.begin(), t.end());
+        double mean = 0;
+        for (double v : t)
+            mean += v;
+        mean /= t.empty() ? 1 : t.size();
+        double median = t.empty() ? 0 : t[t.size() / 2];
+        double minimum = t.empty() ? 0 : t.front();
+
+        str << sep << "    {\"sketch\": " << jsonString(r.sketch)
+            << ", \"file\": " << jsonString(r.file)
+            << ", \"phase\": " << jsonString(r.phase)
+            << ", \"algorithm\": " << jsonString(r.algorithm)
+            << ", \"qr\": " << jsonString(r.qrAlgorithm)
+            << ", \"params\": " << r.params
+            << ", \"constraints\": " << r.constraints
+            << ", \"dofs\": " << r.dofs
+            << ", \"status\": " << r.status
+            << ", \"runs\": " << t.size()
+            << ", \"min_ms\": " << minimum
+            << ", \"median_ms\": " << median
+            << ", \"mean_ms\": " << mean << "}";
+        sep = ",\n";
+    }
+    str << "\n  ]\n}\n";
+}
+
+/// builds the system and runs the solver set-up as Sketch::setUpSketch does
+std::unique_ptr<BenchmarkSketch> setUp(const SketchDescription &desc, GCS::QRAlgorithm qr)
+{
+    std::unique_ptr<BenchmarkSketch> sketch(new BenchmarkSketch(desc));
+    sketch->system.qrAlgorithm = qr;
+    sketch->system.debugMode = GCS::NoDebug;
+    sketch->system.declareUnknowns(sketch->unknowns);
+    sketch->system.initSolution(GCS::DogLeg);
+    return sketch;
+}
+
+void benchmarkSketch(const SketchDescription &desc, int repeat,
+                     const std::vector<GCS::QRAlgorithm> &qrAlgorithms, std::vector<Result> &results)
+{
+    const std::vector<DragSequence> drags = BenchmarkSketch(desc).drags;
+
+    auto makeResult = [&](const char *phase, const BenchmarkSketch &sketch) {
+        Result r;
+        r.sketch = desc.name;
+        r.file = desc.file;
+        r.phase = phase;
+        r.params = sketch.unknowns.size();
+        r.constraints = sketch.constraintCount;
+        r.dofs = sketch.system.dofsNumber();
+        return r;
+    };
+
+    for (GCS::QRAlgorithm qr : qrAlgorithms) {
+        // setup, including the initial diagnosis
+        Result setup;
+        for (int i = 0; i < repeat; i++) {
+            Clock::time_point start = Clock::now();
+            auto sketch = setUp(desc, qr);
+            double t = elapsedMs(start);
+            if (i == 0)
+                setup = makeResult("setup", *sketch);
+            setup.times.push_back(t);
+        }
+        setup.qrAlgorithm = qrAlgorithmName(qr);
+        results.push_back(setup);
+
+        // diagnose alone
+        {
+            auto sketch = setUp(desc, qr);
+            Result r = makeResult("diagnose", *sketch);
+            r.qrAlgorithm = qrAlgorithmName(qr);
+            for (int i = 0; i < repeat; i++) {
+                sketch->system.invalidatedDiagnosis();
+                Clock::time_point start = Clock::now();
+                r.dofs = sketch->system.diagnose(GCS::DogLeg);
+                r.times.push_back(elapsedMs(start));
+            }
+            results.push_back(r);
+        }
+
+        // a full solve from the initial configuration with each algorithm
+        for (GCS::Algorithm alg : algorithms) {
+            Result r;
+            for (int i = 0; i < repeat; i++) {
+                auto sketch = setUp(desc, qr);
+                Clock::time_point start = Clock::now();
+                int status = sketch->system.solve(true, alg);
+                double t = elapsedMs(start);
+                if (i == 0) {
+                    r = makeResult("solve", *sketch);
+                    r.status = status;
+                }
+                r.times.push_back(t);
+            }
+            r.algorithm = algorithmName(alg);
+            r.qrAlgorithm = qrAlgorithmName(qr);
+            results.push_back(r);
+        }
+
+        // drag sequences, like Sketch::initMove() and Sketch::movePoint() for a point
+        for (const DragSequence &drag : drags) {
+            Result r;
+            for (int i = 0; i < repeat; i++) {
+                auto sketch = setUp(desc, qr);
+                // dragging starts from a solved sketch
+                if (sketch->system.solve(true, GCS::DogLeg) == GCS::Success)
+                    sketch->system.applySolution();
+
+                GCS::Point &p = sketch->point(drag.point);
+                double move[2] = { *p.x, *p.y };
+                const double x0 = move[0], y0 = move[1];
+                GCS::Point p0(&move[0], &move[1]);
+
+                Clock::time_point start = Clock::now();
+                sketch->system.addConstraintP2PCoincident(p0, p, GCS::DefaultTemporaryConstraint);
+                sketch->system.initSolution();
+                int status = GCS::Success;
+                for (int step = 1; step <= drag.steps; step++) {
+                    move[0] = x0 + drag.dx * step / drag.steps;
+                    move[1] = y0 + drag.dy * step / drag.steps;
+                    sketch->system.setDragMode(true);
+                    int ret = sketch->system.solve(false, GCS::DogLeg);
+                    sketch->system.setDragMode(false);
+                    if (ret == GCS::Success)
+                        sketch->system.applySolution();
+                    else
+                        status = ret;
+                }
+                double t = elapsedMs(start);
+                if (i == 0) {
+                    r = makeResult("drag", *sketch);
+                    r.status = status;
+                }
+                r.times.push_back(t);
+            }
+            r.algorithm = "DogLeg";
+            r.qrAlgorithm = qrAlgorithmName(qr);
+            r.phase = "drag:" + drag.point;
+            results.push_back(r);
+        }
+    }
+}
+
+// Synthetic corpus
+
+/// A DXF-like sketch: a grid of closed rectangles made of independent segments whose coincident
+/// end points are slightly apart, as after an import followed by autoconstraint
+void generateDxf(std::ostream &str, int size)
+{
+    str << "# generated: " << size << "x" << size << " rectangles of four segments\n";
+    str << "sketch dxf_grid_" << size << "\n";
+    int seed = 1;
+    auto jitter = [&seed]() {
+        seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+        return (seed % 1000) * 1e-5;
+    };
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            std::string id = std::to_string(i) + "_" + std::to_string(j);
+            double x = i * 12.0, y = j * 12.0;
+            double cx[4] = { x, x + 10, x + 10, x };
+            double cy[4] = { y, y, y + 10, y + 10 };
+            for (int k = 0; k < 4; k++) {
+                int n = (k + 1) % 4;
+                str << "point s" << k << "_" << id << " " << cx[k] + jitter() << " " << cy[k] + jitter() << "\n";
+                str << "point e" << k << "_" << id << " " << cx[n] + jitter() << " " << cy[n] + jitter() << "\n";
+                str << "line l" << k << "_" << id << " s" << k << "_" << id << " e" << k << "_" << id << "\n";
+            }
+            for (int k = 0; k < 4; k++)
+                str << "constraint coincident e" << k << "_" << id << " s" << (k + 1) % 4 << "_" << id << "\n";
+            str << "constraint horizontal l0_" << id << "\nconstraint horizontal l2_" << id << "\n";
+            str << "constraint vertical l1_" << id << "\nconstraint vertical l3_" << id << "\n";
+            if ((i + j) % 2 == 0)
+                str << "constraint equallength l0_" << id << " l1_" << id << "\n";
+        }
+    }
+    str << "constraint fixx s0_0_0 0\nconstraint fixy s0_0_0 0\n";
+    str << "drag e1_0_0 3 2 20\n";
+    str << "end\n";
+}
+
+/// B-spline sketches: clamped and periodic cubic B-splines whose poles carry circles, distance
+/// and equality constraints, as built by the B-spline tools of the sketcher
+void generateBSplines(std::ostream &str, int size)
+{
+    str << "# generated: " << size << " cubic B-splines\n";
+    str << "sketch bspline_" << size << "\n";
+    const int npoles = 8;
+    for (int b = 0; b < size; b++) {
+        bool periodic = b % 2 == 1;
+        std::string id = std::to_string(b);
+        double y = b * 10.0;
+        for (int k = 0; k < npoles; k++) {
+            double px = k * 5.0, py = y + (k % 2 ? 3.0 : 0.0);
+            str << "point p" << k << "_" << id << " " << px << " " << py << "\n";
+            str << "point c" << k << "_" << id << " " << px + 0.1 << " " << py - 0.1 << "\n";
+            str << "circle w" << k << "_" << id << " c" << k << "_" << id << " 1\n";
+        }
+        str << "point start_" << id << " 0 " << y << "\n";
+        str << "point end_" << id << " " << (npoles - 1) * 5.0 << " " << y + 3.0 << "\n";
+        str << "bspline b" << id << " 3 " << (periodic ? 1 : 0) << " start_" << id << " end_" << id;
+        str << " poles " << npoles;
+        for (int k = 0; k < npoles; k++)
+            str << " p" << k << "_" << id;
+        str << " weights";
+        for (int k = 0; k < npoles; k++)
+            str << " 1";
+        if (periodic) {
+            str << " knots " << npoles + 1;
+            for (int k = 0; k <= npoles; k++)
+                str << " " << double(k) / npoles;
+            str << " mults";
+            for (int k = 0; k <= npoles; k++)
+                str << " 1";
+        }
+        else {
+            int nknots = npoles - 2;
+            str << " knots " << nknots;
+            for (int k = 0; k < nknots; k++)
+                str << " " << double(k) / (nknots - 1);
+            str << " mults";
+            for (int k = 0; k < nknots; k++)
+                str << " " << ((k == 0 || k == nknots - 1) ? 4 : 1);
+        }
+        str << "\n";
+        for (int k = 0; k < npoles; k++) {
+            str << "constraint bsplinecontrolpoint b" << id << " w" << k << "_" << id << " " << k << "\n";
+            if (k > 0) {
+                str << "constraint equalradius w0_" << id << " w" << k << "_" << id << "\n";
+                str << "constraint distancex p" << k - 1 << "_" << id << " p" << k << "_" << id << " 5\n";
+            }
+        }
+        str << "constraint radius w0_" << id << " 2\n";
+        if (b == 0)
+            str << "constraint fixx p0_0 0\nconstraint fixy p0_0 0\n";
+        else
+            str << "constraint distancey p0_" << b - 1 << " p0_" << id << " 10\n"
+                << "constraint distancex p0_" << b - 1 << " p0_" << id << " 0\n";
+    }
+    str << "drag p3_0 1 4 20\n";
+    str << "end\n";
+}
+
+void generateCorpus(const std::string &dir, int size)
+{
+    fs::create_directories(dir);
+    std::ofstream dxf((fs::path(dir) / "dxf_grid.gcs").string());
+    generateDxf(dxf, size);
+    std::ofstream bsp((fs::path(dir) / "bspline.gcs").string());
+    generateBSplines(bsp, std::max(1, size / 5));
+}
+
+void collectFiles(const std::string &path, std::vector<std::string> &files)
+{
+    if (fs::is_directory(path)) {
+        std::vector<std::string> found;
+        for (fs::directory_iterator it(path), end; it != end; ++it) {
+            if (fs::is_regular_file(it->path()) && it->path().extension() == ".gcs")
+                found.push_back(it->path().string());
+        }
+        std::sort(found.begin(), found.end());
+        files.insert(files.end(), found.begin(), found.end());
+    }
+    else {
+        files.push_back(path);
+    }
+}
+
+void usage()
+{
+    std::cerr << "Usage: SketcherSolverBenchmark [--repeat N] [--output FILE] [--qr dense|sparse] <corpus file or directory>...\n"
+                 "       SketcherSolverBenchmark --generate DIR [--size N]\n";
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    int repeat = 5;
+    int size = 20;
+    std::vector<GCS::QRAlgorithm> qrAlgorithms = { GCS::EigenDenseQR, GCS::EigenSparseQR };
+    std::string output;
+    std::string generate;
+    std::vector<std::string> files;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc)
+                    throw std::runtime_error("missing value for " + arg);
+                return argv[++i];
+            };
+            if (arg == "--repeat")
+                repeat = std::max(1, std::stoi(next()));
+            else if (arg == "--output")
+                output = next();
+            else if (arg == "--qr") {
+                std::string qr = next();
+                if (qr == "dense")
+                    qrAlgorithms = { GCS::EigenDenseQR };
+                else if (qr == "sparse")
+                    qrAlgorithms = { GCS::EigenSparseQR };
+                else
+                    throw std::runtime_error("unknown QR algorithm " + qr);
+            }
+            else if (arg == "--generate")
+                generate = next();
+            else if (arg == "--size")
+                size = std::max(1, std::stoi(next()));
+            else if (arg == "--help" || arg == "-h") {
+                usage();
+                return 0;
+            }
+            else
+                collectFiles(arg, files);
+        }
+
+        if (!generate.empty()) {
+            generateCorpus(generate, size);
+            return 0;
+        }
+
+        if (files.empty()) {
+            usage();
+            return 1;
+        }
+
+        std::vector<Result> results;
+        for (const std::string &file : files) {
+            for (const SketchDescription &desc : readCorpusFile(file)) {
+                std::cerr << "Benchmarking " << desc.name << " (" << file << ")\n";
+                benchmarkSketch(desc, repeat, qrAlgorithms, results);
+            }
+        }
+
+        if (output.empty()) {
+            writeJson(std::cout, results);
+        }
+        else {
+            std::ofstream str(output);
+            if (!str)
+                throw std::runtime_error("Cannot write " + output);
+            writeJson(str, results);
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << "SketcherSolverBenchmark: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
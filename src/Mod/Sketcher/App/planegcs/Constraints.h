@@ -25,6 +25,7 @@
 
 #include "Geo.h"
 #include "Util.h"
+#include "Pool.h"
 #include <boost/graph/graph_concepts.hpp>
 
 //#define _GCS_EXTRACT_SOLVER_SUBSYSTEM_ // This enables debugging code intended to extract information to file bug reports against Eigen, not for production code
@@ -105,6 +106,10 @@ namespace GCS
         Constraint();
         virtual ~Constraint(){}
 
+        // constraints are created and destroyed in large numbers whenever a system is set up
+        static void* operator new(std::size_t size) { return ObjectPool::allocate(size); }
+        static void operator delete(void* p, std::size_t size) { ObjectPool::deallocate(p, size); }
+
         inline VEC_pD params() { return pvec; }
 
         void redirectParams(MAP_pD_pD redirectionmap);
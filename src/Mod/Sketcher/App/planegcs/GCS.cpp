@@ -54,6 +54,8 @@
 #include <cfloat>
 #include <limits>
 #include <future>
+#include <atomic>
+#include <thread>
 
 #include "GCS.h"
 #include "qp_eq.h"
@@ -451,6 +453,7 @@ System::System()
   , hasDiagnosis(false)
   , isInit(false)
   , emptyDiagnoseMatrix(true)
+  , dragMode(false)
   , maxIter(100)
   , maxIterRedundant(100)
   , sketchSizeMultiplier(false)
@@ -459,6 +462,9 @@ System::System()
   , convergenceRedundant(1e-10)
   , qrAlgorithm(EigenSparseQR)
   , dogLegGaussStep(FullPivLU)
+  , sparseThreshold(200)
+  , parallelThreshold(200)
+  , reuseDiagnosis(false)
   , qrpivotThreshold(1E-13)
   , debugMode(Minimal)
   , LM_eps(1E-10)
@@ -1563,22 +1569,58 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
     if (!isInit)
         return Failed;
 
-    bool isReset = false;
     // return success by default in order to permit coincidence constraints to be applied
     // even if no other system has to be solved
     int res = Success;
+    std::vector<int> cids; // decoupled components that have to be solved
+    int xsize = 0;
     for (int cid=0; cid < int(subSystems.size()); cid++) {
-        if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
-             resetToReference();
-             isReset = true;
-        }
+        // while dragging the components without temporary constraints keep their solution
+        if (dragMode && !subSystemsAux[cid])
+            continue;
+        if (subSystems[cid] || subSystemsAux[cid])
+            cids.push_back(cid);
+        if (subSystems[cid])
+            xsize += subSystems[cid]->pSize();
+        if (subSystemsAux[cid])
+            xsize += subSystemsAux[cid]->pSize();
+    }
+    if (!cids.empty() && !dragMode)
+        resetToReference();
+
+    auto solveComponent = [&](int cid) {
         if (subSystems[cid] && subSystemsAux[cid])
-            res = std::max(res, solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving));
+            return solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving);
         else if (subSystems[cid])
-            res = std::max(res, solve(subSystems[cid], isFine, alg, isRedundantsolving));
-        else if (subSystemsAux[cid])
-            res = std::max(res, solve(subSystemsAux[cid], isFine, alg, isRedundantsolving));
+            return solve(subSystems[cid], isFine, alg, isRedundantsolving);
+        else
+            return solve(subSystemsAux[cid], isFine, alg, isRedundantsolving);
+    };
+
+    if (cids.size() > 1 && xsize >= parallelThreshold) {
+        // The components share neither parameters nor constraints and each subsystem
+        // works on its own copy of the parameters, so they can be solved concurrently.
+        std::atomic<std::size_t> next(0);
+        auto worker = [&]() {
+            int ret = Success;
+            for (std::size_t k; (k = next++) < cids.size();)
+                ret = std::max(ret, solveComponent(cids[k]));
+            return ret;
+        };
+        std::size_t nthreads = std::min<std::size_t>(
+            std::max(1u, std::thread::hardware_concurrency()), cids.size());
+        std::vector<std::future<int> > futures;
+        for (std::size_t t=1; t < nthreads; t++)
+            futures.push_back(std::async(std::launch::async, worker));
+        res = std::max(res, worker());
+        for (auto &fut : futures)
+            res = std::max(res, fut.get());
     }
+    else {
+        for (int cid : cids)
+            res = std::max(res, solveComponent(cid));
+    }
+
     if (res == Success) {
         for (std::set<Constraint *>::const_iterator constr=redundant.begin();
              constr != redundant.end(); ++constr){
@@ -1742,10 +1784,25 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
     if (xsize == 0)
         return Success;
 
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    // Large sketches are dominated by the dense Jacobian, the sparse one only
+    // evaluates the parameters each constraint depends on
+    bool sparse = xsize >= sparseThreshold;
+#else
+    bool sparse = false;
+#endif
+
     Eigen::VectorXd e(csize), e_new(csize); // vector of all function errors (every constraint is one function)
-    Eigen::MatrixXd J(csize, xsize);        // Jacobi of the subsystem
-    Eigen::MatrixXd A(xsize, xsize);
+    Eigen::MatrixXd J(sparse ? 0 : csize, sparse ? 0 : xsize); // Jacobi of the subsystem
+    Eigen::MatrixXd A(sparse ? 0 : xsize, sparse ? 0 : xsize);
     Eigen::VectorXd x(xsize), h(xsize), x_new(xsize), g(xsize), diag_A(xsize);
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    Eigen::SparseMatrix<double> Js, As, Is(xsize, xsize);
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > ldlt;
+    bool analyzed = false; // the sparsity pattern of J does not change, see SubSystem::calcJacobi()
+    if (sparse)
+        Is.setIdentity();
+#endif
 
     subsys->redirectParams();
 
@@ -1792,14 +1849,26 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         }
 
         // J^T J, J^T e
-        subsys->calcJacobi(J);;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (sparse) {
+            subsys->calcJacobi(Js);
+
+            As = Js.transpose()*Js;
+            g = Js.transpose()*e;
+            diag_A = As.diagonal();
+        }
+        else
+#endif
+        {
+            subsys->calcJacobi(J);;
 
-        A = J.transpose()*J;
-        g = J.transpose()*e;
+            A = J.transpose()*J;
+            g = J.transpose()*e;
+            diag_A = A.diagonal(); // save diagonal entries so that augmentation can be later canceled
+        }
 
         // Compute ||J^T e||_inf
         double g_inf = g.lpNorm<Eigen::Infinity>();
-        diag_A = A.diagonal(); // save diagonal entries so that augmentation can be later canceled
 
         // check for convergence
         if (g_inf <= eps1) {
@@ -1815,13 +1884,32 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         // determine increment using adaptive damping
         int k=0;
         while (k < 50) {
-            // augment normal equations A = A+uI
-            for (int i=0; i < xsize; ++i)
-                A(i,i) += mu;
+            double rel_error = 1.;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+            if (sparse) {
+                // the augmented normal equations are positive definite for mu > 0
+                Eigen::SparseMatrix<double> Aaug = As + mu*Is;
+                if (!analyzed) {
+                    ldlt.analyzePattern(Aaug);
+                    analyzed = true;
+                }
+                ldlt.factorize(Aaug);
+                if (ldlt.info() == Eigen::Success) {
+                    h = ldlt.solve(g);
+                    rel_error = (Aaug*h - g).norm() / g.norm();
+                }
+            }
+            else
+#endif
+            {
+                // augment normal equations A = A+uI
+                for (int i=0; i < xsize; ++i)
+                    A(i,i) += mu;
 
-            //solve augmented functions A*h=-g
-            h = A.fullPivLu().solve(g);
-            double rel_error = (A*h - g).norm() / g.norm();
+                //solve augmented functions A*h=-g
+                h = A.fullPivLu().solve(g);
+                rel_error = (A*h - g).norm() / g.norm();
+            }
 
             // check if solving works
             if (rel_error < 1e-5) {
@@ -1868,8 +1956,10 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
             mu*=nu;
             nu*=2.0;
-            for (int i=0; i < xsize; ++i) // restore diagonal J^T J entries
-                A(i,i) = diag_A(i);
+            if (!sparse) {
+                for (int i=0; i < xsize; ++i) // restore diagonal J^T J entries
+                    A(i,i) = diag_A(i);
+            }
 
             k++;
         }
@@ -1900,6 +1990,23 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 }
 
 
+// Gauss-Newton step of the DogLeg solver with one of the dense decompositions
+static Eigen::VectorXd gaussStepDL(const Eigen::MatrixXd &Jx, const Eigen::VectorXd &fx,
+                                   DogLegGaussStep dogLegGaussStep)
+{
+    // http://forum.freecadweb.org/viewtopic.php?f=10&t=12769&start=50#p106220
+    // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
+    switch (dogLegGaussStep){
+        case FullPivLU:
+            return Jx.fullPivLu().solve(-fx);
+        case LeastNormFullPivLU:
+            return Jx.adjoint()*(Jx*Jx.adjoint()).fullPivLu().solve(-fx);
+        case LeastNormLdlt:
+            return Jx.adjoint()*(Jx*Jx.adjoint()).ldlt().solve(-fx);
+    }
+    return Eigen::VectorXd::Zero(Jx.cols());
+}
+
 int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
@@ -1935,19 +2042,48 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         Base::Console().Log(tmp.c_str());
     }
 
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    // see solve_LM()
+    bool sparse = xsize >= sparseThreshold;
+    Eigen::SparseMatrix<double> Jsx, Jsx_new;
+#else
+    bool sparse = false;
+#endif
+
     Eigen::VectorXd x(xsize), x_new(xsize);
     Eigen::VectorXd fx(csize), fx_new(csize);
-    Eigen::MatrixXd Jx(csize, xsize), Jx_new(csize, xsize);
+    Eigen::MatrixXd Jx(sparse ? 0 : csize, sparse ? 0 : xsize), Jx_new(sparse ? 0 : csize, sparse ? 0 : xsize);
     Eigen::VectorXd g(xsize), h_sd(xsize), h_gn(xsize), h_dl(xsize);
 
+    // products with the current Jacobian in whichever form it is stored
+    auto mulJ = [&](const Eigen::VectorXd &v) -> Eigen::VectorXd {
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (sparse)
+            return Jsx*v;
+#endif
+        return Jx*v;
+    };
+    auto mulJt = [&](const Eigen::VectorXd &v) -> Eigen::VectorXd {
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (sparse)
+            return Jsx.transpose()*v;
+#endif
+        return Jx.transpose()*v;
+    };
+
     subsys->redirectParams();
 
     double err;
     subsys->getParams(x);
     subsys->calcResidual(fx, err);
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    if (sparse)
+        subsys->calcJacobi(Jsx);
+    else
+#endif
     subsys->calcJacobi(Jx);
 
-    g = Jx.transpose()*(-fx);
+    g = mulJt(-fx);
 
     // get the infinity norm fx_inf and g_inf
     double g_inf = g.lpNorm<Eigen::Infinity>();
@@ -1975,25 +2111,31 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         }
         else {
             // get the steepest descent direction
-            alpha = g.squaredNorm()/(Jx*g).squaredNorm();
+            alpha = g.squaredNorm()/mulJ(g).squaredNorm();
             h_sd  = alpha*g;
 
             // get the gauss-newton step
-            // http://forum.freecadweb.org/viewtopic.php?f=10&t=12769&start=50#p106220
-            // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
-            switch (dogLegGaussStep){
-                case FullPivLU:
-                    h_gn = Jx.fullPivLu().solve(-fx);
-                    break;
-                case LeastNormFullPivLU:
-                    h_gn = Jx.adjoint()*(Jx*Jx.adjoint()).fullPivLu().solve(-fx);
-                    break;
-                case LeastNormLdlt:
-                    h_gn = Jx.adjoint()*(Jx*Jx.adjoint()).ldlt().solve(-fx);
-                    break;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+            if (sparse) {
+                bool solved = false;
+                if (dogLegGaussStep == LeastNormLdlt) {
+                    Eigen::SparseMatrix<double> JJt = Jsx*Jsx.transpose();
+                    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > ldlt(JJt);
+                    if (ldlt.info() == Eigen::Success) {
+                        h_gn = Jsx.transpose()*ldlt.solve(-fx);
+                        solved = h_gn.allFinite();
+                    }
+                }
+                // SimplicialLDLT does not pivot, rank deficient systems (redundant
+                // constraints) and the other step types need the dense decompositions
+                if (!solved)
+                    h_gn = gaussStepDL(Eigen::MatrixXd(Jsx), fx, dogLegGaussStep);
             }
+            else
+#endif
+            h_gn = gaussStepDL(Jx, fx, dogLegGaussStep);
 
-            double rel_error = (Jx*h_gn + fx).norm() / fx.norm();
+            double rel_error = (mulJ(h_gn) + fx).norm() / fx.norm();
             if (rel_error > 1e15)
                 break;
 
@@ -2041,20 +2183,30 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         x_new = x + h_dl;
         subsys->setParams(x_new);
         subsys->calcResidual(fx_new, err_new);
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (sparse)
+            subsys->calcJacobi(Jsx_new);
+        else
+#endif
         subsys->calcJacobi(Jx_new);
 
         // calculate the linear model and the update ratio
-        double dL = err - 0.5*(fx + Jx*h_dl).squaredNorm();
+        double dL = err - 0.5*(fx + mulJ(h_dl)).squaredNorm();
         double dF = err - err_new;
         double rho = dL/dF;
 
         if (dF > 0 && dL > 0) {
             x  = x_new;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+            if (sparse)
+                Jsx = Jsx_new;
+            else
+#endif
             Jx = Jx_new;
             fx = fx_new;
             err = err_new;
 
-            g = Jx.transpose()*(-fx);
+            g = mulJt(-fx);
 
             // get infinity norms
             g_inf = g.lpNorm<Eigen::Infinity>();
@@ -3904,6 +4056,17 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     redundantTags.clear();
     partiallyRedundantTags.clear();
 
+    // The rank of the Jacobian is a structural property for all but degenerate configurations.
+    // If enabled, a system rebuilt with the same constraints on the same parameters takes over
+    // the last diagnosis instead of repeating the QR decompositions.
+    std::vector<int> signature;
+    VEC_pD signatureParams;
+    if (reuseDiagnosis) {
+        makeDiagnosisSignature(signature, signatureParams);
+        if (restoreDiagnosis(signature, signatureParams))
+            return dofs;
+    }
+
     // This QR diagnosis uses a reduced Jacobian matrix to calculate the rank of the system and identify
     // conflicting and redundant constraints.
     //
@@ -4088,9 +4251,113 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     }
 #endif
 
+    if (reuseDiagnosis)
+        storeDiagnosis(signature, signatureParams);
+
     return dofs;
 }
 
+void System::makeDiagnosisSignature(std::vector<int> &signature, VEC_pD &params)
+{
+    // Unknown parameters are numbered by their position in plist, all other parameters
+    // (fixed ones and values of driven constraints) in the order of their first appearance
+    params = plist;
+    MAP_pD_I index = pIndex;
+    auto number = [&](double *param) {
+        MAP_pD_I::const_iterator it = index.find(param);
+        if (it != index.end())
+            return it->second;
+        int i = static_cast<int>(params.size());
+        index[param] = i;
+        params.push_back(param);
+        return i;
+    };
+
+    signature.clear();
+    signature.push_back(static_cast<int>(plist.size()));
+    signature.push_back(static_cast<int>(pdrivenlist.size()));
+    for (VEC_pD::const_iterator param=pdrivenlist.begin(); param != pdrivenlist.end(); ++param)
+        signature.push_back(number(*param));
+    signature.push_back(static_cast<int>(clist.size()));
+    for (std::vector<Constraint *>::const_iterator constr=clist.begin(); constr != clist.end(); ++constr) {
+        VEC_pD cparams = (*constr)->params();
+        signature.push_back(static_cast<int>((*constr)->getTypeId()));
+        signature.push_back((*constr)->getTag());
+        signature.push_back((*constr)->isDriving() ? 1 : 0);
+        signature.push_back(static_cast<int>(cparams.size()));
+        for (VEC_pD::const_iterator param=cparams.begin(); param != cparams.end(); ++param)
+            signature.push_back(number(*param));
+    }
+}
+
+bool System::restoreDiagnosis(const std::vector<int> &signature, const VEC_pD &params)
+{
+    if (diagnosisCache.dofs < 0 || diagnosisCache.signature != signature)
+        return false;
+
+    dofs = diagnosisCache.dofs;
+    emptyDiagnoseMatrix = diagnosisCache.emptyDiagnoseMatrix;
+    for (std::vector<int>::const_iterator it=diagnosisCache.redundant.begin();
+         it != diagnosisCache.redundant.end(); ++it)
+        redundant.insert(clist[*it]);
+    conflictingTags = diagnosisCache.conflictingTags;
+    redundantTags = diagnosisCache.redundantTags;
+    partiallyRedundantTags = diagnosisCache.partiallyRedundantTags;
+
+    pDependentParameters.clear();
+    for (std::vector<int>::const_iterator it=diagnosisCache.dependentParameters.begin();
+         it != diagnosisCache.dependentParameters.end(); ++it)
+        pDependentParameters.push_back(params[*it]);
+    pDependentParametersGroups.clear();
+    for (std::size_t i=0; i < diagnosisCache.dependentParametersGroups.size(); i++) {
+        pDependentParametersGroups.emplace_back();
+        for (std::vector<int>::const_iterator it=diagnosisCache.dependentParametersGroups[i].begin();
+             it != diagnosisCache.dependentParametersGroups[i].end(); ++it)
+            pDependentParametersGroups.back().push_back(params[*it]);
+    }
+
+    hasDiagnosis = true;
+    return true;
+}
+
+void System::storeDiagnosis(const std::vector<int> &signature, const VEC_pD &params)
+{
+    MAP_pD_I pindex;
+    for (int i=0; i < int(params.size()); i++)
+        pindex[params[i]] = i;
+    std::map<Constraint *, int> cindex;
+    for (int i=0; i < int(clist.size()); i++)
+        cindex[clist[i]] = i;
+
+    diagnosisCache = DiagnosisCache();
+    for (std::set<Constraint *>::const_iterator constr=redundant.begin(); constr != redundant.end(); ++constr)
+        diagnosisCache.redundant.push_back(cindex.at(*constr));
+    for (VEC_pD::const_iterator param=pDependentParameters.begin(); param != pDependentParameters.end(); ++param) {
+        MAP_pD_I::const_iterator it = pindex.find(*param);
+        if (it == pindex.end())
+            return; // cannot be expressed in terms of the signature, leave the cache empty
+        diagnosisCache.dependentParameters.push_back(it->second);
+    }
+    for (std::size_t i=0; i < pDependentParametersGroups.size(); i++) {
+        diagnosisCache.dependentParametersGroups.emplace_back();
+        for (VEC_pD::const_iterator param=pDependentParametersGroups[i].begin();
+             param != pDependentParametersGroups[i].end(); ++param) {
+            MAP_pD_I::const_iterator it = pindex.find(*param);
+            if (it == pindex.end()) {
+                diagnosisCache = DiagnosisCache();
+                return;
+            }
+            diagnosisCache.dependentParametersGroups.back().push_back(it->second);
+        }
+    }
+    diagnosisCache.conflictingTags = conflictingTags;
+    diagnosisCache.redundantTags = redundantTags;
+    diagnosisCache.partiallyRedundantTags = partiallyRedundantTags;
+    diagnosisCache.emptyDiagnoseMatrix = emptyDiagnoseMatrix;
+    diagnosisCache.signature = signature;
+    diagnosisCache.dofs = dofs;
+}
+
 void System::makeDenseQRDecomposition(  const Eigen::MatrixXd &J,
                                         const std::map<int,int> &jacobianconstraintmap,
                                         Eigen::FullPivHouseholderQR<Eigen::MatrixXd>& qrJT,
@@ -4506,11 +4773,35 @@ void System::identifyConflictingRedundantConstraints(   Algorithm alg,
         SolverReportingManager::Manager().LogSetOfConstraints("Chosen redundants", skipped);
     }
 
+    // Only the constraints coupled to the skipped ones through the diagnosed parameters can
+    // tell whether these are redundant, decoupled parts of the system are not solved again
+    std::set<Constraint *> coupled(skipped.begin(), skipped.end());
+    {
+        SET_pD diagnosed(pdiagnoselist.begin(), pdiagnoselist.end());
+        SET_pD visited;
+        std::vector<Constraint *> stack(skipped.begin(), skipped.end());
+        while (!stack.empty()) {
+            Constraint *constr = stack.back();
+            stack.pop_back();
+            VEC_pD &cparams = c2p[constr];
+            for (VEC_pD::const_iterator param=cparams.begin(); param != cparams.end(); ++param) {
+                if (diagnosed.count(*param) == 0 || !visited.insert(*param).second)
+                    continue;
+                std::vector<Constraint *> &constrs = p2c[*param];
+                for (std::vector<Constraint *>::const_iterator other=constrs.begin();
+                     other != constrs.end(); ++other) {
+                    if (coupled.insert(*other).second)
+                        stack.push_back(*other);
+                }
+            }
+        }
+    }
+
     std::vector<Constraint *> clistTmp;
-    clistTmp.reserve(clist.size());
+    clistTmp.reserve(coupled.size());
     for (std::vector<Constraint *>::iterator constr=clist.begin();
         constr != clist.end(); ++constr) {
-        if ((*constr)->isDriving() && skipped.count(*constr) == 0)
+        if ((*constr)->isDriving() && skipped.count(*constr) == 0 && coupled.count(*constr) > 0)
             clistTmp.push_back(*constr);
     }
 
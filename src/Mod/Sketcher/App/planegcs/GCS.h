@@ -123,6 +123,22 @@ namespace GCS
         std::vector< std::vector<Constraint *> > clists; // partitioned clist except equality constraints
         std::vector< MAP_pD_pD > reductionmaps;          // for simplification of equality constraints
 
+        // Result of the last diagnosis in terms of indices, so that it survives clear() and can be
+        // reused when the system is rebuilt with the same structure but other values
+        struct DiagnosisCache {
+            std::vector<int> signature;
+            int dofs = -1;
+            bool emptyDiagnoseMatrix = true;
+            std::vector<int> redundant;
+            VEC_I conflictingTags, redundantTags, partiallyRedundantTags;
+            std::vector<int> dependentParameters;
+            std::vector< std::vector<int> > dependentParametersGroups;
+        };
+        DiagnosisCache diagnosisCache;
+        void makeDiagnosisSignature(std::vector<int> &signature, VEC_pD &params);
+        bool restoreDiagnosis(const std::vector<int> &signature, const VEC_pD &params);
+        void storeDiagnosis(const std::vector<int> &signature, const VEC_pD &params);
+
         int dofs;
         std::set<Constraint *> redundant;
         VEC_I conflictingTags, redundantTags, partiallyRedundantTags;
@@ -132,6 +148,7 @@ namespace GCS
         bool isInit;       // if plists, clists, reductionmaps are up to date
 
         bool emptyDiagnoseMatrix; // false only if there is at least one driving constraint.
+        bool dragMode;     // see setDragMode()
 
         int solve_BFGS(SubSystem *subsys, bool isFine=true, bool isRedundantsolving=false);
         int solve_LM(SubSystem *subsys, bool isRedundantsolving=false);
@@ -203,6 +220,9 @@ namespace GCS
         double convergenceRedundant;
         QRAlgorithm qrAlgorithm;
         DogLegGaussStep dogLegGaussStep;
+        int sparseThreshold; // LM and DL use a sparse Jacobian from this number of parameters on
+        int parallelThreshold; // decoupled components are solved concurrently from this number of parameters on
+        bool reuseDiagnosis; // reuse the last diagnosis if only parameter values changed, see diagnose()
         double qrpivotThreshold;
         DebugMode debugMode;
         double LM_eps;
@@ -349,6 +369,10 @@ namespace GCS
 
         void applySolution();
         void undoSolution();
+        // Interactive dragging: solve() only solves the decoupled components that
+        // hold temporary (negatively tagged) constraints and starts from the last
+        // solution instead of the reference configuration.
+        void setDragMode(bool enable) { dragMode = enable; }
         //FIXME: looks like XconvergenceFine is not the solver precision, at least in DogLeg solver.
         // Note: Yes, every solver has a different way of interpreting precision
         // but one has to study what is this needed for in order to decide
@@ -0,0 +1,124 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <new>
+#include "Pool.h"
+
+namespace GCS
+{
+
+namespace {
+    // Objects up to 'MaxSize' bytes are recycled in size classes of 'Granularity' bytes
+    const std::size_t Granularity = 16;
+    const std::size_t MaxSize = 512;
+    const std::size_t NumClasses = MaxSize / Granularity;
+
+    struct FreeNode
+    {
+        FreeNode* next;
+    };
+
+    struct FreeLists
+    {
+        FreeNode* heads[NumClasses] = {};
+        bool destroyed = false;
+
+        ~FreeLists()
+        {
+            // objects deleted during the shutdown of the thread aren't recycled any more
+            destroyed = true;
+            for (std::size_t i = 0; i < NumClasses; i++) {
+                while (heads[i]) {
+                    FreeNode* node = heads[i];
+                    heads[i] = node->next;
+                    ::operator delete(node);
+                }
+            }
+        }
+    };
+
+    thread_local FreeLists freeLists;
+
+    inline std::size_t sizeClass(std::size_t size)
+    {
+        return (size + Granularity - 1) / Granularity - 1;
+    }
+}
+
+void* ObjectPool::allocate(std::size_t size)
+{
+    if (size == 0 || size > MaxSize)
+        return ::operator new(size);
+
+    std::size_t index = sizeClass(size);
+    FreeNode* node = freeLists.heads[index];
+    if (node) {
+        freeLists.heads[index] = node->next;
+        return node;
+    }
+    return ::operator new((index + 1) * Granularity);
+}
+
+void ObjectPool::deallocate(void* p, std::size_t size)
+{
+    if (!p)
+        return;
+    if (size == 0 || size > MaxSize || freeLists.destroyed) {
+        ::operator delete(p);
+        return;
+    }
+
+    std::size_t index = sizeClass(size);
+    FreeNode* node = static_cast<FreeNode*>(p);
+    node->next = freeLists.heads[index];
+    freeLists.heads[index] = node;
+}
+
+// ----------------------------------------------------------------------------
+
+ParameterArena::ParameterArena()
+  : used(0)
+{
+}
+
+ParameterArena::~ParameterArena()
+{
+}
+
+double* ParameterArena::create(double value)
+{
+    std::size_t block = used / BlockSize;
+    if (block == blocks.size())
+        blocks.emplace_back(new double[BlockSize]);
+
+    double* param = &blocks[block][used % BlockSize];
+    *param = value;
+    used++;
+    return param;
+}
+
+void ParameterArena::reset()
+{
+    used = 0;
+}
+
+} //namespace GCS
@@ -0,0 +1,71 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD contributors                               *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PLANEGCS_POOL_H
+#define PLANEGCS_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace GCS
+{
+    /**
+     * Recycles the memory of small objects of the same size class.
+     * Freed blocks are kept in a per-thread free list and handed out again by the
+     * next allocation of that size, so setting up a system with thousands of
+     * constraints again and again doesn't go through the global allocator.
+     */
+    class ObjectPool
+    {
+    public:
+        static void* allocate(std::size_t size);
+        static void deallocate(void* p, std::size_t size);
+    };
+
+    /**
+     * Allocates the solver parameters in contiguous blocks. All parameters are
+     * released at once with reset() which keeps the blocks for reuse. The addresses
+     * of the parameters remain valid until reset() is called.
+     */
+    class ParameterArena
+    {
+    public:
+        ParameterArena();
+        ~ParameterArena();
+
+        double* create(double value);
+        void reset();
+        std::size_t size() const { return used; }
+
+    private:
+        ParameterArena(const ParameterArena&) = delete;
+        ParameterArena& operator=(const ParameterArena&) = delete;
+
+        static const std::size_t BlockSize = 1024;
+        std::vector<std::unique_ptr<double[]>> blocks;
+        std::size_t used;
+    };
+
+} //namespace GCS
+
+#endif // PLANEGCS_POOL_H
@@ -275,6 +275,29 @@ void SubSystem::calcJacobi(Eigen::MatrixXd &jacobi)
     calcJacobi(plist, jacobi);
 }
 
+void SubSystem::calcJacobi(Eigen::SparseMatrix<double> &jacobi)
+{
+    // Only the parameters a constraint depends on are evaluated (see c2p), instead
+    // of calling grad() for every pair of constraint and parameter. Zero derivatives
+    // are stored as well, so the pattern stays the same between iterations and a
+    // symbolic factorization can be reused.
+    std::vector<Eigen::Triplet<double> > triplets;
+    triplets.reserve(4*csize);
+    for (int i=0; i < csize; i++) {
+        std::map<Constraint *,VEC_pD >::const_iterator
+          c2pfind = c2p.find(clist[i]);
+        if (c2pfind == c2p.end())
+            continue;
+        for (VEC_pD::const_iterator param=c2pfind->second.begin();
+             param != c2pfind->second.end(); ++param) {
+            double deriv = clist[i]->grad(*param);
+            triplets.push_back(Eigen::Triplet<double>(i, int(*param - &pvals[0]), deriv));
+        }
+    }
+    jacobi.resize(csize, psize);
+    jacobi.setFromTriplets(triplets.begin(), triplets.end());
+}
+
 void SubSystem::calcGrad(VEC_pD &params, Eigen::VectorXd &grad)
 {
     assert(grad.size() == int(params.size()));
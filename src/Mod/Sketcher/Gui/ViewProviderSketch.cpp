@@ -173,6 +173,139 @@ SbVec2s ViewProviderSketch::newCursorPos;
 //**************************************************************************
 // Edit data structure
 
+namespace {
+
+/// The parameters that determine the edit mode polyline of a curve. Two curves of the same type
+/// with equal keys are tessellated identically.
+std::vector<double> tessellationKey(const Part::Geometry *geo, int countSegments)
+{
+    std::vector<double> key;
+    key.push_back(countSegments);
+
+    auto addVector = [&key](const Base::Vector3d &v) {
+        key.push_back(v.x);
+        key.push_back(v.y);
+        key.push_back(v.z);
+    };
+
+    if (geo->isDerivedFrom(Part::GeomConic::getClassTypeId())) {
+        const Part::GeomConic *conic = static_cast<const Part::GeomConic *>(geo);
+        addVector(conic->getCenter());
+        key.push_back(conic->getAngleXU());
+        key.push_back(conic->isReversed());
+    }
+    else if (geo->isDerivedFrom(Part::GeomArcOfConic::getClassTypeId())) {
+        const Part::GeomArcOfConic *aoc = static_cast<const Part::GeomArcOfConic *>(geo);
+        addVector(aoc->getCenter());
+        key.push_back(aoc->getAngleXU());
+        key.push_back(aoc->isReversed());
+        double u, v;
+        aoc->getRange(u, v, /*emulateCCW=*/false);
+        key.push_back(u);
+        key.push_back(v);
+    }
+
+    Base::Type type = geo->getTypeId();
+    if (type == Part::GeomCircle::getClassTypeId()) {
+        key.push_back(static_cast<const Part::GeomCircle *>(geo)->getRadius());
+    }
+    else if (type == Part::GeomArcOfCircle::getClassTypeId()) {
+        key.push_back(static_cast<const Part::GeomArcOfCircle *>(geo)->getRadius());
+    }
+    else if (type == Part::GeomEllipse::getClassTypeId()) {
+        const Part::GeomEllipse *ellipse = static_cast<const Part::GeomEllipse *>(geo);
+        key.push_back(ellipse->getMajorRadius());
+        key.push_back(ellipse->getMinorRadius());
+    }
+    else if (type == Part::GeomArcOfEllipse::getClassTypeId()) {
+        const Part::GeomArcOfEllipse *aoe = static_cast<const Part::GeomArcOfEllipse *>(geo);
+        key.push_back(aoe->getMajorRadius());
+        key.push_back(aoe->getMinorRadius());
+    }
+    else if (type == Part::GeomArcOfHyperbola::getClassTypeId()) {
+        const Part::GeomArcOfHyperbola *aoh = static_cast<const Part::GeomArcOfHyperbola *>(geo);
+        key.push_back(aoh->getMajorRadius());
+        key.push_back(aoh->getMinorRadius());
+    }
+    else if (type == Part::GeomArcOfParabola::getClassTypeId()) {
+        key.push_back(static_cast<const Part::GeomArcOfParabola *>(geo)->getFocal());
+    }
+    else if (type == Part::GeomBSplineCurve::getClassTypeId()) {
+        const Part::GeomBSplineCurve *spline = static_cast<const Part::GeomBSplineCurve *>(geo);
+        key.push_back(spline->getDegree());
+        key.push_back(spline->isPeriodic());
+        for (const auto &pole : spline->getPoles())
+            addVector(pole);
+        for (double weight : spline->getWeights())
+            key.push_back(weight);
+        for (double knot : spline->getKnots())
+            key.push_back(knot);
+        for (int mult : spline->getMultiplicities())
+            key.push_back(mult);
+    }
+
+    return key;
+}
+
+/// Keeps the edit mode polylines of the curved geometries between two draws. A curve is only
+/// tessellated again if one of its defining parameters changed, so while dragging just the
+/// geometries moved by the solver are recomputed.
+class CurveTessellationCache
+{
+public:
+    /// Appends the polyline cached for GeoId to Coords if geo did not change since it was stored.
+    /// B-splines also get back the scale of their curvature comb.
+    bool reuse(int GeoId, const Part::Geometry *geo, int countSegments,
+               std::vector<Base::Vector3d> &Coords, double *combScale = nullptr)
+    {
+        pending.type = geo->getTypeId();
+        pending.key = tessellationKey(geo, countSegments);
+        pendingStart = Coords.size();
+
+        auto it = previous.find(GeoId);
+        if (it == previous.end() || it->second.type != pending.type || it->second.key != pending.key)
+            return false;
+
+        Coords.insert(Coords.end(), it->second.coords.begin(), it->second.coords.end());
+        if (combScale)
+            *combScale = it->second.combScale;
+        current[GeoId] = std::move(it->second);
+        previous.erase(it);
+        return true;
+    }
+
+    /// Stores the polyline appended to Coords since the failed reuse() for GeoId
+    void store(int GeoId, const std::vector<Base::Vector3d> &Coords, double combScale = 0)
+    {
+        pending.coords.assign(Coords.begin() + pendingStart, Coords.end());
+        pending.combScale = combScale;
+        current[GeoId] = std::move(pending);
+        pending = Entry();
+    }
+
+    /// Drops the polylines of the geometries that were not drawn since the last call
+    void finish()
+    {
+        previous.swap(current);
+        current.clear();
+    }
+
+private:
+    struct Entry {
+        Base::Type type;
+        std::vector<double> key;
+        std::vector<Base::Vector3d> coords;
+        double combScale = 0;
+    };
+
+    std::map<int, Entry> previous;
+    std::map<int, Entry> current;
+    Entry pending;
+    std::size_t pendingStart = 0;
+};
+
+} // namespace
+
 /// Data structure while editing the sketch
 struct EditData {
     EditData():
@@ -265,6 +398,12 @@ struct EditData {
     // constraint IDs.
     std::map<QString, ViewProviderSketch::ConstrIconBBVec> combinedConstrBoxes;
 
+    // polylines of the curved geometries of the last draw()
+    CurveTessellationCache curveTessellations;
+
+    // appearance of the icon last rendered into each constraint icon node, see drawTypicalConstraintIcon()
+    std::map<SoImage *, QString> constrIconKeys;
+
     // nodes for the visuals
     SoSeparator   *EditRoot;
     SoMaterial    *PointsMaterials;
@@ -3281,11 +3420,15 @@ void ViewProviderSketch::sendConstraintIconToCoin(const QImage &icon, SoImage *s
     //Set Image Alignment to Center
     soImagePtr->vertAlignment = SoImage::HALF;
     soImagePtr->horAlignment = SoImage::CENTER;
+
+    edit->constrIconKeys.erase(soImagePtr);
 }
 
 void ViewProviderSketch::clearCoinImage(SoImage *soImagePtr)
 {
     soImagePtr->setToDefaults();
+
+    edit->constrIconKeys.erase(soImagePtr);
 }
 
 QColor ViewProviderSketch::constrColor(int constraintId)
@@ -3778,6 +3921,13 @@ void ViewProviderSketch::drawTypicalConstraintIcon(const constrIconQueueItem &i)
 {
     QColor color = constrColor(i.constraintId);
 
+    // the icon is only rendered again if it looks different from the one already in the node
+    QString key = QString::fromLatin1("%1|%2|%3|%4|%5").arg(i.type, color.name(), i.label)
+                                                       .arg(i.iconRotation).arg(i.constraintId);
+    auto cached = edit->constrIconKeys.find(i.destination);
+    if (cached != edit->constrIconKeys.end() && cached->second == key)
+        return;
+
     QImage image = renderConstrIcon(i.type,
                                     color,
                                     QStringList(i.label),
@@ -3786,6 +3936,7 @@ void ViewProviderSketch::drawTypicalConstraintIcon(const constrIconQueueItem &i)
 
     i.infoPtr->string.setValue(QString::number(i.constraintId).toLatin1().data());
     sendConstraintIconToCoin(image, i.destination);
+    edit->constrIconKeys[i.destination] = key;
 }
 
 float ViewProviderSketch::getScaleFactor()
@@ -4070,7 +4221,7 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
                     }
                 }
             }
-            else {
+            else if (!edit->curveTessellations.reuse(GeoId, circle, countSegments, Coords)) {
 
                 double segment = (2 * M_PI) / countSegments;
 
@@ -4081,6 +4232,8 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
 
                 gp_Pnt pnt = curve->Value(0);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+
+                edit->curveTessellations.store(GeoId, Coords);
             }
 
             Index.push_back(countSegments+1);
@@ -4094,14 +4247,18 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
 
             int countSegments = stdcountsegments;
             Base::Vector3d center = ellipse->getCenter();
-            double segment = (2 * M_PI) / countSegments;
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(i*segment);
+            if (!edit->curveTessellations.reuse(GeoId, ellipse, countSegments, Coords)) {
+                double segment = (2 * M_PI) / countSegments;
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(i*segment);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                }
+
+                gp_Pnt pnt = curve->Value(0);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-            }
 
-            gp_Pnt pnt = curve->Value(0);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                edit->curveTessellations.store(GeoId, Coords);
+            }
 
             Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
@@ -4125,15 +4282,19 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             Base::Vector3d start  = arc->getStartPoint(/*emulateCCW=*/true);
             Base::Vector3d end    = arc->getEndPoint(/*emulateCCW=*/true);
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
+            if (!edit->curveTessellations.reuse(GeoId, arc, countSegments, Coords)) {
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(startangle);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                    startangle += segment;
+                }
+
+                // end point
+                gp_Pnt pnt = curve->Value(endangle);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
-            }
 
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                edit->curveTessellations.store(GeoId, Coords);
+            }
 
             Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
@@ -4161,15 +4322,19 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             Base::Vector3d start  = arc->getStartPoint(/*emulateCCW=*/true);
             Base::Vector3d end    = arc->getEndPoint(/*emulateCCW=*/true);
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
+            if (!edit->curveTessellations.reuse(GeoId, arc, countSegments, Coords)) {
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(startangle);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                    startangle += segment;
+                }
+
+                // end point
+                gp_Pnt pnt = curve->Value(endangle);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
-            }
 
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                edit->curveTessellations.store(GeoId, Coords);
+            }
 
             Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
@@ -4197,15 +4362,19 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             Base::Vector3d start  = aoh->getStartPoint();
             Base::Vector3d end    = aoh->getEndPoint();
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
+            if (!edit->curveTessellations.reuse(GeoId, aoh, countSegments, Coords)) {
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(startangle);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                    startangle += segment;
+                }
+
+                // end point
+                gp_Pnt pnt = curve->Value(endangle);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
-            }
 
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                edit->curveTessellations.store(GeoId, Coords);
+            }
 
             Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
@@ -4233,15 +4402,19 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             Base::Vector3d start  = aop->getStartPoint();
             Base::Vector3d end    = aop->getEndPoint();
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
+            if (!edit->curveTessellations.reuse(GeoId, aop, countSegments, Coords)) {
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(startangle);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                    startangle += segment;
+                }
+
+                // end point
+                gp_Pnt pnt = curve->Value(endangle);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
-            }
 
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                edit->curveTessellations.store(GeoId, Coords);
+            }
 
             Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
@@ -4269,15 +4442,21 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             int countSegments = stdcountsegments;
             double segment = range / countSegments;
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(first);
-                Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                first += segment;
-            }
+            // the curvature comb scale is cached along with the polyline
+            double temprepscale = 0;
+            bool cached = edit->curveTessellations.reuse(GeoId, spline, countSegments, Coords, &temprepscale);
 
-            // end point
-            gp_Pnt end = curve->Value(last);
-            Coords.emplace_back(end.X(), end.Y(), end.Z());
+            if (!cached) {
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(first);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                    first += segment;
+                }
+
+                // end point
+                gp_Pnt end = curve->Value(last);
+                Coords.emplace_back(end.X(), end.Y(), end.Z());
+            }
 
             Index.push_back(countSegments+1);
             edit->CurvIdToGeoId.push_back(GeoId);
@@ -4286,68 +4465,73 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             edit->PointIdToGeoId.push_back(GeoId);
             edit->PointIdToGeoId.push_back(GeoId);
 
-            //***************************************************************************************************************
-            // global information gathering for geometry information layer
+            if (!cached) {
+                //***************************************************************************************************************
+                // global information gathering for geometry information layer
 
-            std::vector<Base::Vector3d> poles = spline->getPoles();
+                std::vector<Base::Vector3d> poles = spline->getPoles();
 
-            Base::Vector3d midp = Base::Vector3d(0,0,0);
+                Base::Vector3d midp = Base::Vector3d(0,0,0);
 
-            for (std::vector<Base::Vector3d>::iterator it = poles.begin(); it != poles.end(); ++it) {
-                midp += (*it);
-            }
+                for (std::vector<Base::Vector3d>::iterator it = poles.begin(); it != poles.end(); ++it) {
+                    midp += (*it);
+                }
 
-            midp /= poles.size();
+                midp /= poles.size();
 
-            double firstparam = spline->getFirstParameter();
-            double lastparam =  spline->getLastParameter();
+                double firstparam = spline->getFirstParameter();
+                double lastparam =  spline->getLastParameter();
 
-            const int ndiv = poles.size()>4?poles.size()*16:64;
-            double step = (lastparam - firstparam ) / (ndiv -1);
+                const int ndiv = poles.size()>4?poles.size()*16:64;
+                double step = (lastparam - firstparam ) / (ndiv -1);
 
-            std::vector<double> paramlist(ndiv);
-            std::vector<Base::Vector3d> pointatcurvelist(ndiv);
-            std::vector<double> curvaturelist(ndiv);
-            std::vector<Base::Vector3d> normallist(ndiv);
+                std::vector<double> paramlist(ndiv);
+                std::vector<Base::Vector3d> pointatcurvelist(ndiv);
+                std::vector<double> curvaturelist(ndiv);
+                std::vector<Base::Vector3d> normallist(ndiv);
 
-            double maxcurv = 0;
-            double maxdisttocenterofmass = 0;
+                double maxcurv = 0;
+                double maxdisttocenterofmass = 0;
 
-            for (int i = 0; i < ndiv; i++) {
-                paramlist[i] = firstparam + i * step;
-                pointatcurvelist[i] = spline->pointAtParameter(paramlist[i]);
+                for (int i = 0; i < ndiv; i++) {
+                    paramlist[i] = firstparam + i * step;
+                    pointatcurvelist[i] = spline->pointAtParameter(paramlist[i]);
 
-                try {
-                    curvaturelist[i] = spline->curvatureAt(paramlist[i]);
-                }
-                catch(Base::CADKernelError &e) {
-                    // it is "just" a visualisation matter OCC could not calculate the curvature
-                    // terminating here would mean that the other shapes would not be drawn.
-                    // Solution: Report the issue and set dummy curvature to 0
-                    e.ReportException();
-                    Base::Console().Error("Curvature graph for B-Spline with GeoId=%d could not be calculated.\n", GeoId);
-                    curvaturelist[i] = 0;
-                }
+                    try {
+                        curvaturelist[i] = spline->curvatureAt(paramlist[i]);
+                    }
+                    catch(Base::CADKernelError &e) {
+                        // it is "just" a visualisation matter OCC could not calculate the curvature
+                        // terminating here would mean that the other shapes would not be drawn.
+                        // Solution: Report the issue and set dummy curvature to 0
+                        e.ReportException();
+                        Base::Console().Error("Curvature graph for B-Spline with GeoId=%d could not be calculated.\n", GeoId);
+                        curvaturelist[i] = 0;
+                    }
 
-                if (curvaturelist[i] > maxcurv)
-                    maxcurv = curvaturelist[i];
+                    if (curvaturelist[i] > maxcurv)
+                        maxcurv = curvaturelist[i];
 
-                double tempf = ( pointatcurvelist[i] - midp ).Length();
+                    double tempf = ( pointatcurvelist[i] - midp ).Length();
 
-                if (tempf > maxdisttocenterofmass)
-                    maxdisttocenterofmass = tempf;
+                    if (tempf > maxdisttocenterofmass)
+                        maxdisttocenterofmass = tempf;
 
-            }
+                }
 
-            double temprepscale = 0;
-            if (maxcurv > 0)
-                temprepscale = (0.5 * maxdisttocenterofmass) / maxcurv; // just a factor to make a comb reasonably visible
+                if (maxcurv > 0)
+                    temprepscale = (0.5 * maxdisttocenterofmass) / maxcurv; // just a factor to make a comb reasonably visible
+
+                edit->curveTessellations.store(GeoId, Coords, temprepscale);
+            }
 
             if (temprepscale > combrepscale)
                 combrepscale = temprepscale;
         }
     }
 
+    edit->curveTessellations.finish();
+
     if ( (combrepscale > (2 * combrepscalehyst)) || (combrepscale < (combrepscalehyst/2)))
         combrepscalehyst = combrepscale ;
 
@@ -4814,33 +4998,48 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
     edit->PointsCoordinate->point.setNum(Points.size());
     edit->PointsMaterials->diffuseColor.setNum(Points.size());
 
-    SbVec3f *verts = edit->CurvesCoordinate->point.startEditing();
-    int32_t *index = edit->CurveSet->numVertices.startEditing();
-    SbVec3f *pverts = edit->PointsCoordinate->point.startEditing();
-
     float dMg = 100;
 
-    int i=0; // setting up the line set
-    for (std::vector<Base::Vector3d>::const_iterator it = Coords.begin(); it != Coords.end(); ++it,i++) {
-        dMg = dMg>std::abs(it->x)?dMg:std::abs(it->x);
-        dMg = dMg>std::abs(it->y)?dMg:std::abs(it->y);
-        verts[i].setValue(it->x,it->y,zLowLines);
-    }
+    // Only the values differing from the previous draw are written. A field without any change is
+    // not edited at all, so that Coin does not notify and re-render it.
+    auto updateCoordinates = [&dMg](SoMFVec3f &field, const std::vector<Base::Vector3d> &coords, float z) {
+        const SbVec3f *current = field.getValues(0);
+        SbVec3f *verts = nullptr;
+        int i=0;
+        for (std::vector<Base::Vector3d>::const_iterator it = coords.begin(); it != coords.end(); ++it,i++) {
+            dMg = dMg>std::abs(it->x)?dMg:std::abs(it->x);
+            dMg = dMg>std::abs(it->y)?dMg:std::abs(it->y);
+            SbVec3f vert(it->x,it->y,z);
+            if (!verts) {
+                if (current[i] == vert)
+                    continue;
+                verts = field.startEditing();
+            }
+            verts[i] = vert;
+        }
+        if (verts)
+            field.finishEditing();
+    };
 
-    i=0; // setting up the indexes of the line set
-    for (std::vector<unsigned int>::const_iterator it = Index.begin(); it != Index.end(); ++it,i++)
-        index[i] = *it;
+    // setting up the line set
+    updateCoordinates(edit->CurvesCoordinate->point, Coords, zLowLines);
 
-    i=0; // setting up the point set
-    for (std::vector<Base::Vector3d>::const_iterator it = Points.begin(); it != Points.end(); ++it,i++){
-        dMg = dMg>std::abs(it->x)?dMg:std::abs(it->x);
-        dMg = dMg>std::abs(it->y)?dMg:std::abs(it->y);
-        pverts[i].setValue(it->x,it->y,zLowPoints);
+    // setting up the indexes of the line set
+    const int32_t *currentIndex = edit->CurveSet->numVertices.getValues(0);
+    int i=0;
+    for (; i < int(Index.size()); i++) {
+        if (currentIndex[i] != int32_t(Index[i]))
+            break;
+    }
+    if (i < int(Index.size())) {
+        int32_t *index = edit->CurveSet->numVertices.startEditing();
+        for (; i < int(Index.size()); i++)
+            index[i] = Index[i];
+        edit->CurveSet->numVertices.finishEditing();
     }
 
-    edit->CurvesCoordinate->point.finishEditing();
-    edit->CurveSet->numVertices.finishEditing();
-    edit->PointsCoordinate->point.finishEditing();
+    // setting up the point set
+    updateCoordinates(edit->PointsCoordinate->point, Points, zLowPoints);
 
     // set cross coordinates
     edit->RootCrossSet->numVertices.set1Value(0,2);
@@ -5916,6 +6115,7 @@ void ViewProviderSketch::rebuildConstraintsVisual(void)
     // clean up
     Gui::coinRemoveAllChildren(edit->constrGroup);
     edit->vConstrType.clear();
+    edit->constrIconKeys.clear();
 
     for (std::vector<Sketcher::Constraint *>::const_iterator it=constrlist.begin(); it != constrlist.end(); ++it) {
         // root separator for one constraint
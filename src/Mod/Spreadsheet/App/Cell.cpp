@@ -701,17 +701,39 @@ void Cell::moveAbsolute(CellAddress newAddress)
   *
   */
 
+const char * const Cell::persistentAttributes[Cell::numPersistentAttributes] = {
+    "content", "style", "alignment", "foregroundColor", "backgroundColor",
+    "displayUnit", "alias", "rowSpan", "colSpan"
+};
+
 void Cell::restore(Base::XMLReader &reader, bool checkAlias)
 {
-    const char* style = reader.hasAttribute("style") ? reader.getAttribute("style") : 0;
-    const char* alignment = reader.hasAttribute("alignment") ? reader.getAttribute("alignment") : 0;
-    const char* content = reader.hasAttribute("content") ? reader.getAttribute("content") : "";
-    const char* foregroundColor = reader.hasAttribute("foregroundColor") ? reader.getAttribute("foregroundColor") : 0;
-    const char* backgroundColor = reader.hasAttribute("backgroundColor") ? reader.getAttribute("backgroundColor") : 0;
-    const char* displayUnit = reader.hasAttribute("displayUnit") ? reader.getAttribute("displayUnit") : 0;
-    const char* alias = reader.hasAttribute("alias") ? reader.getAttribute("alias") : 0;
-    const char* rowSpan = reader.hasAttribute("rowSpan") ? reader.getAttribute("rowSpan") : 0;
-    const char* colSpan = reader.hasAttribute("colSpan") ? reader.getAttribute("colSpan") : 0;
+    const char* values[numPersistentAttributes];
+    for (int i = 0; i < numPersistentAttributes; ++i) {
+        const char* name = persistentAttributes[i];
+        values[i] = reader.hasAttribute(name) ? reader.getAttribute(name) : 0;
+    }
+
+    restore(values, checkAlias);
+}
+
+/**
+  * Restore cell contents from the encoded attribute \a values, e.g. from the
+  * binary cell data of PropertySheet.
+  *
+  */
+
+void Cell::restore(const char * const values[numPersistentAttributes], bool checkAlias)
+{
+    const char* content = values[0] ? values[0] : "";
+    const char* style = values[1];
+    const char* alignment = values[2];
+    const char* foregroundColor = values[3];
+    const char* backgroundColor = values[4];
+    const char* displayUnit = values[5];
+    const char* alias = values[6];
+    const char* rowSpan = values[7];
+    const char* colSpan = values[8];
 
     // Don't trigger multiple updates below; wait until everything is loaded by calling unfreeze() below.
     PropertySheet::AtomicPropertyChange signaller(*owner);
@@ -820,6 +842,60 @@ void Cell::save(std::ostream &os, const char *indent, bool noContent) const {
         os << std::endl;
 }
 
+/**
+  * Get the value of the persistent attribute \a index encoded like save() does.
+  *
+  */
+
+bool Cell::getPersistentAttribute(int index, std::string &value) const
+{
+    switch (index) {
+    case 0:
+        if (!isUsed(EXPRESSION_SET))
+            return false;
+        getStringContent(value, true);
+        return true;
+    case 1:
+        if (!isUsed(STYLE_SET))
+            return false;
+        value = encodeStyle(style);
+        return true;
+    case 2:
+        if (!isUsed(ALIGNMENT_SET))
+            return false;
+        value = encodeAlignment(alignment);
+        return true;
+    case 3:
+        if (!isUsed(FOREGROUND_COLOR_SET))
+            return false;
+        value = encodeColor(foregroundColor);
+        return true;
+    case 4:
+        if (!isUsed(BACKGROUND_COLOR_SET))
+            return false;
+        value = encodeColor(backgroundColor);
+        return true;
+    case 5:
+        if (!isUsed(DISPLAY_UNIT_SET))
+            return false;
+        value = displayUnit.stringRep;
+        return true;
+    case 6:
+        if (!isUsed(ALIAS_SET))
+            return false;
+        value = alias;
+        return true;
+    case 7:
+    case 8:
+        if (!isUsed(SPANS_SET))
+            return false;
+        value = std::to_string(index == 7 ? rowSpan : colSpan);
+        return true;
+    default:
+        return false;
+    }
+}
+
 /**
   * Update the \a used member variable with mask (bitwise or'ed).
   *
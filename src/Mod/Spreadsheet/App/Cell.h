@@ -105,6 +105,16 @@ public:
 
     void restore(Base::XMLReader &reader, bool checkAlias=false);
 
+    /* Persistent attributes, in the order of persistentAttributes */
+    static const int numPersistentAttributes = 9;
+    static const char * const persistentAttributes[numPersistentAttributes];
+
+    /// Restores the cell from the encoded attribute values, a null pointer for those not set
+    void restore(const char * const values[numPersistentAttributes], bool checkAlias=false);
+
+    /// Gets the encoded value of a persistent attribute as it is saved, returns false if it is not set
+    bool getPersistentAttribute(int index, std::string &value) const;
+
     void afterRestore();
 
     void save(Base::Writer &writer) const;
@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <unordered_map>
 #endif
 
 #include <boost/range/adaptor/map.hpp>
@@ -31,11 +32,14 @@
 #include <boost_bind_bind.hpp>
 #include <boost/regex.hpp>
 #include <Base/Console.h>
+#include <Base/Exception.h>
+#include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObject.h>
 #include <App/Property.h>
 #include <Base/Writer.h>
 #include <Base/Reader.h>
+#include <Base/Stream.h>
 #include <Base/Tools.h>
 #include <Base/PyObjectBase.h>
 #include "PropertySheet.h"
@@ -73,6 +77,8 @@ void PropertySheet::clear()
     cellToPropertyNameMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
+    cellToDependantCellMap.clear();
+    cellToDependencyCellMap.clear();
     aliasProp.clear();
     revAliasProp.clear();
 
@@ -200,6 +206,8 @@ PropertySheet::PropertySheet(const PropertySheet &other)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
+    , cellToDependantCellMap(other.cellToDependantCellMap)
+    , cellToDependencyCellMap(other.cellToDependencyCellMap)
     , aliasProp(other.aliasProp)
     , revAliasProp(other.revAliasProp)
     , updateCount(other.updateCount)
@@ -286,17 +294,30 @@ void PropertySheet::Save(Base::Writer &writer) const
         ++ci;
     }
 
-    writer.Stream() << writer.ind() << "<Cells Count=\"" << count
-        << "\" xlink=\"1\">" << std::endl;
+    // Large sheets can be saved as binary cell data to keep Document.xml small
+    // and fast to load. The cells are left out of the XML in this case, so
+    // older versions load the sheet without cells instead of failing.
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Spreadsheet");
+    long threshold = hGrp->GetInt("BinaryCellThreshold", 0);
+    bool binary = !writer.isForceXML() && threshold > 0 && count >= threshold;
+
+    writer.Stream() << writer.ind() << "<Cells Count=\"" << (binary ? 0 : count)
+        << "\" xlink=\"1\"";
+    if (binary)
+        writer.Stream() << " file=\"" << writer.addFile("Cells.bin", this) << "\"";
+    writer.Stream() << ">" << std::endl;
 
     writer.incInd();
 
     PropertyExpressionContainer::Save(writer);
 
-    ci = data.begin();
-    while (ci != data.end()) {
-        ci->second->save(writer);
-        ++ci;
+    if (!binary) {
+        ci = data.begin();
+        while (ci != data.end()) {
+            ci->second->save(writer);
+            ++ci;
+        }
     }
 
     writer.decInd();
@@ -337,10 +358,123 @@ void PropertySheet::Restore(Base::XMLReader &reader)
         catch (...) {
         }
     }
+
+    if (reader.hasAttribute("file")) {
+        std::string file(reader.getAttribute("file"));
+        if (!file.empty())
+            reader.addFile(file.c_str(), this);
+    }
+
     reader.readEndElement("Cells");
     signaller.tryInvoke();
 }
 
+/*
+ * The binary cell data is stored by column: the addresses of all cells, then
+ * for each persistent attribute of Cell an index per cell into a table of the
+ * distinct attribute values. Styles, colors and units are shared by many cells
+ * and are only stored once this way.
+ */
+
+void PropertySheet::SaveDocFile (Base::Writer &writer) const
+{
+    std::vector<const Cell*> cells;
+    for (const auto &d : data) {
+        if (d.second->isUsed())
+            cells.push_back(d.second);
+    }
+
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> stringIndex;
+    std::vector<uint32_t> columns(Cell::numPersistentAttributes * cells.size(), 0);
+    std::string value;
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        for (int attr = 0; attr < Cell::numPersistentAttributes; ++attr) {
+            if (!cells[i]->getPersistentAttribute(attr, value))
+                continue;
+            auto res = stringIndex.emplace(value, static_cast<uint32_t>(strings.size() + 1));
+            if (res.second)
+                strings.push_back(value);
+            columns[attr * cells.size() + i] = res.first->second;
+        }
+    }
+
+    Base::OutputStream str(writer.Stream());
+    str << static_cast<uint32_t>(1) << static_cast<uint32_t>(cells.size());
+    for (const auto cell : cells)
+        str << static_cast<uint32_t>(cell->getAddress().asInt());
+    str << static_cast<uint32_t>(strings.size());
+    for (const auto &s : strings) {
+        str << static_cast<uint32_t>(s.size());
+        writer.Stream().write(s.c_str(), s.size());
+    }
+    for (auto index : columns)
+        str << index;
+}
+
+void PropertySheet::RestoreDocFile(Base::Reader &reader)
+{
+    Base::InputStream str(reader);
+    uint32_t version = 0, count = 0;
+    str >> version >> count;
+    if (version != 1) {
+        FC_ERR("Unsupported cell data version " << version << " in " << getFullName());
+        return;
+    }
+
+    std::vector<uint32_t> addresses(count);
+    for (auto &address : addresses)
+        str >> address;
+
+    uint32_t numStrings = 0;
+    str >> numStrings;
+    std::vector<std::string> strings(numStrings);
+    for (auto &s : strings) {
+        uint32_t size = 0;
+        str >> size;
+        s.resize(size);
+        reader.read(&s[0], size);
+    }
+
+    std::vector<uint32_t> columns(Cell::numPersistentAttributes * count);
+    for (auto &index : columns)
+        str >> index;
+    if (!reader)
+        throw Base::FileException("Failed to read cell data", reader.getFileName().c_str());
+
+    // Like for the XML cells, the expressions are only parsed in afterRestore()
+    Base::ObjectStatusLocker<App::ObjectStatus, App::DocumentObject> restoreBit(
+            App::ObjectStatus::Restore, owner);
+    AtomicPropertyChange signaller(*this);
+
+    const char* values[Cell::numPersistentAttributes];
+    for (uint32_t i = 0; i < count; ++i) {
+        for (int attr = 0; attr < Cell::numPersistentAttributes; ++attr) {
+            uint32_t index = columns[attr * count + i];
+            values[attr] = index > 0 && index <= numStrings ? strings[index - 1].c_str() : 0;
+        }
+
+        try {
+            CellAddress address(static_cast<int>(addresses[i] >> 16),
+                                static_cast<int>(addresses[i] & 0xffff));
+            Cell * cell = createCell(address);
+
+            cell->restore(values);
+
+            int rows, cols;
+            if (cell->getSpans(rows, cols) && (rows > 1 || cols > 1)) {
+                mergeCells(address, CellAddress(address.row() + rows - 1, address.col() + cols - 1));
+            }
+        }
+        catch (const Base::Exception &) {
+            // Something is wrong, skip this cell
+        }
+        catch (...) {
+        }
+    }
+    signaller.tryInvoke();
+}
+
 void PropertySheet::copyCells(Base::Writer &writer, const std::vector<Range> &ranges) const {
     writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << std::endl;
     writer.Stream() << "<Cells count=\"" << ranges.size() << "\">" << std::endl;
@@ -1053,8 +1187,16 @@ void PropertySheet::addDependencies(CellAddress key)
             propertyNameToCellMap[propName].insert(key);
             cellToPropertyNameMap[key].insert(propName);
 
-            // Also an alias?
             if (docObj==owner && props.first.size()) {
+                // Direct reference to another cell of this sheet?
+                CellAddress addr = App::stringToAddress(props.first.c_str(), true);
+                if (addr.isValid() && addr.toString() == props.first) {
+                    addr = CellAddress(addr.row(), addr.col());
+                    cellToDependantCellMap[addr].insert(key);
+                    cellToDependencyCellMap[key].insert(addr);
+                }
+
+                // Also an alias?
                 std::map<std::string, CellAddress>::const_iterator j = revAliasProp.find(props.first);
 
                 if (j != revAliasProp.end()) {
@@ -1064,6 +1206,8 @@ void PropertySheet::addDependencies(CellAddress key)
                     // Insert into maps
                     propertyNameToCellMap[propName].insert(key);
                     cellToPropertyNameMap[key].insert(propName);
+                    cellToDependantCellMap[j->second].insert(key);
+                    cellToDependencyCellMap[key].insert(j->second);
                 }
             }
         }
@@ -1099,6 +1243,20 @@ void PropertySheet::removeDependencies(CellAddress key)
         cellToPropertyNameMap.erase(i1);
     }
 
+    auto i3 = cellToDependencyCellMap.find(key);
+
+    if (i3 != cellToDependencyCellMap.end()) {
+        for (auto &addr : i3->second) {
+            auto k = cellToDependantCellMap.find(addr);
+            if (k != cellToDependantCellMap.end()) {
+                k->second.erase(key);
+                if (k->second.empty())
+                    cellToDependantCellMap.erase(k);
+            }
+        }
+        cellToDependencyCellMap.erase(i3);
+    }
+
     /* Remove from DocumentObject <-> Key maps */
 
     std::map<CellAddress, std::set< std::string > >::iterator i2 = cellToDocumentObjectMap.find(key);
@@ -1278,6 +1436,17 @@ const std::set<CellAddress> &PropertySheet::getDeps(const std::string &name) con
         return empty;
 }
 
+const std::set<CellAddress> &PropertySheet::getCellDependants(CellAddress pos) const
+{
+    static std::set<CellAddress> empty;
+    auto it = cellToDependantCellMap.find(pos);
+
+    if (it != cellToDependantCellMap.end())
+        return it->second;
+    else
+        return empty;
+}
+
 const std::set<std::string> &PropertySheet::getDeps(CellAddress pos) const
 {
     static std::set<std::string> empty;
@@ -72,6 +72,10 @@ public:
 
     virtual void Restore(Base::XMLReader & reader) override;
 
+    virtual void SaveDocFile (Base::Writer & writer) const override;
+
+    virtual void RestoreDocFile(Base::Reader & reader) override;
+
     void copyCells(Base::Writer &writer, const std::vector<App::Range> &ranges) const;
 
     void pasteCells(Base::XMLReader &reader, const App::CellAddress &addr);
@@ -156,6 +160,9 @@ public:
 
     const std::set<std::string> &getDeps(App::CellAddress pos) const;
 
+    /// Return the cells of this sheet that depend on the cell at \a pos
+    const std::set<App::CellAddress> &getCellDependants(App::CellAddress pos) const;
+
     void recomputeDependencies(App::CellAddress key);
 
     PyObject *getPyObject(void) override;
@@ -251,6 +258,14 @@ private:
     /*! DocumentObject this cell depends on */
     std::map<App::CellAddress, std::set< std::string > > cellToDocumentObjectMap;
 
+    /*! Same as propertyNameToCellMap restricted to cells of this sheet,
+      keyed by address to avoid building property names while recomputing.
+      */
+    std::map<App::CellAddress, std::set< App::CellAddress > > cellToDependantCellMap;
+
+    /*! Cells of this sheet this cell depends on */
+    std::map<App::CellAddress, std::set< App::CellAddress > > cellToDependencyCellMap;
+
     /*! Mapping of cell position to alias property */
     std::map<App::CellAddress, std::string> aliasProp;
 
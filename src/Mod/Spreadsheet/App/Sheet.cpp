@@ -369,6 +369,25 @@ void Sheet::setCell(CellAddress address, const char * value)
     setContent(address, value);
 }
 
+/**
+  * Set the contents of several cells at once. The cells are changed inside a
+  * single property change, so that observers are notified only once, and the
+  * affected cells are recomputed together on the next recompute.
+  *
+  * @param contents   Map of cell address to string value of expression.
+  *
+  */
+
+void Sheet::setCells(const std::map<CellAddress, std::string> &contents)
+{
+    PropertySheet::AtomicPropertyChange signaller(cells);
+
+    for (auto &v : contents)
+        setCell(v.first, v.second.c_str());
+
+    signaller.tryInvoke();
+}
+
 /**
   * Get the Python object for the Sheet.
   *
@@ -817,9 +836,12 @@ DocumentObjectExecReturn *Sheet::execute(void)
          dirtyCells.insert(*i);
     }
 
+    // Collect the dirty cells and everything downstream of them. The
+    // dependants are looked up by address in the dependency maps kept by
+    // PropertySheet, so only the affected part of the sheet is visited.
     DependencyList graph;
     std::map<CellAddress, Vertex> VertexList;
-    std::map<Vertex, CellAddress> VertexIndexList;
+    std::vector<CellAddress> VertexIndexList;
     std::deque<CellAddress> workQueue(dirtyCells.begin(),dirtyCells.end());
     while(workQueue.size()) {
         CellAddress currPos = workQueue.front();
@@ -829,7 +851,7 @@ DocumentObjectExecReturn *Sheet::execute(void)
         auto res = VertexList.emplace(currPos,Vertex());
         if(res.second) {
             res.first->second = add_vertex(graph);
-            VertexIndexList[res.first->second] = currPos;
+            VertexIndexList.push_back(currPos);
         }
 
         // Process cells that depend on the current cell
@@ -837,7 +859,7 @@ DocumentObjectExecReturn *Sheet::execute(void)
             auto resDep = VertexList.emplace(dep,Vertex());
             if(resDep.second) {
                 resDep.first->second = add_vertex(graph);
-                VertexIndexList[resDep.first->second] = dep;
+                VertexIndexList.push_back(dep);
                 if(dirtyCells.insert(dep).second)
                     workQueue.push_back(dep);
             }
@@ -1382,9 +1404,9 @@ void Sheet::providesTo(CellAddress address, std::set<std::string> & result) cons
  * @param result Set of links.
  */
 
-std::set<CellAddress>  Sheet::providesTo(CellAddress address) const
+const std::set<CellAddress> &Sheet::providesTo(CellAddress address) const
 {
-    return cells.getDeps(getFullName()+"."+address.toString());
+    return cells.getCellDependants(address);
 }
 
 void Sheet::onDocumentRestored()
@@ -100,6 +100,8 @@ public:
 
     void setCell(App::CellAddress address, const char *value);
 
+    void setCells(const std::map<App::CellAddress, std::string> &contents);
+
     void clearAll();
 
     void clear(App::CellAddress address, bool all = true);
@@ -193,7 +195,7 @@ protected:
 
     void updateColumnsOrRows(bool horizontal, int section, int count) ;
 
-    std::set<App::CellAddress> providesTo(App::CellAddress address) const;
+    const std::set<App::CellAddress> &providesTo(App::CellAddress address) const;
 
     void onDocumentRestored();
 
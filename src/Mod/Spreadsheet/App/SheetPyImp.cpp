@@ -89,6 +89,51 @@ PyObject* SheetPy::set(PyObject *args)
     Py_Return;
 }
 
+PyObject* SheetPy::setCells(PyObject *args)
+{
+    PyObject *dict;
+
+    if (!PyArg_ParseTuple(args, "O!:setCells", &PyDict_Type, &dict))
+        return 0;
+
+    try {
+        Sheet * sheet = getSheetPtr();
+        std::map<CellAddress, std::string> contents;
+        Py::Dict pyDict(dict);
+
+        for (Py::Dict::iterator it = pyDict.begin(); it != pyDict.end(); ++it) {
+            Py::Object key((*it).first);
+            Py::Object value((*it).second);
+            if (!key.isString() || !value.isString()) {
+                PyErr_SetString(PyExc_TypeError, "Expected a dict of strings");
+                return 0;
+            }
+            std::string address = Py::String(key).as_std_string("utf-8");
+            std::string text = Py::String(value).as_std_string("utf-8");
+
+            /* Check to see if address is really an alias first */
+            std::string cellAddress = sheet->getAddressFromAlias(address);
+            if (cellAddress.size() > 0)
+                contents[CellAddress(cellAddress)] = text;
+            else {
+                Range rangeIter(address);
+
+                do {
+                    contents[*rangeIter] = text;
+                } while (rangeIter.next());
+            }
+        }
+
+        sheet->setCells(contents);
+    }
+    catch (const Base::Exception & e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+        return 0;
+    }
+
+    Py_Return;
+}
+
 PyObject* SheetPy::get(PyObject *args)
 {
     char *address;
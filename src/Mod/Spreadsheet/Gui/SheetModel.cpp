@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <QtCore>
 # include <QApplication>
 # include <QLocale>
@@ -147,7 +148,57 @@ static std::string getUnitString(const Base::Unit & unit)
 }
 #endif
 
+static int cachedRole(int role)
+{
+    switch (role) {
+    case Qt::DisplayRole:
+        return 0;
+    case Qt::ToolTipRole:
+        return 1;
+    case Qt::FontRole:
+        return 2;
+    case Qt::TextAlignmentRole:
+        return 3;
+    case Qt::BackgroundRole:
+        return 4;
+    case Qt::ForegroundRole:
+        return 5;
+    default:
+        return -1;
+    }
+}
+
 QVariant SheetModel::data(const QModelIndex &index, int role) const
+{
+    // Formatting the values is too slow to be done on every repaint, so the roles
+    // needed for painting are cached for the existing cells. Empty cells are cheap
+    // and not cached to keep the cache as small as the sheet.
+    int slot = cachedRole(role);
+    if (slot < 0)
+        return cellData(index, role);
+
+    CellAddress address(index.row(), index.column());
+    auto it = cache.find(address.asInt());
+    if (it == cache.end()) {
+        if (!sheet->getCell(address))
+            return cellData(index, role);
+        it = cache.emplace(address.asInt(), CellCache()).first;
+    }
+
+    CellCache &entry = it->second;
+    if (!(entry.valid & (1 << slot))) {
+        entry.roles[slot] = cellData(index, role);
+        entry.valid |= 1 << slot;
+    }
+    return entry.roles[slot];
+}
+
+void SheetModel::clearCache()
+{
+    cache.clear();
+}
+
+QVariant SheetModel::cellData(const QModelIndex &index, int role) const
 {
     static const Cell * emptyCell = new Cell(CellAddress(0, 0), 0);
     int row = index.row();
@@ -557,9 +608,30 @@ Qt::ItemFlags SheetModel::flags(const QModelIndex & /*index*/) const
 
 void SheetModel::cellUpdated(CellAddress address)
 {
-    QModelIndex i = index(address.row(), address.col());
+    cache.erase(address.asInt());
+
+    // A recompute updates many cells at once, they are reported with a single
+    // dataChanged signal when the event loop is back.
+    if (!updatePending) {
+        updatePending = true;
+        updateTop = updateBottom = address.row();
+        updateLeft = updateRight = address.col();
+        QMetaObject::invokeMethod(this, "flushUpdates", Qt::QueuedConnection);
+    }
+    else {
+        updateTop = std::min(updateTop, address.row());
+        updateBottom = std::max(updateBottom, address.row());
+        updateLeft = std::min(updateLeft, address.col());
+        updateRight = std::max(updateRight, address.col());
+    }
+}
 
-    dataChanged(i, i);
+void SheetModel::flushUpdates()
+{
+    if (!updatePending)
+        return;
+    updatePending = false;
+    dataChanged(index(updateTop, updateLeft), index(updateBottom, updateRight));
 }
 
 #include "moc_SheetModel.cpp"
@@ -23,6 +23,7 @@
 #ifndef SHEETMODEL_H
 #define SHEETMODEL_H
 
+#include <unordered_map>
 #include <QAbstractTableModel>
 #include <Mod/Spreadsheet/App/Utils.h>
 #include <App/Range.h>
@@ -48,9 +49,27 @@ public:
     bool setData(const QModelIndex &index, const QVariant &value, int role);
     Qt::ItemFlags flags(const QModelIndex &) const;
 
+    /// Forgets the cached roles of all cells, e.g. after the style of a cell has changed
+    void clearCache();
+
+private Q_SLOTS:
+    void flushUpdates();
+
 private:
+    QVariant cellData(const QModelIndex &index, int role) const;
     void cellUpdated(App::CellAddress address);
 
+    /// The roles needed to paint a cell, computed once until the cell is updated
+    struct CellCache {
+        unsigned int valid = 0;
+        QVariant roles[6];
+    };
+    mutable std::unordered_map<unsigned int, CellCache> cache;
+
+    // the cells updated since the last dataChanged signal
+    bool updatePending = false;
+    int updateTop, updateLeft, updateBottom, updateRight;
+
     boost::signals2::scoped_connection cellUpdatedConnection;
     Spreadsheet::Sheet * sheet;
     QColor aliasBgColor;
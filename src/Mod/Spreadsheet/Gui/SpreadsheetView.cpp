@@ -406,6 +406,9 @@ void SheetView::updateCell(const App::Property *prop)
             QString cap = QString::fromUtf8(sheet->Label.getValue());
             setWindowTitle(cap);
         }
+        // style changes of a cell are only reported through the cells property
+        if (prop == sheet->getCells())
+            model->clearCache();
         CellAddress address;
 
         if(!sheet->getCellAddress(prop, address))
@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
 #include <BRepFill_Filling.hxx>
@@ -112,10 +113,59 @@ short Filling::mustExecute() const
         MaximumDegree.isTouched() ||
         MaximumSegments.isTouched())
         return 1;
+    if (previewShape && !preview)
+        return 1;
     return 0;
 }
 
-void Filling::addConstraints(BRepFill_Filling& builder,
+void Filling::onChanged(const App::Property* prop)
+{
+    if (prop == &BoundaryEdges ||
+        prop == &BoundaryFaces ||
+        prop == &BoundaryOrder ||
+        prop == &UnboundEdges ||
+        prop == &UnboundFaces ||
+        prop == &UnboundOrder ||
+        prop == &FreeFaces ||
+        prop == &FreeOrder ||
+        prop == &Points ||
+        prop == &InitialFace) {
+        constraints.valid = false;
+    }
+    Part::Spline::onChanged(prop);
+}
+
+void Filling::setPreview(bool on)
+{
+    preview = on;
+    if (!on && previewShape)
+        touch();
+}
+
+// The shapes of all linked objects in the order of the link properties.
+// If any of them is recomputed its shape changes and the cached constraints
+// must be resolved again.
+std::vector<TopoDS_Shape> Filling::sourceShapes() const
+{
+    std::vector<TopoDS_Shape> shapes;
+    auto addShapes = [&shapes](const std::vector<App::DocumentObject*>& objs) {
+        for (auto obj : objs) {
+            if (obj && obj->getTypeId().isDerivedFrom(Part::Feature::getClassTypeId()))
+                shapes.push_back(static_cast<Part::Feature*>(obj)->Shape.getValue());
+            else
+                shapes.push_back(TopoDS_Shape());
+        }
+    };
+
+    addShapes(BoundaryEdges.getValues());
+    addShapes(UnboundEdges.getValues());
+    addShapes(FreeFaces.getValues());
+    addShapes(Points.getValues());
+    addShapes({InitialFace.getValue()});
+    return shapes;
+}
+
+void Filling::addConstraints(Constraints& data,
                              const App::PropertyLinkSubList& edges,
                              const App::PropertyStringList& faces,
                              const App::PropertyIntegerList& orders,
@@ -162,13 +212,13 @@ void Filling::addConstraints(BRepFill_Filling& builder,
                     if (subFace.empty()) {
                         if (!bnd) {
                             // not a boundary edge: safe to add it directly
-                            builder.Add(TopoDS::Edge(edge), cont, bnd);
+                            data.edges.push_back({edge, TopoDS_Shape(), cont, bnd});
                         }
                         else {
                             // boundary edge: try to add it to the test wire first
                             testWire.Add(TopoDS::Edge(edge));
                             if (testWire.IsDone()) {
-                                builder.Add(TopoDS::Edge(edge), cont, bnd);
+                                data.edges.push_back({edge, TopoDS_Shape(), cont, bnd});
                             }
                             else {
                                 Standard_Failure::Raise("Boundary edges must be added in a consecutive order");
@@ -180,13 +230,13 @@ void Filling::addConstraints(BRepFill_Filling& builder,
                         if (!face.IsNull() && face.ShapeType() == TopAbs_FACE) {
                             if (!bnd) {
                                 // not a boundary edge: safe to add it directly
-                                builder.Add(TopoDS::Edge(edge), TopoDS::Face(face), cont, bnd);
+                                data.edges.push_back({edge, face, cont, bnd});
                             }
                             else {
                                 // boundary edge: try to add it to the test wire first
                                 testWire.Add(TopoDS::Edge(edge));
                                 if (testWire.IsDone()) {
-                                    builder.Add(TopoDS::Edge(edge), TopoDS::Face(face), cont, bnd);
+                                    data.edges.push_back({edge, face, cont, bnd});
                                 }
                                 else {
                                     Standard_Failure::Raise("Boundary edges must be added in a consecutive order");
@@ -210,7 +260,7 @@ void Filling::addConstraints(BRepFill_Filling& builder,
 }
 
 // Add free support faces with their continuities
-void Filling::addConstraints(BRepFill_Filling& builder,
+void Filling::addConstraints(Constraints& data,
                              const App::PropertyLinkSubList& faces,
                              const App::PropertyIntegerList& orders)
 {
@@ -228,7 +278,7 @@ void Filling::addConstraints(BRepFill_Filling& builder,
                 TopoDS_Shape face = shape.getSubShape(sub.c_str());
                 if (!face.IsNull() && face.ShapeType() == TopAbs_FACE) {
                     GeomAbs_Shape cont = static_cast<GeomAbs_Shape>(contvals[index]);
-                    builder.Add(TopoDS::Face(face), cont);
+                    data.faces.push_back({face, cont});
                 }
                 else {
                     Standard_Failure::Raise("Sub-shape is not a face");
@@ -241,7 +291,7 @@ void Filling::addConstraints(BRepFill_Filling& builder,
     }
 }
 
-void Filling::addConstraints(BRepFill_Filling& builder,
+void Filling::addConstraints(Constraints& data,
                              const App::PropertyLinkSubList& pointsList)
 {
     auto points = pointsList.getSubListValues();
@@ -254,13 +304,29 @@ void Filling::addConstraints(BRepFill_Filling& builder,
                 TopoDS_Shape subShape = shape.getSubShape(jt.c_str());
                 if (!subShape.IsNull() && subShape.ShapeType() == TopAbs_VERTEX) {
                     gp_Pnt pnt = BRep_Tool::Pnt(TopoDS::Vertex(subShape));
-                    builder.Add(pnt);
+                    data.points.push_back(pnt);
                 }
             }
         }
     }
 }
 
+void Filling::addInitialFace(Constraints& data)
+{
+    App::DocumentObject* initFace = InitialFace.getValue();
+    if (initFace && initFace->getTypeId().isDerivedFrom(Part::Feature::getClassTypeId())) {
+        const Part::TopoShape& shape = static_cast<Part::Feature*>(initFace)->Shape.getShape();
+        std::vector<std::string> subNames = InitialFace.getSubValues();
+        for (auto it : subNames) {
+            TopoDS_Shape subShape = shape.getSubShape(it.c_str());
+            if (!subShape.IsNull() && subShape.ShapeType() == TopAbs_FACE) {
+                data.initFace = subShape;
+                break;
+            }
+        }
+    }
+}
+
 App::DocumentObjectExecReturn *Filling::execute(void)
 {
     //Assign Variables
@@ -275,44 +341,70 @@ App::DocumentObjectExecReturn *Filling::execute(void)
     unsigned int maxdeg = MaximumDegree.getValue();
     unsigned int maxseg = MaximumSegments.getValue();
 
-    try {
-        BRepFill_Filling builder(degree, ptsoncurve, numIter, anisotropy, tol2d,
-                                 tol3d, tolG1, tolG2, maxdeg, maxseg);
+    // a single iteration with fewer points is good enough to show the shape
+    // of the surface while editing
+    if (preview) {
+        numIter = std::min(numIter, 1u);
+        ptsoncurve = std::max(3u, ptsoncurve / 2);
+    }
 
+    try {
         if ((BoundaryEdges.getSize()) < 1) {
             return new App::DocumentObjectExecReturn("Border must have at least one curve defined.");
         }
 
-        // Load the initial surface if set
-        App::DocumentObject* initFace = InitialFace.getValue();
-        if (initFace && initFace->getTypeId().isDerivedFrom(Part::Feature::getClassTypeId())) {
-            const Part::TopoShape& shape = static_cast<Part::Feature*>(initFace)->Shape.getShape();
-            std::vector<std::string> subNames = InitialFace.getSubValues();
-            for (auto it : subNames) {
-                TopoDS_Shape subShape = shape.getSubShape(it.c_str());
-                if (!subShape.IsNull() && subShape.ShapeType() == TopAbs_FACE) {
-                    builder.LoadInitSurface(TopoDS::Face(subShape));
-                    break;
-                }
+        std::vector<TopoDS_Shape> sources = sourceShapes();
+        bool sameSources = std::equal(sources.begin(), sources.end(),
+                                      constraints.sources.begin(), constraints.sources.end(),
+                                      [](const TopoDS_Shape& s1, const TopoDS_Shape& s2) {
+                                          return s1.IsEqual(s2);
+                                      });
+        if (!constraints.valid || !sameSources) {
+            Constraints data;
+
+            // Load the initial surface if set
+            addInitialFace(data);
+
+            // Add the constraints of border curves/faces (bound)
+            addConstraints(data, BoundaryEdges, BoundaryFaces, BoundaryOrder, Standard_True);
+
+            // Add additional edge constraints if available (unbound)
+            if (UnboundEdges.getSize() > 0) {
+                addConstraints(data, UnboundEdges, UnboundFaces, UnboundOrder, Standard_False);
             }
-        }
 
-        // Add the constraints of border curves/faces (bound)
-        addConstraints(builder, BoundaryEdges, BoundaryFaces, BoundaryOrder, Standard_True);
+            // Add additional constraint on free faces
+            if (FreeFaces.getSize() > 0) {
+                addConstraints(data, FreeFaces, FreeOrder);
+            }
 
-        // Add additional edge constraints if available (unbound)
-        if (UnboundEdges.getSize() > 0) {
-            addConstraints(builder, UnboundEdges, UnboundFaces, UnboundOrder, Standard_False);
-        }
+            // App point constraints
+            if (Points.getSize() > 0) {
+                addConstraints(data, Points);
+            }
 
-        // Add additional constraint on free faces
-        if (FreeFaces.getSize() > 0) {
-            addConstraints(builder, FreeFaces, FreeOrder);
+            data.sources = sources;
+            data.valid = true;
+            constraints = std::move(data);
         }
 
-        // App point constraints
-        if (Points.getSize() > 0) {
-            addConstraints(builder, Points);
+        BRepFill_Filling builder(degree, ptsoncurve, numIter, anisotropy, tol2d,
+                                 tol3d, tolG1, tolG2, maxdeg, maxseg);
+
+        if (!constraints.initFace.IsNull()) {
+            builder.LoadInitSurface(TopoDS::Face(constraints.initFace));
+        }
+        for (const auto& it : constraints.edges) {
+            if (it.face.IsNull())
+                builder.Add(TopoDS::Edge(it.edge), it.order, it.bnd);
+            else
+                builder.Add(TopoDS::Edge(it.edge), TopoDS::Face(it.face), it.order, it.bnd);
+        }
+        for (const auto& it : constraints.faces) {
+            builder.Add(TopoDS::Face(it.face), it.order);
+        }
+        for (const auto& it : constraints.points) {
+            builder.Add(it);
         }
 
         //Build the face
@@ -324,6 +416,7 @@ App::DocumentObjectExecReturn *Filling::execute(void)
         //Return the face
         TopoDS_Face aFace = builder.Face();
         this->Shape.setValue(aFace);
+        previewShape = preview;
         return App::DocumentObject::StdReturn;
     }
     catch (Standard_Failure& e) {
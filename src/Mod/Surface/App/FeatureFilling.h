@@ -27,8 +27,9 @@
 #include <App/PropertyUnits.h>
 #include <App/PropertyLinks.h>
 #include <Mod/Part/App/FeaturePartSpline.h>
-
-class BRepFill_Filling;
+#include <GeomAbs_Shape.hxx>
+#include <gp_Pnt.hxx>
+#include <vector>
 
 namespace Surface
 {
@@ -72,17 +73,58 @@ public:
         return "SurfaceGui::ViewProviderFilling";
     }
 
+    /** Build with fewer iterations and points on curves while the feature
+     * is being edited interactively. Switching it off marks a preview shape
+     * for recomputation.
+     */
+    void setPreview(bool on);
+    bool isPreview() const {
+        return preview;
+    }
+
+protected:
+    void onChanged(const App::Property* prop);
+
 private:
-    void addConstraints(BRepFill_Filling& builder,
+    struct EdgeConstraint {
+        TopoDS_Shape edge;
+        TopoDS_Shape face;          // null if the edge has no support face
+        GeomAbs_Shape order;
+        Standard_Boolean bnd;
+    };
+    struct FaceConstraint {
+        TopoDS_Shape face;
+        GeomAbs_Shape order;
+    };
+    // Constraint geometry resolved from the link properties. It is kept as
+    // long as neither the links nor the linked shapes change so that editing
+    // only the algorithm parameters doesn't resolve the sub-shapes again.
+    struct Constraints {
+        TopoDS_Shape initFace;
+        std::vector<EdgeConstraint> edges;
+        std::vector<FaceConstraint> faces;
+        std::vector<gp_Pnt> points;
+        std::vector<TopoDS_Shape> sources;
+        bool valid = false;
+    };
+
+    std::vector<TopoDS_Shape> sourceShapes() const;
+    void addConstraints(Constraints& data,
                         const App::PropertyLinkSubList& edges,
                         const App::PropertyStringList& faces,
                         const App::PropertyIntegerList& orders,
                         Standard_Boolean bnd);
-    void addConstraints(BRepFill_Filling& builder,
+    void addConstraints(Constraints& data,
                         const App::PropertyLinkSubList& faces,
                         const App::PropertyIntegerList& orders);
-    void addConstraints(BRepFill_Filling& builder,
+    void addConstraints(Constraints& data,
                         const App::PropertyLinkSubList& points);
+    void addInitialFace(Constraints& data);
+
+private:
+    Constraints constraints;
+    bool preview = false;
+    bool previewShape = false;
 };
 
 } //Namespace Surface
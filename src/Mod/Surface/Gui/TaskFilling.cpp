@@ -366,6 +366,9 @@ void FillingPanel::open()
 {
     checkOpenCommand();
 
+    // recompute with a lower quality while the constraints are edited
+    editedObject->setPreview(true);
+
     // highlight the boundary edges
     this->vp->highlightReferences(ViewProviderFilling::Edge,
         editedObject->BoundaryEdges.getSubListValues(), true);
@@ -430,6 +433,7 @@ bool FillingPanel::accept()
     selectionMode = None;
     Gui::Selection().rmvSelectionGate();
 
+    editedObject->setPreview(false);
     if (editedObject->mustExecute())
         editedObject->recomputeFeature();
     if (!editedObject->isValid()) {
@@ -452,6 +456,8 @@ bool FillingPanel::accept()
 
 bool FillingPanel::reject()
 {
+    editedObject->setPreview(false);
+
     this->vp->highlightReferences(ViewProviderFilling::Edge,
         editedObject->BoundaryEdges.getSubListValues(), false);
 
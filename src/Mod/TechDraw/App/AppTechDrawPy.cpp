@@ -34,16 +34,22 @@
 #include <gp_Vec.hxx>
 #include <BRep_Builder.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
+#include <Standard_Failure.hxx>
+#include <sstream>
 
 #endif
 
+#include <QtConcurrentMap>
+
 #include <CXX/Extensions.hxx>
 #include <CXX/Objects.hxx>
 
 #include <Base/Console.h>
 #include <Base/PyObjectBase.h>
 #include <Base/Exception.h>
+#include <Base/FileInfo.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/Stream.h>
 #include <Base/Vector3D.h>
 #include <Base/VectorPy.h>
 
@@ -68,6 +74,7 @@
 #include "DrawViewDimension.h"
 #include "DrawPage.h"
 #include "DrawPagePy.h"
+#include "DrawSVGTemplate.h"
 #include "Geometry.h"
 #include "GeometryObject.h"
 #include "EdgeWalker.h"
@@ -80,6 +87,173 @@
 
 namespace TechDraw {
 //module level static C++ functions go here
+
+//! the edges of one view, grouped by line weight
+struct SvgViewEdges {
+    double x = 0.0;                     //position on the page in Svg coordinates
+    double y = 0.0;
+    std::vector<TopoDS_Shape> visible;
+    std::vector<TopoDS_Shape> hidden;
+};
+
+//! everything needed to write one page as Svg without touching the document
+struct SvgPageJob {
+    std::string filePath;
+    double width = 0.0;
+    double height = 0.0;
+    double thick = 0.0;
+    double thin = 0.0;
+    std::string templateSvg;
+    std::vector<SvgViewEdges> views;
+    std::string svg;
+    std::string error;
+};
+
+static SvgViewEdges collectSvgEdges(TechDraw::DrawViewPart* dvp)
+{
+    SvgViewEdges result;
+    TechDraw::GeometryObject* go = dvp->getGeometryObject();
+    if (go == nullptr) {
+        return result;
+    }
+    result.visible.push_back(go->getVisHard());
+    result.visible.push_back(go->getVisOutline());
+    if (dvp->SmoothVisible.getValue()) {
+        result.visible.push_back(go->getVisSmooth());
+    }
+    if (dvp->SeamVisible.getValue()) {
+        result.visible.push_back(go->getVisSeam());
+    }
+    if (dvp->HardHidden.getValue()) {
+        result.hidden.push_back(go->getHidHard());
+        result.hidden.push_back(go->getHidOutline());
+    }
+    if (dvp->SmoothHidden.getValue()) {
+        result.hidden.push_back(go->getHidSmooth());
+    }
+    if (dvp->SeamHidden.getValue()) {
+        result.hidden.push_back(go->getHidSeam());
+    }
+    return result;
+}
+
+//! only reads the shapes, so it can run outside the main thread
+static std::string svgEdgeGroups(const SvgViewEdges& edges, double thick, double thin)
+{
+    std::string grpHead1 = "<g fill=\"none\" stroke=\"#000000\" stroke-opacity=\"1\" stroke-width=\"";
+    std::string grpHead2 = "\" stroke-linecap=\"butt\" stroke-linejoin=\"miter\" stroke-miterlimit=\"4\">\n";
+    std::string grpTail  = "</g>\n";
+    Drawing::SVGOutput svgOut;
+    std::stringstream ss;
+    //visible group
+    ss << grpHead1 << thick << grpHead2;
+    for (auto& s: edges.visible) {
+        ss << svgOut.exportEdges(s);
+    }
+    ss << grpTail;
+    if (!edges.hidden.empty()) {
+        //hidden group
+        ss << grpHead1 << thin << grpHead2;
+        for (auto& s: edges.hidden) {
+            ss << svgOut.exportEdges(s);
+        }
+        ss << grpTail;
+    }
+    return ss.str();
+}
+
+//! collect the page contents.  must run in the main thread.
+static SvgPageJob makeSvgPageJob(TechDraw::DrawPage* dp, const std::string& filePath)
+{
+    SvgPageJob job;
+    job.filePath = filePath;
+    job.width = dp->getPageWidth();
+    job.height = dp->getPageHeight();
+    job.thick = DrawUtil::getDefaultLineWeight("Thick");
+    job.thin = DrawUtil::getDefaultLineWeight("Thin");
+
+    auto svgTemplate = dynamic_cast<TechDraw::DrawSVGTemplate*>(dp->Template.getValue());
+    if (svgTemplate != nullptr) {
+        Base::FileInfo fi(svgTemplate->PageResult.getValue());
+        if (fi.isReadable()) {
+            Base::ifstream inFile(fi, std::ios::in | std::ios::binary);
+            std::stringstream content;
+            content << inFile.rdbuf();
+            //drop the xml prolog, the template becomes a nested svg element
+            std::string text = content.str();
+            std::string::size_type start = text.find("<svg");
+            if (start != std::string::npos) {
+                job.templateSvg = text.substr(start);
+            }
+        }
+    }
+
+    auto views = dp->getAllViews();
+    for (auto& v: views) {
+        if (!v->isDerivedFrom(TechDraw::DrawViewPart::getClassTypeId())) {
+            continue;
+        }
+        TechDraw::DrawViewPart* dvp = static_cast<TechDraw::DrawViewPart*>(v);
+        if (!dvp->hasGeometry()) {
+            continue;
+        }
+        double offX = 0.0;
+        double offY = 0.0;
+        if (dvp->isDerivedFrom(TechDraw::DrawProjGroupItem::getClassTypeId())) {
+            TechDraw::DrawProjGroupItem* dpgi = static_cast<TechDraw::DrawProjGroupItem*>(dvp);
+            TechDraw::DrawProjGroup*      dpg = dpgi->getPGroup();
+            if (dpg != nullptr) {
+                offX = dpg->X.getValue();
+                offY = dpg->Y.getValue();
+            }
+        }
+        SvgViewEdges edges = collectSvgEdges(dvp);
+        //view geometry is already y down like Svg. page origin is top left in Svg.
+        edges.x = dvp->X.getValue() + offX;
+        edges.y = job.height - (dvp->Y.getValue() + offY);
+        job.views.push_back(edges);
+    }
+    return job;
+}
+
+static void makeSvgPage(SvgPageJob& job)
+{
+    try {
+        std::stringstream ss;
+        ss << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+           << "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\" version=\"1.1\""
+           << " width=\"" << job.width << "mm\" height=\"" << job.height << "mm\""
+           << " viewBox=\"0 0 " << job.width << " " << job.height << "\">\n";
+        ss << job.templateSvg;
+        for (auto& v: job.views) {
+            ss << "<g transform=\"translate(" << v.x << "," << v.y << ")\">\n";
+            ss << svgEdgeGroups(v, job.thick, job.thin);
+            ss << "</g>\n";
+        }
+        ss << "</svg>\n";
+        job.svg = ss.str();
+    }
+    catch (Standard_Failure& e) {
+        job.error = e.GetMessageString();
+    }
+}
+
+//! render the pages in parallel, then write the files
+static void writeSvgPages(std::vector<SvgPageJob>& jobs)
+{
+    QtConcurrent::blockingMap(jobs, makeSvgPage);
+    for (auto& job: jobs) {
+        if (!job.error.empty()) {
+            throw Base::RuntimeError(job.error);
+        }
+        Base::FileInfo fi(job.filePath);
+        Base::ofstream outFile(fi, std::ios::out | std::ios::binary);
+        if (!outFile) {
+            throw Base::FileException("Cannot open file for writing", fi);
+        }
+        outFile << job.svg;
+    }
+}
 }
 
 using Part::TopoShape;
@@ -118,6 +292,12 @@ public:
         add_varargs_method("writeDXFPage",&Module::writeDXFPage,
             "writeDXFPage(page,filename): Exports a DrawPage to a DXF file."
         );
+        add_varargs_method("writeSVGPage",&Module::writeSVGPage,
+            "writeSVGPage(page,filename): Exports the template and view edges of a DrawPage to a SVG file without the Gui."
+        );
+        add_varargs_method("writeSVGPages",&Module::writeSVGPages,
+            "writeSVGPages([pages],[filenames]): Exports several DrawPages like writeSVGPage, rendering them in parallel."
+        );
         add_varargs_method("findCentroid",&Module::findCentroid,
             "vector = findCentroid(shape,direction): finds geometric centroid of shape looking in direction."
         );
@@ -413,68 +593,18 @@ private:
             throw Py::TypeError("expected (DrawViewPart)");
         }
         Py::String svgReturn;
-        std::string grpHead1 = "<g fill=\"none\" stroke=\"#000000\" stroke-opacity=\"1\" stroke-width=\"";
-        std::string grpHead2 = "\" stroke-linecap=\"butt\" stroke-linejoin=\"miter\" stroke-miterlimit=\"4\">\n";
-        std::string grpTail  = "</g>\n";
         try {
             App::DocumentObject* obj = 0;
             TechDraw::DrawViewPart* dvp = 0;
-            Drawing::SVGOutput svgOut;
-            std::string svgText;
-            std::stringstream ss;
             if (PyObject_TypeCheck(viewObj, &(TechDraw::DrawViewPartPy::Type))) {
                 obj = static_cast<App::DocumentObjectPy*>(viewObj)->getDocumentObjectPtr();
                 dvp = static_cast<TechDraw::DrawViewPart*>(obj);
-                TechDraw::GeometryObject* go = dvp->getGeometryObject();
-                //visible group begin "<g ... >"
-                ss << grpHead1;
 //                double thick = dvp->LineWidth.getValue();
+//                thin = dvp->HiddenWidth.getValue();
                 double thick = DrawUtil::getDefaultLineWeight("Thick");
-                ss << thick;
-                ss << grpHead2;
-                TopoDS_Shape s = go->getVisHard();
-                ss << svgOut.exportEdges(s);
-                s = (go->getVisOutline());
-                ss << svgOut.exportEdges(s);
-                if (dvp->SmoothVisible.getValue()) {
-                    s = go->getVisSmooth();
-                    ss << svgOut.exportEdges(s);
-                }
-                if (dvp->SeamVisible.getValue()) {
-                    s = go->getVisSeam();
-                    ss << svgOut.exportEdges(s);
-                }
-                //visible group end "</g>"
-                ss << grpTail;
-
-                if ( dvp->HardHidden.getValue()  ||
-                     dvp->SmoothHidden.getValue() ||
-                     dvp->SeamHidden.getValue() ) {
-                    //hidden group begin
-                    ss << grpHead1;
-//                    thick = dvp->HiddenWidth.getValue();
-                    thick = DrawUtil::getDefaultLineWeight("Thin");
-                    ss << thick;
-                    ss << grpHead2;
-                    if (dvp->HardHidden.getValue()) {
-                        s = go->getHidHard();
-                        ss << svgOut.exportEdges(s);
-                        s = go->getHidOutline();
-                        ss << svgOut.exportEdges(s);
-                    }
-                    if (dvp->SmoothHidden.getValue()) {
-                        s = go->getHidSmooth();
-                        ss << svgOut.exportEdges(s);
-                    }
-                    if (dvp->SeamHidden.getValue()) {
-                        s = go->getHidSeam();
-                        ss << svgOut.exportEdges(s);
-                    }
-                    ss << grpTail;
-                    //hidden group end
-                }
-                // ss now contains all edges as Svg
-                svgReturn = Py::String(ss.str());
+                double thin = DrawUtil::getDefaultLineWeight("Thin");
+                // all edges as Svg
+                svgReturn = Py::String(svgEdgeGroups(collectSvgEdges(dvp), thick, thin));
            }
         }
         catch (Base::Exception &e) {
@@ -731,6 +861,69 @@ private:
         return Py::None();
     }
 
+    Py::Object writeSVGPage(const Py::Tuple& args)
+    {
+        PyObject *pageObj;
+        char* name;
+        if (!PyArg_ParseTuple(args.ptr(), "Oet", &pageObj, "utf-8",&name)) {
+            throw Py::TypeError("expected (page,path");
+        }
+
+        std::string filePath = std::string(name);
+        PyMem_Free(name);
+
+        if (!PyObject_TypeCheck(pageObj, &(TechDraw::DrawPagePy::Type))) {
+            throw Py::TypeError("expected arg1 to be 'DrawPage'");
+        }
+        try {
+            App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>(pageObj)->getDocumentObjectPtr();
+            std::vector<SvgPageJob> jobs;
+            jobs.push_back(makeSvgPageJob(static_cast<TechDraw::DrawPage*>(obj), filePath));
+            writeSvgPages(jobs);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
+
+    Py::Object writeSVGPages(const Py::Tuple& args)
+    {
+        PyObject *pagesObj;
+        PyObject *pathsObj;
+        if (!PyArg_ParseTuple(args.ptr(), "OO", &pagesObj, &pathsObj)) {
+            throw Py::TypeError("expected ([pages],[paths])");
+        }
+        if (!PySequence_Check(pagesObj) || !PySequence_Check(pathsObj)) {
+            throw Py::TypeError("expected two lists");
+        }
+        Py::Sequence pages(pagesObj);
+        Py::Sequence paths(pathsObj);
+        if (pages.size() != paths.size()) {
+            throw Py::ValueError("expected one path for each page");
+        }
+
+        try {
+            std::vector<SvgPageJob> jobs;
+            for (Py::Sequence::size_type i = 0; i < pages.size(); i++) {
+                PyObject* pageObj = pages[i].ptr();
+                if (!PyObject_TypeCheck(pageObj, &(TechDraw::DrawPagePy::Type))) {
+                    throw Py::TypeError("expected only 'DrawPage' in arg1");
+                }
+                App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>(pageObj)->getDocumentObjectPtr();
+                std::string filePath = Py::String(paths[i]).as_std_string("utf-8");
+                jobs.push_back(makeSvgPageJob(static_cast<TechDraw::DrawPage*>(obj), filePath));
+            }
+            writeSvgPages(jobs);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
+
     Py::Object findCentroid(const Py::Tuple& args)
     {
         PyObject *pcObjShape;
@@ -37,7 +37,6 @@
 #include <BRepBndLib.hxx>
 #include <BRep_Builder.hxx>
 
-#include <BRepAlgoAPI_Common.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
@@ -66,6 +65,7 @@
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
 #include <Base/Parameter.h>
+#include <Base/ThreadPool.h>
 #include <Base/UnitsApi.h>
 
 #include "HatchLine.h"
@@ -177,6 +177,7 @@ void DrawGeomHatch::makeLineSets(void)
             m_saveName = NamePattern.getValue();
             std::vector<PATLineSpec> specs = getDecodedSpecsFromFile();
             m_lineSets.clear();
+            m_trimmedLines.clear();
             for (auto& hl: specs) {
                 //hl.dump("hl from file");
                 LineSet ls;
@@ -226,7 +227,24 @@ std::vector<LineSet>  DrawGeomHatch::getTrimmedLines(int i)   //get the trimmed
         Base::Console().Log("DGH::getTrimmedLines - no source geometry\n");
         return result;
     }
-    return getTrimmedLines(source, m_lineSets,i, ScalePattern.getValue());
+
+    //the face is rebuilt from the view's geometry, so check whether its outline changed
+    TopoDS_Face face = extractFace(source, i);
+    HatchClipper clipper(face);
+    double scale = ScalePattern.getValue();
+    auto it = m_trimmedLines.find(i);
+    if (it != m_trimmedLines.end() &&
+        it->second.boundary == clipper.hashValue() &&
+        it->second.scale == scale) {
+        return it->second.lineSets;
+    }
+
+    result = trimLineSets(face, clipper, m_lineSets, scale);
+    TrimmedLines& cached = m_trimmedLines[i];
+    cached.boundary = clipper.hashValue();
+    cached.scale = scale;
+    cached.lineSets = result;
+    return result;
 }
 
 /* static */
@@ -275,81 +293,80 @@ std::vector<LineSet> DrawGeomHatch::getTrimmedLines(DrawViewPart* source,
                                                     double scale )
 {
     (void)source;
+    HatchClipper clipper(f);
+    return trimLineSets(f, clipper, lineSets, scale);
+}
+
+/* static */
+//! clip the lines of each PAT line family to the face outline, the families are independent
+std::vector<LineSet> DrawGeomHatch::trimLineSets(const TopoDS_Face& face,
+                                                 const HatchClipper& clipper,
+                                                 std::vector<LineSet> lineSets,
+                                                 double scale)
+{
     std::vector<LineSet> result;
 
     if (lineSets.empty()) {
         Base::Console().Log("DGH::getTrimmedLines - no LineSets!\n");
         return result;
     }
-
-    TopoDS_Face face = f;
+    if (!clipper.isValid()) {
+        Base::Console().Log("INFO - DGH::getTrimmedLines - face has no outline\n");
+        return result;
+    }
 
     Bnd_Box bBox;
     BRepBndLib::Add(face, bBox);
     bBox.SetGap(0.0);
 
-    for (auto& ls: lineSets) {
+    Base::parallel_for(size_t(0), lineSets.size(), [&](size_t index) {
+        LineSet& ls = lineSets[index];
         PATLineSpec hl = ls.getPATLineSpec();
-        std::vector<TopoDS_Edge> candidates = DrawGeomHatch::makeEdgeOverlay(hl, bBox, scale);   //completely cover face bbox with lines
-
-        //make Compound for this linespec
-        BRep_Builder builder;
-        TopoDS_Compound grid;
-        builder.MakeCompound(grid);
-        for (auto& c: candidates) {
-           builder.Add(grid, c);
-        }
-
-        //Common(Compound,Face)
-        BRepAlgoAPI_Common mkCommon(face, grid);
-        if ((!mkCommon.IsDone())  ||
-            (mkCommon.Shape().IsNull()) ) {
-            Base::Console().Log("INFO - DGH::getTrimmedLines - Common creation failed\n");
-            return result;
-        }
-        TopoDS_Shape common = mkCommon.Shape();
+        //completely cover face bbox with lines and keep the parts inside the face
+        std::vector<HatchClipper::Segment> segments = clipper.clip(makeLineEnds(hl, bBox, scale));
 
         //save the boundingBox of hatch pattern
         Bnd_Box overlayBox;
         overlayBox.SetGap(0.0);
-        BRepBndLib::Add(common, overlayBox);
-        ls.setBBox(overlayBox);
 
-        //get resulting edges
         std::vector<TopoDS_Edge> resultEdges;
-        TopTools_IndexedMapOfShape mapOfEdges;
-        TopExp::MapShapes(common, TopAbs_EDGE, mapOfEdges);
-        for ( int i = 1 ; i <= mapOfEdges.Extent() ; i++ ) {           //remember, TopExp makes no promises about the order it finds edges
-            const TopoDS_Edge& edge = TopoDS::Edge(mapOfEdges(i));
-            if (edge.IsNull()) {
-                Base::Console().Log("INFO - DGH::getTrimmedLines - edge: %d is NULL\n",i);
-                continue;
-            }
-            resultEdges.push_back(edge);
-        }
-
         std::vector<TechDraw::BaseGeom*> resultGeoms;
-        int i = 0;
-        for (auto& e: resultEdges) {
-            TechDraw::BaseGeom* base = BaseGeom::baseFactory(e);
+        resultEdges.reserve(segments.size());
+        resultGeoms.reserve(segments.size());
+        for (auto& seg: segments) {
+            TopoDS_Edge edge = makeLine(seg.first, seg.second);
+            TechDraw::BaseGeom* base = BaseGeom::baseFactory(edge);
             if (base == nullptr) {
-                Base::Console().Log("FAIL - DGH::getTrimmedLines - baseFactory failed for edge: %d\n",i);
                 throw Base::ValueError("DGH::getTrimmedLines - baseFactory failed");
             }
+            overlayBox.Add(gp_Pnt(seg.first.x, seg.first.y, 0.0));
+            overlayBox.Add(gp_Pnt(seg.second.x, seg.second.y, 0.0));
+            resultEdges.push_back(edge);
             resultGeoms.push_back(base);
-            i++;
         }
+        ls.setBBox(overlayBox);
         ls.setEdges(resultEdges);
         ls.setGeoms(resultGeoms);
-        result.push_back(ls);
-    }
-    return result;
+    }, size_t(1));
+
+    return lineSets;
 }
 
 /* static */
 std::vector<TopoDS_Edge> DrawGeomHatch::makeEdgeOverlay(PATLineSpec hl, Bnd_Box b, double scale)
 {
     std::vector<TopoDS_Edge> result;
+    for (auto& ends: makeLineEnds(hl, b, scale)) {
+        result.push_back(makeLine(ends.first, ends.second));
+    }
+    return result;
+}
+
+/* static */
+//! end points of the lines of one PAT line family that cover the box
+std::vector<std::pair<Base::Vector3d, Base::Vector3d> > DrawGeomHatch::makeLineEnds(PATLineSpec hl, Bnd_Box b, double scale)
+{
+    std::vector<std::pair<Base::Vector3d, Base::Vector3d> > result;
 
     double minX,maxX,minY,maxY,minZ,maxZ;
     b.Get(minX,minY,minZ,maxX,maxY,maxZ);
@@ -380,8 +397,7 @@ std::vector<TopoDS_Edge> DrawGeomHatch::makeEdgeOverlay(PATLineSpec hl, Bnd_Box
         for (int i = 0; i < repeatTotal; i++) {
             Base::Vector3d newStart(minX,yStart + float(i)*interval,0);
             Base::Vector3d newEnd(maxX,yStart + float(i)*interval,0);
-            TopoDS_Edge newLine = makeLine(newStart,newEnd);
-            result.push_back(newLine);
+            result.emplace_back(newStart,newEnd);
         }
     } else if ((angle == 90.0)  ||
                (angle == -90.0))  {         //odd case 2: vertical lines
@@ -396,8 +412,7 @@ std::vector<TopoDS_Edge> DrawGeomHatch::makeEdgeOverlay(PATLineSpec hl, Bnd_Box
         for (int i = 0; i < repeatTotal; i++) {
             Base::Vector3d newStart(xStart + float(i)*interval,minY,0);
             Base::Vector3d newEnd(xStart + float(i)*interval,maxY,0);
-            TopoDS_Edge newLine = makeLine(newStart,newEnd);
-            result.push_back(newLine);
+            result.emplace_back(newStart,newEnd);
         }
 //TODO: check if this makes 2-3 extra lines.  might be some "left" lines on "right" side of vv
     } else if (angle > 0) {      //oblique  (bottom left -> top right)
@@ -417,8 +432,7 @@ std::vector<TopoDS_Edge> DrawGeomHatch::makeEdgeOverlay(PATLineSpec hl, Bnd_Box
         for (int i = 0; i < repeatTotal; i++) {
             Base::Vector3d newStart(leftStartX + (float(i) *  interval),minY,0);
             Base::Vector3d newEnd (leftEndX + (float(i) * interval),maxY,0);
-            TopoDS_Edge newLine = makeLine(newStart,newEnd);
-            result.push_back(newLine);
+            result.emplace_back(newStart,newEnd);
         }
     } else {    //oblique (bottom right -> top left)
         // ex: -60,0,0,0,4.0,25.0,-12.5,12.5,-6
@@ -435,8 +449,7 @@ std::vector<TopoDS_Edge> DrawGeomHatch::makeEdgeOverlay(PATLineSpec hl, Bnd_Box
         for (int i = 0; i < repeatTotal; i++) {
             Base::Vector3d newStart(leftStartX + float(i)*interval,minY,0);
             Base::Vector3d newEnd(leftEndX + float(i)*interval,maxY,0);
-            TopoDS_Edge newLine = makeLine(newStart,newEnd);
-            result.push_back(newLine);
+            result.emplace_back(newStart,newEnd);
         }
     }
 
@@ -29,6 +29,9 @@
 #include <App/PropertyLinks.h>
 #include <App/PropertyFile.h>
 
+#include <map>
+#include <utility>
+
 class TopoDS_Edge;
 class TopoDS_Face;
 class Bnd_Box;
@@ -45,6 +48,7 @@ class DrawViewSection;
 class PATLineSpec;
 class LineSet;
 class DashSet;
+class HatchClipper;
 
 class TechDrawExport DrawGeomHatch : public App::DocumentObject
 {
@@ -85,6 +89,7 @@ public:
                                                                 double scale );
 
     static std::vector<TopoDS_Edge> makeEdgeOverlay(PATLineSpec hl, Bnd_Box bBox, double scale);
+    static std::vector<std::pair<Base::Vector3d, Base::Vector3d> > makeLineEnds(PATLineSpec hl, Bnd_Box bBox, double scale);
     static TopoDS_Edge makeLine(Base::Vector3d s, Base::Vector3d e);
     static std::vector<PATLineSpec> getDecodedSpecsFromFile(std::string fileSpec, std::string myPattern);
     static TopoDS_Face extractFace(DrawViewPart* source, int iface );
@@ -100,6 +105,10 @@ protected:
     void replacePatIncluded(std::string newPatFile);
 
     void makeLineSets(void);
+    static std::vector<LineSet> trimLineSets(const TopoDS_Face& face,
+                                             const HatchClipper& clipper,
+                                             std::vector<LineSet> lineSets,
+                                             double scale);
 
     std::vector<PATLineSpec> getDecodedSpecsFromFile();
     std::vector<LineSet> m_lineSets;
@@ -109,6 +118,14 @@ protected:
 private:
     static App::PropertyFloatConstraint::Constraints scaleRange;
 
+    struct TrimmedLines
+    {
+        std::size_t boundary;
+        double scale;
+        std::vector<LineSet> lineSets;
+    };
+    std::map<int, TrimmedLines> m_trimmedLines;       //per face, cleared when the pattern changes
+
 };
 
 typedef App::FeaturePythonT<DrawGeomHatch> DrawGeomHatchPython;
@@ -149,6 +149,24 @@ App::DocumentObjectExecReturn *DrawProjGroupItem::execute(void)
     return ret;
 }
 
+void DrawProjGroupItem::postHlrTasks(void)
+{
+    DrawViewPart::postHlrTasks();
+
+    //the group places its items by their sizes, so the other items may have
+    //to move now that this one has its new geometry
+    auto pgroup = getPGroup();
+    if (pgroup == nullptr) {
+        return;
+    }
+    for (auto& v: pgroup->Views.getValues()) {
+        auto item = dynamic_cast<DrawProjGroupItem*>(v);
+        if ((item != nullptr) && !item->waitingForHlr()) {
+            item->autoPosition();
+        }
+    }
+}
+
 void DrawProjGroupItem::autoPosition()
 {
 //    Base::Console().Message("DPGI::autoPosition(%s)\n",Label.getValue());
@@ -70,6 +70,7 @@ public:
                                       const bool flip = true)  const override;
 
     virtual App::DocumentObjectExecReturn *execute(void) override;
+    virtual void postHlrTasks(void) override;
     virtual const char* getViewProviderName(void) const override {
         return "TechDrawGui::ViewProviderProjGroupItem";
     }
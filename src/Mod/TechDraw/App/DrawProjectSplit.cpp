@@ -67,6 +67,13 @@
 #include <cmath>
 #include <GeomLib_Tool.hxx>
 
+#include <boost_geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/geometries/box.hpp>
+
+#include <QtConcurrentMap>
+
 #include <App/Application.h>
 #include <Base/BoundBox.h>
 #include <Base/Console.h>
@@ -88,6 +95,17 @@
 using namespace TechDraw;
 using namespace std;
 
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace {
+//projected edges lie in the XY plane of the view
+typedef bg::model::point<double, 2, bg::cs::cartesian> Point2d;
+typedef bg::model::box<Point2d> Box2d;
+typedef std::pair<Box2d, int> EdgeBox;
+typedef bgi::rtree<EdgeBox, bgi::quadratic<16> > EdgeTree;
+}
+
 
 //===========================================================================
 // DrawProjectSplit
@@ -170,63 +188,7 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = origEdges.begin();
-    int iOuter = 0;
-    for (; itOuter != origEdges.end(); ++itOuter, iOuter++) {
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Message("DPS::Extract Faces - outer Bnd_Box is void\n");
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Message("DPS::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = faceEdges.begin();
-        for (; itInner != faceEdges.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DPS::Extract Faces - inner Bnd_Box is void\n");
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = findSplitPoints(faceEdges);
 
     std::vector<splitPoint> sorted = sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -241,6 +203,75 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 }
 
 
+//! find the vertices of edges that lie on the interior of another edge.
+//! candidates come from an R-tree of the edge boxes and are tested in parallel.
+std::vector<splitPoint> DrawProjectSplit::findSplitPoints(const std::vector<TopoDS_Edge>& edges)
+{
+    std::vector<EdgeBox> boxes;
+    std::vector<int> outer;
+    boxes.reserve(edges.size());
+    outer.reserve(edges.size());
+    int iEdge = 0;
+    for (auto& e: edges) {
+        if (DrawUtil::isZeroEdge(e)) {
+            Base::Console().Log("DPS::findSplitPoints - edge: %d is ZeroEdge\n", iEdge);
+        } else {
+            Bnd_Box sBox;
+            BRepBndLib::Add(e, sBox);
+            sBox.SetGap(0.1);
+            if (sBox.IsVoid()) {
+                Base::Console().Log("DPS::findSplitPoints - Bnd_Box is void\n");
+            } else {
+                double xMin, yMin, zMin, xMax, yMax, zMax;
+                sBox.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+                boxes.push_back(EdgeBox(Box2d(Point2d(xMin, yMin), Point2d(xMax, yMax)), iEdge));
+                outer.push_back(iEdge);
+            }
+        }
+        iEdge++;
+    }
+    //packing constructor gives a better tree than repeated inserts
+    const EdgeTree tree(boxes.begin(), boxes.end());
+
+    //a vertex can only be on an edge if it is inside that edge's box
+    std::vector<std::vector<splitPoint> > found(edges.size());
+    auto findOne = [&](int& iOuter) {
+        const TopoDS_Edge& e = edges[iOuter];
+        TopoDS_Vertex ends[2] = {TopExp::FirstVertex(e), TopExp::LastVertex(e)};
+        std::vector<EdgeBox> candidates;
+        for (auto& v: ends) {
+            gp_Pnt pnt = BRep_Tool::Pnt(v);
+            candidates.clear();
+            tree.query(bgi::intersects(Point2d(pnt.X(), pnt.Y())),
+                       std::back_inserter(candidates));
+            //rtree order depends on the build, keep results repeatable
+            std::sort(candidates.begin(), candidates.end(),
+                      [](const EdgeBox& a, const EdgeBox& b) { return a.second < b.second; });
+            for (auto& c: candidates) {
+                int iInner = c.second;
+                if (iInner == iOuter) {
+                    continue;
+                }
+                double param = -1;
+                if (isOnEdge(edges[iInner], v, param, false)) {
+                    splitPoint s;
+                    s.i = iInner;
+                    s.v = Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z());
+                    s.param = param;
+                    found[iOuter].push_back(s);
+                }
+            }
+        }
+    };
+    QtConcurrent::blockingMap(outer, findOne);
+
+    std::vector<splitPoint> result;
+    for (auto& f: found) {
+        result.insert(result.end(), f.begin(), f.end());
+    }
+    return result;
+}
+
 //this routine is the big time consumer.  gets called many times (and is slow?))
 //note param gets modified here
 bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, bool allowEnds)
@@ -36,6 +36,7 @@
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
 #include <BRep_Builder.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp.hxx>
@@ -51,6 +52,7 @@
 #include <gp_Dir.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
 #include <GProp_GProps.hxx>
 #include <gp_XYZ.hxx>
 #include <HLRAlgo_Projector.hxx>
@@ -65,6 +67,7 @@
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Vertex.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Vertex.hxx>
@@ -72,12 +75,16 @@
 #include <BRepAlgo_NormalProjection.hxx>
 
 #include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS_Iterator.hxx>
 
 #endif
 
 #include <limits>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+
+#include <QtConcurrentRun>
 
 #include <App/Application.h>
 #include <App/Document.h>
@@ -116,6 +123,59 @@
 using namespace TechDraw;
 using namespace std;
 
+namespace {
+
+//! FNV-1a hash of everything written to the stream
+class HashStreamBuf : public std::streambuf
+{
+public:
+    std::uint64_t hash = 14695981039346656037ULL;
+
+protected:
+    virtual int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            add(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+    virtual std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        for (std::streamsize i = 0; i < n; i++) {
+            add(s[i]);
+        }
+        return n;
+    }
+
+private:
+    void add(char c)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+};
+
+std::vector<TopoDS_Shape> scaleHlrShapes(const std::vector<TopoDS_Shape>& shapes, double factor)
+{
+    if (DrawUtil::fpCompare(factor, 1.0)) {
+        return shapes;
+    }
+    gp_Trsf scaleTransform;
+    scaleTransform.SetScale(gp_Pnt(0,0,0), factor);
+    std::vector<TopoDS_Shape> result;
+    for (auto& s: shapes) {
+        if (s.IsNull()) {
+            result.push_back(s);
+        } else {
+            BRepBuilderAPI_Transform mkTrf(s, scaleTransform, true);
+            result.push_back(mkTrf.Shape());
+        }
+    }
+    return result;
+}
+
+}
+
 
 //===========================================================================
 // DrawViewPart
@@ -127,7 +187,10 @@ PROPERTY_SOURCE_WITH_EXTENSIONS(TechDraw::DrawViewPart,
                                 TechDraw::DrawView)
 
 DrawViewPart::DrawViewPart(void) :
-    geometryObject(0)
+    geometryObject(0),
+    m_hlrGeometry(nullptr),
+    m_hlrRescaled(false),
+    m_waitingForHlr(false)
 {
     static const char *group = "Projection";
     static const char *sgroup = "HLR Parameters";
@@ -168,14 +231,22 @@ DrawViewPart::DrawViewPart(void) :
     ADD_PROPERTY_TYPE(SeamHidden ,(prefSeamHid()),sgroup,App::Prop_None,"Show Hidden Seam lines");
     ADD_PROPERTY_TYPE(IsoHidden ,(prefIsoHid()),sgroup,App::Prop_None,"Show Hidden Iso u,v lines");
     ADD_PROPERTY_TYPE(IsoCount ,(prefIsoCount()),sgroup,App::Prop_None,"Number of iso parameters lines");
+    ADD_PROPERTY_TYPE(HlrCache ,(TopoDS_Shape()),sgroup,(App::PropertyType)(App::Prop_Output | App::Prop_Hidden),
+                      "Saved hidden line removal result at scale 1");
+    ADD_PROPERTY_TYPE(HlrCacheKey ,(""),sgroup,(App::PropertyType)(App::Prop_Output | App::Prop_Hidden),
+                      "Inputs of the saved hidden line removal result");
 
     geometryObject = nullptr;
     //initialize bbox to non-garbage
     bbox = Base::BoundBox3d(Base::Vector3d(0.0, 0.0, 0.0), 0.0);
+
+    QObject::connect(&m_hlrWatcher, &QFutureWatcherBase::finished,
+                     [this]() { onHlrFinished(); });
 }
 
 DrawViewPart::~DrawViewPart()
 {
+    waitForHlr();
     removeAllReferencesFromGeom();
     delete geometryObject;
 }
@@ -289,6 +360,11 @@ App::DocumentObjectExecReturn *DrawViewPart::execute(void)
     }
 
     m_saveShape = shape;
+    if (prefHlrInBackground()) {
+        //the page shows the old geometry until postHlrTasks
+        startHlr(shape, false);
+        return DrawView::execute();
+    }
     partExec(shape);
     addShapes2d();
 
@@ -350,6 +426,8 @@ void DrawViewPart::onChanged(const App::Property* prop)
 void DrawViewPart::partExec(TopoDS_Shape shape)
 {
 //    Base::Console().Message("DVP::partExec()\n");
+    //results of a background projection are superseded
+    waitForHlr();
     if (geometryObject) {
         delete geometryObject;
         geometryObject = nullptr;
@@ -358,7 +436,13 @@ void DrawViewPart::partExec(TopoDS_Shape shape)
     if (geometryObject == nullptr) {
         return;
     }
+    storeHlrCache();
+    finishGeometry();
+}
 
+//! add faces, cosmetics and references to a new geometryObject
+void DrawViewPart::finishGeometry(void)
+{
 #if MOD_TECHDRAW_HANDLE_FACES
     if (handleFaces() && !geometryObject->usePolygonHLR()) {
         try {
@@ -408,23 +492,35 @@ void DrawViewPart::addShapes2d(void)
 }
 
 GeometryObject* DrawViewPart::makeGeometryForShape(TopoDS_Shape shape)
+{
+    gp_Ax2 viewAxis;
+    TopoDS_Shape scaledShape = prepareShape(shape, viewAxis,
+                                            m_saveCentroid, m_saveShape);
+    GeometryObject* go =  newGeometryObject();
+    projectGeometry(go, scaledShape, viewAxis,
+                    hlrCacheKey(m_saveShape, viewAxis));
+    bbox = go->calcBoundingBox();
+    return go;
+}
+
+//! center, scale and rotate the source shape for projection
+TopoDS_Shape DrawViewPart::prepareShape(TopoDS_Shape shape, gp_Ax2& viewAxis,
+                                        Base::Vector3d& centroid, TopoDS_Shape& centeredShape)
 {
     gp_Pnt inputCenter;
     Base::Vector3d stdOrg(0.0,0.0,0.0);
 
-    gp_Ax2 viewAxis = getProjectionCS(stdOrg);
+    viewAxis = getProjectionCS(stdOrg);
 
     inputCenter = TechDraw::findCentroid(shape,
                                          viewAxis);
-    Base::Vector3d centroid(inputCenter.X(),
-                            inputCenter.Y(),
-                            inputCenter.Z());
+    centroid = Base::Vector3d(inputCenter.X(),
+                              inputCenter.Y(),
+                              inputCenter.Z());
 
     //center shape on origin
-    TopoDS_Shape centeredShape = TechDraw::moveShape(shape,
-                                                     centroid * -1.0);
-    m_saveCentroid = centroid;
-    m_saveShape = centeredShape;
+    centeredShape = TechDraw::moveShape(shape,
+                                        centroid * -1.0);
 
     TopoDS_Shape scaledShape = TechDraw::scaleShape(centeredShape,
                                                     getScale());
@@ -434,26 +530,48 @@ GeometryObject* DrawViewPart::makeGeometryForShape(TopoDS_Shape shape)
                                             Rotation.getValue());  //conventional rotation
      }
 //    BRepTools::Write(scaledShape, "DVPScaled.brep");            //debug
-    GeometryObject* go =  buildGeometryObject(scaledShape,viewAxis);
-    return go;
+    return scaledShape;
 }
 
 //note: slightly different than routine with same name in DrawProjectSplit
 TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis)
+{
+    TechDraw::GeometryObject* go = newGeometryObject();
+    projectGeometry(go, shape, viewAxis);
+    bbox = go->calcBoundingBox();
+    return go;
+}
+
+TechDraw::GeometryObject* DrawViewPart::newGeometryObject(void)
 {
     TechDraw::GeometryObject* go = new TechDraw::GeometryObject(getNameInDocument(), this);
     go->setIsoCount(IsoCount.getValue());
     go->isPerspective(Perspective.getValue());
     go->setFocus(Focus.getValue());
     go->usePolygonHLR(CoarseView.getValue());
+    return go;
+}
 
-    if (go->usePolygonHLR()){
-        go->projectShapeWithPolygonAlgo(shape,
-            viewAxis);
-    }
-    else{
-        go->projectShape(shape,
-            viewAxis);
+//! run HLR on the shape and extract the edges shown by this view into go.
+//! with a cacheKey, the last result is reused if it was made from the same inputs.
+void DrawViewPart::projectGeometry(TechDraw::GeometryObject* go, TopoDS_Shape shape, gp_Ax2 viewAxis,
+                                   const std::string& cacheKey)
+{
+    if (!cacheKey.empty() && (cacheKey == m_hlrCacheKey)) {
+        go->setHlrShapes(scaleHlrShapes(m_hlrCacheShapes, getScale()));
+    } else {
+        if (go->usePolygonHLR()){
+            go->projectShapeWithPolygonAlgo(shape,
+                viewAxis);
+        }
+        else{
+            go->projectShape(shape,
+                viewAxis);
+        }
+        if (!cacheKey.empty()) {
+            m_hlrCacheKey = cacheKey;
+            m_hlrCacheShapes = scaleHlrShapes(go->getHlrShapes(), 1.0 / getScale());
+        }
     }
 
     go->extractGeometry(TechDraw::ecHARD,                   //always show the hard&outline visible lines
@@ -495,8 +613,177 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
     if (edges.empty()) {
         Base::Console().Log("DVP::buildGO - NO extracted edges!\n");
     }
-    bbox = go->calcBoundingBox();
-    return go;
+}
+
+//! identify the inputs of a projection, except for the scale which is applied
+//! to a reused result.  centeredShape is neither scaled nor rotated.
+std::string DrawViewPart::hlrCacheKey(const TopoDS_Shape& centeredShape, const gp_Ax2& viewAxis)
+{
+    const gp_Dir& dir = viewAxis.Direction();
+    const gp_Dir& xDir = viewAxis.XDirection();
+    std::stringstream ss;
+    ss.precision(17);
+    ss << std::hex << shapeContentHash(centeredShape) << std::dec
+       << " " << dir.X() << " " << dir.Y() << " " << dir.Z()
+       << " " << xDir.X() << " " << xDir.Y() << " " << xDir.Z()
+       << " " << Rotation.getValue()
+       << " " << CoarseView.getValue()
+       << " " << IsoCount.getValue();
+    if (Perspective.getValue()) {
+        //a perspective projection does not scale
+        ss << " p " << Focus.getValue() << " " << getScale();
+    }
+    return ss.str();
+}
+
+//! hash of the BRep text of shape.  The source shapes are fresh copies on every
+//! recompute, so the TShape pointer can't identify them.
+std::uint64_t DrawViewPart::shapeContentHash(const TopoDS_Shape& shape)
+{
+    HashStreamBuf hashBuf;
+    std::ostream hashStream(&hashBuf);
+    BRepTools::Write(shape, hashStream);
+    return hashBuf.hash;
+}
+
+//! keep the last HLR result in the document if the user wants it saved
+void DrawViewPart::storeHlrCache(void)
+{
+    if (!prefSaveHlrCache()) {
+        if (!HlrCacheKey.isEmpty()) {
+            HlrCacheKey.setValue("");
+            HlrCache.setValue(TopoDS_Shape());
+        }
+        return;
+    }
+    if (m_hlrCacheKey.empty() || (m_hlrCacheKey == HlrCacheKey.getStrValue())) {
+        return;
+    }
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    for (auto& s: m_hlrCacheShapes) {
+        if (s.IsNull()) {
+            //keep the position of empty results
+            TopoDS_Compound empty;
+            builder.MakeCompound(empty);
+            builder.Add(comp, empty);
+        } else {
+            builder.Add(comp, s);
+        }
+    }
+    HlrCache.setValue(comp);
+    HlrCacheKey.setValue(m_hlrCacheKey);
+}
+
+void DrawViewPart::restoreHlrCache(void)
+{
+    if (HlrCacheKey.isEmpty()) {
+        return;
+    }
+    std::vector<TopoDS_Shape> shapes;
+    for (TopoDS_Iterator it(HlrCache.getValue()); it.More(); it.Next()) {
+        shapes.push_back(it.Value());
+    }
+    if (shapes.size() == 10) {
+        m_hlrCacheKey = HlrCacheKey.getValue();
+        m_hlrCacheShapes = shapes;
+    }
+}
+
+//! start the projection of shape in a worker thread.  geometryObject keeps the
+//! old result until onHlrFinished.
+void DrawViewPart::startHlr(TopoDS_Shape shape, bool rescaled)
+{
+    //a running projection is for outdated settings
+    waitForHlr();
+
+    gp_Ax2 viewAxis;
+    TopoDS_Shape scaledShape = prepareShape(shape, viewAxis,
+                                            m_hlrCentroid, m_hlrShape);
+    std::string cacheKey = hlrCacheKey(m_hlrShape, viewAxis);
+    //the worker gets its own copy, other views may project the same source
+    BRepBuilderAPI_Copy copier(scaledShape);
+    TopoDS_Shape workShape = copier.Shape();
+
+    m_hlrSource = shape;
+    m_hlrRescaled = rescaled;
+    m_hlrGeometry = newGeometryObject();
+    m_waitingForHlr = true;
+
+    TechDraw::GeometryObject* go = m_hlrGeometry;
+    std::string name = getNameInDocument();
+    m_hlrFuture = QtConcurrent::run([this, go, workShape, viewAxis, cacheKey, name]() {
+        try {
+            projectGeometry(go, workShape, viewAxis, cacheKey);
+        }
+        catch (Standard_Failure& e) {
+            Base::Console().Error("DVP::startHlr - OCC error - %s - while projecting %s\n",
+                                  e.GetMessageString(), name.c_str());
+        }
+        catch (...) {
+            Base::Console().Error("DVP::startHlr - error while projecting %s\n",
+                                  name.c_str());
+        }
+    });
+    m_hlrWatcher.setFuture(m_hlrFuture);
+}
+
+//! wait for a running projection and throw its result away
+void DrawViewPart::waitForHlr(void)
+{
+    m_hlrFuture.waitForFinished();
+    delete m_hlrGeometry;
+    m_hlrGeometry = nullptr;
+    m_waitingForHlr = false;
+}
+
+void DrawViewPart::onHlrFinished(void)
+{
+    if ((m_hlrGeometry == nullptr) || !m_hlrFuture.isFinished()) {
+        //signal of an abandoned projection
+        return;
+    }
+    delete geometryObject;
+    geometryObject = m_hlrGeometry;
+    m_hlrGeometry = nullptr;
+    m_saveCentroid = m_hlrCentroid;
+    m_saveShape = m_hlrShape;
+    bbox = geometryObject->calcBoundingBox();
+    m_waitingForHlr = false;
+    storeHlrCache();
+
+    postHlrTasks();
+}
+
+//! complete the view once the background projection has finished
+void DrawViewPart::postHlrTasks(void)
+{
+    finishGeometry();
+    addShapes2d();
+
+    //second pass if required
+    if (ScaleType.isValue("Automatic") && !m_hlrRescaled) {
+        if (!checkFit()) {
+            double newScale = autoScale();
+            Scale.setValue(newScale);
+            Scale.purgeTouched();
+            startHlr(m_hlrSource, true);
+            return;
+        }
+    }
+
+    //dimensions were measured on the old geometry
+    bool recomputing = getDocument()->testStatus(App::Document::Status::Recomputing);
+    std::vector<TechDraw::DrawViewDimension*> dims = getDimensions();
+    for (auto& d: dims) {
+        if (recomputing) {
+            d->touch();
+        } else {
+            d->recomputeFeature();
+        }
+    }
+    requestPaint();
 }
 
 //! make faces from the existing edge geometry
@@ -526,63 +813,7 @@ void DrawViewPart::extractFaces()
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = nonZero.begin();
-    int iOuter = 0;
-    for (; itOuter != nonZero.end(); ++itOuter, iOuter++) {    //*** itOuter != nonZero.end() - 1
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Log("DVP::Extract Faces - outer Bnd_Box is void for %s\n",getNameInDocument());
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Log("DVP::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = nonZero.begin();   //***sb itOuter + 1;
-        for (; itInner != nonZero.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DVP::Extract Faces - inner Bnd_Box is void for %s\n",getNameInDocument());
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (DrawProjectSplit::isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (DrawProjectSplit::isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = DrawProjectSplit::findSplitPoints(nonZero);
 
     std::vector<splitPoint> sorted = DrawProjectSplit::sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -969,6 +1200,7 @@ bool DrawViewPart::handleFaces(void)
 void DrawViewPart::unsetupObject()
 {
     nowUnsetting = true;
+    waitForHlr();
     App::Document* doc = getDocument();
     std::string docName = doc->getName();
 
@@ -1413,6 +1645,7 @@ void DrawViewPart::onDocumentRestored()
 {
 //    requestPaint();
     //if execute has not run yet, there will be no GO, and paint will not do anything.
+    restoreHlrCache();
     recomputeFeature();
     DrawView::onDocumentRestored();
 }
@@ -1504,6 +1737,22 @@ int DrawViewPart::prefIsoCount(void)
     return result;
 }
 
+bool DrawViewPart::prefHlrInBackground(void)
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+          .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/General");
+    bool result = hGrp->GetBool("HlrInBackground", false);
+    return result;
+}
+
+bool DrawViewPart::prefSaveHlrCache(void)
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+          .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/General");
+    bool result = hGrp->GetBool("SaveHlrCache", false);
+    return result;
+}
+
 
 // Python Drawing feature ---------------------------------------------------------
 
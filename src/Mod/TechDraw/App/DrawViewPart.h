@@ -25,10 +25,15 @@
 #ifndef _DrawViewPart_h_
 #define _DrawViewPart_h_
 
+#include <cstdint>
+
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Wire.hxx>
 
+#include <QFuture>
+#include <QFutureWatcher>
+
 #include <App/DocumentObject.h>
 #include <App/PropertyLinks.h>
 #include <App/PropertyStandard.h>
@@ -36,6 +41,7 @@
 #include <App/FeaturePython.h>
 
 #include <Base/BoundBox.h>
+#include <Mod/Part/App/PropertyTopoShape.h>
 
 #include "PropertyGeomFormatList.h"
 #include "PropertyCenterLineList.h"
@@ -112,6 +118,9 @@ public:
     App::PropertyBool   IsoHidden;
     App::PropertyInteger  IsoCount;
 
+    Part::PropertyPartShape HlrCache;
+    App::PropertyString     HlrCacheKey;
+
     virtual short mustExecute() const override;
     virtual void onDocumentRestored() override;
     virtual App::DocumentObjectExecReturn *execute(void) override;
@@ -205,6 +214,9 @@ public:
 
     std::vector<App::DocumentObject*> getAllSources(void) const;
 
+    bool waitingForHlr(void) const { return m_waitingForHlr; }
+    virtual void postHlrTasks(void);
+
 
 protected:
     bool checkXDirection(void) const;
@@ -217,7 +229,20 @@ protected:
 
     virtual TechDraw::GeometryObject*  buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis); //const??
     virtual TechDraw::GeometryObject*  makeGeometryForShape(TopoDS_Shape shape);   //const??
+    TechDraw::GeometryObject* newGeometryObject(void);
+    void projectGeometry(TechDraw::GeometryObject* go, TopoDS_Shape shape, gp_Ax2 viewAxis,
+                         const std::string& cacheKey = std::string());
+    std::string hlrCacheKey(const TopoDS_Shape& centeredShape, const gp_Ax2& viewAxis);
+    static std::uint64_t shapeContentHash(const TopoDS_Shape& shape);
+    void storeHlrCache(void);
+    void restoreHlrCache(void);
+    TopoDS_Shape prepareShape(TopoDS_Shape shape, gp_Ax2& viewAxis,
+                              Base::Vector3d& centroid, TopoDS_Shape& centeredShape);
     void partExec(TopoDS_Shape shape);
+    void finishGeometry(void);
+    void startHlr(TopoDS_Shape shape, bool rescaled);
+    void onHlrFinished(void);
+    void waitForHlr(void);
     virtual void addShapes2d(void);
 
     void extractFaces();
@@ -241,12 +266,28 @@ protected:
     bool prefSmoothHid(void);
     bool prefIsoHid(void);
     int  prefIsoCount(void);
+    bool prefHlrInBackground(void);
+    bool prefSaveHlrCache(void);
 
     std::vector<TechDraw::Vertex*> m_referenceVerts;
 
 private:
     bool nowUnsetting;
 
+    //projection running in the background, the view keeps its old geometry until it is done
+    QFutureWatcher<void> m_hlrWatcher;
+    QFuture<void> m_hlrFuture;
+    TechDraw::GeometryObject* m_hlrGeometry;
+    TopoDS_Shape m_hlrSource;
+    TopoDS_Shape m_hlrShape;
+    Base::Vector3d m_hlrCentroid;
+    bool m_hlrRescaled;
+    bool m_waitingForHlr;
+
+    //last HLR result at scale 1 and the inputs it was made from
+    std::string m_hlrCacheKey;
+    std::vector<TopoDS_Shape> m_hlrCacheShapes;
+
 };
 
 typedef App::FeaturePythonT<DrawViewPart> DrawViewPartPython;
@@ -60,6 +60,7 @@
 #include <TopoDS_Compound.hxx>
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
+#include <TopTools_ListOfShape.hxx>
 
 #endif
 
@@ -354,72 +355,27 @@ App::DocumentObjectExecReturn *DrawViewSection::execute(void)
 
 void DrawViewSection::sectionExec(TopoDS_Shape baseShape)
 {
-// cut base shape with tool
-    //is SectionOrigin valid?
-    Bnd_Box centerBox;
-    BRepBndLib::Add(baseShape, centerBox);
-    centerBox.SetGap(0.0);
-
-// make tool
-    gp_Pln pln = getSectionPlane();
-    gp_Dir gpNormal = pln.Axis().Direction();
-    Base::Vector3d orgPnt = SectionOrigin.getValue();
-
-    if(!isReallyInBox(gp_Pnt(orgPnt.x,orgPnt.y,orgPnt.z), centerBox)) {
-        Base::Console().Warning("DVS: SectionOrigin doesn't intersect part in %s\n",getNameInDocument());
-    }
-
-    // Make the extrusion face
-    double dMax = sqrt(centerBox.SquareExtent());
-    BRepBuilderAPI_MakeFace mkFace(pln, -dMax,dMax,-dMax,dMax);
-    TopoDS_Face aProjFace = mkFace.Face();
-    if(aProjFace.IsNull()) {
-        Base::Console().Warning("DVS: Section face is NULL in %s\n",getNameInDocument());
-        return;
-    }
-    gp_Vec extrudeDir = dMax * gp_Vec(gpNormal);
-    TopoDS_Shape prism = BRepPrimAPI_MakePrism(aProjFace, extrudeDir, false, true).Shape();
-
-    // We need to copy the shape to not modify the BRepstructure
-    BRepBuilderAPI_Copy BuilderCopy(baseShape);
-    TopoDS_Shape myShape = BuilderCopy.Shape();
+    //the cut doesn't depend on scale, rotation or any of the display properties
+    std::string cutKey = sectionCutKey(baseShape);
+    TopoDS_Shape rawShape;
+    TopoDS_Compound faceIntersections;
+    if (cutKey == m_cutCacheKey) {
+        rawShape = m_cutCacheShape;
+        faceIntersections = m_cutCacheFaces;
+    } else {
+        m_cutCacheKey.clear();
+        m_cutCacheShape = TopoDS_Shape();
+        m_cutCacheFaces = TopoDS_Compound();
 
-// perform cut
-    BRep_Builder builder;
-    TopoDS_Compound pieces;
-    builder.MakeCompound(pieces);
-    TopExp_Explorer expl(myShape, TopAbs_SOLID);
-    int indb = 0;
-    int outdb = 0;
-    for (; expl.More(); expl.Next()) {
-        indb++;
-        const TopoDS_Solid& s = TopoDS::Solid(expl.Current());
-        BRepAlgoAPI_Cut mkCut(s, prism);
-        if (!mkCut.IsDone()) {
-            Base::Console().Warning("DVS: Section cut has failed in %s\n",getNameInDocument());
-            continue;
+        rawShape = makeSectionCut(baseShape);
+        if (rawShape.IsNull()) {
+            return;
         }
-        TopoDS_Shape cut = mkCut.Shape();
-        builder.Add(pieces, cut);
-        outdb++;
-    }
-// pieces contains result of cutting each subshape in baseShape with tool
-    TopoDS_Shape rawShape = pieces;
-    if (debugSection()) {
-        BRepTools::Write(myShape, "DVSCopy.brep");            //debug
-        BRepTools::Write(aProjFace, "DVSFace.brep");          //debug
-        BRepTools::Write(prism, "DVSTool.brep");              //debug
-        BRepTools::Write(pieces, "DVSPieces.brep");         //debug
-    }
-
-// check for error in cut
-    Bnd_Box testBox;
-    BRepBndLib::Add(rawShape, testBox);
-    testBox.SetGap(0.0);
-    if (testBox.IsVoid()) {           //prism & input don't intersect.  rawShape is garbage, don't bother.
-        Base::Console().Warning("DVS::execute - prism & input don't intersect - %s\n", Label.getValue());
-        return;
+        faceIntersections = findSectionPlaneIntersections(rawShape);
 
+        m_cutCacheKey = cutKey;
+        m_cutCacheShape = rawShape;
+        m_cutCacheFaces = faceIntersections;
     }
 
 // build display geometry as in DVP, with minor mods
@@ -454,7 +410,10 @@ void DrawViewSection::sectionExec(TopoDS_Shape baseShape)
 //            DrawUtil::dumpCS("DVS::execute - CS to GO", viewAxis);
         }
 
-        geometryObject = buildGeometryObject(scaledShape,viewAxis);
+        geometryObject = newGeometryObject();
+        projectGeometry(geometryObject, scaledShape, viewAxis,
+                        hlrCacheKey(m_cutShape, viewAxis));
+        bbox = geometryObject->calcBoundingBox();
 
 #if MOD_TECHDRAW_HANDLE_FACES
         extractFaces();
@@ -468,7 +427,6 @@ void DrawViewSection::sectionExec(TopoDS_Shape baseShape)
 //display geometry for cut shape is in geometryObject as in DVP
 
 // build section face geometry
-        TopoDS_Compound faceIntersections = findSectionPlaneIntersections(rawShape);
         TopoDS_Shape centeredShapeF = TechDraw::moveShape(faceIntersections,
                                                            m_saveCentroid * -1.0);
 
@@ -540,6 +498,99 @@ void DrawViewSection::sectionExec(TopoDS_Shape baseShape)
     addReferencesToGeom();
 }
 
+//! cut the solids of baseShape with the half space behind the section plane
+TopoDS_Shape DrawViewSection::makeSectionCut(const TopoDS_Shape& baseShape)
+{
+// cut base shape with tool
+    //is SectionOrigin valid?
+    Bnd_Box centerBox;
+    BRepBndLib::Add(baseShape, centerBox);
+    centerBox.SetGap(0.0);
+
+// make tool
+    gp_Pln pln = getSectionPlane();
+    gp_Dir gpNormal = pln.Axis().Direction();
+    Base::Vector3d orgPnt = SectionOrigin.getValue();
+
+    if(!isReallyInBox(gp_Pnt(orgPnt.x,orgPnt.y,orgPnt.z), centerBox)) {
+        Base::Console().Warning("DVS: SectionOrigin doesn't intersect part in %s\n",getNameInDocument());
+    }
+
+    // Make the extrusion face
+    double dMax = sqrt(centerBox.SquareExtent());
+    BRepBuilderAPI_MakeFace mkFace(pln, -dMax,dMax,-dMax,dMax);
+    TopoDS_Face aProjFace = mkFace.Face();
+    if(aProjFace.IsNull()) {
+        Base::Console().Warning("DVS: Section face is NULL in %s\n",getNameInDocument());
+        return TopoDS_Shape();
+    }
+    gp_Vec extrudeDir = dMax * gp_Vec(gpNormal);
+    TopoDS_Shape prism = BRepPrimAPI_MakePrism(aProjFace, extrudeDir, false, true).Shape();
+
+    // We need to copy the shape to not modify the BRepstructure
+    BRepBuilderAPI_Copy BuilderCopy(baseShape);
+    TopoDS_Shape myShape = BuilderCopy.Shape();
+
+// perform cut
+    BRep_Builder builder;
+    TopoDS_Compound pieces;
+    builder.MakeCompound(pieces);
+    TopExp_Explorer expl(myShape, TopAbs_SOLID);
+    int indb = 0;
+    int outdb = 0;
+    for (; expl.More(); expl.Next()) {
+        indb++;
+        const TopoDS_Solid& s = TopoDS::Solid(expl.Current());
+        TopTools_ListOfShape arguments, tools;
+        arguments.Append(s);
+        tools.Append(prism);
+        BRepAlgoAPI_Cut mkCut;
+        mkCut.SetRunParallel(true);
+        mkCut.SetArguments(arguments);
+        mkCut.SetTools(tools);
+        mkCut.Build();
+        if (!mkCut.IsDone()) {
+            Base::Console().Warning("DVS: Section cut has failed in %s\n",getNameInDocument());
+            continue;
+        }
+        TopoDS_Shape cut = mkCut.Shape();
+        builder.Add(pieces, cut);
+        outdb++;
+    }
+// pieces contains result of cutting each subshape in baseShape with tool
+    TopoDS_Shape rawShape = pieces;
+    if (debugSection()) {
+        BRepTools::Write(myShape, "DVSCopy.brep");            //debug
+        BRepTools::Write(aProjFace, "DVSFace.brep");          //debug
+        BRepTools::Write(prism, "DVSTool.brep");              //debug
+        BRepTools::Write(pieces, "DVSPieces.brep");         //debug
+    }
+
+// check for error in cut
+    Bnd_Box testBox;
+    BRepBndLib::Add(rawShape, testBox);
+    testBox.SetGap(0.0);
+    if (testBox.IsVoid()) {           //prism & input don't intersect.  rawShape is garbage, don't bother.
+        Base::Console().Warning("DVS::execute - prism & input don't intersect - %s\n", Label.getValue());
+        return TopoDS_Shape();
+    }
+
+    return rawShape;
+}
+
+//! identify the inputs of the cut: the content of the source shape and the section plane
+std::string DrawViewSection::sectionCutKey(const TopoDS_Shape& baseShape)
+{
+    Base::Vector3d normal = SectionNormal.getValue();
+    Base::Vector3d origin = SectionOrigin.getValue();
+    std::stringstream ss;
+    ss.precision(17);
+    ss << std::hex << shapeContentHash(baseShape) << std::dec
+       << " " << normal.x << " " << normal.y << " " << normal.z
+       << " " << origin.x << " " << origin.y << " " << origin.z;
+    return ss.str();
+}
+
 gp_Pln DrawViewSection::getSectionPlane() const
 {
     gp_Ax2 viewAxis = getSectionCS();
@@ -132,12 +132,19 @@ protected:
 
     gp_Pln getSectionPlane() const;
     TopoDS_Compound findSectionPlaneIntersections(const TopoDS_Shape& shape);
+    TopoDS_Shape makeSectionCut(const TopoDS_Shape& baseShape);
+    std::string sectionCutKey(const TopoDS_Shape& baseShape);
     void getParameters(void);
     bool debugSection(void) const;
     int prefCutSurface(void) const;
 
     TopoDS_Shape m_cutShape;
 
+    //last cut and section faces, in model coordinates, and the inputs they were made from
+    std::string m_cutCacheKey;
+    TopoDS_Shape m_cutCacheShape;
+    TopoDS_Compound m_cutCacheFaces;
+
     virtual void onDocumentRestored() override;
     virtual void setupObject() override;
     void setupSvgIncluded(void);
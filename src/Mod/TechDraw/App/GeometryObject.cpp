@@ -273,6 +273,32 @@ void GeometryObject::projectShape(const TopoDS_Shape& input,
     Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in hlrToShape and BuildCurves\n",m_parentName.c_str(),diffOut);
 }
 
+//! the HLR output compounds in a fixed order
+std::vector<TopoDS_Shape> GeometryObject::getHlrShapes(void) const
+{
+    return { visHard, visOutline, visSmooth, visSeam, visIso,
+             hidHard, hidOutline, hidSmooth, hidSeam, hidIso };
+}
+
+//! use the HLR output of an earlier projection instead of projecting again
+void GeometryObject::setHlrShapes(const std::vector<TopoDS_Shape>& shapes)
+{
+    clear();
+    if (shapes.size() != 10) {
+        return;
+    }
+    visHard    = shapes[0];
+    visOutline = shapes[1];
+    visSmooth  = shapes[2];
+    visSeam    = shapes[3];
+    visIso     = shapes[4];
+    hidHard    = shapes[5];
+    hidOutline = shapes[6];
+    hidSmooth  = shapes[7];
+    hidSeam    = shapes[8];
+    hidIso     = shapes[9];
+}
+
 //mirror a shape thru XZ plane for Qt's inverted Y coordinate
 TopoDS_Shape GeometryObject::invertGeometry(const TopoDS_Shape s)
 {
@@ -116,6 +116,8 @@ public:
                       const gp_Ax2 &viewAxis);
     void projectShapeWithPolygonAlgo(const TopoDS_Shape &input,
                                      const gp_Ax2 &viewAxis);
+    std::vector<TopoDS_Shape> getHlrShapes(void) const;
+    void setHlrShapes(const std::vector<TopoDS_Shape>& shapes);
     TopoDS_Shape projectFace(const TopoDS_Shape &face,
                              const gp_Ax2 &CS);
 
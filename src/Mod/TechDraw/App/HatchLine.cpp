@@ -29,11 +29,21 @@
 #include <QFileInfo>
 #include <stdexcept>
 #include <cmath>
+#include <algorithm>
 #endif
 
+#include <boost/functional/hash.hpp>
+
+#include <BRep_Tool.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepBndLib.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
+#include <Precision.hxx>
+#include <TopoDS.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
 
 #include <Base/Console.h>
 #include <Base/Vector3D.h>
@@ -485,7 +495,131 @@ void DashSpec::dump(const char* title)
     Base::Console().Message("DUMP - DashSpec - %s\n",ss.str().c_str());
 }
 
+//*******************************************
 
+HatchClipper::HatchClipper(const TopoDS_Face& face, double deflection) :
+    m_hash(0)
+{
+    if (face.IsNull()) {
+        return;
+    }
+    if (deflection <= 0.0) {
+        Bnd_Box box;
+        BRepBndLib::Add(face, box);
+        if (box.IsVoid()) {
+            return;
+        }
+        deflection = std::max(Precision::Confusion(), 1.0e-4 * sqrt(box.SquareExtent()));
+    }
 
+    //flatten the boundary, the orientation of the edges doesn't matter for an even-odd test
+    TopExp_Explorer expl(face, TopAbs_EDGE);
+    for (; expl.More(); expl.Next()) {
+        const TopoDS_Edge& edge = TopoDS::Edge(expl.Current());
+        if (BRep_Tool::Degenerated(edge)) {
+            continue;
+        }
+        BRepAdaptor_Curve adapt(edge);
+        std::vector<gp_Pnt> points;
+        if (adapt.GetType() == GeomAbs_Line) {
+            points.push_back(adapt.Value(adapt.FirstParameter()));
+            points.push_back(adapt.Value(adapt.LastParameter()));
+        } else {
+            GCPnts_TangentialDeflection discretizer(adapt, 0.05, deflection);
+            for (int i = 1; i <= discretizer.NbPoints(); i++) {
+                points.push_back(discretizer.Value(i));
+            }
+        }
+        for (size_t i = 1; i < points.size(); i++) {
+            Edge e = {points[i-1].X(), points[i-1].Y(), points[i].X(), points[i].Y()};
+            m_boundary.push_back(e);
+            boost::hash_combine(m_hash, e.x1);
+            boost::hash_combine(m_hash, e.y1);
+            boost::hash_combine(m_hash, e.x2);
+            boost::hash_combine(m_hash, e.y2);
+        }
+    }
+}
 
+std::vector<HatchClipper::Segment> HatchClipper::clip(const std::vector<Segment>& lines) const
+{
+    std::vector<Segment> result;
+    if (lines.empty() || m_boundary.empty()) {
+        return result;
+    }
+
+    //work in the frame of the line family: u along the lines, v across them
+    Base::Vector3d dir = lines.front().second - lines.front().first;
+    if (dir.Length() < Precision::Confusion()) {
+        return result;
+    }
+    dir.Normalize();
+    Base::Vector3d ortho(-dir.y, dir.x, 0.0);
 
+    struct Span
+    {
+        double u1, v1, u2, v2;
+        double vMin() const {return std::min(v1, v2);}
+        double vMax() const {return std::max(v1, v2);}
+    };
+    std::vector<Span> spans;
+    spans.reserve(m_boundary.size());
+    for (auto& e: m_boundary) {
+        Span s = {dir.x * e.x1 + dir.y * e.y1, ortho.x * e.x1 + ortho.y * e.y1,
+                  dir.x * e.x2 + dir.y * e.y2, ortho.x * e.x2 + ortho.y * e.y2};
+        if (s.v1 != s.v2) {                        //edges along the lines never cross them
+            spans.push_back(s);
+        }
+    }
+    std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) {
+        return a.vMin() < b.vMin();
+    });
+
+    std::vector<size_t> order(lines.size());
+    std::vector<double> offsets(lines.size());
+    for (size_t i = 0; i < lines.size(); i++) {
+        order[i] = i;
+        offsets[i] = ortho.x * lines[i].first.x + ortho.y * lines[i].first.y;
+    }
+    std::sort(order.begin(), order.end(), [&offsets](size_t a, size_t b) {
+        return offsets[a] < offsets[b];
+    });
+
+    //sweep across the lines and keep the boundary edges that span the current line
+    std::vector<const Span*> active;
+    std::vector<double> crossings;
+    size_t next = 0;
+    for (auto index: order) {
+        double v = offsets[index];
+        while (next < spans.size() && spans[next].vMin() <= v) {
+            active.push_back(&spans[next]);
+            next++;
+        }
+        active.erase(std::remove_if(active.begin(), active.end(), [v](const Span* s) {
+            return s->vMax() < v;
+        }), active.end());
+
+        crossings.clear();
+        for (auto s: active) {
+            //half open to count a crossing through a polygon vertex once
+            if ((s->v1 <= v && v < s->v2) || (s->v2 <= v && v < s->v1)) {
+                crossings.push_back(s->u1 + (v - s->v1) * (s->u2 - s->u1) / (s->v2 - s->v1));
+            }
+        }
+        std::sort(crossings.begin(), crossings.end());
+
+        const Segment& line = lines[index];
+        double uStart = dir.x * line.first.x + dir.y * line.first.y;
+        double uEnd = dir.x * line.second.x + dir.y * line.second.y;
+        for (size_t i = 0; i + 1 < crossings.size(); i += 2) {
+            double u1 = std::max(crossings[i], uStart);
+            double u2 = std::min(crossings[i+1], uEnd);
+            if (u2 - u1 < Precision::Confusion()) {
+                continue;
+            }
+            Base::Vector3d base = ortho * v;
+            result.emplace_back(base + dir * u1, base + dir * u2);
+        }
+    }
+    return result;
+}
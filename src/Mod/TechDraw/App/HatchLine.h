@@ -27,8 +27,10 @@
 
 #include <vector>
 #include <string>
+#include <utility>
 
 #include <TopoDS_Edge.hxx>
+#include <TopoDS_Face.hxx>
 #include <Bnd_Box.hxx>
 #include <Base/Vector3D.h>
 
@@ -153,6 +155,32 @@ private:
     Bnd_Box m_box;
 };
 
+//! HatchClipper clips families of parallel hatch lines to a face in the XY plane.
+//! The face boundary is flattened to a polygon once and each line is intersected
+//! with the polygon edges that span it, no boolean operations are needed.
+class TechDrawExport HatchClipper
+{
+public:
+    typedef std::pair<Base::Vector3d, Base::Vector3d> Segment;
+
+    HatchClipper(const TopoDS_Face& face, double deflection = 0.0);
+    ~HatchClipper() {}
+
+    bool isValid(void) const {return !m_boundary.empty();}
+    //! a value that changes with the shape of the boundary
+    std::size_t hashValue(void) const {return m_hash;}
+    //! clip parallel lines given by their end points, inside parts keep the line direction
+    std::vector<Segment> clip(const std::vector<Segment>& lines) const;
+
+private:
+    struct Edge
+    {
+        double x1, y1, x2, y2;
+    };
+    std::vector<Edge> m_boundary;
+    std::size_t m_hash;
+};
+
 
 } //end namespace
 
@@ -42,6 +42,7 @@ public:
     virtual void paint(QPainter * painter, const QStyleOptionGraphicsItem * option, QWidget * widget = 0 ) override;
 
     int getProjIndex() const { return projIndex; }
+    void setProjIndex(int index) { projIndex = index; }
 
     void setCosmetic(bool state);
     void setHiddenEdge(bool b);
@@ -42,6 +42,8 @@
 #endif // #ifndef _PreComp_
 
 #include <chrono>
+#include <map>
+#include <tuple>
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObject.h>
@@ -95,6 +97,18 @@ using namespace std;
 
 const float lineScaleFactor = Rez::guiX(1.);   // temp fiddle for devel
 
+namespace {
+//edges with the same key are compared path by path
+typedef std::tuple<int, qreal, qreal, qreal, qreal> EdgePathKey;
+typedef std::multimap<EdgePathKey, QGIEdge*> EdgePathMap;
+
+EdgePathKey edgePathKey(const QPainterPath& path)
+{
+    QRectF r = path.boundingRect();
+    return std::make_tuple(path.elementCount(), r.left(), r.top(), r.right(), r.bottom());
+}
+}
+
 QGIViewPart::QGIViewPart() :
     m_isExporting(false)
 {
@@ -462,9 +476,18 @@ void QGIViewPart::drawViewPart()
     bool showAll = vp->ShowAllEdges.getValue();
 
     prepareGeometryChange();
-    removePrimitives();                      //clean the slate
+    removePrimitives(true);                  //clean the slate, except for the edges
     removeDecorations();
 
+    //edges with an unchanged path are reused instead of rebuilt
+    EdgePathMap oldEdges;
+    for (auto& c: childItems()) {
+        if (c->type() == QGIEdge::Type) {
+            QGIEdge* edge = static_cast<QGIEdge*>(c);
+            oldEdges.insert(std::make_pair(edgePathKey(edge->path()), edge));
+        }
+    }
+
 #if MOD_TECHDRAW_HANDLE_FACES
     if (viewPart->handleFaces()) {
         // Draw Faces
@@ -560,7 +583,26 @@ void QGIViewPart::drawViewPart()
         }
         bool showItem = true;
         if (showEdge) {                     //based on hard/seam/hidden/etc
-            item = new QGIEdge(i);
+            QPainterPath edgePath = drawPainterPath(*itGeom);
+            item = nullptr;
+            auto range = oldEdges.equal_range(edgePathKey(edgePath));
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second->path() == edgePath) {
+                    item = it->second;
+                    oldEdges.erase(it);
+                    break;
+                }
+            }
+            if (item != nullptr) {
+                item->setProjIndex(i);
+                item->setHiddenEdge(false);
+                item->show();
+            } else {
+                item = new QGIEdge(i);
+                addToGroup(item);                       //item is at scene(0,0), not group(0,0)
+                item->setPos(0.0,0.0);                  //now at group(0,0)
+                item->setPath(edgePath);
+            }
             item->setWidth(lineWidth);
             item->setNormalColor(edgeColor);
             item->setStyle(Qt::SolidLine);
@@ -585,9 +627,6 @@ void QGIViewPart::drawViewPart()
                 }
             }
 
-            addToGroup(item);                       //item is at scene(0,0), not group(0,0)
-            item->setPos(0.0,0.0);                  //now at group(0,0)
-            item->setPath(drawPainterPath(*itGeom));
             item->setZValue(ZVALUE::EDGE);
             if(!(*itGeom)->hlrVisible) {
                 item->setWidth(lineWidthHid);
@@ -611,6 +650,22 @@ void QGIViewPart::drawViewPart()
          }
     }
 
+    //edges of the last drawing that are gone now
+    if (!oldEdges.empty()) {
+        MDIViewPage* mdi = getMDIViewPage();
+        if (mdi != nullptr) {
+            mdi->blockSelection(true);
+        }
+        for (auto& old: oldEdges) {
+            old.second->hide();
+            scene()->removeItem(old.second);
+            delete old.second;
+        }
+        if (mdi != nullptr) {
+            mdi->blockSelection(false);
+        }
+    }
+
 
     // Draw Vertexs:
     Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter().GetGroup("BaseApp")->
@@ -764,7 +819,8 @@ QGIFace* QGIViewPart::drawFace(TechDraw::Face* f, int idx)
 
 //! Remove all existing QGIPrimPath items(Vertex,Edge,Face)
 //note this triggers scene selectionChanged signal if vertex/edge/face is selected
-void QGIViewPart::removePrimitives()
+//! keepEdges leaves the unselected edges for drawViewPart to reuse
+void QGIViewPart::removePrimitives(bool keepEdges)
 {
     QList<QGraphicsItem*> children = childItems();
     MDIViewPage* mdi = getMDIViewPage();
@@ -772,6 +828,9 @@ void QGIViewPart::removePrimitives()
         getMDIViewPage()->blockSelection(true);
     }
     for (auto& c:children) {
+         if (keepEdges && (c->type() == QGIEdge::Type) && !c->isSelected()) {
+             continue;
+         }
          QGIPrimPath* prim = dynamic_cast<QGIPrimPath*>(c);
          if (prim) {
             prim->hide();
@@ -81,6 +81,33 @@ istream *ZipFile::getInputStream( const string &entry_name,
 			   getLocalHeaderOffset() + _vs.startOffset() ) ;
 }
 
+bool ZipFile::getRawData( const ConstEntryPointer &entry, string &data ) {
+  if ( ! _valid )
+    throw InvalidStateException( "Attempt to use an invalid ZipFile" ) ;
+
+  const ZipCDirEntry *ent = dynamic_cast< const ZipCDirEntry * >( entry.get() ) ;
+  if ( ! ent )
+    return false ;
+
+#if defined(_WIN32) && defined(ZIPIOS_UTF8)
+  std::wstring wsname = Base::FileInfo(_filename).toStdWString();
+  ifstream _zipfile( wsname.c_str(), ios::in | ios::binary ) ;
+#else
+  ifstream _zipfile( _filename.c_str(), ios::in | ios::binary ) ;
+#endif
+  // skip the local header, its size may differ from the central directory entry
+  ZipLocalEntry zlh ;
+  _vs.vseekg( _zipfile, ent->getLocalHeaderOffset(), ios::beg ) ;
+  _zipfile >> zlh ;
+  if ( ! _zipfile )
+    return false ;
+
+  data.resize( ent->getCompressedSize() ) ;
+  if ( ! data.empty() )
+    _zipfile.read( &data[ 0 ], data.size() ) ;
+  return static_cast< bool >( _zipfile ) ;
+}
+
 
 //
 // Private
@@ -65,6 +65,14 @@ public:
   virtual istream *getInputStream( const ConstEntryPointer &entry ) ;
   virtual istream *getInputStream( const string &entry_name, 
 				     MatchPath matchpath = MATCH ) ;
+
+  /** Reads the data of an entry as it is stored in the archive, i.e. still
+      compressed, e.g. to copy it into another archive with
+      ZipOutputStream::putRawEntry().
+      @param entry the entry to read.
+      @param data receives the stored data.
+      @return false if the data couldn't be read. */
+  bool getRawData( const ConstEntryPointer &entry, string &data ) ;
 private:
   VirtualSeeker _vs ;
   EndOfCentralDirectory  _eocd ;
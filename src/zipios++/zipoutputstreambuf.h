@@ -49,6 +49,18 @@ public:
       entry. */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Appends an entry whose data has already been compressed with raw
+      deflate (no zlib header) at the current compression level. Any open
+      entry is closed first. The entry is complete when the call returns,
+      i.e. putNextEntry() must be called before writing to the stream again.
+      @param entry the entry to add.
+      @param data the compressed data.
+      @param compressed_size the number of bytes in data.
+      @param crc the crc32 checksum of the uncompressed data.
+      @param size the size of the uncompressed data. */
+  void putRawEntry( const ZipCDirEntry &entry, const char *data,
+                    uint32 compressed_size, uint32 crc, uint32 size ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const string &comment ) ;
 
@@ -68,6 +80,7 @@ protected:
 
   void setEntryClosedState() ;
   void updateEntryHeaderInfo() ;
+  static int currentDosTime() ;
 
   // Should/could be moved to zipheadio.h ?!
   static void writeCentralDirectory( const vector< ZipCDirEntry > &entries, 